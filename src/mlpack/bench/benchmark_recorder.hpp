@@ -0,0 +1,116 @@
+/**
+ * @file bench/benchmark_recorder.hpp
+ * @author Ryan Curtin
+ *
+ * A minimal micro-benchmark harness.  Each benchmark is a callable that is
+ * run repeatedly until both a minimum number of iterations and a minimum
+ * amount of wall-clock time have been reached; the results can be emitted as
+ * JSON so runs can be compared across releases.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BENCH_BENCHMARK_RECORDER_HPP
+#define MLPACK_BENCH_BENCHMARK_RECORDER_HPP
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace mlpack {
+namespace bench {
+
+//! A sink for benchmark results; writing computed values here keeps the
+//! compiler from optimizing benchmark bodies away.
+extern volatile double benchSink;
+
+/**
+ * Runs benchmarks and collects their timings.
+ */
+class BenchmarkRecorder
+{
+ public:
+  /**
+   * Run one benchmark.  The callable is invoked once untimed as a warm-up,
+   * and then repeatedly until at least minIterations iterations and
+   * minSeconds seconds of measurement have accumulated.
+   *
+   * @param name Name of the benchmark (used in the report).
+   * @param benchmark Callable taking no arguments.
+   * @param minIterations Minimum number of timed iterations.
+   * @param minSeconds Minimum total measured time, in seconds.
+   */
+  template<typename FuncType>
+  void Run(const std::string& name,
+           FuncType benchmark,
+           const size_t minIterations = 5,
+           const double minSeconds = 0.25)
+  {
+    // Warm-up run; not timed.
+    benchmark();
+
+    size_t iterations = 0;
+    double totalSeconds = 0.0;
+    while (iterations < minIterations || totalSeconds < minSeconds)
+    {
+      const std::chrono::steady_clock::time_point start =
+          std::chrono::steady_clock::now();
+      benchmark();
+      const std::chrono::steady_clock::time_point end =
+          std::chrono::steady_clock::now();
+
+      totalSeconds += std::chrono::duration_cast<
+          std::chrono::duration<double>>(end - start).count();
+      ++iterations;
+    }
+
+    results.push_back({ name, iterations, totalSeconds });
+    std::cerr << name << ": " << (totalSeconds / iterations) << "s/iter ("
+        << iterations << " iterations)" << std::endl;
+  }
+
+  /**
+   * Print all collected results as a JSON document to the given stream.
+   */
+  void PrintJSON(std::ostream& stream) const
+  {
+    stream << "{\n  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+      stream << (i == 0 ? "\n" : ",\n")
+          << "    {\n"
+          << "      \"name\": \"" << results[i].name << "\",\n"
+          << "      \"iterations\": " << results[i].iterations << ",\n"
+          << "      \"total_seconds\": " << results[i].totalSeconds << ",\n"
+          << "      \"seconds_per_iteration\": "
+          << (results[i].totalSeconds / results[i].iterations) << "\n"
+          << "    }";
+    }
+    stream << "\n  ]\n}\n";
+  }
+
+ private:
+  //! The timing of one benchmark.
+  struct Result
+  {
+    //! Name of the benchmark.
+    std::string name;
+
+    //! Number of timed iterations.
+    size_t iterations;
+
+    //! Total measured time, in seconds.
+    double totalSeconds;
+  };
+
+  //! All results, in the order the benchmarks were run.
+  std::vector<Result> results;
+};
+
+} // namespace bench
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,201 @@
+/**
+ * @file bench/mlpack_bench.cpp
+ * @author Ryan Curtin
+ *
+ * Micro-benchmarks for core mlpack kernels: metric and kernel evaluations,
+ * bound computations, tree construction and traversal, the naive k-means
+ * step, and CSV loading.  Run with an optional argument naming a file to
+ * write JSON results to (for regression tracking); otherwise the JSON report
+ * is printed to stdout.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/kernels/epanechnikov_kernel.hpp>
+#include <mlpack/core/kernels/gaussian_kernel.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+#include <mlpack/core/tree/binary_space_tree.hpp>
+#include <mlpack/core/tree/cover_tree.hpp>
+#include <mlpack/core/tree/hrectbound.hpp>
+#include <mlpack/core/tree/octree.hpp>
+#include <mlpack/methods/kmeans/naive_kmeans.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+
+#include <cstdio>
+#include <fstream>
+
+#include "benchmark_recorder.hpp"
+
+using namespace mlpack;
+using namespace mlpack::bench;
+using namespace mlpack::bound;
+using namespace mlpack::kernel;
+using namespace mlpack::kmeans;
+using namespace mlpack::metric;
+using namespace mlpack::neighbor;
+using namespace mlpack::tree;
+
+namespace mlpack {
+namespace bench {
+
+volatile double benchSink = 0.0;
+
+} // namespace bench
+} // namespace mlpack
+
+int main(int argc, char** argv)
+{
+  // A fixed seed makes runs comparable across releases.
+  math::RandomSeed(42);
+
+  BenchmarkRecorder recorder;
+
+  // Metric evaluation on pairs of adjacent columns.
+  {
+    arma::mat points(50, 2000, arma::fill::randu);
+    recorder.Run("lmetric_evaluate", [&]()
+    {
+      double sum = 0.0;
+      for (size_t i = 0; i < points.n_cols - 1; ++i)
+        sum += EuclideanDistance::Evaluate(points.col(i), points.col(i + 1));
+      benchSink += sum;
+    }, 50);
+  }
+
+  // Bound-to-bound minimum distance.
+  {
+    arma::mat points(20, 2000, arma::fill::randu);
+    std::vector<HRectBound<EuclideanDistance>> bounds(100,
+        HRectBound<EuclideanDistance>(points.n_rows));
+    for (size_t i = 0; i < bounds.size(); ++i)
+      bounds[i] |= points.cols(20 * i, 20 * i + 19);
+
+    recorder.Run("hrectbound_min_distance", [&]()
+    {
+      double sum = 0.0;
+      for (size_t i = 0; i < bounds.size(); ++i)
+        for (size_t j = 0; j < bounds.size(); ++j)
+          sum += bounds[i].MinDistance(bounds[j]);
+      benchSink += sum;
+    }, 50);
+  }
+
+  // Tree construction.
+  arma::mat treeData(10, 20000, arma::fill::randu);
+  {
+    recorder.Run("kdtree_build", [&]()
+    {
+      KDTree<EuclideanDistance, EmptyStatistic, arma::mat> tree(treeData);
+      benchSink += tree.NumDescendants();
+    });
+
+    recorder.Run("covertree_build", [&]()
+    {
+      StandardCoverTree<EuclideanDistance, EmptyStatistic, arma::mat>
+          tree(treeData);
+      benchSink += tree.NumDescendants();
+    });
+
+    recorder.Run("octree_build", [&]()
+    {
+      Octree<EuclideanDistance, EmptyStatistic, arma::mat> tree(treeData);
+      benchSink += tree.NumDescendants();
+    });
+  }
+
+  // Dual-tree traversal, via k-nearest-neighbor search.
+  {
+    arma::mat queries(10, 2000, arma::fill::randu);
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+
+    KNN kdtreeSearch(treeData);
+    recorder.Run("kdtree_knn_search", [&]()
+    {
+      kdtreeSearch.Search(queries, 5, neighbors, distances);
+      benchSink += distances(0, 0);
+    });
+
+    NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat,
+        StandardCoverTree> coverTreeSearch(treeData);
+    recorder.Run("covertree_knn_search", [&]()
+    {
+      coverTreeSearch.Search(queries, 5, neighbors, distances);
+      benchSink += distances(0, 0);
+    });
+
+    NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat,
+        Octree> octreeSearch(treeData);
+    recorder.Run("octree_knn_search", [&]()
+    {
+      octreeSearch.Search(queries, 5, neighbors, distances);
+      benchSink += distances(0, 0);
+    });
+  }
+
+  // One naive k-means step.
+  {
+    EuclideanDistance metric;
+    NaiveKMeans<EuclideanDistance, arma::mat> lloyd(treeData, metric);
+    arma::mat centroids(treeData.n_rows, 10, arma::fill::randu);
+    arma::mat newCentroids;
+    arma::Col<size_t> counts;
+    recorder.Run("naive_kmeans_iterate", [&]()
+    {
+      benchSink += lloyd.Iterate(centroids, newCentroids, counts);
+    });
+  }
+
+  // Kernel evaluations on pairs of adjacent columns.
+  {
+    arma::mat points(50, 2000, arma::fill::randu);
+    GaussianKernel gaussian;
+    EpanechnikovKernel epanechnikov;
+
+    recorder.Run("gaussian_kernel_evaluate", [&]()
+    {
+      double sum = 0.0;
+      for (size_t i = 0; i < points.n_cols - 1; ++i)
+        sum += gaussian.Evaluate(points.col(i), points.col(i + 1));
+      benchSink += sum;
+    }, 50);
+
+    recorder.Run("epanechnikov_kernel_evaluate", [&]()
+    {
+      double sum = 0.0;
+      for (size_t i = 0; i < points.n_cols - 1; ++i)
+        sum += epanechnikov.Evaluate(points.col(i), points.col(i + 1));
+      benchSink += sum;
+    }, 50);
+  }
+
+  // CSV load throughput.
+  {
+    arma::mat csvData(100, 10000, arma::fill::randu);
+    data::Save("mlpack_bench_tmp.csv", csvData);
+
+    recorder.Run("csv_load", [&]()
+    {
+      arma::mat loaded;
+      data::Load("mlpack_bench_tmp.csv", loaded);
+      benchSink += loaded(0, 0);
+    });
+
+    remove("mlpack_bench_tmp.csv");
+  }
+
+  if (argc > 1)
+  {
+    std::ofstream output(argv[1]);
+    recorder.PrintJSON(output);
+  }
+  else
+  {
+    recorder.PrintJSON(std::cout);
+  }
+
+  return 0;
+}
@@ -0,0 +1,339 @@
+/**
+ * @file bindings/cli/binding_server.hpp
+ *
+ * Persistent server mode for command-line bindings.  When a binding is run
+ * with '--server <socket path>', instead of running once and exiting, it
+ * listens on a Unix domain socket and serves one request per framed message.
+ * Each request is a command line for the binding (whitespace-separated
+ * arguments, exactly as they would be given on the shell, minus the program
+ * name); the response reports success or the error message.  Messages in both
+ * directions are framed as an 8-byte little-endian length followed by that
+ * many bytes of payload.
+ *
+ * The point of server mode is amortization: input matrices and serialized
+ * models that are given with the same filename as in the previous request are
+ * kept in memory and not loaded again, so a pipeline that calls a binding
+ * thousands of times against one large model pays for deserialization once
+ * instead of on every invocation.  A request consisting of the single word
+ * "exit" shuts the server down cleanly.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_CLI_BINDING_SERVER_HPP
+#define MLPACK_BINDINGS_CLI_BINDING_SERVER_HPP
+
+#include <mlpack/core.hpp>
+#include "parse_command_line.hpp"
+
+#ifndef _WIN32
+  #include <cerrno>
+  #include <sys/socket.h>
+  #include <sys/un.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+namespace bindings {
+namespace cli {
+
+/**
+ * Scan the command line for '--server <socket path>' and return the socket
+ * path, or an empty string if server mode was not requested.  This happens
+ * before regular command-line parsing, since in server mode the rest of the
+ * command line comes from socket requests instead.
+ *
+ * @param argc Number of command-line arguments.
+ * @param argv Command-line arguments.
+ */
+inline std::string ServerSocketPath(int argc, char** argv)
+{
+  for (int i = 1; i < argc - 1; ++i)
+    if (std::string(argv[i]) == "--server")
+      return std::string(argv[i + 1]);
+
+  return "";
+}
+
+#ifndef _WIN32
+
+//! Read exactly count bytes from fd; returns false on EOF or error.
+inline bool ServerReadBytes(const int fd, char* buffer, size_t count)
+{
+  while (count > 0)
+  {
+    const ssize_t got = read(fd, buffer, count);
+    if (got <= 0)
+      return false;
+    buffer += got;
+    count -= got;
+  }
+
+  return true;
+}
+
+//! Write exactly count bytes to fd; returns false on error.
+inline bool ServerWriteBytes(const int fd, const char* buffer, size_t count)
+{
+  while (count > 0)
+  {
+    const ssize_t sent = write(fd, buffer, count);
+    if (sent <= 0)
+      return false;
+    buffer += sent;
+    count -= sent;
+  }
+
+  return true;
+}
+
+/**
+ * Read one length-prefixed message from the given socket.  Returns false on
+ * EOF or error (i.e. the client hung up).
+ *
+ * @param fd Connected socket to read from.
+ * @param payload String to store the message payload in.
+ */
+inline bool ServerReadMessage(const int fd, std::string& payload)
+{
+  uint64_t length;
+  if (!ServerReadBytes(fd, (char*) &length, sizeof(length)))
+    return false;
+
+  payload.resize((size_t) length);
+  if (length > 0 && !ServerReadBytes(fd, &payload[0], (size_t) length))
+    return false;
+
+  return true;
+}
+
+/**
+ * Write one length-prefixed message to the given socket.  Returns false on
+ * error.
+ *
+ * @param fd Connected socket to write to.
+ * @param payload Message payload to send.
+ */
+inline bool ServerWriteMessage(const int fd, const std::string& payload)
+{
+  const uint64_t length = (uint64_t) payload.size();
+  if (!ServerWriteBytes(fd, (const char*) &length, sizeof(length)))
+    return false;
+
+  return ServerWriteBytes(fd, payload.data(), payload.size());
+}
+
+/**
+ * Handle one request: re-parse the given command line, run the binding, and
+ * save any output parameters.  Input matrices and models whose backing
+ * filename is unchanged from the previous request stay loaded in memory;
+ * loads whose filename changed are invalidated (and cached models deleted)
+ * before the binding runs.  Returns "OK" on success or an error message.
+ *
+ * @param request Whitespace-separated binding arguments.
+ * @param bindingFunction The binding's mlpackMain() function.
+ */
+inline std::string ServerHandleRequest(const std::string& request,
+                                       void (*bindingFunction)())
+{
+  std::map<std::string, util::ParamData>& parameters = IO::Parameters();
+
+  // Snapshot the filename backing each input parameter, and reset the passed
+  // flags so the new request starts clean.
+  std::map<std::string, std::string> oldFilenames;
+  for (auto& it : parameters)
+  {
+    util::ParamData& d = it.second;
+    std::string filename;
+    IO::GetSingleton().functionMap[d.tname]["GetParamFilename"](d, NULL,
+        (void*) &filename);
+    oldFilenames[it.first] = filename;
+    d.wasPassed = false;
+  }
+
+  // Tokenize the request into an argument vector.  Note that this is simple
+  // whitespace splitting---there is no shell-style quoting.
+  std::vector<std::string> tokens;
+  std::istringstream tokenStream(request);
+  std::string token;
+  while (tokenStream >> token)
+    tokens.push_back(token);
+
+  std::vector<char*> args;
+  char programName[] = "mlpack_binding_server";
+  args.push_back(programName);
+  for (size_t i = 0; i < tokens.size(); ++i)
+    args.push_back(const_cast<char*>(tokens[i].c_str()));
+
+  try
+  {
+    ParseCommandLine((int) args.size(), args.data());
+
+    // Invalidate any cached loads whose backing file changed; a model that was
+    // loaded for the previous request must be freed before the flag is
+    // cleared, or it would leak.
+    for (auto& it : parameters)
+    {
+      util::ParamData& d = it.second;
+      if (!d.input || !d.loaded)
+        continue;
+
+      std::string filename;
+      IO::GetSingleton().functionMap[d.tname]["GetParamFilename"](d, NULL,
+          (void*) &filename);
+      if (filename != oldFilenames[it.first])
+      {
+        IO::GetSingleton().functionMap[d.tname]["DeleteAllocatedMemory"](d,
+            NULL, NULL);
+        d.loaded = false;
+      }
+    }
+
+    bindingFunction();
+
+    // Save output parameters, but---unlike EndProgram()---do not free any
+    // loaded input models, since the next request will likely reuse them.
+    for (auto& it : parameters)
+    {
+      util::ParamData& d = it.second;
+      if (!d.input)
+        IO::GetSingleton().functionMap[d.tname]["OutputParam"](d, NULL, NULL);
+    }
+
+    return "OK";
+  }
+  catch (std::exception& e)
+  {
+    return "ERROR: " + std::string(e.what());
+  }
+}
+
+/**
+ * Run the binding as a persistent server on the given Unix domain socket.
+ * This only returns when a client sends an "exit" request (or the socket
+ * fails); the return value is the process exit code.
+ *
+ * @param socketPath Path of the Unix domain socket to listen on.
+ * @param bindingFunction The binding's mlpackMain() function.
+ */
+inline int ServeBinding(const std::string& socketPath,
+                        void (*bindingFunction)())
+{
+  const int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listenFd < 0)
+  {
+    std::cerr << "Could not create socket: " << strerror(errno) << std::endl;
+    return 1;
+  }
+
+  sockaddr_un address;
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (socketPath.size() >= sizeof(address.sun_path))
+  {
+    std::cerr << "Socket path '" << socketPath << "' is too long!"
+        << std::endl;
+    close(listenFd);
+    return 1;
+  }
+  strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+  // Remove any stale socket file from a previous run.
+  unlink(socketPath.c_str());
+
+  if (bind(listenFd, (sockaddr*) &address, sizeof(address)) < 0 ||
+      listen(listenFd, 8) < 0)
+  {
+    std::cerr << "Could not listen on '" << socketPath << "': "
+        << strerror(errno) << std::endl;
+    close(listenFd);
+    return 1;
+  }
+
+  mlpack::Timer::EnableTiming();
+  std::cout << IO::GetSingleton().ProgramName() << ": serving requests on '"
+      << socketPath << "'." << std::endl;
+
+  bool shutdown = false;
+  while (!shutdown)
+  {
+    const int conn = accept(listenFd, NULL, NULL);
+    if (conn < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      break;
+    }
+
+    // A connection may carry any number of requests.
+    std::string request;
+    while (ServerReadMessage(conn, request))
+    {
+      if (request == "exit")
+      {
+        ServerWriteMessage(conn, "OK");
+        shutdown = true;
+        break;
+      }
+
+      if (!ServerWriteMessage(conn,
+          ServerHandleRequest(request, bindingFunction)))
+        break;
+    }
+
+    close(conn);
+  }
+
+  close(listenFd);
+  unlink(socketPath.c_str());
+
+  // Now it is safe to free any cached input models.  This mirrors the cleanup
+  // at the end of EndProgram(), but without re-printing the last request's
+  // output parameters.
+  std::map<std::string, util::ParamData>& parameters = IO::Parameters();
+  std::unordered_map<void*, util::ParamData*> memoryAddresses;
+  for (auto& it : parameters)
+  {
+    util::ParamData& d = it.second;
+
+    void* result;
+    IO::GetSingleton().functionMap[d.tname]["GetAllocatedMemory"](d, NULL,
+        (void*) &result);
+    if (result != NULL && memoryAddresses.count(result) == 0)
+      memoryAddresses[result] = &d;
+  }
+
+  for (auto& it : memoryAddresses)
+  {
+    IO::GetSingleton().functionMap[it.second->tname]["DeleteAllocatedMemory"](
+        *it.second, NULL, NULL);
+  }
+
+  return 0;
+}
+
+#else
+
+/**
+ * Server mode requires Unix domain sockets and is not available on Windows.
+ *
+ * @param * (socketPath) Unused.
+ * @param * (bindingFunction) Unused.
+ */
+inline int ServeBinding(const std::string& /* socketPath */,
+                        void (*)() /* bindingFunction */)
+{
+  std::cerr << "Server mode (--server) is not available on Windows!"
+      << std::endl;
+  return 1;
+}
+
+#endif
+
+} // namespace cli
+} // namespace bindings
+} // namespace mlpack
+
+#endif
@@ -23,6 +23,7 @@
 #include "get_printable_param.hpp"
 #include "string_type_param.hpp"
 #include "get_param.hpp"
+#include "get_param_filename.hpp"
 #include "get_raw_param.hpp"
 #include "map_parameter_name.hpp"
 #include "set_param.hpp"
@@ -148,6 +149,8 @@ class CLIOption
     IO::GetSingleton().functionMap[tname]["StringTypeParam"] =
         &StringTypeParam<N>;
     IO::GetSingleton().functionMap[tname]["GetParam"] = &GetParam<N>;
+    IO::GetSingleton().functionMap[tname]["GetParamFilename"] =
+        &GetParamFilename<N>;
     IO::GetSingleton().functionMap[tname]["GetRawParam"] = &GetRawParam<N>;
     IO::GetSingleton().functionMap[tname]["AddToCLI11"] = &AddToCLI11<N>;
     IO::GetSingleton().functionMap[tname]["MapParameterName"] =
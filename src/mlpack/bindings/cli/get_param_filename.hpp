@@ -0,0 +1,106 @@
+/**
+ * @file bindings/cli/get_param_filename.hpp
+ *
+ * Get the name of the file that backs a parameter, if any.  Matrices, matrices
+ * with dataset info, and serializable models are passed on the command line as
+ * filenames; this returns the filename currently associated with such a
+ * parameter (or an empty string for parameters with no backing file).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_CLI_GET_PARAM_FILENAME_HPP
+#define MLPACK_BINDINGS_CLI_GET_PARAM_FILENAME_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "parameter_type.hpp"
+
+namespace mlpack {
+namespace bindings {
+namespace cli {
+
+/**
+ * This overload is called for parameters that are not backed by a file
+ * (flags, numeric options, strings, and so forth); there is no filename.
+ *
+ * @param * (d) ParamData object to get the backing filename of.
+ */
+template<typename T>
+std::string GetParamFilename(
+    util::ParamData& /* d */,
+    const typename boost::disable_if<arma::is_arma_type<T>>::type* = 0,
+    const typename boost::disable_if<data::HasSerialize<T>>::type* = 0,
+    const typename boost::disable_if<std::is_same<T,
+        std::tuple<mlpack::data::DatasetInfo, arma::mat>>>::type* = 0)
+{
+  return "";
+}
+
+/**
+ * Return the filename backing a matrix parameter.
+ *
+ * @param d ParamData object to get the backing filename of.
+ */
+template<typename T>
+std::string GetParamFilename(
+    util::ParamData& d,
+    const typename boost::enable_if<arma::is_arma_type<T>>::type* = 0)
+{
+  typedef std::tuple<T, typename ParameterType<T>::type> TupleType;
+  return std::get<1>(*boost::any_cast<TupleType>(&d.value));
+}
+
+/**
+ * Return the filename backing a matrix/dataset info parameter.
+ *
+ * @param d ParamData object to get the backing filename of.
+ */
+template<typename T>
+std::string GetParamFilename(
+    util::ParamData& d,
+    const typename boost::enable_if<std::is_same<T,
+        std::tuple<mlpack::data::DatasetInfo, arma::mat>>>::type* = 0)
+{
+  typedef std::tuple<T, std::string> TupleType;
+  return std::get<1>(*boost::any_cast<TupleType>(&d.value));
+}
+
+/**
+ * Return the filename backing a serializable model parameter.
+ *
+ * @param d ParamData object to get the backing filename of.
+ */
+template<typename T>
+std::string GetParamFilename(
+    util::ParamData& d,
+    const typename boost::disable_if<arma::is_arma_type<T>>::type* = 0,
+    const typename boost::enable_if<data::HasSerialize<T>>::type* = 0)
+{
+  typedef std::tuple<T*, std::string> TupleType;
+  return std::get<1>(*boost::any_cast<TupleType>(&d.value));
+}
+
+/**
+ * Return the backing filename of a parameter.  This function is registered in
+ * IO's function map.
+ *
+ * @param d Parameter information.
+ * @param * (input) Unused parameter.
+ * @param output Place to store the filename (as a std::string).
+ */
+template<typename T>
+void GetParamFilename(util::ParamData& d,
+                      const void* /* input */,
+                      void* output)
+{
+  *((std::string*) output) =
+      GetParamFilename<typename std::remove_pointer<T>::type>(d);
+}
+
+} // namespace cli
+} // namespace bindings
+} // namespace mlpack
+
+#endif
@@ -28,6 +28,9 @@ PARAM_STRING_IN("info", "Print help on a specific option.", "", "");
 PARAM_FLAG("verbose", "Display informational messages and the full list of "
     "parameters and timers at the end of execution.", "v");
 PARAM_FLAG("version", "Display the version of mlpack.", "V");
+PARAM_STRING_IN("server", "If specified, run persistently and serve repeated "
+    "requests over a Unix domain socket at the given path, keeping loaded "
+    "models and matrices in memory between requests.", "", "");
 
 /**
  * Parse the command line, setting all of the options inside of the CLI object
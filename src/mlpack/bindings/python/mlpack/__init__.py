@@ -8,3 +8,6 @@ terms of the 3-clause BSD license.  You should have received a copy of the
 3-clause BSD license along with mlpack.  If not, see
 http://www.opensource.org/licenses/BSD-3-Clause for more information.
 """
+
+# Convenience import for strict zero-copy mode (see matrix_utils.py).
+from mlpack.matrix_utils import strict_zero_copy, strict_zero_copy_enabled
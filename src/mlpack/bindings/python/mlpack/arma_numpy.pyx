@@ -12,6 +12,11 @@ object, then the numpy object will "own" the matrix.
 Thus, know that if you convert a matrix type, remember that the resulting type
 is what "owns" the allocated memory.
 
+Some inputs cannot be used in place (non-contiguous views, arrays numpy does
+not own) and are silently copied.  If strict zero-copy mode is enabled (see
+matrix_utils.strict_zero_copy()), these paths raise a ValueError instead so
+that no hidden copy is ever made.
+
 mlpack is free software; you may redistribute it and/or modify it under the
 terms of the 3-clause BSD license.  You should have received a copy of the
 3-clause BSD license along with mlpack.  If not, see
@@ -50,6 +55,11 @@ cdef arma.Mat[double]* numpy_to_mat_d(numpy.ndarray[numpy.double_t, ndim=2] X, \
   """
   if not X.flags.c_contiguous or (not X.flags.owndata and not isWin):
     # If needed, make a copy where we own the memory.
+    from matrix_utils import strict_zero_copy_enabled
+    if strict_zero_copy_enabled():
+      raise ValueError("strict zero-copy mode: cannot use the array "\
+          "in place (it is not C-contiguous, or numpy does not own "\
+          "its memory)")
     X = X.copy(order="C")
     takeOwnership = True
 
@@ -71,6 +81,11 @@ cdef arma.Mat[size_t]* numpy_to_mat_s(numpy.ndarray[numpy.npy_intp, ndim=2] X, \
   if not X.flags.c_contiguous or (not X.flags.owndata and not isWin):
     # If needed, make a copy where we own the memory, except on Windows where
     # we never copy.
+    from matrix_utils import strict_zero_copy_enabled
+    if strict_zero_copy_enabled():
+      raise ValueError("strict zero-copy mode: cannot use the array "\
+          "in place (it is not C-contiguous, or numpy does not own "\
+          "its memory)")
     X = X.copy(order="C")
     takeOwnership = True
 
@@ -135,6 +150,11 @@ cdef arma.Row[double]* numpy_to_row_d(numpy.ndarray[numpy.double_t, ndim=1] X, \
   if not X.flags.c_contiguous or (not X.flags.owndata and not isWin):
     # If needed, make a copy where we own the memory, except on Windows where
     # we never copy.
+    from matrix_utils import strict_zero_copy_enabled
+    if strict_zero_copy_enabled():
+      raise ValueError("strict zero-copy mode: cannot use the array "\
+          "in place (it is not C-contiguous, or numpy does not own "\
+          "its memory)")
     X = X.copy(order="C")
     takeOwnership = True
 
@@ -157,6 +177,11 @@ cdef arma.Row[size_t]* numpy_to_row_s(numpy.ndarray[numpy.npy_intp, ndim=1] X, \
   if not X.flags.c_contiguous or (not X.flags.owndata and not isWin):
     # If needed, make a copy where we own the memory, except on Windows where
     # we never copy.
+    from matrix_utils import strict_zero_copy_enabled
+    if strict_zero_copy_enabled():
+      raise ValueError("strict zero-copy mode: cannot use the array "\
+          "in place (it is not C-contiguous, or numpy does not own "\
+          "its memory)")
     X = X.copy(order="C")
     takeOwnership = True
 
@@ -218,6 +243,11 @@ cdef arma.Col[double]* numpy_to_col_d(numpy.ndarray[numpy.double_t, ndim=1] X, \
   if not X.flags.c_contiguous or (not X.flags.owndata and not isWin):
     # If needed, make a copy where we own the memory, except on Windows where
     # we never copy.
+    from matrix_utils import strict_zero_copy_enabled
+    if strict_zero_copy_enabled():
+      raise ValueError("strict zero-copy mode: cannot use the array "\
+          "in place (it is not C-contiguous, or numpy does not own "\
+          "its memory)")
     X = X.copy(order="C")
     takeOwnership = True
 
@@ -240,6 +270,11 @@ cdef arma.Col[size_t]* numpy_to_col_s(numpy.ndarray[numpy.npy_intp, ndim=1] X, \
   if not X.flags.c_contiguous or (not X.flags.owndata and not isWin):
     # If needed, make a copy where we own the memory, except on Windows where
     # we never copy.
+    from matrix_utils import strict_zero_copy_enabled
+    if strict_zero_copy_enabled():
+      raise ValueError("strict zero-copy mode: cannot use the array "\
+          "in place (it is not C-contiguous, or numpy does not own "\
+          "its memory)")
     X = X.copy(order="C")
     takeOwnership = True
 
@@ -37,6 +37,38 @@ try:
 except:
   buffer = memoryview
 
+# If strict zero-copy mode is enabled, any conversion that would need to copy
+# the input data raises instead of silently copying.  See strict_zero_copy().
+_strict_zero_copy = False
+
+def strict_zero_copy(enable=True):
+  """
+  Enable or disable strict zero-copy mode.  When enabled, any input
+  conversion that would need to copy the data---wrong dtype, Fortran
+  (column-major) memory order, non-contiguous views, pandas categorical
+  conversion, or Python lists---raises a ValueError instead of silently
+  copying.  This is useful for very large matrices where a hidden copy means
+  running out of memory: pass C-contiguous numpy arrays of the right dtype
+  (float64 for data matrices) and they will be used in place.
+  """
+  global _strict_zero_copy
+  _strict_zero_copy = bool(enable)
+
+def strict_zero_copy_enabled():
+  """
+  Return whether strict zero-copy mode is enabled (see strict_zero_copy()).
+  """
+  return _strict_zero_copy
+
+def _strict_copy_error(reason):
+  """
+  Raise a ValueError for a conversion that would copy in strict zero-copy
+  mode.
+  """
+  raise ValueError("strict zero-copy mode: input would be copied (" + reason +
+      "); pass a C-contiguous numpy array of the correct dtype, or disable "
+      "strict mode with mlpack.strict_zero_copy(False)")
+
 def to_matrix(x, dtype=np.double, copy=False):
   """
   Given some array-like X, return a numpy ndarray of the same type.
@@ -49,11 +81,15 @@ def to_matrix(x, dtype=np.double, copy=False):
 
   if (isinstance(x, np.ndarray) and x.dtype == dtype and x.flags.c_contiguous):
     if copy: # Copy the matrix if required.
+      if _strict_zero_copy:
+        _strict_copy_error("a copy of the input was explicitly requested")
       return x.copy("C"), True
     else:
       return x, False
   elif (isinstance(x, np.ndarray) and x.dtype == dtype and x.flags.f_contiguous):
     # A copy is always necessary here.
+    if _strict_zero_copy:
+      _strict_copy_error("the array is Fortran (column-major) ordered")
     return x.copy("C"), True
   else:
     if isinstance(x, pd.core.series.Series) or isinstance(x, pd.DataFrame):
@@ -66,8 +102,16 @@ def to_matrix(x, dtype=np.double, copy=False):
             False
       else:
         # We have to make a copy or change the dtype, so just do this directly.
+        if _strict_zero_copy:
+          _strict_copy_error("the pandas data is not C-contiguous with dtype "
+              + np.dtype(dtype).name)
         return np.array(y, dtype=dtype, order='C', copy=True), True
     else:
+      if _strict_zero_copy and isinstance(x, np.ndarray):
+        _strict_copy_error("the array has dtype " + x.dtype.name +
+            " but dtype " + np.dtype(dtype).name + " is required")
+      elif _strict_zero_copy:
+        _strict_copy_error("the input is not a numpy array")
       return np.array(x, copy=True, dtype=dtype, order='C'), True
 
 
@@ -91,6 +135,8 @@ def to_matrix_with_info(x, dtype, copy=False):
 
     # Copy the matrix if needed.
     if copy:
+      if _strict_zero_copy:
+        _strict_copy_error("a copy of the input was explicitly requested")
       return (x.copy(order="C"), True, d)
     else:
       return (x, False, d)
@@ -122,6 +168,9 @@ def to_matrix_with_info(x, dtype, copy=False):
     # If we get to here, then we are going to need to do some type conversion,
     # so go ahead and copy the dataframe and we'll work with y to make
     # modifications.
+    if _strict_zero_copy:
+      _strict_copy_error("the pandas data contains categorical columns that "
+          "must be converted")
     y = x
     d = np.zeros([x.shape[1]], dtype=np.bool)
 
@@ -152,6 +201,9 @@ def to_matrix_with_info(x, dtype, copy=False):
     return (t[0], True, d)
 
   if isinstance(x, list):
+    if _strict_zero_copy:
+      _strict_copy_error("the input is a Python list")
+
     # Get the number of dimensions.
     dims = 0
     if isinstance(x[0], list):
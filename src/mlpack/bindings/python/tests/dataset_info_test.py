@@ -15,6 +15,8 @@ import numpy as np
 
 from mlpack.matrix_utils import to_matrix
 from mlpack.matrix_utils import to_matrix_with_info
+from mlpack.matrix_utils import strict_zero_copy
+from mlpack.matrix_utils import strict_zero_copy_enabled
 
 class TestToMatrix(unittest.TestCase):
   """
@@ -306,6 +308,87 @@ class TestToMatrixWithInfo(unittest.TestCase):
     self.assertTrue(m[1] != m[2])
     self.assertTrue(m[0] != m[2])
 
+class TestStrictZeroCopy(unittest.TestCase):
+  """
+  This class defines tests for strict zero-copy mode, in which any conversion
+  that would copy the input raises instead.
+  """
+
+  def tearDown(self):
+    """
+    Always disable strict mode again so other tests are unaffected.
+    """
+    strict_zero_copy(False)
+
+  def testFlagToggle(self):
+    """
+    Test that the mode can be enabled and disabled.
+    """
+    self.assertFalse(strict_zero_copy_enabled())
+    strict_zero_copy()
+    self.assertTrue(strict_zero_copy_enabled())
+    strict_zero_copy(False)
+    self.assertFalse(strict_zero_copy_enabled())
+
+  def testNoCopyPathStillWorks(self):
+    """
+    Test that a C-contiguous double matrix passes through untouched in strict
+    mode.
+    """
+    strict_zero_copy()
+    a = np.random.randn(10, 4)
+
+    m, copied = to_matrix(a)
+
+    self.assertTrue(m is a)
+    self.assertFalse(copied)
+
+  def testFortranOrderRaises(self):
+    """
+    Test that a Fortran-ordered matrix raises in strict mode (it would
+    otherwise be copied to C order).
+    """
+    strict_zero_copy()
+    a = np.asfortranarray(np.random.randn(10, 4))
+
+    self.assertRaises(ValueError, to_matrix, a)
+
+    # Without strict mode the conversion copies and succeeds.
+    strict_zero_copy(False)
+    m, copied = to_matrix(a)
+    self.assertTrue(copied)
+
+  def testWrongDtypeRaises(self):
+    """
+    Test that a float32 matrix raises in strict mode (the bindings operate on
+    float64, so it would otherwise be copied and widened).
+    """
+    strict_zero_copy()
+    a = np.random.randn(10, 4).astype(np.float32)
+
+    self.assertRaises(ValueError, to_matrix, a)
+
+  def testListRaises(self):
+    """
+    Test that a Python list raises in strict mode.
+    """
+    strict_zero_copy()
+
+    self.assertRaises(ValueError, to_matrix, [[1.0, 2.0], [3.0, 4.0]])
+    self.assertRaises(ValueError, to_matrix_with_info,
+        [[1.0, 2.0], [3.0, 4.0]], np.double)
+
+  def testExplicitCopyRaises(self):
+    """
+    Test that requesting a copy of an otherwise-usable matrix raises in
+    strict mode; the two requests contradict each other.
+    """
+    strict_zero_copy()
+    a = np.random.randn(10, 4)
+
+    self.assertRaises(ValueError, to_matrix, a, np.double, True)
+    self.assertRaises(ValueError, to_matrix_with_info, a, np.double, True)
+
 def test_suite():
     """
     Run all tests.
@@ -314,6 +397,7 @@ def test_suite():
     suite = unittest.TestSuite()
     suite.addTest(loader.loadTestsFromTestCase(TestToMatrix))
     suite.addTest(loader.loadTestsFromTestCase(TestToMatrixWithInfo))
+    suite.addTest(loader.loadTestsFromTestCase(TestStrictZeroCopy))
     return suite
 
 if __name__ == '__main__':
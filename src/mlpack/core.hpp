@@ -71,8 +71,11 @@
 #include <mlpack/core/util/log.hpp>
 #include <mlpack/core/util/io.hpp>
 #include <mlpack/core/util/deprecated.hpp>
+#include <mlpack/core/util/telemetry.hpp>
+#include <mlpack/core/util/threads.hpp>
 #include <mlpack/core/data/load.hpp>
 #include <mlpack/core/data/save.hpp>
+#include <mlpack/core/data/save_async.hpp>
 #include <mlpack/core/data/normalize_labels.hpp>
 #include <mlpack/core/math/clamp.hpp>
 #include <mlpack/core/math/random.hpp>
@@ -25,6 +25,31 @@
  */
 namespace cereal {
 
+// Serialize a block of contiguous memory.  For the binary archives and
+// arithmetic element types the whole block is written as one raw blob, which
+// is byte-identical to serializing the elements one at a time (these archives
+// store untagged raw bytes either way) but avoids one archive dispatch per
+// element; text archives and non-arithmetic types fall back to the
+// element-wise loop.
+template<typename Archive, typename eT>
+typename std::enable_if<(is_raw_binary_archive<Archive>::value &&
+                         std::is_arithmetic<eT>::value), void>::type
+serialize_block(Archive& ar, eT* mem, const arma::uword count,
+                const char* /* name */)
+{
+  ar(binary_data(mem, count * sizeof(eT)));
+}
+
+template<typename Archive, typename eT>
+typename std::enable_if<!(is_raw_binary_archive<Archive>::value &&
+                          std::is_arithmetic<eT>::value), void>::type
+serialize_block(Archive& ar, eT* mem, const arma::uword count,
+                const char* name)
+{
+  for (size_t i = 0; i < count; ++i)
+    ar(make_nvp(name, mem[i]));
+}
+
 template<typename Archive, typename eT>
 void serialize(Archive& ar, arma::SpMat<eT>& mat)
 {
@@ -51,12 +76,11 @@ void serialize(Archive& ar, arma::SpMat<eT>& mat)
   }
 
   // Serialize the values held in the sparse matrix.
-  for (size_t i = 0; i < mat.n_nonzero; ++i)
-    ar(cereal::make_nvp("value", arma::access::rw(mat.values[i])));
-  for (size_t i = 0; i < mat.n_nonzero; ++i)
-    ar(cereal::make_nvp("row_index", arma::access::rw(mat.row_indices[i])));
-  for (size_t i = 0; i < mat.n_cols + 1; ++i)
-    ar(cereal::make_nvp("col_ptr", arma::access::rw(mat.col_ptrs[i])));
+  serialize_block(ar, arma::access::rwp(mat.values), mat.n_nonzero, "value");
+  serialize_block(ar, arma::access::rwp(mat.row_indices), mat.n_nonzero,
+      "row_index");
+  serialize_block(ar, arma::access::rwp(mat.col_ptrs), mat.n_cols + 1,
+      "col_ptr");
 }
 
 // Add an external serialization function for Mat.
@@ -79,8 +103,7 @@ void serialize(Archive& ar, arma::Mat<eT>& mat)
   }
 
   // Directly serialize the contents of the matrix's memory.
-  for (size_t i = 0; i < mat.n_elem; ++i)
-    ar(cereal::make_nvp("elem", arma::access::rw(mat.mem[i])));
+  serialize_block(ar, arma::access::rwp(mat.mem), mat.n_elem, "elem");
 }
 
 // Add a serialization function for armadillo Cube
@@ -100,8 +123,7 @@ void serialize(Archive& ar, arma::Cube<eT>& cube)
     cube.set_size(n_rows, n_cols, n_slices);
 
   // Directly serialize the contents of the cube's memory.
-  for (size_t i = 0; i < cube.n_elem; ++i)
-    ar(cereal::make_nvp("elem", arma::access::rw(cube.mem[i])));
+  serialize_block(ar, arma::access::rwp(cube.mem), cube.n_elem, "elem");
 }
 
 } // end namespace cereal
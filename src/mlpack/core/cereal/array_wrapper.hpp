@@ -21,6 +21,24 @@
 
 namespace cereal {
 
+/**
+ * Whether the archive stores elements as raw, untagged bytes (the binary and
+ * portable binary archives).  For these archives an array of arithmetic
+ * elements can be written as a single blob with binary_data(): the encoding
+ * is byte-identical to serializing the elements one at a time, so files
+ * written either way load interchangeably, but the bulk call avoids one
+ * archive dispatch per element.
+ */
+template<typename Archive>
+struct is_raw_binary_archive
+{
+  static const bool value =
+      std::is_same<Archive, BinaryInputArchive>::value ||
+      std::is_same<Archive, BinaryOutputArchive>::value ||
+      std::is_same<Archive, PortableBinaryInputArchive>::value ||
+      std::is_same<Archive, PortableBinaryOutputArchive>::value;
+};
+
 /**
  * This class is used as a shim for cereal to be able to serialize a raw pointer array.
  */
@@ -37,8 +55,7 @@ class ArrayWrapper
   void save(Archive& ar) const
   {
     ar(CEREAL_NVP(arraySize));
-    for (size_t i = 0; i < arraySize; ++i)
-      ar(cereal::make_nvp("item", arrayAddress[i]));
+    saveItems(ar);
   }
 
   template<class Archive>
@@ -52,11 +69,48 @@ class ArrayWrapper
       return;
     }
     arrayAddress = new T[arraySize];
+    loadItems(ar);
+  }
+
+ private:
+  //! Write arithmetic items to a binary archive as one raw blob.
+  template<class Archive>
+  typename std::enable_if<(is_raw_binary_archive<Archive>::value &&
+                           std::is_arithmetic<T>::value), void>::type
+  saveItems(Archive& ar) const
+  {
+    ar(binary_data(arrayAddress, arraySize * sizeof(T)));
+  }
+
+  //! Write items one at a time (text archives or non-arithmetic items).
+  template<class Archive>
+  typename std::enable_if<!(is_raw_binary_archive<Archive>::value &&
+                            std::is_arithmetic<T>::value), void>::type
+  saveItems(Archive& ar) const
+  {
+    for (size_t i = 0; i < arraySize; ++i)
+      ar(cereal::make_nvp("item", arrayAddress[i]));
+  }
+
+  //! Read arithmetic items from a binary archive as one raw blob.
+  template<class Archive>
+  typename std::enable_if<(is_raw_binary_archive<Archive>::value &&
+                           std::is_arithmetic<T>::value), void>::type
+  loadItems(Archive& ar)
+  {
+    ar(binary_data(arrayAddress, arraySize * sizeof(T)));
+  }
+
+  //! Read items one at a time (text archives or non-arithmetic items).
+  template<class Archive>
+  typename std::enable_if<!(is_raw_binary_archive<Archive>::value &&
+                            std::is_arithmetic<T>::value), void>::type
+  loadItems(Archive& ar)
+  {
     for (size_t i = 0; i < arraySize; ++i)
       ar(cereal::make_nvp("item", arrayAddress[i]));
   }
 
- private:
   ArrayWrapper& operator=(ArrayWrapper rhs);
 
   T*& arrayAddress;
@@ -14,6 +14,7 @@
 
 #include <mlpack/core/cv/meta_info_extractor.hpp>
 #include <mlpack/core/cv/cv_base.hpp>
+#include <mlpack/core/cv/metrics/multi_metric.hpp>
 
 namespace mlpack {
 namespace cv {
@@ -177,6 +178,27 @@ class KFoldCV
   template<typename... MLAlgorithmArgs>
   double Evaluate(const MLAlgorithmArgs& ...args);
 
+  /**
+   * Run k-fold cross-validation computing several metrics from a single
+   * prediction pass per fold, instead of rerunning prediction once per
+   * metric.  The metrics are given as explicit template arguments and must
+   * all work on the same kind of predictions (see MultiMetric):
+   *
+   * @code
+   * arma::vec results =
+   *     cv.template EvaluateMetrics<Accuracy, F1<Binary>>(lambda);
+   * @endcode
+   *
+   * @tparam Metrics The metrics to compute; each must provide an Evaluate()
+   *     overload over already computed predictions (e.g. Accuracy, F1, MSE).
+   * @param args Arguments for MLAlgorithm (in addition to the passed
+   *     ones in the constructor).
+   * @return A vector holding the average of each metric over the folds, in
+   *     the order of the template arguments.
+   */
+  template<typename... Metrics, typename... MLAlgorithmArgs>
+  arma::vec EvaluateMetrics(const MLAlgorithmArgs& ...args);
+
   //! Access and modify a model from the last run of k-fold cross-validation.
   MLAlgorithm& Model();
 
@@ -270,6 +292,27 @@ class KFoldCV
            typename = void>
   double TrainAndEvaluate(const MLAlgorithmArgs& ...mlAlgorithmArgs);
 
+  /**
+   * Train and compute several metrics per fold in the case of non-weighted
+   * learning.
+   */
+  template<typename... Metrics,
+           typename... MLAlgorithmArgs,
+           bool Enabled = !Base::MIE::SupportsWeights,
+           typename = typename std::enable_if<Enabled>::type>
+  arma::vec TrainAndEvaluateMetrics(const MLAlgorithmArgs& ...mlAlgorithmArgs);
+
+  /**
+   * Train and compute several metrics per fold in the case of supporting
+   * weighted learning.
+   */
+  template<typename... Metrics,
+           typename... MLAlgorithmArgs,
+           bool Enabled = Base::MIE::SupportsWeights,
+           typename = typename std::enable_if<Enabled>::type,
+           typename = void>
+  arma::vec TrainAndEvaluateMetrics(const MLAlgorithmArgs& ...mlAlgorithmArgs);
+
   /**
    * Calculate the index of the first column of the ith validation subset.
    *
@@ -194,6 +194,21 @@ double KFoldCV<MLAlgorithm,
   return TrainAndEvaluate(args...);
 }
 
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... Metrics, typename... MLAlgorithmArgs>
+arma::vec KFoldCV<MLAlgorithm,
+                  Metric,
+                  MatType,
+                  PredictionsType,
+                  WeightsType>::EvaluateMetrics(const MLAlgorithmArgs&... args)
+{
+  return TrainAndEvaluateMetrics<Metrics...>(args...);
+}
+
 template<typename MLAlgorithm,
          typename Metric,
          typename MatType,
@@ -246,8 +261,11 @@ double KFoldCV<MLAlgorithm,
 {
   arma::vec evaluations(k);
 
+  // Every fold trains an independent model on its own alias into the circular
+  // dataset, so the folds can run in parallel without copying any subsets.
   size_t numInvalidScores = 0;
-  for (size_t i = 0; i < k; ++i)
+  #pragma omp parallel for reduction(+ : numInvalidScores)
+  for (omp_size_t i = 0; i < (omp_size_t) k; ++i)
   {
     MLAlgorithm&& model  = base.Train(GetTrainingSubset(xs, i),
         GetTrainingSubset(ys, i), args...);
@@ -256,11 +274,12 @@ double KFoldCV<MLAlgorithm,
     if (std::isnan(evaluations(i)) || std::isinf(evaluations(i)))
     {
       ++numInvalidScores;
+      #pragma omp critical (KFoldCVTrainAndEvaluate)
       Log::Warn << "KFoldCV::TrainAndEvaluate(): fold " << i << " returned "
           << "a score of " << evaluations(i) << "; ignoring when computing "
           << "the average score." << std::endl;
     }
-    if (i == k - 1)
+    if (i == (omp_size_t) k - 1)
       modelPtr.reset(new MLAlgorithm(std::move(model)));
   }
 
@@ -288,7 +307,10 @@ double KFoldCV<MLAlgorithm,
 {
   arma::vec evaluations(k);
 
-  for (size_t i = 0; i < k; ++i)
+  // Every fold trains an independent model on its own alias into the circular
+  // dataset, so the folds can run in parallel without copying any subsets.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) k; ++i)
   {
     MLAlgorithm&& model = (weights.n_elem > 0) ?
         base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
@@ -297,13 +319,84 @@ double KFoldCV<MLAlgorithm,
             args...);
     evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
         GetValidationSubset(ys, i));
-    if (i == k - 1)
+    if (i == (omp_size_t) k - 1)
       modelPtr.reset(new MLAlgorithm(std::move(model)));
   }
 
   return arma::mean(evaluations);
 }
 
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... Metrics, typename... MLAlgorithmArgs, bool Enabled,
+         typename>
+arma::vec KFoldCV<MLAlgorithm,
+                  Metric,
+                  MatType,
+                  PredictionsType,
+                  WeightsType>::TrainAndEvaluateMetrics(
+    const MLAlgorithmArgs&... args)
+{
+  arma::mat evaluations(MultiMetric<Metrics...>::NumMetrics, k);
+
+  // Every fold trains an independent model on its own alias into the circular
+  // dataset, so the folds can run in parallel without copying any subsets;
+  // prediction runs once per fold and all metrics are computed from the
+  // cached predictions.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) k; ++i)
+  {
+    MLAlgorithm&& model = base.Train(GetTrainingSubset(xs, i),
+        GetTrainingSubset(ys, i), args...);
+    evaluations.col(i) = MultiMetric<Metrics...>::Evaluate(model,
+        GetValidationSubset(xs, i), GetValidationSubset(ys, i));
+    if (i == (omp_size_t) k - 1)
+      modelPtr.reset(new MLAlgorithm(std::move(model)));
+  }
+
+  return arma::mean(evaluations, 1);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... Metrics, typename... MLAlgorithmArgs, bool Enabled,
+         typename, typename>
+arma::vec KFoldCV<MLAlgorithm,
+                  Metric,
+                  MatType,
+                  PredictionsType,
+                  WeightsType>::TrainAndEvaluateMetrics(
+    const MLAlgorithmArgs&... args)
+{
+  arma::mat evaluations(MultiMetric<Metrics...>::NumMetrics, k);
+
+  // Every fold trains an independent model on its own alias into the circular
+  // dataset, so the folds can run in parallel without copying any subsets;
+  // prediction runs once per fold and all metrics are computed from the
+  // cached predictions.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) k; ++i)
+  {
+    MLAlgorithm&& model = (weights.n_elem > 0) ?
+        base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
+            GetTrainingSubset(weights, i), args...) :
+        base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
+            args...);
+    evaluations.col(i) = MultiMetric<Metrics...>::Evaluate(model,
+        GetValidationSubset(xs, i), GetValidationSubset(ys, i));
+    if (i == (omp_size_t) k - 1)
+      modelPtr.reset(new MLAlgorithm(std::move(model)));
+  }
+
+  return arma::mean(evaluations, 1);
+}
+
 template<typename MLAlgorithm,
          typename Metric,
          typename MatType,
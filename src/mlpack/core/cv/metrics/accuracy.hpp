@@ -37,6 +37,16 @@ class Accuracy
                          const DataType& data,
                          const arma::Row<size_t>& labels);
 
+  /**
+   * Calculate accuracy from predictions that have already been computed, so
+   * that classification does not need to be rerun.
+   *
+   * @param predictedLabels Labels predicted by a model.
+   * @param labels Ground truth (correct) labels for the test items.
+   */
+  static double Evaluate(const arma::Row<size_t>& predictedLabels,
+                         const arma::Row<size_t>& labels);
+
   /**
    * Information for hyper-parameter tuning code. It indicates that we want
    * to maximize the metric.
@@ -26,6 +26,13 @@ double Accuracy::Evaluate(MLAlgorithm& model,
 
   arma::Row<size_t> predictedLabels;
   model.Classify(data, predictedLabels);
+
+  return Evaluate(predictedLabels, labels);
+}
+
+inline double Accuracy::Evaluate(const arma::Row<size_t>& predictedLabels,
+                                 const arma::Row<size_t>& labels)
+{
   size_t amountOfCorrectPredictions = arma::sum(predictedLabels == labels);
 
   return (double) amountOfCorrectPredictions / labels.n_elem;
@@ -57,6 +57,16 @@ class F1
                          const DataType& data,
                          const arma::Row<size_t>& labels);
 
+  /**
+   * Calculate F1 from predictions that have already been computed, so that
+   * classification does not need to be rerun.
+   *
+   * @param predictedLabels Labels predicted by a model.
+   * @param labels Ground truth (correct) labels for the test items.
+   */
+  static double Evaluate(const arma::Row<size_t>& predictedLabels,
+                         const arma::Row<size_t>& labels);
+
   /**
    * Information for hyper-parameter tuning code. It indicates that we want
    * to maximize the metric.
@@ -99,6 +109,33 @@ class F1
   static double Evaluate(MLAlgorithm& model,
                         const DataType& data,
                         const arma::Row<size_t>& labels);
+
+  /**
+   * Calculate F1 for binary classification from already computed predictions.
+   */
+  template<AverageStrategy _AS,
+           typename = std::enable_if_t<_AS == Binary>>
+  static double Evaluate(const arma::Row<size_t>& predictedLabels,
+                         const arma::Row<size_t>& labels);
+
+  /**
+   * Calculate microaveraged F1 from already computed predictions.
+   */
+  template<AverageStrategy _AS,
+           typename = std::enable_if_t<_AS == Micro>,
+           typename = void>
+  static double Evaluate(const arma::Row<size_t>& predictedLabels,
+                         const arma::Row<size_t>& labels);
+
+  /**
+   * Calculate macroaveraged F1 from already computed predictions.
+   */
+  template<AverageStrategy _AS,
+           typename = std::enable_if_t<_AS == Macro>,
+           typename = void,
+           typename = void>
+  static double Evaluate(const arma::Row<size_t>& predictedLabels,
+                         const arma::Row<size_t>& labels);
 };
 
 } // namespace cv
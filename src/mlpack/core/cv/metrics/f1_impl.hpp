@@ -27,6 +27,13 @@ double F1<AS, PC>::Evaluate(MLAlgorithm& model,
   return Evaluate<AS>(model, data, labels);
 }
 
+template<AverageStrategy AS, size_t PC /* PositiveClass */>
+double F1<AS, PC>::Evaluate(const arma::Row<size_t>& predictedLabels,
+                            const arma::Row<size_t>& labels)
+{
+  return Evaluate<AS>(predictedLabels, labels);
+}
+
 template<AverageStrategy AS, size_t PC /* PositiveClass */>
 template<AverageStrategy _AS, typename MLAlgorithm, typename DataType, typename>
 double F1<AS, PC>::Evaluate(MLAlgorithm& model,
@@ -38,6 +45,28 @@ double F1<AS, PC>::Evaluate(MLAlgorithm& model,
   arma::Row<size_t> predictedLabels;
   model.Classify(data, predictedLabels);
 
+  return Evaluate<_AS>(predictedLabels, labels);
+}
+
+template<AverageStrategy AS, size_t PC /* PositiveClass */>
+template<AverageStrategy _AS, typename MLAlgorithm, typename DataType, typename,
+    typename>
+double F1<AS, PC>::Evaluate(MLAlgorithm& model,
+                            const DataType& data,
+                            const arma::Row<size_t>& labels)
+{
+  AssertSizes(data, labels, "F1<Micro>::Evaluate()");
+
+  // Microaveraged F1 is really the same as microaveraged precision and
+  // microaveraged recall, which are in turn the same as accuracy.
+  return Accuracy::Evaluate(model, data, labels);
+}
+
+template<AverageStrategy AS, size_t PC /* PositiveClass */>
+template<AverageStrategy _AS, typename>
+double F1<AS, PC>::Evaluate(const arma::Row<size_t>& predictedLabels,
+                            const arma::Row<size_t>& labels)
+{
   size_t tp = arma::sum((labels == PC) % (predictedLabels == PC));
   size_t numberOfPositivePredictions = arma::sum(predictedLabels == PC);
   size_t numberOfPositiveClassInstances = arma::sum(labels == PC);
@@ -50,17 +79,13 @@ double F1<AS, PC>::Evaluate(MLAlgorithm& model,
 }
 
 template<AverageStrategy AS, size_t PC /* PositiveClass */>
-template<AverageStrategy _AS, typename MLAlgorithm, typename DataType, typename,
-    typename>
-double F1<AS, PC>::Evaluate(MLAlgorithm& model,
-                            const DataType& data,
+template<AverageStrategy _AS, typename, typename>
+double F1<AS, PC>::Evaluate(const arma::Row<size_t>& predictedLabels,
                             const arma::Row<size_t>& labels)
 {
-  AssertSizes(data, labels, "F1<Micro>::Evaluate()");
-
   // Microaveraged F1 is really the same as microaveraged precision and
   // microaveraged recall, which are in turn the same as accuracy.
-  return Accuracy::Evaluate(model, data, labels);
+  return Accuracy::Evaluate(predictedLabels, labels);
 }
 
 template<AverageStrategy AS, size_t PC /* PositiveClass */>
@@ -75,6 +100,14 @@ double F1<AS, PC>::Evaluate(MLAlgorithm& model,
   arma::Row<size_t> predictedLabels;
   model.Classify(data, predictedLabels);
 
+  return Evaluate<_AS>(predictedLabels, labels);
+}
+
+template<AverageStrategy AS, size_t PC /* PositiveClass */>
+template<AverageStrategy _AS, typename, typename, typename>
+double F1<AS, PC>::Evaluate(const arma::Row<size_t>& predictedLabels,
+                            const arma::Row<size_t>& labels)
+{
   size_t numClasses = arma::max(labels) + 1;
 
   arma::vec f1s = arma::vec(numClasses);
@@ -38,6 +38,17 @@ class MSE
                          const DataType& data,
                          const ResponsesType& responses);
 
+  /**
+   * Calculate the mean squared error from predictions that have already been
+   * computed, so that prediction does not need to be rerun.
+   *
+   * @param predictedResponses Target values predicted by a model.
+   * @param responses Ground truth (correct) target values for the test items.
+   */
+  template<typename ResponsesType>
+  static double Evaluate(const ResponsesType& predictedResponses,
+                         const ResponsesType& responses);
+
   /**
    * Information for hyper-parameter tuning code. It indicates that we want
    * to minimize the measurement.
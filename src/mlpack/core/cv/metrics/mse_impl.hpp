@@ -31,6 +31,14 @@ double MSE::Evaluate(MLAlgorithm& model,
 
   ResponsesType predictedResponses;
   model.Predict(data, predictedResponses);
+
+  return Evaluate(predictedResponses, responses);
+}
+
+template<typename ResponsesType>
+double MSE::Evaluate(const ResponsesType& predictedResponses,
+                     const ResponsesType& responses)
+{
   double sum = arma::accu(arma::square(responses - predictedResponses));
 
   return sum / responses.n_elem;
@@ -0,0 +1,121 @@
+/**
+ * @file core/cv/metrics/multi_metric.hpp
+ *
+ * A wrapper that computes several metrics from a single prediction pass.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CV_METRICS_MULTI_METRIC_HPP
+#define MLPACK_CORE_CV_METRICS_MULTI_METRIC_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+namespace cv {
+
+/**
+ * MultiMetric computes several metrics for the same model from one run of
+ * prediction.  Each wrapped metric on its own calls Classify() or Predict()
+ * when it is evaluated, so evaluating three metrics separately runs inference
+ * three times; MultiMetric runs it once and computes every metric from the
+ * cached predictions.
+ *
+ * Each wrapped metric must provide an Evaluate() overload over already
+ * computed predictions, as Accuracy, F1 and MSE do.  The wrapped metrics must
+ * all work on the same kind of predictions: classification metrics
+ * (arma::Row<size_t> labels) and regression metrics cannot be mixed in one
+ * MultiMetric.  Whether Classify() or Predict() is called is decided by the
+ * type of the passed ground truth: arma::Row<size_t> selects Classify().
+ *
+ * @code
+ * LogisticRegression<> lr(data, labels);
+ * arma::vec results =
+ *     MultiMetric<Accuracy, F1<Binary>>::Evaluate(lr, data, labels);
+ * // results[0] is the accuracy and results[1] is the F1 score.
+ * @endcode
+ *
+ * @tparam FirstMetric The first metric to compute.
+ * @tparam OtherMetrics The remaining metrics to compute.
+ */
+template<typename FirstMetric, typename... OtherMetrics>
+class MultiMetric
+{
+ public:
+  //! The number of metrics computed by Evaluate().
+  static const size_t NumMetrics = 1 + sizeof...(OtherMetrics);
+
+  /**
+   * Run prediction once and calculate every metric from the cached
+   * predictions.
+   *
+   * @param model A model to evaluate.
+   * @param data Column-major data containing test items.
+   * @param responses Ground truth (correct) labels or responses for the test
+   *     items.
+   * @return A vector holding the value of each metric, in the order of the
+   *     template arguments.
+   */
+  template<typename MLAlgorithm, typename DataType, typename ResponsesType>
+  static arma::vec Evaluate(MLAlgorithm& model,
+                            const DataType& data,
+                            const ResponsesType& responses);
+
+  /**
+   * Run prediction once and calculate every metric together with a bootstrap
+   * confidence interval.  The test items are resampled with replacement the
+   * given number of times, each metric is recomputed from the cached
+   * predictions of every resample in parallel, and the percentile interval of
+   * the resampled values is reported.
+   *
+   * @param model A model to evaluate.
+   * @param data Column-major data containing test items.
+   * @param responses Ground truth (correct) labels or responses for the test
+   *     items.
+   * @param samples Number of bootstrap resamples to draw.
+   * @param confidence Coverage of the reported interval (between 0 and 1).
+   * @return A matrix with one row per metric, in the order of the template
+   *     arguments; the columns hold the point estimate, the lower bound and
+   *     the upper bound of the interval.
+   */
+  template<typename MLAlgorithm, typename DataType, typename ResponsesType>
+  static arma::mat BootstrapEvaluate(MLAlgorithm& model,
+                                     const DataType& data,
+                                     const ResponsesType& responses,
+                                     const size_t samples = 1000,
+                                     const double confidence = 0.95);
+
+ private:
+  /**
+   * Compute every metric from the given cached predictions.
+   */
+  template<typename ResponsesType>
+  static arma::vec ComputeMetrics(const ResponsesType& predictions,
+                                  const ResponsesType& responses);
+
+  /**
+   * Run classification; selected when the ground truth is a row of labels.
+   */
+  template<typename MLAlgorithm, typename DataType>
+  static void Predict(MLAlgorithm& model,
+                      const DataType& data,
+                      arma::Row<size_t>& predictions);
+
+  /**
+   * Run regression prediction; selected for any other ground truth type.
+   */
+  template<typename MLAlgorithm, typename DataType, typename ResponsesType>
+  static void Predict(MLAlgorithm& model,
+                      const DataType& data,
+                      ResponsesType& predictions);
+};
+
+} // namespace cv
+} // namespace mlpack
+
+// Include implementation.
+#include "multi_metric_impl.hpp"
+
+#endif
@@ -0,0 +1,135 @@
+/**
+ * @file core/cv/metrics/multi_metric_impl.hpp
+ *
+ * Implementation of the class MultiMetric.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CV_METRICS_MULTI_METRIC_IMPL_HPP
+#define MLPACK_CORE_CV_METRICS_MULTI_METRIC_IMPL_HPP
+
+namespace mlpack {
+namespace cv {
+
+template<typename FirstMetric, typename... OtherMetrics>
+template<typename MLAlgorithm, typename DataType, typename ResponsesType>
+arma::vec MultiMetric<FirstMetric, OtherMetrics...>::Evaluate(
+    MLAlgorithm& model,
+    const DataType& data,
+    const ResponsesType& responses)
+{
+  if (data.n_cols != responses.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "MultiMetric::Evaluate(): number of points (" << data.n_cols
+        << ") does not match number of responses (" << responses.n_cols
+        << ")!" << std::endl;
+    throw std::invalid_argument(oss.str());
+  }
+
+  ResponsesType predictions;
+  Predict(model, data, predictions);
+
+  return ComputeMetrics(predictions, responses);
+}
+
+template<typename FirstMetric, typename... OtherMetrics>
+template<typename MLAlgorithm, typename DataType, typename ResponsesType>
+arma::mat MultiMetric<FirstMetric, OtherMetrics...>::BootstrapEvaluate(
+    MLAlgorithm& model,
+    const DataType& data,
+    const ResponsesType& responses,
+    const size_t samples,
+    const double confidence)
+{
+  if (samples == 0)
+  {
+    throw std::invalid_argument("MultiMetric::BootstrapEvaluate(): number of "
+        "bootstrap samples must be positive!");
+  }
+
+  if (confidence <= 0.0 || confidence >= 1.0)
+  {
+    throw std::invalid_argument("MultiMetric::BootstrapEvaluate(): "
+        "confidence must be between 0 and 1!");
+  }
+
+  ResponsesType predictions;
+  Predict(model, data, predictions);
+
+  // Draw every resample up front; the global random number generator is not
+  // thread-safe.
+  const size_t numPoints = responses.n_cols;
+  arma::umat indices(numPoints, samples);
+  for (size_t s = 0; s < samples; ++s)
+    for (size_t i = 0; i < numPoints; ++i)
+      indices(i, s) = (arma::uword) math::RandInt(numPoints);
+
+  // The metrics of each resample only read the cached predictions, so the
+  // resamples can be evaluated in parallel.
+  arma::mat evaluations(NumMetrics, samples);
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t s = 0; s < (omp_size_t) samples; ++s)
+  {
+    const arma::uvec sampleIndices = indices.col(s);
+    evaluations.col(s) = ComputeMetrics(
+        ResponsesType(predictions.cols(sampleIndices)),
+        ResponsesType(responses.cols(sampleIndices)));
+  }
+
+  // Report the percentile interval of the resampled values around the point
+  // estimate computed from the full set of predictions.
+  const double lowerQuantile = (1.0 - confidence) / 2.0;
+  arma::mat result(NumMetrics, 3);
+  result.col(0) = ComputeMetrics(predictions, responses);
+  for (size_t m = 0; m < NumMetrics; ++m)
+  {
+    const arma::rowvec sorted = arma::sort(evaluations.row(m));
+    result(m, 1) = sorted[(size_t) std::floor(lowerQuantile * (samples - 1))];
+    result(m, 2) = sorted[(size_t) std::ceil((1.0 - lowerQuantile) *
+        (samples - 1))];
+  }
+
+  return result;
+}
+
+template<typename FirstMetric, typename... OtherMetrics>
+template<typename ResponsesType>
+arma::vec MultiMetric<FirstMetric, OtherMetrics...>::ComputeMetrics(
+    const ResponsesType& predictions,
+    const ResponsesType& responses)
+{
+  const double evaluations[NumMetrics] = {
+      FirstMetric::Evaluate(predictions, responses),
+      OtherMetrics::Evaluate(predictions, responses)... };
+
+  return arma::vec(evaluations, NumMetrics);
+}
+
+template<typename FirstMetric, typename... OtherMetrics>
+template<typename MLAlgorithm, typename DataType>
+void MultiMetric<FirstMetric, OtherMetrics...>::Predict(
+    MLAlgorithm& model,
+    const DataType& data,
+    arma::Row<size_t>& predictions)
+{
+  model.Classify(data, predictions);
+}
+
+template<typename FirstMetric, typename... OtherMetrics>
+template<typename MLAlgorithm, typename DataType, typename ResponsesType>
+void MultiMetric<FirstMetric, OtherMetrics...>::Predict(
+    MLAlgorithm& model,
+    const DataType& data,
+    ResponsesType& predictions)
+{
+  model.Predict(data, predictions);
+}
+
+} // namespace cv
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,148 @@
+/**
+ * @file core/data/chunked_reader.hpp
+ *
+ * Defines the ChunkedReader class, a streaming loader that yields fixed-size
+ * column blocks of a CSV or ARFF file, so that datasets too large to fit in
+ * memory can be traversed chunk by chunk.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_CHUNKED_READER_HPP
+#define MLPACK_CORE_DATA_CHUNKED_READER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <fstream>
+
+#include "dataset_mapper.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * The ChunkedReader class reads a delimited data file one fixed-size chunk
+ * of points at a time, instead of materializing the whole matrix the way
+ * data::Load() does.  A single DatasetMapper is kept across all chunks, so
+ * categorical values map to the same codes no matter which chunk they appear
+ * in, and the mapper can be handed to downstream consumers such as
+ * HoeffdingTree, the incremental NaiveBayesClassifier::Train() overload, or
+ * any SGD-based trainer that accepts data in batches.
+ *
+ * ARFF files (detected by their extension or an \@relation header) have
+ * their \@attribute declarations parsed up front: the dimensionality and the
+ * type of every dimension are fixed before the first chunk is read, and the
+ * values of nominal attributes are mapped in declaration order.  For plain
+ * CSV/TSV files the dimensionality is taken from the first data line and
+ * every token is passed through the DatasetMapper: a dimension becomes
+ * categorical the first time a token in it fails to parse as a number.  Note
+ * that with CSV input, numeric values of such a dimension read in *earlier*
+ * chunks are kept as parsed numbers, so files whose categorical dimensions
+ * also contain numeric-looking tokens should either be read as ARFF or have
+ * the affected dimension types set on Info() before the first ReadChunk()
+ * call.
+ *
+ * The reader handles the simple quoting dialect of the repository's loaders:
+ * fields may be wrapped in single or double quotes, in which case delimiters
+ * inside the quotes are not treated as field separators.  Comment lines
+ * ('\%' for ARFF, '#' for CSV) and blank lines are skipped.
+ */
+class ChunkedReader
+{
+ public:
+  /**
+   * Open the given file and prepare for chunked reading.  For ARFF files the
+   * header is parsed immediately; for CSV files the first data line
+   * determines the dimensionality.
+   *
+   * @param filename Name of the file to read.
+   * @param chunkSize Number of points (columns) per chunk.
+   * @param delimiter Field delimiter for CSV files (',' for CSV, '\t' for
+   *      TSV); ignored for ARFF files, which always use ','.
+   */
+  ChunkedReader(const std::string& filename,
+                const size_t chunkSize = 10000,
+                const char delimiter = ',');
+
+  /**
+   * Read the next chunk of points into the given matrix, following mlpack's
+   * column-major convention (one column per point).  The matrix is sized to
+   * the number of points actually read, which is less than ChunkSize() only
+   * at the end of the file.
+   *
+   * @param chunk Matrix to store the chunk in, dim(Dimensionality(), n).
+   * @return The number of points read; 0 when the file is exhausted.
+   */
+  template<typename eT>
+  size_t ReadChunk(arma::Mat<eT>& chunk);
+
+  /**
+   * Rewind the reader to the beginning of the data section.  The
+   * DatasetMapper state is kept, so a second pass maps categorical values to
+   * the same codes as the first.
+   */
+  void Reset();
+
+  //! Get the DatasetMapper holding the dimension types and the category
+  //! mappings accumulated so far.
+  const DatasetInfo& Info() const { return info; }
+  //! Modify the DatasetMapper (e.g. to pre-set dimension types).
+  DatasetInfo& Info() { return info; }
+
+  //! Get the dimensionality of the dataset.
+  size_t Dimensionality() const { return dimensionality; }
+
+  //! Get the number of points per chunk.
+  size_t ChunkSize() const { return chunkSize; }
+  //! Modify the number of points per chunk.
+  size_t& ChunkSize() { return chunkSize; }
+
+ private:
+  /**
+   * Parse the ARFF header, setting the dimensionality and the dimension
+   * types and leaving the stream at the beginning of the \@data section.
+   */
+  void ParseARFFHeader();
+
+  /**
+   * Split the given line into trimmed fields, honoring single and double
+   * quotes around fields.
+   *
+   * @param line The line to split.
+   * @param tokens Vector the fields are written into.
+   */
+  void SplitLine(const std::string& line,
+                 std::vector<std::string>& tokens) const;
+
+  /**
+   * Strip leading and trailing whitespace from the given string in place.
+   *
+   * @param s The string to trim.
+   */
+  static void Trim(std::string& s);
+
+  //! The stream the chunks are read from.
+  std::ifstream stream;
+  //! Number of points per chunk.
+  size_t chunkSize;
+  //! Field delimiter.
+  char delimiter;
+  //! Whether the file is an ARFF file.
+  bool isArff;
+  //! Dimensionality of the dataset.
+  size_t dimensionality;
+  //! Stream position of the beginning of the data section.
+  std::streampos dataStart;
+  //! Mapper holding the dimension types and categorical mappings; shared
+  //! across all chunks.
+  DatasetInfo info;
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "chunked_reader_impl.hpp"
+
+#endif
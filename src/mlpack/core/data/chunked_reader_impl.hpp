@@ -0,0 +1,306 @@
+/**
+ * @file core/data/chunked_reader_impl.hpp
+ *
+ * Implementation of the ChunkedReader class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_CHUNKED_READER_IMPL_HPP
+#define MLPACK_CORE_DATA_CHUNKED_READER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "chunked_reader.hpp"
+#include "extension.hpp"
+
+#include <algorithm>
+
+namespace mlpack {
+namespace data {
+
+inline ChunkedReader::ChunkedReader(const std::string& filename,
+                                    const size_t chunkSize,
+                                    const char delimiter) :
+    stream(filename),
+    chunkSize(chunkSize),
+    delimiter(delimiter),
+    isArff(false),
+    dimensionality(0),
+    dataStart(0)
+{
+  if (!stream.is_open())
+  {
+    throw std::runtime_error("ChunkedReader: cannot open file '" + filename +
+        "'!");
+  }
+
+  // Detect ARFF input by the extension, or by an @relation header for files
+  // with a different extension.
+  if (Extension(filename) == "arff")
+  {
+    isArff = true;
+  }
+  else
+  {
+    std::string line;
+    while (std::getline(stream, line))
+    {
+      Trim(line);
+      if (line.empty())
+        continue;
+
+      std::string start = line.substr(0, 9);
+      std::transform(start.begin(), start.end(), start.begin(), ::tolower);
+      isArff = (start == "@relation");
+      break;
+    }
+    stream.clear();
+    stream.seekg(0);
+  }
+
+  if (isArff)
+  {
+    // The ARFF data section is always comma separated.
+    this->delimiter = ',';
+    ParseARFFHeader();
+  }
+  else
+  {
+    // Determine the dimensionality from the first data line; the stream is
+    // rewound afterwards so that the line is part of the first chunk.
+    std::string line;
+    std::vector<std::string> tokens;
+    while (std::getline(stream, line))
+    {
+      Trim(line);
+      if (line.empty() || line[0] == '#')
+        continue;
+
+      SplitLine(line, tokens);
+      dimensionality = tokens.size();
+      break;
+    }
+
+    if (dimensionality == 0)
+    {
+      throw std::runtime_error("ChunkedReader: no data found in file '" +
+          filename + "'!");
+    }
+
+    info.SetDimensionality(dimensionality);
+    stream.clear();
+    stream.seekg(0);
+    dataStart = stream.tellg();
+  }
+}
+
+inline void ChunkedReader::ParseARFFHeader()
+{
+  std::string line;
+  std::vector<Datatype> types;
+  std::vector<std::vector<std::string>> nominalValues;
+  bool sawData = false;
+
+  while (std::getline(stream, line))
+  {
+    Trim(line);
+    if (line.empty() || line[0] == '%')
+      continue;
+    if (line[0] != '@')
+    {
+      throw std::runtime_error("ChunkedReader: malformed ARFF header line '" +
+          line + "'!");
+    }
+
+    // Extract the lowercased keyword following the '@'.
+    const size_t space = line.find_first_of(" \t");
+    std::string keyword = line.substr(1,
+        (space == std::string::npos) ? std::string::npos : space - 1);
+    std::transform(keyword.begin(), keyword.end(), keyword.begin(),
+        ::tolower);
+
+    if (keyword == "data")
+    {
+      sawData = true;
+      dataStart = stream.tellg();
+      break;
+    }
+
+    if (keyword != "attribute" || space == std::string::npos)
+      continue; // @relation and unknown directives are ignored.
+
+    // Parse "@attribute <name> <type>"; the name may be quoted.
+    std::string rest = line.substr(space);
+    Trim(rest);
+    if (!rest.empty() && (rest[0] == '"' || rest[0] == '\''))
+    {
+      const size_t nameEnd = rest.find(rest[0], 1);
+      if (nameEnd == std::string::npos)
+      {
+        throw std::runtime_error("ChunkedReader: unterminated attribute name "
+            "in ARFF header line '" + line + "'!");
+      }
+      rest = rest.substr(nameEnd + 1);
+    }
+    else
+    {
+      const size_t nameEnd = rest.find_first_of(" \t");
+      if (nameEnd == std::string::npos)
+      {
+        throw std::runtime_error("ChunkedReader: missing attribute type in "
+            "ARFF header line '" + line + "'!");
+      }
+      rest = rest.substr(nameEnd);
+    }
+    Trim(rest);
+
+    std::string typeSpec = rest;
+    std::transform(typeSpec.begin(), typeSpec.end(), typeSpec.begin(),
+        ::tolower);
+
+    if (!rest.empty() && rest[0] == '{')
+    {
+      // Nominal attribute: remember the declared values, so they can be
+      // mapped in declaration order before any data is read.
+      const size_t close = rest.find('}');
+      if (close == std::string::npos)
+      {
+        throw std::runtime_error("ChunkedReader: unterminated nominal "
+            "specification in ARFF header line '" + line + "'!");
+      }
+
+      std::vector<std::string> values;
+      SplitLine(rest.substr(1, close - 1), values);
+      types.push_back(Datatype::categorical);
+      nominalValues.push_back(values);
+    }
+    else if (typeSpec == "string")
+    {
+      types.push_back(Datatype::categorical);
+      nominalValues.push_back(std::vector<std::string>());
+    }
+    else if (typeSpec == "numeric" || typeSpec == "real" ||
+             typeSpec == "integer")
+    {
+      types.push_back(Datatype::numeric);
+      nominalValues.push_back(std::vector<std::string>());
+    }
+    else
+    {
+      throw std::runtime_error("ChunkedReader: unsupported ARFF attribute "
+          "type '" + rest + "'!");
+    }
+  }
+
+  if (!sawData)
+    throw std::runtime_error("ChunkedReader: no @data section found!");
+
+  dimensionality = types.size();
+  info.SetDimensionality(dimensionality);
+  for (size_t d = 0; d < dimensionality; ++d)
+  {
+    if (types[d] != Datatype::categorical)
+      continue;
+
+    // Mark the dimension categorical before mapping, so that declared
+    // nominal values that happen to look numeric are mapped too.  String
+    // attributes have no declared values; theirs are mapped as they appear.
+    info.Type(d) = Datatype::categorical;
+    for (size_t v = 0; v < nominalValues[d].size(); ++v)
+      info.MapString<size_t>(nominalValues[d][v], d);
+  }
+}
+
+template<typename eT>
+size_t ChunkedReader::ReadChunk(arma::Mat<eT>& chunk)
+{
+  chunk.set_size(dimensionality, chunkSize);
+
+  const char comment = isArff ? '%' : '#';
+  std::string line;
+  std::vector<std::string> tokens;
+  size_t points = 0;
+  while (points < chunkSize && std::getline(stream, line))
+  {
+    Trim(line);
+    if (line.empty() || line[0] == comment)
+      continue;
+
+    SplitLine(line, tokens);
+    if (tokens.size() != dimensionality)
+    {
+      throw std::runtime_error("ChunkedReader: read a line with " +
+          std::to_string(tokens.size()) + " fields, but the dataset has " +
+          std::to_string(dimensionality) + " dimensions!");
+    }
+
+    for (size_t d = 0; d < dimensionality; ++d)
+      chunk(d, points) = info.MapString<eT>(tokens[d], d);
+    ++points;
+  }
+
+  if (points < chunkSize)
+    chunk.resize(dimensionality, points);
+
+  return points;
+}
+
+inline void ChunkedReader::Reset()
+{
+  stream.clear();
+  stream.seekg(dataStart);
+}
+
+inline void ChunkedReader::SplitLine(const std::string& line,
+                                     std::vector<std::string>& tokens) const
+{
+  tokens.clear();
+  std::string field;
+  char quote = 0;
+  for (size_t i = 0; i < line.size(); ++i)
+  {
+    const char c = line[i];
+    if (quote != 0)
+    {
+      if (c == quote)
+        quote = 0;
+      else
+        field += c;
+    }
+    else if (c == '"' || c == '\'')
+    {
+      quote = c;
+    }
+    else if (c == delimiter)
+    {
+      Trim(field);
+      tokens.push_back(field);
+      field.clear();
+    }
+    else
+    {
+      field += c;
+    }
+  }
+  Trim(field);
+  tokens.push_back(field);
+}
+
+inline void ChunkedReader::Trim(std::string& s)
+{
+  const size_t first = s.find_first_not_of(" \t\r\n");
+  if (first == std::string::npos)
+  {
+    s.clear();
+    return;
+  }
+  const size_t last = s.find_last_not_of(" \t\r\n");
+  s = s.substr(first, last - first + 1);
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,115 @@
+/**
+ * @file core/data/column_subset_view.hpp
+ *
+ * Defines ColumnSubsetView, a lightweight non-owning view onto a subset of
+ * the columns of a matrix.  This allows train/test splits (see
+ * split_data.hpp) to be expressed as index sets over the original dataset
+ * instead of freshly allocated copies.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_COLUMN_SUBSET_VIEW_HPP
+#define MLPACK_CORE_DATA_COLUMN_SUBSET_VIEW_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A non-owning view onto a subset of the columns of a matrix, identified by
+ * an index set.  Constructing the view allocates nothing but the index
+ * vector: column accesses gather on demand from the underlying matrix, so a
+ * train/validate workflow never needs to materialize its splits.  This is
+ * suitable for algorithms that only need unordered column access (e.g.
+ * SGD-style trainers that draw one point at a time); algorithms that require
+ * contiguous storage can call Materialize() to produce a dense copy.
+ *
+ * The view holds a reference to the underlying matrix, which must outlive
+ * the view.  The index vector is copied, so it may be a temporary.
+ *
+ * @code
+ * arma::mat dataset = loadData();
+ * arma::uvec trainIdx, testIdx;
+ * data::SplitIndices(dataset.n_cols, trainIdx, testIdx, 0.3);
+ *
+ * data::ColumnSubsetView<double> trainView(dataset, trainIdx);
+ * for (size_t i = 0; i < trainView.n_cols; ++i)
+ *   f(trainView.col(i)); // No copies of the dataset are made.
+ * @endcode
+ *
+ * @tparam T Element type of the underlying matrix.
+ */
+template<typename T>
+class ColumnSubsetView
+{
+ public:
+  /**
+   * Construct the view as the given subset of the columns of the given
+   * matrix.  The indices need not be sorted or unique.
+   *
+   * @param input Matrix to view (must outlive the view).
+   * @param indices Column indices of the subset, in subset order.
+   */
+  ColumnSubsetView(const arma::Mat<T>& input, const arma::uvec& indices) :
+      n_rows(input.n_rows),
+      n_cols(indices.n_elem),
+      input(input),
+      indices(indices)
+  {
+    // Nothing to do.
+  }
+
+  //! Zero-copy access to column i of the subset.
+  arma::subview_col<T> col(const size_t i) const
+  {
+    return input.col(indices[i]);
+  }
+
+  //! Access the element at the given row and subset column.
+  const T& operator()(const size_t row, const size_t col) const
+  {
+    return input(row, indices[col]);
+  }
+
+  //! Gather the subset into a freshly allocated dense matrix, for use with
+  //! algorithms that require contiguous storage.
+  arma::Mat<T> Materialize() const { return input.cols(indices); }
+
+  /**
+   * Gather the elements of the given row object (e.g. a label vector over
+   * the full dataset) that correspond to this subset.
+   *
+   * @param labels Row of per-column values over the underlying matrix.
+   */
+  template<typename U>
+  arma::Row<U> GatherLabels(const arma::Row<U>& labels) const
+  {
+    return labels.cols(indices);
+  }
+
+  //! Get the index set defining the subset.
+  const arma::uvec& Indices() const { return indices; }
+
+  //! Get the underlying matrix.
+  const arma::Mat<T>& Matrix() const { return input; }
+
+  //! Number of rows (dimensions), named for matrix compatibility.
+  const size_t n_rows;
+  //! Number of columns in the subset, named for matrix compatibility.
+  const size_t n_cols;
+
+ private:
+  //! The underlying matrix (not owned).
+  const arma::Mat<T>& input;
+  //! The column indices of the subset.
+  const arma::uvec indices;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,204 @@
+/**
+ * @file core/data/columnar_dataset.hpp
+ *
+ * An in-memory columnar dataset container.  Each dimension is stored
+ * separately with a per-dimension compression scheme (raw, run-length, or
+ * dictionary with bit-packed codes), chosen automatically to minimize memory
+ * use.  Dense views are materialized lazily, so memory-bound methods can be
+ * trained with, e.g., `tree.Train(dataset.DenseView(), ...)` while the
+ * compressed representation remains the only long-lived copy.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_COLUMNAR_DATASET_HPP
+#define MLPACK_CORE_DATA_COLUMNAR_DATASET_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "dataset_mapper.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A compressed columnar (dimension-major) dataset container.  Categorical and
+ * other low-cardinality dimensions of an arma::mat occupy 8 bytes per element
+ * even though a handful of bits would do; this class stores each dimension
+ * with the cheapest of three encodings:
+ *
+ *  - raw: the values as-is (8 bytes per element);
+ *  - run-length: one (value, end offset) pair per run of equal values;
+ *  - dictionary: the sorted unique values plus bit-packed codes, using
+ *    ceil(log2(cardinality)) bits per element.
+ *
+ * A DatasetMapper may be given at construction time and is carried along, so
+ * methods that need per-dimension types (such as DecisionTree or
+ * HoeffdingTree) can be trained directly from the container:
+ *
+ * @code
+ * data::ColumnarDataset dataset(denseData, info);
+ * tree::DecisionTree<> tree(dataset.DenseView(), dataset.Info(), labels, 5);
+ * @endcode
+ *
+ * DenseView() and DimensionView() materialize dense representations lazily
+ * and cache them; call ClearViews() to drop the caches and return to the
+ * compressed footprint.
+ */
+class ColumnarDataset
+{
+ public:
+  //! The encoding used for a single dimension.
+  enum ColumnEncoding
+  {
+    RAW = 0,
+    RLE = 1,
+    DICTIONARY = 2
+  };
+
+  /**
+   * Create an empty ColumnarDataset.
+   */
+  ColumnarDataset();
+
+  /**
+   * Create a ColumnarDataset from the given dense dataset, choosing the
+   * cheapest encoding for each dimension.  No type information is stored.
+   *
+   * @param dataset Dense dataset to compress.
+   */
+  ColumnarDataset(const arma::mat& dataset);
+
+  /**
+   * Create a ColumnarDataset from the given dense dataset and dataset
+   * information, choosing the cheapest encoding for each dimension.
+   *
+   * @param dataset Dense dataset to compress.
+   * @param info Type information for each dimension.
+   */
+  ColumnarDataset(const arma::mat& dataset, const DatasetInfo& info);
+
+  //! Get the number of dimensions (rows of the dense representation).
+  size_t NumDimensions() const { return numDimensions; }
+  //! Get the number of points (columns of the dense representation).
+  size_t NumPoints() const { return numPoints; }
+
+  /**
+   * Get the value of the given dimension of the given point, decoding it from
+   * the compressed representation.
+   *
+   * @param dimension Dimension of the value.
+   * @param point Index of the point.
+   */
+  double operator()(const size_t dimension, const size_t point) const;
+
+  /**
+   * Get a dense view of the entire dataset, materializing (and caching) it if
+   * necessary.  The reference stays valid until ClearViews() is called or the
+   * object is destructed.
+   */
+  const arma::mat& DenseView() const;
+
+  /**
+   * Get a dense view of a single dimension, materializing (and caching) it if
+   * necessary.  The reference stays valid until ClearViews() is called or the
+   * object is destructed.
+   *
+   * @param dimension Dimension to materialize.
+   */
+  const arma::rowvec& DimensionView(const size_t dimension) const;
+
+  /**
+   * Drop all cached dense views, returning the object to its compressed
+   * memory footprint.
+   */
+  void ClearViews() const;
+
+  //! Get the encoding used for the given dimension.
+  ColumnEncoding Encoding(const size_t dimension) const
+  { return (ColumnEncoding) encodings[dimension]; }
+
+  //! Get the type information for the dataset.
+  const DatasetInfo& Info() const { return datasetInfo; }
+
+  /**
+   * Get the approximate size, in bytes, of the compressed representation
+   * (excluding any cached dense views).
+   */
+  size_t CompressedBytes() const;
+
+  /**
+   * Serialize the dataset.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(numDimensions));
+    ar(CEREAL_NVP(numPoints));
+    ar(CEREAL_NVP(datasetInfo));
+    ar(CEREAL_NVP(encodings));
+    ar(CEREAL_NVP(rawValues));
+    ar(CEREAL_NVP(runValues));
+    ar(CEREAL_NVP(runEnds));
+    ar(CEREAL_NVP(dictionaries));
+    ar(CEREAL_NVP(packedCodes));
+    ar(CEREAL_NVP(codeBits));
+
+    // The dense views are not serialized; rematerialize them on demand.
+    if (cereal::is_loading<Archive>())
+      ClearViews();
+  }
+
+ private:
+  /**
+   * Compress the given dense dataset, choosing the cheapest encoding for each
+   * dimension.
+   *
+   * @param dataset Dense dataset to compress.
+   */
+  void Encode(const arma::mat& dataset);
+
+  //! The number of dimensions.
+  size_t numDimensions;
+  //! The number of points.
+  size_t numPoints;
+
+  //! Type information for each dimension.
+  DatasetInfo datasetInfo;
+
+  //! The encoding of each dimension (a ColumnEncoding value).
+  std::vector<size_t> encodings;
+
+  //! Raw values, for RAW dimensions; empty otherwise.
+  std::vector<arma::rowvec> rawValues;
+
+  //! The value of each run, for RLE dimensions; empty otherwise.
+  std::vector<arma::vec> runValues;
+  //! The exclusive end offset of each run, for RLE dimensions.
+  std::vector<arma::uvec> runEnds;
+
+  //! The sorted unique values, for DICTIONARY dimensions; empty otherwise.
+  std::vector<arma::vec> dictionaries;
+  //! The bit-packed dictionary codes, for DICTIONARY dimensions.
+  std::vector<std::vector<uint64_t>> packedCodes;
+  //! The number of bits per code, for DICTIONARY dimensions.
+  std::vector<size_t> codeBits;
+
+  //! Cached dense view of the full dataset, if it has been materialized.
+  mutable arma::mat denseView;
+  //! Whether denseView is valid.
+  mutable bool denseValid;
+  //! Cached dense views of single dimensions.
+  mutable std::vector<arma::rowvec> dimensionViews;
+  //! Whether each element of dimensionViews is valid.
+  mutable std::vector<bool> dimensionValid;
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "columnar_dataset_impl.hpp"
+
+#endif
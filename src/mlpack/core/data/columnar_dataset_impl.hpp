@@ -0,0 +1,277 @@
+/**
+ * @file core/data/columnar_dataset_impl.hpp
+ *
+ * Implementation of the ColumnarDataset class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_COLUMNAR_DATASET_IMPL_HPP
+#define MLPACK_CORE_DATA_COLUMNAR_DATASET_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "columnar_dataset.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace mlpack {
+namespace data {
+
+inline ColumnarDataset::ColumnarDataset() :
+    numDimensions(0),
+    numPoints(0),
+    denseValid(false)
+{ /* Nothing to do. */ }
+
+inline ColumnarDataset::ColumnarDataset(const arma::mat& dataset) :
+    numDimensions(dataset.n_rows),
+    numPoints(dataset.n_cols),
+    datasetInfo(dataset.n_rows),
+    denseValid(false)
+{
+  Encode(dataset);
+}
+
+inline ColumnarDataset::ColumnarDataset(const arma::mat& dataset,
+                                        const DatasetInfo& info) :
+    numDimensions(dataset.n_rows),
+    numPoints(dataset.n_cols),
+    datasetInfo(info),
+    denseValid(false)
+{
+  if (info.Dimensionality() != dataset.n_rows)
+  {
+    throw std::invalid_argument("ColumnarDataset::ColumnarDataset(): the "
+        "given DatasetInfo does not have the same dimensionality as the "
+        "dataset!");
+  }
+
+  Encode(dataset);
+}
+
+inline void ColumnarDataset::Encode(const arma::mat& dataset)
+{
+  encodings.resize(numDimensions, (size_t) RAW);
+  rawValues.resize(numDimensions);
+  runValues.resize(numDimensions);
+  runEnds.resize(numDimensions);
+  dictionaries.resize(numDimensions);
+  packedCodes.resize(numDimensions);
+  codeBits.resize(numDimensions, 0);
+  dimensionViews.resize(numDimensions);
+  dimensionValid.resize(numDimensions, false);
+
+  for (size_t d = 0; d < numDimensions; ++d)
+  {
+    // Count the runs of equal values and collect the sorted unique values in
+    // one pass over a sorted copy of the dimension.
+    size_t numRuns = (numPoints > 0) ? 1 : 0;
+    for (size_t i = 1; i < numPoints; ++i)
+      if (dataset(d, i) != dataset(d, i - 1))
+        ++numRuns;
+
+    arma::rowvec sorted = arma::sort(dataset.row(d));
+    size_t cardinality = (numPoints > 0) ? 1 : 0;
+    for (size_t i = 1; i < numPoints; ++i)
+      if (sorted[i] != sorted[i - 1])
+        ++cardinality;
+
+    // The number of bits needed to represent a dictionary code.
+    size_t bits = 1;
+    while (((uint64_t) 1 << bits) < (uint64_t) cardinality)
+      ++bits;
+
+    // Estimate the in-memory cost of each encoding, in bytes.
+    const size_t rawCost = 8 * numPoints;
+    const size_t rleCost = 16 * numRuns;
+    const size_t dictCost = 8 * cardinality + ((numPoints * bits + 7) / 8);
+
+    if (rleCost <= rawCost && rleCost <= dictCost)
+    {
+      // Run-length encode the dimension.
+      encodings[d] = (size_t) RLE;
+      runValues[d].set_size(numRuns);
+      runEnds[d].set_size(numRuns);
+
+      size_t run = 0;
+      for (size_t i = 0; i < numPoints; ++i)
+      {
+        if (i == 0 || dataset(d, i) != dataset(d, i - 1))
+        {
+          runValues[d][run] = dataset(d, i);
+          ++run;
+        }
+        runEnds[d][run - 1] = i + 1;
+      }
+    }
+    else if (dictCost < rawCost)
+    {
+      // Dictionary encode the dimension with bit-packed codes.
+      encodings[d] = (size_t) DICTIONARY;
+      codeBits[d] = bits;
+
+      dictionaries[d].set_size(cardinality);
+      std::unordered_map<double, uint64_t> codes;
+      size_t next = 0;
+      for (size_t i = 0; i < numPoints; ++i)
+      {
+        if (i == 0 || sorted[i] != sorted[i - 1])
+        {
+          dictionaries[d][next] = sorted[i];
+          codes[sorted[i]] = next;
+          ++next;
+        }
+      }
+
+      const uint64_t mask = ((uint64_t) 1 << bits) - 1;
+      packedCodes[d].resize((numPoints * bits + 63) / 64, 0);
+      for (size_t i = 0; i < numPoints; ++i)
+      {
+        const uint64_t code = codes[dataset(d, i)] & mask;
+        const size_t bitPos = i * bits;
+        const size_t word = bitPos >> 6;
+        const size_t offset = bitPos & 63;
+
+        packedCodes[d][word] |= (code << offset);
+        if (offset + bits > 64)
+          packedCodes[d][word + 1] |= (code >> (64 - offset));
+      }
+    }
+    else
+    {
+      // Store the dimension as-is.
+      encodings[d] = (size_t) RAW;
+      rawValues[d] = dataset.row(d);
+    }
+  }
+}
+
+inline double ColumnarDataset::operator()(const size_t dimension,
+                                          const size_t point) const
+{
+  switch ((ColumnEncoding) encodings[dimension])
+  {
+    case RLE:
+    {
+      // Binary search for the run containing the point.
+      const arma::uvec& ends = runEnds[dimension];
+      const size_t run = std::upper_bound(ends.begin(), ends.end(),
+          (arma::uword) point) - ends.begin();
+      return runValues[dimension][run];
+    }
+
+    case DICTIONARY:
+    {
+      const size_t bits = codeBits[dimension];
+      const uint64_t mask = ((uint64_t) 1 << bits) - 1;
+      const size_t bitPos = point * bits;
+      const size_t word = bitPos >> 6;
+      const size_t offset = bitPos & 63;
+
+      uint64_t code = packedCodes[dimension][word] >> offset;
+      if (offset + bits > 64)
+        code |= packedCodes[dimension][word + 1] << (64 - offset);
+
+      return dictionaries[dimension][code & mask];
+    }
+
+    case RAW:
+    default:
+      return rawValues[dimension][point];
+  }
+}
+
+inline const arma::rowvec& ColumnarDataset::DimensionView(
+    const size_t dimension) const
+{
+  if (!dimensionValid[dimension])
+  {
+    arma::rowvec& view = dimensionViews[dimension];
+    view.set_size(numPoints);
+
+    switch ((ColumnEncoding) encodings[dimension])
+    {
+      case RLE:
+      {
+        // Expand each run directly; no per-element binary search needed.
+        size_t begin = 0;
+        for (size_t run = 0; run < runValues[dimension].n_elem; ++run)
+        {
+          const size_t end = runEnds[dimension][run];
+          view.subvec(begin, end - 1).fill(runValues[dimension][run]);
+          begin = end;
+        }
+        break;
+      }
+
+      case DICTIONARY:
+        for (size_t i = 0; i < numPoints; ++i)
+          view[i] = (*this)(dimension, i);
+        break;
+
+      case RAW:
+      default:
+        view = rawValues[dimension];
+        break;
+    }
+
+    dimensionValid[dimension] = true;
+  }
+
+  return dimensionViews[dimension];
+}
+
+inline const arma::mat& ColumnarDataset::DenseView() const
+{
+  if (!denseValid)
+  {
+    denseView.set_size(numDimensions, numPoints);
+    for (size_t d = 0; d < numDimensions; ++d)
+      denseView.row(d) = DimensionView(d);
+
+    denseValid = true;
+  }
+
+  return denseView;
+}
+
+inline void ColumnarDataset::ClearViews() const
+{
+  denseView.reset();
+  denseValid = false;
+  dimensionViews.assign(numDimensions, arma::rowvec());
+  dimensionValid.assign(numDimensions, false);
+}
+
+inline size_t ColumnarDataset::CompressedBytes() const
+{
+  size_t bytes = 0;
+  for (size_t d = 0; d < numDimensions; ++d)
+  {
+    switch ((ColumnEncoding) encodings[d])
+    {
+      case RLE:
+        bytes += 16 * runValues[d].n_elem;
+        break;
+
+      case DICTIONARY:
+        bytes += 8 * dictionaries[d].n_elem + 8 * packedCodes[d].size();
+        break;
+
+      case RAW:
+      default:
+        bytes += 8 * rawValues[d].n_elem;
+        break;
+    }
+  }
+
+  return bytes;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -19,6 +19,7 @@
 #include <unordered_map>
 
 #include "map_policies/increment_policy.hpp"
+#include "frozen_map_index.hpp"
 
 namespace mlpack {
 namespace data {
@@ -147,6 +148,21 @@ class DatasetMapper
    */
   size_t Dimensionality() const;
 
+  /**
+   * Freeze the current mappings into an immutable index (see FrozenMapIndex)
+   * that resolves input-to-value lookups through a contiguous string arena
+   * instead of the node-based std::unordered_maps.  This accelerates
+   * MapString() for already-mapped inputs and UnmapValue(), which is useful
+   * on the prediction path where the mappings no longer change.  The index
+   * is invalidated automatically if a new mapping is added afterwards, and
+   * rebuilt automatically when a DatasetMapper is deserialized.  This only
+   * has an effect when InputType is std::string.
+   */
+  void Freeze();
+
+  //! Return true if a frozen lookup index is currently active.
+  bool Frozen() const;
+
   /**
    * Serialize the dataset information.
    */
@@ -155,6 +171,12 @@ class DatasetMapper
   {
     ar(CEREAL_NVP(types));
     ar(CEREAL_NVP(maps));
+
+    // The mappings of a deserialized DatasetMapper are nearly always used
+    // read-only, so build the frozen lookup index right away.  It is not
+    // serialized itself; rebuilding it is one linear pass over the maps.
+    if (cereal::is_loading<Archive>())
+      frozen.Build(maps, types.size());
   }
 
   //! Return the policy of the mapper.
@@ -187,6 +209,10 @@ class DatasetMapper
   //! maps object stores string and numerical pairs.
   MapType maps;
 
+  //! Immutable lookup index over maps; empty until Freeze() is called (or a
+  //! DatasetMapper is deserialized), and cleared whenever maps changes.
+  FrozenMapIndex<InputType, typename PolicyType::MappedType> frozen;
+
   //! policy object tells dataset mapper how the categorical values should be
   //  mapped to the maps object. It is used in MapString() and MapTokens().
   PolicyType policy;
@@ -43,6 +43,7 @@ inline void DatasetMapper<PolicyType, InputType>::SetDimensionality(
 {
   types = std::vector<Datatype>(dimensionality, Datatype::numeric);
   maps.clear();
+  frozen.Clear();
 }
 
 // Utility helper function to call MapFirstPass.
@@ -86,7 +87,26 @@ inline T DatasetMapper<PolicyType, InputType>::MapString(
     const InputType& input,
     const size_t dimension)
 {
-  return policy.template MapString<MapType, T>(input, dimension, maps, types);
+  // If a frozen index is active, inputs that already have a mapping can be
+  // resolved without consulting the policy (which would go through the
+  // node-based maps and possibly a stringstream conversion).
+  typename PolicyType::MappedType frozenValue;
+  if (frozen.Built() && frozen.Lookup(input, dimension, frozenValue))
+    return T(frozenValue);
+
+  // Remember whether the policy adds a mapping; if it does, the frozen index
+  // (if any) is stale and must be dropped.
+  const size_t oldNumMappings = (maps.count(dimension) == 0) ? 0 :
+      maps[dimension].first.size();
+
+  const T result =
+      policy.template MapString<MapType, T>(input, dimension, maps, types);
+
+  if (frozen.Built() && ((maps.count(dimension) == 0) ? 0 :
+      maps[dimension].first.size()) != oldNumMappings)
+    frozen.Clear();
+
+  return result;
 }
 
 /**
@@ -179,8 +199,14 @@ DatasetMapper<PolicyType, InputType>::UnmapValue(
     const InputType& input,
     const size_t dimension)
 {
+  // A built frozen index covers every mapping, so a hit avoids the maps
+  // entirely and a miss means the input is genuinely unknown.
+  typename PolicyType::MappedType frozenValue;
+  if (frozen.Built() && frozen.Lookup(input, dimension, frozenValue))
+    return frozenValue;
+
   // Throw an exception if the value doesn't exist.
-  if (maps[dimension].first.count(input) == 0)
+  if (frozen.Built() || maps[dimension].first.count(input) == 0)
   {
     std::ostringstream oss;
     oss << "DatasetMapper<PolicyType, InputType>::UnmapValue(): input '"
@@ -230,6 +256,18 @@ inline size_t DatasetMapper<PolicyType, InputType>::Dimensionality() const
   return types.size();
 }
 
+template<typename PolicyType, typename InputType>
+inline void DatasetMapper<PolicyType, InputType>::Freeze()
+{
+  frozen.Build(maps, types.size());
+}
+
+template<typename PolicyType, typename InputType>
+inline bool DatasetMapper<PolicyType, InputType>::Frozen() const
+{
+  return frozen.Built();
+}
+
 template<typename PolicyType, typename InputType>
 inline const PolicyType& DatasetMapper<PolicyType, InputType>::Policy() const
 {
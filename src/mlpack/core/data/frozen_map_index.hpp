@@ -0,0 +1,236 @@
+/**
+ * @file core/data/frozen_map_index.hpp
+ *
+ * Defines the FrozenMapIndex class, an immutable, cache-friendly lookup
+ * structure over the categorical mappings held by a DatasetMapper.  The
+ * mutable std::unordered_map representation chases one heap node per lookup;
+ * for large category sets (millions of distinct strings) the frozen form
+ * interns every string into a single contiguous arena and resolves lookups
+ * through a flat open-addressing table, so a hit costs one hash, a few
+ * probes of a dense array, and one memcmp() against the arena.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_FROZEN_MAP_INDEX_HPP
+#define MLPACK_CORE_DATA_FROZEN_MAP_INDEX_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <unordered_map>
+#include <cstring>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * An immutable input-to-value lookup index over the mappings of a
+ * DatasetMapper.  Interning into a byte arena only makes sense for string
+ * inputs, so this primary template (used for any other InputType) is a no-op:
+ * Built() is always false and the DatasetMapper falls back to its mutable
+ * maps.  The real implementation lives in the std::string specialization
+ * below.
+ *
+ * @tparam InputType Type of input the DatasetMapper maps from.
+ * @tparam MappedType Type of value the DatasetMapper maps to.
+ */
+template<typename InputType, typename MappedType>
+class FrozenMapIndex
+{
+ public:
+  //! Building is not supported for non-string inputs; do nothing.
+  template<typename MapType>
+  void Build(const MapType& /* maps */, const size_t /* dimensionality */) { }
+
+  //! Nothing to clear.
+  void Clear() { }
+
+  //! The index is never built for non-string inputs.
+  bool Built() const { return false; }
+
+  //! Lookups always miss; the caller falls back to the mutable maps.
+  bool Lookup(const InputType& /* input */,
+              const size_t /* dimension */,
+              MappedType& /* value */) const { return false; }
+};
+
+/**
+ * The string form of the frozen index.  Build() copies every mapped string of
+ * every categorical dimension into one contiguous character arena and builds
+ * a flat open-addressing hash table per dimension (at most half full, so
+ * probe sequences stay short).  After that, Lookup() resolves a string to its
+ * mapped value without touching the node-based std::unordered_maps at all.
+ *
+ * The index is a read-only acceleration structure: it holds no state of its
+ * own beyond a copy of the mappings, so it is rebuilt from the maps after
+ * deserialization rather than serialized itself, and it must be cleared (or
+ * rebuilt) whenever the underlying mappings change.
+ */
+template<typename MappedType>
+class FrozenMapIndex<std::string, MappedType>
+{
+ public:
+  //! Construct an empty (unbuilt) index.
+  FrozenMapIndex() : built(false) { }
+
+  /**
+   * Build the index from the given DatasetMapper maps object.  Any previously
+   * built index is discarded.  This is a single linear pass over the
+   * mappings.
+   *
+   * @param maps Maps object of a DatasetMapper (dimension to pair of forward
+   *     and reverse maps).
+   * @param dimensionality Dimensionality of the DatasetMapper.
+   */
+  template<typename MapType>
+  void Build(const MapType& maps, const size_t dimensionality)
+  {
+    Clear();
+
+    // Reserve the arena and string tables in one shot.
+    size_t totalStrings = 0;
+    size_t totalBytes = 0;
+    for (typename MapType::const_iterator it = maps.begin(); it != maps.end();
+         ++it)
+    {
+      totalStrings += it->second.first.size();
+      for (typename ForwardMapType::const_iterator m =
+           it->second.first.begin(); m != it->second.first.end(); ++m)
+        totalBytes += m->first.size();
+    }
+
+    arena.reserve(totalBytes);
+    offsets.reserve(totalStrings + 1);
+    values.reserve(totalStrings);
+    offsets.push_back(0);
+    dims.resize(dimensionality);
+
+    for (size_t d = 0; d < dimensionality; ++d)
+    {
+      if (maps.count(d) == 0 || maps.at(d).first.empty())
+        continue;
+
+      const ForwardMapType& forward = maps.at(d).first;
+      DimTable& table = dims[d];
+
+      // Size the probe table to the next power of two at least twice the
+      // number of mappings, so the load factor never exceeds one half.
+      size_t slotCount = 1;
+      while (slotCount < 2 * forward.size())
+        slotCount *= 2;
+      table.slots.assign(slotCount, 0);
+      table.mask = slotCount - 1;
+
+      for (typename ForwardMapType::const_iterator m = forward.begin();
+           m != forward.end(); ++m)
+      {
+        // Intern the string and record its mapped value.
+        const size_t id = offsets.size() - 1;
+        arena.insert(arena.end(), m->first.begin(), m->first.end());
+        offsets.push_back(arena.size());
+        values.push_back(m->second);
+
+        // Insert into the probe table; slots hold (id + 1) so that zero can
+        // mean "empty".
+        size_t slot = Hash(m->first.data(), m->first.size()) & table.mask;
+        while (table.slots[slot] != 0)
+          slot = (slot + 1) & table.mask;
+        table.slots[slot] = id + 1;
+      }
+    }
+
+    built = true;
+  }
+
+  //! Discard the index; lookups will miss until Build() is called again.
+  void Clear()
+  {
+    arena.clear();
+    offsets.clear();
+    values.clear();
+    dims.clear();
+    built = false;
+  }
+
+  //! Return true if the index has been built.
+  bool Built() const { return built; }
+
+  /**
+   * Look up the mapped value of the given input in the given dimension.
+   * Returns true and fills value on a hit; returns false if the input has no
+   * mapping in that dimension (which, on a built index, means the mutable
+   * maps do not contain it either).
+   *
+   * @param input Input string to look up.
+   * @param dimension Dimension to look the string up in.
+   * @param value Output: mapped value of the string, if found.
+   */
+  bool Lookup(const std::string& input,
+              const size_t dimension,
+              MappedType& value) const
+  {
+    if (dimension >= dims.size() || dims[dimension].slots.empty())
+      return false;
+
+    const DimTable& table = dims[dimension];
+    size_t slot = Hash(input.data(), input.size()) & table.mask;
+    while (table.slots[slot] != 0)
+    {
+      const size_t id = table.slots[slot] - 1;
+      const size_t length = offsets[id + 1] - offsets[id];
+      if (length == input.size() &&
+          std::memcmp(arena.data() + offsets[id], input.data(), length) == 0)
+      {
+        value = values[id];
+        return true;
+      }
+
+      slot = (slot + 1) & table.mask;
+    }
+
+    return false;
+  }
+
+ private:
+  //! The forward map type used by DatasetMapper for string inputs.
+  using ForwardMapType = std::unordered_map<std::string, MappedType>;
+
+  //! FNV-1a hash over the raw bytes of a string.
+  static size_t Hash(const char* data, const size_t length)
+  {
+    uint64_t h = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; ++i)
+    {
+      h ^= (uint64_t) (unsigned char) data[i];
+      h *= 1099511628211ULL;
+    }
+
+    return (size_t) h;
+  }
+
+  //! Open-addressing probe table for one dimension.
+  struct DimTable
+  {
+    //! Slot values are (string id + 1); zero marks an empty slot.
+    std::vector<size_t> slots;
+    //! Bitmask for reducing hashes into the table (slots.size() - 1).
+    size_t mask;
+  };
+
+  //! All interned strings, back to back.
+  std::vector<char> arena;
+  //! String i occupies arena bytes [offsets[i], offsets[i + 1]).
+  std::vector<size_t> offsets;
+  //! Mapped value of each interned string.
+  std::vector<MappedType> values;
+  //! One probe table per dimension (empty for numeric dimensions).
+  std::vector<DimTable> dims;
+  //! Whether the index has been built.
+  bool built;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,154 @@
+/**
+ * @file core/data/image_batch_loader.hpp
+ * @author Mehul Kumar Nirala
+ *
+ * A prefetching batch loader for image datasets.  Images are decoded and
+ * normalized on background threads while the caller consumes previous
+ * batches, so training does not stall on image decoding between minibatches.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_IMAGE_BATCH_LOADER_HPP
+#define MLPACK_CORE_DATA_IMAGE_BATCH_LOADER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include "image_info.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * ImageBatchLoader loads a list of image files as a sequence of batches,
+ * decoding images on background threads ahead of the consumer.  Each batch is
+ * an arma::Mat<eT> whose columns are flattened, normalized images, in the
+ * order of the given file list, so batch b holds the files with indices
+ * [b * batchSize, (b + 1) * batchSize).  Batches are kept in a bounded queue:
+ * at most queueSize decoded batches are held in memory at once, and Next()
+ * blocks only when decoding has not yet caught up.
+ *
+ * All images are expected to have the dimensions given by the ImageInfo
+ * parameter; files that fail to load or do not match are filled with zeros
+ * and a warning is printed (similarly to the non-fatal image Load()).
+ *
+ * A typical use for minibatch training:
+ *
+ * @code
+ * data::ImageInfo info(32, 32, 3);
+ * data::ImageBatchLoader<> loader(files, info, 128);
+ * arma::mat batch;
+ * while (loader.Next(batch))
+ *   ... // Train on the batch.
+ * @endcode
+ *
+ * @tparam eT Element type of the produced batches.
+ */
+template<typename eT = double>
+class ImageBatchLoader
+{
+ public:
+  /**
+   * Create the loader and start the background decoding threads.
+   *
+   * @param files Files to load, in the order in which they will be delivered.
+   * @param info Dimensions that every image is expected to have.
+   * @param batchSize Number of images per batch.
+   * @param numThreads Number of background decoding threads.
+   * @param queueSize Maximum number of decoded batches held in memory; the
+   *     default of 2 double-buffers the output.
+   * @param scale Factor every pixel value is multiplied with; the default
+   *     normalizes 8-bit pixel values into [0, 1].
+   */
+  ImageBatchLoader(const std::vector<std::string>& files,
+                   const ImageInfo& info,
+                   const size_t batchSize,
+                   const size_t numThreads = 2,
+                   const size_t queueSize = 2,
+                   const double scale = 1.0 / 255.0);
+
+  //! Stop the background threads and destroy the loader.
+  ~ImageBatchLoader();
+
+  /**
+   * Get the next batch, blocking until it has been decoded if necessary.
+   *
+   * @param batch Matrix the batch will be moved into.
+   * @return True if a batch was delivered; false if all batches have already
+   *     been consumed.
+   */
+  bool Next(arma::Mat<eT>& batch);
+
+  //! Get whether there are batches that have not been delivered yet.
+  bool HasNext() const { return nextDelivery < numBatches; }
+
+  //! Get the total number of batches.
+  size_t NumBatches() const { return numBatches; }
+
+  //! Get the number of images per batch.
+  size_t BatchSize() const { return batchSize; }
+
+  //! Get the dimensions the images are expected to have.
+  const ImageInfo& Info() const { return info; }
+
+ private:
+  //! Body of a background thread: claim, decode and enqueue batches.
+  void DecodeLoop();
+
+  //! Files to load.
+  const std::vector<std::string> files;
+
+  //! Expected image dimensions.
+  const ImageInfo info;
+
+  //! Number of images per batch.
+  const size_t batchSize;
+
+  //! Maximum number of decoded batches held in memory.
+  const size_t queueSize;
+
+  //! Factor every pixel value is multiplied with.
+  const double scale;
+
+  //! Total number of batches.
+  size_t numBatches;
+
+  //! Index of the next batch a background thread will claim.
+  size_t nextClaim;
+
+  //! Index of the next batch Next() will deliver.
+  size_t nextDelivery;
+
+  //! If true, the loader is being destroyed and all threads must stop.
+  bool shutdown;
+
+  //! Decoded batches that have not been delivered yet, keyed by batch index.
+  std::map<size_t, arma::Mat<eT>> decoded;
+
+  //! Background decoding threads.
+  std::vector<std::thread> threads;
+
+  //! Mutex protecting all the mutable state above.
+  mutable std::mutex mutex;
+
+  //! Signaled when space becomes available in the queue.
+  std::condition_variable producerSignal;
+
+  //! Signaled when a batch becomes available for delivery.
+  std::condition_variable consumerSignal;
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "image_batch_loader_impl.hpp"
+
+#endif
@@ -0,0 +1,152 @@
+/**
+ * @file core/data/image_batch_loader_impl.hpp
+ * @author Mehul Kumar Nirala
+ *
+ * Implementation of the prefetching image batch loader.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_IMAGE_BATCH_LOADER_IMPL_HPP
+#define MLPACK_CORE_DATA_IMAGE_BATCH_LOADER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "image_batch_loader.hpp"
+
+#include "load.hpp"
+
+namespace mlpack {
+namespace data {
+
+template<typename eT>
+ImageBatchLoader<eT>::ImageBatchLoader(const std::vector<std::string>& files,
+                                       const ImageInfo& info,
+                                       const size_t batchSize,
+                                       const size_t numThreads,
+                                       const size_t queueSize,
+                                       const double scale) :
+    files(files),
+    info(info),
+    batchSize(batchSize),
+    queueSize(std::max(queueSize, (size_t) 1)),
+    scale(scale),
+    nextClaim(0),
+    nextDelivery(0),
+    shutdown(false)
+{
+  if (files.size() == 0)
+  {
+    throw std::invalid_argument("ImageBatchLoader: vector of image files is "
+        "empty");
+  }
+  if (batchSize == 0)
+    throw std::invalid_argument("ImageBatchLoader: batch size must not be 0");
+  if (info.Width() == 0 || info.Height() == 0 || info.Channels() == 0)
+  {
+    throw std::invalid_argument("ImageBatchLoader: image dimensions must be "
+        "specified in the given ImageInfo");
+  }
+
+  numBatches = (files.size() + batchSize - 1) / batchSize;
+
+  // There is no use for more threads than batches.
+  const size_t threadCount =
+      std::max(std::min(numThreads, numBatches), (size_t) 1);
+  for (size_t t = 0; t < threadCount; ++t)
+    threads.push_back(std::thread(&ImageBatchLoader::DecodeLoop, this));
+}
+
+template<typename eT>
+ImageBatchLoader<eT>::~ImageBatchLoader()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    shutdown = true;
+  }
+  producerSignal.notify_all();
+  consumerSignal.notify_all();
+  for (size_t t = 0; t < threads.size(); ++t)
+    threads[t].join();
+}
+
+template<typename eT>
+bool ImageBatchLoader<eT>::Next(arma::Mat<eT>& batch)
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  if (nextDelivery >= numBatches)
+    return false;
+
+  // Wait until the batch has been decoded.
+  consumerSignal.wait(lock,
+      [&] { return shutdown || decoded.count(nextDelivery) > 0; });
+  if (shutdown)
+    return false;
+
+  batch = std::move(decoded[nextDelivery]);
+  decoded.erase(nextDelivery);
+  ++nextDelivery;
+
+  // A slot of the queue has been freed.
+  producerSignal.notify_all();
+  return true;
+}
+
+template<typename eT>
+void ImageBatchLoader<eT>::DecodeLoop()
+{
+  const size_t dimensionality = info.Width() * info.Height() * info.Channels();
+
+  while (true)
+  {
+    // Claim the next batch that has not been decoded yet.  Claims are handed
+    // out in order, so the batch the consumer waits for is always being
+    // worked on.
+    size_t batchIndex;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (shutdown || nextClaim >= numBatches)
+        return;
+      batchIndex = nextClaim++;
+    }
+
+    // Decode and normalize the batch without holding the lock.
+    const size_t begin = batchIndex * batchSize;
+    const size_t end = std::min(begin + batchSize, files.size());
+    arma::Mat<eT> batch(dimensionality, end - begin);
+    for (size_t i = begin; i < end; ++i)
+    {
+      arma::Mat<eT> image;
+      ImageInfo imageInfo(info);
+      if (Load(files[i], image, imageInfo, false) &&
+          image.n_rows == dimensionality)
+      {
+        batch.col(i - begin) = scale * image;
+      }
+      else
+      {
+        Log::Warn << "ImageBatchLoader: could not load '" << files[i]
+            << "' with the expected dimensions; substituting zeros."
+            << std::endl;
+        batch.col(i - begin).zeros();
+      }
+    }
+
+    // Wait for the batch to fit into the delivery window, so that no more
+    // than queueSize decoded batches are held in memory.
+    std::unique_lock<std::mutex> lock(mutex);
+    producerSignal.wait(lock,
+        [&] { return shutdown || batchIndex < nextDelivery + queueSize; });
+    if (shutdown)
+      return;
+
+    decoded[batchIndex] = std::move(batch);
+    consumerSignal.notify_all();
+  }
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -71,6 +71,35 @@ class CustomImputation
     }
   }
 
+  /**
+   * Impute all dimensions of the input at once, replacing the missing value
+   * of every dimension with the custom value in a single fused pass.
+   *
+   * @param input Matrix that contains the values to be replaced.
+   * @param mappedValues The value the user wants to get rid of, one entry
+   *     per dimension.
+   * @param columnMajor State of whether the input matrix is columnMajor or
+   *     not.
+   */
+  void Impute(arma::Mat<T>& input,
+              const arma::Col<T>& mappedValues,
+              const bool columnMajor = true)
+  {
+    const size_t dims = columnMajor ? input.n_rows : input.n_cols;
+    const size_t points = columnMajor ? input.n_cols : input.n_rows;
+
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t d = 0; d < (omp_size_t) dims; ++d)
+    {
+      for (size_t i = 0; i < points; ++i)
+      {
+        T& value = columnMajor ? input(d, i) : input(i, d);
+        if (value == mappedValues[d] || std::isnan(value))
+          value = customValue;
+      }
+    }
+  }
+
  private:
   //! A user-defined value that the user wants to replace missing values with.
   T customValue;
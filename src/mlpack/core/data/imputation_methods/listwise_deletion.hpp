@@ -66,6 +66,48 @@ class ListwiseDeletion
       input = input.rows(arma::uvec(colsToKeep));
     }
   }
+
+  /**
+   * Impute all dimensions of the input at once: any case that holds the
+   * missing value (or NaN) in any dimension is removed, in a single pass
+   * over the matrix.
+   *
+   * @param input Matrix that contains the values to be removed.
+   * @param mappedValues The value the user wants to get rid of, one entry
+   *     per dimension.
+   * @param columnMajor State of whether the input matrix is columnMajor or
+   *     not.
+   */
+  void Impute(arma::Mat<T>& input,
+              const arma::Col<T>& mappedValues,
+              const bool columnMajor = true)
+  {
+    const size_t dims = columnMajor ? input.n_rows : input.n_cols;
+    const size_t points = columnMajor ? input.n_cols : input.n_rows;
+
+    std::vector<arma::uword> casesToKeep;
+    for (size_t i = 0; i < points; ++i)
+    {
+      bool keep = true;
+      for (size_t d = 0; d < dims; ++d)
+      {
+        const T value = columnMajor ? input(d, i) : input(i, d);
+        if (value == mappedValues[d] || std::isnan(value))
+        {
+          keep = false;
+          break;
+        }
+      }
+
+      if (keep)
+        casesToKeep.push_back(i);
+    }
+
+    if (columnMajor)
+      input = input.cols(arma::uvec(casesToKeep));
+    else
+      input = input.rows(arma::uvec(casesToKeep));
+  }
 }; // class ListwiseDeletion
 
 } // namespace data
@@ -96,6 +96,67 @@ class MeanImputation
       input(target.first, target.second) = mean;
     }
   }
+
+  /**
+   * Impute all dimensions of the input at once.  Per-dimension sums and
+   * counts of valid elements are accumulated in one parallel pass over the
+   * matrix, and all imputations are applied in a second fused pass, instead
+   * of re-walking the matrix once per dimension.
+   *
+   * @param input Matrix that contains the values to be replaced.
+   * @param mappedValues The value the user wants to get rid of, one entry
+   *     per dimension.
+   * @param columnMajor State of whether the input matrix is columnMajor or
+   *     not.
+   */
+  void Impute(arma::Mat<T>& input,
+              const arma::Col<T>& mappedValues,
+              const bool columnMajor = true)
+  {
+    const size_t dims = columnMajor ? input.n_rows : input.n_cols;
+    const size_t points = columnMajor ? input.n_cols : input.n_rows;
+
+    arma::vec sums(dims, arma::fill::zeros);
+    arma::Col<size_t> counts(dims, arma::fill::zeros);
+
+    // First pass: per-dimension statistics.  Each thread owns a block of
+    // dimensions, so the accumulators need no reduction.
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t d = 0; d < (omp_size_t) dims; ++d)
+    {
+      for (size_t i = 0; i < points; ++i)
+      {
+        const T value = columnMajor ? input(d, i) : input(i, d);
+        if (!(value == mappedValues[d] || std::isnan(value)))
+        {
+          sums[d] += value;
+          counts[d]++;
+        }
+      }
+    }
+
+    for (size_t d = 0; d < dims; ++d)
+    {
+      if (counts[d] == 0)
+      {
+        Log::Fatal << "it is impossible to calculate mean; no valid elements "
+            << "in dimension " << d << std::endl;
+      }
+    }
+
+    // Second pass: apply every imputation.
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t d = 0; d < (omp_size_t) dims; ++d)
+    {
+      const double mean = sums[d] / counts[d];
+      for (size_t i = 0; i < points; ++i)
+      {
+        T& value = columnMajor ? input(d, i) : input(i, d);
+        if (value == mappedValues[d] || std::isnan(value))
+          value = mean;
+      }
+    }
+  }
 }; // class MeanImputation
 
 } // namespace data
@@ -13,6 +13,7 @@
 #define MLPACK_CORE_DATA_IMPUTE_STRATEGIES_MEDIAN_IMPUTATION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/quantile_sketch.hpp>
 
 namespace mlpack {
 namespace data {
@@ -25,6 +26,21 @@ template <typename T>
 class MedianImputation
 {
  public:
+  /**
+   * Construct the MedianImputation object.
+   *
+   * @param approximate If true, medians are estimated with a streaming P^2
+   *     quantile sketch instead of copying and sorting each column.  The
+   *     sketch uses constant memory per dimension and a single pass, at the
+   *     cost of a small estimation error; use it when columns are too large
+   *     to sort comfortably.
+   */
+  MedianImputation(const bool approximate = false) :
+      approximate(approximate)
+  {
+    // Nothing to do.
+  }
+
   /**
    * Impute function searches through the input looking for mappedValue and
    * replaces it with the median of the given dimension. The result is
@@ -43,8 +59,11 @@ class MedianImputation
     using PairType = std::pair<size_t, size_t>;
     // dimensions and indexes are saved as pairs inside this vector.
     std::vector<PairType> targets;
-    // good elements are kept inside this vector.
+    // good elements are kept inside this vector (exact mode only).
     std::vector<double> elemsToKeep;
+    // in approximate mode, good elements are streamed into the sketch
+    // instead of being stored.
+    math::QuantileSketch sketch;
 
     if (columnMajor)
     {
@@ -55,6 +74,10 @@ class MedianImputation
         {
           targets.emplace_back(dimension, i);
         }
+        else if (approximate)
+        {
+          sketch.Insert(input(dimension, i));
+        }
         else
         {
           elemsToKeep.push_back(input(dimension, i));
@@ -70,6 +93,10 @@ class MedianImputation
         {
           targets.emplace_back(i, dimension);
         }
+        else if (approximate)
+        {
+          sketch.Insert(input(i, dimension));
+        }
         else
         {
            elemsToKeep.push_back(input(i, dimension));
@@ -78,13 +105,70 @@ class MedianImputation
     }
 
     // calculate median
-    const double median = arma::median(arma::vec(elemsToKeep));
+    const double median = approximate ? sketch.Estimate() :
+        arma::median(arma::vec(elemsToKeep));
 
     for (const PairType& target : targets)
     {
        input(target.first, target.second) = median;
     }
   }
+
+  /**
+   * Impute all dimensions of the input at once.  Dimensions are processed in
+   * one parallel pass: each one gathers its valid elements, computes the
+   * median, and applies its imputations, instead of re-walking the matrix
+   * once per dimension.
+   *
+   * @param input Matrix that contains the values to be replaced.
+   * @param mappedValues The value the user wants to get rid of, one entry
+   *     per dimension.
+   * @param columnMajor State of whether the input matrix is columnMajor or
+   *     not.
+   */
+  void Impute(arma::Mat<T>& input,
+              const arma::Col<T>& mappedValues,
+              const bool columnMajor = true)
+  {
+    const size_t dims = columnMajor ? input.n_rows : input.n_cols;
+    const size_t points = columnMajor ? input.n_cols : input.n_rows;
+
+    // The per-dimension median costs depend on how many elements are valid,
+    // so let the scheduler balance the dimensions across threads.
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t d = 0; d < (omp_size_t) dims; ++d)
+    {
+      std::vector<size_t> targets;
+      std::vector<double> elemsToKeep;
+      math::QuantileSketch sketch;
+      for (size_t i = 0; i < points; ++i)
+      {
+        const T value = columnMajor ? input(d, i) : input(i, d);
+        if (value == mappedValues[d] || std::isnan(value))
+          targets.push_back(i);
+        else if (approximate)
+          sketch.Insert(value);
+        else
+          elemsToKeep.push_back(value);
+      }
+
+      if (targets.empty())
+        continue;
+
+      const double median = approximate ? sketch.Estimate() :
+          arma::median(arma::vec(elemsToKeep));
+      for (size_t t = 0; t < targets.size(); ++t)
+      {
+        if (columnMajor)
+          input(d, targets[t]) = median;
+        else
+          input(targets[t], d) = median;
+      }
+    }
+  }
+ private:
+  //! If true, medians are estimated with a streaming quantile sketch.
+  bool approximate;
 }; // class MedianImputation
 
 } // namespace data
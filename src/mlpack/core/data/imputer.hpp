@@ -65,6 +65,27 @@ class Imputer
     strategy.Impute(input, mappedValue, dimension, columnMajor);
   }
 
+  /**
+  * Given an input dataset, replace missing values of every dimension with
+  * the given imputation strategy in one shot.  The missing value is unmapped
+  * through the mapper once per dimension up front, and the strategy then
+  * computes all per-dimension statistics in a single pass over the matrix
+  * and applies every imputation in a second fused pass, instead of
+  * re-walking the whole dataset once per dimension.
+  *
+  * @param input Input dataset to apply imputation.
+  * @param missingValue User defined missing value; it can be anything.
+  */
+  void Impute(arma::Mat<T>& input, const std::string& missingValue)
+  {
+    const size_t dims = columnMajor ? input.n_rows : input.n_cols;
+    arma::Col<T> mappedValues(dims);
+    for (size_t d = 0; d < dims; ++d)
+      mappedValues[d] = static_cast<T>(mapper.UnmapValue(missingValue, d));
+
+    strategy.Impute(input, mappedValues, columnMajor);
+  }
+
   //! Get the strategy.
   const StrategyType& Strategy() const { return strategy; }
 
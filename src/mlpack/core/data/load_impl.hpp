@@ -17,8 +17,10 @@
 #include <exception>
 #include <algorithm>
 #include <mlpack/core/util/timers.hpp>
+#include <mlpack/core/util/telemetry.hpp>
 
 #include "load_csv.hpp"
+#include "parallel_csv_parse.hpp"
 #include "load.hpp"
 #include "extension.hpp"
 #include "detect_file_type.hpp"
@@ -93,6 +95,7 @@ bool Load(const std::string& filename,
           const arma::file_type inputLoadType)
 {
   Timer::Start("loading_data");
+  Telemetry::Operation telemetryOp("data::Load");
 
   // Catch nonexistent files by opening the stream ourselves.
   std::fstream stream;
@@ -164,7 +167,20 @@ bool Load(const std::string& filename,
 
   // We can't use the stream if the type is HDF5.
   bool success;
-  if (loadType != arma::hdf5_binary)
+  if (loadType == arma::csv_ascii &&
+      ParallelCSVParse(filename, matrix, ',', transpose))
+  {
+    // The parallel numeric fast path parsed the file (and already handled the
+    // transposition); files with non-numeric fields fall through to the
+    // stream-based loader below.
+    Log::Info << "Size is " << matrix.n_rows << " x " << matrix.n_cols
+        << ".\n";
+    Timer::Stop("loading_data");
+    telemetryOp.Rows(matrix.n_rows).Cols(matrix.n_cols)
+        .Bytes(matrix.n_elem * sizeof(eT));
+    return true;
+  }
+  else if (loadType != arma::hdf5_binary)
     success = matrix.load(stream, loadType);
   else
     success = matrix.load(filename, loadType);
@@ -191,6 +207,8 @@ bool Load(const std::string& filename,
   }
 
   Timer::Stop("loading_data");
+  telemetryOp.Rows(matrix.n_rows).Cols(matrix.n_cols)
+      .Bytes(matrix.n_elem * sizeof(eT));
 
   // Finally, return the success indicator.
   return success;
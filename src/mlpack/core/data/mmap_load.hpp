@@ -0,0 +1,276 @@
+/**
+ * @file core/data/mmap_load.hpp
+ *
+ * A simple binary column-major matrix container format, plus an mmap-backed
+ * zero-copy load mode.  SaveBinary() writes a small header followed by the
+ * raw column-major element data; MappedMatrix loads such a file by mapping it
+ * into memory and aliasing the mapped pages as an arma::Mat (using the same
+ * advanced-constructor trick as core/math/make_alias.hpp), so loading is
+ * page-fault driven instead of stream driven and does not double peak memory
+ * use.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MMAP_LOAD_HPP
+#define MLPACK_CORE_DATA_MMAP_LOAD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/log.hpp>
+
+#include <fstream>
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+//! Magic bytes identifying the mlpack binary matrix container format.
+const uint32_t BinaryMatrixMagic = 0x4b504c4d; // "MLPK", little-endian.
+//! Current version of the container format.
+const uint32_t BinaryMatrixVersion = 1;
+
+//! On-disk header of the binary matrix container format.  The element data
+//! follows the header directly, in column-major order, padded so that it
+//! starts on a 64-byte boundary (which keeps mapped columns aligned).
+struct BinaryMatrixHeader
+{
+  uint32_t magic;
+  uint32_t version;
+  uint32_t elemTypeCode; // See BinaryMatrixElemCode.
+  uint32_t dataOffset;   // Offset of the element data from the file start.
+  uint64_t rows;
+  uint64_t cols;
+};
+
+//! Mapping of supported element types to on-disk type codes.
+template<typename eT>
+struct BinaryMatrixElemCode { };
+
+template<>
+struct BinaryMatrixElemCode<double> { static const uint32_t value = 1; };
+
+template<>
+struct BinaryMatrixElemCode<float> { static const uint32_t value = 2; };
+
+template<>
+struct BinaryMatrixElemCode<size_t> { static const uint32_t value = 3; };
+
+/**
+ * Save a matrix in the mlpack binary column-major container format.  Files
+ * written this way can be loaded with zero copies via MappedMatrix, or read
+ * conventionally on platforms without mmap support.
+ *
+ * @param matrix Matrix to save.
+ * @param filename Name of the file to write.
+ * @param fatal If true, an exception is thrown on failure.
+ * @return Boolean value indicating success or failure of the save.
+ */
+template<typename eT>
+bool SaveBinary(const arma::Mat<eT>& matrix,
+                const std::string& filename,
+                const bool fatal = false)
+{
+  std::ofstream stream(filename, std::ios::binary);
+  if (!stream.is_open())
+  {
+    if (fatal)
+      Log::Fatal << "Cannot open file '" << filename << "' for writing. "
+          << std::endl;
+    else
+      Log::Warn << "Cannot open file '" << filename << "' for writing."
+          << std::endl;
+    return false;
+  }
+
+  BinaryMatrixHeader header;
+  header.magic = BinaryMatrixMagic;
+  header.version = BinaryMatrixVersion;
+  header.elemTypeCode = BinaryMatrixElemCode<eT>::value;
+  header.dataOffset = 64; // Element data starts at a 64-byte boundary.
+  header.rows = matrix.n_rows;
+  header.cols = matrix.n_cols;
+
+  stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  // Pad up to the data offset.
+  const std::streamsize padding = header.dataOffset - sizeof(header);
+  const std::vector<char> zeros(padding, 0);
+  stream.write(zeros.data(), padding);
+  stream.write(reinterpret_cast<const char*>(matrix.memptr()),
+      matrix.n_elem * sizeof(eT));
+
+  if (!stream)
+  {
+    if (fatal)
+      Log::Fatal << "Save to '" << filename << "' failed." << std::endl;
+    else
+      Log::Warn << "Save to '" << filename << "' failed." << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * A matrix backed by a memory-mapped binary container file.  After a
+ * successful Load(), Matrix() is an arma::Mat aliasing the mapped pages
+ * directly: no element data is copied, and pages are faulted in lazily as the
+ * matrix is used.  The mapping is private (copy-on-write), so modifying the
+ * matrix is safe and never writes back to the file.
+ *
+ * The alias is strict (it cannot be resized or repointed), and it is only
+ * valid for the lifetime of this object.  On platforms without mmap support,
+ * Load() falls back to reading the file into an owned matrix.
+ *
+ * @tparam eT Element type of the matrix.
+ */
+template<typename eT>
+class MappedMatrix
+{
+ public:
+  //! Construct an empty, unmapped matrix.
+  MappedMatrix() : matrix(new arma::Mat<eT>()), mapping(NULL), mappedLength(0)
+  { }
+
+  //! Unmap the file (if mapped) and destroy the matrix alias.
+  ~MappedMatrix()
+  {
+    Reset();
+    delete matrix;
+  }
+
+  // The mapping is uniquely owned and cannot be copied.
+  MappedMatrix(const MappedMatrix&) = delete;
+  MappedMatrix& operator=(const MappedMatrix&) = delete;
+
+  /**
+   * Map the given binary container file and alias it as a matrix.  Any
+   * previous mapping held by this object is released first.
+   *
+   * @param filename Name of the file to map.
+   * @param fatal If true, an exception is thrown on failure.
+   * @return Boolean value indicating success or failure of the load.
+   */
+  bool Load(const std::string& filename, const bool fatal = false)
+  {
+    Reset();
+
+    BinaryMatrixHeader header;
+    if (!ReadHeader(filename, header, fatal))
+      return false;
+
+#ifndef _WIN32
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      return Fail(filename, "cannot open file", fatal);
+    }
+
+    mappedLength = (size_t) header.dataOffset +
+        (size_t) header.rows * (size_t) header.cols * sizeof(eT);
+    // A private mapping gives copy-on-write semantics: the matrix can be
+    // modified without the changes reaching the file.
+    void* map = mmap(NULL, mappedLength, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+        fd, 0);
+    close(fd); // The mapping stays valid after the descriptor is closed.
+    if (map == MAP_FAILED)
+    {
+      mappedLength = 0;
+      return Fail(filename, "mmap() failed", fatal);
+    }
+
+    mapping = map;
+    eT* data = reinterpret_cast<eT*>(
+        reinterpret_cast<char*>(map) + header.dataOffset);
+    // Alias the mapped pages with the advanced constructor (no copy, strict).
+    delete matrix;
+    matrix = new arma::Mat<eT>(data, header.rows, header.cols, false, true);
+    return true;
+#else
+    // No mmap on this platform; fall back to a conventional read.
+    std::ifstream stream(filename, std::ios::binary);
+    stream.seekg(header.dataOffset);
+    matrix->set_size(header.rows, header.cols);
+    stream.read(reinterpret_cast<char*>(matrix->memptr()),
+        matrix->n_elem * sizeof(eT));
+    if (!stream)
+      return Fail(filename, "read failed", fatal);
+    return true;
+#endif
+  }
+
+  //! Get the matrix aliasing the mapped file.
+  const arma::Mat<eT>& Matrix() const { return *matrix; }
+  //! Modify the matrix aliasing the mapped file (copy-on-write; changes do
+  //! not reach the file).
+  arma::Mat<eT>& Matrix() { return *matrix; }
+
+ private:
+  //! Read and validate the container header.
+  bool ReadHeader(const std::string& filename,
+                  BinaryMatrixHeader& header,
+                  const bool fatal)
+  {
+    std::ifstream stream(filename, std::ios::binary);
+    if (!stream.is_open())
+      return Fail(filename, "cannot open file", fatal);
+
+    stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!stream || header.magic != BinaryMatrixMagic)
+      return Fail(filename, "not an mlpack binary matrix file", fatal);
+    if (header.version != BinaryMatrixVersion)
+      return Fail(filename, "unsupported container version", fatal);
+    if (header.elemTypeCode != BinaryMatrixElemCode<eT>::value)
+      return Fail(filename, "element type mismatch", fatal);
+
+    return true;
+  }
+
+  //! Report a failure in the repo's usual Log::Fatal/Log::Warn style.
+  bool Fail(const std::string& filename,
+            const std::string& reason,
+            const bool fatal)
+  {
+    if (fatal)
+      Log::Fatal << "Load of '" << filename << "' failed: " << reason << "."
+          << std::endl;
+    else
+      Log::Warn << "Load of '" << filename << "' failed: " << reason << "."
+          << std::endl;
+    return false;
+  }
+
+  //! Release the mapping and replace the alias with an empty matrix.  The
+  //! alias is strict, so it must be destroyed (not reassigned) before the
+  //! pages are unmapped.
+  void Reset()
+  {
+    delete matrix;
+    matrix = new arma::Mat<eT>();
+#ifndef _WIN32
+    if (mapping != NULL)
+      munmap(mapping, mappedLength);
+#endif
+    mapping = NULL;
+    mappedLength = 0;
+  }
+
+  //! Matrix aliasing the mapped pages (or owning the data on fallback).
+  arma::Mat<eT>* matrix;
+  //! Base address of the mapping (NULL if not mapped).
+  void* mapping;
+  //! Length of the mapping in bytes.
+  size_t mappedLength;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif // MLPACK_CORE_DATA_MMAP_LOAD_HPP
@@ -47,6 +47,27 @@ void OneHotEncoding(const arma::Mat<eT>& input,
                     const arma::Col<size_t>& indices,
                     arma::Mat<eT>& output);
 
+/**
+ * Overloaded function for the above function which writes the encoding into
+ * a sparse matrix, so that dimensions with very many categories never have to
+ * be materialized densely.  If numBuckets is nonzero, feature hashing is used
+ * instead of exact encoding: every encoded dimension spans numBuckets rows
+ * and each categorical value is mapped to the bucket given by its hash, so
+ * the output size is bounded no matter how many distinct categories exist
+ * (at the price of hash collisions).
+ *
+ * @param input Input dataset to be encoded.
+ * @param indices Index of rows to be encoded.
+ * @param output Encoded sparse matrix.
+ * @param numBuckets Number of hash buckets per encoded dimension; 0 means
+ *      exact one-hot encoding.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    const arma::Col<size_t>& indices,
+                    arma::SpMat<eT>& output,
+                    const size_t numBuckets = 0);
+
 /**
  * Overloaded function for the above function, which takes a matrix as input
  * and also a DatasetInfo object and outputs a matrix.
@@ -62,6 +83,25 @@ void OneHotEncoding(const arma::Mat<eT>& input,
                     arma::Mat<eT>& output,
                     const data::DatasetInfo& datasetInfo);
 
+/**
+ * Overloaded function for the above function which writes the encoding into
+ * a sparse matrix.  All dimensions marked `Datatype::categorical` in the
+ * given DatasetInfo are encoded; the mapped category values produced by the
+ * DatasetMapper are either one-hot encoded exactly (numBuckets is 0) or
+ * hashed into numBuckets buckets per dimension.
+ *
+ * @param input Input dataset to be encoded.
+ * @param output Encoded sparse matrix.
+ * @param datasetInfo DatasetInfo object that has information about data.
+ * @param numBuckets Number of hash buckets per encoded dimension; 0 means
+ *      exact one-hot encoding.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    arma::SpMat<eT>& output,
+                    const data::DatasetInfo& datasetInfo,
+                    const size_t numBuckets = 0);
+
 } // namespace data
 } // namespace mlpack
 
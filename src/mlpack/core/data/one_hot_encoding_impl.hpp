@@ -143,6 +143,110 @@ void OneHotEncoding(const arma::Mat<eT>& input,
   }
 }
 
+/**
+ * Overloaded function for the above function which writes the encoding into
+ * a sparse matrix; if numBuckets is nonzero, feature hashing is applied
+ * instead of exact encoding.
+ *
+ * @param input Input dataset to be encoded.
+ * @param indices Index of rows to be encoded.
+ * @param output Encoded sparse matrix.
+ * @param numBuckets Number of hash buckets per encoded dimension; 0 means
+ *      exact one-hot encoding.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    const arma::Col<size_t>& indices,
+                    arma::SpMat<eT>& output,
+                    const size_t numBuckets)
+{
+  // Handle the edge case where there is nothing to encode.
+  if (indices.n_elem == 0)
+  {
+    output = arma::SpMat<eT>(input);
+    return;
+  }
+
+  // This vector will eventually hold the offsets for each dimension in the
+  // encoded matrix.  A hashed dimension always spans numBuckets rows; an
+  // exactly encoded one spans its number of distinct values, which is
+  // counted below.
+  arma::Col<size_t> dimensionOffsets(input.n_rows, arma::fill::ones);
+  std::vector<bool> encode(input.n_rows, false);
+  // This will hold the mappings from a value that should be one-hot encoded
+  // to the index of the dimension it should take (exact encoding only).
+  std::unordered_map<size_t, std::unordered_map<eT, size_t>> mappings;
+  for (size_t i = 0; i < indices.n_elem; ++i)
+  {
+    encode[indices[i]] = true;
+    if (numBuckets > 0)
+    {
+      dimensionOffsets[indices[i]] = numBuckets;
+    }
+    else
+    {
+      dimensionOffsets[indices[i]] = 0;
+      mappings.insert(
+          std::make_pair(indices[i], std::unordered_map<eT, size_t>()));
+    }
+  }
+
+  if (numBuckets == 0)
+  {
+    // Develop the mappings, counting the distinct values of each dimension.
+    for (size_t col = 0; col < input.n_cols; ++col)
+    {
+      for (size_t row = 0; row < input.n_rows; ++row)
+      {
+        if (encode[row] && mappings[row].count(input(row, col)) == 0)
+          mappings[row][input(row, col)] = dimensionOffsets[row]++;
+      }
+    }
+  }
+
+  // Turn the dimension counts into offsets.  Note that the last element is
+  // the total number of dimensions, and the first element is the offset for
+  // dimension *2* (not 1).
+  for (size_t i = 1; i < dimensionOffsets.n_elem; ++i)
+    dimensionOffsets[i] += dimensionOffsets[i - 1];
+
+  // Assemble the batch-insertion arrays; there is at most one nonzero entry
+  // per input value.  Walking the input in column-major order produces
+  // already-sorted locations, since the output row offsets increase with the
+  // input row.
+  std::hash<eT> hasher;
+  arma::umat locations(2, input.n_elem);
+  arma::Col<eT> values(input.n_elem);
+  size_t nonzeros = 0;
+  for (size_t col = 0; col < input.n_cols; ++col)
+  {
+    for (size_t row = 0; row < input.n_rows; ++row)
+    {
+      const size_t dimOffset = (row == 0) ? 0 : dimensionOffsets[row - 1];
+      if (encode[row])
+      {
+        const size_t bucket = (numBuckets > 0) ?
+            hasher(input(row, col)) % numBuckets :
+            mappings[row][input(row, col)];
+        locations(0, nonzeros) = dimOffset + bucket;
+        locations(1, nonzeros) = col;
+        values[nonzeros++] = eT(1);
+      }
+      else if (input(row, col) != eT(0))
+      {
+        // No need for one-hot encoding; pass the value through.
+        locations(0, nonzeros) = dimOffset;
+        locations(1, nonzeros) = col;
+        values[nonzeros++] = input(row, col);
+      }
+    }
+  }
+
+  output = arma::SpMat<eT>(locations.head_cols(nonzeros),
+      values.head(nonzeros), dimensionOffsets[dimensionOffsets.n_elem - 1],
+      input.n_cols);
+}
+
 /**
  * Overloaded function for the above function, which takes a matrix as input
  * and also a DatasetInfo object and outputs a matrix.
@@ -169,6 +273,34 @@ void OneHotEncoding(const arma::Mat<eT>& input,
   OneHotEncoding(input, arma::Col<size_t>(indices), output);
 }
 
+/**
+ * Overloaded function for the above function which writes the encoding into
+ * a sparse matrix, optionally hashing the mapped category values into
+ * numBuckets buckets per dimension.
+ *
+ * @param input Input dataset to be encoded.
+ * @param output Encoded sparse matrix.
+ * @param datasetInfo DatasetInfo object that has information about data.
+ * @param numBuckets Number of hash buckets per encoded dimension; 0 means
+ *      exact one-hot encoding.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    arma::SpMat<eT>& output,
+                    const data::DatasetInfo& datasetInfo,
+                    const size_t numBuckets)
+{
+  std::vector<size_t> indices;
+  for (size_t i = 0; i < datasetInfo.Dimensionality(); ++i)
+  {
+    if (datasetInfo.Type(i) == data::Datatype::categorical)
+    {
+      indices.push_back(i);
+    }
+  }
+  OneHotEncoding(input, arma::Col<size_t>(indices), output, numBuckets);
+}
+
 } // namespace data
 } // namespace mlpack
 
@@ -0,0 +1,270 @@
+/**
+ * @file core/data/pipeline.hpp
+ *
+ * Pipeline class to compose several data transformations (scalers, imputers,
+ * encoders) into one fused, blocked transform.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_PIPELINE_HPP
+#define MLPACK_CORE_DATA_PIPELINE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * The Pipeline class chains several data transformations with the standard
+ * Fit() / Transform() / InverseTransform() interface (the scaler methods,
+ * and anything else that follows the same interface) into one object with
+ * that same interface.
+ *
+ * Applying chained transformations one after another makes a full pass over
+ * the dataset and a full-size copy per stage.  Transform() (and
+ * InverseTransform()) instead walk the dataset once in blocks of columns and
+ * push every block through all stages while it is cache resident, so only
+ * one pass over the dataset and one output allocation are made no matter how
+ * many stages the pipeline has; the blocks are processed in parallel.  This
+ * requires every stage to transform columns independently, which holds for
+ * all of the scaler methods (including the whitening transforms, which are a
+ * fixed matrix product per column after fitting).
+ *
+ * Fit() fits the first stage on the input, transforms it, fits the second
+ * stage on the result, and so on, since the statistics of each stage depend
+ * on the output of the previous ones.
+ *
+ * The whole pipeline (all fitted stage statistics) serializes as one object.
+ *
+ * @code
+ * arma::mat input;
+ * Load("train.csv", input);
+ * arma::mat output;
+ *
+ * // Standardize the features, then map them to [0, 1].
+ * Pipeline<StandardScaler, MinMaxScaler> pipeline;
+ * pipeline.Fit(input);
+ *
+ * // One pass over the data, both stages applied per block.
+ * pipeline.Transform(input, output);
+ *
+ * // Retransform the input.
+ * pipeline.InverseTransform(output, input);
+ * @endcode
+ *
+ * @tparam TransformTypes The types of the transformations, in the order in
+ *     which they are applied by Transform().
+ */
+template<typename... TransformTypes>
+class Pipeline
+{
+ public:
+  //! The number of stages in the pipeline.
+  static const size_t NumStages = sizeof...(TransformTypes);
+
+  /**
+   * Create the pipeline with default-constructed stages.
+   */
+  Pipeline() { }
+
+  /**
+   * Create the pipeline from already-constructed stages (e.g. stages whose
+   * constructors take parameters).
+   *
+   * @param transforms The stages, in application order.
+   */
+  Pipeline(TransformTypes... transforms) :
+      transforms(std::move(transforms)...)
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * Fit all stages: the first stage is fit on the input, each later stage on
+   * the transformed output of the stages before it.
+   *
+   * @param input Dataset to fit.
+   */
+  template<typename MatType>
+  void Fit(const MatType& input)
+  {
+    FitStages<0>(input);
+  }
+
+  /**
+   * Apply all stages to the dataset in one blocked pass.
+   *
+   * @param input Dataset to transform.
+   * @param output Output matrix with all stages applied.
+   */
+  template<typename MatType>
+  void Transform(const MatType& input, MatType& output)
+  {
+    if (NumStages == 0 || input.n_cols == 0)
+    {
+      output = input;
+      return;
+    }
+
+    // The first block determines the output dimensionality.
+    const size_t firstEnd = std::min(blockSize, (size_t) input.n_cols) - 1;
+    MatType block = input.cols(0, firstEnd);
+    TransformStages<0>(block);
+    output.set_size(block.n_rows, input.n_cols);
+    output.cols(0, firstEnd) = block;
+
+    // Process the remaining blocks in parallel; the stages are only read
+    // here, and every block writes a disjoint part of the output.
+    const size_t blocks = (input.n_cols + blockSize - 1) / blockSize;
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 1; i < (omp_size_t) blocks; ++i)
+    {
+      const size_t begin = i * blockSize;
+      const size_t end = std::min(begin + blockSize,
+          (size_t) input.n_cols) - 1;
+      MatType localBlock = input.cols(begin, end);
+      TransformStages<0>(localBlock);
+      output.cols(begin, end) = localBlock;
+    }
+  }
+
+  /**
+   * Apply the inverses of all stages, in reverse order, in one blocked pass.
+   *
+   * @param input Transformed dataset.
+   * @param output Output matrix with the original dataset.
+   */
+  template<typename MatType>
+  void InverseTransform(const MatType& input, MatType& output)
+  {
+    if (NumStages == 0 || input.n_cols == 0)
+    {
+      output = input;
+      return;
+    }
+
+    const size_t firstEnd = std::min(blockSize, (size_t) input.n_cols) - 1;
+    MatType block = input.cols(0, firstEnd);
+    InverseStages<NumStages>(block);
+    output.set_size(block.n_rows, input.n_cols);
+    output.cols(0, firstEnd) = block;
+
+    const size_t blocks = (input.n_cols + blockSize - 1) / blockSize;
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 1; i < (omp_size_t) blocks; ++i)
+    {
+      const size_t begin = i * blockSize;
+      const size_t end = std::min(begin + blockSize,
+          (size_t) input.n_cols) - 1;
+      MatType localBlock = input.cols(begin, end);
+      InverseStages<NumStages>(localBlock);
+      output.cols(begin, end) = localBlock;
+    }
+  }
+
+  //! Get the stage at the given position.
+  template<size_t I>
+  const typename std::tuple_element<I, std::tuple<TransformTypes...> >::type&
+  Stage() const { return std::get<I>(transforms); }
+  //! Modify the stage at the given position.
+  template<size_t I>
+  typename std::tuple_element<I, std::tuple<TransformTypes...> >::type&
+  Stage() { return std::get<I>(transforms); }
+
+  //! Get the number of columns processed per block.
+  size_t BlockSize() const { return blockSize; }
+  //! Modify the number of columns processed per block.
+  size_t& BlockSize() { return blockSize; }
+
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t version)
+  {
+    ar(CEREAL_NVP(blockSize));
+    SerializeStages<0>(ar, version);
+  }
+
+ private:
+  //! Fit stage I and recurse with the transformed data, if a later stage
+  //! still needs it.
+  template<size_t I, typename MatType>
+  typename std::enable_if<(I + 1 < NumStages), void>::type
+  FitStages(const MatType& input)
+  {
+    std::get<I>(transforms).Fit(input);
+    MatType transformed;
+    std::get<I>(transforms).Transform(input, transformed);
+    FitStages<I + 1>(transformed);
+  }
+
+  //! Fit the last stage; its output is not needed.
+  template<size_t I, typename MatType>
+  typename std::enable_if<(I + 1 == NumStages), void>::type
+  FitStages(const MatType& input)
+  {
+    std::get<I>(transforms).Fit(input);
+  }
+
+  //! Base case for the empty pipeline.
+  template<size_t I, typename MatType>
+  typename std::enable_if<(I >= NumStages), void>::type
+  FitStages(const MatType& /* input */) { }
+
+  //! Apply stages I and onwards to the block, in place.
+  template<size_t I, typename MatType>
+  typename std::enable_if<(I < NumStages), void>::type
+  TransformStages(MatType& block)
+  {
+    MatType transformed;
+    std::get<I>(transforms).Transform(block, transformed);
+    block = std::move(transformed);
+    TransformStages<I + 1>(block);
+  }
+
+  template<size_t I, typename MatType>
+  typename std::enable_if<(I == NumStages), void>::type
+  TransformStages(MatType& /* block */) { }
+
+  //! Apply the inverses of the first I stages to the block, in reverse
+  //! order, in place.
+  template<size_t I, typename MatType>
+  typename std::enable_if<(I > 0), void>::type
+  InverseStages(MatType& block)
+  {
+    MatType transformed;
+    std::get<I - 1>(transforms).InverseTransform(block, transformed);
+    block = std::move(transformed);
+    InverseStages<I - 1>(block);
+  }
+
+  template<size_t I, typename MatType>
+  typename std::enable_if<(I == 0), void>::type
+  InverseStages(MatType& /* block */) { }
+
+  //! Serialize every stage under a unique name.
+  template<size_t I, typename Archive>
+  typename std::enable_if<(I < NumStages), void>::type
+  SerializeStages(Archive& ar, const uint32_t version)
+  {
+    const std::string name = "stage" + std::to_string(I);
+    ar(cereal::make_nvp(name.c_str(), std::get<I>(transforms)));
+    SerializeStages<I + 1>(ar, version);
+  }
+
+  template<size_t I, typename Archive>
+  typename std::enable_if<(I == NumStages), void>::type
+  SerializeStages(Archive& /* ar */, const uint32_t /* version */) { }
+
+  //! The stages, in application order.
+  std::tuple<TransformTypes...> transforms;
+
+  //! The number of columns pushed through all stages at a time.
+  size_t blockSize = 4096;
+}; // class Pipeline
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,72 @@
+/**
+ * @file core/data/quantize.hpp
+ * @author Ryan Curtin
+ *
+ * Quantize a floating-point dataset to int8 with a per-dimension affine map.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_QUANTIZE_HPP
+#define MLPACK_CORE_DATA_QUANTIZE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Quantize each dimension of the input dataset to int8 with an affine map,
+ * so that an original value is approximately reconstructed as
+ *
+ * @f[
+ * x_d \approx s_d q_d + o_d
+ * @f]
+ *
+ * where @f$ q_d \in [-128, 127] @f$ is the quantized value and @f$ s_d @f$
+ * and @f$ o_d @f$ are the returned per-dimension scale and offset.  The
+ * scale of a constant dimension is set to 1.
+ *
+ * The quantized matrix is 4x smaller than a float matrix and 8x smaller than
+ * a double one.  Passing the returned scales to
+ * metric::QuantizedEuclideanDistance gives distances between quantized
+ * points that approximate the Euclidean distances between the original
+ * points (the offsets cancel in any difference of two points).
+ *
+ * @param input Dataset to quantize.
+ * @param output Matrix to store the quantized dataset in.
+ * @param scale Vector to store the per-dimension scales in.
+ * @param offset Vector to store the per-dimension offsets in.
+ */
+template<typename eT>
+void Quantize(const arma::Mat<eT>& input,
+              arma::Mat<arma::s8>& output,
+              arma::vec& scale,
+              arma::vec& offset);
+
+/**
+ * Quantize the input dataset with an existing affine map, as returned by the
+ * other Quantize() overload.  Use this to quantize a query set with the same
+ * map as an already-quantized reference set, so that distances between the
+ * two sets remain comparable.  Values outside the representable range are
+ * clamped to [-128, 127].
+ *
+ * @param input Dataset to quantize.
+ * @param output Matrix to store the quantized dataset in.
+ * @param scale Per-dimension scales to use.
+ * @param offset Per-dimension offsets to use.
+ */
+template<typename eT>
+void Quantize(const arma::Mat<eT>& input,
+              arma::Mat<arma::s8>& output,
+              const arma::vec& scale,
+              const arma::vec& offset);
+
+} // namespace data
+} // namespace mlpack
+
+#include "quantize_impl.hpp"
+
+#endif
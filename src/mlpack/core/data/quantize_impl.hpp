@@ -0,0 +1,78 @@
+/**
+ * @file core/data/quantize_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of dataset quantization.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_QUANTIZE_IMPL_HPP
+#define MLPACK_CORE_DATA_QUANTIZE_IMPL_HPP
+
+// In case it hasn't been included.
+#include "quantize.hpp"
+
+namespace mlpack {
+namespace data {
+
+template<typename eT>
+void Quantize(const arma::Mat<eT>& input,
+              arma::Mat<arma::s8>& output,
+              arma::vec& scale,
+              arma::vec& offset)
+{
+  output.set_size(input.n_rows, input.n_cols);
+  scale.set_size(input.n_rows);
+  offset.set_size(input.n_rows);
+
+  for (size_t d = 0; d < input.n_rows; ++d)
+  {
+    const double minVal = (double) arma::min(input.row(d));
+    const double maxVal = (double) arma::max(input.row(d));
+
+    // A constant dimension carries no information; use a unit scale so the
+    // affine map stays well defined.
+    scale[d] = (maxVal > minVal) ? (maxVal - minVal) / 255.0 : 1.0;
+    offset[d] = minVal + 128.0 * scale[d];
+
+    for (size_t i = 0; i < input.n_cols; ++i)
+    {
+      const double q = std::round(((double) input(d, i) - minVal) / scale[d])
+          - 128.0;
+      output(d, i) = (arma::s8) std::max(-128.0, std::min(127.0, q));
+    }
+  }
+}
+
+template<typename eT>
+void Quantize(const arma::Mat<eT>& input,
+              arma::Mat<arma::s8>& output,
+              const arma::vec& scale,
+              const arma::vec& offset)
+{
+  if (scale.n_elem != input.n_rows || offset.n_elem != input.n_rows)
+  {
+    throw std::invalid_argument("data::Quantize(): scale and offset must have "
+        "one element per dimension of the input dataset");
+  }
+
+  output.set_size(input.n_rows, input.n_cols);
+
+  for (size_t d = 0; d < input.n_rows; ++d)
+  {
+    for (size_t i = 0; i < input.n_cols; ++i)
+    {
+      const double q = std::round(((double) input(d, i) - offset[d]) /
+          scale[d]);
+      output(d, i) = (arma::s8) std::max(-128.0, std::min(127.0, q));
+    }
+  }
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,91 @@
+/**
+ * @file core/data/save_async.hpp
+ *
+ * Asynchronous variants of data::Save().  The matrix (or model) is snapshotted
+ * into a private buffer and written by a background thread, so the caller can
+ * keep computing---and keep mutating its own copy---while the previous stage's
+ * output is being persisted.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_SAVE_ASYNC_HPP
+#define MLPACK_CORE_DATA_SAVE_ASYNC_HPP
+
+#include <future>
+
+#include "save.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Saves a matrix to file on a background thread, returning immediately.  The
+ * file type handling, transposition, and error reporting are identical to
+ * Save(); the difference is that the write happens asynchronously, so the
+ * caller's computation overlaps the disk I/O.
+ *
+ * The matrix is taken by value: it is snapshotted into a buffer owned by the
+ * background writer before this function returns, so the caller may modify or
+ * destroy its matrix right away.  Pass the matrix with std::move() to turn
+ * the snapshot into a transfer and avoid the copy when the matrix is no
+ * longer needed.
+ *
+ * The returned future yields the same success flag Save() would have
+ * returned; retrieving it (or destroying the future) waits for the write to
+ * finish.  If `fatal` is set to true, the std::runtime_error thrown on
+ * failure is captured in the future and rethrown by get().
+ *
+ * @param filename Name of file to save to.
+ * @param matrix Matrix to save into file (snapshotted; pass with std::move()
+ *      to avoid the copy).
+ * @param fatal If an error should be reported as fatal (default false).
+ * @param transpose If true, transpose the matrix before saving (default
+ *      true).
+ * @param inputSaveType File type to save to (defaults to arma::auto_detect).
+ * @return Future holding the boolean success flag of the save.
+ */
+template<typename eT>
+std::future<bool> SaveAsync(
+    const std::string& filename,
+    arma::Mat<eT> matrix,
+    const bool fatal = false,
+    const bool transpose = true,
+    const arma::file_type inputSaveType = arma::auto_detect);
+
+/**
+ * Saves a model to file on a background thread, returning immediately.  The
+ * format handling and error reporting are identical to the model overload of
+ * Save(); the model is snapshotted with its copy constructor before this
+ * function returns, so the caller may keep training or modifying its own
+ * copy while the snapshot is serialized.
+ *
+ * The returned future yields the same success flag Save() would have
+ * returned; retrieving it (or destroying the future) waits for the write to
+ * finish.  If `fatal` is set to true, the std::runtime_error thrown on
+ * failure is captured in the future and rethrown by get().
+ *
+ * @param filename Name of file to save to.
+ * @param name Name of the structure to be saved (must match the name later
+ *      given to Load()).
+ * @param t Model to save (snapshotted with its copy constructor).
+ * @param fatal If an error should be reported as fatal (default false).
+ * @param f Format to save with (defaults to format::autodetect).
+ * @return Future holding the boolean success flag of the save.
+ */
+template<typename T>
+std::future<bool> SaveAsync(const std::string& filename,
+                            const std::string& name,
+                            const T& t,
+                            const bool fatal = false,
+                            format f = format::autodetect);
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "save_async_impl.hpp"
+
+#endif
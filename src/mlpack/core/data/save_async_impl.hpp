@@ -0,0 +1,62 @@
+/**
+ * @file core/data/save_async_impl.hpp
+ *
+ * Implementation of the asynchronous save functionality.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_SAVE_ASYNC_IMPL_HPP
+#define MLPACK_CORE_DATA_SAVE_ASYNC_IMPL_HPP
+
+// In case it hasn't already been included.
+#include "save_async.hpp"
+
+#include <memory>
+
+namespace mlpack {
+namespace data {
+
+template<typename eT>
+std::future<bool> SaveAsync(const std::string& filename,
+                            arma::Mat<eT> matrix,
+                            const bool fatal,
+                            const bool transpose,
+                            const arma::file_type inputSaveType)
+{
+  // The by-value parameter is the snapshot; hand it to the writer thread
+  // through a shared_ptr, since C++11 lambdas cannot capture by move.
+  std::shared_ptr<arma::Mat<eT>> buffer =
+      std::make_shared<arma::Mat<eT>>(std::move(matrix));
+
+  return std::async(std::launch::async,
+      [filename, buffer, fatal, transpose, inputSaveType]() -> bool
+      {
+        return Save(filename, *buffer, fatal, transpose, inputSaveType);
+      });
+}
+
+template<typename T>
+std::future<bool> SaveAsync(const std::string& filename,
+                            const std::string& name,
+                            const T& t,
+                            const bool fatal,
+                            format f)
+{
+  // Snapshot the model, so the caller's copy can keep changing while the
+  // snapshot is serialized.
+  std::shared_ptr<T> snapshot = std::make_shared<T>(t);
+
+  return std::async(std::launch::async,
+      [filename, name, snapshot, fatal, f]() -> bool
+      {
+        return Save(filename, name, *snapshot, fatal, f);
+      });
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
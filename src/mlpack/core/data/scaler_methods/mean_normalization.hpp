@@ -46,6 +46,11 @@ namespace data {
 class MeanNormalization
 {
  public:
+  /**
+   * Create the MeanNormalization object with no statistics computed.
+   */
+  MeanNormalization() : count(0) { }
+
   /**
    * Function to fit features, to find out the min max and scale.
    *
@@ -54,9 +59,83 @@ class MeanNormalization
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMean = arma::mean(input, 1);
-    itemMin = arma::min(input, 1);
-    itemMax = arma::max(input, 1);
+    // Reset any statistics accumulated by previous Fit() or PartialFit()
+    // calls, then consume the dataset as a single chunk.
+    count = 0;
+    PartialFit(input);
+  }
+
+  /**
+   * Update the statistics with one chunk of the dataset.  Chunks may be fed
+   * one at a time, so the full dataset never needs to be in memory; the
+   * resulting scaler is identical to one fit on the concatenation of all
+   * chunks.
+   *
+   * @param input Chunk of the dataset to fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& input)
+  {
+    if (input.n_cols == 0)
+      return;
+
+    const size_t n = input.n_cols;
+    const arma::vec chunkMean = arma::mean(input, 1);
+    const arma::vec chunkMin = arma::min(input, 1);
+    const arma::vec chunkMax = arma::max(input, 1);
+
+    if (count == 0)
+    {
+      itemMean = chunkMean;
+      itemMin = chunkMin;
+      itemMax = chunkMax;
+      count = n;
+    }
+    else
+    {
+      const size_t total = count + n;
+      itemMean += (chunkMean - itemMean) * ((double) n / total);
+      itemMin = arma::min(itemMin, chunkMin);
+      itemMax = arma::max(itemMax, chunkMax);
+      count = total;
+    }
+
+    scale = itemMax - itemMin;
+    // Handling zeros in scale vector.
+    scale.for_each([](arma::vec::elem_type& val) { val =
+        (val == 0) ? 1 : val; });
+  }
+
+  /**
+   * Combine the statistics of another scaler into this one, exactly as if
+   * every chunk the other scaler has seen had been passed to PartialFit() of
+   * this scaler.  This allows parallel workers to fit disjoint shards of a
+   * dataset independently and merge the results.
+   *
+   * @param other Fitted scaler whose statistics will be merged.
+   */
+  void Merge(const MeanNormalization& other)
+  {
+    if (other.count == 0)
+      return;
+
+    if (count == 0)
+    {
+      itemMean = other.itemMean;
+      itemMin = other.itemMin;
+      itemMax = other.itemMax;
+      count = other.count;
+    }
+    else
+    {
+      const size_t total = count + other.count;
+      itemMean += (other.itemMean - itemMean) *
+          ((double) other.count / total);
+      itemMin = arma::min(itemMin, other.itemMin);
+      itemMax = arma::max(itemMax, other.itemMax);
+      count = total;
+    }
+
     scale = itemMax - itemMin;
     // Handling zeros in scale vector.
     scale.for_each([](arma::vec::elem_type& val) { val =
@@ -81,6 +160,23 @@ class MeanNormalization
     output = (input.each_col() - itemMean).each_col() / scale;
   }
 
+  /**
+   * Function to scale features in place, without allocating a second matrix.
+   *
+   * @param inputOutput Dataset whose features will be scaled in place.
+   */
+  template<typename MatType>
+  void Transform(MatType& inputOutput)
+  {
+    if (itemMean.is_empty() || scale.is_empty())
+    {
+      throw std::runtime_error("Call Fit() before Transform(), please"
+        " refer to the documentation.");
+    }
+    inputOutput.each_col() -= itemMean;
+    inputOutput.each_col() /= scale;
+  }
+
   /**
    * Function to retrieve original dataset.
    *
@@ -102,6 +198,8 @@ class MeanNormalization
   const arma::vec& ItemMax() const { return itemMax; }
   //! Get the Scale row vector.
   const arma::vec& Scale() const { return scale; }
+  //! Get the number of samples the statistics were computed from.
+  size_t Count() const { return count; }
 
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */)
@@ -110,9 +208,12 @@ class MeanNormalization
     ar(CEREAL_NVP(itemMax));
     ar(CEREAL_NVP(scale));
     ar(CEREAL_NVP(itemMean));
+    ar(CEREAL_NVP(count));
   }
 
  private:
+  // Number of samples seen by Fit(), PartialFit() and Merge() so far.
+  size_t count;
   // Vector which holds mean of each feature.
   arma::vec itemMean;
   // Vector which holds minimum of each feature.
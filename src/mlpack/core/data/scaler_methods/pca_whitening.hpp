@@ -72,8 +72,9 @@ class PCAWhitening
   {
     itemMean = arma::mean(input, 1);
     // Get eigenvectors and eigenvalues of covariance of input matrix.
-    eig_sym(eigenValues, eigenVectors, mlpack::math::ColumnCovariance(
-        input.each_col() - itemMean));
+    // ColumnCovariance() centers internally, so no centered copy of the
+    // input is materialized here.
+    eig_sym(eigenValues, eigenVectors, mlpack::math::ColumnCovariance(input));
     eigenValues += epsilon;
   }
 
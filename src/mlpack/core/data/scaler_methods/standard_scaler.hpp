@@ -47,6 +47,11 @@ namespace data {
 class StandardScaler
 {
  public:
+  /**
+   * Create the StandardScaler object with no statistics computed.
+   */
+  StandardScaler() : count(0) { }
+
   /**
    * Function to fit features, to find out the min max and scale.
    *
@@ -55,8 +60,91 @@ class StandardScaler
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMean = arma::mean(input, 1);
-    itemStdDev = arma::stddev(input, 1, 1);
+    // Reset any statistics accumulated by previous Fit() or PartialFit()
+    // calls, then consume the dataset as a single chunk.
+    count = 0;
+    runningMean.clear();
+    runningM2.clear();
+    PartialFit(input);
+  }
+
+  /**
+   * Update the statistics with one chunk of the dataset.  Chunks may be fed
+   * one at a time, so the full dataset never needs to be in memory; the
+   * resulting scaler is identical to one fit on the concatenation of all
+   * chunks.  The chunk statistics are folded into the running statistics with
+   * Welford's parallel update, which is numerically stable over any number of
+   * chunks.
+   *
+   * @param input Chunk of the dataset to fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& input)
+  {
+    if (input.n_cols == 0)
+      return;
+
+    const size_t n = input.n_cols;
+    const arma::vec chunkMean = arma::mean(input, 1);
+    const arma::vec chunkM2 =
+        arma::sum(arma::square(input.each_col() - chunkMean), 1);
+
+    if (count == 0)
+    {
+      runningMean = chunkMean;
+      runningM2 = chunkM2;
+      count = n;
+    }
+    else
+    {
+      const arma::vec delta = chunkMean - runningMean;
+      const size_t total = count + n;
+
+      runningM2 += chunkM2 + arma::square(delta) *
+          (((double) count * n) / total);
+      runningMean += delta * ((double) n / total);
+      count = total;
+    }
+
+    itemMean = runningMean;
+    itemStdDev = arma::sqrt(runningM2 / count);
+    // Handle zeros in scale vector.
+    itemStdDev.for_each([](arma::vec::elem_type& val) { val =
+        (val == 0) ? 1 : val; });
+  }
+
+  /**
+   * Combine the statistics of another scaler into this one, exactly as if
+   * every chunk the other scaler has seen had been passed to PartialFit() of
+   * this scaler.  This allows parallel workers to fit disjoint shards of a
+   * dataset independently and merge the results.
+   *
+   * @param other Fitted scaler whose statistics will be merged.
+   */
+  void Merge(const StandardScaler& other)
+  {
+    if (other.count == 0)
+      return;
+
+    if (count == 0)
+    {
+      runningMean = other.runningMean;
+      runningM2 = other.runningM2;
+      count = other.count;
+    }
+    else
+    {
+      const arma::vec delta = other.runningMean - runningMean;
+      const size_t total = count + other.count;
+
+      runningM2 += other.runningM2 + arma::square(delta) *
+          (((double) count * other.count) / total);
+      runningMean += delta * ((double) other.count / total);
+      count = total;
+    }
+
+    itemMean = runningMean;
+    itemStdDev = arma::sqrt(runningM2 / count);
     // Handle zeros in scale vector.
     itemStdDev.for_each([](arma::vec::elem_type& val) { val =
         (val == 0) ? 1 : val; });
@@ -80,6 +168,23 @@ class StandardScaler
     output = (input.each_col() - itemMean).each_col() / itemStdDev;
   }
 
+  /**
+   * Function to scale features in place, without allocating a second matrix.
+   *
+   * @param inputOutput Dataset whose features will be scaled in place.
+   */
+  template<typename MatType>
+  void Transform(MatType& inputOutput)
+  {
+    if (itemMean.is_empty() || itemStdDev.is_empty())
+    {
+      throw std::runtime_error("Call Fit() before Transform(), please"
+        " refer to the documentation.");
+    }
+    inputOutput.each_col() -= itemMean;
+    inputOutput.each_col() /= itemStdDev;
+  }
+
   /**
    * Function to retrieve original dataset.
    *
@@ -97,12 +202,17 @@ class StandardScaler
   const arma::vec& ItemMean() const { return itemMean; }
   //! Get the standard deviation row vector.
   const arma::vec& ItemStdDev() const { return itemStdDev; }
+  //! Get the number of samples the statistics were computed from.
+  size_t Count() const { return count; }
 
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */)
   {
     ar(CEREAL_NVP(itemMean));
     ar(CEREAL_NVP(itemStdDev));
+    ar(CEREAL_NVP(count));
+    ar(CEREAL_NVP(runningMean));
+    ar(CEREAL_NVP(runningM2));
   }
 
  private:
@@ -110,6 +220,12 @@ class StandardScaler
   arma::vec itemMean;
   // Vector which holds standard devation of each feature.
   arma::vec itemStdDev;
+  // Number of samples seen by Fit(), PartialFit() and Merge() so far.
+  size_t count;
+  // Running mean of each feature over all samples seen so far.
+  arma::vec runningMean;
+  // Running sum of squared deviations from the mean of each feature.
+  arma::vec runningM2;
 }; // class StandardScaler
 
 } // namespace data
@@ -15,9 +15,109 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "column_subset_view.hpp"
+
 namespace mlpack {
 namespace data {
 
+/**
+ * Compute a train/test split as two index sets over the columns of a dataset,
+ * without touching the data itself.  This is the allocation-free counterpart
+ * of Split(): the returned indices can be used with ColumnSubsetView to
+ * iterate the splits in place, or with arma's cols() to gather them later.
+ *
+ * @code
+ * arma::uvec trainIndices, testIndices;
+ * data::SplitIndices(dataset.n_cols, trainIndices, testIndices, 0.3);
+ * data::ColumnSubsetView<double> trainView(dataset, trainIndices);
+ * @endcode
+ *
+ * @param numPoints Number of columns (points) in the dataset to split.
+ * @param trainIndices Vector to store the training set indices into.
+ * @param testIndices Vector to store the test set indices into.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *     sample is visited in linear order. (Default true.)
+ */
+inline void SplitIndices(const size_t numPoints,
+                         arma::uvec& trainIndices,
+                         arma::uvec& testIndices,
+                         const double testRatio,
+                         const bool shuffleData = true)
+{
+  const size_t testSize = static_cast<size_t>(numPoints * testRatio);
+  const size_t trainSize = numPoints - testSize;
+
+  arma::uvec order = arma::linspace<arma::uvec>(0, numPoints - 1, numPoints);
+  if (shuffleData)
+    order = arma::shuffle(order);
+
+  trainIndices = (trainSize > 0) ? order.subvec(0, trainSize - 1) :
+      arma::uvec();
+  testIndices = (trainSize < numPoints) ?
+      order.subvec(trainSize, numPoints - 1) : arma::uvec();
+}
+
+/**
+ * Compute a stratified train/test split as two index sets over the columns of
+ * a dataset, without touching the data itself.  The ratio of each class in
+ * the two index sets matches its ratio in the input labels, using the same
+ * strategy as StratifiedSplit().
+ *
+ * @param inputLabel Input labels to stratify on.
+ * @param trainIndices Vector to store the training set indices into.
+ * @param testIndices Vector to store the test set indices into.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *     sample is visited in linear order. (Default true.)
+ */
+template<typename U>
+void StratifiedSplitIndices(const arma::Row<U>& inputLabel,
+                            arma::uvec& trainIndices,
+                            arma::uvec& testIndices,
+                            const double testRatio,
+                            const bool shuffleData = true)
+{
+  const size_t numPoints = inputLabel.n_elem;
+  const U maxLabel = inputLabel.max();
+
+  arma::uvec labelCounts(maxLabel + 1, arma::fill::zeros);
+  arma::uvec testLabelCounts(maxLabel + 1, arma::fill::zeros);
+
+  for (U label : inputLabel)
+    ++labelCounts[label];
+
+  size_t trainSize = 0;
+  size_t testSize = 0;
+  for (arma::uword labelCount : labelCounts)
+  {
+    testSize += floor(labelCount * testRatio);
+    trainSize += labelCount - floor(labelCount * testRatio);
+  }
+
+  arma::uvec order = arma::linspace<arma::uvec>(0, numPoints - 1, numPoints);
+  if (shuffleData)
+    order = arma::shuffle(order);
+
+  trainIndices.set_size(trainSize);
+  testIndices.set_size(testSize);
+  size_t trainIdx = 0;
+  size_t testIdx = 0;
+  for (arma::uword i : order)
+  {
+    const U label = inputLabel[i];
+    if (testLabelCounts[label] < floor(labelCounts[label] * testRatio))
+    {
+      testLabelCounts[label] += 1;
+      testIndices[testIdx++] = i;
+    }
+    else
+    {
+      trainIndices[trainIdx++] = i;
+    }
+  }
+}
+
 /**
  * Given an input dataset and labels, stratify into a training set and test set.
  * It is recommended to have the input labels between the range [0, n) where n
@@ -368,6 +468,56 @@ Split(const arma::Mat<T>& input,
                          std::move(testData));
 }
 
+/**
+ * Given an input dataset, split into training and test views without copying
+ * any data.  The returned ColumnSubsetViews reference the input matrix, which
+ * must outlive them; columns are gathered on demand as they are accessed.
+ * This avoids the doubled memory footprint of the materializing Split()
+ * overloads, which matters most for the common train/validate workflow on
+ * large datasets.
+ *
+ * @code
+ * arma::mat input = loadData();
+ * auto views = SplitView(input, 0.2);
+ * const data::ColumnSubsetView<double>& trainView = std::get<0>(views);
+ * @endcode
+ *
+ * @param input Input dataset to split (must outlive the returned views).
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *       sample is visited in linear order. (Default true).
+ * @param stratifyData If true, the train and test splits are stratified on
+ *       the given labels (which must then be non-empty).
+ * @param inputLabel Labels to stratify on, if stratifyData is true.
+ * @return std::tuple containing the training view (ColumnSubsetView<T>) and
+ *      the test view (ColumnSubsetView<T>).
+ */
+template<typename T, typename U = size_t>
+std::tuple<ColumnSubsetView<T>, ColumnSubsetView<T>>
+SplitView(const arma::Mat<T>& input,
+          const double testRatio,
+          const bool shuffleData = true,
+          const bool stratifyData = false,
+          const arma::Row<U>& inputLabel = arma::Row<U>())
+{
+  arma::uvec trainIndices;
+  arma::uvec testIndices;
+
+  if (stratifyData)
+  {
+    StratifiedSplitIndices(inputLabel, trainIndices, testIndices, testRatio,
+        shuffleData);
+  }
+  else
+  {
+    SplitIndices(input.n_cols, trainIndices, testIndices, testRatio,
+        shuffleData);
+  }
+
+  return std::make_tuple(ColumnSubsetView<T>(input, trainIndices),
+                         ColumnSubsetView<T>(input, testIndices));
+}
+
 } // namespace data
 } // namespace mlpack
 
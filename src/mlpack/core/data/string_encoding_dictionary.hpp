@@ -65,6 +65,22 @@ class StringEncodingDictionary
     return size;
   }
 
+  /**
+   * The function returns the label assigned to the given token, adding the
+   * token to the dictionary first if it is not present yet.  This is
+   * equivalent to HasToken()/AddToken()/Value(), but performs only one hash
+   * lookup.
+   *
+   * @param token The given token.
+   */
+  template<typename T>
+  size_t ValueOrAddToken(T&& token)
+  {
+    const size_t size = mapping.size() + 1;
+
+    return mapping.emplace(std::forward<T>(token), size).first->second;
+  }
+
   /**
    * The function returns the label assigned to the given token. The function
    * throws std::out_of_range if no such token is found.
@@ -178,6 +194,23 @@ class StringEncodingDictionary<boost::string_view>
     return size;
   }
 
+  /**
+   * The function returns the label assigned to the given token, adding the
+   * token to the dictionary first if it is not present yet.  Unlike
+   * HasToken()/AddToken()/Value(), a token that is already interned costs
+   * only one hash lookup.
+   *
+   * @param token The given token.
+   */
+  size_t ValueOrAddToken(const boost::string_view token)
+  {
+    auto it = mapping.find(token);
+    if (it != mapping.end())
+      return it->second;
+
+    return AddToken(token);
+  }
+
   /**
    * The function returns the label assigned to the given token. The function
    * throws std::out_of_range if no such token is found.
@@ -295,6 +328,21 @@ class StringEncodingDictionary<int>
     return size;
   }
 
+  /**
+   * The function returns the label assigned to the given token, adding the
+   * token to the dictionary first if it is not present yet. The token must
+   * belong to [0, 255]; otherwise the behavior is undefined.
+   *
+   * @param token The given token.
+   */
+  size_t ValueOrAddToken(const int token)
+  {
+    if (mapping[token] == 0)
+      mapping[token] = ++size;
+
+    return mapping[token];
+  }
+
   /**
    * The function returns the label assigned to the given token. The function
    * doesn't verify that the dictionary contains the token. The token must
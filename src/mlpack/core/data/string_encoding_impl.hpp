@@ -79,8 +79,7 @@ void StringEncoding<EncodingPolicyType, DictionaryType>::CreateMap(
   // The loop below adds the extracted tokens to the dictionary.
   while (!tokenizer.IsTokenEmpty(token))
   {
-    if (!dictionary.HasToken(token))
-      dictionary.AddToken(std::move(token));
+    dictionary.ValueOrAddToken(std::move(token));
 
     token = tokenizer(strView);
   }
@@ -109,6 +108,11 @@ EncodeHelper(const std::vector<std::string>& input,
 
   policy.Reset();
 
+  // The labels of all extracted tokens are recorded during the first pass, so
+  // that the second pass does not need to tokenize the documents or query the
+  // dictionary again.
+  std::vector<std::vector<size_t>> labels(input.size());
+
   // The first pass adds the extracted tokens to the dictionary.
   for (size_t i = 0; i < input.size(); ++i)
   {
@@ -126,10 +130,10 @@ EncodeHelper(const std::vector<std::string>& input,
 
     while (!tokenizer.IsTokenEmpty(token))
     {
-      if (!dictionary.HasToken(token))
-        dictionary.AddToken(std::move(token));
+      const size_t value = dictionary.ValueOrAddToken(std::move(token));
 
-      policy.PreprocessToken(i, numTokens, dictionary.Value(token));
+      policy.PreprocessToken(i, numTokens, value);
+      labels[i].push_back(value);
 
       token = tokenizer(strView);
       numTokens++;
@@ -140,19 +144,23 @@ EncodeHelper(const std::vector<std::string>& input,
 
   policy.InitMatrix(output, input.size(), numColumns, dictionary.Size());
 
-  // The second pass writes the encoded values to the output.
-  for (size_t i = 0; i < input.size(); ++i)
+  // The second pass writes the encoded values to the output by replaying the
+  // recorded labels.  Each document only writes to its own column of the
+  // preallocated output, so the documents can be processed in parallel;
+  // sparse output types do not support concurrent writes, so they are
+  // processed sequentially.
+  if (arma::is_arma_sparse_type<MatType>::value)
   {
-    boost::string_view strView(input[i]);
-    auto token = tokenizer(strView);
-    size_t numTokens = 0;
-
-    while (!tokenizer.IsTokenEmpty(token))
-    {
-      policy.Encode(output, dictionary.Value(token), i, numTokens);
-      token = tokenizer(strView);
-      numTokens++;
-    }
+    for (size_t i = 0; i < input.size(); ++i)
+      for (size_t j = 0; j < labels[i].size(); ++j)
+        policy.Encode(output, labels[i][j], i, j);
+  }
+  else
+  {
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) input.size(); ++i)
+      for (size_t j = 0; j < labels[i].size(); ++j)
+        policy.Encode(output, labels[i][j], i, j);
   }
 }
 
@@ -186,10 +194,7 @@ EncodeHelper(const std::vector<std::string>& input,
 
     while (!tokenizer.IsTokenEmpty(token))
     {
-      if (dictionary.HasToken(token))
-        policy.Encode(output[i], dictionary.Value(token));
-      else
-        policy.Encode(output[i], dictionary.AddToken(std::move(token)));
+      policy.Encode(output[i], dictionary.ValueOrAddToken(std::move(token)));
 
       token = tokenizer(strView);
     }
@@ -16,40 +16,132 @@ using namespace mlpack;
 using namespace mlpack::distribution;
 
 /**
- * Return a randomly generated observation according to the probability
- * distribution defined by this object.
+ * Build the per-dimension alias tables used by Random(), with Vose's method.
  */
-arma::vec DiscreteDistribution::Random() const
+void DiscreteDistribution::BuildAliasTables() const
 {
-  size_t dimension = probabilities.size();
-  arma::vec result(dimension);
+  const size_t dimensions = probabilities.size();
+  aliasProbs.resize(dimensions);
+  aliasTargets.resize(dimensions);
 
-  for (size_t d = 0; d < dimension; d++)
+  for (size_t d = 0; d < dimensions; ++d)
   {
-    // Generate a random number.
-    double randObs = math::Random();
+    const size_t numObs = probabilities[d].n_elem;
+    aliasProbs[d].set_size(numObs);
+    aliasTargets[d].set_size(numObs);
+
+    // Scale the probabilities so that the uniform distribution has weight 1 in
+    // every bin.
+    arma::vec scaled = probabilities[d] * numObs;
 
-    double sumProb = 0;
+    // Partition the bins into those with less than uniform weight and those
+    // with at least uniform weight.
+    std::vector<size_t> small, large;
+    small.reserve(numObs);
+    large.reserve(numObs);
+    for (size_t obs = 0; obs < numObs; ++obs)
+    {
+      if (scaled[obs] < 1.0)
+        small.push_back(obs);
+      else
+        large.push_back(obs);
+    }
 
-    for (size_t obs = 0; obs < probabilities[d].n_elem; obs++)
+    // Fill each underfull bin with the excess weight of an overfull bin; the
+    // overfull bin becomes the alias target of that bin.
+    while (!small.empty() && !large.empty())
     {
-      if ((sumProb += probabilities[d][obs]) >= randObs)
+      const size_t s = small.back();
+      small.pop_back();
+      const size_t l = large.back();
+
+      aliasProbs[d][s] = scaled[s];
+      aliasTargets[d][s] = l;
+
+      scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+      if (scaled[l] < 1.0)
       {
-        result[d] = obs;
-        break;
+        large.pop_back();
+        small.push_back(l);
       }
     }
 
-    if (sumProb > 1.0)
+    // Any remaining bins have weight 1 up to floating-point rounding.
+    while (!large.empty())
     {
-      // This shouldn't happen.
-      result[d] = probabilities[d].n_elem - 1;
+      aliasProbs[d][large.back()] = 1.0;
+      aliasTargets[d][large.back()] = large.back();
+      large.pop_back();
+    }
+    while (!small.empty())
+    {
+      aliasProbs[d][small.back()] = 1.0;
+      aliasTargets[d][small.back()] = small.back();
+      small.pop_back();
     }
   }
 
+  aliasValid = true;
+}
+
+/**
+ * Return a randomly generated observation according to the probability
+ * distribution defined by this object.
+ */
+arma::vec DiscreteDistribution::Random() const
+{
+  if (!aliasValid)
+    BuildAliasTables();
+
+  size_t dimension = probabilities.size();
+  arma::vec result(dimension);
+
+  for (size_t d = 0; d < dimension; d++)
+  {
+    // Pick a bin uniformly at random, then either accept it or take its
+    // alias.
+    const size_t numObs = probabilities[d].n_elem;
+    size_t bin = size_t(math::Random() * numObs);
+    if (bin >= numObs) // This shouldn't happen.
+      bin = numObs - 1;
+
+    result[d] = (math::Random() < aliasProbs[d][bin]) ?
+        double(bin) : double(aliasTargets[d][bin]);
+  }
+
   return result;
 }
 
+/**
+ * Generate many random observations at once, filling the given matrix.
+ */
+void DiscreteDistribution::Random(const size_t numSamples,
+                                  arma::mat& observations) const
+{
+  if (!aliasValid)
+    BuildAliasTables();
+
+  const size_t dimension = probabilities.size();
+  observations.set_size(dimension, numSamples);
+
+  for (size_t d = 0; d < dimension; d++)
+  {
+    const size_t numObs = probabilities[d].n_elem;
+    const arma::vec& accept = aliasProbs[d];
+    const arma::Col<size_t>& targets = aliasTargets[d];
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+      size_t bin = size_t(math::Random() * numObs);
+      if (bin >= numObs) // This shouldn't happen.
+        bin = numObs - 1;
+
+      observations(d, i) = (math::Random() < accept[bin]) ?
+          double(bin) : double(targets[bin]);
+    }
+  }
+}
+
 /**
  * Estimate the probability distribution directly from the given observations.
  */
@@ -101,6 +193,9 @@ void DiscreteDistribution::Train(const arma::mat& observations)
     else // Force normalization.
       probabilities[i].fill(1.0 / probabilities[i].n_elem);
   }
+
+  // The probabilities changed, so any cached alias tables are stale.
+  aliasValid = false;
 }
 
 /**
@@ -157,4 +252,7 @@ void DiscreteDistribution::Train(const arma::mat& observations,
     else // Force normalization.
       probabilities[i].fill(1.0 / probabilities[i].n_elem);
   }
+
+  // The probabilities changed, so any cached alias tables are stale.
+  aliasValid = false;
 }
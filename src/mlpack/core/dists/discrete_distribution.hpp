@@ -50,7 +50,9 @@ class DiscreteDistribution
    * observations.
    */
   DiscreteDistribution() :
-      probabilities(std::vector<arma::vec>(1)){ /* Nothing to do. */ }
+      probabilities(std::vector<arma::vec>(1)),
+      aliasValid(false)
+  { /* Nothing to do. */ }
 
   /**
    * Define the discrete distribution as having numObservations possible
@@ -62,7 +64,8 @@ class DiscreteDistribution
    */
   DiscreteDistribution(const size_t numObservations) :
       probabilities(std::vector<arma::vec>(1,
-          arma::ones<arma::vec>(numObservations) / numObservations))
+          arma::ones<arma::vec>(numObservations) / numObservations)),
+      aliasValid(false)
   { /* Nothing to do. */ }
 
   /**
@@ -73,7 +76,8 @@ class DiscreteDistribution
    * @param numObservations Number of possible observations this distribution
    *    can have.
    */
-  DiscreteDistribution(const arma::Col<size_t>& numObservations)
+  DiscreteDistribution(const arma::Col<size_t>& numObservations) :
+      aliasValid(false)
   {
     for (size_t i = 0; i < numObservations.n_elem; ++i)
     {
@@ -95,7 +99,8 @@ class DiscreteDistribution
    *
    * @param probabilities Probabilities of each possible observation.
    */
-  DiscreteDistribution(const std::vector<arma::vec>& probabilities)
+  DiscreteDistribution(const std::vector<arma::vec>& probabilities) :
+      aliasValid(false)
   {
     for (size_t i = 0; i < probabilities.size(); ++i)
     {
@@ -178,9 +183,36 @@ class DiscreteDistribution
    */
   void Probability(const arma::mat& x, arma::vec& probabilities) const
   {
-    probabilities.set_size(x.n_cols);
-    for (size_t i = 0; i < x.n_cols; ++i)
-      probabilities(i) = Probability(x.unsafe_col(i));
+    // Ensure the observations have the same dimension as the probabilities.
+    if (x.n_rows != this->probabilities.size())
+    {
+      Log::Fatal << "DiscreteDistribution::Probability(): observations have "
+          << "incorrect dimension " << x.n_rows << " but should have dimension "
+          << this->probabilities.size() << "!" << std::endl;
+    }
+
+    // Accumulate the product over dimensions one dimension at a time, so that
+    // the inner loop is a direct table lookup.
+    probabilities.ones(x.n_cols);
+    for (size_t dimension = 0; dimension < x.n_rows; ++dimension)
+    {
+      const arma::vec& dimProbs = this->probabilities[dimension];
+      for (size_t i = 0; i < x.n_cols; ++i)
+      {
+        // Adding 0.5 helps ensure that we cast the floating point to a size_t
+        // correctly.
+        const size_t obs = size_t(x(dimension, i) + 0.5);
+
+        // Ensure that the observation is within the bounds.
+        if (obs >= dimProbs.n_elem)
+        {
+          Log::Fatal << "DiscreteDistribution::Probability(): received "
+              << "observation " << obs << "; observation must be in [0, "
+              << dimProbs.n_elem << "] for this distribution." << std::endl;
+        }
+        probabilities(i) *= dimProbs[obs];
+      }
+    }
   }
 
   /**
@@ -193,9 +225,8 @@ class DiscreteDistribution
    */
   void LogProbability(const arma::mat& x, arma::vec& logProbabilities) const
   {
-    logProbabilities.set_size(x.n_cols);
-    for (size_t i = 0; i < x.n_cols; ++i)
-      logProbabilities(i) = log(Probability(x.unsafe_col(i)));
+    Probability(x, logProbabilities);
+    logProbabilities = arma::log(logProbabilities);
   }
 
   /**
@@ -203,10 +234,26 @@ class DiscreteDistribution
    * observation) according to the probability distribution defined by this
    * object.
    *
+   * Sampling uses per-dimension alias tables, which are built the first time
+   * a sample is drawn and reused until the probabilities change, so each draw
+   * costs O(1) per dimension.
+   *
    * @return Random observation.
    */
   arma::vec Random() const;
 
+  /**
+   * Generate numSamples random observations according to the probability
+   * distribution defined by this object, storing them in the given matrix.
+   * This is much faster than calling Random() in a loop, since the alias
+   * tables are built (if necessary) and checked only once.
+   *
+   * @param numSamples Number of observations to generate.
+   * @param observations Matrix to store the observations in; it will be set to
+   *    size (Dimensionality() x numSamples).
+   */
+  void Random(const size_t numSamples, arma::mat& observations) const;
+
   /**
    * Estimate the probability distribution directly from the given
    * observations. If any of the observations is greater than numObservations,
@@ -229,7 +276,13 @@ class DiscreteDistribution
              const arma::vec& probabilities);
 
   //! Return the vector of probabilities for the given dimension.
-  arma::vec& Probabilities(const size_t dim = 0) { return probabilities[dim]; }
+  arma::vec& Probabilities(const size_t dim = 0)
+  {
+    // The probabilities may be modified through this reference, so the alias
+    // tables must be rebuilt before the next sample is drawn.
+    aliasValid = false;
+    return probabilities[dim];
+  }
   //! Modify the vector of probabilities for the given dimension.
   const arma::vec& Probabilities(const size_t dim = 0) const
   { return probabilities[dim]; }
@@ -241,12 +294,30 @@ class DiscreteDistribution
   void serialize(Archive& ar, const uint32_t /* version */)
   {
     ar(CEREAL_NVP(probabilities));
+
+    // The alias tables are not serialized; rebuild them on first use.
+    if (cereal::is_loading<Archive>())
+      aliasValid = false;
   }
 
  private:
+  /**
+   * Build the per-dimension alias tables used by Random(), with Vose's method
+   * (O(n) per dimension).  Marks the tables as valid when done.
+   */
+  void BuildAliasTables() const;
+
   //! The probabilities for each dimension; each arma::vec represents the
   //! probabilities for the observations in each dimension.
   std::vector<arma::vec> probabilities;
+
+  //! Alias-table acceptance probabilities for each dimension (see
+  //! BuildAliasTables()).  Cached, so mutable.
+  mutable std::vector<arma::vec> aliasProbs;
+  //! Alias-table alias targets for each dimension.
+  mutable std::vector<arma::Col<size_t>> aliasTargets;
+  //! Whether the alias tables match the current probabilities.
+  mutable bool aliasValid;
 };
 
 } // namespace distribution
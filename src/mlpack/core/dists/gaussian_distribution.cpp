@@ -11,6 +11,7 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include "gaussian_distribution.hpp"
+#include <mlpack/core/math/ccov.hpp>
 #include <mlpack/methods/gmm/positive_definite_constraint.hpp>
 
 using namespace mlpack;
@@ -68,6 +69,67 @@ void GaussianDistribution::FactorCovariance()
   logDetCov *= 2;
 }
 
+void GaussianDistribution::UpdateCovariance(const arma::vec& update,
+                                            const double weight)
+{
+  const size_t d = mean.n_elem;
+
+  // Update the covariance itself.
+  covariance += weight * (update * update.t());
+
+  // Update the cached inverse with the Sherman-Morrison formula.  The
+  // denominator also detects updates that destroy positive definiteness.
+  const arma::vec invCovUpdate = invCov * update;
+  const double denom = 1.0 + weight * arma::dot(update, invCovUpdate);
+  if (denom <= 0.0)
+  {
+    Log::Fatal << "GaussianDistribution::UpdateCovariance(): update makes the "
+        << "covariance singular or indefinite." << std::endl;
+  }
+  invCov -= (weight / denom) * (invCovUpdate * invCovUpdate.t());
+
+  // Rank-1 update (or downdate) of the lower-triangular Cholesky factor,
+  // using the classical sequence of Givens-like eliminations (LINPACK's
+  // dchud/dchdd).  The weight is folded into the update vector; its sign
+  // decides between update and downdate.
+  arma::vec work = std::sqrt(std::abs(weight)) * update;
+  const double sign = (weight >= 0.0) ? 1.0 : -1.0;
+  for (size_t k = 0; k < d; ++k)
+  {
+    const double lkk = covLower(k, k);
+    const double rSquared = lkk * lkk + sign * work(k) * work(k);
+    if (rSquared <= 0.0)
+    {
+      Log::Fatal << "GaussianDistribution::UpdateCovariance(): downdate "
+          << "failed; covariance is no longer positive definite." << std::endl;
+    }
+    const double r = std::sqrt(rSquared);
+    const double c = r / lkk;
+    const double s = work(k) / lkk;
+    covLower(k, k) = r;
+
+    if (k + 1 < d)
+    {
+      // The rest of the work vector is rotated against the updated column.
+      arma::vec colTail = covLower.col(k).subvec(k + 1, d - 1);
+      const arma::vec workTail = work.subvec(k + 1, d - 1);
+      colTail = (colTail + sign * s * workTail) / c;
+      work.subvec(k + 1, d - 1) = c * workTail - s * colTail;
+      covLower.col(k).subvec(k + 1, d - 1) = colTail;
+    }
+  }
+
+  // The log-determinant follows directly from the diagonal of the factor.
+  logDetCov = 2.0 * arma::accu(arma::log(covLower.diag()));
+}
+
+void GaussianDistribution::UpdateCovariance(const arma::mat& updates,
+                                            const arma::vec& weights)
+{
+  for (size_t i = 0; i < updates.n_cols; ++i)
+    UpdateCovariance(updates.col(i), weights(i));
+}
+
 double GaussianDistribution::LogProbability(const arma::vec& observation) const
 {
   const size_t k = observation.n_elem;
@@ -101,23 +163,15 @@ void GaussianDistribution::Train(const arma::mat& observations)
     return;
   }
 
-  // Calculate the mean.
-  for (size_t i = 0; i < observations.n_cols; ++i)
-    mean += observations.col(i);
-
-  // Normalize the mean.
-  mean /= observations.n_cols;
-
-  // Now calculate the covariance.
-  for (size_t i = 0; i < observations.n_cols; ++i)
-  {
-    arma::vec obsNoMean = observations.col(i) - mean;
-    covariance += obsNoMean * trans(obsNoMean);
-  }
+  // Calculate the mean and the covariance in one fused pass over the
+  // observations; the mean is removed from the accumulated second moment at
+  // the end, so no centered copy of the observations is needed.  The
+  // (1 / (n - 1)) normalization makes this the unbiased estimator.
+  math::ColumnCovarianceAccumulator<double> accumulator(observations.n_rows);
+  accumulator.Accumulate(observations);
 
-  // Finish estimating the covariance by normalizing, with the (1 / (n - 1)) so
-  // that it is the unbiased estimator.
-  covariance /= (observations.n_cols - 1);
+  mean = accumulator.Mean();
+  covariance = accumulator.Covariance(0);
 
   // Ensure that the covariance is positive definite.
   gmm::PositiveDefiniteConstraint::ApplyConstraint(covariance);
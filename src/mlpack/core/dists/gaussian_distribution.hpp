@@ -110,14 +110,15 @@ class GaussianDistribution
     // Column i of 'diffs' is the difference between x.col(i) and the mean.
     arma::mat diffs = x;
     diffs.each_col() -= mean;
-    // Now, we only want to calculate the diagonal elements of (diffs' * cov^-1
-    // * diffs).  We just don't need any of the other elements.  We can
-    // calculate the right hand part of the equation (instead of the left side)
-    // so that later we are referencing columns, not rows -- that is faster.
-    const arma::mat rhs = -0.5 * invCov * diffs;
-    arma::vec logExponents(diffs.n_cols); // We will now fill this.
-    for (size_t i = 0; i < diffs.n_cols; ++i)
-      logExponents(i) = accu(diffs.unsafe_col(i) % rhs.unsafe_col(i));
+    // With the Cholesky factorization cov = L L^T, the Mahalanobis term
+    // (x - mu)^T cov^-1 (x - mu) is the squared norm of z = L^-1 (x - mu).
+    // One triangular solve against the cached factor computes z for all
+    // observations at once, and is both cheaper and better conditioned than
+    // multiplying by the explicit inverse.
+    const arma::mat z = arma::solve(arma::trimatl(covLower), diffs);
+    arma::vec logExponents(z.n_cols); // We will now fill this.
+    for (size_t i = 0; i < z.n_cols; ++i)
+      logExponents(i) = -0.5 * accu(z.unsafe_col(i) % z.unsafe_col(i));
 
     logProbabilities = -0.5 * x.n_rows * log2pi - 0.5 * logDetCov +
       logExponents;
@@ -168,6 +169,29 @@ class GaussianDistribution
 
   void Covariance(arma::mat&& covariance);
 
+  /**
+   * Apply a rank-1 update to the covariance:
+   * covariance += weight * update * update^T.  The cached Cholesky factor,
+   * inverse and log-determinant are updated incrementally in O(d^2) time
+   * instead of being refactorized from scratch in O(d^3), which is useful for
+   * re-estimation schemes that adjust the covariance by a few outer products
+   * per step.  A negative weight performs a downdate; if the updated
+   * covariance is no longer positive definite, a fatal error is reported.
+   *
+   * @param update Vector whose outer product is added to the covariance.
+   * @param weight Weight of the update; a negative value downdates.
+   */
+  void UpdateCovariance(const arma::vec& update, const double weight = 1.0);
+
+  /**
+   * Apply a rank-k update to the covariance: one rank-1 update per column of
+   * the given matrix, each with its corresponding weight.
+   *
+   * @param updates Matrix whose columns are the update vectors.
+   * @param weights Weight of each update; negative values downdate.
+   */
+  void UpdateCovariance(const arma::mat& updates, const arma::vec& weights);
+
   //! Return the invCov.
   const arma::mat& InvCov() const { return invCov; }
 
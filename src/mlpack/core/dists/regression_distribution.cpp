@@ -65,6 +65,20 @@ double RegressionDistribution::Probability(const arma::vec& observation) const
   return err.Probability(observation(0)-fitted.t());
 }
 
+/**
+ * Evaluate probability density function on each of the given observations.
+ */
+void RegressionDistribution::Probability(const arma::mat& observations,
+                                         arma::vec& probabilities) const
+{
+  // Predict the responses for all observations at once, then evaluate the
+  // error distribution on the whole residual vector; each residual is a
+  // one-dimensional observation of the error distribution.
+  arma::rowvec fitted;
+  rf.Predict(observations.rows(1, observations.n_rows - 1), fitted);
+  err.Probability(arma::mat(observations.row(0) - fitted), probabilities);
+}
+
 void RegressionDistribution::Predict(const arma::mat& points,
                                      arma::vec& predictions) const
 {
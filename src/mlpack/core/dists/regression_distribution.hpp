@@ -132,6 +132,31 @@ class RegressionDistribution
     return log(Probability(observation));
   }
 
+  /**
+   * Evaluate probability density function on each of the given observations
+   * (one observation per column).
+   *
+   * @param observations Points to evaluate probability at.
+   * @param probabilities Vector to store one probability per observation in.
+   */
+  void Probability(const arma::mat& observations,
+                   arma::vec& probabilities) const;
+
+  /**
+   * Evaluate log probability density function on each of the given
+   * observations (one observation per column).
+   *
+   * @param observations Points to evaluate log probability at.
+   * @param logProbabilities Vector to store one log probability per
+   *      observation in.
+   */
+  void LogProbability(const arma::mat& observations,
+                      arma::vec& logProbabilities) const
+  {
+    Probability(observations, logProbabilities);
+    logProbabilities = log(logProbabilities);
+  }
+
   /**
    * Calculate y_i for each data point in points.
    *
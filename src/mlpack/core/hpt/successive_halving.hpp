@@ -0,0 +1,233 @@
+/**
+ * @file core/hpt/successive_halving.hpp
+ * @author Kirill Mishchenko
+ *
+ * Successive halving for hyper-parameter tuning.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_HPT_SUCCESSIVE_HALVING_HPP
+#define MLPACK_CORE_HPT_SUCCESSIVE_HALVING_HPP
+
+#include <mlpack/core/cv/meta_info_extractor.hpp>
+#include <mlpack/core/cv/simple_cv.hpp>
+#include <mlpack/core/math/shuffle_data.hpp>
+
+namespace mlpack {
+namespace hpt {
+
+/**
+ * SuccessiveHalving selects the best of a set of candidate hyper-parameter
+ * configurations without evaluating every configuration on the full dataset.
+ * All candidates are first assessed on a small random subsample of the data;
+ * in every following rung the budget (the number of data points) grows by a
+ * factor of eta and only the best 1 / eta fraction of the candidates
+ * survives.  Obviously bad configurations are therefore discarded after
+ * seeing only a small part of the data, while promising ones are refined on
+ * progressively larger subsets.  The candidates of a rung are evaluated in
+ * parallel when OpenMP is available.
+ *
+ * Candidate configurations are given explicitly, as tuples of the arguments
+ * that would be passed to the Evaluate() method of the cross-validation
+ * strategy:
+ *
+ * @code
+ * SuccessiveHalving<LinearRegression, MSE> sh(0.2, data, responses);
+ *
+ * std::vector<std::tuple<double>> candidates;
+ * for (double lambda : {0.0, 0.001, 0.01, 0.1, 1.0})
+ *   candidates.push_back(std::make_tuple(lambda));
+ *
+ * // Start with 100 points and triple the budget at every rung.
+ * double bestLambda;
+ * std::tie(bestLambda) = sh.Optimize(candidates, 100);
+ * @endcode
+ *
+ * @tparam MLAlgorithm A machine learning algorithm.
+ * @tparam Metric A metric to assess the quality of a trained model.
+ * @tparam CV A cross-validation strategy used to assess a set of
+ *     hyper-parameters.
+ * @tparam MatType The type of data.
+ * @tparam PredictionsType The type of predictions (should be passed when the
+ *     predictions type is a template parameter in Train methods of the given
+ *     MLAlgorithm; arma::Row<size_t> will be used otherwise).
+ * @tparam WeightsType The type of weights (should be passed when weighted
+ *     learning is supported, and the weights type is a template parameter in
+ *     Train methods of the given MLAlgorithm; arma::vec will be used
+ *     otherwise).
+ */
+template<typename MLAlgorithm,
+         typename Metric,
+         template<typename, typename, typename, typename, typename> class CV =
+             cv::SimpleCV,
+         typename MatType = arma::mat,
+         typename PredictionsType =
+             typename cv::MetaInfoExtractor<MLAlgorithm,
+                 MatType>::PredictionsType,
+         typename WeightsType =
+             typename cv::MetaInfoExtractor<MLAlgorithm, MatType,
+                 PredictionsType>::WeightsType>
+class SuccessiveHalving
+{
+ public:
+  //! A short alias for the full type of the cross-validation.
+  using CVType =
+      CV<MLAlgorithm, Metric, MatType, PredictionsType, WeightsType>;
+
+  //! A short alias for the meta information extractor of MLAlgorithm.
+  using MIE =
+      cv::MetaInfoExtractor<MLAlgorithm, MatType, PredictionsType,
+          WeightsType>;
+
+  /**
+   * Create a SuccessiveHalving object for regression or binary classification
+   * algorithms.  The data is shuffled once, so that every subsampled budget
+   * is a random subset.
+   *
+   * @param cvParam The first constructor argument of the cross-validation
+   *     strategy (the proportion of the validation set for SimpleCV, or the
+   *     number of folds for KFoldCV).
+   * @param xs Data points to choose hyper-parameters with.
+   * @param ys Predictions (labels for classification algorithms and responses
+   *     for regression algorithms) for each data point.
+   */
+  template<bool Enabled = !MIE::TakesNumClasses,
+           typename = std::enable_if_t<Enabled>>
+  SuccessiveHalving(const double cvParam,
+                    const MatType& xs,
+                    const PredictionsType& ys);
+
+  /**
+   * Create a SuccessiveHalving object for multiclass classification
+   * algorithms.  The data is shuffled once, so that every subsampled budget
+   * is a random subset.
+   *
+   * @param cvParam The first constructor argument of the cross-validation
+   *     strategy (the proportion of the validation set for SimpleCV, or the
+   *     number of folds for KFoldCV).
+   * @param xs Data points to choose hyper-parameters with.
+   * @param ys Labels for each data point.
+   * @param numClasses Number of classes in the dataset.
+   */
+  template<bool Enabled = MIE::TakesNumClasses,
+           typename = std::enable_if_t<Enabled>>
+  SuccessiveHalving(const double cvParam,
+                    const MatType& xs,
+                    const PredictionsType& ys,
+                    const size_t numClasses);
+
+  /**
+   * Find the best of the given candidate configurations with successive
+   * halving, and return it.  Each candidate is a tuple of the arguments that
+   * would be passed to the Evaluate() method of the cross-validation
+   * strategy.  Configurations that produce invalid (NaN or infinite) scores
+   * are discarded first.
+   *
+   * @param candidates Candidate hyper-parameter configurations.
+   * @param minResource Number of data points used in the first rung.
+   * @param eta Rate at which the budget grows and the number of candidates
+   *     shrinks between rungs (eta > 1).
+   */
+  template<typename... Args>
+  std::tuple<Args...> Optimize(
+      const std::vector<std::tuple<Args...>>& candidates,
+      const size_t minResource,
+      const double eta = 3.0);
+
+  //! Get the performance measurement of the best configuration from the last
+  //! run.
+  double BestObjective() const { return bestObjective; }
+
+  //! Get the index of the best configuration from the last run.
+  size_t BestIndex() const { return bestIndex; }
+
+  //! Get the best model from the last run.
+  const MLAlgorithm& BestModel() const { return bestModel; }
+
+  //! Modify the best model from the last run.
+  MLAlgorithm& BestModel() { return bestModel; }
+
+ private:
+  /**
+   * Evaluate one candidate configuration on the first resource points of the
+   * (shuffled) data.
+   */
+  template<typename TupleType>
+  double EvaluateCandidate(const TupleType& candidate, const size_t resource);
+
+  /**
+   * Gather all elements of the candidate tuple in an argument list.  This
+   * template is called while there are still elements to gather.
+   */
+  template<typename TupleType,
+           typename... Args,
+           typename = std::enable_if_t<
+               (sizeof...(Args) < std::tuple_size<TupleType>::value)>>
+  double EvaluateConfig(CVType& cv,
+                        const TupleType& candidate,
+                        const Args&... args);
+
+  /**
+   * Call the Evaluate() method of the given cross-validation object with the
+   * gathered elements of the candidate tuple as arguments.
+   */
+  template<typename TupleType,
+           typename... Args,
+           typename = std::enable_if_t<
+               sizeof...(Args) == std::tuple_size<TupleType>::value>,
+           typename = void>
+  double EvaluateConfig(CVType& cv,
+                        const TupleType& candidate,
+                        const Args&... args);
+
+  //! Construct a cross-validation object for multiclass classification
+  //! algorithms.
+  template<typename XsType,
+           typename YsType,
+           bool Enabled = MIE::TakesNumClasses,
+           typename = std::enable_if_t<Enabled>>
+  CVType MakeCV(const XsType& xs, const YsType& ys)
+  { return CVType(cvParam, xs, ys, numClasses); }
+
+  //! Construct a cross-validation object for regression and binary
+  //! classification algorithms.
+  template<typename XsType,
+           typename YsType,
+           bool Enabled = !MIE::TakesNumClasses,
+           typename = std::enable_if_t<Enabled>,
+           typename = void>
+  CVType MakeCV(const XsType& xs, const YsType& ys)
+  { return CVType(cvParam, xs, ys); }
+
+  //! The first constructor argument of the cross-validation strategy.
+  const double cvParam;
+
+  //! Shuffled copy of the data points.
+  MatType xs;
+
+  //! Shuffled copy of the predictions.
+  PredictionsType ys;
+
+  //! Number of classes (for multiclass classification algorithms).
+  const size_t numClasses;
+
+  //! The best objective from the last run.
+  double bestObjective;
+
+  //! The index of the best configuration from the last run.
+  size_t bestIndex;
+
+  //! The best model from the last run.
+  MLAlgorithm bestModel;
+};
+
+} // namespace hpt
+} // namespace mlpack
+
+// Include implementation
+#include "successive_halving_impl.hpp"
+
+#endif
@@ -0,0 +1,209 @@
+/**
+ * @file core/hpt/successive_halving_impl.hpp
+ * @author Kirill Mishchenko
+ *
+ * Implementation of successive halving for hyper-parameter tuning.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_HPT_SUCCESSIVE_HALVING_IMPL_HPP
+#define MLPACK_CORE_HPT_SUCCESSIVE_HALVING_IMPL_HPP
+
+#include <numeric>
+
+namespace mlpack {
+namespace hpt {
+
+template<typename MLAlgorithm,
+         typename Metric,
+         template<typename, typename, typename, typename, typename> class CV,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<bool Enabled, typename>
+SuccessiveHalving<MLAlgorithm,
+                  Metric,
+                  CV,
+                  MatType,
+                  PredictionsType,
+                  WeightsType>::SuccessiveHalving(const double cvParam,
+                                                  const MatType& xs,
+                                                  const PredictionsType& ys) :
+    cvParam(cvParam),
+    numClasses(0)
+{
+  math::ShuffleData(xs, ys, this->xs, this->ys);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         template<typename, typename, typename, typename, typename> class CV,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<bool Enabled, typename>
+SuccessiveHalving<MLAlgorithm,
+                  Metric,
+                  CV,
+                  MatType,
+                  PredictionsType,
+                  WeightsType>::SuccessiveHalving(const double cvParam,
+                                                  const MatType& xs,
+                                                  const PredictionsType& ys,
+                                                  const size_t numClasses) :
+    cvParam(cvParam),
+    numClasses(numClasses)
+{
+  math::ShuffleData(xs, ys, this->xs, this->ys);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         template<typename, typename, typename, typename, typename> class CV,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... Args>
+std::tuple<Args...> SuccessiveHalving<MLAlgorithm,
+                                      Metric,
+                                      CV,
+                                      MatType,
+                                      PredictionsType,
+                                      WeightsType>::Optimize(
+    const std::vector<std::tuple<Args...>>& candidates,
+    const size_t minResource,
+    const double eta)
+{
+  if (candidates.size() == 0)
+  {
+    throw std::invalid_argument("SuccessiveHalving::Optimize(): no candidate "
+        "configurations were given");
+  }
+  if (minResource == 0)
+  {
+    throw std::invalid_argument("SuccessiveHalving::Optimize(): minResource "
+        "should be positive");
+  }
+  if (eta <= 1.0)
+  {
+    throw std::invalid_argument("SuccessiveHalving::Optimize(): eta should "
+        "be greater than 1");
+  }
+
+  const size_t numPoints = xs.n_cols;
+  const double worstScore =
+      Metric::NeedsMinimization ? arma::datum::inf : -arma::datum::inf;
+
+  std::vector<size_t> survivors(candidates.size());
+  std::iota(survivors.begin(), survivors.end(), 0);
+
+  // Run rungs with growing budgets until either a single candidate or the
+  // full dataset is left.
+  size_t resource = std::min(minResource, numPoints);
+  while (survivors.size() > 1 && resource < numPoints)
+  {
+    arma::vec scores(survivors.size());
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) survivors.size(); ++i)
+      scores(i) = EvaluateCandidate(candidates[survivors[i]], resource);
+
+    // Invalid scores are dropped first.
+    scores.elem(arma::find_nonfinite(scores)).fill(worstScore);
+
+    // Keep the best 1 / eta fraction of the candidates.
+    const arma::uvec order = arma::stable_sort_index(scores,
+        Metric::NeedsMinimization ? "ascend" : "descend");
+    const size_t keep = std::max((size_t) 1,
+        (size_t) std::ceil(survivors.size() / eta));
+    std::vector<size_t> nextSurvivors(keep);
+    for (size_t i = 0; i < keep; ++i)
+      nextSurvivors[i] = survivors[order(i)];
+    survivors = std::move(nextSurvivors);
+
+    resource = std::min(numPoints, (size_t) (resource * eta));
+  }
+
+  // Evaluate the remaining candidates on the full dataset and keep the best
+  // model.
+  bestObjective = worstScore;
+  bestIndex = survivors[0];
+  for (size_t i = 0; i < survivors.size(); ++i)
+  {
+    CVType cv = MakeCV(xs, ys);
+    const double score = EvaluateConfig(cv, candidates[survivors[i]]);
+    const bool better = Metric::NeedsMinimization ?
+        score < bestObjective : score > bestObjective;
+    if (better)
+    {
+      bestObjective = score;
+      bestIndex = survivors[i];
+      bestModel = std::move(cv.Model());
+    }
+  }
+
+  return candidates[bestIndex];
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         template<typename, typename, typename, typename, typename> class CV,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename TupleType>
+double SuccessiveHalving<MLAlgorithm,
+                         Metric,
+                         CV,
+                         MatType,
+                         PredictionsType,
+                         WeightsType>::EvaluateCandidate(
+    const TupleType& candidate, const size_t resource)
+{
+  CVType cv = MakeCV(xs.cols(0, resource - 1), ys.cols(0, resource - 1));
+  return EvaluateConfig(cv, candidate);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         template<typename, typename, typename, typename, typename> class CV,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename TupleType, typename... Args, typename>
+double SuccessiveHalving<MLAlgorithm,
+                         Metric,
+                         CV,
+                         MatType,
+                         PredictionsType,
+                         WeightsType>::EvaluateConfig(
+    CVType& cv, const TupleType& candidate, const Args&... args)
+{
+  return EvaluateConfig(cv, candidate, args...,
+      std::get<sizeof...(Args)>(candidate));
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         template<typename, typename, typename, typename, typename> class CV,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename TupleType, typename... Args, typename, typename>
+double SuccessiveHalving<MLAlgorithm,
+                         Metric,
+                         CV,
+                         MatType,
+                         PredictionsType,
+                         WeightsType>::EvaluateConfig(
+    CVType& cv, const TupleType& /* candidate */, const Args&... args)
+{
+  return cv.Evaluate(args...);
+}
+
+} // namespace hpt
+} // namespace mlpack
+
+#endif
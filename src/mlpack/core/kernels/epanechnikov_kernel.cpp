@@ -34,6 +34,25 @@ double EpanechnikovKernel::Evaluate(const double distance) const
   return std::max(0.0, 1 - std::pow(distance, 2.0) * inverseBandwidthSquared);
 }
 
+/**
+ * Evaluate the kernel given the squared distance between two points.
+ */
+double EpanechnikovKernel::ApplyToSquaredDistance(
+    const double squaredDistance) const
+{
+  return std::max(0.0, 1 - squaredDistance * inverseBandwidthSquared);
+}
+
+/**
+ * Evaluate the kernel for a vector of numerical values.
+ */
+void EpanechnikovKernel::BatchEvaluate(const arma::vec& distances,
+                                       arma::vec& kernelValues) const
+{
+  kernelValues = arma::clamp(
+      1.0 - arma::square(distances) * inverseBandwidthSquared, 0.0, 1.0);
+}
+
 /**
  * Evaluate gradient of the kernel not for two points
  * but for a numerical value.
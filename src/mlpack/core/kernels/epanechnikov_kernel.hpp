@@ -57,6 +57,24 @@ class EpanechnikovKernel
    */
   double Evaluate(const double distance) const;
 
+  /**
+   * Evaluate the Epanechnikov kernel given that the squared distance between
+   * the two input points is known.  Batch routines use this to turn a matrix
+   * of squared distances into kernel values.
+   */
+  double ApplyToSquaredDistance(const double squaredDistance) const;
+
+  /**
+   * Evaluate the Epanechnikov kernel on a vector of distances, using
+   * vectorized operations instead of one scalar evaluation per distance.
+   *
+   * @param distances Vector of distances between pairs of points.
+   * @param kernelValues Will be filled with K(distances[i]) for each element
+   *     of distances.
+   */
+  void BatchEvaluate(const arma::vec& distances,
+                     arma::vec& kernelValues) const;
+
   /**
    * Evaluate the Gradient of Epanechnikov kernel
    * given that the distance between the two
@@ -81,6 +81,35 @@ class GaussianKernel
     return exp(gamma * std::pow(t, 2.0));
   }
 
+  /**
+   * Evaluation of the Gaussian kernel given the squared distance between two
+   * points.  Batch routines use this to turn a matrix of squared distances
+   * (computed via matrix products) into kernel values without the square
+   * root/square round trip of Evaluate().
+   *
+   * @param t The squared distance between the two points.
+   * @return K(t) using the bandwidth (@f$\mu@f$) specified in the
+   *     constructor.
+   */
+  double ApplyToSquaredDistance(const double t) const
+  {
+    return exp(gamma * t);
+  }
+
+  /**
+   * Evaluation of the Gaussian kernel on a vector of distances, using a
+   * single vectorized exponential instead of one scalar exp() call per
+   * distance.  (This is not an Evaluate() overload so that it can never be
+   * selected for a two-vector evaluation.)
+   *
+   * @param t Vector of distances between pairs of points.
+   * @param kernelValues Will be filled with K(t[i]) for each element of t.
+   */
+  void BatchEvaluate(const arma::vec& t, arma::vec& kernelValues) const
+  {
+    kernelValues = arma::exp(gamma * arma::square(t));
+  }
+
   /**
    * Evaluation of the gradient of Gaussian kernel
    * given the distance between two points.
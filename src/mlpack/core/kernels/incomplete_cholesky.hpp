@@ -0,0 +1,57 @@
+/**
+ * @file core/kernels/incomplete_cholesky.hpp
+ *
+ * Pivoted incomplete Cholesky factorization of kernel matrices.  The kernel
+ * matrix is approximated by a tall low-rank factor whose columns are
+ * generated on the fly with batched kernel evaluations, so the full n x n
+ * matrix is never materialized.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_KERNELS_INCOMPLETE_CHOLESKY_HPP
+#define MLPACK_CORE_KERNELS_INCOMPLETE_CHOLESKY_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/kernel_matrix.hpp>
+
+namespace mlpack {
+namespace kernel {
+
+/**
+ * Compute a pivoted incomplete Cholesky factorization of the kernel matrix
+ * K(i, j) = k(data.col(i), data.col(j)), producing a factor G of size
+ * n x rank (rank <= maxRank) such that K is approximated by G * G^T.  The
+ * kernel matrix itself is never materialized: each step picks the point with
+ * the largest residual diagonal as the pivot and generates only that pivot's
+ * kernel column, using PairwiseKernelMatrix() so that kernels expressible
+ * through distances or dot products are evaluated in batch.
+ *
+ * The factorization stops before the rank budget is exhausted if the largest
+ * residual diagonal falls to the given tolerance; the trace of the residual
+ * K - G * G^T is then at most n times the tolerance.
+ *
+ * @param data Dataset to compute the kernel approximation over (one point
+ *     per column).
+ * @param kernel Kernel to evaluate.
+ * @param maxRank Maximum number of columns of the factor.
+ * @param factor Matrix to store the factor into (sized n x achieved rank).
+ * @param tolerance Residual diagonal value considered negligible.
+ * @return The achieved rank of the factorization.
+ */
+template<typename KernelType, typename MatType>
+size_t IncompleteCholesky(const MatType& data,
+                          KernelType& kernel,
+                          const size_t maxRank,
+                          arma::mat& factor,
+                          const double tolerance = 1e-10);
+
+} // namespace kernel
+} // namespace mlpack
+
+// Include implementation.
+#include "incomplete_cholesky_impl.hpp"
+
+#endif // MLPACK_CORE_KERNELS_INCOMPLETE_CHOLESKY_HPP
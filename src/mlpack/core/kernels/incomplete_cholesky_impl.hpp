@@ -0,0 +1,80 @@
+/**
+ * @file core/kernels/incomplete_cholesky_impl.hpp
+ *
+ * Implementation of the pivoted incomplete Cholesky kernel factorization.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_KERNELS_INCOMPLETE_CHOLESKY_IMPL_HPP
+#define MLPACK_CORE_KERNELS_INCOMPLETE_CHOLESKY_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "incomplete_cholesky.hpp"
+
+namespace mlpack {
+namespace kernel {
+
+template<typename KernelType, typename MatType>
+size_t IncompleteCholesky(const MatType& data,
+                          KernelType& kernel,
+                          const size_t maxRank,
+                          arma::mat& factor,
+                          const double tolerance)
+{
+  const size_t n = data.n_cols;
+  const size_t budget = std::min(maxRank, n);
+  factor.zeros(n, budget);
+
+  // The diagonal of the residual kernel matrix K - G * G^T.
+  arma::vec diagonal(n);
+  for (size_t i = 0; i < n; ++i)
+    diagonal(i) = kernel.Evaluate(data.col(i), data.col(i));
+
+  size_t rank = 0;
+  for (; rank < budget; ++rank)
+  {
+    // The point with the largest residual diagonal is the next pivot.
+    arma::uword pivot;
+    const double pivotValue = diagonal.max(pivot);
+    if (pivotValue <= tolerance)
+      break;
+
+    // Generate only the pivot's kernel column, in batch where the kernel
+    // allows it.
+    const arma::mat pivotPoint(data.col(pivot));
+    arma::mat kernelColumn;
+    PairwiseKernelMatrix(data, pivotPoint, kernel, kernelColumn);
+
+    // Subtract the part of the column already explained by earlier pivots.
+    arma::vec column = kernelColumn.col(0);
+    if (rank > 0)
+    {
+      column -= factor.head_cols(rank) *
+          factor.submat(pivot, 0, pivot, rank - 1).t();
+    }
+
+    const double scale = std::sqrt(pivotValue);
+    column /= scale;
+    column(pivot) = scale; // Exact by construction.
+    factor.col(rank) = column;
+
+    // Update the residual diagonal; rounding can leave tiny negative values.
+    diagonal -= arma::square(column);
+    diagonal = arma::clamp(diagonal, 0.0, DBL_MAX);
+    diagonal(pivot) = 0.0;
+  }
+
+  // Drop the unused columns if the tolerance was reached early.
+  if (rank < budget)
+    factor.shed_cols(rank, budget - 1);
+
+  return rank;
+}
+
+} // namespace kernel
+} // namespace mlpack
+
+#endif // MLPACK_CORE_KERNELS_INCOMPLETE_CHOLESKY_IMPL_HPP
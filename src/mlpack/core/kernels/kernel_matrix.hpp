@@ -0,0 +1,105 @@
+/**
+ * @file core/kernels/kernel_matrix.hpp
+ *
+ * Blocked construction of pairwise kernel matrices.  The KernelTraits of the
+ * given kernel are used to select the fastest available strategy: kernels
+ * that are functions of the squared distance or of the dot product alone are
+ * evaluated with one matrix product per block of columns followed by an
+ * elementwise transformation, and all other kernels fall back to parallel
+ * pairwise Evaluate() calls.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_KERNELS_KERNEL_MATRIX_HPP
+#define MLPACK_CORE_KERNELS_KERNEL_MATRIX_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/kernel_traits.hpp>
+#include <mlpack/core/math/pairwise_distances.hpp>
+
+namespace mlpack {
+namespace kernel {
+
+/**
+ * Compute the full pairwise kernel matrix between the columns of a and the
+ * columns of b, so that kernelMatrix(i, j) = K(a.col(i), b.col(j)).
+ *
+ * If KernelTraits<KernelType>::UsesSquaredDistance is true, the squared
+ * distances are computed in blocks via math::PairwiseSquaredDistances() (one
+ * matrix product per block) and the kernel's ApplyToSquaredDistance() method
+ * is applied elementwise.  If instead
+ * KernelTraits<KernelType>::IsDotProductExpressible is true, the inner
+ * products are computed via math::PairwiseInnerProducts() and
+ * ApplyToDotProduct() is applied elementwise.  Otherwise, one Evaluate() call
+ * is made per pair, parallelized over the columns of b.
+ *
+ * @param a First matrix (one point per column).
+ * @param b Second matrix (one point per column).
+ * @param kernel Kernel to evaluate.
+ * @param kernelMatrix Matrix to store the kernel values into; it will be
+ *     sized a.n_cols x b.n_cols.
+ * @param blockSize Number of columns of b handled per matrix product.
+ */
+template<typename KernelType, typename MatAType, typename MatBType>
+void PairwiseKernelMatrix(const MatAType& a,
+                          const MatBType& b,
+                          KernelType& kernel,
+                          arma::mat& kernelMatrix,
+                          const size_t blockSize = 1024);
+
+/**
+ * Return the name of the cache file that the caching overload of
+ * PairwiseKernelMatrix() will use for the given inputs.  The name is the
+ * given prefix followed by a hash of the contents of both matrices and of the
+ * serialized kernel, so a change to the data, to the point selection, or to
+ * any kernel parameter produces a different file.
+ *
+ * @param a First matrix (one point per column).
+ * @param b Second matrix (one point per column).
+ * @param kernel Kernel to evaluate (must be serializable).
+ * @param cachePrefix Path prefix for the cache file.
+ */
+template<typename KernelType>
+std::string KernelMatrixCacheFile(const arma::mat& a,
+                                  const arma::mat& b,
+                                  KernelType& kernel,
+                                  const std::string& cachePrefix);
+
+/**
+ * Compute the pairwise kernel matrix between the columns of a and the columns
+ * of b, caching the result on disk.  If a cache file for these exact inputs
+ * already exists (see KernelMatrixCacheFile()), the matrix is loaded from it
+ * instead of being recomputed; otherwise it is computed with
+ * PairwiseKernelMatrix() and saved.  This is useful when the same kernel
+ * block is recomputed across many runs, such as hyperparameter sweeps where
+ * only parameters outside of the kernel change.
+ *
+ * Cache files for inputs that are no longer of interest are never removed;
+ * cleaning the cache directory is up to the caller.
+ *
+ * @param a First matrix (one point per column).
+ * @param b Second matrix (one point per column).
+ * @param kernel Kernel to evaluate (must be serializable).
+ * @param kernelMatrix Matrix to store the kernel values into; it will be
+ *     sized a.n_cols x b.n_cols.
+ * @param cachePrefix Path prefix for the cache file.
+ * @param blockSize Number of columns of b handled per matrix product.
+ */
+template<typename KernelType>
+void PairwiseKernelMatrix(const arma::mat& a,
+                          const arma::mat& b,
+                          KernelType& kernel,
+                          arma::mat& kernelMatrix,
+                          const std::string& cachePrefix,
+                          const size_t blockSize = 1024);
+
+} // namespace kernel
+} // namespace mlpack
+
+// Include implementation.
+#include "kernel_matrix_impl.hpp"
+
+#endif // MLPACK_CORE_KERNELS_KERNEL_MATRIX_HPP
@@ -0,0 +1,170 @@
+/**
+ * @file core/kernels/kernel_matrix_impl.hpp
+ *
+ * Implementation of blocked pairwise kernel matrix construction.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_KERNELS_KERNEL_MATRIX_IMPL_HPP
+#define MLPACK_CORE_KERNELS_KERNEL_MATRIX_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "kernel_matrix.hpp"
+
+#include <sstream>
+
+namespace mlpack {
+namespace kernel {
+
+/**
+ * Strategy for kernels that are functions of the squared distance: compute
+ * all squared distances with blocked matrix products, then apply the kernel's
+ * ApplyToSquaredDistance() method in place.
+ */
+template<typename KernelType, typename MatAType, typename MatBType>
+typename std::enable_if<
+    KernelTraits<KernelType>::UsesSquaredDistance, void>::type
+PairwiseKernelMatrixImpl(const MatAType& a,
+                         const MatBType& b,
+                         KernelType& kernel,
+                         arma::mat& kernelMatrix,
+                         const size_t blockSize)
+{
+  math::PairwiseSquaredDistances(a, b, kernelMatrix, blockSize);
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t j = 0; j < (omp_size_t) kernelMatrix.n_cols; ++j)
+    for (size_t i = 0; i < kernelMatrix.n_rows; ++i)
+      kernelMatrix(i, j) = kernel.ApplyToSquaredDistance(kernelMatrix(i, j));
+}
+
+/**
+ * Strategy for kernels that are functions of the dot product: compute all
+ * inner products with blocked matrix products, then apply the kernel's
+ * ApplyToDotProduct() method in place.
+ */
+template<typename KernelType, typename MatAType, typename MatBType>
+typename std::enable_if<
+    !KernelTraits<KernelType>::UsesSquaredDistance &&
+    KernelTraits<KernelType>::IsDotProductExpressible, void>::type
+PairwiseKernelMatrixImpl(const MatAType& a,
+                         const MatBType& b,
+                         KernelType& kernel,
+                         arma::mat& kernelMatrix,
+                         const size_t blockSize)
+{
+  math::PairwiseInnerProducts(a, b, kernelMatrix, blockSize);
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t j = 0; j < (omp_size_t) kernelMatrix.n_cols; ++j)
+    for (size_t i = 0; i < kernelMatrix.n_rows; ++i)
+      kernelMatrix(i, j) = kernel.ApplyToDotProduct(kernelMatrix(i, j));
+}
+
+/**
+ * Fallback strategy for kernels without a batch-friendly form: one Evaluate()
+ * call per pair, parallelized over the columns of b.
+ */
+template<typename KernelType, typename MatAType, typename MatBType>
+typename std::enable_if<
+    !KernelTraits<KernelType>::UsesSquaredDistance &&
+    !KernelTraits<KernelType>::IsDotProductExpressible, void>::type
+PairwiseKernelMatrixImpl(const MatAType& a,
+                         const MatBType& b,
+                         KernelType& kernel,
+                         arma::mat& kernelMatrix,
+                         const size_t /* blockSize */)
+{
+  kernelMatrix.set_size(a.n_cols, b.n_cols);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t j = 0; j < (omp_size_t) b.n_cols; ++j)
+    for (size_t i = 0; i < a.n_cols; ++i)
+      kernelMatrix(i, j) = kernel.Evaluate(a.col(i), b.col(j));
+}
+
+template<typename KernelType, typename MatAType, typename MatBType>
+void PairwiseKernelMatrix(const MatAType& a,
+                          const MatBType& b,
+                          KernelType& kernel,
+                          arma::mat& kernelMatrix,
+                          const size_t blockSize)
+{
+  PairwiseKernelMatrixImpl(a, b, kernel, kernelMatrix, blockSize);
+}
+
+//! Mix the given bytes into a running FNV-1a hash.
+inline void HashBytes(const void* data, const size_t length, uint64_t& hash)
+{
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < length; ++i)
+  {
+    hash ^= (uint64_t) bytes[i];
+    hash *= 1099511628211ULL;
+  }
+}
+
+template<typename KernelType>
+std::string KernelMatrixCacheFile(const arma::mat& a,
+                                  const arma::mat& b,
+                                  KernelType& kernel,
+                                  const std::string& cachePrefix)
+{
+  // Serialize the kernel, so that its parameters take part in the key and a
+  // sweep over (for example) bandwidths cannot hit a stale cache entry.
+  std::ostringstream state;
+  {
+    cereal::JSONOutputArchive ar(state);
+    ar(CEREAL_NVP(kernel));
+  }
+  const std::string kernelState = state.str();
+
+  // FNV-1a offset basis.
+  uint64_t hash = 14695981039346656037ULL;
+  const uint64_t dims[4] = { a.n_rows, a.n_cols, b.n_rows, b.n_cols };
+  HashBytes(dims, sizeof(dims), hash);
+  HashBytes(a.memptr(), a.n_elem * sizeof(double), hash);
+  HashBytes(b.memptr(), b.n_elem * sizeof(double), hash);
+  HashBytes(kernelState.c_str(), kernelState.size(), hash);
+
+  std::ostringstream name;
+  name << cachePrefix << "." << std::hex << hash << ".bin";
+  return name.str();
+}
+
+template<typename KernelType>
+void PairwiseKernelMatrix(const arma::mat& a,
+                          const arma::mat& b,
+                          KernelType& kernel,
+                          arma::mat& kernelMatrix,
+                          const std::string& cachePrefix,
+                          const size_t blockSize)
+{
+  const std::string cacheFile = KernelMatrixCacheFile(a, b, kernel,
+      cachePrefix);
+
+  if (kernelMatrix.quiet_load(cacheFile, arma::arma_binary) &&
+      kernelMatrix.n_rows == a.n_cols && kernelMatrix.n_cols == b.n_cols)
+  {
+    Log::Info << "PairwiseKernelMatrix(): loaded cached kernel matrix from '"
+        << cacheFile << "'." << std::endl;
+    return;
+  }
+
+  PairwiseKernelMatrix(a, b, kernel, kernelMatrix, blockSize);
+
+  if (!kernelMatrix.save(cacheFile, arma::arma_binary))
+  {
+    Log::Warn << "PairwiseKernelMatrix(): could not save kernel matrix to '"
+        << cacheFile << "'; it will be recomputed on the next run."
+        << std::endl;
+  }
+}
+
+} // namespace kernel
+} // namespace mlpack
+
+#endif // MLPACK_CORE_KERNELS_KERNEL_MATRIX_IMPL_HPP
@@ -34,8 +34,20 @@ class KernelTraits
 
   /**
    * If true, then the kernel include a squared distance, ||x - y||^2 .
+   * Kernels that set this should also expose the value as a function of the
+   * squared distance via ApplyToSquaredDistance(), so that batch routines can
+   * evaluate many kernel values from a precomputed distance matrix.
    */
   static const bool UsesSquaredDistance = false;
+
+  /**
+   * If true, then the kernel is a function of the inner product of its
+   * arguments alone: K(x, y) = f(x^T y), where f is exposed by the kernel as
+   * ApplyToDotProduct().  Batch routines can then evaluate many kernel
+   * values with a single matrix product followed by an elementwise
+   * transformation, instead of one pairwise Evaluate() call per value.
+   */
+  static const bool IsDotProductExpressible = false;
 };
 
 } // namespace kernel
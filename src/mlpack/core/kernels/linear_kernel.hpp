@@ -15,6 +15,7 @@
 #define MLPACK_CORE_KERNELS_LINEAR_KERNEL_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/kernel_traits.hpp>
 
 namespace mlpack {
 namespace kernel {
@@ -55,11 +56,37 @@ class LinearKernel
     return arma::dot(a, b);
   }
 
+  /**
+   * Obtain the kernel value from an already-computed dot product of the
+   * arguments (see KernelTraits::IsDotProductExpressible); for the linear
+   * kernel the dot product is the kernel value.
+   *
+   * @param dotProduct Dot product of the two kernel arguments.
+   * @return K(a, b) given that dot(a, b) = dotProduct.
+   */
+  static double ApplyToDotProduct(const double dotProduct)
+  {
+    return dotProduct;
+  }
+
   //! Serialize the kernel (it has no members... do nothing).
   template<typename Archive>
   void serialize(Archive& /* ar */, const uint32_t /* version */) { }
 };
 
+//! Kernel traits for the linear kernel.
+template<>
+class KernelTraits<LinearKernel>
+{
+ public:
+  //! The linear kernel is not normalized: K(x, x) can take any value.
+  static const bool IsNormalized = false;
+  //! The linear kernel does not include a squared distance.
+  static const bool UsesSquaredDistance = false;
+  //! The linear kernel is the dot product itself.
+  static const bool IsDotProductExpressible = true;
+};
+
 } // namespace kernel
 } // namespace mlpack
 
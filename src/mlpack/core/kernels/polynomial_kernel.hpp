@@ -13,6 +13,7 @@
 #define MLPACK_CORE_KERNELS_POLYNOMIAL_KERNEL_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/kernel_traits.hpp>
 
 namespace mlpack {
 namespace kernel {
@@ -57,6 +58,18 @@ class PolynomialKernel
     return pow((arma::dot(a, b) + offset), degree);
   }
 
+  /**
+   * Obtain the kernel value from an already-computed dot product of the
+   * arguments (see KernelTraits::IsDotProductExpressible).
+   *
+   * @param dotProduct Dot product of the two kernel arguments.
+   * @return K(a, b) given that dot(a, b) = dotProduct.
+   */
+  double ApplyToDotProduct(const double dotProduct) const
+  {
+    return pow(dotProduct + offset, degree);
+  }
+
   //! Get the degree of the polynomial.
   const double& Degree() const { return degree; }
   //! Modify the degree of the polynomial.
@@ -82,6 +95,19 @@ class PolynomialKernel
   double offset;
 };
 
+//! Kernel traits for the polynomial kernel.
+template<>
+class KernelTraits<PolynomialKernel>
+{
+ public:
+  //! The polynomial kernel is not normalized: K(x, x) can take any value.
+  static const bool IsNormalized = false;
+  //! The polynomial kernel does not include a squared distance.
+  static const bool UsesSquaredDistance = false;
+  //! The polynomial kernel is a function of the dot product alone.
+  static const bool IsDotProductExpressible = true;
+};
+
 } // namespace kernel
 } // namespace mlpack
 
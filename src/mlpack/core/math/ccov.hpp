@@ -30,6 +30,85 @@ arma::Mat< std::complex<T> >
 ColumnCovariance(const arma::Mat< std::complex<T> >& A,
      const size_t norm_type = 0);
 
+/**
+ * Accumulate the raw second moment (x * x.t()) and the column sum of x into
+ * the given accumulators, parallelizing over blocks of columns.  This is the
+ * shared kernel of ColumnCovariance() and ColumnCovarianceAccumulator; the
+ * accumulators must already have the right size.
+ */
+template<typename eT>
+inline void AccumulateColumnMoments(const arma::Mat<eT>& x,
+                                    arma::Mat<eT>& rawMoment,
+                                    arma::Col<eT>& total);
+
+/**
+ * A streaming accumulator for the covariance computed by ColumnCovariance():
+ * data can be passed in batches with Accumulate(), and only the raw second
+ * moment and the column sum are kept, so the covariance of a dataset far
+ * larger than RAM can be computed one batch at a time without ever
+ * materializing a centered copy.  The contribution of the mean is removed
+ * when Covariance() is called, which yields the same result ColumnCovariance()
+ * computes over the concatenation of all batches.
+ */
+template<typename eT>
+class ColumnCovarianceAccumulator
+{
+ public:
+  /**
+   * Create the accumulator, optionally with the dimensionality of the data
+   * to accumulate.  If the dimensionality is 0, it is taken from the first
+   * batch passed to Accumulate().
+   *
+   * @param dimensionality Dimensionality of the data to accumulate.
+   */
+  ColumnCovarianceAccumulator(const size_t dimensionality = 0);
+
+  /**
+   * Reset the accumulator for data of the given dimensionality, discarding
+   * anything accumulated so far.
+   *
+   * @param dimensionality Dimensionality of the data to accumulate.
+   */
+  void Reset(const size_t dimensionality);
+
+  /**
+   * Accumulate a batch of data points (one per column).  Every batch must
+   * have the same dimensionality.
+   *
+   * @param batch Batch of data points to accumulate.
+   */
+  void Accumulate(const arma::Mat<eT>& batch);
+
+  /**
+   * Compute the mean of all accumulated points.  At least one point must
+   * have been accumulated.
+   */
+  arma::Col<eT> Mean() const;
+
+  /**
+   * Compute the covariance of all accumulated points, removing the
+   * contribution of the mean.  At least one point must have been
+   * accumulated.
+   *
+   * @param normType Normalization type: 0 divides by (n - 1), 1 divides
+   *     by n.
+   */
+  arma::Mat<eT> Covariance(const size_t normType = 0) const;
+
+  //! Get the dimensionality of the accumulated data (0 if not yet set).
+  size_t Dimensionality() const { return rawMoment.n_rows; }
+  //! Get the number of points accumulated so far.
+  size_t Count() const { return count; }
+
+ private:
+  //! The raw (uncentered) second moment of the accumulated points.
+  arma::Mat<eT> rawMoment;
+  //! The sum of the accumulated points.
+  arma::Col<eT> total;
+  //! The number of points accumulated so far.
+  size_t count;
+};
+
 } // namespace math
 } // namespace mlpack
 
@@ -40,9 +40,15 @@ inline arma::Mat<eT> ColumnCovariance(const arma::Mat<eT>& x,
     const size_t n = xAlias.n_cols;
     const eT normVal = (normType == 0) ? ((n > 1) ? eT(n - 1) : eT(1)) : eT(n);
 
-    const arma::Mat<eT> tmp = xAlias.each_col() - arma::mean(xAlias, 1);
-
-    out = tmp * tmp.t();
+    // Accumulate the raw second moment and the column sum in one pass and
+    // remove the contribution of the mean at the end, instead of
+    // materializing a centered copy of the matrix before the product; the
+    // centered copy doubles the memory footprint on large inputs.
+    arma::Mat<eT> rawMoment(xAlias.n_rows, xAlias.n_rows, arma::fill::zeros);
+    arma::Col<eT> total(xAlias.n_rows, arma::fill::zeros);
+    AccumulateColumnMoments(xAlias, rawMoment, total);
+
+    out = rawMoment - (total * total.t()) / eT(n);
     out /= normVal;
   }
 
@@ -94,6 +100,111 @@ inline arma::Mat<std::complex<T>> ColumnCovariance(
   return out;
 }
 
+template<typename eT>
+inline void AccumulateColumnMoments(const arma::Mat<eT>& x,
+                                    arma::Mat<eT>& rawMoment,
+                                    arma::Col<eT>& total)
+{
+  // Each thread accumulates the moments of whole blocks of columns, so the
+  // per-block work is a small matrix product and the merge under the critical
+  // section happens once per thread.
+  const size_t blockSize = 256;
+  const size_t blocks = (x.n_cols + blockSize - 1) / blockSize;
+
+  #pragma omp parallel
+  {
+    arma::Mat<eT> threadMoment(x.n_rows, x.n_rows, arma::fill::zeros);
+    arma::Col<eT> threadTotal(x.n_rows, arma::fill::zeros);
+
+    #pragma omp for schedule(static) nowait
+    for (omp_size_t b = 0; b < (omp_size_t) blocks; ++b)
+    {
+      const size_t begin = b * blockSize;
+      const size_t end = std::min(begin + blockSize,
+          (size_t) x.n_cols) - 1;
+
+      threadMoment += x.cols(begin, end) * x.cols(begin, end).t();
+      threadTotal += arma::sum(x.cols(begin, end), 1);
+    }
+
+    #pragma omp critical (ColumnCovarianceMoments)
+    {
+      rawMoment += threadMoment;
+      total += threadTotal;
+    }
+  }
+}
+
+template<typename eT>
+ColumnCovarianceAccumulator<eT>::ColumnCovarianceAccumulator(
+    const size_t dimensionality)
+{
+  Reset(dimensionality);
+}
+
+template<typename eT>
+inline void ColumnCovarianceAccumulator<eT>::Reset(const size_t dimensionality)
+{
+  rawMoment.zeros(dimensionality, dimensionality);
+  total.zeros(dimensionality);
+  count = 0;
+}
+
+template<typename eT>
+inline void ColumnCovarianceAccumulator<eT>::Accumulate(
+    const arma::Mat<eT>& batch)
+{
+  if (Dimensionality() == 0)
+    Reset(batch.n_rows);
+
+  if (batch.n_rows != Dimensionality())
+  {
+    Log::Fatal << "ColumnCovarianceAccumulator::Accumulate(): batch has "
+        << "dimensionality " << batch.n_rows << ", but the accumulator was "
+        << "given dimensionality " << Dimensionality() << "!" << std::endl;
+  }
+
+  AccumulateColumnMoments(batch, rawMoment, total);
+  count += batch.n_cols;
+}
+
+template<typename eT>
+inline arma::Col<eT> ColumnCovarianceAccumulator<eT>::Mean() const
+{
+  if (count == 0)
+  {
+    Log::Fatal << "ColumnCovarianceAccumulator::Mean(): no points have been "
+        << "accumulated!" << std::endl;
+  }
+
+  return total / eT(count);
+}
+
+template<typename eT>
+inline arma::Mat<eT> ColumnCovarianceAccumulator<eT>::Covariance(
+    const size_t normType) const
+{
+  if (normType > 1)
+  {
+    Log::Fatal << "ColumnCovarianceAccumulator::Covariance(): norm_type must "
+        << "be 0 or 1!" << std::endl;
+  }
+
+  if (count == 0)
+  {
+    Log::Fatal << "ColumnCovarianceAccumulator::Covariance(): no points have "
+        << "been accumulated!" << std::endl;
+  }
+
+  const eT normVal = (normType == 0) ?
+      ((count > 1) ? eT(count - 1) : eT(1)) : eT(count);
+
+  arma::Mat<eT> out = rawMoment - (total * total.t()) / eT(count);
+  out /= normVal;
+
+  return out;
+}
+
 } // namespace math
 } // namespace mlpack
 
@@ -0,0 +1,181 @@
+/**
+ * @file core/math/compensated_accumulator.hpp
+ *
+ * Compensated (Neumaier) summation accumulators.  A long reduction of many
+ * small terms into a single running sum loses the low-order bits of every
+ * term once the sum has grown large; these accumulators carry the rounding
+ * error in a separate correction term, so the result is accurate to within a
+ * couple of units in the last place regardless of the number of terms.  This
+ * is what makes reductions over float32 data numerically safe.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_COMPENSATED_ACCUMULATOR_HPP
+#define MLPACK_CORE_MATH_COMPENSATED_ACCUMULATOR_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace math {
+
+/**
+ * A scalar accumulator that sums with Neumaier's variant of Kahan
+ * compensation.  Each Add() costs a few extra additions over a plain sum,
+ * and in exchange the accumulated rounding error stays bounded by a small
+ * constant instead of growing with the number of terms.
+ */
+template<typename ElemType = double>
+class CompensatedAccumulator
+{
+ public:
+  //! Construct the accumulator, optionally with an initial value.
+  CompensatedAccumulator(const ElemType initial = 0) :
+      sum(initial),
+      comp(0)
+  { /* Nothing to do. */ }
+
+  //! Add a value to the running sum.
+  void Add(const ElemType value)
+  {
+    const ElemType t = sum + value;
+
+    // Once the sum is infinite the correction term would be inf - inf (NaN);
+    // drop it so that infinities propagate exactly as in a plain sum.
+    if (std::isfinite(t))
+    {
+      if (std::abs(sum) >= std::abs(value))
+        comp += (sum - t) + value;
+      else
+        comp += (value - t) + sum;
+    }
+
+    sum = t;
+  }
+
+  //! Get the compensated value of the running sum.
+  ElemType Value() const { return sum + comp; }
+
+  //! Reset the accumulator, optionally to an initial value.
+  void Reset(const ElemType initial = 0)
+  {
+    sum = initial;
+    comp = 0;
+  }
+
+ private:
+  //! Running sum.
+  ElemType sum;
+
+  //! Accumulated rounding error of the running sum.
+  ElemType comp;
+};
+
+/**
+ * An element-wise Neumaier accumulator over an existing Armadillo vector or
+ * matrix.  The accumulator holds a reference to the target and a parallel
+ * correction term for every element; Add() updates the target in place, and
+ * Flush() folds the corrections into the target once the reduction (or a
+ * stage of it) is over.  Flush() may be called any number of times: it
+ * leaves the target holding the compensated sum and resets the corrections,
+ * so further Add() calls continue correctly.
+ *
+ * @tparam MatType Type of the target (arma::vec, arma::mat, or the float32
+ *     equivalents).
+ */
+template<typename MatType = arma::vec>
+class CompensatedSum
+{
+ public:
+  //! Type of the elements of the target.
+  typedef typename MatType::elem_type ElemType;
+
+  //! Construct the accumulator for the given target, which must already have
+  //! its final size.
+  CompensatedSum(MatType& target) : target(target)
+  {
+    compensations.zeros(arma::size(target));
+  }
+
+  //! Add a value to the element of the target with the given linear index.
+  void Add(const size_t index, const ElemType value)
+  {
+    ElemType& sum = target(index);
+    const ElemType t = sum + value;
+
+    // Once the sum is infinite the correction term would be inf - inf (NaN);
+    // drop it so that infinities propagate exactly as in a plain sum.
+    if (std::isfinite(t))
+    {
+      if (std::abs(sum) >= std::abs(value))
+        compensations(index) += (sum - t) + value;
+      else
+        compensations(index) += (value - t) + sum;
+    }
+
+    sum = t;
+  }
+
+  //! Add an object of the same shape as the target element-wise.
+  template<typename ExprType>
+  void Add(const ExprType& values)
+  {
+    const MatType vals(values);
+    for (size_t i = 0; i < vals.n_elem; ++i)
+      Add(i, vals(i));
+  }
+
+  //! Fold the accumulated corrections into the target and reset them.
+  void Flush()
+  {
+    target += compensations;
+    compensations.zeros();
+  }
+
+ private:
+  //! The target of the summation.
+  MatType& target;
+
+  //! Accumulated rounding error of every element of the target.
+  MatType compensations;
+};
+
+/**
+ * A drop-in replacement for CompensatedSum that sums directly into the
+ * target with no compensation.  Use this policy to recover plain summation
+ * where the compensation overhead is not worth it.
+ */
+template<typename MatType = arma::vec>
+class DirectSum
+{
+ public:
+  //! Type of the elements of the target.
+  typedef typename MatType::elem_type ElemType;
+
+  //! Construct the accumulator for the given target.
+  DirectSum(MatType& target) : target(target) { /* Nothing to do. */ }
+
+  //! Add a value to the element of the target with the given linear index.
+  void Add(const size_t index, const ElemType value)
+  {
+    target(index) += value;
+  }
+
+  //! Add an object of the same shape as the target element-wise.
+  template<typename ExprType>
+  void Add(const ExprType& values) { target += values; }
+
+  //! No-op; there are no corrections to fold in.
+  void Flush() { /* Nothing to do. */ }
+
+ private:
+  //! The target of the summation.
+  MatType& target;
+};
+
+} // namespace math
+} // namespace mlpack
+
+#endif
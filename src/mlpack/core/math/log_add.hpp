@@ -36,6 +36,18 @@ T LogAdd(T x, T y);
 template<typename T>
 typename T::elem_type AccuLog(const T& x);
 
+/**
+ * Compute the sum of exponentials of each column of a matrix of log values,
+ * returning the result in log space.  This is the vectorized equivalent of
+ * calling AccuLog() on every column: y[i] = log(sum(exp(x.col(i)))).
+ * (T should be an Armadillo matrix type.)
+ *
+ * @param x matrix of log values
+ * @param y vector to store the per-column results in
+ */
+template<typename T>
+void LogSumExpCols(const T& x, arma::Col<typename T::elem_type>& y);
+
 } // namespace math
 } // namespace mlpack
 
@@ -71,6 +71,34 @@ typename T::elem_type AccuLog(const T& x)
   return sum;
 }
 
+/**
+ * Compute the sum of exponentials of each column of a matrix of log values,
+ * returning the result in log space.
+ *
+ * @param x matrix of log values
+ * @param y vector to store the per-column results in
+ */
+template<typename T>
+void LogSumExpCols(const T& x, arma::Col<typename T::elem_type>& y)
+{
+  typedef typename T::elem_type ElemType;
+
+  // Shift each column by its maximum, so that the largest exponential in each
+  // column is e^0; this cannot overflow, and underflow is harmless.
+  const arma::Row<ElemType> maxs = arma::max(x, 0);
+  arma::Mat<ElemType> shifted(x);
+  shifted.each_row() -= maxs;
+
+  y = (maxs + arma::log(arma::sum(arma::exp(shifted), 0))).t();
+
+  // A column whose maximum is -inf holds only -inf values, for which the
+  // shifted expression above gives NaN; the correct log-sum is the maximum
+  // itself.
+  for (size_t i = 0; i < y.n_elem; ++i)
+    if (!std::isfinite(maxs[i]))
+      y[i] = maxs[i];
+}
+
 } // namespace math
 } // namespace mlpack
 
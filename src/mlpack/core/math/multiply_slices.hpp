@@ -22,7 +22,8 @@ namespace math /** Miscellaneous math routines. */ {
  * Matrix multiplication of slices of two cubes. This function expects
  * both cubes to have the same number of slices. For example, a valid operation
  * would be: cube A of shape (m, p, s) multiplied by cube B of shape (p, n, s)
- * resulting in a cube of shape (m, n, s).
+ * resulting in a cube of shape (m, n, s).  The slices are multiplied in
+ * parallel if OpenMP is enabled.
  *
  * @param cubeA First cube.
  * @param cubeB Second cube.
@@ -39,7 +40,8 @@ CubeType MultiplyCube2Cube(const CubeType& cubeA,
  * is used when the first object is a matrix and the second object is a cube.
  * For example, a valid operation would be: matrix A of shape (m, p)
  * multiplied by cube B of shape (p, n, s) resulting in a cube
- * of shape (m, n, s).
+ * of shape (m, n, s).  The slices are multiplied in parallel if OpenMP is
+ * enabled.
  *
  * @param matA The matrix as the first operand.
  * @param cubeB The cube as the second operand.
@@ -56,7 +58,8 @@ CubeType MultiplyMat2Cube(const MatType& matA,
  * is used when the first object is a cube and the second object is a matrix.
  * For example, a valid operation would be: cube A of shape (m, p, s)
  * multiplied by a matrix of shape (p, n) resulting in a cube
- * of shape (m, n, s).
+ * of shape (m, n, s).  The slices are multiplied in parallel if OpenMP is
+ * enabled.
  *
  * @param cubeA The cube as the first operand.
  * @param matB The matrix as the second operand.
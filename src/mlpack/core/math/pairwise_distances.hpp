@@ -0,0 +1,75 @@
+/**
+ * @file core/math/pairwise_distances.hpp
+ * @author Ryan Curtin
+ *
+ * Blocked all-pairs distance and inner product kernels.  These compute the
+ * full m x n result matrix between the columns of two matrices via matrix
+ * products, tiling over the columns of the second matrix so that each tile
+ * stays cache-sized and the tiles can be computed in parallel.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_PAIRWISE_DISTANCES_HPP
+#define MLPACK_CORE_MATH_PAIRWISE_DISTANCES_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace math {
+
+/**
+ * Compute all pairwise inner products between the columns of a and the
+ * columns of b, so that products(i, j) = dot(a.col(i), b.col(j)).  The
+ * computation is performed one block of b's columns at a time (one matrix
+ * product per block), and blocks are processed in parallel if OpenMP is
+ * enabled.
+ *
+ * @param a First matrix (one point per column).
+ * @param b Second matrix (one point per column).
+ * @param products Matrix to store the inner products into; it will be sized
+ *     a.n_cols x b.n_cols.
+ * @param blockSize Number of columns of b handled per matrix product.
+ */
+template<typename MatAType, typename MatBType>
+void PairwiseInnerProducts(
+    const MatAType& a,
+    const MatBType& b,
+    arma::Mat<typename MatAType::elem_type>& products,
+    const size_t blockSize = 1024);
+
+/**
+ * Compute all pairwise squared L2 distances between the columns of a and the
+ * columns of b, so that distances(i, j) is the squared Euclidean distance
+ * between a.col(i) and b.col(j).  The distances are computed through the
+ * expansion ||x - y||^2 = ||x||^2 + ||y||^2 - 2 x'y, so the bulk of the work
+ * is one matrix product per block of b's columns; blocks are processed in
+ * parallel if OpenMP is enabled.  Small negative values produced by the
+ * expansion are clamped to zero.
+ *
+ * Note that the expansion can lose a few digits of precision relative to
+ * computing each distance directly, so results may differ from
+ * metric::EuclideanDistance in the last units of precision.
+ *
+ * @param a First matrix (one point per column).
+ * @param b Second matrix (one point per column).
+ * @param distances Matrix to store the squared distances into; it will be
+ *     sized a.n_cols x b.n_cols.
+ * @param blockSize Number of columns of b handled per matrix product.
+ */
+template<typename MatAType, typename MatBType>
+void PairwiseSquaredDistances(
+    const MatAType& a,
+    const MatBType& b,
+    arma::Mat<typename MatAType::elem_type>& distances,
+    const size_t blockSize = 1024);
+
+} // namespace math
+} // namespace mlpack
+
+// Include implementation.
+#include "pairwise_distances_impl.hpp"
+
+#endif // MLPACK_CORE_MATH_PAIRWISE_DISTANCES_HPP
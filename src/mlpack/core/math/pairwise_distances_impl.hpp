@@ -0,0 +1,83 @@
+/**
+ * @file core/math/pairwise_distances_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the blocked all-pairs distance and inner product kernels.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_PAIRWISE_DISTANCES_IMPL_HPP
+#define MLPACK_CORE_MATH_PAIRWISE_DISTANCES_IMPL_HPP
+
+#include "pairwise_distances.hpp"
+
+namespace mlpack {
+namespace math {
+
+template<typename MatAType, typename MatBType>
+void PairwiseInnerProducts(
+    const MatAType& a,
+    const MatBType& b,
+    arma::Mat<typename MatAType::elem_type>& products,
+    const size_t blockSize)
+{
+  products.set_size(a.n_cols, b.n_cols);
+
+  const size_t numBlocks = (b.n_cols + blockSize - 1) / blockSize;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+  {
+    const size_t begin = block * blockSize;
+    const size_t end = std::min(begin + blockSize, (size_t) b.n_cols);
+
+    products.cols(begin, end - 1) = a.t() * b.cols(begin, end - 1);
+  }
+}
+
+template<typename MatAType, typename MatBType>
+void PairwiseSquaredDistances(
+    const MatAType& a,
+    const MatBType& b,
+    arma::Mat<typename MatAType::elem_type>& distances,
+    const size_t blockSize)
+{
+  typedef typename MatAType::elem_type ElemType;
+
+  distances.set_size(a.n_cols, b.n_cols);
+
+  // The squared norms of every column are computed once up front.
+  const arma::Col<ElemType> aNorms =
+      arma::conv_to<arma::Col<ElemType>>::from(
+      arma::sum(arma::square(a), 0).t());
+  const arma::Row<ElemType> bNorms =
+      arma::conv_to<arma::Row<ElemType>>::from(arma::sum(arma::square(b), 0));
+
+  const size_t numBlocks = (b.n_cols + blockSize - 1) / blockSize;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+  {
+    const size_t begin = block * blockSize;
+    const size_t end = std::min(begin + blockSize, (size_t) b.n_cols);
+
+    // ||x||^2 + ||y||^2 - 2 x'y for every pair in the block.
+    arma::Mat<ElemType> tile = ElemType(-2) * (a.t() * b.cols(begin, end - 1));
+    tile.each_col() += aNorms;
+    tile.each_row() += bNorms.cols(begin, end - 1);
+
+    // The expansion can produce slightly negative values for (near-)identical
+    // points; clamp those to zero.
+    tile.elem(arma::find(tile < ElemType(0))).zeros();
+
+    distances.cols(begin, end - 1) = tile;
+  }
+}
+
+} // namespace math
+} // namespace mlpack
+
+#endif // MLPACK_CORE_MATH_PAIRWISE_DISTANCES_IMPL_HPP
@@ -0,0 +1,86 @@
+/**
+ * @file core/math/quantile_sketch.hpp
+ *
+ * Definition of the P^2 (piecewise-parabolic) quantile sketch, a streaming
+ * estimator of a single quantile that uses constant memory.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_QUANTILE_SKETCH_HPP
+#define MLPACK_CORE_MATH_QUANTILE_SKETCH_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace math {
+
+/**
+ * A streaming estimator of a single quantile, using the P^2 algorithm of
+ * Jain and Chlamtac (1985).  The sketch maintains five markers whose heights
+ * are adjusted with a piecewise-parabolic formula as observations arrive, so
+ * a quantile of an arbitrarily long stream can be estimated in one pass with
+ * constant memory and without storing or sorting the data.  The first five
+ * observations are reproduced exactly.
+ *
+ * This is useful wherever an approximate order statistic of a large column
+ * is good enough: approximate median imputation, descriptive statistics
+ * passes, and similar preprocessing jobs that would otherwise copy and sort
+ * entire columns.
+ */
+class QuantileSketch
+{
+ public:
+  /**
+   * Construct the sketch for the given quantile.
+   *
+   * @param quantile The quantile to estimate, in (0, 1); 0.5 (the default)
+   *     estimates the median.
+   */
+  QuantileSketch(const double quantile = 0.5);
+
+  /**
+   * Insert an observation into the sketch.
+   *
+   * @param value The observed value.
+   */
+  void Insert(const double value);
+
+  /**
+   * Estimate the quantile of the observations inserted so far.  With fewer
+   * than five observations the estimate is the exact order statistic.  The
+   * sketch must not be empty.
+   */
+  double Estimate() const;
+
+  //! Get the number of observations inserted so far.
+  size_t Count() const { return count; }
+
+  //! Get the quantile this sketch estimates.
+  double Quantile() const { return quantile; }
+
+ private:
+  //! The quantile to estimate.
+  double quantile;
+  //! The number of observations inserted so far.
+  size_t count;
+
+  //! Marker heights (the estimated quantile is the middle height).
+  double heights[5];
+  //! Actual marker positions (1-based ranks).
+  double positions[5];
+  //! Desired marker positions.
+  double desired[5];
+  //! Per-observation increments of the desired positions.
+  double increments[5];
+};
+
+} // namespace math
+} // namespace mlpack
+
+// Include implementation.
+#include "quantile_sketch_impl.hpp"
+
+#endif
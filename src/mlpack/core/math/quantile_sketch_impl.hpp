@@ -0,0 +1,142 @@
+/**
+ * @file core/math/quantile_sketch_impl.hpp
+ *
+ * Implementation of the P^2 quantile sketch.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_QUANTILE_SKETCH_IMPL_HPP
+#define MLPACK_CORE_MATH_QUANTILE_SKETCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "quantile_sketch.hpp"
+
+namespace mlpack {
+namespace math {
+
+inline QuantileSketch::QuantileSketch(const double quantile) :
+    quantile(quantile),
+    count(0)
+{
+  if (quantile <= 0.0 || quantile >= 1.0)
+    throw std::invalid_argument("QuantileSketch: quantile must be in (0, 1)");
+
+  // Desired marker positions (1-based) and their per-observation increments,
+  // following Jain and Chlamtac (1985).
+  desired[0] = 1.0;
+  desired[1] = 1.0 + 2.0 * quantile;
+  desired[2] = 1.0 + 4.0 * quantile;
+  desired[3] = 3.0 + 2.0 * quantile;
+  desired[4] = 5.0;
+
+  increments[0] = 0.0;
+  increments[1] = quantile / 2.0;
+  increments[2] = quantile;
+  increments[3] = (1.0 + quantile) / 2.0;
+  increments[4] = 1.0;
+}
+
+inline void QuantileSketch::Insert(const double value)
+{
+  // The first five observations initialize the markers.
+  if (count < 5)
+  {
+    heights[count] = value;
+    ++count;
+    if (count == 5)
+    {
+      std::sort(heights, heights + 5);
+      for (size_t i = 0; i < 5; ++i)
+        positions[i] = i + 1;
+    }
+    return;
+  }
+
+  // Find the cell the new observation falls into, extending the extreme
+  // markers if necessary.
+  size_t k;
+  if (value < heights[0])
+  {
+    heights[0] = value;
+    k = 0;
+  }
+  else if (value >= heights[4])
+  {
+    heights[4] = value;
+    k = 3;
+  }
+  else
+  {
+    k = 0;
+    while (k < 3 && value >= heights[k + 1])
+      ++k;
+  }
+
+  // Shift the actual positions of the markers above the cell, and advance
+  // every desired position.
+  for (size_t i = k + 1; i < 5; ++i)
+    positions[i] += 1.0;
+  for (size_t i = 0; i < 5; ++i)
+    desired[i] += increments[i];
+
+  // Adjust the heights of the three interior markers toward their desired
+  // positions, using the piecewise-parabolic update when it keeps the
+  // heights ordered and a linear update otherwise.
+  for (size_t i = 1; i <= 3; ++i)
+  {
+    const double diff = desired[i] - positions[i];
+    if ((diff >= 1.0 && positions[i + 1] - positions[i] > 1.0) ||
+        (diff <= -1.0 && positions[i - 1] - positions[i] < -1.0))
+    {
+      const double d = (diff >= 1.0) ? 1.0 : -1.0;
+      const double parabolic = heights[i] + d /
+          (positions[i + 1] - positions[i - 1]) *
+          ((positions[i] - positions[i - 1] + d) *
+              (heights[i + 1] - heights[i]) /
+              (positions[i + 1] - positions[i]) +
+           (positions[i + 1] - positions[i] - d) *
+              (heights[i] - heights[i - 1]) /
+              (positions[i] - positions[i - 1]));
+
+      if (heights[i - 1] < parabolic && parabolic < heights[i + 1])
+      {
+        heights[i] = parabolic;
+      }
+      else
+      {
+        // Linear update toward the neighbor in the direction of d.
+        const size_t j = (d > 0) ? i + 1 : i - 1;
+        heights[i] += d * (heights[j] - heights[i]) /
+            (positions[j] - positions[i]);
+      }
+
+      positions[i] += d;
+    }
+  }
+
+  ++count;
+}
+
+inline double QuantileSketch::Estimate() const
+{
+  if (count == 0)
+    throw std::runtime_error("QuantileSketch::Estimate(): sketch is empty");
+
+  if (count >= 5)
+    return heights[2];
+
+  // With fewer than five observations, return the exact order statistic.
+  double sorted[5];
+  std::copy(heights, heights + count, sorted);
+  std::sort(sorted, sorted + count);
+  const size_t index = (size_t) std::floor(quantile * (count - 1) + 0.5);
+  return sorted[index];
+}
+
+} // namespace math
+} // namespace mlpack
+
+#endif
@@ -8,6 +8,7 @@
  * 3-clause BSD license along with mlpack.  If not, see
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
+#include <cstdint>
 #include <random>
 #include <mlpack/mlpack_export.hpp>
 
@@ -20,6 +21,9 @@ MLPACK_EXPORT std::mt19937 randGen;
 MLPACK_EXPORT std::uniform_real_distribution<> randUniformDist(0.0, 1.0);
 // Global normal distribution.
 MLPACK_EXPORT std::normal_distribution<> randNormalDist(0.0, 1.0);
+// Global seed the counter-based random streams are derived from; the default
+// matches the default seed of the global std::mt19937.
+MLPACK_EXPORT uint64_t randStreamSeed = std::mt19937::default_seed;
 
 } // namespace math
 } // namespace mlpack
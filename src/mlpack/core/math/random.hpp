@@ -29,6 +29,9 @@ extern MLPACK_EXPORT std::mt19937 randGen;
 extern MLPACK_EXPORT std::uniform_real_distribution<> randUniformDist;
 // Global normal distribution.
 extern MLPACK_EXPORT std::normal_distribution<> randNormalDist;
+// Global seed the counter-based random streams are derived from (see
+// random_stream.hpp).
+extern MLPACK_EXPORT uint64_t randStreamSeed;
 
 /**
  * Set the random seed used by the random functions (Random() and RandInt()).
@@ -41,6 +44,7 @@ inline void RandomSeed(const size_t seed)
 {
   #if (!defined(BINDING_TYPE) || BINDING_TYPE != BINDING_TYPE_TEST)
     randGen.seed((uint32_t) seed);
+    randStreamSeed = (uint64_t) seed;
     #if (BINDING_TYPE == BINDING_TYPE_R)
       // To suppress Found ‘srand’, possibly from ‘srand’ (C).
       (void) seed;
@@ -65,6 +69,7 @@ inline void FixedRandomSeed()
 {
   const static size_t seed = rand();
   randGen.seed((uint32_t) seed);
+  randStreamSeed = (uint64_t) seed;
   srand((unsigned int) seed);
   arma::arma_rng::set_seed(seed);
 }
@@ -72,6 +77,7 @@ inline void FixedRandomSeed()
 inline void CustomRandomSeed(const size_t seed)
 {
   randGen.seed((uint32_t) seed);
+  randStreamSeed = (uint64_t) seed;
   srand((unsigned int) seed);
   arma::arma_rng::set_seed(seed);
 }
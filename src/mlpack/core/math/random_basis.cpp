@@ -18,12 +18,24 @@ namespace math {
 
 void RandomBasis(mat& basis, const size_t d)
 {
+  // Key a stream off the global generator, so the result is determined by
+  // the global seed and the generation is independent of armadillo's RNG.
+  RandomStream stream(randGen());
+  RandomBasis(basis, d, stream);
+}
+
+void RandomBasis(mat& basis, const size_t d, RandomStream& stream)
+{
+  mat candidate(d, d);
   while (true)
   {
     // [Q, R] = qr(randn(d, d));
     // Q = Q * diag(sign(diag(R)));
+    for (size_t i = 0; i < candidate.n_elem; ++i)
+      candidate[i] = stream.RandNormal();
+
     mat r;
-    if (qr(basis, r, randn<mat>(d, d)))
+    if (qr(basis, r, candidate))
     {
       vec rDiag(r.n_rows);
       for (size_t i = 0; i < rDiag.n_elem; ++i)
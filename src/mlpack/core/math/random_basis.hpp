@@ -14,6 +14,8 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "random_stream.hpp"
+
 namespace mlpack {
 namespace math {
 
@@ -26,6 +28,18 @@ namespace math {
  */
 void RandomBasis(arma::mat& basis, const size_t d);
 
+/**
+ * Create a random d-dimensional orthogonal basis, storing it in the given
+ * matrix, drawing all randomness from the given stream.  The result depends
+ * only on the stream, so parallel callers can generate bases concurrently
+ * and reproducibly by keying one stream per basis.
+ *
+ * @param basis Matrix to store basis in.
+ * @param d Desired number of dimensions in the basis.
+ * @param stream Stream to draw the basis from.
+ */
+void RandomBasis(arma::mat& basis, const size_t d, RandomStream& stream);
+
 } // namespace math
 } // namespace mlpack
 
@@ -0,0 +1,186 @@
+/**
+ * @file core/math/random_stream.hpp
+ *
+ * A counter-based random number stream for reproducible parallel random
+ * number generation.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_RANDOM_STREAM_HPP
+#define MLPACK_CORE_MATH_RANDOM_STREAM_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "random.hpp"
+
+namespace mlpack {
+namespace math {
+
+/**
+ * A counter-based random number stream.  The global generator (see
+ * random.hpp) is a single std::mt19937, so parallel code either contends on
+ * it or produces results that depend on the number of threads and on how the
+ * work was scheduled.  A RandomStream instead derives every value from a
+ * fixed key and a running counter by a stateless mixing function: streams
+ * with different ids are independent, any position of a stream can be reached
+ * in constant time, and a stream's output depends only on the global seed
+ * (RandomSeed()) and the stream id -- not on the thread that consumes it.
+ *
+ * Parallel consumers should key their streams by the logical unit of work
+ * (the tree, the chunk, the repetition) rather than by the thread id, so that
+ * results are bitwise identical no matter how many threads run:
+ *
+ * @code
+ * #pragma omp parallel for
+ * for (omp_size_t i = 0; i < numTasks; ++i)
+ * {
+ *   RandomStream stream(i);
+ *   ... // Use stream.Random(), stream.RandInt(), stream.RandNormal().
+ * }
+ * @endcode
+ *
+ * The stream also satisfies the UniformRandomBitGenerator concept, but note
+ * that standard library distributions are not bitwise portable across
+ * implementations; the Random(), RandInt() and RandNormal() members are, as
+ * they are fully specified here.
+ */
+class RandomStream
+{
+ public:
+  //! Type of the raw values the stream produces.
+  typedef uint64_t result_type;
+
+  /**
+   * Create a stream with the given id.  The stream's key is derived from the
+   * global seed (RandomSeed()) and the id, so streams with different ids
+   * produce independent sequences and the same (seed, id) pair always
+   * reproduces the same sequence.
+   *
+   * @param streamId Id of the stream.
+   */
+  explicit RandomStream(const uint64_t streamId = 0) :
+      key(Mix(randStreamSeed + 0x9E3779B97F4A7C15ULL * (streamId + 1))),
+      counter(0)
+  { }
+
+  //! Smallest raw value the stream can produce.
+  static constexpr result_type min() { return 0; }
+  //! Largest raw value the stream can produce.
+  static constexpr result_type max() { return ~(result_type) 0; }
+
+  //! Get the next raw 64-bit value of the stream.
+  result_type operator()()
+  {
+    return Mix(key + (++counter) * 0x9E3779B97F4A7C15ULL);
+  }
+
+  //! Move the stream to the given position in constant time; the next value
+  //! drawn is the one a fresh stream would produce after position draws.
+  void Seek(const uint64_t position) { counter = position; }
+
+  //! Get the number of values drawn from the stream so far.
+  uint64_t Position() const { return counter; }
+
+  //! Generate a uniform random number between 0 and 1.
+  double Random()
+  {
+    // The upper 53 bits of the raw value, as an exactly representable double
+    // in [0, 1).
+    return ((*this)() >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+  //! Generate a uniform random number in the specified range.
+  double Random(const double lo, const double hi)
+  {
+    return lo + (hi - lo) * Random();
+  }
+
+  //! Generate a uniform random integer in [0, hiExclusive).
+  int RandInt(const int hiExclusive)
+  {
+    return (int) std::floor((double) hiExclusive * Random());
+  }
+
+  //! Generate a uniform random integer in [lo, hiExclusive).
+  int RandInt(const int lo, const int hiExclusive)
+  {
+    return lo + (int) std::floor((double) (hiExclusive - lo) * Random());
+  }
+
+  //! Generate a normally distributed random number with mean 0 and variance
+  //! 1.
+  double RandNormal()
+  {
+    // Box-Muller transform; unlike std::normal_distribution, its output is
+    // fully specified, so streams are bitwise reproducible across standard
+    // library implementations.  (1 - u1) lies in (0, 1], so the logarithm is
+    // finite.
+    const double u1 = Random();
+    const double u2 = Random();
+    return std::sqrt(-2.0 * std::log(1.0 - u1)) * std::cos(2.0 * M_PI * u2);
+  }
+
+  //! Generate a normally distributed random number with the specified mean
+  //! and variance.
+  double RandNormal(const double mean, const double variance)
+  {
+    return variance * RandNormal() + mean;
+  }
+
+ private:
+  //! Bijective mixing of a 64-bit value (the SplitMix64 finalizer).
+  static uint64_t Mix(uint64_t z)
+  {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+  //! Key of the stream, derived from the global seed and the stream id.
+  uint64_t key;
+  //! Number of values drawn from the stream so far.
+  uint64_t counter;
+}; // class RandomStream
+
+/**
+ * Generate a uniformly shuffled ordering of n indices with a Fisher-Yates
+ * shuffle driven by the given stream.
+ *
+ * @param n Number of indices to shuffle.
+ * @param stream Stream to draw the shuffle from.
+ */
+inline arma::uvec ShuffledOrder(const size_t n, RandomStream& stream)
+{
+  if (n == 0)
+    return arma::uvec();
+
+  arma::uvec order = arma::linspace<arma::uvec>(0, n - 1, n);
+  for (size_t i = n - 1; i > 0; --i)
+  {
+    const size_t j = (size_t) std::floor((double) (i + 1) * stream.Random());
+    std::swap(order[i], order[j]);
+  }
+  return order;
+}
+
+/**
+ * Generate a uniformly shuffled ordering of n indices.  The shuffle is driven
+ * by a stream keyed off a single draw of the global generator, so it consumes
+ * one value of the global sequence regardless of n and its result is
+ * determined by the global seed.
+ *
+ * @param n Number of indices to shuffle.
+ */
+inline arma::uvec ShuffledOrder(const size_t n)
+{
+  RandomStream stream(randGen());
+  return ShuffledOrder(n, stream);
+}
+
+} // namespace math
+} // namespace mlpack
+
+#endif
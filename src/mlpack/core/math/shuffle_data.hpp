@@ -14,6 +14,8 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "random_stream.hpp"
+
 namespace mlpack {
 namespace math {
 
@@ -33,8 +35,7 @@ void ShuffleData(const MatType& inputPoints,
                  const std::enable_if_t<!arma::is_Cube<MatType>::value>* = 0)
 {
   // Generate ordering.
-  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
-      inputPoints.n_cols - 1, inputPoints.n_cols));
+  arma::uvec ordering = ShuffledOrder(inputPoints.n_cols);
 
   outputPoints = inputPoints.cols(ordering);
   outputLabels = inputLabels.cols(ordering);
@@ -56,8 +57,7 @@ void ShuffleData(const MatType& inputPoints,
                  const std::enable_if_t<!arma::is_Cube<MatType>::value>* = 0)
 {
   // Generate ordering.
-  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
-      inputPoints.n_cols - 1, inputPoints.n_cols));
+  arma::uvec ordering = ShuffledOrder(inputPoints.n_cols);
 
   // Extract coordinate list representation.
   arma::umat locations(2, inputPoints.n_nonzero);
@@ -109,8 +109,7 @@ void ShuffleData(const MatType& inputPoints,
                  const std::enable_if_t<arma::is_Cube<LabelsType>::value>* = 0)
 {
   // Generate ordering.
-  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
-      inputPoints.n_cols - 1, inputPoints.n_cols));
+  arma::uvec ordering = ShuffledOrder(inputPoints.n_cols);
 
   // Properly handle the case where the input and output data are the same
   // object.
@@ -167,8 +166,7 @@ void ShuffleData(const MatType& inputPoints,
                  const std::enable_if_t<!arma::is_Cube<MatType>::value>* = 0)
 {
   // Generate ordering.
-  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
-      inputPoints.n_cols - 1, inputPoints.n_cols));
+  arma::uvec ordering = ShuffledOrder(inputPoints.n_cols);
 
   outputPoints = inputPoints.cols(ordering);
   outputLabels = inputLabels.cols(ordering);
@@ -195,8 +193,7 @@ void ShuffleData(const MatType& inputPoints,
                  const std::enable_if_t<!arma::is_Cube<MatType>::value>* = 0)
 {
   // Generate ordering.
-  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
-      inputPoints.n_cols - 1, inputPoints.n_cols));
+  arma::uvec ordering = ShuffledOrder(inputPoints.n_cols);
 
   // Extract coordinate list representation.
   arma::umat locations(2, inputPoints.n_nonzero);
@@ -237,6 +234,137 @@ void ShuffleData(const MatType& inputPoints,
   }
 }
 
+/**
+ * A view over a dataset and its labels (or responses) that yields minibatches
+ * in a shuffled order without ever materializing a shuffled copy of the whole
+ * dataset.  Only the columns of the current batch are gathered into small
+ * buffers that are reused from one batch to the next, so the memory overhead
+ * is one batch instead of one full dataset copy per epoch.
+ *
+ * A typical training loop:
+ *
+ * @code
+ * ShuffledBatchView<arma::mat, arma::Row<size_t>> view(data, labels, 32);
+ * arma::mat batchData;
+ * arma::Row<size_t> batchLabels;
+ * for (size_t epoch = 0; epoch < maxEpochs; ++epoch)
+ * {
+ *   for (size_t i = 0; i < view.NumBatches(); ++i)
+ *   {
+ *     view.Batch(i, batchData, batchLabels);
+ *     ... // Train on the batch.
+ *   }
+ *   view.Shuffle();
+ * }
+ * @endcode
+ *
+ * Sparse datasets are supported too; their batches are gathered column by
+ * column, so the full sparse matrix is never rebuilt.
+ */
+template<typename MatType, typename LabelsType>
+class ShuffledBatchView
+{
+ public:
+  /**
+   * Create a view over the given dataset with an initial shuffled ordering.
+   * The view keeps references to the dataset and labels, so they must outlive
+   * it.
+   *
+   * @param inputPoints Dataset to view.
+   * @param inputLabels Labels (or responses) associated with the dataset.
+   * @param batchSize Number of points per batch.
+   */
+  ShuffledBatchView(const MatType& inputPoints,
+                    const LabelsType& inputLabels,
+                    const size_t batchSize) :
+      inputPoints(inputPoints),
+      inputLabels(inputLabels),
+      batchSize(batchSize)
+  {
+    if (batchSize == 0)
+      throw std::invalid_argument("ShuffledBatchView: batch size must not be "
+          "0");
+
+    Shuffle();
+  }
+
+  //! Generate a new shuffled ordering; call this once per epoch.
+  void Shuffle()
+  {
+    ordering = ShuffledOrder(inputPoints.n_cols);
+  }
+
+  //! Get the number of batches.
+  size_t NumBatches() const
+  {
+    return (inputPoints.n_cols + batchSize - 1) / batchSize;
+  }
+
+  //! Get the current shuffled ordering of the points.
+  const arma::uvec& Ordering() const { return ordering; }
+
+  /**
+   * Gather the points and labels of the given batch into the given buffers.
+   * The buffers are only resized when their size does not match, so they can
+   * be reused across batches and epochs without reallocation.  The last batch
+   * may hold fewer than batchSize points.
+   *
+   * @param batch Index of the batch to gather (0 <= batch < NumBatches()).
+   * @param batchPoints Buffer the batch points are gathered into.
+   * @param batchLabels Buffer the batch labels are gathered into.
+   */
+  void Batch(const size_t batch,
+             MatType& batchPoints,
+             LabelsType& batchLabels) const
+  {
+    const size_t begin = batch * batchSize;
+    const size_t count = std::min(batchSize,
+        (size_t) inputPoints.n_cols - begin);
+    GatherBatch(ordering.subvec(begin, begin + count - 1), batchPoints,
+        batchLabels);
+  }
+
+ private:
+  //! Gather a dense batch; assignment reuses the buffer if the size matches.
+  template<typename T = MatType>
+  void GatherBatch(const arma::uvec& columns,
+                   T& batchPoints,
+                   LabelsType& batchLabels,
+                   const std::enable_if_t<!arma::is_SpMat<T>::value>* = 0)
+      const
+  {
+    batchPoints = inputPoints.cols(columns);
+    batchLabels = inputLabels.cols(columns);
+  }
+
+  //! Gather a sparse batch column by column, without rebuilding the whole
+  //! sparse matrix from its coordinate list representation.
+  template<typename T = MatType>
+  void GatherBatch(const arma::uvec& columns,
+                   T& batchPoints,
+                   LabelsType& batchLabels,
+                   const std::enable_if_t<arma::is_SpMat<T>::value>* = 0)
+      const
+  {
+    batchPoints.zeros(inputPoints.n_rows, columns.n_elem);
+    for (size_t i = 0; i < columns.n_elem; ++i)
+      batchPoints.col(i) = inputPoints.col(columns[i]);
+    batchLabels = inputLabels.cols(columns);
+  }
+
+  //! The dataset the view refers to.
+  const MatType& inputPoints;
+
+  //! The labels the view refers to.
+  const LabelsType& inputLabels;
+
+  //! Number of points per batch.
+  const size_t batchSize;
+
+  //! Current shuffled ordering of the points.
+  arma::uvec ordering;
+};
+
 } // namespace math
 } // namespace mlpack
 
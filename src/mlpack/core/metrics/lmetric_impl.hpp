@@ -18,6 +18,82 @@
 namespace mlpack {
 namespace metric {
 
+//! Per-element term of the L_p sum; specialized so that the common powers do
+//! not go through std::pow().
+template<int Power>
+struct LMetricPowerOperation
+{
+  static double Apply(const double diff) { return std::pow(fabs(diff), Power); }
+};
+
+template<>
+struct LMetricPowerOperation<1>
+{
+  static double Apply(const double diff) { return fabs(diff); }
+};
+
+template<>
+struct LMetricPowerOperation<2>
+{
+  static double Apply(const double diff) { return diff * diff; }
+};
+
+/**
+ * Accumulate sum_{i < Dim} |a[i] - b[i]|^Power with the loop fully unrolled
+ * at compile time.  At the tiny dimensionalities common in geospatial
+ * workloads (d = 2 or 3), loop setup costs as much as the arithmetic itself,
+ * so Evaluate() dispatches here when d <= 8.
+ */
+template<int Power, size_t Dim>
+struct LMetricUnrolledSum
+{
+  template<typename VecTypeA, typename VecTypeB>
+  static double Apply(const VecTypeA& a, const VecTypeB& b)
+  {
+    return LMetricPowerOperation<Power>::Apply(a[Dim - 1] - b[Dim - 1]) +
+        LMetricUnrolledSum<Power, Dim - 1>::Apply(a, b);
+  }
+};
+
+template<int Power>
+struct LMetricUnrolledSum<Power, 0>
+{
+  template<typename VecTypeA, typename VecTypeB>
+  static double Apply(const VecTypeA& /* a */, const VecTypeB& /* b */)
+  {
+    return 0.0;
+  }
+};
+
+//! Dispatch on the runtime dimensionality to an unrolled kernel.  Only call
+//! this when a.n_elem <= 8.
+template<int Power, typename VecTypeA, typename VecTypeB>
+inline double LMetricUnrolledEvaluate(const VecTypeA& a, const VecTypeB& b)
+{
+  switch (a.n_elem)
+  {
+    case 1: return LMetricUnrolledSum<Power, 1>::Apply(a, b);
+    case 2: return LMetricUnrolledSum<Power, 2>::Apply(a, b);
+    case 3: return LMetricUnrolledSum<Power, 3>::Apply(a, b);
+    case 4: return LMetricUnrolledSum<Power, 4>::Apply(a, b);
+    case 5: return LMetricUnrolledSum<Power, 5>::Apply(a, b);
+    case 6: return LMetricUnrolledSum<Power, 6>::Apply(a, b);
+    case 7: return LMetricUnrolledSum<Power, 7>::Apply(a, b);
+    case 8: return LMetricUnrolledSum<Power, 8>::Apply(a, b);
+    default: return 0.0; // Empty vectors have an empty sum.
+  }
+}
+
+//! Whether the unrolled small-dimension kernels give exactly the semantics of
+//! the Armadillo expressions (they compute in double, so integer element
+//! types must take the generic path).
+template<typename VecTypeA>
+struct LMetricCanUnroll
+{
+  static const bool value =
+      std::is_floating_point<typename VecTypeA::elem_type>::value;
+};
+
 // Unspecialized implementation.  This should almost never be used...
 template<int Power, bool TakeRoot>
 template<typename VecTypeA, typename VecTypeB>
@@ -26,8 +102,11 @@ typename VecTypeA::elem_type LMetric<Power, TakeRoot>::Evaluate(
     const VecTypeB& b)
 {
   typename VecTypeA::elem_type sum = 0;
-  for (size_t i = 0; i < a.n_elem; ++i)
-    sum += std::pow(fabs(a[i] - b[i]), Power);
+  if (LMetricCanUnroll<VecTypeA>::value && a.n_elem <= 8)
+    sum = LMetricUnrolledEvaluate<Power>(a, b);
+  else
+    for (size_t i = 0; i < a.n_elem; ++i)
+      sum += std::pow(fabs(a[i] - b[i]), Power);
 
   if (!TakeRoot) // The compiler should optimize this correctly at compile-time.
     return sum;
@@ -42,6 +121,9 @@ typename VecTypeA::elem_type LMetric<1, true>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
+  if (LMetricCanUnroll<VecTypeA>::value && a.n_elem <= 8)
+    return LMetricUnrolledEvaluate<1>(a, b);
+
   return arma::accu(abs(a - b));
 }
 
@@ -51,6 +133,9 @@ typename VecTypeA::elem_type LMetric<1, false>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
+  if (LMetricCanUnroll<VecTypeA>::value && a.n_elem <= 8)
+    return LMetricUnrolledEvaluate<1>(a, b);
+
   return arma::accu(abs(a - b));
 }
 
@@ -61,6 +146,9 @@ typename VecTypeA::elem_type LMetric<2, true>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
+  if (LMetricCanUnroll<VecTypeA>::value && a.n_elem <= 8)
+    return std::sqrt(LMetricUnrolledEvaluate<2>(a, b));
+
   return arma::norm(a - b, 2);
 }
 
@@ -70,6 +158,9 @@ typename VecTypeA::elem_type LMetric<2, false>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
+  if (LMetricCanUnroll<VecTypeA>::value && a.n_elem <= 8)
+    return LMetricUnrolledEvaluate<2>(a, b);
+
   return accu(arma::square(a - b));
 }
 
@@ -80,9 +171,8 @@ typename VecTypeA::elem_type LMetric<3, true>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
-  typename VecTypeA::elem_type sum = 0;
-  for (size_t i = 0; i < a.n_elem; ++i)
-    sum += std::pow(fabs(a[i] - b[i]), 3.0);
+  if (LMetricCanUnroll<VecTypeA>::value && a.n_elem <= 8)
+    return std::pow(LMetricUnrolledEvaluate<3>(a, b), 1.0 / 3.0);
 
   return std::pow(arma::accu(arma::pow(arma::abs(a - b), 3.0)), 1.0 / 3.0);
 }
@@ -93,6 +183,9 @@ typename VecTypeA::elem_type LMetric<3, false>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
+  if (LMetricCanUnroll<VecTypeA>::value && a.n_elem <= 8)
+    return LMetricUnrolledEvaluate<3>(a, b);
+
   return arma::accu(arma::pow(arma::abs(a - b), 3.0));
 }
 
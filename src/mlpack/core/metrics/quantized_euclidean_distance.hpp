@@ -0,0 +1,90 @@
+/**
+ * @file core/metrics/quantized_euclidean_distance.hpp
+ * @author Ryan Curtin
+ *
+ * The Euclidean distance over per-dimension quantized (integer) data.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_METRICS_QUANTIZED_EUCLIDEAN_DISTANCE_HPP
+#define MLPACK_CORE_METRICS_QUANTIZED_EUCLIDEAN_DISTANCE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace metric {
+
+/**
+ * The Euclidean distance between points that have been quantized with a
+ * per-dimension affine map, as produced by data::Quantize().  If the original
+ * point satisfies @f$ x_d \approx s_d q_d + o_d @f$ for quantized value
+ * @f$ q_d @f$, scale @f$ s_d @f$ and offset @f$ o_d @f$, then the offsets
+ * cancel in any difference of two points, and
+ *
+ * @f[
+ * d(x, y) \approx \sqrt{\sum_d s_d^2 (q_{x,d} - q_{y,d})^2}
+ * @f]
+ *
+ * which is what this class computes.  It therefore approximates the Euclidean
+ * distance between the original (unquantized) points while only storing the
+ * small integer representation, typically `arma::Mat<arma::s8>`, which is 4x
+ * smaller than a float matrix and 8x smaller than a double one.
+ *
+ * If no scales are given (the default constructor), every scale is taken to
+ * be 1 and this reduces to the plain Euclidean distance over the quantized
+ * values.
+ *
+ * This is a true metric (it is a diagonally-weighted L2 distance), but it is
+ * not an LMetric, so it cannot be used with the default KDTree; use a tree
+ * that accepts arbitrary metrics (such as tree::BallTree or a cover tree), or
+ * naive search.
+ */
+class QuantizedEuclideanDistance
+{
+ public:
+  /**
+   * Initialize the distance with unit scales; this is the plain Euclidean
+   * distance over the quantized values.
+   */
+  QuantizedEuclideanDistance() { }
+
+  /**
+   * Initialize the distance with the given per-dimension scales, as produced
+   * by data::Quantize().
+   *
+   * @param scale Per-dimension quantization scales.
+   */
+  QuantizedEuclideanDistance(arma::vec scale) : scale(std::move(scale)) { }
+
+  /**
+   * Evaluate the distance between the two given quantized points.
+   *
+   * @param a First vector.
+   * @param b Second vector.
+   */
+  template<typename VecTypeA, typename VecTypeB>
+  double Evaluate(const VecTypeA& a, const VecTypeB& b) const;
+
+  //! Access the per-dimension scales (empty means unit scales).
+  const arma::vec& Scale() const { return scale; }
+  //! Modify the per-dimension scales.
+  arma::vec& Scale() { return scale; }
+
+  //! Serialize the distance.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t version);
+
+ private:
+  //! The per-dimension quantization scales; empty means unit scales.
+  arma::vec scale;
+};
+
+} // namespace metric
+} // namespace mlpack
+
+#include "quantized_euclidean_distance_impl.hpp"
+
+#endif
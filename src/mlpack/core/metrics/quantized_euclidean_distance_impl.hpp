@@ -0,0 +1,60 @@
+/**
+ * @file core/metrics/quantized_euclidean_distance_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the QuantizedEuclideanDistance class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_METRICS_QUANTIZED_EUCLIDEAN_DISTANCE_IMPL_HPP
+#define MLPACK_CORE_METRICS_QUANTIZED_EUCLIDEAN_DISTANCE_IMPL_HPP
+
+// In case it hasn't been included.
+#include "quantized_euclidean_distance.hpp"
+
+namespace mlpack {
+namespace metric {
+
+template<typename VecTypeA, typename VecTypeB>
+double QuantizedEuclideanDistance::Evaluate(const VecTypeA& a,
+                                            const VecTypeB& b) const
+{
+  // An explicit loop is used instead of an Armadillo expression so that the
+  // two vectors may have different element types (e.g. a double tree bound
+  // center against an int8 data column); integer differences are promoted
+  // before squaring so they cannot overflow.
+  double sum = 0.0;
+  if (scale.n_elem == 0)
+  {
+    for (size_t i = 0; i < a.n_elem; ++i)
+    {
+      const double diff = (double) a[i] - (double) b[i];
+      sum += diff * diff;
+    }
+  }
+  else
+  {
+    for (size_t i = 0; i < a.n_elem; ++i)
+    {
+      const double diff = scale[i] * ((double) a[i] - (double) b[i]);
+      sum += diff * diff;
+    }
+  }
+
+  return std::sqrt(sum);
+}
+
+template<typename Archive>
+void QuantizedEuclideanDistance::serialize(Archive& ar,
+                                           const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(scale));
+}
+
+} // namespace metric
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,138 @@
+/**
+ * @file core/tree/binary_space_tree/arena_layout.hpp
+ *
+ * Defines TreeNodeArena, a utility which relocates the nodes of a built
+ * BinarySpaceTree (or any binary tree with the same Left()/Right()/Parent()
+ * interface) into one contiguous arena, ordered with the cache-oblivious van
+ * Emde Boas layout.  Deep traversals of the relocated tree touch far fewer
+ * cache lines than traversals of the individually heap-allocated original.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_ARENA_LAYOUT_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_ARENA_LAYOUT_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * An arena which holds all nodes of a binary tree in one contiguous block of
+ * memory, ordered with the recursive van Emde Boas layout so that any
+ * root-to-leaf path crosses O(log_B N) cache blocks regardless of the cache
+ * block size B.  Use it after building a tree:
+ *
+ * @code
+ * KDTree<...> tree(dataset);
+ * TreeNodeArena<KDTree<...>> arena;
+ * KDTree<...>* packedRoot = arena.Layout(tree);
+ * // Traverse from packedRoot; 'tree' is now empty.  The arena owns the
+ * // relocated tree (and its dataset) and frees it on destruction.
+ * @endcode
+ *
+ * The relocation is destructive: nodes are moved out of the original tree,
+ * which is left empty.  The tree type must provide modifiable Left(), Right()
+ * and Parent() accessors and a move constructor, as BinarySpaceTree does.
+ *
+ * @tparam TreeType Type of the tree whose nodes will be relocated.
+ */
+template<typename TreeType>
+class TreeNodeArena
+{
+ public:
+  //! Construct an empty arena.
+  TreeNodeArena();
+
+  //! Destroy the arena and every node it holds.
+  ~TreeNodeArena();
+
+  // The arena cannot be copied, since it uniquely owns its nodes.
+  TreeNodeArena(const TreeNodeArena&) = delete;
+  TreeNodeArena& operator=(const TreeNodeArena&) = delete;
+
+  /**
+   * Move every node of the tree rooted at the given node into the arena, in
+   * van Emde Boas order, and return a pointer to the relocated root.  The
+   * original tree is emptied (its nodes are deallocated), and the arena takes
+   * ownership of the relocated tree.  Any previous contents of the arena are
+   * freed first.
+   *
+   * @param root Root of the tree to relocate; left empty afterwards.
+   * @return Pointer to the relocated root node, owned by the arena.
+   */
+  TreeType* Layout(TreeType& root);
+
+  /**
+   * Deserialize a tree from the given cereal archive straight into the arena.
+   * The recursive archive format carries no node count, so the nodes are
+   * first reconstructed through the tree's regular serialize() path and then
+   * relocated in bulk into one contiguous block in van Emde Boas order; the
+   * transient per-node allocations are released immediately, while they are
+   * still hot in the allocator, instead of fragmenting the heap for the
+   * lifetime of the tree.  Any previous contents of the arena are freed
+   * first.
+   *
+   * @code
+   * std::ifstream f("tree.bin", std::ios::binary);
+   * cereal::BinaryInputArchive ar(f);
+   * TreeNodeArena<KDTree<...>> arena;
+   * KDTree<...>* root = arena.Load(ar, "tree");
+   * @endcode
+   *
+   * @param ar Archive to load the tree from.
+   * @param name Name the tree was saved under.
+   * @return Pointer to the loaded root node, owned by the arena.
+   */
+  template<typename Archive>
+  TreeType* Load(Archive& ar, const std::string& name);
+
+  //! Get the relocated root node (NULL if Layout() has not been called).
+  TreeType* Root() const { return root; }
+
+  //! Get the number of nodes held in the arena.
+  size_t NumNodes() const { return numNodes; }
+
+ private:
+  /**
+   * Append the nodes of the subtree rooted at the given node to the order
+   * list, in van Emde Boas order, considering only the top levels of the
+   * subtree.  Nodes immediately below the considered levels are appended to
+   * the boundary list instead, for the caller to lay out afterwards.
+   *
+   * @param node Root of the subtree to order.
+   * @param levels Number of levels of the subtree to lay out.
+   * @param order Output list of nodes in van Emde Boas order.
+   * @param boundary Output list of subtree roots below the considered levels.
+   */
+  void VanEmdeBoasOrder(TreeType* node,
+                        const size_t levels,
+                        std::vector<TreeType*>& order,
+                        std::vector<TreeType*>& boundary);
+
+  //! Return the height (number of levels) of the subtree at the given node.
+  size_t SubtreeHeight(const TreeType* node) const;
+
+  //! Destroy all nodes in the arena and free the storage.
+  void Clear();
+
+  //! Raw storage for the relocated nodes.
+  char* storage;
+
+  //! The relocated root node.
+  TreeType* root;
+
+  //! The number of nodes held in the arena.
+  size_t numNodes;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "arena_layout_impl.hpp"
+
+#endif // MLPACK_CORE_TREE_BINARY_SPACE_TREE_ARENA_LAYOUT_HPP
@@ -0,0 +1,182 @@
+/**
+ * @file core/tree/binary_space_tree/arena_layout_impl.hpp
+ *
+ * Implementation of TreeNodeArena.  Nodes are collected in van Emde Boas
+ * order, move-constructed into one contiguous allocation, and their child and
+ * parent pointers are rewritten to point into the arena.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_ARENA_LAYOUT_IMPL_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_ARENA_LAYOUT_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "arena_layout.hpp"
+
+#include <unordered_map>
+
+namespace mlpack {
+namespace tree {
+
+template<typename TreeType>
+TreeNodeArena<TreeType>::TreeNodeArena() :
+    storage(NULL),
+    root(NULL),
+    numNodes(0)
+{ /* Nothing to do. */ }
+
+template<typename TreeType>
+TreeNodeArena<TreeType>::~TreeNodeArena()
+{
+  Clear();
+}
+
+template<typename TreeType>
+size_t TreeNodeArena<TreeType>::SubtreeHeight(const TreeType* node) const
+{
+  if (node == NULL)
+    return 0;
+  return 1 + std::max(SubtreeHeight(node->Left()),
+                      SubtreeHeight(node->Right()));
+}
+
+template<typename TreeType>
+void TreeNodeArena<TreeType>::VanEmdeBoasOrder(
+    TreeType* node,
+    const size_t levels,
+    std::vector<TreeType*>& order,
+    std::vector<TreeType*>& boundary)
+{
+  if (node == NULL)
+    return;
+
+  if (levels == 0)
+  {
+    // This node lies below the levels being laid out; the caller will lay out
+    // the subtree rooted here later.
+    boundary.push_back(node);
+    return;
+  }
+
+  if (levels == 1)
+  {
+    order.push_back(node);
+    if (node->Left() != NULL)
+      boundary.push_back(node->Left());
+    if (node->Right() != NULL)
+      boundary.push_back(node->Right());
+    return;
+  }
+
+  // Recursively lay out the top half of the levels, then each subtree hanging
+  // below it.  This is the classic van Emde Boas recursion.
+  const size_t topLevels = levels / 2;
+  const size_t bottomLevels = levels - topLevels;
+
+  std::vector<TreeType*> midBoundary;
+  VanEmdeBoasOrder(node, topLevels, order, midBoundary);
+  for (size_t i = 0; i < midBoundary.size(); ++i)
+    VanEmdeBoasOrder(midBoundary[i], bottomLevels, order, boundary);
+}
+
+template<typename TreeType>
+TreeType* TreeNodeArena<TreeType>::Layout(TreeType& oldRoot)
+{
+  Clear();
+
+  // Collect the nodes of the tree in van Emde Boas order.
+  std::vector<TreeType*> order;
+  std::vector<TreeType*> boundary; // Will remain empty: we use full height.
+  VanEmdeBoasOrder(&oldRoot, SubtreeHeight(&oldRoot), order, boundary);
+
+  numNodes = order.size();
+  if (numNodes == 0)
+    return NULL;
+
+  // Allocate one contiguous block for all nodes, and move each node into its
+  // slot.  The moved-from nodes are left hollow (no children, no dataset).
+  storage = new char[numNodes * sizeof(TreeType)];
+  std::unordered_map<const TreeType*, TreeType*> relocation;
+  relocation[NULL] = NULL;
+  for (size_t i = 0; i < numNodes; ++i)
+  {
+    TreeType* slot = reinterpret_cast<TreeType*>(storage) + i;
+    new (slot) TreeType(std::move(*order[i]));
+    relocation[order[i]] = slot;
+  }
+
+  // Rewrite child and parent pointers to point into the arena.  Pointers that
+  // already refer to arena slots are left alone: parents precede children in
+  // van Emde Boas order, so a node's move constructor may already have fixed
+  // up its children's parent pointers.
+  for (size_t i = 0; i < numNodes; ++i)
+  {
+    TreeType* slot = reinterpret_cast<TreeType*>(storage) + i;
+
+    typename std::unordered_map<const TreeType*, TreeType*>::const_iterator it;
+    if ((it = relocation.find(slot->Left())) != relocation.end())
+      slot->Left() = it->second;
+    if ((it = relocation.find(slot->Right())) != relocation.end())
+      slot->Right() = it->second;
+    if ((it = relocation.find(slot->Parent())) != relocation.end())
+      slot->Parent() = it->second;
+  }
+
+  // Free the hollow original nodes.  Their child pointers are NULL, so each
+  // delete destroys a single node; the root is owned by the caller and is not
+  // deleted here.
+  for (size_t i = 0; i < numNodes; ++i)
+  {
+    if (order[i] != &oldRoot)
+      delete order[i];
+  }
+
+  root = relocation.at(&oldRoot);
+  return root;
+}
+
+template<typename TreeType>
+template<typename Archive>
+TreeType* TreeNodeArena<TreeType>::Load(Archive& ar, const std::string& name)
+{
+  // The recursive format allocates every node individually through cereal;
+  // relocate them as soon as the root finishes loading, so that the loaded
+  // tree occupies one contiguous block and the transient nodes go back to
+  // the allocator right away.
+  TreeType scratch;
+  ar(cereal::make_nvp(name.c_str(), scratch));
+  return Layout(scratch);
+}
+
+template<typename TreeType>
+void TreeNodeArena<TreeType>::Clear()
+{
+  if (storage == NULL)
+    return;
+
+  // Detach every node from its children first, so that destroying a node
+  // cannot recursively delete arena memory.  Parent pointers are left alone:
+  // the destructor of the root (whose parent is NULL) must still free the
+  // dataset it owns.
+  TreeType* nodes = reinterpret_cast<TreeType*>(storage);
+  for (size_t i = 0; i < numNodes; ++i)
+  {
+    nodes[i].Left() = NULL;
+    nodes[i].Right() = NULL;
+  }
+  for (size_t i = 0; i < numNodes; ++i)
+    nodes[i].~TreeType();
+
+  delete[] storage;
+  storage = NULL;
+  root = NULL;
+  numNodes = 0;
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif // MLPACK_CORE_TREE_BINARY_SPACE_TREE_ARENA_LAYOUT_IMPL_HPP
@@ -89,6 +89,11 @@ class BinarySpaceTree
   //! delete it.
   MatType* dataset;
 
+  //! During a parallel build, child nodes with fewer points than this are
+  //! split serially; spawning a task for a tiny subtree costs more than the
+  //! split itself.
+  static const size_t parallelBuildCutoff = 8192;
+
  public:
   //! A single-tree traverser for binary space trees; see
   //! single_tree_traverser.hpp for implementation.
@@ -102,6 +107,11 @@ class BinarySpaceTree
   template<typename RuleType>
   class BreadthFirstDualTreeTraverser;
 
+  //! A task-parallel dual-tree traverser which splits work over disjoint query
+  //! subtrees; see parallel_dual_tree_traverser.hpp.
+  template<typename RuleType>
+  class ParallelDualTreeTraverser;
+
   /**
    * Construct this as the root node of a binary space tree using the given
    * dataset.  This will copy the input matrix; if you don't want this, consider
@@ -564,6 +574,38 @@ class BinarySpaceTree
    */
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t version);
+
+  /**
+   * Write the tree to the given stream in a flat binary format: a header,
+   * the dataset blob, and one contiguous array per node field (offsets,
+   * counts, child indices, cached distances, and bound coordinates), with the
+   * nodes in preorder.  Loading this format with LoadFlat() is a handful of
+   * bulk reads followed by pointer fixup, which is far faster than
+   * round-tripping every node through a cereal archive.
+   *
+   * The format requires a dense matrix type and a rectangular bound type
+   * (one exposing operator[] returning a range, like HRectBound), and it is
+   * written in host byte order, so it is not portable across architectures
+   * with different endianness or element sizes.  Node statistics are not
+   * stored; they are reconstructed from the nodes on load, so statistics
+   * that hold state beyond what their constructor derives from the node will
+   * not survive the round trip.  May only be called on the root of a tree.
+   *
+   * @param stream Stream to write the flat tree to; must be opened in binary
+   *     mode.
+   */
+  void SaveFlat(std::ostream& stream) const;
+
+  /**
+   * Load a tree written by SaveFlat() from the given stream, returning a
+   * newly-allocated root node that the caller must delete.  See SaveFlat()
+   * for the restrictions of the format.
+   *
+   * @param stream Stream to read the flat tree from; must be opened in
+   *     binary mode.
+   * @return Pointer to the root of the loaded tree.
+   */
+  static BinarySpaceTree* LoadFlat(std::istream& stream);
 };
 
 } // namespace tree
@@ -15,7 +15,9 @@
 #include "binary_space_tree.hpp"
 
 #include <mlpack/core/util/log.hpp>
+#include <map>
 #include <queue>
+#include <stack>
 
 namespace mlpack {
 namespace tree {
@@ -41,8 +43,14 @@ BinarySpaceTree(
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
     dataset(new MatType(data)) // Copies the dataset.
 {
-  // Do the actual splitting of this node.
+  // Do the actual splitting of this node.  The recursive split spawns tasks
+  // for large child nodes, which the thread team created here executes; for
+  // small datasets or stateful split policies the region stays inactive and
+  // the build is serial.
   SplitType<BoundType<MetricType>, MatType> splitter;
+  #pragma omp parallel if (std::is_empty<Split>::value && \
+      count >= 2 * parallelBuildCutoff)
+  #pragma omp single
   SplitNode(maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
@@ -74,8 +82,14 @@ BinarySpaceTree(
   for (size_t i = 0; i < data.n_cols; ++i)
     oldFromNew[i] = i; // Fill with unharmed indices.
 
-  // Now do the actual splitting.
+  // Now do the actual splitting.  The recursive split spawns tasks for large
+  // child nodes, which the thread team created here executes; for small
+  // datasets or stateful split policies the region stays inactive and the
+  // build is serial.
   SplitType<BoundType<MetricType>, MatType> splitter;
+  #pragma omp parallel if (std::is_empty<Split>::value && \
+      count >= 2 * parallelBuildCutoff)
+  #pragma omp single
   SplitNode(oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
@@ -108,8 +122,14 @@ BinarySpaceTree(
   for (size_t i = 0; i < data.n_cols; ++i)
     oldFromNew[i] = i; // Fill with unharmed indices.
 
-  // Now do the actual splitting.
+  // Now do the actual splitting.  The recursive split spawns tasks for large
+  // child nodes, which the thread team created here executes; for small
+  // datasets or stateful split policies the region stays inactive and the
+  // build is serial.
   SplitType<BoundType<MetricType>, MatType> splitter;
+  #pragma omp parallel if (std::is_empty<Split>::value && \
+      count >= 2 * parallelBuildCutoff)
+  #pragma omp single
   SplitNode(oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
@@ -138,8 +158,14 @@ BinarySpaceTree(MatType&& data, const size_t maxLeafSize) :
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
     dataset(new MatType(std::move(data)))
 {
-  // Do the actual splitting of this node.
+  // Do the actual splitting of this node.  The recursive split spawns tasks
+  // for large child nodes, which the thread team created here executes; for
+  // small datasets or stateful split policies the region stays inactive and
+  // the build is serial.
   SplitType<BoundType<MetricType>, MatType> splitter;
+  #pragma omp parallel if (std::is_empty<Split>::value && \
+      count >= 2 * parallelBuildCutoff)
+  #pragma omp single
   SplitNode(maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
@@ -171,8 +197,14 @@ BinarySpaceTree(
   for (size_t i = 0; i < dataset->n_cols; ++i)
     oldFromNew[i] = i; // Fill with unharmed indices.
 
-  // Now do the actual splitting.
+  // Now do the actual splitting.  The recursive split spawns tasks for large
+  // child nodes, which the thread team created here executes; for small
+  // datasets or stateful split policies the region stays inactive and the
+  // build is serial.
   SplitType<BoundType<MetricType>, MatType> splitter;
+  #pragma omp parallel if (std::is_empty<Split>::value && \
+      count >= 2 * parallelBuildCutoff)
+  #pragma omp single
   SplitNode(oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
@@ -205,8 +237,14 @@ BinarySpaceTree(
   for (size_t i = 0; i < dataset->n_cols; ++i)
     oldFromNew[i] = i; // Fill with unharmed indices.
 
-  // Now do the actual splitting.
+  // Now do the actual splitting.  The recursive split spawns tasks for large
+  // child nodes, which the thread team created here executes; for small
+  // datasets or stateful split policies the region stays inactive and the
+  // build is serial.
   SplitType<BoundType<MetricType>, MatType> splitter;
+  #pragma omp parallel if (std::is_empty<Split>::value && \
+      count >= 2 * parallelBuildCutoff)
+  #pragma omp single
   SplitNode(oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
@@ -904,11 +942,20 @@ void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
 
   // Now that we know the split column, we will recursively split the children
   // by calling their constructors (which perform this splitting process).
+  // The children cover disjoint column ranges of the dataset, so during a
+  // parallel build they can be constructed as independent tasks.  Outside of
+  // a parallel region (or below the cutoff) the tasks execute immediately on
+  // this thread and the build proceeds exactly as the serial one.
+  #pragma omp task if (count >= 2 * parallelBuildCutoff)
   left = new BinarySpaceTree(this, begin, splitCol - begin, splitter,
       maxLeafSize);
+
+  #pragma omp task if (count >= 2 * parallelBuildCutoff)
   right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
       splitter, maxLeafSize);
 
+  #pragma omp taskwait
+
   // Calculate parent distances for those two nodes.
   arma::vec center, leftCenter, rightCenter;
   Center(center);
@@ -972,11 +1019,21 @@ SplitNode(std::vector<size_t>& oldFromNew,
 
   // Now that we know the split column, we will recursively split the children
   // by calling their constructors (which perform this splitting process).
+  // The children cover disjoint column ranges of the dataset and disjoint
+  // entries of oldFromNew, so during a parallel build they can be constructed
+  // as independent tasks.  Outside of a parallel region (or below the cutoff)
+  // the tasks execute immediately on this thread and the build proceeds
+  // exactly as the serial one.
+  #pragma omp task if (count >= 2 * parallelBuildCutoff)
   left = new BinarySpaceTree(this, begin, splitCol - begin, oldFromNew,
       splitter, maxLeafSize);
+
+  #pragma omp task if (count >= 2 * parallelBuildCutoff)
   right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
       oldFromNew, splitter, maxLeafSize);
 
+  #pragma omp taskwait
+
   // Calculate parent distances for those two nodes.
   arma::vec center, leftCenter, rightCenter;
   Center(center);
@@ -1136,6 +1193,187 @@ void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
   }
 }
 
+/**
+ * Write the tree to the given stream in the flat binary format.
+ */
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+    SaveFlat(std::ostream& stream) const
+{
+  if (parent != NULL)
+    throw std::invalid_argument("BinarySpaceTree::SaveFlat(): can only be "
+        "called on the root of the tree!");
+
+  // Collect the nodes in preorder, and assign each its index in the flat node
+  // array so that child pointers can be stored as indices.
+  std::vector<const BinarySpaceTree*> nodes;
+  std::map<const BinarySpaceTree*, uint64_t> nodeIndex;
+  std::stack<const BinarySpaceTree*> toVisit;
+  toVisit.push(this);
+  while (!toVisit.empty())
+  {
+    const BinarySpaceTree* node = toVisit.top();
+    toVisit.pop();
+    nodeIndex[node] = (uint64_t) nodes.size();
+    nodes.push_back(node);
+    if (node->right)
+      toVisit.push(node->right);
+    if (node->left)
+      toVisit.push(node->left);
+  }
+
+  const uint64_t numNodes = (uint64_t) nodes.size();
+  const uint64_t dims = (uint64_t) dataset->n_rows;
+  const uint64_t points = (uint64_t) dataset->n_cols;
+  const uint64_t elemSize = (uint64_t) sizeof(ElemType);
+
+  // Gather every node field into its own contiguous array.
+  std::vector<uint64_t> begins(numNodes), counts(numNodes);
+  std::vector<uint64_t> lefts(numNodes), rights(numNodes);
+  std::vector<ElemType> parentDistances(numNodes);
+  std::vector<ElemType> furthestDistances(numNodes);
+  std::vector<ElemType> boundLo(numNodes * dims), boundHi(numNodes * dims);
+  for (size_t i = 0; i < numNodes; ++i)
+  {
+    const BinarySpaceTree* node = nodes[i];
+    begins[i] = (uint64_t) node->begin;
+    counts[i] = (uint64_t) node->count;
+    // numNodes is the "no child" sentinel.
+    lefts[i] = node->left ? nodeIndex[node->left] : numNodes;
+    rights[i] = node->right ? nodeIndex[node->right] : numNodes;
+    parentDistances[i] = node->parentDistance;
+    furthestDistances[i] = node->furthestDescendantDistance;
+    for (size_t d = 0; d < dims; ++d)
+    {
+      boundLo[i * dims + d] = node->bound[d].Lo();
+      boundHi[i * dims + d] = node->bound[d].Hi();
+    }
+  }
+
+  // Write the header, the dataset blob, and then each field array as one
+  // bulk write.
+  const char magic[8] = { 'm', 'l', 'p', 'k', 'f', 'b', 't', '1' };
+  stream.write(magic, 8);
+  stream.write((const char*) &dims, sizeof(uint64_t));
+  stream.write((const char*) &points, sizeof(uint64_t));
+  stream.write((const char*) &numNodes, sizeof(uint64_t));
+  stream.write((const char*) &elemSize, sizeof(uint64_t));
+  stream.write((const char*) dataset->memptr(), dims * points * elemSize);
+  stream.write((const char*) begins.data(), numNodes * sizeof(uint64_t));
+  stream.write((const char*) counts.data(), numNodes * sizeof(uint64_t));
+  stream.write((const char*) lefts.data(), numNodes * sizeof(uint64_t));
+  stream.write((const char*) rights.data(), numNodes * sizeof(uint64_t));
+  stream.write((const char*) parentDistances.data(), numNodes * elemSize);
+  stream.write((const char*) furthestDistances.data(), numNodes * elemSize);
+  stream.write((const char*) boundLo.data(), numNodes * dims * elemSize);
+  stream.write((const char*) boundHi.data(), numNodes * dims * elemSize);
+
+  if (!stream)
+    throw std::runtime_error("BinarySpaceTree::SaveFlat(): write failed!");
+}
+
+/**
+ * Load a tree written by SaveFlat() from the given stream.
+ */
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>*
+BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+    LoadFlat(std::istream& stream)
+{
+  // Check the header.
+  const char magic[8] = { 'm', 'l', 'p', 'k', 'f', 'b', 't', '1' };
+  char fileMagic[8];
+  stream.read(fileMagic, 8);
+  if (!stream || std::memcmp(fileMagic, magic, 8) != 0)
+    throw std::runtime_error("BinarySpaceTree::LoadFlat(): stream does not "
+        "hold a flat tree!");
+
+  uint64_t dims, points, numNodes, elemSize;
+  stream.read((char*) &dims, sizeof(uint64_t));
+  stream.read((char*) &points, sizeof(uint64_t));
+  stream.read((char*) &numNodes, sizeof(uint64_t));
+  stream.read((char*) &elemSize, sizeof(uint64_t));
+  if (!stream || elemSize != sizeof(ElemType))
+    throw std::runtime_error("BinarySpaceTree::LoadFlat(): element type of "
+        "flat tree does not match the element type of this tree type!");
+
+  // Read the dataset blob straight into place.
+  MatType* data = new MatType(dims, points);
+  stream.read((char*) data->memptr(), dims * points * elemSize);
+
+  // Read the field arrays.
+  std::vector<uint64_t> begins(numNodes), counts(numNodes);
+  std::vector<uint64_t> lefts(numNodes), rights(numNodes);
+  std::vector<ElemType> parentDistances(numNodes);
+  std::vector<ElemType> furthestDistances(numNodes);
+  std::vector<ElemType> boundLo(numNodes * dims), boundHi(numNodes * dims);
+  stream.read((char*) begins.data(), numNodes * sizeof(uint64_t));
+  stream.read((char*) counts.data(), numNodes * sizeof(uint64_t));
+  stream.read((char*) lefts.data(), numNodes * sizeof(uint64_t));
+  stream.read((char*) rights.data(), numNodes * sizeof(uint64_t));
+  stream.read((char*) parentDistances.data(), numNodes * elemSize);
+  stream.read((char*) furthestDistances.data(), numNodes * elemSize);
+  stream.read((char*) boundLo.data(), numNodes * dims * elemSize);
+  stream.read((char*) boundHi.data(), numNodes * dims * elemSize);
+  if (!stream)
+  {
+    delete data;
+    throw std::runtime_error("BinarySpaceTree::LoadFlat(): flat tree is "
+        "truncated!");
+  }
+
+  // Allocate all nodes, then fix up the pointers between them.
+  std::vector<BinarySpaceTree*> nodes(numNodes);
+  for (size_t i = 0; i < numNodes; ++i)
+    nodes[i] = new BinarySpaceTree();
+
+  for (size_t i = 0; i < numNodes; ++i)
+  {
+    BinarySpaceTree* node = nodes[i];
+    node->begin = (size_t) begins[i];
+    node->count = (size_t) counts[i];
+    node->dataset = data;
+    node->parentDistance = parentDistances[i];
+    node->furthestDescendantDistance = furthestDistances[i];
+
+    node->bound = BoundType<MetricType>(dims);
+    for (size_t d = 0; d < dims; ++d)
+    {
+      node->bound[d] = math::RangeType<ElemType>(boundLo[i * dims + d],
+                                                 boundHi[i * dims + d]);
+    }
+    node->minimumBoundDistance = node->bound.MinWidth() / 2.0;
+
+    if (lefts[i] < numNodes)
+    {
+      node->left = nodes[lefts[i]];
+      node->left->parent = node;
+    }
+    if (rights[i] < numNodes)
+    {
+      node->right = nodes[rights[i]];
+      node->right->parent = node;
+    }
+  }
+
+  // Rebuild the statistics now that the bounds and children are in place;
+  // the flat format does not store them.
+  for (size_t i = 0; i < numNodes; ++i)
+    nodes[i]->stat = StatisticType(*nodes[i]);
+
+  return nodes[0];
+}
+
 } // namespace tree
 } // namespace mlpack
 
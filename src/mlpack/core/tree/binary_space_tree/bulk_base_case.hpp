@@ -0,0 +1,58 @@
+/**
+ * @file core/tree/binary_space_tree/bulk_base_case.hpp
+ * @author Ryan Curtin
+ *
+ * Helpers to run base cases over a contiguous range of reference points.  If
+ * the rules class provides a bulk BaseCase(queryIndex, refBegin, refCount)
+ * overload, it is used (detected via SFINAE); otherwise one base case is run
+ * per point.  Trees that rearrange their dataset hold contiguous point ranges
+ * in their leaves, so traversers for those trees can hand the whole leaf to
+ * the rules class at once.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_BULK_BASE_CASE_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_BULK_BASE_CASE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * Run the rule's bulk base case over a contiguous reference range.  This
+ * overload is selected when RuleType provides a three-argument BaseCase().
+ */
+template<typename RuleType>
+inline auto BulkBaseCase(RuleType& rule,
+                         const size_t queryIndex,
+                         const size_t refBegin,
+                         const size_t refCount,
+                         int)
+    -> decltype(rule.BaseCase(queryIndex, refBegin, refCount), void())
+{
+  rule.BaseCase(queryIndex, refBegin, refCount);
+}
+
+/**
+ * Fall back to one base case per point, for rules classes without a bulk
+ * overload.
+ */
+template<typename RuleType>
+inline void BulkBaseCase(RuleType& rule,
+                         const size_t queryIndex,
+                         const size_t refBegin,
+                         const size_t refCount,
+                         long)
+{
+  for (size_t i = 0; i < refCount; ++i)
+    rule.BaseCase(queryIndex, refBegin + i);
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -16,6 +16,10 @@
 
 // In case it hasn't been included yet.
 #include "dual_tree_traverser.hpp"
+#include "bulk_base_case.hpp"
+
+#include <mlpack/core/util/prefetch.hpp>
+#include <mlpack/core/util/profiler.hpp>
 
 namespace mlpack {
 namespace tree {
@@ -50,6 +54,8 @@ DualTreeTraverser<RuleType>::Traverse(
     BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>&
         referenceNode)
 {
+  MLPACK_PROFILE_SCOPE("binary_space_tree_dual_traversal");
+
   // Increment the visit counter.
   ++numVisited;
 
@@ -73,7 +79,6 @@ DualTreeTraverser<RuleType>::Traverse(
   {
     // Loop through each of the points in each node.
     const size_t queryEnd = queryNode.Begin() + queryNode.Count();
-    const size_t refEnd = referenceNode.Begin() + referenceNode.Count();
     for (size_t query = queryNode.Begin(); query < queryEnd; ++query)
     {
       // See if we need to investigate this point (this function should be
@@ -85,8 +90,10 @@ DualTreeTraverser<RuleType>::Traverse(
       if (childScore == DBL_MAX)
         continue; // We can't improve this particular point.
 
-      for (size_t ref = referenceNode.Begin(); ref < refEnd; ++ref)
-        rule.BaseCase(query, ref);
+      // Run the base case over the reference leaf's contiguous point range;
+      // the rule's bulk overload is used if it has one.
+      BulkBaseCase(rule, query, referenceNode.Begin(), referenceNode.Count(),
+          0);
 
       numBaseCases += referenceNode.Count();
     }
@@ -96,7 +103,12 @@ DualTreeTraverser<RuleType>::Traverse(
             !queryNode.IsLeaf() && !referenceNode.IsLeaf()))
   {
     // We have to recurse down the query node.  In this case the recursion order
-    // does not matter.
+    // does not matter.  Hint both children into cache before scoring; their
+    // bounds are reached through dependent loads the hardware prefetcher
+    // cannot predict.
+    MLPACK_PREFETCH_READ(queryNode.Left());
+    MLPACK_PREFETCH_READ(queryNode.Right());
+
     const double leftScore = rule.Score(*queryNode.Left(), referenceNode);
     ++numScores;
 
@@ -118,8 +130,11 @@ DualTreeTraverser<RuleType>::Traverse(
   else if (queryNode.IsLeaf() && (!referenceNode.IsLeaf()))
   {
     // We have to recurse down the reference node.  In this case the recursion
-    // order does matter.  Before recursing, though, we have to set the
-    // traversal information correctly.
+    // order does matter.  Hint both children into cache, then set the
+    // traversal information correctly before each score.
+    MLPACK_PREFETCH_READ(referenceNode.Left());
+    MLPACK_PREFETCH_READ(referenceNode.Right());
+
     double leftScore = rule.Score(queryNode, *referenceNode.Left());
     typename RuleType::TraversalInfoType leftInfo = rule.TraversalInfo();
     rule.TraversalInfo() = traversalInfo;
@@ -195,8 +210,13 @@ DualTreeTraverser<RuleType>::Traverse(
   {
     // We have to recurse down both query and reference nodes.  Because the
     // query descent order does not matter, we will go to the left query child
-    // first.  Before recursing, we have to set the traversal information
-    // correctly.
+    // first.  Hint all four children into cache, then set the traversal
+    // information correctly before each score.
+    MLPACK_PREFETCH_READ(queryNode.Left());
+    MLPACK_PREFETCH_READ(queryNode.Right());
+    MLPACK_PREFETCH_READ(referenceNode.Left());
+    MLPACK_PREFETCH_READ(referenceNode.Right());
+
     double leftScore = rule.Score(*queryNode.Left(), *referenceNode.Left());
     typename RuleType::TraversalInfoType leftInfo = rule.TraversalInfo();
     rule.TraversalInfo() = traversalInfo;
@@ -275,7 +295,11 @@ DualTreeTraverser<RuleType>::Traverse(
     // Restore the main traversal information.
     rule.TraversalInfo() = traversalInfo;
 
-    // Now recurse down the right query node.
+    // Now recurse down the right query node.  The reference children were
+    // likely evicted during the left query recursion, so hint them again.
+    MLPACK_PREFETCH_READ(referenceNode.Left());
+    MLPACK_PREFETCH_READ(referenceNode.Right());
+
     leftScore = rule.Score(*queryNode.Right(), *referenceNode.Left());
     leftInfo = rule.TraversalInfo();
     rule.TraversalInfo() = traversalInfo;
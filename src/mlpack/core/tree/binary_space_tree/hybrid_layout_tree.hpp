@@ -0,0 +1,137 @@
+/**
+ * @file core/tree/binary_space_tree/hybrid_layout_tree.hpp
+ *
+ * Defines HybridLayoutTree, an owning wrapper which builds a BinarySpaceTree
+ * as a two-tier hybrid layout: the top levels of the tree are relocated into
+ * one contiguous cache-oblivious arena (see TreeNodeArena), and the bottom
+ * levels are replaced by wide leaf buckets of tunable width whose points the
+ * tree build reorders into contiguous column ranges of the dataset, so each
+ * bucket can be scanned linearly instead of descending further.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_HYBRID_LAYOUT_TREE_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_HYBRID_LAYOUT_TREE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "arena_layout.hpp"
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * An owning wrapper which builds a tree as a two-tier hybrid layout.  The
+ * wrapped tree is built with a wide, tunable leaf bucket width, so the last
+ * few levels of recursion---where descending the tree costs more than simply
+ * scanning the points---are replaced by contiguous buckets of points, which
+ * the BinarySpaceTree build already reorders into contiguous column ranges of
+ * the dataset.  The remaining top levels are then relocated into one
+ * contiguous TreeNodeArena, so deep traversals touch a single allocation laid
+ * out in cache-oblivious van Emde Boas order instead of scattered
+ * heap-allocated nodes.
+ *
+ * HybridLayoutTree is not itself a TreeType; it owns the relocated tree, and
+ * traversals should start from Root(), which is a node of the wrapped tree
+ * type and satisfies the TreeType policy API as usual:
+ *
+ * @code
+ * arma::mat dataset = arma::randu<arma::mat>(10, 10000);
+ * HybridKDTree<EuclideanDistance, EmptyStatistic, arma::mat> tree(dataset);
+ * // Traverse from tree.Root().
+ * @endcode
+ *
+ * @tparam TreeType Type of the tree to build and relocate.
+ */
+template<typename TreeType>
+class HybridLayoutTree
+{
+ public:
+  //! The matrix type held by the wrapped tree.
+  typedef typename TreeType::Mat MatType;
+
+  //! The default width of the leaf buckets.  This is deliberately wider than
+  //! the default leaf size of the wrapped tree, since scanning a contiguous
+  //! bucket is cheaper per point than descending further.
+  static const size_t DefaultBucketWidth = 64;
+
+  /**
+   * Construct the hybrid tree on the given dataset, copying the dataset.  The
+   * copy held by the tree is reordered so that each leaf bucket owns a
+   * contiguous range of columns.
+   *
+   * @param data Dataset to build the tree on.
+   * @param bucketWidth Maximum number of points in each leaf bucket.
+   */
+  HybridLayoutTree(const MatType& data,
+                   const size_t bucketWidth = DefaultBucketWidth);
+
+  /**
+   * Construct the hybrid tree on the given dataset, copying the dataset, and
+   * fill a mapping from the reordered point indices back to the original
+   * ones.
+   *
+   * @param data Dataset to build the tree on.
+   * @param oldFromNew Mapping from new point indices to old point indices.
+   * @param bucketWidth Maximum number of points in each leaf bucket.
+   */
+  HybridLayoutTree(const MatType& data,
+                   std::vector<size_t>& oldFromNew,
+                   const size_t bucketWidth = DefaultBucketWidth);
+
+  /**
+   * Construct the hybrid tree on the given dataset, taking ownership of the
+   * dataset.
+   *
+   * @param data Dataset to build the tree on.
+   * @param bucketWidth Maximum number of points in each leaf bucket.
+   */
+  HybridLayoutTree(MatType&& data,
+                   const size_t bucketWidth = DefaultBucketWidth);
+
+  /**
+   * Construct the hybrid tree on the given dataset, taking ownership of the
+   * dataset, and fill a mapping from the reordered point indices back to the
+   * original ones.
+   *
+   * @param data Dataset to build the tree on.
+   * @param oldFromNew Mapping from new point indices to old point indices.
+   * @param bucketWidth Maximum number of points in each leaf bucket.
+   */
+  HybridLayoutTree(MatType&& data,
+                   std::vector<size_t>& oldFromNew,
+                   const size_t bucketWidth = DefaultBucketWidth);
+
+  // The wrapper cannot be copied, since its arena uniquely owns the tree.
+  HybridLayoutTree(const HybridLayoutTree&) = delete;
+  HybridLayoutTree& operator=(const HybridLayoutTree&) = delete;
+
+  //! Get the root of the relocated tree, owned by this object.
+  TreeType* Root() const { return arena.Root(); }
+
+  //! Get the (reordered) dataset held by the tree.
+  const MatType& Dataset() const { return arena.Root()->Dataset(); }
+
+  //! Get the maximum number of points in each leaf bucket.
+  size_t BucketWidth() const { return bucketWidth; }
+
+  //! Get the number of nodes held in the arena.
+  size_t NumNodes() const { return arena.NumNodes(); }
+
+ private:
+  //! The arena holding the relocated nodes of the tree.
+  TreeNodeArena<TreeType> arena;
+  //! The maximum number of points in each leaf bucket.
+  size_t bucketWidth;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "hybrid_layout_tree_impl.hpp"
+
+#endif
@@ -0,0 +1,61 @@
+/**
+ * @file core/tree/binary_space_tree/hybrid_layout_tree_impl.hpp
+ *
+ * Implementation of the HybridLayoutTree class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_HYBRID_LAYOUT_TREE_IMPL_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_HYBRID_LAYOUT_TREE_IMPL_HPP
+
+// In case it wasn't included already for some reason.
+#include "hybrid_layout_tree.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename TreeType>
+HybridLayoutTree<TreeType>::HybridLayoutTree(const MatType& data,
+                                             const size_t bucketWidth) :
+    bucketWidth(bucketWidth)
+{
+  TreeType tree(data, bucketWidth);
+  arena.Layout(tree);
+}
+
+template<typename TreeType>
+HybridLayoutTree<TreeType>::HybridLayoutTree(const MatType& data,
+                                             std::vector<size_t>& oldFromNew,
+                                             const size_t bucketWidth) :
+    bucketWidth(bucketWidth)
+{
+  TreeType tree(data, oldFromNew, bucketWidth);
+  arena.Layout(tree);
+}
+
+template<typename TreeType>
+HybridLayoutTree<TreeType>::HybridLayoutTree(MatType&& data,
+                                             const size_t bucketWidth) :
+    bucketWidth(bucketWidth)
+{
+  TreeType tree(std::move(data), bucketWidth);
+  arena.Layout(tree);
+}
+
+template<typename TreeType>
+HybridLayoutTree<TreeType>::HybridLayoutTree(MatType&& data,
+                                             std::vector<size_t>& oldFromNew,
+                                             const size_t bucketWidth) :
+    bucketWidth(bucketWidth)
+{
+  TreeType tree(std::move(data), oldFromNew, bucketWidth);
+  arena.Layout(tree);
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
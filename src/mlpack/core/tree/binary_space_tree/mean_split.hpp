@@ -115,6 +115,64 @@ class MeanSplit
   {
     return point[splitInfo.splitDimension] < splitInfo.splitVal;
   }
+
+ private:
+  /**
+   * Compute the bounding range of each dimension over the given range of
+   * points.  This is used when the bound type does not maintain tight bounds.
+   *
+   * @param data The dataset used by the binary space tree.
+   * @param begin Index of the starting point in the dataset.
+   * @param count Number of points to consider.
+   * @param ranges Array of data.n_rows ranges to fill.
+   */
+  template<typename T = MatType>
+  static typename std::enable_if<!arma::is_SpMat<T>::value, void>::type
+  ComputeRanges(const MatType& data,
+                const size_t begin,
+                const size_t count,
+                math::Range* ranges);
+
+  /**
+   * Compute the bounding range of each dimension over the given range of
+   * points, for sparse matrices.  This makes a single pass over the nonzero
+   * entries of the columns instead of performing a binary search for every
+   * (dimension, point) pair, then widens each dimension that has any implicit
+   * zero to include zero.
+   */
+  template<typename T = MatType>
+  static typename std::enable_if<arma::is_SpMat<T>::value, void>::type
+  ComputeRanges(const MatType& data,
+                const size_t begin,
+                const size_t count,
+                math::Range* ranges);
+
+  /**
+   * Compute the mean of the given dimension over the given range of points.
+   *
+   * @param data The dataset used by the binary space tree.
+   * @param begin Index of the starting point in the dataset.
+   * @param count Number of points to consider.
+   * @param dimension Dimension to compute the mean in.
+   */
+  template<typename T = MatType>
+  static typename std::enable_if<!arma::is_SpMat<T>::value, double>::type
+  DimensionMean(const MatType& data,
+                const size_t begin,
+                const size_t count,
+                const size_t dimension);
+
+  /**
+   * Compute the mean of the given dimension over the given range of points,
+   * for sparse matrices.  Only the nonzero entries of the columns are
+   * visited; the implicit zeros contribute nothing to the sum.
+   */
+  template<typename T = MatType>
+  static typename std::enable_if<arma::is_SpMat<T>::value, double>::type
+  DimensionMean(const MatType& data,
+                const size_t begin,
+                const size_t count,
+                const size_t dimension);
 };
 
 } // namespace tree
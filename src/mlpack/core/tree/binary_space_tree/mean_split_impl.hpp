@@ -48,18 +48,7 @@ bool MeanSplit<BoundType, MatType>::SplitNode(const BoundType& bound,
   {
     // We must individually calculate bounding boxes.
     math::Range* ranges = new math::Range[data.n_rows];
-    for (size_t i = begin; i < begin + count; ++i)
-    {
-      // Expand each dimension as necessary.
-      for (size_t d = 0; d < data.n_rows; ++d)
-      {
-        const double val = data(d, i);
-        if (val < ranges[d].Lo())
-          ranges[d].Lo() = val;
-        if (val > ranges[d].Hi())
-          ranges[d].Hi() = val;
-      }
-    }
+    ComputeRanges(data, begin, count, ranges);
 
     // Now, which is the widest?
     for (size_t d = 0; d < data.n_rows; d++)
@@ -79,10 +68,8 @@ bool MeanSplit<BoundType, MatType>::SplitNode(const BoundType& bound,
     return false;
 
   // Split in the mean of that dimension.
-  splitInfo.splitVal = 0.0;
-  for (size_t i = begin; i < begin + count; ++i)
-    splitInfo.splitVal += data(splitInfo.splitDimension, i);
-  splitInfo.splitVal /= count;
+  splitInfo.splitVal = DimensionMean(data, begin, count,
+      splitInfo.splitDimension);
 
   Log::Assert(splitInfo.splitVal >= bound[splitInfo.splitDimension].Lo());
   Log::Assert(splitInfo.splitVal <= bound[splitInfo.splitDimension].Hi());
@@ -90,6 +77,104 @@ bool MeanSplit<BoundType, MatType>::SplitNode(const BoundType& bound,
   return true;
 }
 
+template<typename BoundType, typename MatType>
+template<typename T>
+typename std::enable_if<!arma::is_SpMat<T>::value, void>::type
+MeanSplit<BoundType, MatType>::ComputeRanges(const MatType& data,
+                                             const size_t begin,
+                                             const size_t count,
+                                             math::Range* ranges)
+{
+  for (size_t i = begin; i < begin + count; ++i)
+  {
+    // Expand each dimension as necessary.
+    for (size_t d = 0; d < data.n_rows; ++d)
+    {
+      const double val = data(d, i);
+      if (val < ranges[d].Lo())
+        ranges[d].Lo() = val;
+      if (val > ranges[d].Hi())
+        ranges[d].Hi() = val;
+    }
+  }
+}
+
+template<typename BoundType, typename MatType>
+template<typename T>
+typename std::enable_if<arma::is_SpMat<T>::value, void>::type
+MeanSplit<BoundType, MatType>::ComputeRanges(const MatType& data,
+                                             const size_t begin,
+                                             const size_t count,
+                                             math::Range* ranges)
+{
+  // One pass over the nonzero entries; element access on a sparse matrix is a
+  // binary search, so the dense per-element loop would be far more expensive.
+  std::vector<size_t> nonzeros(data.n_rows, 0);
+  for (size_t i = begin; i < begin + count; ++i)
+  {
+    for (typename MatType::const_col_iterator it = data.begin_col(i);
+         it != data.end_col(i); ++it)
+    {
+      const double val = (*it);
+      if (val < ranges[it.row()].Lo())
+        ranges[it.row()].Lo() = val;
+      if (val > ranges[it.row()].Hi())
+        ranges[it.row()].Hi() = val;
+      ++nonzeros[it.row()];
+    }
+  }
+
+  // Any dimension with an implicit zero must have its range widened to
+  // include zero.
+  for (size_t d = 0; d < data.n_rows; ++d)
+  {
+    if (nonzeros[d] < count)
+    {
+      if (ranges[d].Lo() > 0.0)
+        ranges[d].Lo() = 0.0;
+      if (ranges[d].Hi() < 0.0)
+        ranges[d].Hi() = 0.0;
+    }
+  }
+}
+
+template<typename BoundType, typename MatType>
+template<typename T>
+typename std::enable_if<!arma::is_SpMat<T>::value, double>::type
+MeanSplit<BoundType, MatType>::DimensionMean(const MatType& data,
+                                             const size_t begin,
+                                             const size_t count,
+                                             const size_t dimension)
+{
+  double sum = 0.0;
+  for (size_t i = begin; i < begin + count; ++i)
+    sum += data(dimension, i);
+  return sum / count;
+}
+
+template<typename BoundType, typename MatType>
+template<typename T>
+typename std::enable_if<arma::is_SpMat<T>::value, double>::type
+MeanSplit<BoundType, MatType>::DimensionMean(const MatType& data,
+                                             const size_t begin,
+                                             const size_t count,
+                                             const size_t dimension)
+{
+  // The implicit zeros contribute nothing to the sum, so only the nonzero
+  // entries of the columns need to be visited.
+  double sum = 0.0;
+  for (size_t i = begin; i < begin + count; ++i)
+  {
+    for (typename MatType::const_col_iterator it = data.begin_col(i);
+         it != data.end_col(i); ++it)
+    {
+      if (it.row() == dimension)
+        sum += (*it);
+    }
+  }
+  return sum / count;
+}
+
 } // namespace tree
 } // namespace mlpack
 
@@ -0,0 +1,112 @@
+/**
+ * @file core/tree/binary_space_tree/parallel_dual_tree_traverser.hpp
+ *
+ * Defines the ParallelDualTreeTraverser for the BinarySpaceTree tree type.
+ * This is a nested class of BinarySpaceTree which performs the same depth-first
+ * dual-tree traversal as DualTreeTraverser, but splits the work over a set of
+ * disjoint query subtrees which are processed by independent OpenMP threads.
+ *
+ * Each thread traverses with its own copy of the rules, so the rule type must
+ * be copy-constructible and must provide a Merge() method which folds the
+ * results of another rules object into this one.  Because the query subtrees
+ * handed to each thread are disjoint, no locking is needed on the hot
+ * Score()/BaseCase() path; results are merged once, after traversal.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "binary_space_tree.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+class BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
+                      SplitType>::ParallelDualTreeTraverser
+{
+ public:
+  /**
+   * Instantiate the parallel dual-tree traverser with the given rule set.
+   */
+  ParallelDualTreeTraverser(RuleType& rule);
+
+  /**
+   * Traverse the two trees.  This does not reset the number of prunes.  If
+   * OpenMP is not available (or only one thread is in use), this is equivalent
+   * to a sequential DualTreeTraverser traversal.
+   *
+   * @param queryNode The query node to be traversed.
+   * @param referenceNode The reference node to be traversed.
+   */
+  void Traverse(BinarySpaceTree& queryNode,
+                BinarySpaceTree& referenceNode);
+
+  //! Get the number of prunes.
+  size_t NumPrunes() const { return numPrunes; }
+  //! Modify the number of prunes.
+  size_t& NumPrunes() { return numPrunes; }
+
+  //! Get the number of visited combinations.
+  size_t NumVisited() const { return numVisited; }
+  //! Modify the number of visited combinations.
+  size_t& NumVisited() { return numVisited; }
+
+  //! Get the number of times a node combination was scored.
+  size_t NumScores() const { return numScores; }
+  //! Modify the number of times a node combination was scored.
+  size_t& NumScores() { return numScores; }
+
+  //! Get the number of times a base case was calculated.
+  size_t NumBaseCases() const { return numBaseCases; }
+  //! Modify the number of times a base case was calculated.
+  size_t& NumBaseCases() { return numBaseCases; }
+
+ private:
+  //! Reference to the rules with which the trees will be traversed.
+  RuleType& rule;
+
+  //! The number of prunes.
+  size_t numPrunes;
+
+  //! The number of node combinations that have been visited during traversal.
+  size_t numVisited;
+
+  //! The number of times a node combination was scored.
+  size_t numScores;
+
+  //! The number of times a base case was calculated.
+  size_t numBaseCases;
+
+  /**
+   * Descend the query tree breadth-first, collecting at least minTasks
+   * disjoint query subtrees that can be traversed independently.
+   *
+   * @param queryNode Root of the query tree to decompose.
+   * @param minTasks Minimum number of subtrees to collect (if possible).
+   * @param queryRoots Output list of disjoint query subtree roots.
+   */
+  void CollectQueryRoots(BinarySpaceTree& queryNode,
+                         const size_t minTasks,
+                         std::vector<BinarySpaceTree*>& queryRoots);
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "parallel_dual_tree_traverser_impl.hpp"
+
+#endif // MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_HPP
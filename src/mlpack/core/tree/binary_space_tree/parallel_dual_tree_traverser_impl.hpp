@@ -0,0 +1,198 @@
+/**
+ * @file core/tree/binary_space_tree/parallel_dual_tree_traverser_impl.hpp
+ *
+ * Implementation of the ParallelDualTreeTraverser for BinarySpaceTree.  The
+ * query tree is decomposed into disjoint subtrees, and each subtree is
+ * traversed against the reference tree by an independent OpenMP thread using a
+ * thread-local copy of the rules; the copies are merged after traversal.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_IMPL_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "parallel_dual_tree_traverser.hpp"
+
+#include <queue>
+
+#include <mlpack/core/util/threads.hpp>
+
+namespace mlpack {
+namespace tree {
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+ParallelDualTreeTraverser<RuleType>::ParallelDualTreeTraverser(RuleType& rule) :
+    rule(rule),
+    numPrunes(0),
+    numVisited(0),
+    numScores(0),
+    numBaseCases(0)
+{ /* Nothing to do. */ }
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+ParallelDualTreeTraverser<RuleType>::CollectQueryRoots(
+    BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>&
+        queryNode,
+    const size_t minTasks,
+    std::vector<BinarySpaceTree*>& queryRoots)
+{
+  // Breadth-first expansion of the query tree: repeatedly replace the largest
+  // expandable node with its two children until we have enough subtrees.
+  std::queue<BinarySpaceTree*> frontier;
+  frontier.push(&queryNode);
+
+  while (!frontier.empty() &&
+         (frontier.size() + queryRoots.size()) < minTasks)
+  {
+    BinarySpaceTree* node = frontier.front();
+    frontier.pop();
+
+    if (node->IsLeaf())
+    {
+      queryRoots.push_back(node);
+    }
+    else
+    {
+      frontier.push(node->Left());
+      frontier.push(node->Right());
+    }
+  }
+
+  while (!frontier.empty())
+  {
+    queryRoots.push_back(frontier.front());
+    frontier.pop();
+  }
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+ParallelDualTreeTraverser<RuleType>::Traverse(
+    BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>&
+        queryNode,
+    BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>&
+        referenceNode)
+{
+  // Threads() reports 1 inside an outer parallel region, so a traversal
+  // started from one falls back to the sequential traverser instead of
+  // oversubscribing the machine.
+  const size_t numThreads = Threads();
+
+  // Fall back to the sequential traverser if there is nothing to parallelize.
+  if (numThreads == 1 || queryNode.IsLeaf())
+  {
+    DualTreeTraverser<RuleType> traverser(rule);
+    traverser.Traverse(queryNode, referenceNode);
+    numPrunes += traverser.NumPrunes();
+    numVisited += traverser.NumVisited();
+    numScores += traverser.NumScores();
+    numBaseCases += traverser.NumBaseCases();
+    return;
+  }
+
+  ++numVisited;
+
+  // Score the root combination before decomposing the query tree, exactly as
+  // the sequential traverser would.
+  if (queryNode.Parent() == NULL && referenceNode.Parent() == NULL)
+  {
+    const double rootScore = rule.Score(queryNode, referenceNode);
+    ++numScores;
+    if (rootScore == DBL_MAX)
+    {
+      ++numPrunes;
+      return;
+    }
+  }
+
+  // Collect enough disjoint query subtrees to keep all threads busy; using
+  // more tasks than threads lets dynamic scheduling balance uneven subtrees.
+  std::vector<BinarySpaceTree*> queryRoots;
+  CollectQueryRoots(queryNode, 8 * numThreads, queryRoots);
+
+  // Score each query subtree against the reference root serially with the
+  // shared rules, saving the traversal information each task must start from.
+  std::vector<typename RuleType::TraversalInfoType> rootInfos;
+  std::vector<BinarySpaceTree*> tasks;
+  const typename RuleType::TraversalInfoType rootInfo = rule.TraversalInfo();
+  for (size_t i = 0; i < queryRoots.size(); ++i)
+  {
+    rule.TraversalInfo() = rootInfo;
+    const double score = (queryRoots[i] == &queryNode) ? 0.0 :
+        rule.Score(*queryRoots[i], referenceNode);
+    if (queryRoots[i] != &queryNode)
+      ++numScores;
+
+    if (score == DBL_MAX)
+    {
+      ++numPrunes;
+      continue;
+    }
+
+    tasks.push_back(queryRoots[i]);
+    rootInfos.push_back(rule.TraversalInfo());
+  }
+
+  // Traverse each query subtree with a thread-local copy of the rules.  The
+  // subtrees hold disjoint query point ranges, so the copies never contend.
+  #pragma omp parallel
+  {
+    RuleType threadRule(rule);
+    size_t threadPrunes = 0;
+    size_t threadVisited = 0;
+    size_t threadScores = 0;
+    size_t threadBaseCases = 0;
+
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) tasks.size(); ++i)
+    {
+      threadRule.TraversalInfo() = rootInfos[i];
+      DualTreeTraverser<RuleType> traverser(threadRule);
+      traverser.Traverse(*tasks[i], referenceNode);
+      threadPrunes += traverser.NumPrunes();
+      threadVisited += traverser.NumVisited();
+      threadScores += traverser.NumScores();
+      threadBaseCases += traverser.NumBaseCases();
+    }
+
+    // Fold each thread's candidate results and counters back into the shared
+    // rules, one thread at a time.
+    #pragma omp critical (ParallelDualTreeTraverserMerge)
+    {
+      rule.Merge(threadRule);
+      numPrunes += threadPrunes;
+      numVisited += threadVisited;
+      numScores += threadScores;
+      numBaseCases += threadBaseCases;
+    }
+  }
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif // MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_IMPL_HPP
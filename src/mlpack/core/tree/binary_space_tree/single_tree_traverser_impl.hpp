@@ -16,6 +16,7 @@
 
 // In case it hasn't been included yet.
 #include "single_tree_traverser.hpp"
+#include "bulk_base_case.hpp"
 
 #include <stack>
 
@@ -48,12 +49,12 @@ SingleTreeTraverser<RuleType>::Traverse(
     BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>&
         referenceNode)
 {
-  // If we are a leaf, run the base case as necessary.
+  // If we are a leaf, run the base case over the leaf's contiguous point
+  // range; the rule's bulk overload is used if it has one.
   if (referenceNode.IsLeaf())
   {
-    const size_t refEnd = referenceNode.Begin() + referenceNode.Count();
-    for (size_t i = referenceNode.Begin(); i < refEnd; ++i)
-      rule.BaseCase(queryIndex, i);
+    BulkBaseCase(rule, queryIndex, referenceNode.Begin(),
+        referenceNode.Count(), 0);
   }
   else
   {
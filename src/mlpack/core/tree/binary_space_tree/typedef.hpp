@@ -79,6 +79,27 @@ using MeanSplitKDTree = BinarySpaceTree<MetricType,
                                         bound::HRectBound,
                                         MeanSplit>;
 
+/**
+ * A two-tier hybrid kd-tree.  The bottom of the tree consists of wide leaf
+ * buckets whose points the build reorders into contiguous column ranges of the
+ * dataset, so the last few levels of recursion are replaced by linear (and
+ * vectorizable) scans of the buckets.  The remaining top levels are relocated
+ * into one contiguous cache-oblivious arena (see TreeNodeArena), so deep
+ * traversals touch a single allocation instead of scattered heap-allocated
+ * nodes.  The bucket width is tunable at construction and defaults to
+ * HybridLayoutTree::DefaultBucketWidth.
+ *
+ * Unlike the other typedefs in this file, HybridKDTree is an owning wrapper
+ * and does not itself satisfy the TreeType policy API; traversals should
+ * start from its Root(), which is a KDTree node and satisfies the policy API
+ * as usual.
+ *
+ * @see @ref trees, BinarySpaceTree, KDTree, HybridLayoutTree, TreeNodeArena
+ */
+template<typename MetricType, typename StatisticType, typename MatType>
+using HybridKDTree =
+    HybridLayoutTree<KDTree<MetricType, StatisticType, MatType>>;
+
 /**
  * A midpoint-split ball tree.  This tree holds its points only in the leaves,
  * similar to the KDTree and MeanSplitKDTree.  However, the bounding shape of
@@ -198,6 +219,30 @@ using VPTree = BinarySpaceTree<MetricType,
                                bound::HollowBallBound,
                                VPTreeSplit>;
 
+/**
+ * An ordered vantage point tree.  This has the same structure as the VPTree,
+ * but every split additionally orders the points of both subtrees by
+ * increasing distance to the vantage point, so each leaf holds its points
+ * sorted by distance to the vantage point of its nearest split.  Leaf scans
+ * then visit the most central points of the region first, which lets a
+ * nearest neighbor search tighten its candidate bound sooner; this comes at
+ * the cost of a somewhat more expensive build.
+ *
+ * This template typedef satisfies the TreeType policy API.
+ *
+ * @see @ref trees, BinarySpaceTree, VPTree
+ */
+template<typename BoundType,
+         typename MatType = arma::mat>
+using OrderedVPTreeSplit = VantagePointSplit<BoundType, MatType, 100, true>;
+
+template<typename MetricType, typename StatisticType, typename MatType>
+using OrderedVPTree = BinarySpaceTree<MetricType,
+                                      StatisticType,
+                                      MatType,
+                                      bound::HollowBallBound,
+                                      OrderedVPTreeSplit>;
+
 /**
  * A max-split random projection tree. When recursively splitting nodes, the
  * MaxSplitRPTree class selects a random hyperplane and splits a node by the
@@ -25,10 +25,17 @@ namespace tree /** Trees and tree-building procedures. */ {
  * median distance to the vantage point. Thus points that are closer to the
  * vantage point belong to the left subtree and points that are farther from
  * the vantage point belong to the right subtree.
+ *
+ * If SortPoints is true, the points of each subtree are additionally ordered
+ * by increasing distance to the vantage point, so every leaf holds its points
+ * sorted by distance to the vantage point of its nearest split.  Scans of
+ * such leaves visit the most central points of the region first, which
+ * tightens the candidate bound of a nearest neighbor search sooner.
  */
 template<typename BoundType,
          typename MatType = arma::mat,
-         size_t MaxNumSamples = 100>
+         size_t MaxNumSamples = 100,
+         bool SortPoints = false>
 class VantagePointSplit
 {
  public:
@@ -94,6 +101,9 @@ class VantagePointSplit
                              const size_t count,
                              const SplitInfo& splitInfo)
   {
+    if (SortPoints)
+      return SortedPerformSplit(data, begin, count, splitInfo, NULL);
+
     return split::PerformSplit<MatType, VantagePointSplit>(data, begin, count,
         splitInfo);
   }
@@ -119,6 +129,9 @@ class VantagePointSplit
                              const SplitInfo& splitInfo,
                              std::vector<size_t>& oldFromNew)
   {
+    if (SortPoints)
+      return SortedPerformSplit(data, begin, count, splitInfo, &oldFromNew);
+
     return split::PerformSplit<MatType, VantagePointSplit>(data, begin, count,
         splitInfo, oldFromNew);
   }
@@ -164,6 +177,27 @@ class VantagePointSplit
                                  const size_t count,
                                  size_t& vantagePoint,
                                  ElemType& mu);
+
+  /**
+   * Order the points of the node by increasing distance to the vantage point
+   * and return the index of the first point of the right (outer) subtree.
+   * Since every point closer to the vantage point than the median precedes
+   * every point that is not, this produces the same partition as the generic
+   * split, with both subtrees sorted by distance to the vantage point.
+   *
+   * @param data The dataset used by the binary space tree.
+   * @param begin Index of the starting point in the dataset that belongs to
+   *    this node.
+   * @param count Number of points in this node.
+   * @param splitInfo The information about the split.
+   * @param oldFromNew Vector of the old positions for each new point; may be
+   *    NULL if the positions are not tracked.
+   */
+  static size_t SortedPerformSplit(MatType& data,
+                                   const size_t begin,
+                                   const size_t count,
+                                   const SplitInfo& splitInfo,
+                                   std::vector<size_t>* oldFromNew);
 };
 
 } // namespace tree
@@ -19,8 +19,11 @@
 namespace mlpack {
 namespace tree {
 
-template<typename BoundType, typename MatType, size_t MaxNumSamples>
-bool VantagePointSplit<BoundType, MatType, MaxNumSamples>::
+template<typename BoundType,
+         typename MatType,
+         size_t MaxNumSamples,
+         bool SortPoints>
+bool VantagePointSplit<BoundType, MatType, MaxNumSamples, SortPoints>::
 SplitNode(const BoundType& bound, MatType& data, const size_t begin,
     const size_t count, SplitInfo& splitInfo)
 {
@@ -39,8 +42,11 @@ SplitNode(const BoundType& bound, MatType& data, const size_t begin,
   return true;
 }
 
-template<typename BoundType, typename MatType, size_t MaxNumSamples>
-void VantagePointSplit<BoundType, MatType, MaxNumSamples>::
+template<typename BoundType,
+         typename MatType,
+         size_t MaxNumSamples,
+         bool SortPoints>
+void VantagePointSplit<BoundType, MatType, MaxNumSamples, SortPoints>::
 SelectVantagePoint(const MetricType& metric, const MatType& data,
     const size_t begin, const size_t count, size_t& vantagePoint, ElemType& mu)
 {
@@ -82,6 +88,56 @@ SelectVantagePoint(const MetricType& metric, const MatType& data,
   assert(bestSpread > 0);
 }
 
+template<typename BoundType,
+         typename MatType,
+         size_t MaxNumSamples,
+         bool SortPoints>
+size_t VantagePointSplit<BoundType, MatType, MaxNumSamples, SortPoints>::
+SortedPerformSplit(MatType& data, const size_t begin, const size_t count,
+    const SplitInfo& splitInfo, std::vector<size_t>* oldFromNew)
+{
+  // Compute the distance from the vantage point to every point of the node.
+  arma::Col<ElemType> distances(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    distances[i] = splitInfo.metric->Evaluate(splitInfo.vantagePoint,
+        data.col(begin + i));
+  }
+
+  const arma::uvec order = arma::stable_sort_index(distances);
+
+  // Apply the ordering to the columns of the dataset (and the mapping, if one
+  // is tracked), one permutation cycle at a time.
+  std::vector<bool> done(count, false);
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (done[i])
+      continue;
+
+    size_t j = i;
+    size_t k = order[i];
+    while (k != i)
+    {
+      data.swap_cols(begin + j, begin + k);
+      if (oldFromNew)
+        std::swap((*oldFromNew)[begin + j], (*oldFromNew)[begin + k]);
+
+      done[k] = true;
+      j = k;
+      k = order[j];
+    }
+    done[i] = true;
+  }
+
+  // Points closer to the vantage point than the median belong to the left
+  // (inner) subtree, exactly as in the generic split.
+  size_t left = 0;
+  while (left < count && distances[order[left]] < splitInfo.mu)
+    left++;
+
+  return begin + left;
+}
+
 } // namespace tree
 } // namespace mlpack
 
@@ -29,6 +29,10 @@ struct BoundTraits
   //! bounds for each dimension may be looser than the range of all points held
   //! in the bound.  This defaults to false.
   static const bool HasTightBounds = false;
+
+  //! If true, then MinDistance() is computed with an explicitly vectorized
+  //! (SIMD) kernel for this bound type in this build.  This defaults to false.
+  static const bool HasVectorizedMinDistance = false;
 };
 
 } // namespace bound
@@ -279,16 +279,26 @@ class CellBound
   MetricType metric;
 
   /**
-   * Add a subrectangle to the bound.
+   * Add a number of candidate subrectangles to the bound in one batched pass
+   * over the data.  Each point is assigned to the first (and, since the
+   * subrectangles are disjoint, only) candidate subrectangle that contains
+   * it, and each non-empty subrectangle is shrunk to its points and appended
+   * to the bound.  Candidate subrectangles that contain no points are
+   * dropped.  This touches each column of the data once, instead of once per
+   * subrectangle.
    *
-   * @param loCorner The lower corner of the subrectangle that is being added.
-   * @param hiCorner The high corner of the subrectangle that is being added.
+   * @param loCorners Lower corners of the candidate subrectangles, one per
+   *    column.
+   * @param hiCorners High corners of the candidate subrectangles, one per
+   *    column.
+   * @param numCorners The number of candidate subrectangles.
    * @param data Points that are contained in the node.
    */
   template<typename MatType>
-  void AddBound(const arma::Col<ElemType>& loCorner,
-                const arma::Col<ElemType>& hiCorner,
-                const MatType& data);
+  void AddToBound(const arma::Mat<ElemType>& loCorners,
+                  const arma::Mat<ElemType>& hiCorners,
+                  const size_t numCorners,
+                  const MatType& data);
   /**
    * Initialize all subrectangles that touches the lower address. This function
    * should be called before InitLowerBound().
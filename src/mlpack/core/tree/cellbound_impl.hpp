@@ -181,46 +181,66 @@ inline void CellBound<MetricType, ElemType>::Center(
 
 template<typename MetricType, typename ElemType>
 template<typename MatType>
-void CellBound<MetricType, ElemType>::AddBound(
-    const arma::Col<ElemType>& loCorner,
-    const arma::Col<ElemType>& hiCorner,
+void CellBound<MetricType, ElemType>::AddToBound(
+    const arma::Mat<ElemType>& loCorners,
+    const arma::Mat<ElemType>& hiCorners,
+    const size_t numCorners,
     const MatType& data)
 {
-  assert(numBounds < loBound.n_cols);
   assert(loBound.n_rows == dim);
-  assert(loCorner.n_elem == dim);
-  assert(hiCorner.n_elem == dim);
+  assert(loCorners.n_rows == dim);
+  assert(hiCorners.n_rows == dim);
 
-  for (size_t k = 0; k < dim; ++k)
-  {
-    loBound(k, numBounds) = std::numeric_limits<ElemType>::max();
-    hiBound(k, numBounds) = std::numeric_limits<ElemType>::lowest();
-  }
+  if (numCorners == 0)
+    return;
+
+  // The shrunken bounds of the candidate subrectangles, initialized empty.
+  arma::Mat<ElemType> lo(dim, numCorners);
+  arma::Mat<ElemType> hi(dim, numCorners);
+  lo.fill(std::numeric_limits<ElemType>::max());
+  hi.fill(std::numeric_limits<ElemType>::lowest());
 
+  // One pass over the points.  The candidate subrectangles are disjoint, so
+  // each point lies in at most one of them, and only the first subrectangle
+  // that contains the point has to be shrunk.
   for (size_t i = 0; i < data.n_cols; ++i)
   {
-    size_t k = 0;
-    // Check if the point is contained in the hyperrectangle.
-    for (k = 0; k < dim; ++k)
-      if (data(k, i) < loCorner[k] || data(k, i) > hiCorner[k])
-        break;
+    for (size_t j = 0; j < numCorners; ++j)
+    {
+      size_t k = 0;
+      // Check if the point is contained in the hyperrectangle.
+      for (k = 0; k < dim; ++k)
+        if (data(k, i) < loCorners(k, j) || data(k, i) > hiCorners(k, j))
+          break;
 
-    if (k < dim)
-      continue; // The point is not contained in the hyperrectangle.
+      if (k < dim)
+        continue; // The point is not contained in the hyperrectangle.
 
-    // Shrink the bound.
-    for (k = 0; k < dim; ++k)
-    {
-      loBound(k, numBounds) = std::min(loBound(k, numBounds), data(k, i));
-      hiBound(k, numBounds) = std::max(hiBound(k, numBounds), data(k, i));
+      // Shrink the bound.
+      for (k = 0; k < dim; ++k)
+      {
+        lo(k, j) = std::min(lo(k, j), (ElemType) data(k, i));
+        hi(k, j) = std::max(hi(k, j), (ElemType) data(k, i));
+      }
+
+      break;
     }
   }
 
-  for (size_t k = 0; k < dim; ++k)
-    if (loBound(k, numBounds) > hiBound(k, numBounds))
-      return; // The hyperrectangle does not contain points.
+  // Append the subrectangles that contain points, in order; the empty ones
+  // are dropped.
+  for (size_t j = 0; j < numCorners; ++j)
+  {
+    if (lo(0, j) > hi(0, j))
+      continue; // The hyperrectangle does not contain points.
+
+    assert(numBounds < loBound.n_cols);
+
+    loBound.col(numBounds) = lo.col(j);
+    hiBound.col(numBounds) = hi.col(j);
 
-  numBounds++;
+    numBounds++;
+  }
 }
 
 
@@ -234,6 +254,13 @@ void CellBound<MetricType, ElemType>::InitHighBound(size_t numEqualBits,
   arma::Col<ElemType> loCorner(tmpHiAddress.n_elem);
   arma::Col<ElemType> hiCorner(tmpHiAddress.n_elem);
 
+  // The corners of the candidate subrectangles; these are gathered first, so
+  // that all of them may be shrunk to their points in one batched pass over
+  // the data.
+  arma::Mat<ElemType> loCorners(tmpHiAddress.n_elem, maxNumBounds + 1);
+  arma::Mat<ElemType> hiCorners(tmpHiAddress.n_elem, maxNumBounds + 1);
+  size_t numCandidates = 0;
+
   assert(tmpHiAddress.n_elem > 0);
 
   // We have to calculate the number of subrectangles since the maximum number
@@ -272,7 +299,9 @@ void CellBound<MetricType, ElemType>::InitHighBound(size_t numEqualBits,
       addr::AddressToPoint(loCorner, tmpLoAddress);
       addr::AddressToPoint(hiCorner, tmpHiAddress);
 
-      AddBound(loCorner, hiCorner, data);
+      loCorners.col(numCandidates) = loCorner;
+      hiCorners.col(numCandidates) = hiCorner;
+      numCandidates++;
       break;
     }
     // Nullify the bit that corresponds to this step.
@@ -285,7 +314,9 @@ void CellBound<MetricType, ElemType>::InitHighBound(size_t numEqualBits,
     addr::AddressToPoint(loCorner, tmpLoAddress);
     addr::AddressToPoint(hiCorner, tmpHiAddress);
 
-    AddBound(loCorner, hiCorner, data);
+    loCorners.col(numCandidates) = loCorner;
+    hiCorners.col(numCandidates) = hiCorner;
+    numCandidates++;
   }
 
   for ( ; pos > numEqualBits; pos--)
@@ -306,11 +337,16 @@ void CellBound<MetricType, ElemType>::InitHighBound(size_t numEqualBits,
       addr::AddressToPoint(loCorner, tmpLoAddress);
       addr::AddressToPoint(hiCorner, tmpHiAddress);
 
-      AddBound(loCorner, hiCorner, data);
+      loCorners.col(numCandidates) = loCorner;
+      hiCorners.col(numCandidates) = hiCorner;
+      numCandidates++;
     }
     // The high bound should correspond to this step.
     tmpHiAddress[row] |= ((AddressElemType) 1 << bit);
   }
+
+  // Shrink all candidate subrectangles to their points in one pass.
+  AddToBound(loCorners, hiCorners, numCandidates, data);
 }
 
 template<typename MetricType, typename ElemType>
@@ -323,6 +359,13 @@ void CellBound<MetricType, ElemType>::InitLowerBound(size_t numEqualBits,
   arma::Col<ElemType> loCorner(tmpHiAddress.n_elem);
   arma::Col<ElemType> hiCorner(tmpHiAddress.n_elem);
 
+  // The corners of the candidate subrectangles; these are gathered first, so
+  // that all of them may be shrunk to their points in one batched pass over
+  // the data.
+  arma::Mat<ElemType> loCorners(tmpHiAddress.n_elem, maxNumBounds + 1);
+  arma::Mat<ElemType> hiCorners(tmpHiAddress.n_elem, maxNumBounds + 1);
+  size_t numCandidates = 0;
+
   // We have to calculate the number of subrectangles since the maximum number
   // of hyperrectangles is restricted.
   size_t numCorners = 0;
@@ -359,7 +402,9 @@ void CellBound<MetricType, ElemType>::InitLowerBound(size_t numEqualBits,
       addr::AddressToPoint(loCorner, tmpLoAddress);
       addr::AddressToPoint(hiCorner, tmpHiAddress);
 
-      AddBound(loCorner, hiCorner, data);
+      loCorners.col(numCandidates) = loCorner;
+      hiCorners.col(numCandidates) = hiCorner;
+      numCandidates++;
       break;
     }
     // Enlarge the hyperrectangle at this step since it is contained
@@ -373,7 +418,9 @@ void CellBound<MetricType, ElemType>::InitLowerBound(size_t numEqualBits,
     addr::AddressToPoint(loCorner, tmpLoAddress);
     addr::AddressToPoint(hiCorner, tmpHiAddress);
 
-    AddBound(loCorner, hiCorner, data);
+    loCorners.col(numCandidates) = loCorner;
+    hiCorners.col(numCandidates) = hiCorner;
+    numCandidates++;
   }
 
   for ( ; pos > numEqualBits; pos--)
@@ -395,12 +442,17 @@ void CellBound<MetricType, ElemType>::InitLowerBound(size_t numEqualBits,
       addr::AddressToPoint(loCorner, tmpLoAddress);
       addr::AddressToPoint(hiCorner, tmpHiAddress);
 
-      AddBound(loCorner, hiCorner, data);
+      loCorners.col(numCandidates) = loCorner;
+      hiCorners.col(numCandidates) = hiCorner;
+      numCandidates++;
     }
 
     // The lower bound should correspond to this step.
     tmpLoAddress[row] &= ~((AddressElemType) 1 << bit);
   }
+
+  // Shrink all candidate subrectangles to their points in one pass.
+  AddToBound(loCorners, hiCorners, numCandidates, data);
 }
 
 template<typename MetricType, typename ElemType>
@@ -23,18 +23,21 @@ CosineTree::CosineTree(const arma::mat& dataset) :
     left(NULL),
     right(NULL),
     numColumns(dataset.n_cols),
-    localDataset(false)
+    localDataset(false),
+    arena(NULL)
 {
   // Initialize sizes of column indices and l2 norms.
   indices.resize(numColumns);
   l2NormsSquared.zeros(numColumns);
 
-  // Set indices and calculate squared norms of the columns.
-  for (size_t i = 0; i < numColumns; ++i)
+  // Set indices and calculate squared norms of the columns.  The columns are
+  // independent, so the pass is parallelized for wide matrices.  This cache is
+  // inherited by every descendant node, so no column norm is ever recomputed.
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) numColumns; ++i)
   {
     indices[i] = i;
-    double l2Norm = arma::norm(dataset.col(i), 2);
-    l2NormsSquared(i) = l2Norm * l2Norm;
+    l2NormsSquared(i) = arma::dot(dataset.col(i), dataset.col(i));
   }
 
   // Frobenius norm of columns in the node.
@@ -53,7 +56,8 @@ CosineTree::CosineTree(CosineTree& parentNode,
     left(NULL),
     right(NULL),
     numColumns(subIndices.size()),
-    localDataset(false)
+    localDataset(false),
+    arena(parentNode.arena)
 {
   // Initialize sizes of column indices and l2 norms.
   indices.resize(numColumns);
@@ -77,18 +81,28 @@ CosineTree::CosineTree(CosineTree& parentNode,
 
 CosineTree::CosineTree(const arma::mat& dataset,
                        const double epsilon,
-                       const double delta) :
+                       const double delta,
+                       const size_t maxBasisSize) :
     dataset(&dataset),
     delta(delta),
     left(NULL),
     right(NULL),
-    localDataset(false)
+    localDataset(false),
+    arena(NULL)
 {
   // Declare the cosine tree priority queue.
   CosineNodeQueue treeQueue;
 
+  // Every node of the tree lives only as long as this constructor, so node
+  // storage is carved out of one arena and freed in bulk instead of going
+  // through the general-purpose allocator once per split.  The arena is
+  // declared before the root so that the root (and with it every node) is
+  // destroyed before the arena releases its blocks.
+  NodeArena<CosineTree> nodeArena;
+
   // Define root node of the tree and add it to the queue.
   CosineTree root(dataset);
+  root.arena = &nodeArena;
   arma::vec tempVector = arma::zeros(dataset.n_rows);
   root.L2Error(-1.0); // We don't know what the error is.
   root.BasisVector(tempVector);
@@ -97,8 +111,11 @@ CosineTree::CosineTree(const arma::mat& dataset,
   // Initialize Monte Carlo error estimate for comparison.
   double monteCarloError = root.FrobNormSquared();
 
+  // Each iteration grows the final basis by one vector (the queue size), so a
+  // basis size budget translates directly into a bound on the queue size.
   while (treeQueue.size() > 0 &&
-         (monteCarloError > epsilon * root.FrobNormSquared()))
+         (monteCarloError > epsilon * root.FrobNormSquared()) &&
+         (maxBasisSize == 0 || treeQueue.size() < maxBasisSize))
   {
     // Pop node from queue with highest projection error.
     CosineTree* currentNode;
@@ -169,7 +186,8 @@ CosineTree::CosineTree(const CosineTree& other) :
     numColumns(other.NumColumns()),
     l2Error(other.L2Error()),
     frobNormSquared(other.FrobNormSquared()),
-    localDataset(other.parent == NULL)
+    localDataset(other.parent == NULL),
+    arena(NULL)
 {
   // Create left and right children (if any).
   if (other.Left())
@@ -236,6 +254,7 @@ CosineTree& CosineTree::operator=(const CosineTree& other)
   l2Error = other.L2Error();
   localDataset = (other.parent == NULL) ? true : false;
   frobNormSquared = other.FrobNormSquared();
+  arena = NULL; // Copies allocate their children individually.
 
   // Create left and right children (if any).
   if (other.Left())
@@ -289,7 +308,8 @@ CosineTree::CosineTree(CosineTree&& other) :
     numColumns(other.numColumns),
     l2Error(other.l2Error),
     frobNormSquared(other.frobNormSquared),
-    localDataset(other.localDataset)
+    localDataset(other.localDataset),
+    arena(other.arena)
 {
   // Now we are a clone of the other tree.  But we must also clear the other
   // tree's contents, so it doesn't delete anything when it is destructed.
@@ -302,6 +322,7 @@ CosineTree::CosineTree(CosineTree&& other) :
   other.l2Error = -1;
   other.localDataset = false;
   other.frobNormSquared = 0;
+  other.arena = NULL;
   // Set new parent.
   if (left)
     left->parent = this;
@@ -336,6 +357,7 @@ CosineTree& CosineTree::operator=(CosineTree&& other)
   l2Error = other.L2Error();
   localDataset = other.localDataset;
   frobNormSquared = other.FrobNormSquared();
+  arena = other.arena;
 
   // Now we are a clone of the other tree.  But we must also clear the other
   // tree's contents, so it doesn't delete anything when it is destructed.
@@ -348,6 +370,7 @@ CosineTree& CosineTree::operator=(CosineTree&& other)
   other.l2Error = -1;
   other.localDataset = false;
   other.frobNormSquared = 0;
+  other.arena = NULL;
   // Set new parent.
   if (left)
     left->parent = this;
@@ -361,10 +384,33 @@ CosineTree::~CosineTree()
 {
   if (localDataset)
     delete dataset;
+
+  // Children allocated from an arena are destroyed explicitly and their slots
+  // handed back; the arena frees the underlying blocks in bulk.
   if (left)
-    delete left;
+  {
+    if (arena)
+    {
+      left->~CosineTree();
+      arena->Deallocate(left);
+    }
+    else
+    {
+      delete left;
+    }
+  }
   if (right)
-    delete right;
+  {
+    if (arena)
+    {
+      right->~CosineTree();
+      arena->Deallocate(right);
+    }
+    else
+    {
+      delete right;
+    }
+  }
 }
 
 void CosineTree::ModifiedGramSchmidt(CosineNodeQueue& treeQueue,
@@ -536,9 +582,18 @@ void CosineTree::CosineNodeSplit()
       rightIndices.push_back(i);
   }
 
-  // Split the node into left and right children.
-  left = new CosineTree(*this, leftIndices);
-  right = new CosineTree(*this, rightIndices);
+  // Split the node into left and right children.  If this node belongs to an
+  // arena, the children take their storage from it.
+  if (arena)
+  {
+    left = new (arena->Allocate()) CosineTree(*this, leftIndices);
+    right = new (arena->Allocate()) CosineTree(*this, rightIndices);
+  }
+  else
+  {
+    left = new CosineTree(*this, leftIndices);
+    right = new CosineTree(*this, rightIndices);
+  }
 }
 
 void CosineTree::ColumnSamplesLS(std::vector<size_t>& sampledIndices,
@@ -633,7 +688,16 @@ void CosineTree::CalculateCosines(arma::vec& cosines)
   // Initialize cosine vector as a vector of zeros.
   cosines.zeros(numColumns);
 
-  for (size_t i = 0; i < numColumns; ++i)
+  // Both norms of every cosine are already cached in 'l2NormsSquared', so
+  // each cosine costs only one dot product.  A zero-norm splitting point can
+  // only arise in a degenerate node; the cosines are left as zeros then.
+  const double splitNorm = std::sqrt(l2NormsSquared(splitPointIndex));
+  if (splitNorm == 0)
+    return;
+
+  // The columns are independent of each other.
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) numColumns; ++i)
   {
     // If norm is zero, store cosine value as zero. Else, calculate cosine value
     // between two vectors.
@@ -644,8 +708,9 @@ void CosineTree::CalculateCosines(arma::vec& cosines)
     else
     {
       cosines(i) =
-          std::abs(arma::norm_dot(dataset->col(indices[splitPointIndex]),
-                                  dataset->col(indices[i])));
+          std::abs(arma::dot(dataset->col(indices[splitPointIndex]),
+                             dataset->col(indices[i]))) /
+          (splitNorm * std::sqrt(l2NormsSquared(i)));
     }
   }
 }
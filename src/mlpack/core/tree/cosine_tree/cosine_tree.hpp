@@ -15,6 +15,8 @@
 #include <mlpack/prereqs.hpp>
 #include <boost/heap/priority_queue.hpp>
 
+#include "../node_arena.hpp"
+
 namespace mlpack {
 namespace tree {
 
@@ -58,15 +60,21 @@ class CosineTree
    * split node. The basis vector from a node is the orthonormalized centroid of
    * its columns. The splitting continues till the Monte Carlo estimate of the
    * input matrix's projection on the obtained subspace is less than a fraction
-   * of the norm of the input matrix.
+   * of the norm of the input matrix, or until the basis reaches the given
+   * maximum size.  All nodes of the tree are carved out of a single arena that
+   * lives only as long as this constructor.
    *
    * @param dataset Matrix for which the CosineTree is constructed.
    * @param epsilon Error tolerance fraction for calculated subspace.
    * @param delta Cumulative probability for Monte Carlo error lower bound.
+   * @param maxBasisSize Maximum number of basis vectors to extract; 0 means
+   *     no limit.  A budget caps the construction time at the cost of a
+   *     possibly larger subspace reconstruction error.
    */
   CosineTree(const arma::mat& dataset,
              const double epsilon,
-             const double delta);
+             const double delta,
+             const size_t maxBasisSize = 0);
 
   /**
    * Copy the given tree.  Be careful!  This may use a lot of memory.
@@ -143,7 +151,8 @@ class CosineTree
   /**
    * This function splits the cosine node into two children based on the cosines
    * of the columns contained in the node, with respect to the sampled splitting
-   * point. The function also calls the CosineTree constructor for the children.
+   * point. The function also calls the CosineTree constructor for the children;
+   * if the node belongs to an arena, the children take their storage from it.
    */
   void CosineNodeSplit();
 
@@ -182,7 +191,9 @@ class CosineTree
   /**
    * Calculate cosines of the columns present in the node, with respect to the
    * sampled splitting point. The calculated cosine values are useful for
-   * splitting the node into its children.
+   * splitting the node into its children. The column norms cached in
+   * 'l2NormsSquared' are reused, so each cosine costs one dot product, and the
+   * columns are processed in parallel when OpenMP is available.
    *
    * @param cosines Vector to store the cosine values in.
    */
@@ -272,6 +283,9 @@ class CosineTree
   double frobNormSquared;
   //! If true, we own the dataset and need to destroy it in the destructor.
   bool localDataset;
+  //! Arena the children of this node are allocated from, or NULL if the
+  //! children are allocated individually with new.  Never owned by the node.
+  NodeArena<CosineTree>* arena;
 };
 
 class CompareCosineNode
@@ -15,6 +15,7 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/math/range.hpp>
 
+#include "../node_arena.hpp"
 #include "../statistic.hpp"
 #include "first_point_is_root.hpp"
 
@@ -461,6 +462,32 @@ class CoverTree
   //! The metric used for this tree.
   MetricType* metric;
 
+  //! The arena that tree nodes are allocated from during construction.  Only
+  //! the root of a tree built from a dataset owns an arena; copies and trees
+  //! loaded from an archive do not use one.
+  NodeArena<CoverTree>* arena;
+  //! Whether or not we are responsible for deleting the arena.
+  bool ownsArena;
+  //! Whether this node's own storage came from the arena (false if it was
+  //! allocated directly on the heap).
+  bool fromArena;
+
+  /**
+   * Construct a new node in storage taken from the per-tree arena, forwarding
+   * the given arguments to the matching constructor.  Nodes created this way
+   * must be destroyed with DeallocateNode(), which returns their slot to the
+   * arena.
+   */
+  template<typename... Args>
+  CoverTree* AllocateNode(Args&&... args);
+
+  /**
+   * Destroy a node, returning its storage to the arena it was allocated from
+   * (or to the heap, if it was not arena-allocated).  Does nothing if the
+   * given node is NULL.
+   */
+  static void DeallocateNode(CoverTree* node);
+
   /**
    * Create the children for this node.
    */
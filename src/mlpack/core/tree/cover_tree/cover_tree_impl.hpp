@@ -55,6 +55,9 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CoverTree(
     localMetric(metric == NULL),
     localDataset(false),
     metric(metric),
+    arena(new NodeArena<CoverTree>()),
+    ownsArena(true),
+    fromArena(false),
     distanceComps(0)
 {
   // If we need to create a metric, do that.  We'll just do it on the heap.
@@ -111,7 +114,7 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CoverTree(
     scale = old->Scale();
 
     // Now delete it.
-    delete old;
+    DeallocateNode(old);
   }
 
   // Use the furthest descendant distance to determine the scale of the root
@@ -154,6 +157,9 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CoverTree(
     localMetric(true),
     localDataset(false),
     metric(new MetricType(metric)),
+    arena(new NodeArena<CoverTree>()),
+    ownsArena(true),
+    fromArena(false),
     distanceComps(0)
 {
   // If there is only one point or zero points in the dataset... uh, we're done.
@@ -206,7 +212,7 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CoverTree(
     scale = old->Scale();
 
     // Now delete it.
-    delete old;
+    DeallocateNode(old);
   }
 
   // Use the furthest descendant distance to determine the scale of the root
@@ -247,6 +253,9 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CoverTree(
     furthestDescendantDistance(0),
     localMetric(true),
     localDataset(true),
+    arena(new NodeArena<CoverTree>()),
+    ownsArena(true),
+    fromArena(false),
     distanceComps(0)
 {
   // We need to create a metric.  We'll just do it on the heap.
@@ -302,7 +311,7 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CoverTree(
     scale = old->Scale();
 
     // Now delete it.
-    delete old;
+    DeallocateNode(old);
   }
 
   // Use the furthest descendant distance to determine the scale of the root
@@ -345,6 +354,9 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CoverTree(
     localMetric(true),
     localDataset(true),
     metric(new MetricType(metric)),
+    arena(new NodeArena<CoverTree>()),
+    ownsArena(true),
+    fromArena(false),
     distanceComps(0)
 {
   // If there is only one point or zero points in the dataset... uh, we're done.
@@ -397,7 +409,7 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CoverTree(
     scale = old->Scale();
 
     // Now delete it.
-    delete old;
+    DeallocateNode(old);
   }
 
   // Use the furthest descendant distance to determine the scale of the root
@@ -449,6 +461,9 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CoverTree(
     localMetric(false),
     localDataset(false),
     metric(&metric),
+    arena(parent == NULL ? NULL : parent->arena),
+    ownsArena(false),
+    fromArena(false),
     distanceComps(0)
 {
   // If the size of the near set is 0, this is a leaf.
@@ -490,6 +505,9 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CoverTree(
     localMetric(metric == NULL),
     localDataset(false),
     metric(metric),
+    arena(parent == NULL ? new NodeArena<CoverTree>() : parent->arena),
+    ownsArena(parent == NULL),
+    fromArena(false),
     distanceComps(0)
 {
   // If necessary, create a local metric.
@@ -519,6 +537,9 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CoverTree(
     localMetric(other.localMetric),
     localDataset(other.parent == NULL && other.localDataset),
     metric((other.localMetric ? new MetricType() : other.metric)),
+    arena(NULL),
+    ownsArena(false),
+    fromArena(false),
     distanceComps(0)
 {
   // Copy each child by hand.
@@ -570,9 +591,15 @@ operator=(const CoverTree& other)
     delete metric;
 
   for (size_t i = 0; i < children.size(); ++i)
-    delete children[i];
+    DeallocateNode(children[i]);
   children.clear();
 
+  // With every node destroyed, the old arena can be released.
+  if (ownsArena)
+    delete arena;
+  arena = NULL;
+  ownsArena = false;
+
   dataset = ((other.parent == NULL && other.localDataset) ?
       new MatType(*other.dataset) : other.dataset);
   point = other.point;
@@ -639,6 +666,9 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CoverTree(
     localMetric(other.localMetric),
     localDataset(other.localDataset),
     metric(other.metric),
+    arena(other.arena),
+    ownsArena(other.ownsArena),
+    fromArena(false),
     distanceComps(other.distanceComps)
 {
   // Set proper parent pointer.
@@ -656,6 +686,8 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CoverTree(
   other.localMetric = false;
   other.localDataset = false;
   other.metric = NULL;
+  other.arena = NULL;
+  other.ownsArena = false;
 }
 
 // Move assignment operator: take ownership of the given tree.
@@ -680,7 +712,11 @@ operator=(CoverTree&& other)
     delete metric;
 
   for (size_t i = 0; i < children.size(); ++i)
-    delete children[i];
+    DeallocateNode(children[i]);
+
+  // With every node destroyed, the old arena can be released.
+  if (ownsArena)
+    delete arena;
 
   dataset = other.dataset;
   point = other.point;
@@ -695,6 +731,8 @@ operator=(CoverTree&& other)
   localMetric = other.localMetric;
   localDataset = other.localDataset;
   metric = other.metric;
+  arena = other.arena;
+  ownsArena = other.ownsArena;
   distanceComps = other.distanceComps;
 
   // Set proper parent pointer.
@@ -712,6 +750,8 @@ operator=(CoverTree&& other)
   other.localMetric = false;
   other.localDataset = false;
   other.metric = NULL;
+  other.arena = NULL;
+  other.ownsArena = false;
 
   return *this;
 }
@@ -744,7 +784,11 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::~CoverTree()
 {
   // Delete each child.
   for (size_t i = 0; i < children.size(); ++i)
-    delete children[i];
+    DeallocateNode(children[i]);
+
+  // With every node destroyed, the arena's blocks can be released in bulk.
+  if (ownsArena)
+    delete arena;
 
   // Delete the local metric, if necessary.
   if (localMetric)
@@ -1155,7 +1199,7 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CreateChildren(
     // Make the self child at the lowest possible level.
     // This should not modify farSetSize or usedSetSize.
     size_t tempSize = 0;
-    children.push_back(new CoverTree(*dataset, base, point, INT_MIN, this, 0,
+    children.push_back(AllocateNode(*dataset, base, point, INT_MIN, this, 0,
         indices, distances, 0, tempSize, usedSetSize, *metric));
     distanceComps += children.back()->DistanceComps();
 
@@ -1163,7 +1207,7 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CreateChildren(
     for (size_t i = 0; i < nearSetSize; ++i)
     {
       // farSetSize and usedSetSize will not be modified.
-      children.push_back(new CoverTree(*dataset, base, indices[i],
+      children.push_back(AllocateNode(*dataset, base, indices[i],
           INT_MIN, this, distances[i], indices, distances, 0, tempSize,
           usedSetSize, *metric));
       distanceComps += children.back()->DistanceComps();
@@ -1195,7 +1239,7 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CreateChildren(
   // Build the self child (recursively).
   size_t childFarSetSize = nearSetSize - childNearSetSize;
   size_t childUsedSetSize = 0;
-  children.push_back(new CoverTree(*dataset, base, point, nextScale, this, 0,
+  children.push_back(AllocateNode(*dataset, base, point, nextScale, this, 0,
       indices, distances, childNearSetSize, childFarSetSize, childUsedSetSize,
       *metric));
   // Don't double-count the self-child (so, subtract one).
@@ -1253,7 +1297,7 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CreateChildren(
     if ((nearSetSize == 1) && (farSetSize == 0))
     {
       size_t childNearSetSize = 0;
-      children.push_back(new CoverTree(*dataset, base, indices[0], nextScale,
+      children.push_back(AllocateNode(*dataset, base, indices[0], nextScale,
           this, distances[0], indices, distances, childNearSetSize, farSetSize,
           usedSetSize, *metric));
       distanceComps += children.back()->DistanceComps();
@@ -1295,7 +1339,7 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CreateChildren(
 
     // Build this child (recursively).
     childUsedSetSize = 1; // Mark self point as used.
-    children.push_back(new CoverTree(*dataset, base, indices[0], nextScale,
+    children.push_back(AllocateNode(*dataset, base, indices[0], nextScale,
         this, distances[0], childIndices, childDistances, childNearSetSize,
         childFarSetSize, childUsedSetSize, *metric));
     numDescendants += children.back()->NumDescendants();
@@ -1392,9 +1436,12 @@ void CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
                      const size_t pointSetSize)
 {
   // For each point, rebuild the distances.  The indices do not need to be
-  // modified.
+  // modified.  The evaluations are independent and the point sets encountered
+  // near the top of the tree are large, so compute them in parallel; small
+  // sets stay serial to avoid the threading overhead.
   distanceComps += pointSetSize;
-  for (size_t i = 0; i < pointSetSize; ++i)
+  #pragma omp parallel for schedule(static) if (pointSetSize >= 2048)
+  for (omp_size_t i = 0; i < (omp_size_t) pointSetSize; ++i)
   {
     distances[i] = metric->Evaluate(dataset->col(pointIndex),
         dataset->col(indices[i]));
@@ -1654,6 +1701,57 @@ size_t CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
   return (left - nearSetSize);
 }
 
+/**
+ * Construct a new node in storage taken from the per-tree arena.
+ */
+template<
+    typename MetricType,
+    typename StatisticType,
+    typename MatType,
+    typename RootPointPolicy
+>
+template<typename... Args>
+CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>*
+CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
+    AllocateNode(Args&&... args)
+{
+  // Nodes created outside of tree construction have no arena to draw from.
+  if (arena == NULL)
+    return new CoverTree(std::forward<Args>(args)...);
+
+  CoverTree* node = new (arena->Allocate())
+      CoverTree(std::forward<Args>(args)...);
+  node->fromArena = true;
+  return node;
+}
+
+/**
+ * Destroy a node, returning its storage to the arena it was allocated from.
+ */
+template<
+    typename MetricType,
+    typename StatisticType,
+    typename MatType,
+    typename RootPointPolicy
+>
+void CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
+    DeallocateNode(CoverTree* node)
+{
+  if (node == NULL)
+    return;
+
+  if (node->fromArena && node->arena != NULL)
+  {
+    NodeArena<CoverTree>* nodeArena = node->arena;
+    node->~CoverTree();
+    nodeArena->Deallocate(node);
+  }
+  else
+  {
+    delete node;
+  }
+}
+
 /**
  * Take a look at the last child (the most recently created one) and remove any
  * implicit nodes that have been created.
@@ -1686,7 +1784,7 @@ inline void CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
     old->Children().erase(old->Children().begin() + old->Children().size() - 1);
 
     // Now delete it.
-    delete old;
+    DeallocateNode(old);
   }
 }
 
@@ -1711,6 +1809,9 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CoverTree() :
     localMetric(false),
     localDataset(false),
     metric(NULL),
+    arena(NULL),
+    ownsArena(false),
+    fromArena(false),
     distanceComps(0)
 {
   // Nothing to do.
@@ -1735,7 +1836,7 @@ void CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::serialize(
   if (cereal::is_loading<Archive>())
   {
     for (size_t i = 0; i < children.size(); ++i)
-      delete children[i];
+      DeallocateNode(children[i]);
 
     if (localMetric && metric)
       delete metric;
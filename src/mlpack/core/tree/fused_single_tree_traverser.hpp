@@ -0,0 +1,72 @@
+/**
+ * @file core/tree/fused_single_tree_traverser.hpp
+ *
+ * A single-tree traverser that handles a small block of query points in one
+ * descent of the reference tree.  Each node is scored once per query still
+ * active for it, and queries whose score indicates a prune are dropped from
+ * the block before recursing, so the tree (and each reference point) is
+ * fetched once for the whole block instead of once per query.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_FUSED_SINGLE_TREE_TRAVERSER_HPP
+#define MLPACK_CORE_TREE_FUSED_SINGLE_TREE_TRAVERSER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The FusedSingleTreeTraverser traverses the reference tree once for an
+ * entire block of query points.  This pays off when the block is small
+ * (roughly 8--64 queries): the queries then share most of their descent, and
+ * fusing them amortizes node and point accesses that a per-query traversal
+ * would repeat for every query.  The results are identical to running a
+ * depth-first single-tree traversal for each query separately.
+ *
+ * Because all queries in the block share one descent order, the recursion
+ * cannot be best-first for each query individually; pruning is therefore
+ * slightly weaker than in a prioritized per-query traversal.  For large query
+ * sets, a dual-tree traversal is the better tool.
+ */
+template<typename TreeType, typename RuleType>
+class FusedSingleTreeTraverser
+{
+ public:
+  /**
+   * Instantiate the fused single tree traverser with the given rule set.
+   */
+  FusedSingleTreeTraverser(RuleType& rule);
+
+  /**
+   * Traverse the tree with the given block of query points.
+   *
+   * @param queryIndices The indices of the points in the query set which are
+   *     traversed as one block.
+   * @param referenceNode The tree node to be traversed.
+   */
+  void Traverse(const std::vector<size_t>& queryIndices,
+                TreeType& referenceNode);
+
+  //! Get the number of prunes (counted once per pruned query and node).
+  size_t NumPrunes() const { return numPrunes; }
+
+ private:
+  //! Reference to the rules with which the tree will be traversed.
+  RuleType& rule;
+
+  //! The number of nodes which have been pruned during traversal.
+  size_t numPrunes;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "fused_single_tree_traverser_impl.hpp"
+
+#endif
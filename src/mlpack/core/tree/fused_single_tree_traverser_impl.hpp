@@ -0,0 +1,62 @@
+/**
+ * @file core/tree/fused_single_tree_traverser_impl.hpp
+ *
+ * Implementation of FusedSingleTreeTraverser, a single-tree traverser that
+ * handles a small block of query points in one descent of the reference tree.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_FUSED_SINGLE_TREE_TRAVERSER_IMPL_HPP
+#define MLPACK_CORE_TREE_FUSED_SINGLE_TREE_TRAVERSER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "fused_single_tree_traverser.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename TreeType, typename RuleType>
+FusedSingleTreeTraverser<TreeType, RuleType>::FusedSingleTreeTraverser(
+    RuleType& rule) :
+    rule(rule),
+    numPrunes(0)
+{ /* Nothing to do. */ }
+
+template<typename TreeType, typename RuleType>
+void FusedSingleTreeTraverser<TreeType, RuleType>::Traverse(
+    const std::vector<size_t>& queryIndices,
+    TreeType& referenceNode)
+{
+  // Score the node once per query in the block; queries for which the node
+  // can be pruned are dropped from the block.
+  std::vector<size_t> active;
+  active.reserve(queryIndices.size());
+  for (size_t i = 0; i < queryIndices.size(); ++i)
+  {
+    if (rule.Score(queryIndices[i], referenceNode) == DBL_MAX)
+      ++numPrunes;
+    else
+      active.push_back(queryIndices[i]);
+  }
+
+  if (active.empty())
+    return;
+
+  // Run the base cases for the points held in this node against every query
+  // still active; each reference point is fetched once for the whole block.
+  for (size_t p = 0; p < referenceNode.NumPoints(); ++p)
+    for (size_t i = 0; i < active.size(); ++i)
+      rule.BaseCase(active[i], referenceNode.Point(p));
+
+  // Recurse into the children with the surviving block.
+  for (size_t c = 0; c < referenceNode.NumChildren(); ++c)
+    Traverse(active, referenceNode.Child(c));
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -18,6 +18,7 @@
 #include <mlpack/core/math/range.hpp>
 #include <mlpack/core/metrics/lmetric.hpp>
 #include "bound_traits.hpp"
+#include "hrectbound_simd.hpp"
 
 namespace mlpack {
 namespace bound {
@@ -248,6 +249,12 @@ struct BoundTraits<HRectBound<MetricType, ElemType>>
 {
   //! These bounds are always tight for each dimension.
   const static bool HasTightBounds = true;
+
+  //! Whether MinDistance() uses an explicitly vectorized kernel; this holds
+  //! for the L2 case when the build enables AVX2 or AVX-512.
+  const static bool HasVectorizedMinDistance =
+      (MetricType::Power == 2) &&
+      simd::L2MinDistanceKernel<ElemType>::Vectorized;
 };
 
 } // namespace bound
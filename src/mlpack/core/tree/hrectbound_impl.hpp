@@ -174,6 +174,21 @@ inline ElemType HRectBound<MetricType, ElemType>::MinDistance(
 
   ElemType sum = 0;
 
+  // For the L2 case, use the explicitly vectorized kernel when one exists for
+  // this element type and the point's memory is directly accessible; the
+  // kernel produces the same accumulated sum as the scalar loop below.
+  if (MetricType::Power == 2 &&
+      simd::L2MinDistanceKernel<ElemType>::Vectorized)
+  {
+    if (simd::VectorizedPointSum(bounds, point, dim, sum))
+    {
+      if (MetricType::TakeRoot)
+        return (ElemType) std::sqrt(sum) * 0.5;
+      else
+        return sum * 0.25;
+    }
+  }
+
   ElemType lower, higher;
   for (size_t d = 0; d < dim; d++)
   {
@@ -229,6 +244,20 @@ ElemType HRectBound<MetricType, ElemType>::MinDistance(const HRectBound& other)
 {
   Log::Assert(dim == other.dim);
 
+  // For the L2 case, use the explicitly vectorized kernel when one exists for
+  // this element type; it produces the same accumulated sum as the scalar
+  // loop below.
+  if (MetricType::Power == 2 &&
+      simd::L2MinDistanceKernel<ElemType>::Vectorized)
+  {
+    const ElemType vecSum = simd::L2MinDistanceKernel<ElemType>::BoundSum(
+        bounds, other.bounds, dim);
+    if (MetricType::TakeRoot)
+      return (ElemType) std::sqrt(vecSum) * 0.5;
+    else
+      return vecSum * 0.25;
+  }
+
   ElemType sum = 0;
   const math::RangeType<ElemType>* mbound = bounds;
   const math::RangeType<ElemType>* obound = other.bounds;
@@ -551,6 +580,32 @@ HRectBound<MetricType, ElemType>::operator|=(const HRectBound& other)
   return *this;
 }
 
+/**
+ * Test containment in the first Dim dimensions with the loop fully unrolled
+ * at compile time; Contains() dispatches here for tiny dimensionalities,
+ * where the loop setup rivals the comparisons themselves.
+ */
+template<size_t Dim>
+struct HRectBoundContainsUnrolled
+{
+  template<typename RangeType, typename VecType>
+  static bool Apply(const RangeType* bounds, const VecType& point)
+  {
+    return bounds[Dim - 1].Contains(point[Dim - 1]) &&
+        HRectBoundContainsUnrolled<Dim - 1>::Apply(bounds, point);
+  }
+};
+
+template<>
+struct HRectBoundContainsUnrolled<0>
+{
+  template<typename RangeType, typename VecType>
+  static bool Apply(const RangeType* /* bounds */, const VecType& /* point */)
+  {
+    return true;
+  }
+};
+
 /**
  * Determines if a point is within this bound.
  */
@@ -559,6 +614,20 @@ template<typename VecType>
 inline bool HRectBound<MetricType, ElemType>::Contains(
     const VecType& point) const
 {
+  // Geospatial workloads live at d = 2 or 3; unrolled kernels avoid the loop
+  // overhead there.
+  switch (point.n_elem)
+  {
+    case 1: return HRectBoundContainsUnrolled<1>::Apply(bounds, point);
+    case 2: return HRectBoundContainsUnrolled<2>::Apply(bounds, point);
+    case 3: return HRectBoundContainsUnrolled<3>::Apply(bounds, point);
+    case 4: return HRectBoundContainsUnrolled<4>::Apply(bounds, point);
+    case 5: return HRectBoundContainsUnrolled<5>::Apply(bounds, point);
+    case 6: return HRectBoundContainsUnrolled<6>::Apply(bounds, point);
+    case 7: return HRectBoundContainsUnrolled<7>::Apply(bounds, point);
+    case 8: return HRectBoundContainsUnrolled<8>::Apply(bounds, point);
+  }
+
   for (size_t i = 0; i < point.n_elem; ++i)
   {
     if (!bounds[i].Contains(point(i)))
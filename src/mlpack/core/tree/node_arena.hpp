@@ -0,0 +1,101 @@
+/**
+ * @file core/tree/node_arena.hpp
+ *
+ * Definition of the NodeArena class, a per-tree pool allocator for tree node
+ * storage.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_NODE_ARENA_HPP
+#define MLPACK_CORE_TREE_NODE_ARENA_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <new>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * A simple pool allocator for tree nodes.  Node slots are carved out of large
+ * blocks; destroyed nodes return their slot to a free list for reuse by later
+ * splits, and the blocks themselves are freed in bulk when the arena (and thus
+ * the tree that owns it) is destroyed.  This keeps the repeated node
+ * allocation and deallocation done by SplitNode() and CondenseTree() during
+ * dynamic insertion and deletion -- and the per-node allocations done during
+ * tree construction -- out of the general-purpose allocator.
+ *
+ * The arena hands out raw, uninitialized storage; the caller is responsible
+ * for constructing and destroying objects in the returned slots.
+ *
+ * @tparam NodeType The node type to allocate storage for.
+ */
+template<typename NodeType>
+class NodeArena
+{
+ public:
+  /**
+   * Construct an empty arena.  Blocks are only allocated on demand, so an
+   * arena that is never used (e.g. one belonging to a tree that is never
+   * modified) costs almost nothing.
+   *
+   * @param blockSize The number of node slots held by each block.
+   */
+  NodeArena(const size_t blockSize = 128) :
+      blockSize(blockSize),
+      nextSlot(0)
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * Destroy the arena, freeing every block in bulk.  Any node allocated from
+   * this arena must have been destroyed before the arena is.
+   */
+  ~NodeArena()
+  {
+    for (size_t i = 0; i < blocks.size(); ++i)
+      ::operator delete(blocks[i]);
+  }
+
+  //! Return uninitialized storage for one node.
+  void* Allocate()
+  {
+    // Prefer recycling the slot of a previously destroyed node.
+    if (!freeList.empty())
+    {
+      void* slot = freeList.back();
+      freeList.pop_back();
+      return slot;
+    }
+
+    if (blocks.empty() || nextSlot == blockSize)
+    {
+      blocks.push_back(::operator new(blockSize * sizeof(NodeType)));
+      nextSlot = 0;
+    }
+
+    return (char*) blocks.back() + (nextSlot++) * sizeof(NodeType);
+  }
+
+  //! Return the storage of a destroyed node to the arena for reuse.
+  void Deallocate(void* slot) { freeList.push_back(slot); }
+
+ private:
+  //! The number of node slots held by each block.
+  size_t blockSize;
+  //! The index of the first never-used slot in the newest block.
+  size_t nextSlot;
+  //! Every block allocated by this arena.
+  std::vector<void*> blocks;
+  //! Slots of destroyed nodes, available for reuse.
+  std::vector<void*> freeList;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -19,6 +19,23 @@
 namespace mlpack {
 namespace tree {
 
+/**
+ * Tag type to select the Morton-code-based construction algorithm when
+ * building an Octree.  Instead of recursively moving points at every level,
+ * this build quantizes each point onto a grid, interleaves the grid cells
+ * into a Morton code, sorts the points by code once, and then derives every
+ * node's point range from the sorted codes without touching the point data
+ * again.  The resulting tree has the same structure as the standard build
+ * (up to floating-point rounding at cell boundaries), but construction is a
+ * single sort plus one gather of the dataset.
+ *
+ * Because the codes hold a fixed number of bits per dimension, the tree
+ * depth is bounded by 64 / dimensionality levels; nodes at that depth become
+ * leaves even if they hold more than maxLeafSize points.  For data with more
+ * than 32 dimensions, the standard splitting build is used instead.
+ */
+struct MortonBuild { };
+
 template<typename MetricType = metric::EuclideanDistance,
          typename StatisticType = EmptyStatistic,
          typename MatType = arma::mat>
@@ -157,6 +174,67 @@ class Octree
          std::vector<size_t>& newFromOld,
          const size_t maxLeafSize = 20);
 
+  /**
+   * Construct this as the root node of an octree on the given dataset, using
+   * the Morton-code-based construction algorithm (see the MortonBuild
+   * documentation).  This copies the dataset.
+   *
+   * @param data Dataset to create tree from.  This will be copied!
+   * @param tag Tag selecting the Morton-code-based build.
+   * @param maxLeafSize Maximum number of points in a leaf node.
+   */
+  Octree(const MatType& data,
+         const MortonBuild& tag,
+         const size_t maxLeafSize = 20);
+
+  /**
+   * Construct this as the root node of an octree on the given dataset, using
+   * the Morton-code-based construction algorithm (see the MortonBuild
+   * documentation).  This copies the dataset and modifies its ordering; a
+   * mapping of the old point indices to the new point indices is filled.
+   *
+   * @param data Dataset to create tree from.  This will be copied!
+   * @param oldFromNew Vector which will be filled with the old positions for
+   *      each new point.
+   * @param tag Tag selecting the Morton-code-based build.
+   * @param maxLeafSize Maximum number of points in a leaf node.
+   */
+  Octree(const MatType& data,
+         std::vector<size_t>& oldFromNew,
+         const MortonBuild& tag,
+         const size_t maxLeafSize = 20);
+
+  /**
+   * Construct this as the root node of an octree on the given dataset, using
+   * the Morton-code-based construction algorithm (see the MortonBuild
+   * documentation).  This will take ownership of the dataset.
+   *
+   * @param data Dataset to create tree from.
+   * @param tag Tag selecting the Morton-code-based build.
+   * @param maxLeafSize Maximum number of points in a leaf node.
+   */
+  Octree(MatType&& data,
+         const MortonBuild& tag,
+         const size_t maxLeafSize = 20);
+
+  /**
+   * Construct this as the root node of an octree on the given dataset, using
+   * the Morton-code-based construction algorithm (see the MortonBuild
+   * documentation).  This will take ownership of the dataset and modifies its
+   * ordering; a mapping of the old point indices to the new point indices is
+   * filled.
+   *
+   * @param data Dataset to create tree from.
+   * @param oldFromNew Vector which will be filled with the old positions for
+   *      each new point.
+   * @param tag Tag selecting the Morton-code-based build.
+   * @param maxLeafSize Maximum number of points in a leaf node.
+   */
+  Octree(MatType&& data,
+         std::vector<size_t>& oldFromNew,
+         const MortonBuild& tag,
+         const size_t maxLeafSize = 20);
+
   /**
    * Construct this node as a child of the given parent, starting at column
    * begin and using count points.  The ordering of that subset of points in the
@@ -413,6 +491,71 @@ class Octree
   friend class cereal::access;
 
  private:
+  /**
+   * Construct this node as a child of the given parent during a Morton-code
+   * build, covering the columns [begin, begin + count).  The dataset is
+   * already in sorted Morton order, so no points are moved; children are
+   * derived from the given sorted codes.
+   *
+   * @param parent Parent of this node.
+   * @param begin Index of the first point of this node.
+   * @param count Number of points in this node.
+   * @param codes Morton codes of the whole dataset, in dataset order.
+   * @param level Depth of this node (in code digits).
+   * @param bitsPerDim Number of bits per dimension in the codes.
+   * @param center Center of the node.
+   * @param width Width of the node in each dimension.
+   * @param maxLeafSize Maximum number of points in a leaf node.
+   */
+  Octree(Octree* parent,
+         const size_t begin,
+         const size_t count,
+         const std::vector<uint64_t>& codes,
+         const size_t level,
+         const size_t bitsPerDim,
+         const arma::vec& center,
+         const double width,
+         const size_t maxLeafSize);
+
+  /**
+   * Build the tree below the root with the Morton-code-based algorithm:
+   * compute the codes in parallel, radix-sort the points by code, gather the
+   * dataset into sorted order once, and then derive all node ranges from the
+   * sorted codes.  Falls back to SplitNode() when the dimensionality is too
+   * high to fit at least one level per dimension into a 64-bit code.
+   *
+   * @param center Center of the root node.
+   * @param width Width of the root node in each dimension.
+   * @param oldFromNew If not NULL, mappings from old to new point indices
+   *      (assumed to already hold the identity mapping) are updated for the
+   *      sort.
+   * @param maxLeafSize Maximum number of points allowed in a leaf.
+   */
+  void BuildMorton(const arma::vec& center,
+                   const double width,
+                   std::vector<size_t>* oldFromNew,
+                   const size_t maxLeafSize);
+
+  /**
+   * Create the children of this node from the sorted Morton codes, without
+   * touching the point data.  All codes in [begin, begin + count) share their
+   * first `level` digits; each child's range is found by binary search on the
+   * next digit.
+   *
+   * @param codes Morton codes of the whole dataset, in dataset order.
+   * @param level Depth of this node (in code digits).
+   * @param bitsPerDim Number of bits per dimension in the codes.
+   * @param center Center of the node.
+   * @param width Width of the node in each dimension.
+   * @param maxLeafSize Maximum number of points allowed in a leaf.
+   */
+  void MortonSplitNode(const std::vector<uint64_t>& codes,
+                       const size_t level,
+                       const size_t bitsPerDim,
+                       const arma::vec& center,
+                       const double width,
+                       const size_t maxLeafSize);
+
   /**
    * Split the node, using the given center and the given maximum width of this
    * node.
@@ -14,6 +14,7 @@
 
 #include "octree.hpp"
 #include <mlpack/core/tree/perform_split.hpp>
+#include <algorithm>
 #include <stack>
 
 namespace mlpack {
@@ -271,6 +272,168 @@ Octree<MetricType, StatisticType, MatType>::Octree(
     newFromOld[oldFromNew[i]] = i;
 }
 
+//! Construct the tree with the Morton-code-based algorithm.
+template<typename MetricType, typename StatisticType, typename MatType>
+Octree<MetricType, StatisticType, MatType>::Octree(
+    const MatType& dataset,
+    const MortonBuild& /* tag */,
+    const size_t maxLeafSize) :
+    begin(0),
+    count(dataset.n_cols),
+    bound(dataset.n_rows),
+    dataset(new MatType(dataset)),
+    parent(NULL),
+    parentDistance(0.0)
+{
+  if (count > 0)
+  {
+    // Calculate empirical center of data.
+    bound |= *this->dataset;
+    arma::vec center;
+    bound.Center(center);
+
+    double maxWidth = 0.0;
+    for (size_t i = 0; i < bound.Dim(); ++i)
+      if (bound[i].Hi() - bound[i].Lo() > maxWidth)
+        maxWidth = bound[i].Hi() - bound[i].Lo();
+
+    BuildMorton(center, maxWidth, NULL, maxLeafSize);
+
+    furthestDescendantDistance = 0.5 * bound.Diameter();
+  }
+  else
+  {
+    furthestDescendantDistance = 0.0;
+  }
+
+  // Initialize the statistic.
+  stat = StatisticType(*this);
+}
+
+//! Construct the tree with the Morton-code-based algorithm.
+template<typename MetricType, typename StatisticType, typename MatType>
+Octree<MetricType, StatisticType, MatType>::Octree(
+    const MatType& dataset,
+    std::vector<size_t>& oldFromNew,
+    const MortonBuild& /* tag */,
+    const size_t maxLeafSize) :
+    begin(0),
+    count(dataset.n_cols),
+    bound(dataset.n_rows),
+    dataset(new MatType(dataset)),
+    parent(NULL),
+    parentDistance(0.0)
+{
+  oldFromNew.resize(this->dataset->n_cols);
+  for (size_t i = 0; i < this->dataset->n_cols; ++i)
+    oldFromNew[i] = i;
+
+  if (count > 0)
+  {
+    // Calculate empirical center of data.
+    bound |= *this->dataset;
+    arma::vec center;
+    bound.Center(center);
+
+    double maxWidth = 0.0;
+    for (size_t i = 0; i < bound.Dim(); ++i)
+      if (bound[i].Hi() - bound[i].Lo() > maxWidth)
+        maxWidth = bound[i].Hi() - bound[i].Lo();
+
+    BuildMorton(center, maxWidth, &oldFromNew, maxLeafSize);
+
+    furthestDescendantDistance = 0.5 * bound.Diameter();
+  }
+  else
+  {
+    furthestDescendantDistance = 0.0;
+  }
+
+  // Initialize the statistic.
+  stat = StatisticType(*this);
+}
+
+//! Construct the tree with the Morton-code-based algorithm.
+template<typename MetricType, typename StatisticType, typename MatType>
+Octree<MetricType, StatisticType, MatType>::Octree(
+    MatType&& dataset,
+    const MortonBuild& /* tag */,
+    const size_t maxLeafSize) :
+    begin(0),
+    count(dataset.n_cols),
+    bound(dataset.n_rows),
+    dataset(new MatType(std::move(dataset))),
+    parent(NULL),
+    parentDistance(0.0)
+{
+  if (count > 0)
+  {
+    // Calculate empirical center of data.
+    bound |= *this->dataset;
+    arma::vec center;
+    bound.Center(center);
+
+    double maxWidth = 0.0;
+    for (size_t i = 0; i < bound.Dim(); ++i)
+      if (bound[i].Hi() - bound[i].Lo() > maxWidth)
+        maxWidth = bound[i].Hi() - bound[i].Lo();
+
+    BuildMorton(center, maxWidth, NULL, maxLeafSize);
+
+    furthestDescendantDistance = 0.5 * bound.Diameter();
+  }
+  else
+  {
+    furthestDescendantDistance = 0.0;
+  }
+
+  // Initialize the statistic.
+  stat = StatisticType(*this);
+}
+
+//! Construct the tree with the Morton-code-based algorithm.
+template<typename MetricType, typename StatisticType, typename MatType>
+Octree<MetricType, StatisticType, MatType>::Octree(
+    MatType&& dataset,
+    std::vector<size_t>& oldFromNew,
+    const MortonBuild& /* tag */,
+    const size_t maxLeafSize) :
+    begin(0),
+    count(dataset.n_cols),
+    bound(dataset.n_rows),
+    dataset(new MatType(std::move(dataset))),
+    parent(NULL),
+    parentDistance(0.0)
+{
+  oldFromNew.resize(this->dataset->n_cols);
+  for (size_t i = 0; i < this->dataset->n_cols; ++i)
+    oldFromNew[i] = i;
+
+  if (count > 0)
+  {
+    // Calculate empirical center of data.
+    bound |= *this->dataset;
+    arma::vec center;
+    bound.Center(center);
+
+    double maxWidth = 0.0;
+    for (size_t i = 0; i < bound.Dim(); ++i)
+      if (bound[i].Hi() - bound[i].Lo() > maxWidth)
+        maxWidth = bound[i].Hi() - bound[i].Lo();
+
+    BuildMorton(center, maxWidth, &oldFromNew, maxLeafSize);
+
+    furthestDescendantDistance = 0.5 * bound.Diameter();
+  }
+  else
+  {
+    furthestDescendantDistance = 0.0;
+  }
+
+  // Initialize the statistic.
+  stat = StatisticType(*this);
+}
+
 //! Construct a child node.
 template<typename MetricType, typename StatisticType, typename MatType>
 Octree<MetricType, StatisticType, MatType>::Octree(
@@ -340,6 +503,44 @@ Octree<MetricType, StatisticType, MatType>::Octree(
   stat = StatisticType(*this);
 }
 
+//! Construct a child node during a Morton-code build.
+template<typename MetricType, typename StatisticType, typename MatType>
+Octree<MetricType, StatisticType, MatType>::Octree(
+    Octree* parent,
+    const size_t begin,
+    const size_t count,
+    const std::vector<uint64_t>& codes,
+    const size_t level,
+    const size_t bitsPerDim,
+    const arma::vec& center,
+    const double width,
+    const size_t maxLeafSize) :
+    begin(begin),
+    count(count),
+    bound(parent->dataset->n_rows),
+    dataset(parent->dataset),
+    parent(parent)
+{
+  // Calculate empirical center of data.
+  bound |= dataset->cols(begin, begin + count - 1);
+
+  // Now create any children; their ranges are derived from the sorted codes,
+  // so no points are moved.
+  MortonSplitNode(codes, level, bitsPerDim, center, width, maxLeafSize);
+
+  // Calculate the distance from the empirical center of this node to the
+  // empirical center of the parent.
+  arma::vec trueCenter, parentCenter;
+  bound.Center(trueCenter);
+  parent->Bound().Center(parentCenter);
+  parentDistance = metric.Evaluate(trueCenter, parentCenter);
+
+  furthestDescendantDistance = 0.5 * bound.Diameter();
+
+  // Initialize the statistic.
+  stat = StatisticType(*this);
+}
+
 //! Copy the given tree.
 template<typename MetricType, typename StatisticType, typename MatType>
 Octree<MetricType, StatisticType, MatType>::Octree(const Octree& other) :
@@ -973,6 +1174,157 @@ void Octree<MetricType, StatisticType, MatType>::SplitNode(
   }
 }
 
+//! Build the tree below the root with the Morton-code-based algorithm.
+template<typename MetricType, typename StatisticType, typename MatType>
+void Octree<MetricType, StatisticType, MatType>::BuildMorton(
+    const arma::vec& center,
+    const double width,
+    std::vector<size_t>* oldFromNew,
+    const size_t maxLeafSize)
+{
+  const size_t dims = dataset->n_rows;
+
+  // With more than 32 dimensions a 64-bit code cannot hold even one split per
+  // dimension, so use the standard build instead.
+  if (dims > 32)
+  {
+    if (oldFromNew != NULL)
+      SplitNode(center, width, *oldFromNew, maxLeafSize);
+    else
+      SplitNode(center, width, maxLeafSize);
+    return;
+  }
+
+  const size_t bitsPerDim = std::min<size_t>(64 / dims, 63);
+  const uint64_t maxCell = (((uint64_t) 1) << bitsPerDim) - 1;
+
+  // The lower corner of the root cube; the cube has side `width` in every
+  // dimension, matching the region that SplitNode() recursively halves.
+  const arma::vec lo = center - 0.5 * width;
+  const double scale =
+      (width > 0.0) ? std::ldexp(1.0, bitsPerDim) / width : 0.0;
+
+  // Compute the code of each point: quantize every dimension onto the cell
+  // grid, then interleave the cell bits level by level.  Within a level the
+  // last dimension is the most significant bit, so that sorting by code gives
+  // the same point order as the splitting passes of SplitNode().
+  std::vector<uint64_t> codes(count);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) count; ++i)
+  {
+    uint64_t cells[32];
+    for (size_t d = 0; d < dims; ++d)
+    {
+      const double x = ((*dataset)(d, i) - lo[d]) * scale;
+      uint64_t q = (x > 0.0) ? (uint64_t) x : 0;
+      if (q > maxCell)
+        q = maxCell;
+      cells[d] = q;
+    }
+
+    uint64_t code = 0;
+    for (size_t l = 0; l < bitsPerDim; ++l)
+      for (size_t d = dims; d-- > 0; )
+        code = (code << 1) | ((cells[d] >> (bitsPerDim - 1 - l)) & 1);
+    codes[i] = code;
+  }
+
+  // Radix-sort the point indices by code, one byte at a time.
+  std::vector<size_t> ordering(count), buffer(count);
+  for (size_t i = 0; i < count; ++i)
+    ordering[i] = i;
+  for (size_t shift = 0; shift < 8 * sizeof(uint64_t); shift += 8)
+  {
+    // bucketStarts[b + 1] first counts the occurrences of byte b; the prefix
+    // sum then turns bucketStarts[b] into the offset of bucket b.
+    size_t bucketStarts[257] = { 0 };
+    for (size_t i = 0; i < count; ++i)
+      ++bucketStarts[((codes[ordering[i]] >> shift) & 0xff) + 1];
+    for (size_t b = 1; b <= 256; ++b)
+      bucketStarts[b] += bucketStarts[b - 1];
+
+    for (size_t i = 0; i < count; ++i)
+      buffer[bucketStarts[(codes[ordering[i]] >> shift) & 0xff]++] =
+          ordering[i];
+    ordering.swap(buffer);
+  }
+
+  // Gather the dataset (and the mappings and codes) into sorted order, once.
+  const arma::uvec orderingVec = arma::conv_to<arma::uvec>::from(ordering);
+  MatType sortedDataset = dataset->cols(orderingVec);
+  *dataset = std::move(sortedDataset);
+
+  std::vector<uint64_t> sortedCodes(count);
+  for (size_t i = 0; i < count; ++i)
+    sortedCodes[i] = codes[ordering[i]];
+
+  if (oldFromNew != NULL)
+  {
+    std::vector<size_t> sortedMappings(count);
+    for (size_t i = 0; i < count; ++i)
+      sortedMappings[i] = (*oldFromNew)[ordering[i]];
+    oldFromNew->swap(sortedMappings);
+  }
+
+  // Now all node ranges can be derived from the sorted codes.
+  MortonSplitNode(sortedCodes, 0, bitsPerDim, center, width, maxLeafSize);
+}
+
+//! Create the children of this node from the sorted Morton codes.
+template<typename MetricType, typename StatisticType, typename MatType>
+void Octree<MetricType, StatisticType, MatType>::MortonSplitNode(
+    const std::vector<uint64_t>& codes,
+    const size_t level,
+    const size_t bitsPerDim,
+    const arma::vec& center,
+    const double width,
+    const size_t maxLeafSize)
+{
+  // The node is a leaf if it is small enough, or if the code resolution is
+  // exhausted (all codes in the range are then identical).
+  if (count <= maxLeafSize || level >= bitsPerDim)
+    return;
+
+  const size_t dims = dataset->n_rows;
+  const size_t shift = (bitsPerDim - 1 - level) * dims;
+  const uint64_t digitMask = (((uint64_t) 1) << dims) - 1;
+
+  arma::vec childCenter(center.n_elem);
+  const double childWidth = width / 2.0;
+
+  size_t childBegin = begin;
+  for (uint64_t i = 0; i < (((uint64_t) 1) << dims); ++i)
+  {
+    // Find the end of this child's range: the first code whose digit at this
+    // level is greater than i.  The point data is never examined.
+    const size_t childEnd = std::upper_bound(
+        codes.begin() + childBegin, codes.begin() + (begin + count), i,
+        [shift, digitMask](const uint64_t value, const uint64_t code)
+        {
+          return value < ((code >> shift) & digitMask);
+        }) - codes.begin();
+
+    // If the child has no points, don't create it.
+    if (childEnd == childBegin)
+      continue;
+
+    // Create the correct center.
+    for (size_t d = 0; d < center.n_elem; ++d)
+    {
+      // Is the dimension "right" (1) or "left" (0)?
+      if (((i >> d) & 1) == 0)
+        childCenter[d] = center[d] - childWidth;
+      else
+        childCenter[d] = center[d] + childWidth;
+    }
+
+    children.push_back(new Octree(this, childBegin, childEnd - childBegin,
+        codes, level + 1, bitsPerDim, childCenter, childWidth, maxLeafSize));
+
+    childBegin = childEnd;
+  }
+}
+
 } // namespace tree
 } // namespace mlpack
 
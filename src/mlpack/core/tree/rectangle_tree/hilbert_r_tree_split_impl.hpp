@@ -32,7 +32,7 @@ void HilbertRTreeSplit<splitOrder>::SplitLeafNode(TreeType* tree,
   if (tree->Parent() == NULL)
   {
     // We actually want to copy this way.  Pointers and everything.
-    TreeType* copy = new TreeType(*tree, false);
+    TreeType* copy = tree->AllocateNode(*tree, false);
     // Only the root node owns this variable.
     copy->AuxiliaryInfo().HilbertValue().OwnsValueToInsert() = false;
     // Only leaf nodes own this variable.
@@ -69,7 +69,7 @@ void HilbertRTreeSplit<splitOrder>::SplitLeafNode(TreeType* tree,
 
   parent->NumChildren()++;
 
-  parent->children[iNewSibling] = new TreeType(parent);
+  parent->children[iNewSibling] = parent->AllocateNode(parent);
 
   lastSibling = (iTree + splitOrder < parent->NumChildren() ?
                  iTree + splitOrder : parent->NumChildren() - 1);
@@ -96,7 +96,7 @@ SplitNonLeafNode(TreeType* tree, std::vector<bool>& relevels)
   if (tree->Parent() == NULL)
   {
     // We actually want to copy this way.  Pointers and everything.
-    TreeType* copy = new TreeType(*tree, false);
+    TreeType* copy = tree->AllocateNode(*tree, false);
     // Only the root node owns this variable.
     copy->AuxiliaryInfo().HilbertValue().OwnsValueToInsert() = false;
     copy->Parent() = tree;
@@ -132,7 +132,7 @@ SplitNonLeafNode(TreeType* tree, std::vector<bool>& relevels)
 
   parent->NumChildren()++;
 
-  parent->children[iNewSibling] = new TreeType(parent);
+  parent->children[iNewSibling] = parent->AllocateNode(parent);
 
   lastSibling = (iTree + splitOrder < parent->NumChildren() ?
                  iTree + splitOrder : parent->NumChildren() - 1);
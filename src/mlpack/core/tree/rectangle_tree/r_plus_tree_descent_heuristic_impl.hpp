@@ -78,7 +78,7 @@ size_t RPlusTreeDescentHeuristic::ChooseDescentNode(TreeType* node,
     TreeType* tree = node;
     while (depth > 1)
     {
-      TreeType* child = new TreeType(tree);
+      TreeType* child = tree->AllocateNode(tree);
 
       tree->children[tree->NumChildren()++] = child;
       tree = child;
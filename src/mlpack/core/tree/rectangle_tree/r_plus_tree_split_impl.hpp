@@ -58,7 +58,7 @@ SplitLeafNode(TreeType* tree, std::vector<bool>& relevels)
   if (tree->Parent() == NULL)
   {
     // We actually want to copy this way.  Pointers and everything.
-    TreeType* copy = new TreeType(*tree, false);
+    TreeType* copy = tree->AllocateNode(*tree, false);
     copy->Parent() = tree;
     tree->Count() = 0;
     tree->NullifyData();
@@ -87,8 +87,10 @@ SplitLeafNode(TreeType* tree, std::vector<bool>& relevels)
     return;
   }
 
-  TreeType* treeOne = new TreeType(tree->Parent(), tree->MaxNumChildren());
-  TreeType* treeTwo = new TreeType(tree->Parent(), tree->MaxNumChildren());
+  TreeType* treeOne =
+      tree->AllocateNode(tree->Parent(), tree->MaxNumChildren());
+  TreeType* treeTwo =
+      tree->AllocateNode(tree->Parent(), tree->MaxNumChildren());
   treeOne->MinLeafSize() = 0;
   treeOne->MinNumChildren() = 0;
   treeTwo->MinLeafSize() = 0;
@@ -130,7 +132,7 @@ SplitNonLeafNode(TreeType* tree, std::vector<bool>& relevels)
   if (tree->Parent() == NULL)
   {
     // We actually want to copy this way.  Pointers and everything.
-    TreeType* copy = new TreeType(*tree, false);
+    TreeType* copy = tree->AllocateNode(*tree, false);
 
     copy->Parent() = tree;
     tree->NumChildren() = 0;
@@ -157,8 +159,10 @@ SplitNonLeafNode(TreeType* tree, std::vector<bool>& relevels)
     return false;
   }
 
-  TreeType* treeOne = new TreeType(tree->Parent(), tree->MaxNumChildren());
-  TreeType* treeTwo = new TreeType(tree->Parent(), tree->MaxNumChildren());
+  TreeType* treeOne =
+      tree->AllocateNode(tree->Parent(), tree->MaxNumChildren());
+  TreeType* treeTwo =
+      tree->AllocateNode(tree->Parent(), tree->MaxNumChildren());
   treeOne->MinLeafSize() = 0;
   treeOne->MinNumChildren() = 0;
   treeTwo->MinLeafSize() = 0;
@@ -272,8 +276,8 @@ void RPlusTreeSplit<SplitPolicyType, SweepType>::SplitNonLeafNodeAlongPartition(
     else
     {
       // The child should be split (i.e. the partition divides its bound).
-      TreeType* childOne = new TreeType(treeOne);
-      TreeType* childTwo = new TreeType(treeTwo);
+      TreeType* childOne = treeOne->AllocateNode(treeOne);
+      TreeType* childTwo = treeTwo->AllocateNode(treeTwo);
       treeOne->MinLeafSize() = 0;
       treeOne->MinNumChildren() = 0;
       treeTwo->MinLeafSize() = 0;
@@ -315,7 +319,7 @@ AddFakeNodes(const TreeType* tree, TreeType* emptyTree)
   TreeType* node = emptyTree;
   for (size_t i = 0; i < numDescendantNodes; ++i)
   {
-    TreeType* child = new TreeType(node);
+    TreeType* child = node->AllocateNode(node);
     node->children[node->NumChildren()++] = child;
 
     node = child;
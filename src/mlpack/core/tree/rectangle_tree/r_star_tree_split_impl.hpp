@@ -218,8 +218,9 @@ void RStarTreeSplit::SplitLeafNode(TreeType *tree, std::vector<bool>& relevels)
    * duplication.
    */
   TreeType* par = tree->Parent();
-  TreeType* treeOne = (par) ? tree              : new TreeType(tree);
-  TreeType* treeTwo = (par) ? new TreeType(par) : new TreeType(tree);
+  TreeType* treeOne = (par) ? tree : tree->AllocateNode(tree);
+  TreeType* treeTwo =
+      (par) ? tree->AllocateNode(par) : tree->AllocateNode(tree);
 
   // Now clean the node, and we will re-use this.
   const size_t numPoints = tree->Count();
@@ -420,8 +421,9 @@ bool RStarTreeSplit::SplitNonLeafNode(
    * duplication.
    */
   TreeType* par = tree->Parent();
-  TreeType* treeOne = par ? tree              : new TreeType(tree);
-  TreeType* treeTwo = par ? new TreeType(par) : new TreeType(tree);
+  TreeType* treeOne = par ? tree : tree->AllocateNode(tree);
+  TreeType* treeTwo =
+      par ? tree->AllocateNode(par) : tree->AllocateNode(tree);
 
   // Now clean the node.
   tree->numChildren = 0;
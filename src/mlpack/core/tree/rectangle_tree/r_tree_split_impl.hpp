@@ -36,7 +36,7 @@ void RTreeSplit::SplitLeafNode(TreeType *tree, std::vector<bool>& relevels)
   if (tree->Parent() == NULL)
   {
     // We actually want to copy this way.  Pointers and everything.
-    TreeType* copy = new TreeType(*tree, false);
+    TreeType* copy = tree->AllocateNode(*tree, false);
     copy->Parent() = tree;
     tree->Count() = 0;
     tree->NullifyData();
@@ -55,8 +55,8 @@ void RTreeSplit::SplitLeafNode(TreeType *tree, std::vector<bool>& relevels)
   int j = 0;
   RTreeSplit::GetPointSeeds(tree, i, j);
 
-  TreeType* treeOne = new TreeType(tree->Parent());
-  TreeType* treeTwo = new TreeType(tree->Parent());
+  TreeType* treeOne = tree->AllocateNode(tree->Parent());
+  TreeType* treeTwo = tree->AllocateNode(tree->Parent());
 
   // This will assign the ith and jth point appropriately.
   AssignPointDestNode(tree, treeOne, treeTwo, i, j);
@@ -100,7 +100,7 @@ bool RTreeSplit::SplitNonLeafNode(TreeType *tree, std::vector<bool>& relevels)
   if (tree->Parent() == NULL)
   {
     // We actually want to copy this way.  Pointers and everything.
-    TreeType* copy = new TreeType(*tree, false);
+    TreeType* copy = tree->AllocateNode(*tree, false);
     copy->Parent() = tree;
     tree->NumChildren() = 0;
     tree->NullifyData();
@@ -115,8 +115,8 @@ bool RTreeSplit::SplitNonLeafNode(TreeType *tree, std::vector<bool>& relevels)
 
   assert(i != j);
 
-  TreeType* treeOne = new TreeType(tree->Parent());
-  TreeType* treeTwo = new TreeType(tree->Parent());
+  TreeType* treeOne = tree->AllocateNode(tree->Parent());
+  TreeType* treeTwo = tree->AllocateNode(tree->Parent());
 
   // This will assign the ith and jth rectangles appropriately.
   AssignNodeDestNode(tree, treeOne, treeTwo, i, j);
@@ -17,6 +17,7 @@
 
 #include "../hrectbound.hpp"
 #include "../statistic.hpp"
+#include <mlpack/core/tree/node_arena.hpp>
 #include "r_tree_split.hpp"
 #include "r_tree_descent_heuristic.hpp"
 #include "no_auxiliary_information.hpp"
@@ -104,6 +105,15 @@ class RectangleTree
   std::vector<size_t> points;
   //! A tree-specific information
   AuxiliaryInformationType<RectangleTree> auxiliaryInfo;
+  //! The arena that tree nodes are allocated from during splitting.  It is
+  //! owned by the node that created it (generally the root) and shared by all
+  //! of its descendants.
+  NodeArena<RectangleTree>* arena;
+  //! Whether or not we are responsible for deleting the arena.
+  bool ownsArena;
+  //! Whether this node's own storage came from the arena (false if it was
+  //! allocated with operator new or is not heap-allocated at all).
+  bool fromArena;
 
  public:
   //! A single traverser for rectangle type trees.  See
@@ -156,6 +166,64 @@ class RectangleTree
                 const size_t minNumChildren = 2,
                 const size_t firstDataIndex = 0);
 
+  /**
+   * Construct this as the root node of a rectangle type tree using the given
+   * dataset and the Sort-Tile-Recursive (STR) bulk loader instead of repeated
+   * insertion.  The points are tiled into spatially compact, nearly full
+   * leaves and the upper levels are packed bottom-up, which is much faster
+   * than one-at-a-time insertion and produces a tree with near-100% node
+   * occupancy (and therefore smaller query fanout).  Note that a bulk-loaded
+   * tree may leave the last child of a node below the minimum fill; this is
+   * harmless for queries and is repaired by later insertions and deletions.
+   *
+   * This constructor should not be used with tree variants whose auxiliary
+   * information maintains incremental per-node state (e.g. the Hilbert
+   * R tree), since the bulk loader builds nodes directly rather than through
+   * InsertPoint().
+   *
+   * @param data Dataset from which to create the tree.  This will be modified!
+   * @param bulkLoad Unused flag to select this constructor; pass true.
+   * @param maxLeafSize Maximum size of each leaf in the tree.
+   * @param minLeafSize Minimum size of each leaf in the tree.
+   * @param maxNumChildren The maximum number of child nodes a non-leaf node may
+   *      have.
+   * @param minNumChildren The minimum number of child nodes a non-leaf node may
+   *      have.
+   * @param firstDataIndex The index of the first data point.  UNUSED UNLESS WE
+   *      ADD SUPPORT FOR HAVING A "CENTERAL" DATA MATRIX.
+   */
+  RectangleTree(const MatType& data,
+                const bool bulkLoad,
+                const size_t maxLeafSize = 20,
+                const size_t minLeafSize = 8,
+                const size_t maxNumChildren = 5,
+                const size_t minNumChildren = 2,
+                const size_t firstDataIndex = 0);
+
+  /**
+   * Construct this as the root node of a rectangle type tree using the given
+   * dataset and the Sort-Tile-Recursive (STR) bulk loader, taking ownership of
+   * the given dataset.  See the copying STR constructor for details.
+   *
+   * @param data Dataset from which to create the tree.
+   * @param bulkLoad Unused flag to select this constructor; pass true.
+   * @param maxLeafSize Maximum size of each leaf in the tree.
+   * @param minLeafSize Minimum size of each leaf in the tree.
+   * @param maxNumChildren The maximum number of child nodes a non-leaf node may
+   *      have.
+   * @param minNumChildren The minimum number of child nodes a non-leaf node may
+   *      have.
+   * @param firstDataIndex The index of the first data point.  UNUSED UNLESS WE
+   *      ADD SUPPORT FOR HAVING A "CENTERAL" DATA MATRIX.
+   */
+  RectangleTree(MatType&& data,
+                const bool bulkLoad,
+                const size_t maxLeafSize = 20,
+                const size_t minLeafSize = 8,
+                const size_t maxNumChildren = 5,
+                const size_t minNumChildren = 2,
+                const size_t firstDataIndex = 0);
+
   /**
    * Construct this as an empty node with the specified parent.  Copying the
    * parameters (maxLeafSize, minLeafSize, maxNumChildren, minNumChildren,
@@ -228,6 +296,22 @@ class RectangleTree
    */
   void NullifyData();
 
+  /**
+   * Construct a new node of this tree in storage taken from the per-tree
+   * arena, forwarding the given arguments to the matching constructor.  Nodes
+   * created this way must be destroyed with DeallocateNode(), which returns
+   * their slot to the arena for reuse by later splits.
+   */
+  template<typename... Args>
+  RectangleTree* AllocateNode(Args&&... args);
+
+  /**
+   * Destroy a node, returning its storage to the arena it was allocated from
+   * (or to the heap, if it was not arena-allocated).  Does nothing if the
+   * given node is NULL.
+   */
+  static void DeallocateNode(RectangleTree* node);
+
   /**
    * Inserts a point into the tree.
    *
@@ -279,6 +363,20 @@ class RectangleTree
    */
   bool DeletePoint(const size_t point, std::vector<bool>& relevels);
 
+  /**
+   * Deletes all of the given points (indices into the dataset) from the tree
+   * at once.  Instead of condensing the tree after every removal, the
+   * surviving points are gathered and the tree is rebuilt with the STR bulk
+   * loader, which amortizes the cost of large deletions and restores
+   * near-full node occupancy.  As with DeletePoint(), the points are kept in
+   * the central dataset.  This must be called on the root node, and it should
+   * not be used with tree variants whose auxiliary information maintains
+   * incremental per-node state (e.g. the Hilbert R tree).
+   *
+   * @param pointsToDelete The indices of the points to remove.
+   */
+  void DeletePoints(const std::vector<size_t>& pointsToDelete);
+
   /**
    * Removes a node from the tree.  You are responsible for deleting it if you
    * wish to do so.
@@ -564,6 +662,50 @@ class RectangleTree
    */
   void BuildStatistics(RectangleTree* node);
 
+  /**
+   * Build this (empty root) node's subtree over the given point indices with
+   * the Sort-Tile-Recursive bulk loader.  Called by the bulk-loading
+   * constructors and by DeletePoints().
+   *
+   * @param indices The indices of the points to build the tree over.  The
+   *      ordering of this vector will be modified!
+   */
+  void BulkLoad(std::vector<size_t>& indices);
+
+  /**
+   * Recursively fill the given empty node with the given range of point
+   * indices, packing children as full as possible.
+   *
+   * @param node The empty node to fill.
+   * @param indices The point indices being bulk loaded.
+   * @param begin The first index in the range belonging to this node.
+   * @param count The number of indices in the range belonging to this node.
+   * @param height The height the subtree rooted here must have (0 for a leaf).
+   */
+  void BuildSTRSubtree(RectangleTree* node,
+                       std::vector<size_t>& indices,
+                       const size_t begin,
+                       const size_t count,
+                       const size_t height);
+
+  /**
+   * Reorder the given range of point indices so that contiguous chunks of
+   * ceil(count / numParts) indices form spatially compact tiles: the range is
+   * sorted along the given dimension, cut into slabs, and each slab is tiled
+   * recursively along the next dimension.
+   *
+   * @param indices The point indices being bulk loaded.
+   * @param begin The first index of the range to tile.
+   * @param count The number of indices in the range to tile.
+   * @param numParts The number of tiles to cut the range into.
+   * @param dim The dimension to sort along at this level of the recursion.
+   */
+  void SortTileRecursive(std::vector<size_t>& indices,
+                         const size_t begin,
+                         const size_t count,
+                         const size_t numParts,
+                         const size_t dim);
+
  protected:
   /**
    * A default constructor.  This is meant to only be used with
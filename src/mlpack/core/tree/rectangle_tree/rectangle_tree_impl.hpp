@@ -39,6 +39,139 @@ BuildStatistics(RectangleTree* node)
   node->Stat() = StatisticType(*node);
 }
 
+// Bulk load the given points into this (empty root) node.
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+BulkLoad(std::vector<size_t>& indices)
+{
+  if (indices.empty())
+    return;
+
+  // Find the smallest height at which a fully packed tree holds every point.
+  size_t height = 0;
+  size_t capacity = maxLeafSize;
+  while (capacity < indices.size())
+  {
+    capacity *= maxNumChildren;
+    ++height;
+  }
+
+  BuildSTRSubtree(this, indices, 0, indices.size(), height);
+}
+
+// Recursively pack a range of points into an empty node.
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+BuildSTRSubtree(RectangleTree* node,
+                std::vector<size_t>& indices,
+                const size_t begin,
+                const size_t count,
+                const size_t height)
+{
+  node->numDescendants = count;
+
+  if (height == 0)
+  {
+    // This node is a leaf; store the points directly.
+    node->count = count;
+    for (size_t i = 0; i < count; ++i)
+    {
+      node->points[i] = indices[begin + i];
+      node->bound |= dataset->col(indices[begin + i]);
+    }
+    return;
+  }
+
+  // The number of points a fully packed child subtree can hold.
+  size_t childCapacity = maxLeafSize;
+  for (size_t i = 1; i < height; ++i)
+    childCapacity *= maxNumChildren;
+
+  // Cut the range into as few (and thus as full) tiles as possible; this
+  // cannot exceed maxNumChildren, since count fits in a subtree of the given
+  // height.
+  const size_t numTiles = (count + childCapacity - 1) / childCapacity;
+  const size_t tileSize = (count + numTiles - 1) / numTiles;
+
+  // Reorder the range so that contiguous chunks of tileSize points form
+  // spatially compact tiles.
+  SortTileRecursive(indices, begin, count, numTiles, 0);
+
+  for (size_t i = 0; i < numTiles; ++i)
+  {
+    const size_t tileBegin = begin + i * tileSize;
+    const size_t tileCount = std::min(tileSize, count - i * tileSize);
+
+    RectangleTree* child = AllocateNode(node);
+    node->children[node->numChildren++] = child;
+    BuildSTRSubtree(child, indices, tileBegin, tileCount, height - 1);
+    node->bound |= child->bound;
+  }
+}
+
+// Order a range of points so that contiguous chunks form spatial tiles.
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+SortTileRecursive(std::vector<size_t>& indices,
+                  const size_t begin,
+                  const size_t count,
+                  const size_t numParts,
+                  const size_t dim)
+{
+  if (numParts <= 1 || count <= 1)
+    return;
+
+  // Sort the range along the current dimension.
+  const MatType& data = *dataset;
+  std::sort(indices.begin() + begin, indices.begin() + begin + count,
+      [&data, dim](const size_t a, const size_t b)
+      { return data(dim, a) < data(dim, b); });
+
+  // In the last dimension the sorted order is final: contiguous chunks of
+  // ceil(count / numParts) points are the tiles themselves.
+  if (dim + 1 == data.n_rows)
+    return;
+
+  // Cut the range into roughly numParts^(1 / d) slabs along this dimension
+  // (d being the number of dimensions left to tile in), then tile each slab
+  // along the next dimension.  Slab sizes are multiples of the tile size, so
+  // tiles never straddle slab boundaries.
+  const size_t remainingDims = data.n_rows - dim;
+  const size_t slabs = (size_t) std::ceil(std::pow((double) numParts,
+      1.0 / remainingDims));
+  const size_t partsPerSlab = (numParts + slabs - 1) / slabs;
+  const size_t partSize = (count + numParts - 1) / numParts;
+  const size_t pointsPerSlab = partsPerSlab * partSize;
+
+  for (size_t i = 0; i * pointsPerSlab < count; ++i)
+  {
+    const size_t slabCount = std::min(pointsPerSlab,
+        count - i * pointsPerSlab);
+    const size_t slabParts = std::min(partsPerSlab,
+        numParts - i * partsPerSlab);
+    SortTileRecursive(indices, begin + i * pointsPerSlab, slabCount, slabParts,
+        dim + 1);
+  }
+}
+
 template<typename MetricType,
          typename StatisticType,
          typename MatType,
@@ -68,7 +201,10 @@ RectangleTree(const MatType& data,
     dataset(new MatType(data)),
     ownsDataset(true),
     points(maxLeafSize + 1), // Add one to make splitting the node simpler.
-    auxiliaryInfo(this)
+    auxiliaryInfo(this),
+    arena(new NodeArena<RectangleTree>()),
+    ownsArena(true),
+    fromArena(false)
 {
   // For now, just insert the points in order.
   RectangleTree* root = this;
@@ -109,7 +245,10 @@ RectangleTree(MatType&& data,
     dataset(new MatType(std::move(data))),
     ownsDataset(true),
     points(maxLeafSize + 1), // Add one to make splitting the node simpler.
-    auxiliaryInfo(this)
+    auxiliaryInfo(this),
+    arena(new NodeArena<RectangleTree>()),
+    ownsArena(true),
+    fromArena(false)
 {
   // For now, just insert the points in order.
   RectangleTree* root = this;
@@ -121,6 +260,98 @@ RectangleTree(MatType&& data,
   BuildStatistics(this);
 }
 
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+RectangleTree(const MatType& data,
+              const bool /* bulkLoad */,
+              const size_t maxLeafSize,
+              const size_t minLeafSize,
+              const size_t maxNumChildren,
+              const size_t minNumChildren,
+              const size_t firstDataIndex) :
+    maxNumChildren(maxNumChildren),
+    minNumChildren(minNumChildren),
+    numChildren(0),
+    children(maxNumChildren + 1), // Add one to make splitting the node simpler.
+    parent(NULL),
+    begin(0),
+    count(0),
+    numDescendants(0),
+    maxLeafSize(maxLeafSize),
+    minLeafSize(minLeafSize),
+    bound(data.n_rows),
+    parentDistance(0),
+    dataset(new MatType(data)),
+    ownsDataset(true),
+    points(maxLeafSize + 1), // Add one to make splitting the node simpler.
+    auxiliaryInfo(this),
+    arena(new NodeArena<RectangleTree>()),
+    ownsArena(true),
+    fromArena(false)
+{
+  // Pack the points into the tree with the STR bulk loader.
+  std::vector<size_t> indices(dataset->n_cols - firstDataIndex);
+  for (size_t i = 0; i < indices.size(); ++i)
+    indices[i] = firstDataIndex + i;
+
+  BulkLoad(indices);
+
+  // Initialize statistic recursively after tree construction is complete.
+  BuildStatistics(this);
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+RectangleTree(MatType&& data,
+              const bool /* bulkLoad */,
+              const size_t maxLeafSize,
+              const size_t minLeafSize,
+              const size_t maxNumChildren,
+              const size_t minNumChildren,
+              const size_t firstDataIndex) :
+    maxNumChildren(maxNumChildren),
+    minNumChildren(minNumChildren),
+    numChildren(0),
+    children(maxNumChildren + 1), // Add one to make splitting the node simpler.
+    parent(NULL),
+    begin(0),
+    count(0),
+    numDescendants(0),
+    maxLeafSize(maxLeafSize),
+    minLeafSize(minLeafSize),
+    bound(data.n_rows),
+    parentDistance(0),
+    dataset(new MatType(std::move(data))),
+    ownsDataset(true),
+    points(maxLeafSize + 1), // Add one to make splitting the node simpler.
+    auxiliaryInfo(this),
+    arena(new NodeArena<RectangleTree>()),
+    ownsArena(true),
+    fromArena(false)
+{
+  // Pack the points into the tree with the STR bulk loader.
+  std::vector<size_t> indices(dataset->n_cols - firstDataIndex);
+  for (size_t i = 0; i < indices.size(); ++i)
+    indices[i] = firstDataIndex + i;
+
+  BulkLoad(indices);
+
+  // Initialize statistic recursively after tree construction is complete.
+  BuildStatistics(this);
+}
+
 template<typename MetricType,
          typename StatisticType,
          typename MatType,
@@ -149,7 +380,10 @@ RectangleTree(
     dataset(&parentNode->Dataset()),
     ownsDataset(false),
     points(maxLeafSize + 1), // Add one to make splitting the node simpler.
-    auxiliaryInfo(this)
+    auxiliaryInfo(this),
+    arena(parentNode->arena),
+    ownsArena(false),
+    fromArena(false)
 {
   // Initialize statistic.
   BuildStatistics(this);
@@ -189,14 +423,19 @@ RectangleTree(
         &other.Dataset()),
     ownsDataset(deepCopy && (!parent)),
     points(other.points),
-    auxiliaryInfo(other.auxiliaryInfo, this, deepCopy)
+    auxiliaryInfo(other.auxiliaryInfo, this, deepCopy),
+    arena(deepCopy ?
+        (parent ? parent->arena : new NodeArena<RectangleTree>()) :
+        other.arena),
+    ownsArena(deepCopy && (!parent)),
+    fromArena(false)
 {
   if (deepCopy)
   {
     if (numChildren > 0)
     {
       for (size_t i = 0; i < numChildren; ++i)
-        children[i] = new RectangleTree(other.Child(i), true, this);
+        children[i] = AllocateNode(other.Child(i), true, this);
     }
   }
   else
@@ -231,7 +470,10 @@ RectangleTree(RectangleTree&& other) :
     dataset(other.dataset),
     ownsDataset(other.ownsDataset),
     points(std::move(other.points)),
-    auxiliaryInfo(std::move(other.auxiliaryInfo))
+    auxiliaryInfo(std::move(other.auxiliaryInfo)),
+    arena(other.arena),
+    ownsArena(other.ownsArena),
+    fromArena(false)
 {
   if (parent)
   {
@@ -260,6 +502,8 @@ RectangleTree(RectangleTree&& other) :
   other.parentDistance = 0;
   other.dataset = NULL;
   other.ownsDataset = false;
+  other.arena = NULL;
+  other.ownsArena = false;
 }
 
 /**
@@ -283,7 +527,7 @@ operator=(const RectangleTree& other)
 
   // Freeing memory that will not be used anymore.
   for (size_t i = 0; i < numChildren; ++i)
-    delete children[i];
+    DeallocateNode(children[i]);
 
   if (ownsDataset)
     delete dataset;
@@ -309,7 +553,7 @@ operator=(const RectangleTree& other)
   if (numChildren > 0)
   {
     for (size_t i = 0; i < numChildren; ++i)
-      children[i] = new RectangleTree(other.Child(i), true, this);
+      children[i] = AllocateNode(other.Child(i), true, this);
   }
 
   return *this;
@@ -336,11 +580,14 @@ operator=(RectangleTree&& other)
 
   // Freeing memory that will not be used anymore.
   for (size_t i = 0; i < numChildren; ++i)
-    delete children[i];
+    DeallocateNode(children[i]);
 
   if (ownsDataset)
     delete dataset;
 
+  if (ownsArena)
+    delete arena;
+
   maxNumChildren = other.MaxNumChildren();
   minNumChildren = other.MinNumChildren();
   numChildren = other.NumChildren();
@@ -358,6 +605,8 @@ operator=(RectangleTree&& other)
   ownsDataset = other.ownsDataset;
   points = std::move(other.points);
   auxiliaryInfo = std::move(other.auxiliaryInfo);
+  arena = other.arena;
+  ownsArena = other.ownsArena;
 
   // Now we are a clone of the other tree.  But we must also clear the other
   // tree's contents, so it doesn't delete anything when it is destructed.
@@ -373,6 +622,8 @@ operator=(RectangleTree&& other)
   other.parentDistance = 0;
   other.dataset = NULL;
   other.ownsDataset = false;
+  other.arena = NULL;
+  other.ownsArena = false;
 
   return *this;
 }
@@ -414,10 +665,14 @@ RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
 ~RectangleTree()
 {
   for (size_t i = 0; i < numChildren; ++i)
-    delete children[i];
+    DeallocateNode(children[i]);
 
   if (ownsDataset)
     delete dataset;
+
+  // Deleting the arena releases every block of node storage in bulk.
+  if (ownsArena)
+    delete arena;
 }
 
 /**
@@ -440,7 +695,7 @@ void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
     children[i] = NULL;
 
   numChildren = 0;
-  delete this;
+  DeallocateNode(this);
 }
 
 /**
@@ -459,6 +714,63 @@ void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
   auxiliaryInfo.NullifyData();
 }
 
+/**
+ * Construct a new node of this tree in storage taken from the per-tree arena.
+ */
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+template<typename... Args>
+RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>*
+RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+    AllocateNode(Args&&... args)
+{
+  // A tree loaded from an archive has no arena until its first allocation.
+  if (arena == NULL)
+  {
+    arena = new NodeArena<RectangleTree>();
+    ownsArena = true;
+  }
+
+  RectangleTree* node =
+      new (arena->Allocate()) RectangleTree(std::forward<Args>(args)...);
+  node->fromArena = true;
+  return node;
+}
+
+/**
+ * Destroy a node, returning its storage to the arena it was allocated from.
+ */
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::
+    DeallocateNode(RectangleTree* node)
+{
+  if (node == NULL)
+    return;
+
+  if (node->fromArena && node->arena != NULL)
+  {
+    NodeArena<RectangleTree>* nodeArena = node->arena;
+    node->~RectangleTree();
+    nodeArena->Deallocate(node);
+  }
+  else
+  {
+    delete node;
+  }
+}
+
 /**
  * Recurse through the tree and insert the point at the leaf node chosen
  * by the heuristic.
@@ -668,6 +980,50 @@ bool RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
   return false;
 }
 
+/**
+ * Delete a whole batch of points at once by rebuilding the tree over the
+ * surviving points with the STR bulk loader.
+ */
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::
+    DeletePoints(const std::vector<size_t>& pointsToDelete)
+{
+  // Mark the points that are being removed, then gather the survivors.
+  std::vector<bool> removed(dataset->n_cols, false);
+  for (size_t i = 0; i < pointsToDelete.size(); ++i)
+    removed[pointsToDelete[i]] = true;
+
+  std::vector<size_t> survivors;
+  survivors.reserve(numDescendants);
+  for (size_t i = 0; i < numDescendants; ++i)
+  {
+    const size_t index = Descendant(i);
+    if (!removed[index])
+      survivors.push_back(index);
+  }
+
+  // Tear the tree down to an empty root, then rebuild it over the surviving
+  // points.  This is far cheaper than condensing the tree once per deleted
+  // point, and it restores near-full node occupancy.
+  for (size_t i = 0; i < numChildren; ++i)
+  {
+    DeallocateNode(children[i]);
+    children[i] = NULL;
+  }
+  numChildren = 0;
+  count = 0;
+  numDescendants = 0;
+  bound.Clear();
+
+  BulkLoad(survivors);
+  BuildStatistics(this);
+}
 
 /**
  * Recurse through the tree to remove the node.  Once we find the node, we
@@ -1057,7 +1413,10 @@ RectangleTree() :
     minLeafSize(0),
     parentDistance(0.0),
     dataset(NULL),
-    ownsDataset(false)
+    ownsDataset(false),
+    arena(NULL),
+    ownsArena(false),
+    fromArena(false)
 {
   // Nothing to do.
 }
@@ -1230,7 +1589,7 @@ void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
       count = child->Count();
       child->Count() = 0;
 
-      delete child;
+      DeallocateNode(child);
       return;
     }
   }
@@ -1400,7 +1759,7 @@ void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
   if (cereal::is_loading<Archive>())
   {
     for (size_t i = 0; i < numChildren; ++i)
-      delete children[i];
+      DeallocateNode(children[i]);
     children.clear();
 
     if (ownsDataset && dataset)
@@ -69,8 +69,9 @@ void XTreeSplit::SplitLeafNode(TreeType *tree, std::vector<bool>& relevels)
    * duplication.
    */
   TreeType* par = tree->Parent();
-  TreeType* treeOne = (par) ? tree              : new TreeType(tree);
-  TreeType* treeTwo = (par) ? new TreeType(par) : new TreeType(tree);
+  TreeType* treeOne = (par) ? tree : tree->AllocateNode(tree);
+  TreeType* treeTwo =
+      (par) ? tree->AllocateNode(par) : tree->AllocateNode(tree);
 
   // Now clean the node, and we will re-use this.
   const size_t numPoints = tree->Count();
@@ -426,7 +427,8 @@ bool XTreeSplit::SplitNonLeafNode(TreeType *tree, std::vector<bool>& relevels)
   if (tree->Parent() != NULL)
   {
     // Reuse tree as the new child.
-    TreeType* treeTwo = new TreeType(tree->Parent(), tree->MaxNumChildren());
+    TreeType* treeTwo =
+        tree->AllocateNode(tree->Parent(), tree->MaxNumChildren());
     const size_t numChildren = tree->NumChildren();
     tree->numChildren = 0;
     tree->count = 0;
@@ -533,8 +535,8 @@ bool XTreeSplit::SplitNonLeafNode(TreeType *tree, std::vector<bool>& relevels)
             tree->children[i] = NULL;
           }
 
-          delete tree;
-          delete treeTwo;
+          TreeType::DeallocateNode(tree);
+          TreeType::DeallocateNode(treeTwo);
 
           return false;
         }
@@ -547,7 +549,7 @@ bool XTreeSplit::SplitNonLeafNode(TreeType *tree, std::vector<bool>& relevels)
         for (size_t i = 0; i < numChildren; ++i)
           tree->Child(i).Parent() = tree;
 
-        delete treeTwo;
+        TreeType::DeallocateNode(treeTwo);
         return false;
       }
     }
@@ -591,8 +593,8 @@ bool XTreeSplit::SplitNonLeafNode(TreeType *tree, std::vector<bool>& relevels)
   else
   {
     // We are the root of the tree, so we need to create two children to add.
-    TreeType* treeOne = new TreeType(tree, tree->MaxNumChildren());
-    TreeType* treeTwo = new TreeType(tree, tree->MaxNumChildren());
+    TreeType* treeOne = tree->AllocateNode(tree, tree->MaxNumChildren());
+    TreeType* treeTwo = tree->AllocateNode(tree, tree->MaxNumChildren());
     const size_t numChildren = tree->NumChildren();
     tree->numChildren = 0;
 
@@ -676,8 +678,8 @@ bool XTreeSplit::SplitNonLeafNode(TreeType *tree, std::vector<bool>& relevels)
         for (size_t i = 0; i < numChildren; ++i)
           tree->Child(i).Parent() = tree;
 
-        delete treeOne;
-        delete treeTwo;
+        TreeType::DeallocateNode(treeOne);
+        TreeType::DeallocateNode(treeTwo);
         return false;
       }
     }
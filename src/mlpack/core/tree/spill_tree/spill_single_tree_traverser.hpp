@@ -21,6 +21,8 @@
 
 #include "spill_tree.hpp"
 
+#include <queue>
+
 namespace mlpack {
 namespace tree {
 
@@ -36,9 +38,14 @@ class SpillTree<MetricType, StatisticType, MatType, HyperplaneType, SplitType>::
 {
  public:
   /**
-   * Instantiate the single tree traverser with the given rule set.
+   * Instantiate the single tree traverser with the given rule set and an
+   * optional backtracking budget.  The budget only applies to defeatist
+   * traversals: after the defeatist descent, up to backtrackLimit of the most
+   * promising skipped branches are revisited for each query point.  A budget
+   * of 0 gives the usual defeatist search; larger budgets trade running time
+   * for recall.
    */
-  SpillSingleTreeTraverser(RuleType& rule);
+  SpillSingleTreeTraverser(RuleType& rule, const size_t backtrackLimit = 0);
 
   /**
    * Traverse the tree with the given point.
@@ -58,10 +65,48 @@ class SpillTree<MetricType, StatisticType, MatType, HyperplaneType, SplitType>::
   //! Modify the number of prunes.
   size_t& NumPrunes() { return numPrunes; }
 
+  //! Get the backtracking budget for defeatist traversals.
+  size_t BacktrackLimit() const { return backtrackLimit; }
+  //! Modify the backtracking budget for defeatist traversals.
+  size_t& BacktrackLimit() { return backtrackLimit; }
+
  private:
+  //! CandidateBranch represents a skipped branch (score, node).
+  typedef std::pair<double, SpillTree*> CandidateBranch;
+
+  //! Use a min-heap to revisit the skipped branches best score first.
+  typedef std::priority_queue<CandidateBranch,
+      std::vector<CandidateBranch>, std::greater<CandidateBranch>>
+      CandidateQueue;
+
+  /**
+   * The recursive part of the traversal.  This is the usual depth-first
+   * traversal; when a backtracking budget is set, skipped branches are pushed
+   * onto candidateBranches instead of being forgotten.
+   */
+  void TraverseDescend(const size_t queryIndex,
+                       SpillTree& referenceNode,
+                       const bool bruteForce = false);
+
   //! Reference to the rules with which the tree will be traversed.
   RuleType& rule;
 
+  //! The maximum number of skipped branches to revisit for each query point
+  //! (0 means pure defeatist search).
+  size_t backtrackLimit;
+
+  //! The branches skipped by the defeatist descent of the current query.
+  CandidateQueue candidateBranches;
+
+  //! Stamp of the current query traversal, used by the duplicate-point guard.
+  size_t traversalId;
+
+  //! For each reference point, the stamp of the last traversal that performed
+  //! its base case.  This is only maintained when backtracking is enabled:
+  //! overlapping branches share points, so revisiting a skipped branch could
+  //! otherwise produce duplicate candidates.
+  std::vector<size_t> pointVisited;
+
   //! The number of nodes which have been pruned during traversal.
   size_t numPrunes;
 };
@@ -30,8 +30,10 @@ template<typename MetricType,
 template<typename RuleType, bool Defeatist>
 SpillTree<MetricType, StatisticType, MatType, HyperplaneType, SplitType>::
 SpillSingleTreeTraverser<RuleType, Defeatist>::SpillSingleTreeTraverser(
-    RuleType& rule) :
+    RuleType& rule, const size_t backtrackLimit) :
     rule(rule),
+    backtrackLimit(backtrackLimit),
+    traversalId(0),
     numPrunes(0)
 { /* Nothing to do. */ }
 
@@ -48,6 +50,59 @@ SpillSingleTreeTraverser<RuleType, Defeatist>::Traverse(
     SpillTree<MetricType, StatisticType, MatType, HyperplaneType, SplitType>&
         referenceNode,
     const bool bruteForce)
+{
+  if (Defeatist && (backtrackLimit > 0))
+  {
+    // A new query traversal begins; reset the duplicate-point guard.
+    ++traversalId;
+    if (pointVisited.size() < referenceNode.Dataset().n_cols)
+      pointVisited.resize(referenceNode.Dataset().n_cols, 0);
+  }
+
+  if (Defeatist && (backtrackLimit > 0) && !bruteForce &&
+      (referenceNode.Parent() == NULL))
+  {
+    // Bounded-backtracking search: perform the defeatist descent, then spend
+    // the backtracking budget on the most promising skipped branches.
+    candidateBranches = CandidateQueue();
+    TraverseDescend(queryIndex, referenceNode);
+
+    size_t budget = backtrackLimit;
+    while (budget > 0 && !candidateBranches.empty())
+    {
+      const CandidateBranch branch = candidateBranches.top();
+      candidateBranches.pop();
+
+      // The branch may have become prunable since it was scored.
+      if (rule.Rescore(queryIndex, *branch.second, branch.first) == DBL_MAX)
+      {
+        ++numPrunes;
+        continue;
+      }
+
+      --budget;
+      TraverseDescend(queryIndex, *branch.second);
+    }
+  }
+  else
+  {
+    TraverseDescend(queryIndex, referenceNode, bruteForce);
+  }
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename HyperplaneMetricType> class HyperplaneType,
+         template<typename SplitMetricType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType, bool Defeatist>
+void SpillTree<MetricType, StatisticType, MatType, HyperplaneType, SplitType>::
+SpillSingleTreeTraverser<RuleType, Defeatist>::TraverseDescend(
+    const size_t queryIndex,
+    SpillTree<MetricType, StatisticType, MatType, HyperplaneType, SplitType>&
+        referenceNode,
+    const bool bruteForce)
 {
   // If we have too few points, then we need to backtrack up one level and
   // brute-force search.
@@ -56,12 +111,25 @@ SpillSingleTreeTraverser<RuleType, Defeatist>::Traverse(
       (referenceNode.Parent() != NULL) &&
       (referenceNode.Parent()->Overlap()))
   {
-    Traverse(queryIndex, *referenceNode.Parent(), true);
+    TraverseDescend(queryIndex, *referenceNode.Parent(), true);
   }
   else if (referenceNode.IsLeaf() || bruteForce)
   {
     for (size_t i = 0; i < referenceNode.NumDescendants(); ++i)
-      rule.BaseCase(queryIndex, referenceNode.Descendant(i));
+    {
+      if (Defeatist && (backtrackLimit > 0))
+      {
+        // Overlapping branches share points, so skip points whose base case
+        // has already been performed during this query traversal.
+        const size_t index = referenceNode.Descendant(i);
+        if (pointVisited[index] == traversalId)
+          continue;
+        pointVisited[index] = traversalId;
+        rule.BaseCase(queryIndex, index);
+      }
+      else
+        rule.BaseCase(queryIndex, referenceNode.Descendant(i));
+    }
   }
   else
   {
@@ -69,7 +137,22 @@ SpillSingleTreeTraverser<RuleType, Defeatist>::Traverse(
     {
       // If referenceNode is a overlapping node we do defeatist search.
       size_t bestChild = rule.GetBestChild(queryIndex, referenceNode);
-      Traverse(queryIndex, referenceNode.Child(bestChild));
+
+      // When a backtracking budget is available, remember the branch we are
+      // about to skip so that it may be revisited later.
+      if (backtrackLimit > 0)
+      {
+        const size_t otherChild = (bestChild == 0) ? 1 : 0;
+        const double score = rule.Score(queryIndex,
+            referenceNode.Child(otherChild));
+        if (score != DBL_MAX)
+        {
+          candidateBranches.push(std::make_pair(score,
+              &referenceNode.Child(otherChild)));
+        }
+      }
+
+      TraverseDescend(queryIndex, referenceNode.Child(bestChild));
       ++numPrunes;
     }
     else
@@ -81,27 +164,27 @@ SpillSingleTreeTraverser<RuleType, Defeatist>::Traverse(
       if (leftScore < rightScore)
       {
         // Recurse to the left.
-        Traverse(queryIndex, *referenceNode.Left());
+        TraverseDescend(queryIndex, *referenceNode.Left());
 
         // Is it still valid to recurse to the right?
         rightScore = rule.Rescore(queryIndex, *referenceNode.Right(),
             rightScore);
 
         if (rightScore != DBL_MAX) // Recurse to the right.
-          Traverse(queryIndex, *referenceNode.Right());
+          TraverseDescend(queryIndex, *referenceNode.Right());
         else
           ++numPrunes;
       }
       else if (rightScore < leftScore)
       {
         // Recurse to the right.
-        Traverse(queryIndex, *referenceNode.Right());
+        TraverseDescend(queryIndex, *referenceNode.Right());
 
         // Is it still valid to recurse to the left?
         leftScore = rule.Rescore(queryIndex, *referenceNode.Left(), leftScore);
 
         if (leftScore != DBL_MAX) // Recurse to the left.
-          Traverse(queryIndex, *referenceNode.Left());
+          TraverseDescend(queryIndex, *referenceNode.Left());
         else
           ++numPrunes;
       }
@@ -114,14 +197,14 @@ SpillSingleTreeTraverser<RuleType, Defeatist>::Traverse(
         else
         {
           // Choose the left first.
-          Traverse(queryIndex, *referenceNode.Left());
+          TraverseDescend(queryIndex, *referenceNode.Left());
 
           // Is it still valid to recurse to the right?
           rightScore = rule.Rescore(queryIndex, *referenceNode.Right(),
               rightScore);
 
           if (rightScore != DBL_MAX)
-            Traverse(queryIndex, *referenceNode.Right());
+            TraverseDescend(queryIndex, *referenceNode.Right());
           else
             ++numPrunes;
         }
@@ -0,0 +1,124 @@
+/**
+ * @file core/tree/traversal_statistics.hpp
+ * @author Ryan Curtin
+ *
+ * An opt-in collector of traversal statistics.  A rules class holding a
+ * pointer to a TraversalStatistics object records base cases, node
+ * combinations scored and pruned, candidate list insertions, and bound
+ * tightenings into it during the traversal; when the pointer is NULL, nothing
+ * is collected.  The counts are useful to understand why a particular query
+ * is slow and to tune leaf sizes and tree types for a dataset.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_TRAVERSAL_STATISTICS_HPP
+#define MLPACK_CORE_TREE_TRAVERSAL_STATISTICS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The TraversalStatistics class accumulates counts of the work performed by a
+ * traversal.  Base cases and candidate insertions are additionally aggregated
+ * per query point, so particularly expensive queries can be identified.
+ */
+class TraversalStatistics
+{
+ public:
+  //! Create an empty statistics object.
+  TraversalStatistics() :
+      baseCases(0),
+      scores(0),
+      prunes(0),
+      insertions(0),
+      boundTightenings(0)
+  { /* Nothing to do. */ }
+
+  /**
+   * Clear all counts and size the per-query aggregates for the given number
+   * of query points.  This should be called before every traversal whose
+   * statistics are to be collected.
+   *
+   * @param numQueries Number of query points of the upcoming traversal.
+   */
+  void Reset(const size_t numQueries)
+  {
+    baseCases = 0;
+    scores = 0;
+    prunes = 0;
+    insertions = 0;
+    boundTightenings = 0;
+    perQueryBaseCases.zeros(numQueries);
+    perQueryInsertions.zeros(numQueries);
+  }
+
+  //! Record one base case for the given query point.
+  void RecordBaseCase(const size_t queryIndex)
+  {
+    ++baseCases;
+    if (queryIndex < perQueryBaseCases.n_elem)
+      ++perQueryBaseCases[queryIndex];
+  }
+
+  //! Record one scored node or node combination.
+  void RecordScore() { ++scores; }
+
+  //! Record one pruned node or node combination.
+  void RecordPrune() { ++prunes; }
+
+  //! Record one insertion into the candidate list of the given query point.
+  void RecordInsertion(const size_t queryIndex)
+  {
+    ++insertions;
+    if (queryIndex < perQueryInsertions.n_elem)
+      ++perQueryInsertions[queryIndex];
+  }
+
+  //! Record one tightening of a cached node bound.
+  void RecordBoundTightening() { ++boundTightenings; }
+
+  //! Get the number of base cases that were performed.
+  size_t BaseCases() const { return baseCases; }
+  //! Get the number of nodes or node combinations that were scored.
+  size_t Scores() const { return scores; }
+  //! Get the number of nodes or node combinations that were pruned.
+  size_t Prunes() const { return prunes; }
+  //! Get the number of candidate list insertions.
+  size_t Insertions() const { return insertions; }
+  //! Get the number of cached node bound tightenings.
+  size_t BoundTightenings() const { return boundTightenings; }
+
+  //! Get the number of base cases performed for each query point.
+  const arma::Col<size_t>& PerQueryBaseCases() const
+  { return perQueryBaseCases; }
+  //! Get the number of candidate insertions for each query point.
+  const arma::Col<size_t>& PerQueryInsertions() const
+  { return perQueryInsertions; }
+
+ private:
+  //! The number of base cases that were performed.
+  size_t baseCases;
+  //! The number of nodes or node combinations that were scored.
+  size_t scores;
+  //! The number of nodes or node combinations that were pruned.
+  size_t prunes;
+  //! The number of candidate list insertions.
+  size_t insertions;
+  //! The number of cached node bound tightenings.
+  size_t boundTightenings;
+
+  //! The number of base cases performed for each query point.
+  arma::Col<size_t> perQueryBaseCases;
+  //! The number of candidate insertions for each query point.
+  arma::Col<size_t> perQueryInsertions;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+#endif // MLPACK_CORE_TREE_TRAVERSAL_STATISTICS_HPP
@@ -91,11 +91,19 @@ static const std::string testName = "";
 #include <mlpack/core/util/param.hpp>
 #include <mlpack/bindings/cli/parse_command_line.hpp>
 #include <mlpack/bindings/cli/end_program.hpp>
+#include <mlpack/bindings/cli/binding_server.hpp>
 
 static void mlpackMain(); // This is typically defined after this include.
 
 int main(int argc, char** argv)
 {
+  // If --server was given, run persistently and serve requests over a Unix
+  // domain socket instead of running once (see binding_server.hpp).
+  const std::string serverSocketPath =
+      mlpack::bindings::cli::ServerSocketPath(argc, argv);
+  if (!serverSocketPath.empty())
+    return mlpack::bindings::cli::ServeBinding(serverSocketPath, &mlpackMain);
+
   // Parse the command-line options; put them into CLI.
   mlpack::bindings::cli::ParseCommandLine(argc, argv);
   // Enable timing.
@@ -0,0 +1,35 @@
+/**
+ * @file core/util/prefetch.hpp
+ *
+ * A portable software-prefetch hint.  Pointer-chasing code (such as tree
+ * traversals) issues dependent loads that the hardware prefetcher cannot
+ * predict; hinting the next node into cache while the current one is being
+ * processed hides some of that memory latency.
+ *
+ * MLPACK_PREFETCH_READ(addr) requests that the cache line containing `addr`
+ * be brought into cache for reading.  It is only a hint: it never faults,
+ * even for invalid addresses, and compiles to nothing on compilers without a
+ * prefetch intrinsic.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_PREFETCH_HPP
+#define MLPACK_CORE_UTIL_PREFETCH_HPP
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  #include <xmmintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+  #define MLPACK_PREFETCH_READ(addr) __builtin_prefetch((addr), 0, 3)
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  #define MLPACK_PREFETCH_READ(addr) \
+      _mm_prefetch((const char*) (addr), _MM_HINT_T0)
+#else
+  #define MLPACK_PREFETCH_READ(addr) ((void) 0)
+#endif
+
+#endif // MLPACK_CORE_UTIL_PREFETCH_HPP
@@ -0,0 +1,133 @@
+/**
+ * @file core/util/profiler.cpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the low-overhead hierarchical profiler.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace mlpack;
+using namespace mlpack::util;
+
+namespace {
+
+//! The registry of the states of all threads; only touched when a thread is
+//! created or destroyed and when a report is produced.
+std::vector<ProfileThreadState*>& Registry()
+{
+  static std::vector<ProfileThreadState*> registry;
+  return registry;
+}
+
+//! The mutex guarding the registry.
+std::mutex& RegistryMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+} // namespace
+
+ProfileThreadState::ProfileThreadState() : size(0), depth(0)
+{
+  std::lock_guard<std::mutex> lock(RegistryMutex());
+  Registry().push_back(this);
+}
+
+ProfileThreadState::~ProfileThreadState()
+{
+  std::lock_guard<std::mutex> lock(RegistryMutex());
+  std::vector<ProfileThreadState*>& registry = Registry();
+  registry.erase(std::remove(registry.begin(), registry.end(), this),
+      registry.end());
+}
+
+void ProfileThreadState::Record(const char* name,
+                                const size_t depth,
+                                const uint64_t ns)
+{
+  const size_t clampedDepth = std::min(depth, maxDepth);
+
+  // Scopes are entered with the same string literal every time, so comparing
+  // pointers is sufficient to find the right slot.
+  for (size_t i = 0; i < size; ++i)
+  {
+    if (slots[i].name == name && slots[i].depth == clampedDepth)
+    {
+      slots[i].nanoseconds += ns;
+      ++slots[i].calls;
+      return;
+    }
+  }
+
+  // The combination is new; drop it if the table is full.
+  if (size == maxSlots)
+    return;
+
+  slots[size].name = name;
+  slots[size].depth = clampedDepth;
+  slots[size].nanoseconds = ns;
+  slots[size].calls = 1;
+  ++size;
+}
+
+ProfileThreadState& Profiler::ThreadState()
+{
+  thread_local ProfileThreadState state;
+  return state;
+}
+
+void Profiler::Print(std::ostream& stream)
+{
+  // Merge the slots of all threads by (depth, name).  The map is ordered by
+  // depth, so parents are printed before their children.
+  std::map<std::pair<size_t, std::string>,
+      std::pair<uint64_t, size_t>> merged;
+  {
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    for (const ProfileThreadState* state : Registry())
+    {
+      for (size_t i = 0; i < state->size; ++i)
+      {
+        std::pair<uint64_t, size_t>& entry = merged[std::make_pair(
+            state->slots[i].depth, std::string(state->slots[i].name))];
+        entry.first += state->slots[i].nanoseconds;
+        entry.second += state->slots[i].calls;
+      }
+    }
+  }
+
+  stream << "Profile (all threads):" << std::endl;
+  for (const auto& entry : merged)
+  {
+    const std::string indent(2 * entry.first.first, ' ');
+    stream << "  " << indent << entry.first.second << ": "
+        << entry.second.first / 1e9 << "s (" << entry.second.second
+        << " calls)" << std::endl;
+  }
+}
+
+void Profiler::Reset()
+{
+  std::lock_guard<std::mutex> lock(RegistryMutex());
+  for (ProfileThreadState* state : Registry())
+  {
+    state->size = 0;
+    state->depth = 0;
+  }
+}
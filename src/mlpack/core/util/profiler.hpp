@@ -0,0 +1,155 @@
+/**
+ * @file core/util/profiler.hpp
+ * @author Ryan Curtin
+ *
+ * A low-overhead hierarchical profiler.  Unlike the Timer facility, which
+ * grabs a mutex and performs a map lookup on every Start()/Stop() call,
+ * scopes are recorded into thread-local buffers that are only merged when a
+ * report is printed, so hot loops can be instrumented without perturbing
+ * them.  Instrumentation sites use the MLPACK_PROFILE_SCOPE() macro, which
+ * compiles away entirely unless MLPACK_ENABLE_PROFILER is defined.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_PROFILER_HPP
+#define MLPACK_CORE_UTIL_PROFILER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+namespace mlpack {
+namespace util {
+
+/**
+ * Profiling state of one thread.  Time spent in a scope is aggregated per
+ * (name, nesting depth) combination into a small fixed-size table, so
+ * recording a scope is a handful of arithmetic operations, a linear scan of
+ * the table and two clock reads -- no locking and no allocation.
+ */
+class ProfileThreadState
+{
+ public:
+  //! Aggregated time of one scope name at one nesting depth.
+  struct Slot
+  {
+    //! Name of the scope (instrumentation sites use string literals, so slots
+    //! are matched by pointer).
+    const char* name;
+
+    //! Nesting depth of the scope.
+    size_t depth;
+
+    //! Total time spent in the scope, in nanoseconds.
+    uint64_t nanoseconds;
+
+    //! Number of times the scope was entered.
+    size_t calls;
+  };
+
+  //! Maximum number of (name, depth) combinations tracked per thread; further
+  //! combinations are silently dropped.
+  constexpr static size_t maxSlots = 256;
+
+  //! Nesting depths beyond this value are clamped, so that recursive
+  //! instrumented scopes do not flood the table.
+  constexpr static size_t maxDepth = 16;
+
+  //! Create the state and register it for report merging.
+  ProfileThreadState();
+
+  //! Unregister the state.
+  ~ProfileThreadState();
+
+  //! Add elapsed time for the given scope name at the given depth.
+  void Record(const char* name, const size_t depth, const uint64_t ns);
+
+  //! Aggregated slots of this thread.
+  Slot slots[maxSlots];
+
+  //! Number of slots in use.
+  size_t size;
+
+  //! Current nesting depth of the thread.
+  size_t depth;
+};
+
+/**
+ * The static interface of the profiler: access to the per-thread state and
+ * merging of all thread states into a printed report.
+ */
+class Profiler
+{
+ public:
+  //! Get the profiling state of the calling thread.
+  static ProfileThreadState& ThreadState();
+
+  /**
+   * Merge the buffers of all threads and print a hierarchical time breakdown
+   * (scopes indented by nesting depth, with total time and call counts) to
+   * the given stream.
+   */
+  static void Print(std::ostream& stream);
+
+  //! Clear the recorded times of all threads.
+  static void Reset();
+};
+
+/**
+ * A RAII timer for one profiled scope: entering the scope reads the clock
+ * and increases the nesting depth of the thread; leaving it records the
+ * elapsed time into the thread-local buffer.
+ */
+class ScopedProfile
+{
+ public:
+  //! Enter the scope.  The name must outlive the profiler (instrumentation
+  //! sites pass string literals).
+  explicit ScopedProfile(const char* name) :
+      name(name),
+      start(std::chrono::steady_clock::now())
+  {
+    ++Profiler::ThreadState().depth;
+  }
+
+  //! Leave the scope and record the elapsed time.
+  ~ScopedProfile()
+  {
+    const std::chrono::steady_clock::time_point end =
+        std::chrono::steady_clock::now();
+    ProfileThreadState& state = Profiler::ThreadState();
+    --state.depth;
+    state.Record(name, state.depth,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+        end - start).count());
+  }
+
+ private:
+  //! Name of the scope.
+  const char* name;
+
+  //! Time at which the scope was entered.
+  const std::chrono::steady_clock::time_point start;
+};
+
+} // namespace util
+} // namespace mlpack
+
+/**
+ * Instrument the current scope with the given name (a string literal).  The
+ * macro expands to nothing unless mlpack is compiled with
+ * MLPACK_ENABLE_PROFILER, so instrumented hot loops cost nothing in regular
+ * builds.
+ */
+#ifdef MLPACK_ENABLE_PROFILER
+  #define MLPACK_PROFILE_SCOPE(name) \
+      mlpack::util::ScopedProfile mlpackProfileScope(name)
+#else
+  #define MLPACK_PROFILE_SCOPE(name) ((void) 0)
+#endif
+
+#endif // MLPACK_CORE_UTIL_PROFILER_HPP
@@ -0,0 +1,95 @@
+/**
+ * @file core/util/telemetry.cpp
+ *
+ * Implementation of the Telemetry class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "telemetry.hpp"
+#include "threads.hpp"
+
+#include <sstream>
+
+using namespace mlpack;
+
+// Telemetry is disabled by default.
+std::ostream* Telemetry::stream = NULL;
+
+void Telemetry::Stream(std::ostream* newStream)
+{
+  stream = newStream;
+}
+
+std::ostream* Telemetry::Stream()
+{
+  return stream;
+}
+
+Telemetry::Operation::Operation(const std::string& name) :
+    rows(0),
+    cols(0),
+    bytes(0),
+    hasRows(false),
+    hasCols(false),
+    hasBytes(false)
+{
+  // Take the start time only when telemetry is enabled; the empty name marks
+  // an operation that began while telemetry was disabled, so that enabling it
+  // mid-operation does not emit a record with a garbage duration.
+  if (Enabled())
+  {
+    this->name = name;
+    start = std::chrono::high_resolution_clock::now();
+  }
+}
+
+Telemetry::Operation::~Operation()
+{
+  if (!Enabled() || name.empty())
+    return;
+
+  const double duration = std::chrono::duration_cast<
+      std::chrono::duration<double>>(
+      std::chrono::high_resolution_clock::now() - start).count();
+
+  // Compose the whole line first and write it with one insertion, so lines
+  // from concurrent operations do not interleave on streams with atomic
+  // insertions.
+  std::ostringstream record;
+  record << "{\"operation\":\"" << name << "\""
+      << ",\"duration\":" << duration;
+  if (hasRows)
+    record << ",\"rows\":" << rows;
+  if (hasCols)
+    record << ",\"cols\":" << cols;
+  if (hasBytes)
+    record << ",\"bytes\":" << bytes;
+  record << ",\"threads\":" << Threads() << "}\n";
+
+  (*stream) << record.str();
+  stream->flush();
+}
+
+Telemetry::Operation& Telemetry::Operation::Rows(const size_t rows)
+{
+  this->rows = rows;
+  this->hasRows = true;
+  return *this;
+}
+
+Telemetry::Operation& Telemetry::Operation::Cols(const size_t cols)
+{
+  this->cols = cols;
+  this->hasCols = true;
+  return *this;
+}
+
+Telemetry::Operation& Telemetry::Operation::Bytes(const size_t bytes)
+{
+  this->bytes = bytes;
+  this->hasBytes = true;
+  return *this;
+}
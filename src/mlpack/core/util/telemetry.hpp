@@ -0,0 +1,117 @@
+/**
+ * @file core/util/telemetry.hpp
+ *
+ * Definition of the Telemetry class, a structured performance-counter sink.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_TELEMETRY_HPP
+#define MLPACK_CORE_UTIL_TELEMETRY_HPP
+
+#include <chrono>
+#include <ostream>
+#include <string>
+
+#include <mlpack/mlpack_export.hpp>
+
+namespace mlpack {
+
+/**
+ * Emits per-operation performance counters as JSON lines, one object per
+ * operation, for fleet monitoring.  Unlike Log::Info, the output is machine
+ * parseable; unlike the Timers printed by bindings at program exit, records
+ * are emitted as operations finish.
+ *
+ * Telemetry is disabled by default and costs a single pointer check per
+ * instrumented operation while disabled.  Enable it by pointing it at a
+ * stream:
+ *
+ * @code
+ * std::ofstream telemetryLog("telemetry.jsonl");
+ * Telemetry::Stream(&telemetryLog);
+ * @endcode
+ *
+ * Instrumented entry points create a scoped Telemetry::Operation, which
+ * records the wall-clock duration between its construction and destruction:
+ *
+ * @code
+ * Telemetry::Operation op("data::Load");
+ * // ... do the work ...
+ * op.Rows(matrix.n_rows).Cols(matrix.n_cols).Bytes(bytes);
+ * @endcode
+ *
+ * Each record carries the operation name, the duration in seconds, the row,
+ * column, and byte counts the operation chose to report (omitted when not
+ * set), and the configured thread count.  Each line is written with a single
+ * stream insertion, so lines from concurrent operations do not interleave on
+ * streams with atomic insertions.
+ */
+class Telemetry
+{
+ public:
+  /**
+   * Enable telemetry by setting the stream records are written to, or disable
+   * it by passing NULL.  The stream is not owned and must outlive all
+   * instrumented operations.
+   *
+   * @param stream Stream to write JSON lines to (NULL to disable).
+   */
+  static void Stream(std::ostream* stream);
+
+  //! Get the stream records are written to (NULL when disabled).
+  static std::ostream* Stream();
+
+  //! Whether telemetry records are being collected.
+  static bool Enabled() { return stream != NULL; }
+
+  /**
+   * Scoped recorder for one operation.  The constructor takes the wall-clock
+   * start time; the destructor emits the record.  When telemetry is disabled
+   * construction and destruction reduce to a pointer check.
+   */
+  class Operation
+  {
+   public:
+    /**
+     * Begin recording an operation.
+     *
+     * @param name Name of the operation (e.g. "data::Load"); must not need
+     *      JSON escaping.
+     */
+    Operation(const std::string& name);
+
+    //! Emit the record (if telemetry is enabled).
+    ~Operation();
+
+    //! Report the number of rows the operation processed.
+    Operation& Rows(const size_t rows);
+    //! Report the number of columns (e.g. points) the operation processed.
+    Operation& Cols(const size_t cols);
+    //! Report the number of bytes the operation processed.
+    Operation& Bytes(const size_t bytes);
+
+   private:
+    //! Name of the operation.
+    std::string name;
+    //! Wall-clock time at construction.
+    std::chrono::high_resolution_clock::time_point start;
+    //! Counters and whether they were set.
+    size_t rows;
+    size_t cols;
+    size_t bytes;
+    bool hasRows;
+    bool hasCols;
+    bool hasBytes;
+  };
+
+ private:
+  //! The stream records are written to; NULL means disabled.
+  static MLPACK_EXPORT std::ostream* stream;
+};
+
+} // namespace mlpack
+
+#endif
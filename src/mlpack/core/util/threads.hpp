@@ -0,0 +1,70 @@
+/**
+ * @file core/util/threads.hpp
+ *
+ * Library-level control of the threads mlpack's parallel regions use.  All of
+ * mlpack's parallelism runs on the OpenMP runtime, which maintains one
+ * persistent thread pool per process; these functions configure that pool
+ * once for every mlpack model the process embeds, and give parallel code a
+ * single place to ask how many workers it may use.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_THREADS_HPP
+#define MLPACK_CORE_UTIL_THREADS_HPP
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+
+/**
+ * Get the maximum number of threads mlpack's parallel regions will use.
+ *
+ * When called from inside a parallel region this returns 1, so code that
+ * sizes per-thread buffers or spawns further parallel work with this value
+ * does not oversubscribe the machine---for instance when two models train
+ * concurrently from an outer parallel region.  Without OpenMP support this
+ * always returns 1.
+ */
+inline size_t Threads()
+{
+  #ifdef HAS_OPENMP
+  if (omp_in_parallel())
+    return 1;
+
+  return (size_t) omp_get_max_threads();
+  #else
+  return 1;
+  #endif
+}
+
+/**
+ * Set the maximum number of threads mlpack's parallel regions will use.  This
+ * configures the process-wide OpenMP pool, so it affects every mlpack model
+ * in the process; call it once at startup.  Passing 0 restores the use of
+ * all hardware threads.  Without OpenMP support this is a no-op.
+ *
+ * @param numThreads Number of threads to use (0 for all hardware threads).
+ */
+inline void Threads(const size_t numThreads)
+{
+  #ifdef HAS_OPENMP
+  omp_set_num_threads((numThreads == 0) ? omp_get_num_procs() :
+      (int) numThreads);
+
+  // mlpack's parallel regions are not written to nest; keeping a single
+  // active level makes regions entered from an already-parallel caller run
+  // sequentially instead of oversubscribing the machine with nested teams.
+  omp_set_max_active_levels(1);
+  #else
+  (void) numThreads;
+  #endif
+}
+
+} // namespace mlpack
+
+#endif
@@ -29,6 +29,7 @@
 #define MLPACK_METHODS_ADABOOST_ADABOOST_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
 #include <mlpack/methods/perceptron/perceptron.hpp>
 #include <mlpack/methods/decision_tree/decision_tree.hpp>
 
@@ -66,8 +67,10 @@ namespace adaboost {
  *             const arma::rowvec& weights);
  *
  * // Given the test points, classify them and output predictions into
- * // predictedLabels.
- * void Classify(const MatType& data, arma::Row<size_t>& predictedLabels);
+ * // predictedLabels.  This must be const so that AdaBoost::Classify() can be
+ * // called on a const model.
+ * void Classify(const MatType& data,
+ *               arma::Row<size_t>& predictedLabels) const;
  * @endcode
  *
  * For more information on and examples of weak learners, see
@@ -112,6 +115,15 @@ class AdaBoost
   //! Modify the tolerance for stopping the optimization during training.
   double& Tolerance() { return tolerance; }
 
+  //! Get the fraction of points used to train each weak learner.
+  double SampleFraction() const { return sampleFraction; }
+  //! Modify the fraction of points used to train each weak learner (must be
+  //! in (0, 1]).  If less than 1, each boosting round trains its weak learner
+  //! on a weight-proportional sample of this fraction of the dataset instead
+  //! of the fully weighted dataset, which is much faster on large datasets at
+  //! a small cost in accuracy.  Set before calling Train().
+  double& SampleFraction() { return sampleFraction; }
+
   //! Get the number of classes this model is trained on.
   size_t NumClasses() const { return numClasses; }
 
@@ -151,7 +163,9 @@ class AdaBoost
                const double tolerance = 1e-6);
 
   /**
-   * Classify the given test points.
+   * Classify the given test points.  This method is const and keeps all
+   * scratch state on the stack, so a single trained model can be shared by
+   * concurrent threads that each call Classify().
    *
    * @param test Testing data.
    * @param predictedLabels Vector in which the predicted labels of the test
@@ -161,17 +175,42 @@ class AdaBoost
    */
   void Classify(const MatType& test,
                 arma::Row<size_t>& predictedLabels,
-                arma::mat& probabilities);
+                arma::mat& probabilities) const;
 
   /**
-   * Classify the given test points.
+   * Classify the given test points.  This method is const and keeps all
+   * scratch state on the stack, so a single trained model can be shared by
+   * concurrent threads that each call Classify().
    *
    * @param test Testing data.
    * @param predictedLabels Vector in which the predicted labels of the test
    *      set will be stored.
    */
   void Classify(const MatType& test,
-                arma::Row<size_t>& predictedLabels);
+                arma::Row<size_t>& predictedLabels) const;
+
+  /**
+   * Classify the given test points with an early-exit cascade.  The weak
+   * learners are evaluated in order of decreasing weight, and a point stops
+   * being evaluated as soon as the lead of its best class over its runner-up
+   * exceeds the total weight of the remaining learners (scaled by the given
+   * confidence), since the rest of the ensemble can then no longer flip the
+   * decision.  Each stage is evaluated over the surviving points in one
+   * batched Classify() call, so on easy data most points exit after a few
+   * stages and most stages see only a few points.
+   *
+   * @param test Testing data.
+   * @param predictedLabels Vector in which the predicted labels of the test
+   *      set will be stored.
+   * @param confidence Fraction of the remaining weight that must be unable
+   *      to flip the decision before a point exits.  With the default of 1 a
+   *      point only exits when a flip is impossible, so the predictions match
+   *      Classify() exactly; smaller values exit earlier at the risk of an
+   *      occasional flipped prediction.  Must be in (0, 1].
+   */
+  void ClassifyCascade(const MatType& test,
+                       arma::Row<size_t>& predictedLabels,
+                       const double confidence = 1.0) const;
 
   /**
    * Serialize the AdaBoost model.
@@ -180,10 +219,31 @@ class AdaBoost
   void serialize(Archive& ar, const uint32_t /* version */);
 
  private:
+  /**
+   * Train a weak learner on a weight-proportional sample of the data.  The
+   * sample is drawn with replacement, so the instance weights are folded into
+   * the sampling probabilities and the learner itself is trained with uniform
+   * weights.
+   *
+   * @param other Weak learner to take the training parameters from.
+   * @param data Full dataset to sample from.
+   * @param labels Labels for each point in the dataset.
+   * @param weights Current boosting weight of each point.
+   * @return The trained weak learner.
+   */
+  WeakLearnerType TrainSampledLearner(const WeakLearnerType& other,
+                                      const MatType& data,
+                                      const arma::Row<size_t>& labels,
+                                      const arma::rowvec& weights) const;
+
   //! The number of classes in the model.
   size_t numClasses;
   // The tolerance for change in rt and when to stop.
   double tolerance;
+  //! The fraction of points each weak learner is trained on; if less than 1,
+  //! each round draws a weight-proportional sample instead of training on the
+  //! fully weighted dataset.
+  double sampleFraction;
 
   //! The vector of weak learners.
   std::vector<WeakLearnerType> wl;
@@ -47,7 +47,8 @@ AdaBoost<WeakLearnerType, MatType>::AdaBoost(
     const size_t numClasses,
     const WeakLearnerType& other,
     const size_t iterations,
-    const double tol)
+    const double tol) :
+    sampleFraction(1.0)
 {
   Train(data, labels, numClasses, other, iterations, tol);
 }
@@ -56,7 +57,8 @@ AdaBoost<WeakLearnerType, MatType>::AdaBoost(
 template<typename WeakLearnerType, typename MatType>
 AdaBoost<WeakLearnerType, MatType>::AdaBoost(const double tolerance) :
     numClasses(0),
-    tolerance(tolerance)
+    tolerance(tolerance),
+    sampleFraction(1.0)
 {
   // Nothing to do.
 }
@@ -71,6 +73,10 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
     const size_t iterations,
     const double tolerance)
 {
+  if (sampleFraction <= 0.0 || sampleFraction > 1.0)
+    throw std::invalid_argument("AdaBoost::Train(): sample fraction must be "
+        "in the range (0, 1]");
+
   // Clear information from previous runs.
   wl.clear();
   alpha.clear();
@@ -119,15 +125,21 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
     // Build the weight vectors.
     weights = arma::sum(D);
 
-    // Use the existing weak learner to train a new one with new weights.
-    WeakLearnerType w(other, tempData, labels, numClasses, weights);
+    // Use the existing weak learner to train a new one with new weights; if
+    // subsampling is enabled, the weights are folded into a weight
+    // proportional sample instead.
+    WeakLearnerType w = (sampleFraction < 1.0) ?
+        TrainSampledLearner(other, tempData, labels, weights) :
+        WeakLearnerType(other, tempData, labels, numClasses, weights);
     w.Classify(tempData, predictedLabels);
 
     // Now from predictedLabels, build ht, the weak hypothesis
     // buildClassificationMatrix(ht, predictedLabels);
 
-    // Now, calculate alpha(t) using ht.
-    for (size_t j = 0; j < D.n_cols; ++j) // instead of D, ht
+    // Now, calculate alpha(t) using ht.  Each column contributes
+    // independently, so the sweep can run in parallel.
+    #pragma omp parallel for reduction(+:rt)
+    for (omp_size_t j = 0; j < (omp_size_t) D.n_cols; ++j) // instead of D, ht
     {
       if (predictedLabels(j) == labels(j))
         rt += arma::accu(D.col(j));
@@ -156,10 +168,12 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
     alpha.push_back(alphat);
     wl.push_back(w);
 
-    // Now start modifying the weights.
-    for (size_t j = 0; j < D.n_cols; ++j)
+    // Now start modifying the weights.  Each column of D and sumFinalH is
+    // touched by exactly one iteration, so the sweep can run in parallel.
+    const double expo = exp(alphat);
+    #pragma omp parallel for reduction(+:zt)
+    for (omp_size_t j = 0; j < (omp_size_t) D.n_cols; ++j)
     {
-      const double expo = exp(alphat);
       if (predictedLabels(j) == labels(j))
       {
         for (size_t k = 0; k < D.n_rows; ++k)
@@ -202,13 +216,48 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
   return ztProduct;
 }
 
+// Train a weak learner on a weight-proportional sample of the data.
+template<typename WeakLearnerType, typename MatType>
+WeakLearnerType AdaBoost<WeakLearnerType, MatType>::TrainSampledLearner(
+    const WeakLearnerType& other,
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const arma::rowvec& weights) const
+{
+  const size_t sampleSize = std::max((size_t) 1,
+      (size_t) std::round(sampleFraction * data.n_cols));
+
+  // Draw the sample with replacement, with probability proportional to the
+  // boosting weights, by inverting the cumulative weight distribution.
+  const arma::rowvec cumulative = arma::cumsum(weights);
+  const double total = cumulative[cumulative.n_elem - 1];
+
+  arma::uvec indices(sampleSize);
+  for (size_t j = 0; j < sampleSize; ++j)
+  {
+    const double u = math::Random() * total;
+    indices[j] = std::lower_bound(cumulative.begin(), cumulative.end(), u) -
+        cumulative.begin();
+  }
+
+  // The weights are already represented by the sampling probabilities, so the
+  // learner itself trains with uniform weights.
+  const MatType sampleData = data.cols(indices);
+  const arma::Row<size_t> sampleLabels = labels.cols(indices);
+  arma::rowvec sampleWeights(sampleSize);
+  sampleWeights.fill(1.0 / sampleSize);
+
+  return WeakLearnerType(other, sampleData, sampleLabels, numClasses,
+      sampleWeights);
+}
+
 /**
  * Classify the given test points.
  */
 template<typename WeakLearnerType, typename MatType>
 void AdaBoost<WeakLearnerType, MatType>::Classify(
     const MatType& test,
-    arma::Row<size_t>& predictedLabels)
+    arma::Row<size_t>& predictedLabels) const
 {
   arma::Row<size_t> tempPredictedLabels(test.n_cols);
   arma::mat probabilities;
@@ -223,7 +272,7 @@ template<typename WeakLearnerType, typename MatType>
 void AdaBoost<WeakLearnerType, MatType>::Classify(
     const MatType& test,
     arma::Row<size_t>& predictedLabels,
-    arma::mat& probabilities)
+    arma::mat& probabilities) const
 {
   arma::Row<size_t> tempPredictedLabels(test.n_cols);
 
@@ -250,6 +299,87 @@ void AdaBoost<WeakLearnerType, MatType>::Classify(
   }
 }
 
+/**
+ * Classify the given test points with an early-exit cascade.
+ */
+template<typename WeakLearnerType, typename MatType>
+void AdaBoost<WeakLearnerType, MatType>::ClassifyCascade(
+    const MatType& test,
+    arma::Row<size_t>& predictedLabels,
+    const double confidence) const
+{
+  if (confidence <= 0.0 || confidence > 1.0)
+    throw std::invalid_argument("AdaBoost::ClassifyCascade(): confidence must "
+        "be in the range (0, 1]");
+
+  predictedLabels.set_size(test.n_cols);
+
+  // Evaluate the strongest learners first, so that easy points can exit
+  // after only a few stages.
+  const arma::uvec order = arma::sort_index(arma::vec(alpha), "descend");
+
+  // remaining(s) is the total weight of the stages after stage s: once a
+  // point's vote margin exceeds it, the rest of the cascade cannot flip the
+  // decision.
+  arma::vec remaining(order.n_elem);
+  if (order.n_elem > 0)
+  {
+    remaining(order.n_elem - 1) = 0.0;
+    for (size_t s = order.n_elem - 1; s > 0; --s)
+      remaining(s - 1) = remaining(s) + alpha[order[s]];
+  }
+
+  // Weighted votes of every point, and the points still in the cascade.
+  arma::mat votes = arma::zeros<arma::mat>(numClasses, test.n_cols);
+  arma::uvec alive;
+  if (test.n_cols > 0)
+    alive = arma::regspace<arma::uvec>(0, 1, test.n_cols - 1);
+
+  arma::Row<size_t> stageLabels;
+  for (size_t s = 0; s < order.n_elem && alive.n_elem > 0; ++s)
+  {
+    // Evaluate this stage over the surviving subset in one batched call.
+    const MatType subset = test.cols(alive);
+    wl[order[s]].Classify(subset, stageLabels);
+
+    const double weight = alpha[order[s]];
+    for (size_t j = 0; j < alive.n_elem; ++j)
+      votes(stageLabels(j), alive[j]) += weight;
+
+    // Retire every surviving point whose current margin cannot be overturned
+    // by the weight that is still to come.
+    const double exitBound = confidence * remaining(s);
+    size_t kept = 0;
+    for (size_t j = 0; j < alive.n_elem; ++j)
+    {
+      const size_t point = alive[j];
+      arma::uword best;
+      const double bestVote = votes.col(point).max(best);
+      double secondVote = -DBL_MAX;
+      for (size_t k = 0; k < numClasses; ++k)
+      {
+        if (k != best && votes(k, point) > secondVote)
+          secondVote = votes(k, point);
+      }
+
+      if (bestVote - secondVote > exitBound)
+        predictedLabels(point) = best;
+      else
+        alive[kept++] = point;
+    }
+    alive.resize(kept);
+  }
+
+  // Finalize any points that reached the end of the cascade without a
+  // decisive margin.
+  for (size_t j = 0; j < alive.n_elem; ++j)
+  {
+    arma::uword best;
+    votes.col(alive[j]).max(best);
+    predictedLabels(alive[j]) = best;
+  }
+}
+
 /**
  * Serialize the AdaBoost model.
  */
@@ -260,6 +390,7 @@ void AdaBoost<WeakLearnerType, MatType>::serialize(Archive& ar,
 {
   ar(CEREAL_NVP(numClasses));
   ar(CEREAL_NVP(tolerance));
+  ar(CEREAL_NVP(sampleFraction));
   ar(CEREAL_NVP(alpha));
 
   // Now serialize each weak learner.
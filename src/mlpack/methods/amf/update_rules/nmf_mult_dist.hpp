@@ -35,6 +35,15 @@ namespace amf {
  * This is a multiplicative rule that ensures that the Frobenius norm
  * \f$ \sqrt{\sum_i \sum_j(V-WH)^2} \f$ is non-increasing between subsequent
  * iterations. Both of the update rules for W and H are defined in this file.
+ *
+ * Although the denominators of the update rules contain the product \f$ WH \f$,
+ * the dense \f$ n \times m \f$ matrix is never formed: the products are
+ * grouped so that only the small rank-by-rank Gram matrices \f$ HH^T \f$ and
+ * \f$ W^TW \f$ are materialized.  This makes these rules suitable for very
+ * large sparse inputs, where a dense \f$ WH \f$ would not fit in memory.
+ * The intermediate matrices are held as workspace members and reused across
+ * iterations, so no per-iteration allocations are made after the first
+ * iteration.
  */
 class NMFMultiplicativeDistanceUpdate
 {
@@ -43,20 +52,27 @@ class NMFMultiplicativeDistanceUpdate
   NMFMultiplicativeDistanceUpdate() { }
 
   /**
-   * Initialize the factorization.  These update rules hold no information, so
-   * the input parameters are ignored.
+   * Initialize the factorization.  The workspace matrices are sized here, so
+   * that the per-iteration updates do not allocate.
+   *
+   * @param dataset Input matrix to be factorized.
+   * @param rank Rank of the factorization.
    */
   template<typename MatType>
-  void Initialize(const MatType& /* dataset */, const size_t /* rank */)
+  void Initialize(const MatType& dataset, const size_t rank)
   {
-    // Nothing to do.
+    gram.set_size(rank, rank);
+    wNumerator.set_size(dataset.n_rows, rank);
+    wDenominator.set_size(dataset.n_rows, rank);
+    hNumerator.set_size(rank, dataset.n_cols);
+    hDenominator.set_size(rank, dataset.n_cols);
   }
 
   /**
-   * The update rule for the basis matrix W. The formula used isa
+   * The update rule for the basis matrix W. The formula used is
    *
    * \f[
-   * W_{ia} \leftarrow W_{ia} \frac{(VH^T)_{ia}}{(WHH^T)_{ia}}
+   * W_{ia} \leftarrow W_{ia} \frac{(VH^T)_{ia}}{(W(HH^T))_{ia}}
    * \f]
    *
    * The function takes in all the matrices and only changes the value of the W
@@ -67,18 +83,23 @@ class NMFMultiplicativeDistanceUpdate
    * @param H Encoding matrix.
    */
   template<typename MatType>
-  inline static void WUpdate(const MatType& V,
-                             arma::mat& W,
-                             const arma::mat& H)
+  inline void WUpdate(const MatType& V,
+                      arma::mat& W,
+                      const arma::mat& H)
   {
-    W = (W % (V * H.t())) / (W * H * H.t());
+    // The denominator (WH)H^T is evaluated as W(HH^T), so that only the
+    // rank-by-rank Gram matrix is formed instead of the dense product WH.
+    gram = H * H.t();
+    MultiplyVHt(V, H);
+    wDenominator = W * gram;
+    W %= wNumerator / wDenominator;
   }
 
   /**
    * The update rule for the encoding matrix H. The formula used is
    *
    * \f[
-   * H_{a\mu} \leftarrow H_{a\mu} \frac{(W^T V)_{a\mu}}{(W^T WH)_{a\mu}}
+   * H_{a\mu} \leftarrow H_{a\mu} \frac{(W^T V)_{a\mu}}{((W^TW)H)_{a\mu}}
    * \f]
    *
    * The function takes in all the matrices and only changes the value of the H
@@ -89,16 +110,78 @@ class NMFMultiplicativeDistanceUpdate
    * @param H Encoding matrix to be updated.
    */
   template<typename MatType>
-  inline static void HUpdate(const MatType& V,
-                             const arma::mat& W,
-                             arma::mat& H)
+  inline void HUpdate(const MatType& V,
+                      const arma::mat& W,
+                      arma::mat& H)
   {
-    H = (H % (W.t() * V)) / (W.t() * W * H);
+    // The denominator W^T(WH) is evaluated as (W^TW)H; see WUpdate().
+    gram = W.t() * W;
+    MultiplyWtV(V, W);
+    hDenominator = gram * H;
+    H %= hNumerator / hDenominator;
   }
 
-  //! Serialize the object (in this case, there is nothing to serialize).
+  //! Serialize the object (the workspace matrices are scratch space, so there
+  //! is nothing to serialize).
   template<typename Archive>
   void serialize(Archive& /* ar */, const uint32_t /* version */) { }
+
+ private:
+  /**
+   * Compute the numerator V * H^T of the W update.  For dense inputs this is
+   * a single (BLAS-parallelized) matrix product.
+   */
+  template<typename eT>
+  void MultiplyVHt(const arma::Mat<eT>& V, const arma::mat& H)
+  {
+    wNumerator = V * H.t();
+  }
+
+  /**
+   * Compute the numerator V * H^T of the W update for sparse inputs.
+   * Armadillo's sparse-dense product is not parallelized, so the product is
+   * computed one rank at a time, with OpenMP across ranks.
+   */
+  template<typename eT>
+  void MultiplyVHt(const arma::SpMat<eT>& V, const arma::mat& H)
+  {
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t a = 0; a < (omp_size_t) H.n_rows; ++a)
+      wNumerator.col(a) = arma::vec(V * arma::trans(H.row(a)));
+  }
+
+  /**
+   * Compute the numerator W^T * V of the H update.  For dense inputs this is
+   * a single (BLAS-parallelized) matrix product.
+   */
+  template<typename eT>
+  void MultiplyWtV(const arma::Mat<eT>& V, const arma::mat& W)
+  {
+    hNumerator = W.t() * V;
+  }
+
+  /**
+   * Compute the numerator W^T * V of the H update for sparse inputs, one rank
+   * at a time with OpenMP across ranks; see MultiplyVHt().
+   */
+  template<typename eT>
+  void MultiplyWtV(const arma::SpMat<eT>& V, const arma::mat& W)
+  {
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t a = 0; a < (omp_size_t) W.n_cols; ++a)
+      hNumerator.row(a) = arma::rowvec(arma::trans(W.col(a)) * V);
+  }
+
+  //! Rank-by-rank Gram matrix workspace (HH^T or W^TW).
+  arma::mat gram;
+  //! Workspace for the numerator of the W update.
+  arma::mat wNumerator;
+  //! Workspace for the denominator of the W update.
+  arma::mat wDenominator;
+  //! Workspace for the numerator of the H update.
+  arma::mat hNumerator;
+  //! Workspace for the denominator of the H update.
+  arma::mat hDenominator;
 };
 
 } // namespace amf
@@ -0,0 +1,128 @@
+/**
+ * @file methods/ann/activation_functions/fast_math.hpp
+ *
+ * Fast polynomial approximations of exp() and log() for use in activation
+ * functions.  The implementations are branch-free over their main range and
+ * contain no calls into libm, so compilers can auto-vectorize element-wise
+ * loops over them (AVX2/NEON where available).
+ *
+ * The activation functors only use these approximations when
+ * MLPACK_ANN_FAST_ACTIVATIONS is defined; the accuracy of the approximations
+ * themselves is selected at compile time:
+ *
+ *  - default: maximum relative error of roughly 1e-13 for FastExp() and
+ *    1e-11 for FastLog() (a few ULPs);
+ *  - with MLPACK_ANN_FAST_ACTIVATIONS_LOW_PRECISION defined: shorter
+ *    polynomials with maximum relative error of roughly 2.5e-6 for FastExp()
+ *    and 1e-7 for FastLog(), trading accuracy for speed.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_ACTIVATION_FUNCTIONS_FAST_MATH_HPP
+#define MLPACK_METHODS_ANN_ACTIVATION_FUNCTIONS_FAST_MATH_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <cstring>
+
+namespace mlpack {
+namespace ann {
+
+/**
+ * Compute an approximation of exp(x).
+ *
+ * The input is reduced to exp(x) = 2^n * exp(r) with |r| <= ln(2) / 2; the
+ * residual factor is evaluated with a polynomial and the power of two is
+ * applied by assembling the exponent bits directly.  Inputs outside
+ * [-708, 708] are clamped, so the result saturates instead of producing 0 or
+ * infinity.
+ *
+ * @param x Input value.
+ * @return Approximation of e^x.
+ */
+inline double FastExp(const double x)
+{
+  // Clamp to the range where the exact result is finite and normal.
+  const double xc = std::max(-708.0, std::min(708.0, x));
+
+  // Split xc = n * ln(2) + r with |r| <= ln(2) / 2.  The two-part
+  // representation of ln(2) keeps the reduction error below the polynomial
+  // error.
+  const double n = std::floor(xc * 1.4426950408889634074 + 0.5);
+  const double r = (xc - n * 6.93147180369123816490e-01) -
+      n * 1.90821492927058770002e-10;
+
+  // Evaluate exp(r) with a truncated Taylor polynomial in Horner form.
+#ifdef MLPACK_ANN_FAST_ACTIVATIONS_LOW_PRECISION
+  // Degree 5: maximum relative error is about 2.5e-6.
+  const double p = 1.0 + r * (1.0 + r * (1.0 / 2.0 + r * (1.0 / 6.0 +
+      r * (1.0 / 24.0 + r * (1.0 / 120.0)))));
+#else
+  // Degree 9: maximum relative error is about 1e-13.
+  const double p = 1.0 + r * (1.0 + r * (1.0 / 2.0 + r * (1.0 / 6.0 +
+      r * (1.0 / 24.0 + r * (1.0 / 120.0 + r * (1.0 / 720.0 +
+      r * (1.0 / 5040.0 + r * (1.0 / 40320.0 + r * (1.0 / 362880.0)))))))));
+#endif
+
+  // Assemble 2^n from its exponent bits and apply it.
+  const int64_t bits = ((int64_t) n + 1023) << 52;
+  double scale;
+  std::memcpy(&scale, &bits, sizeof(scale));
+
+  return p * scale;
+}
+
+/**
+ * Compute an approximation of the natural logarithm of x.
+ *
+ * The input is decomposed into x = m * 2^n with m in [sqrt(2) / 2, sqrt(2));
+ * log(m) is evaluated through the series of atanh((m - 1) / (m + 1)).
+ * Non-positive, subnormal, and non-finite inputs are delegated to std::log().
+ *
+ * @param x Input value.
+ * @return Approximation of ln(x).
+ */
+inline double FastLog(const double x)
+{
+  // The bit decomposition below is only valid for positive normal values.
+  if (!(x >= 2.2250738585072014e-308) || !std::isfinite(x))
+    return std::log(x);
+
+  // Extract the exponent and build the mantissa m in [1, 2).
+  int64_t bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  double n = (double) (((bits >> 52) & 0x7FF) - 1023);
+  int64_t mantissaBits = (bits & 0x000FFFFFFFFFFFFFLL) |
+      0x3FF0000000000000LL;
+  double m;
+  std::memcpy(&m, &mantissaBits, sizeof(m));
+
+  // Renormalize to [sqrt(2) / 2, sqrt(2)) so that s below is small.
+  if (m > 1.4142135623730951)
+  {
+    m *= 0.5;
+    n += 1.0;
+  }
+
+  // log(m) = 2 atanh(s) = 2 s (1 + s^2 / 3 + s^4 / 5 + ...).
+  const double s = (m - 1.0) / (m + 1.0);
+  const double s2 = s * s;
+#ifdef MLPACK_ANN_FAST_ACTIVATIONS_LOW_PRECISION
+  // Maximum relative error is about 1e-7.
+  const double logM = 2.0 * s * (1.0 + s2 * (1.0 / 3.0 + s2 * (1.0 / 5.0)));
+#else
+  // Maximum relative error is about 1e-11.
+  const double logM = 2.0 * s * (1.0 + s2 * (1.0 / 3.0 + s2 * (1.0 / 5.0 +
+      s2 * (1.0 / 7.0 + s2 * (1.0 / 9.0 + s2 * (1.0 / 11.0))))));
+#endif
+
+  return n * 0.69314718055994530942 + logM;
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
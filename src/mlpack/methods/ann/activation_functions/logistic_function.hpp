@@ -14,6 +14,8 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "fast_math.hpp"
+
 namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
 
@@ -58,7 +60,15 @@ class LogisticFunction
   template<typename InputVecType, typename OutputVecType>
   static void Fn(const InputVecType& x, OutputVecType& y)
   {
+#ifdef MLPACK_ANN_FAST_ACTIVATIONS
+    // Element-wise loop over the vectorizable exp() approximation; FastExp()
+    // saturates for large inputs, so no range checks are needed.
+    y.set_size(arma::size(x));
+    for (size_t i = 0; i < x.n_elem; ++i)
+      y(i) = 1.0 / (1.0 + FastExp(-x(i)));
+#else
     y = (1.0 / (1 + arma::exp(-x)));
+#endif
   }
 
   /**
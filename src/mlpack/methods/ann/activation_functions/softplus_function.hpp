@@ -28,6 +28,8 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "fast_math.hpp"
+
 namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
 
@@ -68,8 +70,15 @@ class SoftplusFunction
   {
     y.set_size(arma::size(x));
 
+#ifdef MLPACK_ANN_FAST_ACTIVATIONS
+    // Where e^x would overflow, f(x) = x to double precision; the branch
+    // compiles to a select, so the loop can still vectorize.
+    for (size_t i = 0; i < x.n_elem; ++i)
+      y(i) = (x(i) > 708.0) ? x(i) : FastLog(1.0 + FastExp(x(i)));
+#else
     for (size_t i = 0; i < x.n_elem; ++i)
       y(i) = Fn(x(i));
+#endif
   }
 
   /**
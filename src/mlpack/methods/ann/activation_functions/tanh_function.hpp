@@ -14,6 +14,8 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "fast_math.hpp"
+
 namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
 
@@ -49,7 +51,15 @@ class TanhFunction
   template<typename InputVecType, typename OutputVecType>
   static void Fn(const InputVecType& x, OutputVecType& y)
   {
+#ifdef MLPACK_ANN_FAST_ACTIVATIONS
+    // tanh(x) = 1 - 2 / (e^{2x} + 1); FastExp() saturates for large inputs,
+    // so the result correctly approaches +/- 1.
+    y.set_size(arma::size(x));
+    for (size_t i = 0; i < x.n_elem; ++i)
+      y(i) = 1.0 - 2.0 / (FastExp(2.0 * x(i)) + 1.0);
+#else
     y = arma::tanh(x);
+#endif
   }
 
   /**
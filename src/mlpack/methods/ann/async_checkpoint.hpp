@@ -0,0 +1,175 @@
+/**
+ * @file methods/ann/async_checkpoint.hpp
+ *
+ * Definition of the AsyncCheckpointer class, which periodically writes a
+ * snapshot of a model to disk from a background thread so that the training
+ * loop does not stall on serialization or disk I/O.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_ASYNC_CHECKPOINT_HPP
+#define MLPACK_METHODS_ANN_ASYNC_CHECKPOINT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/format.hpp>
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * The AsyncCheckpointer writes checkpoints of a model (e.g. an FFN or RNN)
+ * without blocking the training loop.  Checkpoint() takes a snapshot of the
+ * model on the calling thread---a plain copy, which is just a memcpy of the
+ * parameter matrix plus the small layer objects---and hands it to a
+ * long-lived background thread that serializes it with data::Save().  The
+ * expensive part of a checkpoint (archive conversion and disk I/O) therefore
+ * overlaps with training instead of stalling it.
+ *
+ * Checkpoints are crash consistent: the writer thread serializes to a
+ * temporary file next to the target and atomically renames it over the
+ * target, so the checkpoint file on disk is always either the previous or
+ * the new snapshot, never a partial write.  The optimizer state, if given,
+ * is written the same way to a companion file (the checkpoint filename plus
+ * the ".state" suffix).
+ *
+ * If a new snapshot arrives while the writer is still busy with the previous
+ * one, the not-yet-written snapshot is replaced; only the most recent
+ * snapshot is ever written (latest wins).  The destructor flushes any
+ * pending snapshot before joining the writer thread.
+ *
+ * A sample usage of the class:
+ *
+ * @code
+ * AsyncCheckpointer<FFN<>> checkpointer("model.bin");
+ * for (size_t epoch = 0; epoch < maxEpochs; ++epoch)
+ * {
+ *   model.Train(trainData, trainLabels, optimizer);
+ *   checkpointer.Checkpoint(model);
+ * }
+ * checkpointer.Wait();
+ * @endcode
+ *
+ * @tparam ModelType The type of the model to checkpoint.  The type must be
+ *     copy constructible and serializable with data::Save().
+ */
+template<typename ModelType>
+class AsyncCheckpointer
+{
+ public:
+  /**
+   * Create the checkpointer and start the background writer thread.
+   *
+   * @param filename Name of the checkpoint file.  The extension selects the
+   *     serialization format (".bin", ".xml" or ".json"); an unknown
+   *     extension falls back to the binary format.
+   * @param name Name of the structure inside the archive; pass the same name
+   *     to data::Load() to restore the checkpoint.
+   */
+  AsyncCheckpointer(const std::string& filename,
+                    const std::string& name = "model");
+
+  /**
+   * Flush any pending snapshot and join the background writer thread.
+   */
+  ~AsyncCheckpointer();
+
+  /**
+   * Snapshot the given model and schedule it for writing.  The model is
+   * copied on the calling thread; the serialization and the disk write
+   * happen on the background thread.  If a snapshot is already waiting to
+   * be written, it is replaced by this one.
+   *
+   * @param model The model to checkpoint.
+   */
+  void Checkpoint(const ModelType& model);
+
+  /**
+   * Snapshot the given model together with the flattened optimizer state and
+   * schedule both for writing.  The optimizer state is written to a
+   * companion file named after the checkpoint file plus the ".state" suffix,
+   * in armadillo binary format.
+   *
+   * @param model The model to checkpoint.
+   * @param optimizerState Flattened optimizer state (e.g. moment estimates)
+   *     to store next to the model.
+   */
+  void Checkpoint(const ModelType& model, const arma::mat& optimizerState);
+
+  /**
+   * Block until every scheduled snapshot has been written to disk.
+   */
+  void Wait();
+
+  //! Get the number of checkpoints written to disk so far.
+  size_t CheckpointsWritten();
+
+  //! Get the checkpoint filename.
+  const std::string& Filename() const { return filename; }
+
+ private:
+  //! Body of the background writer thread.
+  void WriterLoop();
+
+  //! Serialize the given snapshot and atomically swap it into place.
+  void WriteSnapshot(ModelType& model,
+                     const bool writeState,
+                     const arma::mat& optimizerState);
+
+  //! The name of the checkpoint file.
+  std::string filename;
+
+  //! The name of the structure inside the archive.
+  std::string name;
+
+  //! The serialization format, derived from the filename extension.
+  data::format saveFormat;
+
+  //! The snapshot waiting to be written, if any.
+  std::unique_ptr<ModelType> snapshot;
+
+  //! The optimizer state belonging to the pending snapshot.
+  arma::mat stateSnapshot;
+
+  //! Whether the pending snapshot carries optimizer state.
+  bool hasState;
+
+  //! Whether a snapshot is waiting to be written.
+  bool pending;
+
+  //! Whether the writer thread is currently serializing a snapshot.
+  bool writing;
+
+  //! Whether the writer thread should terminate.
+  bool stop;
+
+  //! The number of checkpoints written to disk.
+  size_t checkpointsWritten;
+
+  //! Guards the snapshot slot and the flags above.
+  std::mutex mutex;
+
+  //! Wakes the writer thread when a snapshot is scheduled.
+  std::condition_variable wakeWriter;
+
+  //! Wakes Wait() when the writer finishes a snapshot.
+  std::condition_variable writeDone;
+
+  //! The background writer thread.
+  std::thread writer;
+}; // class AsyncCheckpointer
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "async_checkpoint_impl.hpp"
+
+#endif
@@ -0,0 +1,165 @@
+/**
+ * @file methods/ann/async_checkpoint_impl.hpp
+ *
+ * Implementation of the AsyncCheckpointer class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_ASYNC_CHECKPOINT_IMPL_HPP
+#define MLPACK_METHODS_ANN_ASYNC_CHECKPOINT_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "async_checkpoint.hpp"
+
+#include <mlpack/core/data/extension.hpp>
+#include <mlpack/core/data/save.hpp>
+
+#include <cstdio>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename ModelType>
+AsyncCheckpointer<ModelType>::AsyncCheckpointer(const std::string& filename,
+                                                const std::string& name) :
+    filename(filename),
+    name(name),
+    hasState(false),
+    pending(false),
+    writing(false),
+    stop(false),
+    checkpointsWritten(0)
+{
+  const std::string extension = data::Extension(filename);
+  if (extension == "xml")
+    saveFormat = data::format::xml;
+  else if (extension == "json")
+    saveFormat = data::format::json;
+  else if (extension == "bin")
+    saveFormat = data::format::binary;
+  else
+  {
+    Log::Warn << "AsyncCheckpointer: unknown extension '" << extension
+        << "' for checkpoint file '" << filename << "'; the binary format "
+        << "will be used." << std::endl;
+    saveFormat = data::format::binary;
+  }
+
+  writer = std::thread([this]() { this->WriterLoop(); });
+}
+
+template<typename ModelType>
+AsyncCheckpointer<ModelType>::~AsyncCheckpointer()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+  wakeWriter.notify_one();
+  writer.join();
+}
+
+template<typename ModelType>
+void AsyncCheckpointer<ModelType>::Checkpoint(const ModelType& model)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    snapshot.reset(new ModelType(model));
+    hasState = false;
+    pending = true;
+  }
+  wakeWriter.notify_one();
+}
+
+template<typename ModelType>
+void AsyncCheckpointer<ModelType>::Checkpoint(const ModelType& model,
+                                              const arma::mat& optimizerState)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    snapshot.reset(new ModelType(model));
+    stateSnapshot = optimizerState;
+    hasState = true;
+    pending = true;
+  }
+  wakeWriter.notify_one();
+}
+
+template<typename ModelType>
+void AsyncCheckpointer<ModelType>::Wait()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  writeDone.wait(lock, [this]() { return !pending && !writing; });
+}
+
+template<typename ModelType>
+size_t AsyncCheckpointer<ModelType>::CheckpointsWritten()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return checkpointsWritten;
+}
+
+template<typename ModelType>
+void AsyncCheckpointer<ModelType>::WriterLoop()
+{
+  for (;;)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    wakeWriter.wait(lock, [this]() { return pending || stop; });
+
+    // Flush a pending snapshot even when shutting down.
+    if (!pending)
+      break;
+
+    std::unique_ptr<ModelType> local = std::move(snapshot);
+    const arma::mat localState = hasState ? std::move(stateSnapshot) :
+        arma::mat();
+    const bool writeState = hasState;
+    pending = false;
+    writing = true;
+    lock.unlock();
+
+    WriteSnapshot(*local, writeState, localState);
+
+    lock.lock();
+    writing = false;
+    ++checkpointsWritten;
+    lock.unlock();
+    writeDone.notify_all();
+  }
+}
+
+template<typename ModelType>
+void AsyncCheckpointer<ModelType>::WriteSnapshot(
+    ModelType& model,
+    const bool writeState,
+    const arma::mat& optimizerState)
+{
+  // Serialize next to the target and rename over it; the rename is atomic,
+  // so a crash mid-write leaves the previous checkpoint intact.
+  if (writeState)
+  {
+    const std::string stateFile = filename + ".state";
+    const std::string stateTmp = stateFile + ".tmp";
+    if (optimizerState.save(stateTmp, arma::arma_binary))
+      std::rename(stateTmp.c_str(), stateFile.c_str());
+    else
+      Log::Warn << "AsyncCheckpointer: failed to write optimizer state to '"
+          << stateTmp << "'!" << std::endl;
+  }
+
+  const std::string tmp = filename + ".tmp";
+  if (data::Save(tmp, name, model, false, saveFormat))
+    std::rename(tmp.c_str(), filename.c_str());
+  else
+    Log::Warn << "AsyncCheckpointer: failed to write checkpoint to '" << tmp
+        << "'!" << std::endl;
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -164,6 +164,40 @@ class BRNN
   template<typename OptimizerType = ens::StandardSGD>
   double Train(arma::cube predictors, arma::cube responses);
 
+  /**
+   * Train the bidirectional recurrent neural network on the given input data
+   * with length-bucketed batching and truncated backpropagation through
+   * time.
+   *
+   * The sequences are sorted by length and grouped into buckets of at most
+   * bucketSize sequences; each bucket is unrolled only to the length of the
+   * longest sequence it contains, so padding cost is bounded by the length
+   * spread within a bucket rather than by the longest sequence in the data.
+   * Buckets longer than Rho() are split into windows of at most Rho() steps
+   * that are trained as independent bidirectional segments.  In single
+   * response mode only the final window of each bucket is trained, since
+   * the earlier windows have no targets.
+   *
+   * The data format is the same as for Train(); sequences shorter than the
+   * number of slices are expected to be padded at the end, and
+   * sequenceLengths holds the unpadded length of each sequence (column).
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @param predictors Input training variables.
+   * @param responses Outputs results from input training variables.
+   * @param sequenceLengths Unpadded length of each input sequence.
+   * @param bucketSize Maximum number of sequences per bucket.
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @return The accumulated final objectives of the bucket optimizations
+   *      (NaN or Inf on error).
+   */
+  template<typename OptimizerType>
+  double TrainBucketed(arma::cube predictors,
+                       arma::cube responses,
+                       const arma::urowvec& sequenceLengths,
+                       const size_t bucketSize,
+                       OptimizerType& optimizer);
+
   /**
    * Predict the responses to a given set of predictors. The responses will
    * reflect the output of the given output layer as returned by the
@@ -182,6 +182,108 @@ double BRNN<OutputLayerType, MergeLayerType, MergeOutputType,
   return out;
 }
 
+template<typename OutputLayerType, typename MergeLayerType,
+         typename MergeOutputType, typename InitializationRuleType,
+         typename... CustomLayers>
+template<typename OptimizerType>
+double BRNN<OutputLayerType, MergeLayerType, MergeOutputType,
+    InitializationRuleType, CustomLayers...>::TrainBucketed(
+    arma::cube predictors,
+    arma::cube responses,
+    const arma::urowvec& sequenceLengths,
+    const size_t bucketSize,
+    OptimizerType& optimizer)
+{
+  if (sequenceLengths.n_elem != predictors.n_cols)
+  {
+    Log::Fatal << "BRNN<>::TrainBucketed(): the number of sequence lengths ("
+        << sequenceLengths.n_elem << ") does not match the number of "
+        << "sequences (" << predictors.n_cols << ")!" << std::endl;
+  }
+
+  if (bucketSize == 0)
+  {
+    Log::Fatal << "BRNN<>::TrainBucketed(): bucketSize must be greater than "
+        << "0!" << std::endl;
+  }
+
+  this->deterministic = true;
+  ResetDeterministic();
+
+  if (!reset)
+  {
+    ResetParameters();
+  }
+
+  WarnMessageMaxIterations<OptimizerType>(optimizer, bucketSize);
+
+  // Sort the sequences by length, so that each bucket holds sequences of
+  // similar length and is unrolled only to the longest one it contains.
+  const arma::uvec order = arma::sort_index(sequenceLengths);
+  const size_t maxRho = rho;
+  double objective = 0;
+
+  Timer::Start("BRNN_optimization");
+  for (size_t bucketBegin = 0; bucketBegin < order.n_elem;
+      bucketBegin += bucketSize)
+  {
+    const size_t bucketEnd = std::min(bucketBegin + bucketSize,
+        size_t(order.n_elem));
+    const arma::uvec bucket = order.subvec(bucketBegin, bucketEnd - 1);
+    const size_t bucketLength = std::max(size_t(1), std::min(
+        size_t(sequenceLengths(bucket(bucket.n_elem - 1))),
+        size_t(predictors.n_slices)));
+
+    // Gather the bucket into contiguous storage, trimmed to the length of
+    // its longest sequence; only the spread within the bucket is padded.
+    arma::cube bucketPredictors(predictors.n_rows, bucket.n_elem,
+        bucketLength);
+    for (size_t s = 0; s < bucketLength; ++s)
+      bucketPredictors.slice(s) = predictors.slice(s).cols(bucket);
+
+    arma::cube bucketResponses(responses.n_rows, bucket.n_elem,
+        single ? 1 : bucketLength);
+    for (size_t s = 0; s < bucketResponses.n_slices; ++s)
+      bucketResponses.slice(s) = responses.slice(s).cols(bucket);
+
+    // Split buckets longer than the configured rho into windows that are
+    // trained as independent bidirectional segments.  In single response
+    // mode only the final window has a target, so the earlier windows are
+    // skipped.
+    const size_t firstWindow = (single && bucketLength > maxRho) ?
+        bucketLength - maxRho : 0;
+    for (size_t windowBegin = firstWindow; windowBegin < bucketLength;
+        windowBegin += maxRho)
+    {
+      const size_t windowLength = std::min(maxRho,
+          bucketLength - windowBegin);
+
+      rho = windowLength;
+      numFunctions = bucket.n_elem;
+      this->predictors = bucketPredictors.slices(windowBegin,
+          windowBegin + windowLength - 1);
+      if (single)
+      {
+        this->responses = bucketResponses;
+      }
+      else
+      {
+        this->responses = bucketResponses.slices(windowBegin,
+            windowBegin + windowLength - 1);
+      }
+
+      objective += optimizer.Optimize(*this, parameter);
+    }
+  }
+  Timer::Stop("BRNN_optimization");
+
+  rho = maxRho;
+
+  Log::Info << "BRNN::TrainBucketed(): accumulated final objective of "
+      << "trained model is " << objective << "." << std::endl;
+  return objective;
+}
+
 template<typename OutputLayerType, typename MergeLayerType,
          typename MergeOutputType, typename InitializationRuleType,
          typename... CustomLayers>
@@ -167,18 +167,56 @@ class FFTConvolution
                           const arma::Cube<eT>& filter,
                           arma::Cube<eT>& output)
   {
-    arma::Mat<eT> convOutput;
-    FFTConvolution<BorderMode>::Convolution(input, filter.slice(0),
-        convOutput);
+    // All filter slices have the same shape, so the padded input and its
+    // transform can be computed once and reused for every slice.
+    arma::Mat<eT> inputPadded;
+    if (std::is_same<BorderMode, ValidConvolution>::value)
+    {
+      inputPadded = input;
 
-    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
-        filter.n_slices);
-    output.slice(0) = convOutput;
+      if (padLastDim)
+        inputPadded.resize(inputPadded.n_rows, inputPadded.n_cols + 1);
+    }
+    else
+    {
+      const size_t workingRows = input.n_rows + 2 * (filter.n_rows - 1);
+      size_t workingCols = input.n_cols + 2 * (filter.n_cols - 1);
+
+      if (padLastDim)
+        workingCols++;
 
-    for (size_t i = 1; i < filter.n_slices; ++i)
+      inputPadded = arma::zeros<arma::Mat<eT> >(workingRows, workingCols);
+      inputPadded.submat(filter.n_rows - 1, filter.n_cols - 1,
+          filter.n_rows - 1 + input.n_rows - 1,
+          filter.n_cols - 1 + input.n_cols - 1) = input;
+    }
+
+    const arma::Mat<std::complex<eT> > inputFFT = arma::fft2(inputPadded);
+
+    const size_t outputRows = std::is_same<BorderMode,
+        ValidConvolution>::value ?
+        input.n_rows - filter.n_rows + 1 :
+        input.n_rows + filter.n_rows - 1;
+    const size_t outputCols = std::is_same<BorderMode,
+        ValidConvolution>::value ?
+        input.n_cols - filter.n_cols + 1 :
+        input.n_cols + filter.n_cols - 1;
+
+    output = arma::Cube<eT>(outputRows, outputCols, filter.n_slices);
+    for (size_t i = 0; i < filter.n_slices; ++i)
     {
-      FFTConvolution<BorderMode>::Convolution(input, filter.slice(i),
-          output.slice(i));
+      arma::Mat<eT> filterPadded = filter.slice(i);
+      filterPadded.resize(inputPadded.n_rows, inputPadded.n_cols);
+
+      arma::Mat<eT> temp = arma::real(ifft2(inputFFT %
+          arma::fft2(filterPadded)));
+
+      // Extract the region of interest. We don't need to handle the
+      // padLastDim parameter in a special way we just cut it out from the
+      // output matrix.
+      output.slice(i) = temp.submat(filter.n_rows - 1, filter.n_cols - 1,
+          filter.n_rows - 1 + outputRows - 1,
+          filter.n_cols - 1 + outputCols - 1);
     }
   }
 
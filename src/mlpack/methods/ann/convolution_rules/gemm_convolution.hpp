@@ -0,0 +1,367 @@
+/**
+ * @file methods/ann/convolution_rules/gemm_convolution.hpp
+ *
+ * Implementation of the convolution through im2col and matrix multiplication.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_CONVOLUTION_RULES_GEMM_CONVOLUTION_HPP
+#define MLPACK_METHODS_ANN_CONVOLUTION_RULES_GEMM_CONVOLUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/ann/util/inference_backend.hpp>
+#include "border_modes.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Computes the two-dimensional convolution by rearranging the input into a
+ * patch matrix (im2col) and expressing the convolution as a matrix
+ * multiplication, which is delegated to the BLAS backend. This class allows
+ * specification of the type of the border type. The convolution can be
+ * computed with the valid border type or the full border type (default).
+ *
+ * FullConvolution: returns the full two-dimensional convolution.
+ * ValidConvolution: returns only those parts of the convolution that are
+ * computed without the zero-padded edges.
+ *
+ * The tensor overloads collapse as much work as possible into a single
+ * multiplication: when one input is convolved with a bank of filters the
+ * patch matrix is built once and shared by every filter, and when several
+ * inputs are convolved with one filter their patch matrices are concatenated
+ * so that a single product computes all output maps.  If an InferenceBackend
+ * is registered, these products are dispatched through it.
+ *
+ * @tparam BorderMode Type of the border mode (FullConvolution or
+ * ValidConvolution).
+ */
+template<typename BorderMode = FullConvolution>
+class GemmConvolution
+{
+ public:
+  /*
+   * Perform a convolution (valid mode) as a matrix multiplication.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT, typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, ValidConvolution>::value, void>::type
+  Convolution(const arma::Mat<eT>& input,
+              const arma::Mat<eT>& filter,
+              arma::Mat<eT>& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1)
+  {
+    arma::Mat<eT> patches;
+    size_t outputRows, outputCols;
+    Im2Col(input, filter.n_rows, filter.n_cols, dW, dH, dilationW, dilationH,
+        patches, outputRows, outputCols);
+
+    output = arma::reshape(arma::vectorise(filter).t() * patches, outputRows,
+        outputCols);
+  }
+
+  /*
+   * Perform a convolution (full mode) as a matrix multiplication.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT, typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, FullConvolution>::value, void>::type
+  Convolution(const arma::Mat<eT>& input,
+              const arma::Mat<eT>& filter,
+              arma::Mat<eT>& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1)
+  {
+    arma::Mat<eT> inputPadded;
+    PadFull(input, filter.n_rows, filter.n_cols, dW, dH, dilationW, dilationH,
+        inputPadded);
+
+    GemmConvolution<ValidConvolution>::Convolution(inputPadded, filter,
+        output, 1, 1, dilationW, dilationH);
+  }
+
+  /*
+   * Perform a convolution using 3rd order tensors. Each input slice is
+   * convolved with the corresponding filter slice, one multiplication per
+   * slice.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    GemmConvolution<BorderMode>::Convolution(input.slice(0), filter.slice(0),
+        convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; ++i)
+    {
+      GemmConvolution<BorderMode>::Convolution(input.slice(i),
+          filter.slice(i), output.slice(i), dW, dH, dilationW, dilationH);
+    }
+  }
+
+  /*
+   * Perform a convolution using dense matrix as input and a 3rd order tensors
+   * as filter and output. The patch matrix of the input is built once and all
+   * filter slices are applied with a single matrix multiplication.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Mat<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> patches;
+    size_t outputRows, outputCols;
+    if (std::is_same<BorderMode, FullConvolution>::value)
+    {
+      // All filter slices have the same shape, so the padded input can be
+      // built once and shared.
+      arma::Mat<eT> inputPadded;
+      PadFull(input, filter.n_rows, filter.n_cols, dW, dH, dilationW,
+          dilationH, inputPadded);
+      Im2Col(inputPadded, filter.n_rows, filter.n_cols, 1, 1, dilationW,
+          dilationH, patches, outputRows, outputCols);
+    }
+    else
+    {
+      Im2Col(input, filter.n_rows, filter.n_cols, dW, dH, dilationW,
+          dilationH, patches, outputRows, outputCols);
+    }
+
+    // Stack the vectorised filters as rows so that one multiplication
+    // produces every output map.
+    arma::Mat<eT> filters(filter.n_slices, filter.n_rows * filter.n_cols);
+    for (size_t i = 0; i < filter.n_slices; ++i)
+      filters.row(i) = arma::vectorise(filter.slice(i)).t();
+
+    arma::Mat<eT> result;
+    if (!InferenceBackend::Multiply(filters, patches, result))
+      result = filters * patches;
+
+    output = arma::Cube<eT>(outputRows, outputCols, filter.n_slices);
+    for (size_t i = 0; i < filter.n_slices; ++i)
+      output.slice(i) = arma::reshape(result.row(i), outputRows, outputCols);
+  }
+
+  /*
+   * Perform a convolution using a 3rd order tensors as input and output and a
+   * dense matrix as filter. The patch matrices of all input slices are
+   * concatenated so that a single multiplication computes every output slice.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Mat<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> patches;
+    size_t outputRows, outputCols;
+    SlicePatches(input.slice(0), filter, dW, dH, dilationW, dilationH,
+        patches, outputRows, outputCols);
+
+    arma::Mat<eT> allPatches(patches.n_rows, patches.n_cols * input.n_slices);
+    allPatches.cols(0, patches.n_cols - 1) = patches;
+    for (size_t i = 1; i < input.n_slices; ++i)
+    {
+      SlicePatches(input.slice(i), filter, dW, dH, dilationW, dilationH,
+          patches, outputRows, outputCols);
+      allPatches.cols(i * patches.n_cols, (i + 1) * patches.n_cols - 1) =
+          patches;
+    }
+
+    const arma::Mat<eT> filterRow = arma::vectorise(filter).t();
+    arma::Mat<eT> result;
+    if (!InferenceBackend::Multiply(filterRow, allPatches, result))
+      result = filterRow * allPatches;
+
+    output = arma::Cube<eT>(outputRows, outputCols, input.n_slices);
+    for (size_t i = 0; i < input.n_slices; ++i)
+    {
+      output.slice(i) = arma::reshape(result.cols(i * patches.n_cols,
+          (i + 1) * patches.n_cols - 1), outputRows, outputCols);
+    }
+  }
+
+ private:
+  /*
+   * Rearrange the input into a patch matrix (im2col, valid mode): column
+   * j * outputRows + i holds the vectorised receptive field of output element
+   * (i, j), in the same order as the vectorised filter.
+   */
+  template<typename eT>
+  static void Im2Col(const arma::Mat<eT>& input,
+                     const size_t filterRows,
+                     const size_t filterCols,
+                     const size_t dW,
+                     const size_t dH,
+                     const size_t dilationW,
+                     const size_t dilationH,
+                     arma::Mat<eT>& patches,
+                     size_t& outputRows,
+                     size_t& outputCols)
+  {
+    outputRows = (input.n_rows - (filterRows - 1) * dilationW - 1) / dW + 1;
+    outputCols = (input.n_cols - (filterCols - 1) * dilationH - 1) / dH + 1;
+
+    patches.set_size(filterRows * filterCols, outputRows * outputCols);
+    eT* patchPtr = patches.memptr();
+
+    for (size_t j = 0; j < outputCols; ++j)
+    {
+      for (size_t i = 0; i < outputRows; ++i)
+      {
+        for (size_t kj = 0; kj < filterCols; ++kj)
+        {
+          const eT* inputPtr = input.colptr(kj * dilationW + j * dW) + i * dH;
+          for (size_t ki = 0; ki < filterRows; ++ki, inputPtr += dilationH)
+            *patchPtr++ = *inputPtr;
+        }
+      }
+    }
+  }
+
+  /*
+   * Zero-pad the input for a full convolution; the padded matrix can then be
+   * convolved in valid mode with unit strides. The output shape matches the
+   * direct implementation, including the adjustment of the working size for
+   * strided application.
+   */
+  template<typename eT>
+  static void PadFull(const arma::Mat<eT>& input,
+                      const size_t filterRows,
+                      const size_t filterCols,
+                      const size_t dW,
+                      const size_t dH,
+                      const size_t dilationW,
+                      const size_t dilationH,
+                      arma::Mat<eT>& inputPadded)
+  {
+    size_t outputRows = (input.n_rows - 1) * dW + 2 * (filterRows - 1)
+        * dilationW + 1;
+    size_t outputCols = (input.n_cols - 1) * dH + 2 * (filterCols - 1)
+        * dilationH + 1;
+
+    for (size_t i = 0; i < dW; ++i)
+    {
+      if (((((i + outputRows - 2 * (filterRows - 1) * dilationW - 1) % dW)
+          + dW) % dW) == i)
+      {
+        outputRows += i;
+        break;
+      }
+    }
+    for (size_t i = 0; i < dH; ++i)
+    {
+      if (((((i + outputCols - 2 * (filterCols - 1) * dilationH - 1) % dH)
+          + dH) % dH) == i)
+      {
+        outputCols += i;
+        break;
+      }
+    }
+
+    inputPadded = arma::zeros<arma::Mat<eT> >(outputRows, outputCols);
+    inputPadded.submat((filterRows - 1) * dilationW, (filterCols - 1)
+        * dilationH, (filterRows - 1) * dilationW + input.n_rows - 1,
+        (filterCols - 1) * dilationH + input.n_cols - 1) = input;
+  }
+
+  /*
+   * Build the patch matrix of a single slice, applying the border mode.
+   */
+  template<typename eT>
+  static void SlicePatches(const arma::Mat<eT>& input,
+                           const arma::Mat<eT>& filter,
+                           const size_t dW,
+                           const size_t dH,
+                           const size_t dilationW,
+                           const size_t dilationH,
+                           arma::Mat<eT>& patches,
+                           size_t& outputRows,
+                           size_t& outputCols)
+  {
+    if (std::is_same<BorderMode, FullConvolution>::value)
+    {
+      arma::Mat<eT> inputPadded;
+      PadFull(input, filter.n_rows, filter.n_cols, dW, dH, dilationW,
+          dilationH, inputPadded);
+      Im2Col(inputPadded, filter.n_rows, filter.n_cols, 1, 1, dilationW,
+          dilationH, patches, outputRows, outputCols);
+    }
+    else
+    {
+      Im2Col(input, filter.n_rows, filter.n_cols, dW, dH, dilationW,
+          dilationH, patches, outputRows, outputCols);
+    }
+  }
+
+};  // class GemmConvolution
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
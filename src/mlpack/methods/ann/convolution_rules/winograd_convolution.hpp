@@ -0,0 +1,351 @@
+/**
+ * @file methods/ann/convolution_rules/winograd_convolution.hpp
+ *
+ * Implementation of the convolution through the Winograd minimal filtering
+ * algorithm F(2x2, 3x3).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_CONVOLUTION_RULES_WINOGRAD_CONVOLUTION_HPP
+#define MLPACK_METHODS_ANN_CONVOLUTION_RULES_WINOGRAD_CONVOLUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "border_modes.hpp"
+#include "naive_convolution.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Computes the two-dimensional convolution with the Winograd minimal
+ * filtering algorithm F(2x2, 3x3): the input is split into 4x4 tiles that
+ * produce 2x2 output tiles each, and every tile costs 16 multiplications
+ * instead of the 36 of the direct method. The filter transform is computed
+ * once per convolution and shared by all tiles. This class allows
+ * specification of the type of the border type. The convolution can be
+ * computed with the valid border type or the full border type (default).
+ *
+ * FullConvolution: returns the full two-dimensional convolution.
+ * ValidConvolution: returns only those parts of the convolution that are
+ * computed without the zero-padded edges.
+ *
+ * The Winograd path covers the 3x3 kernel with unit stride and dilation,
+ * which is the dominant case in convolutional networks; any other
+ * configuration falls back to the direct method.
+ *
+ * For more information, see the following.
+ *
+ * @code
+ * @inproceedings{Lavin2016,
+ *   author    = {Andrew Lavin and Scott Gray},
+ *   title     = {Fast Algorithms for Convolutional Neural Networks},
+ *   booktitle = {2016 IEEE Conference on Computer Vision and Pattern
+ *                Recognition (CVPR)},
+ *   year      = {2016}
+ * }
+ * @endcode
+ *
+ * @tparam BorderMode Type of the border mode (FullConvolution or
+ * ValidConvolution).
+ */
+template<typename BorderMode = FullConvolution>
+class WinogradConvolution
+{
+ public:
+  /*
+   * Perform a convolution (valid mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT, typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, ValidConvolution>::value, void>::type
+  Convolution(const arma::Mat<eT>& input,
+              const arma::Mat<eT>& filter,
+              arma::Mat<eT>& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1)
+  {
+    if (filter.n_rows == 3 && filter.n_cols == 3 && dW == 1 && dH == 1 &&
+        dilationW == 1 && dilationH == 1 &&
+        input.n_rows >= 3 && input.n_cols >= 3)
+    {
+      arma::Mat<eT> transformedFilter;
+      FilterTransform(filter, transformedFilter);
+      WinogradTiles(input, transformedFilter, output);
+    }
+    else
+    {
+      NaiveConvolution<ValidConvolution>::Convolution(input, filter, output,
+          dW, dH, dilationW, dilationH);
+    }
+  }
+
+  /*
+   * Perform a convolution (full mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT, typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, FullConvolution>::value, void>::type
+  Convolution(const arma::Mat<eT>& input,
+              const arma::Mat<eT>& filter,
+              arma::Mat<eT>& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1)
+  {
+    size_t outputRows = (input.n_rows - 1) * dW + 2 * (filter.n_rows - 1)
+        * dilationW + 1;
+    size_t outputCols = (input.n_cols - 1) * dH + 2 * (filter.n_cols - 1)
+        * dilationH + 1;
+
+    for (size_t i = 0; i < dW; ++i)
+    {
+      if (((((i + outputRows - 2 * (filter.n_rows - 1) * dilationW - 1) % dW)
+          + dW) % dW) == i)
+      {
+        outputRows += i;
+        break;
+      }
+    }
+    for (size_t i = 0; i < dH; ++i)
+    {
+      if (((((i + outputCols - 2 * (filter.n_cols - 1) * dilationH - 1) % dH)
+          + dH) % dH) == i)
+      {
+        outputCols += i;
+        break;
+      }
+    }
+
+    // Pad the input to the working output shape; the padded input can then
+    // be convolved in valid mode with unit strides.
+    arma::Mat<eT> inputPadded = arma::zeros<arma::Mat<eT> >(outputRows,
+        outputCols);
+    inputPadded.submat((filter.n_rows - 1) * dilationW, (filter.n_cols - 1)
+        * dilationH, (filter.n_rows - 1) * dilationW + input.n_rows - 1,
+        (filter.n_cols - 1) * dilationH + input.n_cols - 1) = input;
+
+    WinogradConvolution<ValidConvolution>::Convolution(inputPadded, filter,
+        output, 1, 1, dilationW, dilationH);
+  }
+
+  /*
+   * Perform a convolution using 3rd order tensors.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    WinogradConvolution<BorderMode>::Convolution(input.slice(0),
+        filter.slice(0), convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; ++i)
+    {
+      WinogradConvolution<BorderMode>::Convolution(input.slice(i),
+          filter.slice(i), output.slice(i), dW, dH, dilationW, dilationH);
+    }
+  }
+
+  /*
+   * Perform a convolution using dense matrix as input and a 3rd order tensors
+   * as filter and output.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Mat<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    WinogradConvolution<BorderMode>::Convolution(input, filter.slice(0),
+        convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        filter.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < filter.n_slices; ++i)
+    {
+      WinogradConvolution<BorderMode>::Convolution(input, filter.slice(i),
+          output.slice(i), dW, dH, dilationW, dilationH);
+    }
+  }
+
+  /*
+   * Perform a convolution using a 3rd order tensors as input and output and a
+   * dense matrix as filter. The transformed filter is computed once and
+   * shared by all input slices.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Mat<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    if (std::is_same<BorderMode, ValidConvolution>::value &&
+        filter.n_rows == 3 && filter.n_cols == 3 && dW == 1 && dH == 1 &&
+        dilationW == 1 && dilationH == 1 &&
+        input.n_rows >= 3 && input.n_cols >= 3)
+    {
+      arma::Mat<eT> transformedFilter;
+      FilterTransform(filter, transformedFilter);
+
+      output = arma::Cube<eT>(input.n_rows - 2, input.n_cols - 2,
+          input.n_slices);
+      for (size_t i = 0; i < input.n_slices; ++i)
+        WinogradTiles(input.slice(i), transformedFilter, output.slice(i));
+
+      return;
+    }
+
+    arma::Mat<eT> convOutput;
+    WinogradConvolution<BorderMode>::Convolution(input.slice(0), filter,
+        convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; ++i)
+    {
+      WinogradConvolution<BorderMode>::Convolution(input.slice(i), filter,
+          output.slice(i), dW, dH, dilationW, dilationH);
+    }
+  }
+
+ private:
+  /*
+   * Transform the 3x3 filter into the 4x4 Winograd domain: U = G g G^T.
+   */
+  template<typename eT>
+  static void FilterTransform(const arma::Mat<eT>& filter,
+                              arma::Mat<eT>& transformedFilter)
+  {
+    const arma::Mat<eT> g = { { 1.0,  0.0, 0.0 },
+                              { 0.5,  0.5, 0.5 },
+                              { 0.5, -0.5, 0.5 },
+                              { 0.0,  0.0, 1.0 } };
+
+    transformedFilter = g * filter * g.t();
+  }
+
+  /*
+   * Compute the valid convolution of the input with the transformed 3x3
+   * filter: every 4x4 input tile is moved into the Winograd domain with
+   * V = B^T d B, multiplied elementwise with the transformed filter, and the
+   * 2x2 output tile is recovered with Y = A^T (U % V) A. Odd output shapes
+   * are handled by padding the tiling and cropping the last tile row/column.
+   */
+  template<typename eT>
+  static void WinogradTiles(const arma::Mat<eT>& input,
+                            const arma::Mat<eT>& transformedFilter,
+                            arma::Mat<eT>& output)
+  {
+    const size_t outputRows = input.n_rows - 2;
+    const size_t outputCols = input.n_cols - 2;
+    const size_t tileRows = (outputRows + 1) / 2;
+    const size_t tileCols = (outputCols + 1) / 2;
+
+    const arma::Mat<eT> bt = { { 1.0,  0.0, -1.0,  0.0 },
+                               { 0.0,  1.0,  1.0,  0.0 },
+                               { 0.0, -1.0,  1.0,  0.0 },
+                               { 0.0,  1.0,  0.0, -1.0 } };
+    const arma::Mat<eT> at = { { 1.0, 1.0,  1.0,  0.0 },
+                               { 0.0, 1.0, -1.0, -1.0 } };
+
+    // If the output shape is odd the tiling overruns the input, so work on
+    // a zero-padded copy and crop the overrun below.
+    const bool pad = (outputRows % 2 != 0) || (outputCols % 2 != 0);
+    arma::Mat<eT> padded;
+    if (pad)
+    {
+      padded.zeros(2 * tileRows + 2, 2 * tileCols + 2);
+      padded.submat(0, 0, input.n_rows - 1, input.n_cols - 1) = input;
+    }
+    const arma::Mat<eT>& data = pad ? padded : input;
+
+    output.set_size(outputRows, outputCols);
+
+    arma::Mat<eT> v(4, 4), y(2, 2);
+    for (size_t tj = 0; tj < tileCols; ++tj)
+    {
+      for (size_t ti = 0; ti < tileRows; ++ti)
+      {
+        v = bt * data.submat(2 * ti, 2 * tj, 2 * ti + 3, 2 * tj + 3) *
+            bt.t();
+        y = at * (transformedFilter % v) * at.t();
+
+        const size_t rowEnd = std::min(2 * ti + 1, outputRows - 1);
+        const size_t colEnd = std::min(2 * tj + 1, outputCols - 1);
+        output.submat(2 * ti, 2 * tj, rowEnd, colEnd) =
+            y.submat(0, 0, rowEnd - 2 * ti, colEnd - 2 * tj);
+      }
+    }
+  }
+};  // class WinogradConvolution
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
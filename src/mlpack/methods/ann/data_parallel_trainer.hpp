@@ -0,0 +1,170 @@
+/**
+ * @file methods/ann/data_parallel_trainer.hpp
+ *
+ * Definition of the DataParallelTrainer class, a synchronous data-parallel
+ * training wrapper for FFN and RNN models.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_DATA_PARALLEL_TRAINER_HPP
+#define MLPACK_METHODS_ANN_DATA_PARALLEL_TRAINER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/shuffle_data.hpp>
+
+#include <ensmallen.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Synchronous data-parallel trainer for FFN and RNN models.
+ *
+ * The trainer holds one replica of the model per thread.  For every
+ * optimizer step, the minibatch is split into disjoint shards, each thread
+ * evaluates the objective and the gradient of its shard on its own replica
+ * (so no layer state is shared between threads), and the shard gradients
+ * are reduced into the single gradient used by the optimizer step.  This is
+ * equivalent to evaluating the whole minibatch on one model, up to
+ * floating point summation order.
+ *
+ * The wrapper exposes the ensmallen separable function API, so any
+ * optimizer that works with FFN::Train() works here:
+ *
+ * @code
+ * FFN<> model;
+ * model.Add<Linear<> >(10, 3);
+ * ...
+ * DataParallelTrainer<FFN<> > trainer(model);
+ * ens::StandardSGD optimizer;
+ * trainer.Train(predictors, responses, optimizer);
+ * // The trained parameters live in the wrapped model.
+ * @endcode
+ *
+ * @tparam ModelType Type of the model to train (FFN<...> or RNN<...>).
+ * @tparam DataType Type of the input data (arma::mat for FFN models,
+ *     arma::cube for RNN models).
+ */
+template<typename ModelType, typename DataType = arma::mat>
+class DataParallelTrainer
+{
+ public:
+  /**
+   * Create the trainer for the given model.  The model is kept by
+   * reference; the optimized parameters are written back into it.
+   *
+   * @param model The model to train.
+   * @param threads Number of worker threads (and model replicas).  If 0,
+   *     one thread per available core is used.
+   */
+  DataParallelTrainer(ModelType& model, const size_t threads = 0);
+
+  /**
+   * Train the wrapped model on the given data with the given optimizer,
+   * evaluating each minibatch in parallel across the model replicas.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of callback functions.
+   * @param predictors Input training variables.
+   * @param responses Outputs results from input training variables.
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @param callbacks Callback functions for ensmallen optimizer
+   *     `OptimizerType`.
+   * @return The final objective of the trained model (NaN or Inf on error).
+   */
+  template<typename OptimizerType, typename... CallbackTypes>
+  double Train(DataType predictors,
+               DataType responses,
+               OptimizerType& optimizer,
+               CallbackTypes&&... callbacks);
+
+  /**
+   * Evaluate the model with the given parameters on a subset of the
+   * training data.  This function is usually called by the optimizer.
+   *
+   * @param parameters Matrix of the model parameters to be optimized.
+   * @param begin Index of the starting point to use for objective function
+   *     evaluation.
+   * @param batchSize Number of points to be passed at a time to use for
+   *     objective function evaluation.
+   */
+  double Evaluate(const arma::mat& parameters,
+                  const size_t begin,
+                  const size_t batchSize);
+
+  /**
+   * Evaluate the model with the given parameters on a subset of the
+   * training data and compute the gradient, with the shards of the
+   * minibatch processed in parallel on the model replicas.  This function
+   * is usually called by the optimizer.
+   *
+   * @param parameters Matrix of the model parameters to be optimized.
+   * @param begin Index of the starting point to use for objective function
+   *     evaluation.
+   * @param gradient Matrix to output the reduced gradient into.
+   * @param batchSize Number of points to be passed at a time to use for
+   *     objective function evaluation.
+   */
+  double EvaluateWithGradient(const arma::mat& parameters,
+                              const size_t begin,
+                              arma::mat& gradient,
+                              const size_t batchSize);
+
+  /**
+   * Evaluate the gradient of the model with the given parameters on a
+   * subset of the training data.  This function is usually called by the
+   * optimizer.
+   *
+   * @param parameters Matrix of the model parameters to be optimized.
+   * @param begin Index of the starting point to use for gradient
+   *     evaluation.
+   * @param gradient Matrix to output the reduced gradient into.
+   * @param batchSize Number of points to be passed at a time to use for
+   *     gradient evaluation.
+   */
+  void Gradient(const arma::mat& parameters,
+                const size_t begin,
+                arma::mat& gradient,
+                const size_t batchSize);
+
+  //! Shuffle the order of function visitation.  This may be called by the
+  //! optimizer.
+  void Shuffle();
+
+  //! Return the number of separable functions (the number of predictor
+  //! points).
+  size_t NumFunctions() const { return numFunctions; }
+
+  //! Get the number of worker threads (and model replicas).
+  size_t Threads() const { return threads; }
+
+ private:
+  //! The model whose parameters are optimized.
+  ModelType& model;
+
+  //! The number of worker threads (and model replicas).
+  size_t threads;
+
+  //! Locally-stored per-thread model replicas.
+  std::vector<ModelType> replicas;
+
+  //! Locally-stored copy of the training data.
+  DataType predictors;
+
+  //! Locally-stored copy of the responses.
+  DataType responses;
+
+  //! The number of training points.
+  size_t numFunctions;
+}; // class DataParallelTrainer
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "data_parallel_trainer_impl.hpp"
+
+#endif
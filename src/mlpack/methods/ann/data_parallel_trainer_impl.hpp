@@ -0,0 +1,148 @@
+/**
+ * @file methods/ann/data_parallel_trainer_impl.hpp
+ *
+ * Implementation of the DataParallelTrainer class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_DATA_PARALLEL_TRAINER_IMPL_HPP
+#define MLPACK_METHODS_ANN_DATA_PARALLEL_TRAINER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "data_parallel_trainer.hpp"
+
+#include <mlpack/core/util/threads.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename ModelType, typename DataType>
+DataParallelTrainer<ModelType, DataType>::DataParallelTrainer(
+    ModelType& model, const size_t threads) :
+    model(model),
+    threads(threads),
+    numFunctions(0)
+{
+  if (this->threads == 0)
+    this->threads = Threads();
+}
+
+template<typename ModelType, typename DataType>
+template<typename OptimizerType, typename... CallbackTypes>
+double DataParallelTrainer<ModelType, DataType>::Train(
+    DataType predictors,
+    DataType responses,
+    OptimizerType& optimizer,
+    CallbackTypes&&... callbacks)
+{
+  this->predictors = std::move(predictors);
+  this->responses = std::move(responses);
+  numFunctions = this->responses.n_cols;
+
+  // Make sure the master model has initialized parameters, so the replicas
+  // and the optimizer all work on matrices of the right size.
+  if (model.Parameters().is_empty())
+    model.ResetParameters();
+
+  // Build one replica per thread.  ResetParameters() re-binds the layers of
+  // each replica to the replica's own parameter matrix; the values it fills
+  // in are overwritten by the parameter synchronization of the first step.
+  replicas.clear();
+  replicas.reserve(threads);
+  for (size_t t = 0; t < threads; ++t)
+  {
+    replicas.push_back(model);
+    replicas.back().ResetParameters();
+  }
+
+  // Train the model; the optimizer updates the master parameters in place.
+  Timer::Start("data_parallel_optimization");
+  const double out = optimizer.Optimize(*this, model.Parameters(),
+      callbacks...);
+  Timer::Stop("data_parallel_optimization");
+
+  Log::Info << "DataParallelTrainer::Train(): final objective of trained "
+      << "model is " << out << "." << std::endl;
+  return out;
+}
+
+template<typename ModelType, typename DataType>
+double DataParallelTrainer<ModelType, DataType>::Evaluate(
+    const arma::mat& parameters,
+    const size_t begin,
+    const size_t batchSize)
+{
+  // Evaluation is not on the training fast path, so one replica handles the
+  // whole batch.
+  replicas[0].Parameters() = parameters;
+  replicas[0].Predictors() = predictors.cols(begin, begin + batchSize - 1);
+  replicas[0].Responses() = responses.cols(begin, begin + batchSize - 1);
+
+  return replicas[0].Evaluate(parameters, 0, batchSize);
+}
+
+template<typename ModelType, typename DataType>
+double DataParallelTrainer<ModelType, DataType>::EvaluateWithGradient(
+    const arma::mat& parameters,
+    const size_t begin,
+    arma::mat& gradient,
+    const size_t batchSize)
+{
+  arma::vec objectives(threads, arma::fill::zeros);
+  std::vector<arma::mat> gradients(threads);
+
+  // Each thread synchronizes its replica with the current parameters,
+  // copies its shard of the minibatch into the replica, and evaluates the
+  // shard objective and gradient with no state shared between threads.
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t t = 0; t < (omp_size_t) threads; ++t)
+  {
+    const size_t shardBegin = (batchSize * t) / threads;
+    const size_t shardEnd = (batchSize * (t + 1)) / threads;
+    if (shardEnd == shardBegin)
+      continue;
+
+    replicas[t].Parameters() = parameters;
+    replicas[t].Predictors() = predictors.cols(begin + shardBegin,
+        begin + shardEnd - 1);
+    replicas[t].Responses() = responses.cols(begin + shardBegin,
+        begin + shardEnd - 1);
+
+    objectives[t] = replicas[t].EvaluateWithGradient(parameters, 0,
+        gradients[t], shardEnd - shardBegin);
+  }
+
+  // Reduce the shard gradients into the optimizer's gradient.
+  gradient.zeros(parameters.n_rows, parameters.n_cols);
+  for (size_t t = 0; t < threads; ++t)
+  {
+    if (!gradients[t].is_empty())
+      gradient += gradients[t];
+  }
+
+  return arma::accu(objectives);
+}
+
+template<typename ModelType, typename DataType>
+void DataParallelTrainer<ModelType, DataType>::Gradient(
+    const arma::mat& parameters,
+    const size_t begin,
+    arma::mat& gradient,
+    const size_t batchSize)
+{
+  EvaluateWithGradient(parameters, begin, gradient, batchSize);
+}
+
+template<typename ModelType, typename DataType>
+void DataParallelTrainer<ModelType, DataType>::Shuffle()
+{
+  math::ShuffleData(predictors, responses, predictors, responses);
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -15,6 +15,8 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "visitor/compile_forward_visitor.hpp"
+#include "visitor/in_place_visitor.hpp"
 #include "visitor/delete_visitor.hpp"
 #include "visitor/delta_visitor.hpp"
 #include "visitor/output_height_visitor.hpp"
@@ -176,6 +178,71 @@ class FFN
    */
   void Predict(arma::mat predictors, arma::mat& results);
 
+  /**
+   * Compile the network into a fixed inference execution plan.  The layer
+   * list is flattened into one directly callable Forward() function per
+   * layer, resolving the layer type dispatch once here instead of once per
+   * layer per forward pass, and the activations are passed through two
+   * preallocated ping-pong buffers.  Predict() then runs the plan over the
+   * whole batch of predictors at once.  Elementwise layers that are flagged
+   * with LayerTraits::SupportsInPlace (e.g. the activation layers built on
+   * BaseLayer) mutate their input buffer in place instead of writing a
+   * second activation buffer, halving the activation traffic of deep
+   * stacks of such layers.
+   *
+   * Call this after the network is fully built and trained (or after
+   * ResetParameters()); adding a layer invalidates the plan.  The plan only
+   * covers the forward pass, so training is unaffected.  Note that the
+   * compiled path is skipped until the layer shapes have been propagated by
+   * a first forward pass (i.e. by training or a previous Predict() call).
+   */
+  void CompileInference();
+
+  /**
+   * Fold every BatchNorm layer that directly follows a Linear or Convolution
+   * layer into the weights and bias of that layer, and remove the folded
+   * BatchNorm layers from the network.  At inference time batch
+   * normalization is a fixed per-channel affine transform (built from the
+   * running mean, the running variance, gamma and beta), so it can be
+   * absorbed into the preceding layer's weights, saving one pass over the
+   * activations per folded layer while producing identical outputs.
+   *
+   * The network structure and the parameter matrix are rewritten in place,
+   * so only call this on a trained network that is used for inference from
+   * here on; training the fused network optimizes a different model.  Any
+   * compiled inference plan is invalidated and has to be rebuilt with
+   * CompileInference().
+   */
+  void FuseForInference();
+
+  /**
+   * Quantize the network parameters to 8 bit integers with floating point
+   * scales.  The weights of Linear and Convolution layers are quantized per
+   * channel (one scale per output dimension or output map), and every other
+   * parameter block (biases, other layer types) with one scale per block;
+   * each value is rounded to scale * q with q in [-127, 127].
+   *
+   * The quantized parameters and the scales serialize through the existing
+   * cereal support for Armadillo types, giving models that are 8x smaller
+   * on disk; use DequantizeParameters() to load them back into a network
+   * with the same structure.
+   *
+   * @param quantizedParameters Vector to store the int8 parameters in.
+   * @param scales Vector to store the quantization scales in.
+   */
+  void QuantizeParameters(arma::Col<arma::s8>& quantizedParameters,
+                          arma::vec& scales);
+
+  /**
+   * Set the network parameters from quantized values produced by
+   * QuantizeParameters() on a network with the same structure.
+   *
+   * @param quantizedParameters The int8 parameters.
+   * @param scales The quantization scales.
+   */
+  void DequantizeParameters(const arma::Col<arma::s8>& quantizedParameters,
+                            const arma::vec& scales);
+
   /**
    * Evaluate the feedforward network with the given predictors and responses.
    * This functions is usually used to monitor progress while training.
@@ -287,14 +354,26 @@ class FFN
    * @param args The layer parameter.
    */
   template <class LayerType, class... Args>
-  void Add(Args... args) { network.push_back(new LayerType(args...)); }
+  void Add(Args... args)
+  {
+    network.push_back(new LayerType(args...));
+    inferencePlan.clear();
+    inferencePlanInPlace.clear();
+    boundGradientMemory = NULL;
+  }
 
   /*
    * Add a new module to the model.
    *
    * @param layer The Layer to be added to the model.
    */
-  void Add(LayerTypes<CustomLayers...> layer) { network.push_back(layer); }
+  void Add(LayerTypes<CustomLayers...> layer)
+  {
+    network.push_back(layer);
+    inferencePlan.clear();
+    inferencePlanInPlace.clear();
+    boundGradientMemory = NULL;
+  }
 
   //! Get the network model.
   const std::vector<LayerTypes<CustomLayers...> >& Model() const
@@ -314,6 +393,16 @@ class FFN
   //! Modify the initial point for the optimization.
   arma::mat& Parameters() { return parameter; }
 
+  //! Get the micro-batch size used for gradient accumulation during
+  //! training (0 means micro-batching is disabled).
+  size_t MicroBatchSize() const { return microBatchSize; }
+  //! Modify the micro-batch size used for gradient accumulation during
+  //! training.  When set to a nonzero value, every minibatch larger than
+  //! this is processed in micro-batches of at most this many points and the
+  //! gradients are accumulated, so the resident activation size is bounded
+  //! by the micro-batch size instead of the optimizer's batch size.
+  size_t& MicroBatchSize() { return microBatchSize; }
+
   //! Get the matrix of responses to the input data points.
   const arma::mat& Responses() const { return responses; }
   //! Modify the matrix of responses to the input data points.
@@ -423,9 +512,25 @@ class FFN
 
   /**
    * Reset the gradient for all modules that implement the Gradient function.
+   * The layer gradients stay bound until a matrix with different memory is
+   * given, so repeated calls with the same gradient matrix are free.
    */
   void ResetGradients(arma::mat& gradient);
 
+  /**
+   * Evaluate one minibatch and compute its gradient.  This is the core of
+   * EvaluateWithGradient(), which splits large minibatches into
+   * micro-batches before calling this when micro-batching is enabled.
+   *
+   * @param begin Index of the starting point of the minibatch.
+   * @param gradient Matrix to output the gradient into.
+   * @param batchSize Number of points in the minibatch.
+   */
+  template<typename GradType>
+  double EvaluateWithGradientStep(const size_t begin,
+                                  GradType& gradient,
+                                  const size_t batchSize);
+
   /**
    * Swap the content of this network with given network.
    *
@@ -509,6 +614,37 @@ class FFN
   //! Locally-stored copy visitor
   CopyVisitor<CustomLayers...> copyVisitor;
 
+  //! The compiled inference plan built by CompileInference(): one bound
+  //! Forward() call per layer, with the variant dispatch already resolved.
+  //! Empty if no plan has been compiled (or it has been invalidated).
+  std::vector<std::function<void(const arma::mat&, arma::mat&)> >
+      inferencePlan;
+
+  //! For every step of the compiled inference plan, whether the layer is
+  //! elementwise and may overwrite its input buffer in place.
+  std::vector<bool> inferencePlanInPlace;
+
+  //! Preallocated ping-pong activation buffers used by the compiled
+  //! inference plan; in-place steps reuse the current buffer, all other
+  //! layers read from one buffer and write to the other.
+  arma::mat planBuffers[2];
+
+  //! The micro-batch size for gradient accumulation (0 disables it).
+  size_t microBatchSize;
+
+  //! Persistent workspace holding the current minibatch; reused across
+  //! minibatches so the forward and gradient passes don't allocate a fresh
+  //! input copy each time.
+  arma::mat batchWorkspace;
+
+  //! Persistent gradient buffer for one micro-batch, accumulated into the
+  //! optimizer's gradient when micro-batching is enabled.
+  arma::mat microGradient;
+
+  //! The memory the layer gradients are currently bound to; used by
+  //! ResetGradients() to skip redundant re-binding.
+  const double* boundGradientMemory;
+
   // The GAN class should have access to internal members.
   template<
     typename Model,
@@ -22,9 +22,16 @@
 #include "visitor/gradient_visitor.hpp"
 #include "visitor/set_input_height_visitor.hpp"
 #include "visitor/set_input_width_visitor.hpp"
+#include "visitor/parameters_visitor.hpp"
+#include "visitor/parameters_set_visitor.hpp"
+#include "visitor/weight_set_visitor.hpp"
 
 #include "util/check_input_shape.hpp"
 
+#include <mlpack/core/util/profiler.hpp>
+
+#include <sstream>
+
 namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
 
@@ -39,7 +46,9 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::FFN(
     height(0),
     reset(false),
     numFunctions(0),
-    deterministic(false)
+    deterministic(false),
+    microBatchSize(0),
+    boundGradientMemory(NULL)
 {
   /* Nothing to do here. */
 }
@@ -121,9 +130,19 @@ double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
 
   // Train the model.
   Timer::Start("ffn_optimization");
-  const double out = optimizer.Optimize(*this, parameter, callbacks...);
+  double out;
+  {
+    MLPACK_PROFILE_SCOPE("ffn_optimization");
+    out = optimizer.Optimize(*this, parameter, callbacks...);
+  }
   Timer::Stop("ffn_optimization");
 
+  #ifdef MLPACK_ENABLE_PROFILER
+  std::ostringstream profile;
+  util::Profiler::Print(profile);
+  Log::Info << profile.str();
+  #endif
+
   Log::Info << "FFN::FFN(): final objective of trained model is " << out
       << "." << std::endl;
   return out;
@@ -149,9 +168,19 @@ double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
 
   // Train the model.
   Timer::Start("ffn_optimization");
-  const double out = optimizer.Optimize(*this, parameter, callbacks...);
+  double out;
+  {
+    MLPACK_PROFILE_SCOPE("ffn_optimization");
+    out = optimizer.Optimize(*this, parameter, callbacks...);
+  }
   Timer::Stop("ffn_optimization");
 
+  #ifdef MLPACK_ENABLE_PROFILER
+  std::ostringstream profile;
+  util::Profiler::Print(profile);
+  Log::Info << profile.str();
+  #endif
+
   Log::Info << "FFN::FFN(): final objective of trained model is " << out
       << "." << std::endl;
   return out;
@@ -240,6 +269,37 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
     ResetDeterministic();
   }
 
+  // If an inference plan has been compiled and the layer shapes have been
+  // propagated, run the whole batch through the plan: one direct Forward()
+  // call per layer, ping-ponging between the two preallocated activation
+  // buffers.
+  if (reset && inferencePlan.size() == network.size() && !network.empty())
+  {
+    // The predictors were passed by value, so the in-place steps may mutate
+    // the input buffer directly.
+    arma::mat* layerInput = &predictors;
+    size_t bufferIndex = 0;
+    for (size_t i = 0; i < inferencePlan.size(); ++i)
+    {
+      if (inferencePlanInPlace[i])
+      {
+        // Elementwise layer: overwrite the current buffer instead of
+        // writing a second activation buffer.
+        inferencePlan[i](*layerInput, *layerInput);
+      }
+      else
+      {
+        arma::mat& layerOutput = planBuffers[bufferIndex];
+        inferencePlan[i](*layerInput, layerOutput);
+        layerInput = &layerOutput;
+        bufferIndex ^= 1;
+      }
+    }
+
+    results = *layerInput;
+    return;
+  }
+
   arma::mat resultsTemp;
   Forward(arma::mat(predictors.colptr(0), predictors.n_rows, 1, false, true));
   resultsTemp = boost::apply_visitor(outputParameterVisitor,
@@ -258,6 +318,359 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
   }
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::CompileInference()
+{
+  if (parameter.is_empty())
+    ResetParameters();
+
+  // Resolve the variant dispatch for every layer once, binding each layer's
+  // Forward() function into a directly callable function object.
+  inferencePlan.clear();
+  inferencePlan.reserve(network.size());
+  inferencePlanInPlace.clear();
+  inferencePlanInPlace.reserve(network.size());
+
+  CompileForwardVisitor compileVisitor;
+  InPlaceVisitor inPlaceVisitor;
+  for (size_t i = 0; i < network.size(); ++i)
+  {
+    inferencePlan.push_back(boost::apply_visitor(compileVisitor, network[i]));
+    inferencePlanInPlace.push_back(boost::apply_visitor(inPlaceVisitor,
+        network[i]));
+  }
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::FuseForInference()
+{
+  typedef Linear<arma::mat, arma::mat, NoRegularizer> LinearType;
+  typedef Convolution<NaiveConvolution<ValidConvolution>,
+                      NaiveConvolution<FullConvolution>,
+                      NaiveConvolution<ValidConvolution>,
+                      arma::mat, arma::mat> ConvolutionType;
+  typedef BatchNorm<arma::mat, arma::mat> BatchNormType;
+
+  if (parameter.is_empty())
+    ResetParameters();
+
+  std::vector<LayerTypes<CustomLayers...> > fusedNetwork;
+  fusedNetwork.reserve(network.size());
+
+  for (size_t i = 0; i < network.size(); ++i)
+  {
+    fusedNetwork.push_back(network[i]);
+
+    // Check whether the next layer is a BatchNorm layer that can be folded
+    // into this one.
+    if (i + 1 >= network.size())
+      continue;
+
+    BatchNormType* const* batchNorm =
+        boost::get<BatchNormType*>(&network[i + 1]);
+    if (batchNorm == NULL)
+      continue;
+
+    // At inference time the BatchNorm layer applies the per-channel affine
+    // transform y = scale * x + shift, with the scale and shift built from
+    // the running statistics, gamma and beta.
+    const size_t channels = (*batchNorm)->InputSize();
+    const arma::mat& bnWeights = (*batchNorm)->Parameters();
+    const arma::vec scale = bnWeights.rows(0, channels - 1) /
+        arma::sqrt((*batchNorm)->TrainingVariance() +
+        (*batchNorm)->Epsilon());
+    const arma::vec shift = bnWeights.rows(channels, 2 * channels - 1) -
+        scale % (*batchNorm)->TrainingMean();
+
+    bool folded = false;
+
+    LinearType* const* linear = boost::get<LinearType*>(&network[i]);
+    if (linear != NULL && (*linear)->OutputSize() % channels == 0)
+    {
+      // Each channel covers a contiguous block of output rows; expand the
+      // per-channel transform to one factor per output dimension and fold
+      // it into the weight rows and the bias.
+      const size_t rowsPerChannel = (*linear)->OutputSize() / channels;
+      const arma::vec rowScale = arma::vectorise(
+          arma::repmat(scale.t(), rowsPerChannel, 1));
+      const arma::vec rowShift = arma::vectorise(
+          arma::repmat(shift.t(), rowsPerChannel, 1));
+
+      (*linear)->Weight().each_col() %= rowScale;
+      (*linear)->Bias() = rowScale % (*linear)->Bias() + rowShift;
+      folded = true;
+    }
+
+    ConvolutionType* const* convolution =
+        boost::get<ConvolutionType*>(&network[i]);
+    if (convolution != NULL && (*convolution)->OutputSize() == channels)
+    {
+      // The filter slices of output map o are stored contiguously, so each
+      // channel scale applies to one block of slices and one bias element.
+      arma::cube& weight = (*convolution)->Weight();
+      const size_t slicesPerMap = weight.n_slices / channels;
+      for (size_t map = 0; map < channels; ++map)
+      {
+        weight.slices(map * slicesPerMap, (map + 1) * slicesPerMap - 1) *=
+            scale(map);
+      }
+      (*convolution)->Bias() = scale % (*convolution)->Bias() + shift;
+      folded = true;
+    }
+
+    if (folded)
+    {
+      boost::apply_visitor(deleteVisitor, network[i + 1]);
+      ++i;
+    }
+  }
+
+  // Nothing was folded, so the network and the parameters stay as they are.
+  if (fusedNetwork.size() == network.size())
+    return;
+
+  network = std::move(fusedNetwork);
+
+  // Rebuild the parameter matrix without the parameters of the folded
+  // layers, and re-alias the remaining layers into it.  The layer weights
+  // are copied out first, since setting the new weights clears the aliased
+  // values, and written back once the layers point into the new matrix.
+  std::vector<arma::mat> layerParameters(network.size());
+  size_t weightSize = 0;
+  for (size_t i = 0; i < network.size(); ++i)
+  {
+    boost::apply_visitor(ParametersVisitor(layerParameters[i]), network[i]);
+    weightSize += layerParameters[i].n_elem;
+  }
+
+  parameter.set_size(weightSize, 1);
+  size_t offset = 0;
+  for (size_t i = 0; i < network.size(); ++i)
+  {
+    const size_t layerSize = boost::apply_visitor(
+        WeightSetVisitor(parameter, offset), network[i]);
+    boost::apply_visitor(resetVisitor, network[i]);
+
+    if (layerSize > 0)
+    {
+      parameter.rows(offset, offset + layerSize - 1) =
+          arma::vectorise(layerParameters[i]);
+    }
+    offset += layerSize;
+  }
+
+  // The layer list changed, so any compiled inference plan and gradient
+  // bindings are stale.
+  inferencePlan.clear();
+  inferencePlanInPlace.clear();
+  boundGradientMemory = NULL;
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::QuantizeParameters(
+    arma::Col<arma::s8>& quantizedParameters, arma::vec& scales)
+{
+  typedef Linear<arma::mat, arma::mat, NoRegularizer> LinearType;
+  typedef Convolution<NaiveConvolution<ValidConvolution>,
+                      NaiveConvolution<FullConvolution>,
+                      NaiveConvolution<ValidConvolution>,
+                      arma::mat, arma::mat> ConvolutionType;
+
+  if (parameter.is_empty())
+    ResetParameters();
+
+  quantizedParameters.set_size(parameter.n_elem);
+  std::vector<double> scaleList;
+  size_t offset = 0;
+
+  for (size_t i = 0; i < network.size(); ++i)
+  {
+    LinearType* const* linear = boost::get<LinearType*>(&network[i]);
+    ConvolutionType* const* convolution =
+        boost::get<ConvolutionType*>(&network[i]);
+
+    if (linear != NULL)
+    {
+      // One scale per output dimension (weight row).
+      const arma::mat& weight = (*linear)->Weight();
+      arma::vec rowScales = arma::max(arma::abs(weight), 1) / 127.0;
+      rowScales.replace(0.0, 1.0);
+
+      arma::mat scaled = weight;
+      scaled.each_col() /= rowScales;
+      quantizedParameters.rows(offset, offset + weight.n_elem - 1) =
+          arma::conv_to<arma::Col<arma::s8> >::from(
+          arma::vectorise(arma::round(scaled)));
+      offset += weight.n_elem;
+      for (size_t c = 0; c < rowScales.n_elem; ++c)
+        scaleList.push_back(rowScales[c]);
+
+      // The bias is quantized as one block with its own scale.
+      const arma::vec bias = arma::vectorise((*linear)->Bias());
+      double scale = arma::abs(bias).max() / 127.0;
+      if (scale == 0.0)
+        scale = 1.0;
+      quantizedParameters.rows(offset, offset + bias.n_elem - 1) =
+          arma::conv_to<arma::Col<arma::s8> >::from(arma::round(bias / scale));
+      offset += bias.n_elem;
+      scaleList.push_back(scale);
+    }
+    else if (convolution != NULL)
+    {
+      // One scale per output map; the filter slices of a map are stored
+      // contiguously.
+      const arma::cube& weight = (*convolution)->Weight();
+      const size_t maps = (*convolution)->OutputSize();
+      const size_t slicesPerMap = weight.n_slices / maps;
+      for (size_t map = 0; map < maps; ++map)
+      {
+        const arma::vec block = arma::vectorise(weight.slices(
+            map * slicesPerMap, (map + 1) * slicesPerMap - 1));
+        double scale = arma::abs(block).max() / 127.0;
+        if (scale == 0.0)
+          scale = 1.0;
+        quantizedParameters.rows(offset, offset + block.n_elem - 1) =
+            arma::conv_to<arma::Col<arma::s8> >::from(
+            arma::round(block / scale));
+        offset += block.n_elem;
+        scaleList.push_back(scale);
+      }
+
+      const arma::vec bias = arma::vectorise((*convolution)->Bias());
+      double scale = arma::abs(bias).max() / 127.0;
+      if (scale == 0.0)
+        scale = 1.0;
+      quantizedParameters.rows(offset, offset + bias.n_elem - 1) =
+          arma::conv_to<arma::Col<arma::s8> >::from(arma::round(bias / scale));
+      offset += bias.n_elem;
+      scaleList.push_back(scale);
+    }
+    else
+    {
+      // Any other parameterized layer is quantized as one block.
+      arma::mat layerParameters;
+      boost::apply_visitor(ParametersVisitor(layerParameters), network[i]);
+      if (layerParameters.n_elem == 0)
+        continue;
+
+      double scale = arma::abs(layerParameters).max() / 127.0;
+      if (scale == 0.0)
+        scale = 1.0;
+      quantizedParameters.rows(offset,
+          offset + layerParameters.n_elem - 1) =
+          arma::conv_to<arma::Col<arma::s8> >::from(
+          arma::vectorise(arma::round(layerParameters / scale)));
+      offset += layerParameters.n_elem;
+      scaleList.push_back(scale);
+    }
+  }
+
+  scales = arma::vec(scaleList);
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::DequantizeParameters(
+    const arma::Col<arma::s8>& quantizedParameters, const arma::vec& scales)
+{
+  typedef Linear<arma::mat, arma::mat, NoRegularizer> LinearType;
+  typedef Convolution<NaiveConvolution<ValidConvolution>,
+                      NaiveConvolution<FullConvolution>,
+                      NaiveConvolution<ValidConvolution>,
+                      arma::mat, arma::mat> ConvolutionType;
+
+  if (parameter.is_empty())
+    ResetParameters();
+
+  if (quantizedParameters.n_elem != parameter.n_elem)
+  {
+    Log::Fatal << "FFN::DequantizeParameters(): the quantized parameters "
+        << "have " << quantizedParameters.n_elem << " elements, but the "
+        << "network has " << parameter.n_elem << " parameters!" << std::endl;
+  }
+
+  size_t offset = 0;
+  size_t scaleIndex = 0;
+
+  for (size_t i = 0; i < network.size(); ++i)
+  {
+    LinearType* const* linear = boost::get<LinearType*>(&network[i]);
+    ConvolutionType* const* convolution =
+        boost::get<ConvolutionType*>(&network[i]);
+
+    if (linear != NULL)
+    {
+      arma::mat& weight = (*linear)->Weight();
+      const arma::vec rowScales = scales.subvec(scaleIndex,
+          scaleIndex + weight.n_rows - 1);
+      scaleIndex += weight.n_rows;
+
+      arma::mat dequantized = arma::reshape(arma::conv_to<arma::mat>::from(
+          quantizedParameters.rows(offset, offset + weight.n_elem - 1)),
+          weight.n_rows, weight.n_cols);
+      dequantized.each_col() %= rowScales;
+      weight = dequantized;
+      offset += weight.n_elem;
+
+      arma::mat& bias = (*linear)->Bias();
+      bias = arma::conv_to<arma::mat>::from(quantizedParameters.rows(offset,
+          offset + bias.n_elem - 1)) * scales[scaleIndex++];
+      offset += bias.n_elem;
+    }
+    else if (convolution != NULL)
+    {
+      arma::cube& weight = (*convolution)->Weight();
+      const size_t maps = (*convolution)->OutputSize();
+      const size_t slicesPerMap = weight.n_slices / maps;
+      const size_t mapElements = weight.n_rows * weight.n_cols * slicesPerMap;
+      for (size_t map = 0; map < maps; ++map)
+      {
+        arma::mat block = arma::conv_to<arma::mat>::from(
+            quantizedParameters.rows(offset, offset + mapElements - 1)) *
+            scales[scaleIndex++];
+        weight.slices(map * slicesPerMap, (map + 1) * slicesPerMap - 1) =
+            arma::cube(block.memptr(), weight.n_rows, weight.n_cols,
+            slicesPerMap, false, false);
+        offset += mapElements;
+      }
+
+      arma::mat& bias = (*convolution)->Bias();
+      bias = arma::conv_to<arma::mat>::from(quantizedParameters.rows(offset,
+          offset + bias.n_elem - 1)) * scales[scaleIndex++];
+      offset += bias.n_elem;
+    }
+    else
+    {
+      arma::mat layerParameters;
+      boost::apply_visitor(ParametersVisitor(layerParameters), network[i]);
+      if (layerParameters.n_elem == 0)
+        continue;
+
+      arma::mat dequantized = arma::reshape(arma::conv_to<arma::mat>::from(
+          quantizedParameters.rows(offset,
+          offset + layerParameters.n_elem - 1)),
+          layerParameters.n_rows, layerParameters.n_cols) *
+          scales[scaleIndex++];
+      boost::apply_visitor(ParametersSetVisitor(dequantized), network[i]);
+      offset += layerParameters.n_elem;
+    }
+  }
+
+  if (scaleIndex != scales.n_elem)
+  {
+    Log::Fatal << "FFN::DequantizeParameters(): " << scales.n_elem
+        << " scales were given, but the network uses " << scaleIndex
+        << "!" << std::endl;
+  }
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename PredictorsType, typename ResponsesType>
@@ -380,7 +793,41 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
     ResetDeterministic();
   }
 
-  Forward(predictors.cols(begin, begin + batchSize - 1));
+  // With micro-batching enabled, process the minibatch in chunks of at most
+  // microBatchSize points and accumulate the gradients, so the resident
+  // activations stay bounded by the micro-batch size.
+  if (microBatchSize > 0 && batchSize > microBatchSize)
+  {
+    double res = 0;
+    for (size_t microBegin = 0; microBegin < batchSize;
+        microBegin += microBatchSize)
+    {
+      const size_t effectiveBatchSize = std::min(microBatchSize,
+          batchSize - microBegin);
+      res += EvaluateWithGradientStep(begin + microBegin, microGradient,
+          effectiveBatchSize);
+      gradient += microGradient;
+    }
+    return res;
+  }
+
+  return EvaluateWithGradientStep(begin, gradient, batchSize);
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+template<typename GradType>
+double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::
+EvaluateWithGradientStep(const size_t begin,
+                         GradType& gradient,
+                         const size_t batchSize)
+{
+  // Copy the minibatch into the persistent workspace once; the forward and
+  // gradient passes both read from it, so no per-call input copies are made
+  // and the workspace memory is reused across minibatches.
+  batchWorkspace = predictors.cols(begin, begin + batchSize - 1);
+
+  Forward(batchWorkspace);
   double res = outputLayer.Forward(
       boost::apply_visitor(outputParameterVisitor, network.back()),
       responses.cols(begin, begin + batchSize - 1));
@@ -396,8 +843,11 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
       error);
 
   Backward();
+
+  if (gradient.is_empty())
+    gradient = arma::zeros<arma::mat>(parameter.n_rows, parameter.n_cols);
   ResetGradients(gradient);
-  Gradient(predictors.cols(begin, begin + batchSize - 1));
+  Gradient(batchWorkspace);
 
   return res;
 }
@@ -448,12 +898,18 @@ template<typename OutputLayerType, typename InitializationRuleType,
 void FFN<OutputLayerType, InitializationRuleType,
          CustomLayers...>::ResetGradients(arma::mat& gradient)
 {
+  // The layer gradients are aliases into the given matrix, so re-binding is
+  // only needed when the memory changed since the last call.
+  if (gradient.memptr() == boundGradientMemory)
+    return;
+
   size_t offset = 0;
   for (size_t i = 0; i < network.size(); ++i)
   {
     offset += boost::apply_visitor(GradientSetVisitor(gradient, offset),
         network[i]);
   }
+  boundGradientMemory = gradient.memptr();
 }
 
 template<typename OutputLayerType, typename InitializationRuleType,
@@ -613,6 +1069,14 @@ void FFN<OutputLayerType, InitializationRuleType,
   std::swap(inputParameter, network.inputParameter);
   std::swap(outputParameter, network.outputParameter);
   std::swap(gradient, network.gradient);
+  std::swap(inferencePlan, network.inferencePlan);
+  std::swap(inferencePlanInPlace, network.inferencePlanInPlace);
+  std::swap(planBuffers[0], network.planBuffers[0]);
+  std::swap(planBuffers[1], network.planBuffers[1]);
+  std::swap(microBatchSize, network.microBatchSize);
+  std::swap(batchWorkspace, network.batchWorkspace);
+  std::swap(microGradient, network.microGradient);
+  std::swap(boundGradientMemory, network.boundGradientMemory);
 };
 
 template<typename OutputLayerType, typename InitializationRuleType,
@@ -633,7 +1097,9 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::FFN(
     delta(network.delta),
     inputParameter(network.inputParameter),
     outputParameter(network.outputParameter),
-    gradient(network.gradient)
+    gradient(network.gradient),
+    microBatchSize(network.microBatchSize),
+    boundGradientMemory(NULL)
 {
   // Build new layers according to source network
   for (size_t i = 0; i < network.network.size(); ++i)
@@ -662,7 +1128,9 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::FFN(
     delta(std::move(network.delta)),
     inputParameter(std::move(network.inputParameter)),
     outputParameter(std::move(network.outputParameter)),
-    gradient(std::move(network.gradient))
+    gradient(std::move(network.gradient)),
+    microBatchSize(network.microBatchSize),
+    boundGradientMemory(NULL)
 {
   this->network = std::move(network.network);
 };
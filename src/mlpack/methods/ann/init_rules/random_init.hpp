@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_ANN_INIT_RULES_RANDOM_INIT_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random_stream.hpp>
 
 namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
@@ -58,9 +59,7 @@ class RandomInitialization
     if (W.is_empty())
       W.set_size(rows, cols);
 
-    W.randu();
-    W *= (upperBound - lowerBound);
-    W += lowerBound;
+    Fill(W);
   }
 
   /**
@@ -74,9 +73,7 @@ class RandomInitialization
     if (W.is_empty())
       Log::Fatal << "Cannot initialize an empty matrix." << std::endl;
 
-    W.randu();
-    W *= (upperBound - lowerBound);
-    W += lowerBound;
+    Fill(W);
   }
 
   /**
@@ -116,6 +113,21 @@ class RandomInitialization
   }
 
  private:
+  /**
+   * Fill the given matrix with uniform draws from [lowerBound, upperBound).
+   * The draws come from a counter-based stream keyed off the global
+   * generator (see random_stream.hpp), so the initialization is determined
+   * by the global seed and is bitwise reproducible across platforms and
+   * armadillo versions, unlike arma::randu().
+   */
+  template<typename eT>
+  void Fill(arma::Mat<eT>& W)
+  {
+    math::RandomStream stream(math::randGen());
+    for (size_t i = 0; i < W.n_elem; ++i)
+      W[i] = (eT) stream.Random(lowerBound, upperBound);
+  }
+
   //! The number used as lower bound.
   double lowerBound;
 
@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_ANN_LAYER_BASE_LAYER_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/methods/ann/layer/layer_traits.hpp>
 #include <mlpack/methods/ann/activation_functions/logistic_function.hpp>
 #include <mlpack/methods/ann/activation_functions/identity_function.hpp>
 #include <mlpack/methods/ann/activation_functions/rectifier_function.hpp>
@@ -132,6 +133,22 @@ class BaseLayer
   OutputDataType outputParameter;
 }; // class BaseLayer
 
+//! The activation functions are elementwise, so Forward() may be evaluated
+//! with the output aliasing the input; flag this for in-place inference.
+template<class ActivationFunction, typename InputDataType,
+         typename OutputDataType>
+class LayerTraits<BaseLayer<ActivationFunction, InputDataType,
+    OutputDataType> >
+{
+ public:
+  static const bool IsBinary = false;
+  static const bool IsOutputLayer = false;
+  static const bool IsBiasLayer = false;
+  static const bool IsLSTMLayer = false;
+  static const bool IsConnection = false;
+  static const bool SupportsInPlace = true;
+};
+
 // Convenience typedefs.
 
 /**
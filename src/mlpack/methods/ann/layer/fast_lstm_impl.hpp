@@ -211,45 +211,47 @@ void FastLSTM<InputDataType, OutputDataType>::Forward(
       forwardStep, forwardStep + batchStep);
   gate.cols(forwardStep, forwardStep + batchStep).each_col() += input2GateBias;
 
-  arma::subview<double> sigmoidOut = gateActivation.cols(forwardStep,
-      forwardStep + batchStep);
-  FastSigmoid(
-      gate.submat(0, forwardStep, 3 * outSize - 1, forwardStep + batchStep),
-      sigmoidOut);
-
-  stateActivation.cols(forwardStep, forwardStep + batchStep) = arma::tanh(
-      gate.submat(3 * outSize, forwardStep, 4 * outSize - 1,
-      forwardStep + batchStep));
-
-  // Update the cell: cmul1 + cmul2
-  // where cmul1 is input gate * hidden state and
-  // cmul2 is forget gate * cell (prevCell).
-  if (forwardStep == 0)
+  // Fused pointwise kernel: compute the gate activations, the cell update
+  // (cmul1 + cmul2, where cmul1 is input gate * hidden state and cmul2 is
+  // forget gate * cell (prevCell)), the cell activation and the layer output
+  // in a single pass over the gate block, instead of one element-wise pass
+  // per gate with subview temporaries.
+  const bool firstStep = (forwardStep == 0);
+  for (size_t j = 0; j <= batchStep; ++j)
   {
-    cell.cols(forwardStep, forwardStep + batchStep) =
-        gateActivation.submat(0, forwardStep, outSize - 1,
-        forwardStep + batchStep) %
-        stateActivation.cols(forwardStep, forwardStep + batchStep);
-  }
-  else
-  {
-    cell.cols(forwardStep, forwardStep + batchStep) =
-        gateActivation.submat(0, forwardStep, outSize - 1,
-        forwardStep + batchStep) %
-        stateActivation.cols(forwardStep, forwardStep + batchStep) +
-        gateActivation.submat(2 * outSize, forwardStep, 3 * outSize - 1,
-        forwardStep + batchStep) %
-        cell.cols(forwardStep - batchSize, forwardStep - batchSize + batchStep);
+    const size_t col = forwardStep + j;
+    const ElemType* gateCol = gate.colptr(col);
+    ElemType* activationCol = gateActivation.colptr(col);
+    ElemType* stateCol = stateActivation.colptr(col);
+    ElemType* cellCol = cell.colptr(col);
+    const ElemType* prevCellCol = firstStep ? NULL :
+        cell.colptr(col - batchSize);
+    ElemType* cellActivationCol = cellActivation.colptr(col);
+    ElemType* outputCol = outParameter.colptr(col + batchSize);
+
+    for (size_t i = 0; i < outSize; ++i)
+    {
+      // Input, output and forget gate (sigmoid approximation), and the
+      // candidate cell state (tanh).
+      const ElemType inGate = FastSigmoid(gateCol[i]);
+      const ElemType outGate = FastSigmoid(gateCol[outSize + i]);
+      const ElemType forgetGate = FastSigmoid(gateCol[2 * outSize + i]);
+      const ElemType state = std::tanh(gateCol[3 * outSize + i]);
+
+      activationCol[i] = inGate;
+      activationCol[outSize + i] = outGate;
+      activationCol[2 * outSize + i] = forgetGate;
+      stateCol[i] = state;
+
+      cellCol[i] = firstStep ? inGate * state :
+          inGate * state + forgetGate * prevCellCol[i];
+
+      const ElemType cellActivated = std::tanh(cellCol[i]);
+      cellActivationCol[i] = cellActivated;
+      outputCol[i] = cellActivated * outGate;
+    }
   }
 
-  cellActivation.cols(forwardStep, forwardStep + batchStep) =
-      arma::tanh(cell.cols(forwardStep, forwardStep + batchStep));
-
-  outParameter.cols(forwardStep + batchSize,
-      forwardStep + batchSize + batchStep) = cellActivation.cols(
-      forwardStep, forwardStep + batchStep) % gateActivation.submat(
-      outSize, forwardStep, 2 * outSize - 1, forwardStep + batchStep);
-
   output = OutputType(outParameter.memptr() +
       (forwardStep + batchSize) * outSize, outSize, batchSize, false, false);
 
@@ -53,6 +53,13 @@ class LayerTraits
    * This is true if the layer is a connection layer.
    **/
   static const bool IsConnection = false;
+
+  /**
+   * This is true if the layer is elementwise and its Forward() function may
+   * be called with the output aliasing the input, so inference can mutate
+   * the input buffer in place instead of writing a second activation buffer.
+   */
+  static const bool SupportsInPlace = false;
 };
 
 // This gives us a HasGradientCheck<T, U> type (where U is a function pointer)
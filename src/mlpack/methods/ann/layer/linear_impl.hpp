@@ -16,6 +16,8 @@
 // In case it hasn't yet been included.
 #include "linear.hpp"
 
+#include <mlpack/methods/ann/util/inference_backend.hpp>
+
 namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
 
@@ -112,7 +114,8 @@ template<typename eT>
 void Linear<InputDataType, OutputDataType, RegularizerType>::Forward(
     const arma::Mat<eT>& input, arma::Mat<eT>& output)
 {
-  output = weight * input;
+  if (!InferenceBackend::Multiply(weight, input, output))
+    output = weight * input;
   output.each_col() += bias;
 }
 
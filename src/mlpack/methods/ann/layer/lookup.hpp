@@ -29,6 +29,16 @@ namespace ann /* Artificial Neural Network. */ {
  * The input shape : (sequenceLength, batchSize).
  * The output shape : (embeddingSize, sequenceLength, batchSize).
  *
+ * The backward pass touches only the embeddings of the tokens that appear in
+ * the batch.  By default the layer still materializes a dense gradient the
+ * size of the embedding table, but if SparseGradient() is set, only the
+ * columns touched by the current and the previous pass are rewritten; the
+ * accumulated per-token gradients are also exposed as (column index, gradient
+ * slice) pairs through GradientIndices() and GradientSlices(), so custom
+ * update loops can skip the dense gradient entirely.  In sparse mode the
+ * caller has to keep the dense gradient zeroed outside the emitted columns,
+ * which the FFN gradient machinery already does.
+ *
  * @tparam InputDataType Type of the input data (arma::colvec, arma::mat,
  *         arma::sp_mat or arma::cube).
  * @tparam OutputDataType Type of the output data (arma::colvec, arma::mat,
@@ -105,6 +115,18 @@ class Lookup
   //! Modify the gradient.
   OutputDataType& Gradient() { return gradient; }
 
+  //! Get whether the sparse gradient path is used.
+  bool SparseGradient() const { return sparseGradient; }
+  //! Modify whether the sparse gradient path is used.
+  bool& SparseGradient() { return sparseGradient; }
+
+  //! Get the embedding table columns touched by the last gradient pass.
+  arma::uvec const& GradientIndices() const { return gradientIndices; }
+
+  //! Get the accumulated gradient slices of the touched columns; column i
+  //! holds the gradient of embedding table column GradientIndices()[i].
+  OutputDataType const& GradientSlices() const { return gradientSlices; }
+
   //! Get the size of the vocabulary.
   size_t VocabSize() const { return vocabSize; }
 
@@ -133,6 +155,20 @@ class Lookup
   //! Locally-stored gradient object.
   OutputDataType gradient;
 
+  //! Whether only the touched embedding table columns are rewritten in the
+  //! dense gradient.
+  bool sparseGradient;
+
+  //! Locally-stored columns touched by the last gradient pass.
+  arma::uvec gradientIndices;
+
+  //! Locally-stored accumulated gradient slices of the touched columns.
+  OutputDataType gradientSlices;
+
+  //! Locally-stored columns touched by the pass before the last one; in
+  //! sparse mode these are the stale columns that have to be cleared.
+  arma::uvec previousIndices;
+
   //! Locally-stored output parameter object.
   OutputDataType outputParameter;
 }; // class Lookup
@@ -24,7 +24,8 @@ Lookup<InputDataType, OutputDataType>::Lookup(
     const size_t vocabSize,
     const size_t embeddingSize) :
     vocabSize(vocabSize),
-    embeddingSize(embeddingSize)
+    embeddingSize(embeddingSize),
+    sparseGradient(false)
 {
   weights.set_size(embeddingSize, vocabSize);
 }
@@ -69,17 +70,46 @@ void Lookup<InputDataType, OutputDataType>::Gradient(
   const size_t seqLength = input.n_rows;
   const size_t batchSize = input.n_cols;
 
-  arma::Cube<eT> errorTemp(const_cast<arma::Mat<eT>&>(error).memptr(),
-      embeddingSize, seqLength, batchSize, false, false);
+  // Column i of the flattened error is the error of the i-th token of the
+  // flattened input, both taken in column-major order.
+  const arma::Mat<eT> errorTemp(const_cast<arma::Mat<eT>&>(error).memptr(),
+      embeddingSize, seqLength * batchSize, false, false);
+  const arma::uvec tokens = arma::conv_to<arma::uvec>::from(
+      arma::vectorise(input)) - 1;
 
-  gradient.set_size(arma::size(weights));
-  gradient.zeros();
+  // Accumulate one gradient slice per distinct token, so the accumulation
+  // work scales with the number of tokens in the batch instead of with the
+  // size of the vocabulary.  Both gradientIndices and the sorted tokens are
+  // ascending, so a single merge walk maps every token to its slice.
+  gradientIndices = arma::unique(tokens);
+  const arma::uvec order = arma::sort_index(tokens);
 
-  for (size_t i = 0; i < batchSize; ++i)
+  gradientSlices.zeros(embeddingSize, gradientIndices.n_elem);
+  for (size_t i = 0, slot = 0; i < order.n_elem; ++i)
+  {
+    while (gradientIndices[slot] < tokens[order[i]])
+      ++slot;
+    gradientSlices.col(slot) += errorTemp.col(order[i]);
+  }
+
+  if (sparseGradient && gradient.n_rows == weights.n_rows &&
+      gradient.n_cols == weights.n_cols)
   {
-    gradient.cols(arma::conv_to<arma::uvec>::from(input.col(i)) - 1)
-        += errorTemp.slice(i);
+    // Clear the columns written by the previous pass; everything else is
+    // already zero, so the whole embedding table is never rewritten.
+    for (size_t i = 0; i < previousIndices.n_elem; ++i)
+      gradient.col(previousIndices[i]).zeros();
   }
+  else
+  {
+    gradient.set_size(arma::size(weights));
+    gradient.zeros();
+  }
+
+  for (size_t i = 0; i < gradientIndices.n_elem; ++i)
+    gradient.col(gradientIndices[i]) = gradientSlices.col(i);
+
+  previousIndices = gradientIndices;
 }
 
 template<typename InputDataType, typename OutputDataType>
@@ -283,35 +283,19 @@ void LSTM<InputDataType, OutputDataType>::Forward(const InputType& input,
   forgetGate.cols(forwardStep, forwardStep + batchStep).each_col() +=
       input2GateForgetBias;
 
-  if (forwardStep > 0)
+  if (forwardStep > 0 && useCellState)
   {
-    if (useCellState)
+    if (!cellState.is_empty())
     {
-      if (!cellState.is_empty())
-      {
-        cell.cols(forwardStep - batchSize,
-            forwardStep - batchSize + batchStep) = cellState;
-      }
-      else
-      {
-        throw std::runtime_error("Cell parameter is empty.");
-      }
+      cell.cols(forwardStep - batchSize,
+          forwardStep - batchSize + batchStep) = cellState;
+    }
+    else
+    {
+      throw std::runtime_error("Cell parameter is empty.");
     }
-    inputGate.cols(forwardStep, forwardStep + batchStep) +=
-        arma::repmat(cell2GateInputWeight, 1, batchSize) %
-        cell.cols(forwardStep - batchSize, forwardStep - batchSize + batchStep);
-
-    forgetGate.cols(forwardStep, forwardStep + batchStep) +=
-        arma::repmat(cell2GateForgetWeight, 1, batchSize) %
-        cell.cols(forwardStep - batchSize, forwardStep - batchSize + batchStep);
   }
 
-  inputGateActivation.cols(forwardStep, forwardStep + batchStep) = 1.0 /
-      (1 + arma::exp(-inputGate.cols(forwardStep, forwardStep + batchStep)));
-
-  forgetGateActivation.cols(forwardStep, forwardStep + batchStep) = 1.0 /
-      (1 + arma::exp(-forgetGate.cols(forwardStep, forwardStep + batchStep)));
-
   hiddenLayer.cols(forwardStep, forwardStep + batchStep) = input2HiddenWeight *
       input + output2HiddenWeight * outParameter.cols(
       forwardStep, forwardStep + batchStep);
@@ -319,42 +303,66 @@ void LSTM<InputDataType, OutputDataType>::Forward(const InputType& input,
   hiddenLayer.cols(forwardStep, forwardStep + batchStep).each_col() +=
       input2HiddenBias;
 
-  hiddenLayerActivation.cols(forwardStep, forwardStep + batchStep) =
-      arma::tanh(hiddenLayer.cols(forwardStep, forwardStep + batchStep));
-
-  if (forwardStep == 0)
-  {
-    cell.cols(forwardStep, forwardStep + batchStep) =
-        inputGateActivation.cols(forwardStep, forwardStep + batchStep) %
-        hiddenLayerActivation.cols(forwardStep, forwardStep + batchStep);
-  }
-  else
-  {
-    cell.cols(forwardStep, forwardStep + batchStep) =
-        forgetGateActivation.cols(forwardStep, forwardStep + batchStep) %
-        cell.cols(forwardStep - batchSize, forwardStep - batchSize + batchStep)
-        + inputGateActivation.cols(forwardStep, forwardStep + batchStep) %
-        hiddenLayerActivation.cols(forwardStep, forwardStep + batchStep);
-  }
-
+  // The output gate peephole term depends on the updated cell, so only the
+  // matrix products and the bias are computed here; the peephole contribution
+  // is added in the fused element-wise pass below.
   outputGate.cols(forwardStep, forwardStep + batchStep) = input2GateOutputWeight
       * input + output2GateOutputWeight * outParameter.cols(
-      forwardStep, forwardStep + batchStep) + cell.cols(forwardStep,
-      forwardStep + batchStep).each_col() % cell2GateOutputWeight;
+      forwardStep, forwardStep + batchStep);
 
   outputGate.cols(forwardStep, forwardStep + batchStep).each_col() +=
       input2GateOutputBias;
 
-  outputGateActivation.cols(forwardStep, forwardStep + batchStep) = 1.0 /
-      (1 + arma::exp(-outputGate.cols(forwardStep, forwardStep + batchStep)));
+  // Fused element-wise kernel: add the peephole contributions to the gate
+  // pre-activations, apply the gate activations, update the cell, and produce
+  // the layer output in a single pass over the gate blocks, instead of one
+  // element-wise pass per gate with subview temporaries.
+  typedef typename OutputDataType::elem_type ElemType;
+  const bool firstStep = (forwardStep == 0);
+  for (size_t j = 0; j <= batchStep; ++j)
+  {
+    const size_t col = forwardStep + j;
+    ElemType* inputGateCol = inputGate.colptr(col);
+    ElemType* forgetGateCol = forgetGate.colptr(col);
+    const ElemType* hiddenLayerCol = hiddenLayer.colptr(col);
+    ElemType* outputGateCol = outputGate.colptr(col);
+    ElemType* inputActivationCol = inputGateActivation.colptr(col);
+    ElemType* forgetActivationCol = forgetGateActivation.colptr(col);
+    ElemType* hiddenActivationCol = hiddenLayerActivation.colptr(col);
+    ElemType* outputActivationCol = outputGateActivation.colptr(col);
+    ElemType* cellCol = cell.colptr(col);
+    const ElemType* prevCellCol = firstStep ? NULL :
+        cell.colptr(col - batchSize);
+    ElemType* cellActivationCol = cellActivation.colptr(col);
+    ElemType* outCol = outParameter.colptr(col + batchSize);
+
+    for (size_t i = 0; i < outSize; ++i)
+    {
+      if (!firstStep)
+      {
+        inputGateCol[i] += cell2GateInputWeight[i] * prevCellCol[i];
+        forgetGateCol[i] += cell2GateForgetWeight[i] * prevCellCol[i];
+      }
+
+      const ElemType inGateValue = 1.0 / (1.0 + std::exp(-inputGateCol[i]));
+      const ElemType forgetGateValue = 1.0 /
+          (1.0 + std::exp(-forgetGateCol[i]));
+      const ElemType hiddenValue = std::tanh(hiddenLayerCol[i]);
+
+      inputActivationCol[i] = inGateValue;
+      forgetActivationCol[i] = forgetGateValue;
+      hiddenActivationCol[i] = hiddenValue;
 
-  cellActivation.cols(forwardStep, forwardStep + batchStep) =
-      arma::tanh(cell.cols(forwardStep, forwardStep + batchStep));
+      cellCol[i] = firstStep ? inGateValue * hiddenValue :
+          forgetGateValue * prevCellCol[i] + inGateValue * hiddenValue;
 
-  outParameter.cols(forwardStep + batchSize,
-      forwardStep + batchSize + batchStep) =
-      cellActivation.cols(forwardStep, forwardStep + batchStep) %
-      outputGateActivation.cols(forwardStep, forwardStep + batchStep);
+      outputGateCol[i] += cell2GateOutputWeight[i] * cellCol[i];
+      outputActivationCol[i] = 1.0 / (1.0 + std::exp(-outputGateCol[i]));
+
+      cellActivationCol[i] = std::tanh(cellCol[i]);
+      outCol[i] = cellActivationCol[i] * outputActivationCol[i];
+    }
+  }
 
   output = OutputType(outParameter.memptr() +
       (forwardStep + batchSize) * outSize, outSize, batchSize, false, false);
@@ -88,7 +88,7 @@ template <typename eT>
 void MultiheadAttention<InputDataType, OutputDataType, RegularizerType>::
 Forward(const arma::Mat<eT>& input, arma::Mat<eT>& output)
 {
-  typedef typename arma::Cube<eT> CubeType;
+  typedef typename arma::Mat<eT> MatType;
 
   if (input.n_rows != embedDim * (tgtSeqLen + 2 * srcSeqLen))
   {
@@ -100,18 +100,28 @@ Forward(const arma::Mat<eT>& input, arma::Mat<eT>& output)
   // shape of output : (embedDim * tgtSeqLen, batchSize).
   output.set_size(embedDim * tgtSeqLen, batchSize);
 
-  // Reshape the input, the query, and the key into a cube from a matrix.
-  // The shape of q : (embedDim, tgtSeqLen, batchSize).
-  // The shape of k : (embedDim, srcSeqLen, batchSize).
-  // The shape of v : (embedDim, srcSeqLen, batchSize).
-  const CubeType q(const_cast<arma::Mat<eT>&>(input).memptr(),
-      embedDim, tgtSeqLen, batchSize, false, false);
-  const CubeType k(const_cast<arma::Mat<eT>&>(input).memptr() +
+  // View the query, the key and the value parts of the input as matrices
+  // with one sequence element per column, so that each projection can be
+  // computed with one fused matrix product for the whole batch instead of
+  // one product per batch item.
+  // The shape of qMat : (embedDim, tgtSeqLen * batchSize).
+  // The shape of kMat : (embedDim, srcSeqLen * batchSize).
+  // The shape of vMat : (embedDim, srcSeqLen * batchSize).
+  const MatType qMat(const_cast<arma::Mat<eT>&>(input).memptr(),
+      embedDim, tgtSeqLen * batchSize, false, false);
+  const MatType kMat(const_cast<arma::Mat<eT>&>(input).memptr() +
       embedDim * tgtSeqLen * batchSize,
-      embedDim, srcSeqLen, batchSize, false, false);
-  const CubeType v(const_cast<arma::Mat<eT>&>(input).memptr() +
+      embedDim, srcSeqLen * batchSize, false, false);
+  const MatType vMat(const_cast<arma::Mat<eT>&>(input).memptr() +
       embedDim * (tgtSeqLen + srcSeqLen) * batchSize,
-      embedDim, srcSeqLen, batchSize, false, false);
+      embedDim, srcSeqLen * batchSize, false, false);
+
+  MatType qProjMat = queryWt * qMat;
+  qProjMat.each_col() += qBias;
+  MatType kProjMat = keyWt * kMat;
+  kProjMat.each_col() += kBias;
+  MatType vProjMat = valueWt * vMat;
+  vProjMat.each_col() += vBias;
 
   // qProj, kProj, and vProj are the linearly projected query, key and value
   // respectively.
@@ -119,14 +129,15 @@ Forward(const arma::Mat<eT>& input, arma::Mat<eT>& output)
   kProj.set_size(srcSeqLen, embedDim, batchSize);
   vProj.set_size(srcSeqLen, embedDim, batchSize);
 
-  for (size_t i = 0; i < batchSize; ++i)
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) batchSize; ++i)
   {
     qProj.slice(i) = arma::trans(
-        queryWt * q.slice(i) + arma::repmat(qBias, 1, tgtSeqLen));
+        qProjMat.cols(i * tgtSeqLen, (i + 1) * tgtSeqLen - 1));
     kProj.slice(i) = arma::trans(
-        keyWt * k.slice(i) + arma::repmat(kBias, 1, srcSeqLen));
+        kProjMat.cols(i * srcSeqLen, (i + 1) * srcSeqLen - 1));
     vProj.slice(i) = arma::trans(
-        valueWt * v.slice(i) + arma::repmat(vBias, 1, srcSeqLen));
+        vProjMat.cols(i * srcSeqLen, (i + 1) * srcSeqLen - 1));
   }
 
   // The scaling factor sqrt(headDim) is used to prevent exploding values
@@ -165,10 +176,16 @@ Forward(const arma::Mat<eT>& input, arma::Mat<eT>& output)
     scores.each_slice() += arma::repmat(keyPaddingMask, tgtSeqLen, 1);
   }
 
-  for (size_t i = 0; i < numHeads * batchSize; ++i)
+  // Apply the softmax to each slice in place, processing the slices in
+  // parallel.  This computes exactly what the Softmax layer's Forward()
+  // would, but without materializing a second copy of the score cube.  The
+  // score cube itself has to be kept for the backward pass.
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) (numHeads * batchSize); ++i)
   {
-    softmax.Forward(scores.slice(i), softmax.OutputParameter());
-    scores.slice(i) = softmax.OutputParameter();
+    scores.slice(i).each_row() -= arma::max(scores.slice(i), 0);
+    scores.slice(i) = arma::exp(scores.slice(i));
+    scores.slice(i).each_row() /= arma::sum(scores.slice(i), 0);
   }
 
   // Calculate the attention output i.e. matrix multiplication of softmax
@@ -180,12 +197,21 @@ Forward(const arma::Mat<eT>& input, arma::Mat<eT>& output)
   // attnOut to (tgtSeqLen, embedDim, batchSize).
   attnOut.reshape(tgtSeqLen, embedDim, batchSize);
 
-  // The final output is the linear projection of attention output.
-  for (size_t i = 0; i < batchSize; ++i)
+  // The final output is the linear projection of the attention output,
+  // again computed with one fused matrix product for the whole batch.  Each
+  // slice is transposed so that the projected columns land directly in the
+  // layout of the output matrix.
+  MatType attnTrans(embedDim, tgtSeqLen * batchSize);
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) batchSize; ++i)
   {
-    output.col(i) = arma::vectorise(arma::trans(attnOut.slice(i) * outWt
-        + arma::repmat(outBias, tgtSeqLen, 1)));
+    attnTrans.cols(i * tgtSeqLen, (i + 1) * tgtSeqLen - 1) =
+        arma::trans(attnOut.slice(i));
   }
+
+  MatType outProj = outWt.t() * attnTrans;
+  outProj.each_col() += outBias.t();
+  output = arma::reshape(outProj, embedDim * tgtSeqLen, batchSize);
 }
 
 template <typename InputDataType, typename OutputDataType,
@@ -243,9 +269,12 @@ Backward(const arma::Mat<eT>& /* input */,
   // So the new shape of gyTemp : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
   gyTemp = math::MultiplyCube2Cube(gyTemp, vProj, false, true);
 
-  for (size_t i = 0; i < numHeads * batchSize; ++i)
+  // We will perform backpropagation of softmax over each slice of gyTemp.
+  // The softmax backward pass is stateless, so the slices can be processed
+  // in parallel.
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) (numHeads * batchSize); ++i)
   {
-    // We will perform backpropagation of softmax over each slice of gyTemp.
     softmax.Backward(scores.slice(i), gyTemp.slice(i), gyTemp.slice(i));
   }
 
@@ -372,11 +401,13 @@ Gradient(const arma::Mat<eT>& input,
   // The new shape of errorTemp : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
   errorTemp = math::MultiplyCube2Cube(gyTemp, vProj, false, true);
 
-  for (size_t i = 0; i < numHeads * batchSize; ++i)
+  // The shape of scores : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
+  // The shape of errorTemp : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
+  // The new shape of errorTemp remain same.  The softmax backward pass is
+  // stateless, so the slices can be processed in parallel.
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) (numHeads * batchSize); ++i)
   {
-    // The shape of scores : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
-    // The shape of errorTemp : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
-    // The new shape of errorTemp remain same.
     softmax.Backward(scores.slice(i), errorTemp.slice(i), errorTemp.slice(i));
   }
 
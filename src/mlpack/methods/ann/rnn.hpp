@@ -179,6 +179,44 @@ class RNN
                arma::cube responses,
                CallbackTypes&&... callbacks);
 
+  /**
+   * Train the recurrent neural network on the given input data with
+   * length-bucketed batching and truncated backpropagation through time.
+   *
+   * When the sequences have very different lengths, padding all of them to a
+   * common number of slices wastes most of the unroll on padding.  Here the
+   * sequences are sorted by length and grouped into buckets of at most
+   * bucketSize sequences, and each bucket is unrolled only to the length of
+   * the longest sequence it contains.  Buckets longer than Rho() are split
+   * into windows of at most Rho() steps and BPTT is truncated at the window
+   * boundaries; the recurrent state is not carried across windows.  In
+   * single response mode only the final window of each bucket is trained,
+   * since the earlier windows have no targets.
+   *
+   * The data format is the same as for Train(); sequences shorter than the
+   * number of slices are expected to be padded at the end, and
+   * sequenceLengths holds the unpadded length of each sequence (column).
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param predictors Input training variables.
+   * @param responses Outputs results from input training variables.
+   * @param sequenceLengths Unpadded length of each input sequence.
+   * @param bucketSize Maximum number of sequences per bucket.
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The accumulated final objectives of the bucket optimizations
+   *      (NaN or Inf on error).
+   */
+  template<typename OptimizerType, typename... CallbackTypes>
+  double TrainBucketed(arma::cube predictors,
+                       arma::cube responses,
+                       const arma::urowvec& sequenceLengths,
+                       const size_t bucketSize,
+                       OptimizerType& optimizer,
+                       CallbackTypes&&... callbacks);
+
   /**
    * Predict the responses to a given set of predictors. The responses will
    * reflect the output of the given output layer as returned by the
@@ -202,6 +240,29 @@ class RNN
                arma::cube& results,
                const size_t batchSize = 256);
 
+  /**
+   * Predict the response to a single time step, carrying the recurrent state
+   * (e.g. LSTM cell states) across calls.  This is meant for incremental
+   * (autoregressive) decoding: instead of re-running Predict() on the whole
+   * prefix for every generated step, call PredictStep() once per step and
+   * feed each generated output back in as the next input, so that step t
+   * costs a single pass through the network instead of t passes.
+   *
+   * Pass resetState = true at the start of every new sequence; subsequent
+   * calls continue from the state left by the previous call.  The recurrent
+   * layers can carry their state across at most Rho() steps, so increase
+   * Rho() before decoding sequences longer than that.
+   *
+   * @param predictors Input for a single time step, one column per data
+   *      point.
+   * @param results Matrix to put the output predictions of the step into.
+   * @param resetState Whether to reset the recurrent state before this step
+   *      (i.e. whether this is the first step of a new sequence).
+   */
+  void PredictStep(const arma::mat& predictors,
+                   arma::mat& results,
+                   const bool resetState = false);
+
   /**
    * Evaluate the recurrent neural network with the given parameters. This
    * function is usually called by the optimizer to train the model.
@@ -436,6 +497,10 @@ class RNN
   //! The current evaluation mode (training or testing).
   bool deterministic;
 
+  //! The number of steps taken since the last state reset during incremental
+  //! prediction with PredictStep().
+  size_t predictionStep;
+
   //! The current gradient for the gradient pass.
   arma::mat currentGradient;
 
@@ -46,7 +46,8 @@ RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::RNN(
     reset(false),
     single(single),
     numFunctions(0),
-    deterministic(true)
+    deterministic(true),
+    predictionStep(0)
 {
   /* Nothing to do here */
 }
@@ -65,7 +66,8 @@ RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::RNN(
     single(network.single),
     parameter(network.parameter),
     numFunctions(network.numFunctions),
-    deterministic(network.deterministic)
+    deterministic(network.deterministic),
+    predictionStep(network.predictionStep)
 {
   for (size_t i = 0; i < network.network.size(); ++i)
   {
@@ -90,6 +92,7 @@ RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::RNN(
     parameter(std::move(network.parameter)),
     numFunctions(std::move(network.numFunctions)),
     deterministic(std::move(network.deterministic)),
+    predictionStep(std::move(network.predictionStep)),
     network(std::move(network.network))
 {
   // Nothing to do here.
@@ -187,6 +190,7 @@ void RNN<OutputLayerType, InitializationRuleType,
   {
     boost::apply_visitor(ResetCellVisitor(rho), network[i]);
   }
+  predictionStep = 0;
 }
 
 template<typename OutputLayerType, typename InitializationRuleType,
@@ -228,6 +232,109 @@ double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
   return out;
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+template<typename OptimizerType, typename... CallbackTypes>
+double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::
+TrainBucketed(arma::cube predictors,
+              arma::cube responses,
+              const arma::urowvec& sequenceLengths,
+              const size_t bucketSize,
+              OptimizerType& optimizer,
+              CallbackTypes&&... callbacks)
+{
+  CheckInputShape<std::vector<LayerTypes<CustomLayers...> > >(
+      network, predictors.n_rows, "RNN<>::TrainBucketed()");
+
+  if (sequenceLengths.n_elem != predictors.n_cols)
+  {
+    Log::Fatal << "RNN<>::TrainBucketed(): the number of sequence lengths ("
+        << sequenceLengths.n_elem << ") does not match the number of "
+        << "sequences (" << predictors.n_cols << ")!" << std::endl;
+  }
+
+  if (bucketSize == 0)
+  {
+    Log::Fatal << "RNN<>::TrainBucketed(): bucketSize must be greater than 0!"
+        << std::endl;
+  }
+
+  this->deterministic = true;
+  ResetDeterministic();
+
+  if (!reset)
+  {
+    ResetParameters();
+  }
+
+  WarnMessageMaxIterations<OptimizerType>(optimizer, bucketSize);
+
+  // Sort the sequences by length, so that each bucket holds sequences of
+  // similar length and is unrolled only to the longest one it contains.
+  const arma::uvec order = arma::sort_index(sequenceLengths);
+  const size_t maxRho = rho;
+  double objective = 0;
+
+  Timer::Start("rnn_optimization");
+  for (size_t bucketBegin = 0; bucketBegin < order.n_elem;
+      bucketBegin += bucketSize)
+  {
+    const size_t bucketEnd = std::min(bucketBegin + bucketSize,
+        size_t(order.n_elem));
+    const arma::uvec bucket = order.subvec(bucketBegin, bucketEnd - 1);
+    const size_t bucketLength = std::max(size_t(1), std::min(
+        size_t(sequenceLengths(bucket(bucket.n_elem - 1))),
+        size_t(predictors.n_slices)));
+
+    // Gather the bucket into contiguous storage, trimmed to the length of
+    // its longest sequence; only the spread within the bucket is padded.
+    arma::cube bucketPredictors(predictors.n_rows, bucket.n_elem,
+        bucketLength);
+    for (size_t s = 0; s < bucketLength; ++s)
+      bucketPredictors.slice(s) = predictors.slice(s).cols(bucket);
+
+    arma::cube bucketResponses(responses.n_rows, bucket.n_elem,
+        single ? 1 : bucketLength);
+    for (size_t s = 0; s < bucketResponses.n_slices; ++s)
+      bucketResponses.slice(s) = responses.slice(s).cols(bucket);
+
+    // Split buckets longer than the configured rho into windows; BPTT is
+    // truncated at the window boundaries.  In single response mode only the
+    // final window has a target, so the earlier windows are skipped.
+    const size_t firstWindow = (single && bucketLength > maxRho) ?
+        bucketLength - maxRho : 0;
+    for (size_t windowBegin = firstWindow; windowBegin < bucketLength;
+        windowBegin += maxRho)
+    {
+      const size_t windowLength = std::min(maxRho,
+          bucketLength - windowBegin);
+
+      rho = windowLength;
+      numFunctions = bucket.n_elem;
+      this->predictors = bucketPredictors.slices(windowBegin,
+          windowBegin + windowLength - 1);
+      if (single)
+      {
+        this->responses = bucketResponses;
+      }
+      else
+      {
+        this->responses = bucketResponses.slices(windowBegin,
+            windowBegin + windowLength - 1);
+      }
+
+      objective += optimizer.Optimize(*this, parameter, callbacks...);
+    }
+  }
+  Timer::Stop("rnn_optimization");
+
+  rho = maxRho;
+
+  Log::Info << "RNN::TrainBucketed(): accumulated final objective of trained "
+      << "model is " << objective << "." << std::endl;
+  return objective;
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
@@ -280,6 +387,47 @@ void RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
   }
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void RNN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::PredictStep(
+    const arma::mat& predictors, arma::mat& results, const bool resetState)
+{
+  CheckInputShape<std::vector<LayerTypes<CustomLayers...> > >(
+      network, predictors.n_rows, "RNN<>::PredictStep()");
+
+  // The state is also reset on the very first step, where there is no
+  // previous state to continue from.
+  if (resetState || predictionStep == 0)
+  {
+    ResetCells();
+  }
+  else if (predictionStep >= rho)
+  {
+    // The recurrent layers wrap their state buffers after rho steps, so
+    // continuing here would silently restart from a cleared state.
+    Log::Fatal << "RNN<>::PredictStep(): the recurrent state can only be "
+        << "carried across Rho() steps; pass resetState = true at the start "
+        << "of each sequence, and increase Rho() to decode longer sequences."
+        << std::endl;
+  }
+
+  if (parameter.is_empty())
+  {
+    ResetParameters();
+  }
+
+  if (!deterministic)
+  {
+    deterministic = true;
+    ResetDeterministic();
+  }
+
+  Forward(predictors);
+  results = boost::apply_visitor(outputParameterVisitor, network.back());
+  ++predictionStep;
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Evaluate(
@@ -0,0 +1,257 @@
+/**
+ * @file methods/ann/static_ffn.hpp
+ *
+ * Definition of the StaticFFN class, a feed forward network whose layer list
+ * is fixed at compile time.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_STATIC_FFN_HPP
+#define MLPACK_METHODS_ANN_STATIC_FFN_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <mlpack/methods/ann/layer/layer_traits.hpp>
+#include <mlpack/methods/ann/init_rules/random_init.hpp>
+#include <mlpack/methods/ann/loss_functions/negative_log_likelihood.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Implementation of a standard feed forward network whose layers are held in
+ * a std::tuple of concrete layer types instead of a vector of boost::variant
+ * objects.  Every Forward() call is unrolled at compile time into direct
+ * member function calls, so there is no visitor dispatch per layer and the
+ * compiler is free to inline across layer boundaries; for small models this
+ * makes inference considerably faster than FFN.
+ *
+ * The layer implementations are shared with FFN, and the parameter layout
+ * matches an FFN built by adding the same layers in the same order.  The
+ * intended use is to train a regular FFN and move the trained parameters
+ * into the static network for deployment:
+ *
+ * @code
+ * FFN<> model;
+ * model.Add<Linear<> >(10, 8);
+ * model.Add<SigmoidLayer<> >();
+ * model.Add<Linear<> >(8, 3);
+ * model.Add<LogSoftMax<> >();
+ * model.Train(trainData, trainLabels);
+ *
+ * StaticFFN<NegativeLogLikelihood<>, RandomInitialization,
+ *     Linear<>, SigmoidLayer<>, Linear<>, LogSoftMax<> > staticModel(
+ *     Linear<>(10, 8), SigmoidLayer<>(), Linear<>(8, 3), LogSoftMax<>());
+ * staticModel.ResetParameters();
+ * staticModel.Parameters() = model.Parameters();
+ * staticModel.Predict(testData, predictions);
+ * @endcode
+ *
+ * Training is not implemented here; the architecture is meant for inference,
+ * and the dynamic FFN already covers training with the same layers.
+ *
+ * @tparam OutputLayerType The output layer type used to evaluate the network.
+ * @tparam InitializationRuleType Rule used to initialize the weight matrix.
+ * @tparam Layers The concrete types of the layers, in forward order.
+ */
+template<typename OutputLayerType = NegativeLogLikelihood<>,
+         typename InitializationRuleType = RandomInitialization,
+         typename... Layers>
+class StaticFFN
+{
+ public:
+  //! The number of layers in the network.
+  static const size_t NumLayers = sizeof...(Layers);
+
+  /**
+   * Create the StaticFFN object from the given layer instances.
+   *
+   * @param layers The layer instances, in forward order.
+   */
+  StaticFFN(Layers... layers);
+
+  /**
+   * Reset the module information (weights), so that the network can be used.
+   * The parameter matrix is sized to hold all layer weights, initialized
+   * with the initialization rule, and the layer weights are bound into it
+   * with the same layout FFN uses; assigning an equally-sized matrix to
+   * Parameters() afterwards therefore loads trained FFN weights.
+   */
+  void ResetParameters();
+
+  /**
+   * Predict the responses to a given set of predictors. The responses will
+   * reflect the output of the given output layer as returned by the
+   * output layer function.
+   *
+   * @param predictors Input predictors.
+   * @param results Matrix to put output predictions of responses into.
+   * @param batchSize Number of points to predict at once.
+   */
+  void Predict(arma::mat predictors,
+               arma::mat& results,
+               const size_t batchSize = 128);
+
+  /**
+   * Perform a forward pass of the data in real batch mode.
+   *
+   * @param inputs The input data.
+   * @param results The predicted results.
+   */
+  void Forward(const arma::mat& inputs, arma::mat& results);
+
+  /**
+   * Evaluate the static network with the given predictors and responses.
+   * This functions is usually used to monitor progress while training.
+   *
+   * @param predictors Input variables.
+   * @param responses Target outputs for input variables.
+   */
+  double Evaluate(const arma::mat& predictors, const arma::mat& responses);
+
+  //! Get the I'th layer of the network.
+  template<size_t I>
+  typename std::tuple_element<I, std::tuple<Layers...> >::type& Layer()
+  {
+    return std::get<I>(network);
+  }
+
+  //! Get the initial point for the optimization.
+  const arma::mat& Parameters() const { return parameter; }
+  //! Modify the initial point for the optimization.
+  arma::mat& Parameters() { return parameter; }
+
+ private:
+  /**
+   * Reset the module status by setting the current deterministic parameter
+   * for all modules that implement the Deterministic function.
+   */
+  template<size_t I>
+  typename std::enable_if<I == NumLayers, void>::type
+  ResetDeterministic() { }
+
+  template<size_t I>
+  typename std::enable_if<(I < NumLayers), void>::type
+  ResetDeterministic()
+  {
+    SetLayerDeterministic(std::get<I>(network));
+    ResetDeterministic<I + 1>();
+  }
+
+  //! Compute the total number of weights of the layers I and onwards.
+  template<size_t I>
+  typename std::enable_if<I == NumLayers, size_t>::type
+  WeightSize() { return 0; }
+
+  template<size_t I>
+  typename std::enable_if<(I < NumLayers), size_t>::type
+  WeightSize()
+  {
+    return LayerWeightSize(std::get<I>(network)) + WeightSize<I + 1>();
+  }
+
+  //! Bind the weights of the layers I and onwards into the parameter matrix,
+  //! starting at the given offset.
+  template<size_t I>
+  typename std::enable_if<I == NumLayers, void>::type
+  SetWeights(const size_t /* offset */) { }
+
+  template<size_t I>
+  typename std::enable_if<(I < NumLayers), void>::type
+  SetWeights(const size_t offset)
+  {
+    BindLayerWeights(std::get<I>(network), offset);
+    SetWeights<I + 1>(offset + LayerWeightSize(std::get<I>(network)));
+  }
+
+  //! Run the forward pass through the layers I and onwards.
+  template<size_t I, typename InputType>
+  typename std::enable_if<I == NumLayers, void>::type
+  ForwardLayers(const InputType& /* input */) { }
+
+  template<size_t I, typename InputType>
+  typename std::enable_if<(I < NumLayers), void>::type
+  ForwardLayers(const InputType& input)
+  {
+    std::get<I>(network).Forward(input,
+        std::get<I>(network).OutputParameter());
+    ForwardLayers<I + 1>(std::get<I>(network).OutputParameter());
+  }
+
+  //! The number of weights of the given layer; zero if the layer has no
+  //! Parameters() function.
+  template<typename LayerType>
+  typename std::enable_if<HasParametersCheck<LayerType,
+      arma::mat&(LayerType::*)()>::value, size_t>::type
+  LayerWeightSize(LayerType& layer) { return layer.Parameters().n_elem; }
+
+  template<typename LayerType>
+  typename std::enable_if<!HasParametersCheck<LayerType,
+      arma::mat&(LayerType::*)()>::value, size_t>::type
+  LayerWeightSize(LayerType& /* layer */) { return 0; }
+
+  //! Bind the weights of the given layer into the parameter matrix; a no-op
+  //! if the layer has no Parameters() function.  The layer weights become an
+  //! alias of the corresponding section of the parameter matrix, just like
+  //! WeightSetVisitor makes them for FFN.
+  template<typename LayerType>
+  typename std::enable_if<HasParametersCheck<LayerType,
+      arma::mat&(LayerType::*)()>::value, void>::type
+  BindLayerWeights(LayerType& layer, const size_t offset)
+  {
+    layer.Parameters() = arma::mat(parameter.memptr() + offset,
+        layer.Parameters().n_rows, layer.Parameters().n_cols, false, false);
+    ResetLayer(layer);
+  }
+
+  template<typename LayerType>
+  typename std::enable_if<!HasParametersCheck<LayerType,
+      arma::mat&(LayerType::*)()>::value, void>::type
+  BindLayerWeights(LayerType& /* layer */, const size_t /* offset */) { }
+
+  //! Call Reset() on the given layer if it implements it.
+  template<typename LayerType>
+  typename std::enable_if<HasResetCheck<LayerType,
+      void(LayerType::*)()>::value, void>::type
+  ResetLayer(LayerType& layer) { layer.Reset(); }
+
+  template<typename LayerType>
+  typename std::enable_if<!HasResetCheck<LayerType,
+      void(LayerType::*)()>::value, void>::type
+  ResetLayer(LayerType& /* layer */) { }
+
+  //! Set the deterministic flag of the given layer if it implements it.
+  template<typename LayerType>
+  typename std::enable_if<HasDeterministicCheck<LayerType,
+      bool&(LayerType::*)(void)>::value, void>::type
+  SetLayerDeterministic(LayerType& layer) { layer.Deterministic() = true; }
+
+  template<typename LayerType>
+  typename std::enable_if<!HasDeterministicCheck<LayerType,
+      bool&(LayerType::*)(void)>::value, void>::type
+  SetLayerDeterministic(LayerType& /* layer */) { }
+
+  //! Locally-stored layer modules.
+  std::tuple<Layers...> network;
+
+  //! The output layer used to evaluate the network.
+  OutputLayerType outputLayer;
+
+  //! Instantiated InitializationRule object for initializing the network
+  //! parameter.
+  InitializationRuleType initializeRule;
+
+  //! Matrix of (trained) parameters.
+  arma::mat parameter;
+}; // class StaticFFN
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "static_ffn_impl.hpp"
+
+#endif
@@ -0,0 +1,96 @@
+/**
+ * @file methods/ann/static_ffn_impl.hpp
+ *
+ * Implementation of the StaticFFN class, a feed forward network whose layer
+ * list is fixed at compile time.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_STATIC_FFN_IMPL_HPP
+#define MLPACK_METHODS_ANN_STATIC_FFN_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "static_ffn.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... Layers>
+StaticFFN<OutputLayerType, InitializationRuleType, Layers...>::StaticFFN(
+    Layers... layers) : network(std::move(layers)...)
+{
+  /* Nothing to do here */
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... Layers>
+void StaticFFN<OutputLayerType, InitializationRuleType,
+               Layers...>::ResetParameters()
+{
+  parameter.set_size(WeightSize<0>(), 1);
+  initializeRule.Initialize(parameter, parameter.n_elem, 1);
+  SetWeights<0>(0);
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... Layers>
+void StaticFFN<OutputLayerType, InitializationRuleType, Layers...>::Predict(
+    arma::mat predictors, arma::mat& results, const size_t batchSize)
+{
+  if (parameter.is_empty())
+    ResetParameters();
+
+  ResetDeterministic<0>();
+
+  arma::mat resultsTemp;
+  for (size_t begin = 0; begin < predictors.n_cols; begin += batchSize)
+  {
+    const size_t effectiveBatchSize = std::min(batchSize,
+        size_t(predictors.n_cols) - begin);
+
+    ForwardLayers<0>(arma::mat(predictors.colptr(begin), predictors.n_rows,
+        effectiveBatchSize, false, true));
+    resultsTemp = Layer<NumLayers - 1>().OutputParameter();
+
+    if (begin == 0)
+      results.set_size(resultsTemp.n_rows, predictors.n_cols);
+
+    results.cols(begin, begin + effectiveBatchSize - 1) = resultsTemp;
+  }
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... Layers>
+void StaticFFN<OutputLayerType, InitializationRuleType, Layers...>::Forward(
+    const arma::mat& inputs, arma::mat& results)
+{
+  if (parameter.is_empty())
+    ResetParameters();
+
+  ForwardLayers<0>(inputs);
+  results = Layer<NumLayers - 1>().OutputParameter();
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... Layers>
+double StaticFFN<OutputLayerType, InitializationRuleType, Layers...>::
+Evaluate(const arma::mat& predictors, const arma::mat& responses)
+{
+  if (parameter.is_empty())
+    ResetParameters();
+
+  ResetDeterministic<0>();
+
+  ForwardLayers<0>(predictors);
+  return outputLayer.Forward(Layer<NumLayers - 1>().OutputParameter(),
+      responses);
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,129 @@
+/**
+ * @file methods/ann/util/inference_backend.hpp
+ *
+ * Definition of the InferenceBackend hook, through which the matrix
+ * multiplications of the forward paths (the Linear layer and the
+ * GemmConvolution rule) can be dispatched to an external BLAS-like handle.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_UTIL_INFERENCE_BACKEND_HPP
+#define MLPACK_METHODS_ANN_UTIL_INFERENCE_BACKEND_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <functional>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * A process-wide hook for offloading the dense matrix multiplications that
+ * dominate inference.  By default no backend is registered and every forward
+ * pass uses the plain Armadillo (BLAS) path; registering a Gemm() callback
+ * routes products above the Threshold() to that callback instead, so a build
+ * can plug in an accelerator library (NVBLAS, oneDNN, or anything else with a
+ * GEMM entry point) without mlpack linking against it.
+ *
+ * A backend computes c = a * b into the pre-sized matrix c and returns true,
+ * or returns false to decline the product, in which case the caller falls
+ * back to the Armadillo path.  Products whose multiply-add count falls below
+ * Threshold() are never dispatched: for small operands the staging and
+ * dispatch overhead costs more than the multiplication itself.
+ *
+ * The operands are staged in buffers that persist across calls (one set per
+ * thread), so a backend that registers or pins its host memory sees the same
+ * allocations every time instead of paying for registration per call.  Only
+ * double-precision products are dispatched; other element types always take
+ * the Armadillo path.
+ */
+class InferenceBackend
+{
+ public:
+  //! The backend callback type; computes c = a * b into the pre-sized c and
+  //! returns true, or returns false to fall back to the Armadillo path.
+  typedef std::function<bool(const arma::mat& a,
+                             const arma::mat& b,
+                             arma::mat& c)> GemmType;
+
+  //! The default dispatch threshold, as a multiply-add count.
+  static const size_t DefaultThreshold = 1048576;
+
+  //! Get or set the registered backend; empty (the default) disables
+  //! dispatch entirely.
+  static GemmType& Gemm()
+  {
+    static GemmType gemm;
+    return gemm;
+  }
+
+  //! Get or set the minimum multiply-add count (rows(a) * cols(a) * cols(b))
+  //! for which products are dispatched to the backend.
+  static size_t& Threshold()
+  {
+    static size_t threshold = DefaultThreshold;
+    return threshold;
+  }
+
+  /**
+   * Compute c = a * b via the registered backend, if there is one and the
+   * product is large enough.  Returns true if the backend produced the
+   * result; returns false if the caller should use the Armadillo path
+   * instead.
+   *
+   * @param a Left operand.
+   * @param b Right operand.
+   * @param c Matrix to store the product into.
+   */
+  static bool Multiply(const arma::mat& a, const arma::mat& b, arma::mat& c)
+  {
+    if (!Gemm())
+      return false;
+
+    if (a.n_rows * a.n_cols * b.n_cols < Threshold())
+      return false;
+
+    // Stage the operands in the per-thread reusable buffers, so a backend
+    // that pins its host memory touches the same allocations on every call.
+    arma::mat& stagedA = Buffer(0);
+    arma::mat& stagedB = Buffer(1);
+    arma::mat& stagedC = Buffer(2);
+    stagedA = a;
+    stagedB = b;
+    stagedC.set_size(a.n_rows, b.n_cols);
+
+    if (!Gemm()(stagedA, stagedB, stagedC))
+      return false;
+
+    c = stagedC;
+    return true;
+  }
+
+  /**
+   * Catch-all overload for element types other than double; these are never
+   * dispatched, so the caller always takes the Armadillo path.
+   */
+  template<typename MatTypeA, typename MatTypeB, typename MatTypeC>
+  static bool Multiply(const MatTypeA& /* a */,
+                       const MatTypeB& /* b */,
+                       MatTypeC& /* c */)
+  {
+    return false;
+  }
+
+ private:
+  //! The per-thread staging buffers (two operands and the result).
+  static arma::mat& Buffer(const size_t index)
+  {
+    static thread_local arma::mat buffers[3];
+    return buffers[index];
+  }
+};
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,44 @@
+/**
+ * @file methods/ann/visitor/in_place_visitor.hpp
+ *
+ * This file provides an abstraction to query whether a layer supports
+ * in-place evaluation, i.e. whether its Forward() function may be called
+ * with the output aliasing the input.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_IN_PLACE_VISITOR_HPP
+#define MLPACK_METHODS_ANN_VISITOR_IN_PLACE_VISITOR_HPP
+
+#include <mlpack/methods/ann/layer/layer_traits.hpp>
+#include <mlpack/methods/ann/layer/layer_types.hpp>
+
+#include <boost/variant.hpp>
+
+namespace mlpack {
+namespace ann {
+
+/**
+ * InPlaceVisitor returns true if the layer supports in-place evaluation, as
+ * flagged by LayerTraits::SupportsInPlace.
+ */
+class InPlaceVisitor : public boost::static_visitor<bool>
+{
+ public:
+  //! Return whether the given layer supports in-place evaluation.
+  template<typename LayerType>
+  bool operator()(LayerType* layer) const;
+
+  bool operator()(MoreTypes layer) const;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "in_place_visitor_impl.hpp"
+
+#endif
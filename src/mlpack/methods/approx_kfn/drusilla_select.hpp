@@ -74,6 +74,23 @@ class DrusillaSelect
              const size_t l = 0,
              const size_t m = 0);
 
+  /**
+   * Update the model after a small fraction of the reference set has changed.
+   * The given reference set must be the same set the model was trained on,
+   * with the columns listed in changedIndices holding new values.  Stored
+   * copies of changed candidate points are refreshed in-place; a full
+   * retraining pass is only run if some changed point could now out-score an
+   * existing candidate (its norm about the mean exceeds the smallest centered
+   * candidate norm).  This is a heuristic, but so is the candidate selection
+   * itself; for large changes, call Train() instead.
+   *
+   * @param referenceSet Reference set the model was trained on, with the
+   *      changed columns updated.
+   * @param changedIndices Indices of columns whose values have changed.
+   */
+  void UpdatePoints(const MatType& referenceSet,
+                    const arma::Col<size_t>& changedIndices);
+
   /**
    * Search for the k furthest neighbors of the given query set.  (The query set
    * can contain just one point: that is okay.)  The results will be stored in
@@ -16,9 +16,7 @@
 #include "drusilla_select.hpp"
 
 #include <queue>
-#include <mlpack/methods/neighbor_search/neighbor_search_rules.hpp>
-#include <mlpack/methods/neighbor_search/sort_policies/furthest_neighbor_sort.hpp>
-#include <mlpack/core/tree/binary_space_tree.hpp>
+#include <unordered_set>
 #include <algorithm>
 
 namespace mlpack {
@@ -164,6 +162,58 @@ void DrusillaSelect<MatType>::Train(
   }
 }
 
+// Update the model after some points in the reference set have changed.
+template<typename MatType>
+void DrusillaSelect<MatType>::UpdatePoints(
+    const MatType& referenceSet,
+    const arma::Col<size_t>& changedIndices)
+{
+  if (candidateSet.n_cols == 0)
+    throw std::runtime_error("DrusillaSelect::UpdatePoints(): candidate set "
+        "not initialized!  Call Train() first.");
+
+  // Refresh the stored copy of any candidate whose point has changed.
+  std::unordered_set<size_t> candidates(candidateIndices.begin(),
+      candidateIndices.end());
+  std::unordered_set<size_t> changed(changedIndices.begin(),
+      changedIndices.end());
+  for (size_t i = 0; i < candidateIndices.n_elem; ++i)
+  {
+    if (changed.count(candidateIndices[i]) > 0)
+      candidateSet.col(i) = referenceSet.col(candidateIndices[i]);
+  }
+
+  // The score a point can get on any projection is bounded above by its norm
+  // about the mean, so a changed non-candidate point can only deserve a place
+  // in the candidate set if that norm exceeds the smallest centered candidate
+  // norm.  If no changed point passes the bound, the candidate set stands.
+  arma::vec dataMean(arma::mean(referenceSet, 1));
+  double minNorm = DBL_MAX;
+  for (size_t i = 0; i < candidateSet.n_cols; ++i)
+  {
+    const double norm = arma::norm(arma::vec(candidateSet.col(i)) - dataMean);
+    minNorm = std::min(minNorm, norm);
+  }
+
+  for (size_t i = 0; i < changedIndices.n_elem; ++i)
+  {
+    const size_t index = changedIndices[i];
+    if (index >= referenceSet.n_cols)
+      throw std::invalid_argument("DrusillaSelect::UpdatePoints(): changed "
+          "index is out of bounds of the reference set!");
+
+    if (candidates.count(index) > 0)
+      continue;
+
+    if (arma::norm(arma::vec(referenceSet.col(index)) - dataMean) > minNorm)
+    {
+      // This point could displace a candidate; rebuild the candidate set.
+      Train(referenceSet);
+      return;
+    }
+  }
+}
+
 // Search.
 template<typename MatType>
 void DrusillaSelect<MatType>::Search(const MatType& querySet,
@@ -179,23 +229,45 @@ void DrusillaSelect<MatType>::Search(const MatType& querySet,
     throw std::invalid_argument("DrusillaSelect::Search(): requested k is "
         "greater than number of points in candidate set!  Increase l or m.");
 
-  // We'll use the NeighborSearchRules class to perform our brute-force search.
-  // Note that we aren't using trees for our search, so we can use 'int' as a
-  // TreeType.
-  metric::EuclideanDistance metric;
-  NeighborSearchRules<FurthestNeighborSort, metric::EuclideanDistance,
-      tree::KDTree<metric::EuclideanDistance, tree::EmptyStatistic, MatType>>
-      rules(candidateSet, querySet, k, metric, 0, false);
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  // Squared norms of the candidates; reused for every query block.
+  arma::vec candidateNorms(candidateSet.n_cols);
+  for (size_t i = 0; i < candidateSet.n_cols; ++i)
+    candidateNorms[i] = arma::dot(candidateSet.col(i), candidateSet.col(i));
 
-  for (size_t q = 0; q < querySet.n_cols; ++q)
-    for (size_t r = 0; r < candidateSet.n_cols; ++r)
-      rules.BaseCase(q, r);
+  // Compute all query-candidate distances for a block of queries at once with
+  // a single matrix multiplication, using the expansion
+  // || q - r ||^2 = || q ||^2 + || r ||^2 - 2 q^T r.  Blocking bounds the
+  // size of the intermediate distance matrix for large query sets.
+  const size_t blockSize = 256;
+  for (size_t begin = 0; begin < querySet.n_cols; begin += blockSize)
+  {
+    const size_t end = std::min(begin + blockSize - 1,
+        (size_t) querySet.n_cols - 1);
+
+    const MatType queryBlock(querySet.cols(begin, end));
+    const MatType products(candidateSet.t() * queryBlock);
+    arma::mat distancesSq(products);
+    distancesSq *= -2.0;
+    distancesSq.each_col() += candidateNorms;
 
-  rules.GetResults(neighbors, distances);
+    for (size_t q = begin; q <= end; ++q)
+    {
+      const double queryNorm = arma::dot(querySet.col(q), querySet.col(q));
+      arma::vec queryDistances = distancesSq.col(q - begin) + queryNorm;
+      arma::uvec ordering = arma::sort_index(queryDistances, "descend");
 
-  // Map the neighbors back to their original indices in the reference set.
-  for (size_t i = 0; i < neighbors.n_elem; ++i)
-    neighbors[i] = candidateIndices[neighbors[i]];
+      for (size_t j = 0; j < k; ++j)
+      {
+        // Map the neighbor back to its original index in the reference set.
+        neighbors(j, q) = candidateIndices[ordering[j]];
+        distances(j, q) = std::sqrt(std::max(queryDistances[ordering[j]],
+            0.0));
+      }
+    }
+  }
 }
 
 //! Serialize the model.
@@ -68,6 +68,21 @@ class QDAFN
              const size_t l = 0,
              const size_t m = 0);
 
+  /**
+   * Update the model after a small fraction of the reference set has changed.
+   * The given reference set must have the same size as the set the model was
+   * trained on, with the columns listed in changedIndices holding new values.
+   * The projection lines are kept; only the changed points are reprojected,
+   * and only the tables whose top-m contents could have changed are resorted.
+   * For large changes, call Train() instead.
+   *
+   * @param referenceSet Reference set the model was trained on, with the
+   *      changed columns updated.
+   * @param changedIndices Indices of columns whose values have changed.
+   */
+  void UpdatePoints(const MatType& referenceSet,
+                    const arma::Col<size_t>& changedIndices);
+
   /**
    * Search for the k furthest neighbors of the given query set.  (The query set
    * can contain just one point, that is okay.)  The results will be stored in
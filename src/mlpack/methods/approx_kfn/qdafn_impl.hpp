@@ -89,6 +89,58 @@ void QDAFN<MatType>::Train(const MatType& referenceSet,
   }
 }
 
+// Update the model after some points in the reference set have changed.
+template<typename MatType>
+void QDAFN<MatType>::UpdatePoints(const MatType& referenceSet,
+                                  const arma::Col<size_t>& changedIndices)
+{
+  if (projections.n_rows != referenceSet.n_cols)
+    throw std::invalid_argument("QDAFN::UpdatePoints(): reference set does "
+        "not match the size of the set the model was trained on!  Call "
+        "Train() instead.");
+
+  // Reproject only the changed points onto the existing lines.
+  for (size_t i = 0; i < changedIndices.n_elem; ++i)
+  {
+    const size_t index = changedIndices[i];
+    if (index >= referenceSet.n_cols)
+      throw std::invalid_argument("QDAFN::UpdatePoints(): changed index is "
+          "out of bounds of the reference set!");
+
+    projections.row(index) = (lines.t() * referenceSet.col(index)).t();
+  }
+
+  // Resort only the tables whose top-m contents could have changed: those
+  // storing a changed point, and those where a changed point now projects
+  // past the smallest stored value.
+  for (size_t i = 0; i < l; ++i)
+  {
+    bool dirty = false;
+    for (size_t j = 0; j < changedIndices.n_elem && !dirty; ++j)
+    {
+      const size_t index = changedIndices[j];
+      if (projections(index, i) > sValues(m - 1, i))
+        dirty = true;
+
+      for (size_t t = 0; t < m && !dirty; ++t)
+        if (sIndices(t, i) == index)
+          dirty = true;
+    }
+
+    if (!dirty)
+      continue;
+
+    arma::uvec sortedIndices = arma::sort_index(projections.col(i),
+        "descend");
+    for (size_t j = 0; j < m; ++j)
+    {
+      sIndices(j, i) = sortedIndices[j];
+      sValues(j, i) = projections(sortedIndices[j], i);
+      candidateSet[i].col(j) = referenceSet.col(sortedIndices[j]);
+    }
+  }
+}
+
 // Search.
 template<typename MatType>
 void QDAFN<MatType>::Search(const MatType& querySet,
@@ -104,6 +156,10 @@ void QDAFN<MatType>::Search(const MatType& querySet,
   neighbors.fill(size_t() - 1);
   distances.zeros(k, querySet.n_cols);
 
+  // Project all queries onto all lines with one matrix multiplication,
+  // instead of computing l dot products per query point.
+  const arma::mat queryProjections(lines.t() * querySet);
+
   // Search for each point.
   for (size_t q = 0; q < querySet.n_cols; ++q)
   {
@@ -113,8 +169,7 @@ void QDAFN<MatType>::Search(const MatType& querySet,
     std::priority_queue<std::pair<double, size_t>> queue;
     for (size_t i = 0; i < l; ++i)
     {
-      const double val = sValues(0, i) - arma::dot(querySet.col(q),
-          lines.col(i));
+      const double val = sValues(0, i) - queryProjections(i, q);
       queue.push(std::make_pair(val, i));
     }
 
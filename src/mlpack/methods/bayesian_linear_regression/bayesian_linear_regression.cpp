@@ -27,7 +27,10 @@ BayesianLinearRegression::BayesianLinearRegression(const bool centerData,
   responsesOffset(0.0),
   alpha(0.0),
   beta(0.0),
-  gamma(0.0)
+  gamma(0.0),
+  responsesSum(0.0),
+  responsesSquaredSum(0.0),
+  nPoints(0)
 {/* Nothing to do */}
 
 double BayesianLinearRegression::Train(const arma::mat& data,
@@ -35,6 +38,9 @@ double BayesianLinearRegression::Train(const arma::mat& data,
 {
   Timer::Start("bayesian_linear_regression");
 
+  // A batch training discards any window accumulated by TrainIncremental().
+  Reset();
+
   arma::mat phi;
   arma::rowvec t;
   arma::colvec eigVal;
@@ -90,6 +96,130 @@ double BayesianLinearRegression::Train(const arma::mat& data,
   return RMSE(data, responses);
 }
 
+double BayesianLinearRegression::TrainIncremental(const arma::mat& data,
+                                                  const arma::rowvec& responses)
+{
+  Timer::Start("bayesian_linear_regression");
+
+  if (nPoints == 0)
+  {
+    dataOuterSum.zeros(data.n_rows, data.n_rows);
+    dataResponsesSum.zeros(data.n_rows);
+    dataSum.zeros(data.n_rows);
+  }
+  else if (data.n_rows != dataOuterSum.n_rows)
+  {
+    Timer::Stop("bayesian_linear_regression");
+    throw std::invalid_argument("BayesianLinearRegression::TrainIncremental():"
+        " dimensionality of the chunk (" + std::to_string(data.n_rows) + ") "
+        "does not match the previous chunks (" +
+        std::to_string(dataOuterSum.n_rows) + ")!");
+  }
+
+  // Rank-k update of the accumulated moments; this is the only pass over the
+  // new chunk, all later refits work from the moments alone.
+  dataOuterSum += data * data.t();
+  dataResponsesSum += data * responses.t();
+  dataSum += sum(data, 1);
+  responsesSum += accu(responses);
+  responsesSquaredSum += dot(responses, responses);
+  nPoints += data.n_cols;
+
+  FitFromStatistics();
+
+  Timer::Stop("bayesian_linear_regression");
+
+  return RMSE(data, responses);
+}
+
+void BayesianLinearRegression::Reset()
+{
+  dataOuterSum.reset();
+  dataResponsesSum.reset();
+  dataSum.reset();
+  responsesSum = 0.0;
+  responsesSquaredSum = 0.0;
+  nPoints = 0;
+}
+
+void BayesianLinearRegression::FitFromStatistics()
+{
+  const double n = (double) nPoints;
+
+  // Derive the centered moments analytically from the raw sums, instead of
+  // subtracting the means from points that are no longer held.
+  arma::mat gram = dataOuterSum;
+  arma::colvec cross = dataResponsesSum;
+  double responsesSquared = responsesSquaredSum;
+  responsesOffset = 0.0;
+
+  if (centerData)
+  {
+    dataOffset = dataSum / n;
+    responsesOffset = responsesSum / n;
+    gram -= n * dataOffset * dataOffset.t();
+    cross -= dataSum * (responsesSum / n);
+    responsesSquared -= responsesSum * responsesSum / n;
+  }
+
+  if (scaleData)
+  {
+    // The same unbiased standard deviations that CenterScaleData() computes;
+    // the deviations are taken about the mean whether centering or not.
+    dataScale = arma::sqrt((arma::diagvec(dataOuterSum) -
+        arma::square(dataSum) / n) / (n - 1));
+    gram.each_col() /= dataScale;
+    gram.each_row() /= dataScale.t();
+    cross /= dataScale;
+  }
+
+  arma::colvec eigVal;
+  arma::mat eigVec;
+  if (!arma::eig_sym(eigVal, eigVec, arma::symmatu(gram)))
+  {
+    Log::Fatal << "BayesianLinearRegression::TrainIncremental(): "
+               << "Eigendecomposition of covariance failed!" << std::endl;
+  }
+
+  // The covariance is symmetric, so the inverse of eigVec is its transpose.
+  const arma::colvec eigVecInvCross = eigVec.t() * cross;
+
+  // Initialize the hyperparameters and begin with an infinitely broad prior.
+  alpha = 1e-6;
+  beta = 1 / ((responsesSquaredSum - responsesSum * responsesSum / n) / n
+      * 0.1);
+
+  unsigned short i = 0;
+  double deltaAlpha = 1.0, deltaBeta = 1.0, crit = 1.0;
+
+  while ((crit > tol) && (i < nIterMax))
+  {
+    deltaAlpha = -alpha;
+    deltaBeta = -beta;
+
+    // Update the solution.
+    omega = eigVec * diagmat(1 / (eigVal + (alpha / beta))) * eigVecInvCross;
+
+    // Update alpha.
+    gamma = sum(eigVal / (alpha / beta + eigVal));
+    alpha = gamma / dot(omega, omega);
+
+    // Update beta. The squared residual is expanded in terms of the
+    // accumulated moments, so no pass over the window is needed.
+    const double residual = responsesSquared - 2 * dot(omega, cross) +
+        as_scalar(omega.t() * gram * omega);
+    beta = (n - gamma) / residual;
+
+    // Compute the stopping criterion.
+    deltaAlpha += alpha;
+    deltaBeta += beta;
+    crit = std::abs(deltaAlpha / alpha + deltaBeta / beta);
+    i++;
+  }
+  // Compute the covariance matrix for the uncertainties later.
+  matCovariance = eigVec * diagmat(1 / (beta * eigVal + alpha)) * eigVec.t();
+}
+
 void BayesianLinearRegression::Predict(const arma::mat& points,
                                        arma::rowvec& predictions) const
 {
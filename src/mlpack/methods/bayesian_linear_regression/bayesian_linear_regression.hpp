@@ -127,6 +127,29 @@ class BayesianLinearRegression
   double Train(const arma::mat& data,
                const arma::rowvec& responses);
 
+  /**
+   * Train the model incrementally on a new chunk of data, reusing the
+   * statistics accumulated by the previous calls. Only second order moments
+   * of the data are kept between the calls, so every chunk is visited exactly
+   * once and the cost of a refit does not depend on how much data has been
+   * seen before: absorbing a chunk of K points costs O(K * P^2), the refit
+   * itself O(P^3). This is intended for models retrained repeatedly while
+   * data keeps arriving. Reset() discards the accumulated window; calling
+   * Train() also starts over from scratch.
+   *
+   * @param data Column-major input data of the new chunk, dim(P, K).
+   * @param responses A vector of targets of the new chunk, dim(K).
+   * @return Root mean squared error computed on the new chunk.
+   */
+  double TrainIncremental(const arma::mat& data,
+                          const arma::rowvec& responses);
+
+  /**
+   * Discard the statistics accumulated by TrainIncremental(), so that the
+   * next chunk starts a new window. The fitted model is left untouched.
+   */
+  void Reset();
+
   /**
    * Predict \f$y_{i}\f$ for each data point in the given data matrix using the
    * currently-trained Bayesian Ridge model.
@@ -257,6 +280,35 @@ class BayesianLinearRegression
   //! Covariance matrix of the solution vector omega.
   arma::mat matCovariance;
 
+  //! Accumulated second moment of the data seen by TrainIncremental(),
+  //! \f$ \sum_i x_i x_i^T \f$.
+  arma::mat dataOuterSum;
+
+  //! Accumulated moment between the data and the responses seen by
+  //! TrainIncremental(), \f$ \sum_i x_i y_i \f$.
+  arma::colvec dataResponsesSum;
+
+  //! Accumulated sum of the data seen by TrainIncremental().
+  arma::colvec dataSum;
+
+  //! Accumulated sum of the responses seen by TrainIncremental().
+  double responsesSum;
+
+  //! Accumulated sum of the squared responses seen by TrainIncremental().
+  double responsesSquaredSum;
+
+  //! Number of points seen by TrainIncremental().
+  size_t nPoints;
+
+  /**
+   * Maximize the evidence function from the moments accumulated by
+   * TrainIncremental(). The centered and scaled moments are derived
+   * analytically from the raw sums, and the eigendecomposition of the
+   * covariance is computed once and reused across the whole alpha/beta
+   * fixed-point loop.
+   */
+  void FitFromStatistics();
+
   /**
    * Center and scale the data accordind to centerData and scaleData.
    * Allows future modifications of new points.
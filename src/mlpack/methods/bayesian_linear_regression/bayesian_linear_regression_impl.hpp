@@ -36,6 +36,12 @@ void BayesianLinearRegression::serialize(Archive& ar,
   ar(CEREAL_NVP(gamma));
   ar(CEREAL_NVP(omega));
   ar(CEREAL_NVP(matCovariance));
+  ar(CEREAL_NVP(dataOuterSum));
+  ar(CEREAL_NVP(dataResponsesSum));
+  ar(CEREAL_NVP(dataSum));
+  ar(CEREAL_NVP(responsesSum));
+  ar(CEREAL_NVP(responsesSquaredSum));
+  ar(CEREAL_NVP(nPoints));
 }
 
 } // namespace regression
@@ -86,6 +86,31 @@ class BiasSVD
              arma::vec& p,
              arma::vec& q);
 
+  /**
+   * Trains the model with a sharded parallel SGD (distributed SGD, or DSGD).
+   * Users and items are partitioned into as many blocks as there are threads,
+   * and each epoch is run as a sequence of rotations in which every thread
+   * processes one user block paired with a distinct item block.  Because no
+   * two blocks of a rotation share a user or an item, the threads never touch
+   * the same parameter columns and no locking or atomic updates are needed;
+   * the ratings of each block pair are stored contiguously so each thread
+   * streams through its shard in order.  With a single thread this reduces to
+   * plain SGD over a blocked visitation order.
+   *
+   * @param data Rating data matrix.
+   * @param rank Rank parameter to be used for optimization.
+   * @param u Item matrix obtained on decomposition.
+   * @param v User matrix obtained on decomposition.
+   * @param p Item bias.
+   * @param q User bias.
+   */
+  void ApplyParallel(const arma::mat& data,
+                     const size_t rank,
+                     arma::mat& u,
+                     arma::mat& v,
+                     arma::vec& p,
+                     arma::vec& q);
+
  private:
   //! Number of optimization iterations.
   size_t iterations;
@@ -90,7 +90,17 @@ class RandomizedBlockKrylovSVD
 
   /**
    * Apply Principal Component Analysis to the provided data set using the
-   * randomized block krylov SVD.
+   * randomized block krylov SVD.  The data matrix may be dense or sparse
+   * (arma::sp_mat); for sparse inputs the power products are parallelized
+   * over the columns of the block with OpenMP, since the sparse kernels do
+   * not use threaded BLAS.
+   *
+   * The Krylov basis is built up block by block in one preallocated matrix:
+   * each new block is orthogonalized against the basis built so far with two
+   * passes of block Gram-Schmidt and then orthonormalized in place with
+   * CholQR (falling back to Householder QR if the Cholesky factorization of
+   * the Gram matrix fails), so no second full-size basis copy or full-width
+   * QR is ever materialized.
    *
    * @param data Data matrix.
    * @param u First unitary matrix.
@@ -98,7 +108,8 @@ class RandomizedBlockKrylovSVD
    * @param s Diagonal matrix of singular values.
    * @param rank Rank of the approximation.
    */
-  void Apply(const arma::mat& data,
+  template<typename MatType>
+  void Apply(const MatType& data,
              arma::mat& u,
              arma::vec& s,
              arma::mat& v,
@@ -125,4 +136,7 @@ class RandomizedBlockKrylovSVD
 } // namespace svd
 } // namespace mlpack
 
+// Include implementation.
+#include "randomized_block_krylov_svd_impl.hpp"
+
 #endif
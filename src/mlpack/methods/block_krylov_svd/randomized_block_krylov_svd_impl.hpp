@@ -0,0 +1,150 @@
+/**
+ * @file methods/block_krylov_svd/randomized_block_krylov_svd_impl.hpp
+ *
+ * Implementation of the templated Apply() of the randomized block krylov SVD
+ * method, which works on both dense and sparse data matrices.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef MLPACK_METHODS_BLOCK_KRYLOV_SVD_RANDOMIZED_BLOCK_KRYLOV_SVD_IMPL_HPP
+#define MLPACK_METHODS_BLOCK_KRYLOV_SVD_RANDOMIZED_BLOCK_KRYLOV_SVD_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "randomized_block_krylov_svd.hpp"
+
+namespace mlpack {
+namespace svd {
+
+/**
+ * Orthonormalize the given block in place using CholQR: the Cholesky factor
+ * of the small Gram matrix is inverted and applied to the block, so no
+ * second copy of the (tall) block is needed.  A second CholQR pass restores
+ * the orthogonality lost to the squared condition number of the block, and
+ * if the Cholesky factorization fails (numerically rank-deficient block),
+ * Householder QR is used as a fallback.
+ *
+ * @param block The block to orthonormalize in place.
+ */
+inline void CholQR(arma::mat& block)
+{
+  arma::mat R;
+  if (!arma::chol(R, block.t() * block))
+  {
+    arma::mat q;
+    arma::qr_econ(q, R, block);
+    block = q;
+    return;
+  }
+  block = block * arma::inv(arma::trimatu(R));
+
+  // Reorthogonalization pass.
+  if (arma::chol(R, block.t() * block))
+    block = block * arma::inv(arma::trimatu(R));
+}
+
+/**
+ * Compute data * (data.t() * block).  For dense data this is left to BLAS.
+ *
+ * @param data Data matrix.
+ * @param block Current block of the Krylov basis.
+ * @param result Matrix to store the product in.
+ */
+inline void PowerProduct(const arma::mat& data,
+                         const arma::mat& block,
+                         arma::mat& result)
+{
+  result = data * (data.t() * block);
+}
+
+/**
+ * Compute data * (data.t() * block) for a sparse data matrix.  Armadillo's
+ * sparse-times-dense kernels are single-threaded, so the product is
+ * parallelized over the columns of the block.
+ *
+ * @param data Data matrix.
+ * @param block Current block of the Krylov basis.
+ * @param result Matrix to store the product in.
+ */
+inline void PowerProduct(const arma::sp_mat& data,
+                         const arma::mat& block,
+                         arma::mat& result)
+{
+  result.set_size(data.n_rows, block.n_cols);
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t j = 0; j < (omp_size_t) block.n_cols; ++j)
+  {
+    result.col(j) = data * (data.t() * block.col(j));
+  }
+}
+
+template<typename MatType>
+void RandomizedBlockKrylovSVD::Apply(const MatType& data,
+                                     arma::mat& u,
+                                     arma::vec& s,
+                                     arma::mat& v,
+                                     const size_t rank)
+{
+  arma::mat block, blockIteration;
+
+  if (blockSize == 0)
+  {
+    blockSize = rank + 10;
+  }
+
+  // Random block initialization.
+  arma::mat G = arma::randn(data.n_cols, blockSize);
+
+  // Construct and orthonormalize Krylov subspace.  The basis is built block
+  // by block inside this one allocation; it is orthonormal on completion, so
+  // no full-width QR (and no second basis-sized copy) is needed afterwards.
+  arma::mat K(data.n_rows, blockSize * (maxIterations + 1));
+
+  // Create a working matrix using data from writable auxiliary memory
+  // (K matrix). Doing so avoids an uncessary copy in upcoming step.
+  block = arma::mat(K.memptr(), data.n_rows, blockSize, false, false);
+  block = data * G;
+  CholQR(block);
+
+  size_t builtCols = blockSize;
+  for (size_t blockOffset = block.n_elem; blockOffset < K.n_elem;
+      blockOffset += block.n_elem)
+  {
+    // Temporary working matrix to store the result in the correct place.
+    blockIteration = arma::mat(K.memptr() + blockOffset, block.n_rows,
+        block.n_cols, false, false);
+
+    PowerProduct(data, block, blockIteration);
+
+    // Two passes of block Gram-Schmidt keep the new block orthogonal to the
+    // basis built so far, and CholQR orthonormalizes it in place.
+    const arma::mat basis(K.memptr(), data.n_rows, builtCols, false, true);
+    for (size_t pass = 0; pass < 2; ++pass)
+      blockIteration -= basis * (basis.t() * blockIteration);
+    CholQR(blockIteration);
+    builtCols += blockSize;
+
+    // Update working matrix for the next iteration.
+    block = arma::mat(K.memptr() + blockOffset, block.n_rows, block.n_cols,
+        false, false);
+  }
+
+  // Approximate eigenvalues and eigenvectors using Rayleigh–Ritz method; the
+  // basis K is orthonormal by construction.
+  arma::mat projection = K.t() * data;
+  arma::svd_econ(u, s, v, projection);
+
+  // Do economical singular value decomposition and compute only the
+  // approximations of the left singular vectors by using the centered data
+  // applied to K.
+  u = K * u;
+}
+
+} // namespace svd
+} // namespace mlpack
+
+#endif
@@ -216,6 +216,35 @@ class CFType
                           arma::Mat<size_t>& recommendations,
                           const arma::Col<size_t>& users);
 
+  /**
+   * Generates the given number of recommendations for all users by scoring
+   * every item directly against the factorization.  See the other overload of
+   * RecommendBatch() for details.
+   *
+   * @param numRecs Number of Recommendations.
+   * @param recommendations Matrix to save recommendations into.
+   */
+  void RecommendBatch(const size_t numRecs,
+                      arma::Mat<size_t>& recommendations) const;
+
+  /**
+   * Generates the given number of recommendations for the specified users by
+   * scoring every item directly against the factorization, without building a
+   * neighborhood model.  Each user's full rating vector is computed in one
+   * product of the factor matrices, and the top numRecs unrated items are
+   * selected with a bounded heap; users are processed in parallel if OpenMP is
+   * enabled.  This is much faster than GetRecommendations() when serving many
+   * users, but because the neighborhood interpolation step is skipped, the
+   * recommendations may differ from those of GetRecommendations().
+   *
+   * @param numRecs Number of Recommendations.
+   * @param recommendations Matrix to save recommendations.
+   * @param users Users for which recommendations are to be generated.
+   */
+  void RecommendBatch(const size_t numRecs,
+                      arma::Mat<size_t>& recommendations,
+                      const arma::Col<size_t>& users) const;
+
   //! Converts the User, Item, Value Matrix to User-Item Table.
   static void CleanData(const arma::mat& data, arma::sp_mat& cleanedData);
 
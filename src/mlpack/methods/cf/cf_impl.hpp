@@ -273,6 +273,96 @@ GetRecommendations(const size_t numRecs,
   }
 }
 
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+RecommendBatch(const size_t numRecs,
+               arma::Mat<size_t>& recommendations) const
+{
+  // Generate list of users.
+  arma::Col<size_t> users = arma::linspace<arma::Col<size_t> >(0,
+      cleanedData.n_cols - 1, cleanedData.n_cols);
+
+  // Call the main overload for recommendations.
+  RecommendBatch(numRecs, recommendations, users);
+}
+
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+RecommendBatch(const size_t numRecs,
+               arma::Mat<size_t>& recommendations,
+               const arma::Col<size_t>& users) const
+{
+  // Default candidate: the smallest possible value and invalid item number.
+  const Candidate def = std::make_pair(-DBL_MAX, cleanedData.n_rows);
+
+  recommendations.set_size(numRecs, users.n_elem);
+  recommendations.fill(def.second);
+
+  // Each user is independent: its full rating vector is one product of the
+  // factor matrices, and its top candidates live in a heap local to the loop
+  // body, so the users can be scored in parallel.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) users.n_elem; ++i)
+  {
+    // Score every item for this user directly from the factorization.
+    arma::vec ratings;
+    decomposition.GetRatingOfUser(users[i], ratings);
+
+    // Mark the items this user has already rated, so that one pass over the
+    // sparse column replaces an element lookup per item below.
+    std::vector<bool> rated(ratings.n_elem, false);
+    for (arma::sp_mat::const_col_iterator it =
+        cleanedData.begin_col(users[i]);
+        it != cleanedData.end_col(users[i]); ++it)
+      rated[it.row()] = true;
+
+    // Let's build the list of candidate recommendations for the given user.
+    std::vector<Candidate> vect(numRecs, def);
+    typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
+        CandidateList;
+    CandidateList pqueue(CandidateCmp(), std::move(vect));
+
+    for (size_t j = 0; j < ratings.n_rows; ++j)
+    {
+      // Ensure that the user hasn't already rated the item.
+      if (rated[j])
+        continue;
+
+      // Is the estimated value better than the worst candidate?
+      // Denormalize rating before comparison.
+      const double realRating =
+          normalization.Denormalize(users[i], j, ratings[j]);
+      if (realRating > pqueue.top().first)
+      {
+        Candidate c = std::make_pair(realRating, j);
+        pqueue.pop();
+        pqueue.push(c);
+      }
+    }
+
+    for (size_t p = 1; p <= numRecs; p++)
+    {
+      recommendations(numRecs - p, i) = pqueue.top().second;
+      pqueue.pop();
+    }
+  }
+
+  // If we were not able to come up with enough recommendations for some user,
+  // issue a warning.  This is done outside the parallel loop so that the
+  // logging stays serial.
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    if (recommendations(numRecs - 1, i) == def.second)
+      Log::Warn << "Could not provide " << numRecs << " recommendations "
+          << "for user " << users(i) << " (not enough un-rated items)!"
+          << std::endl;
+  }
+}
+
 // Predict the rating for a single user/item combination.
 template<typename DecompositionPolicy,
          typename NormalizationType>
@@ -90,6 +90,8 @@ BINDING_LONG_DESC(
     " - 'SVDCompleteIncremental' -- SVD complete incremental learning\n"
     " - 'BiasSVD' -- Bias SVD using a SGD optimizer\n"
     " - 'SVDPP' -- SVD++ using a SGD optimizer\n"
+    " - 'SGD' -- parallel stochastic gradient descent over the nonzero "
+    "ratings\n"
     "\n\n"
     "The following neighbor search algorithms can be specified via" +
     " the " + PRINT_PARAM_STRING("neighbor_search") + " parameter:"
@@ -465,6 +467,10 @@ void AssembleFactorizerType(const std::string& algorithm,
         "when max_iterations is reached");
     PerformAction<SVDPlusPlusPolicy>(dataset, rank, maxIterations, minResidue);
   }
+  else if (algorithm == "SGD")
+  {
+    PerformAction<SGDPolicy>(dataset, rank, maxIterations, minResidue);
+  }
 }
 
 static void mlpackMain()
@@ -488,7 +494,7 @@ static void mlpackMain()
 
   RequireParamInSet<string>("algorithm", { "NMF", "BatchSVD",
       "SVDIncompleteIncremental", "SVDCompleteIncremental", "RegSVD",
-      "RandSVD", "BiasSVD", "SVDPP" }, true, "unknown algorithm");
+      "RandSVD", "BiasSVD", "SVDPP", "SGD" }, true, "unknown algorithm");
 
   ReportIgnoredParam({{ "iteration_only_termination", true }}, "min_residue");
 
@@ -20,6 +20,7 @@
 #include <mlpack/methods/cf/decomposition_policies/batch_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/randomized_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/regularized_svd_method.hpp>
+#include <mlpack/methods/cf/decomposition_policies/sgd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/svd_complete_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/svd_incomplete_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/bias_svd_method.hpp>
@@ -135,6 +136,7 @@ class CFModel
                  CFType<SVDIncompletePolicy, NoNormalization>*,
                  CFType<BiasSVDPolicy, NoNormalization>*,
                  CFType<SVDPlusPlusPolicy, NoNormalization>*,
+                 CFType<SGDPolicy, NoNormalization>*,
 
                  CFType<NMFPolicy, ItemMeanNormalization>*,
                  CFType<BatchSVDPolicy, ItemMeanNormalization>*,
@@ -144,6 +146,7 @@ class CFModel
                  CFType<SVDIncompletePolicy, ItemMeanNormalization>*,
                  CFType<BiasSVDPolicy, ItemMeanNormalization>*,
                  CFType<SVDPlusPlusPolicy, ItemMeanNormalization>*,
+                 CFType<SGDPolicy, ItemMeanNormalization>*,
 
                  CFType<NMFPolicy, UserMeanNormalization>*,
                  CFType<BatchSVDPolicy, UserMeanNormalization>*,
@@ -153,6 +156,7 @@ class CFModel
                  CFType<SVDIncompletePolicy, UserMeanNormalization>*,
                  CFType<BiasSVDPolicy, UserMeanNormalization>*,
                  CFType<SVDPlusPlusPolicy, UserMeanNormalization>*,
+                 CFType<SGDPolicy, UserMeanNormalization>*,
 
                  CFType<NMFPolicy, OverallMeanNormalization>*,
                  CFType<BatchSVDPolicy, OverallMeanNormalization>*,
@@ -162,6 +166,7 @@ class CFModel
                  CFType<SVDIncompletePolicy, OverallMeanNormalization>*,
                  CFType<BiasSVDPolicy, OverallMeanNormalization>*,
                  CFType<SVDPlusPlusPolicy, OverallMeanNormalization>*,
+                 CFType<SGDPolicy, OverallMeanNormalization>*,
 
                  CFType<NMFPolicy, ZScoreNormalization>*,
                  CFType<BatchSVDPolicy, ZScoreNormalization>*,
@@ -170,7 +175,8 @@ class CFModel
                  CFType<SVDCompletePolicy, ZScoreNormalization>*,
                  CFType<SVDIncompletePolicy, ZScoreNormalization>*,
                  CFType<BiasSVDPolicy, ZScoreNormalization>*,
-                 CFType<SVDPlusPlusPolicy, ZScoreNormalization>*> cf;
+                 CFType<SVDPlusPlusPolicy, ZScoreNormalization>*,
+                 CFType<SGDPolicy, ZScoreNormalization>*> cf;
 
  public:
   //! Create an empty CF model.
@@ -0,0 +1,251 @@
+/**
+ * @file methods/cf/decomposition_policies/sgd_method.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of a parallel stochastic gradient descent method for use in
+ * Collaborative Filtering.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef MLPACK_METHODS_CF_DECOMPOSITION_POLICIES_SGD_METHOD_HPP
+#define MLPACK_METHODS_CF_DECOMPOSITION_POLICIES_SGD_METHOD_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace cf {
+
+/**
+ * Implementation of a stochastic gradient descent policy for use in CFType.
+ * The regularized squared-error objective is minimized by sweeping the
+ * nonzero ratings directly, updating the user and item factors in place.  The
+ * sweeps run in parallel Hogwild-style: threads apply their updates without
+ * locking, which is safe in practice because the rating matrix is sparse, so
+ * two threads rarely touch the same user or item at the same time.  Each
+ * sweep costs O(nnz * rank) and never forms a dense intermediate, which makes
+ * this policy suitable for rating matrices whose full factorization sweeps
+ * (as in the AMF-based policies) are too slow.
+ *
+ * An example of how to use SGDPolicy in CF is shown below:
+ *
+ * @code
+ * extern arma::mat data; // data is a (user, item, rating) table.
+ * // Users for whom recommendations are generated.
+ * extern arma::Col<size_t> users;
+ * arma::Mat<size_t> recommendations; // Resulting recommendations.
+ *
+ * CFType<SGDPolicy> cf(data);
+ *
+ * // Generate 10 recommendations for all users.
+ * cf.GetRecommendations(10, recommendations);
+ * @endcode
+ */
+class SGDPolicy
+{
+ public:
+  /**
+   * Use SGD method to perform collaborative filtering.
+   *
+   * @param stepSize Step size of each gradient update.
+   * @param lambda Regularization parameter of the objective.
+   */
+  SGDPolicy(const double stepSize = 0.01, const double lambda = 0.02) :
+      stepSize(stepSize),
+      lambda(lambda)
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * Apply Collaborative Filtering to the provided dataset using parallel
+   * stochastic gradient descent over the nonzero ratings.
+   *
+   * @param * (data) Data matrix: dense matrix (coordinate lists)
+   *    or sparse matrix (cleaned).
+   * @param cleanedData item user table in form of sparse matrix.
+   * @param rank Rank parameter for matrix factorization.
+   * @param maxIterations Maximum number of epochs (sweeps over the ratings).
+   * @param minResidue Improvement of the RMSE between two epochs required to
+   *    continue; ignored if mit is true.
+   * @param mit Whether to terminate only when maxIterations is reached.
+   */
+  template<typename MatType>
+  void Apply(const MatType& /* data */,
+             const arma::sp_mat& cleanedData,
+             const size_t rank,
+             const size_t maxIterations,
+             const double minResidue,
+             const bool mit)
+  {
+    // Initialize the factors with small random values.
+    w.randu(cleanedData.n_rows, rank);
+    h.randu(rank, cleanedData.n_cols);
+    w /= std::sqrt((double) rank);
+    h /= std::sqrt((double) rank);
+
+    if (cleanedData.n_nonzero == 0)
+      return;
+
+    // Extract the nonzero ratings into flat arrays once, so that the sweeps
+    // read contiguous memory instead of walking the sparse structure.
+    const size_t numRatings = cleanedData.n_nonzero;
+    arma::uvec items(numRatings), users(numRatings);
+    arma::vec ratings(numRatings);
+    size_t index = 0;
+    for (arma::sp_mat::const_iterator it = cleanedData.begin();
+        it != cleanedData.end(); ++it, ++index)
+    {
+      items[index] = it.row();
+      users[index] = it.col();
+      ratings[index] = (*it);
+    }
+
+    double lastRMSE = DBL_MAX;
+    for (size_t epoch = 1; epoch != maxIterations + 1; ++epoch)
+    {
+      // Visit the ratings in a fresh random order each epoch.
+      const arma::uvec order = arma::shuffle(
+          arma::linspace<arma::uvec>(0, numRatings - 1, numRatings));
+
+      // Hogwild-style sweep: threads update the factors without locking.
+      // Concurrent updates of the same user or item can race, but collisions
+      // are rare for sparse ratings and each update is small, so the sweep
+      // still converges.
+      double squaredError = 0.0;
+      #pragma omp parallel for reduction(+:squaredError)
+      for (omp_size_t i = 0; i < (omp_size_t) numRatings; ++i)
+      {
+        const size_t item = items[order[i]];
+        const size_t user = users[order[i]];
+        const double rating = ratings[order[i]];
+
+        // Copy this rating's factors, so the gradient is computed from one
+        // consistent snapshot even if another thread updates them meanwhile.
+        const arma::rowvec wi = w.row(item);
+        const arma::vec hu = h.col(user);
+        const double error = arma::dot(wi, hu) - rating;
+
+        w.row(item) = wi - stepSize * (error * hu.t() + lambda * wi);
+        h.col(user) = hu - stepSize * (error * wi.t() + lambda * hu);
+
+        squaredError += error * error;
+      }
+
+      const double rmse = std::sqrt(squaredError / numRatings);
+      Log::Info << "SGDPolicy::Apply(): epoch " << epoch << ", RMSE " << rmse
+          << "." << std::endl;
+
+      if (!mit && std::abs(lastRMSE - rmse) < minResidue)
+        break;
+      lastRMSE = rmse;
+    }
+  }
+
+  /**
+   * Return predicted rating given user ID and item ID.
+   *
+   * @param user User ID.
+   * @param item Item ID.
+   */
+  double GetRating(const size_t user, const size_t item) const
+  {
+    double rating = arma::as_scalar(w.row(item) * h.col(user));
+    return rating;
+  }
+
+  /**
+   * Get predicted ratings for a user.
+   *
+   * @param user User ID.
+   * @param rating Resulting rating vector.
+   */
+  void GetRatingOfUser(const size_t user, arma::vec& rating) const
+  {
+    rating = w * h.col(user);
+  }
+
+  /**
+   * Get the neighborhood and corresponding similarities for a set of users.
+   *
+   * @tparam NeighborSearchPolicy The policy to perform neighbor search.
+   *
+   * @param users Users whose neighborhood is to be computed.
+   * @param numUsersForSimilarity The number of neighbors returned for
+   *     each user.
+   * @param neighborhood Neighbors represented by user IDs.
+   * @param similarities Similarity between each user and each of its
+   *     neighbors.
+   */
+  template<typename NeighborSearchPolicy>
+  void GetNeighborhood(const arma::Col<size_t>& users,
+                       const size_t numUsersForSimilarity,
+                       arma::Mat<size_t>& neighborhood,
+                       arma::mat& similarities) const
+  {
+    // We want to avoid calculating the full rating matrix, so we will do
+    // nearest neighbor search only on the H matrix, using the observation that
+    // if the rating matrix X = W*H, then d(X.col(i), X.col(j)) = d(W H.col(i),
+    // W H.col(j)).  This can be seen as nearest neighbor search on the H
+    // matrix with the Mahalanobis distance where M^{-1} = W^T W.  So, we'll
+    // decompose M^{-1} = L L^T (the Cholesky decomposition), and then multiply
+    // H by L^T. Then we can perform nearest neighbor search.
+    arma::mat l = arma::chol(w.t() * w);
+    arma::mat stretchedH = l * h; // Due to the Armadillo API, l is L^T.
+
+    // Temporarily store feature vector of queried users.
+    arma::mat query(stretchedH.n_rows, users.n_elem);
+    // Select feature vectors of queried users.
+    for (size_t i = 0; i < users.n_elem; ++i)
+      query.col(i) = stretchedH.col(users(i));
+
+    NeighborSearchPolicy neighborSearch(stretchedH);
+    neighborSearch.Search(
+        query, numUsersForSimilarity, neighborhood, similarities);
+  }
+
+  //! Get the Item Matrix.
+  const arma::mat& W() const { return w; }
+  //! Get the User Matrix.
+  const arma::mat& H() const { return h; }
+
+  //! Get the step size.
+  double StepSize() const { return stepSize; }
+  //! Modify the step size.
+  double& StepSize() { return stepSize; }
+
+  //! Get the regularization parameter.
+  double Lambda() const { return lambda; }
+  //! Modify the regularization parameter.
+  double& Lambda() { return lambda; }
+
+  /**
+   * Serialization.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(stepSize));
+    ar(CEREAL_NVP(lambda));
+    ar(CEREAL_NVP(w));
+    ar(CEREAL_NVP(h));
+  }
+
+ private:
+  //! Step size of each gradient update.
+  double stepSize;
+  //! Regularization parameter of the objective.
+  double lambda;
+  //! Item matrix.
+  arma::mat w;
+  //! User matrix.
+  arma::mat h;
+};
+
+} // namespace cf
+} // namespace mlpack
+
+#endif
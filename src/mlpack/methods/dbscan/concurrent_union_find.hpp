@@ -0,0 +1,109 @@
+/**
+ * @file methods/dbscan/concurrent_union_find.hpp
+ * @author Ryan Curtin
+ *
+ * A lock-free union-find data structure that can be updated from multiple
+ * threads at once, used for the parallel union pass of batch-mode DBSCAN.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DBSCAN_CONCURRENT_UNION_FIND_HPP
+#define MLPACK_METHODS_DBSCAN_CONCURRENT_UNION_FIND_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <atomic>
+
+namespace mlpack {
+namespace dbscan {
+
+/**
+ * A union-find data structure whose Union() and Find() operations may be
+ * called concurrently from multiple threads without locking.  The parent
+ * array holds atomics, links are installed with compare-and-swap, and Find()
+ * compresses paths by halving.
+ *
+ * Unlike emst::UnionFind, which links by rank, this structure always links
+ * the root with the larger index under the root with the smaller index.
+ * That keeps every parent pointer strictly decreasing, which guarantees that
+ * the structure stays acyclic and that every operation terminates no matter
+ * how the threads interleave; it also means the final root of each component
+ * is its smallest member, so the result is deterministic.
+ */
+class ConcurrentUnionFind
+{
+ private:
+  std::vector<std::atomic<size_t>> parent;
+
+ public:
+  //! Construct the object with the given size.
+  ConcurrentUnionFind(const size_t size) : parent(size)
+  {
+    for (size_t i = 0; i < size; ++i)
+      parent[i].store(i, std::memory_order_relaxed);
+  }
+
+  /**
+   * Returns the component containing an element.  Safe to call concurrently
+   * with other Find() and Union() calls.
+   *
+   * @param x the component to be found
+   * @return The index of the component containing x
+   */
+  size_t Find(size_t x)
+  {
+    while (true)
+    {
+      size_t p = parent[x].load(std::memory_order_relaxed);
+      if (p == x)
+        return x;
+
+      const size_t gp = parent[p].load(std::memory_order_relaxed);
+      if (gp == p)
+        return p;
+
+      // Path halving: point x at its grandparent.  If the exchange fails,
+      // another thread has already moved x at least as close to the root, so
+      // either way we can continue from the grandparent.
+      parent[x].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+      x = gp;
+    }
+  }
+
+  /**
+   * Union the components containing x and y.  Safe to call concurrently with
+   * other Find() and Union() calls.
+   *
+   * @param x one component
+   * @param y the other component
+   */
+  void Union(const size_t x, const size_t y)
+  {
+    size_t xRoot = Find(x);
+    size_t yRoot = Find(y);
+
+    while (xRoot != yRoot)
+    {
+      // Link the root with the larger index under the root with the smaller
+      // index.
+      if (xRoot < yRoot)
+        std::swap(xRoot, yRoot);
+
+      size_t expected = xRoot;
+      if (parent[xRoot].compare_exchange_strong(expected, yRoot,
+          std::memory_order_relaxed))
+        return;
+
+      // Another thread linked xRoot first; restart from the current roots.
+      xRoot = Find(xRoot);
+      yRoot = Find(yRoot);
+    }
+  }
+}; // class ConcurrentUnionFind
+
+} // namespace dbscan
+} // namespace mlpack
+
+#endif // MLPACK_METHODS_DBSCAN_CONCURRENT_UNION_FIND_HPP
@@ -182,21 +182,52 @@ void DBSCAN<RangeSearchType, PointSelectionPolicy>::BatchCluster(
     emst::UnionFind& uf)
 {
   // For each point, find the points in epsilon-nighborhood and their distances.
+  // Cluster() has already called Train(), so we can search directly.
   std::vector<std::vector<size_t>> neighbors;
   std::vector<std::vector<double>> distances;
   Log::Info << "Performing range search." << std::endl;
-  rangeSearch.Train(data);
   rangeSearch.Search(data, math::Range(0.0, epsilon), neighbors, distances);
   Log::Info << "Range search complete." << std::endl;
 
-  // Now loop over all points.
+  // The distances are not needed for the union pass.
+  std::vector<std::vector<double>>().swap(distances);
+
+  // Compact the neighbor lists into a flat offsets+indices arena, releasing
+  // each list as it is copied.  This drops the per-list allocation overhead
+  // of the nested vectors and lets the union pass read one contiguous array.
+  std::vector<size_t> offsets(data.n_cols + 1, 0);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    offsets[i + 1] = offsets[i] + neighbors[i].size();
+
+  std::vector<size_t> arena(offsets[data.n_cols]);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    std::copy(neighbors[i].begin(), neighbors[i].end(),
+        arena.begin() + offsets[i]);
+    std::vector<size_t>().swap(neighbors[i]);
+  }
+
+  // The point selection policy may be stateful, so select every point up
+  // front, outside the parallel region.
+  std::vector<size_t> selected(data.n_cols);
   for (size_t i = 0; i < data.n_cols; ++i)
+    selected[i] = pointSelector.Select(i, data);
+
+  // Union each point to all of its neighbors.  The unions go into a lock-free
+  // union-find, which always links the larger root under the smaller, so the
+  // components do not depend on the thread interleaving; the result is folded
+  // into the caller's UnionFind afterwards.
+  ConcurrentUnionFind batchUf(data.n_cols);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
   {
-    // Get the next index.
-    const size_t index = pointSelector.Select(i, data);
-    for (size_t j = 0; j < neighbors[index].size(); ++j)
-      uf.Union(index, neighbors[index][j]);
+    const size_t index = selected[i];
+    for (size_t j = offsets[index]; j < offsets[index + 1]; ++j)
+      batchUf.Union(index, arena[j]);
   }
+
+  for (size_t i = 0; i < data.n_cols; ++i)
+    uf.Union(i, batchUf.Find(i));
 }
 
 } // namespace dbscan
@@ -29,60 +29,48 @@ double AllCategoricalSplit<FitnessFunction>::SplitIfBetter(
     arma::Col<typename VecType::elem_type>& classProbabilities,
     AuxiliarySplitInfo<typename VecType::elem_type>& /* aux */)
 {
-  // Count the number of elements in each potential child.
+  // Build the class histogram of every potential child in a single pass over
+  // the data, instead of extracting the labels of each child and counting
+  // them again inside the fitness function.  This is the same
+  // categories-by-classes statistic that HoeffdingCategoricalSplit
+  // accumulates in TrainBatch().
   const double epsilon = 1e-7; // Tolerance for floating-point errors.
   arma::Col<size_t> counts(numCategories, arma::fill::zeros);
-
-  // If we are using weighted training, learn the weights for each child too.
-  arma::vec childWeightSums;
+  arma::Mat<size_t> classCounts;
+  arma::mat classWeightSums;
   double sumWeight = 0.0;
-  if (UseWeights)
-    childWeightSums.zeros(numCategories);
 
-  for (size_t i = 0; i < data.n_elem; ++i)
+  if (UseWeights)
   {
-    counts[(size_t) data[i]]++;
-
-    if (UseWeights)
+    classWeightSums.zeros(numClasses, numCategories);
+    for (size_t i = 0; i < data.n_elem; ++i)
     {
-      childWeightSums[(size_t) data[i]] += weights[i];
+      const size_t category = (size_t) data[i];
+      counts[category]++;
+      classWeightSums(labels[i], category) += weights[i];
       sumWeight += weights[i];
     }
   }
+  else
+  {
+    classCounts.zeros(numClasses, numCategories);
+    for (size_t i = 0; i < data.n_elem; ++i)
+    {
+      const size_t category = (size_t) data[i];
+      counts[category]++;
+      ++classCounts(labels[i], category);
+    }
+  }
 
   // If each child will have the minimum number of points in it, we can split.
   // Otherwise we can't.
   if (arma::min(counts) < minimumLeafSize)
     return DBL_MAX;
 
-  // Calculate the gain of the split.  First we have to calculate the labels
-  // that would be assigned to each child.
-  arma::uvec childPositions(numCategories, arma::fill::zeros);
-  std::vector<arma::Row<size_t>> childLabels(numCategories);
-  std::vector<arma::Row<double>> childWeights(numCategories);
-  for (size_t i = 0; i < numCategories; ++i)
-  {
-    // Labels and weights should have same length.
-    childLabels[i].zeros(counts[i]);
-    if (UseWeights)
-      childWeights[i].zeros(counts[i]);
-  }
-
-  // Extract labels for each child.
-  for (size_t i = 0; i < data.n_elem; ++i)
-  {
-    const size_t category = (size_t) data[i];
-
-    if (UseWeights)
-    {
-      childLabels[category][childPositions[category]] = labels[i];
-      childWeights[category][childPositions[category]++] = weights[i];
-    }
-    else
-    {
-      childLabels[category][childPositions[category]++] = labels[i];
-    }
-  }
+  // Calculate the gain of the split directly from the histogram columns.
+  arma::vec childWeightSums;
+  if (UseWeights)
+    childWeightSums = arma::sum(classWeightSums, 0).t();
 
   double overallGain = 0.0;
   for (size_t i = 0; i < counts.n_elem; ++i)
@@ -91,8 +79,11 @@ double AllCategoricalSplit<FitnessFunction>::SplitIfBetter(
     const double childPct = UseWeights ?
         double(childWeightSums[i]) / sumWeight :
         double(counts[i]) / double(data.n_elem);
-    const double childGain = FitnessFunction::template Evaluate<UseWeights>(
-        childLabels[i], numClasses, childWeights[i]);
+    const double childGain = UseWeights ?
+        FitnessFunction::template EvaluatePtr<true>(classWeightSums.colptr(i),
+            numClasses, childWeightSums[i]) :
+        FitnessFunction::template EvaluatePtr<false>(classCounts.colptr(i),
+            numClasses, counts[i]);
 
     overallGain += childPct * childGain;
   }
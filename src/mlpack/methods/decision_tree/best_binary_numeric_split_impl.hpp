@@ -27,7 +27,7 @@ double BestBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
     const size_t minimumLeafSize,
     const double minimumGainSplit,
     arma::Col<typename VecType::elem_type>& classProbabilities,
-    AuxiliarySplitInfo<typename VecType::elem_type>& /* aux */)
+    AuxiliarySplitInfo<typename VecType::elem_type>& aux)
 {
   // First sanity check: if we don't have enough points, we can't split.
   if (data.n_elem < (minimumLeafSize * 2))
@@ -35,8 +35,36 @@ double BestBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
   if (bestGain == 0.0)
     return DBL_MAX; // It can't be outperformed.
 
-  // Next, sort the data.
+  // Sort the data and pass off to the overload that takes a precomputed
+  // sorted order.
   arma::uvec sortedIndices = arma::sort_index(data);
+  return SplitIfBetter<UseWeights>(bestGain, data, sortedIndices, labels,
+      numClasses, weights, minimumLeafSize, minimumGainSplit,
+      classProbabilities, aux);
+}
+
+//classification, with a precomputed ascending order of data
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename WeightVecType>
+double BestBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const arma::uvec& sortedIndices,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::Col<typename VecType::elem_type>& classProbabilities,
+    AuxiliarySplitInfo<typename VecType::elem_type>& /* aux */)
+{
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Gather the labels into sorted order.
   arma::Row<size_t> sortedLabels(labels.n_elem);
   arma::rowvec sortedWeights;
   for (size_t i = 0; i < sortedLabels.n_elem; ++i)
@@ -19,6 +19,7 @@
 #include "best_binary_numeric_split.hpp"
 #include "all_categorical_split.hpp"
 #include "all_dimension_select.hpp"
+#include "presorted_index.hpp"
 #include <type_traits>
 
 namespace mlpack {
@@ -398,6 +399,147 @@ class DecisionTree :
                const std::enable_if_t<arma::is_arma_type<typename
                    std::remove_reference<WeightsType>::type>::value>* = 0);
 
+  /**
+   * Train the decision tree on the points of the given dataset whose column
+   * indices are listed in samples.  Indices may be repeated, so this can be
+   * used to train on a bootstrap sample without materializing a copy of the
+   * dataset: the recursion partitions the sample indices instead of the
+   * columns of the data matrix, and data is only ever read.  The labels apply
+   * to the full dataset, i.e. labels[samples[i]] is the label of the i'th
+   * sampled point.
+   *
+   * @param data Dataset to train on.
+   * @param samples Column indices of the points to train on.
+   * @param datasetInfo Type information for each dimension.
+   * @param labels Labels for each point in the full dataset.
+   * @param numClasses Number of classes in the dataset.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @param presortedIndex Optional presorted index of data; if given, numeric
+   *      split selection uses its cached ranks instead of re-sorting.
+   * @return The final entropy of decision tree.
+   */
+  template<typename MatType>
+  double Train(const MatType& data,
+               const arma::Row<size_t>& samples,
+               const data::DatasetInfo& datasetInfo,
+               const arma::Row<size_t>& labels,
+               const size_t numClasses,
+               const size_t minimumLeafSize = 10,
+               const double minimumGainSplit = 1e-7,
+               const size_t maximumDepth = 0,
+               DimensionSelectionType dimensionSelector =
+                   DimensionSelectionType(),
+               const PresortedIndex* presortedIndex = NULL);
+
+  /**
+   * Train the decision tree on the points of the given dataset whose column
+   * indices are listed in samples, assuming that all dimensions are numeric.
+   * Indices may be repeated, so this can be used to train on a bootstrap
+   * sample without materializing a copy of the dataset: the recursion
+   * partitions the sample indices instead of the columns of the data matrix,
+   * and data is only ever read.  The labels apply to the full dataset, i.e.
+   * labels[samples[i]] is the label of the i'th sampled point.
+   *
+   * @param data Dataset to train on.
+   * @param samples Column indices of the points to train on.
+   * @param labels Labels for each point in the full dataset.
+   * @param numClasses Number of classes in the dataset.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @param presortedIndex Optional presorted index of data; if given, numeric
+   *      split selection uses its cached ranks instead of re-sorting.
+   * @return The final entropy of decision tree.
+   */
+  template<typename MatType>
+  double Train(const MatType& data,
+               const arma::Row<size_t>& samples,
+               const arma::Row<size_t>& labels,
+               const size_t numClasses,
+               const size_t minimumLeafSize = 10,
+               const double minimumGainSplit = 1e-7,
+               const size_t maximumDepth = 0,
+               DimensionSelectionType dimensionSelector =
+                   DimensionSelectionType(),
+               const PresortedIndex* presortedIndex = NULL);
+
+  /**
+   * Train the decision tree on the points of the given weighted dataset whose
+   * column indices are listed in samples.  Indices may be repeated, so this
+   * can be used to train on a bootstrap sample without materializing a copy
+   * of the dataset: the recursion partitions the sample indices instead of
+   * the columns of the data matrix, and data is only ever read.  The labels
+   * and weights apply to the full dataset, i.e. labels[samples[i]] is the
+   * label of the i'th sampled point.
+   *
+   * @param data Dataset to train on.
+   * @param samples Column indices of the points to train on.
+   * @param datasetInfo Type information for each dimension.
+   * @param labels Labels for each point in the full dataset.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weights of each point in the full dataset.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @param presortedIndex Optional presorted index of data; if given, numeric
+   *      split selection uses its cached ranks instead of re-sorting.
+   * @return The final entropy of decision tree.
+   */
+  template<typename MatType>
+  double Train(const MatType& data,
+               const arma::Row<size_t>& samples,
+               const data::DatasetInfo& datasetInfo,
+               const arma::Row<size_t>& labels,
+               const size_t numClasses,
+               const arma::rowvec& weights,
+               const size_t minimumLeafSize = 10,
+               const double minimumGainSplit = 1e-7,
+               const size_t maximumDepth = 0,
+               DimensionSelectionType dimensionSelector =
+                   DimensionSelectionType(),
+               const PresortedIndex* presortedIndex = NULL);
+
+  /**
+   * Train the decision tree on the points of the given weighted dataset whose
+   * column indices are listed in samples, assuming that all dimensions are
+   * numeric.  Indices may be repeated, so this can be used to train on a
+   * bootstrap sample without materializing a copy of the dataset: the
+   * recursion partitions the sample indices instead of the columns of the
+   * data matrix, and data is only ever read.  The labels and weights apply to
+   * the full dataset, i.e. labels[samples[i]] is the label of the i'th
+   * sampled point.
+   *
+   * @param data Dataset to train on.
+   * @param samples Column indices of the points to train on.
+   * @param labels Labels for each point in the full dataset.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weights of each point in the full dataset.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @param presortedIndex Optional presorted index of data; if given, numeric
+   *      split selection uses its cached ranks instead of re-sorting.
+   * @return The final entropy of decision tree.
+   */
+  template<typename MatType>
+  double Train(const MatType& data,
+               const arma::Row<size_t>& samples,
+               const arma::Row<size_t>& labels,
+               const size_t numClasses,
+               const arma::rowvec& weights,
+               const size_t minimumLeafSize = 10,
+               const double minimumGainSplit = 1e-7,
+               const size_t maximumDepth = 0,
+               DimensionSelectionType dimensionSelector =
+                   DimensionSelectionType(),
+               const PresortedIndex* presortedIndex = NULL);
+
   /**
    * Classify the given point, using the entire tree.  The predicted label is
    * returned.
@@ -447,6 +589,31 @@ class DecisionTree :
                 arma::Row<size_t>& predictions,
                 arma::mat& probabilities) const;
 
+  /**
+   * Prune the trained tree with cost-complexity (weakest-link) pruning.  The
+   * weakest-link sweep generates the standard nested sequence of candidate
+   * subtrees with increasing complexity penalty alpha; every candidate is
+   * evaluated against the given validation set (the candidates are scored in
+   * parallel), and the smallest subtree with the best validation accuracy
+   * replaces the current tree.  Pruning never reduces validation accuracy,
+   * since the unpruned tree is one of the candidates.
+   *
+   * The training data and labels are routed through the tree once to recover
+   * the per-node class counts that the candidate generation and the merged
+   * leaves need, so they should be the data the tree was trained on.
+   *
+   * @param data Data the tree was trained on.
+   * @param labels Labels for each training point.
+   * @param validationData Held-out data to score candidate subtrees on.
+   * @param validationLabels Labels for each validation point.
+   * @return Validation accuracy of the pruned tree.
+   */
+  template<typename MatType>
+  double Prune(const MatType& data,
+               const arma::Row<size_t>& labels,
+               const MatType& validationData,
+               const arma::Row<size_t>& validationLabels);
+
   /**
    * Serialize the tree.
    */
@@ -465,6 +632,15 @@ class DecisionTree :
   //! trained tree).
   size_t SplitDimension() const { return splitDimension; }
 
+  //! Get the index of the majority class (if this is a leaf), or the type of
+  //! the dimension that the node splits on (if this is not a leaf).
+  size_t DimensionTypeOrMajorityClass() const
+  { return dimensionTypeOrMajorityClass; }
+
+  //! Get the class probabilities (if this is a leaf), or the split information
+  //! used by the split type's CalculateDirection() (if this is not a leaf).
+  const arma::vec& ClassProbabilities() const { return classProbabilities; }
+
   /**
    * Given a point and that this node is not a leaf, calculate the index of the
    * child node this point would go towards.  This method is primarily used by
@@ -570,6 +746,84 @@ class DecisionTree :
                const double minimumGainSplit,
                const size_t maximumDepth,
                DimensionSelectionType& dimensionSelector);
+
+  /**
+   * Corresponding to the public sample-indexed Train() method, this method is
+   * designed for avoiding unnecessary copies during training.  The data
+   * matrix is shared and read-only; the node's points are
+   * samples[begin] ... samples[begin + count - 1], and the recursion
+   * partitions samples (along with labels and weights, which are ordered in
+   * sync with samples) instead of the columns of data.  This function is
+   * called to train children.
+   *
+   * @param data Dataset to train on (never modified).
+   * @param samples Column indices of the sampled points, partitioned in
+   *      place.
+   * @param begin Index of the starting point in samples that belongs to this
+   *      node.
+   * @param count Number of points in this node.
+   * @param datasetInfo Type information for each dimension.
+   * @param labels Labels of the sampled points, ordered in sync with samples.
+   * @param numClasses Number of classes in the dataset.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @param presortedIndex Optional presorted index of data (may be NULL).
+   * @return The final entropy of decision tree.
+   */
+  template<bool UseWeights, typename MatType>
+  double Train(const MatType& data,
+               arma::Row<size_t>& samples,
+               const size_t begin,
+               const size_t count,
+               const data::DatasetInfo& datasetInfo,
+               arma::Row<size_t>& labels,
+               const size_t numClasses,
+               arma::rowvec& weights,
+               const size_t minimumLeafSize,
+               const double minimumGainSplit,
+               const size_t maximumDepth,
+               DimensionSelectionType& dimensionSelector,
+               const PresortedIndex* presortedIndex);
+
+  /**
+   * Corresponding to the public sample-indexed Train() method, this method is
+   * designed for avoiding unnecessary copies during training.  The data
+   * matrix is shared and read-only; the node's points are
+   * samples[begin] ... samples[begin + count - 1], and the recursion
+   * partitions samples (along with labels and weights, which are ordered in
+   * sync with samples) instead of the columns of data.  This function is
+   * called to train children.
+   *
+   * @param data Dataset to train on (never modified).
+   * @param samples Column indices of the sampled points, partitioned in
+   *      place.
+   * @param begin Index of the starting point in samples that belongs to this
+   *      node.
+   * @param count Number of points in this node.
+   * @param labels Labels of the sampled points, ordered in sync with samples.
+   * @param numClasses Number of classes in the dataset.
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for the node to split.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @param presortedIndex Optional presorted index of data (may be NULL).
+   * @return The final entropy of decision tree.
+   */
+  template<bool UseWeights, typename MatType>
+  double Train(const MatType& data,
+               arma::Row<size_t>& samples,
+               const size_t begin,
+               const size_t count,
+               arma::Row<size_t>& labels,
+               const size_t numClasses,
+               arma::rowvec& weights,
+               const size_t minimumLeafSize,
+               const double minimumGainSplit,
+               const size_t maximumDepth,
+               DimensionSelectionType& dimensionSelector,
+               const PresortedIndex* presortedIndex);
 };
 
 /**
@@ -655,6 +655,226 @@ double DecisionTree<FitnessFunction,
       dimensionSelector);
 }
 
+//! Train on the sampled points of the given data.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         typename ElemType,
+         bool NoRecursion>
+template<typename MatType>
+double DecisionTree<FitnessFunction,
+                    NumericSplitType,
+                    CategoricalSplitType,
+                    DimensionSelectionType,
+                    ElemType,
+                    NoRecursion>::Train(
+    const MatType& data,
+    const arma::Row<size_t>& samples,
+    const data::DatasetInfo& datasetInfo,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    DimensionSelectionType dimensionSelector,
+    const PresortedIndex* presortedIndex)
+{
+  // Sanity check on data.
+  if (data.n_cols != labels.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "DecisionTree::Train(): number of points (" << data.n_cols << ") "
+        << "does not match number of labels (" << labels.n_elem << ")!"
+        << std::endl;
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Gather the labels of the sampled points; the dataset itself is not
+  // copied, since the recursion partitions the sample indices instead of the
+  // columns of the data matrix.
+  arma::Row<size_t> tmpSamples(samples);
+  arma::Row<size_t> tmpLabels(samples.n_elem);
+  for (size_t i = 0; i < samples.n_elem; ++i)
+    tmpLabels[i] = labels[samples[i]];
+
+  // Set the correct dimensionality for the dimension selector.
+  dimensionSelector.Dimensions() = data.n_rows;
+
+  // Pass off work to the Train() method.
+  arma::rowvec weights; // Fake weights, not used.
+  return Train<false>(data, tmpSamples, 0, tmpSamples.n_elem, datasetInfo,
+      tmpLabels, numClasses, weights, minimumLeafSize, minimumGainSplit,
+      maximumDepth, dimensionSelector, presortedIndex);
+}
+
+//! Train on the sampled points of the given data, assuming all dimensions are
+//! numeric.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         typename ElemType,
+         bool NoRecursion>
+template<typename MatType>
+double DecisionTree<FitnessFunction,
+                    NumericSplitType,
+                    CategoricalSplitType,
+                    DimensionSelectionType,
+                    ElemType,
+                    NoRecursion>::Train(
+    const MatType& data,
+    const arma::Row<size_t>& samples,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    DimensionSelectionType dimensionSelector,
+    const PresortedIndex* presortedIndex)
+{
+  // Sanity check on data.
+  if (data.n_cols != labels.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "DecisionTree::Train(): number of points (" << data.n_cols << ") "
+        << "does not match number of labels (" << labels.n_elem << ")!"
+        << std::endl;
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Gather the labels of the sampled points; the dataset itself is not
+  // copied, since the recursion partitions the sample indices instead of the
+  // columns of the data matrix.
+  arma::Row<size_t> tmpSamples(samples);
+  arma::Row<size_t> tmpLabels(samples.n_elem);
+  for (size_t i = 0; i < samples.n_elem; ++i)
+    tmpLabels[i] = labels[samples[i]];
+
+  // Set the correct dimensionality for the dimension selector.
+  dimensionSelector.Dimensions() = data.n_rows;
+
+  // Pass off work to the Train() method.
+  arma::rowvec weights; // Fake weights, not used.
+  return Train<false>(data, tmpSamples, 0, tmpSamples.n_elem, tmpLabels,
+      numClasses, weights, minimumLeafSize, minimumGainSplit, maximumDepth,
+      dimensionSelector, presortedIndex);
+}
+
+//! Train on the sampled points of the given weighted data.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         typename ElemType,
+         bool NoRecursion>
+template<typename MatType>
+double DecisionTree<FitnessFunction,
+                    NumericSplitType,
+                    CategoricalSplitType,
+                    DimensionSelectionType,
+                    ElemType,
+                    NoRecursion>::Train(
+    const MatType& data,
+    const arma::Row<size_t>& samples,
+    const data::DatasetInfo& datasetInfo,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const arma::rowvec& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    DimensionSelectionType dimensionSelector,
+    const PresortedIndex* presortedIndex)
+{
+  // Sanity check on data.
+  if (data.n_cols != labels.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "DecisionTree::Train(): number of points (" << data.n_cols << ") "
+        << "does not match number of labels (" << labels.n_elem << ")!"
+        << std::endl;
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Gather the labels and weights of the sampled points; the dataset itself
+  // is not copied, since the recursion partitions the sample indices instead
+  // of the columns of the data matrix.
+  arma::Row<size_t> tmpSamples(samples);
+  arma::Row<size_t> tmpLabels(samples.n_elem);
+  arma::rowvec tmpWeights(samples.n_elem);
+  for (size_t i = 0; i < samples.n_elem; ++i)
+  {
+    tmpLabels[i] = labels[samples[i]];
+    tmpWeights[i] = weights[samples[i]];
+  }
+
+  // Set the correct dimensionality for the dimension selector.
+  dimensionSelector.Dimensions() = data.n_rows;
+
+  // Pass off work to the Train() method.
+  return Train<true>(data, tmpSamples, 0, tmpSamples.n_elem, datasetInfo,
+      tmpLabels, numClasses, tmpWeights, minimumLeafSize, minimumGainSplit,
+      maximumDepth, dimensionSelector, presortedIndex);
+}
+
+//! Train on the sampled points of the given weighted data, assuming all
+//! dimensions are numeric.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         typename ElemType,
+         bool NoRecursion>
+template<typename MatType>
+double DecisionTree<FitnessFunction,
+                    NumericSplitType,
+                    CategoricalSplitType,
+                    DimensionSelectionType,
+                    ElemType,
+                    NoRecursion>::Train(
+    const MatType& data,
+    const arma::Row<size_t>& samples,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const arma::rowvec& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    DimensionSelectionType dimensionSelector,
+    const PresortedIndex* presortedIndex)
+{
+  // Sanity check on data.
+  if (data.n_cols != labels.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "DecisionTree::Train(): number of points (" << data.n_cols << ") "
+        << "does not match number of labels (" << labels.n_elem << ")!"
+        << std::endl;
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Gather the labels and weights of the sampled points; the dataset itself
+  // is not copied, since the recursion partitions the sample indices instead
+  // of the columns of the data matrix.
+  arma::Row<size_t> tmpSamples(samples);
+  arma::Row<size_t> tmpLabels(samples.n_elem);
+  arma::rowvec tmpWeights(samples.n_elem);
+  for (size_t i = 0; i < samples.n_elem; ++i)
+  {
+    tmpLabels[i] = labels[samples[i]];
+    tmpWeights[i] = weights[samples[i]];
+  }
+
+  // Set the correct dimensionality for the dimension selector.
+  dimensionSelector.Dimensions() = data.n_rows;
+
+  // Pass off work to the Train() method.
+  return Train<true>(data, tmpSamples, 0, tmpSamples.n_elem, tmpLabels,
+      numClasses, tmpWeights, minimumLeafSize, minimumGainSplit, maximumDepth,
+      dimensionSelector, presortedIndex);
+}
+
 //! Train on the given data, assuming all dimensions are numeric.
 template<typename FitnessFunction,
          template<typename> class NumericSplitType,
@@ -669,7 +889,352 @@ double DecisionTree<FitnessFunction,
                     DimensionSelectionType,
                     ElemType,
                     NoRecursion>::Train(
-    MatType& data,
+    MatType& data,
+    const size_t begin,
+    const size_t count,
+    const data::DatasetInfo& datasetInfo,
+    arma::Row<size_t>& labels,
+    const size_t numClasses,
+    arma::rowvec& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    DimensionSelectionType& dimensionSelector)
+{
+  // Clear children if needed.
+  for (size_t i = 0; i < children.size(); ++i)
+    delete children[i];
+  children.clear();
+
+  // Look through the list of dimensions and obtain the gain of the best split.
+  // We'll cache the best numeric and categorical split auxiliary information in
+  // numericAux and categoricalAux (and clear them later if we make no split),
+  // and use classProbabilities as auxiliary information.  Later we'll overwrite
+  // classProbabilities to the empirical class probabilities if we do not split.
+  double bestGain = FitnessFunction::template Evaluate<UseWeights>(
+      labels.subvec(begin, begin + count - 1),
+      numClasses,
+      UseWeights ? weights.subvec(begin, begin + count - 1) : weights);
+  size_t bestDim = datasetInfo.Dimensionality(); // This means "no split".
+  const size_t end = dimensionSelector.End();
+
+  if (maximumDepth != 1)
+  {
+    for (size_t i = dimensionSelector.Begin(); i != end;
+         i = dimensionSelector.Next())
+    {
+      double dimGain = -DBL_MAX;
+      if (datasetInfo.Type(i) == data::Datatype::categorical)
+      {
+        dimGain = CategoricalSplit::template SplitIfBetter<UseWeights>(bestGain,
+            data.cols(begin, begin + count - 1).row(i),
+            datasetInfo.NumMappings(i),
+            labels.subvec(begin, begin + count - 1),
+            numClasses,
+            UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
+            minimumLeafSize,
+            minimumGainSplit,
+            classProbabilities,
+            *this);
+      }
+      else if (datasetInfo.Type(i) == data::Datatype::numeric)
+      {
+        dimGain = NumericSplit::template SplitIfBetter<UseWeights>(bestGain,
+            data.cols(begin, begin + count - 1).row(i),
+            labels.subvec(begin, begin + count - 1),
+            numClasses,
+            UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
+            minimumLeafSize,
+            minimumGainSplit,
+            classProbabilities,
+            *this);
+      }
+
+      // If the splitter reported that it did not split, move to the next
+      // dimension.
+      if (dimGain == DBL_MAX)
+        continue;
+
+      // Was there an improvement?  If so mark that it's the new best dimension.
+      bestDim = i;
+      bestGain = dimGain;
+
+      // If the gain is the best possible, no need to keep looking.
+      if (bestGain >= 0.0)
+        break;
+    }
+  }
+
+  // Did we split or not?  If so, then split the data and create the children.
+  if (bestDim != datasetInfo.Dimensionality())
+  {
+    dimensionTypeOrMajorityClass = (size_t) datasetInfo.Type(bestDim);
+    splitDimension = bestDim;
+
+    // Get the number of children we will have.
+    size_t numChildren = 0;
+    if (datasetInfo.Type(bestDim) == data::Datatype::categorical)
+      numChildren = CategoricalSplit::NumChildren(classProbabilities, *this);
+    else
+      numChildren = NumericSplit::NumChildren(classProbabilities, *this);
+
+    // Calculate all child assignments.
+    arma::Row<size_t> childAssignments(count);
+    if (datasetInfo.Type(bestDim) == data::Datatype::categorical)
+    {
+      for (size_t j = begin; j < begin + count; ++j)
+        childAssignments[j - begin] = CategoricalSplit::CalculateDirection(
+            data(bestDim, j), classProbabilities, *this);
+    }
+    else
+    {
+      for (size_t j = begin; j < begin + count; ++j)
+      {
+        childAssignments[j - begin] = NumericSplit::CalculateDirection(
+            data(bestDim, j), classProbabilities, *this);
+      }
+    }
+
+    // Figure out counts of children.
+    arma::Row<size_t> childCounts(numChildren, arma::fill::zeros);
+    for (size_t i = begin; i < begin + count; ++i)
+      childCounts[childAssignments[i - begin]]++;
+
+    // Initialize bestGain if recursive split is allowed.
+    if (!NoRecursion)
+    {
+      bestGain = 0.0;
+    }
+
+    // Split into children.
+    size_t currentCol = begin;
+    for (size_t i = 0; i < numChildren; ++i)
+    {
+      size_t currentChildBegin = currentCol;
+      for (size_t j = currentChildBegin; j < begin + count; ++j)
+      {
+        if (childAssignments[j - begin] == i)
+        {
+          childAssignments.swap_cols(currentCol - begin, j - begin);
+          data.swap_cols(currentCol, j);
+          labels.swap_cols(currentCol, j);
+          if (UseWeights)
+            weights.swap_cols(currentCol, j);
+          ++currentCol;
+        }
+      }
+
+      // Now build the child recursively.
+      DecisionTree* child = new DecisionTree();
+      if (NoRecursion)
+      {
+        child->Train<UseWeights>(data, currentChildBegin,
+            currentCol - currentChildBegin, datasetInfo, labels, numClasses,
+            weights, currentCol - currentChildBegin, minimumGainSplit,
+            maximumDepth - 1, dimensionSelector);
+      }
+      else
+      {
+        // During recursion entropy of child node may change.
+        double childGain = child->Train<UseWeights>(data, currentChildBegin,
+            currentCol - currentChildBegin, datasetInfo, labels, numClasses,
+            weights, minimumLeafSize, minimumGainSplit, maximumDepth - 1,
+            dimensionSelector);
+        bestGain += double(childCounts[i]) / double(count) * (-childGain);
+      }
+      children.push_back(child);
+    }
+  }
+  else
+  {
+    // Clear auxiliary info objects.
+    NumericAuxiliarySplitInfo::operator=(NumericAuxiliarySplitInfo());
+    CategoricalAuxiliarySplitInfo::operator=(CategoricalAuxiliarySplitInfo());
+
+    // Calculate class probabilities because we are a leaf.
+    CalculateClassProbabilities<UseWeights>(
+        labels.subvec(begin, begin + count - 1),
+        numClasses,
+        UseWeights ? weights.subvec(begin, begin + count - 1) : weights);
+  }
+
+  return -bestGain;
+}
+
+//! Train on the given data, assuming all dimensions are numeric.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         typename ElemType,
+         bool NoRecursion>
+template<bool UseWeights, typename MatType>
+double DecisionTree<FitnessFunction,
+                    NumericSplitType,
+                    CategoricalSplitType,
+                    DimensionSelectionType,
+                    ElemType,
+                    NoRecursion>::Train(
+    MatType& data,
+    const size_t begin,
+    const size_t count,
+    arma::Row<size_t>& labels,
+    const size_t numClasses,
+    arma::rowvec& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t maximumDepth,
+    DimensionSelectionType& dimensionSelector)
+{
+  // Clear children if needed.
+  for (size_t i = 0; i < children.size(); ++i)
+    delete children[i];
+  children.clear();
+
+  // We won't be using these members, so reset them.
+  CategoricalAuxiliarySplitInfo::operator=(CategoricalAuxiliarySplitInfo());
+
+  // Look through the list of dimensions and obtain the best split.  We'll cache
+  // the best numeric split auxiliary information in numericAux (and clear it
+  // later if we don't make a split), and use classProbabilities as auxiliary
+  // information.  Later we'll overwrite classProbabilities to the empirical
+  // class probabilities if we do not split.
+  double bestGain = FitnessFunction::template Evaluate<UseWeights>(
+      labels.subvec(begin, begin + count - 1),
+      numClasses,
+      UseWeights ? weights.subvec(begin, begin + count - 1) : weights);
+  size_t bestDim = data.n_rows; // This means "no split".
+
+  if (maximumDepth != 1)
+  {
+    for (size_t i = dimensionSelector.Begin(); i != dimensionSelector.End();
+         i = dimensionSelector.Next())
+    {
+      const double dimGain = NumericSplitType<FitnessFunction>::template
+          SplitIfBetter<UseWeights>(bestGain,
+                                    data.cols(begin, begin + count - 1).row(i),
+                                    labels.cols(begin, begin + count - 1),
+                                    numClasses,
+                                    UseWeights ?
+                                        weights.cols(begin, begin + count - 1) :
+                                        weights,
+                                    minimumLeafSize,
+                                    minimumGainSplit,
+                                    classProbabilities,
+                                    *this);
+
+      // If the splitter did not report that it improved, then move to the next
+      // dimension.
+      if (dimGain == DBL_MAX)
+        continue;
+
+      bestDim = i;
+      bestGain = dimGain;
+
+      // If the gain is the best possible, no need to keep looking.
+      if (bestGain >= 0.0)
+        break;
+    }
+  }
+
+  // Did we split or not?  If so, then split the data and create the children.
+  if (bestDim != data.n_rows)
+  {
+    // We know that the split is numeric.
+    size_t numChildren = NumericSplit::NumChildren(classProbabilities, *this);
+    splitDimension = bestDim;
+    dimensionTypeOrMajorityClass = (size_t) data::Datatype::numeric;
+
+    // Calculate all child assignments.
+    arma::Row<size_t> childAssignments(count);
+
+    for (size_t j = begin; j < begin + count; ++j)
+    {
+      childAssignments[j - begin] = NumericSplit::CalculateDirection(
+          data(bestDim, j), classProbabilities, *this);
+    }
+
+    // Calculate counts of children in each node.
+    arma::Row<size_t> childCounts(numChildren);
+    childCounts.zeros();
+    for (size_t j = begin; j < begin + count; ++j)
+      childCounts[childAssignments[j - begin]]++;
+
+    // Initialize bestGain if recursive split is allowed.
+    if (!NoRecursion)
+    {
+      bestGain = 0.0;
+    }
+
+    size_t currentCol = begin;
+    for (size_t i = 0; i < numChildren; ++i)
+    {
+      size_t currentChildBegin = currentCol;
+      for (size_t j = currentChildBegin; j < begin + count; ++j)
+      {
+        if (childAssignments[j - begin] == i)
+        {
+          childAssignments.swap_cols(currentCol - begin, j - begin);
+          data.swap_cols(currentCol, j);
+          labels.swap_cols(currentCol, j);
+          if (UseWeights)
+            weights.swap_cols(currentCol, j);
+          ++currentCol;
+        }
+      }
+
+      // Now build the child recursively.
+      DecisionTree* child = new DecisionTree();
+      if (NoRecursion)
+      {
+        child->Train<UseWeights>(data, currentChildBegin,
+            currentCol - currentChildBegin, labels, numClasses, weights,
+            currentCol - currentChildBegin, minimumGainSplit, maximumDepth - 1,
+            dimensionSelector);
+      }
+      else
+      {
+        // During recursion entropy of child node may change.
+        double childGain = child->Train<UseWeights>(data, currentChildBegin,
+            currentCol - currentChildBegin, labels, numClasses, weights,
+            minimumLeafSize, minimumGainSplit, maximumDepth - 1,
+            dimensionSelector);
+        bestGain += double(childCounts[i]) / double(count) * (-childGain);
+      }
+      children.push_back(child);
+    }
+  }
+  else
+  {
+    // We won't be needing these members, so reset them.
+    NumericAuxiliarySplitInfo::operator=(NumericAuxiliarySplitInfo());
+
+    // Calculate class probabilities because we are a leaf.
+    CalculateClassProbabilities<UseWeights>(
+        labels.subvec(begin, begin + count - 1),
+        numClasses,
+        UseWeights ? weights.subvec(begin, begin + count - 1) : weights);
+  }
+
+  return -bestGain;
+}
+
+//! Train on the sampled points of the given data.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         typename ElemType,
+         bool NoRecursion>
+template<bool UseWeights, typename MatType>
+double DecisionTree<FitnessFunction,
+                    NumericSplitType,
+                    CategoricalSplitType,
+                    DimensionSelectionType,
+                    ElemType,
+                    NoRecursion>::Train(
+    const MatType& data,
+    arma::Row<size_t>& samples,
     const size_t begin,
     const size_t count,
     const data::DatasetInfo& datasetInfo,
@@ -679,18 +1244,19 @@ double DecisionTree<FitnessFunction,
     const size_t minimumLeafSize,
     const double minimumGainSplit,
     const size_t maximumDepth,
-    DimensionSelectionType& dimensionSelector)
+    DimensionSelectionType& dimensionSelector,
+    const PresortedIndex* presortedIndex)
 {
   // Clear children if needed.
   for (size_t i = 0; i < children.size(); ++i)
     delete children[i];
   children.clear();
 
-  // Look through the list of dimensions and obtain the gain of the best split.
-  // We'll cache the best numeric and categorical split auxiliary information in
-  // numericAux and categoricalAux (and clear them later if we make no split),
-  // and use classProbabilities as auxiliary information.  Later we'll overwrite
-  // classProbabilities to the empirical class probabilities if we do not split.
+  // This mirrors the column-partitioning Train() above, except that the data
+  // matrix is read-only and shared: the values of a candidate dimension are
+  // gathered into a contiguous buffer before being handed to the splitters,
+  // and the partition into children swaps sample indices instead of data
+  // columns.
   double bestGain = FitnessFunction::template Evaluate<UseWeights>(
       labels.subvec(begin, begin + count - 1),
       numClasses,
@@ -700,14 +1266,21 @@ double DecisionTree<FitnessFunction,
 
   if (maximumDepth != 1)
   {
+    // One gather buffer is reused for every candidate dimension; likewise for
+    // the sorted-order buffer when a presorted index is available.
+    arma::Row<typename MatType::elem_type> dimValues(count);
+    arma::uvec sampleOrder;
     for (size_t i = dimensionSelector.Begin(); i != end;
          i = dimensionSelector.Next())
     {
+      for (size_t j = 0; j < count; ++j)
+        dimValues[j] = data(i, samples[begin + j]);
+
       double dimGain = -DBL_MAX;
       if (datasetInfo.Type(i) == data::Datatype::categorical)
       {
         dimGain = CategoricalSplit::template SplitIfBetter<UseWeights>(bestGain,
-            data.cols(begin, begin + count - 1).row(i),
+            dimValues,
             datasetInfo.NumMappings(i),
             labels.subvec(begin, begin + count - 1),
             numClasses,
@@ -719,15 +1292,35 @@ double DecisionTree<FitnessFunction,
       }
       else if (datasetInfo.Type(i) == data::Datatype::numeric)
       {
-        dimGain = NumericSplit::template SplitIfBetter<UseWeights>(bestGain,
-            data.cols(begin, begin + count - 1).row(i),
-            labels.subvec(begin, begin + count - 1),
-            numClasses,
-            UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
-            minimumLeafSize,
-            minimumGainSplit,
-            classProbabilities,
-            *this);
+        if (presortedIndex != NULL && presortedIndex->HasDimension(i))
+        {
+          // Recover the sorted order of this node's points from the cached
+          // ranks instead of letting the splitter re-sort the values.
+          presortedIndex->SortSamples(i, samples, begin, count, sampleOrder);
+          dimGain = SplitIfBetterWithOrder<UseWeights, NumericSplit>(0,
+              bestGain,
+              dimValues,
+              sampleOrder,
+              labels.subvec(begin, begin + count - 1),
+              numClasses,
+              UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
+              minimumLeafSize,
+              minimumGainSplit,
+              classProbabilities,
+              *this);
+        }
+        else
+        {
+          dimGain = NumericSplit::template SplitIfBetter<UseWeights>(bestGain,
+              dimValues,
+              labels.subvec(begin, begin + count - 1),
+              numClasses,
+              UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
+              minimumLeafSize,
+              minimumGainSplit,
+              classProbabilities,
+              *this);
+        }
       }
 
       // If the splitter reported that it did not split, move to the next
@@ -745,7 +1338,8 @@ double DecisionTree<FitnessFunction,
     }
   }
 
-  // Did we split or not?  If so, then split the data and create the children.
+  // Did we split or not?  If so, then split the sample and create the
+  // children.
   if (bestDim != datasetInfo.Dimensionality())
   {
     dimensionTypeOrMajorityClass = (size_t) datasetInfo.Type(bestDim);
@@ -764,14 +1358,14 @@ double DecisionTree<FitnessFunction,
     {
       for (size_t j = begin; j < begin + count; ++j)
         childAssignments[j - begin] = CategoricalSplit::CalculateDirection(
-            data(bestDim, j), classProbabilities, *this);
+            data(bestDim, samples[j]), classProbabilities, *this);
     }
     else
     {
       for (size_t j = begin; j < begin + count; ++j)
       {
         childAssignments[j - begin] = NumericSplit::CalculateDirection(
-            data(bestDim, j), classProbabilities, *this);
+            data(bestDim, samples[j]), classProbabilities, *this);
       }
     }
 
@@ -796,7 +1390,7 @@ double DecisionTree<FitnessFunction,
         if (childAssignments[j - begin] == i)
         {
           childAssignments.swap_cols(currentCol - begin, j - begin);
-          data.swap_cols(currentCol, j);
+          samples.swap_cols(currentCol, j);
           labels.swap_cols(currentCol, j);
           if (UseWeights)
             weights.swap_cols(currentCol, j);
@@ -808,18 +1402,18 @@ double DecisionTree<FitnessFunction,
       DecisionTree* child = new DecisionTree();
       if (NoRecursion)
       {
-        child->Train<UseWeights>(data, currentChildBegin,
+        child->Train<UseWeights>(data, samples, currentChildBegin,
             currentCol - currentChildBegin, datasetInfo, labels, numClasses,
             weights, currentCol - currentChildBegin, minimumGainSplit,
-            maximumDepth - 1, dimensionSelector);
+            maximumDepth - 1, dimensionSelector, presortedIndex);
       }
       else
       {
         // During recursion entropy of child node may change.
-        double childGain = child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, datasetInfo, labels, numClasses,
-            weights, minimumLeafSize, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
+        double childGain = child->Train<UseWeights>(data, samples,
+            currentChildBegin, currentCol - currentChildBegin, datasetInfo,
+            labels, numClasses, weights, minimumLeafSize, minimumGainSplit,
+            maximumDepth - 1, dimensionSelector, presortedIndex);
         bestGain += double(childCounts[i]) / double(count) * (-childGain);
       }
       children.push_back(child);
@@ -841,7 +1435,8 @@ double DecisionTree<FitnessFunction,
   return -bestGain;
 }
 
-//! Train on the given data, assuming all dimensions are numeric.
+//! Train on the sampled points of the given data, assuming all dimensions are
+//! numeric.
 template<typename FitnessFunction,
          template<typename> class NumericSplitType,
          template<typename> class CategoricalSplitType,
@@ -855,7 +1450,8 @@ double DecisionTree<FitnessFunction,
                     DimensionSelectionType,
                     ElemType,
                     NoRecursion>::Train(
-    MatType& data,
+    const MatType& data,
+    arma::Row<size_t>& samples,
     const size_t begin,
     const size_t count,
     arma::Row<size_t>& labels,
@@ -864,7 +1460,8 @@ double DecisionTree<FitnessFunction,
     const size_t minimumLeafSize,
     const double minimumGainSplit,
     const size_t maximumDepth,
-    DimensionSelectionType& dimensionSelector)
+    DimensionSelectionType& dimensionSelector,
+    const PresortedIndex* presortedIndex)
 {
   // Clear children if needed.
   for (size_t i = 0; i < children.size(); ++i)
@@ -874,11 +1471,11 @@ double DecisionTree<FitnessFunction,
   // We won't be using these members, so reset them.
   CategoricalAuxiliarySplitInfo::operator=(CategoricalAuxiliarySplitInfo());
 
-  // Look through the list of dimensions and obtain the best split.  We'll cache
-  // the best numeric split auxiliary information in numericAux (and clear it
-  // later if we don't make a split), and use classProbabilities as auxiliary
-  // information.  Later we'll overwrite classProbabilities to the empirical
-  // class probabilities if we do not split.
+  // This mirrors the column-partitioning Train() above, except that the data
+  // matrix is read-only and shared: the values of a candidate dimension are
+  // gathered into a contiguous buffer before being handed to the splitter,
+  // and the partition into children swaps sample indices instead of data
+  // columns.
   double bestGain = FitnessFunction::template Evaluate<UseWeights>(
       labels.subvec(begin, begin + count - 1),
       numClasses,
@@ -887,21 +1484,52 @@ double DecisionTree<FitnessFunction,
 
   if (maximumDepth != 1)
   {
+    // One gather buffer is reused for every candidate dimension; likewise for
+    // the sorted-order buffer when a presorted index is available.
+    arma::Row<typename MatType::elem_type> dimValues(count);
+    arma::uvec sampleOrder;
     for (size_t i = dimensionSelector.Begin(); i != dimensionSelector.End();
          i = dimensionSelector.Next())
     {
-      const double dimGain = NumericSplitType<FitnessFunction>::template
-          SplitIfBetter<UseWeights>(bestGain,
-                                    data.cols(begin, begin + count - 1).row(i),
-                                    labels.cols(begin, begin + count - 1),
-                                    numClasses,
-                                    UseWeights ?
-                                        weights.cols(begin, begin + count - 1) :
-                                        weights,
-                                    minimumLeafSize,
-                                    minimumGainSplit,
-                                    classProbabilities,
-                                    *this);
+      for (size_t j = 0; j < count; ++j)
+        dimValues[j] = data(i, samples[begin + j]);
+
+      double dimGain;
+      if (presortedIndex != NULL && presortedIndex->HasDimension(i))
+      {
+        // Recover the sorted order of this node's points from the cached
+        // ranks instead of letting the splitter re-sort the values.
+        presortedIndex->SortSamples(i, samples, begin, count, sampleOrder);
+        dimGain = SplitIfBetterWithOrder<UseWeights, NumericSplit>(0,
+            bestGain,
+            dimValues,
+            sampleOrder,
+            labels.cols(begin, begin + count - 1),
+            numClasses,
+            UseWeights ?
+                weights.cols(begin, begin + count - 1) :
+                weights,
+            minimumLeafSize,
+            minimumGainSplit,
+            classProbabilities,
+            *this);
+      }
+      else
+      {
+        dimGain = NumericSplitType<FitnessFunction>::template
+            SplitIfBetter<UseWeights>(bestGain,
+                                      dimValues,
+                                      labels.cols(begin, begin + count - 1),
+                                      numClasses,
+                                      UseWeights ?
+                                          weights.cols(begin,
+                                                       begin + count - 1) :
+                                          weights,
+                                      minimumLeafSize,
+                                      minimumGainSplit,
+                                      classProbabilities,
+                                      *this);
+      }
 
       // If the splitter did not report that it improved, then move to the next
       // dimension.
@@ -917,7 +1545,8 @@ double DecisionTree<FitnessFunction,
     }
   }
 
-  // Did we split or not?  If so, then split the data and create the children.
+  // Did we split or not?  If so, then split the sample and create the
+  // children.
   if (bestDim != data.n_rows)
   {
     // We know that the split is numeric.
@@ -931,7 +1560,7 @@ double DecisionTree<FitnessFunction,
     for (size_t j = begin; j < begin + count; ++j)
     {
       childAssignments[j - begin] = NumericSplit::CalculateDirection(
-          data(bestDim, j), classProbabilities, *this);
+          data(bestDim, samples[j]), classProbabilities, *this);
     }
 
     // Calculate counts of children in each node.
@@ -955,7 +1584,7 @@ double DecisionTree<FitnessFunction,
         if (childAssignments[j - begin] == i)
         {
           childAssignments.swap_cols(currentCol - begin, j - begin);
-          data.swap_cols(currentCol, j);
+          samples.swap_cols(currentCol, j);
           labels.swap_cols(currentCol, j);
           if (UseWeights)
             weights.swap_cols(currentCol, j);
@@ -967,18 +1596,18 @@ double DecisionTree<FitnessFunction,
       DecisionTree* child = new DecisionTree();
       if (NoRecursion)
       {
-        child->Train<UseWeights>(data, currentChildBegin,
+        child->Train<UseWeights>(data, samples, currentChildBegin,
             currentCol - currentChildBegin, labels, numClasses, weights,
             currentCol - currentChildBegin, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
+            dimensionSelector, presortedIndex);
       }
       else
       {
         // During recursion entropy of child node may change.
-        double childGain = child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, labels, numClasses, weights,
-            minimumLeafSize, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
+        double childGain = child->Train<UseWeights>(data, samples,
+            currentChildBegin, currentCol - currentChildBegin, labels,
+            numClasses, weights, minimumLeafSize, minimumGainSplit,
+            maximumDepth - 1, dimensionSelector, presortedIndex);
         bestGain += double(childCounts[i]) / double(count) * (-childGain);
       }
       children.push_back(child);
@@ -1234,6 +1863,230 @@ void DecisionTree<FitnessFunction,
   dimensionTypeOrMajorityClass = (size_t) maxIndex;
 }
 
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         typename ElemType,
+         bool NoRecursion>
+template<typename MatType>
+double DecisionTree<FitnessFunction,
+                    NumericSplitType,
+                    CategoricalSplitType,
+                    DimensionSelectionType,
+                    ElemType,
+                    NoRecursion>::Prune(
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const MatType& validationData,
+    const arma::Row<size_t>& validationLabels)
+{
+  if (validationData.n_cols == 0)
+  {
+    throw std::invalid_argument("DecisionTree::Prune(): validation set is "
+        "empty!");
+  }
+
+  const size_t numClasses = NumClasses();
+
+  // Collect the nodes in breadth-first order, with parent links.  The
+  // children of a node are appended together, so only the index of the first
+  // child is needed to route points by index below.  Children always have
+  // larger indices than their parent.
+  std::vector<DecisionTree*> nodes;
+  std::vector<size_t> firstChild, parent;
+  nodes.push_back(this);
+  parent.push_back(0);
+  for (size_t i = 0; i < nodes.size(); ++i)
+  {
+    firstChild.push_back(nodes.size());
+    for (size_t c = 0; c < nodes[i]->children.size(); ++c)
+    {
+      nodes.push_back(nodes[i]->children[c]);
+      parent.push_back(i);
+    }
+  }
+
+  // Route the training data through the tree to recover the class counts of
+  // every node; the sweep needs them to score nodes as merged leaves.
+  arma::mat counts(numClasses, nodes.size(), arma::fill::zeros);
+  for (size_t j = 0; j < data.n_cols; ++j)
+  {
+    size_t i = 0;
+    while (true)
+    {
+      counts(labels[j], i) += 1.0;
+      if (nodes[i]->children.size() == 0)
+        break;
+      i = firstChild[i] + nodes[i]->CalculateDirection(data.col(j));
+    }
+  }
+
+  // The majority class of every node, and the number of misclassified
+  // training points if the node were collapsed into a leaf.
+  std::vector<size_t> majority(nodes.size());
+  arma::vec nodeError(nodes.size());
+  for (size_t i = 0; i < nodes.size(); ++i)
+  {
+    arma::uword maxIndex = 0;
+    counts.col(i).max(maxIndex);
+    majority[i] = (size_t) maxIndex;
+    nodeError[i] = arma::accu(counts.col(i)) - counts(maxIndex, i);
+  }
+
+  // The error and leaf count of every node's current subtree, computed
+  // bottom-up.
+  arma::vec subtreeError = nodeError;
+  std::vector<size_t> subtreeLeaves(nodes.size(), 1);
+  for (size_t i = nodes.size(); i > 0; --i)
+  {
+    const size_t node = i - 1;
+    if (nodes[node]->children.size() == 0)
+      continue;
+
+    subtreeError[node] = 0.0;
+    subtreeLeaves[node] = 0;
+    for (size_t c = 0; c < nodes[node]->children.size(); ++c)
+    {
+      subtreeError[node] += subtreeError[firstChild[node] + c];
+      subtreeLeaves[node] += subtreeLeaves[firstChild[node] + c];
+    }
+  }
+
+  // Weakest-link sweep: repeatedly collapse the internal node(s) whose
+  // subtree buys the least training error per extra leaf, recording at which
+  // step each node is collapsed.  Candidate subtree k keeps exactly the
+  // nodes collapsed after step k, so the candidates are nested.
+  std::vector<size_t> pruneStep(nodes.size(), 0); // 0 = never collapsed.
+  std::vector<bool> removed(nodes.size(), false);
+  size_t numSteps = 0;
+  while (nodes[0]->children.size() > 0 && pruneStep[0] == 0)
+  {
+    ++numSteps;
+
+    // Find the smallest complexity penalty alpha among live internal nodes.
+    double minAlpha = DBL_MAX;
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+      if (removed[i] || pruneStep[i] > 0 || nodes[i]->children.size() == 0)
+        continue;
+      const double alpha = (nodeError[i] - subtreeError[i]) /
+          (subtreeLeaves[i] - 1);
+      minAlpha = std::min(minAlpha, alpha);
+    }
+
+    // Collapse every live internal node achieving that alpha.
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+      if (removed[i] || pruneStep[i] > 0 || nodes[i]->children.size() == 0)
+        continue;
+      const double alpha = (nodeError[i] - subtreeError[i]) /
+          (subtreeLeaves[i] - 1);
+      if (alpha > minAlpha + 1e-12)
+        continue;
+
+      pruneStep[i] = numSteps;
+
+      // The node's descendants leave the tree.
+      std::vector<size_t> pending(1, i);
+      while (!pending.empty())
+      {
+        const size_t index = pending.back();
+        pending.pop_back();
+        for (size_t c = 0; c < nodes[index]->children.size(); ++c)
+        {
+          removed[firstChild[index] + c] = true;
+          pending.push_back(firstChild[index] + c);
+        }
+      }
+
+      // The node's ancestors lose its subtree's leaves and error.
+      const double errorDelta = nodeError[i] - subtreeError[i];
+      const size_t leafDelta = subtreeLeaves[i] - 1;
+      subtreeError[i] = nodeError[i];
+      subtreeLeaves[i] = 1;
+      size_t p = i;
+      while (p != 0)
+      {
+        p = parent[p];
+        subtreeError[p] += errorDelta;
+        subtreeLeaves[p] -= leafDelta;
+      }
+    }
+  }
+
+  // Score every candidate subtree on the validation set.  The candidates
+  // share all read-only state, so they are evaluated in parallel.
+  arma::vec accuracies(numSteps + 1);
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t k = 0; k <= (omp_size_t) numSteps; ++k)
+  {
+    size_t correct = 0;
+    for (size_t j = 0; j < validationData.n_cols; ++j)
+    {
+      size_t i = 0;
+      while (nodes[i]->children.size() > 0 &&
+             !(pruneStep[i] > 0 && pruneStep[i] <= (size_t) k))
+      {
+        i = firstChild[i] +
+            nodes[i]->CalculateDirection(validationData.col(j));
+      }
+      if (majority[i] == validationLabels[j])
+        ++correct;
+    }
+    accuracies[k] = (double) correct / validationData.n_cols;
+  }
+
+  // Pick the best candidate; ties go to the most heavily pruned subtree.
+  size_t bestStep = 0;
+  for (size_t k = 1; k <= numSteps; ++k)
+  {
+    if (accuracies[k] >= accuracies[bestStep])
+      bestStep = k;
+  }
+
+  // Apply the selected pruning: collapse each chosen node into a leaf with
+  // the class distribution of its routed training points.
+  if (bestStep > 0)
+  {
+    std::vector<size_t> pending(1, 0);
+    while (!pending.empty())
+    {
+      const size_t i = pending.back();
+      pending.pop_back();
+      if (nodes[i]->children.size() == 0)
+        continue;
+
+      if (pruneStep[i] > 0 && pruneStep[i] <= bestStep)
+      {
+        for (size_t c = 0; c < nodes[i]->children.size(); ++c)
+          delete nodes[i]->children[c];
+        nodes[i]->children.clear();
+
+        const double total = arma::accu(counts.col(i));
+        if (total > 0.0)
+        {
+          nodes[i]->classProbabilities = counts.col(i) / total;
+        }
+        else
+        {
+          // No training points were routed here; fall back to uniform.
+          nodes[i]->classProbabilities =
+              arma::vec(numClasses, arma::fill::ones) / numClasses;
+        }
+        nodes[i]->dimensionTypeOrMajorityClass = majority[i];
+      }
+      else
+      {
+        for (size_t c = 0; c < nodes[i]->children.size(); ++c)
+          pending.push_back(firstChild[i] + c);
+      }
+    }
+  }
+
+  return accuracies[bestStep];
+}
+
 } // namespace tree
 } // namespace mlpack
 
@@ -0,0 +1,355 @@
+/**
+ * @file methods/decision_tree/histogram_numeric_split_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the histogram-based binary numeric split.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_HISTOGRAM_NUMERIC_SPLIT_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_HISTOGRAM_NUMERIC_SPLIT_IMPL_HPP
+
+namespace mlpack {
+namespace tree {
+
+// If labels has size_t type use for classification.
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename WeightVecType>
+double HistogramNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::Col<typename VecType::elem_type>& classProbabilities,
+    AuxiliarySplitInfo<typename VecType::elem_type>& /* aux */)
+{
+  typedef typename VecType::elem_type ElemType;
+
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Sanity check: if all values are the same, we can't split.
+  const ElemType minValue = data.min();
+  const ElemType maxValue = data.max();
+  if (minValue == maxValue)
+    return DBL_MAX;
+
+  // Bin the dimension into equal-width buckets, accumulating per-bucket class
+  // counts (or weight sums) in one pass instead of sorting.
+  const size_t numBins = std::min((size_t) NumBins, (size_t) data.n_elem);
+  const double binWidth = double(maxValue - minValue) / numBins;
+
+  arma::Col<size_t> binCounts(numBins, arma::fill::zeros);
+  arma::Mat<size_t> binClassCounts;
+  arma::mat binClassWeights;
+  if (UseWeights)
+    binClassWeights.zeros(numClasses, numBins);
+  else
+    binClassCounts.zeros(numClasses, numBins);
+
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    const size_t bin = std::min(numBins - 1,
+        (size_t) (double(data[i] - minValue) / binWidth));
+    ++binCounts[bin];
+    if (UseWeights)
+      binClassWeights(labels[i], bin) += weights[i];
+    else
+      ++binClassCounts(labels[i], bin);
+  }
+
+  // Loop through the bucket boundaries, choosing the best one.  Also, force a
+  // minimum leaf size of 1 (empty children don't make sense).
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
+  bool improved = false;
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+
+  double totalWeight = 0.0;
+  arma::vec leftClassWeights, rightClassWeights;
+  arma::Col<size_t> leftClassCounts, rightClassCounts;
+  if (UseWeights)
+  {
+    rightClassWeights = arma::sum(binClassWeights, 1);
+    leftClassWeights.zeros(numClasses);
+    totalWeight = arma::accu(rightClassWeights);
+    bestFoundGain *= totalWeight;
+  }
+  else
+  {
+    rightClassCounts = arma::sum(binClassCounts, 1);
+    leftClassCounts.zeros(numClasses);
+    bestFoundGain *= data.n_elem;
+  }
+
+  size_t leftCount = 0;
+  double totalLeftWeight = 0.0;
+  for (size_t bin = 0; bin + 1 < numBins; ++bin)
+  {
+    // Move this bucket's statistics from the right child to the left child.
+    leftCount += binCounts[bin];
+    if (UseWeights)
+    {
+      leftClassWeights += binClassWeights.col(bin);
+      rightClassWeights -= binClassWeights.col(bin);
+      totalLeftWeight += arma::accu(binClassWeights.col(bin));
+    }
+    else
+    {
+      leftClassCounts += binClassCounts.col(bin);
+      rightClassCounts -= binClassCounts.col(bin);
+    }
+
+    // An empty bucket leaves the partition unchanged.
+    if (binCounts[bin] == 0)
+      continue;
+
+    // Enforce the minimum leaf size on both children.
+    const size_t rightCount = data.n_elem - leftCount;
+    if ((leftCount < minimum) || (rightCount < minimum))
+      continue;
+
+    // Calculate the gain for the left and right child.  Only use weights if
+    // needed.
+    const double totalRightWeight = totalWeight - totalLeftWeight;
+    const double leftGain = UseWeights ?
+        FitnessFunction::template EvaluatePtr<true>(
+            leftClassWeights.memptr(), numClasses, totalLeftWeight) :
+        FitnessFunction::template EvaluatePtr<false>(
+            leftClassCounts.memptr(), numClasses, leftCount);
+    const double rightGain = UseWeights ?
+        FitnessFunction::template EvaluatePtr<true>(
+            rightClassWeights.memptr(), numClasses, totalRightWeight) :
+        FitnessFunction::template EvaluatePtr<false>(
+            rightClassCounts.memptr(), numClasses, rightCount);
+
+    double gain;
+    if (UseWeights)
+    {
+      gain = totalLeftWeight * leftGain + totalRightWeight * rightGain;
+    }
+    else
+    {
+      // Calculate the gain at this bucket boundary.
+      gain = double(leftCount) * leftGain + double(rightCount) * rightGain;
+    }
+
+    // The split value is the boundary between this bucket and the next one.
+    const ElemType splitValue =
+        ElemType(minValue + double(bin + 1) * binWidth);
+
+    // Corner case: is this the best possible split?
+    if (gain >= 0.0)
+    {
+      // We can take a shortcut: no split will be better than this, so just
+      // take this one.
+      classProbabilities.set_size(1);
+      classProbabilities[0] = splitValue;
+
+      return gain;
+    }
+    else if (gain > bestFoundGain)
+    {
+      // We still have a better split.
+      bestFoundGain = gain;
+      classProbabilities.set_size(1);
+      classProbabilities[0] = splitValue;
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  if (UseWeights)
+    bestFoundGain /= totalWeight;
+  else
+    bestFoundGain /= data.n_elem;
+
+  return bestFoundGain;
+}
+
+// If predictors is of type arma::rowvec use regression.
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename WeightVecType>
+double HistogramNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const arma::rowvec& predictors,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::Col<typename VecType::elem_type>& classProbabilities,
+    AuxiliarySplitInfo<typename VecType::elem_type>& /* aux */)
+{
+  typedef typename VecType::elem_type ElemType;
+
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Sanity check: if all values are the same, we can't split.
+  const ElemType minValue = data.min();
+  const ElemType maxValue = data.max();
+  if (minValue == maxValue)
+    return DBL_MAX;
+
+  // Bin the dimension into equal-width buckets.
+  const size_t numBins = std::min((size_t) NumBins, (size_t) data.n_elem);
+  const double binWidth = double(maxValue - minValue) / numBins;
+
+  arma::Col<size_t> binCounts(numBins, arma::fill::zeros);
+  arma::Col<size_t> bins(data.n_elem);
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    bins[i] = std::min(numBins - 1,
+        (size_t) (double(data[i] - minValue) / binWidth));
+    ++binCounts[bins[i]];
+  }
+
+  // Counting sort the predictors (and weights) into bucket order, so that the
+  // fitness function can be evaluated over contiguous ranges.  The order of
+  // points inside a bucket does not matter because only bucket boundaries are
+  // candidate splits.
+  arma::Col<size_t> binOffsets(numBins);
+  size_t offset = 0;
+  for (size_t bin = 0; bin < numBins; ++bin)
+  {
+    binOffsets[bin] = offset;
+    offset += binCounts[bin];
+  }
+
+  arma::rowvec sortedPredictors(predictors.n_elem);
+  arma::rowvec sortedWeights;
+  if (UseWeights)
+    sortedWeights.set_size(predictors.n_elem);
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    const size_t position = binOffsets[bins[i]]++;
+    sortedPredictors[position] = predictors[i];
+    if (UseWeights)
+      sortedWeights[position] = weights[i];
+  }
+
+  // Loop through the bucket boundaries, choosing the best one.  Also, force a
+  // minimum leaf size of 1 (empty children don't make sense).
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
+  bool improved = false;
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+
+  double totalWeight = 0.0;
+  double totalLeftWeight = 0.0;
+  if (UseWeights)
+  {
+    totalWeight = arma::accu(sortedWeights);
+    bestFoundGain *= totalWeight;
+  }
+  else
+  {
+    bestFoundGain *= data.n_elem;
+  }
+
+  size_t leftCount = 0;
+  for (size_t bin = 0; bin + 1 < numBins; ++bin)
+  {
+    if (UseWeights)
+    {
+      for (size_t i = leftCount; i < leftCount + binCounts[bin]; ++i)
+        totalLeftWeight += sortedWeights[i];
+    }
+    leftCount += binCounts[bin];
+
+    // An empty bucket leaves the partition unchanged.
+    if (binCounts[bin] == 0)
+      continue;
+
+    // Enforce the minimum leaf size on both children.
+    const size_t rightCount = data.n_elem - leftCount;
+    if ((leftCount < minimum) || (rightCount < minimum))
+      continue;
+
+    // Calculate the gain for the left and right child.  Only use weights if
+    // needed.
+    const double leftGain = FitnessFunction::template Evaluate<UseWeights>(
+        sortedPredictors, sortedWeights, 0, leftCount - 1);
+    const double rightGain = FitnessFunction::template Evaluate<UseWeights>(
+        sortedPredictors, sortedWeights, leftCount, data.n_elem - 1);
+
+    double gain;
+    if (UseWeights)
+    {
+      const double totalRightWeight = totalWeight - totalLeftWeight;
+      gain = totalLeftWeight * leftGain + totalRightWeight * rightGain;
+    }
+    else
+    {
+      // Calculate the gain at this bucket boundary.
+      gain = double(leftCount) * leftGain + double(rightCount) * rightGain;
+    }
+
+    // The split value is the boundary between this bucket and the next one.
+    const ElemType splitValue =
+        ElemType(minValue + double(bin + 1) * binWidth);
+
+    // Corner case: is this the best possible split?
+    if (gain >= 0.0)
+    {
+      // We can take a shortcut: no split will be better than this, so just
+      // take this one.
+      classProbabilities.set_size(1);
+      classProbabilities[0] = splitValue;
+
+      return gain;
+    }
+    else if (gain > bestFoundGain)
+    {
+      // We still have a better split.
+      bestFoundGain = gain;
+      classProbabilities.set_size(1);
+      classProbabilities[0] = splitValue;
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  if (UseWeights)
+    bestFoundGain /= totalWeight;
+  else
+    bestFoundGain /= data.n_elem;
+
+  return bestFoundGain;
+}
+
+template<typename FitnessFunction>
+template<typename ElemType>
+size_t HistogramNumericSplit<FitnessFunction>::CalculateDirection(
+    const ElemType& point,
+    const arma::Col<ElemType>& classProbabilities,
+    const AuxiliarySplitInfo<ElemType>& /* aux */)
+{
+  if (point < classProbabilities[0])
+    return 0; // Go left.
+  else
+    return 1; // Go right.
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
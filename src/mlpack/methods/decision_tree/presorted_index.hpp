@@ -0,0 +1,184 @@
+/**
+ * @file methods/decision_tree/presorted_index.hpp
+ *
+ * A presorted per-dimension index of a dataset, shared between all of the
+ * trees of an ensemble so that numeric split selection does not re-sort the
+ * same columns once per node per tree.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_PRESORTED_INDEX_HPP
+#define MLPACK_METHODS_DECISION_TREE_PRESORTED_INDEX_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/dataset_mapper.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The PresortedIndex holds, for every numeric dimension of a dataset, the rank
+ * of each point in the ascending order of that dimension.  The sorted order of
+ * each dimension is computed exactly once (in parallel across dimensions) when
+ * the index is built; afterwards, the sorted order of any subset of the points
+ * can be recovered from the ranks without ever comparing floating point values
+ * again.  The sample-indexed DecisionTree::Train() overloads accept an
+ * optional pointer to a PresortedIndex, and RandomForest::Train() builds one
+ * index that all of its trees share, so the per-node sorts inside
+ * BestBinaryNumericSplit are replaced by cheap integer rank sorts.
+ *
+ * The index refers to points by their column index in the dataset it was
+ * built from, so it must not be used after the dataset has been modified or
+ * with a different dataset.
+ */
+class PresortedIndex
+{
+ public:
+  /**
+   * Construct an empty index.  Call Build() before use.
+   */
+  PresortedIndex() : numPoints(0) { }
+
+  /**
+   * Build the index for the given dataset, assuming all dimensions are
+   * numeric.  The per-dimension sorts run in parallel when OpenMP is enabled.
+   *
+   * @param data Dataset to index.
+   */
+  template<typename MatType>
+  void Build(const MatType& data);
+
+  /**
+   * Build the index for the given dataset, indexing only the numeric
+   * dimensions.  Categorical dimensions are skipped; HasDimension() will
+   * return false for them.  The per-dimension sorts run in parallel when
+   * OpenMP is enabled.
+   *
+   * @param data Dataset to index.
+   * @param datasetInfo Type information for each dimension.
+   */
+  template<typename MatType>
+  void Build(const MatType& data, const data::DatasetInfo& datasetInfo);
+
+  /**
+   * Return true if the given dimension was indexed.
+   */
+  bool HasDimension(const size_t dimension) const
+  {
+    return (dimension < ranks.size()) && (ranks[dimension].n_elem > 0);
+  }
+
+  //! Get the number of points the index was built on.
+  size_t NumPoints() const { return numPoints; }
+
+  //! Get the rank array of the given dimension; element i is the position of
+  //! point i in the ascending order of that dimension.
+  const arma::uvec& Ranks(const size_t dimension) const
+  {
+    return ranks[dimension];
+  }
+
+  /**
+   * Compute the ascending order of a subset of the points in the given
+   * dimension.  The subset is samples[begin] ... samples[begin + count - 1]
+   * (indices may be repeated), and on return order[k] holds the offset into
+   * that range of the k'th smallest value.  Large subsets are ordered with a
+   * single counting pass over the rank space; small subsets fall back to a
+   * comparison sort of the gathered ranks, which is still much cheaper than
+   * re-sorting the values themselves.
+   *
+   * @param dimension Dimension to order by; HasDimension(dimension) must be
+   *      true.
+   * @param samples Column indices of the sampled points.
+   * @param begin Index of the first point of the subset in samples.
+   * @param count Number of points in the subset.
+   * @param order Vector to store the computed order in; it will be set to
+   *      length count.
+   */
+  inline void SortSamples(const size_t dimension,
+                          const arma::Row<size_t>& samples,
+                          const size_t begin,
+                          const size_t count,
+                          arma::uvec& order) const;
+
+ private:
+  //! The number of points in the indexed dataset.
+  size_t numPoints;
+  //! For each indexed dimension, the rank of every point in the ascending
+  //! order of that dimension; empty for dimensions that were not indexed.
+  std::vector<arma::uvec> ranks;
+};
+
+/**
+ * Call the numeric split with a precomputed sorted order if the split type
+ * has a SplitIfBetter() overload that accepts one (as BestBinaryNumericSplit
+ * does), and fall back to the plain overload---which re-sorts internally---for
+ * split types that do not.  The first argument exists only for overload
+ * resolution: passing 0 prefers the sorted-order version when it is
+ * well-formed.
+ */
+template<bool UseWeights,
+         typename SplitType,
+         typename VecType,
+         typename LabelsType,
+         typename WeightVecType,
+         typename AuxType>
+auto SplitIfBetterWithOrder(
+    int /* sortedOrderPreferred */,
+    const double bestGain,
+    const VecType& data,
+    const arma::uvec& sortedOrder,
+    const LabelsType& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::Col<typename VecType::elem_type>& classProbabilities,
+    AuxType& aux)
+    -> decltype(SplitType::template SplitIfBetter<UseWeights>(bestGain, data,
+        sortedOrder, labels, numClasses, weights, minimumLeafSize,
+        minimumGainSplit, classProbabilities, aux))
+{
+  return SplitType::template SplitIfBetter<UseWeights>(bestGain, data,
+      sortedOrder, labels, numClasses, weights, minimumLeafSize,
+      minimumGainSplit, classProbabilities, aux);
+}
+
+/**
+ * Fallback for numeric split types without a sorted-order overload of
+ * SplitIfBetter(); the precomputed order is ignored.
+ */
+template<bool UseWeights,
+         typename SplitType,
+         typename VecType,
+         typename LabelsType,
+         typename WeightVecType,
+         typename AuxType>
+double SplitIfBetterWithOrder(
+    long /* sortedOrderPreferred */,
+    const double bestGain,
+    const VecType& data,
+    const arma::uvec& /* sortedOrder */,
+    const LabelsType& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::Col<typename VecType::elem_type>& classProbabilities,
+    AuxType& aux)
+{
+  return SplitType::template SplitIfBetter<UseWeights>(bestGain, data, labels,
+      numClasses, weights, minimumLeafSize, minimumGainSplit,
+      classProbabilities, aux);
+}
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "presorted_index_impl.hpp"
+
+#endif
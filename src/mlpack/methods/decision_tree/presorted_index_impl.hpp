@@ -0,0 +1,100 @@
+/**
+ * @file methods/decision_tree/presorted_index_impl.hpp
+ *
+ * Implementation of the PresortedIndex class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_PRESORTED_INDEX_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_PRESORTED_INDEX_IMPL_HPP
+
+namespace mlpack {
+namespace tree {
+
+template<typename MatType>
+void PresortedIndex::Build(const MatType& data)
+{
+  numPoints = data.n_cols;
+  ranks.clear();
+  ranks.resize(data.n_rows);
+
+  // Each dimension is sorted independently, so the sorts can run in parallel.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_rows; ++i)
+  {
+    const arma::uvec sortedOrder = arma::sort_index(data.row(i));
+    ranks[i].set_size(numPoints);
+    for (size_t j = 0; j < numPoints; ++j)
+      ranks[i][sortedOrder[j]] = j;
+  }
+}
+
+template<typename MatType>
+void PresortedIndex::Build(const MatType& data,
+                           const data::DatasetInfo& datasetInfo)
+{
+  numPoints = data.n_cols;
+  ranks.clear();
+  ranks.resize(data.n_rows);
+
+  // Each dimension is sorted independently, so the sorts can run in parallel.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_rows; ++i)
+  {
+    // Ranks are only meaningful for numeric dimensions.
+    if (datasetInfo.Type(i) != data::Datatype::numeric)
+      continue;
+
+    const arma::uvec sortedOrder = arma::sort_index(data.row(i));
+    ranks[i].set_size(numPoints);
+    for (size_t j = 0; j < numPoints; ++j)
+      ranks[i][sortedOrder[j]] = j;
+  }
+}
+
+inline void PresortedIndex::SortSamples(const size_t dimension,
+                                        const arma::Row<size_t>& samples,
+                                        const size_t begin,
+                                        const size_t count,
+                                        arma::uvec& order) const
+{
+  const arma::uvec& dimRanks = ranks[dimension];
+  order.set_size(count);
+
+  if (count >= numPoints / 8)
+  {
+    // The subset is a sizable fraction of the dataset, so a counting sort
+    // over the global rank space is cheaper than any comparison sort.  Ranks
+    // are unique per point, but sample indices may be repeated, so we count
+    // occurrences per rank and then place each sample at its rank's offset.
+    std::vector<size_t> offsets(numPoints + 1, 0);
+    for (size_t j = 0; j < count; ++j)
+      ++offsets[dimRanks[samples[begin + j]] + 1];
+    for (size_t r = 1; r <= numPoints; ++r)
+      offsets[r] += offsets[r - 1];
+    for (size_t j = 0; j < count; ++j)
+      order[offsets[dimRanks[samples[begin + j]]]++] = j;
+  }
+  else
+  {
+    // Deep in the tree the counting pass would be dominated by its
+    // O(numPoints) initialization, so sort the gathered integer ranks
+    // instead; this avoids floating point comparisons and any access to the
+    // data itself.
+    for (size_t j = 0; j < count; ++j)
+      order[j] = j;
+    std::sort(order.begin(), order.end(),
+        [&](const arma::uword a, const arma::uword b)
+        {
+          return dimRanks[samples[begin + a]] < dimRanks[samples[begin + b]];
+        });
+  }
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -18,6 +18,71 @@
 namespace mlpack {
 namespace det /** Density Estimation Trees */ {
 
+/**
+ * A per-dimension presorted index used while growing a DTree.  Finding the
+ * best split of a node needs the node's values in every dimension in sorted
+ * order; sorting them from scratch at every node costs O(d n log n) per tree
+ * level.  This index sorts every dimension once, up front, and then maintains
+ * the sorted order across node splits: whenever a node's points are
+ * partitioned between its children, each dimension's sorted run is stably
+ * partitioned in linear time as well, so both children again hold their
+ * values in sorted order at their positions [start, end).
+ *
+ * The index holds dense copies of the sorted values, so it is only used for
+ * dense datasets.  It is built and consumed internally by DTree::Grow();
+ * there is no need to construct one directly.
+ */
+template<typename MatType>
+class PresortedSplits
+{
+ public:
+  //! The underlying element type of the indexed dataset.
+  typedef typename MatType::elem_type ElemType;
+
+  /**
+   * Sort every dimension of the dataset.  The identifier stored for each
+   * point is taken from the given old-from-new mapping, so that the mapping
+   * maintained during tree growth can be used to partition the index later.
+   *
+   * @param data Dataset the tree is grown on.
+   * @param oldFromNew Current mappings from new points to old points.
+   */
+  void Build(const MatType& data, const arma::Col<size_t>& oldFromNew);
+
+  //! Return true if Build() has been called.
+  bool Built() const { return sortedValues.n_elem > 0; }
+
+  /**
+   * Re-partition every dimension's sorted run [start, end) to match a node
+   * split: the points now at positions [start, splitIndex) of the data
+   * matrix form the left run and the others the right run, and both runs
+   * stay sorted.  Concurrent calls are safe as long as they concern disjoint
+   * position ranges, which is the case for the nodes of any one tree.
+   *
+   * @param start First position of the node that was split.
+   * @param splitIndex First position of the right child.
+   * @param end One past the last position of the node that was split.
+   * @param oldFromNew Current mappings from new points to old points.
+   */
+  void Partition(const size_t start,
+                 const size_t splitIndex,
+                 const size_t end,
+                 const arma::Col<size_t>& oldFromNew);
+
+  //! Return a pointer to the sorted values of the given dimension; the run
+  //! of a node covering [start, end) is at offsets [start, end) of it.
+  const ElemType* Values(const size_t dim) const
+  { return sortedValues.colptr(dim); }
+
+ private:
+  //! Sorted values of the dataset; one column per dimension.
+  arma::Mat<ElemType> sortedValues;
+  //! Old-from-new point identifiers aligned with sortedValues.
+  arma::umat sortedIds;
+  //! Scratch: which side of the split being applied each point fell on.
+  std::vector<char> leftSide;
+};
+
 /**
  * A density estimation tree is similar to both a decision tree and a space
  * partitioning tree (like a kd-tree).  Each leaf represents a constant-density
@@ -182,6 +247,20 @@ class DTree
    */
   double ComputeValue(const VecType& query) const;
 
+  /**
+   * Compute the density estimate of every column of the given query matrix.
+   * This is much faster than calling the single-point ComputeValue() in a
+   * loop: instead of one root-to-leaf descent per point, the query indices
+   * are partitioned down the tree in contiguous blocks, so each node is
+   * visited once per block instead of once per point, and the subtrees are
+   * processed in parallel with OpenMP (if enabled).
+   *
+   * @param queries Matrix of query points (one point per column).
+   * @param densities Vector to store the density estimate of each query point
+   *      in.
+   */
+  void ComputeValue(const MatType& queries, arma::rowvec& densities) const;
+
   /**
    * Index the buckets for possible usage later; this results in every leaf in
    * the tree having a specific tag (accessible with BucketTag()).  This
@@ -335,6 +414,23 @@ class DTree
  private:
   // Utility methods.
 
+  //! Grows of nodes smaller than this stay on the spawning thread instead of
+  //! becoming OpenMP tasks.
+  static const size_t parallelGrowCutoff = 8192;
+
+  /**
+   * The recursive part of Grow().  When the presorted index has been built,
+   * splits are found from its sorted runs and the index is re-partitioned at
+   * every split; otherwise each node sorts its own values, as before.  Large
+   * subtrees are grown as OpenMP tasks.
+   */
+  double Grow(MatType& data,
+              arma::Col<size_t>& oldFromNew,
+              const bool useVolReg,
+              const size_t maxLeafSize,
+              const size_t minLeafSize,
+              PresortedSplits<MatType>& presorted);
+
   /**
    * Find the dimension to split on.
    */
@@ -345,6 +441,20 @@ class DTree
                  double& rightError,
                  const size_t minLeafSize = 5) const;
 
+  /**
+   * Find the dimension to split on, reading each dimension's values of this
+   * node from the sorted runs of the presorted index instead of sorting
+   * them.  The total number of points must be passed since the data matrix
+   * itself is not.
+   */
+  bool FindSplit(const PresortedSplits<MatType>& presorted,
+                 const size_t totalPoints,
+                 size_t& splitDim,
+                 ElemType& splitValue,
+                 double& leftError,
+                 double& rightError,
+                 const size_t minLeafSize) const;
+
   /**
    * Split the data, returning the number of points left of the split.
    */
@@ -355,6 +465,21 @@ class DTree
 
   void  FillMinMax(const StatType& mins,
                    const StatType& maxs);
+
+  /**
+   * Compute the density estimates of a contiguous block of query indices,
+   * partitioning the block between the two children at each node.  This is
+   * the recursive part of the batched ComputeValue().
+   *
+   * @param queries Matrix of query points (one point per column).
+   * @param indices Pointer to the first query index of the block.
+   * @param count Number of query indices in the block.
+   * @param densities Vector to store the density estimates in.
+   */
+  void ComputeValue(const MatType& queries,
+                    size_t* indices,
+                    const size_t count,
+                    arma::rowvec& densities) const;
 };
 
 } // namespace det
@@ -12,7 +12,10 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include "dtree.hpp"
+#include <mlpack/core/util/threads.hpp>
+#include <algorithm>
 #include <stack>
+#include <tuple>
 #include <vector>
 
 using namespace mlpack;
@@ -147,8 +150,115 @@ void ExtractSplits(std::vector<std::pair<ElemType, size_t>>& splitVec,
   }
 }
 
+/**
+ * This one scans an already-sorted run of values, as maintained by the
+ * presorted index, and puts all splits in a vector; no per-node sorting is
+ * needed.
+ */
+template<typename ElemType>
+void ExtractSplitsPresorted(
+    std::vector<std::pair<ElemType, size_t>>& splitVec,
+    const ElemType* dimVec,
+    const size_t length,
+    const size_t minLeafSize)
+{
+  typedef std::pair<ElemType, size_t> SplitItem;
+
+  // Ensure the minimum leaf size on both sides, as in ExtractSplits().
+  for (size_t i = minLeafSize - 1; i < length - minLeafSize; ++i)
+  {
+    const ElemType split = (dimVec[i] + dimVec[i + 1]) / 2.0;
+
+    // Check if we can split here (two points are different)
+    if (split != dimVec[i])
+      splitVec.push_back(SplitItem(split, i + 1));
+  }
+}
+
 } // namespace details
 
+template<typename MatType>
+void PresortedSplits<MatType>::Build(const MatType& data,
+                                     const arma::Col<size_t>& oldFromNew)
+{
+  // One column per dimension, so that each dimension's run is contiguous.
+  sortedValues.set_size(data.n_cols, data.n_rows);
+  sortedIds.set_size(data.n_cols, data.n_rows);
+  leftSide.resize(data.n_cols);
+
+  // The dimensions are sorted independently of each other.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t dim = 0; dim < (omp_size_t) data.n_rows; ++dim)
+  {
+    // Element-wise extraction, so that this compiles for any matrix type
+    // (even though only dense datasets ever build the index).
+    arma::Row<ElemType> dimVec(data.n_cols);
+    for (size_t j = 0; j < data.n_cols; ++j)
+      dimVec[j] = data(dim, j);
+
+    const arma::uvec order = arma::sort_index(dimVec);
+
+    ElemType* vals = sortedValues.colptr(dim);
+    arma::uword* ids = sortedIds.colptr(dim);
+    for (size_t i = 0; i < order.n_elem; ++i)
+    {
+      vals[i] = dimVec[order[i]];
+      ids[i] = oldFromNew[order[i]];
+    }
+  }
+}
+
+template<typename MatType>
+void PresortedSplits<MatType>::Partition(const size_t start,
+                                         const size_t splitIndex,
+                                         const size_t end,
+                                         const arma::Col<size_t>& oldFromNew)
+{
+  // Record which side each of the node's points ended up on.  The points of
+  // a node are disjoint from those of any concurrently-split node, so these
+  // writes need no synchronization.
+  for (size_t pos = start; pos < end; ++pos)
+    leftSide[oldFromNew[pos]] = (pos < splitIndex) ? 1 : 0;
+
+  std::vector<arma::uword> rightIds;
+  std::vector<ElemType> rightVals;
+  rightIds.reserve(end - splitIndex);
+  rightVals.reserve(end - splitIndex);
+
+  for (size_t dim = 0; dim < sortedValues.n_cols; ++dim)
+  {
+    ElemType* vals = sortedValues.colptr(dim);
+    arma::uword* ids = sortedIds.colptr(dim);
+
+    // Stably partition the run: compact the left child's entries in place
+    // and stash the right child's, preserving the sorted order of both.
+    rightIds.clear();
+    rightVals.clear();
+    size_t out = start;
+    for (size_t pos = start; pos < end; ++pos)
+    {
+      if (leftSide[ids[pos]])
+      {
+        ids[out] = ids[pos];
+        vals[out] = vals[pos];
+        ++out;
+      }
+      else
+      {
+        rightIds.push_back(ids[pos]);
+        rightVals.push_back(vals[pos]);
+      }
+    }
+
+    // Copy the right child's entries back after the left child's.
+    for (size_t k = 0; k < rightIds.size(); ++k)
+    {
+      ids[out + k] = rightIds[k];
+      vals[out + k] = rightVals[k];
+    }
+  }
+}
+
 template<typename MatType, typename TagType>
 DTree<MatType, TagType>::DTree() :
     start(0),
@@ -551,6 +661,117 @@ bool DTree<MatType, TagType>::FindSplit(const MatType& data,
   return splitFound;
 }
 
+// The same search as above, except that the values of this node in each
+// dimension are read from the sorted runs of the presorted index, so no
+// sorting happens here at all.
+template<typename MatType, typename TagType>
+bool DTree<MatType, TagType>::FindSplit(
+    const PresortedSplits<MatType>& presorted,
+    const size_t totalPoints,
+    size_t& splitDim,
+    ElemType& splitValue,
+    double& leftError,
+    double& rightError,
+    const size_t minLeafSize) const
+{
+  typedef std::pair<ElemType, size_t> SplitItem;
+
+  const size_t points = end - start;
+
+  double minError = logNegError;
+  bool splitFound = false;
+
+  // Loop through each dimension.
+#ifdef _WIN32
+  #pragma omp parallel for default(shared)
+  for (intmax_t dim = 0; dim < (intmax_t) maxVals.n_elem; ++dim)
+#else
+  #pragma omp parallel for default(shared)
+  for (size_t dim = 0; dim < maxVals.n_elem; ++dim)
+#endif
+  {
+    const ElemType min = minVals[dim];
+    const ElemType max = maxVals[dim];
+
+    // If there is nothing to split in this dimension, move on.
+    if (max - min == 0.0)
+      continue; // Skip to next dimension.
+
+    // Find the log volume of all the other dimensions.
+    const double volumeWithoutDim = logVolume - std::log(max - min);
+
+    // Initializing all other stuff for this dimension.
+    bool dimSplitFound = false;
+    // Take an error estimate for this dimension.
+    double minDimError = std::pow(points, 2.0) / (max - min);
+    double dimLeftError = 0.0; // For -Wuninitialized.  These variables will
+    double dimRightError = 0.0; // always be set to something else before use.
+    ElemType dimSplitValue = 0.0;
+
+    // This node's values of this dimension are already in sorted order at
+    // offsets [start, end) of the presorted run.
+    std::vector<SplitItem> splitVec;
+    details::ExtractSplitsPresorted<ElemType>(splitVec,
+        presorted.Values(dim) + start, points, minLeafSize);
+
+    // Iterate on all the splits for this dimension
+    for (typename std::vector<SplitItem>::iterator i = splitVec.begin();
+         i != splitVec.end();
+         ++i)
+    {
+      const ElemType split = i->first;
+      const size_t position = i->second;
+
+      if ((split - min > 0.0) && (max - split > 0.0))
+      {
+        // Ensure that the right node will have at least the minimum number of
+        // points.
+        Log::Assert((points - position) >= minLeafSize);
+
+        // Now we have to see if the error will be reduced.  Simple manipulation
+        // of the error function gives us the condition we must satisfy:
+        //   |t_l|^2 / V_l + |t_r|^2 / V_r  >= |t|^2 / (V_l + V_r)
+        // and because the volume is only dependent on the dimension we are
+        // splitting, we can assume V_l is just the range of the left and V_r is
+        // just the range of the right.
+        double negLeftError = std::pow(position, 2.0) / (split - min);
+        double negRightError = std::pow(points - position, 2.0) / (max - split);
+
+        // If this is better, take it.
+        if ((negLeftError + negRightError) >= minDimError)
+        {
+          minDimError = negLeftError + negRightError;
+          dimLeftError = negLeftError;
+          dimRightError = negRightError;
+          dimSplitValue = split;
+          dimSplitFound = true;
+        }
+      }
+    }
+
+    const double actualMinDimError = std::log(minDimError)
+      - 2 * std::log((double) totalPoints)
+      - volumeWithoutDim;
+
+#pragma omp critical(DTreeFindUpdate)
+    if ((actualMinDimError > minError) && dimSplitFound)
+    {
+      // Calculate actual error (in logspace) by adding terms back to our
+      // estimate.
+      minError = actualMinDimError;
+      splitDim = dim;
+      splitValue = dimSplitValue;
+      leftError = std::log(dimLeftError) - 2 * std::log((double) totalPoints)
+        - volumeWithoutDim;
+      rightError = std::log(dimRightError) - 2 * std::log((double) totalPoints)
+        - volumeWithoutDim;
+      splitFound = true;
+    } // end if better split found in this dimension.
+  }
+
+  return splitFound;
+}
+
 template<typename MatType, typename TagType>
 size_t DTree<MatType, TagType>::SplitData(MatType& data,
                                           const size_t splitDim,
@@ -592,6 +813,37 @@ double DTree<MatType, TagType>::Grow(MatType& data,
                                      const bool useVolReg,
                                      const size_t maxLeafSize,
                                      const size_t minLeafSize)
+{
+  // Build the presorted per-dimension index, so that no node has to sort its
+  // values while searching for its best split.  The index stores dense
+  // copies of every dimension, so sparse datasets keep the sparsity-aware
+  // extraction in FindSplit() instead; and it can only be built when growth
+  // starts at the root, since it covers whole rows of the data matrix.
+  PresortedSplits<MatType> presorted;
+  if (root && std::is_same<MatType, arma::Mat<ElemType>>::value &&
+      ((size_t) (end - start) > maxLeafSize))
+    presorted.Build(data, oldFromNew);
+
+  // The recursive grow spawns tasks for large subtrees, which the thread
+  // team created here executes; for small datasets the region stays inactive
+  // and the growth proceeds exactly as the serial one.
+  double result;
+  #pragma omp parallel if (end - start >= 2 * parallelGrowCutoff)
+  #pragma omp single
+  result = Grow(data, oldFromNew, useVolReg, maxLeafSize, minLeafSize,
+      presorted);
+
+  return result;
+}
+
+// The recursive part of the greedy expansion.
+template<typename MatType, typename TagType>
+double DTree<MatType, TagType>::Grow(MatType& data,
+                                     arma::Col<size_t>& oldFromNew,
+                                     const bool useVolReg,
+                                     const size_t maxLeafSize,
+                                     const size_t minLeafSize,
+                                     PresortedSplits<MatType>& presorted)
 {
   Log::Assert(data.n_rows == maxVals.n_elem);
   Log::Assert(data.n_rows == minVals.n_elem);
@@ -614,12 +866,29 @@ double DTree<MatType, TagType>::Grow(MatType& data,
     size_t dim;
     double splitValueTmp;
     double leftError, rightError;
-    if (FindSplit(data, dim, splitValueTmp, leftError, rightError, minLeafSize))
+    bool splitFound;
+    if (presorted.Built())
+    {
+      splitFound = FindSplit(presorted, data.n_cols, dim, splitValueTmp,
+          leftError, rightError, minLeafSize);
+    }
+    else
+    {
+      splitFound = FindSplit(data, dim, splitValueTmp, leftError, rightError,
+          minLeafSize);
+    }
+
+    if (splitFound)
     {
       // Move the data around for the children to have points in a node lie
       // contiguously (to increase efficiency during the training).
       const size_t splitIndex = SplitData(data, dim, splitValueTmp, oldFromNew);
 
+      // Keep every dimension's sorted run consistent with the new point
+      // order.
+      if (presorted.Built())
+        presorted.Partition(start, splitIndex, end, oldFromNew);
+
       // Make max and min vals for the children.
       StatType maxValsL(maxVals);
       StatType maxValsR(maxVals);
@@ -633,14 +902,23 @@ double DTree<MatType, TagType>::Grow(MatType& data,
       splitValue = splitValueTmp;
       splitDim = dim;
 
-      // Recursively grow the children.
+      // Recursively grow the children.  They cover disjoint ranges of the
+      // data matrix and of the presorted index, so during a parallel grow
+      // large subtrees are processed as independent tasks; outside of a
+      // parallel region (or below the cutoff) the tasks execute immediately
+      // on this thread and the growth proceeds exactly as the serial one.
       left = new DTree(maxValsL, minValsL, start, splitIndex, leftError);
       right = new DTree(maxValsR, minValsR, splitIndex, end, rightError);
 
+      #pragma omp task default(shared) \
+          if (end - start >= 2 * parallelGrowCutoff)
       leftG = left->Grow(data, oldFromNew, useVolReg, maxLeafSize,
-                         minLeafSize);
+                         minLeafSize, presorted);
+
       rightG = right->Grow(data, oldFromNew, useVolReg, maxLeafSize,
-                           minLeafSize);
+                           minLeafSize, presorted);
+
+      #pragma omp taskwait
 
       // Store values of R(T~) and |T~|.
       subtreeLeaves = left->SubtreeLeaves() + right->SubtreeLeaves();
@@ -889,6 +1167,122 @@ double DTree<MatType, TagType>::ComputeValue(const VecType& query) const
   return 0.0;
 }
 
+template<typename MatType, typename TagType>
+void DTree<MatType, TagType>::ComputeValue(const MatType& queries,
+                                           arma::rowvec& densities) const
+{
+  Log::Assert(queries.n_rows == maxVals.n_elem);
+
+  densities.set_size(queries.n_cols);
+
+  // Queries outside the root's bounding box have zero density; collect the
+  // indices of all the others, which will be partitioned down the tree.  Note
+  // that element access is used instead of WithinRange() so that this also
+  // works for sparse query matrices.
+  std::vector<size_t> indices;
+  indices.reserve(queries.n_cols);
+  for (size_t i = 0; i < queries.n_cols; ++i)
+  {
+    bool within = true;
+    for (size_t d = 0; d < maxVals.n_elem; ++d)
+    {
+      const ElemType value = queries(d, i);
+      if ((value < minVals[d]) || (value > maxVals[d]))
+      {
+        within = false;
+        break;
+      }
+    }
+
+    if (within)
+      indices.push_back(i);
+    else
+      densities[i] = 0.0;
+  }
+
+  // Expand the first few levels of the tree breadth-first, splitting the
+  // block of query indices at each node, until there are enough blocks to
+  // keep every thread busy; then each block's subtree is independent of the
+  // others and can be processed in parallel.
+  size_t targetBlocks = 1;
+  if (Threads() > 1)
+    targetBlocks = 4 * Threads();
+
+  // Each block is a (node, block start, block size) triple.
+  typedef std::tuple<const DTree*, size_t, size_t> BlockType;
+  std::vector<BlockType> blocks, childBlocks;
+  blocks.push_back(BlockType(this, 0, indices.size()));
+  while (blocks.size() < targetBlocks)
+  {
+    bool expanded = false;
+    childBlocks.clear();
+    for (size_t b = 0; b < blocks.size(); ++b)
+    {
+      const DTree* node = std::get<0>(blocks[b]);
+      const size_t begin = std::get<1>(blocks[b]);
+      const size_t count = std::get<2>(blocks[b]);
+      if ((node->subtreeLeaves == 1) || (count == 0))
+      {
+        childBlocks.push_back(blocks[b]);
+        continue;
+      }
+
+      // Partition the block between the two children of this node.
+      size_t* const first = indices.data() + begin;
+      size_t* const mid = std::partition(first, first + count,
+          [&](const size_t i)
+          { return queries(node->splitDim, i) <= node->splitValue; });
+      const size_t leftCount = (size_t) (mid - first);
+
+      childBlocks.push_back(BlockType(node->left, begin, leftCount));
+      childBlocks.push_back(BlockType(node->right, begin + leftCount,
+          count - leftCount));
+      expanded = true;
+    }
+
+    blocks.swap(childBlocks);
+
+    // Stop if every block has already reached a leaf.
+    if (!expanded)
+      break;
+  }
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t b = 0; b < (omp_size_t) blocks.size(); ++b)
+  {
+    std::get<0>(blocks[b])->ComputeValue(queries,
+        indices.data() + std::get<1>(blocks[b]), std::get<2>(blocks[b]),
+        densities);
+  }
+}
+
+template<typename MatType, typename TagType>
+void DTree<MatType, TagType>::ComputeValue(const MatType& queries,
+                                           size_t* indices,
+                                           const size_t count,
+                                           arma::rowvec& densities) const
+{
+  if (count == 0)
+    return;
+
+  if (subtreeLeaves == 1) // If we are a leaf...
+  {
+    const double density = std::exp(std::log(ratio) - logVolume);
+    for (size_t i = 0; i < count; ++i)
+      densities[indices[i]] = density;
+    return;
+  }
+
+  // Partition the block of query indices by the split value, so that each
+  // child sees a contiguous block.
+  size_t* const mid = std::partition(indices, indices + count,
+      [&](const size_t i) { return queries(splitDim, i) <= splitValue; });
+  const size_t leftCount = (size_t) (mid - indices);
+
+  left->ComputeValue(queries, indices, leftCount, densities);
+  right->ComputeValue(queries, mid, count - leftCount, densities);
+}
+
 // Index the buckets for possible usage later.
 template<typename MatType, typename TagType>
 TagType DTree<MatType, TagType>::TagTree(const TagType& tag, bool every)
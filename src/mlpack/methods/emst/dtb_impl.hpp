@@ -130,10 +130,43 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeMST(
   {
     if (naive)
     {
-      // Full O(N^2) traversal.
+      // Fully compress the union-find before the sweep, so that Find() calls
+      // made inside the parallel region below only read the parent array:
+      // after this pass every tree has depth at most one, and path halving
+      // has nothing left to write.
       for (size_t i = 0; i < data.n_cols; ++i)
-        for (size_t j = 0; j < data.n_cols; ++j)
-          rules.BaseCase(i, j);
+        connections.Find(i);
+
+      // Full O(N^2) sweep.  Threads own disjoint blocks of query points and
+      // accumulate candidate edges into their own arrays; the per-component
+      // minima are merged below.
+      #pragma omp parallel
+      {
+        arma::vec localDistances(data.n_cols);
+        localDistances.fill(DBL_MAX);
+        arma::Col<size_t> localInComponent(data.n_cols);
+        arma::Col<size_t> localOutComponent(data.n_cols);
+        RuleType localRules(data, connections, localDistances,
+            localInComponent, localOutComponent, metric);
+
+        #pragma omp for schedule(static) nowait
+        for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+          for (size_t j = 0; j < data.n_cols; ++j)
+            localRules.BaseCase(i, j);
+
+        #pragma omp critical
+        {
+          for (size_t c = 0; c < data.n_cols; ++c)
+          {
+            if (localDistances[c] < neighborsDistances[c])
+            {
+              neighborsDistances[c] = localDistances[c];
+              neighborsInComponent[c] = localInComponent[c];
+              neighborsOutComponent[c] = localOutComponent[c];
+            }
+          }
+        }
+      }
     }
     else
     {
@@ -55,16 +55,16 @@ class UnionFind
    */
   size_t Find(const size_t x)
   {
-    if (parent[x] == x)
+    // Walk up to the root, halving the path as we go: pointing every other
+    // node at its grandparent keeps the trees shallow without a second pass
+    // or recursion, so the walk touches the flat parent array sequentially.
+    size_t cur = x;
+    while (parent[cur] != cur)
     {
-      return x;
-    }
-    else
-    {
-      // This ensures that the tree has a small depth.
-      parent[x] = Find(parent[x]);
-      return parent[x];
+      parent[cur] = parent[parent[cur]];
+      cur = parent[cur];
     }
+    return cur;
   }
 
   /**
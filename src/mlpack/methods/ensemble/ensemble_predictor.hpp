@@ -0,0 +1,141 @@
+/**
+ * @file methods/ensemble/ensemble_predictor.hpp
+ *
+ * An inference scheduler for ensembles of heterogeneous trained models.  All
+ * registered models are evaluated over shared input blocks tile-by-tile, so
+ * each tile of query points is read from memory once and stays in cache while
+ * every model processes it, instead of each model streaming the whole query
+ * set from RAM in its own pass.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ENSEMBLE_ENSEMBLE_PREDICTOR_HPP
+#define MLPACK_METHODS_ENSEMBLE_ENSEMBLE_PREDICTOR_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <functional>
+
+namespace mlpack {
+namespace ensemble /** Ensemble inference. */ {
+
+/**
+ * An inference scheduler for an ensemble of trained classifiers.  Models of
+ * any type may be registered, as long as they can produce class predictions
+ * for a batch of points; models with the standard
+ * `Classify(data, predictions)` interface (such as RandomForest,
+ * LogisticRegression, or SoftmaxRegression) can be added directly, and any
+ * other model can be added through a custom invocation functor.
+ *
+ * At prediction time, the query set is processed in blocks of columns.  Each
+ * block is evaluated by every model before the next block is touched, so the
+ * block is read from main memory once and served to the remaining models from
+ * cache.  Models are evaluated in parallel over each block when OpenMP is
+ * enabled.  The registered models are held by reference and must outlive this
+ * object.
+ *
+ * A typical usage might look like:
+ *
+ * @code
+ * EnsemblePredictor ensemble;
+ * ensemble.Add(randomForest);
+ * ensemble.Add(logisticRegression);
+ *
+ * arma::Row<size_t> predictions;
+ * ensemble.Classify(data, 3, predictions); // Majority vote over 3 classes.
+ * @endcode
+ */
+class EnsemblePredictor
+{
+ public:
+  //! The type of a model invocation: fill predictions for a block of points.
+  typedef std::function<void(const arma::mat&, arma::Row<size_t>&)>
+      ClassifyFunction;
+
+  /**
+   * Create an empty ensemble.
+   *
+   * @param blockSize Number of query points evaluated per tile.  The tile
+   *      should fit in L2 cache: blockSize * dimensionality * 8 bytes.
+   */
+  EnsemblePredictor(const size_t blockSize = 1024);
+
+  /**
+   * Register a trained model with the standard batch classification
+   * interface `model.Classify(data, predictions)`.  The model is held by
+   * reference and must outlive this object.
+   *
+   * @param model Trained model to register.
+   */
+  template<typename ModelType>
+  void Add(ModelType& model);
+
+  /**
+   * Register a model through a custom invocation functor, for model types
+   * whose prediction interface does not match
+   * `Classify(data, predictions)`---for instance an FFN, whose Predict()
+   * returns per-class scores:
+   *
+   * @code
+   * ensemble.Add([&ffn](const arma::mat& block, arma::Row<size_t>& preds)
+   *     {
+   *       arma::mat scores;
+   *       ffn.Predict(block, scores);
+   *       preds = arma::conv_to<arma::Row<size_t>>::from(
+   *           arma::index_max(scores, 0));
+   *     });
+   * @endcode
+   *
+   * @param classify Functor that fills predictions for a block of points.
+   */
+  void Add(ClassifyFunction classify);
+
+  /**
+   * Evaluate every registered model on the given query set, tile-by-tile.
+   * predictions[m] holds the predictions of the m'th registered model.
+   *
+   * @param data Query points to classify.
+   * @param predictions Per-model predictions for each query point.
+   */
+  void Classify(const arma::mat& data,
+                std::vector<arma::Row<size_t>>& predictions) const;
+
+  /**
+   * Evaluate every registered model on the given query set, tile-by-tile, and
+   * combine the per-model predictions into one prediction per point by
+   * majority vote (ties broken towards the smaller class label).
+   *
+   * @param data Query points to classify.
+   * @param numClasses Number of classes in the classification task.
+   * @param predictions Combined predictions for each query point.
+   */
+  void Classify(const arma::mat& data,
+                const size_t numClasses,
+                arma::Row<size_t>& predictions) const;
+
+  //! Get the number of registered models.
+  size_t NumModels() const { return classifiers.size(); }
+
+  //! Get the number of query points evaluated per tile.
+  size_t BlockSize() const { return blockSize; }
+  //! Modify the number of query points evaluated per tile.
+  size_t& BlockSize() { return blockSize; }
+
+ private:
+  //! Invocations for each registered model.
+  std::vector<ClassifyFunction> classifiers;
+
+  //! The number of query points evaluated per tile.
+  size_t blockSize;
+};
+
+} // namespace ensemble
+} // namespace mlpack
+
+// Include implementation.
+#include "ensemble_predictor_impl.hpp"
+
+#endif
@@ -0,0 +1,99 @@
+/**
+ * @file methods/ensemble/ensemble_predictor_impl.hpp
+ *
+ * Implementation of the EnsemblePredictor class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ENSEMBLE_ENSEMBLE_PREDICTOR_IMPL_HPP
+#define MLPACK_METHODS_ENSEMBLE_ENSEMBLE_PREDICTOR_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "ensemble_predictor.hpp"
+
+namespace mlpack {
+namespace ensemble {
+
+inline EnsemblePredictor::EnsemblePredictor(const size_t blockSize) :
+    blockSize(blockSize)
+{
+  if (blockSize == 0)
+    throw std::invalid_argument("EnsemblePredictor::EnsemblePredictor(): "
+        "blockSize must be greater than 0!");
+}
+
+template<typename ModelType>
+void EnsemblePredictor::Add(ModelType& model)
+{
+  classifiers.push_back(
+      [&model](const arma::mat& block, arma::Row<size_t>& predictions)
+      {
+        model.Classify(block, predictions);
+      });
+}
+
+inline void EnsemblePredictor::Add(ClassifyFunction classify)
+{
+  classifiers.push_back(std::move(classify));
+}
+
+inline void EnsemblePredictor::Classify(
+    const arma::mat& data,
+    std::vector<arma::Row<size_t>>& predictions) const
+{
+  if (classifiers.empty())
+    throw std::runtime_error("EnsemblePredictor::Classify(): no models have "
+        "been registered!  Call Add() first.");
+
+  predictions.resize(classifiers.size());
+  for (size_t m = 0; m < classifiers.size(); ++m)
+    predictions[m].set_size(data.n_cols);
+
+  // Evaluate every model on one tile of query points before moving to the
+  // next tile, so the tile is read from main memory once and stays in cache
+  // for the remaining models.
+  for (size_t begin = 0; begin < data.n_cols; begin += blockSize)
+  {
+    const size_t end = std::min(begin + blockSize - 1,
+        (size_t) data.n_cols - 1);
+    const arma::mat block(data.cols(begin, end));
+
+    // Run the models over the shared tile in parallel; dynamic scheduling
+    // balances models with very different per-point costs.
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t m = 0; m < (omp_size_t) classifiers.size(); ++m)
+    {
+      arma::Row<size_t> blockPredictions;
+      classifiers[m](block, blockPredictions);
+      predictions[m].subvec(begin, end) = blockPredictions;
+    }
+  }
+}
+
+inline void EnsemblePredictor::Classify(const arma::mat& data,
+                                        const size_t numClasses,
+                                        arma::Row<size_t>& predictions) const
+{
+  std::vector<arma::Row<size_t>> modelPredictions;
+  Classify(data, modelPredictions);
+
+  // Majority vote over the models, breaking ties towards the smaller label.
+  predictions.set_size(data.n_cols);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+  {
+    arma::Col<size_t> votes(numClasses, arma::fill::zeros);
+    for (size_t m = 0; m < modelPredictions.size(); ++m)
+      ++votes[modelPredictions[m][i]];
+
+    predictions[i] = (size_t) votes.index_max();
+  }
+}
+
+} // namespace ensemble
+} // namespace mlpack
+
+#endif
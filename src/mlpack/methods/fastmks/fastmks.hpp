@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_FASTMKS_FASTMKS_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/kernel_traits.hpp>
 #include <mlpack/core/metrics/ip_metric.hpp>
 #include "fastmks_stat.hpp"
 #include <mlpack/core/tree/cover_tree.hpp>
@@ -320,6 +321,33 @@ class FastMKS
   //! The instantiated inner-product metric induced by the given kernel.
   metric::IPMetric<KernelType> metric;
 
+  /**
+   * Perform naive search using blocked matrix products, if the kernel is a
+   * function of the dot product of its arguments alone (see
+   * KernelTraits::IsDotProductExpressible).  Returns true if the search was
+   * performed this way; otherwise the caller must fall back to pairwise
+   * Evaluate() calls.
+   */
+  template<typename KT>
+  typename std::enable_if<
+      kernel::KernelTraits<KT>::IsDotProductExpressible, bool>::type
+  NaiveDotProductSearch(const MatType& querySet,
+                        const size_t k,
+                        arma::Mat<size_t>& indices,
+                        arma::mat& kernels);
+
+  /**
+   * Overload for kernels that are not expressible as a function of the dot
+   * product; this does no work and returns false.
+   */
+  template<typename KT>
+  typename std::enable_if<
+      !kernel::KernelTraits<KT>::IsDotProductExpressible, bool>::type
+  NaiveDotProductSearch(const MatType& querySet,
+                        const size_t k,
+                        arma::Mat<size_t>& indices,
+                        arma::mat& kernels);
+
   //! Candidate represents a possible candidate point (value, index).
   typedef std::pair<double, size_t> Candidate;
 
@@ -18,6 +18,8 @@
 #include "fastmks_rules.hpp"
 
 #include <mlpack/core/kernels/gaussian_kernel.hpp>
+#include <mlpack/core/kernels/linear_kernel.hpp>
+#include <mlpack/core/math/pairwise_distances.hpp>
 
 namespace mlpack {
 namespace fastmks {
@@ -389,6 +391,78 @@ void FastMKS<KernelType, MatType, TreeType>::Train(Tree* tree)
   this->treeOwner = true;
 }
 
+template<typename KernelType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename KT>
+typename std::enable_if<
+    kernel::KernelTraits<KT>::IsDotProductExpressible, bool>::type
+FastMKS<KernelType, MatType, TreeType>::NaiveDotProductSearch(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& indices,
+    arma::mat& kernels)
+{
+  // Process query blocks so that only one block of the full evaluation matrix
+  // is ever held in memory.
+  const size_t blockSize = 1024;
+  for (size_t begin = 0; begin < querySet.n_cols; begin += blockSize)
+  {
+    const size_t end = std::min(begin + blockSize, (size_t) querySet.n_cols);
+
+    arma::Mat<typename MatType::elem_type> evals;
+    math::PairwiseInnerProducts(*referenceSet, querySet.cols(begin, end - 1),
+        evals);
+
+    #pragma omp parallel for
+    for (omp_size_t q = 0; q < (omp_size_t) (end - begin); ++q)
+    {
+      const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
+      std::vector<Candidate> cList(k, def);
+      CandidateList pqueue(CandidateCmp(), std::move(cList));
+
+      for (size_t r = 0; r < referenceSet->n_cols; ++r)
+      {
+        const double eval = metric.Kernel().ApplyToDotProduct(evals(r, q));
+        if (eval > pqueue.top().first)
+        {
+          Candidate c = std::make_pair(eval, r);
+          pqueue.pop();
+          pqueue.push(c);
+        }
+      }
+
+      for (size_t j = 1; j <= k; ++j)
+      {
+        indices(k - j, begin + q) = pqueue.top().second;
+        kernels(k - j, begin + q) = pqueue.top().first;
+        pqueue.pop();
+      }
+    }
+  }
+
+  return true;
+}
+
+template<typename KernelType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename KT>
+typename std::enable_if<
+    !kernel::KernelTraits<KT>::IsDotProductExpressible, bool>::type
+FastMKS<KernelType, MatType, TreeType>::NaiveDotProductSearch(
+    const MatType& /* querySet */,
+    const size_t /* k */,
+    arma::Mat<size_t>& /* indices */,
+    arma::mat& /* kernels */)
+{
+  return false;
+}
+
 template<typename KernelType,
          typename MatType,
          template<typename TreeMetricType,
@@ -426,6 +500,16 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   // Naive implementation.
   if (naive)
   {
+    // If the kernel is a function of the dot product of its arguments alone
+    // (e.g. the linear or polynomial kernel), all pairwise evaluations can be
+    // computed with blocked matrix products followed by an elementwise
+    // transformation.
+    if (NaiveDotProductSearch<KernelType>(querySet, k, indices, kernels))
+    {
+      Timer::Stop("computing_products");
+      return;
+    }
+
     // Simple double loop.  Stupid, slow, but a good benchmark.
     for (size_t q = 0; q < querySet.n_cols; ++q)
     {
@@ -0,0 +1,181 @@
+/**
+ * @file methods/gmm/component_pruning_index.cpp
+ *
+ * Implementation of the ComponentPruningIndex class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "component_pruning_index.hpp"
+
+#include <mlpack/core/math/log_add.hpp>
+
+namespace mlpack {
+namespace gmm {
+
+ComponentPruningIndex::ComponentPruningIndex(const GMM& gmm,
+                                             const size_t maxLeafSize) :
+    gmm(gmm),
+    tree(ComponentMeans(gmm), oldFromNew, maxLeafSize)
+{
+  // Precompute the per-component bound terms, in the rearranged order of the
+  // tree: the peak log-density of a Gaussian (its density at its own mean,
+  // weighted by the prior) and the largest eigenvalue of its covariance.
+  const size_t gaussians = gmm.Gaussians();
+  logPeaks.set_size(gaussians);
+  maxEigenvalues.set_size(gaussians);
+  for (size_t i = 0; i < gaussians; ++i)
+  {
+    const distribution::GaussianDistribution& d =
+        gmm.Component(oldFromNew[i]);
+    logPeaks[i] = std::log(gmm.Weights()[oldFromNew[i]]) +
+        d.LogProbability(d.Mean());
+
+    arma::vec eigenvalues;
+    if (!arma::eig_sym(eigenvalues, d.Covariance()))
+    {
+      Log::Fatal << "ComponentPruningIndex: eigendecomposition of the "
+          << "covariance of component " << oldFromNew[i] << " failed!"
+          << std::endl;
+    }
+    maxEigenvalues[i] = eigenvalues.max();
+  }
+
+  AggregateBounds(tree);
+}
+
+arma::mat ComponentPruningIndex::ComponentMeans(const GMM& gmm)
+{
+  if (gmm.Gaussians() == 0)
+  {
+    throw std::invalid_argument("ComponentPruningIndex: cannot build an "
+        "index over a model with no components");
+  }
+
+  arma::mat means(gmm.Dimensionality(), gmm.Gaussians());
+  for (size_t i = 0; i < gmm.Gaussians(); ++i)
+    means.col(i) = gmm.Component(i).Mean();
+  return means;
+}
+
+ComponentPruningIndex::NodeBound ComponentPruningIndex::AggregateBounds(
+    const TreeType& node)
+{
+  NodeBound bound;
+  bound.maxLogPeak = -std::numeric_limits<double>::infinity();
+  bound.maxEigenvalue = 0.0;
+
+  if (node.NumChildren() == 0)
+  {
+    for (size_t i = 0; i < node.NumPoints(); ++i)
+    {
+      bound.maxLogPeak = std::max(bound.maxLogPeak, logPeaks[node.Point(i)]);
+      bound.maxEigenvalue = std::max(bound.maxEigenvalue,
+          maxEigenvalues[node.Point(i)]);
+    }
+  }
+  else
+  {
+    for (size_t c = 0; c < node.NumChildren(); ++c)
+    {
+      const NodeBound childBound = AggregateBounds(node.Child(c));
+      bound.maxLogPeak = std::max(bound.maxLogPeak, childBound.maxLogPeak);
+      bound.maxEigenvalue = std::max(bound.maxEigenvalue,
+          childBound.maxEigenvalue);
+    }
+  }
+
+  nodeBounds[&node] = bound;
+  return bound;
+}
+
+void ComponentPruningIndex::ScoreNode(const TreeType& node,
+                                      const arma::vec& observation,
+                                      const double logEpsilon,
+                                      double& logSum) const
+{
+  const NodeBound& bound = nodeBounds.at(&node);
+
+  // The Mahalanobis distance of the observation to any component inside the
+  // node is at least the minimum Euclidean distance to the node's ball,
+  // scaled by the largest covariance eigenvalue; multiplying the resulting
+  // density bound by the number of components inside bounds the node's total
+  // contribution.
+  const double minDist = node.Bound().MinDistance(observation);
+  double upperBound = bound.maxLogPeak +
+      std::log((double) node.NumDescendants());
+  if (minDist > 0.0)
+    upperBound -= 0.5 * minDist * minDist / bound.maxEigenvalue;
+
+  if (upperBound < logSum + logEpsilon)
+    return; // The node cannot meaningfully contribute.
+
+  if (node.NumChildren() == 0)
+  {
+    for (size_t i = 0; i < node.NumPoints(); ++i)
+    {
+      logSum = math::LogAdd(logSum,
+          gmm.LogProbability(observation, oldFromNew[node.Point(i)]));
+    }
+  }
+  else
+  {
+    // Visit the nearer child first: the faster the running sum grows, the
+    // more of the remaining tree can be pruned.
+    const double leftDist = node.Child(0).Bound().MinDistance(observation);
+    const double rightDist = node.Child(1).Bound().MinDistance(observation);
+    const size_t first = (leftDist <= rightDist) ? 0 : 1;
+
+    ScoreNode(node.Child(first), observation, logEpsilon, logSum);
+    ScoreNode(node.Child(1 - first), observation, logEpsilon, logSum);
+  }
+}
+
+double ComponentPruningIndex::LogProbability(
+    const arma::vec& observation,
+    const double relativeEpsilon) const
+{
+  if (relativeEpsilon < 0.0 || relativeEpsilon >= 1.0)
+  {
+    throw std::invalid_argument("ComponentPruningIndex::LogProbability(): "
+        "relativeEpsilon must be in the range [0, 1)");
+  }
+
+  const double logEpsilon = (relativeEpsilon == 0.0) ?
+      -std::numeric_limits<double>::infinity() : std::log(relativeEpsilon);
+
+  double logSum = -std::numeric_limits<double>::infinity();
+  ScoreNode(tree, observation, logEpsilon, logSum);
+  return logSum;
+}
+
+double ComponentPruningIndex::Probability(const arma::vec& observation,
+                                          const double relativeEpsilon) const
+{
+  return exp(LogProbability(observation, relativeEpsilon));
+}
+
+void ComponentPruningIndex::LogProbability(const arma::mat& observations,
+                                           arma::vec& logProbs,
+                                           const double relativeEpsilon) const
+{
+  logProbs.set_size(observations.n_cols);
+
+  // Each observation only reads the index, so the queries run in parallel.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) observations.n_cols; ++i)
+    logProbs(i) = LogProbability(observations.unsafe_col(i), relativeEpsilon);
+}
+
+void ComponentPruningIndex::Probability(const arma::mat& observations,
+                                        arma::vec& probs,
+                                        const double relativeEpsilon) const
+{
+  LogProbability(observations, probs, relativeEpsilon);
+  probs = arma::exp(probs);
+}
+
+} // namespace gmm
+} // namespace mlpack
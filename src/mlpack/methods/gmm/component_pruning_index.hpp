@@ -0,0 +1,153 @@
+/**
+ * @file methods/gmm/component_pruning_index.hpp
+ *
+ * A component-pruning index for fast (log-)probability evaluation of GMMs
+ * with many components, as used for one-class novelty scoring.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GMM_COMPONENT_PRUNING_INDEX_HPP
+#define MLPACK_METHODS_GMM_COMPONENT_PRUNING_INDEX_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/tree/binary_space_tree.hpp>
+
+#include "gmm.hpp"
+
+#include <unordered_map>
+
+namespace mlpack {
+namespace gmm {
+
+/**
+ * GMM::Probability() evaluates every component for every observation, but
+ * with many components the density of a point is almost entirely determined
+ * by its few nearest components.  This index builds a small ball tree over
+ * the component means and, for each query, visits the components nearest
+ * first while carrying a running log-sum; a subtree is skipped as soon as an
+ * upper bound on the total density of its components falls below the running
+ * sum times the given relative epsilon.
+ *
+ * The bound uses the peak density of each component together with the
+ * largest eigenvalue of its covariance: since the Mahalanobis distance is at
+ * least the Euclidean distance scaled by the largest eigenvalue, the minimum
+ * Euclidean distance to a tree node's ball bound yields an upper bound on
+ * the log-density of every component inside the node.
+ *
+ * Every pruned subtree contributes at most a relativeEpsilon fraction of the
+ * returned density, so the result carries a relative error of roughly the
+ * number of prunes times relativeEpsilon; an epsilon of 0 disables pruning
+ * and reproduces GMM::LogProbability() exactly.
+ *
+ * The index holds a reference to the model and caches per-component bound
+ * terms at construction time, so it must be rebuilt if the model is modified
+ * or retrained.
+ */
+class ComponentPruningIndex
+{
+ public:
+  /**
+   * Build the index over the components of the given (trained) model.
+   *
+   * @param gmm Model to build the index for.
+   * @param maxLeafSize Maximum number of component means per tree leaf.
+   */
+  ComponentPruningIndex(const GMM& gmm, const size_t maxLeafSize = 8);
+
+  /**
+   * Return the log-probability of the given observation under the model,
+   * skipping components that cannot contribute more than the given relative
+   * epsilon of the running density sum.
+   *
+   * @param observation Observation to evaluate.
+   * @param relativeEpsilon Pruning threshold, in [0, 1); 0 disables pruning.
+   */
+  double LogProbability(const arma::vec& observation,
+                        const double relativeEpsilon = 1e-10) const;
+
+  /**
+   * Return the probability of the given observation under the model,
+   * skipping components that cannot contribute more than the given relative
+   * epsilon of the running density sum.
+   *
+   * @param observation Observation to evaluate.
+   * @param relativeEpsilon Pruning threshold, in [0, 1); 0 disables pruning.
+   */
+  double Probability(const arma::vec& observation,
+                     const double relativeEpsilon = 1e-10) const;
+
+  /**
+   * Compute the log-probability of each of the given observations; the
+   * observations are evaluated in parallel.
+   *
+   * @param observations Observations to evaluate (one per column).
+   * @param logProbs Vector to store the log-probabilities into.
+   * @param relativeEpsilon Pruning threshold, in [0, 1); 0 disables pruning.
+   */
+  void LogProbability(const arma::mat& observations,
+                      arma::vec& logProbs,
+                      const double relativeEpsilon = 1e-10) const;
+
+  /**
+   * Compute the probability of each of the given observations; the
+   * observations are evaluated in parallel.
+   *
+   * @param observations Observations to evaluate (one per column).
+   * @param probs Vector to store the probabilities into.
+   * @param relativeEpsilon Pruning threshold, in [0, 1); 0 disables pruning.
+   */
+  void Probability(const arma::mat& observations,
+                   arma::vec& probs,
+                   const double relativeEpsilon = 1e-10) const;
+
+ private:
+  //! Type of the tree built over the component means.
+  typedef tree::BallTree<metric::EuclideanDistance, tree::EmptyStatistic,
+      arma::mat> TreeType;
+
+  //! Precomputed bound terms of a tree node.
+  struct NodeBound
+  {
+    //! Largest peak log-density (including prior) of any component inside.
+    double maxLogPeak;
+    //! Largest covariance eigenvalue of any component inside.
+    double maxEigenvalue;
+  };
+
+  //! Gather the component means into a matrix (one mean per column).
+  static arma::mat ComponentMeans(const GMM& gmm);
+
+  //! Recursively precompute the bound terms of every tree node.
+  NodeBound AggregateBounds(const TreeType& node);
+
+  /**
+   * Accumulate the contributions of the components of the given node into
+   * the running log-sum, skipping subtrees whose bounded total contribution
+   * is below the running sum plus logEpsilon (in log space).
+   */
+  void ScoreNode(const TreeType& node,
+                 const arma::vec& observation,
+                 const double logEpsilon,
+                 double& logSum) const;
+
+  //! The model this index was built for.
+  const GMM& gmm;
+  //! Mapping from tree point indices to component indices.
+  std::vector<size_t> oldFromNew;
+  //! Ball tree over the component means.
+  TreeType tree;
+  //! Peak log-density (including prior) of each component, in tree order.
+  arma::vec logPeaks;
+  //! Largest covariance eigenvalue of each component, in tree order.
+  arma::vec maxEigenvalues;
+  //! Precomputed bound terms of every tree node.
+  std::unordered_map<const TreeType*, NodeBound> nodeBounds;
+}; // class ComponentPruningIndex
+
+} // namespace gmm
+} // namespace mlpack
+
+#endif
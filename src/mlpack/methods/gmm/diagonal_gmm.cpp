@@ -75,6 +75,38 @@ double DiagonalGMM::Probability(const arma::vec& observation) const
   return exp(LogProbability(observation));
 }
 
+/**
+ * Return the log probability of each of the given observations being from this
+ * GMM.
+ */
+void DiagonalGMM::LogProbability(const arma::mat& observations,
+                                 arma::vec& logProbs) const
+{
+  // Compute log-probabilities of each observation under each Gaussian
+  // component, weighted by the component prior, and sum over the components
+  // in log space.
+  arma::mat componentLogProbs(gaussians, observations.n_cols);
+  arma::vec logPhis;
+  for (size_t i = 0; i < gaussians; ++i)
+  {
+    dists[i].LogProbability(observations, logPhis);
+    componentLogProbs.row(i) = log(weights[i]) + trans(logPhis);
+  }
+
+  math::LogSumExpCols(componentLogProbs, logProbs);
+}
+
+/**
+ * Return the probability of each of the given observations being from this
+ * GMM.
+ */
+void DiagonalGMM::Probability(const arma::mat& observations,
+                              arma::vec& probs) const
+{
+  LogProbability(observations, probs);
+  probs = exp(probs);
+}
+
 /**
  * Return the log probability of the given observation being from the given
  * component in the mixture.
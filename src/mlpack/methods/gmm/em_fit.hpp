@@ -15,6 +15,7 @@
 #define MLPACK_METHODS_GMM_EM_FIT_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/compensated_accumulator.hpp>
 #include <mlpack/core/dists/gaussian_distribution.hpp>
 #include <mlpack/core/dists/diagonal_gaussian_distribution.hpp>
 
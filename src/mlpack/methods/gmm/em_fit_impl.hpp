@@ -87,8 +87,12 @@ Estimate(const arma::mat& observations,
         << "log-likelihood " << l << "." << std::endl;
 
     // Calculate the conditional probabilities of choosing a particular
-    // Gaussian given the observations and the present theta value.
-    for (size_t i = 0; i < dists.size(); ++i)
+    // Gaussian given the observations and the present theta value.  Each
+    // component evaluates its log-probability against the whole block of
+    // observations at once and writes a disjoint column, so the components
+    // can be computed in parallel.
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
     {
       // Store conditional log probabilities into condLogProb vector for each
       // Gaussian.  First we make an alias of the condLogProb vector.
@@ -97,8 +101,9 @@ Estimate(const arma::mat& observations,
       condLogProbAlias += log(weights[i]);
     }
 
-    // Normalize row-wise.
-    for (size_t i = 0; i < condLogProb.n_rows; ++i)
+    // Normalize row-wise.  Every row is independent of the others.
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) condLogProb.n_rows; ++i)
     {
       // Avoid dividing by zero; if the probability for everything is 0, we
       // don't want to make it NaN.
@@ -109,14 +114,19 @@ Estimate(const arma::mat& observations,
 
     // Store the sum of the probability of each state over all the observations.
     arma::vec probRowSums(dists.size());
-    for (size_t i = 0; i < dists.size(); ++i)
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
     {
       probRowSums(i) = mlpack::math::AccuLog(condLogProb.col(i));
     }
 
     // Calculate the new value of the means using the updated conditional
-    // probabilities.
-    for (size_t i = 0; i < dists.size(); ++i)
+    // probabilities.  The sufficient statistics of each component (weighted
+    // mean and covariance) only involve its own responsibility column and its
+    // own distribution object, so the components are updated in parallel;
+    // dynamic scheduling smooths out the unevenly-sized updates.
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
     {
       // Don't update if there's no probability of the Gaussian having points.
       if (probRowSums[i] != -std::numeric_limits<double>::infinity())
@@ -192,8 +202,11 @@ Estimate(const arma::mat& observations,
   while (std::abs(l - lOld) > tolerance && iteration != maxIterations)
   {
     // Calculate the conditional probabilities of choosing a particular
-    // Gaussian given the observations and the present theta value.
-    for (size_t i = 0; i < dists.size(); ++i)
+    // Gaussian given the observations and the present theta value.  Each
+    // component writes a disjoint column, so the components can be computed
+    // in parallel.
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
     {
       // Store conditional log probabilities into condLogProb vector for each
       // Gaussian.  First we make an alias of the condLogProb vector.
@@ -202,8 +215,9 @@ Estimate(const arma::mat& observations,
       condLogProbAlias += log(weights[i]);
     }
 
-    // Normalize row-wise.
-    for (size_t i = 0; i < condLogProb.n_rows; ++i)
+    // Normalize row-wise.  Every row is independent of the others.
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) condLogProb.n_rows; ++i)
     {
       // Avoid dividing by zero; if the probability for everything is 0, we
       // don't want to make it NaN.
@@ -217,9 +231,13 @@ Estimate(const arma::mat& observations,
     arma::vec probRowSums(dists.size());
 
     // Calculate the new value of the means using the updated conditional
-    // probabilities.
+    // probabilities.  Each iteration touches only its own column of
+    // condLogProb, its own entry of probRowSums, and its own distribution, so
+    // the components are updated in parallel; dynamic scheduling smooths out
+    // the unevenly-sized updates.
     arma::vec logProbabilities = arma::log(probabilities);
-    for (size_t i = 0; i < dists.size(); ++i)
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
     {
       // Calculate the sum of probabilities of points, which is the
       // conditional probability of each point being from Gaussian i
@@ -302,8 +320,9 @@ InitialClustering(const arma::mat& observations,
   std::vector<arma::vec> means(dists.size());
 
   // Conditional covariance instantiation.
-  std::vector<typename std::conditional<isDiagGaussDist,
-      arma::vec, arma::mat>::type> covs(dists.size());
+  typedef typename std::conditional<isDiagGaussDist,
+      arma::vec, arma::mat>::type CovType;
+  std::vector<CovType> covs(dists.size());
 
   // Now calculate the means, covariances, and weights.
   weights.zeros();
@@ -321,19 +340,32 @@ InitialClustering(const arma::mat& observations,
     }
   }
 
+  // The per-cluster sums below have one term per observation, so accumulate
+  // them with compensated summation to keep the rounding error of the long
+  // reductions bounded.
+  std::vector<math::CompensatedSum<arma::vec>> meanSums;
+  std::vector<math::CompensatedSum<CovType>> covSums;
+  meanSums.reserve(dists.size());
+  covSums.reserve(dists.size());
+  for (size_t i = 0; i < dists.size(); ++i)
+  {
+    meanSums.emplace_back(means[i]);
+    covSums.emplace_back(covs[i]);
+  }
+
   // From the assignments, generate our means, covariances, and weights.
   for (size_t i = 0; i < observations.n_cols; ++i)
   {
     const size_t cluster = assignments[i];
 
     // Add this to the relevant mean.
-    means[cluster] += observations.col(i);
+    meanSums[cluster].Add(observations.col(i));
 
     // Add this to the relevant covariance.
     if (isDiagGaussDist)
-      covs[cluster] += observations.col(i) % observations.col(i);
+      covSums[cluster].Add(observations.col(i) % observations.col(i));
     else
-      covs[cluster] += observations.col(i) * trans(observations.col(i));
+      covSums[cluster].Add(observations.col(i) * trans(observations.col(i)));
 
     // Now add one to the weights (we will normalize).
     weights[cluster]++;
@@ -342,6 +374,7 @@ InitialClustering(const arma::mat& observations,
   // Now normalize the mean and covariance.
   for (size_t i = 0; i < dists.size(); ++i)
   {
+    meanSums[i].Flush();
     means[i] /= (weights[i] > 1) ? weights[i] : 1;
   }
 
@@ -350,13 +383,14 @@ InitialClustering(const arma::mat& observations,
     const size_t cluster = assignments[i];
     const arma::vec normObs = observations.col(i) - means[cluster];
     if (isDiagGaussDist)
-      covs[cluster] += normObs % normObs;
+      covSums[cluster].Add(normObs % normObs);
     else
-      covs[cluster] += normObs * normObs.t();
+      covSums[cluster].Add(normObs * normObs.t());
   }
 
   for (size_t i = 0; i < dists.size(); ++i)
   {
+    covSums[i].Flush();
     covs[i] /= (weights[i] > 1) ? weights[i] : 1;
 
     // Apply constraints to covariance matrix.
@@ -381,30 +415,34 @@ LogLikelihood(const arma::mat& observations,
               const std::vector<Distribution>& dists,
               const arma::vec& weights) const
 {
-  double logLikelihood = 0;
+  // The log-likelihood has one term per observation, so accumulate it with
+  // compensated summation.
+  math::CompensatedAccumulator<> logLikelihood;
 
-  arma::vec logPhis;
   arma::mat logLikelihoods(dists.size(), observations.n_cols);
 
   // It has to be LogProbability() otherwise Probability() would overflow easily
-  for (size_t i = 0; i < dists.size(); ++i)
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
   {
+    arma::vec logPhis;
     dists[i].LogProbability(observations, logPhis);
     logLikelihoods.row(i) = log(weights(i)) + trans(logPhis);
   }
   // Now sum over every point.
   for (size_t j = 0; j < observations.n_cols; ++j)
   {
-    if (mlpack::math::AccuLog(logLikelihoods.col(j)) ==
-        -std::numeric_limits<double>::infinity())
+    const double pointLogLikelihood =
+        mlpack::math::AccuLog(logLikelihoods.col(j));
+    if (pointLogLikelihood == -std::numeric_limits<double>::infinity())
     {
       Log::Info << "Likelihood of point " << j << " is 0!  It is probably an "
           << "outlier." << std::endl;
     }
-    logLikelihood += mlpack::math::AccuLog(logLikelihoods.col(j));
+    logLikelihood.Add(pointLogLikelihood);
   }
 
-  return logLikelihood;
+  return logLikelihood.Value();
 }
 
 template<typename InitialClusteringType,
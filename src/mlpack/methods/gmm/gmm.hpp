@@ -172,6 +172,25 @@ class GMM
    */
   double LogProbability(const arma::vec& observation) const;
 
+  /**
+   * Return the log probability of each of the given observations (one
+   * observation per column) being from this GMM.
+   *
+   * @param observations Matrix of observations to compute probabilities of.
+   * @param logProbs Vector to store one log probability per observation in.
+   */
+  void LogProbability(const arma::mat& observations,
+                      arma::vec& logProbs) const;
+
+  /**
+   * Return the probability of each of the given observations (one observation
+   * per column) being from this GMM.
+   *
+   * @param observations Matrix of observations to compute probabilities of.
+   * @param probs Vector to store one probability per observation in.
+   */
+  void Probability(const arma::mat& observations, arma::vec& probs) const;
+
   /**
    * Return the probability that the given observation came from the given
    * Gaussian component in this distribution.
@@ -20,6 +20,102 @@
 namespace mlpack {
 namespace hmm /** Hidden Markov Models. */ {
 
+/**
+ * A reusable workspace for Viterbi decoding with HMM::Predict().  Decoding a
+ * sequence needs several scratch matrices whose sizes depend only on the
+ * number of states and the sequence length; allocating them on every call is
+ * wasteful when many sequences are decoded with the same model.  A
+ * caller-owned ViterbiWorkspace passed to Predict() has its buffers grown as
+ * needed and reused across calls, so decoding performs no allocations once
+ * the buffers have reached the size of the longest sequence seen.
+ *
+ * The workspace holds no model state and may be reused across models, but a
+ * single workspace must not be used from multiple threads at once.
+ */
+class ViterbiWorkspace
+{
+ public:
+  //! Log-probabilities of being in each state at each time step.
+  arma::mat logStateProb;
+  //! Backpointers to the best previous state at each time step.
+  arma::umat stateSeqBack;
+  //! Transposed log-transition matrix, so the max-plus update runs down
+  //! columns.
+  arma::mat logTransitionT;
+  //! Max-plus scores of each previous state (rows) for each current state
+  //! (columns) at the current time step.
+  arma::mat scores;
+  //! Best previous state for each current state at the current time step.
+  arma::urowvec bestPrev;
+  //! Log-probabilities of the current observation under each state's emission
+  //! distribution.
+  arma::vec emissionLogProb;
+  //! States inside the beam at the current time step, when beam pruning is
+  //! enabled (see HMM::BeamWidth()).
+  arma::uvec beamActive;
+
+  /**
+   * Ensure the buffers can hold a decode of the given size.  Buffers are only
+   * grown, never shrunk, so that decoding sequences of varying lengths does
+   * not reallocate.  Called by Predict(); there is no need to call this
+   * directly.
+   *
+   * @param states Number of hidden states of the model.
+   * @param length Length of the sequence to be decoded.
+   */
+  void Resize(const size_t states, const size_t length)
+  {
+    if (logStateProb.n_rows != states || logStateProb.n_cols < length)
+    {
+      const size_t cols = std::max(length, logStateProb.n_cols);
+      logStateProb.set_size(states, cols);
+      stateSeqBack.set_size(states, cols);
+    }
+
+    if (logTransitionT.n_rows != states)
+    {
+      logTransitionT.set_size(states, states);
+      scores.set_size(states, states);
+      bestPrev.set_size(states);
+      emissionLogProb.set_size(states);
+      beamActive.set_size(states);
+    }
+  }
+};
+
+/**
+ * Streaming forward-filtering state for HMM::ExtendForward().  When a
+ * sequence grows one observation at a time (live time-series scoring),
+ * re-running the full forward pass costs O(T * states^2) per new sample.  A
+ * ForwardState instead carries the normalized forward variables and the
+ * accumulated log-likelihood of the observations consumed so far, so that
+ * each new observation is absorbed with a single O(states^2) recursion step.
+ *
+ * A default-constructed (or Reset()) state represents an empty sequence.  One
+ * state tracks one stream; keep a separate state per stream, and do not use a
+ * single state from multiple threads at once.
+ */
+class ForwardState
+{
+ public:
+  //! Create a state representing an empty sequence.
+  ForwardState() : logLikelihood(0.0), time(0) { }
+
+  //! Normalized log forward probabilities P(X_t | o_{1:t}) of each state.
+  arma::vec logForwardProb;
+  //! Log-likelihood of the observations consumed so far.
+  double logLikelihood;
+  //! Number of observations consumed so far.
+  size_t time;
+
+  //! Reset the state so that a new sequence can be scored.
+  void Reset()
+  {
+    logLikelihood = 0.0;
+    time = 0;
+  }
+};
+
 /**
  * A class that represents a Hidden Markov Model with an arbitrary type of
  * emission distribution.  This HMM class supports training (supervised and
@@ -168,6 +264,39 @@ class HMM
    */
   double Train(const std::vector<arma::mat>& dataSeq);
 
+  /**
+   * Train the model using minibatch (stepwise online) EM with only the given
+   * unlabeled observations.  Instead of accumulating sufficient statistics
+   * over the whole dataset before every parameter update, this overload
+   * updates the model after each minibatch of sequences: the expected
+   * initial-state, transition, and emission statistics of the minibatch are
+   * interpolated into running averages with a decaying step size
+   * (1 / (k + 2)^stepSizeExponent for the k'th update), and the parameters
+   * are re-estimated from those averages.  For large sequence collections
+   * this typically needs far fewer passes over the data than full-batch
+   * Baum-Welch, since early minibatches already move the parameters.  The
+   * sequences within each minibatch are processed in parallel, and the
+   * sequence order is reshuffled every epoch.
+   *
+   * A batchSize of zero, or one at least as large as the number of sequences,
+   * falls back to the full-batch Train() overload.  The step size exponent
+   * should lie in (0.5, 1]; smaller values take more aggressive steps.
+   *
+   * Convergence is checked once per epoch against Tolerance(), using the sum
+   * of the minibatch log-likelihoods of that epoch.  Because the parameters
+   * change between minibatches, this sum is only an approximation of the
+   * dataset log-likelihood under the final parameters, and the same caveat
+   * applies to the returned value.
+   *
+   * @param dataSeq Vector of observation sequences.
+   * @param batchSize Number of sequences in each minibatch.
+   * @param stepSizeExponent Decay exponent of the stepwise EM step size.
+   * @return Approximate log-likelihood of the data over the last epoch.
+   */
+  double Train(const std::vector<arma::mat>& dataSeq,
+               const size_t batchSize,
+               const double stepSizeExponent = 0.6);
+
   /**
    * Train the model using the given labeled observations; the transition and
    * emission matrices are directly estimated.  Each matrix in the vector of
@@ -282,6 +411,24 @@ class HMM
   double Predict(const arma::mat& dataSeq,
                  arma::Row<size_t>& stateSeq) const;
 
+  /**
+   * Compute the most probable hidden state sequence for the given data
+   * sequence, using the Viterbi algorithm, returning the log-likelihood of the
+   * most likely state sequence.  This overload keeps its scratch matrices in
+   * the given caller-owned workspace, so repeated decodes reuse the same
+   * memory instead of allocating on every call.
+   *
+   * @param dataSeq Sequence of observations.
+   * @param stateSeq Vector in which the most probable state sequence will be
+   *    stored.
+   * @param workspace Workspace whose buffers will be used for scratch space;
+   *    they are grown as needed and reused on subsequent calls.
+   * @return Log-likelihood of most probable state sequence.
+   */
+  double Predict(const arma::mat& dataSeq,
+                 arma::Row<size_t>& stateSeq,
+                 ViterbiWorkspace& workspace) const;
+
   /**
    * Compute the log-likelihood of the given data sequence.
    *
@@ -290,6 +437,22 @@ class HMM
    */
   double LogLikelihood(const arma::mat& dataSeq) const;
 
+  /**
+   * Incrementally extend a streaming sequence by one observation.  This
+   * performs a single step of the scaled forward recursion on the given
+   * state, so absorbing a new observation costs O(states^2) regardless of how
+   * long the sequence already is; the state's forward probabilities and
+   * log-likelihood afterwards match what Forward() and LogLikelihood() would
+   * compute on the full sequence.  Pass a default-constructed (or Reset())
+   * ForwardState to start a new sequence.
+   *
+   * @param state Streaming state to extend; updated in place.
+   * @param observation The new observation to absorb.
+   * @return Log-likelihood of the whole sequence consumed so far.
+   */
+  double ExtendForward(ForwardState& state,
+                       const arma::vec& observation) const;
+
   /**
    * HMM filtering. Computes the k-step-ahead expected emission at each time
    * conditioned only on prior observations. That is
@@ -353,6 +516,22 @@ class HMM
   //! Modify the tolerance of the Baum-Welch algorithm.
   double& Tolerance() { return tolerance; }
 
+  //! Get the beam width used by Predict() and Filter() (0 means no pruning).
+  size_t BeamWidth() const { return beamWidth; }
+  /**
+   * Modify the beam width used by Predict() and Filter().  When nonzero,
+   * only the given number of highest-probability states are propagated to
+   * the next time step, so each step costs O(B * S) transition evaluations
+   * instead of O(S^2).  This makes decoding and filtering approximate: a
+   * path or probability mass passing through a pruned state is lost.  For
+   * models whose state posteriors are concentrated, even small beams
+   * recover the exact answer.  A width of zero (the default), or one at
+   * least as large as the number of states, disables pruning.  Training and
+   * likelihood computations are never pruned.  This setting is not
+   * serialized.
+   */
+  size_t& BeamWidth() { return beamWidth; }
+
   /**
    * Load the object.
    */
@@ -396,6 +575,21 @@ class HMM
                 const arma::vec& logScales,
                 arma::mat& backwardLogProb) const;
 
+  /**
+   * Beam-pruned version of the Forward algorithm, used by Filter() when
+   * BeamWidth() is nonzero.  At each time step only the BeamWidth()
+   * highest-probability states are propagated; the probability mass of the
+   * pruned states is dropped (and removed again by the per-step
+   * renormalization), so the result is approximate.
+   *
+   * @param dataSeq Data sequence to compute probabilities for.
+   * @param logScales Vector in which scaling factors will be saved.
+   * @param forwardLogProb Matrix in which forward probabilities will be saved.
+   */
+  void ForwardBeam(const arma::mat& dataSeq,
+                   arma::vec& logScales,
+                   arma::mat& forwardLogProb) const;
+
   //! Set of emission probability distributions; one for each state.
   std::vector<Distribution> emission;
 
@@ -431,6 +625,9 @@ class HMM
   //! Tolerance of Baum-Welch algorithm.
   double tolerance;
 
+  //! Beam width for pruned decoding and filtering; 0 disables pruning.
+  size_t beamWidth;
+
   /**
    * Whether or not we need to update the logInitial from initialProxy.
    * Should be removed in mlpack 4.0.
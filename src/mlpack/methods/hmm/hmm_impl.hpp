@@ -34,6 +34,7 @@ HMM<Distribution>::HMM(const size_t states,
     initialProxy(arma::randu<arma::vec>(states) / (double) states),
     dimensionality(emissions.Dimensionality()),
     tolerance(tolerance),
+    beamWidth(0),
     recalculateInitial(false),
     recalculateTransition(false)
 {
@@ -61,6 +62,7 @@ HMM<Distribution>::HMM(const arma::vec& initial,
     initialProxy(initial),
     logInitial(log(initial)),
     tolerance(tolerance),
+    beamWidth(0),
     recalculateInitial(false),
     recalculateTransition(false)
 {
@@ -133,53 +135,108 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
     // Reset log likelihood.
     loglik = 0;
 
-    // Sum over time.
-    size_t sumTime = 0;
+    // Precompute where each sequence's observations land in the emission
+    // list, so that the sequences can be processed in any order.
+    std::vector<size_t> seqOffsets(dataSeq.size(), 0);
+    for (size_t seq = 1; seq < dataSeq.size(); seq++)
+      seqOffsets[seq] = seqOffsets[seq - 1] + dataSeq[seq - 1].n_cols;
 
-    // Loop over each sequence.
-    for (size_t seq = 0; seq < dataSeq.size(); seq++)
-    {
-      arma::mat stateLogProb;
-      arma::mat forwardLog;
-      arma::mat backwardLog;
-      arma::vec logScales;
-
-      // Add the log-likelihood of this sequence.  This is the E-step.
-      loglik += LogEstimate(dataSeq[seq], stateLogProb, forwardLog,
-          backwardLog, logScales);
+    // Make sure the log-space parameters are up to date before the parallel
+    // region; Forward() would otherwise recompute them concurrently.
+    ConvertToLogSpace();
 
-      // Add to estimate of initial probability for state j.
-      for (size_t j = 0; j < logTransition.n_cols; ++j)
-        newLogInitial[j] = math::LogAdd(newLogInitial[j], stateLogProb(j, 0));
-
-      // Now re-estimate the parameters.  This is the M-step.
-      //   pi_i = sum_d ((1 / P(seq[d])) sum_t (f(i, 0) b(i, 0))
-      //   T_ij = sum_d ((1 / P(seq[d])) sum_t (f(i, t) T_ij E_i(seq[d][t]) b(i,
-      //           t + 1)))
-      //   E_ij = sum_d ((1 / P(seq[d])) sum_{t | seq[d][t] = j} f(i, t) b(i, t)
-      // We store the new estimates in a different matrix.
-      for (size_t t = 0; t < dataSeq[seq].n_cols; ++t)
+    // The sequences are independent given the current parameters, so they are
+    // processed in parallel; each thread accumulates into its own
+    // initial-state and transition estimates, which are merged at the end.
+    #pragma omp parallel
+    {
+      arma::vec threadLogInitial(logTransition.n_rows);
+      threadLogInitial.fill(-std::numeric_limits<double>::infinity());
+      arma::mat threadLogTransition(logTransition.n_rows,
+          logTransition.n_cols);
+      threadLogTransition.fill(-std::numeric_limits<double>::infinity());
+      double threadLoglik = 0;
+
+      // Loop over each sequence.
+      #pragma omp for schedule(dynamic) nowait
+      for (omp_size_t seq = 0; seq < (omp_size_t) dataSeq.size(); seq++)
       {
+        arma::mat stateLogProb;
+        arma::mat forwardLog;
+        arma::mat backwardLog;
+        arma::vec logScales;
+
+        // Add the log-likelihood of this sequence.  This is the E-step.
+        threadLoglik += LogEstimate(dataSeq[seq], stateLogProb, forwardLog,
+            backwardLog, logScales);
+
+        // Compute the emission log-probability of every observation under
+        // every state once, instead of once per transition pair below.
+        arma::mat emissionLogProb(logTransition.n_rows, dataSeq[seq].n_cols);
+        arma::vec stateEmissionLogProb;
+        for (size_t state = 0; state < logTransition.n_rows; state++)
+        {
+          emission[state].LogProbability(dataSeq[seq], stateEmissionLogProb);
+          emissionLogProb.row(state) = stateEmissionLogProb.t();
+        }
+
+        // Add to estimate of initial probability for state j.
         for (size_t j = 0; j < logTransition.n_cols; ++j)
         {
-          if (t < dataSeq[seq].n_cols - 1)
+          threadLogInitial[j] = math::LogAdd(threadLogInitial[j],
+              stateLogProb(j, 0));
+        }
+
+        // Now re-estimate the parameters.  This is the M-step.
+        //   pi_i = sum_d ((1 / P(seq[d])) sum_t (f(i, 0) b(i, 0))
+        //   T_ij = sum_d ((1 / P(seq[d])) sum_t (f(i, t) T_ij E_i(seq[d][t])
+        //           b(i, t + 1)))
+        //   E_ij = sum_d ((1 / P(seq[d])) sum_{t | seq[d][t] = j} f(i, t)
+        //           b(i, t)
+        // We store the new estimates in a different matrix.  The emission list
+        // slots of each sequence are disjoint, so those writes need no
+        // synchronization.
+        for (size_t t = 0; t < dataSeq[seq].n_cols; ++t)
+        {
+          const size_t sumTime = seqOffsets[seq] + t;
+          for (size_t j = 0; j < logTransition.n_cols; ++j)
           {
-            // Estimate of T_ij (probability of transition from state j to state
-            // i).  We postpone multiplication of the old T_ij until later.
-            for (size_t i = 0; i < logTransition.n_rows; ++i)
+            if (t < dataSeq[seq].n_cols - 1)
             {
-              newLogTransition(i, j) = math::LogAdd(newLogTransition(i, j),
-                  forwardLog(j, t) + backwardLog(i, t + 1) +
-                  emission[i].LogProbability(dataSeq[seq].unsafe_col(t + 1)) -
-                  logScales[t + 1]);
+              // Estimate of T_ij (probability of transition from state j to
+              // state i).  We postpone multiplication of the old T_ij until
+              // later.
+              for (size_t i = 0; i < logTransition.n_rows; ++i)
+              {
+                threadLogTransition(i, j) = math::LogAdd(
+                    threadLogTransition(i, j),
+                    forwardLog(j, t) + backwardLog(i, t + 1) +
+                    emissionLogProb(i, t + 1) - logScales[t + 1]);
+              }
             }
-          }
 
-          // Add to list of emission observations, for Distribution::Train().
+            // Add to list of emission observations, for
+            // Distribution::Train().
+            emissionProb[j][sumTime] = exp(stateLogProb(j, t));
+          }
           emissionList.col(sumTime) = dataSeq[seq].col(t);
-          emissionProb[j][sumTime] = exp(stateLogProb(j, t));
         }
-        sumTime++;
+      }
+
+      // Merge this thread's accumulators into the global estimates.
+      #pragma omp critical (HMMTrainMerge)
+      {
+        loglik += threadLoglik;
+        for (size_t j = 0; j < logTransition.n_cols; ++j)
+        {
+          newLogInitial[j] = math::LogAdd(newLogInitial[j],
+              threadLogInitial[j]);
+          for (size_t i = 0; i < logTransition.n_rows; ++i)
+          {
+            newLogTransition(i, j) = math::LogAdd(newLogTransition(i, j),
+                threadLogTransition(i, j));
+          }
+        }
       }
     }
 
@@ -225,6 +282,243 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
   return loglik;
 }
 
+/**
+ * Train the model using minibatch (stepwise online) EM with only the given
+ * unlabeled observations.  The parameters are updated after every minibatch
+ * of sequences instead of once per pass over the whole dataset.
+ */
+template<typename Distribution>
+double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq,
+                                const size_t batchSize,
+                                const double stepSizeExponent)
+{
+  // A minibatch covering the whole dataset is just ordinary Baum-Welch.
+  if (batchSize == 0 || batchSize >= dataSeq.size())
+    return Train(dataSeq);
+
+  double loglik = 0;
+  double oldLoglik = 0;
+
+  // Maximum passes over the data?
+  size_t epochs = 1000;
+
+  // Find length of all sequences and ensure they are the correct size.
+  size_t totalLength = 0;
+  for (size_t seq = 0; seq < dataSeq.size(); seq++)
+  {
+    totalLength += dataSeq[seq].n_cols;
+
+    if (dataSeq[seq].n_rows != dimensionality)
+      Log::Fatal << "HMM::Train(): data sequence " << seq << " has "
+          << "dimensionality " << dataSeq[seq].n_rows << " (expected "
+          << dimensionality << " dimensions)." << std::endl;
+  }
+
+  // Precompute where each sequence's observations land in the emission list.
+  std::vector<size_t> seqOffsets(dataSeq.size(), 0);
+  for (size_t seq = 1; seq < dataSeq.size(); seq++)
+    seqOffsets[seq] = seqOffsets[seq - 1] + dataSeq[seq - 1].n_cols;
+
+  // This is stepwise EM in the style of Liang and Klein, "Online EM for
+  // Unsupervised Models" (NAACL 2009): running averages of the sufficient
+  // statistics are interpolated towards each minibatch's statistics with a
+  // decaying step size, and the parameters are re-estimated from the
+  // averages after every minibatch.
+  //
+  // The initial-state and transition statistics are small and are held as
+  // averaged expected counts directly.  The emission statistics have to stay
+  // in the form Distribution::Train() accepts---a weighted observation
+  // list---so the interpolation is applied to the weights themselves: every
+  // update decays all stored weights by (1 - stepSize) and adds the fresh
+  // minibatch posteriors into the slots of the minibatch's sequences.  The
+  // emission M-step therefore still passes over all accumulated
+  // observations, but the forward-backward E-step---the dominant cost for
+  // models with many states---only touches the minibatch.
+  arma::vec initialStats(logTransition.n_rows, arma::fill::zeros);
+  arma::mat transitionStats(logTransition.n_rows, logTransition.n_cols,
+      arma::fill::zeros);
+  std::vector<arma::vec> emissionProb(logTransition.n_cols,
+      arma::vec(totalLength, arma::fill::zeros));
+  // Zero-initialized so that not-yet-visited slots contribute nothing to the
+  // weighted emission estimates (their weights are zero).
+  arma::mat emissionList(dimensionality, totalLength, arma::fill::zeros);
+
+  arma::uvec order = arma::linspace<arma::uvec>(0, dataSeq.size() - 1,
+      dataSeq.size());
+
+  size_t updates = 0;
+  for (size_t epoch = 0; epoch < epochs; epoch++)
+  {
+    // Visit the sequences in a different order on every pass.
+    order = arma::shuffle(order);
+
+    // Reset (approximate) log likelihood for this epoch.
+    loglik = 0;
+
+    for (size_t batchStart = 0; batchStart < dataSeq.size();
+         batchStart += batchSize)
+    {
+      const size_t batchEnd =
+          std::min(batchStart + batchSize, dataSeq.size()) - 1;
+
+      // Make sure the log-space parameters are up to date before the
+      // parallel region.
+      ConvertToLogSpace();
+
+      const double stepSize = std::pow((double) updates + 2.0,
+          -stepSizeExponent);
+
+      // Count the observations in this minibatch, so that its statistics can
+      // be averaged consistently with those of differently-sized batches.
+      size_t batchLength = 0;
+      for (size_t b = batchStart; b <= batchEnd; ++b)
+        batchLength += dataSeq[order[b]].n_cols;
+
+      // Decay the stored emission weights; the minibatch contributions are
+      // added on top of this inside the parallel region.
+      for (size_t j = 0; j < logTransition.n_cols; ++j)
+        emissionProb[j] *= (1.0 - stepSize);
+
+      // Fresh minibatch weights are scaled as if the minibatch were the
+      // whole dataset, so that they are commensurate with the accumulated
+      // full-data weights they are interpolated into.
+      const double emissionScale = stepSize *
+          ((double) totalLength / (double) batchLength);
+
+      arma::vec batchInitial(logTransition.n_rows, arma::fill::zeros);
+      arma::mat batchTransition(logTransition.n_rows, logTransition.n_cols,
+          arma::fill::zeros);
+      double batchLoglik = 0;
+
+      // The minibatch's sequences are independent given the current
+      // parameters, so they are processed in parallel, as in the full-batch
+      // overload.  The expected counts are accumulated in linear space here;
+      // every summand is a posterior probability, so there is no underflow
+      // risk in the sums.
+      #pragma omp parallel
+      {
+        arma::vec threadInitial(logTransition.n_rows, arma::fill::zeros);
+        arma::mat threadTransition(logTransition.n_rows,
+            logTransition.n_cols, arma::fill::zeros);
+        double threadLoglik = 0;
+
+        #pragma omp for schedule(dynamic) nowait
+        for (omp_size_t b = batchStart; b <= (omp_size_t) batchEnd; b++)
+        {
+          const size_t seq = order[b];
+
+          arma::mat stateLogProb;
+          arma::mat forwardLog;
+          arma::mat backwardLog;
+          arma::vec logScales;
+
+          // The E-step for this sequence.
+          threadLoglik += LogEstimate(dataSeq[seq], stateLogProb, forwardLog,
+              backwardLog, logScales);
+
+          // Compute the emission log-probability of every observation under
+          // every state once, instead of once per transition pair below.
+          arma::mat emissionLogProb(logTransition.n_rows,
+              dataSeq[seq].n_cols);
+          arma::vec stateEmissionLogProb;
+          for (size_t state = 0; state < logTransition.n_rows; state++)
+          {
+            emission[state].LogProbability(dataSeq[seq],
+                stateEmissionLogProb);
+            emissionLogProb.row(state) = stateEmissionLogProb.t();
+          }
+
+          threadInitial += exp(stateLogProb.col(0));
+
+          // Accumulate the expected transition counts and write the fresh
+          // emission posteriors into this sequence's slots of the emission
+          // list.  The slots of each sequence are disjoint, so those writes
+          // need no synchronization.
+          for (size_t t = 0; t < dataSeq[seq].n_cols; ++t)
+          {
+            const size_t sumTime = seqOffsets[seq] + t;
+            for (size_t j = 0; j < logTransition.n_cols; ++j)
+            {
+              if (t < dataSeq[seq].n_cols - 1)
+              {
+                // Unlike the full-batch overload, the running averages need
+                // the actual expected counts, so the multiplication by the
+                // old T_ij is not postponed.
+                for (size_t i = 0; i < logTransition.n_rows; ++i)
+                {
+                  threadTransition(i, j) += exp(forwardLog(j, t) +
+                      logTransition(i, j) + emissionLogProb(i, t + 1) +
+                      backwardLog(i, t + 1) - logScales[t + 1]);
+                }
+              }
+
+              emissionProb[j][sumTime] += emissionScale *
+                  exp(stateLogProb(j, t));
+            }
+            emissionList.col(sumTime) = dataSeq[seq].col(t);
+          }
+        }
+
+        // Merge this thread's accumulators into the minibatch statistics.
+        #pragma omp critical (HMMTrainMinibatchMerge)
+        {
+          batchLoglik += threadLoglik;
+          batchInitial += threadInitial;
+          batchTransition += threadTransition;
+        }
+      }
+
+      // Interpolate the running averages towards the minibatch statistics.
+      // Both are normalized to per-sequence (respectively per-observation)
+      // averages so that their scales match.
+      initialStats = (1.0 - stepSize) * initialStats +
+          stepSize * batchInitial / (double) (batchEnd - batchStart + 1);
+      transitionStats = (1.0 - stepSize) * transitionStats +
+          stepSize * batchTransition / (double) batchLength;
+
+      // Now the M-step: re-estimate the parameters from the averages.
+      arma::vec initial = initialStats / arma::accu(initialStats);
+      arma::mat transition = transitionStats;
+      for (size_t col = 0; col < transition.n_cols; col++)
+      {
+        const double sum = arma::accu(transition.col(col));
+        if (sum > 0)
+          transition.col(col) /= sum;
+        else
+          transition.col(col).fill(1.0 / (double) transition.n_rows);
+      }
+
+      initialProxy = initial;
+      transitionProxy = transition;
+      logInitial = log(initial);
+      logTransition = log(transition);
+
+      // Re-estimate the emission distributions from the accumulated weighted
+      // observations.  A state with no weight yet has nothing to train on.
+      for (size_t state = 0; state < logTransition.n_cols; state++)
+      {
+        if (arma::accu(emissionProb[state]) > 0)
+          emission[state].Train(emissionList, emissionProb[state]);
+      }
+
+      loglik += batchLoglik;
+      ++updates;
+    }
+
+    if (std::abs(oldLoglik - loglik) < tolerance)
+    {
+      Log::Debug << "Converged after " << epoch << " epochs." << std::endl;
+      break;
+    }
+
+    oldLoglik = loglik;
+
+    Log::Debug << "Epoch " << epoch << ": approximate log-likelihood "
+        << loglik << "." << std::endl;
+  }
+  return loglik;
+}
+
 /**
  * Train the model using the given labeled observations; the transition and
  * emission matrices are directly estimated.
@@ -457,21 +751,46 @@ void HMM<Distribution>::Generate(const size_t length,
 template<typename Distribution>
 double HMM<Distribution>::Predict(const arma::mat& dataSeq,
                                   arma::Row<size_t>& stateSeq) const
+{
+  // Decode into a temporary workspace; callers that decode many sequences can
+  // pass their own workspace to the other overload to reuse its buffers.
+  ViterbiWorkspace workspace;
+  return Predict(dataSeq, stateSeq, workspace);
+}
+
+/**
+ * Compute the most probable hidden state sequence for the given observation
+ * using the Viterbi algorithm, keeping all scratch matrices in the given
+ * caller-owned workspace.  Returns the log-likelihood of the most likely
+ * sequence.
+ */
+template<typename Distribution>
+double HMM<Distribution>::Predict(const arma::mat& dataSeq,
+                                  arma::Row<size_t>& stateSeq,
+                                  ViterbiWorkspace& workspace) const
 {
   // This is an implementation of the Viterbi algorithm for finding the most
-  // probable sequence of states to produce the observed data sequence.  We
-  // don't use log-likelihoods to save that little bit of time, but we'll
-  // calculate the log-likelihood at the end of it all.
+  // probable sequence of states to produce the observed data sequence.
   stateSeq.set_size(dataSeq.n_cols);
-  arma::mat logStateProb(logTransition.n_rows, dataSeq.n_cols);
-  arma::mat stateSeqBack(logTransition.n_rows, dataSeq.n_cols);
 
   ConvertToLogSpace();
 
+  workspace.Resize(logTransition.n_rows, dataSeq.n_cols);
+  arma::mat& logStateProb = workspace.logStateProb;
+  arma::umat& stateSeqBack = workspace.stateSeqBack;
+
+  const bool pruned = (beamWidth > 0 && beamWidth < logTransition.n_rows);
+
+  // Work with the transposed transition matrix so that the per-timestep
+  // max-plus update runs down columns instead of across rows.  The pruned
+  // update reads columns of the untransposed matrix instead, so it can skip
+  // the transposition entirely.
+  if (!pruned)
+    workspace.logTransitionT = logTransition.t();
+
   // The calculation of the first state is slightly different; the probability
   // of the first state being state j is the maximum probability that the state
   // came to be j from another state.
-  logStateProb.col(0).zeros();
   for (size_t state = 0; state < logTransition.n_rows; state++)
   {
     logStateProb(state, 0) = logInitial[state] +
@@ -479,23 +798,69 @@ double HMM<Distribution>::Predict(const arma::mat& dataSeq,
     stateSeqBack(state, 0) = state;
   }
 
-  // Store the best first state.
   arma::uword index;
+  arma::vec bestScore;
+  if (pruned)
+    bestScore.set_size(logTransition.n_rows);
   for (size_t t = 1; t < dataSeq.n_cols; t++)
   {
     // Assemble the state probability for this element.
-    // Given that we are in state j, we use state with the highest probability
-    // of being the previous state.
-    for (size_t j = 0; j < logTransition.n_rows; ++j)
+    // Given that we are in state j, we use the state with the highest
+    // probability of being the previous state.
+    if (pruned)
+    {
+      // Only the beamWidth most probable states of the previous time step
+      // are considered as predecessors, so this step evaluates
+      // beamWidth * numStates transitions instead of all of them.  A path
+      // through a pruned state is lost.
+      workspace.beamActive = arma::sort_index(logStateProb.col(t - 1),
+          "descend");
+
+      bestScore.fill(-std::numeric_limits<double>::infinity());
+      for (size_t b = 0; b < beamWidth; ++b)
+      {
+        const size_t k = workspace.beamActive[b];
+        const double prevLogProb = logStateProb(k, t - 1);
+
+        // Column k of the transition matrix holds the log-probabilities of
+        // transitioning from state k to every state.
+        for (size_t j = 0; j < logTransition.n_rows; ++j)
+        {
+          const double candidate = prevLogProb + logTransition(j, k);
+          if (candidate > bestScore[j])
+          {
+            bestScore[j] = candidate;
+            stateSeqBack(j, t) = k;
+          }
+        }
+      }
+
+      for (size_t j = 0; j < logTransition.n_rows; ++j)
+      {
+        logStateProb(j, t) = bestScore[j] +
+            emission[j].LogProbability(dataSeq.unsafe_col(t));
+      }
+    }
+    else
     {
-      arma::vec prob = logStateProb.col(t - 1) + logTransition.row(j).t();
-      logStateProb(j, t) = prob.max(index) +
-          emission[j].LogProbability(dataSeq.unsafe_col(t));
-      stateSeqBack(j, t) = index;
+      // scores(k, j) is the probability of being in state k at time t - 1
+      // and transitioning to state j, so the best previous state for each j
+      // is the maximum of column j.
+      workspace.scores = workspace.logTransitionT;
+      workspace.scores.each_col() += logStateProb.unsafe_col(t - 1);
+      workspace.bestPrev = arma::index_max(workspace.scores, 0);
+
+      for (size_t j = 0; j < logTransition.n_rows; ++j)
+      {
+        logStateProb(j, t) = workspace.scores(workspace.bestPrev[j], j) +
+            emission[j].LogProbability(dataSeq.unsafe_col(t));
+        stateSeqBack(j, t) = workspace.bestPrev[j];
+      }
     }
   }
 
-  // Backtrack to find the most probable state sequence.
+  // Backtrack to find the most probable state sequence.  The workspace
+  // buffers may be larger than this sequence, so index columns explicitly.
   logStateProb.unsafe_col(dataSeq.n_cols - 1).max(index);
   stateSeq[dataSeq.n_cols - 1] = index;
   for (size_t t = 2; t <= dataSeq.n_cols; t++)
@@ -522,6 +887,50 @@ double HMM<Distribution>::LogLikelihood(const arma::mat& dataSeq) const
   return accu(logScales);
 }
 
+/**
+ * Incrementally extend a streaming sequence by one observation.
+ */
+template<typename Distribution>
+double HMM<Distribution>::ExtendForward(ForwardState& state,
+                                        const arma::vec& observation) const
+{
+  ConvertToLogSpace();
+
+  // Emission log-probability of the new observation under every state.
+  arma::vec emissionLogProb(logTransition.n_rows);
+  for (size_t i = 0; i < logTransition.n_rows; ++i)
+    emissionLogProb[i] = emission[i].LogProbability(observation);
+
+  if (state.time == 0)
+  {
+    // The first observation uses the initial state probabilities, as in
+    // Forward().
+    state.logForwardProb = logInitial + emissionLogProb;
+  }
+  else
+  {
+    // One step of the forward recursion: combine the previous normalized
+    // forward probabilities with the transition matrix, then apply the
+    // emission probabilities.
+    arma::mat shifted = logTransition.t();
+    shifted.each_col() += state.logForwardProb;
+    arma::vec logProbSum;
+    math::LogSumExpCols(shifted, logProbSum);
+    state.logForwardProb = logProbSum + emissionLogProb;
+  }
+
+  // Normalize; the scale is this observation's contribution to the
+  // log-likelihood.
+  const double logScale = math::AccuLog(state.logForwardProb);
+  if (std::isfinite(logScale))
+    state.logForwardProb -= logScale;
+
+  state.logLikelihood += logScale;
+  ++state.time;
+
+  return state.logLikelihood;
+}
+
 /**
  * HMM filtering.
  */
@@ -530,10 +939,13 @@ void HMM<Distribution>::Filter(const arma::mat& dataSeq,
                                arma::mat& filterSeq,
                                size_t ahead) const
 {
-  // First run the forward algorithm.
+  // First run the forward algorithm, possibly with beam pruning.
   arma::mat forwardLogProb;
   arma::vec logScales;
-  Forward(dataSeq, logScales, forwardLogProb);
+  if (beamWidth > 0 && beamWidth < logTransition.n_rows)
+    ForwardBeam(dataSeq, logScales, forwardLogProb);
+  else
+    Forward(dataSeq, logScales, forwardLogProb);
 
   // Propagate state ahead.
   if (ahead != 0)
@@ -587,34 +999,45 @@ void HMM<Distribution>::Forward(const arma::mat& dataSeq,
 
   ConvertToLogSpace();
 
+  // Compute the emission log-probability of every observation under every
+  // state up front: one vectorized call per state instead of one call per
+  // (state, observation) pair.
+  arma::mat emissionLogProb(logTransition.n_rows, dataSeq.n_cols);
+  arma::vec stateLogProb;
+  for (size_t state = 0; state < logTransition.n_rows; state++)
+  {
+    emission[state].LogProbability(dataSeq, stateLogProb);
+    emissionLogProb.row(state) = stateLogProb.t();
+  }
+
   // The first entry in the forward algorithm uses the initial state
   // probabilities.  Note that MATLAB assumes that the starting state (at
   // t = -1) is state 0; this is not our assumption here.  To force that
   // behavior, you could append a single starting state to every single data
   // sequence and that should produce results in line with MATLAB.
-  for (size_t state = 0; state < logTransition.n_rows; state++)
-  {
-    forwardLogProb(state, 0) = logInitial(state) +
-        emission[state].LogProbability(dataSeq.unsafe_col(0));
-  }
+  forwardLogProb.col(0) = logInitial + emissionLogProb.col(0);
 
   // Then normalize the column.
   logScales[0] = math::AccuLog(forwardLogProb.col(0));
   if (std::isfinite(logScales[0]))
     forwardLogProb.col(0) -= logScales[0];
 
-  // Now compute the probabilities for each successive observation.
+  // Now compute the probabilities for each successive observation.  The
+  // transposed transition matrix is hoisted out of the loop so that each
+  // timestep is a single shift of it.
+  const arma::mat logTransitionT = logTransition.t();
+  arma::vec logProbSum;
   for (size_t t = 1; t < dataSeq.n_cols; t++)
   {
-    for (size_t j = 0; j < logTransition.n_rows; ++j)
-    {
-      // The forward probability of state j at time t is the sum over all states
-      // of the probability of the previous state transitioning to the current
-      // state and emitting the given observation.
-      arma::vec tmp = forwardLogProb.col(t - 1) + logTransition.row(j).t();
-      forwardLogProb(j, t) = math::AccuLog(tmp) +
-          emission[j].LogProbability(dataSeq.unsafe_col(t));
-    }
+    // The forward probability of state j at time t is the sum over all states
+    // of the probability of the previous state transitioning to the current
+    // state and emitting the given observation.  Column j of the shifted
+    // matrix holds these summands for state j, so one log-sum-exp over each
+    // column computes the probabilities of all states at once.
+    arma::mat shifted = logTransitionT;
+    shifted.each_col() += forwardLogProb.col(t - 1);
+    math::LogSumExpCols(shifted, logProbSum);
+    forwardLogProb.col(t) = logProbSum + emissionLogProb.col(t);
 
     // Normalize probability.
     logScales[t] = math::AccuLog(forwardLogProb.col(t));
@@ -636,26 +1059,106 @@ void HMM<Distribution>::Backward(const arma::mat& dataSeq,
   // The last element probability is 1.
   backwardLogProb.col(dataSeq.n_cols - 1).fill(0);
 
+  // Compute the emission log-probability of every observation under every
+  // state up front, as in Forward().
+  arma::mat emissionLogProb(logTransition.n_rows, dataSeq.n_cols);
+  arma::vec stateLogProb;
+  for (size_t state = 0; state < logTransition.n_rows; state++)
+  {
+    emission[state].LogProbability(dataSeq, stateLogProb);
+    emissionLogProb.row(state) = stateLogProb.t();
+  }
+
   // Now step backwards through all other observations.
+  arma::vec logProbSum;
   for (size_t t = dataSeq.n_cols - 2; t + 1 > 0; t--)
   {
-    for (size_t j = 0; j < logTransition.n_rows; ++j)
+    // The backward probability of state j at time t is the sum over all states
+    // of the probability of the next state having been a transition from the
+    // current state multiplied by the probability of each of those states
+    // emitting the given observation.  Column j of the shifted transition
+    // matrix holds these summands for state j, so one log-sum-exp over each
+    // column computes the probabilities of all states at once.
+    arma::mat shifted = logTransition;
+    shifted.each_col() +=
+        backwardLogProb.col(t + 1) + emissionLogProb.col(t + 1);
+    math::LogSumExpCols(shifted, logProbSum);
+    backwardLogProb.col(t) = logProbSum;
+
+    // Normalize by the weights from the forward algorithm.
+    if (std::isfinite(logScales[t + 1]))
+      backwardLogProb.col(t) -= logScales[t + 1];
+  }
+}
+
+/**
+ * The beam-pruned Forward procedure, used by Filter() when a beam width is
+ * set.
+ */
+template<typename Distribution>
+void HMM<Distribution>::ForwardBeam(const arma::mat& dataSeq,
+                                    arma::vec& logScales,
+                                    arma::mat& forwardLogProb) const
+{
+  // This is the same recursion as Forward(), except that only the beamWidth
+  // most probable states of the previous time step are summed over: each
+  // step costs beamWidth * numStates transition evaluations instead of all
+  // of them.  The mass of the pruned states is dropped, and the per-step
+  // renormalization spreads the approximation error over the remaining
+  // states.
+  forwardLogProb.resize(logTransition.n_rows, dataSeq.n_cols);
+  forwardLogProb.fill(-std::numeric_limits<double>::infinity());
+  logScales.resize(dataSeq.n_cols);
+  logScales.fill(-std::numeric_limits<double>::infinity());
+
+  ConvertToLogSpace();
+
+  // Compute the emission log-probability of every observation under every
+  // state up front, as in Forward().
+  arma::mat emissionLogProb(logTransition.n_rows, dataSeq.n_cols);
+  arma::vec stateLogProb;
+  for (size_t state = 0; state < logTransition.n_rows; state++)
+  {
+    emission[state].LogProbability(dataSeq, stateLogProb);
+    emissionLogProb.row(state) = stateLogProb.t();
+  }
+
+  // The first column is not pruned; it uses the initial state probabilities,
+  // as in Forward().
+  forwardLogProb.col(0) = logInitial + emissionLogProb.col(0);
+
+  logScales[0] = math::AccuLog(forwardLogProb.col(0));
+  if (std::isfinite(logScales[0]))
+    forwardLogProb.col(0) -= logScales[0];
+
+  arma::uvec beamActive;
+  arma::vec logProbSum(logTransition.n_rows);
+  for (size_t t = 1; t < dataSeq.n_cols; t++)
+  {
+    // Keep only the most probable states of the previous time step.
+    beamActive = arma::sort_index(forwardLogProb.col(t - 1), "descend");
+
+    logProbSum.fill(-std::numeric_limits<double>::infinity());
+    for (size_t b = 0; b < beamWidth; ++b)
     {
-      // The backward probability of state j at time t is the sum over all state
-      // of the probability of the next state having been a transition from the
-      // current state multiplied by the probability of each of those states
-      // emitting the given observation.
-      for (size_t state = 0; state < logTransition.n_rows; state++)
+      const size_t k = beamActive[b];
+      const double prevLogProb = forwardLogProb(k, t - 1);
+
+      // Column k of the transition matrix holds the log-probabilities of
+      // transitioning from state k to every state.
+      for (size_t j = 0; j < logTransition.n_rows; ++j)
       {
-        backwardLogProb(j, t) = math::LogAdd(backwardLogProb(j, t),
-            logTransition(state, j) + backwardLogProb(state, t + 1)
-            + emission[state].LogProbability(dataSeq.unsafe_col(t + 1)));
+        logProbSum[j] = math::LogAdd(logProbSum[j],
+            prevLogProb + logTransition(j, k));
       }
-
-      // Normalize by the weights from the forward algorithm.
-      if (std::isfinite(logScales[t + 1]))
-        backwardLogProb(j, t) -= logScales[t + 1];
     }
+
+    forwardLogProb.col(t) = logProbSum + emissionLogProb.col(t);
+
+    // Normalize probability.
+    logScales[t] = math::AccuLog(forwardLogProb.col(t));
+    if (std::isfinite(logScales[t]))
+      forwardLogProb.col(t) -= logScales[t];
   }
 }
 
@@ -245,6 +245,25 @@ class HMMRegression : public HMM<distribution::RegressionDistribution>
    */
   double LogLikelihood(const arma::mat& predictors,
                        const arma::vec& responses) const;
+
+  /**
+   * Incrementally extend a streaming sequence by one observation.  This
+   * performs a single step of the scaled forward recursion on the given
+   * state, so scoring a live stream costs O(states^2) per new sample instead
+   * of re-running the full forward pass; the resulting log-likelihood matches
+   * what LogLikelihood() would compute on the full sequence.  Pass a
+   * default-constructed (or Reset()) ForwardState to start a new stream, and
+   * keep one state per stream.
+   *
+   * @param state Streaming state to extend; updated in place.
+   * @param predictor Predictor vector of the new observation.
+   * @param response Response of the new observation.
+   * @return Log-likelihood of the whole sequence consumed so far.
+   */
+  double ExtendForward(ForwardState& state,
+                       const arma::vec& predictor,
+                       const double response) const;
+
   /**
    * HMMR filtering. Computes the k-step-ahead expected response at each time
    * conditioned only on prior observations. That is
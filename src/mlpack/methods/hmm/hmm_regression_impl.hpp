@@ -92,6 +92,22 @@ double HMMRegression::LogLikelihood(const arma::mat& predictors,
   return this->HMM::LogLikelihood(dataSeq);
 }
 
+/**
+ * Incrementally extend a streaming sequence by one observation.
+ */
+double HMMRegression::ExtendForward(ForwardState& state,
+                                    const arma::vec& predictor,
+                                    const double response) const
+{
+  // Stack the response on top of the predictors, as StackData() does for full
+  // sequences.
+  arma::vec observation(predictor.n_elem + 1);
+  observation[0] = response;
+  observation.subvec(1, predictor.n_elem) = predictor;
+
+  return this->HMM::ExtendForward(state, observation);
+}
+
 /**
  * HMMRegression filtering.
  */
@@ -23,50 +23,30 @@ class GiniImpurity
  public:
   static double Evaluate(const arma::Mat<size_t>& counts)
   {
-    // We need to sum over the difference between the un-split node and the
-    // split nodes.  First we'll calculate the number of elements in each split
-    // and total.
-    size_t numElem = 0;
-    arma::vec splitCounts(counts.n_cols);
-    for (size_t i = 0; i < counts.n_cols; ++i)
-    {
-      splitCounts[i] = arma::accu(counts.col(i));
-      numElem += splitCounts[i];
-    }
+    // Work on the stacked counts matrix with vectorized expressions; this is
+    // called once per candidate split per split check, on a (classes x
+    // children) matrix.
+    const arma::mat fCounts = arma::conv_to<arma::mat>::from(counts);
+    const arma::rowvec splitCounts = arma::sum(fCounts, 0);
+    const double numElem = arma::accu(splitCounts);
 
     // Corner case: if there are no elements, the impurity is zero.
     if (numElem == 0)
       return 0.0;
 
-    arma::Col<size_t> classCounts = arma::sum(counts, 1);
+    const arma::vec classFracs = arma::sum(fCounts, 1) / numElem;
 
-    // Calculate the Gini impurity of the un-split node.
-    double impurity = 0.0;
-    for (size_t i = 0; i < classCounts.n_elem; ++i)
-    {
-      const double f = ((double) classCounts[i] / (double) numElem);
-      impurity += f * (1.0 - f);
-    }
+    // The difference between the impurity of the un-split node and the
+    // weighted impurity of the children simplifies algebraically to
+    //   (1 / N) * sum_i (sum_j c_ij^2 / s_i) - sum_j f_j^2,
+    // with s_i the number of points in child i and f_j the class fractions of
+    // the un-split node.  Empty children contribute nothing (their squared
+    // counts are zero), so clamping the denominator is safe.
+    const arma::rowvec squaredSums = arma::sum(arma::square(fCounts), 0);
+    const double childTerm = arma::accu(squaredSums /
+        arma::clamp(splitCounts, 1.0, arma::datum::inf)) / numElem;
 
-    // Now calculate the impurity of the split nodes and subtract them from the
-    // overall impurity.
-    for (size_t i = 0; i < counts.n_cols; ++i)
-    {
-      if (splitCounts[i] > 0)
-      {
-        double splitImpurity = 0.0;
-        for (size_t j = 0; j < counts.n_rows; ++j)
-        {
-          const double f = ((double) counts(j, i) / (double) splitCounts[i]);
-          splitImpurity += f * (1.0 - f);
-        }
-
-        impurity -= ((double) splitCounts[i] / (double) numElem) *
-            splitImpurity;
-      }
-    }
-
-    return impurity;
+    return childTerm - arma::accu(classFracs % classFracs);
   }
 
   /**
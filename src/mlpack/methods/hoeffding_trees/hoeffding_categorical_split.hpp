@@ -76,6 +76,16 @@ class HoeffdingCategoricalSplit
   template<typename eT>
   void Train(eT value, const size_t label);
 
+  /**
+   * Train on a whole batch of values at once, accumulating all counts into
+   * the sufficient statistics in one tight loop.
+   *
+   * @param values Batch of category values for this dimension.
+   * @param labels Labels associated with the values.
+   */
+  template<typename VecType>
+  void TrainBatch(const VecType& values, const arma::Row<size_t>& labels);
+
   /**
    * Given the points seen so far, evaluate the fitness function, returning the
    * gain for the best possible split and the second best possible split.  In
@@ -47,6 +47,17 @@ void HoeffdingCategoricalSplit<FitnessFunction>::Train(eT value,
   sufficientStatistics(label, size_t(value))++;
 }
 
+template<typename FitnessFunction>
+template<typename VecType>
+void HoeffdingCategoricalSplit<FitnessFunction>::TrainBatch(
+    const VecType& values,
+    const arma::Row<size_t>& labels)
+{
+  // Add the whole batch to our counts in one pass.
+  for (size_t i = 0; i < values.n_elem; ++i)
+    sufficientStatistics(labels[i], size_t(values[i]))++;
+}
+
 template<typename FitnessFunction>
 void HoeffdingCategoricalSplit<FitnessFunction>::EvaluateFitnessFunction(
     double& bestFitness,
@@ -0,0 +1,186 @@
+/**
+ * @file methods/hoeffding_trees/hoeffding_forest.hpp
+ *
+ * A streaming random forest built on the Hoeffding tree.  Each tree of the
+ * forest observes a random subspace of the dimensions, every tree is updated
+ * in parallel from the same pass over the input stream, and classification is
+ * performed by majority vote over the trees.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HOEFFDING_TREES_HOEFFDING_FOREST_HPP
+#define MLPACK_METHODS_HOEFFDING_TREES_HOEFFDING_FOREST_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "hoeffding_tree.hpp"
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The HoeffdingForest class trains an ensemble of Hoeffding trees in a
+ * streaming setting.  Each tree is restricted to a random subset of the
+ * dimensions of the dataset, so the trees decorrelate in the same way the
+ * trees of a batch random forest do; on drifting streams the ensemble
+ * typically recovers much of the accuracy gap between a single streaming tree
+ * and a batch-trained forest, while every update still costs only streaming
+ * time.
+ *
+ * Train() may be called repeatedly with successive chunks of the stream; all
+ * trees of the forest are updated in parallel from the same chunk.  Classify()
+ * takes the majority vote of the trees, and the returned probabilities are
+ * the fractions of trees voting for each class.
+ *
+ * @tparam FitnessFunction Fitness function to use by each tree.
+ * @tparam NumericSplitType Technique for splitting numeric features.
+ * @tparam CategoricalSplitType Technique for splitting categorical features.
+ */
+template<typename FitnessFunction = GiniImpurity,
+         template<typename> class NumericSplitType =
+             HoeffdingDoubleNumericSplit,
+         template<typename> class CategoricalSplitType =
+             HoeffdingCategoricalSplit
+>
+class HoeffdingForest
+{
+ public:
+  //! The type of a single tree of the forest.
+  typedef HoeffdingTree<FitnessFunction, NumericSplitType,
+      CategoricalSplitType> TreeType;
+
+  /**
+   * Construct an empty forest with no trees.  Be sure to call the other
+   * constructor (or load a forest) before calling Train() or Classify().
+   */
+  HoeffdingForest();
+
+  /**
+   * Construct the forest, but train on no data.  Each tree draws its own
+   * random subset of the dimensions; if dimensionsPerTree is 0, the usual
+   * random forest heuristic of ceil(sqrt(dimensionality)) dimensions per tree
+   * is used.
+   *
+   * @param datasetInfo Information on the dataset (types of each feature).
+   * @param numClasses Number of classes in the dataset.
+   * @param numTrees Number of trees in the forest.
+   * @param dimensionsPerTree Number of dimensions each tree observes (0 means
+   *      ceil(sqrt(dimensionality))).
+   * @param successProbability Probability of success required in Hoeffding
+   *      bounds before a split can happen.
+   * @param maxSamples Maximum number of samples before a split is forced (0
+   *      never forces a split).
+   * @param checkInterval Number of samples required before each split check.
+   * @param minSamples If a node has seen this many points or fewer, no split
+   *      will be allowed.
+   */
+  HoeffdingForest(const data::DatasetInfo& datasetInfo,
+                  const size_t numClasses,
+                  const size_t numTrees = 10,
+                  const size_t dimensionsPerTree = 0,
+                  const double successProbability = 0.95,
+                  const size_t maxSamples = 0,
+                  const size_t checkInterval = 100,
+                  const size_t minSamples = 100);
+
+  /**
+   * Train all trees of the forest on a chunk of the stream.  The chunk is
+   * passed over once; every tree extracts its subspace of the chunk and the
+   * per-tree updates run in parallel.
+   *
+   * @param data Data points to train on.
+   * @param labels Labels of data points.
+   */
+  template<typename MatType>
+  void Train(const MatType& data, const arma::Row<size_t>& labels);
+
+  /**
+   * Train all trees of the forest on a single point in streaming mode.
+   *
+   * @param point Point to train on.
+   * @param label Label of the point to train on.
+   */
+  template<typename VecType>
+  void Train(const VecType& point, const size_t label);
+
+  /**
+   * Classify the given point by majority vote of the trees, returning the
+   * predicted class.
+   *
+   * @param point Point to classify.
+   */
+  template<typename VecType>
+  size_t Classify(const VecType& point) const;
+
+  /**
+   * Classify the given point by majority vote of the trees, returning the
+   * predicted class and the fraction of trees that voted for it.
+   *
+   * @param point Point to classify.
+   * @param prediction Predicted class of the point.
+   * @param probability Fraction of trees voting for the predicted class.
+   */
+  template<typename VecType>
+  void Classify(const VecType& point,
+                size_t& prediction,
+                double& probability) const;
+
+  /**
+   * Classify the given points by majority vote of the trees.  Each tree
+   * classifies its subspace of the whole batch at once and the trees are
+   * processed in parallel.
+   *
+   * @param data Points to classify.
+   * @param predictions Predicted classes of each point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data, arma::Row<size_t>& predictions) const;
+
+  /**
+   * Classify the given points by majority vote of the trees, also returning
+   * the fraction of trees voting for each class.
+   *
+   * @param data Points to classify.
+   * @param predictions Predicted classes of each point.
+   * @param probabilities Fraction of trees voting for each class, for each
+   *      point (one column per point).
+   */
+  template<typename MatType>
+  void Classify(const MatType& data,
+                arma::Row<size_t>& predictions,
+                arma::mat& probabilities) const;
+
+  //! Get the number of trees in the forest.
+  size_t NumTrees() const { return trees.size(); }
+
+  //! Get the number of classes in the dataset.
+  size_t NumClasses() const { return numClasses; }
+
+  //! Get a single tree of the forest.
+  const TreeType& Tree(const size_t i) const { return trees[i]; }
+
+  //! Get the dimension subset observed by a single tree.
+  arma::uvec Subspace(const size_t i) const { return subspaces.col(i); }
+
+  //! Serialize the forest.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! The trees of the forest.
+  std::vector<TreeType> trees;
+  //! The sorted dimension subset of each tree (one column per tree).
+  arma::umat subspaces;
+  //! The number of classes in the dataset.
+  size_t numClasses;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "hoeffding_forest_impl.hpp"
+
+#endif
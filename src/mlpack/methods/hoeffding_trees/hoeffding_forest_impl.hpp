@@ -0,0 +1,245 @@
+/**
+ * @file methods/hoeffding_trees/hoeffding_forest_impl.hpp
+ *
+ * Implementation of the HoeffdingForest class, a streaming random forest
+ * built on Hoeffding trees with per-tree random feature subspaces.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HOEFFDING_TREES_HOEFFDING_FOREST_IMPL_HPP
+#define MLPACK_METHODS_HOEFFDING_TREES_HOEFFDING_FOREST_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "hoeffding_forest.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+HoeffdingForest<FitnessFunction, NumericSplitType, CategoricalSplitType>::
+    HoeffdingForest() : numClasses(0)
+{
+  // Nothing to do.
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+HoeffdingForest<FitnessFunction, NumericSplitType, CategoricalSplitType>::
+    HoeffdingForest(const data::DatasetInfo& datasetInfo,
+                    const size_t numClasses,
+                    const size_t numTrees,
+                    const size_t dimensionsPerTree,
+                    const double successProbability,
+                    const size_t maxSamples,
+                    const size_t checkInterval,
+                    const size_t minSamples) :
+    numClasses(numClasses)
+{
+  const size_t dimensionality = datasetInfo.Dimensionality();
+  size_t dims = (dimensionsPerTree == 0) ?
+      (size_t) std::ceil(std::sqrt((double) dimensionality)) :
+      dimensionsPerTree;
+  if (dims > dimensionality)
+    dims = dimensionality;
+
+  subspaces.set_size(dims, numTrees);
+  trees.reserve(numTrees);
+
+  arma::uvec dimensions = arma::linspace<arma::uvec>(0, dimensionality - 1,
+      dimensionality);
+  for (size_t t = 0; t < numTrees; ++t)
+  {
+    // Draw a random subset of the dimensions (partial Fisher-Yates shuffle),
+    // and keep it sorted so subspace extraction is cache-friendly.
+    for (size_t j = 0; j < dims; ++j)
+    {
+      const size_t k = (size_t) math::RandInt(j, dimensionality);
+      std::swap(dimensions[j], dimensions[k]);
+    }
+    subspaces.col(t) = arma::sort(dimensions.head(dims));
+
+    // Build the DatasetInfo of the subspace.  Categorical dimensions keep
+    // their number of mappings; the mapped strings themselves don't matter to
+    // the tree, only the category count does.
+    data::DatasetInfo treeInfo(dims);
+    for (size_t j = 0; j < dims; ++j)
+    {
+      const size_t d = subspaces(j, t);
+      if (datasetInfo.Type(d) == data::Datatype::categorical)
+      {
+        treeInfo.Type(j) = data::Datatype::categorical;
+        for (size_t k = 0; k < datasetInfo.NumMappings(d); ++k)
+          treeInfo.MapString<size_t>(std::to_string(k), j);
+      }
+    }
+
+    trees.push_back(TreeType(treeInfo, numClasses, successProbability,
+        maxSamples, checkInterval, minSamples));
+  }
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename MatType>
+void HoeffdingForest<FitnessFunction, NumericSplitType,
+    CategoricalSplitType>::Train(const MatType& data,
+                                 const arma::Row<size_t>& labels)
+{
+  // Each tree consumes its subspace of the same chunk of the stream; the
+  // trees are independent, so the updates run in parallel.
+  #pragma omp parallel for
+  for (omp_size_t t = 0; t < (omp_size_t) trees.size(); ++t)
+  {
+    const MatType subset = data.rows(subspaces.col(t));
+    trees[t].TrainBatch(subset, labels);
+  }
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename VecType>
+void HoeffdingForest<FitnessFunction, NumericSplitType,
+    CategoricalSplitType>::Train(const VecType& point, const size_t label)
+{
+  arma::Col<typename VecType::elem_type> subPoint(subspaces.n_rows);
+  for (size_t t = 0; t < trees.size(); ++t)
+  {
+    for (size_t j = 0; j < subspaces.n_rows; ++j)
+      subPoint[j] = point[subspaces(j, t)];
+    trees[t].Train(subPoint, label);
+  }
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename VecType>
+size_t HoeffdingForest<FitnessFunction, NumericSplitType,
+    CategoricalSplitType>::Classify(const VecType& point) const
+{
+  size_t prediction;
+  double probability;
+  Classify(point, prediction, probability);
+  return prediction;
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename VecType>
+void HoeffdingForest<FitnessFunction, NumericSplitType,
+    CategoricalSplitType>::Classify(const VecType& point,
+                                    size_t& prediction,
+                                    double& probability) const
+{
+  if (trees.size() == 0)
+  {
+    throw std::invalid_argument("HoeffdingForest::Classify(): no forest "
+        "trained!");
+  }
+
+  arma::vec votes(numClasses, arma::fill::zeros);
+  arma::Col<typename VecType::elem_type> subPoint(subspaces.n_rows);
+  for (size_t t = 0; t < trees.size(); ++t)
+  {
+    for (size_t j = 0; j < subspaces.n_rows; ++j)
+      subPoint[j] = point[subspaces(j, t)];
+    votes[trees[t].Classify(subPoint)] += 1.0;
+  }
+
+  arma::uword maxIndex = 0;
+  votes.max(maxIndex);
+  prediction = (size_t) maxIndex;
+  probability = votes[maxIndex] / trees.size();
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename MatType>
+void HoeffdingForest<FitnessFunction, NumericSplitType,
+    CategoricalSplitType>::Classify(const MatType& data,
+                                    arma::Row<size_t>& predictions) const
+{
+  arma::mat probabilities;
+  Classify(data, predictions, probabilities);
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename MatType>
+void HoeffdingForest<FitnessFunction, NumericSplitType,
+    CategoricalSplitType>::Classify(const MatType& data,
+                                    arma::Row<size_t>& predictions,
+                                    arma::mat& probabilities) const
+{
+  if (trees.size() == 0)
+  {
+    predictions.clear();
+    probabilities.clear();
+
+    throw std::invalid_argument("HoeffdingForest::Classify(): no forest "
+        "trained!");
+  }
+
+  arma::mat votes(numClasses, data.n_cols, arma::fill::zeros);
+
+  // Each tree classifies its subspace of the whole batch at once; the votes
+  // are accumulated thread-locally and merged afterwards.
+  #pragma omp parallel
+  {
+    arma::mat localVotes(numClasses, data.n_cols, arma::fill::zeros);
+    arma::Row<size_t> treePredictions;
+
+    #pragma omp for
+    for (omp_size_t t = 0; t < (omp_size_t) trees.size(); ++t)
+    {
+      const MatType subset = data.rows(subspaces.col(t));
+      trees[t].Classify(subset, treePredictions);
+      for (size_t i = 0; i < treePredictions.n_elem; ++i)
+        localVotes(treePredictions[i], i) += 1.0;
+    }
+
+    #pragma omp critical (HoeffdingForestVotes)
+    {
+      votes += localVotes;
+    }
+  }
+
+  votes /= trees.size();
+  probabilities = std::move(votes);
+
+  predictions.set_size(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    arma::uword maxIndex = 0;
+    probabilities.unsafe_col(i).max(maxIndex);
+    predictions[i] = (size_t) maxIndex;
+  }
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename Archive>
+void HoeffdingForest<FitnessFunction, NumericSplitType,
+    CategoricalSplitType>::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(numClasses));
+  ar(CEREAL_NVP(subspaces));
+  ar(CEREAL_NVP(trees));
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
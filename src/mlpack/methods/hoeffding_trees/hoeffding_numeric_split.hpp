@@ -87,6 +87,18 @@ class HoeffdingNumericSplit
    */
   void Train(ObservationType value, const size_t label);
 
+  /**
+   * Train on a whole batch of observed values at once.  Points are fed one at
+   * a time until the bins have been built; the remainder of the batch is
+   * accumulated into the sufficient statistics in a single tight loop with no
+   * per-point dispatch.
+   *
+   * @param values Batch of observed values for this dimension.
+   * @param labels Labels associated with the observed values.
+   */
+  template<typename VecType>
+  void TrainBatch(const VecType& values, const arma::Row<size_t>& labels);
+
   /**
    * Evaluate the fitness function given what has been calculated so far.  In
    * this case, if binning has not yet been performed, 0 will be returned (i.e.,
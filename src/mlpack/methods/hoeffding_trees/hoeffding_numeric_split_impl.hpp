@@ -103,6 +103,33 @@ void HoeffdingNumericSplit<FitnessFunction, ObservationType>::Train(
   sufficientStatistics(label, bin)++;
 }
 
+template<typename FitnessFunction, typename ObservationType>
+template<typename VecType>
+void HoeffdingNumericSplit<FitnessFunction, ObservationType>::TrainBatch(
+    const VecType& values,
+    const arma::Row<size_t>& labels)
+{
+  // Feed points one at a time until the bins have been built.
+  size_t i = 0;
+  while (i < values.n_elem && samplesSeen < observationsBeforeBinning)
+  {
+    Train((ObservationType) values[i], labels[i]);
+    ++i;
+  }
+
+  // The bins exist now (unless the batch was too small); accumulate the rest
+  // of the batch directly into the sufficient statistics.
+  for (; i < values.n_elem; ++i)
+  {
+    const ObservationType value = (ObservationType) values[i];
+    size_t bin = 0;
+    while (bin < bins - 1 && value > splitPoints[bin])
+      ++bin;
+
+    sufficientStatistics(labels[i], bin)++;
+  }
+}
+
 template<typename FitnessFunction, typename ObservationType>
 void HoeffdingNumericSplit<FitnessFunction, ObservationType>::
     EvaluateFitnessFunction(double& bestFitness,
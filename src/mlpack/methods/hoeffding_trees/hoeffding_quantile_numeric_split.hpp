@@ -0,0 +1,184 @@
+/**
+ * @file methods/hoeffding_trees/hoeffding_quantile_numeric_split.hpp
+ *
+ * A numeric feature split for Hoeffding trees that builds its bins from a
+ * fixed-memory streaming quantile sketch instead of a buffer of observations.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HOEFFDING_TREES_HOEFFDING_QUANTILE_NUMERIC_SPLIT_HPP
+#define MLPACK_METHODS_HOEFFDING_TREES_HOEFFDING_QUANTILE_NUMERIC_SPLIT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "numeric_split_info.hpp"
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The HoeffdingQuantileNumericSplit class is a drop-in alternative to the
+ * HoeffdingNumericSplit class that never buffers raw observations.  The
+ * HoeffdingNumericSplit class stores the first observationsBeforeBinning
+ * points (and their labels) of every numeric dimension of every leaf before
+ * it builds its bins, so the memory per leaf grows with the warmup length;
+ * this class instead maintains a fixed set of quantile markers with the
+ * extended P^2 algorithm of Jain and Chlamtac:
+ *
+ * @code
+ * @article{jain1985p2,
+ *   title={{The P^2 Algorithm for Dynamic Calculation of Quantiles and
+ *       Histograms Without Storing Observations}},
+ *   author={Jain, R. and Chlamtac, I.},
+ *   journal={Communications of the ACM},
+ *   volume={28},
+ *   number={10},
+ *   year={1985}
+ * }
+ * @endcode
+ *
+ * The sketch holds 2 * bins + 1 markers, so the memory per dimension is a
+ * small constant independent of the warmup length.  When
+ * observationsBeforeBinning points have been seen, the bin boundaries are
+ * taken from the quantile markers, which gives (approximately)
+ * equal-population bins instead of the equal-width bins of the
+ * HoeffdingNumericSplit class.  The warmup points only inform the sketch;
+ * they are not replayed into the sufficient statistics, so the first split
+ * check after binning sees slightly fewer points than with the buffering
+ * strategy.
+ *
+ * @tparam FitnessFunction Fitness function to use for calculating gain.
+ * @tparam ObservationType Type of observations in this dimension.
+ */
+template<typename FitnessFunction,
+         typename ObservationType = double>
+class HoeffdingQuantileNumericSplit
+{
+ public:
+  //! The splitting information type required by this split.
+  typedef NumericSplitInfo<ObservationType> SplitInfo;
+
+  /**
+   * Create the HoeffdingQuantileNumericSplit class, and specify some basic
+   * parameters about how the binning should take place.
+   *
+   * @param numClasses Number of classes.
+   * @param bins Number of bins.
+   * @param observationsBeforeBinning Number of points to see before binning is
+   *      performed (always at least the number of quantile markers).
+   */
+  HoeffdingQuantileNumericSplit(const size_t numClasses = 0,
+                                const size_t bins = 10,
+                                const size_t observationsBeforeBinning = 100);
+
+  /**
+   * Create the HoeffdingQuantileNumericSplit class, using the parameters from
+   * the given other split object.
+   */
+  HoeffdingQuantileNumericSplit(const size_t numClasses,
+                                const HoeffdingQuantileNumericSplit& other);
+
+  /**
+   * Train the split on the given observed value (remember that this object
+   * only cares about the information for a single feature, not an entire
+   * point).
+   *
+   * @param value Value in the dimension that this split refers to.
+   * @param label Label of the given point.
+   */
+  void Train(ObservationType value, const size_t label);
+
+  /**
+   * Train on a whole batch of observed values at once.  Points are fed one at
+   * a time until the bins have been built; the remainder of the batch is
+   * accumulated into the sufficient statistics in a single tight loop with no
+   * per-point dispatch.
+   *
+   * @param values Batch of observed values for this dimension.
+   * @param labels Labels associated with the observed values.
+   */
+  template<typename VecType>
+  void TrainBatch(const VecType& values, const arma::Row<size_t>& labels);
+
+  /**
+   * Evaluate the fitness function given what has been calculated so far.  If
+   * binning has not yet been performed, 0 will be returned (i.e., no gain).
+   * Because this split can only split one possible way, secondBestFitness
+   * (the fitness function for the second best possible split) will be set to
+   * 0.
+   *
+   * @param bestFitness Value of the fitness function for the best possible
+   *      split.
+   * @param secondBestFitness Value of the fitness function for the second
+   *      best possible split (always 0 for this split).
+   */
+  void EvaluateFitnessFunction(double& bestFitness, double& secondBestFitness)
+      const;
+
+  //! Return the number of children if this node splits on this feature.
+  size_t NumChildren() const { return bins; }
+
+  /**
+   * Return the majority class of each child to be created, if a split on this
+   * dimension was performed.  Also create the split object.
+   */
+  void Split(arma::Col<size_t>& childMajorities, SplitInfo& splitInfo) const;
+
+  //! Return the majority class.
+  size_t MajorityClass() const;
+  //! Return the probability of the majority class.
+  double MajorityProbability() const;
+
+  //! Return the number of bins.
+  size_t Bins() const { return bins; }
+
+  //! Return the split points of the bins (empty before binning).
+  const arma::Col<ObservationType>& SplitPoints() const { return splitPoints; }
+
+  //! Serialize the object.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  /**
+   * Feed one value to the quantile sketch.  The first markerHeights.n_elem
+   * values initialize the markers; after that each value adjusts the interior
+   * markers with the P^2 parabolic update.
+   */
+  void UpdateSketch(const ObservationType value);
+
+  //! The quantile marker heights (length 2 * bins + 1).
+  arma::Col<ObservationType> markerHeights;
+  //! The actual marker positions (number of observations not above them).
+  arma::vec markerPositions;
+
+  //! The split points for the binning (length bins - 1; empty until built).
+  arma::Col<ObservationType> splitPoints;
+  //! The number of bins.
+  size_t bins;
+  //! The number of observations we must see before binning.
+  size_t observationsBeforeBinning;
+  //! The number of samples we have seen so far.
+  size_t samplesSeen;
+
+  //! Class counts of the warmup points (these are seen before the bins are
+  //! built, so they are not part of the sufficient statistics).
+  arma::Col<size_t> warmupCounts;
+  //! After binning, this contains the sufficient statistics.
+  arma::Mat<size_t> sufficientStatistics;
+};
+
+//! Convenience typedef.
+template<typename FitnessFunction>
+using HoeffdingDoubleQuantileNumericSplit =
+    HoeffdingQuantileNumericSplit<FitnessFunction, double>;
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "hoeffding_quantile_numeric_split_impl.hpp"
+
+#endif
@@ -0,0 +1,272 @@
+/**
+ * @file methods/hoeffding_trees/hoeffding_quantile_numeric_split_impl.hpp
+ *
+ * An implementation of the HoeffdingQuantileNumericSplit class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HOEFFDING_TREES_HOEFFDING_QUANTILE_NUMERIC_SPLIT_IMPL_HPP
+#define MLPACK_METHODS_HOEFFDING_TREES_HOEFFDING_QUANTILE_NUMERIC_SPLIT_IMPL_HPP
+
+#include "hoeffding_quantile_numeric_split.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename FitnessFunction, typename ObservationType>
+HoeffdingQuantileNumericSplit<FitnessFunction, ObservationType>::
+HoeffdingQuantileNumericSplit(const size_t numClasses,
+                              const size_t bins,
+                              const size_t observationsBeforeBinning) :
+    markerHeights(2 * bins + 1),
+    markerPositions(2 * bins + 1),
+    bins(bins),
+    // The sketch needs at least one observation per marker before it can
+    // estimate anything.
+    observationsBeforeBinning(std::max(observationsBeforeBinning,
+        2 * bins + 1)),
+    samplesSeen(0),
+    warmupCounts(arma::zeros<arma::Col<size_t>>(numClasses)),
+    sufficientStatistics(arma::zeros<arma::Mat<size_t>>(numClasses, bins))
+{
+  // Nothing to do.
+}
+
+template<typename FitnessFunction, typename ObservationType>
+HoeffdingQuantileNumericSplit<FitnessFunction, ObservationType>::
+HoeffdingQuantileNumericSplit(const size_t numClasses,
+                              const HoeffdingQuantileNumericSplit& other) :
+    markerHeights(2 * other.bins + 1),
+    markerPositions(2 * other.bins + 1),
+    bins(other.bins),
+    observationsBeforeBinning(other.observationsBeforeBinning),
+    samplesSeen(0),
+    warmupCounts(arma::zeros<arma::Col<size_t>>(numClasses)),
+    sufficientStatistics(arma::zeros<arma::Mat<size_t>>(numClasses,
+        other.bins))
+{
+  // Nothing to do.
+}
+
+template<typename FitnessFunction, typename ObservationType>
+void HoeffdingQuantileNumericSplit<FitnessFunction, ObservationType>::Train(
+    ObservationType value,
+    const size_t label)
+{
+  if (samplesSeen < observationsBeforeBinning)
+  {
+    // The bins do not exist yet; the point only informs the sketch and the
+    // warmup class counts.
+    UpdateSketch(value);
+    warmupCounts[label]++;
+    ++samplesSeen;
+
+    if (samplesSeen == observationsBeforeBinning)
+    {
+      // Build the bins from the quantile markers; marker 2 * (i + 1) tracks
+      // the (i + 1) / bins quantile.
+      splitPoints.set_size(bins - 1);
+      for (size_t i = 0; i < bins - 1; ++i)
+        splitPoints[i] = markerHeights[2 * (i + 1)];
+    }
+
+    return;
+  }
+
+  // The bins exist, so we only need to add the point to the sufficient
+  // statistics.  What bin does the point fall into?
+  size_t bin = 0;
+  while (bin < bins - 1 && value > splitPoints[bin])
+    ++bin;
+
+  sufficientStatistics(label, bin)++;
+}
+
+template<typename FitnessFunction, typename ObservationType>
+template<typename VecType>
+void HoeffdingQuantileNumericSplit<FitnessFunction, ObservationType>::
+TrainBatch(const VecType& values, const arma::Row<size_t>& labels)
+{
+  // Feed points one at a time until the bins have been built.
+  size_t i = 0;
+  while (i < values.n_elem && samplesSeen < observationsBeforeBinning)
+  {
+    Train((ObservationType) values[i], labels[i]);
+    ++i;
+  }
+
+  // The bins exist now (unless the batch was too small); accumulate the rest
+  // of the batch directly into the sufficient statistics.
+  for (; i < values.n_elem; ++i)
+  {
+    const ObservationType value = (ObservationType) values[i];
+    size_t bin = 0;
+    while (bin < bins - 1 && value > splitPoints[bin])
+      ++bin;
+
+    sufficientStatistics(labels[i], bin)++;
+  }
+}
+
+template<typename FitnessFunction, typename ObservationType>
+void HoeffdingQuantileNumericSplit<FitnessFunction, ObservationType>::
+UpdateSketch(const ObservationType value)
+{
+  const size_t numMarkers = markerHeights.n_elem;
+
+  if (samplesSeen < numMarkers)
+  {
+    // The sketch is still initializing; collect the value as a marker.
+    markerHeights[samplesSeen] = value;
+
+    if (samplesSeen == numMarkers - 1)
+    {
+      // All markers are filled; sort them to get the initial estimates.
+      markerHeights = arma::sort(markerHeights);
+      for (size_t i = 0; i < numMarkers; ++i)
+        markerPositions[i] = i;
+    }
+
+    return;
+  }
+
+  // Regular P^2 update.  Find the cell the value falls into, clamping the
+  // extreme markers if necessary.
+  size_t k;
+  if (value < markerHeights[0])
+  {
+    markerHeights[0] = value;
+    k = 0;
+  }
+  else if (value >= markerHeights[numMarkers - 1])
+  {
+    markerHeights[numMarkers - 1] = value;
+    k = numMarkers - 2;
+  }
+  else
+  {
+    k = 0;
+    while (value >= markerHeights[k + 1])
+      ++k;
+  }
+
+  // All markers above the cell move one position to the right.
+  for (size_t i = k + 1; i < numMarkers; ++i)
+    markerPositions[i] += 1.0;
+
+  // Adjust the interior markers towards their desired positions.  Marker i
+  // tracks the quantile i / (numMarkers - 1), so with (samplesSeen + 1)
+  // observations its desired position is samplesSeen * i / (numMarkers - 1).
+  for (size_t i = 1; i < numMarkers - 1; ++i)
+  {
+    const double desired = (double) samplesSeen * i / (numMarkers - 1);
+    const double d = desired - markerPositions[i];
+
+    if (!((d >= 1.0 && markerPositions[i + 1] - markerPositions[i] > 1.0) ||
+          (d <= -1.0 && markerPositions[i - 1] - markerPositions[i] < -1.0)))
+      continue;
+
+    const double s = (d >= 1.0) ? 1.0 : -1.0;
+
+    // Try the piecewise-parabolic estimate first.
+    const double parabolic = (double) markerHeights[i] +
+        (s / (markerPositions[i + 1] - markerPositions[i - 1])) *
+        ((markerPositions[i] - markerPositions[i - 1] + s) *
+             ((double) markerHeights[i + 1] - markerHeights[i]) /
+             (markerPositions[i + 1] - markerPositions[i]) +
+         (markerPositions[i + 1] - markerPositions[i] - s) *
+             ((double) markerHeights[i] - markerHeights[i - 1]) /
+             (markerPositions[i] - markerPositions[i - 1]));
+
+    if (parabolic > markerHeights[i - 1] && parabolic < markerHeights[i + 1])
+    {
+      markerHeights[i] = (ObservationType) parabolic;
+    }
+    else
+    {
+      // Fall back to the linear estimate towards the neighbor in the
+      // direction of the adjustment.
+      const size_t j = (s > 0) ? (i + 1) : (i - 1);
+      markerHeights[i] = (ObservationType) ((double) markerHeights[i] +
+          s * ((double) markerHeights[j] - markerHeights[i]) /
+          (markerPositions[j] - markerPositions[i]));
+    }
+
+    markerPositions[i] += s;
+  }
+}
+
+template<typename FitnessFunction, typename ObservationType>
+void HoeffdingQuantileNumericSplit<FitnessFunction, ObservationType>::
+EvaluateFitnessFunction(double& bestFitness, double& secondBestFitness) const
+{
+  secondBestFitness = 0.0; // We can only split one way.
+  if (samplesSeen < observationsBeforeBinning)
+    bestFitness = 0.0;
+  else
+    bestFitness = FitnessFunction::Evaluate(sufficientStatistics);
+}
+
+template<typename FitnessFunction, typename ObservationType>
+void HoeffdingQuantileNumericSplit<FitnessFunction, ObservationType>::Split(
+    arma::Col<size_t>& childMajorities,
+    SplitInfo& splitInfo) const
+{
+  childMajorities.set_size(sufficientStatistics.n_cols);
+  for (size_t i = 0; i < sufficientStatistics.n_cols; ++i)
+  {
+    arma::uword maxIndex = 0;
+    sufficientStatistics.unsafe_col(i).max(maxIndex);
+    childMajorities[i] = size_t(maxIndex);
+  }
+
+  // Create the SplitInfo object.
+  splitInfo = SplitInfo(splitPoints);
+}
+
+template<typename FitnessFunction, typename ObservationType>
+size_t HoeffdingQuantileNumericSplit<FitnessFunction, ObservationType>::
+MajorityClass() const
+{
+  // The warmup points are not in the sufficient statistics, so the class
+  // counts are the sum of both.
+  arma::Col<size_t> classCounts = warmupCounts +
+      arma::sum(sufficientStatistics, 1);
+
+  arma::uword maxIndex = 0;
+  classCounts.max(maxIndex);
+  return size_t(maxIndex);
+}
+
+template<typename FitnessFunction, typename ObservationType>
+double HoeffdingQuantileNumericSplit<FitnessFunction, ObservationType>::
+MajorityProbability() const
+{
+  arma::Col<size_t> classCounts = warmupCounts +
+      arma::sum(sufficientStatistics, 1);
+
+  return double(classCounts.max()) / double(arma::accu(classCounts));
+}
+
+template<typename FitnessFunction, typename ObservationType>
+template<typename Archive>
+void HoeffdingQuantileNumericSplit<FitnessFunction, ObservationType>::
+serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(samplesSeen));
+  ar(CEREAL_NVP(observationsBeforeBinning));
+  ar(CEREAL_NVP(bins));
+  ar(CEREAL_NVP(markerHeights));
+  ar(CEREAL_NVP(markerPositions));
+  ar(CEREAL_NVP(splitPoints));
+  ar(CEREAL_NVP(warmupCounts));
+  ar(CEREAL_NVP(sufficientStatistics));
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -192,6 +192,20 @@ class HoeffdingTree
   template<typename VecType>
   void Train(const VecType& point, const size_t label);
 
+  /**
+   * Train on a mini-batch of points in streaming mode.  The sufficient
+   * statistics of every dimension are accumulated for the whole mini-batch
+   * before a single split check, instead of re-evaluating the split
+   * conditions after every point; for bursty streaming ingestion this is
+   * considerably faster than calling the single-point Train() in a loop and
+   * produces a split decision based on all the points of the batch.
+   *
+   * @param data Mini-batch of points to train on.
+   * @param labels Labels of the points in the mini-batch.
+   */
+  template<typename MatType>
+  void TrainBatch(const MatType& data, const arma::Row<size_t>& labels);
+
   /**
    * Check if a split would satisfy the conditions of the Hoeffding bound with
    * the node's specified success probability.  If so, the number of children
@@ -372,6 +372,79 @@ void HoeffdingTree<
   Train(data, labels, batchTraining);
 }
 
+//! Train on a mini-batch of points with a single split check.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename MatType>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::TrainBatch(const MatType& data, const arma::Row<size_t>& labels)
+{
+  if (data.n_cols == 0)
+    return;
+
+  if (splitDimension == size_t(-1))
+  {
+    // We are a leaf: accumulate the sufficient statistics of every dimension
+    // for the whole mini-batch, then check for a split once.
+    numSamples += data.n_cols;
+    size_t numericIndex = 0;
+    size_t categoricalIndex = 0;
+    for (size_t i = 0; i < data.n_rows; ++i)
+    {
+      if (datasetInfo->Type(i) == data::Datatype::categorical)
+        categoricalSplits[categoricalIndex++].TrainBatch(data.row(i), labels);
+      else if (datasetInfo->Type(i) == data::Datatype::numeric)
+        numericSplits[numericIndex++].TrainBatch(data.row(i), labels);
+    }
+
+    // Grab majority class from splits.
+    if (categoricalSplits.size() > 0)
+    {
+      majorityClass = categoricalSplits[0].MajorityClass();
+      majorityProbability = categoricalSplits[0].MajorityProbability();
+    }
+    else
+    {
+      majorityClass = numericSplits[0].MajorityClass();
+      majorityProbability = numericSplits[0].MajorityProbability();
+    }
+
+    // A single split check for the entire mini-batch.
+    const size_t numChildren = SplitCheck();
+    if (numChildren == 0)
+      return;
+
+    children.clear();
+    CreateChildren();
+  }
+
+  // We have children (either we just split, or we were already split): route
+  // each point of the batch to the right child and recurse in batch mode.
+  std::vector<arma::uvec> indices(children.size(), arma::uvec(data.n_cols));
+  arma::Col<size_t> counts = arma::zeros<arma::Col<size_t>>(children.size());
+
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    const size_t direction = CalculateDirection(data.col(i));
+    indices[direction][counts[direction]++] = i;
+  }
+
+  for (size_t i = 0; i < children.size(); ++i)
+  {
+    if (counts[i] == 0)
+      continue;
+
+    arma::Row<size_t> childLabels = labels.cols(
+        indices[i].subvec(0, counts[i] - 1));
+    MatType childData = data.cols(indices[i].subvec(0, counts[i] - 1));
+    children[i]->TrainBatch(childData, childLabels);
+  }
+}
+
 //! Train on one point.
 template<typename FitnessFunction,
          template<typename> class NumericSplitType,
@@ -30,48 +30,30 @@ class HoeffdingInformationGain
    */
   static double Evaluate(const arma::Mat<size_t>& counts)
   {
-    // Calculate the number of elements in the unsplit node and also in each
-    // proposed child.
-    size_t numElem = 0;
-    arma::vec splitCounts(counts.n_elem);
-    for (size_t i = 0; i < counts.n_cols; ++i)
-    {
-      splitCounts[i] = arma::accu(counts.col(i));
-      numElem += splitCounts[i];
-    }
+    // Work on the stacked counts matrix with vectorized expressions; this is
+    // called once per candidate split per split check, on a (classes x
+    // children) matrix.
+    const arma::mat fCounts = arma::conv_to<arma::mat>::from(counts);
+    const arma::rowvec splitCounts = arma::sum(fCounts, 0);
+    const double numElem = arma::accu(splitCounts);
 
     // Corner case: if there are no elements, the gain is zero.
     if (numElem == 0)
       return 0.0;
 
-    arma::Col<size_t> classCounts = arma::sum(counts, 1);
+    // Entropy of the unsplit node.  Zero fractions are replaced with one so
+    // that their log term vanishes (0 * log(1) == 0).
+    arma::vec classFracs = arma::sum(fCounts, 1) / numElem;
+    classFracs.replace(0.0, 1.0);
+    double gain = -arma::accu(classFracs % arma::log2(classFracs));
 
-    // Calculate the gain of the unsplit node.
-    double gain = 0.0;
-    for (size_t i = 0; i < classCounts.n_elem; ++i)
-    {
-      const double f = ((double) classCounts[i] / (double) numElem);
-      if (f > 0.0)
-        gain -= f * std::log2(f);
-    }
-
-    // Now calculate the impurity of the split nodes and subtract them from the
-    // overall gain.
-    for (size_t i = 0; i < counts.n_cols; ++i)
-    {
-      if (splitCounts[i] > 0)
-      {
-        double splitGain = 0.0;
-        for (size_t j = 0; j < counts.n_rows; ++j)
-        {
-          const double f = ((double) counts(j, i) / (double) splitCounts[i]);
-          if (f > 0.0)
-            splitGain += f * std::log2(f);
-        }
-
-        gain += ((double) splitCounts[i] / (double) numElem) * splitGain;
-      }
-    }
+    // Weighted entropy of the children, computed on the whole matrix at once:
+    // sum_ij (c_ij / N) * log2(c_ij / s_i).  Empty cells (and empty children)
+    // are again masked by replacing zero fractions with one.
+    arma::mat childFracs = fCounts.each_row() /
+        arma::clamp(splitCounts, 1.0, arma::datum::inf);
+    childFracs.replace(0.0, 1.0);
+    gain += arma::accu((fCounts / numElem) % arma::log2(childFracs));
 
     return gain;
   }
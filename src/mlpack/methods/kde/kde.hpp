@@ -16,6 +16,7 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/tree/binary_space_tree.hpp>
 
+#include "kde_rules.hpp"
 #include "kde_stat.hpp"
 
 namespace mlpack {
@@ -290,6 +291,31 @@ class KDE
   //! Modify Monte Carlo break coefficient. (0 < newCoef <= 1).
   void MCBreakCoef(const double newCoef);
 
+  //! Get whether Monte Carlo sample statistics are kept between evaluations.
+  bool MCCheckpointing() const { return mcCheckpointing; }
+
+  //! Modify whether Monte Carlo sample statistics are kept between
+  //! evaluations.  When enabled, a later Evaluate() call over the same query
+  //! set (for example, with a tighter relative error tolerance) refines the
+  //! previously drawn samples instead of resampling from scratch.
+  bool& MCCheckpointing() { return mcCheckpointing; }
+
+  //! Discard any Monte Carlo sample statistics kept from previous
+  //! evaluations.  Call this before evaluating a different query set with
+  //! checkpointing enabled.
+  void ResetMCCheckpoint() { mcCheckpoint.clear(); }
+
+  //! Get whether detailed traversal statistics are collected.
+  bool CollectStatistics() const { return collectStatistics; }
+  //! Modify whether detailed traversal statistics are collected.  When this
+  //! is set to true, every non-parallel Evaluate() call fills the object
+  //! returned by Stats(); collection adds a small overhead to the traversal.
+  bool& CollectStatistics() { return collectStatistics; }
+
+  //! Get the detailed statistics of the last evaluation (only filled if
+  //! CollectStatistics() is set to true).
+  const tree::TraversalStatistics& Stats() const { return stats; }
+
   //! Serialize the model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t version);
@@ -341,6 +367,36 @@ class KDE
   //! is the limit before Monte Carlo estimation recurses.
   double mcBreakCoef;
 
+  //! Whether Monte Carlo sample statistics are kept between evaluations.
+  bool mcCheckpointing;
+
+  //! Accumulated Monte Carlo sample statistics of previous evaluations.  It
+  //! is cleared whenever the model is retrained.
+  typename KDERules<MetricType, KernelType, Tree>::MCCheckpointType
+      mcCheckpoint;
+
+  //! If true, detailed traversal statistics are collected during
+  //! evaluations.
+  bool collectStatistics;
+
+  //! Detailed statistics of the last evaluation.
+  tree::TraversalStatistics stats;
+
+  /**
+   * Evaluate the dual-tree algorithm for the given query tree, distributing
+   * disjoint query subtrees across OpenMP threads when parallelism is
+   * available.  Each thread accumulates densities into its own vector and the
+   * partial results are merged at the end.
+   *
+   * @param queryTree Tree built on the query points.
+   * @param estimations Object which will hold the densities for each query
+   *     point.
+   * @param sameSet Whether query and reference sets are the same.
+   */
+  void EvaluateDualTree(Tree* queryTree,
+                        arma::vec& estimations,
+                        const bool sameSet);
+
   //! Check whether absolute and relative error values are compatible.
   static void CheckErrorValues(const double relError, const double absError);
 
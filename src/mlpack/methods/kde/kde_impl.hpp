@@ -13,6 +13,8 @@
 #include "kde.hpp"
 #include "kde_rules.hpp"
 
+#include <mlpack/core/util/threads.hpp>
+
 namespace mlpack {
 namespace kde {
 
@@ -38,6 +40,34 @@ TreeType* BuildTree(
   return new TreeType(std::forward<MatType>(dataset));
 }
 
+//! Collect disjoint query subtrees that together cover every query point, so
+//! that a dual-tree traversal can be distributed across threads.
+template<typename TreeType>
+void CollectQuerySubtrees(TreeType* queryTree,
+                          const size_t minSubtrees,
+                          std::vector<TreeType*>& subtrees)
+{
+  subtrees.push_back(queryTree);
+
+  // Expand internal nodes into their children until there are enough subtrees
+  // to keep every thread busy or only leaves are left.
+  size_t current = 0;
+  while (subtrees.size() < minSubtrees && current < subtrees.size())
+  {
+    TreeType* node = subtrees[current];
+    if (node->NumChildren() > 0)
+    {
+      subtrees.erase(subtrees.begin() + current);
+      for (size_t i = 0; i < node->NumChildren(); ++i)
+        subtrees.push_back(&node->Child(i));
+    }
+    else
+    {
+      ++current;
+    }
+  }
+}
+
 template<typename KernelType,
          typename MetricType,
          typename MatType,
@@ -72,7 +102,9 @@ KDE(const double relError,
     trained(false),
     mode(mode),
     monteCarlo(monteCarlo),
-    initialSampleSize(initialSampleSize)
+    initialSampleSize(initialSampleSize),
+    mcCheckpointing(false),
+    collectStatistics(false)
 {
   CheckErrorValues(relError, absError);
   MCProb(mcProb);
@@ -106,8 +138,12 @@ KDE(const KDE& other) :
     mcProb(other.mcProb),
     initialSampleSize(other.initialSampleSize),
     mcEntryCoef(other.mcEntryCoef),
-    mcBreakCoef(other.mcBreakCoef)
+    mcBreakCoef(other.mcBreakCoef),
+    mcCheckpointing(other.mcCheckpointing),
+    collectStatistics(other.collectStatistics)
 {
+  // The checkpoint is not copied because its keys point into the tree of the
+  // other model; the copy starts from scratch.
   if (trained)
   {
     if (ownsReferenceTree)
@@ -152,7 +188,11 @@ KDE(KDE&& other) :
     mcProb(other.mcProb),
     initialSampleSize(other.initialSampleSize),
     mcEntryCoef(other.mcEntryCoef),
-    mcBreakCoef(other.mcBreakCoef)
+    mcBreakCoef(other.mcBreakCoef),
+    mcCheckpointing(other.mcCheckpointing),
+    mcCheckpoint(std::move(other.mcCheckpoint)),
+    collectStatistics(other.collectStatistics),
+    stats(std::move(other.stats))
 {
   other.kernel = std::move(KernelType());
   other.metric = std::move(MetricType());
@@ -168,6 +208,9 @@ KDE(KDE&& other) :
   other.initialSampleSize = KDEDefaultParams::initialSampleSize;
   other.mcEntryCoef = KDEDefaultParams::mcEntryCoef;
   other.mcBreakCoef = KDEDefaultParams::mcBreakCoef;
+  other.mcCheckpointing = false;
+  other.mcCheckpoint.clear();
+  other.collectStatistics = false;
 }
 
 template<typename KernelType,
@@ -214,6 +257,10 @@ operator=(KDE other)
   this->initialSampleSize = other.initialSampleSize;
   this->mcEntryCoef = other.mcEntryCoef;
   this->mcBreakCoef = other.mcBreakCoef;
+  this->mcCheckpointing = other.mcCheckpointing;
+  this->mcCheckpoint = std::move(other.mcCheckpoint);
+  this->collectStatistics = other.collectStatistics;
+  this->stats = std::move(other.stats);
 
   return *this;
 }
@@ -277,6 +324,9 @@ Train(MatType referenceSet)
                                         *oldFromNewReferences);
   Timer::Stop("building_reference_tree");
   this->trained = true;
+
+  // Sample statistics of the old reference tree are meaningless now.
+  mcCheckpoint.clear();
 }
 
 template<typename KernelType,
@@ -312,6 +362,9 @@ Train(Tree* referenceTree, std::vector<size_t>* oldFromNewReferences)
   this->referenceTree = referenceTree;
   this->oldFromNewReferences = oldFromNewReferences;
   this->trained = true;
+
+  // Sample statistics of the old reference tree are meaningless now.
+  mcCheckpoint.clear();
 }
 
 template<typename KernelType,
@@ -379,6 +432,9 @@ Evaluate(MatType querySet, arma::vec& estimations)
 
     Timer::Start("computing_kde");
 
+    if (collectStatistics)
+      stats.Reset(querySet.n_cols);
+
     // Evaluate.
     typedef KDERules<MetricType, KernelType, Tree> RuleType;
     RuleType rules = RuleType(referenceTree->Dataset(),
@@ -393,7 +449,9 @@ Evaluate(MatType querySet, arma::vec& estimations)
                               metric,
                               kernel,
                               monteCarlo,
-                              false);
+                              false,
+                              mcCheckpointing ? &mcCheckpoint : NULL,
+                              collectStatistics ? &stats : NULL);
 
     // Create traverser.
     SingleTreeTraversalType<RuleType> traverser(rules);
@@ -401,6 +459,7 @@ Evaluate(MatType querySet, arma::vec& estimations)
     // Traverse for each point.
     for (size_t i = 0; i < querySet.n_cols; ++i)
       traverser.Traverse(i, *referenceTree);
+    rules.FinishBaseCases();
 
     estimations /= referenceTree->Dataset().n_cols;
     Timer::Stop("computing_kde");
@@ -477,33 +536,12 @@ Evaluate(Tree* queryTree,
 
   Timer::Start("computing_kde");
 
-  // Evaluate.
-  typedef KDERules<MetricType, KernelType, Tree> RuleType;
-  RuleType rules = RuleType(referenceTree->Dataset(),
-                            queryTree->Dataset(),
-                            estimations,
-                            relError,
-                            absError,
-                            mcProb,
-                            initialSampleSize,
-                            mcEntryCoef,
-                            mcBreakCoef,
-                            metric,
-                            kernel,
-                            monteCarlo,
-                            false);
-
-  // Create traverser.
-  DualTreeTraversalType<RuleType> traverser(rules);
-  traverser.Traverse(*queryTree, *referenceTree);
-  estimations /= referenceTree->Dataset().n_cols;
+  // Evaluate, distributing query subtrees across threads when possible.
+  EvaluateDualTree(queryTree, estimations, false);
   Timer::Stop("computing_kde");
 
   // Rearrange if necessary.
   RearrangeEstimations(oldFromNewQueries, estimations);
-
-  Log::Info << rules.Scores() << " node combinations were scored." << std::endl;
-  Log::Info << rules.BaseCases() << " base cases were calculated." << std::endl;
 }
 
 template<typename KernelType,
@@ -546,42 +584,50 @@ Evaluate(arma::vec& estimations)
 
   Timer::Start("computing_kde");
 
-  // Evaluate.
-  typedef KDERules<MetricType, KernelType, Tree> RuleType;
-  RuleType rules = RuleType(referenceTree->Dataset(),
-                            referenceTree->Dataset(),
-                            estimations,
-                            relError,
-                            absError,
-                            mcProb,
-                            initialSampleSize,
-                            mcEntryCoef,
-                            mcBreakCoef,
-                            metric,
-                            kernel,
-                            monteCarlo,
-                            true);
-
   if (mode == DUAL_TREE_MODE)
   {
-    // Create traverser.
-    DualTreeTraversalType<RuleType> traverser(rules);
-    traverser.Traverse(*referenceTree, *referenceTree);
+    // Evaluate, distributing query subtrees across threads when possible.
+    EvaluateDualTree(referenceTree, estimations, true);
   }
   else if (mode == SINGLE_TREE_MODE)
   {
+    if (collectStatistics)
+      stats.Reset(referenceTree->Dataset().n_cols);
+
+    // Evaluate.
+    typedef KDERules<MetricType, KernelType, Tree> RuleType;
+    RuleType rules = RuleType(referenceTree->Dataset(),
+                              referenceTree->Dataset(),
+                              estimations,
+                              relError,
+                              absError,
+                              mcProb,
+                              initialSampleSize,
+                              mcEntryCoef,
+                              mcBreakCoef,
+                              metric,
+                              kernel,
+                              monteCarlo,
+                              true,
+                              mcCheckpointing ? &mcCheckpoint : NULL,
+                              collectStatistics ? &stats : NULL);
+
     SingleTreeTraversalType<RuleType> traverser(rules);
     for (size_t i = 0; i < referenceTree->Dataset().n_cols; ++i)
       traverser.Traverse(i, *referenceTree);
+    rules.FinishBaseCases();
+
+    estimations /= referenceTree->Dataset().n_cols;
+
+    Log::Info << rules.Scores() << " node combinations were scored."
+        << std::endl;
+    Log::Info << rules.BaseCases() << " base cases were calculated."
+        << std::endl;
   }
 
-  estimations /= referenceTree->Dataset().n_cols;
   // Rearrange if necessary.
   RearrangeEstimations(*oldFromNewReferences, estimations);
   Timer::Stop("computing_kde");
-
-  Log::Info << rules.Scores() << " node combinations were scored." << std::endl;
-  Log::Info << rules.BaseCases() << " base cases were calculated." << std::endl;
 }
 
 template<typename KernelType,
@@ -724,6 +770,7 @@ serialize(Archive& ar, const uint32_t /* version */)
   ar(CEREAL_NVP(initialSampleSize));
   ar(CEREAL_NVP(mcEntryCoef));
   ar(CEREAL_NVP(mcBreakCoef));
+  ar(CEREAL_NVP(mcCheckpointing));
 
   // If we are loading, clean up memory if necessary.
   if (cereal::is_loading<Archive>())
@@ -735,6 +782,10 @@ serialize(Archive& ar, const uint32_t /* version */)
     }
     // After loading tree, we own it.
     ownsReferenceTree = true;
+
+    // The checkpoint references nodes of the old tree, so it cannot survive
+    // loading.
+    mcCheckpoint.clear();
   }
 
   // Serialize the rest of values.
@@ -744,6 +795,108 @@ serialize(Archive& ar, const uint32_t /* version */)
   ar(CEREAL_POINTER(oldFromNewReferences));
 }
 
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+EvaluateDualTree(Tree* queryTree, arma::vec& estimations, const bool sameSet)
+{
+  typedef KDERules<MetricType, KernelType, Tree> RuleType;
+  size_t scores = 0;
+  size_t baseCases = 0;
+
+  const size_t numThreads = Threads();
+
+  // Monte Carlo estimations update shared reference node statistics during
+  // the traversal, so they can only run on the sequential path.
+  const bool parallel = numThreads > 1 &&
+      !(monteCarlo && std::is_same<KernelType, kernel::GaussianKernel>::value);
+
+  if (parallel)
+  {
+    // Partition the query tree into disjoint subtrees; each one is an
+    // independent dual-tree traversal against the full reference tree.
+    std::vector<Tree*> subtrees;
+    CollectQuerySubtrees(queryTree, 4 * numThreads, subtrees);
+
+    #pragma omp parallel
+    {
+      // Per-thread accumulator.  Every query point belongs to exactly one
+      // subtree, so the merged partial estimates never overlap.
+      arma::vec partialEstimations(estimations.n_elem, arma::fill::zeros);
+      RuleType rules = RuleType(referenceTree->Dataset(),
+                                queryTree->Dataset(),
+                                partialEstimations,
+                                relError,
+                                absError,
+                                mcProb,
+                                initialSampleSize,
+                                mcEntryCoef,
+                                mcBreakCoef,
+                                metric,
+                                kernel,
+                                monteCarlo,
+                                sameSet);
+      DualTreeTraversalType<RuleType> traverser(rules);
+
+      #pragma omp for schedule(dynamic) nowait
+      for (omp_size_t i = 0; i < (omp_size_t) subtrees.size(); ++i)
+        traverser.Traverse(*subtrees[i], *referenceTree);
+      rules.FinishBaseCases();
+
+      #pragma omp critical (KDEEvaluateDualTree)
+      {
+        estimations += partialEstimations;
+        scores += rules.Scores();
+        baseCases += rules.BaseCases();
+      }
+    }
+  }
+  else
+  {
+    if (collectStatistics)
+      stats.Reset(queryTree->Dataset().n_cols);
+
+    RuleType rules = RuleType(referenceTree->Dataset(),
+                              queryTree->Dataset(),
+                              estimations,
+                              relError,
+                              absError,
+                              mcProb,
+                              initialSampleSize,
+                              mcEntryCoef,
+                              mcBreakCoef,
+                              metric,
+                              kernel,
+                              monteCarlo,
+                              sameSet,
+                              mcCheckpointing ? &mcCheckpoint : NULL,
+                              collectStatistics ? &stats : NULL);
+
+    // Create traverser.
+    DualTreeTraversalType<RuleType> traverser(rules);
+    traverser.Traverse(*queryTree, *referenceTree);
+    rules.FinishBaseCases();
+    scores = rules.Scores();
+    baseCases = rules.BaseCases();
+  }
+
+  estimations /= referenceTree->Dataset().n_cols;
+
+  Log::Info << scores << " node combinations were scored." << std::endl;
+  Log::Info << baseCases << " base cases were calculated." << std::endl;
+}
+
 template<typename KernelType,
          typename MetricType,
          typename MatType,
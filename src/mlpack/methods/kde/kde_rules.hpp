@@ -13,19 +13,74 @@
 #ifndef MLPACK_METHODS_KDE_RULES_HPP
 #define MLPACK_METHODS_KDE_RULES_HPP
 
+#include <mlpack/core/math/compensated_accumulator.hpp>
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/core/tree/traversal_statistics.hpp>
+
+#include <map>
 
 namespace mlpack {
 namespace kde {
 
+/**
+ * Accumulated Monte Carlo sample statistics for one combination of reference
+ * node and query point.  When Monte Carlo checkpointing is enabled these
+ * survive between evaluations, so that a later evaluation with a tighter
+ * error tolerance can refine the previous samples instead of resampling from
+ * scratch.
+ */
+struct KDEMCSampleStat
+{
+  //! Sum of the sampled kernel values.
+  double sum;
+
+  //! Sum of the squares of the sampled kernel values.
+  double sumSq;
+
+  //! Number of samples drawn.
+  size_t count;
+
+  KDEMCSampleStat() : sum(0.0), sumSq(0.0), count(0) { }
+};
+
+/**
+ * Utility to detect, at compile time, whether a kernel provides a vectorized
+ * BatchEvaluate() method that evaluates a whole vector of distances at once.
+ */
+template<typename KernelType, typename = void>
+struct KernelSupportsBatchEvaluation : std::false_type { };
+
+template<typename KernelType>
+struct KernelSupportsBatchEvaluation<KernelType, typename std::enable_if<
+    std::is_void<decltype(std::declval<const KernelType&>().BatchEvaluate(
+        std::declval<const arma::vec&>(),
+        std::declval<arma::vec&>()))>::value>::type> : std::true_type { };
+
 /**
  * A dual-tree traversal Rules class for kernel density estimation.  This
  * contains the Score() and BaseCase() implementations.
+ *
+ * Every density is the sum of up to as many terms as there are reference
+ * points, so the rules accumulate through an accumulator policy; the default
+ * compensated policy keeps the rounding error of these long reductions
+ * bounded (which is what makes float32 pipelines numerically safe), and
+ * math::DirectSum<> recovers plain summation.
+ *
+ * @tparam AccumulatorType Accumulator policy used to sum kernel
+ *     contributions into the density vector.
  */
-template<typename MetricType, typename KernelType, typename TreeType>
+template<typename MetricType,
+         typename KernelType,
+         typename TreeType,
+         typename AccumulatorType = math::CompensatedSum<arma::vec>>
 class KDERules
 {
  public:
+  //! Type of the Monte Carlo checkpoint: accumulated sample statistics keyed
+  //! by reference node and query point index.
+  typedef std::map<std::pair<const TreeType*, size_t>, KDEMCSampleStat>
+      MCCheckpointType;
+
   /**
    * Construct KDERules.
    *
@@ -45,6 +100,13 @@ class KDERules
    *                   possible.
    * @param sameSet True if query and reference sets are the same
    *                (monochromatic evaluation).
+   * @param mcCheckpoint If non-NULL, accumulated Monte Carlo sample
+   *                     statistics are read from and written to this
+   *                     checkpoint, so that a later evaluation over the same
+   *                     query set can refine the previous samples.
+   * @param stats If non-NULL, detailed traversal statistics (base cases,
+   *              scores, prunes) are recorded into the given object during
+   *              the traversal.
    */
   KDERules(const arma::mat& referenceSet,
            const arma::mat& querySet,
@@ -58,7 +120,9 @@ class KDERules
            MetricType& metric,
            KernelType& kernel,
            const bool monteCarlo,
-           const bool sameSet);
+           const bool sameSet,
+           MCCheckpointType* mcCheckpoint = NULL,
+           tree::TraversalStatistics* stats = NULL);
 
   //! Base Case.
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
@@ -97,7 +161,44 @@ class KDERules
   //! results.
   size_t MinimumBaseCases() const { return 0; }
 
+  /**
+   * Evaluate any kernel batch that is still pending and fold the accumulated
+   * summation corrections into the densities.  This must be called once the
+   * traversal is over, before the densities are read.
+   */
+  void FinishBaseCases()
+  {
+    FinishBaseCases(KernelSupportsBatchEvaluation<KernelType>());
+    densityAccum.Flush();
+  }
+
  private:
+  //! Flush the pending kernel batch, for kernels with batched evaluation.
+  void FinishBaseCases(std::true_type);
+
+  //! No-op, for kernels without batched evaluation.
+  void FinishBaseCases(std::false_type) { /* Nothing to do. */ }
+
+  /**
+   * Add the kernel value for the given distance to the density of the given
+   * query point.  For kernels with batched evaluation the distance is only
+   * collected here, and the kernel values of a whole batch are computed at
+   * once; for any other kernel the value is evaluated immediately.
+   */
+  void AddKernelValue(const size_t queryIndex,
+                      const double distance,
+                      std::true_type);
+
+  //! Scalar fallback of AddKernelValue() for kernels without batched
+  //! evaluation.
+  void AddKernelValue(const size_t queryIndex,
+                      const double distance,
+                      std::false_type);
+
+  //! Evaluate the collected batch of distances and accumulate the resulting
+  //! kernel values into the densities of their query points.
+  void FlushKernelBatch();
+
   //! Evaluate kernel value of 2 points given their indexes.
   double EvaluateKernel(const size_t queryIndex,
                         const size_t referenceIndex) const;
@@ -109,14 +210,35 @@ class KDERules
   //! Calculate depth alpha for some node.
   double CalculateAlpha(TreeType* node);
 
+  /**
+   * Compute (or, if a checkpoint holds statistics from a previous evaluation,
+   * refine) the Monte Carlo estimation of the mean kernel value between a
+   * query point and the descendants of a reference node.
+   *
+   * @param queryIndex Index of the query point.
+   * @param referenceNode Reference node to sample descendants from.
+   * @param alreadyDidRefPoint0 Whether the first reference point has already
+   *     been taken into account and must not be sampled.
+   * @param z Quantile of the standard normal for the required confidence.
+   * @param meanSample Will be set to the estimated mean kernel value.
+   * @return True if the estimation reached the required confidence; false if
+   *     it would take a similar amount of computation as the exact
+   *     calculation, in which case the caller should recurse.
+   */
+  bool MonteCarloSample(const size_t queryIndex,
+                        TreeType& referenceNode,
+                        const bool alreadyDidRefPoint0,
+                        const double z,
+                        double& meanSample);
+
   //! The reference set.
   const arma::mat& referenceSet;
 
   //! The query set.
   const arma::mat& querySet;
 
-  //! Density values.
-  arma::vec& densities;
+  //! Accumulator for the density values.
+  AccumulatorType densityAccum;
 
   //! Absolute error tolerance.
   const double absError;
@@ -158,10 +280,32 @@ class KDERules
   //! Whether reference and query sets are the same.
   const bool sameSet;
 
+  //! Persistent Monte Carlo sample statistics, or NULL if checkpointing is
+  //! not enabled.
+  MCCheckpointType* mcCheckpoint;
+
+  //! If non-NULL, detailed traversal statistics are recorded here.
+  tree::TraversalStatistics* stats;
+
   //! Whether the kernel used for the rule is the Gaussian Kernel.
   constexpr static bool kernelIsGaussian =
       std::is_same<KernelType, kernel::GaussianKernel>::value;
 
+  //! Number of distances collected before a batched kernel evaluation.
+  constexpr static size_t batchCapacity = 256;
+
+  //! Collected distances of base cases whose kernel value is still pending.
+  arma::vec batchDistances;
+
+  //! Query point index of every collected distance.
+  arma::Col<size_t> batchQueries;
+
+  //! Reusable buffer for the kernel values of a batch.
+  arma::vec batchKernelValues;
+
+  //! Number of distances currently collected.
+  size_t batchSize;
+
   //! Absolute error tolerance available for each reference point.
   const double absErrorTol;
 
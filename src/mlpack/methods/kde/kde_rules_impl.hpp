@@ -22,8 +22,11 @@
 namespace mlpack {
 namespace kde {
 
-template<typename MetricType, typename KernelType, typename TreeType>
-KDERules<MetricType, KernelType, TreeType>::KDERules(
+template<typename MetricType,
+         typename KernelType,
+         typename TreeType,
+         typename AccumulatorType>
+KDERules<MetricType, KernelType, TreeType, AccumulatorType>::KDERules(
     const arma::mat& referenceSet,
     const arma::mat& querySet,
     arma::vec& densities,
@@ -36,10 +39,12 @@ KDERules<MetricType, KernelType, TreeType>::KDERules(
     MetricType& metric,
     KernelType& kernel,
     const bool monteCarlo,
-    const bool sameSet) :
+    const bool sameSet,
+    MCCheckpointType* mcCheckpoint,
+    tree::TraversalStatistics* stats) :
     referenceSet(referenceSet),
     querySet(querySet),
-    densities(densities),
+    densityAccum(densities),
     absError(absError),
     relError(relError),
     mcBeta(1 - mcProb),
@@ -50,9 +55,12 @@ KDERules<MetricType, KernelType, TreeType>::KDERules(
     kernel(kernel),
     monteCarlo(monteCarlo),
     sameSet(sameSet),
+    mcCheckpoint(mcCheckpoint),
+    stats(stats),
     absErrorTol(absError / referenceSet.n_cols),
     lastQueryIndex(querySet.n_cols),
     lastReferenceIndex(referenceSet.n_cols),
+    batchSize(0),
     baseCases(0),
     scores(0)
 {
@@ -62,12 +70,23 @@ KDERules<MetricType, KernelType, TreeType>::KDERules(
   // Initialize accumMCAlpha only if Monte Carlo estimations are available.
   if (monteCarlo && kernelIsGaussian)
     accumMCAlpha = arma::vec(querySet.n_cols, arma::fill::zeros);
+
+  // Allocate the kernel batch buffers only if they are going to be used.
+  if (KernelSupportsBatchEvaluation<KernelType>::value)
+  {
+    batchDistances.set_size(batchCapacity);
+    batchQueries.set_size(batchCapacity);
+    batchKernelValues.set_size(batchCapacity);
+  }
 }
 
 //! The base case.
-template<typename MetricType, typename KernelType, typename TreeType>
+template<typename MetricType,
+         typename KernelType,
+         typename TreeType,
+         typename AccumulatorType>
 inline force_inline
-double KDERules<MetricType, KernelType, TreeType>::BaseCase(
+double KDERules<MetricType, KernelType, TreeType, AccumulatorType>::BaseCase(
     const size_t queryIndex,
     const size_t referenceIndex)
 {
@@ -80,16 +99,16 @@ double KDERules<MetricType, KernelType, TreeType>::BaseCase(
   if ((lastQueryIndex == queryIndex) && (lastReferenceIndex == referenceIndex))
     return 0.0;
 
-  // Calculations.
+  // Calculations.  The kernel evaluation may be deferred and performed in a
+  // vectorized batch if the kernel supports it.
   const double distance = metric.Evaluate(querySet.col(queryIndex),
                                           referenceSet.col(referenceIndex));
-  const double kernelValue = kernel.Evaluate(distance);
-  densities(queryIndex) += kernelValue;
-
-  // Update accumulated relative error tolerance for single-tree pruning.
-  accumError(queryIndex) += 2 * relError * kernelValue;
+  AddKernelValue(queryIndex, distance,
+      KernelSupportsBatchEvaluation<KernelType>());
 
   ++baseCases;
+  if (stats)
+    stats->RecordBaseCase(queryIndex);
   lastQueryIndex = queryIndex;
   lastReferenceIndex = referenceIndex;
   traversalInfo.LastBaseCase() = distance;
@@ -97,8 +116,11 @@ double KDERules<MetricType, KernelType, TreeType>::BaseCase(
 }
 
 //! Single-tree scoring function.
-template<typename MetricType, typename KernelType, typename TreeType>
-inline double KDERules<MetricType, KernelType, TreeType>::
+template<typename MetricType,
+         typename KernelType,
+         typename TreeType,
+         typename AccumulatorType>
+inline double KDERules<MetricType, KernelType, TreeType, AccumulatorType>::
 Score(const size_t queryIndex, TreeType& referenceNode)
 {
   // Auxiliary variables.
@@ -166,9 +188,9 @@ Score(const size_t queryIndex, TreeType& referenceNode)
     const double kernelValue = (maxKernel + minKernel) / 2.0;
 
     if (alreadyDidRefPoint0)
-      densities(queryIndex) += (refNumDesc - 1) * kernelValue;
+      densityAccum.Add(queryIndex, (refNumDesc - 1) * kernelValue);
     else
-      densities(queryIndex) += refNumDesc * kernelValue;
+      densityAccum.Add(queryIndex, refNumDesc * kernelValue);
 
     // Don't explore this tree branch.
     score = DBL_MAX;
@@ -195,59 +217,19 @@ Score(const size_t queryIndex, TreeType& referenceNode)
     const double z =
         std::abs(boost::math::quantile(normalDist, alpha / 2));
 
-    // Auxiliary variables.
-    arma::vec sample;
-    size_t m = initialSampleSize;
-    double meanSample = 0;
-    bool useMonteCarloPredictions = true;
-
-    // Resample as long as confidence is not high enough.
-    while (m > 0)
-    {
-      const size_t oldSize = sample.size();
-      const size_t newSize = oldSize + m;
-
-      // Don't use probabilistic estimation if this is going to take a similar
-      // amount of computations to the exact calculation.
-      if (newSize >= mcBreakCoef * refNumDesc)
-      {
-        useMonteCarloPredictions = false;
-        break;
-      }
-
-      // Increase the sample size.
-      sample.resize(newSize);
-      for (size_t i = 0; i < m; ++i)
-      {
-        // Sample and evaluate random points from the reference node.
-        size_t randomPoint;
-        if (alreadyDidRefPoint0)
-          randomPoint = math::RandInt(1, refNumDesc);
-        else
-          randomPoint = math::RandInt(0, refNumDesc);
-
-        sample(oldSize + i) =
-            EvaluateKernel(queryIndex, referenceNode.Descendant(randomPoint));
-      }
-      meanSample = arma::mean(sample);
-      const double stddev = arma::stddev(sample);
-      const double mThreshBase =
-          z * stddev * (1 + relError) / (relError * meanSample);
-      const size_t mThresh = std::ceil(mThreshBase * mThreshBase);
-
-      if (sample.size() < mThresh)
-        m = mThresh - sample.size();
-      else
-        m = 0;
-    }
+    // Compute (or refine, if a checkpoint from a previous evaluation is
+    // available) the Monte Carlo estimation of the mean kernel value.
+    double meanSample;
+    const bool useMonteCarloPredictions = MonteCarloSample(queryIndex,
+        referenceNode, alreadyDidRefPoint0, z, meanSample);
 
     if (useMonteCarloPredictions)
     {
       // Confidence is high enough so we can use Monte Carlo estimation.
       if (alreadyDidRefPoint0)
-        densities(queryIndex) += (refNumDesc - 1) * meanSample;
+        densityAccum.Add(queryIndex, (refNumDesc - 1) * meanSample);
       else
-        densities(queryIndex) += refNumDesc * meanSample;
+        densityAccum.Add(queryIndex, refNumDesc * meanSample);
 
       // Prune.
       score = DBL_MAX;
@@ -288,13 +270,23 @@ Score(const size_t queryIndex, TreeType& referenceNode)
   }
 
   ++scores;
+  if (stats)
+  {
+    stats->RecordScore();
+    if (score == DBL_MAX)
+      stats->RecordPrune();
+  }
   traversalInfo.LastReferenceNode() = &referenceNode;
   traversalInfo.LastScore() = score;
   return score;
 }
 
-template<typename MetricType, typename KernelType, typename TreeType>
-inline force_inline double KDERules<MetricType, KernelType, TreeType>::
+template<typename MetricType,
+         typename KernelType,
+         typename TreeType,
+         typename AccumulatorType>
+inline force_inline double
+KDERules<MetricType, KernelType, TreeType, AccumulatorType>::
 Rescore(const size_t /* queryIndex */,
         TreeType& /* referenceNode */,
         const double oldScore) const
@@ -304,8 +296,11 @@ Rescore(const size_t /* queryIndex */,
 }
 
 //! Dual-tree scoring function.
-template<typename MetricType, typename KernelType, typename TreeType>
-inline double KDERules<MetricType, KernelType, TreeType>::
+template<typename MetricType,
+         typename KernelType,
+         typename TreeType,
+         typename AccumulatorType>
+inline double KDERules<MetricType, KernelType, TreeType, AccumulatorType>::
 Score(TreeType& queryNode, TreeType& referenceNode)
 {
   kde::KDEStat& queryStat = queryNode.Stat();
@@ -377,9 +372,12 @@ Score(TreeType& queryNode, TreeType& referenceNode)
     for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
     {
       if (alreadyDidRefPoint0 && i == 0)
-        densities(queryNode.Descendant(i)) += (refNumDesc - 1) * kernelValue;
+      {
+        densityAccum.Add(queryNode.Descendant(i),
+            (refNumDesc - 1) * kernelValue);
+      }
       else
-        densities(queryNode.Descendant(i)) += refNumDesc * kernelValue;
+        densityAccum.Add(queryNode.Descendant(i), refNumDesc * kernelValue);
     }
 
     // Prune.
@@ -405,58 +403,19 @@ Score(TreeType& queryNode, TreeType& referenceNode)
         std::abs(boost::math::quantile(normalDist, alpha / 2));
 
     // Auxiliary variables.
-    arma::vec sample;
     arma::vec means = arma::zeros(queryNode.NumDescendants());
-    size_t m;
-    double meanSample = 0;
+    double meanSample;
     bool useMonteCarloPredictions = true;
 
     // Pick a sample for every query node.
     for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
     {
       const size_t queryIndex = queryNode.Descendant(i);
-      sample.clear();
-      m = initialSampleSize;
 
-      // Resample as long as confidence is not high enough.
-      while (m > 0)
-      {
-        const size_t oldSize = sample.size();
-        const size_t newSize = oldSize + m;
-
-        // Don't use probabilistic estimation if this is going to take a similar
-        // amount of computations to the exact calculation.
-        if (newSize >= mcBreakCoef * refNumDesc)
-        {
-          useMonteCarloPredictions = false;
-          break;
-        }
-
-        // Increase the sample size.
-        sample.resize(newSize);
-        for (size_t i = 0; i < m; ++i)
-        {
-          // Sample and evaluate random points from the reference node.
-          size_t randomPoint;
-          if (alreadyDidRefPoint0)
-            randomPoint = math::RandInt(1, refNumDesc);
-          else
-            randomPoint = math::RandInt(0, refNumDesc);
-
-          sample(oldSize + i) =
-              EvaluateKernel(queryIndex, referenceNode.Descendant(randomPoint));
-        }
-        meanSample = arma::mean(sample);
-        const double stddev = arma::stddev(sample);
-        const double mThreshBase =
-            z * stddev * (1 + relError) / (relError * meanSample);
-        const size_t mThresh = std::ceil(mThreshBase * mThreshBase);
-
-        if (sample.size() < mThresh)
-          m = mThresh - sample.size();
-        else
-          m = 0;
-      }
+      // Compute (or refine, if a checkpoint from a previous evaluation is
+      // available) the Monte Carlo estimation of the mean kernel value.
+      useMonteCarloPredictions = MonteCarloSample(queryIndex, referenceNode,
+          alreadyDidRefPoint0, z, meanSample);
 
       // Store mean for the i_th query node descendant point.
       if (useMonteCarloPredictions)
@@ -471,9 +430,12 @@ Score(TreeType& queryNode, TreeType& referenceNode)
       for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
       {
         if (alreadyDidRefPoint0 && i == 0)
-          densities(queryNode.Descendant(i)) += (refNumDesc - 1) * means(i);
+        {
+          densityAccum.Add(queryNode.Descendant(i),
+              (refNumDesc - 1) * means(i));
+        }
         else
-          densities(queryNode.Descendant(i)) += refNumDesc * means(i);
+          densityAccum.Add(queryNode.Descendant(i), refNumDesc * means(i));
       }
 
       // Prune.
@@ -511,6 +473,12 @@ Score(TreeType& queryNode, TreeType& referenceNode)
   }
 
   ++scores;
+  if (stats)
+  {
+    stats->RecordScore();
+    if (score == DBL_MAX)
+      stats->RecordPrune();
+  }
   traversalInfo.LastQueryNode() = &queryNode;
   traversalInfo.LastReferenceNode() = &referenceNode;
   traversalInfo.LastScore() = score;
@@ -518,8 +486,12 @@ Score(TreeType& queryNode, TreeType& referenceNode)
 }
 
 //! Dual-tree rescore.
-template<typename MetricType, typename KernelType, typename TreeType>
-inline force_inline double KDERules<MetricType, KernelType, TreeType>::
+template<typename MetricType,
+         typename KernelType,
+         typename TreeType,
+         typename AccumulatorType>
+inline force_inline double
+KDERules<MetricType, KernelType, TreeType, AccumulatorType>::
 Rescore(TreeType& /*queryNode*/,
         TreeType& /*referenceNode*/,
         const double oldScore) const
@@ -528,8 +500,12 @@ Rescore(TreeType& /*queryNode*/,
   return oldScore;
 }
 
-template<typename MetricType, typename KernelType, typename TreeType>
-inline force_inline double KDERules<MetricType, KernelType, TreeType>::
+template<typename MetricType,
+         typename KernelType,
+         typename TreeType,
+         typename AccumulatorType>
+inline force_inline double
+KDERules<MetricType, KernelType, TreeType, AccumulatorType>::
 EvaluateKernel(const size_t queryIndex,
                const size_t referenceIndex) const
 {
@@ -537,15 +513,188 @@ EvaluateKernel(const size_t queryIndex,
                         referenceSet.unsafe_col(referenceIndex));
 }
 
-template<typename MetricType, typename KernelType, typename TreeType>
-inline force_inline double KDERules<MetricType, KernelType, TreeType>::
+template<typename MetricType,
+         typename KernelType,
+         typename TreeType,
+         typename AccumulatorType>
+inline force_inline double
+KDERules<MetricType, KernelType, TreeType, AccumulatorType>::
 EvaluateKernel(const arma::vec& query, const arma::vec& reference) const
 {
   return kernel.Evaluate(metric.Evaluate(query, reference));
 }
 
-template<typename MetricType, typename KernelType, typename TreeType>
-inline force_inline double KDERules<MetricType, KernelType, TreeType>::
+template<typename MetricType,
+         typename KernelType,
+         typename TreeType,
+         typename AccumulatorType>
+inline bool KDERules<MetricType, KernelType, TreeType, AccumulatorType>::
+MonteCarloSample(const size_t queryIndex,
+                 TreeType& referenceNode,
+                 const bool alreadyDidRefPoint0,
+                 const double z,
+                 double& meanSample)
+{
+  const size_t refNumDesc = referenceNode.NumDescendants();
+
+  // Restore accumulated sample statistics from a previous evaluation if a
+  // checkpoint is available.
+  KDEMCSampleStat stat;
+  if (mcCheckpoint != NULL)
+  {
+    typename MCCheckpointType::const_iterator it =
+        mcCheckpoint->find(std::make_pair(&referenceNode, queryIndex));
+    if (it != mcCheckpoint->end())
+      stat = it->second;
+  }
+  const size_t priorCount = stat.count;
+
+  size_t m = initialSampleSize;
+  meanSample = 0;
+  bool useMonteCarloPredictions = true;
+
+  // If samples from a previous evaluation are available, check whether they
+  // already reach the required confidence before drawing any new ones.
+  if (stat.count >= 2)
+  {
+    meanSample = stat.sum / stat.count;
+    const double variance = std::max(0.0,
+        (stat.sumSq - stat.count * meanSample * meanSample) /
+        (stat.count - 1));
+    const double mThreshBase = z * std::sqrt(variance) * (1 + relError) /
+        (relError * meanSample);
+    const size_t mThresh = std::ceil(mThreshBase * mThreshBase);
+
+    if (stat.count < mThresh)
+      m = mThresh - stat.count;
+    else
+      m = 0;
+  }
+
+  // Resample as long as confidence is not high enough.
+  while (m > 0)
+  {
+    // Don't use probabilistic estimation if this is going to take a similar
+    // amount of computations to the exact calculation.  Samples restored from
+    // the checkpoint have already been paid for, so only new samples count.
+    if ((stat.count - priorCount) + m >= mcBreakCoef * refNumDesc)
+    {
+      useMonteCarloPredictions = false;
+      break;
+    }
+
+    // Increase the sample size.
+    for (size_t i = 0; i < m; ++i)
+    {
+      // Sample and evaluate random points from the reference node.
+      size_t randomPoint;
+      if (alreadyDidRefPoint0)
+        randomPoint = math::RandInt(1, refNumDesc);
+      else
+        randomPoint = math::RandInt(0, refNumDesc);
+
+      const double value =
+          EvaluateKernel(queryIndex, referenceNode.Descendant(randomPoint));
+      stat.sum += value;
+      stat.sumSq += value * value;
+    }
+    stat.count += m;
+
+    meanSample = stat.sum / stat.count;
+    const double variance = std::max(0.0,
+        (stat.sumSq - stat.count * meanSample * meanSample) /
+        (stat.count - 1));
+    const double mThreshBase = z * std::sqrt(variance) * (1 + relError) /
+        (relError * meanSample);
+    const size_t mThresh = std::ceil(mThreshBase * mThreshBase);
+
+    if (stat.count < mThresh)
+      m = mThresh - stat.count;
+    else
+      m = 0;
+  }
+
+  // Persist the refined statistics for later evaluations.
+  if (mcCheckpoint != NULL && stat.count > priorCount)
+    (*mcCheckpoint)[std::make_pair(&referenceNode, queryIndex)] = stat;
+
+  return useMonteCarloPredictions;
+}
+
+template<typename MetricType,
+         typename KernelType,
+         typename TreeType,
+         typename AccumulatorType>
+inline void KDERules<MetricType, KernelType, TreeType, AccumulatorType>::
+FinishBaseCases(std::true_type)
+{
+  if (batchSize > 0)
+    FlushKernelBatch();
+}
+
+template<typename MetricType,
+         typename KernelType,
+         typename TreeType,
+         typename AccumulatorType>
+inline force_inline void
+KDERules<MetricType, KernelType, TreeType, AccumulatorType>::
+AddKernelValue(const size_t queryIndex,
+               const double distance,
+               std::true_type)
+{
+  // Collect the distance; the kernel values of the whole batch are computed
+  // at once when the buffer fills up (or when FinishBaseCases() is called).
+  if (batchSize == batchCapacity)
+    FlushKernelBatch();
+
+  batchDistances[batchSize] = distance;
+  batchQueries[batchSize] = queryIndex;
+  ++batchSize;
+}
+
+template<typename MetricType,
+         typename KernelType,
+         typename TreeType,
+         typename AccumulatorType>
+inline force_inline void
+KDERules<MetricType, KernelType, TreeType, AccumulatorType>::
+AddKernelValue(const size_t queryIndex,
+               const double distance,
+               std::false_type)
+{
+  const double kernelValue = kernel.Evaluate(distance);
+  densityAccum.Add(queryIndex, kernelValue);
+
+  // Update accumulated relative error tolerance for single-tree pruning.
+  accumError(queryIndex) += 2 * relError * kernelValue;
+}
+
+template<typename MetricType,
+         typename KernelType,
+         typename TreeType,
+         typename AccumulatorType>
+inline void KDERules<MetricType, KernelType, TreeType, AccumulatorType>::
+FlushKernelBatch()
+{
+  // Evaluate the whole batch with one vectorized call, then scatter the
+  // kernel values to the densities of their query points.  The accumulated
+  // error tolerance lags behind by at most one batch, which can only make
+  // pruning more conservative.
+  kernel.BatchEvaluate(batchDistances.head(batchSize), batchKernelValues);
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    densityAccum.Add(batchQueries[i], batchKernelValues[i]);
+    accumError(batchQueries[i]) += 2 * relError * batchKernelValues[i];
+  }
+  batchSize = 0;
+}
+
+template<typename MetricType,
+         typename KernelType,
+         typename TreeType,
+         typename AccumulatorType>
+inline force_inline double
+KDERules<MetricType, KernelType, TreeType, AccumulatorType>::
 CalculateAlpha(TreeType* node)
 {
   KDEStat& stat = node->Stat();
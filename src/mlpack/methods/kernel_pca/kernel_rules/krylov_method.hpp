@@ -0,0 +1,141 @@
+/**
+ * @file methods/kernel_pca/kernel_rules/krylov_method.hpp
+ *
+ * Use a randomized block Krylov eigensolver to compute only the top
+ * eigenpairs of the centered kernel matrix.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef MLPACK_METHODS_KERNEL_PCA_KRYLOV_METHOD_HPP
+#define MLPACK_METHODS_KERNEL_PCA_KRYLOV_METHOD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/kernel_matrix.hpp>
+
+namespace mlpack {
+namespace kpca {
+
+/**
+ * The naive rule eigendecomposes the full centered kernel matrix for all n
+ * eigenpairs, which is O(n^3) even when only a few components are wanted.
+ * This rule instead extracts the top `rank` eigenpairs with a randomized
+ * block Krylov projection (in the style of RandomizedBlockKrylovSVD): a
+ * random block is propagated through a few applications of the centered
+ * kernel operator, the resulting basis is orthonormalized, and a
+ * Rayleigh-Ritz projection reduces the eigenproblem to the basis width.
+ *
+ * The centering C K C (with C = I - 1 1^T / n) is never materialized; the
+ * operator is applied to blocks as mean subtractions around one product with
+ * the plain kernel matrix.
+ */
+template<typename KernelType>
+class KrylovKernelRule
+{
+ public:
+  /**
+   * Construct the exact kernel matrix and compute the top `rank` eigenpairs
+   * of its centered version with a randomized block Krylov projection.
+   *
+   * @param data Input data points.
+   * @param transformedData Matrix to output results into.
+   * @param eigval KPCA eigenvalues will be written to this vector.
+   * @param eigvec KPCA eigenvectors will be written to this matrix.
+   * @param rank Number of eigenpairs to extract.
+   * @param kernel Kernel to be used for computation.
+   */
+  static void ApplyKernelMatrix(const arma::mat& data,
+                                arma::mat& transformedData,
+                                arma::vec& eigval,
+                                arma::mat& eigvec,
+                                const size_t rank,
+                                KernelType kernel = KernelType())
+  {
+    // Construct the kernel matrix, in blocks of matrix products where the
+    // kernel allows it (see PairwiseKernelMatrix()).
+    arma::mat kernelMatrix;
+    kernel::PairwiseKernelMatrix(data, data, kernel, kernelMatrix);
+    kernelMatrix = arma::symmatu(kernelMatrix);
+
+    const size_t n = kernelMatrix.n_cols;
+    if (rank == 0)
+    {
+      Log::Fatal << "KrylovKernelRule::ApplyKernelMatrix(): rank must be "
+          << "greater than 0!" << std::endl;
+    }
+    const size_t k = std::min(rank, n);
+
+    // Apply the centered kernel operator y = C K C x without materializing
+    // the centered matrix: centering is just a per-column mean subtraction
+    // before and after one product with the kernel matrix.
+    auto centeredProduct = [&kernelMatrix](const arma::mat& x) -> arma::mat
+    {
+      arma::mat centered = x;
+      centered.each_row() -= arma::mean(x, 0);
+      arma::mat result = kernelMatrix * centered;
+      result.each_row() -= arma::mean(result, 0);
+      return result;
+    };
+
+    // Build the block Krylov basis [B, (CKC) B, (CKC)^2 B] from a random
+    // starting block; oversampling the block beyond k sharpens the top Ritz
+    // values.
+    const size_t blockSize = std::min(k + 10, n);
+    const size_t width = std::min(3 * blockSize, n);
+
+    arma::mat basis(n, width);
+    arma::mat block = centeredProduct(arma::randn<arma::mat>(n, blockSize));
+    size_t offset = 0;
+    while (offset < width)
+    {
+      const size_t cols = std::min(blockSize, width - offset);
+      basis.cols(offset, offset + cols - 1) = block.cols(0, cols - 1);
+      offset += cols;
+      if (offset < width)
+        block = centeredProduct(block);
+    }
+
+    // Orthonormalize the basis, then solve the small projected eigenproblem
+    // (Rayleigh-Ritz).
+    arma::mat q, r;
+    if (!arma::qr_econ(q, r, basis))
+    {
+      Log::Fatal << "Failed to orthonormalize the Krylov basis." << std::endl;
+    }
+
+    arma::mat projected = q.t() * centeredProduct(q);
+    projected = 0.5 * (projected + projected.t());
+
+    arma::vec ritzval;
+    arma::mat ritzvec;
+    if (!arma::eig_sym(ritzval, ritzvec, projected))
+    {
+      Log::Fatal << "Failed to eigendecompose the projected kernel matrix."
+          << std::endl;
+    }
+
+    // eig_sym() orders the eigenvalues ascending; keep the largest k pairs,
+    // largest to smallest.
+    eigval.set_size(k);
+    arma::mat ritzTop(q.n_cols, k);
+    for (size_t i = 0; i < k; ++i)
+    {
+      eigval[i] = ritzval[ritzval.n_elem - 1 - i];
+      ritzTop.col(i) = ritzvec.col(ritzvec.n_cols - 1 - i);
+    }
+    eigvec = q * ritzTop;
+
+    // transformedData = eigvec^T (C K C), again through the implicit
+    // operator.
+    transformedData = centeredProduct(eigvec).t();
+    transformedData.each_col() /= arma::sqrt(eigval);
+  }
+};
+
+} // namespace kpca
+} // namespace mlpack
+
+#endif
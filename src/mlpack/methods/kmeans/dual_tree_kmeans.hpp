@@ -110,14 +110,21 @@ class DualTreeKMeans
 
   arma::mat interclusterDistances; // Static storage for intercluster distances.
 
+  //! The tree depth down to which UpdateTree() spawns subtree tasks; below
+  //! this depth the recursion proceeds serially inside each task.
+  static const size_t maxParallelDepth = 4;
+
   //! Update the bounds in the tree before the next iteration.
   //! centroids is the current (not yet searched) centroids.
+  //! The recursion descends into sibling subtrees in parallel; depth tracks
+  //! how far below the root we are so task creation can be cut off.
   void UpdateTree(Tree& node,
                   const arma::mat& centroids,
                   const double parentUpperBound = 0.0,
                   const double adjustedParentUpperBound = DBL_MAX,
                   const double parentLowerBound = DBL_MAX,
-                  const double adjustedParentLowerBound = 0.0);
+                  const double adjustedParentLowerBound = 0.0,
+                  const size_t depth = 0);
 
   //! Extract the centroids of the clusters.
   void ExtractCentroids(Tree& node,
@@ -125,6 +132,14 @@ class DualTreeKMeans
                         arma::Col<size_t>& newCounts,
                         const arma::mat& centroids);
 
+  //! Walk the tree and collect the nodes entirely owned by one cluster and
+  //! the unowned leaves, whose contributions ExtractCentroids() then
+  //! accumulates in parallel.
+  void CollectCentroidNodes(Tree& node,
+                            std::vector<Tree*>& ownedNodes,
+                            std::vector<Tree*>& unownedLeaves,
+                            const size_t clusters);
+
   void CoalesceTree(Tree& node, const size_t child = 0);
   void DecoalesceTree(Tree& node);
 };
@@ -136,6 +136,11 @@ double DualTreeKMeans<MetricType, MatType, TreeType>::Iterate(
 
     Timer::Stop("knn");
 
+    // UpdateTree() spawns tasks for sibling subtrees, so open the thread
+    // team here; the single construct issues the root call once and the
+    // other threads pick up the spawned subtree tasks.
+    #pragma omp parallel
+    #pragma omp single
     UpdateTree(*tree, centroids);
 
     for (size_t i = 0; i < dataset.n_cols; ++i)
@@ -217,7 +222,8 @@ void DualTreeKMeans<MetricType, MatType, TreeType>::UpdateTree(
     const double parentUpperBound,
     const double adjustedParentUpperBound,
     const double parentLowerBound,
-    const double adjustedParentLowerBound)
+    const double adjustedParentLowerBound,
+    const size_t depth)
 {
   const bool prunedLastIteration = node.Stat().StaticPruned();
   node.Stat().StaticPruned() = false;
@@ -328,6 +334,7 @@ visited[node.Descendant(i)] << ".\n";
                    node.MaxDistance(centroids.col(node.Stat().Owner())));
       adjustedUpperBound = node.Stat().UpperBound();
 
+      #pragma omp atomic
       ++distanceCalculations;
       if (node.Stat().UpperBound() < node.Stat().LowerBound())
         node.Stat().StaticPruned() = true;
@@ -339,12 +346,22 @@ visited[node.Descendant(i)] << ".\n";
   }
 
   // Recurse into children, and if all the children (and all the points) are
-  // pruned, then we can mark this as statically pruned.
+  // pruned, then we can mark this as statically pruned.  Sibling subtrees
+  // only touch the statistics of their own nodes and the per-point state of
+  // their own (disjoint) point sets, so they can be refreshed in parallel;
+  // tasks are only spawned near the top of the tree to bound the overhead.
   bool allChildrenPruned = true;
   for (size_t i = 0; i < node.NumChildren(); ++i)
   {
+    #pragma omp task default(shared) firstprivate(i) \
+        if (depth < maxParallelDepth)
     UpdateTree(node.Child(i), centroids, unadjustedUpperBound,
-        adjustedUpperBound, unadjustedLowerBound, adjustedLowerBound);
+        adjustedUpperBound, unadjustedLowerBound, adjustedLowerBound,
+        depth + 1);
+  }
+  #pragma omp taskwait
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+  {
     if (!node.Child(i).Stat().StaticPruned())
       allChildrenPruned = false;
   }
@@ -400,6 +417,7 @@ visited[node.Descendant(i)] << ".\n";
         // Attempt to tighten the bound.
         upperBounds[index] = metric.Evaluate(dataset.col(index),
                                              centroids.col(owner));
+        #pragma omp atomic
         ++distanceCalculations;
         if (upperBounds[index] < pruningLowerBound)
         {
@@ -480,26 +498,82 @@ void DualTreeKMeans<MetricType, MatType, TreeType>::ExtractCentroids(
     Tree& node,
     arma::mat& newCentroids,
     arma::Col<size_t>& newCounts,
-    const arma::mat& centroids)
+    const arma::mat& /* centroids */)
+{
+  // First collect the work: the nodes entirely owned by one cluster, and the
+  // leaves whose points have to be accumulated individually.  The collection
+  // walk is cheap; the accumulation below is where the time goes, so that is
+  // what runs in parallel.
+  std::vector<Tree*> ownedNodes;
+  std::vector<Tree*> unownedLeaves;
+  CollectCentroidNodes(node, ownedNodes, unownedLeaves, newCentroids.n_cols);
+
+  // Accumulate into per-thread buffers to avoid synchronizing on every
+  // contribution; clusters are merged once per thread at the end.
+  #pragma omp parallel
+  {
+    arma::mat localCentroids(newCentroids.n_rows, newCentroids.n_cols,
+        arma::fill::zeros);
+    arma::Col<size_t> localCounts(newCounts.n_elem, arma::fill::zeros);
+
+    #pragma omp for schedule(static) nowait
+    for (omp_size_t i = 0; i < (omp_size_t) ownedNodes.size(); ++i)
+    {
+      const Tree& ownedNode = *ownedNodes[i];
+      const size_t owner = ownedNode.Stat().Owner();
+      localCentroids.col(owner) += ownedNode.Stat().Centroid() *
+          ownedNode.NumDescendants();
+      localCounts[owner] += ownedNode.NumDescendants();
+    }
+
+    #pragma omp for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) unownedLeaves.size(); ++i)
+    {
+      const Tree& leaf = *unownedLeaves[i];
+      for (size_t j = 0; j < leaf.NumPoints(); ++j)
+      {
+        const size_t owner = assignments[leaf.Point(j)];
+        localCentroids.col(owner) += dataset.col(leaf.Point(j));
+        ++localCounts[owner];
+      }
+    }
+
+    #pragma omp critical (DualTreeKMeansExtractCentroids)
+    {
+      newCentroids += localCentroids;
+      newCounts += localCounts;
+    }
+  }
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void DualTreeKMeans<MetricType, MatType, TreeType>::CollectCentroidNodes(
+    Tree& node,
+    std::vector<Tree*>& ownedNodes,
+    std::vector<Tree*>& unownedLeaves,
+    const size_t clusters)
 {
   // Does this node own points?
-  if ((node.Stat().Pruned() == newCentroids.n_cols) ||
-      (node.Stat().StaticPruned() && node.Stat().Owner() < newCentroids.n_cols))
+  if ((node.Stat().Pruned() == clusters) ||
+      (node.Stat().StaticPruned() && node.Stat().Owner() < clusters))
   {
-    const size_t owner = node.Stat().Owner();
-    newCentroids.col(owner) += node.Stat().Centroid() * node.NumDescendants();
-    newCounts[owner] += node.NumDescendants();
+    ownedNodes.push_back(&node);
 
     // Perform the sanity check here.
 /*
+    const size_t owner = node.Stat().Owner();
     for (size_t i = 0; i < node.NumDescendants(); ++i)
     {
       const size_t index = node.Descendant(i);
-      arma::vec trueDistances(centroids.n_cols);
-      for (size_t j = 0; j < centroids.n_cols; ++j)
+      arma::vec trueDistances(lastIterationCentroids.n_cols);
+      for (size_t j = 0; j < lastIterationCentroids.n_cols; ++j)
       {
         const double dist = metric.Evaluate(dataset.col(index),
-                                            centroids.col(j));
+                                            lastIterationCentroids.col(j));
         trueDistances[j] = dist;
       }
 
@@ -523,25 +597,23 @@ node.Stat().UpperBound() << " and owner " << node.Stat().Owner() << ".\n";
     // Only check at leaves.
     if (node.NumChildren() == 0)
     {
-      for (size_t i = 0; i < node.NumPoints(); ++i)
-      {
-        const size_t owner = assignments[node.Point(i)];
-        newCentroids.col(owner) += dataset.col(node.Point(i));
-        ++newCounts[owner];
+      unownedLeaves.push_back(&node);
 
 /*
+      for (size_t i = 0; i < node.NumPoints(); ++i)
+      {
         const size_t index = node.Point(i);
-        arma::vec trueDistances(centroids.n_cols);
-        for (size_t j = 0; j < centroids.n_cols; ++j)
+        arma::vec trueDistances(lastIterationCentroids.n_cols);
+        for (size_t j = 0; j < lastIterationCentroids.n_cols; ++j)
         {
           const double dist = metric.Evaluate(dataset.col(index),
-                                              centroids.col(j));
+                                              lastIterationCentroids.col(j));
           trueDistances[j] = dist;
         }
 
         arma::uword minIndex;
         const double minDist = trueDistances.min(minIndex);
-        if (size_t(minIndex) != owner)
+        if (size_t(minIndex) != assignments[index])
         {
           Log::Warn << node;
           Log::Warn << trueDistances.t();
@@ -554,13 +626,13 @@ assignments[node.Point(i)] << " with ub " << upperBounds[node.Point(i)] <<
 (visited[node.Point(i)] ? "true"
 : "false") << ".\n";
         }
-*/
       }
+*/
     }
 
     // The node is not entirely owned by a cluster.  Recurse.
     for (size_t i = 0; i < node.NumChildren(); ++i)
-      ExtractCentroids(node.Child(i), newCentroids, newCounts, centroids);
+      CollectCentroidNodes(node.Child(i), ownedNodes, unownedLeaves, clusters);
   }
 }
 
@@ -38,6 +38,20 @@ class ElkanKMeans
 
   size_t DistanceCalculations() const { return distanceCalculations; }
 
+  //! Get the fraction of point-centroid comparisons that the bounds pruned
+  //! during the last call to Iterate().
+  double PruneRate() const { return pruneRate; }
+
+  /**
+   * Invalidate the bound state of the given point, forcing it to be fully
+   * re-evaluated against all centroids on the next iteration.  Use this when
+   * a point has changed between warm-started runs (see the warm-start
+   * overload of KMeans::Cluster()).
+   *
+   * @param index Index of the point whose bounds should be invalidated.
+   */
+  void InvalidateBounds(const size_t index);
+
  private:
   //! The dataset.
   const MatType& dataset;
@@ -59,6 +73,10 @@ class ElkanKMeans
 
   //! Track distance calculations.
   size_t distanceCalculations;
+  //! Point-centroid comparisons pruned during the last iteration.
+  size_t prunedPairs;
+  //! Fraction of point-centroid comparisons pruned during the last iteration.
+  double pruneRate;
 };
 
 } // namespace kmeans
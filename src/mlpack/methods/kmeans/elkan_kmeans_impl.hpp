@@ -23,7 +23,9 @@ ElkanKMeans<MetricType, MatType>::ElkanKMeans(const MatType& dataset,
                                               MetricType& metric) :
     dataset(dataset),
     metric(metric),
-    distanceCalculations(0)
+    distanceCalculations(0),
+    prunedPairs(0),
+    pruneRate(0.0)
 {
   // Nothing to do here.
 }
@@ -42,10 +44,6 @@ double ElkanKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
   // all centers.  This is O(k^2).
   clusterDistances.set_size(centroids.n_cols, centroids.n_cols);
 
-  // Self-distances are always 0, but we set them to DBL_MAX to avoid the self
-  // being the closest cluster centroid.
-  clusterDistances.diag().fill(DBL_MAX);
-
   // Initially set r(x) to true.
   std::vector<bool> mustRecalculate(dataset.n_cols, true);
 
@@ -62,24 +60,54 @@ double ElkanKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
   }
 
   // Step 1: for all centers, compute between-cluster distances.  For all
-  // centers, compute s(c) = 1/2 min d(c, c').
-  for (size_t i = 0; i < centroids.n_cols; ++i)
+  // centers, compute s(c) = 1/2 min d(c, c').  At large k this O(k^2) phase
+  // dominates the iteration, so for the Euclidean metric we expand
+  // d(i, j)^2 = ||c_i||^2 + ||c_j||^2 - 2 c_i' c_j and compute the whole
+  // distance matrix from one (blocked, multithreaded) matrix product and a
+  // cached vector of centroid norms, as GemmKMeans does for point-centroid
+  // distances.  Other metrics fall back to the pairwise loop, parallelized
+  // over rows of the symmetric distance matrix.
+  if (std::is_same<MetricType, metric::EuclideanDistance>::value)
   {
-    for (size_t j = i + 1; j < centroids.n_cols; ++j)
+    const arma::vec centroidNorms = arma::sum(arma::square(centroids), 0).t();
+    clusterDistances = -2.0 * (centroids.t() * centroids);
+    clusterDistances.each_col() += centroidNorms;
+    clusterDistances.each_row() += centroidNorms.t();
+    // Cancellation in the expansion can push tiny squared distances slightly
+    // below zero; clamp before taking the square root.
+    clusterDistances = arma::sqrt(arma::clamp(clusterDistances, 0.0,
+        DBL_MAX));
+  }
+  else
+  {
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) centroids.n_cols; ++i)
     {
-      const double distance = metric.Evaluate(centroids.col(i),
-                                              centroids.col(j));
-      distanceCalculations++;
-      clusterDistances(i, j) = distance;
-      clusterDistances(j, i) = distance;
+      for (size_t j = i + 1; j < centroids.n_cols; ++j)
+      {
+        const double distance = metric.Evaluate(centroids.col(i),
+                                                centroids.col(j));
+        clusterDistances(i, j) = distance;
+        clusterDistances(j, i) = distance;
+      }
     }
   }
 
+  // Count the work in bulk: the parallel loop cannot safely increment the
+  // member per pair, and the Gram-based path is equivalent to evaluating
+  // every pair.
+  distanceCalculations += (centroids.n_cols * (centroids.n_cols - 1)) / 2;
+
+  // Self-distances are always 0, but we set them to DBL_MAX to avoid the self
+  // being the closest cluster centroid.
+  clusterDistances.diag().fill(DBL_MAX);
+
   // Now find the closest cluster to each other cluster.  We multiply by 0.5 so
   // that this is equivalent to s(c) for each cluster c.
   minClusterDistances = 0.5 * arma::min(clusterDistances).t();
 
   // Now loop over all points, and see which ones need to be updated.
+  prunedPairs = 0;
   for (size_t i = 0; i < dataset.n_cols; ++i)
   {
     // Step 2: identify all points such that u(x) <= s(c(x)).
@@ -88,6 +116,7 @@ double ElkanKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
       // No change needed.  This point must still belong to that cluster.
       counts(assignments[i])++;
       newCentroids.col(assignments[i]) += arma::vec(dataset.col(i));
+      prunedPairs += (centroids.n_cols - 1);
       continue;
     }
     else
@@ -100,10 +129,16 @@ double ElkanKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
           continue; // Pruned because this cluster is already the assignment.
 
         if (upperBounds(i) <= lowerBounds(c, i))
+        {
+          prunedPairs++;
           continue; // Pruned by triangle inequality on lower bound.
+        }
 
         if (upperBounds(i) <= 0.5 * clusterDistances(assignments[i], c))
+        {
+          prunedPairs++;
           continue; // Pruned by triangle inequality on cluster distances.
+        }
 
         // Step 3a: if r(x) then compute d(x, c(x)) and assign r(x) = false.
         // Otherwise, d(x, c(x)) = u(x).
@@ -118,10 +153,16 @@ double ElkanKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
 
           // Check if we can prune again.
           if (upperBounds(i) <= lowerBounds(c, i))
+          {
+            prunedPairs++;
             continue; // Pruned by triangle inequality on lower bound.
+          }
 
           if (upperBounds(i) <= 0.5 * clusterDistances(assignments[i], c))
+          {
+            prunedPairs++;
             continue; // Pruned by triangle inequality on cluster distances.
+          }
         }
         else
         {
@@ -143,6 +184,10 @@ double ElkanKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
             assignments[i] = c;
           }
         }
+        else
+        {
+          prunedPairs++; // Both bounds held; no distance was needed.
+        }
       }
     }
 
@@ -153,6 +198,13 @@ double ElkanKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
     counts[assignments[i]]++;
   }
 
+  // Report how much of the work the bounds eliminated this iteration.
+  const size_t candidatePairs = dataset.n_cols * (centroids.n_cols - 1);
+  pruneRate = (candidatePairs == 0) ? 0.0 :
+      (double) prunedPairs / (double) candidatePairs;
+  Log::Info << "Elkan prunes: " << prunedPairs << " of " << candidatePairs
+      << " comparisons.\n";
+
   // Now, normalize and calculate the distance each cluster has moved.
   arma::vec moveDistances(centroids.n_cols);
   double cNorm = 0.0; // Cluster movement for residual.
@@ -183,6 +235,19 @@ double ElkanKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
   return std::sqrt(cNorm);
 }
 
+template<typename MetricType, typename MatType>
+void ElkanKMeans<MetricType, MatType>::InvalidateBounds(const size_t index)
+{
+  // If no iteration has run yet there is no bound state to invalidate.
+  if (upperBounds.n_elem != dataset.n_cols)
+    return;
+
+  // A maximal upper bound and minimal lower bounds fail every prune, so the
+  // point is compared against every centroid on the next iteration.
+  upperBounds(index) = DBL_MAX;
+  lowerBounds.col(index).zeros();
+}
+
 } // namespace kmeans
 } // namespace mlpack
 
@@ -0,0 +1,91 @@
+/**
+ * @file methods/kmeans/gemm_kmeans.hpp
+ *
+ * An implementation of a single step of the Lloyd algorithm for k-means
+ * clustering which computes all point-to-centroid distances with blocked
+ * matrix multiplication (the ||x||^2 + ||c||^2 - 2 x'c expansion), instead of
+ * evaluating the metric point by point.  For dense, moderate-dimensional
+ * datasets this turns the assignment step into GEMM calls and is typically
+ * much faster than NaiveKMeans.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_GEMM_KMEANS_HPP
+#define MLPACK_METHODS_KMEANS_GEMM_KMEANS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * This is an implementation of a single iteration of Lloyd's algorithm for
+ * k-means which assigns points to centroids blockwise: for each block of
+ * points, the matrix of squared distances to all centroids is computed at
+ * once as ||c||^2 - 2 C'X (the ||x||^2 term is constant per point and cannot
+ * change the argmin, so it is dropped).  Blocks are sized so that the C'X
+ * product stays cache-resident, and are processed in parallel with OpenMP.
+ *
+ * This expansion is only valid for the Euclidean metric, so unlike
+ * NaiveKMeans, this class may only be used with LMetric<2> (and its
+ * square-root-free variant).  Use it with KMeans via the LloydStepType
+ * template parameter:
+ *
+ * @code
+ * KMeans<metric::EuclideanDistance, SampleInitialization, MaxVarianceNewCluster,
+ *     GemmKMeans> kmeans;
+ * @endcode
+ *
+ * @tparam MetricType Type of metric; must be LMetric<2, true> or
+ *     LMetric<2, false>.
+ * @tparam MatType Matrix type (arma::mat).
+ */
+template<typename MetricType, typename MatType>
+class GemmKMeans
+{
+ public:
+  /**
+   * Construct the GemmKMeans object with the given dataset and metric.
+   *
+   * @param dataset Dataset.
+   * @param metric Instantiated metric.
+   */
+  GemmKMeans(const MatType& dataset, MetricType& metric);
+
+  /**
+   * Run a single iteration of the Lloyd algorithm, updating the given
+   * centroids into the newCentroids matrix.  If any cluster is empty, the
+   * centroid associated with that cluster may be filled with invalid data (it
+   * will be corrected later).
+   *
+   * @param centroids Current cluster centroids.
+   * @param newCentroids New cluster centroids.
+   * @param counts Number of points in each cluster at the end of the
+   *     iteration.
+   */
+  double Iterate(const arma::mat& centroids,
+                 arma::mat& newCentroids,
+                 arma::Col<size_t>& counts);
+
+  size_t DistanceCalculations() const { return distanceCalculations; }
+
+ private:
+  //! The dataset.
+  const MatType& dataset;
+  //! The instantiated metric.
+  MetricType& metric;
+
+  //! Number of distance calculations.
+  size_t distanceCalculations;
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+// Include implementation.
+#include "gemm_kmeans_impl.hpp"
+
+#endif // MLPACK_METHODS_KMEANS_GEMM_KMEANS_HPP
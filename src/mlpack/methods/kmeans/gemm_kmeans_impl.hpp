@@ -0,0 +1,117 @@
+/**
+ * @file methods/kmeans/gemm_kmeans_impl.hpp
+ *
+ * Implementation of the blocked GEMM-based step of the Lloyd algorithm for
+ * k-means clustering.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_GEMM_KMEANS_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_GEMM_KMEANS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "gemm_kmeans.hpp"
+
+#include <mlpack/core/math/pairwise_distances.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+
+namespace mlpack {
+namespace kmeans {
+
+template<typename MetricType, typename MatType>
+GemmKMeans<MetricType, MatType>::GemmKMeans(const MatType& dataset,
+                                            MetricType& metric) :
+    dataset(dataset),
+    metric(metric),
+    distanceCalculations(0)
+{
+  // The ||x||^2 + ||c||^2 - 2 x'c expansion only holds for the L2 metric.
+  static_assert(MetricType::Power == 2,
+      "GemmKMeans may only be used with the L2 metric (LMetric<2>).");
+}
+
+// Run a single iteration.
+template<typename MetricType, typename MatType>
+double GemmKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
+                                                arma::mat& newCentroids,
+                                                arma::Col<size_t>& counts)
+{
+  newCentroids.zeros(centroids.n_rows, centroids.n_cols);
+  counts.zeros(centroids.n_cols);
+
+  // ||c||^2 for every centroid; the ||x||^2 term is constant per point and
+  // does not affect the argmin, so it is never computed.
+  const arma::vec cNorms = arma::sum(centroids % centroids, 0).t();
+
+  // Choose the block size so that the k x blockSize distance block stays
+  // around L2-cache-sized (~256KB of doubles), but keep enough blocks to feed
+  // all threads.
+  const size_t k = centroids.n_cols;
+  const size_t blockSize = std::max<size_t>(256,
+      std::min<size_t>(4096, 32768 / std::max<size_t>(1, k / 8)));
+  const size_t numBlocks = (dataset.n_cols + blockSize - 1) / blockSize;
+
+  #pragma omp parallel
+  {
+    // The current state of the k-means is private for each thread.
+    arma::mat localCentroids(centroids.n_rows, centroids.n_cols,
+        arma::fill::zeros);
+    arma::Col<size_t> localCounts(centroids.n_cols, arma::fill::zeros);
+
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+    {
+      const size_t begin = block * blockSize;
+      const size_t end = std::min(begin + blockSize, (size_t) dataset.n_cols);
+
+      // All distances for this block at once: one inner-product tile, then
+      // the ||c||^2 correction applied columnwise.  The block is already
+      // cache-sized, so the shared kernel is called with a single tile.
+      arma::mat dists;
+      math::PairwiseInnerProducts(centroids, dataset.cols(begin, end - 1),
+          dists, end - begin);
+      dists *= -2.0;
+      dists.each_col() += cNorms;
+
+      for (size_t i = 0; i < dists.n_cols; ++i)
+      {
+        const size_t closestCluster = (size_t) dists.col(i).index_min();
+        localCentroids.unsafe_col(closestCluster) += dataset.col(begin + i);
+        localCounts(closestCluster)++;
+      }
+    }
+
+    // Combine calculated state from each thread.
+    #pragma omp critical
+    {
+      newCentroids += localCentroids;
+      counts += localCounts;
+    }
+  }
+
+  // Now normalize the centroid.
+  for (size_t i = 0; i < centroids.n_cols; ++i)
+    if (counts(i) != 0)
+      newCentroids.col(i) /= counts(i);
+
+  distanceCalculations += centroids.n_cols * dataset.n_cols;
+
+  // Calculate cluster distortion for this iteration.
+  double cNorm = 0.0;
+  for (size_t i = 0; i < centroids.n_cols; ++i)
+  {
+    cNorm += std::pow(metric.Evaluate(centroids.col(i), newCentroids.col(i)),
+        2.0);
+  }
+  distanceCalculations += centroids.n_cols;
+
+  return std::sqrt(cNorm);
+}
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif // MLPACK_METHODS_KMEANS_GEMM_KMEANS_IMPL_HPP
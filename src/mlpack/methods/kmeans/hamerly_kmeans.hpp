@@ -39,6 +39,16 @@ class HamerlyKMeans
 
   size_t DistanceCalculations() const { return distanceCalculations; }
 
+  /**
+   * Invalidate the bound state of the given point, forcing it to be fully
+   * re-evaluated against all centroids on the next iteration.  Use this when
+   * a point has changed between warm-started runs (see the warm-start
+   * overload of KMeans::Cluster()).
+   *
+   * @param index Index of the point whose bounds should be invalidated.
+   */
+  void InvalidateBounds(const size_t index);
+
  private:
   //! The dataset.
   const MatType& dataset;
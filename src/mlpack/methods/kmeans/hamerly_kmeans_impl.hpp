@@ -172,6 +172,19 @@ double HamerlyKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
   return std::sqrt(centroidMovement);
 }
 
+template<typename MetricType, typename MatType>
+void HamerlyKMeans<MetricType, MatType>::InvalidateBounds(const size_t index)
+{
+  // If no iteration has run yet there is no bound state to invalidate.
+  if (upperBounds.n_elem != dataset.n_cols)
+    return;
+
+  // A maximal upper bound and minimal lower bound fail both bound tests, so
+  // the point is compared against every centroid on the next iteration.
+  upperBounds(index) = DBL_MAX;
+  lowerBounds(index) = 0.0;
+}
+
 } // namespace kmeans
 } // namespace mlpack
 
@@ -18,6 +18,7 @@
 #include "sample_initialization.hpp"
 #include "max_variance_new_cluster.hpp"
 #include "naive_kmeans.hpp"
+#include "gemm_kmeans.hpp"
 
 #include <mlpack/core/tree/binary_space_tree.hpp>
 
@@ -155,6 +156,49 @@ class KMeans
                const bool initialAssignmentGuess = false,
                const bool initialCentroidGuess = false);
 
+  /**
+   * Perform warm-started k-means clustering on the data, reusing an
+   * externally held Lloyd step object.  Any per-point bound state the Lloyd
+   * step keeps (such as the upper and lower bounds of ElkanKMeans or
+   * HamerlyKMeans) carries over from its previous use, so points whose bounds
+   * still hold are not re-evaluated.  This makes periodic re-clustering of
+   * mostly unchanged data much cheaper than clustering from scratch.
+   *
+   * The centroids matrix must contain the centroids that the Lloyd step
+   * object last converged to, and the dataset must be the same object the
+   * Lloyd step was constructed with.  If any points have changed since the
+   * previous run, invalidate their bounds first (see
+   * ElkanKMeans::InvalidateBounds() and HamerlyKMeans::InvalidateBounds()).
+   *
+   * @code
+   * extern arma::mat data; // Dataset that changes slightly between runs.
+   * KMeans<metric::EuclideanDistance, SampleInitialization,
+   *     MaxVarianceNewCluster, HamerlyKMeans> k;
+   * HamerlyKMeans<metric::EuclideanDistance, arma::mat> step(data, k.Metric());
+   * arma::Row<size_t> assignments;
+   * arma::mat centroids;
+   * k.Cluster(data, 3, assignments, centroids); // Initial (cold) run.
+   *
+   * // ... data changes slightly; invalidate the changed points ...
+   * step.InvalidateBounds(changedPoint);
+   * k.Cluster(data, 3, assignments, centroids, step); // Warm re-cluster.
+   * @endcode
+   *
+   * @tparam MatType Type of matrix (arma::mat or arma::sp_mat).
+   * @param data Dataset to cluster.
+   * @param clusters Number of clusters to compute.
+   * @param assignments Vector to store cluster assignments in.
+   * @param centroids Matrix holding the centroids of the previous run; the
+   *      new centroids are stored here.
+   * @param lloydStep Externally held Lloyd step object whose bound state is
+   *      reused and persisted for the next run.
+   */
+  void Cluster(const MatType& data,
+               const size_t clusters,
+               arma::Row<size_t>& assignments,
+               arma::mat& centroids,
+               LloydStepType<MetricType, MatType>& lloydStep);
+
   //! Get the maximum number of iterations.
   size_t MaxIterations() const { return maxIterations; }
   //! Set the maximum number of iterations.
@@ -189,6 +233,30 @@ class KMeans
   InitialPartitionPolicy partitioner;
   //! Instantiated empty cluster policy.
   EmptyClusterPolicy emptyClusterAction;
+
+  /**
+   * Run Lloyd steps with the given Lloyd step object until the centroids
+   * converge or the maximum number of iterations is reached.
+   *
+   * @param data Dataset to cluster.
+   * @param centroids Matrix holding the initial centroids; the final
+   *      centroids are stored here.
+   * @param lloydStep Lloyd step object to iterate with.
+   */
+  void RunLloydSteps(const MatType& data,
+                     arma::mat& centroids,
+                     LloydStepType<MetricType, MatType>& lloydStep);
+
+  /**
+   * Assign each point of the dataset to its closest centroid.
+   *
+   * @param data Dataset to assign.
+   * @param centroids Cluster centroids.
+   * @param assignments Vector to store cluster assignments in.
+   */
+  void CalculateAssignments(const MatType& data,
+                            const arma::mat& centroids,
+                            arma::Row<size_t>& assignments);
 };
 
 } // namespace kmeans
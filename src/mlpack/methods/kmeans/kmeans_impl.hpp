@@ -14,6 +14,7 @@
 
 #include <mlpack/core/metrics/lmetric.hpp>
 #include <mlpack/core/util/sfinae_utility.hpp>
+#include <mlpack/core/util/telemetry.hpp>
 
 namespace mlpack {
 namespace kmeans {
@@ -150,6 +151,9 @@ Cluster(const MatType& data,
         arma::mat& centroids,
         const bool initialGuess)
 {
+  Telemetry::Operation telemetryOp("KMeans::Cluster");
+  telemetryOp.Rows(data.n_rows).Cols(data.n_cols);
+
   // Make sure we have more points than clusters.
   if (clusters > data.n_cols)
     Log::Warn << "KMeans::Cluster(): more clusters requested than points given."
@@ -202,12 +206,34 @@ Cluster(const MatType& data,
     }
   }
 
+  // Run Lloyd steps with a freshly constructed Lloyd step object.
+  LloydStepType<MetricType, MatType> lloydStep(data, metric);
+  RunLloydSteps(data, centroids, lloydStep);
+}
+
+/**
+ * Run Lloyd steps with the given Lloyd step object until convergence.
+ */
+template<typename MetricType,
+         typename InitialPartitionPolicy,
+         typename EmptyClusterPolicy,
+         template<class, class> class LloydStepType,
+         typename MatType>
+void KMeans<
+    MetricType,
+    InitialPartitionPolicy,
+    EmptyClusterPolicy,
+    LloydStepType,
+    MatType>::
+RunLloydSteps(const MatType& data,
+              arma::mat& centroids,
+              LloydStepType<MetricType, MatType>& lloydStep)
+{
   // Counts of points in each cluster.
-  arma::Col<size_t> counts(clusters);
+  arma::Col<size_t> counts(centroids.n_cols);
 
   size_t iteration = 0;
 
-  LloydStepType<MetricType, MatType> lloydStep(data, metric);
   arma::mat centroidsOther;
   double cNorm;
 
@@ -311,6 +337,64 @@ Cluster(const MatType& data,
   Cluster(data, clusters, centroids,
       initialAssignmentGuess || initialCentroidGuess);
 
+  CalculateAssignments(data, centroids, assignments);
+}
+
+/**
+ * Perform warm-started k-means clustering on the data, reusing the bound
+ * state of an externally held Lloyd step object.
+ */
+template<typename MetricType,
+         typename InitialPartitionPolicy,
+         typename EmptyClusterPolicy,
+         template<class, class> class LloydStepType,
+         typename MatType>
+void KMeans<
+    MetricType,
+    InitialPartitionPolicy,
+    EmptyClusterPolicy,
+    LloydStepType,
+    MatType>::
+Cluster(const MatType& data,
+        const size_t clusters,
+        arma::Row<size_t>& assignments,
+        arma::mat& centroids,
+        LloydStepType<MetricType, MatType>& lloydStep)
+{
+  // The centroids of the previous run are the warm start, so they must be
+  // valid.
+  if (centroids.n_cols != clusters)
+    Log::Fatal << "KMeans::Cluster(): wrong number of warm-start centroids ("
+        << centroids.n_cols << ", should be " << clusters << ")!" << std::endl;
+
+  if (centroids.n_rows != data.n_rows)
+    Log::Fatal << "KMeans::Cluster(): warm-start centroids have wrong "
+        << "dimensionality (" << centroids.n_rows << ", should be "
+        << data.n_rows << ")!" << std::endl;
+
+  RunLloydSteps(data, centroids, lloydStep);
+
+  CalculateAssignments(data, centroids, assignments);
+}
+
+/**
+ * Assign each point of the dataset to its closest centroid.
+ */
+template<typename MetricType,
+         typename InitialPartitionPolicy,
+         typename EmptyClusterPolicy,
+         template<class, class> class LloydStepType,
+         typename MatType>
+void KMeans<
+    MetricType,
+    InitialPartitionPolicy,
+    EmptyClusterPolicy,
+    LloydStepType,
+    MatType>::
+CalculateAssignments(const MatType& data,
+                     const arma::mat& centroids,
+                     arma::Row<size_t>& assignments)
+{
   // Calculate final assignments in parallel over the entire dataset.
   assignments.set_size(data.n_cols);
 
@@ -0,0 +1,139 @@
+/**
+ * @file methods/kmeans/scalable_kmeans_initialization.hpp
+ *
+ * An implementation of the k-means|| ("scalable k-means++") initialization
+ * strategy of Bahmani et al., which replaces the k sequential passes of
+ * k-means++ with a handful of parallel oversampling rounds followed by a
+ * weighted reclustering of the sampled candidates.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_SCALABLE_KMEANS_INITIALIZATION_HPP
+#define MLPACK_METHODS_KMEANS_SCALABLE_KMEANS_INITIALIZATION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * An initial partitioning policy implementing k-means|| ("scalable
+ * k-means++"):
+ *
+ * @code
+ * @article{bahmani2012scalable,
+ *   title={Scalable k-means++},
+ *   author={Bahmani, Bahman and Moseley, Benjamin and Vattani, Andrea and
+ *       Kumar, Ravi and Vassilvitskii, Sergei},
+ *   journal={Proceedings of the VLDB Endowment},
+ *   volume={5},
+ *   number={7},
+ *   pages={622--633},
+ *   year={2012}
+ * }
+ * @endcode
+ *
+ * k-means++ chooses its centers one at a time, which means k dependent
+ * passes over the data.  k-means|| instead performs a small fixed number of
+ * oversampling rounds: in each round every point is sampled independently
+ * with probability proportional to its squared distance from the current
+ * candidate set, so one round picks about `oversampling` new candidates at
+ * once and the expensive distance passes parallelize over the points.  The
+ * oversampled candidates are then weighted by the number of points they are
+ * closest to and reclustered (weighted k-means++ seeding plus weighted Lloyd
+ * iterations on the small candidate set) into the k initial centroids.
+ *
+ * Seeds of this quality typically cost k-means far fewer Lloyd iterations
+ * than uniform sampling, which is what makes the extra passes worthwhile for
+ * large k.
+ */
+class ScalableKMeansInitialization
+{
+ public:
+  /**
+   * Create the ScalableKMeansInitialization object, optionally specifying
+   * the number of oversampling rounds and the expected number of candidates
+   * sampled per round.
+   *
+   * @param rounds Number of oversampling rounds; the paper finds around five
+   *     to be enough in practice.
+   * @param oversampling Expected number of candidates sampled per round; if
+   *     0, twice the number of clusters is used.
+   */
+  ScalableKMeansInitialization(const size_t rounds = 5,
+                               const double oversampling = 0.0) :
+      rounds(rounds), oversampling(oversampling) { }
+
+  /**
+   * Initialize the centroids matrix according to the k-means|| sampling
+   * scheme.
+   *
+   * @tparam MatType Type of data (arma::mat or arma::sp_mat).
+   * @param data Dataset.
+   * @param clusters Number of clusters.
+   * @param centroids Matrix to put initial centroids into.
+   */
+  template<typename MatType>
+  void Cluster(const MatType& data,
+               const size_t clusters,
+               arma::mat& centroids) const;
+
+  //! Get the number of oversampling rounds.
+  size_t Rounds() const { return rounds; }
+  //! Modify the number of oversampling rounds.
+  size_t& Rounds() { return rounds; }
+
+  //! Get the expected number of candidates per round (0 means 2k).
+  double Oversampling() const { return oversampling; }
+  //! Modify the expected number of candidates per round (0 means 2k).
+  double& Oversampling() { return oversampling; }
+
+  //! Serialize the object.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(rounds));
+    ar(CEREAL_NVP(oversampling));
+  }
+
+ private:
+  /**
+   * Recluster the weighted candidate set into the requested number of
+   * centroids: weighted k-means++ seeding followed by weighted Lloyd
+   * iterations.  The candidate set is small (about rounds * oversampling
+   * points), so this is cheap.
+   *
+   * @param candidates Candidate centers (one per column).
+   * @param weights Number of points closest to each candidate.
+   * @param clusters Number of clusters.
+   * @param centroids Matrix to store the resulting centroids into.
+   */
+  void ReclusterCandidates(const arma::mat& candidates,
+                           const arma::vec& weights,
+                           const size_t clusters,
+                           arma::mat& centroids) const;
+
+  /**
+   * Sample an index with probability proportional to the given non-negative
+   * masses, which must not all be zero.
+   */
+  static size_t SampleIndex(const arma::vec& masses);
+
+  //! The number of oversampling rounds to perform.
+  size_t rounds;
+  //! The expected number of candidates sampled per round (0 means 2k).
+  double oversampling;
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+// Include implementation.
+#include "scalable_kmeans_initialization_impl.hpp"
+
+#endif
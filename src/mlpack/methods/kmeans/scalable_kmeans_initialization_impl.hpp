@@ -0,0 +1,236 @@
+/**
+ * @file methods/kmeans/scalable_kmeans_initialization_impl.hpp
+ *
+ * An implementation of the k-means|| ("scalable k-means++") initialization
+ * strategy of Bahmani et al.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_SCALABLE_KMEANS_INITIALIZATION_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_SCALABLE_KMEANS_INITIALIZATION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "scalable_kmeans_initialization.hpp"
+
+namespace mlpack {
+namespace kmeans {
+
+template<typename MatType>
+void ScalableKMeansInitialization::Cluster(const MatType& data,
+                                           const size_t clusters,
+                                           arma::mat& centroids) const
+{
+  // The oversampling factor; the paper recommends a small multiple of k.
+  const double ell = (oversampling > 0.0) ? oversampling :
+      2.0 * (double) clusters;
+
+  // The candidate set starts from one uniformly chosen point.
+  std::vector<size_t> candidates;
+  candidates.push_back((size_t) math::RandInt(data.n_cols));
+
+  // Squared distance from each point to its closest candidate, and the total
+  // cost of the candidate set.
+  arma::vec sqDistances(data.n_cols);
+  double cost = 0.0;
+  #pragma omp parallel for reduction(+:cost) schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+  {
+    sqDistances[i] = metric::SquaredEuclideanDistance::Evaluate(data.col(i),
+        data.col(candidates[0]));
+    cost += sqDistances[i];
+  }
+
+  for (size_t round = 0; round < rounds && cost > 0.0; ++round)
+  {
+    // Sample each point independently with probability ell * d^2 / cost, so
+    // about ell points survive the round.  The draws themselves are cheap;
+    // the distance passes below are the expensive part and parallelize.
+    const size_t firstNew = candidates.size();
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      if (math::Random() * cost < ell * sqDistances[i])
+        candidates.push_back(i);
+    }
+
+    if (candidates.size() == firstNew)
+      continue; // Nothing was sampled this round.
+
+    // Fold the new candidates into the distances and the cost.
+    cost = 0.0;
+    #pragma omp parallel for reduction(+:cost) schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+    {
+      for (size_t c = firstNew; c < candidates.size(); ++c)
+      {
+        const double sqDistance = metric::SquaredEuclideanDistance::Evaluate(
+            data.col(i), data.col(candidates[c]));
+        if (sqDistance < sqDistances[i])
+          sqDistances[i] = sqDistance;
+      }
+
+      cost += sqDistances[i];
+    }
+  }
+
+  // Materialize the candidate set.
+  arma::mat candidateSet(data.n_rows, candidates.size());
+  for (size_t c = 0; c < candidates.size(); ++c)
+    candidateSet.col(c) = data.col(candidates[c]);
+
+  // If the rounds produced no more candidates than clusters, pad with random
+  // points and we are done.
+  if (candidates.size() <= clusters)
+  {
+    centroids.set_size(data.n_rows, clusters);
+    centroids.cols(0, candidates.size() - 1) = candidateSet;
+    for (size_t i = candidates.size(); i < clusters; ++i)
+      centroids.col(i) = data.col((size_t) math::RandInt(data.n_cols));
+    return;
+  }
+
+  // Weight each candidate by the number of points that it is the closest
+  // candidate of.
+  arma::vec weights(candidates.size(), arma::fill::zeros);
+  #pragma omp parallel
+  {
+    arma::vec threadWeights(candidates.size(), arma::fill::zeros);
+
+    #pragma omp for schedule(static) nowait
+    for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+    {
+      size_t closest = 0;
+      double minDistance = std::numeric_limits<double>::infinity();
+      for (size_t c = 0; c < candidates.size(); ++c)
+      {
+        const double sqDistance = metric::SquaredEuclideanDistance::Evaluate(
+            data.col(i), candidateSet.col(c));
+        if (sqDistance < minDistance)
+        {
+          minDistance = sqDistance;
+          closest = c;
+        }
+      }
+
+      threadWeights[closest] += 1.0;
+    }
+
+    #pragma omp critical (ScalableKMeansWeights)
+    weights += threadWeights;
+  }
+
+  // Recluster the small weighted candidate set into the k centroids.
+  ReclusterCandidates(candidateSet, weights, clusters, centroids);
+}
+
+inline void ScalableKMeansInitialization::ReclusterCandidates(
+    const arma::mat& candidates,
+    const arma::vec& weights,
+    const size_t clusters,
+    arma::mat& centroids) const
+{
+  const size_t numCandidates = candidates.n_cols;
+  centroids.set_size(candidates.n_rows, clusters);
+
+  // Weighted k-means++ seeding over the candidates.
+  centroids.col(0) = candidates.col(SampleIndex(weights));
+  arma::vec sqDistances(numCandidates);
+  for (size_t c = 0; c < numCandidates; ++c)
+  {
+    sqDistances[c] = metric::SquaredEuclideanDistance::Evaluate(
+        candidates.col(c), centroids.col(0));
+  }
+
+  for (size_t j = 1; j < clusters; ++j)
+  {
+    const arma::vec masses = weights % sqDistances;
+    const size_t index = (arma::accu(masses) > 0.0) ? SampleIndex(masses) :
+        (size_t) math::RandInt(numCandidates);
+    centroids.col(j) = candidates.col(index);
+
+    for (size_t c = 0; c < numCandidates; ++c)
+    {
+      const double sqDistance = metric::SquaredEuclideanDistance::Evaluate(
+          candidates.col(c), centroids.col(j));
+      if (sqDistance < sqDistances[c])
+        sqDistances[c] = sqDistance;
+    }
+  }
+
+  // Weighted Lloyd iterations over the candidate set; with so few points
+  // this converges almost immediately.
+  const size_t maxIterations = 100;
+  arma::Row<size_t> assignments(numCandidates);
+  assignments.fill(clusters);
+  for (size_t iteration = 0; iteration < maxIterations; ++iteration)
+  {
+    bool changed = false;
+    for (size_t c = 0; c < numCandidates; ++c)
+    {
+      size_t closest = 0;
+      double minDistance = std::numeric_limits<double>::infinity();
+      for (size_t j = 0; j < clusters; ++j)
+      {
+        const double sqDistance = metric::SquaredEuclideanDistance::Evaluate(
+            candidates.col(c), centroids.col(j));
+        if (sqDistance < minDistance)
+        {
+          minDistance = sqDistance;
+          closest = j;
+        }
+      }
+
+      if (assignments[c] != closest)
+      {
+        assignments[c] = closest;
+        changed = true;
+      }
+    }
+
+    if (!changed)
+      break;
+
+    // Recompute the centroids as the weighted means of their candidates; an
+    // empty cluster keeps its previous centroid.
+    arma::mat sums(candidates.n_rows, clusters, arma::fill::zeros);
+    arma::vec totals(clusters, arma::fill::zeros);
+    for (size_t c = 0; c < numCandidates; ++c)
+    {
+      sums.col(assignments[c]) += weights[c] * candidates.col(c);
+      totals[assignments[c]] += weights[c];
+    }
+
+    for (size_t j = 0; j < clusters; ++j)
+    {
+      if (totals[j] > 0.0)
+        centroids.col(j) = sums.col(j) / totals[j];
+    }
+  }
+}
+
+inline size_t ScalableKMeansInitialization::SampleIndex(
+    const arma::vec& masses)
+{
+  const double target = math::Random() * arma::accu(masses);
+  double cumulative = 0.0;
+  for (size_t i = 0; i < masses.n_elem; ++i)
+  {
+    cumulative += masses[i];
+    if (target <= cumulative && masses[i] > 0.0)
+      return i;
+  }
+
+  // Rounding carried us past the end; return the last index with mass.
+  for (size_t i = masses.n_elem; i > 0; --i)
+    if (masses[i - 1] > 0.0)
+      return i - 1;
+
+  return masses.n_elem - 1;
+}
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif
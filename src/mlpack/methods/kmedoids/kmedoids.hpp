@@ -0,0 +1,185 @@
+/**
+ * @file methods/kmedoids/kmedoids.hpp
+ *
+ * K-medoids clustering with the PAM BUILD and SWAP phases, in the FastPAM
+ * style: the swap phase evaluates all medoids for a candidate in one pass
+ * over the cached nearest/second-nearest tables.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEDOIDS_KMEDOIDS_HPP
+#define MLPACK_METHODS_KMEDOIDS_KMEDOIDS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <mlpack/core/math/pairwise_distances.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+
+namespace mlpack {
+namespace kmedoids /** K-medoids clustering. */ {
+
+/**
+ * This class implements k-medoids clustering with the PAM algorithm of
+ * Kaufman and Rousseeuw: a greedy BUILD phase chooses the initial medoids,
+ * and a SWAP phase repeatedly exchanges a medoid for a non-medoid point as
+ * long as the exchange lowers the total deviation (the sum of the distances
+ * of every point to its nearest medoid).  Unlike k-means, the cluster
+ * centers are always dataset points, so the method works with any metric and
+ * is robust to outliers.
+ *
+ * The swap phase follows FastPAM: the nearest and second-nearest medoid
+ * distances of every point are cached (and recomputed with a NeighborSearch
+ * query over the medoid set after every swap), so one pass over the dataset
+ * per candidate evaluates the exchange of that candidate against all k
+ * medoids at once.  Candidates are processed in blocks whose distances are
+ * computed with the blocked pairwise-distance kernel when the metric is
+ * Euclidean, and the candidates of a block are evaluated in parallel.
+ *
+ * Exact PAM evaluates every non-medoid as a swap candidate, which is
+ * quadratic in the number of points per iteration.  For large datasets both
+ * phases can be subsampled: buildSamples bounds the number of candidates
+ * considered for each initial medoid, and swapSamples bounds the number of
+ * swap candidates per iteration, turning each iteration into a sampled local
+ * search at a small cost in final cost.
+ *
+ * A simple example of usage:
+ *
+ * @code
+ * extern arma::mat data; // Dataset we want to run k-medoids on.
+ * arma::Row<size_t> assignments; // Cluster assignments.
+ * arma::Col<size_t> medoids; // Indices of the medoid points.
+ *
+ * KMedoids<> km; // Default options: exact PAM.
+ * const double cost = km.Cluster(data, 3, assignments, medoids);
+ * @endcode
+ *
+ * @tparam MetricType The distance metric to use; see metric::LMetric for an
+ *     example.
+ * @tparam MatType Type of the data matrix (arma::mat or arma::sp_mat).
+ */
+template<typename MetricType = metric::EuclideanDistance,
+         typename MatType = arma::mat>
+class KMedoids
+{
+ public:
+  /**
+   * Create a KMedoids object and (optionally) set the parameters which
+   * k-medoids will be run with.
+   *
+   * @param maxIterations Maximum number of SWAP iterations (each iteration
+   *     performs at most one swap); 0 means no limit.
+   * @param buildSamples Number of candidates considered for each medoid
+   *     during the BUILD phase; 0 (the default) uses an automatic sample of
+   *     10 + ceil(sqrt(n)) candidates, and a value of at least the number of
+   *     points gives the exact PAM BUILD.
+   * @param swapSamples Number of swap candidates evaluated per SWAP
+   *     iteration; 0 (the default) evaluates every non-medoid point, which
+   *     is the exact PAM SWAP.
+   * @param metric Optional MetricType object; for when the metric has state
+   *     it needs to store.
+   */
+  KMedoids(const size_t maxIterations = 100,
+           const size_t buildSamples = 0,
+           const size_t swapSamples = 0,
+           const MetricType metric = MetricType());
+
+  /**
+   * Perform k-medoids clustering on the data, storing the cluster assignment
+   * of every point and the dataset indices of the chosen medoids.
+   *
+   * @param data Dataset to cluster.
+   * @param clusters Number of clusters to compute.
+   * @param assignments Vector to store cluster assignments in.
+   * @param medoidIndices Vector to store the dataset index of the medoid of
+   *     every cluster in.
+   * @return The total deviation (sum of the distances of every point to its
+   *     nearest medoid) of the final clustering.
+   */
+  double Cluster(const MatType& data,
+                 const size_t clusters,
+                 arma::Row<size_t>& assignments,
+                 arma::Col<size_t>& medoidIndices) const;
+
+  //! Get the maximum number of SWAP iterations.
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of SWAP iterations.
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the number of BUILD candidates per medoid (0 means automatic).
+  size_t BuildSamples() const { return buildSamples; }
+  //! Modify the number of BUILD candidates per medoid (0 means automatic).
+  size_t& BuildSamples() { return buildSamples; }
+
+  //! Get the number of swap candidates per iteration (0 means all points).
+  size_t SwapSamples() const { return swapSamples; }
+  //! Modify the number of swap candidates per iteration (0 means all
+  //! points).
+  size_t& SwapSamples() { return swapSamples; }
+
+  //! Get the distance metric.
+  const MetricType& Metric() const { return metric; }
+  //! Modify the distance metric.
+  MetricType& Metric() { return metric; }
+
+ private:
+  /**
+   * Recompute the cached tables from the current medoid set with one
+   * NeighborSearch query: the assignment of every point and its distances to
+   * its nearest and second-nearest medoids.
+   *
+   * @param data Dataset being clustered.
+   * @param medoidIndices Dataset indices of the current medoids.
+   * @param assignments Will hold the nearest medoid of every point.
+   * @param nearest Will hold the distance of every point to its nearest
+   *     medoid.
+   * @param second Will hold the distance of every point to its
+   *     second-nearest medoid (infinity if there is only one medoid).
+   */
+  void NearestTables(const MatType& data,
+                     const arma::Col<size_t>& medoidIndices,
+                     arma::Row<size_t>& assignments,
+                     arma::vec& nearest,
+                     arma::vec& second) const;
+
+  /**
+   * Compute the distances of the given candidate points to every point of
+   * the dataset, so that distances(i, j) is the distance between point
+   * candidates[i] and point j.  For the Euclidean metric this uses the
+   * blocked pairwise-distance kernel.
+   *
+   * @param data Dataset being clustered.
+   * @param candidates Dataset indices of the candidate points.
+   * @param distances Will be sized candidates.n_elem x data.n_cols.
+   */
+  void CandidateDistances(const MatType& data,
+                          const arma::uvec& candidates,
+                          arma::mat& distances) const;
+
+  //! Whether the blocked pairwise-distance kernel applies.
+  constexpr static bool metricIsEuclidean =
+      std::is_same<MetricType, metric::EuclideanDistance>::value;
+
+  //! Number of candidates whose distance rows are computed per block.
+  constexpr static size_t candidateBlockSize = 128;
+
+  //! Maximum number of SWAP iterations.
+  size_t maxIterations;
+  //! Number of BUILD candidates per medoid (0 means automatic).
+  size_t buildSamples;
+  //! Number of swap candidates per iteration (0 means all points).
+  size_t swapSamples;
+  //! The instantiated distance metric.
+  mutable MetricType metric;
+}; // class KMedoids
+
+} // namespace kmedoids
+} // namespace mlpack
+
+// Include implementation.
+#include "kmedoids_impl.hpp"
+
+#endif
@@ -0,0 +1,297 @@
+/**
+ * @file methods/kmedoids/kmedoids_impl.hpp
+ *
+ * Implementation of the KMedoids class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEDOIDS_KMEDOIDS_IMPL_HPP
+#define MLPACK_METHODS_KMEDOIDS_KMEDOIDS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "kmedoids.hpp"
+
+namespace mlpack {
+namespace kmedoids {
+
+template<typename MetricType, typename MatType>
+KMedoids<MetricType, MatType>::KMedoids(const size_t maxIterations,
+                                        const size_t buildSamples,
+                                        const size_t swapSamples,
+                                        const MetricType metric) :
+    maxIterations(maxIterations),
+    buildSamples(buildSamples),
+    swapSamples(swapSamples),
+    metric(metric)
+{
+  // Nothing to do.
+}
+
+template<typename MetricType, typename MatType>
+double KMedoids<MetricType, MatType>::Cluster(
+    const MatType& data,
+    const size_t clusters,
+    arma::Row<size_t>& assignments,
+    arma::Col<size_t>& medoidIndices) const
+{
+  const size_t n = data.n_cols;
+  if (clusters == 0 || clusters > n)
+  {
+    throw std::invalid_argument("KMedoids::Cluster(): the number of clusters "
+        "must be positive and no larger than the number of points");
+  }
+
+  // BUILD phase: greedily add the candidate whose addition to the medoid set
+  // reduces the total deviation the most.  Candidates are drawn from a
+  // random sample; the automatic sample size follows the 10 + ceil(sqrt(n))
+  // rule of the sampled PAM initializations.
+  size_t numCandidates = (buildSamples == 0) ?
+      (size_t) (10 + std::ceil(std::sqrt((double) n))) : buildSamples;
+  numCandidates = std::min(n, std::max(numCandidates, clusters));
+
+  arma::uvec perm = arma::shuffle(arma::regspace<arma::uvec>(0, n - 1));
+  const arma::uvec candidates = perm.head(numCandidates);
+
+  medoidIndices.set_size(clusters);
+  std::vector<bool> isMedoid(n, false);
+
+  // Distance of every point to its nearest chosen medoid so far.
+  arma::vec nearest(n);
+  nearest.fill(DBL_MAX);
+
+  arma::mat candDist;
+  for (size_t m = 0; m < clusters; ++m)
+  {
+    double bestGain = 0.0;
+    size_t bestIndex = n;
+    arma::vec bestRow;
+
+    for (size_t begin = 0; begin < numCandidates;
+         begin += candidateBlockSize)
+    {
+      const size_t end = std::min(begin + candidateBlockSize,
+          numCandidates) - 1;
+      const arma::uvec block = candidates.subvec(begin, end);
+      CandidateDistances(data, block, candDist);
+
+      // The gain of every candidate of the block depends only on the shared
+      // nearest-distance table, so the candidates are evaluated in parallel.
+      arma::vec gains(block.n_elem);
+      #pragma omp parallel for
+      for (omp_size_t c = 0; c < (omp_size_t) block.n_elem; ++c)
+      {
+        if (isMedoid[block[c]])
+        {
+          gains(c) = 0.0;
+          continue;
+        }
+
+        double gain = 0.0;
+        if (m == 0)
+        {
+          // The first medoid minimizes the total deviation directly.
+          gain = -arma::accu(candDist.row(c));
+        }
+        else
+        {
+          for (size_t i = 0; i < n; ++i)
+            gain += std::max(0.0, nearest(i) - candDist(c, i));
+        }
+        gains(c) = gain;
+      }
+
+      for (size_t c = 0; c < block.n_elem; ++c)
+      {
+        if (isMedoid[block[c]])
+          continue;
+
+        if (bestIndex == n || gains(c) > bestGain)
+        {
+          bestGain = gains(c);
+          bestIndex = block[c];
+          bestRow = candDist.row(c).t();
+        }
+      }
+    }
+
+    medoidIndices[m] = bestIndex;
+    isMedoid[bestIndex] = true;
+    nearest = arma::min(nearest, bestRow);
+  }
+
+  // Cache the nearest/second-nearest tables for the swap phase.
+  arma::vec second;
+  NearestTables(data, medoidIndices, assignments, nearest, second);
+  double cost = arma::accu(nearest);
+
+  // SWAP phase: repeatedly exchange a medoid for a non-medoid point while
+  // that lowers the total deviation.  Every candidate is evaluated against
+  // all medoids in one pass over the cached tables (the FastPAM
+  // decomposition), and candidates are processed in distance blocks, in
+  // parallel within each block.
+  size_t iteration = 0;
+  while (maxIterations == 0 || iteration < maxIterations)
+  {
+    ++iteration;
+
+    // Collect the swap candidates for this iteration.
+    arma::uvec swapCandidates(n);
+    size_t found = 0;
+    if (swapSamples == 0 || swapSamples >= n - clusters)
+    {
+      for (size_t i = 0; i < n; ++i)
+      {
+        if (!isMedoid[i])
+          swapCandidates[found++] = i;
+      }
+    }
+    else
+    {
+      perm = arma::shuffle(perm);
+      for (size_t i = 0; i < n && found < swapSamples; ++i)
+      {
+        if (!isMedoid[perm[i]])
+          swapCandidates[found++] = perm[i];
+      }
+    }
+    swapCandidates.resize(found);
+    if (swapCandidates.n_elem == 0)
+      break;
+
+    double bestDelta = 0.0;
+    size_t bestCandidate = n;
+    size_t bestMedoid = clusters;
+
+    for (size_t begin = 0; begin < swapCandidates.n_elem;
+         begin += candidateBlockSize)
+    {
+      const size_t end = std::min(begin + candidateBlockSize,
+          (size_t) swapCandidates.n_elem) - 1;
+      const arma::uvec block = swapCandidates.subvec(begin, end);
+      CandidateDistances(data, block, candDist);
+
+      arma::vec deltas(block.n_elem);
+      arma::Col<size_t> deltaMedoids(block.n_elem);
+      #pragma omp parallel for
+      for (omp_size_t c = 0; c < (omp_size_t) block.n_elem; ++c)
+      {
+        // One pass over the cached tables evaluates the exchange of this
+        // candidate against every medoid at once: the gain of points whose
+        // nearest medoid survives the swap is shared, and a per-medoid
+        // correction accounts for the points that would lose their medoid.
+        double sharedGain = 0.0;
+        arma::vec adjustments(clusters, arma::fill::zeros);
+        for (size_t i = 0; i < n; ++i)
+        {
+          const double dc = candDist(c, i);
+          const double dn = nearest(i);
+          const double shared = std::min(0.0, dc - dn);
+          sharedGain += shared;
+          adjustments(assignments(i)) +=
+              std::min(dc, second(i)) - dn - shared;
+        }
+
+        arma::uword medoid;
+        deltas(c) = sharedGain + adjustments.min(medoid);
+        deltaMedoids(c) = medoid;
+      }
+
+      for (size_t c = 0; c < block.n_elem; ++c)
+      {
+        if (deltas(c) < bestDelta)
+        {
+          bestDelta = deltas(c);
+          bestCandidate = block[c];
+          bestMedoid = deltaMedoids(c);
+        }
+      }
+    }
+
+    // Stop when no swap gives a meaningful improvement.
+    if (bestCandidate == n || bestDelta >= -1e-9 * std::max(1.0, cost))
+      break;
+
+    // Perform the best swap and refresh the cached tables.
+    isMedoid[medoidIndices[bestMedoid]] = false;
+    isMedoid[bestCandidate] = true;
+    medoidIndices[bestMedoid] = bestCandidate;
+
+    NearestTables(data, medoidIndices, assignments, nearest, second);
+    cost = arma::accu(nearest);
+  }
+
+  return cost;
+}
+
+template<typename MetricType, typename MatType>
+void KMedoids<MetricType, MatType>::NearestTables(
+    const MatType& data,
+    const arma::Col<size_t>& medoidIndices,
+    arma::Row<size_t>& assignments,
+    arma::vec& nearest,
+    arma::vec& second) const
+{
+  MatType medoidData(data.n_rows, medoidIndices.n_elem);
+  for (size_t m = 0; m < medoidIndices.n_elem; ++m)
+    medoidData.col(m) = data.col(medoidIndices[m]);
+
+  // One nearest-neighbor query over the medoid set yields the assignment and
+  // the nearest and second-nearest medoid distances of every point.
+  neighbor::NeighborSearch<neighbor::NearestNeighborSort, MetricType, MatType>
+      knn(std::move(medoidData), neighbor::DUAL_TREE_MODE, 0, metric);
+
+  const size_t k = std::min((size_t) 2, (size_t) medoidIndices.n_elem);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(data, k, neighbors, distances);
+
+  assignments = neighbors.row(0);
+  nearest = distances.row(0).t();
+  if (k == 2)
+  {
+    second = distances.row(1).t();
+  }
+  else
+  {
+    second.set_size(data.n_cols);
+    second.fill(DBL_MAX);
+  }
+}
+
+template<typename MetricType, typename MatType>
+void KMedoids<MetricType, MatType>::CandidateDistances(
+    const MatType& data,
+    const arma::uvec& candidates,
+    arma::mat& distances) const
+{
+  if (metricIsEuclidean)
+  {
+    // The bulk of the work is matrix products, blocked and parallelized
+    // inside PairwiseSquaredDistances().
+    const MatType candidateData(data.cols(candidates));
+    arma::Mat<typename MatType::elem_type> squared;
+    math::PairwiseSquaredDistances(candidateData, data, squared);
+    distances = arma::sqrt(squared);
+  }
+  else
+  {
+    distances.set_size(candidates.n_elem, data.n_cols);
+    #pragma omp parallel for
+    for (omp_size_t j = 0; j < (omp_size_t) data.n_cols; ++j)
+    {
+      for (size_t i = 0; i < candidates.n_elem; ++i)
+      {
+        distances(i, j) = metric.Evaluate(data.col(candidates[i]),
+                                          data.col(j));
+      }
+    }
+  }
+}
+
+} // namespace kmedoids
+} // namespace mlpack
+
+#endif
@@ -26,7 +26,8 @@ LARS::LARS(const bool useCholesky,
     lambda1(lambda1),
     elasticNet((lambda1 != 0) && (lambda2 != 0)),
     lambda2(lambda2),
-    tolerance(tolerance)
+    tolerance(tolerance),
+    warmStart(false)
 { /* Nothing left to do. */ }
 
 LARS::LARS(const bool useCholesky,
@@ -40,7 +41,8 @@ LARS::LARS(const bool useCholesky,
     lambda1(lambda1),
     elasticNet((lambda1 != 0) && (lambda2 != 0)),
     lambda2(lambda2),
-    tolerance(tolerance)
+    tolerance(tolerance),
+    warmStart(false)
 { /* Nothing left to do */ }
 
 LARS::LARS(const arma::mat& data,
@@ -80,6 +82,9 @@ LARS::LARS(const LARS& other) :
     elasticNet(other.elasticNet),
     lambda2(other.lambda2),
     tolerance(other.tolerance),
+    warmStart(other.warmStart),
+    cachedActivationOrder(other.cachedActivationOrder),
+    cachedCholFactor(other.cachedCholFactor),
     betaPath(other.betaPath),
     lambdaPath(other.lambdaPath),
     activeSet(other.activeSet),
@@ -102,6 +107,9 @@ LARS::LARS(LARS&& other) :
     elasticNet(other.elasticNet),
     lambda2(other.lambda2),
     tolerance(other.tolerance),
+    warmStart(other.warmStart),
+    cachedActivationOrder(std::move(other.cachedActivationOrder)),
+    cachedCholFactor(std::move(other.cachedCholFactor)),
     betaPath(std::move(other.betaPath)),
     lambdaPath(std::move(other.lambdaPath)),
     activeSet(std::move(other.activeSet)),
@@ -128,6 +136,9 @@ LARS& LARS::operator=(const LARS& other)
   elasticNet = other.elasticNet;
   lambda2 = other.lambda2;
   tolerance = other.tolerance;
+  warmStart = other.warmStart;
+  cachedActivationOrder = other.cachedActivationOrder;
+  cachedCholFactor = other.cachedCholFactor;
   betaPath = other.betaPath;
   lambdaPath = other.lambdaPath;
   activeSet = other.activeSet;
@@ -153,6 +164,9 @@ LARS& LARS::operator=(LARS&& other)
   elasticNet = other.elasticNet;
   lambda2 = other.lambda2;
   tolerance = other.tolerance;
+  warmStart = other.warmStart;
+  cachedActivationOrder = std::move(other.cachedActivationOrder);
+  cachedCholFactor = std::move(other.cachedCholFactor);
   betaPath = std::move(other.betaPath);
   lambdaPath = std::move(other.lambdaPath);
   activeSet = std::move(other.activeSet);
@@ -178,6 +192,16 @@ double LARS::Train(const arma::mat& matX,
   isIgnored.clear();
   matUtriCholFactor.reset();
 
+  // When warm starting, the activation order and Cholesky factor cached from
+  // the previous call (on the same design matrix) let us skip the incremental
+  // factor updates for as long as this problem activates the same variables
+  // in the same order.  We also record this call's activation order, up to
+  // the first deactivation, to serve as the cache for the next call.
+  bool reuseCachedPrefix = warmStart && useCholesky &&
+      !cachedActivationOrder.empty();
+  bool insertionsOnly = true;
+  std::vector<size_t> activationOrder;
+
   // This matrix may end up holding the transpose -- if necessary.
   arma::mat dataTrans;
   // dataRef is row-major.
@@ -256,16 +280,35 @@ double LARS::Train(const arma::mat& matX,
     {
       if (useCholesky)
       {
-        // vec newGramCol = vec(activeSet.size());
-        // for (size_t i = 0; i < activeSet.size(); ++i)
-        // {
-        //   newGramCol[i] = dot(matX.col(activeSet[i]), matX.col(changeInd));
-        // }
-        // This is equivalent to the above 5 lines.
-        arma::vec newGramCol = matGram->elem(changeInd * dataRef.n_cols +
-            arma::conv_to<arma::uvec>::from(activeSet));
-
-        CholeskyInsert((*matGram)(changeInd, changeInd), newGramCol);
+        if (reuseCachedPrefix &&
+            (activeSet.size() < cachedActivationOrder.size()) &&
+            (cachedActivationOrder[activeSet.size()] == changeInd))
+        {
+          // The same variable enters at the same position as in the previous
+          // call, so the leading block of the cached factor is exactly what
+          // CholeskyInsert() would compute from the (unchanged) Gram matrix.
+          matUtriCholFactor = cachedCholFactor.submat(0, 0,
+              activeSet.size(), activeSet.size());
+        }
+        else
+        {
+          // The activation orders have diverged; no more reuse this call.
+          reuseCachedPrefix = false;
+
+          // vec newGramCol = vec(activeSet.size());
+          // for (size_t i = 0; i < activeSet.size(); ++i)
+          // {
+          //   newGramCol[i] = dot(matX.col(activeSet[i]), matX.col(changeInd));
+          // }
+          // This is equivalent to the above 5 lines.
+          arma::vec newGramCol = matGram->elem(changeInd * dataRef.n_cols +
+              arma::conv_to<arma::uvec>::from(activeSet));
+
+          CholeskyInsert((*matGram)(changeInd, changeInd), newGramCol);
+        }
+
+        if (warmStart && insertionsOnly)
+          activationOrder.push_back(changeInd);
       }
 
       // Add variable to active set.
@@ -318,6 +361,12 @@ double LARS::Train(const arma::mat& matX,
         Deactivate(activeSet.size() - 1);
         Ignore(changeInd);
         CholeskyDelete(matUtriCholFactor.n_rows - 1);
+
+        // Removing the variable that was just appended leaves the factor
+        // built by insertions only, so only the recorded order needs fixing.
+        if (warmStart && insertionsOnly)
+          activationOrder.pop_back();
+
         continue;
       }
     }
@@ -424,6 +473,16 @@ double LARS::Train(const arma::mat& matX,
 
     if (lassocond)
     {
+      // The factor is about to lose its insertion-only structure, so
+      // snapshot it for the next warm-started call first.
+      if (warmStart && useCholesky && insertionsOnly)
+      {
+        cachedActivationOrder = activationOrder;
+        cachedCholFactor = matUtriCholFactor;
+        insertionsOnly = false;
+        reuseCachedPrefix = false;
+      }
+
       // Index is in position changeInd in activeSet.
       if (useCholesky)
         CholeskyDelete(changeInd);
@@ -454,6 +513,14 @@ double LARS::Train(const arma::mat& matX,
     }
   }
 
+  // If the whole path was built by insertions only, the final factor (and its
+  // activation order) is the cache for the next warm-started call.
+  if (warmStart && useCholesky && insertionsOnly && !activationOrder.empty())
+  {
+    cachedActivationOrder = activationOrder;
+    cachedCholFactor = matUtriCholFactor;
+  }
+
   // Unfortunate copy...
   beta = betaPath.back();
 
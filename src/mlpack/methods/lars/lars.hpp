@@ -266,6 +266,22 @@ class LARS
   //! Access the upper triangular cholesky factor.
   const arma::mat& MatUtriCholFactor() const { return matUtriCholFactor; }
 
+  //! Get whether warm starting across Train() calls is enabled.
+  bool WarmStart() const { return warmStart; }
+  /**
+   * Modify whether warm starting across Train() calls is enabled.  Warm
+   * starting is meant for solving many problems that share one design matrix
+   * but have different responses, as in sparse coding or multi-target
+   * regression.  When enabled, successive calls to Train() must use the same
+   * design matrix (and therefore the same Gram matrix): the activation order
+   * and Cholesky factor of the previous call are cached, and as long as the
+   * new problem activates the same variables in the same order, the
+   * incremental factor updates for that prefix are replaced by reuse of the
+   * cached factor.  The solutions are unchanged; only redundant Gram and
+   * factorization work is skipped.
+   */
+  bool& WarmStart() { return warmStart; }
+
   /**
    * Serialize the LARS model.
    */
@@ -314,6 +330,18 @@ class LARS
   //! Tolerance for main loop.
   double tolerance;
 
+  //! Whether to reuse Cholesky state across Train() calls that share the same
+  //! design matrix.
+  bool warmStart;
+
+  //! Activation order of the previous warm-started Train() call, up to the
+  //! first deactivation.
+  std::vector<size_t> cachedActivationOrder;
+
+  //! Cholesky factor corresponding to cachedActivationOrder; its leading
+  //! blocks are the factors of every prefix of that order.
+  arma::mat cachedCholFactor;
+
   //! Solution path.
   std::vector<arma::vec> betaPath;
 
@@ -88,6 +88,60 @@ double LinearRegression::Train(const arma::mat& predictors,
   return ComputeError(predictors, responses);
 }
 
+void LinearRegression::StartTrainChunks(const size_t dimensionality,
+                                        const bool intercept)
+{
+  this->intercept = intercept;
+
+  // The intercept term, if any, is one extra dimension of the design matrix.
+  const size_t d = intercept ? dimensionality + 1 : dimensionality;
+  chunkCov.zeros(d, d);
+  chunkXty.zeros(d);
+}
+
+void LinearRegression::TrainChunk(const arma::mat& predictors,
+                                  const arma::rowvec& responses)
+{
+  if (chunkCov.n_elem == 0)
+  {
+    Log::Fatal << "LinearRegression::TrainChunk(): call StartTrainChunks() "
+        "before passing chunks!" << std::endl;
+  }
+
+  const size_t d = intercept ? predictors.n_rows + 1 : predictors.n_rows;
+  if (d != chunkCov.n_rows)
+  {
+    Log::Fatal << "LinearRegression::TrainChunk(): chunk dimensionality ("
+        << predictors.n_rows << ") does not match the dimensionality given to "
+        "StartTrainChunks()!" << std::endl;
+  }
+
+  arma::mat p = predictors;
+  if (intercept)
+    p.insert_rows(0, arma::ones<arma::mat>(1, predictors.n_cols));
+
+  // Both X X^T and X y^T are sums over points, so they can be accumulated one
+  // chunk at a time; only these d x d accumulators persist between chunks.
+  chunkCov += p * p.t();
+  chunkXty += p * responses.t();
+}
+
+void LinearRegression::FinishTrainChunks()
+{
+  if (chunkCov.n_elem == 0)
+  {
+    Log::Fatal << "LinearRegression::FinishTrainChunks(): call "
+        "StartTrainChunks() and TrainChunk() first!" << std::endl;
+  }
+
+  chunkCov.diag() += lambda;
+  parameters = arma::solve(chunkCov, chunkXty);
+
+  // Release the accumulators; a new streaming run must start from scratch.
+  chunkCov.reset();
+  chunkXty.reset();
+}
+
 void LinearRegression::Predict(const arma::mat& points,
     arma::rowvec& predictions) const
 {
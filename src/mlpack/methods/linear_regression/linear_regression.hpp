@@ -95,6 +95,38 @@ class LinearRegression
                const arma::rowvec& weights,
                const bool intercept = true);
 
+  /**
+   * Prepare the model for streaming (out-of-core) training.  Instead of
+   * materializing the full design matrix, the normal equations are accumulated
+   * blockwise: call TrainChunk() once for every chunk of the dataset (in any
+   * order), then FinishTrainChunks() to solve for the parameters.  Only the
+   * d x d Gram matrix is kept in memory between chunks, so datasets of any
+   * number of points can be used.  The result is identical to Train() on the
+   * concatenation of all chunks.
+   *
+   * @param dimensionality Number of dimensions of the data (not counting the
+   *      intercept term).
+   * @param intercept Whether or not to fit an intercept term.
+   */
+  void StartTrainChunks(const size_t dimensionality,
+                        const bool intercept = true);
+
+  /**
+   * Accumulate one chunk of training data.  StartTrainChunks() must have been
+   * called first; the chunk must have the dimensionality given there.
+   *
+   * @param predictors X, one chunk of data points.
+   * @param responses y, the measured data for each point in the chunk.
+   */
+  void TrainChunk(const arma::mat& predictors, const arma::rowvec& responses);
+
+  /**
+   * Solve the normal equations accumulated by TrainChunk() calls and store the
+   * result in the model parameters.  The accumulators are released, so a new
+   * streaming run must begin with StartTrainChunks().
+   */
+  void FinishTrainChunks();
+
   /**
    * Calculate y_i for each data point in points.
    *
@@ -162,6 +194,12 @@ class LinearRegression
 
   //! Indicates whether first parameter is intercept.
   bool intercept;
+
+  //! Accumulated Gram matrix (X X^T) for streaming training; empty unless a
+  //! streaming run is in progress.  Not serialized: it is scratch state.
+  arma::mat chunkCov;
+  //! Accumulated X y^T for streaming training.
+  arma::vec chunkXty;
 };
 
 } // namespace regression
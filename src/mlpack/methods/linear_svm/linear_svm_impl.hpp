@@ -15,6 +15,8 @@
 // In case it hasn't been included yet.
 #include "linear_svm.hpp"
 
+#include <random>
+
 namespace mlpack {
 namespace svm {
 
@@ -144,6 +146,161 @@ double LinearSVM<MatType>::Train(
   return out;
 }
 
+template <typename MatType>
+double LinearSVM<MatType>::Train(
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const DualCoordinateDescent& solver)
+{
+  if (numClasses <= 1)
+  {
+    throw std::invalid_argument("LinearSVM dataset has 0 number of classes!");
+  }
+
+  this->numClasses = numClasses;
+
+  const size_t dimensionality = data.n_rows;
+  const size_t numExamples = data.n_cols;
+
+  Timer::Start("linear_svm_optimization");
+
+  // Our primal objective is lambda / 2 * ||w||^2 + sum(hinge) / n; dividing
+  // through by lambda gives the liblinear form 1 / 2 * ||w||^2 +
+  // C * sum(hinge) with C = 1 / (lambda * n).
+  const double boxC = 1.0 / (lambda * numExamples);
+
+  // Precompute the diagonal of the dual Hessian (the squared norm of each
+  // example); the intercept acts as an implicit extra feature of value 1.
+  arma::vec squaredNorms(numExamples);
+  for (size_t i = 0; i < numExamples; ++i)
+  {
+    squaredNorms(i) = arma::dot(data.col(i), data.col(i)) +
+        (fitIntercept ? 1.0 : 0.0);
+  }
+
+  parameters.zeros(dimensionality + (fitIntercept ? 1 : 0), numClasses);
+
+  // The one-vs-rest subproblems are independent, and each writes only its
+  // own column of the parameter matrix, so no synchronization is needed.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t c = 0; c < (omp_size_t) numClasses; ++c)
+  {
+    arma::vec w(dimensionality, arma::fill::zeros);
+    double intercept = 0.0;
+    arma::vec alpha(numExamples, arma::fill::zeros);
+
+    // The active set used by the shrinking heuristic; shrunk examples are
+    // swapped past the end.
+    std::vector<size_t> active(numExamples);
+    for (size_t i = 0; i < numExamples; ++i)
+      active[i] = i;
+    size_t activeSize = numExamples;
+
+    // Shrinking thresholds carried over from the previous epoch.
+    double upperBoundOld = DBL_MAX;
+    double lowerBoundOld = -DBL_MAX;
+
+    // A per-class generator keeps the parallel loop free of shared random
+    // state.
+    std::mt19937 rng((uint32_t) c);
+
+    for (size_t epoch = 0; epoch < solver.maxIterations; ++epoch)
+    {
+      double maxPG = -DBL_MAX;
+      double minPG = DBL_MAX;
+
+      std::shuffle(active.begin(), active.begin() + activeSize, rng);
+
+      for (size_t s = 0; s < activeSize; )
+      {
+        const size_t i = active[s];
+        const double y = (labels[i] == (size_t) c) ? 1.0 : -1.0;
+        const double score = arma::dot(w, data.col(i)) +
+            (fitIntercept ? intercept : 0.0);
+        const double gradient = y * score - 1.0;
+
+        // Compute the projected gradient, shrinking bound variables whose
+        // gradient has moved past last epoch's thresholds.
+        double projected = gradient;
+        if (alpha(i) == 0.0)
+        {
+          if (gradient > upperBoundOld)
+          {
+            std::swap(active[s], active[--activeSize]);
+            continue;
+          }
+          else if (gradient >= 0.0)
+          {
+            projected = 0.0;
+          }
+        }
+        else if (alpha(i) == boxC)
+        {
+          if (gradient < lowerBoundOld)
+          {
+            std::swap(active[s], active[--activeSize]);
+            continue;
+          }
+          else if (gradient <= 0.0)
+          {
+            projected = 0.0;
+          }
+        }
+
+        maxPG = std::max(maxPG, projected);
+        minPG = std::min(minPG, projected);
+
+        if (std::abs(projected) > 1e-12)
+        {
+          const double alphaOld = alpha(i);
+          alpha(i) = std::min(std::max(
+              alphaOld - gradient / squaredNorms(i), 0.0), boxC);
+          const double step = (alpha(i) - alphaOld) * y;
+          w += step * data.col(i);
+          if (fitIntercept)
+            intercept += step;
+        }
+
+        ++s;
+      }
+
+      if (maxPG - minPG <= solver.tolerance)
+      {
+        // If we converged on the full set, we are done; otherwise take one
+        // final unshrunk pass before declaring convergence.
+        if (activeSize == numExamples)
+          break;
+
+        activeSize = numExamples;
+        upperBoundOld = DBL_MAX;
+        lowerBoundOld = -DBL_MAX;
+        continue;
+      }
+
+      upperBoundOld = (maxPG <= 0.0) ? DBL_MAX : maxPG;
+      lowerBoundOld = (minPG >= 0.0) ? -DBL_MAX : minPG;
+    }
+
+    parameters.submat(0, c, dimensionality - 1, c) = w;
+    if (fitIntercept)
+      parameters(dimensionality, c) = intercept;
+  }
+
+  Timer::Stop("linear_svm_optimization");
+
+  // Report the regularized multiclass objective of the trained parameters,
+  // as the other Train() overloads do.
+  LinearSVMFunction<MatType> svm(data, labels, numClasses, lambda, delta,
+      fitIntercept);
+  const double out = svm.Evaluate(parameters);
+
+  Log::Info << "LinearSVM::LinearSVM(): final objective of "
+            << "trained model is " << out << "." << std::endl;
+
+  return out;
+}
+
 template <typename MatType>
 void LinearSVM<MatType>::Classify(
     const MatType& data,
@@ -347,10 +347,8 @@ static void mlpackMain()
 
       ens::ConstantStep decayPolicy(stepSize);
 
-      #ifdef HAS_OPENMP
-      size_t threads = omp_get_max_threads();
-      #else
-      size_t threads = 1;
+      const size_t threads = Threads();
+      #ifndef HAS_OPENMP
       Log::Warn << "Using parallel SGD, but OpenMP support is "
                 << "not available!" << endl;
       #endif
@@ -226,6 +226,8 @@ class LMNNFunction
   arma::mat maxImpNorm;
   //! Holds previous transformation matrix. Used for L-BFGS like optimizer.
   arma::mat transformationOld;
+  //! Transformation matrix the cached transformedDataset was computed with.
+  arma::mat lastTransformation;
   //! Holds previous transformation matrices.
   std::vector<arma::mat> oldTransformationMatrices;
   //! Holds number of points which are using each transformation matrix.
@@ -242,6 +244,12 @@ class LMNNFunction
   * uses batches.
   */
   inline void Precalculate();
+  /**
+  * Apply the given transformation to the dataset, storing the result in
+  * transformedDataset.  If the transformation is unchanged since the last
+  * call the cached transformed dataset is reused.
+  */
+  inline void TransformDataset(const arma::mat& transformation);
   //! Update cache transformation matrices.
   inline void UpdateCache(const arma::mat& transformation,
                           const size_t begin,
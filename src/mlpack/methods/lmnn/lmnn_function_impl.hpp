@@ -120,11 +120,34 @@ void LMNNFunction<MetricType>::Shuffle()
     evalOld.slice(i) = newEvalOld.slice(ordering(i));
   }
 
+  // The cached transformed dataset is no longer valid, since the dataset
+  // columns have been reordered.
+  lastTransformation.clear();
+
   // Re-calculate target neighbors as indices changed.
   constraint.PreCalulated() = false;
   constraint.TargetNeighbors(targetNeighbors, dataset, labels, norm);
 }
 
+// Apply the transformation to the dataset, if it has changed.
+template<typename MetricType>
+inline void LMNNFunction<MetricType>::TransformDataset(
+    const arma::mat& transformation)
+{
+  // If the transformation has not changed since the last call, the cached
+  // transformed dataset is still valid and the matrix product can be skipped.
+  if (lastTransformation.n_rows == transformation.n_rows &&
+      lastTransformation.n_cols == transformation.n_cols &&
+      arma::accu(transformation == lastTransformation) ==
+          transformation.n_elem)
+  {
+    return;
+  }
+
+  lastTransformation = transformation;
+  transformedDataset = transformation * dataset;
+}
+
 // Update cache transformation matrices.
 template<typename MetricType>
 inline void LMNNFunction<MetricType>::UpdateCache(
@@ -215,7 +238,7 @@ double LMNNFunction<MetricType>::Evaluate(const arma::mat& transformation)
   double cost = 0;
 
   // Apply metric over dataset.
-  transformedDataset = transformation * dataset;
+  TransformDataset(transformation);
 
   double transformationDiff = 0;
   if (!transformationOld.is_empty())
@@ -349,7 +372,7 @@ double LMNNFunction<MetricType>::Evaluate(const arma::mat& transformation,
   TransDiff(transformationDiffs, transformation, begin, batchSize);
 
   // Apply metric over dataset.
-  transformedDataset = transformation * dataset;
+  TransformDataset(transformation);
 
   if (impBounds && iteration++ % range == 0)
   {
@@ -472,7 +495,7 @@ void LMNNFunction<MetricType>::Gradient(const arma::mat& transformation,
                                         GradType& gradient)
 {
   // Apply metric over dataset.
-  transformedDataset = transformation * dataset;
+  TransformDataset(transformation);
 
   double transformationDiff = 0;
   if (!transformationOld.is_empty() && iteration++ % range == 0)
@@ -605,7 +628,7 @@ void LMNNFunction<MetricType>::Gradient(const arma::mat& transformation,
                                         const size_t batchSize)
 {
   // Apply metric over dataset.
-  transformedDataset = transformation * dataset;
+  TransformDataset(transformation);
 
   // Calculate norm of change in transformation.
   std::map<size_t, double> transformationDiffs;
@@ -744,7 +767,7 @@ double LMNNFunction<MetricType>::EvaluateWithGradient(
   double cost = 0;
 
   // Apply metric over dataset.
-  transformedDataset = transformation * dataset;
+  TransformDataset(transformation);
 
   double transformationDiff = 0;
   if (!transformationOld.is_empty())
@@ -891,7 +914,7 @@ double LMNNFunction<MetricType>::EvaluateWithGradient(
   TransDiff(transformationDiffs, transformation, begin, batchSize);
 
   // Apply metric over dataset.
-  transformedDataset = transformation * dataset;
+  TransformDataset(transformation);
 
   if (impBounds && iteration++ % range == 0)
   {
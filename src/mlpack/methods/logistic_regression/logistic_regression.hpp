@@ -159,6 +159,24 @@ class LogisticRegression
                OptimizerType& optimizer,
                CallbackTypes&&... callbacks);
 
+  /**
+   * Train the LogisticRegression model on one chunk of a dataset too large to
+   * fit in memory.  One epoch of mini-batch SGD is run over the chunk,
+   * starting from the current model parameters, so calling this method for
+   * every chunk of the dataset (and making several passes over the chunks)
+   * implements streaming out-of-core training.
+   *
+   * @param predictors One chunk of input training variables.
+   * @param responses Outputs results from the chunk of training variables.
+   * @param stepSize Step size of the mini-batch SGD updates.
+   * @param batchSize Number of points in each mini-batch.
+   * @return The objective on the chunk after the epoch.
+   */
+  double TrainChunk(const MatType& predictors,
+                    const arma::Row<size_t>& responses,
+                    const double stepSize = 0.01,
+                    const size_t batchSize = 32);
+
   //! Return the parameters (the b vector).
   const arma::rowvec& Parameters() const { return parameters; }
   //! Modify the parameters (the b vector).
@@ -191,6 +209,9 @@ class LogisticRegression
    * the response is taken to be 1; otherwise, it is 0.  By default the decision
    * boundary is 0.5.
    *
+   * This method does not modify the model, so concurrent calls on a shared
+   * trained model are safe.
+   *
    * @param dataset Set of points to classify.
    * @param labels Predicted labels for each point.
    * @param decisionBoundary Decision boundary (default 0.5).
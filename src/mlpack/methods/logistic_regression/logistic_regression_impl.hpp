@@ -101,6 +101,20 @@ double LogisticRegression<MatType>::Train(
   return out;
 }
 
+template<typename MatType>
+double LogisticRegression<MatType>::TrainChunk(
+    const MatType& predictors,
+    const arma::Row<size_t>& responses,
+    const double stepSize,
+    const size_t batchSize)
+{
+  // One epoch over the chunk: SGD counts individual point visits, so the
+  // maximum number of iterations is the number of points in the chunk.  The
+  // tolerance is disabled so that the epoch always completes.
+  ens::SGD<> optimizer(stepSize, batchSize, predictors.n_cols, -1.0);
+  return Train(predictors, responses, optimizer);
+}
+
 template<typename MatType>
 template<typename VecType>
 size_t LogisticRegression<MatType>::Classify(const VecType& point,
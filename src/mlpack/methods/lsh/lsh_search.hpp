@@ -290,10 +290,13 @@ class LSHSearch
   //! Get the bucket size of the second hash.
   size_t BucketSize() const { return bucketSize; }
 
-  //! Get the second hash table.
-  const std::vector<arma::Col<size_t>>& SecondHashTable() const
+  //! Get the second hash table (all buckets concatenated in row order).
+  const arma::Col<size_t>& SecondHashTable() const
       { return secondHashTable; }
 
+  //! Get the offset of each bucket row in the second hash table.
+  const arma::Col<size_t>& BucketOffsets() const { return bucketOffsets; }
+
   //! Get the projection tables.
   const arma::cube& Projections() { return projections; }
 
@@ -327,6 +330,30 @@ class LSHSearch
                               size_t numTablesToSearch,
                               const size_t T) const;
 
+  /**
+   * Collect neighbor candidates for a query whose projections into the hash
+   * tables have already been computed.  This is the bulk path used by
+   * Search(), which hashes an entire block of queries into each table with a
+   * single matrix multiplication and then calls this overload per query, so
+   * no per-query projection work is left.
+   *
+   * @param queryCodesNotFloored Matrix of size numProj x numTablesToSearch
+   *    whose column i holds the (offset, unfloored) projection of the query
+   *    into table i.
+   * @param referenceIndices The list of neighbor candidates obtained from
+   *    hashing the query into all the hash tables and eventually into
+   *    multiple buckets of the second hash table.
+   * @param numTablesToSearch The number of tables to perform the search in;
+   *    must match the number of columns of queryCodesNotFloored and be at
+   *    most numTables.
+   * @param T The number of additional probing bins for multiprobe LSH. If 0,
+   *    single-probe is used.
+   */
+  void ReturnIndicesFromTable(const arma::mat& queryCodesNotFloored,
+                              arma::uvec& referenceIndices,
+                              const size_t numTablesToSearch,
+                              const size_t T) const;
+
   /**
    * This is a helper function that computes the distance of the query to the
    * neighbor candidates and appropriately stores the best 'k' candidates.  This
@@ -450,12 +477,19 @@ class LSHSearch
   //! The bucket size of the second hash.
   size_t bucketSize;
 
-  //! The final hash table; should be (< secondHashSize) vectors each with
-  //! (<= bucketSize) elements.
-  std::vector<arma::Col<size_t>> secondHashTable;
+  //! The final hash table: the contents of all (< secondHashSize) non-empty
+  //! buckets, concatenated in bucket row order, so that every bucket is a
+  //! contiguous range and candidate gathering is a sequential scan.  Bucket
+  //! row r holds the elements at positions [bucketOffsets[r],
+  //! bucketOffsets[r] + bucketContentSize[r]).
+  arma::Col<size_t> secondHashTable;
+
+  //! The position at which each bucket row begins in secondHashTable; length
+  //! is the number of non-empty buckets.
+  arma::Col<size_t> bucketOffsets;
 
-  //! The number of elements present in each hash bucket; should be
-  //! secondHashSize.
+  //! The number of elements present in each hash bucket row; length is the
+  //! number of non-empty buckets.
   arma::Col<size_t> bucketContentSize;
 
   //! For a particular hash value, points to the row in secondHashTable
@@ -84,6 +84,7 @@ LSHSearch<SortPolicy, MatType>::LSHSearch(const LSHSearch& other) :
     secondHashWeights(other.secondHashWeights),
     bucketSize(other.bucketSize),
     secondHashTable(other.secondHashTable),
+    bucketOffsets(other.bucketOffsets),
     bucketContentSize(other.bucketContentSize),
     bucketRowInHashTable(other.bucketRowInHashTable),
     distanceEvaluations(other.distanceEvaluations)
@@ -104,6 +105,7 @@ LSHSearch<SortPolicy, MatType>::LSHSearch(LSHSearch&& other) :
     secondHashWeights(std::move(other.secondHashWeights)),
     bucketSize(other.bucketSize),
     secondHashTable(std::move(other.secondHashTable)),
+    bucketOffsets(std::move(other.bucketOffsets)),
     bucketContentSize(std::move(other.bucketContentSize)),
     bucketRowInHashTable(std::move(other.bucketRowInHashTable)),
     distanceEvaluations(other.distanceEvaluations)
@@ -132,6 +134,7 @@ LSHSearch<SortPolicy, MatType>& LSHSearch<SortPolicy, MatType>::operator=(
   secondHashWeights = other.secondHashWeights;
   bucketSize = other.bucketSize;
   secondHashTable = other.secondHashTable;
+  bucketOffsets = other.bucketOffsets;
   bucketContentSize = other.bucketContentSize;
   bucketRowInHashTable = other.bucketRowInHashTable;
   distanceEvaluations = other.distanceEvaluations;
@@ -154,6 +157,7 @@ LSHSearch<SortPolicy, MatType>& LSHSearch<SortPolicy, MatType>::operator=(
   secondHashWeights = std::move(other.secondHashWeights);
   bucketSize = other.bucketSize;
   secondHashTable = std::move(other.secondHashTable);
+  bucketOffsets = std::move(other.bucketOffsets);
   bucketContentSize = std::move(other.bucketContentSize);
   bucketRowInHashTable = std::move(other.bucketRowInHashTable);
   distanceEvaluations = other.distanceEvaluations;
@@ -258,7 +262,11 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
   // size_t, otherwise negative numbers are cast to 0.
   arma::Mat<size_t> secondHashVectors(numTables, this->referenceSet.n_cols);
 
-  for (size_t i = 0; i < numTables; ++i)
+  // Each table writes only its own row of 'secondHashVectors' and reads the
+  // shared projections, offsets, and hash weights, so all tables can be
+  // hashed in parallel.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) numTables; ++i)
   {
     // Step IV: create the 'numProj'-dimensional key for each point in each
     // table.
@@ -310,36 +318,45 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
       { return std::min(val, effectiveBucketSize); });
 
   const size_t numRowsInTable = arma::accu(secondHashBinCounts > 0);
-  bucketContentSize.zeros(numRowsInTable);
-  secondHashTable.resize(numRowsInTable);
 
-  // Next we must assign each point in each table to the right second hash
-  // table.
+  // Assign every non-empty bucket a row and lay the rows out contiguously:
+  // bucket row r occupies the positions [bucketOffsets[r], bucketOffsets[r] +
+  // bucketContentSize[r]) of 'secondHashTable'.  Storing all buckets in one
+  // array means gathering the candidates of a bucket during search is a
+  // sequential scan instead of a chase through separately allocated vectors.
+  bucketOffsets.set_size(numRowsInTable);
   size_t currentRow = 0;
+  size_t totalSize = 0;
+  for (size_t i = 0; i < secondHashSize; ++i)
+  {
+    if (secondHashBinCounts[i] > 0)
+    {
+      bucketRowInHashTable[i] = currentRow;
+      bucketOffsets[currentRow] = totalSize;
+      totalSize += secondHashBinCounts[i];
+      currentRow++;
+    }
+  }
+  secondHashTable.set_size(totalSize);
+
+  // Next we must assign each point in each table to the right second hash
+  // table.  Points that do not fit into their (capped) bucket are dropped,
+  // keeping the same first-come insertion order as before.
+  bucketContentSize.zeros(numRowsInTable);
   for (size_t i = 0; i < numTables; ++i)
   {
-    // Insert the point in the corresponding row to its bucket in the
+    // Insert the point in the range corresponding to its bucket in the
     // 'secondHashTable'.
     for (size_t j = 0; j < secondHashVectors.n_cols; ++j)
     {
       // This is the bucket number.
-      size_t hashInd = (size_t) secondHashVectors(i, j);
+      const size_t hashInd = (size_t) secondHashVectors(i, j);
       // The point ID is 'j'.
+      const size_t row = bucketRowInHashTable[hashInd];
 
-      // If this is currently an empty bucket, start a new row keep track of
-      // which row corresponds to the bucket.
-      const size_t maxSize = secondHashBinCounts[hashInd];
-      if (bucketRowInHashTable[hashInd] == secondHashSize)
-      {
-        bucketRowInHashTable[hashInd] = currentRow;
-        secondHashTable[currentRow].set_size(maxSize);
-        currentRow++;
-      }
-
-      // If this vector in the hash table is not full, add the point.
-      const size_t index = bucketRowInHashTable[hashInd];
-      if (bucketContentSize[index] < maxSize)
-        secondHashTable[index](bucketContentSize[index]++) = j;
+      // If this bucket's range in the hash table is not full, add the point.
+      if (bucketContentSize[row] < secondHashBinCounts[hashInd])
+        secondHashTable[bucketOffsets[row] + bucketContentSize[row]++] = j;
     } // Loop over all points in the reference set.
   } // Loop over tables.
 
@@ -725,13 +742,25 @@ void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
   // vector.
 
   // Compute the projection of the query in each table.
-  arma::mat allProjInTables(numProj, numTablesToSearch);
   arma::mat queryCodesNotFloored(numProj, numTablesToSearch);
   for (size_t i = 0; i < numTablesToSearch; ++i)
     queryCodesNotFloored.unsafe_col(i) = projections.slice(i).t() * queryPoint;
 
   queryCodesNotFloored += offsets.cols(0, numTablesToSearch - 1);
-  allProjInTables = arma::floor(queryCodesNotFloored / hashWidth);
+
+  // Now gather the candidates from the precomputed codes.
+  ReturnIndicesFromTable(queryCodesNotFloored, referenceIndices,
+      numTablesToSearch, T);
+}
+
+template<typename SortPolicy, typename MatType>
+void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
+    const arma::mat& queryCodesNotFloored,
+    arma::uvec& referenceIndices,
+    const size_t numTablesToSearch,
+    const size_t T) const
+{
+  arma::mat allProjInTables = arma::floor(queryCodesNotFloored / hashWidth);
 
   // Use hashMat to store the primary probing codes and any additional codes
   // from multiprobe LSH.
@@ -811,8 +840,9 @@ void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
         if (tableRow < secondHashSize && bucketContentSize[tableRow] > 0)
         {
           // Pick the indices in the bucket corresponding to hashInd.
+          const size_t offset = bucketOffsets[tableRow];
           for (size_t j = 0; j < bucketContentSize[tableRow]; ++j)
-            refPointsConsidered[ secondHashTable[tableRow](j) ]++;
+            refPointsConsidered[ secondHashTable[offset + j] ]++;
         }
       }
     }
@@ -842,8 +872,9 @@ void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
         if (tableRow < secondHashSize)
         {
           // Store all secondHashTable points in the candidates set.
+          const size_t offset = bucketOffsets[tableRow];
           for (size_t j = 0; j < bucketContentSize[tableRow]; ++j)
-            refPointsConsideredSmall(start++) = secondHashTable[tableRow](j);
+            refPointsConsideredSmall(start++) = secondHashTable[offset + j];
        }
       }
     }
@@ -907,33 +938,60 @@ void LSHSearch<SortPolicy, MatType>::Search(
     Log::Info << "Running multiprobe LSH with " << Teffective
         <<" additional probing bins per table per query." << std::endl;
 
+  // Decide on the number of tables to look into, for all queries at once.
+  size_t effectiveTables = numTablesToSearch;
+  if (effectiveTables == 0 || effectiveTables > numTables)
+    effectiveTables = numTables;
+
   size_t avgIndicesReturned = 0;
 
   Timer::Start("computing_neighbors");
 
-  // Parallelization to process more than one query at a time.
-  #pragma omp parallel for \
-      shared(resultingNeighbors, distances) \
-      schedule(dynamic)\
-      reduction(+:avgIndicesReturned)
-  for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+  // Process the queries in blocks: hashing an entire block of queries into a
+  // table is a single matrix multiplication, which is far faster than one
+  // matrix-vector product per query per table.  The block size bounds the
+  // memory used for the precomputed codes.
+  const size_t blockSize = 512;
+  arma::cube queryCodes;
+  arma::mat projBlock;
+  for (size_t begin = 0; begin < querySet.n_cols; begin += blockSize)
   {
-    // Go through every query point.
-    // Hash every query into every hash table and eventually into the
-    // 'secondHashTable' to obtain the neighbor candidates.
-    arma::uvec refIndices;
-    ReturnIndicesFromTable(querySet.col(i), refIndices, numTablesToSearch,
-        Teffective);
-
-    // An informative book-keeping for the number of neighbor candidates
-    // returned on average.
-    // Make atomic to avoid race conditions when multiple threads are running
-    // #pragma omp atomic
-    avgIndicesReturned = avgIndicesReturned + refIndices.n_elem;
-
-    // Sequentially go through all the candidates and save the best 'k'
-    // candidates.
-    BaseCase(i, refIndices, k, querySet, resultingNeighbors, distances);
+    const size_t end = std::min(begin + blockSize,
+        (size_t) querySet.n_cols) - 1;
+
+    // queryCodes.slice(q) holds the numProj x effectiveTables code matrix of
+    // query begin + q, which is the layout the candidate gather expects.
+    queryCodes.set_size(numProj, effectiveTables, end - begin + 1);
+    for (size_t t = 0; t < effectiveTables; ++t)
+    {
+      projBlock = projections.slice(t).t() * querySet.cols(begin, end);
+      projBlock.each_col() += offsets.col(t);
+      for (size_t q = 0; q < queryCodes.n_slices; ++q)
+        queryCodes.slice(q).col(t) = projBlock.col(q);
+    }
+
+    // Parallelization to process more than one query at a time.
+    #pragma omp parallel for \
+        shared(resultingNeighbors, distances, queryCodes) \
+        schedule(dynamic)\
+        reduction(+:avgIndicesReturned)
+    for (omp_size_t i = (omp_size_t) begin; i <= (omp_size_t) end; ++i)
+    {
+      // Go through every query point.  The query has already been hashed into
+      // every hash table; gather the neighbor candidates from the
+      // 'secondHashTable'.
+      arma::uvec refIndices;
+      ReturnIndicesFromTable(queryCodes.slice(i - begin), refIndices,
+          effectiveTables, Teffective);
+
+      // An informative book-keeping for the number of neighbor candidates
+      // returned on average.
+      avgIndicesReturned = avgIndicesReturned + refIndices.n_elem;
+
+      // Sequentially go through all the candidates and save the best 'k'
+      // candidates.
+      BaseCase(i, refIndices, k, querySet, resultingNeighbors, distances);
+    }
   }
 
   Timer::Stop("computing_neighbors");
@@ -973,33 +1031,60 @@ Search(const size_t k,
     Log::Info << "Running multiprobe LSH with " << Teffective <<
       " additional probing bins per table per query."<< std::endl;
 
+  // Decide on the number of tables to look into, for all queries at once.
+  size_t effectiveTables = numTablesToSearch;
+  if (effectiveTables == 0 || effectiveTables > numTables)
+    effectiveTables = numTables;
+
   size_t avgIndicesReturned = 0;
 
   Timer::Start("computing_neighbors");
 
-  // Parallelization to process more than one query at a time.
-  #pragma omp parallel for \
-      shared(resultingNeighbors, distances) \
-      schedule(dynamic)\
-      reduction(+:avgIndicesReturned)
-  for (omp_size_t i = 0; i < (omp_size_t) referenceSet.n_cols; ++i)
+  // Process the queries in blocks: hashing an entire block of queries into a
+  // table is a single matrix multiplication, which is far faster than one
+  // matrix-vector product per query per table.  The block size bounds the
+  // memory used for the precomputed codes.
+  const size_t blockSize = 512;
+  arma::cube queryCodes;
+  arma::mat projBlock;
+  for (size_t begin = 0; begin < referenceSet.n_cols; begin += blockSize)
   {
-    // Go through every query point.
-    // Hash every query into every hash table and eventually into the
-    // 'secondHashTable' to obtain the neighbor candidates.
-    arma::uvec refIndices;
-    ReturnIndicesFromTable(referenceSet.col(i), refIndices, numTablesToSearch,
-        Teffective);
-
-    // An informative book-keeping for the number of neighbor candidates
-    // returned on average.
-    // Make atomic to avoid race conditions when multiple threads are running.
-    // #pragma omp atomic
-    avgIndicesReturned += refIndices.n_elem;
-
-    // Sequentially go through all the candidates and save the best 'k'
-    // candidates.
-    BaseCase(i, refIndices, k, resultingNeighbors, distances);
+    const size_t end = std::min(begin + blockSize,
+        (size_t) referenceSet.n_cols) - 1;
+
+    // queryCodes.slice(q) holds the numProj x effectiveTables code matrix of
+    // query begin + q, which is the layout the candidate gather expects.
+    queryCodes.set_size(numProj, effectiveTables, end - begin + 1);
+    for (size_t t = 0; t < effectiveTables; ++t)
+    {
+      projBlock = projections.slice(t).t() * referenceSet.cols(begin, end);
+      projBlock.each_col() += offsets.col(t);
+      for (size_t q = 0; q < queryCodes.n_slices; ++q)
+        queryCodes.slice(q).col(t) = projBlock.col(q);
+    }
+
+    // Parallelization to process more than one query at a time.
+    #pragma omp parallel for \
+        shared(resultingNeighbors, distances, queryCodes) \
+        schedule(dynamic)\
+        reduction(+:avgIndicesReturned)
+    for (omp_size_t i = (omp_size_t) begin; i <= (omp_size_t) end; ++i)
+    {
+      // Go through every query point.  The query has already been hashed into
+      // every hash table; gather the neighbor candidates from the
+      // 'secondHashTable'.
+      arma::uvec refIndices;
+      ReturnIndicesFromTable(queryCodes.slice(i - begin), refIndices,
+          effectiveTables, Teffective);
+
+      // An informative book-keeping for the number of neighbor candidates
+      // returned on average.
+      avgIndicesReturned += refIndices.n_elem;
+
+      // Sequentially go through all the candidates and save the best 'k'
+      // candidates.
+      BaseCase(i, refIndices, k, resultingNeighbors, distances);
+    }
   }
 
   Timer::Stop("computing_neighbors");
@@ -1057,6 +1142,7 @@ void LSHSearch<SortPolicy, MatType>::serialize(Archive& ar,
   ar(CEREAL_NVP(secondHashWeights));
   ar(CEREAL_NVP(bucketSize));
   ar(CEREAL_NVP(secondHashTable));
+  ar(CEREAL_NVP(bucketOffsets));
   ar(CEREAL_NVP(bucketContentSize));
   ar(CEREAL_NVP(bucketRowInHashTable));
   ar(CEREAL_NVP(distanceEvaluations));
@@ -0,0 +1,210 @@
+/**
+ * @file methods/matrix_completion/als_matrix_completion.cpp
+ *
+ * Implementation of ALSMatrixCompletion class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#include "als_matrix_completion.hpp"
+
+namespace mlpack {
+namespace matrix_completion {
+
+ALSMatrixCompletion::ALSMatrixCompletion(const size_t m,
+                                         const size_t n,
+                                         const arma::umat& indices,
+                                         const arma::vec& values,
+                                         const size_t r) :
+    m(m), n(n), indices(indices), values(values), rank(r),
+    lambda(1e-6), maxIterations(100), tolerance(1e-7)
+{
+  CheckValues();
+  IndexEntries();
+}
+
+ALSMatrixCompletion::ALSMatrixCompletion(const size_t m,
+                                         const size_t n,
+                                         const arma::umat& indices,
+                                         const arma::vec& values) :
+    m(m), n(n), indices(indices), values(values),
+    rank(DefaultRank(m, n, indices.n_cols)),
+    lambda(1e-6), maxIterations(100), tolerance(1e-7)
+{
+  CheckValues();
+  IndexEntries();
+}
+
+void ALSMatrixCompletion::CheckValues()
+{
+  if (indices.n_rows != 2)
+  {
+    Log::Fatal << "ALSMatrixCompletion::CheckValues(): matrix of constraint "
+        << "indices does not have 2 rows!" << std::endl;
+  }
+
+  if (indices.n_cols != values.n_elem)
+  {
+    Log::Fatal << "ALSMatrixCompletion::CheckValues(): the number of "
+        << "constraint indices (columns of constraint indices matrix) does "
+        << "not match the number of constraint values (length of constraint "
+        << "value vector)!" << std::endl;
+  }
+
+  for (size_t i = 0; i < values.n_elem; ++i)
+  {
+    if (indices(0, i) >= m || indices(1, i) >= n)
+      Log::Fatal << "ALSMatrixCompletion::CheckValues(): indices ("
+          << indices(0, i) << ", " << indices(1, i)
+          << ") are out of bounds for matrix of size " << m << " x n!"
+          << std::endl;
+  }
+
+  if (rank == 0 || rank > std::min(m, n))
+  {
+    Log::Fatal << "ALSMatrixCompletion::CheckValues(): rank " << rank
+        << " is invalid for a matrix of size " << m << " x " << n << "!"
+        << std::endl;
+  }
+}
+
+void ALSMatrixCompletion::IndexEntries()
+{
+  const size_t p = indices.n_cols;
+
+  // Count the entries of every row and column, then turn the counts into
+  // offsets (a counting sort in both directions).
+  rowPtr.zeros(m + 1);
+  colPtr.zeros(n + 1);
+  for (size_t i = 0; i < p; ++i)
+  {
+    ++rowPtr[indices(0, i) + 1];
+    ++colPtr[indices(1, i) + 1];
+  }
+  for (size_t i = 1; i <= m; ++i)
+    rowPtr[i] += rowPtr[i - 1];
+  for (size_t i = 1; i <= n; ++i)
+    colPtr[i] += colPtr[i - 1];
+
+  colIndex.set_size(p);
+  rowValues.set_size(p);
+  rowIndex.set_size(p);
+  colValues.set_size(p);
+
+  arma::uvec rowFill = rowPtr.subvec(0, m - 1);
+  arma::uvec colFill = colPtr.subvec(0, n - 1);
+  for (size_t i = 0; i < p; ++i)
+  {
+    const size_t rowSlot = rowFill[indices(0, i)]++;
+    colIndex[rowSlot] = indices(1, i);
+    rowValues[rowSlot] = values[i];
+
+    const size_t colSlot = colFill[indices(1, i)]++;
+    rowIndex[colSlot] = indices(0, i);
+    colValues[colSlot] = values[i];
+  }
+}
+
+void ALSMatrixCompletion::SweepFactor(const arma::mat& fixed,
+                                      arma::mat& solve,
+                                      const arma::uvec& ptr,
+                                      const arma::uvec& index,
+                                      const arma::vec& vals)
+{
+  // Every column of 'solve' depends only on the fixed factor and on the
+  // entries observed in the corresponding row (or column) of the matrix, so
+  // the solves are independent and can run in parallel.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) solve.n_cols; ++i)
+  {
+    const size_t begin = ptr[i];
+    const size_t end = ptr[i + 1];
+    if (begin == end)
+    {
+      // Nothing is observed in this row; leave the factor at zero.
+      solve.col(i).zeros();
+      continue;
+    }
+
+    arma::mat gram(rank, rank, arma::fill::zeros);
+    arma::vec rhs(rank, arma::fill::zeros);
+    for (size_t k = begin; k < end; ++k)
+    {
+      gram += fixed.col(index[k]) * fixed.col(index[k]).t();
+      rhs += vals[k] * fixed.col(index[k]);
+    }
+
+    // Weighted regularization (scaled by the number of observed entries),
+    // which also keeps the system positive definite so that the Cholesky
+    // based solver below applies.
+    gram.diag() += lambda * (end - begin);
+
+    solve.col(i) = arma::solve(gram, rhs, arma::solve_opts::likely_sympd);
+  }
+}
+
+double ALSMatrixCompletion::ObservedError(const arma::mat& w,
+                                          const arma::mat& h) const
+{
+  double squaredError = 0.0;
+  #pragma omp parallel for schedule(static) reduction(+:squaredError)
+  for (omp_size_t i = 0; i < (omp_size_t) m; ++i)
+  {
+    for (size_t k = rowPtr[i]; k < rowPtr[i + 1]; ++k)
+    {
+      const double residual = rowValues[k] -
+          arma::dot(w.col(i), h.col(colIndex[k]));
+      squaredError += residual * residual;
+    }
+  }
+
+  return std::sqrt(squaredError / values.n_elem);
+}
+
+void ALSMatrixCompletion::Recover(arma::mat& recovered)
+{
+  arma::mat w = arma::randu<arma::mat>(rank, m);
+  arma::mat h = arma::randu<arma::mat>(rank, n);
+
+  double lastError = DBL_MAX;
+  for (size_t i = 0; i < maxIterations; ++i)
+  {
+    SweepFactor(h, w, rowPtr, colIndex, rowValues);
+    SweepFactor(w, h, colPtr, rowIndex, colValues);
+
+    const double error = ObservedError(w, h);
+    Log::Info << "ALSMatrixCompletion::Recover(): iteration " << i
+        << ", observed RMSE " << error << "." << std::endl;
+
+    if (std::abs(lastError - error) <= tolerance * lastError)
+    {
+      Log::Info << "ALSMatrixCompletion::Recover(): converged after "
+          << (i + 1) << " iterations." << std::endl;
+      break;
+    }
+    lastError = error;
+  }
+
+  recovered = w.t() * h;
+}
+
+size_t ALSMatrixCompletion::DefaultRank(const size_t m,
+                                        const size_t n,
+                                        const size_t p)
+{
+  // The factorization has 2 * r * (m + n) free parameters; keep them safely
+  // below the number of observed entries so that the sweeps do not simply
+  // interpolate the observations.
+  size_t r = (size_t) std::floor(p / (4.0 * (m + n)));
+  if (r == 0)
+    r = 1;
+  if (r > std::min(m, n))
+    r = std::min(m, n);
+  return r;
+}
+
+} // namespace matrix_completion
+} // namespace mlpack
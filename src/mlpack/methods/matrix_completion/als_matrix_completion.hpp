@@ -0,0 +1,189 @@
+/**
+ * @file methods/matrix_completion/als_matrix_completion.hpp
+ *
+ * A scalable alternating least squares solver for low rank matrix completion
+ * problems that operates only on the observed entries.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_MATRIX_COMPLETION_ALS_MATRIX_COMPLETION_HPP
+#define MLPACK_METHODS_MATRIX_COMPLETION_ALS_MATRIX_COMPLETION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace matrix_completion {
+
+/**
+ * This class solves low rank matrix completion problems with regularized
+ * alternating least squares.  Given known values M_ij, it finds factors W
+ * (r x m) and H (r x n) minimizing
+ *
+ *   sum_{(i, j) observed} (M_ij - w_i^T h_j)^2
+ *       + lambda * (||W||_F^2 + ||H||_F^2)
+ *
+ * and recovers X = W^T H.  Each sweep alternately holds one factor fixed and
+ * solves an independent r x r regularized least squares problem per row (or
+ * column) over the entries observed in that row, so the cost per sweep is
+ * linear in the number of observed entries and the full m x n matrix is
+ * never formed during the optimization.  The observed entries are indexed
+ * once by row and once by column (a CSR-like layout), the per-row systems
+ * are symmetric positive definite and solved by Cholesky factorization, and
+ * the row solves are parallelized with OpenMP.
+ *
+ * This is an alternative to the nuclear norm minimization heuristic of
+ * MatrixCompletion behind the same Recover() interface; the SDP solver gives
+ * stronger recovery guarantees, but does not scale to problems with many
+ * observed entries, where this solver should be used instead.
+ *
+ * For more information, see the following paper:
+ *
+ * @code
+ * @incollection{Zhou2008,
+ *   author    = {Yunhong Zhou and Dennis Wilkinson and Robert Schreiber and
+ *                Rong Pan},
+ *   title     = {Large-Scale Parallel Collaborative Filtering for the
+ *                Netflix Prize},
+ *   booktitle = {Algorithmic Aspects in Information and Management},
+ *   year      = {2008}
+ * }
+ * @endcode
+ *
+ * An example of how to use this class is shown below:
+ *
+ * @code
+ * size_t m, n;         // size of unknown matrix
+ * arma::umat indices;  // contains the known indices [2 x n_entries]
+ * arma::vec values;    // contains the known values [n_entries]
+ * arma::mat recovered; // will contain the completed matrix
+ *
+ * ALSMatrixCompletion mc(m, n, indices, values);
+ * mc.Recover(recovered);
+ * @endcode
+ *
+ * @see MatrixCompletion
+ */
+class ALSMatrixCompletion
+{
+ public:
+  /**
+   * Construct a matrix completion problem, specifying the rank of the
+   * factorization.
+   *
+   * @param m Number of rows of original matrix.
+   * @param n Number of columns of original matrix.
+   * @param indices Matrix containing the indices of the known entries (must be
+   *    [2 x p]).
+   * @param values Vector containing the values of the known entries (must be
+   *    length p).
+   * @param r Rank of the factorization.
+   */
+  ALSMatrixCompletion(const size_t m,
+                      const size_t n,
+                      const arma::umat& indices,
+                      const arma::vec& values,
+                      const size_t r);
+
+  /**
+   * Construct a matrix completion problem, selecting the rank of the
+   * factorization heuristically from the number of known entries.
+   *
+   * @param m Number of rows of original matrix.
+   * @param n Number of columns of original matrix.
+   * @param indices Matrix containing the indices of the known entries (must be
+   *    [2 x p]).
+   * @param values Vector containing the values of the known entries (must be
+   *    length p).
+   */
+  ALSMatrixCompletion(const size_t m,
+                      const size_t n,
+                      const arma::umat& indices,
+                      const arma::vec& values);
+
+  /**
+   * Run the alternating least squares sweeps and fill in the remaining
+   * values.
+   *
+   * @param recovered Will contain the completed matrix.
+   */
+  void Recover(arma::mat& recovered);
+
+  //! Get the regularization parameter.
+  double Lambda() const { return lambda; }
+  //! Modify the regularization parameter.
+  double& Lambda() { return lambda; }
+
+  //! Get the maximum number of alternating sweeps.
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of alternating sweeps.
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the relative convergence tolerance on the observed residual.
+  double Tolerance() const { return tolerance; }
+  //! Modify the relative convergence tolerance on the observed residual.
+  double& Tolerance() { return tolerance; }
+
+ private:
+  //! Number of rows in original matrix.
+  size_t m;
+  //! Number of columns in original matrix.
+  size_t n;
+  //! Matrix containing the indices of the known entries (has two rows).
+  arma::umat indices;
+  //! Vector containing the values of the known entries.
+  arma::vec values;
+  //! Rank of the factorization.
+  size_t rank;
+  //! Regularization parameter.
+  double lambda;
+  //! Maximum number of alternating sweeps.
+  size_t maxIterations;
+  //! Relative convergence tolerance on the observed residual.
+  double tolerance;
+
+  //! Offset of each row's entries in colIndex / rowValues (length m + 1).
+  arma::uvec rowPtr;
+  //! Column index of each entry, grouped by row.
+  arma::uvec colIndex;
+  //! Value of each entry, grouped by row.
+  arma::vec rowValues;
+
+  //! Offset of each column's entries in rowIndex / colValues (length n + 1).
+  arma::uvec colPtr;
+  //! Row index of each entry, grouped by column.
+  arma::uvec rowIndex;
+  //! Value of each entry, grouped by column.
+  arma::vec colValues;
+
+  //! Validate the input matrices.
+  void CheckValues();
+
+  //! Build the row-grouped and column-grouped entry indexes.
+  void IndexEntries();
+
+  /**
+   * Solve the regularized least squares problem for every column of the
+   * factor 'solve', holding the factor 'fixed' fixed.  The observed entries
+   * of the corresponding dimension are given in the CSR-like layout (ptr,
+   * index, vals).
+   */
+  void SweepFactor(const arma::mat& fixed,
+                   arma::mat& solve,
+                   const arma::uvec& ptr,
+                   const arma::uvec& index,
+                   const arma::vec& vals);
+
+  //! Compute the root mean squared error over the observed entries.
+  double ObservedError(const arma::mat& w, const arma::mat& h) const;
+
+  //! Select a rank for a matrix of size m x n with p known elements.
+  static size_t DefaultRank(const size_t m, const size_t n, const size_t p);
+};
+
+} // namespace matrix_completion
+} // namespace mlpack
+
+#endif
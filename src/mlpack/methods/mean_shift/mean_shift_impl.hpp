@@ -139,22 +139,33 @@ CalculateCentroid(const MatType& data,
                   const std::vector<double>& distances,
                   arma::colvec& centroid)
 {
-  double sumWeight = 0;
+  // Compute the kernel weights first, then accumulate the weighted sum as a
+  // single gather plus matrix-vector product instead of one scaled vector
+  // addition per neighbor.
+  arma::uvec weightedNeighbors(neighbors.size());
+  arma::vec weights(neighbors.size());
+  size_t found = 0;
   for (size_t i = 0; i < neighbors.size(); ++i)
   {
     if (distances[i] > 0)
     {
-      double dist = distances[i] / radius;
-      double weight = kernel.Gradient(dist) / dist;
-      sumWeight += weight;
-      centroid += weight * data.unsafe_col(neighbors[i]);
+      const double dist = distances[i] / radius;
+      weightedNeighbors[found] = neighbors[i];
+      weights[found] = kernel.Gradient(dist) / dist;
+      ++found;
     }
   }
 
-  if (sumWeight != 0)
+  if (found > 0)
   {
-    centroid /= sumWeight;
-    return true;
+    const double sumWeight = arma::accu(weights.head(found));
+    if (sumWeight != 0)
+    {
+      centroid += data.cols(weightedNeighbors.head(found)) *
+          weights.head(found);
+      centroid /= sumWeight;
+      return true;
+    }
   }
   return false;
 }
@@ -169,8 +180,9 @@ CalculateCentroid(const MatType& data,
                   const std::vector<double>&, /*unused*/
                   arma::colvec& centroid)
 {
-  for (size_t i = 0; i < neighbors.size(); ++i)
-    centroid += data.unsafe_col(neighbors[i]);
+  const arma::uvec neighborIndices =
+      arma::conv_to<arma::uvec>::from(neighbors);
+  centroid += arma::sum(data.cols(neighborIndices), 1);
 
   centroid /= neighbors.size();
   return true;
@@ -212,36 +224,48 @@ inline void MeanShift<UseKernel, KernelType, MatType>::Cluster(
   std::vector<std::vector<size_t> > neighbors;
   std::vector<std::vector<double> > distances;
 
-  // For each seed, perform mean shift algorithm.
-  for (size_t i = 0; i < pSeeds->n_cols; ++i)
+  // Initial centroids are the seeds themselves.
+  allCentroids = arma::conv_to<arma::mat>::from(*pSeeds);
+
+  // All seeds start out active; seeds drop out of the sweep as soon as they
+  // converge (or end up with no points in range).  Each sweep then issues a
+  // single batched range search for the remaining active seeds, so the work
+  // per iteration is one dual-tree traversal instead of one single-tree
+  // search per seed.
+  arma::uvec activeSeeds = arma::linspace<arma::uvec>(0, pSeeds->n_cols - 1,
+      pSeeds->n_cols);
+
+  for (size_t completedIterations = 0; (completedIterations < maxIterations
+      || forceConvergence) && activeSeeds.n_elem > 0; completedIterations++)
   {
-    // Initial centroid is the seed itself.
-    allCentroids.col(i) = pSeeds->unsafe_col(i);
-    for (size_t completedIterations = 0; completedIterations < maxIterations
-        || forceConvergence; completedIterations++)
+    // One batched range search around all active centroids.
+    const arma::mat activeCentroids = allCentroids.cols(activeSeeds);
+    rangeSearcher.Search(activeCentroids, validRadius, neighbors, distances);
+
+    arma::uvec stillActive(activeSeeds.n_elem);
+    size_t numStillActive = 0;
+    for (size_t j = 0; j < activeSeeds.n_elem; ++j)
     {
-      // Store new centroid in this.
-      arma::colvec newCentroid = arma::zeros<arma::colvec>(pSeeds->n_rows);
+      const size_t seed = activeSeeds[j];
 
-      rangeSearcher.Search(allCentroids.unsafe_col(i), validRadius,
-          neighbors, distances);
-      if (neighbors[0].size() == 0) // There are no points in the cluster.
-        break;
+      if (neighbors[j].size() == 0) // There are no points in the cluster.
+        continue;
 
       // Calculate new centroid.
-      if (!CalculateCentroid(data, neighbors[0], distances[0], newCentroid))
-        newCentroid = allCentroids.unsafe_col(i);
+      arma::colvec newCentroid = arma::zeros<arma::colvec>(pSeeds->n_rows);
+      if (!CalculateCentroid(data, neighbors[j], distances[j], newCentroid))
+        newCentroid = allCentroids.unsafe_col(seed);
 
       // If the mean shift vector is small enough, it has converged.
       if (metric::EuclideanDistance::Evaluate(newCentroid,
-          allCentroids.unsafe_col(i)) < 1e-3 * radius)
+          allCentroids.unsafe_col(seed)) < 1e-3 * radius)
       {
         // Determine if the new centroid is duplicate with old ones.
         bool isDuplicated = false;
         for (size_t k = 0; k < centroids.n_cols; ++k)
         {
           const double distance = metric::EuclideanDistance::Evaluate(
-              allCentroids.unsafe_col(i), centroids.unsafe_col(k));
+              allCentroids.unsafe_col(seed), centroids.unsafe_col(k));
           if (distance < radius)
           {
             isDuplicated = true;
@@ -250,15 +274,19 @@ inline void MeanShift<UseKernel, KernelType, MatType>::Cluster(
         }
 
         if (!isDuplicated)
-          centroids.insert_cols(centroids.n_cols, allCentroids.unsafe_col(i));
+          centroids.insert_cols(centroids.n_cols,
+              allCentroids.unsafe_col(seed));
 
-        // Get out of the loop.
-        break;
+        // The seed has converged; drop it from the sweep.
+        continue;
       }
 
-      // Update the centroid.
-      allCentroids.col(i) = newCentroid;
+      // Update the centroid and keep the seed in the next sweep.
+      allCentroids.col(seed) = newCentroid;
+      stillActive[numStillActive++] = seed;
     }
+
+    activeSeeds = stillActive.head(numStillActive);
   }
 
   // If no centroid has converged due to too little iterations and without
@@ -108,6 +108,11 @@ class NaiveBayesClassifier
    * classes, either re-initialize or call Means(), Variances(), and
    * Probabilities() individually to set them to the right size.
    *
+   * For large datasets the incremental statistics are computed over blocks of
+   * columns (in parallel, if OpenMP is enabled) and merged with Chan et al.'s
+   * pairwise mean/variance update, which gives the same result as the
+   * one-point-at-a-time update up to floating point rounding.
+   *
    * @param data The dataset to train on.
    * @param labels The labels for the dataset.
    * @param numClasses The numbe of classes in the dataset.
@@ -113,14 +113,75 @@ void NaiveBayesClassifier<ModelMatType>::Train(
     // Fist, de-normalize probabilities.
     probabilities *= trainingPoints;
 
-    for (size_t j = 0; j < data.n_cols; ++j)
+    // For large batches the points are split into column blocks: each block's
+    // class counts, means, and second moments are computed independently (in
+    // parallel, if OpenMP is enabled), and the per-block statistics are then
+    // merged with Chan et al.'s pairwise update formulas.  For a single block
+    // this reduces to the plain sequential update.
+    const size_t blockSize = 1024;
+    const size_t blocks = (data.n_cols + blockSize - 1) / blockSize;
+
+    if (blocks <= 1)
     {
-      const size_t label = labels[j];
-      ++probabilities[label];
-
-      arma::vec delta = data.col(j) - means.col(label);
-      means.col(label) += delta / probabilities[label];
-      variances.col(label) += delta % (data.col(j) - means.col(label));
+      for (size_t j = 0; j < data.n_cols; ++j)
+      {
+        const size_t label = labels[j];
+        ++probabilities[label];
+
+        arma::Col<ElemType> delta = data.col(j) - means.col(label);
+        means.col(label) += delta / probabilities[label];
+        variances.col(label) += delta % (data.col(j) - means.col(label));
+      }
+    }
+    else
+    {
+      std::vector<arma::Col<ElemType>> blockCounts(blocks);
+      std::vector<arma::Mat<ElemType>> blockMeans(blocks);
+      std::vector<arma::Mat<ElemType>> blockM2(blocks);
+
+      #pragma omp parallel for schedule(dynamic)
+      for (omp_size_t b = 0; b < (omp_size_t) blocks; ++b)
+      {
+        const size_t begin = b * blockSize;
+        const size_t end = std::min(begin + blockSize, (size_t) data.n_cols);
+
+        blockCounts[b].zeros(numClasses);
+        blockMeans[b].zeros(data.n_rows, numClasses);
+        blockM2[b].zeros(data.n_rows, numClasses);
+
+        for (size_t j = begin; j < end; ++j)
+        {
+          const size_t label = labels[j];
+          ++blockCounts[b][label];
+
+          arma::Col<ElemType> delta = data.col(j) - blockMeans[b].col(label);
+          blockMeans[b].col(label) += delta / blockCounts[b][label];
+          blockM2[b].col(label) +=
+              delta % (data.col(j) - blockMeans[b].col(label));
+        }
+      }
+
+      // Merge the per-block statistics into the model, one block at a time.
+      // Like the sequential update above, this treats the current variances
+      // as the running (unnormalized) second moment.
+      for (size_t b = 0; b < blocks; ++b)
+      {
+        for (size_t c = 0; c < numClasses; ++c)
+        {
+          const ElemType countB = blockCounts[b][c];
+          if (countB == 0)
+            continue;
+
+          const ElemType countA = probabilities[c];
+          const ElemType total = countA + countB;
+
+          arma::Col<ElemType> delta = blockMeans[b].col(c) - means.col(c);
+          means.col(c) += delta * (countB / total);
+          variances.col(c) += blockM2[b].col(c) +
+              delta % delta * (countA * countB / total);
+          probabilities[c] = total;
+        }
+      }
     }
 
     for (size_t i = 0; i < probabilities.n_elem; ++i)
@@ -213,18 +274,22 @@ void NaiveBayesClassifier<ModelMatType>::LogLikelihood(
   logLikelihoods = arma::log(arma::repmat(probabilities, 1, data.n_cols));
   ModelMatType invVar = 1.0 / variances;
 
-  // Calculate the joint log likelihood of point for each of the
-  // means.n_cols.
-
-  // Loop over every class.
-  for (size_t i = 0; i < means.n_cols; ++i)
+  // Calculate the joint log likelihood of all points for each of the
+  // means.n_cols classes, one batched matrix expression per class.
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) means.n_cols; ++i)
   {
     // This is an adaptation of gmm::phi() for the case where the covariance is
-    // a diagonal matrix.
-    ModelMatType diffs = data - arma::repmat(means.col(i), 1, data.n_cols);
-    ModelMatType rhs = -0.5 * arma::diagmat(invVar.col(i)) * diffs;
-    arma::Mat<ElemType> exponents = arma::sum(diffs % rhs, 0);
+    // a diagonal matrix.  The per-class mean and inverse variance are
+    // broadcast over the block with .each_col(), so neither the repeated mean
+    // matrix nor the diagonal covariance product is materialized.
+    ModelMatType diffs(data);
+    diffs.each_col() -= means.col(i);
+
+    ModelMatType weighted = diffs;
+    weighted.each_col() %= invVar.col(i);
 
+    arma::Mat<ElemType> exponents = -0.5 * arma::sum(diffs % weighted, 0);
     logLikelihoods.row(i) += (data.n_rows / -2.0 * log(2 * M_PI) - 0.5 *
         arma::accu(arma::log(variances.col(i))) + exponents);
   }
@@ -324,19 +389,15 @@ void NaiveBayesClassifier<ModelMatType>::Classify(
   ModelMatType logLikelihoods;
   LogLikelihood(data, logLikelihoods);
 
-  predictionProbs.set_size(arma::size(logLikelihoods));
-  double maxValue, logProbX;
-  for (size_t j = 0; j < data.n_cols; ++j)
-  {
-    // The LogLikelihood() gives us the unnormalized log likelihood which is
-    // Log(Prob(X|Y)) + Log(Prob(Y)), so we subtract the normalization term.
-    // Besides, to prevent underflow in log of sum of exp of x operation (where
-    // x is a small negative value), we use logsumexp(x - max(x)) + max(x).
-    maxValue = arma::max(logLikelihoods.col(j));
-    logProbX = log(arma::accu(exp(logLikelihoods.col(j) -
-        maxValue))) + maxValue;
-    predictionProbs.col(j) = arma::exp(logLikelihoods.col(j) - logProbX);
-  }
+  // The LogLikelihood() gives us the unnormalized log likelihood which is
+  // Log(Prob(X|Y)) + Log(Prob(Y)), so we subtract the normalization term for
+  // all points at once.  Besides, to prevent underflow in log of sum of exp
+  // of x operation (where x is a small negative value), we use
+  // logsumexp(x - max(x)) + max(x).
+  predictionProbs = logLikelihoods;
+  predictionProbs.each_row() -= arma::max(logLikelihoods, 0);
+  predictionProbs = arma::exp(predictionProbs);
+  predictionProbs.each_row() /= arma::sum(predictionProbs, 0);
 
   // Now calculate maximum probabilities for each point.
   for (size_t i = 0; i < data.n_cols; ++i)
@@ -145,6 +145,9 @@ class SoftmaxErrorFunction
   arma::mat lastCoordinates;
   //! Stretched dataset.  Kept internal to avoid memory reallocations.
   arma::mat stretchedDataset;
+  //! Coordinates the stretched dataset was last computed with; used by
+  //! Stretch() to avoid recomputing the stretched dataset.
+  arma::mat lastStretchCoordinates;
   //! Holds calculated p_i, for the non-separable Evaluate() and Gradient().
   arma::vec p;
   //! Holds denominators for calculation of p_ij, for the non-separable
@@ -168,6 +171,17 @@ class SoftmaxErrorFunction
    * @param coordinates Coordinates matrix to use for precalculation.
    */
   void Precalculate(const arma::mat& coordinates);
+
+  /**
+   * Stretch the dataset by the given coordinates matrix, storing the result
+   * in stretchedDataset.  If the coordinates are the same as the last call,
+   * the cached stretched dataset is reused instead of recomputing the matrix
+   * product.  This is shared by the separable and non-separable
+   * implementations.
+   *
+   * @param coordinates Coordinates matrix to stretch the dataset with.
+   */
+  void Stretch(const arma::mat& coordinates);
 };
 
 } // namespace nca
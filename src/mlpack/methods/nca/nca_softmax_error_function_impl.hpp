@@ -16,6 +16,7 @@
 #include "nca_softmax_error_function.hpp"
 
 #include <mlpack/core.hpp>
+#include <mlpack/core/math/pairwise_distances.hpp>
 
 namespace mlpack {
 namespace nca {
@@ -46,6 +47,11 @@ void SoftmaxErrorFunction<MetricType>::Shuffle()
 
   dataset = std::move(newDataset);
   labels = std::move(newLabels);
+
+  // Invalidate the cached stretched dataset and precalculated quantities;
+  // they were computed for the old ordering of the points.
+  lastStretchCoordinates.clear();
+  precalculated = false;
 }
 
 //! The non-separable implementation, which uses Precalculate() to save time.
@@ -73,7 +79,7 @@ double SoftmaxErrorFunction<MetricType>::Evaluate(const arma::mat& coordinates,
   double result = 0;
 
   // It's quicker to do this now than one point at a time later.
-  stretchedDataset = coordinates * dataset;
+  Stretch(coordinates);
   for (size_t i = begin; i < begin + batchSize; ++i)
   {
     for (size_t k = 0; k < dataset.n_cols; ++k)
@@ -173,7 +179,7 @@ void SoftmaxErrorFunction<MetricType>::Gradient(const arma::mat& coordinates,
   gradient.zeros(coordinates.n_rows, coordinates.n_rows);
 
   // Compute the stretched dataset.
-  stretchedDataset = coordinates * dataset;
+  Stretch(coordinates);
   for (size_t i = begin; i < begin + batchSize; ++i)
   {
     numerator = 0;
@@ -255,33 +261,78 @@ void SoftmaxErrorFunction<MetricType>::Precalculate(
 
   // Coordinates are different; save the new ones, and stretch the dataset.
   lastCoordinates = coordinates;
-  stretchedDataset = coordinates * dataset;
+  Stretch(coordinates);
 
   // For each point i, we must evaluate the softmax function:
   //   p_ij = exp( -K(x_i, x_j) ) / ( sum_{k != i} ( exp( -K(x_i, x_k) )))
   //   p_i = sum_{j in class of i} p_ij
   // We will do this by keeping track of the denominators for each i as well as
-  // the numerators (the sum for all j in class of i).  This will be on the
-  // order of O((n * (n + 1)) / 2), which really isn't all that great.
+  // the numerators (the sum for all j in class of i).  This is still O(n^2)
+  // work, but for the default squared Euclidean metric the distances can be
+  // computed blockwise with matrix arithmetic instead of one pair at a time.
   p.zeros(stretchedDataset.n_cols);
   denominators.zeros(stretchedDataset.n_cols);
-  for (size_t i = 0; i < stretchedDataset.n_cols; ++i)
+  if (std::is_same<MetricType, metric::SquaredEuclideanDistance>::value)
   {
-    for (size_t j = (i + 1); j < stretchedDataset.n_cols; ++j)
+    // Process the dataset in column blocks to keep the memory overhead of the
+    // pairwise distance matrix bounded.
+    const size_t blockSize = 1024;
+
+    // Gather the points of each class once, so that the numerator of each
+    // point can be accumulated with a single submatrix sum.
+    const size_t numClasses = arma::max(labels) + 1;
+    std::vector<arma::uvec> sameClass(numClasses);
+    for (size_t c = 0; c < numClasses; ++c)
+      sameClass[c] = arma::find(labels == c);
+
+    for (size_t begin = 0; begin < stretchedDataset.n_cols;
+        begin += blockSize)
     {
-      // Evaluate exp(-d(x_i, x_j)).
-      double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
-                                         stretchedDataset.unsafe_col(j)));
-
-      // Add this to the denominators of both p_i and p_j: K(i, j) = K(j, i).
-      denominators[i] += eval;
-      denominators[j] += eval;
-
-      // If i and j are the same class, add to numerator of both.
-      if (labels[i] == labels[j])
+      const size_t blockCols = std::min(blockSize,
+          (size_t) stretchedDataset.n_cols - begin);
+
+      // Evaluate exp(-d(x_i, x_j)) for every point i and every point j in the
+      // block.
+      arma::mat eval;
+      math::PairwiseSquaredDistances(stretchedDataset,
+          stretchedDataset.cols(begin, begin + blockCols - 1), eval);
+      eval = arma::exp(-eval);
+
+      // A point does not contribute to its own denominator or numerator.
+      for (size_t j = 0; j < blockCols; ++j)
+        eval(begin + j, j) = 0.0;
+
+      // Each column of the block belongs to exactly one point, so the
+      // accumulation can safely be done in parallel.
+      #pragma omp parallel for schedule(static)
+      for (omp_size_t j = 0; j < (omp_size_t) blockCols; ++j)
+      {
+        denominators[begin + j] = accu(eval.col(j));
+        p[begin + j] = accu(eval.unsafe_col(j).elem(
+            sameClass[labels[begin + j]]));
+      }
+    }
+  }
+  else
+  {
+    for (size_t i = 0; i < stretchedDataset.n_cols; ++i)
+    {
+      for (size_t j = (i + 1); j < stretchedDataset.n_cols; ++j)
       {
-        p[i] += eval;
-        p[j] += eval;
+        // Evaluate exp(-d(x_i, x_j)).
+        double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
+                                           stretchedDataset.unsafe_col(j)));
+
+        // Add this to the denominators of both p_i and p_j: K(i, j) = K(j, i).
+        denominators[i] += eval;
+        denominators[j] += eval;
+
+        // If i and j are the same class, add to numerator of both.
+        if (labels[i] == labels[j])
+        {
+          p[i] += eval;
+          p[j] += eval;
+        }
       }
     }
   }
@@ -306,6 +357,22 @@ void SoftmaxErrorFunction<MetricType>::Precalculate(
   precalculated = true;
 }
 
+template<typename MetricType>
+void SoftmaxErrorFunction<MetricType>::Stretch(const arma::mat& coordinates)
+{
+  // If the coordinates have not changed since the last call, the cached
+  // stretched dataset is still valid and the matrix product can be skipped.
+  if (lastStretchCoordinates.n_rows == coordinates.n_rows &&
+      lastStretchCoordinates.n_cols == coordinates.n_cols &&
+      accu(coordinates == lastStretchCoordinates) == coordinates.n_elem)
+  {
+    return;
+  }
+
+  lastStretchCoordinates = coordinates;
+  stretchedDataset = coordinates * dataset;
+}
+
 } // namespace nca
 } // namespace mlpack
 
@@ -21,6 +21,7 @@
 #include <iostream>
 
 #include "neighbor_search.hpp"
+#include "sharded_neighbor_search.hpp"
 #include "unmap.hpp"
 #include "ns_model.hpp"
 
@@ -103,7 +104,7 @@ PARAM_INT_IN("k", "Number of nearest neighbors to find.", "k", 0);
 // building.
 PARAM_STRING_IN("tree_type", "Type of tree to use: 'kd', 'vp', 'rp', 'max-rp', "
     "'ub', 'cover', 'r', 'r-star', 'x', 'ball', 'hilbert-r', 'r-plus', "
-    "'r-plus-plus', 'spill', 'oct'.", "t", "kd");
+    "'r-plus-plus', 'spill', 'oct', 'nsw', 'pq'.", "t", "kd");
 PARAM_INT_IN("leaf_size", "Leaf size for tree building (used for kd-trees, vp "
     "trees, random projection trees, UB trees, R trees, R* trees, X trees, "
     "Hilbert R trees, R+ trees, R++ trees, spill trees, and octrees).", "l",
@@ -112,6 +113,12 @@ PARAM_DOUBLE_IN("tau", "Overlapping size (only valid for spill trees).", "u",
     0);
 PARAM_DOUBLE_IN("rho", "Balance threshold (only valid for spill trees).", "b",
     0.7);
+PARAM_INT_IN("ef", "Beam width for searching navigable small-world graphs "
+    "(only valid for the 'nsw' tree type); larger values trade time for "
+    "recall.", "E", 64);
+PARAM_INT_IN("num_probes", "Number of inverted lists probed per query in a "
+    "product-quantization index (only valid for the 'pq' tree type); larger "
+    "values trade time for recall.", "p", 8);
 
 PARAM_FLAG("random_basis", "Before tree-building, project the data onto a "
     "random orthogonal basis.", "R");
@@ -119,9 +126,16 @@ PARAM_INT_IN("seed", "Random seed (if 0, std::time(NULL) is used).", "s", 0);
 
 // Search settings.
 PARAM_STRING_IN("algorithm", "Type of neighbor search: 'naive', 'single_tree', "
-    "'dual_tree', 'greedy'.", "a", "dual_tree");
+    "'dual_tree', 'greedy', 'hybrid'.  The 'hybrid' algorithm seeds the "
+    "candidate neighbors with a greedy search and then refines them with an "
+    "exact dual-tree search.", "a", "dual_tree");
 PARAM_DOUBLE_IN("epsilon", "If specified, will do approximate nearest neighbor "
     "search with given relative error.", "e", 0);
+PARAM_INT_IN("shards", "If greater than 1, partition the reference set into "
+    "this many shards with one kd-tree each, search every query block against "
+    "the shards whose bounding boxes can contain a result, and merge the "
+    "per-shard results; intended for very large reference sets.  Sharded "
+    "search cannot load or save models.", "S", 1);
 
 static void mlpackMain()
 {
@@ -184,6 +198,21 @@ static void mlpackMain()
     ReportIgnoredParam("rho", "spill trees are not being used");
   }
 
+  // Sanity check on ef.
+  RequireParamValue<int>("ef", [](int x) { return x > 0; }, true,
+      "ef must be positive");
+  const int efInt = IO::GetParam<int>("ef");
+  if (IO::GetParam<string>("tree_type") != "nsw")
+    ReportIgnoredParam("ef", "navigable small-world graphs are not being used");
+
+  // Sanity check on num_probes.
+  RequireParamValue<int>("num_probes", [](int x) { return x > 0; }, true,
+      "num_probes must be positive");
+  const int numProbesInt = IO::GetParam<int>("num_probes");
+  if (IO::GetParam<string>("tree_type") != "pq")
+    ReportIgnoredParam("num_probes", "a product-quantization index is not "
+        "being used");
+
   // Sanity check on epsilon.
   const double epsilon = IO::GetParam<double>("epsilon");
   RequireParamValue<double>("epsilon", [](double x) { return x >= 0.0; }, true,
@@ -194,7 +223,7 @@ static void mlpackMain()
 
   const string algorithm = IO::GetParam<string>("algorithm");
   RequireParamInSet<string>("algorithm", { "naive", "single_tree", "dual_tree",
-      "greedy" }, true, "unknown neighbor search algorithm");
+      "greedy", "hybrid" }, true, "unknown neighbor search algorithm");
   NeighborSearchMode searchMode = DUAL_TREE_MODE;
 
   if (algorithm == "naive")
@@ -205,6 +234,74 @@ static void mlpackMain()
     searchMode = DUAL_TREE_MODE;
   else if (algorithm == "greedy")
     searchMode = GREEDY_SINGLE_TREE_MODE;
+  else if (algorithm == "hybrid")
+    searchMode = HYBRID_DUAL_TREE_MODE;
+
+  // Sanity check on the number of shards.
+  RequireParamValue<int>("shards", [](int x) { return x > 0; }, true,
+      "number of shards must be positive");
+
+  if (IO::GetParam<int>("shards") > 1)
+  {
+    // Sharded search builds its own per-shard kd-trees and bypasses the
+    // model machinery entirely.
+    if (IO::HasParam("input_model") || IO::HasParam("output_model"))
+    {
+      Log::Fatal << "Sharded search (" << PRINT_PARAM_STRING("shards")
+          << " > 1) cannot be used with " << PRINT_PARAM_STRING("input_model")
+          << " or " << PRINT_PARAM_STRING("output_model") << "!" << endl;
+    }
+
+    RequireAtLeastOnePassed({ "k" }, true, "sharded search requires k");
+
+    ReportIgnoredParam("tree_type", "sharded search always uses kd-trees");
+    ReportIgnoredParam("random_basis", "sharded search does not project onto "
+        "a random basis");
+    ReportIgnoredParam("true_distances", "sharded search does not compute the "
+        "effective error");
+    ReportIgnoredParam("true_neighbors", "sharded search does not compute the "
+        "recall");
+
+    const size_t k = (size_t) IO::GetParam<int>("k");
+    const size_t shards = (size_t) IO::GetParam<int>("shards");
+
+    arma::mat referenceSet = std::move(IO::GetParam<arma::mat>("reference"));
+
+    if (k > referenceSet.n_cols ||
+        (!IO::HasParam("query") && k == referenceSet.n_cols))
+    {
+      Log::Fatal << "Invalid k: " << k << "; must be greater than 0 and less "
+          << "than or equal to the number of reference points ("
+          << referenceSet.n_cols << "), and strictly less if no query data is "
+          << "provided." << endl;
+    }
+
+    ShardedKNN sharded(std::move(referenceSet), shards, searchMode, epsilon);
+
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    if (IO::HasParam("query"))
+    {
+      arma::mat queryData = std::move(IO::GetParam<arma::mat>("query"));
+      if (queryData.n_rows != sharded.ReferenceSet().n_rows)
+      {
+        Log::Fatal << "Query has invalid dimensions(" << queryData.n_rows
+            << "); should be " << sharded.ReferenceSet().n_rows << "!" << endl;
+      }
+
+      sharded.Search(queryData, k, neighbors, distances);
+    }
+    else
+    {
+      sharded.Search(k, neighbors, distances);
+    }
+    Log::Info << "Search complete." << endl;
+
+    IO::GetParam<arma::Mat<size_t>>("neighbors") = std::move(neighbors);
+    IO::GetParam<arma::mat>("distances") = std::move(distances);
+
+    return;
+  }
 
   if (IO::HasParam("reference"))
   {
@@ -215,7 +312,7 @@ static void mlpackMain()
     KNNModel::TreeTypes tree = KNNModel::KD_TREE;
     RequireParamInSet<string>("tree_type", { "kd", "cover", "r", "r-star",
         "ball", "x", "hilbert-r", "r-plus", "r-plus-plus", "spill", "vp", "rp",
-        "max-rp", "ub", "oct" }, true, "unknown tree type");
+        "max-rp", "ub", "oct", "nsw", "pq" }, true, "unknown tree type");
 
     knn = new KNNModel();
 
@@ -249,12 +346,18 @@ static void mlpackMain()
       tree = KNNModel::UB_TREE;
     else if (treeType == "oct")
       tree = KNNModel::OCTREE;
+    else if (treeType == "nsw")
+      tree = KNNModel::NSW_GRAPH;
+    else if (treeType == "pq")
+      tree = KNNModel::PQ_INDEX;
 
     knn->TreeType() = tree;
     knn->RandomBasis() = randomBasis;
     knn->LeafSize() = size_t(lsInt);
     knn->Tau() = tau;
     knn->Rho() = rho;
+    knn->EfSearch() = size_t(efInt);
+    knn->NumProbes() = size_t(numProbesInt);
 
     Log::Info << "Using reference data from "
         << IO::GetPrintableParam<arma::mat>("reference") << "." << endl;
@@ -272,6 +375,10 @@ static void mlpackMain()
     // Adjust search mode.
     knn->SearchMode() = searchMode;
     knn->Epsilon() = epsilon;
+    if (IO::HasParam("ef"))
+      knn->EfSearch() = size_t(efInt);
+    if (IO::HasParam("num_probes"))
+      knn->NumProbes() = size_t(numProbesInt);
 
     // If leaf_size wasn't provided, let's consider the current value in the
     // loaded model.  Else, update it (only considered when building the query
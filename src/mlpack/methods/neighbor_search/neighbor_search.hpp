@@ -31,16 +31,21 @@ namespace mlpack {
 namespace neighbor  {
 
 // Forward declaration.
-template<typename SortPolicy>
+template<typename SortPolicy, typename MatType>
 class TrainVisitor;
 
-//! NeighborSearchMode represents the different neighbor search modes available.
+//! NeighborSearchMode represents the different neighbor search modes
+//! available.  HYBRID_DUAL_TREE_MODE runs a greedy descent for each query
+//! point first and then refines the results with an exact dual-tree
+//! traversal; the candidates found by the greedy pass serve as warm pruning
+//! bounds for the exact pass, so the results are still exact.
 enum NeighborSearchMode
 {
   NAIVE_MODE,
   SINGLE_TREE_MODE,
   DUAL_TREE_MODE,
-  GREEDY_SINGLE_TREE_MODE
+  GREEDY_SINGLE_TREE_MODE,
+  HYBRID_DUAL_TREE_MODE
 };
 
 /**
@@ -206,6 +211,30 @@ class NeighborSearch
    */
   void Train(Tree referenceTree);
 
+  /**
+   * Add new reference points without rebuilding the tree.  The points are
+   * held in a small unindexed side buffer which is searched by brute force
+   * and folded into the results of every Search() call; when the buffer
+   * grows beyond a tenth of the indexed set, it is merged into the tree with
+   * a rebuild (see MergeAddedPoints()).  Added points are assigned indices
+   * following the points given at Train() time, in insertion order, and the
+   * merge does not change them.
+   *
+   * Until the buffer is merged, added points act as reference points only:
+   * the monochromatic Search() overload does not use them as query points.
+   *
+   * @param points New reference points to add.
+   */
+  void AddPoints(MatType points);
+
+  /**
+   * Merge any points added with AddPoints() into the reference tree,
+   * rebuilding it.  This is called automatically once the side buffer grows
+   * beyond a tenth of the indexed set, but it may also be called directly to
+   * force the merge.
+   */
+  void MergeAddedPoints();
+
   /**
    * For each point in the query set, compute the nearest neighbors and store
    * the output in the given matrices.  The matrices will be set to the size of
@@ -311,6 +340,17 @@ class NeighborSearch
   //! Return the number of node combination scores during the last search.
   size_t Scores() const { return scores; }
 
+  //! Return whether detailed traversal statistics are collected.
+  bool CollectStatistics() const { return collectStatistics; }
+  //! Modify whether detailed traversal statistics are collected.  When this
+  //! is set to true, every Search() call fills the object returned by
+  //! Stats(); collection adds a small overhead to the traversal.
+  bool& CollectStatistics() { return collectStatistics; }
+
+  //! Return the detailed statistics of the last search (only filled if
+  //! CollectStatistics() is set to true).
+  const tree::TraversalStatistics& Stats() const { return stats; }
+
   //! Access the search mode.
   NeighborSearchMode SearchMode() const { return searchMode; }
   //! Modify the search mode.
@@ -321,6 +361,52 @@ class NeighborSearch
   //! Modify the relative error to be considered in approximate search.
   double& Epsilon() { return epsilon; }
 
+  //! Access the backtracking budget for defeatist traversals: the number of
+  //! skipped branches that may be revisited for each query point.  This is
+  //! only meaningful for single-tree defeatist search on spill trees; 0 (the
+  //! default) gives pure defeatist search.
+  size_t BacktrackLimit() const { return backtrackLimit; }
+  //! Modify the backtracking budget for defeatist traversals.
+  size_t& BacktrackLimit() { return backtrackLimit; }
+
+  //! Access the score budget for anytime search: the number of node
+  //! combinations a traversal may score before every remaining combination
+  //! is pruned and the best results found so far are returned.  0 (the
+  //! default) means no budget, i.e., the search runs to completion.  The
+  //! budget has no effect in naive mode.  A latency target can be mapped to
+  //! a budget by timing a completed search and scaling by its Scores()
+  //! count.  When the budget is hit, AnytimeBounds() reports a per-query
+  //! bound on what the truncated search may have missed.
+  size_t ScoreBudget() const { return scoreBudget; }
+  //! Modify the score budget for anytime search.
+  size_t& ScoreBudget() { return scoreBudget; }
+
+  //! Return the per-query anytime bounds of the last search (only filled
+  //! when ScoreBudget() is nonzero).  Element i is the best distance any
+  //! unexplored (budget-pruned) reference subtree could possibly contain for
+  //! query point i: the true k-th neighbor distance of query i is no better
+  //! than the better of this value and the returned k-th distance.  In
+  //! particular, if the returned k-th distance is better than this bound,
+  //! the result for that query point is exact (up to epsilon).  Queries
+  //! whose search completed within the budget hold
+  //! SortPolicy::WorstDistance().
+  const arma::vec& AnytimeBounds() const { return anytimeBounds; }
+
+  //! Return whether single-tree searches fuse the whole query set into one
+  //! descent of the reference tree.
+  bool FusedSingleTree() const { return fusedSingleTree; }
+  //! Modify whether single-tree searches fuse the whole query set into one
+  //! descent of the reference tree.  This pays off for small query blocks
+  //! (roughly 8--64 points), which then share most of their descent; the
+  //! results are unchanged.  It has no effect in other search modes, and it
+  //! bypasses any tree-specific single-tree traverser (e.g. the defeatist
+  //! traverser of spill trees), so leave it off for those trees.
+  bool& FusedSingleTree() { return fusedSingleTree; }
+
+  //! Return the number of points added with AddPoints() that have not yet
+  //! been merged into the reference tree.
+  size_t NumUnindexedPoints() const { return unindexedSet.n_cols; }
+
   //! Access the reference dataset.
   const MatType& ReferenceSet() const { return *referenceSet; }
 
@@ -345,6 +431,18 @@ class NeighborSearch
   NeighborSearchMode searchMode;
   //! Indicates the relative error to be considered in approximate search.
   double epsilon;
+  //! The number of skipped branches that defeatist traversals may revisit for
+  //! each query point.
+  size_t backtrackLimit;
+  //! The number of node combinations a traversal may score before returning
+  //! best-so-far results; 0 means no limit.
+  size_t scoreBudget;
+  //! Per-query bounds on what the last budget-truncated search may have
+  //! missed; only filled when scoreBudget is nonzero.
+  arma::vec anytimeBounds;
+  //! If true, single-tree searches traverse the reference tree once for the
+  //! whole query block instead of once per query point.
+  bool fusedSingleTree;
 
   //! Instantiation of metric.
   MetricType metric;
@@ -354,12 +452,47 @@ class NeighborSearch
   //! The total number of scores (applicable for non-naive search).
   size_t scores;
 
+  //! If true, detailed traversal statistics are collected during searches.
+  bool collectStatistics;
+  //! Detailed statistics of the last search.
+  tree::TraversalStatistics stats;
+
   //! If this is true, the reference tree bounds need to be reset on a call to
-  //! Search() without a query set.
+  //! Search() without a query set.  This is unused now that node statistics
+  //! are invalidated lazily per search epoch, but it is kept so that the
+  //! serialized model layout does not change.
   bool treeNeedsReset;
+  //! The current search epoch: node statistics stamped with an older epoch
+  //! hold stale bounds and are reset lazily when a traversal first touches
+  //! them, instead of resetting the whole tree between searches.
+  size_t searchEpoch;
+
+  //! Points added with AddPoints() that are not yet in the reference tree;
+  //! these are searched by brute force until MergeAddedPoints() folds them
+  //! into the tree.
+  MatType unindexedSet;
+
+  /**
+   * Fold the unindexed side buffer into already-computed search results: for
+   * each query point, evaluate the distance to every unindexed point and
+   * insert it into the sorted result column if it improves the k best.  If
+   * queryMap is non-NULL, the results for query column i are stored in column
+   * (*queryMap)[i] of the output matrices.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors searched for.
+   * @param neighbors Completed neighbor matrix to merge into.
+   * @param distances Completed distance matrix to merge into.
+   * @param queryMap Optional mapping from query columns to result columns.
+   */
+  void SearchUnindexed(const MatType& querySet,
+                       const size_t k,
+                       arma::Mat<size_t>& neighbors,
+                       arma::mat& distances,
+                       const std::vector<size_t>* queryMap = NULL);
 
   //! The NSModel class should have access to internal members.
-  template<typename SortPol>
+  template<typename SortPol, typename TrainMatType>
   friend class TrainVisitor;
 }; // class NeighborSearch
 
@@ -14,6 +14,9 @@
 #define MLPACK_METHODS_NEIGHBOR_SEARCH_NEIGHBOR_SEARCH_IMPL_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/pairwise_distances.hpp>
+#include <mlpack/core/util/telemetry.hpp>
+#include <mlpack/core/tree/fused_single_tree_traverser.hpp>
 #include <mlpack/core/tree/greedy_single_tree_traverser.hpp>
 #include "neighbor_search_rules.hpp"
 #include <mlpack/core/tree/spill_tree/is_spill_tree.hpp>
@@ -45,6 +48,26 @@ TreeType* BuildTree(
   return new TreeType(std::forward<MatType>(dataset));
 }
 
+//! Set the backtracking budget on a traverser that supports it (currently
+//! only the defeatist spill tree traverser).
+template<typename TraverserType>
+auto SetBacktrackLimit(TraverserType& traverser,
+                       const size_t backtrackLimit,
+                       int)
+    -> decltype(traverser.BacktrackLimit(), void())
+{
+  traverser.BacktrackLimit() = backtrackLimit;
+}
+
+//! No-op overload for traversers without a backtracking budget.
+template<typename TraverserType>
+void SetBacktrackLimit(TraverserType& /* traverser */,
+                       const size_t /* backtrackLimit */,
+                       long)
+{
+  // Nothing to do.
+}
+
 // Construct the object.
 template<typename SortPolicy,
          typename MetricType,
@@ -65,10 +88,15 @@ SingleTreeTraversalType>::NeighborSearch(MatType referenceSetIn,
         &referenceTree->Dataset()),
     searchMode(mode),
     epsilon(epsilon),
+    backtrackLimit(0),
+    scoreBudget(0),
+    fusedSingleTree(false),
     metric(metric),
     baseCases(0),
     scores(0),
-    treeNeedsReset(false)
+    collectStatistics(false),
+    treeNeedsReset(false),
+    searchEpoch(0)
 {
   if (epsilon < 0)
     throw std::invalid_argument("epsilon must be non-negative");
@@ -92,10 +120,15 @@ SingleTreeTraversalType>::NeighborSearch(Tree referenceTree,
     referenceSet(&this->referenceTree->Dataset()),
     searchMode(mode),
     epsilon(epsilon),
+    backtrackLimit(0),
+    scoreBudget(0),
+    fusedSingleTree(false),
     metric(metric),
     baseCases(0),
     scores(0),
-    treeNeedsReset(false)
+    collectStatistics(false),
+    treeNeedsReset(false),
+    searchEpoch(0)
 {
   if (epsilon < 0)
     throw std::invalid_argument("epsilon must be non-negative");
@@ -118,10 +151,15 @@ SingleTreeTraversalType>::NeighborSearch(const NeighborSearchMode mode,
     referenceSet(mode == NAIVE_MODE ? new MatType() : NULL), // Empty matrix.
     searchMode(mode),
     epsilon(epsilon),
+    backtrackLimit(0),
+    scoreBudget(0),
+    fusedSingleTree(false),
     metric(metric),
     baseCases(0),
     scores(0),
-    treeNeedsReset(false)
+    collectStatistics(false),
+    treeNeedsReset(false),
+    searchEpoch(0)
 {
   if (epsilon < 0)
     throw std::invalid_argument("epsilon must be non-negative");
@@ -152,10 +190,17 @@ SingleTreeTraversalType>::NeighborSearch(const NeighborSearch& other) :
         new MatType(*other.referenceSet)),
     searchMode(other.searchMode),
     epsilon(other.epsilon),
+    backtrackLimit(other.backtrackLimit),
+    scoreBudget(other.scoreBudget),
+    fusedSingleTree(other.fusedSingleTree),
     metric(other.metric),
     baseCases(other.baseCases),
     scores(other.scores),
-    treeNeedsReset(false)
+    collectStatistics(other.collectStatistics),
+    stats(other.stats),
+    treeNeedsReset(false),
+    searchEpoch(other.searchEpoch),
+    unindexedSet(other.unindexedSet)
 {
   // Nothing else to do.
 }
@@ -176,10 +221,17 @@ SingleTreeTraversalType>::NeighborSearch(NeighborSearch&& other) :
     referenceSet(other.referenceSet),
     searchMode(other.searchMode),
     epsilon(other.epsilon),
+    backtrackLimit(other.backtrackLimit),
+    scoreBudget(other.scoreBudget),
+    fusedSingleTree(other.fusedSingleTree),
     metric(std::move(other.metric)),
     baseCases(other.baseCases),
     scores(other.scores),
-    treeNeedsReset(other.treeNeedsReset)
+    collectStatistics(other.collectStatistics),
+    stats(std::move(other.stats)),
+    treeNeedsReset(other.treeNeedsReset),
+    searchEpoch(other.searchEpoch),
+    unindexedSet(std::move(other.unindexedSet))
 {
   // Clear the other model.
   other.referenceTree = BuildTree<Tree>(std::move(MatType()),
@@ -187,9 +239,13 @@ SingleTreeTraversalType>::NeighborSearch(NeighborSearch&& other) :
   other.referenceSet = &other.referenceTree->Dataset();
   other.searchMode = DUAL_TREE_MODE,
   other.epsilon = 0.0;
+  other.backtrackLimit = 0;
+  other.scoreBudget = 0;
+  other.fusedSingleTree = false;
   other.baseCases = 0;
   other.scores = 0;
   other.treeNeedsReset = false;
+  other.searchEpoch = 0;
 }
 
 // Copy operator.
@@ -229,10 +285,17 @@ NeighborSearch<SortPolicy,
       new MatType(*other.referenceSet);
   searchMode = other.searchMode;
   epsilon = other.epsilon;
+  backtrackLimit = other.backtrackLimit;
+  scoreBudget = other.scoreBudget;
+  fusedSingleTree = other.fusedSingleTree;
   metric = other.metric;
   baseCases = other.baseCases;
   scores = other.scores;
+  collectStatistics = other.collectStatistics;
+  stats = other.stats;
   treeNeedsReset = false;
+  searchEpoch = other.searchEpoch;
+  unindexedSet = other.unindexedSet;
 }
 
 // Move operator.
@@ -271,10 +334,17 @@ NeighborSearch<SortPolicy,
   referenceSet = other.referenceSet;
   searchMode = other.searchMode;
   epsilon = other.epsilon;
+  backtrackLimit = other.backtrackLimit;
+  scoreBudget = other.scoreBudget;
+  fusedSingleTree = other.fusedSingleTree;
   metric = other.metric;
   baseCases = other.baseCases;
   scores = other.scores;
+  collectStatistics = other.collectStatistics;
+  stats = std::move(other.stats);
   treeNeedsReset = other.treeNeedsReset;
+  searchEpoch = other.searchEpoch;
+  unindexedSet = std::move(other.unindexedSet);
 
   // Reset the other object.  Clean memory if needed.
   if (!other.referenceTree)
@@ -285,9 +355,13 @@ NeighborSearch<SortPolicy,
   other.referenceSet = &other.referenceTree->Dataset();
   other.searchMode = DUAL_TREE_MODE,
   other.epsilon = 0.0;
+  other.backtrackLimit = 0;
+  other.scoreBudget = 0;
+  other.fusedSingleTree = false;
   other.baseCases = 0;
   other.scores = 0;
   other.treeNeedsReset = false;
+  other.searchEpoch = 0;
 }
 
 // Clean memory.
@@ -319,6 +393,12 @@ template<typename SortPolicy,
 void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
 DualTreeTraversalType, SingleTreeTraversalType>::Train(MatType referenceSetIn)
 {
+  Telemetry::Operation telemetryOp("NeighborSearch::Train");
+  telemetryOp.Rows(referenceSetIn.n_rows).Cols(referenceSetIn.n_cols);
+
+  // Any unindexed points belong to the old reference set.
+  unindexedSet.reset();
+
   // Clean up the old tree, if we built one.
   if (referenceTree)
   {
@@ -359,6 +439,9 @@ DualTreeTraversalType, SingleTreeTraversalType>::Train(Tree referenceTree)
     throw std::invalid_argument("cannot train on given reference tree when "
         "naive search (without trees) is desired");
 
+  // Any unindexed points belong to the old reference set.
+  unindexedSet.reset();
+
   if (this->referenceTree)
   {
     oldFromNewReferences.clear();
@@ -373,6 +456,122 @@ DualTreeTraversalType, SingleTreeTraversalType>::Train(Tree referenceTree)
   this->referenceSet = &this->referenceTree->Dataset();
 }
 
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::AddPoints(MatType points)
+{
+  if (points.n_cols == 0)
+    return;
+
+  // If there is no reference data yet, this is just training.
+  if (referenceSet->n_cols == 0 && unindexedSet.n_cols == 0)
+    return Train(std::move(points));
+
+  if (points.n_rows != referenceSet->n_rows)
+    throw std::invalid_argument("added points must have the same "
+        "dimensionality as the reference set");
+
+  unindexedSet.insert_cols(unindexedSet.n_cols, points);
+
+  // Once the buffer outgrows a tenth of the indexed set, fold it into the
+  // tree; one rebuild amortizes over many cheap appends.
+  if (unindexedSet.n_cols * 10 >= referenceSet->n_cols)
+    MergeAddedPoints();
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::MergeAddedPoints()
+{
+  if (unindexedSet.n_cols == 0)
+    return; // Nothing buffered.
+
+  // Reassemble the reference set in original point order, then append the
+  // buffered points in insertion order, so that the indices reported by
+  // Search() are unchanged by the merge.
+  MatType all(referenceSet->n_rows,
+      referenceSet->n_cols + unindexedSet.n_cols);
+  if (!oldFromNewReferences.empty())
+  {
+    for (size_t i = 0; i < referenceSet->n_cols; ++i)
+      all.col(oldFromNewReferences[i]) = referenceSet->col(i);
+  }
+  else if (referenceSet->n_cols > 0)
+  {
+    all.cols(0, referenceSet->n_cols - 1) = *referenceSet;
+  }
+  all.cols(referenceSet->n_cols, all.n_cols - 1) = unindexedSet;
+
+  Train(std::move(all)); // This also clears the side buffer.
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::SearchUnindexed(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances,
+    const std::vector<size_t>* queryMap)
+{
+  // Indices of unindexed points continue where the indexed set ends.
+  const size_t indexedSize = referenceSet->n_cols;
+
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    const size_t queryIndex = queryMap ? (*queryMap)[i] : i;
+
+    for (size_t j = 0; j < unindexedSet.n_cols; ++j)
+    {
+      const double distance = metric.Evaluate(querySet.col(i),
+          unindexedSet.col(j));
+
+      // Does this improve on the current k'th best candidate?
+      if (!SortPolicy::IsBetter(distance, distances(k - 1, queryIndex)))
+        continue;
+
+      // Find the position to insert at, then shift worse candidates down.
+      size_t pos = k - 1;
+      while (pos > 0 &&
+          SortPolicy::IsBetter(distance, distances(pos - 1, queryIndex)))
+        --pos;
+
+      for (size_t l = k - 1; l > pos; --l)
+      {
+        distances(l, queryIndex) = distances(l - 1, queryIndex);
+        neighbors(l, queryIndex) = neighbors(l - 1, queryIndex);
+      }
+
+      distances(pos, queryIndex) = distance;
+      neighbors(pos, queryIndex) = indexedSize + j;
+    }
+  }
+
+  baseCases += querySet.n_cols * unindexedSet.n_cols;
+}
+
 /**
  * Computes the best neighbors and stores them in resultingNeighbors and
  * distances.
@@ -401,9 +600,13 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   }
 
   Timer::Start("computing_neighbors");
+  Telemetry::Operation telemetryOp("NeighborSearch::Search");
+  telemetryOp.Rows(querySet.n_rows).Cols(querySet.n_cols);
 
   baseCases = 0;
   scores = 0;
+  if (collectStatistics)
+    stats.Reset(querySet.n_cols);
 
   // This will hold mappings for query points, if necessary.
   std::vector<size_t> oldFromNewQueries;
@@ -415,10 +618,14 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   arma::Mat<size_t>* neighborPtr = &neighbors;
   arma::mat* distancePtr = &distances;
 
+  // We build a query tree in both the dual-tree mode and the hybrid mode.
+  const bool buildQueryTree = (searchMode == DUAL_TREE_MODE) ||
+      (searchMode == HYBRID_DUAL_TREE_MODE);
+
   // Mapping is only necessary if the tree rearranges points.
   if (tree::TreeTraits<Tree>::RearrangesDataset)
   {
-    if (searchMode == DUAL_TREE_MODE)
+    if (buildQueryTree)
     {
       distancePtr = new arma::mat; // Query indices need to be mapped.
       neighborPtr = new arma::Mat<size_t>;
@@ -433,34 +640,104 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
   typedef NeighborSearchRules<SortPolicy, MetricType, Tree> RuleType;
 
+  // Every search is a new epoch: node statistics stamped with an older epoch
+  // are lazily reset when the traversal first touches them.
+  ++searchEpoch;
+
+  // Anytime bounds in the (possibly rearranged) query order of the rules
+  // object; they are mapped back to original query columns below.
+  arma::vec unmappedBounds;
+
   switch (searchMode)
   {
     case NAIVE_MODE:
     {
-      // Create the helper object for the tree traversal.
-      RuleType rules(*referenceSet, querySet, k, metric, epsilon);
+      // For the Euclidean distance, all pairwise distances can be computed in
+      // blocked matrix products; any other metric falls back to the
+      // point-at-a-time loop.
+      if (std::is_same<MetricType, metric::EuclideanDistance>::value)
+      {
+        typedef typename MatType::elem_type ElemType;
 
-      // The naive brute-force traversal.
-      for (size_t i = 0; i < querySet.n_cols; ++i)
-        for (size_t j = 0; j < referenceSet->n_cols; ++j)
-          rules.BaseCase(i, j);
+        // Best-first sorting direction for the sort policy.
+        const char* sortDirection =
+            SortPolicy::IsBetter(0.0, 1.0) ? "ascend" : "descend";
+
+        // Process query blocks so that only one block of the full distance
+        // matrix is ever held in memory.
+        const size_t blockSize = 1024;
+        for (size_t begin = 0; begin < querySet.n_cols; begin += blockSize)
+        {
+          const size_t end = std::min(begin + blockSize,
+              (size_t) querySet.n_cols);
+
+          arma::Mat<ElemType> sqDists;
+          math::PairwiseSquaredDistances(*referenceSet,
+              querySet.cols(begin, end - 1), sqDists);
+
+          #pragma omp parallel for
+          for (omp_size_t i = 0; i < (omp_size_t) (end - begin); ++i)
+          {
+            const arma::uvec order = arma::stable_sort_index(sqDists.col(i),
+                sortDirection);
+            for (size_t j = 0; j < k; ++j)
+            {
+              (*neighborPtr)(j, begin + i) = order[j];
+              (*distancePtr)(j, begin + i) =
+                  std::sqrt(sqDists(order[j], i));
+            }
+          }
+        }
+      }
+      else
+      {
+        // Create the helper object for the tree traversal.
+        RuleType rules(*referenceSet, querySet, k, metric, epsilon, false,
+            collectStatistics ? &stats : NULL);
+
+        // The naive brute-force traversal.
+        for (size_t i = 0; i < querySet.n_cols; ++i)
+          for (size_t j = 0; j < referenceSet->n_cols; ++j)
+            rules.BaseCase(i, j);
+
+        rules.GetResults(*neighborPtr, *distancePtr);
+      }
 
       baseCases += querySet.n_cols * referenceSet->n_cols;
 
-      rules.GetResults(*neighborPtr, *distancePtr);
+      // The search was exact, so no reference subtree was left unexplored.
+      if (scoreBudget > 0)
+      {
+        unmappedBounds.set_size(querySet.n_cols);
+        unmappedBounds.fill(SortPolicy::WorstDistance());
+      }
       break;
     }
     case SINGLE_TREE_MODE:
     {
       // Create the helper object for the tree traversal.
-      RuleType rules(*referenceSet, querySet, k, metric, epsilon);
+      RuleType rules(*referenceSet, querySet, k, metric, epsilon, false,
+          collectStatistics ? &stats : NULL, scoreBudget, searchEpoch);
 
-      // Create the traverser.
-      SingleTreeTraversalType<RuleType> traverser(rules);
+      if (fusedSingleTree)
+      {
+        // Traverse the reference tree once for the whole query block.
+        tree::FusedSingleTreeTraverser<Tree, RuleType> traverser(rules);
+        std::vector<size_t> queryIndices(querySet.n_cols);
+        for (size_t i = 0; i < querySet.n_cols; ++i)
+          queryIndices[i] = i;
+        traverser.Traverse(queryIndices, *referenceTree);
+      }
+      else
+      {
+        // Create the traverser.
+        SingleTreeTraversalType<RuleType> traverser(rules);
+        SetBacktrackLimit(traverser, backtrackLimit, 0);
 
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < querySet.n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+        // Now have it traverse for each point.
+        for (size_t i = 0; i < querySet.n_cols; ++i)
+          traverser.Traverse(i, *referenceTree);
+      }
 
       scores += rules.Scores();
       baseCases += rules.BaseCases();
@@ -471,6 +748,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
           << std::endl;
 
       rules.GetResults(*neighborPtr, *distancePtr);
+      if (scoreBudget > 0)
+        unmappedBounds = rules.AnytimeBounds();
       break;
     }
     case DUAL_TREE_MODE:
@@ -483,7 +762,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       Timer::Start("computing_neighbors");
 
       // Create the helper object for the tree traversal.
-      RuleType rules(*referenceSet, queryTree->Dataset(), k, metric, epsilon);
+      RuleType rules(*referenceSet, queryTree->Dataset(), k, metric, epsilon,
+          false, collectStatistics ? &stats : NULL, scoreBudget, searchEpoch);
 
       // Create the traverser.
       DualTreeTraversalType<RuleType> traverser(rules);
@@ -499,6 +779,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
           << std::endl;
 
       rules.GetResults(*neighborPtr, *distancePtr);
+      if (scoreBudget > 0)
+        unmappedBounds = rules.AnytimeBounds();
 
       delete queryTree;
       break;
@@ -506,7 +788,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     case GREEDY_SINGLE_TREE_MODE:
     {
       // Create the helper object for the tree traversal.
-      RuleType rules(*referenceSet, querySet, k, metric);
+      RuleType rules(*referenceSet, querySet, k, metric, 0.0, false,
+          collectStatistics ? &stats : NULL, scoreBudget, searchEpoch);
 
       // Create the traverser.
       tree::GreedySingleTreeTraverser<Tree, RuleType> traverser(rules);
@@ -524,6 +807,51 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
           << std::endl;
 
       rules.GetResults(*neighborPtr, *distancePtr);
+      if (scoreBudget > 0)
+        unmappedBounds = rules.AnytimeBounds();
+      break;
+    }
+    case HYBRID_DUAL_TREE_MODE:
+    {
+      // Build the query tree.
+      Timer::Stop("computing_neighbors");
+      Timer::Start("tree_building");
+      Tree* queryTree = BuildTree<Tree>(querySet, oldFromNewQueries);
+      Timer::Stop("tree_building");
+      Timer::Start("computing_neighbors");
+
+      // Create the helper object for the tree traversal.  Both phases share
+      // this rules object, so the candidates found by the greedy pass become
+      // warm pruning bounds for the exact pass.
+      RuleType rules(*referenceSet, queryTree->Dataset(), k, metric, epsilon,
+          false, collectStatistics ? &stats : NULL, scoreBudget, searchEpoch);
+
+      // First phase: a greedy descent for each query point, seeding the
+      // candidate heaps with good (approximate) neighbors.
+      tree::GreedySingleTreeTraverser<Tree, RuleType> greedyTraverser(rules);
+      for (size_t i = 0; i < queryTree->Dataset().n_cols; ++i)
+        greedyTraverser.Traverse(i, *referenceTree);
+
+      // Second phase: the exact dual-tree traversal.  Node combinations
+      // whose bounds cannot improve on the seeded candidates are pruned
+      // immediately, so none of the greedy phase's distance evaluations are
+      // wasted.
+      DualTreeTraversalType<RuleType> traverser(rules);
+      traverser.Traverse(*queryTree, *referenceTree);
+
+      scores += rules.Scores();
+      baseCases += rules.BaseCases();
+
+      Log::Info << rules.Scores() << " node combinations were scored."
+          << std::endl;
+      Log::Info << rules.BaseCases() << " base cases were calculated."
+          << std::endl;
+
+      rules.GetResults(*neighborPtr, *distancePtr);
+      if (scoreBudget > 0)
+        unmappedBounds = rules.AnytimeBounds();
+
+      delete queryTree;
       break;
     }
   }
@@ -533,7 +861,7 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   // Map points back to original indices, if necessary.
   if (tree::TreeTraits<Tree>::RearrangesDataset)
   {
-    if (searchMode == DUAL_TREE_MODE && !oldFromNewReferences.empty())
+    if (buildQueryTree && !oldFromNewReferences.empty())
     {
       // We must map both query and reference indices.
       neighbors.set_size(k, querySet.n_cols);
@@ -556,7 +884,7 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       delete neighborPtr;
       delete distancePtr;
     }
-    else if (searchMode == DUAL_TREE_MODE)
+    else if (buildQueryTree)
     {
       // We must map query indices only.
       neighbors.set_size(k, querySet.n_cols);
@@ -588,6 +916,24 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       delete neighborPtr;
     }
   }
+
+  // Store the per-query anytime bounds, mapping the columns back to their
+  // original order if a query tree rearranged the points.
+  if (scoreBudget > 0)
+  {
+    if (buildQueryTree && tree::TreeTraits<Tree>::RearrangesDataset)
+    {
+      anytimeBounds.set_size(querySet.n_cols);
+      for (size_t i = 0; i < unmappedBounds.n_elem; ++i)
+        anytimeBounds[oldFromNewQueries[i]] = unmappedBounds[i];
+    }
+    else
+      anytimeBounds = std::move(unmappedBounds);
+  }
+
+  // Fold in any points added since the last rebuild.
+  if (unindexedSet.n_cols > 0)
+    SearchUnindexed(querySet, k, neighbors, distances);
 } // Search()
 
 template<typename SortPolicy,
@@ -614,8 +960,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     throw std::invalid_argument(ss.str());
   }
 
-  // Make sure we are in dual-tree mode.
-  if (searchMode != DUAL_TREE_MODE)
+  // Make sure we are in dual-tree or hybrid mode.
+  if (searchMode != DUAL_TREE_MODE && searchMode != HYBRID_DUAL_TREE_MODE)
     throw std::invalid_argument("cannot call NeighborSearch::Search() with a "
         "query tree when naive or singleMode are set to true");
 
@@ -627,6 +973,9 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   // Get a reference to the query set.
   const MatType& querySet = queryTree.Dataset();
 
+  if (collectStatistics)
+    stats.Reset(querySet.n_cols);
+
   // We won't need to map query indices, but will we need to map distances?
   arma::Mat<size_t>* neighborPtr = &neighbors;
 
@@ -637,9 +986,24 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   neighborPtr->set_size(k, querySet.n_cols);
   distances.set_size(k, querySet.n_cols);
 
+  // Every search is a new epoch: node statistics stamped with an older epoch
+  // are lazily reset when the traversal first touches them.
+  ++searchEpoch;
+
   // Create the helper object for the traversal.
   typedef NeighborSearchRules<SortPolicy, MetricType, Tree> RuleType;
-  RuleType rules(*referenceSet, querySet, k, metric, epsilon, sameSet);
+  RuleType rules(*referenceSet, querySet, k, metric, epsilon, sameSet,
+      collectStatistics ? &stats : NULL, scoreBudget, searchEpoch);
+
+  // In hybrid mode, seed the candidate heaps with a greedy descent for each
+  // query point; the seeded candidates serve as warm pruning bounds for the
+  // exact dual-tree phase.
+  if (searchMode == HYBRID_DUAL_TREE_MODE)
+  {
+    tree::GreedySingleTreeTraverser<Tree, RuleType> greedyTraverser(rules);
+    for (size_t i = 0; i < querySet.n_cols; ++i)
+      greedyTraverser.Traverse(i, *referenceTree);
+  }
 
   // Create the traverser.
   DualTreeTraversalType<RuleType> traverser(rules);
@@ -653,6 +1017,11 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
   rules.GetResults(*neighborPtr, distances);
 
+  // The query points are in the caller's tree order, so no mapping is needed
+  // for the anytime bounds.
+  if (scoreBudget > 0)
+    anytimeBounds = rules.AnytimeBounds();
+
   Log::Info << rules.Scores() << " node combinations were scored.\n";
   Log::Info << rules.BaseCases() << " base cases were calculated.\n";
 
@@ -673,6 +1042,10 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     // Finished with temporary matrix.
     delete neighborPtr;
   }
+
+  // Fold in any points added since the last rebuild.
+  if (unindexedSet.n_cols > 0)
+    SearchUnindexed(querySet, k, neighbors, distances);
 }
 
 template<typename SortPolicy,
@@ -709,6 +1082,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
   baseCases = 0;
   scores = 0;
+  if (collectStatistics)
+    stats.Reset(referenceSet->n_cols);
 
   arma::Mat<size_t>* neighborPtr = &neighbors;
   arma::mat* distancePtr = &distances;
@@ -725,31 +1100,101 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   neighborPtr->set_size(k, referenceSet->n_cols);
   distancePtr->set_size(k, referenceSet->n_cols);
 
+  // Every search is a new epoch: node statistics stamped with an older epoch
+  // are lazily reset when the traversal first touches them.
+  ++searchEpoch;
+
   // Create the helper object for the traversal.
   typedef NeighborSearchRules<SortPolicy, MetricType, Tree> RuleType;
   RuleType rules(*referenceSet, *referenceSet, k, metric, epsilon,
-      true /* don't return the same point as nearest neighbor */);
+      true /* don't return the same point as nearest neighbor */,
+      collectStatistics ? &stats : NULL, scoreBudget, searchEpoch);
+
+  // Whether the results were written directly, bypassing the rules object.
+  bool resultsWritten = false;
 
   switch (searchMode)
   {
     case NAIVE_MODE:
     {
-      // The naive brute-force solution.
-      for (size_t i = 0; i < referenceSet->n_cols; ++i)
-        for (size_t j = 0; j < referenceSet->n_cols; ++j)
-          rules.BaseCase(i, j);
+      // For the Euclidean distance, all pairwise distances can be computed in
+      // blocked matrix products; any other metric falls back to the
+      // point-at-a-time loop.
+      if (std::is_same<MetricType, metric::EuclideanDistance>::value)
+      {
+        typedef typename MatType::elem_type ElemType;
+
+        // Best-first sorting direction for the sort policy.
+        const char* sortDirection =
+            SortPolicy::IsBetter(0.0, 1.0) ? "ascend" : "descend";
+
+        // Process query blocks so that only one block of the full distance
+        // matrix is ever held in memory.
+        const size_t blockSize = 1024;
+        for (size_t begin = 0; begin < referenceSet->n_cols;
+            begin += blockSize)
+        {
+          const size_t end = std::min(begin + blockSize,
+              (size_t) referenceSet->n_cols);
+
+          arma::Mat<ElemType> sqDists;
+          math::PairwiseSquaredDistances(*referenceSet,
+              referenceSet->cols(begin, end - 1), sqDists);
+
+          #pragma omp parallel for
+          for (omp_size_t i = 0; i < (omp_size_t) (end - begin); ++i)
+          {
+            const arma::uvec order = arma::stable_sort_index(sqDists.col(i),
+                sortDirection);
+            // Never return the query point as its own neighbor.
+            size_t found = 0;
+            for (size_t j = 0; j < order.n_elem && found < k; ++j)
+            {
+              if (order[j] == begin + i)
+                continue;
+
+              (*neighborPtr)(found, begin + i) = order[j];
+              (*distancePtr)(found, begin + i) =
+                  std::sqrt(sqDists(order[j], i));
+              ++found;
+            }
+          }
+        }
+
+        resultsWritten = true;
+      }
+      else
+      {
+        // The naive brute-force solution.
+        for (size_t i = 0; i < referenceSet->n_cols; ++i)
+          for (size_t j = 0; j < referenceSet->n_cols; ++j)
+            rules.BaseCase(i, j);
+      }
 
       baseCases += referenceSet->n_cols * referenceSet->n_cols;
       break;
     }
     case SINGLE_TREE_MODE:
     {
-      // Create the traverser.
-      SingleTreeTraversalType<RuleType> traverser(rules);
+      if (fusedSingleTree)
+      {
+        // Traverse the reference tree once for the whole query block.
+        tree::FusedSingleTreeTraverser<Tree, RuleType> traverser(rules);
+        std::vector<size_t> queryIndices(referenceSet->n_cols);
+        for (size_t i = 0; i < referenceSet->n_cols; ++i)
+          queryIndices[i] = i;
+        traverser.Traverse(queryIndices, *referenceTree);
+      }
+      else
+      {
+        // Create the traverser.
+        SingleTreeTraversalType<RuleType> traverser(rules);
+        SetBacktrackLimit(traverser, backtrackLimit, 0);
 
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < referenceSet->n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+        // Now have it traverse for each point.
+        for (size_t i = 0; i < referenceSet->n_cols; ++i)
+          traverser.Traverse(i, *referenceTree);
+      }
 
       scores += rules.Scores();
       baseCases += rules.BaseCases();
@@ -762,26 +1207,10 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     }
     case DUAL_TREE_MODE:
     {
-      // The dual-tree monochromatic search case may require resetting the
-      // bounds in the tree.
-      if (treeNeedsReset)
-      {
-        std::stack<Tree*> nodes;
-        nodes.push(referenceTree);
-        while (!nodes.empty())
-        {
-          Tree* node = nodes.top();
-          nodes.pop();
-
-          // Reset bounds of this node.
-          node->Stat().Reset();
-
-          // Then add the children.
-          for (size_t i = 0; i < node->NumChildren(); ++i)
-            nodes.push(&node->Child(i));
-        }
-      }
-
+      // Bounds cached in the tree by a previous monochromatic search are
+      // invalidated lazily: each node statistic is stamped with the epoch
+      // that wrote it, and the rules reset stale statistics in place when
+      // they are first touched, so no full-tree reset pass is needed here.
       // Create the traverser.
       DualTreeTraversalType<RuleType> traverser(rules);
 
@@ -795,8 +1224,6 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       else
       {
         traverser.Traverse(*referenceTree, *referenceTree);
-        // Next time we perform this search, we'll need to reset the tree.
-        treeNeedsReset = true;
       }
 
       scores += rules.Scores();
@@ -807,8 +1234,6 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       Log::Info << rules.BaseCases() << " base cases were calculated."
           << std::endl;
 
-      // Next time we perform this search, we'll need to reset the tree.
-      treeNeedsReset = true;
       break;
     }
     case GREEDY_SINGLE_TREE_MODE:
@@ -823,6 +1248,44 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       scores += rules.Scores();
       baseCases += rules.BaseCases();
 
+      Log::Info << rules.Scores() << " node combinations were scored."
+          << std::endl;
+      Log::Info << rules.BaseCases() << " base cases were calculated."
+          << std::endl;
+      break;
+    }
+    case HYBRID_DUAL_TREE_MODE:
+    {
+      // Bounds cached in the tree by a previous monochromatic search are
+      // invalidated lazily: each node statistic is stamped with the epoch
+      // that wrote it, and the rules reset stale statistics in place when
+      // they are first touched, so no full-tree reset pass is needed here.
+      // First phase: a greedy descent for each point, seeding the candidate
+      // heaps with good (approximate) neighbors that serve as warm pruning
+      // bounds for the exact pass.
+      tree::GreedySingleTreeTraverser<Tree, RuleType> greedyTraverser(rules);
+      for (size_t i = 0; i < referenceSet->n_cols; ++i)
+        greedyTraverser.Traverse(i, *referenceTree);
+
+      // Second phase: the exact dual-tree traversal, sharing the rules
+      // object with the greedy pass.
+      DualTreeTraversalType<RuleType> traverser(rules);
+
+      if (tree::IsSpillTree<Tree>::value)
+      {
+        // For Dual Tree Search on SpillTree, the queryTree must be built with
+        // non overlapping (tau = 0).
+        Tree queryTree(*referenceSet);
+        traverser.Traverse(queryTree, *referenceTree);
+      }
+      else
+      {
+        traverser.Traverse(*referenceTree, *referenceTree);
+      }
+
+      scores += rules.Scores();
+      baseCases += rules.BaseCases();
+
       Log::Info << rules.Scores() << " node combinations were scored."
           << std::endl;
       Log::Info << rules.BaseCases() << " base cases were calculated."
@@ -831,7 +1294,25 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     }
   }
 
-  rules.GetResults(*neighborPtr, *distancePtr);
+  if (!resultsWritten)
+    rules.GetResults(*neighborPtr, *distancePtr);
+
+  // Store the per-query anytime bounds, mapping the columns back to their
+  // original order if the reference tree rearranged the points.  (In naive
+  // mode nothing is scored, so the bounds stay at WorstDistance().)
+  if (scoreBudget > 0)
+  {
+    const arma::vec& rawBounds = rules.AnytimeBounds();
+    if (!oldFromNewReferences.empty() &&
+        tree::TreeTraits<Tree>::RearrangesDataset)
+    {
+      anytimeBounds.set_size(referenceSet->n_cols);
+      for (size_t i = 0; i < rawBounds.n_elem; ++i)
+        anytimeBounds[oldFromNewReferences[i]] = rawBounds[i];
+    }
+    else
+      anytimeBounds = rawBounds;
+  }
 
   Timer::Stop("computing_neighbors");
 
@@ -857,6 +1338,19 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     delete neighborPtr;
     delete distancePtr;
   }
+
+  // Fold in any points added since the last rebuild.  The query points are
+  // the (possibly rearranged) tree points, so their results may need mapping
+  // back to original columns.
+  if (unindexedSet.n_cols > 0)
+  {
+    if (!oldFromNewReferences.empty() &&
+        tree::TreeTraits<Tree>::RearrangesDataset)
+      SearchUnindexed(*referenceSet, k, neighbors, distances,
+          &oldFromNewReferences);
+    else
+      SearchUnindexed(*referenceSet, k, neighbors, distances);
+  }
 }
 
 //! Calculate the average relative error.
@@ -989,6 +1483,9 @@ DualTreeTraversalType, SingleTreeTraversalType>::serialize(
     }
   }
 
+  // The side buffer of points added since the last rebuild.
+  ar(CEREAL_NVP(unindexedSet));
+
   // Reset base cases and scores.
   if (cereal::is_loading<Archive>())
   {
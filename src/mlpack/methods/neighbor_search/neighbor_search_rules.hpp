@@ -13,7 +13,10 @@
 #ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_NEIGHBOR_SEARCH_RULES_HPP
 #define MLPACK_METHODS_NEIGHBOR_SEARCH_NEIGHBOR_SEARCH_RULES_HPP
 
+#include <mlpack/core/tree/hrectbound.hpp>
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/core/tree/traversal_statistics.hpp>
+#include "sort_policies/nearest_neighbor_sort.hpp"
 
 #include <queue>
 
@@ -46,13 +49,30 @@ class NeighborSearchRules
    * @param epsilon Relative approximate error.
    * @param sameSet If true, the query and reference set are taken to be the
    *      same, and a query point will not return itself in the results.
+   * @param stats If non-NULL, detailed traversal statistics (base cases,
+   *      prunes, candidate insertions, bound tightenings) are recorded into
+   *      the given object during the traversal.
+   * @param scoreBudget If nonzero, the search becomes an anytime search:
+   *      once this many node combinations have been scored, every remaining
+   *      node combination is pruned, so the traversal unwinds and the
+   *      best-so-far candidates are returned.  The bound distance of each
+   *      budget-pruned combination is recorded per query point (see
+   *      AnytimeBounds()) so that the caller can bound the error of the
+   *      returned results.
+   * @param epoch Search epoch used for lazy invalidation of cached node
+   *      bounds: a node statistic whose generation does not match this epoch
+   *      is reset in place when first touched.  0 (the default) assumes the
+   *      caller has reset the statistics itself.
    */
   NeighborSearchRules(const typename TreeType::Mat& referenceSet,
                       const typename TreeType::Mat& querySet,
                       const size_t k,
                       MetricType& metric,
                       const double epsilon = 0,
-                      const bool sameSet = false);
+                      const bool sameSet = false,
+                      tree::TraversalStatistics* stats = NULL,
+                      const size_t scoreBudget = 0,
+                      const size_t epoch = 0);
 
   /**
    * Store the list of candidates for each query point in the given matrices.
@@ -63,6 +83,17 @@ class NeighborSearchRules
    */
   void GetResults(arma::Mat<size_t>& neighbors, arma::mat& distances);
 
+  /**
+   * Merge the candidate neighbors found by another rules object into this one.
+   * This is used by parallel traversers, which traverse with independent
+   * copies of the rules and combine the per-thread results afterwards.  For
+   * each query point, candidates from the other rules object are inserted if
+   * they improve on the candidates held here.
+   *
+   * @param other Rules object whose results will be merged into this one.
+   */
+  void Merge(const NeighborSearchRules& other);
+
   /**
    * Get the distance from the query point to the reference point.
    * This will update the list of candidates with the new point if appropriate
@@ -73,6 +104,22 @@ class NeighborSearchRules
    */
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
 
+  /**
+   * Run the base case over a contiguous range of reference points.  Traversers
+   * for trees whose leaves hold contiguous point ranges call this overload
+   * over an entire leaf at once, which lets the compiler keep the query point
+   * and the candidate list hot instead of re-fetching them for every point.
+   * The results are identical to calling the two-argument BaseCase() for each
+   * point in the range.
+   *
+   * @param queryIndex Index of query point.
+   * @param refBegin Index of first reference point in the range.
+   * @param refCount Number of reference points in the range.
+   */
+  void BaseCase(const size_t queryIndex,
+                const size_t refBegin,
+                const size_t refCount);
+
   /**
    * Get the score for recursion order.  A low score indicates priority for
    * recursion, while DBL_MAX indicates that the node should not be recursed
@@ -161,6 +208,14 @@ class NeighborSearchRules
   //! results.  This is only needed in defeatist search mode.
   size_t MinimumBaseCases() const { return k; }
 
+  //! Get the per-query anytime bounds (only filled when a score budget is
+  //! set).  Element i is the best distance any budget-pruned reference
+  //! subtree could possibly contain for query point i; if the returned k'th
+  //! candidate distance is better than this value, the result for that query
+  //! point is exact (up to epsilon).  Queries for which nothing was pruned on
+  //! budget hold SortPolicy::WorstDistance().
+  const arma::vec& AnytimeBounds() const { return anytimeBounds; }
+
  protected:
   //! The reference set.
   const typename TreeType::Mat& referenceSet;
@@ -210,6 +265,20 @@ class NeighborSearchRules
   //! The number of scores that have been performed.
   size_t scores;
 
+  //! If non-NULL, detailed traversal statistics are recorded here.
+  tree::TraversalStatistics* stats;
+
+  //! If nonzero, prune every node combination scored after this many scores
+  //! and return best-so-far results (anytime search).
+  const size_t scoreBudget;
+
+  //! For each query point, the best distance any budget-pruned reference
+  //! subtree could contain.  Only allocated when scoreBudget is nonzero.
+  arma::vec anytimeBounds;
+
+  //! Search epoch used for lazy invalidation of cached node bounds.
+  const size_t epoch;
+
   //! Traversal info for the parent combination; this is updated by the
   //! traversal before each call to Score().
   TraversalInfoType traversalInfo;
@@ -219,6 +288,13 @@ class NeighborSearchRules
    */
   double CalculateBound(TreeType& queryNode) const;
 
+  /**
+   * Reset the statistic of the given node in place if it was last written
+   * during an earlier search epoch, so that stale cached bounds are never
+   * consulted.  This is a no-op when no epoch is in use.
+   */
+  void CheckStatEpoch(TreeType& node) const;
+
   /**
    * Helper function to insert a point into the list of candidate points.
    *
@@ -229,6 +305,67 @@ class NeighborSearchRules
   void InsertNeighbor(const size_t queryIndex,
                       const size_t neighbor,
                       const double distance);
+
+  /**
+   * Compute the distance between a query point and a reference point,
+   * abandoning the computation as soon as the running sum over the
+   * dimensions proves the distance worse than the given bound.  The sum is
+   * checked against the bound once per block of 16 dimensions, so the inner
+   * loop stays vectorizable.  If the computation is abandoned, the sentinel
+   * SortPolicy::WorstDistance() is returned instead of the distance.
+   *
+   * This overload is selected when the metric is an LMetric, the search is
+   * for nearest neighbors and the dataset is dense; the partial sum is then
+   * a growing lower bound on the distance, which is what makes abandoning
+   * valid.
+   *
+   * @param queryIndex Index of the query point.
+   * @param referenceIndex Index of the reference point.
+   * @param bound Distance of the current worst candidate neighbor.
+   */
+  template<typename M = MetricType>
+  typename std::enable_if<bound::meta::IsLMetric<M>::Value &&
+      std::is_same<SortPolicy, NearestNeighborSort>::value &&
+      !arma::is_SpMat<typename TreeType::Mat>::value, double>::type
+  EarlyDistance(const size_t queryIndex,
+                const size_t referenceIndex,
+                const double bound) const;
+
+  /**
+   * Compute the distance between a sparse query point and a sparse reference
+   * point by merging their nonzero entries in one pass; dimensions in which
+   * both points are zero contribute nothing and are never touched, so the
+   * cost is proportional to the number of nonzero entries rather than the
+   * dimensionality.  As in the dense overload, the computation is abandoned
+   * (and SortPolicy::WorstDistance() returned) as soon as the running sum
+   * proves the distance worse than the given bound.
+   *
+   * This overload is selected when the metric is an LMetric, the search is
+   * for nearest neighbors and the dataset is sparse.
+   *
+   * @param queryIndex Index of the query point.
+   * @param referenceIndex Index of the reference point.
+   * @param bound Distance of the current worst candidate neighbor.
+   */
+  template<typename M = MetricType>
+  typename std::enable_if<bound::meta::IsLMetric<M>::Value &&
+      std::is_same<SortPolicy, NearestNeighborSort>::value &&
+      arma::is_SpMat<typename TreeType::Mat>::value, double>::type
+  EarlyDistance(const size_t queryIndex,
+                const size_t referenceIndex,
+                const double bound) const;
+
+  /**
+   * Compute the full distance between a query point and a reference point;
+   * this overload is selected whenever early abandoning is not valid for the
+   * configuration, and the bound is ignored.
+   */
+  template<typename M = MetricType>
+  typename std::enable_if<!(bound::meta::IsLMetric<M>::Value &&
+      std::is_same<SortPolicy, NearestNeighborSort>::value), double>::type
+  EarlyDistance(const size_t queryIndex,
+                const size_t referenceIndex,
+                const double bound) const;
 };
 
 } // namespace neighbor
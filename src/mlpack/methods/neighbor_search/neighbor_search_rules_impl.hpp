@@ -26,7 +26,10 @@ NeighborSearchRules<SortPolicy, MetricType, TreeType>::NeighborSearchRules(
     const size_t k,
     MetricType& metric,
     const double epsilon,
-    const bool sameSet) :
+    const bool sameSet,
+    tree::TraversalStatistics* stats,
+    const size_t scoreBudget,
+    const size_t epoch) :
     referenceSet(referenceSet),
     querySet(querySet),
     k(k),
@@ -36,8 +39,19 @@ NeighborSearchRules<SortPolicy, MetricType, TreeType>::NeighborSearchRules(
     lastQueryIndex(querySet.n_cols),
     lastReferenceIndex(referenceSet.n_cols),
     baseCases(0),
-    scores(0)
+    scores(0),
+    stats(stats),
+    scoreBudget(scoreBudget),
+    epoch(epoch)
 {
+  // In anytime mode we track, for each query point, how good the results
+  // hidden in budget-pruned subtrees could possibly be.
+  if (scoreBudget > 0)
+  {
+    anytimeBounds.set_size(querySet.n_cols);
+    anytimeBounds.fill(SortPolicy::WorstDistance());
+  }
+
   // We must set the traversal info last query and reference node pointers to
   // something that is both invalid (i.e. not a tree node) and not NULL.  We'll
   // use the this pointer.
@@ -79,6 +93,35 @@ void NeighborSearchRules<SortPolicy, MetricType, TreeType>::GetResults(
   }
 };
 
+template<typename SortPolicy, typename MetricType, typename TreeType>
+void NeighborSearchRules<SortPolicy, MetricType, TreeType>::Merge(
+    const NeighborSearchRules& other)
+{
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    // Insert every candidate the other rules object holds for this query
+    // point; InsertNeighbor() discards those which do not improve our list.
+    CandidateList pqueue = other.candidates[i]; // Copy so we can pop.
+    while (!pqueue.empty())
+    {
+      const Candidate& c = pqueue.top();
+      InsertNeighbor(i, c.second, c.first);
+      pqueue.pop();
+    }
+  }
+
+  baseCases += other.baseCases;
+  scores += other.scores;
+
+  // Combine anytime bounds, if both objects track them.
+  if (anytimeBounds.n_elem > 0 && other.anytimeBounds.n_elem > 0)
+  {
+    for (size_t i = 0; i < anytimeBounds.n_elem; ++i)
+      if (SortPolicy::IsBetter(other.anytimeBounds[i], anytimeBounds[i]))
+        anytimeBounds[i] = other.anytimeBounds[i];
+  }
+}
+
 template<typename SortPolicy, typename MetricType, typename TreeType>
 inline force_inline // Absolutely MUST be inline so optimizations can happen.
 double NeighborSearchRules<SortPolicy, MetricType, TreeType>::
@@ -96,6 +139,8 @@ BaseCase(const size_t queryIndex, const size_t referenceIndex)
   double distance = metric.Evaluate(querySet.col(queryIndex),
                                     referenceSet.col(referenceIndex));
   ++baseCases;
+  if (stats)
+    stats->RecordBaseCase(queryIndex);
 
   InsertNeighbor(queryIndex, referenceIndex, distance);
 
@@ -107,11 +152,67 @@ BaseCase(const size_t queryIndex, const size_t referenceIndex)
   return distance;
 }
 
+template<typename SortPolicy, typename MetricType, typename TreeType>
+inline void NeighborSearchRules<SortPolicy, MetricType, TreeType>::
+BaseCase(const size_t queryIndex,
+         const size_t refBegin,
+         const size_t refCount)
+{
+  // The reference points are contiguous, so the query point stays in cache
+  // (or registers) across the whole range.
+  const size_t refEnd = refBegin + refCount;
+  for (size_t referenceIndex = refBegin; referenceIndex < refEnd;
+       ++referenceIndex)
+  {
+    // Mirror the checks of the two-argument BaseCase() exactly.
+    if (sameSet && (queryIndex == referenceIndex))
+      continue;
+
+    if ((lastQueryIndex == queryIndex) &&
+        (lastReferenceIndex == referenceIndex))
+      continue;
+
+    // Abandon the distance as soon as its partial sum proves it worse than
+    // the current worst candidate; for configurations where abandoning is
+    // not valid this computes the full distance.  The two-argument overload
+    // cannot abandon, because its return value feeds the traversal bound
+    // bookkeeping.
+    const double distance = EarlyDistance(queryIndex, referenceIndex,
+        candidates[queryIndex].top().first);
+    ++baseCases;
+    if (stats)
+      stats->RecordBaseCase(queryIndex);
+
+    if (distance == SortPolicy::WorstDistance())
+      continue; // Abandoned; the point cannot improve the candidate list.
+
+    InsertNeighbor(queryIndex, referenceIndex, distance);
+
+    // Cache this information, as the two-argument overload does.
+    lastQueryIndex = queryIndex;
+    lastReferenceIndex = referenceIndex;
+    lastBaseCase = distance;
+  }
+}
+
 template<typename SortPolicy, typename MetricType, typename TreeType>
 inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
     const size_t queryIndex,
     TreeType& referenceNode)
 {
+  // In anytime mode, prune everything once the score budget is exhausted,
+  // but remember how good the pruned subtree could have been so that a
+  // per-query error bound can be reported.  Base cases of combinations
+  // admitted before the budget ran out still finish their work.
+  if (scoreBudget > 0 && scores >= scoreBudget)
+  {
+    const double distance = SortPolicy::BestPointToNodeDistance(
+        querySet.col(queryIndex), &referenceNode);
+    if (SortPolicy::IsBetter(distance, anytimeBounds[queryIndex]))
+      anytimeBounds[queryIndex] = distance;
+    return DBL_MAX;
+  }
+
   ++scores; // Count number of Score() calls.
   double distance;
   if (tree::TreeTraits<TreeType>::FirstPointIsCentroid)
@@ -121,6 +222,10 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
     double baseCase = -1.0;
     if (tree::TreeTraits<TreeType>::HasSelfChildren)
     {
+      CheckStatEpoch(referenceNode);
+      if (referenceNode.Parent() != NULL)
+        CheckStatEpoch(*referenceNode.Parent());
+
       // If the parent node is the same, then we have already calculated the
       // base case.
       if ((referenceNode.Parent() != NULL) &&
@@ -146,6 +251,13 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
   double bestDistance = candidates[queryIndex].top().first;
   bestDistance = SortPolicy::Relax(bestDistance, epsilon);
 
+  if (stats)
+  {
+    stats->RecordScore();
+    if (!SortPolicy::IsBetter(distance, bestDistance))
+      stats->RecordPrune();
+  }
+
   return (SortPolicy::IsBetter(distance, bestDistance)) ?
       SortPolicy::ConvertToScore(distance) : DBL_MAX;
 }
@@ -182,6 +294,9 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Rescore(
   double bestDistance = candidates[queryIndex].top().first;
   bestDistance = SortPolicy::Relax(bestDistance, epsilon);
 
+  if (stats && !SortPolicy::IsBetter(distance, bestDistance))
+    stats->RecordPrune();
+
   return (SortPolicy::IsBetter(distance, bestDistance)) ? oldScore : DBL_MAX;
 }
 
@@ -190,7 +305,26 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
     TreeType& queryNode,
     TreeType& referenceNode)
 {
+  // In anytime mode, prune everything once the score budget is exhausted,
+  // but remember how good the pruned reference subtree could have been for
+  // every query point it was pruned for, so that a per-query error bound can
+  // be reported.
+  if (scoreBudget > 0 && scores >= scoreBudget)
+  {
+    const double distance = SortPolicy::BestNodeToNodeDistance(&queryNode,
+        &referenceNode);
+    for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
+    {
+      const size_t queryIndex = queryNode.Descendant(i);
+      if (SortPolicy::IsBetter(distance, anytimeBounds[queryIndex]))
+        anytimeBounds[queryIndex] = distance;
+    }
+    return DBL_MAX;
+  }
+
   ++scores; // Count number of Score() calls.
+  if (stats)
+    stats->RecordScore();
 
   // Update our bound.
   const double bestDistance = CalculateBound(queryNode);
@@ -290,6 +424,8 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
       // There isn't any need to set the traversal information because no
       // descendant combinations will be visited, and those are the only
       // combinations that would depend on the traversal information.
+      if (stats)
+        stats->RecordPrune();
       return DBL_MAX;
     }
   }
@@ -342,6 +478,8 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
     // There isn't any need to set the traversal information because no
     // descendant combinations will be visited, and those are the only
     // combinations that would depend on the traversal information.
+    if (stats)
+      stats->RecordPrune();
     return DBL_MAX;
   }
 }
@@ -360,6 +498,9 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Rescore(
   // Update our bound.
   const double bestDistance = CalculateBound(queryNode);
 
+  if (stats && !SortPolicy::IsBetter(distance, bestDistance))
+    stats->RecordPrune();
+
   return (SortPolicy::IsBetter(distance, bestDistance)) ? oldScore : DBL_MAX;
 }
 
@@ -417,6 +558,7 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::
   // assemble bounds.
   for (size_t i = 0; i < queryNode.NumChildren(); ++i)
   {
+    CheckStatEpoch(queryNode.Child(i));
     const double firstBound = queryNode.Child(i).Stat().FirstBound();
     const double auxBound = queryNode.Child(i).Stat().AuxBound();
 
@@ -447,6 +589,8 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::
   // Now consider the parent bounds.
   if (queryNode.Parent() != NULL)
   {
+    CheckStatEpoch(*queryNode.Parent());
+
     // The parent's worst distance bound implies that the bound for this node
     // must be at least as good.  Thus, if the parent worst distance bound is
     // better, then take it.
@@ -463,12 +607,16 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::
   }
 
   // Could the existing bounds be better?
+  CheckStatEpoch(queryNode);
   if (SortPolicy::IsBetter(queryNode.Stat().FirstBound(), worstDistance))
     worstDistance = queryNode.Stat().FirstBound();
   if (SortPolicy::IsBetter(queryNode.Stat().SecondBound(), bestDistance))
     bestDistance = queryNode.Stat().SecondBound();
 
   // Cache bounds for later.
+  if (stats && (queryNode.Stat().FirstBound() != worstDistance ||
+                queryNode.Stat().SecondBound() != bestDistance))
+    stats->RecordBoundTightening();
   queryNode.Stat().FirstBound() = worstDistance;
   queryNode.Stat().SecondBound() = bestDistance;
   queryNode.Stat().AuxBound() = auxDistance;
@@ -485,6 +633,20 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::
     return bestDistance;
 }
 
+
+template<typename SortPolicy, typename MetricType, typename TreeType>
+inline void NeighborSearchRules<SortPolicy, MetricType, TreeType>::
+    CheckStatEpoch(TreeType& node) const
+{
+  // Generation 0 paired with epoch 0 means no epoch tracking is in use; any
+  // other mismatch means the cached bounds belong to an earlier search.
+  if (node.Stat().Generation() != epoch)
+  {
+    node.Stat().Reset();
+    node.Stat().Generation() = epoch;
+  }
+}
+
 /**
  * Helper function to insert a point into the list of candidate points.
  *
@@ -506,7 +668,138 @@ InsertNeighbor(
   {
     pqueue.pop();
     pqueue.push(c);
+    if (stats)
+      stats->RecordInsertion(queryIndex);
+  }
+}
+
+template<typename SortPolicy, typename MetricType, typename TreeType>
+template<typename M>
+inline typename std::enable_if<bound::meta::IsLMetric<M>::Value &&
+    std::is_same<SortPolicy, NearestNeighborSort>::value &&
+    !arma::is_SpMat<typename TreeType::Mat>::value, double>::type
+NeighborSearchRules<SortPolicy, MetricType, TreeType>::EarlyDistance(
+    const size_t queryIndex,
+    const size_t referenceIndex,
+    const double bound) const
+{
+  typedef typename TreeType::Mat::elem_type ElemType;
+
+  const ElemType* query = querySet.colptr(queryIndex);
+  const ElemType* reference = referenceSet.colptr(referenceIndex);
+  const size_t dimensions = querySet.n_rows;
+
+  // Move the bound into the power domain, so the running sum can be compared
+  // without taking any roots.  Until the candidate list of the query point is
+  // full the bound is the sentinel WorstDistance() and nothing is abandoned.
+  const double boundPow = (M::TakeRoot && bound != SortPolicy::WorstDistance())
+      ? std::pow(bound, (double) M::Power) : bound;
+
+  double sum = 0.0;
+  size_t d = 0;
+  while (d < dimensions)
+  {
+    // One fixed-width block at a time: the block loop has no branches, so it
+    // vectorizes, and the abandoning check runs once per block.
+    const size_t blockEnd = std::min(d + 16, dimensions);
+    for (; d < blockEnd; ++d)
+    {
+      const double difference = (double) (query[d] - reference[d]);
+      sum += (M::Power == 2) ? difference * difference :
+          (M::Power == 1) ? std::fabs(difference) :
+          std::pow(std::fabs(difference), (double) M::Power);
+    }
+
+    if (sum > boundPow)
+      return SortPolicy::WorstDistance();
+  }
+
+  if (!M::TakeRoot)
+    return sum;
+
+  return (M::Power == 2) ? std::sqrt(sum) :
+      std::pow(sum, 1.0 / (double) M::Power);
+}
+
+template<typename SortPolicy, typename MetricType, typename TreeType>
+template<typename M>
+inline typename std::enable_if<bound::meta::IsLMetric<M>::Value &&
+    std::is_same<SortPolicy, NearestNeighborSort>::value &&
+    arma::is_SpMat<typename TreeType::Mat>::value, double>::type
+NeighborSearchRules<SortPolicy, MetricType, TreeType>::EarlyDistance(
+    const size_t queryIndex,
+    const size_t referenceIndex,
+    const double bound) const
+{
+  typedef typename TreeType::Mat MatType;
+
+  // Move the bound into the power domain, so the running sum can be compared
+  // without taking any roots.  Until the candidate list of the query point is
+  // full the bound is the sentinel WorstDistance() and nothing is abandoned.
+  const double boundPow = (M::TakeRoot && bound != SortPolicy::WorstDistance())
+      ? std::pow(bound, (double) M::Power) : bound;
+
+  // Merge the nonzero entries of both columns in one pass; dimensions in
+  // which both points are zero contribute nothing and are never touched.
+  typename MatType::const_col_iterator qIt = querySet.begin_col(queryIndex);
+  typename MatType::const_col_iterator qEnd = querySet.end_col(queryIndex);
+  typename MatType::const_col_iterator rIt =
+      referenceSet.begin_col(referenceIndex);
+  typename MatType::const_col_iterator rEnd =
+      referenceSet.end_col(referenceIndex);
+
+  double sum = 0.0;
+  size_t checked = 0;
+  while (qIt != qEnd || rIt != rEnd)
+  {
+    double difference;
+    if (rIt == rEnd || (qIt != qEnd && qIt.row() < rIt.row()))
+    {
+      difference = (double) (*qIt);
+      ++qIt;
+    }
+    else if (qIt == qEnd || rIt.row() < qIt.row())
+    {
+      difference = (double) (*rIt);
+      ++rIt;
+    }
+    else
+    {
+      difference = (double) ((*qIt) - (*rIt));
+      ++qIt;
+      ++rIt;
+    }
+
+    sum += (M::Power == 2) ? difference * difference :
+        (M::Power == 1) ? std::fabs(difference) :
+        std::pow(std::fabs(difference), (double) M::Power);
+
+    // Check the bound once per block of 16 merged entries.
+    if ((++checked % 16 == 0) && (sum > boundPow))
+      return SortPolicy::WorstDistance();
   }
+
+  if (sum > boundPow)
+    return SortPolicy::WorstDistance();
+
+  if (!M::TakeRoot)
+    return sum;
+
+  return (M::Power == 2) ? std::sqrt(sum) :
+      std::pow(sum, 1.0 / (double) M::Power);
+}
+
+template<typename SortPolicy, typename MetricType, typename TreeType>
+template<typename M>
+inline typename std::enable_if<!(bound::meta::IsLMetric<M>::Value &&
+    std::is_same<SortPolicy, NearestNeighborSort>::value), double>::type
+NeighborSearchRules<SortPolicy, MetricType, TreeType>::EarlyDistance(
+    const size_t queryIndex,
+    const size_t referenceIndex,
+    const double /* bound */) const
+{
+  return metric.Evaluate(querySet.col(queryIndex),
+                         referenceSet.col(referenceIndex));
 }
 
 } // namespace neighbor
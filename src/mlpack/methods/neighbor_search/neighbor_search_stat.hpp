@@ -39,6 +39,11 @@ class NeighborSearchStat
   double auxBound;
   //! The last distance evaluation.
   double lastDistance;
+  //! The search epoch that last wrote the bounds.  A node whose generation
+  //! does not match the current epoch holds stale bounds from an earlier
+  //! search and is reset lazily when first touched, which avoids walking the
+  //! whole tree to reset statistics between searches.
+  size_t generation;
 
  public:
   /**
@@ -49,7 +54,8 @@ class NeighborSearchStat
       firstBound(SortPolicy::WorstDistance()),
       secondBound(SortPolicy::WorstDistance()),
       auxBound(SortPolicy::WorstDistance()),
-      lastDistance(0.0) { }
+      lastDistance(0.0),
+      generation(0) { }
 
   /**
    * Initialization for a fully initialized node.  In this case, we don't need
@@ -60,7 +66,8 @@ class NeighborSearchStat
       firstBound(SortPolicy::WorstDistance()),
       secondBound(SortPolicy::WorstDistance()),
       auxBound(SortPolicy::WorstDistance()),
-      lastDistance(0.0) { }
+      lastDistance(0.0),
+      generation(0) { }
 
   /**
    * Reset statistic parameters to initial values.
@@ -89,6 +96,10 @@ class NeighborSearchStat
   double LastDistance() const { return lastDistance; }
   //! Modify the last distance calculation.
   double& LastDistance() { return lastDistance; }
+  //! Get the search epoch that last wrote the bounds.
+  size_t Generation() const { return generation; }
+  //! Modify the search epoch that last wrote the bounds.
+  size_t& Generation() { return generation; }
 
   //! Serialize the statistic to/from an archive.
   template<typename Archive>
@@ -98,6 +109,8 @@ class NeighborSearchStat
     ar(CEREAL_NVP(secondBound));
     ar(CEREAL_NVP(auxBound));
     ar(CEREAL_NVP(lastDistance));
+    // The generation is deliberately not serialized: a loaded tree starts at
+    // generation 0, so its bounds are lazily reset by the first search.
   }
 };
 
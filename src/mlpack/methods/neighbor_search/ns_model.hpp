@@ -22,6 +22,8 @@
 #include <mlpack/core/tree/octree.hpp>
 #include <boost/variant.hpp>
 #include "neighbor_search.hpp"
+#include "nsw_graph.hpp"
+#include "pq_index.hpp"
 
 namespace mlpack {
 namespace neighbor {
@@ -32,14 +34,32 @@ namespace neighbor {
 template<typename SortPolicy,
          template<typename TreeMetricType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
+                  typename TreeMatType> class TreeType,
+         typename MatType = arma::mat>
 using NSType = NeighborSearch<SortPolicy,
                               metric::EuclideanDistance,
-                              arma::mat,
+                              MatType,
                               TreeType,
                               TreeType<metric::EuclideanDistance,
                                   NeighborSearchStat<SortPolicy>,
-                                  arma::mat>::template DualTreeTraverser>;
+                                  MatType>::template DualTreeTraverser>;
+
+/**
+ * Alias template for defeatist neighbor search on spill trees with an
+ * arbitrary matrix type.  For arma::mat this is exactly the SpillKNN typedef.
+ */
+template<typename MatType = arma::mat>
+using SpillKNNT = NeighborSearch<
+    NearestNeighborSort,
+    metric::EuclideanDistance,
+    MatType,
+    tree::SPTree,
+    tree::SPTree<metric::EuclideanDistance,
+        NeighborSearchStat<NearestNeighborSort>,
+        MatType>::template DefeatistDualTreeTraverser,
+    tree::SPTree<metric::EuclideanDistance,
+        NeighborSearchStat<NearestNeighborSort>,
+        MatType>::template DefeatistSingleTreeTraverser>;
 
 /**
  * MonoSearchVisitor executes a monochromatic neighbor search on the given
@@ -70,18 +90,55 @@ class MonoSearchVisitor : public boost::static_visitor<void>
   {};
 };
 
+/**
+ * BatchSearchVisitor executes a bichromatic neighbor search for a (usually
+ * small) batch of streaming queries on the given NSType.  The search is forced
+ * into single-tree mode so that no query tree is built and the query set is
+ * not copied or remapped; only the already-built reference tree is used.  The
+ * previous search mode is restored afterwards.
+ */
+template<typename MatType = arma::mat>
+class BatchSearchVisitor : public boost::static_visitor<void>
+{
+ private:
+  //! The batch of query points.
+  const MatType& querySet;
+  //! Number of neighbors to search for.
+  const size_t k;
+  //! Result matrix for neighbors.
+  arma::Mat<size_t>& neighbors;
+  //! Result matrix for distances.
+  arma::mat& distances;
+
+ public:
+  //! Perform the batch search in single-tree mode.
+  template<typename NSType>
+  void operator()(NSType* ns) const;
+
+  //! Construct the BatchSearchVisitor object with the given parameters.
+  BatchSearchVisitor(const MatType& querySet,
+                     const size_t k,
+                     arma::Mat<size_t>& neighbors,
+                     arma::mat& distances) :
+      querySet(querySet),
+      k(k),
+      neighbors(neighbors),
+      distances(distances)
+  {};
+};
+
 /**
  * BiSearchVisitor executes a bichromatic neighbor search on the given NSType.
  * We use template specialization to differentiate those tree types that
  * accept leafSize as a parameter. In these cases, before doing neighbor search,
  * a query tree with proper leafSize is built from the querySet.
  */
-template<typename SortPolicy>
+template<typename SortPolicy, typename MatType = arma::mat>
 class BiSearchVisitor : public boost::static_visitor<void>
 {
  private:
   //! The query set for the bichromatic search.
-  const arma::mat& querySet;
+  const MatType& querySet;
   //! The number of neighbors to search for.
   const size_t k;
   //! The result matrix for neighbors.
@@ -104,7 +161,7 @@ class BiSearchVisitor : public boost::static_visitor<void>
   template<template<typename TreeMetricType,
                     typename TreeStatType,
                     typename TreeMatType> class TreeType>
-  using NSTypeT = NSType<SortPolicy, TreeType>;
+  using NSTypeT = NSType<SortPolicy, TreeType, MatType>;
 
   //! Default Bichromatic neighbor search on the given NSType instance.
   template<template<typename TreeMetricType,
@@ -119,13 +176,19 @@ class BiSearchVisitor : public boost::static_visitor<void>
   void operator()(NSTypeT<tree::BallTree>* ns) const;
 
   //! Bichromatic neighbor search specialized for SPTrees.
-  void operator()(SpillKNN* ns) const;
+  void operator()(SpillKNNT<MatType>* ns) const;
 
   //! Bichromatic neighbor search specialized for octrees.
   void operator()(NSTypeT<tree::Octree>* ns) const;
 
+  //! Bichromatic neighbor search on a navigable small-world graph.
+  void operator()(NSWGraph<SortPolicy, MatType>* ns) const;
+
+  //! Bichromatic neighbor search on a product-quantization index.
+  void operator()(PQIndex<SortPolicy, MatType>* ns) const;
+
   //! Construct the BiSearchVisitor.
-  BiSearchVisitor(const arma::mat& querySet,
+  BiSearchVisitor(const MatType& querySet,
                   const size_t k,
                   arma::Mat<size_t>& neighbors,
                   arma::mat& distances,
@@ -140,12 +203,12 @@ class BiSearchVisitor : public boost::static_visitor<void>
  * accept leafSize as a parameter. In these cases, a reference tree with proper
  * leafSize is built from the referenceSet.
  */
-template<typename SortPolicy>
+template<typename SortPolicy, typename MatType = arma::mat>
 class TrainVisitor : public boost::static_visitor<void>
 {
  private:
   //! The reference set to use for training.
-  arma::mat&& referenceSet;
+  MatType&& referenceSet;
   //! The leaf size, used only by BinarySpaceTree.
   size_t leafSize;
   //! Overlapping size (for spill trees).
@@ -162,7 +225,7 @@ class TrainVisitor : public boost::static_visitor<void>
   template<template<typename TreeMetricType,
                     typename TreeStatType,
                     typename TreeMatType> class TreeType>
-  using NSTypeT = NSType<SortPolicy, TreeType>;
+  using NSTypeT = NSType<SortPolicy, TreeType, MatType>;
 
   //! Default Train on the given NSType instance.
   template<template<typename TreeMetricType,
@@ -177,19 +240,45 @@ class TrainVisitor : public boost::static_visitor<void>
   void operator()(NSTypeT<tree::BallTree>* ns) const;
 
   //! Train specialized for SPTrees.
-  void operator()(SpillKNN* ns) const;
+  void operator()(SpillKNNT<MatType>* ns) const;
 
   //! Train specialized for octrees.
   void operator()(NSTypeT<tree::Octree>* ns) const;
 
+  //! Train on a navigable small-world graph.
+  void operator()(NSWGraph<SortPolicy, MatType>* ns) const;
+
+  //! Train on a product-quantization index.
+  void operator()(PQIndex<SortPolicy, MatType>* ns) const;
+
   //! Construct the TrainVisitor object with the given reference set, leafSize
   //! for BinarySpaceTrees, and tau and rho for spill trees.
-  TrainVisitor(arma::mat&& referenceSet,
+  TrainVisitor(MatType&& referenceSet,
                const size_t leafSize,
                const double tau,
                const double rho);
 };
 
+/**
+ * AddPointsVisitor appends new reference points to the index held by the
+ * given NSType without retraining it from scratch.
+ */
+template<typename MatType>
+class AddPointsVisitor : public boost::static_visitor<void>
+{
+ private:
+  //! The points to append.
+  MatType& points;
+
+ public:
+  //! Append the points to the given NSType instance.
+  template<typename NSType>
+  void operator()(NSType* ns) const;
+
+  //! Construct the AddPointsVisitor with the given points.
+  AddPointsVisitor(MatType& points);
+};
+
 /**
  * SearchModeVisitor exposes the SearchMode() method of the given NSType.
  */
@@ -215,12 +304,13 @@ class EpsilonVisitor : public boost::static_visitor<double&>
 /**
  * ReferenceSetVisitor exposes the referenceSet of the given NSType.
  */
-class ReferenceSetVisitor : public boost::static_visitor<const arma::mat&>
+template<typename MatType = arma::mat>
+class ReferenceSetVisitor : public boost::static_visitor<const MatType&>
 {
  public:
   //! Return the reference set.
   template<typename NSType>
-  const arma::mat& operator()(NSType *ns) const;
+  const MatType& operator()(NSType *ns) const;
 };
 
 /**
@@ -243,8 +333,10 @@ class DeleteVisitor : public boost::static_visitor<void>
  * mlpack_knn and mlpack_kfn, be aware that it is limited!
  *
  * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ * @tparam MatType The type of data matrix, which also determines the floating
+ *     point precision of the search (e.g. arma::fmat for single precision).
  */
-template<typename SortPolicy>
+template<typename SortPolicy, typename MatType = arma::mat>
 class NSModel
 {
  public:
@@ -265,7 +357,9 @@ class NSModel
     MAX_RP_TREE,
     SPILL_TREE,
     UB_TREE,
-    OCTREE
+    OCTREE,
+    NSW_GRAPH,
+    PQ_INDEX
   };
 
  private:
@@ -280,31 +374,45 @@ class NSModel
   //! Balance threshold (for spill trees).
   double rho;
 
+  //! Search beam width (for navigable small-world graphs); this is the
+  //! recall/time tradeoff knob.
+  size_t efSearch;
+
+  //! Number of inverted lists probed per query (for product-quantization
+  //! indexes); this is the recall/time tradeoff knob.
+  size_t numProbes;
+
   //! If true, random projections are used.
   bool randomBasis;
   //! This is the random projection matrix; only used if randomBasis is true.
-  arma::mat q;
+  MatType q;
+
+  //! Scratch buffer holding the projected query batch for SearchBatch(); kept
+  //! as a member so repeated batches of the same size reuse the allocation.
+  MatType batchQueryBuffer;
 
   /**
    * nSearch holds an instance of the NeigborSearch class for the current
    * treeType. It is initialized every time BuildModel is executed.
    * We access to the contained value through the visitor classes defined above.
    */
-  boost::variant<NSType<SortPolicy, tree::KDTree>*,
-                 NSType<SortPolicy, tree::StandardCoverTree>*,
-                 NSType<SortPolicy, tree::RTree>*,
-                 NSType<SortPolicy, tree::RStarTree>*,
-                 NSType<SortPolicy, tree::BallTree>*,
-                 NSType<SortPolicy, tree::XTree>*,
-                 NSType<SortPolicy, tree::HilbertRTree>*,
-                 NSType<SortPolicy, tree::RPlusTree>*,
-                 NSType<SortPolicy, tree::RPlusPlusTree>*,
-                 NSType<SortPolicy, tree::VPTree>*,
-                 NSType<SortPolicy, tree::RPTree>*,
-                 NSType<SortPolicy, tree::MaxRPTree>*,
-                 SpillKNN*,
-                 NSType<SortPolicy, tree::UBTree>*,
-                 NSType<SortPolicy, tree::Octree>*> nSearch;
+  boost::variant<NSType<SortPolicy, tree::KDTree, MatType>*,
+                 NSType<SortPolicy, tree::StandardCoverTree, MatType>*,
+                 NSType<SortPolicy, tree::RTree, MatType>*,
+                 NSType<SortPolicy, tree::RStarTree, MatType>*,
+                 NSType<SortPolicy, tree::BallTree, MatType>*,
+                 NSType<SortPolicy, tree::XTree, MatType>*,
+                 NSType<SortPolicy, tree::HilbertRTree, MatType>*,
+                 NSType<SortPolicy, tree::RPlusTree, MatType>*,
+                 NSType<SortPolicy, tree::RPlusPlusTree, MatType>*,
+                 NSType<SortPolicy, tree::VPTree, MatType>*,
+                 NSType<SortPolicy, tree::RPTree, MatType>*,
+                 NSType<SortPolicy, tree::MaxRPTree, MatType>*,
+                 SpillKNNT<MatType>*,
+                 NSType<SortPolicy, tree::UBTree, MatType>*,
+                 NSType<SortPolicy, tree::Octree, MatType>*,
+                 NSWGraph<SortPolicy, MatType>*,
+                 PQIndex<SortPolicy, MatType>*> nSearch;
 
  public:
   /**
@@ -353,7 +461,7 @@ class NSModel
   void serialize(Archive& ar, const uint32_t /* version */);
 
   //! Expose the dataset.
-  const arma::mat& Dataset() const;
+  const MatType& Dataset() const;
 
   //! Expose SearchMode.
   NeighborSearchMode SearchMode() const;
@@ -375,6 +483,15 @@ class NSModel
   double Rho() const { return rho; }
   double& Rho() { return rho; }
 
+  //! Expose efSearch (the recall/time knob for navigable small-world graphs).
+  size_t EfSearch() const { return efSearch; }
+  size_t& EfSearch() { return efSearch; }
+
+  //! Expose numProbes (the recall/time knob for product-quantization
+  //! indexes).
+  size_t NumProbes() const { return numProbes; }
+  size_t& NumProbes() { return numProbes; }
+
   //! Expose treeType.
   TreeTypes TreeType() const { return treeType; }
   TreeTypes& TreeType() { return treeType; }
@@ -384,13 +501,24 @@ class NSModel
   bool& RandomBasis() { return randomBasis; }
 
   //! Build the reference tree.
-  void BuildModel(arma::mat&& referenceSet,
+  void BuildModel(MatType&& referenceSet,
                   const size_t leafSize,
                   const NeighborSearchMode searchMode,
                   const double epsilon = 0);
 
+  /**
+   * Add new reference points to the model without retraining it from
+   * scratch.  Tree-based indexes hold the points in a brute-force side
+   * buffer that is periodically merged into the tree; the navigable
+   * small-world graph inserts them incrementally.  Added points receive
+   * indices following the existing reference points, in insertion order.
+   *
+   * @param points New reference points; the matrix is taken over.
+   */
+  void AddPoints(MatType&& points);
+
   //! Perform neighbor search.  The query set will be reordered.
-  void Search(arma::mat&& querySet,
+  void Search(MatType&& querySet,
               const size_t k,
               arma::Mat<size_t>& neighbors,
               arma::mat& distances);
@@ -400,6 +528,27 @@ class NSModel
               arma::Mat<size_t>& neighbors,
               arma::mat& distances);
 
+  /**
+   * Perform neighbor search on a small batch of streaming queries.  Unlike
+   * Search(), this does not build a query tree, does not reorder or take
+   * ownership of the query set, and reuses internal buffers between calls, so
+   * it is suitable for serving workloads where queries arrive in bursts.  The
+   * reference tree built by BuildModel() is reused unchanged.
+   *
+   * The result matrices and the internal projection buffer are only resized
+   * when the batch size changes, so repeated same-sized batches do not
+   * allocate.
+   *
+   * @param querySet Batch of query points (not modified).
+   * @param k Number of neighbors to search for.
+   * @param neighbors Output matrix of neighbor indices.
+   * @param distances Output matrix of neighbor distances.
+   */
+  void SearchBatch(const MatType& querySet,
+                   const size_t k,
+                   arma::Mat<size_t>& neighbors,
+                   arma::mat& distances);
+
   //! Return a string representation of the current tree type.
   std::string TreeName() const;
 };
@@ -30,15 +30,45 @@ void MonoSearchVisitor::operator()(NSType *ns) const
   throw std::runtime_error("no neighbor search model initialized");
 }
 
+//! Perform a batch search in single-tree mode, restoring the previous search
+//! mode afterwards.
+template<typename MatType>
+template<typename NSType>
+void BatchSearchVisitor<MatType>::operator()(NSType* ns) const
+{
+  if (!ns)
+    throw std::runtime_error("no neighbor search model initialized");
+
+  const NeighborSearchMode oldMode = ns->SearchMode();
+
+  // Naive mode needs no tree either way; everything else is served from the
+  // reference tree without building a query tree.
+  if (oldMode != NAIVE_MODE && oldMode != GREEDY_SINGLE_TREE_MODE)
+    ns->SearchMode() = SINGLE_TREE_MODE;
+
+  try
+  {
+    ns->Search(querySet, k, neighbors, distances);
+  }
+  catch (...)
+  {
+    ns->SearchMode() = oldMode;
+    throw;
+  }
+
+  ns->SearchMode() = oldMode;
+}
+
 //! Save parameters for bichromatic neighbor search.
-template<typename SortPolicy>
-BiSearchVisitor<SortPolicy>::BiSearchVisitor(const arma::mat& querySet,
-                                             const size_t k,
-                                             arma::Mat<size_t>& neighbors,
-                                             arma::mat& distances,
-                                             const size_t leafSize,
-                                             const double tau,
-                                             const double rho) :
+template<typename SortPolicy, typename MatType>
+BiSearchVisitor<SortPolicy, MatType>::BiSearchVisitor(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances,
+    const size_t leafSize,
+    const double tau,
+    const double rho) :
     querySet(querySet),
     k(k),
     neighbors(neighbors),
@@ -49,11 +79,12 @@ BiSearchVisitor<SortPolicy>::BiSearchVisitor(const arma::mat& querySet,
 {}
 
 //! Default Bichromatic neighbor search on the given NSType instance.
-template<typename SortPolicy>
+template<typename SortPolicy, typename MatType>
 template<template<typename TreeMetricType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType>
-void BiSearchVisitor<SortPolicy>::operator()(NSTypeT<TreeType>* ns) const
+void BiSearchVisitor<SortPolicy, MatType>::operator()(
+    NSTypeT<TreeType>* ns) const
 {
   if (ns)
     return ns->Search(querySet, k, neighbors, distances);
@@ -61,8 +92,9 @@ void BiSearchVisitor<SortPolicy>::operator()(NSTypeT<TreeType>* ns) const
 }
 
 //! Bichromatic neighbor search on the given NSType specialized for KDTrees.
-template<typename SortPolicy>
-void BiSearchVisitor<SortPolicy>::operator()(NSTypeT<tree::KDTree>* ns) const
+template<typename SortPolicy, typename MatType>
+void BiSearchVisitor<SortPolicy, MatType>::operator()(
+    NSTypeT<tree::KDTree>* ns) const
 {
   if (ns)
     return SearchLeaf(ns);
@@ -70,8 +102,9 @@ void BiSearchVisitor<SortPolicy>::operator()(NSTypeT<tree::KDTree>* ns) const
 }
 
 //! Bichromatic neighbor search on the given NSType specialized for BallTrees.
-template<typename SortPolicy>
-void BiSearchVisitor<SortPolicy>::operator()(NSTypeT<tree::BallTree>* ns) const
+template<typename SortPolicy, typename MatType>
+void BiSearchVisitor<SortPolicy, MatType>::operator()(
+    NSTypeT<tree::BallTree>* ns) const
 {
   if (ns)
     return SearchLeaf(ns);
@@ -79,17 +112,19 @@ void BiSearchVisitor<SortPolicy>::operator()(NSTypeT<tree::BallTree>* ns) const
 }
 
 //! Bichromatic neighbor search specialized for SPTrees.
-template<typename SortPolicy>
-void BiSearchVisitor<SortPolicy>::operator()(SpillKNN* ns) const
+template<typename SortPolicy, typename MatType>
+void BiSearchVisitor<SortPolicy, MatType>::operator()(
+    SpillKNNT<MatType>* ns) const
 {
   if (ns)
   {
-    if (ns->SearchMode() == DUAL_TREE_MODE)
+    if (ns->SearchMode() == DUAL_TREE_MODE ||
+        ns->SearchMode() == HYBRID_DUAL_TREE_MODE)
     {
       // For Dual Tree Search on SpillTrees, the queryTree must be built with
       // non overlapping (tau = 0).
-      typename SpillKNN::Tree queryTree(std::move(querySet), 0 /* tau*/,
-          leafSize, rho);
+      typename SpillKNNT<MatType>::Tree queryTree(std::move(querySet),
+          0 /* tau*/, leafSize, rho);
       ns->Search(queryTree, k, neighbors, distances);
     }
     else
@@ -100,20 +135,42 @@ void BiSearchVisitor<SortPolicy>::operator()(SpillKNN* ns) const
 }
 
 //! Bichromatic neighbor search specialized for octrees.
-template<typename SortPolicy>
-void BiSearchVisitor<SortPolicy>::operator()(NSTypeT<tree::Octree>* ns) const
+template<typename SortPolicy, typename MatType>
+void BiSearchVisitor<SortPolicy, MatType>::operator()(
+    NSTypeT<tree::Octree>* ns) const
 {
   if (ns)
     return SearchLeaf(ns);
   throw std::runtime_error("no neighbor search model initialized");
 }
 
+//! Bichromatic neighbor search on a navigable small-world graph.
+template<typename SortPolicy, typename MatType>
+void BiSearchVisitor<SortPolicy, MatType>::operator()(
+    NSWGraph<SortPolicy, MatType>* ns) const
+{
+  if (ns)
+    return ns->Search(querySet, k, neighbors, distances);
+  throw std::runtime_error("no neighbor search model initialized");
+}
+
+//! Bichromatic neighbor search on a product-quantization index.
+template<typename SortPolicy, typename MatType>
+void BiSearchVisitor<SortPolicy, MatType>::operator()(
+    PQIndex<SortPolicy, MatType>* ns) const
+{
+  if (ns)
+    return ns->Search(querySet, k, neighbors, distances);
+  throw std::runtime_error("no neighbor search model initialized");
+}
+
 //! Bichromatic neighbor search on the given NSType considering the leafSize.
-template<typename SortPolicy>
+template<typename SortPolicy, typename MatType>
 template<typename NSType>
-void BiSearchVisitor<SortPolicy>::SearchLeaf(NSType* ns) const
+void BiSearchVisitor<SortPolicy, MatType>::SearchLeaf(NSType* ns) const
 {
-  if (ns->SearchMode() == DUAL_TREE_MODE)
+  if (ns->SearchMode() == DUAL_TREE_MODE ||
+      ns->SearchMode() == HYBRID_DUAL_TREE_MODE)
   {
     std::vector<size_t> oldFromNewQueries;
     typename NSType::Tree queryTree(std::move(querySet), oldFromNewQueries,
@@ -137,11 +194,11 @@ void BiSearchVisitor<SortPolicy>::SearchLeaf(NSType* ns) const
 }
 
 //! Save parameters for Train.
-template<typename SortPolicy>
-TrainVisitor<SortPolicy>::TrainVisitor(arma::mat&& referenceSet,
-                                       const size_t leafSize,
-                                       const double tau,
-                                       const double rho) :
+template<typename SortPolicy, typename MatType>
+TrainVisitor<SortPolicy, MatType>::TrainVisitor(MatType&& referenceSet,
+                                                const size_t leafSize,
+                                                const double tau,
+                                                const double rho) :
     referenceSet(std::move(referenceSet)),
     leafSize(leafSize),
     tau(tau),
@@ -149,11 +206,11 @@ TrainVisitor<SortPolicy>::TrainVisitor(arma::mat&& referenceSet,
 {}
 
 //! Default Train on the given NSType instance.
-template<typename SortPolicy>
+template<typename SortPolicy, typename MatType>
 template<template<typename TreeMetricType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType>
-void TrainVisitor<SortPolicy>::operator()(NSTypeT<TreeType>* ns) const
+void TrainVisitor<SortPolicy, MatType>::operator()(NSTypeT<TreeType>* ns) const
 {
   if (ns)
     return ns->Train(std::move(referenceSet));
@@ -161,8 +218,9 @@ void TrainVisitor<SortPolicy>::operator()(NSTypeT<TreeType>* ns) const
 }
 
 //! Train on the given NSType specialized for KDTrees.
-template<typename SortPolicy>
-void TrainVisitor<SortPolicy>::operator()(NSTypeT<tree::KDTree>* ns) const
+template<typename SortPolicy, typename MatType>
+void TrainVisitor<SortPolicy, MatType>::operator()(
+    NSTypeT<tree::KDTree>* ns) const
 {
   if (ns)
     return TrainLeaf(ns);
@@ -170,8 +228,9 @@ void TrainVisitor<SortPolicy>::operator()(NSTypeT<tree::KDTree>* ns) const
 }
 
 //! Train on the given NSType specialized for BallTrees.
-template<typename SortPolicy>
-void TrainVisitor<SortPolicy>::operator()(NSTypeT<tree::BallTree>* ns) const
+template<typename SortPolicy, typename MatType>
+void TrainVisitor<SortPolicy, MatType>::operator()(
+    NSTypeT<tree::BallTree>* ns) const
 {
   if (ns)
     return TrainLeaf(ns);
@@ -179,8 +238,8 @@ void TrainVisitor<SortPolicy>::operator()(NSTypeT<tree::BallTree>* ns) const
 }
 
 //! Train specialized for SPTrees.
-template<typename SortPolicy>
-void TrainVisitor<SortPolicy>::operator()(SpillKNN* ns) const
+template<typename SortPolicy, typename MatType>
+void TrainVisitor<SortPolicy, MatType>::operator()(SpillKNNT<MatType>* ns) const
 {
   if (ns)
   {
@@ -188,7 +247,8 @@ void TrainVisitor<SortPolicy>::operator()(SpillKNN* ns) const
       ns->Train(std::move(referenceSet));
     else
     {
-      typename SpillKNN::Tree tree(std::move(referenceSet), tau, leafSize, rho);
+      typename SpillKNNT<MatType>::Tree tree(std::move(referenceSet), tau,
+          leafSize, rho);
       ns->Train(std::move(tree));
     }
   }
@@ -197,18 +257,39 @@ void TrainVisitor<SortPolicy>::operator()(SpillKNN* ns) const
 }
 
 //! Train specialized for Octrees.
-template<typename SortPolicy>
-void TrainVisitor<SortPolicy>::operator()(NSTypeT<tree::Octree>* ns) const
+template<typename SortPolicy, typename MatType>
+void TrainVisitor<SortPolicy, MatType>::operator()(
+    NSTypeT<tree::Octree>* ns) const
 {
   if (ns)
     return TrainLeaf(ns);
   throw std::runtime_error("no neighbor search model initialized");
 }
 
+//! Train on a navigable small-world graph.
+template<typename SortPolicy, typename MatType>
+void TrainVisitor<SortPolicy, MatType>::operator()(
+    NSWGraph<SortPolicy, MatType>* ns) const
+{
+  if (ns)
+    return ns->Train(std::move(referenceSet));
+  throw std::runtime_error("no neighbor search model initialized");
+}
+
+//! Train on a product-quantization index.
+template<typename SortPolicy, typename MatType>
+void TrainVisitor<SortPolicy, MatType>::operator()(
+    PQIndex<SortPolicy, MatType>* ns) const
+{
+  if (ns)
+    return ns->Train(std::move(referenceSet));
+  throw std::runtime_error("no neighbor search model initialized");
+}
+
 //! Train on the given NSType considering the leafSize.
-template<typename SortPolicy>
+template<typename SortPolicy, typename MatType>
 template<typename NSType>
-void TrainVisitor<SortPolicy>::TrainLeaf(NSType* ns) const
+void TrainVisitor<SortPolicy, MatType>::TrainLeaf(NSType* ns) const
 {
   if (ns->SearchMode() == NAIVE_MODE)
     ns->Train(std::move(referenceSet));
@@ -223,6 +304,21 @@ void TrainVisitor<SortPolicy>::TrainLeaf(NSType* ns) const
   }
 }
 
+//! Append the points to the given NSType instance.
+template<typename MatType>
+template<typename NSType>
+void AddPointsVisitor<MatType>::operator()(NSType* ns) const
+{
+  if (ns)
+    return ns->AddPoints(std::move(points));
+  throw std::runtime_error("no neighbor search model initialized");
+}
+
+//! Construct the AddPointsVisitor with the given points.
+template<typename MatType>
+AddPointsVisitor<MatType>::AddPointsVisitor(MatType& points) : points(points)
+{}
+
 //! Return the search mode.
 template<typename NSType>
 NeighborSearchMode& SearchModeVisitor::operator()(NSType* ns) const
@@ -242,8 +338,9 @@ double& EpsilonVisitor::operator()(NSType* ns) const
 }
 
 //! Expose the referenceSet of the given NSType.
+template<typename MatType>
 template<typename NSType>
-const arma::mat& ReferenceSetVisitor::operator()(NSType* ns) const
+const MatType& ReferenceSetVisitor<MatType>::operator()(NSType* ns) const
 {
   if (ns)
     return ns->ReferenceSet();
@@ -262,23 +359,27 @@ void DeleteVisitor::operator()(NSType* ns) const
  * Initialize the NSModel with the given type and whether or not a random
  * basis should be used.
  */
-template<typename SortPolicy>
-NSModel<SortPolicy>::NSModel(TreeTypes treeType, bool randomBasis) :
+template<typename SortPolicy, typename MatType>
+NSModel<SortPolicy, MatType>::NSModel(TreeTypes treeType, bool randomBasis) :
     treeType(treeType),
     leafSize(20),
     tau(0),
     rho(0.7),
+    efSearch(64),
+    numProbes(8),
     randomBasis(randomBasis)
 {
   // Nothing to do.
 }
 
-template<typename SortPolicy>
-NSModel<SortPolicy>::NSModel(const NSModel& other) :
+template<typename SortPolicy, typename MatType>
+NSModel<SortPolicy, MatType>::NSModel(const NSModel& other) :
     treeType(other.treeType),
     leafSize(other.leafSize),
     tau(other.tau),
     rho(other.rho),
+    efSearch(other.efSearch),
+    numProbes(other.numProbes),
     randomBasis(other.randomBasis),
     q(other.q),
     nSearch(other.nSearch)
@@ -286,12 +387,14 @@ NSModel<SortPolicy>::NSModel(const NSModel& other) :
   // Nothing to do.
 }
 
-template<typename SortPolicy>
-NSModel<SortPolicy>::NSModel(NSModel&& other) :
+template<typename SortPolicy, typename MatType>
+NSModel<SortPolicy, MatType>::NSModel(NSModel&& other) :
     treeType(other.treeType),
     leafSize(other.leafSize),
     tau(other.tau),
     rho(other.rho),
+    efSearch(other.efSearch),
+    numProbes(other.numProbes),
     randomBasis(other.randomBasis),
     q(std::move(other.q)),
     nSearch(other.nSearch)
@@ -301,12 +404,15 @@ NSModel<SortPolicy>::NSModel(NSModel&& other) :
   other.leafSize = 20;
   other.tau = 0;
   other.rho = 0.7;
+  other.efSearch = 64;
+  other.numProbes = 8;
   other.randomBasis = false;
   other.nSearch = decltype(other.nSearch)();
 }
 
-template<typename SortPolicy>
-NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(const NSModel& other)
+template<typename SortPolicy, typename MatType>
+NSModel<SortPolicy, MatType>&
+NSModel<SortPolicy, MatType>::operator=(const NSModel& other)
 {
   boost::apply_visitor(DeleteVisitor(), nSearch);
 
@@ -314,6 +420,8 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(const NSModel& other)
   leafSize = other.leafSize;
   tau = other.tau;
   rho = other.rho;
+  efSearch = other.efSearch;
+  numProbes = other.numProbes;
   randomBasis = other.randomBasis;
   q = other.q;
   nSearch = other.nSearch;
@@ -321,8 +429,9 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(const NSModel& other)
   return *this;
 }
 
-template<typename SortPolicy>
-NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(NSModel&& other)
+template<typename SortPolicy, typename MatType>
+NSModel<SortPolicy, MatType>&
+NSModel<SortPolicy, MatType>::operator=(NSModel&& other)
 {
   boost::apply_visitor(DeleteVisitor(), nSearch);
 
@@ -330,6 +439,8 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(NSModel&& other)
   leafSize = other.leafSize;
   tau = other.tau;
   rho = other.rho;
+  efSearch = other.efSearch;
+  numProbes = other.numProbes;
   randomBasis = other.randomBasis;
   q = std::move(other.q);
   // Copy the pointer and type.
@@ -340,6 +451,8 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(NSModel&& other)
   other.leafSize = 20;
   other.tau = 0;
   other.rho = 0.7;
+  other.efSearch = 64;
+  other.numProbes = 8;
   other.randomBasis = false;
   other.nSearch = decltype(other.nSearch)();
 
@@ -347,21 +460,24 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(NSModel&& other)
 }
 
 //! Clean memory, if necessary.
-template<typename SortPolicy>
-NSModel<SortPolicy>::~NSModel()
+template<typename SortPolicy, typename MatType>
+NSModel<SortPolicy, MatType>::~NSModel()
 {
   boost::apply_visitor(DeleteVisitor(), nSearch);
 }
 
 //! Serialize the kNN model.
-template<typename SortPolicy>
+template<typename SortPolicy, typename MatType>
 template<typename Archive>
-void NSModel<SortPolicy>::serialize(Archive& ar, const uint32_t /* version */)
+void NSModel<SortPolicy, MatType>::serialize(Archive& ar,
+                                             const uint32_t /* version */)
 {
   ar(CEREAL_NVP(treeType));
   ar(CEREAL_NVP(leafSize));
   ar(CEREAL_NVP(tau));
   ar(CEREAL_NVP(rho));
+  ar(CEREAL_NVP(efSearch));
+  ar(CEREAL_NVP(numProbes));
   ar(CEREAL_NVP(randomBasis));
   ar(CEREAL_NVP(q));
 
@@ -373,44 +489,45 @@ void NSModel<SortPolicy>::serialize(Archive& ar, const uint32_t /* version */)
 }
 
 //! Expose the dataset.
-template<typename SortPolicy>
-const arma::mat& NSModel<SortPolicy>::Dataset() const
+template<typename SortPolicy, typename MatType>
+const MatType& NSModel<SortPolicy, MatType>::Dataset() const
 {
-  return boost::apply_visitor(ReferenceSetVisitor(), nSearch);
+  return boost::apply_visitor(ReferenceSetVisitor<MatType>(), nSearch);
 }
 
 //! Access the search mode.
-template<typename SortPolicy>
-NeighborSearchMode NSModel<SortPolicy>::SearchMode() const
+template<typename SortPolicy, typename MatType>
+NeighborSearchMode NSModel<SortPolicy, MatType>::SearchMode() const
 {
   return boost::apply_visitor(SearchModeVisitor(), nSearch);
 }
 
 //! Modify the search mode.
-template<typename SortPolicy>
-NeighborSearchMode& NSModel<SortPolicy>::SearchMode()
+template<typename SortPolicy, typename MatType>
+NeighborSearchMode& NSModel<SortPolicy, MatType>::SearchMode()
 {
   return boost::apply_visitor(SearchModeVisitor(), nSearch);
 }
 
-template<typename SortPolicy>
-double NSModel<SortPolicy>::Epsilon() const
+template<typename SortPolicy, typename MatType>
+double NSModel<SortPolicy, MatType>::Epsilon() const
 {
   return boost::apply_visitor(EpsilonVisitor(), nSearch);
 }
 
-template<typename SortPolicy>
-double& NSModel<SortPolicy>::Epsilon()
+template<typename SortPolicy, typename MatType>
+double& NSModel<SortPolicy, MatType>::Epsilon()
 {
   return boost::apply_visitor(EpsilonVisitor(), nSearch);
 }
 
 //! Build the reference tree.
-template<typename SortPolicy>
-void NSModel<SortPolicy>::BuildModel(arma::mat&& referenceSet,
-                                     const size_t leafSize,
-                                     const NeighborSearchMode searchMode,
-                                     const double epsilon)
+template<typename SortPolicy, typename MatType>
+void NSModel<SortPolicy, MatType>::BuildModel(
+    MatType&& referenceSet,
+    const size_t leafSize,
+    const NeighborSearchMode searchMode,
+    const double epsilon)
 {
   this->leafSize = leafSize;
   // Initialize random basis if necessary.
@@ -421,11 +538,11 @@ void NSModel<SortPolicy>::BuildModel(arma::mat&& referenceSet,
     {
       // [Q, R] = qr(randn(d, d));
       // Q = Q * diag(sign(diag(R)));
-      arma::mat r;
-      if (arma::qr(q, r, arma::randn<arma::mat>(referenceSet.n_rows,
+      MatType r;
+      if (arma::qr(q, r, arma::randn<MatType>(referenceSet.n_rows,
               referenceSet.n_rows)))
       {
-        arma::vec rDiag(r.n_rows);
+        arma::Col<typename MatType::elem_type> rDiag(r.n_rows);
         for (size_t i = 0; i < rDiag.n_elem; ++i)
         {
           if (r(i, i) < 0)
@@ -461,55 +578,84 @@ void NSModel<SortPolicy>::BuildModel(arma::mat&& referenceSet,
   switch (treeType)
   {
     case KD_TREE:
-      nSearch = new NSType<SortPolicy, tree::KDTree>(searchMode, epsilon);
+      nSearch = new NSType<SortPolicy, tree::KDTree, MatType>(
+          searchMode, epsilon);
       break;
     case COVER_TREE:
-      nSearch = new NSType<SortPolicy, tree::StandardCoverTree>(searchMode,
-          epsilon);
+      nSearch = new NSType<SortPolicy, tree::StandardCoverTree, MatType>(
+          searchMode, epsilon);
       break;
     case R_TREE:
-      nSearch = new NSType<SortPolicy, tree::RTree>(searchMode, epsilon);
+      nSearch = new NSType<SortPolicy, tree::RTree, MatType>(
+          searchMode, epsilon);
       break;
     case R_STAR_TREE:
-      nSearch = new NSType<SortPolicy, tree::RStarTree>(searchMode, epsilon);
+      nSearch = new NSType<SortPolicy, tree::RStarTree, MatType>(
+          searchMode, epsilon);
       break;
     case BALL_TREE:
-      nSearch = new NSType<SortPolicy, tree::BallTree>(searchMode, epsilon);
+      nSearch = new NSType<SortPolicy, tree::BallTree, MatType>(
+          searchMode, epsilon);
       break;
     case X_TREE:
-      nSearch = new NSType<SortPolicy, tree::XTree>(searchMode, epsilon);
+      nSearch = new NSType<SortPolicy, tree::XTree, MatType>(
+          searchMode, epsilon);
       break;
     case HILBERT_R_TREE:
-      nSearch = new NSType<SortPolicy, tree::HilbertRTree>(searchMode, epsilon);
+      nSearch = new NSType<SortPolicy, tree::HilbertRTree, MatType>(
+          searchMode, epsilon);
       break;
     case R_PLUS_TREE:
-      nSearch = new NSType<SortPolicy, tree::RPlusTree>(searchMode, epsilon);
+      nSearch = new NSType<SortPolicy, tree::RPlusTree, MatType>(
+          searchMode, epsilon);
       break;
     case R_PLUS_PLUS_TREE:
-      nSearch = new NSType<SortPolicy, tree::RPlusPlusTree>(searchMode,
-          epsilon);
+      nSearch = new NSType<SortPolicy, tree::RPlusPlusTree, MatType>(
+          searchMode, epsilon);
       break;
     case VP_TREE:
-      nSearch = new NSType<SortPolicy, tree::VPTree>(searchMode, epsilon);
+      nSearch = new NSType<SortPolicy, tree::VPTree, MatType>(
+          searchMode, epsilon);
       break;
     case RP_TREE:
-      nSearch = new NSType<SortPolicy, tree::RPTree>(searchMode, epsilon);
+      nSearch = new NSType<SortPolicy, tree::RPTree, MatType>(
+          searchMode, epsilon);
       break;
     case MAX_RP_TREE:
-      nSearch = new NSType<SortPolicy, tree::MaxRPTree>(searchMode, epsilon);
+      nSearch = new NSType<SortPolicy, tree::MaxRPTree, MatType>(
+          searchMode, epsilon);
       break;
     case SPILL_TREE:
-      nSearch = new SpillKNN(searchMode, epsilon);
+      nSearch = new SpillKNNT<MatType>(searchMode, epsilon);
       break;
     case UB_TREE:
-      nSearch = new NSType<SortPolicy, tree::UBTree>(searchMode, epsilon);
+      nSearch = new NSType<SortPolicy, tree::UBTree, MatType>(
+          searchMode, epsilon);
       break;
     case OCTREE:
-      nSearch = new NSType<SortPolicy, tree::Octree>(searchMode, epsilon);
+      nSearch = new NSType<SortPolicy, tree::Octree, MatType>(
+          searchMode, epsilon);
       break;
+    case NSW_GRAPH:
+    {
+      NSWGraph<SortPolicy, MatType>* graph =
+          new NSWGraph<SortPolicy, MatType>(searchMode, epsilon);
+      graph->EfSearch() = efSearch;
+      nSearch = graph;
+      break;
+    }
+    case PQ_INDEX:
+    {
+      PQIndex<SortPolicy, MatType>* index =
+          new PQIndex<SortPolicy, MatType>(searchMode, epsilon);
+      index->NumProbes() = numProbes;
+      nSearch = index;
+      break;
+    }
   }
 
-  TrainVisitor<SortPolicy> tn(std::move(referenceSet), leafSize, tau, rho);
+  TrainVisitor<SortPolicy, MatType> tn(std::move(referenceSet), leafSize, tau,
+      rho);
   boost::apply_visitor(tn, nSearch);
 
   if (searchMode != NAIVE_MODE)
@@ -519,12 +665,24 @@ void NSModel<SortPolicy>::BuildModel(arma::mat&& referenceSet,
   }
 }
 
+//! Add new reference points to the model without a full retrain.
+template<typename SortPolicy, typename MatType>
+void NSModel<SortPolicy, MatType>::AddPoints(MatType&& points)
+{
+  // We may need to map the new points with the random basis.
+  if (randomBasis)
+    points = q * points;
+
+  AddPointsVisitor<MatType> add(points);
+  boost::apply_visitor(add, nSearch);
+}
+
 //! Perform neighbor search.  The query set will be reordered.
-template<typename SortPolicy>
-void NSModel<SortPolicy>::Search(arma::mat&& querySet,
-                                 const size_t k,
-                                 arma::Mat<size_t>& neighbors,
-                                 arma::mat& distances)
+template<typename SortPolicy, typename MatType>
+void NSModel<SortPolicy, MatType>::Search(MatType&& querySet,
+                                          const size_t k,
+                                          arma::Mat<size_t>& neighbors,
+                                          arma::mat& distances)
 {
   // We may need to map the query set randomly.
   if (randomBasis)
@@ -547,18 +705,31 @@ void NSModel<SortPolicy>::Search(arma::mat&& querySet,
       Log::Info << "greedy single-tree " << TreeName() << " search..."
           << std::endl;
       break;
+    case HYBRID_DUAL_TREE_MODE:
+      Log::Info << "hybrid greedy + dual-tree " << TreeName() << " search..."
+          << std::endl;
+      break;
   }
 
-  BiSearchVisitor<SortPolicy> search(querySet, k, neighbors, distances,
-      leafSize, tau, rho);
+  // Keep the graph's search beam width in sync with the model parameter, which
+  // may have changed since the model was built.
+  if (treeType == NSW_GRAPH)
+    boost::get<NSWGraph<SortPolicy, MatType>*>(nSearch)->EfSearch() =
+        efSearch;
+  if (treeType == PQ_INDEX)
+    boost::get<PQIndex<SortPolicy, MatType>*>(nSearch)->NumProbes() =
+        numProbes;
+
+  BiSearchVisitor<SortPolicy, MatType> search(querySet, k, neighbors,
+      distances, leafSize, tau, rho);
   boost::apply_visitor(search, nSearch);
 }
 
 //! Perform neighbor search.
-template<typename SortPolicy>
-void NSModel<SortPolicy>::Search(const size_t k,
-                                 arma::Mat<size_t>& neighbors,
-                                 arma::mat& distances)
+template<typename SortPolicy, typename MatType>
+void NSModel<SortPolicy, MatType>::Search(const size_t k,
+                                          arma::Mat<size_t>& neighbors,
+                                          arma::mat& distances)
 {
   Log::Info << "Searching for " << k << " neighbors with ";
 
@@ -577,19 +748,71 @@ void NSModel<SortPolicy>::Search(const size_t k,
       Log::Info << "greedy single-tree " << TreeName() << " search..."
           << std::endl;
       break;
+    case HYBRID_DUAL_TREE_MODE:
+      Log::Info << "hybrid greedy + dual-tree " << TreeName() << " search..."
+          << std::endl;
+      break;
   }
 
   if (Epsilon() != 0 && SearchMode() != NAIVE_MODE)
     Log::Info << "Maximum of " << Epsilon() * 100 << "% relative error."
         << std::endl;
 
+  // Keep the graph's search beam width in sync with the model parameter, which
+  // may have changed since the model was built.
+  if (treeType == NSW_GRAPH)
+    boost::get<NSWGraph<SortPolicy, MatType>*>(nSearch)->EfSearch() =
+        efSearch;
+  if (treeType == PQ_INDEX)
+    boost::get<PQIndex<SortPolicy, MatType>*>(nSearch)->NumProbes() =
+        numProbes;
+
   MonoSearchVisitor search(k, neighbors, distances);
   boost::apply_visitor(search, nSearch);
 }
 
+//! Perform neighbor search on a batch of streaming queries.
+template<typename SortPolicy, typename MatType>
+void NSModel<SortPolicy, MatType>::SearchBatch(const MatType& querySet,
+                                               const size_t k,
+                                               arma::Mat<size_t>& neighbors,
+                                               arma::mat& distances)
+{
+  // Keep the graph's search beam width in sync with the model parameter, which
+  // may have changed since the model was built.
+  if (treeType == NSW_GRAPH)
+    boost::get<NSWGraph<SortPolicy, MatType>*>(nSearch)->EfSearch() =
+        efSearch;
+  if (treeType == PQ_INDEX)
+    boost::get<PQIndex<SortPolicy, MatType>*>(nSearch)->NumProbes() =
+        numProbes;
+
+  // Size the result buffers up front; set_size() is a no-op when the size
+  // already matches, so repeated same-sized batches do not allocate.
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  if (randomBasis)
+  {
+    // Project into the persistent scratch buffer instead of allocating a new
+    // matrix for every batch.
+    batchQueryBuffer.set_size(querySet.n_rows, querySet.n_cols);
+    batchQueryBuffer = q * querySet;
+
+    BatchSearchVisitor<MatType> search(batchQueryBuffer, k, neighbors,
+        distances);
+    boost::apply_visitor(search, nSearch);
+  }
+  else
+  {
+    BatchSearchVisitor<MatType> search(querySet, k, neighbors, distances);
+    boost::apply_visitor(search, nSearch);
+  }
+}
+
 //! Get the name of the tree type.
-template<typename SortPolicy>
-std::string NSModel<SortPolicy>::TreeName() const
+template<typename SortPolicy, typename MatType>
+std::string NSModel<SortPolicy, MatType>::TreeName() const
 {
   switch (treeType)
   {
@@ -623,6 +846,10 @@ std::string NSModel<SortPolicy>::TreeName() const
       return "UB tree";
     case OCTREE:
       return "octree";
+    case NSW_GRAPH:
+      return "navigable small-world graph";
+    case PQ_INDEX:
+      return "product-quantization index";
     default:
       return "unknown tree";
   }
@@ -0,0 +1,232 @@
+/**
+ * @file methods/neighbor_search/nsw_graph.hpp
+ *
+ * Defines the NSWGraph class, a navigable small-world graph index for
+ * approximate nearest neighbor search.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_NSW_GRAPH_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_NSW_GRAPH_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+#include "neighbor_search.hpp"
+#include "sort_policies/nearest_neighbor_sort.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * The NSWGraph class implements approximate nearest neighbor search with a
+ * navigable small-world graph, in the style of the (H)NSW family of indexes.
+ * Each reference point becomes a graph node with at most a fixed number of
+ * proximity edges; queries run a best-first beam search over the graph,
+ * keeping up to EfSearch() candidates alive.  EfSearch() is the recall/time
+ * knob: larger values examine more of the graph and return more accurate
+ * results.
+ *
+ * Unlike the space trees used by NeighborSearch, the graph does not degrade
+ * with dimensionality, which makes it the method of choice for
+ * high-dimensional (hundreds of dimensions) datasets where all tree-based
+ * policies collapse to near-linear scans.  The adjacency lists are stored in
+ * one contiguous matrix with a fixed number of slots per node, so the beam
+ * search walks flat memory rather than per-node allocations.
+ *
+ * The class mirrors the parts of the NeighborSearch interface that NSModel
+ * relies on; the search mode and epsilon parameters are accepted for
+ * interface compatibility but do not affect the graph search, which is always
+ * approximate.  The index is intended for nearest neighbor search; it can be
+ * instantiated with other sort policies but the graph is built on metric
+ * proximity and will not return meaningful furthest-neighbor results.
+ *
+ * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ * @tparam MatType The type of data matrix.
+ * @tparam MetricType The metric to use for computation.
+ */
+template<typename SortPolicy = NearestNeighborSort,
+         typename MatType = arma::mat,
+         typename MetricType = metric::EuclideanDistance>
+class NSWGraph
+{
+ public:
+  //! Convenience typedef.
+  typedef typename MatType::elem_type ElemType;
+
+  /**
+   * Initialize the NSWGraph object.  The graph is empty until Train() is
+   * called.  The search mode and epsilon parameters exist for interface
+   * compatibility with NeighborSearch and are not used by the graph search.
+   *
+   * @param searchMode Accepted and stored, but ignored by the graph search.
+   * @param epsilon Accepted and stored, but ignored by the graph search.
+   */
+  NSWGraph(const NeighborSearchMode searchMode = SINGLE_TREE_MODE,
+           const double epsilon = 0);
+
+  /**
+   * Build the navigable small-world graph on the given reference set.  Points
+   * are inserted one at a time; each insertion runs a beam search of width
+   * EfConstruction() over the current graph and connects the new point to its
+   * nearest discovered neighbors, so the construction parameters must be set
+   * before calling Train().
+   *
+   * @param referenceSet Set of reference points; the set is taken over.
+   */
+  void Train(arma::mat&& referenceSet);
+
+  /**
+   * Add new reference points to an already-built graph.  The graph supports
+   * incremental insertion directly, so this costs one beam search per added
+   * point instead of a full rebuild.  Added points receive indices following
+   * the existing reference points, in insertion order.
+   *
+   * @param points New reference points to add.
+   */
+  void AddPoints(MatType points);
+
+  /**
+   * Search for the approximate k nearest neighbors of every point in the
+   * query set.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *      point.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances);
+
+  /**
+   * Search for the approximate k nearest neighbors of every point in the
+   * reference set, excluding the point itself (monochromatic search).
+   *
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each point.
+   * @param distances Matrix storing distances of neighbors for each point.
+   */
+  void Search(const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances);
+
+  //! Return the reference set.
+  const MatType& ReferenceSet() const { return referenceSet; }
+
+  //! Access the search mode (stored for interface compatibility; the graph
+  //! search ignores it).
+  NeighborSearchMode SearchMode() const { return searchMode; }
+  //! Modify the search mode.
+  NeighborSearchMode& SearchMode() { return searchMode; }
+
+  //! Access the relative error bound (stored for interface compatibility; the
+  //! graph search ignores it).
+  double Epsilon() const { return epsilon; }
+  //! Modify the relative error bound.
+  double& Epsilon() { return epsilon; }
+
+  //! Get the maximum number of edges per node.
+  size_t MaxDegree() const { return maxDegree; }
+  //! Modify the maximum number of edges per node (must be set before Train()).
+  size_t& MaxDegree() { return maxDegree; }
+
+  //! Get the beam width used during construction.
+  size_t EfConstruction() const { return efConstruction; }
+  //! Modify the beam width used during construction (must be set before
+  //! Train()).
+  size_t& EfConstruction() { return efConstruction; }
+
+  //! Get the beam width used during search (the recall/time tradeoff knob).
+  size_t EfSearch() const { return efSearch; }
+  //! Modify the beam width used during search.
+  size_t& EfSearch() { return efSearch; }
+
+  //! Serialize the graph index.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! A (distance, node index) pair used in the candidate and result queues.
+  typedef std::pair<ElemType, size_t> Candidate;
+
+  /**
+   * Run a best-first beam search over the graph, returning up to ef
+   * candidates sorted by ascending distance.  The visited buffer and stamp
+   * implement O(1) clearing between queries: a node counts as visited if its
+   * entry equals the current stamp.
+   *
+   * @param query The query point.
+   * @param ef Beam width; at most ef candidates are returned.
+   * @param visited Scratch buffer of one stamp per reference point.
+   * @param stamp Stamp identifying the current query.
+   * @param results Output vector of (distance, index) candidates, sorted by
+   *      ascending distance.
+   */
+  template<typename VecType>
+  void BeamSearch(const VecType& query,
+                  const size_t ef,
+                  std::vector<size_t>& visited,
+                  const size_t stamp,
+                  std::vector<Candidate>& results);
+
+  /**
+   * Insert the given reference point into the graph, connecting it to its
+   * nearest neighbors found by a beam search over the current graph.
+   *
+   * @param index Index of the reference point to insert.
+   * @param visited Scratch buffer of one stamp per reference point.
+   * @param stamp Stamp identifying the insertion query.
+   */
+  void InsertPoint(const size_t index,
+                   std::vector<size_t>& visited,
+                   const size_t stamp);
+
+  /**
+   * Add a directed edge from node 'from' to node 'to'.  If 'from' already has
+   * the maximum number of edges, its farthest neighbor is replaced, but (when
+   * 'force' is false) only if the new edge is shorter.
+   */
+  void AddEdge(const size_t from,
+               const size_t to,
+               const ElemType distance,
+               const bool force = false);
+
+  //! The metric used for distance computation.
+  MetricType metric;
+  //! The reference set.
+  MatType referenceSet;
+
+  //! Maximum number of edges per node.
+  size_t maxDegree;
+  //! Beam width during construction.
+  size_t efConstruction;
+  //! Beam width during search; the recall/time tradeoff knob.
+  size_t efSearch;
+
+  //! The search mode (unused; kept for interface compatibility).
+  NeighborSearchMode searchMode;
+  //! The relative error bound (unused; kept for interface compatibility).
+  double epsilon;
+
+  //! The node the beam search starts from.
+  size_t entryPoint;
+  //! Adjacency lists of all nodes in one contiguous matrix; column i holds
+  //! the neighbor indices of node i, of which only the first degrees[i]
+  //! entries are valid.
+  arma::Mat<arma::uword> adjacency;
+  //! The number of valid edges of each node.
+  arma::Col<arma::uword> degrees;
+};  // class NSWGraph
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "nsw_graph_impl.hpp"
+
+#endif
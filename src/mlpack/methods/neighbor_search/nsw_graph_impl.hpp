@@ -0,0 +1,343 @@
+/**
+ * @file methods/neighbor_search/nsw_graph_impl.hpp
+ *
+ * Implementation of the NSWGraph class, a navigable small-world graph index
+ * for approximate nearest neighbor search.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_NSW_GRAPH_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_NSW_GRAPH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "nsw_graph.hpp"
+
+#include <queue>
+
+namespace mlpack {
+namespace neighbor {
+
+template<typename SortPolicy, typename MatType, typename MetricType>
+NSWGraph<SortPolicy, MatType, MetricType>::NSWGraph(
+    const NeighborSearchMode searchMode,
+    const double epsilon) :
+    maxDegree(32),
+    efConstruction(200),
+    efSearch(64),
+    searchMode(searchMode),
+    epsilon(epsilon),
+    entryPoint(0)
+{
+  if (epsilon < 0)
+    throw std::invalid_argument("epsilon must be non-negative");
+}
+
+template<typename SortPolicy, typename MatType, typename MetricType>
+void NSWGraph<SortPolicy, MatType, MetricType>::Train(
+    arma::mat&& referenceSet)
+{
+  this->referenceSet = std::move(referenceSet);
+  const size_t numPoints = this->referenceSet.n_cols;
+
+  adjacency.set_size(maxDegree, numPoints);
+  degrees.zeros(numPoints);
+  entryPoint = 0;
+
+  if (numPoints == 0)
+    return;
+
+  // Insert the points one at a time; each insertion searches the graph built
+  // so far for the new point's neighbors.  The stamp i is unique per
+  // insertion, so the visited buffer never has to be cleared.
+  std::vector<size_t> visited(numPoints, 0);
+  for (size_t i = 1; i < numPoints; ++i)
+    InsertPoint(i, visited, i);
+}
+
+template<typename SortPolicy, typename MatType, typename MetricType>
+void NSWGraph<SortPolicy, MatType, MetricType>::AddPoints(MatType points)
+{
+  if (points.n_cols == 0)
+    return;
+
+  // If there is no graph yet, this is just training.
+  if (referenceSet.n_cols == 0)
+    return Train(std::move(points));
+
+  if (points.n_rows != referenceSet.n_rows)
+    throw std::invalid_argument("added points must have the same "
+        "dimensionality as the reference set");
+
+  const size_t oldSize = referenceSet.n_cols;
+  const size_t newSize = oldSize + points.n_cols;
+
+  // Grow the dataset and the adjacency storage; existing columns (and edges)
+  // are kept, and the new degree entries are zero-filled.
+  referenceSet.insert_cols(oldSize, points);
+  adjacency.resize(maxDegree, newSize);
+  degrees.resize(newSize);
+
+  // Insert the new points one at a time, exactly as Train() does.
+  std::vector<size_t> visited(newSize, 0);
+  for (size_t i = oldSize; i < newSize; ++i)
+    InsertPoint(i, visited, i - oldSize + 1);
+}
+
+template<typename SortPolicy, typename MatType, typename MetricType>
+void NSWGraph<SortPolicy, MatType, MetricType>::Search(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances)
+{
+  if (k > referenceSet.n_cols)
+  {
+    std::stringstream ss;
+    ss << "requested value of k (" << k << ") is greater than the number of "
+        << "points in the reference set (" << referenceSet.n_cols << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  Timer::Start("computing_neighbors");
+
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  // The beam must be at least wide enough to hold the requested neighbors.
+  const size_t ef = std::max(efSearch, k);
+
+  #pragma omp parallel
+  {
+    // Per-thread scratch; the visited stamps are invalidated by bumping the
+    // stamp, so repeated queries never clear the buffer.
+    std::vector<size_t> visited(referenceSet.n_cols, 0);
+    std::vector<Candidate> results;
+    size_t stamp = 0;
+
+    #pragma omp for
+    for (omp_size_t i = 0; i < querySet.n_cols; ++i)
+    {
+      BeamSearch(querySet.col(i), ef, visited, ++stamp, results);
+
+      for (size_t j = 0; j < k; ++j)
+      {
+        if (j < results.size())
+        {
+          neighbors(j, i) = results[j].second;
+          distances(j, i) = results[j].first;
+        }
+        else
+        {
+          // The beam search could not reach k points (disconnected graph).
+          neighbors(j, i) = referenceSet.n_cols;
+          distances(j, i) = SortPolicy::WorstDistance();
+        }
+      }
+    }
+  }
+
+  Timer::Stop("computing_neighbors");
+}
+
+template<typename SortPolicy, typename MatType, typename MetricType>
+void NSWGraph<SortPolicy, MatType, MetricType>::Search(
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances)
+{
+  if (k >= referenceSet.n_cols)
+  {
+    std::stringstream ss;
+    ss << "requested value of k (" << k << ") is greater than or equal to the "
+        << "number of points in the reference set (" << referenceSet.n_cols
+        << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  Timer::Start("computing_neighbors");
+
+  neighbors.set_size(k, referenceSet.n_cols);
+  distances.set_size(k, referenceSet.n_cols);
+
+  // One extra candidate, since the query point itself will be found.
+  const size_t ef = std::max(efSearch, k + 1);
+
+  #pragma omp parallel
+  {
+    std::vector<size_t> visited(referenceSet.n_cols, 0);
+    std::vector<Candidate> results;
+    size_t stamp = 0;
+
+    #pragma omp for
+    for (omp_size_t i = 0; i < referenceSet.n_cols; ++i)
+    {
+      BeamSearch(referenceSet.col(i), ef, visited, ++stamp, results);
+
+      size_t resultIndex = 0;
+      for (size_t j = 0; j < k; ++j)
+      {
+        // Skip the query point itself.
+        if (resultIndex < results.size() &&
+            results[resultIndex].second == (size_t) i)
+          ++resultIndex;
+
+        if (resultIndex < results.size())
+        {
+          neighbors(j, i) = results[resultIndex].second;
+          distances(j, i) = results[resultIndex].first;
+          ++resultIndex;
+        }
+        else
+        {
+          neighbors(j, i) = referenceSet.n_cols;
+          distances(j, i) = SortPolicy::WorstDistance();
+        }
+      }
+    }
+  }
+
+  Timer::Stop("computing_neighbors");
+}
+
+template<typename SortPolicy, typename MatType, typename MetricType>
+template<typename VecType>
+void NSWGraph<SortPolicy, MatType, MetricType>::BeamSearch(
+    const VecType& query,
+    const size_t ef,
+    std::vector<size_t>& visited,
+    const size_t stamp,
+    std::vector<Candidate>& results)
+{
+  results.clear();
+  if (referenceSet.n_cols == 0)
+    return;
+
+  // The frontier is a min-heap of candidates to expand; best is a max-heap of
+  // the ef closest points found so far, so its top is the current worst
+  // result.
+  std::priority_queue<Candidate, std::vector<Candidate>,
+      std::greater<Candidate>> frontier;
+  std::priority_queue<Candidate> best;
+
+  const ElemType entryDistance = metric.Evaluate(query,
+      referenceSet.col(entryPoint));
+  frontier.push(std::make_pair(entryDistance, entryPoint));
+  best.push(std::make_pair(entryDistance, entryPoint));
+  visited[entryPoint] = stamp;
+
+  while (!frontier.empty())
+  {
+    const Candidate current = frontier.top();
+    frontier.pop();
+
+    // The search has converged once the closest unexpanded candidate is
+    // farther away than the worst member of a full result set.
+    if (best.size() >= ef && current.first > best.top().first)
+      break;
+
+    const arma::uword* nodeNeighbors = adjacency.colptr(current.second);
+    const size_t degree = degrees[current.second];
+    for (size_t j = 0; j < degree; ++j)
+    {
+      const size_t neighbor = nodeNeighbors[j];
+      if (visited[neighbor] == stamp)
+        continue;
+      visited[neighbor] = stamp;
+
+      const ElemType distance = metric.Evaluate(query,
+          referenceSet.col(neighbor));
+      if (best.size() < ef || distance < best.top().first)
+      {
+        frontier.push(std::make_pair(distance, neighbor));
+        best.push(std::make_pair(distance, neighbor));
+        if (best.size() > ef)
+          best.pop();
+      }
+    }
+  }
+
+  // Empty the result heap into a vector sorted by ascending distance.
+  results.resize(best.size());
+  for (size_t j = results.size(); j > 0; --j)
+  {
+    results[j - 1] = best.top();
+    best.pop();
+  }
+}
+
+template<typename SortPolicy, typename MatType, typename MetricType>
+void NSWGraph<SortPolicy, MatType, MetricType>::InsertPoint(
+    const size_t index,
+    std::vector<size_t>& visited,
+    const size_t stamp)
+{
+  std::vector<Candidate> results;
+  BeamSearch(referenceSet.col(index), efConstruction, visited, stamp, results);
+
+  // Connect the new point to its closest discovered neighbors, with
+  // reciprocal edges.  The reciprocal edge to the closest neighbor is forced,
+  // so that every node keeps at least one inbound edge and stays reachable.
+  const size_t numEdges = std::min(maxDegree, results.size());
+  for (size_t j = 0; j < numEdges; ++j)
+  {
+    AddEdge(index, results[j].second, results[j].first);
+    AddEdge(results[j].second, index, results[j].first, j == 0);
+  }
+}
+
+template<typename SortPolicy, typename MatType, typename MetricType>
+void NSWGraph<SortPolicy, MatType, MetricType>::AddEdge(
+    const size_t from,
+    const size_t to,
+    const ElemType distance,
+    const bool force)
+{
+  arma::uword* nodeNeighbors = adjacency.colptr(from);
+  if (degrees[from] < maxDegree)
+  {
+    nodeNeighbors[degrees[from]++] = to;
+    return;
+  }
+
+  // The node is full: replace its farthest current neighbor, but (unless the
+  // edge is forced) only if the new edge is shorter.
+  size_t worstSlot = 0;
+  ElemType worstDistance = -1;
+  for (size_t j = 0; j < maxDegree; ++j)
+  {
+    const ElemType d = metric.Evaluate(referenceSet.col(from),
+        referenceSet.col(nodeNeighbors[j]));
+    if (d > worstDistance)
+    {
+      worstDistance = d;
+      worstSlot = j;
+    }
+  }
+
+  if (force || distance < worstDistance)
+    nodeNeighbors[worstSlot] = to;
+}
+
+template<typename SortPolicy, typename MatType, typename MetricType>
+template<typename Archive>
+void NSWGraph<SortPolicy, MatType, MetricType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(referenceSet));
+  ar(CEREAL_NVP(maxDegree));
+  ar(CEREAL_NVP(efConstruction));
+  ar(CEREAL_NVP(efSearch));
+  ar(CEREAL_NVP(searchMode));
+  ar(CEREAL_NVP(epsilon));
+  ar(CEREAL_NVP(entryPoint));
+  ar(CEREAL_NVP(adjacency));
+  ar(CEREAL_NVP(degrees));
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,242 @@
+/**
+ * @file methods/neighbor_search/pq_index.hpp
+ *
+ * Defines the PQIndex class, an inverted-file product-quantization (IVF-PQ)
+ * index for approximate nearest neighbor search in compressed domain.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_PQ_INDEX_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_PQ_INDEX_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+#include "neighbor_search.hpp"
+#include "sort_policies/nearest_neighbor_sort.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * The PQIndex class implements approximate nearest neighbor search with an
+ * inverted file of product-quantized codes (IVF-PQ).  A coarse k-means
+ * quantizer partitions the reference set into inverted lists; within the
+ * lists, every point is compressed to one byte per subspace by quantizing
+ * each of NumSubspaces() contiguous blocks of dimensions against its own
+ * k-means codebook.  A query probes the NumProbes() nearest inverted lists
+ * and scans their codes with asymmetric distance computation: the squared
+ * distance from the query to every codeword of every subspace is tabulated
+ * once, after which each candidate costs only NumSubspaces() table lookups
+ * and additions.  NumProbes() is the recall/time knob.
+ *
+ * With the default parameters each point is stored in 8 bytes regardless of
+ * its dimensionality, so indexes over datasets that do not fit in memory in
+ * float form can be scanned entirely from RAM.  The distances returned are
+ * approximations computed from the codes, not exact distances.
+ *
+ * The per-subspace distance decomposition is only valid for the Euclidean
+ * metric; the class mirrors the parts of the NeighborSearch interface that
+ * NSModel relies on, and like NSWGraph it accepts the search mode and
+ * epsilon parameters for interface compatibility without using them.  The
+ * index is intended for nearest neighbor search; furthest-neighbor sort
+ * policies will not return meaningful results.
+ *
+ * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ * @tparam MatType The type of data matrix.
+ */
+template<typename SortPolicy = NearestNeighborSort,
+         typename MatType = arma::mat>
+class PQIndex
+{
+ public:
+  //! Convenience typedef.
+  typedef typename MatType::elem_type ElemType;
+
+  /**
+   * Initialize the PQIndex object.  The index is empty until Train() is
+   * called.  The search mode and epsilon parameters exist for interface
+   * compatibility with NeighborSearch and are not used by the index.
+   *
+   * @param searchMode Accepted and stored, but ignored by the index.
+   * @param epsilon Accepted and stored, but ignored by the index.
+   */
+  PQIndex(const NeighborSearchMode searchMode = SINGLE_TREE_MODE,
+          const double epsilon = 0);
+
+  /**
+   * Build the index on the given reference set: cluster the points into
+   * NumLists() inverted lists with k-means, then learn one codebook of
+   * CodebookSize() codewords per subspace and encode every point.  The
+   * quantization parameters must be set before calling Train(), and the
+   * dimensionality of the data must be divisible by NumSubspaces().
+   *
+   * @param referenceSet Set of reference points; the set is taken over.
+   */
+  void Train(MatType referenceSet);
+
+  /**
+   * Add new reference points to an already-built index.  The points are
+   * encoded with the existing coarse quantizer and codebooks and appended to
+   * the inverted lists; no retraining takes place, so the codebooks slowly
+   * go stale if the distribution of added points drifts.  Added points
+   * receive indices following the existing reference points, in insertion
+   * order.
+   *
+   * @param points New reference points to add.
+   */
+  void AddPoints(MatType points);
+
+  /**
+   * Search for the approximate k nearest neighbors of every point in the
+   * query set.  If the probed lists hold fewer than k points, further lists
+   * are probed in order of coarse distance until k candidates are found.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *      point.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances);
+
+  /**
+   * Search for the approximate k nearest neighbors of every point in the
+   * reference set, excluding the point itself (monochromatic search).
+   *
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each point.
+   * @param distances Matrix storing distances of neighbors for each point.
+   */
+  void Search(const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances);
+
+  //! Return the reference set.
+  const MatType& ReferenceSet() const { return referenceSet; }
+
+  //! Access the search mode (stored for interface compatibility; the index
+  //! ignores it).
+  NeighborSearchMode SearchMode() const { return searchMode; }
+  //! Modify the search mode.
+  NeighborSearchMode& SearchMode() { return searchMode; }
+
+  //! Access the relative error bound (stored for interface compatibility;
+  //! the index ignores it).
+  double Epsilon() const { return epsilon; }
+  //! Modify the relative error bound.
+  double& Epsilon() { return epsilon; }
+
+  //! Get the number of inverted lists of the coarse quantizer.
+  size_t NumLists() const { return numLists; }
+  //! Modify the number of inverted lists (must be set before Train()).
+  size_t& NumLists() { return numLists; }
+
+  //! Get the number of inverted lists probed per query (the recall/time
+  //! tradeoff knob).
+  size_t NumProbes() const { return numProbes; }
+  //! Modify the number of inverted lists probed per query.
+  size_t& NumProbes() { return numProbes; }
+
+  //! Get the number of product-quantization subspaces.
+  size_t NumSubspaces() const { return numSubspaces; }
+  //! Modify the number of subspaces (must be set before Train(); the data
+  //! dimensionality must be divisible by it).
+  size_t& NumSubspaces() { return numSubspaces; }
+
+  //! Get the number of codewords per subspace codebook.
+  size_t CodebookSize() const { return codebookSize; }
+  //! Modify the number of codewords per subspace codebook (must be set
+  //! before Train(); at most 256, since codes are stored in one byte).
+  size_t& CodebookSize() { return codebookSize; }
+
+  //! Serialize the index.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  /**
+   * Encode the given points against the trained coarse quantizer and
+   * codebooks, writing one coarse assignment and one code column per point.
+   *
+   * @param points Points to encode.
+   * @param assignments Output vector of coarse list assignments.
+   * @param pointCodes Output matrix of product-quantization codes.
+   */
+  void Encode(const MatType& points,
+              arma::Row<size_t>& assignments,
+              arma::Mat<arma::u8>& pointCodes) const;
+
+  /**
+   * Rebuild the contiguous inverted-list arrays (listOffsets/listMembers)
+   * from per-point coarse assignments; indices [0, count) are assigned.
+   *
+   * @param assignments Coarse list assignment of every point.
+   */
+  void BuildLists(const arma::Row<size_t>& assignments);
+
+  /**
+   * Answer a single query with an asymmetric-distance scan of the probed
+   * inverted lists, writing the k best candidates into the given output
+   * column.
+   *
+   * @param query The query point.
+   * @param k Number of neighbors to search for.
+   * @param selfIndex Reference index to skip (for monochromatic search);
+   *      pass the number of reference points to skip nothing.
+   * @param queryIndex Output column to write.
+   * @param neighbors Output matrix of neighbor indices.
+   * @param distances Output matrix of neighbor distances.
+   */
+  template<typename VecType>
+  void SearchQuery(const VecType& query,
+                   const size_t k,
+                   const size_t selfIndex,
+                   const size_t queryIndex,
+                   arma::Mat<size_t>& neighbors,
+                   arma::mat& distances) const;
+
+  //! The reference set.
+  MatType referenceSet;
+
+  //! Number of inverted lists of the coarse quantizer.
+  size_t numLists;
+  //! Number of inverted lists probed per query; the recall/time knob.
+  size_t numProbes;
+  //! Number of product-quantization subspaces.
+  size_t numSubspaces;
+  //! Number of codewords per subspace codebook (at most 256).
+  size_t codebookSize;
+
+  //! The search mode (unused; kept for interface compatibility).
+  NeighborSearchMode searchMode;
+  //! The relative error bound (unused; kept for interface compatibility).
+  double epsilon;
+
+  //! Centroids of the coarse quantizer (one column per inverted list).
+  arma::mat coarseCentroids;
+  //! Start offset of each inverted list in listMembers; numLists + 1
+  //! entries, so list l spans [listOffsets[l], listOffsets[l + 1]).
+  arma::Col<arma::uword> listOffsets;
+  //! Reference point indices of all inverted lists, stored contiguously.
+  arma::Col<arma::uword> listMembers;
+  //! Per-subspace codebooks; slice s holds the codewords of subspace s, one
+  //! codeword per column.
+  arma::cube codebooks;
+  //! Product-quantization codes; column i holds the one-byte-per-subspace
+  //! encoding of reference point i.
+  arma::Mat<arma::u8> codes;
+};  // class PQIndex
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "pq_index_impl.hpp"
+
+#endif
@@ -0,0 +1,365 @@
+/**
+ * @file methods/neighbor_search/pq_index_impl.hpp
+ *
+ * Implementation of the PQIndex class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_PQ_INDEX_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_PQ_INDEX_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "pq_index.hpp"
+
+#include <mlpack/methods/kmeans/kmeans.hpp>
+
+namespace mlpack {
+namespace neighbor {
+
+template<typename SortPolicy, typename MatType>
+PQIndex<SortPolicy, MatType>::PQIndex(
+    const NeighborSearchMode searchMode,
+    const double epsilon) :
+    numLists(64),
+    numProbes(8),
+    numSubspaces(8),
+    codebookSize(256),
+    searchMode(searchMode),
+    epsilon(epsilon)
+{
+  // Nothing to do.
+}
+
+template<typename SortPolicy, typename MatType>
+void PQIndex<SortPolicy, MatType>::Train(MatType referenceSet)
+{
+  this->referenceSet = std::move(referenceSet);
+
+  if (this->referenceSet.n_cols == 0)
+    return;
+
+  if (codebookSize > 256)
+  {
+    throw std::invalid_argument("PQIndex::Train(): codebook size must be at "
+        "most 256, since codes are stored in one byte per subspace");
+  }
+  if (this->referenceSet.n_rows % numSubspaces != 0)
+  {
+    std::ostringstream oss;
+    oss << "PQIndex::Train(): dimensionality ("
+        << this->referenceSet.n_rows << ") is not divisible by the number of "
+        << "subspaces (" << numSubspaces << ")";
+    throw std::invalid_argument(oss.str());
+  }
+
+  Timer::Start("pq_index_building");
+
+  const size_t n = this->referenceSet.n_cols;
+  const size_t subDim = this->referenceSet.n_rows / numSubspaces;
+
+  // Neither quantizer can have more centroids than there are points.
+  numLists = std::min(numLists, n);
+  codebookSize = std::min(codebookSize, n);
+
+  kmeans::KMeans<> kmeans;
+
+  // Learn the coarse quantizer and assign every point to an inverted list.
+  arma::Row<size_t> assignments;
+  kmeans.Cluster(this->referenceSet, numLists, assignments, coarseCentroids);
+  BuildLists(assignments);
+
+  // Learn one codebook per subspace and encode every point.
+  codebooks.set_size(subDim, codebookSize, numSubspaces);
+  codes.set_size(numSubspaces, n);
+  for (size_t s = 0; s < numSubspaces; ++s)
+  {
+    const arma::mat subData = arma::conv_to<arma::mat>::from(
+        this->referenceSet.rows(s * subDim, (s + 1) * subDim - 1));
+
+    arma::Row<size_t> subAssignments;
+    arma::mat centroids;
+    kmeans.Cluster(subData, codebookSize, subAssignments, centroids);
+
+    codebooks.slice(s) = centroids;
+    for (size_t i = 0; i < n; ++i)
+      codes(s, i) = (arma::u8) subAssignments[i];
+  }
+
+  Timer::Stop("pq_index_building");
+}
+
+template<typename SortPolicy, typename MatType>
+void PQIndex<SortPolicy, MatType>::AddPoints(MatType points)
+{
+  // If the index has not been built yet, this is just a Train() call.
+  if (referenceSet.n_cols == 0)
+    return Train(std::move(points));
+
+  if (points.n_rows != referenceSet.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "PQIndex::AddPoints(): added points have dimensionality "
+        << points.n_rows << " but the reference set has dimensionality "
+        << referenceSet.n_rows;
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Encode the new points with the existing quantizers.
+  arma::Row<size_t> newAssignments;
+  arma::Mat<arma::u8> newCodes;
+  Encode(points, newAssignments, newCodes);
+
+  // Recover the coarse assignment of every existing point from the inverted
+  // lists, then rebuild the lists over the extended set.
+  const size_t oldSize = referenceSet.n_cols;
+  arma::Row<size_t> assignments(oldSize + points.n_cols);
+  for (size_t l = 0; l < numLists; ++l)
+    for (size_t m = listOffsets[l]; m < listOffsets[l + 1]; ++m)
+      assignments[listMembers[m]] = l;
+  for (size_t j = 0; j < points.n_cols; ++j)
+    assignments[oldSize + j] = newAssignments[j];
+
+  referenceSet.insert_cols(oldSize, points);
+  codes.insert_cols(oldSize, newCodes);
+  BuildLists(assignments);
+}
+
+template<typename SortPolicy, typename MatType>
+void PQIndex<SortPolicy, MatType>::Encode(
+    const MatType& points,
+    arma::Row<size_t>& assignments,
+    arma::Mat<arma::u8>& pointCodes) const
+{
+  const size_t subDim = referenceSet.n_rows / numSubspaces;
+
+  assignments.set_size(points.n_cols);
+  pointCodes.set_size(numSubspaces, points.n_cols);
+
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    // Nearest coarse centroid.
+    size_t bestList = 0;
+    double bestDistance = metric::SquaredEuclideanDistance::Evaluate(
+        points.col(i), coarseCentroids.col(0));
+    for (size_t l = 1; l < numLists; ++l)
+    {
+      const double distance = metric::SquaredEuclideanDistance::Evaluate(
+          points.col(i), coarseCentroids.col(l));
+      if (distance < bestDistance)
+      {
+        bestList = l;
+        bestDistance = distance;
+      }
+    }
+    assignments[i] = bestList;
+
+    // Nearest codeword in every subspace.
+    for (size_t s = 0; s < numSubspaces; ++s)
+    {
+      const arma::vec subPoint = arma::conv_to<arma::vec>::from(
+          points.col(i).rows(s * subDim, (s + 1) * subDim - 1));
+
+      size_t bestCode = 0;
+      double bestCodeDistance = metric::SquaredEuclideanDistance::Evaluate(
+          subPoint, codebooks.slice(s).col(0));
+      for (size_t c = 1; c < codebookSize; ++c)
+      {
+        const double distance = metric::SquaredEuclideanDistance::Evaluate(
+            subPoint, codebooks.slice(s).col(c));
+        if (distance < bestCodeDistance)
+        {
+          bestCode = c;
+          bestCodeDistance = distance;
+        }
+      }
+      pointCodes(s, i) = (arma::u8) bestCode;
+    }
+  }
+}
+
+template<typename SortPolicy, typename MatType>
+void PQIndex<SortPolicy, MatType>::BuildLists(
+    const arma::Row<size_t>& assignments)
+{
+  listOffsets.zeros(numLists + 1);
+  for (size_t i = 0; i < assignments.n_elem; ++i)
+    ++listOffsets[assignments[i] + 1];
+  for (size_t l = 0; l < numLists; ++l)
+    listOffsets[l + 1] += listOffsets[l];
+
+  // Fill the members using a cursor per list.
+  arma::Col<arma::uword> cursors(listOffsets.memptr(), numLists);
+  listMembers.set_size(assignments.n_elem);
+  for (size_t i = 0; i < assignments.n_elem; ++i)
+    listMembers[cursors[assignments[i]]++] = i;
+}
+
+template<typename SortPolicy, typename MatType>
+void PQIndex<SortPolicy, MatType>::Search(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances)
+{
+  if (k > referenceSet.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "PQIndex::Search(): requested value of k (" << k << ") is greater "
+        << "than the number of points in the reference set ("
+        << referenceSet.n_cols << ")";
+    throw std::invalid_argument(oss.str());
+  }
+
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  Timer::Start("computing_neighbors");
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+  {
+    SearchQuery(querySet.col(i), k, referenceSet.n_cols, (size_t) i,
+        neighbors, distances);
+  }
+
+  Timer::Stop("computing_neighbors");
+}
+
+template<typename SortPolicy, typename MatType>
+void PQIndex<SortPolicy, MatType>::Search(
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances)
+{
+  if (k >= referenceSet.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "PQIndex::Search(): requested value of k (" << k << ") is greater "
+        << "than or equal to the number of points in the reference set ("
+        << referenceSet.n_cols << ")";
+    throw std::invalid_argument(oss.str());
+  }
+
+  neighbors.set_size(k, referenceSet.n_cols);
+  distances.set_size(k, referenceSet.n_cols);
+
+  Timer::Start("computing_neighbors");
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) referenceSet.n_cols; ++i)
+  {
+    // Pass the query's own index so that it is skipped during the scan.
+    SearchQuery(referenceSet.col(i), k, (size_t) i, (size_t) i, neighbors,
+        distances);
+  }
+
+  Timer::Stop("computing_neighbors");
+}
+
+template<typename SortPolicy, typename MatType>
+template<typename VecType>
+void PQIndex<SortPolicy, MatType>::SearchQuery(
+    const VecType& query,
+    const size_t k,
+    const size_t selfIndex,
+    const size_t queryIndex,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances) const
+{
+  const size_t subDim = referenceSet.n_rows / numSubspaces;
+
+  // Order the inverted lists by the distance from the query to their
+  // centroids.
+  arma::vec coarseDistances(numLists);
+  for (size_t l = 0; l < numLists; ++l)
+  {
+    coarseDistances[l] = metric::SquaredEuclideanDistance::Evaluate(
+        query, coarseCentroids.col(l));
+  }
+  const arma::uvec probeOrder = arma::sort_index(coarseDistances);
+
+  // Tabulate the squared distance from the query to every codeword of every
+  // subspace; after this, each candidate costs numSubspaces lookups.
+  arma::mat table(codebookSize, numSubspaces);
+  for (size_t s = 0; s < numSubspaces; ++s)
+  {
+    const arma::vec subQuery = arma::conv_to<arma::vec>::from(
+        query.rows(s * subDim, (s + 1) * subDim - 1));
+    for (size_t c = 0; c < codebookSize; ++c)
+    {
+      table(c, s) = metric::SquaredEuclideanDistance::Evaluate(
+          subQuery, codebooks.slice(s).col(c));
+    }
+  }
+
+  // Scan the probed lists, keeping a sorted list of the k best candidates
+  // (in the squared-distance domain).  If the probed lists hold fewer than k
+  // candidates, keep probing further lists.
+  std::vector<double> bestDistances(k, SortPolicy::WorstDistance());
+  std::vector<size_t> bestNeighbors(k, referenceSet.n_cols);
+  size_t found = 0;
+  for (size_t p = 0; p < numLists; ++p)
+  {
+    if (p >= numProbes && found >= k)
+      break;
+
+    const size_t l = probeOrder[p];
+    for (size_t m = listOffsets[l]; m < listOffsets[l + 1]; ++m)
+    {
+      const size_t index = listMembers[m];
+      if (index == selfIndex)
+        continue;
+
+      double distance = 0.0;
+      for (size_t s = 0; s < numSubspaces; ++s)
+        distance += table(codes(s, index), s);
+      ++found;
+
+      if (!SortPolicy::IsBetter(distance, bestDistances[k - 1]))
+        continue;
+
+      size_t pos = k - 1;
+      while (pos > 0 && SortPolicy::IsBetter(distance, bestDistances[pos - 1]))
+      {
+        bestDistances[pos] = bestDistances[pos - 1];
+        bestNeighbors[pos] = bestNeighbors[pos - 1];
+        --pos;
+      }
+      bestDistances[pos] = distance;
+      bestNeighbors[pos] = index;
+    }
+  }
+
+  for (size_t j = 0; j < k; ++j)
+  {
+    neighbors(j, queryIndex) = bestNeighbors[j];
+    distances(j, queryIndex) = std::sqrt(bestDistances[j]);
+  }
+}
+
+template<typename SortPolicy, typename MatType>
+template<typename Archive>
+void PQIndex<SortPolicy, MatType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(numLists));
+  ar(CEREAL_NVP(numProbes));
+  ar(CEREAL_NVP(numSubspaces));
+  ar(CEREAL_NVP(codebookSize));
+  ar(CEREAL_NVP(searchMode));
+  ar(CEREAL_NVP(epsilon));
+  ar(CEREAL_NVP(referenceSet));
+  ar(CEREAL_NVP(coarseCentroids));
+  ar(CEREAL_NVP(listOffsets));
+  ar(CEREAL_NVP(listMembers));
+  ar(CEREAL_NVP(codebooks));
+  ar(CEREAL_NVP(codes));
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,65 @@
+/**
+ * @file methods/neighbor_search/query_tuning.hpp
+ *
+ * Query-adaptive tuning for NeighborSearch: pick the reference tree shape
+ * that minimizes the expected traversal cost against a historical query
+ * distribution.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_QUERY_TUNING_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_QUERY_TUNING_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * Select the leaf size that minimizes the expected traversal cost of the
+ * given NeighborSearch type against a historical query distribution.  The
+ * query log is first compressed with k-means: each cluster centroid acts as a
+ * representative query, weighted by the number of historical queries in its
+ * cluster.  Then, for each candidate leaf size, a reference tree is built and
+ * the weighted traversal cost (node combinations scored plus base cases) of
+ * searching the centroids is measured; the leaf size with the lowest cost is
+ * returned.
+ *
+ * The leaf size reshapes the reference tree---it controls how points are
+ * grouped into leaves and how deep the pivot hierarchy is---so tuning it to
+ * the query distribution reduces the work of every later search against that
+ * distribution.  To persist a tuned tree, assign the result to
+ * NSModel::LeafSize() before calling NSModel::BuildModel(); the tree built
+ * from it is serialized with the model as usual.
+ *
+ * This is only meaningful for tree types whose constructor accepts a maximum
+ * leaf size (e.g. kd-trees, ball trees, and octrees).
+ *
+ * @tparam NSType NeighborSearch instantiation to tune (e.g. KNN).
+ *
+ * @param referenceSet Set of reference data.
+ * @param historicalQueries Sample of queries drawn from the workload the
+ *     tuned tree will serve.
+ * @param k Number of neighbors the workload searches for.
+ * @param leafSizes Candidate leaf sizes to evaluate; must not be empty.
+ * @param maxClusters Maximum number of k-means clusters used to compress the
+ *     query log.
+ * @return The candidate leaf size with the lowest expected traversal cost.
+ */
+template<typename NSType>
+size_t TuneLeafSize(const arma::mat& referenceSet,
+                    const arma::mat& historicalQueries,
+                    const size_t k,
+                    const std::vector<size_t>& leafSizes,
+                    const size_t maxClusters = 100);
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "query_tuning_impl.hpp"
+
+#endif
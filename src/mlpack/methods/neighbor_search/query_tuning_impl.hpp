@@ -0,0 +1,82 @@
+/**
+ * @file methods/neighbor_search/query_tuning_impl.hpp
+ *
+ * Implementation of query-adaptive leaf size tuning for NeighborSearch.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_QUERY_TUNING_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_QUERY_TUNING_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "query_tuning.hpp"
+
+#include <mlpack/methods/kmeans/kmeans.hpp>
+
+namespace mlpack {
+namespace neighbor {
+
+template<typename NSType>
+size_t TuneLeafSize(const arma::mat& referenceSet,
+                    const arma::mat& historicalQueries,
+                    const size_t k,
+                    const std::vector<size_t>& leafSizes,
+                    const size_t maxClusters)
+{
+  if (leafSizes.empty())
+  {
+    throw std::invalid_argument("TuneLeafSize(): at least one candidate leaf "
+        "size must be given!");
+  }
+
+  // Compress the query log into representative queries: each k-means
+  // centroid stands in for the historical queries assigned to it, weighted
+  // by their number.
+  const size_t clusters = std::min(maxClusters, historicalQueries.n_cols);
+  arma::Row<size_t> assignments;
+  arma::mat centroids;
+  kmeans::KMeans<> kmeans;
+  kmeans.Cluster(historicalQueries, clusters, assignments, centroids);
+
+  arma::vec weights(clusters, arma::fill::zeros);
+  for (size_t i = 0; i < assignments.n_elem; ++i)
+    weights[assignments[i]]++;
+
+  size_t bestLeafSize = leafSizes[0];
+  double bestCost = DBL_MAX;
+  for (size_t l = 0; l < leafSizes.size(); ++l)
+  {
+    // Build a reference tree with this candidate leaf size.
+    typename NSType::Tree tree(referenceSet, leafSizes[l]);
+    NSType ns(std::move(tree));
+
+    // Measure the expected traversal cost: each centroid is searched on its
+    // own so that its cost can be weighted by the number of historical
+    // queries it represents.
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    double cost = 0.0;
+    for (size_t i = 0; i < clusters; ++i)
+    {
+      const arma::mat query(centroids.col(i));
+      ns.Search(query, k, neighbors, distances);
+      cost += weights[i] * (double) (ns.Scores() + ns.BaseCases());
+    }
+
+    if (cost < bestCost)
+    {
+      bestCost = cost;
+      bestLeafSize = leafSizes[l];
+    }
+  }
+
+  return bestLeafSize;
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
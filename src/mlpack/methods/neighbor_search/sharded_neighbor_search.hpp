@@ -0,0 +1,251 @@
+/**
+ * @file methods/neighbor_search/sharded_neighbor_search.hpp
+ * @author Ryan Curtin
+ *
+ * Defines the ShardedNeighborSearch class, which partitions the reference set
+ * into shards, builds one tree per shard, and searches the shards in
+ * parallel, merging the per-shard k-best results.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_SHARDED_NEIGHBOR_SEARCH_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_SHARDED_NEIGHBOR_SEARCH_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "neighbor_search.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * The ShardedNeighborSearch class splits the reference set into a fixed
+ * number of contiguous shards, builds an independent NeighborSearch index on
+ * each shard, and answers queries by searching all shards and merging the
+ * per-shard k-best candidate lists.  The results are identical to a single
+ * index over the whole set.
+ *
+ * The motivation is memory locality on multi-socket (NUMA) machines: one
+ * tree over one big matrix spreads its pages over all memory nodes, so about
+ * half of every traversal crosses the interconnect.  Here each shard's data
+ * is copied and its tree is built by the thread that will later search it
+ * (shards are assigned to threads with a static schedule), so with
+ * first-touch page allocation and pinned threads (e.g. OMP_PROC_BIND=true),
+ * each shard stays local to one socket.  One shard per memory node is the
+ * intended configuration.
+ *
+ * For nearest-neighbor search with an LMetric, bichromatic queries are
+ * additionally routed through a table of shard bounding boxes: each block of
+ * queries visits the shards in order of increasing lower bound on the
+ * distance from the block to the shard's box, and stops as soon as no
+ * remaining box can improve on the block's current k'th-best distances.
+ * With many shards and clustered data most shards are never touched at all,
+ * which is the same pruning idea a routing tree over per-node bounding boxes
+ * would provide in a distributed setting.
+ *
+ * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ * @tparam MetricType The metric to use for computation.
+ * @tparam MatType The type of data matrix.
+ * @tparam TreeType The tree type to use; must adhere to the TreeType API.
+ */
+template<typename SortPolicy = NearestNeighborSort,
+         typename MetricType = metric::EuclideanDistance,
+         typename MatType = arma::mat,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType = tree::KDTree>
+class ShardedNeighborSearch
+{
+ public:
+  //! Convenience typedef for the per-shard searcher.
+  typedef NeighborSearch<SortPolicy, MetricType, MatType, TreeType> ShardType;
+  //! Convenience typedef for the element type of the data.
+  typedef typename MatType::elem_type ElemType;
+
+  /**
+   * Initialize the ShardedNeighborSearch object with the given reference set,
+   * partitioning it into the given number of shards and building one tree
+   * per shard.
+   *
+   * @param referenceSet Set of reference points.
+   * @param numShards Number of shards to partition the reference set into
+   *      (one per NUMA node is the intended configuration).
+   * @param mode Neighbor search mode used for every shard.
+   * @param epsilon Relative approximate error (non-negative).
+   * @param metric An optional instance of the MetricType class.
+   */
+  ShardedNeighborSearch(MatType referenceSet,
+                        const size_t numShards = 2,
+                        const NeighborSearchMode mode = DUAL_TREE_MODE,
+                        const double epsilon = 0,
+                        const MetricType metric = MetricType());
+
+  /**
+   * Create a ShardedNeighborSearch object without any reference data.  If
+   * Search() is called before a reference set is given with Train(), an
+   * exception will be thrown.
+   *
+   * @param numShards Number of shards to partition the reference set into.
+   * @param mode Neighbor search mode used for every shard.
+   * @param epsilon Relative approximate error (non-negative).
+   * @param metric An optional instance of the MetricType class.
+   */
+  ShardedNeighborSearch(const size_t numShards = 2,
+                        const NeighborSearchMode mode = DUAL_TREE_MODE,
+                        const double epsilon = 0,
+                        const MetricType metric = MetricType());
+
+  /**
+   * Set the reference set to a new reference set, repartitioning it and
+   * rebuilding the per-shard trees.
+   *
+   * @param referenceSet New set of reference data.
+   */
+  void Train(MatType referenceSet);
+
+  /**
+   * For each point in the query set, compute the nearest neighbors over all
+   * shards and store the output in the given matrices, exactly as
+   * NeighborSearch::Search() would over the whole reference set.
+   *
+   * @param querySet Set of query points (can be just one point).
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *     point.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances);
+
+  /**
+   * Search for the nearest neighbors of every point in the reference set
+   * (monochromatic search); each point's own entry is excluded from its
+   * results.
+   *
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *      point.
+   */
+  void Search(const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances);
+
+  //! Return the number of shards the reference set is partitioned into.
+  size_t NumShards() const { return shards.size(); }
+
+  //! Access the search mode used for every shard.
+  NeighborSearchMode SearchMode() const { return searchMode; }
+  //! Modify the search mode used for every shard.
+  NeighborSearchMode& SearchMode() { return searchMode; }
+
+  //! Access the relative error to be considered in approximate search.
+  double Epsilon() const { return epsilon; }
+  //! Modify the relative error to be considered in approximate search.
+  double& Epsilon() { return epsilon; }
+
+  //! Access the reference dataset (in the original point order).
+  const MatType& ReferenceSet() const { return dataset; }
+
+  //! Serialize the sharded model.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  /**
+   * Partition the dataset into contiguous shards and build the per-shard
+   * trees; each shard is copied and trained by the thread that will search
+   * it, so its pages are first-touched on that thread's memory node.
+   */
+  void Partition();
+
+  /**
+   * Search for the k best neighbors of every query point, routing each block
+   * of queries through the shard bounding boxes: the shards are visited in
+   * order of increasing lower bound on the distance from the block to the
+   * shard's box, and the remaining shards are skipped as soon as no box can
+   * improve on the block's current k'th-best distances.  The results are
+   * identical to searching every shard.  Only valid when SortPolicy is
+   * NearestNeighborSort and MetricType is an LMetric (otherwise the clamped
+   * point-to-box distance is not a lower bound).
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *     point.
+   */
+  void SearchWithRouting(const MatType& querySet,
+                         const size_t k,
+                         arma::Mat<size_t>& neighbors,
+                         arma::mat& distances);
+
+  /**
+   * Merge the per-shard sorted candidate lists into the global k-best
+   * results, translating shard-local indices to global ones.  If skipSelf is
+   * true, a candidate whose global index equals its query column is dropped
+   * (for monochromatic search).
+   *
+   * @param numQueries Number of query points.
+   * @param k Number of neighbors searched for.
+   * @param shardNeighbors Per-shard neighbor matrices.
+   * @param shardDistances Per-shard distance matrices.
+   * @param neighbors Merged output matrix of neighbor indices.
+   * @param distances Merged output matrix of neighbor distances.
+   * @param skipSelf If true, drop candidates that match the query point.
+   */
+  void MergeShardResults(const size_t numQueries,
+                         const size_t k,
+                         const std::vector<arma::Mat<size_t>>& shardNeighbors,
+                         const std::vector<arma::mat>& shardDistances,
+                         arma::Mat<size_t>& neighbors,
+                         arma::mat& distances,
+                         const bool skipSelf) const;
+
+  //! The full reference set, in the original point order; monochromatic
+  //! search uses it as the query set.
+  MatType dataset;
+
+  //! The number of shards requested (the actual number is capped by the
+  //! number of points).
+  size_t numShards;
+  //! The search mode used for every shard.
+  NeighborSearchMode searchMode;
+  //! The relative error to be considered in approximate search.
+  double epsilon;
+  //! Instantiation of metric.
+  MetricType metric;
+
+  //! One independent searcher per shard.
+  std::vector<ShardType> shards;
+  //! Global index of each shard's first point.
+  std::vector<size_t> shardOffsets;
+
+  //! Per-dimension minima of each shard (one column per shard); together
+  //! with shardMaxs these are the bounding boxes used for query routing.
+  arma::Mat<ElemType> shardMins;
+  //! Per-dimension maxima of each shard (one column per shard).
+  arma::Mat<ElemType> shardMaxs;
+
+  //! Number of query points routed through the shard bounds as one block.
+  static const size_t routingBlockSize = 1024;
+}; // class ShardedNeighborSearch
+
+/**
+ * The ShardedKNN class is the k-nearest-neighbors method over a sharded
+ * reference set; see ShardedNeighborSearch.
+ */
+typedef ShardedNeighborSearch<NearestNeighborSort, metric::EuclideanDistance>
+    ShardedKNN;
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "sharded_neighbor_search_impl.hpp"
+
+#endif
@@ -0,0 +1,441 @@
+/**
+ * @file methods/neighbor_search/sharded_neighbor_search_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the ShardedNeighborSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_SHARDED_NEIGHBOR_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_SHARDED_NEIGHBOR_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "sharded_neighbor_search.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+ShardedNeighborSearch<SortPolicy, MetricType, MatType, TreeType>::
+ShardedNeighborSearch(MatType referenceSet,
+                      const size_t numShards,
+                      const NeighborSearchMode mode,
+                      const double epsilon,
+                      const MetricType metric) :
+    dataset(std::move(referenceSet)),
+    numShards(numShards),
+    searchMode(mode),
+    epsilon(epsilon),
+    metric(metric)
+{
+  if (numShards == 0)
+    throw std::invalid_argument("number of shards must be positive");
+  if (epsilon < 0)
+    throw std::invalid_argument("epsilon must be non-negative");
+
+  Partition();
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+ShardedNeighborSearch<SortPolicy, MetricType, MatType, TreeType>::
+ShardedNeighborSearch(const size_t numShards,
+                      const NeighborSearchMode mode,
+                      const double epsilon,
+                      const MetricType metric) :
+    numShards(numShards),
+    searchMode(mode),
+    epsilon(epsilon),
+    metric(metric)
+{
+  if (numShards == 0)
+    throw std::invalid_argument("number of shards must be positive");
+  if (epsilon < 0)
+    throw std::invalid_argument("epsilon must be non-negative");
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void ShardedNeighborSearch<SortPolicy, MetricType, MatType, TreeType>::Train(
+    MatType referenceSet)
+{
+  dataset = std::move(referenceSet);
+  Partition();
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void ShardedNeighborSearch<SortPolicy, MetricType, MatType, TreeType>::
+Partition()
+{
+  shards.clear();
+  shardOffsets.clear();
+
+  if (dataset.n_cols == 0)
+    return;
+
+  // Never create more shards than points.
+  const size_t shardCount = std::min(numShards, (size_t) dataset.n_cols);
+  shards.resize(shardCount, ShardType(searchMode, epsilon, metric));
+  shardOffsets.resize(shardCount);
+  for (size_t s = 0; s < shardCount; ++s)
+    shardOffsets[s] = (s * dataset.n_cols) / shardCount;
+
+  shardMins.set_size(dataset.n_rows, shardCount);
+  shardMaxs.set_size(dataset.n_rows, shardCount);
+
+  Timer::Start("sharded_tree_building");
+
+  // Each shard is copied and its tree is built by the thread that the static
+  // schedule will also hand its searches to, so with first-touch allocation
+  // and pinned threads the shard's pages stay on that thread's memory node.
+  #pragma omp parallel for schedule(static, 1)
+  for (omp_size_t s = 0; s < (omp_size_t) shardCount; ++s)
+  {
+    const size_t begin = shardOffsets[s];
+    const size_t end = ((s + 1) * dataset.n_cols) / shardCount;
+
+    MatType block = dataset.cols(begin, end - 1);
+
+    // Record the shard's bounding box; the query routing in
+    // SearchWithRouting() prunes whole shards with these.  Element access is
+    // used here so any matrix type can be handled.
+    for (size_t d = 0; d < dataset.n_rows; ++d)
+    {
+      ElemType lo = block(d, 0);
+      ElemType hi = block(d, 0);
+      for (size_t p = 1; p < block.n_cols; ++p)
+      {
+        lo = std::min(lo, (ElemType) block(d, p));
+        hi = std::max(hi, (ElemType) block(d, p));
+      }
+
+      shardMins(d, s) = lo;
+      shardMaxs(d, s) = hi;
+    }
+
+    shards[s].Train(std::move(block));
+  }
+
+  Timer::Stop("sharded_tree_building");
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void ShardedNeighborSearch<SortPolicy, MetricType, MatType, TreeType>::Search(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances)
+{
+  if (k > dataset.n_cols)
+  {
+    std::stringstream ss;
+    ss << "Requested value of k (" << k << ") is greater than the number of "
+        << "points in the reference set (" << dataset.n_cols << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  // Propagate the current search parameters to the shards.
+  for (size_t s = 0; s < shards.size(); ++s)
+  {
+    shards[s].SearchMode() = searchMode;
+    shards[s].Epsilon() = epsilon;
+  }
+
+  // When we are after nearest neighbors under an LMetric, the clamped
+  // point-to-box distance is a valid lower bound, so the query blocks can be
+  // routed through the shard bounding boxes and most shards skipped.
+  if (std::is_same<SortPolicy, NearestNeighborSort>::value &&
+      bound::meta::IsLMetric<MetricType>::Value && shards.size() > 1)
+  {
+    SearchWithRouting(querySet, k, neighbors, distances);
+    return;
+  }
+
+  std::vector<arma::Mat<size_t>> shardNeighbors(shards.size());
+  std::vector<arma::mat> shardDistances(shards.size());
+
+  // Search every shard; the static schedule hands shard s to the same thread
+  // that built it.
+  #pragma omp parallel for schedule(static, 1)
+  for (omp_size_t s = 0; s < (omp_size_t) shards.size(); ++s)
+  {
+    const size_t kShard = std::min(k,
+        (size_t) shards[s].ReferenceSet().n_cols);
+    shards[s].Search(querySet, kShard, shardNeighbors[s], shardDistances[s]);
+  }
+
+  MergeShardResults(querySet.n_cols, k, shardNeighbors, shardDistances,
+      neighbors, distances, false);
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void ShardedNeighborSearch<SortPolicy, MetricType, MatType, TreeType>::Search(
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances)
+{
+  if (k >= dataset.n_cols)
+  {
+    std::stringstream ss;
+    ss << "Requested value of k (" << k << ") is greater than or equal to "
+        << "the number of points in the reference set (" << dataset.n_cols
+        << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  // Propagate the current search parameters to the shards.
+  for (size_t s = 0; s < shards.size(); ++s)
+  {
+    shards[s].SearchMode() = searchMode;
+    shards[s].Epsilon() = epsilon;
+  }
+
+  std::vector<arma::Mat<size_t>> shardNeighbors(shards.size());
+  std::vector<arma::mat> shardDistances(shards.size());
+
+  // Every point is a query against every shard; each point's own shard will
+  // return the point itself, so ask that one extra candidate from each shard
+  // and drop the self-matches during the merge.  No bounding-box routing is
+  // done here: the query set is the reference set, so the queries span every
+  // shard's box and routing would prune next to nothing.
+  #pragma omp parallel for schedule(static, 1)
+  for (omp_size_t s = 0; s < (omp_size_t) shards.size(); ++s)
+  {
+    const size_t kShard = std::min(k + 1,
+        (size_t) shards[s].ReferenceSet().n_cols);
+    shards[s].Search(dataset, kShard, shardNeighbors[s], shardDistances[s]);
+  }
+
+  MergeShardResults(dataset.n_cols, k, shardNeighbors, shardDistances,
+      neighbors, distances, true);
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void ShardedNeighborSearch<SortPolicy, MetricType, MatType, TreeType>::
+SearchWithRouting(const MatType& querySet,
+                  const size_t k,
+                  arma::Mat<size_t>& neighbors,
+                  arma::mat& distances)
+{
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  arma::Mat<size_t> shardNeighbors;
+  arma::mat shardDistances;
+
+  for (size_t begin = 0; begin < querySet.n_cols; begin += routingBlockSize)
+  {
+    const size_t end = std::min(begin + routingBlockSize,
+        (size_t) querySet.n_cols);
+    const size_t blockWidth = end - begin;
+    const MatType blockQueries = querySet.cols(begin, end - 1);
+
+    // Lower-bound the distance from the block to each shard's bounding box:
+    // the closest point of a box to a query is the query clamped to the box,
+    // and the block's bound is the best bound of any of its queries.
+    arma::vec shardBounds(shards.size());
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t s = 0; s < (omp_size_t) shards.size(); ++s)
+    {
+      arma::Col<ElemType> clamped(querySet.n_rows);
+      double best = SortPolicy::WorstDistance();
+      for (size_t q = 0; q < blockWidth; ++q)
+      {
+        for (size_t d = 0; d < querySet.n_rows; ++d)
+        {
+          clamped[d] = std::min(std::max((ElemType) blockQueries(d, q),
+              shardMins(d, s)), shardMaxs(d, s));
+        }
+
+        const double bound = metric.Evaluate(blockQueries.col(q), clamped);
+        if (SortPolicy::IsBetter(bound, best))
+          best = bound;
+      }
+
+      shardBounds[s] = best;
+    }
+
+    // Candidate lists for the block, padded with sentinels until k real
+    // candidates have been found for every query.
+    arma::Mat<size_t> blockNeighbors(k, blockWidth);
+    arma::mat blockDistances(k, blockWidth);
+    blockNeighbors.fill(dataset.n_cols);
+    blockDistances.fill(SortPolicy::WorstDistance());
+
+    // Visit the shards best-first.
+    const arma::uvec shardOrder = arma::sort_index(shardBounds);
+    for (size_t o = 0; o < shardOrder.n_elem; ++o)
+    {
+      const size_t s = shardOrder[o];
+
+      // Once the closest remaining box cannot beat the worst current k'th
+      // distance in the block, no remaining shard can contribute a result.
+      // (Until every query has k candidates the k'th distances are the
+      // sentinel, so nothing is pruned.)
+      const double worstKth = blockDistances.row(k - 1).max();
+      if (!SortPolicy::IsBetter(shardBounds[s], worstKth))
+        break;
+
+      const size_t kShard = std::min(k,
+          (size_t) shards[s].ReferenceSet().n_cols);
+      shards[s].Search(blockQueries, kShard, shardNeighbors, shardDistances);
+
+      // Merge the shard's sorted candidate lists into the block's sorted
+      // lists, translating shard-local indices to global ones.
+      #pragma omp parallel for schedule(static)
+      for (omp_size_t q = 0; q < (omp_size_t) blockWidth; ++q)
+      {
+        arma::Col<size_t> mergedNeighbors(k);
+        arma::vec mergedDistances(k);
+
+        size_t a = 0, b = 0;
+        for (size_t j = 0; j < k; ++j)
+        {
+          if (b >= kShard || !SortPolicy::IsBetter(shardDistances(b, q),
+              blockDistances(a, q)))
+          {
+            mergedNeighbors[j] = blockNeighbors(a, q);
+            mergedDistances[j] = blockDistances(a, q);
+            ++a;
+          }
+          else
+          {
+            mergedNeighbors[j] = shardOffsets[s] + shardNeighbors(b, q);
+            mergedDistances[j] = shardDistances(b, q);
+            ++b;
+          }
+        }
+
+        blockNeighbors.col(q) = mergedNeighbors;
+        blockDistances.col(q) = mergedDistances;
+      }
+    }
+
+    neighbors.cols(begin, end - 1) = blockNeighbors;
+    distances.cols(begin, end - 1) = blockDistances;
+  }
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void ShardedNeighborSearch<SortPolicy, MetricType, MatType, TreeType>::
+MergeShardResults(const size_t numQueries,
+                  const size_t k,
+                  const std::vector<arma::Mat<size_t>>& shardNeighbors,
+                  const std::vector<arma::mat>& shardDistances,
+                  arma::Mat<size_t>& neighbors,
+                  arma::mat& distances,
+                  const bool skipSelf) const
+{
+  neighbors.set_size(k, numQueries);
+  distances.set_size(k, numQueries);
+
+  // The per-shard candidate lists are already sorted best-first, so merging
+  // them is a k-way merge per query point.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) numQueries; ++i)
+  {
+    std::vector<size_t> heads(shards.size(), 0);
+    for (size_t j = 0; j < k; ++j)
+    {
+      size_t bestShard = shards.size();
+      double bestDistance = SortPolicy::WorstDistance();
+      for (size_t s = 0; s < shards.size(); ++s)
+      {
+        // Skip the query point itself in monochromatic search.
+        while (skipSelf && heads[s] < shardNeighbors[s].n_rows &&
+            shardOffsets[s] + shardNeighbors[s](heads[s], i) == (size_t) i)
+          ++heads[s];
+
+        if (heads[s] >= shardNeighbors[s].n_rows)
+          continue; // This shard's candidates are exhausted.
+
+        const double distance = shardDistances[s](heads[s], i);
+        if (bestShard == shards.size() ||
+            SortPolicy::IsBetter(distance, bestDistance))
+        {
+          bestShard = s;
+          bestDistance = distance;
+        }
+      }
+
+      if (bestShard == shards.size())
+      {
+        // Every shard is exhausted; this cannot happen when k is valid.
+        neighbors(j, i) = dataset.n_cols;
+        distances(j, i) = SortPolicy::WorstDistance();
+        continue;
+      }
+
+      neighbors(j, i) = shardOffsets[bestShard] +
+          shardNeighbors[bestShard](heads[bestShard], i);
+      distances(j, i) = bestDistance;
+      ++heads[bestShard];
+    }
+  }
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename Archive>
+void ShardedNeighborSearch<SortPolicy, MetricType, MatType, TreeType>::
+serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(numShards));
+  ar(CEREAL_NVP(searchMode));
+  ar(CEREAL_NVP(epsilon));
+  ar(CEREAL_NVP(dataset));
+  ar(CEREAL_NVP(shardOffsets));
+  ar(CEREAL_NVP(shardMins));
+  ar(CEREAL_NVP(shardMaxs));
+  ar(CEREAL_NVP(shards));
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
@@ -18,6 +18,7 @@
 #include "neighbor_search.hpp"
 
 #include <mlpack/core/metrics/lmetric.hpp>
+#include <mlpack/core/metrics/quantized_euclidean_distance.hpp>
 
 #include "sort_policies/nearest_neighbor_sort.hpp"
 #include "sort_policies/furthest_neighbor_sort.hpp"
@@ -66,6 +67,30 @@ using DefeatistKNN = NeighborSearch<
  */
 typedef DefeatistKNN<tree::SPTree> SpillKNN;
 
+/**
+ * The SparseKNN class is the k-nearest-neighbors method over a sparse
+ * dataset, held as arma::sp_mat.  It returns exact L2 distances (Euclidean
+ * distances) for each of the k nearest neighbors, computed by merging the
+ * nonzero entries of each pair of points, so very sparse data (e.g. TF-IDF
+ * vectors) is searched without ever being densified.
+ */
+typedef NeighborSearch<NearestNeighborSort,
+                       metric::EuclideanDistance,
+                       arma::sp_mat,
+                       tree::KDTree> SparseKNN;
+
+/**
+ * The QuantizedKNN class is the k-nearest-neighbors method over an
+ * int8-quantized dataset, as produced by data::Quantize(); the returned
+ * distances approximate the L2 distances between the original points.  A ball
+ * tree is used because the quantized distance is not an LMetric, which the
+ * default KDTree requires.
+ */
+typedef NeighborSearch<NearestNeighborSort,
+                       metric::QuantizedEuclideanDistance,
+                       arma::Mat<arma::s8>,
+                       tree::BallTree> QuantizedKNN;
+
 } // namespace neighbor
 } // namespace mlpack
 
@@ -16,6 +16,7 @@
 #define MLPACK_METHODS_NYSTROEM_METHOD_NYSTROEM_METHOD_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/kernel_matrix.hpp>
 #include "kmeans_selection.hpp"
 
 namespace mlpack {
@@ -35,8 +36,16 @@ class NystroemMethod
    * @param data Data matrix.
    * @param kernel Kernel to be used for computation.
    * @param rank Rank to be used for matrix approximation.
+   * @param cachePath If non-empty, the n-by-rank semi-kernel matrix is cached
+   *     on disk under this path prefix and reused on later runs with the same
+   *     data, selected points, and kernel parameters (see
+   *     PairwiseKernelMatrix()); this is only useful with a deterministic
+   *     point selection policy.
    */
-  NystroemMethod(const arma::mat& data, KernelType& kernel, const size_t rank);
+  NystroemMethod(const arma::mat& data,
+                 KernelType& kernel,
+                 const size_t rank,
+                 const std::string& cachePath = "");
 
   /**
    * Apply the low-rank factorization to obtain an output matrix G such that
@@ -68,6 +77,12 @@ class NystroemMethod
                        arma::mat& miniKernel,
                        arma::mat& semiKernel);
 
+  //! Get the path prefix used for on-disk caching of the semi-kernel matrix.
+  const std::string& CachePath() const { return cachePath; }
+  //! Modify the path prefix used for on-disk caching of the semi-kernel
+  //! matrix (an empty string disables caching).
+  std::string& CachePath() { return cachePath; }
+
  private:
   //! The reference dataset.
   const arma::mat& data;
@@ -75,6 +90,9 @@ class NystroemMethod
   KernelType& kernel;
   //! Rank used for matrix approximation.
   const size_t rank;
+  //! Path prefix for on-disk caching of the semi-kernel matrix (empty means
+  //! no caching).
+  std::string cachePath;
 };
 
 } // namespace kernel
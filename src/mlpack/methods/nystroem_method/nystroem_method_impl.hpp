@@ -23,10 +23,12 @@ template<typename KernelType, typename PointSelectionPolicy>
 NystroemMethod<KernelType, PointSelectionPolicy>::NystroemMethod(
     const arma::mat& data,
     KernelType& kernel,
-    const size_t rank) :
+    const size_t rank,
+    const std::string& cachePath) :
     data(data),
     kernel(kernel),
-    rank(rank)
+    rank(rank),
+    cachePath(cachePath)
 { }
 
 template<typename KernelType, typename PointSelectionPolicy>
@@ -36,17 +38,15 @@ void NystroemMethod<KernelType, PointSelectionPolicy>::GetKernelMatrix(
     arma::mat& semiKernel)
 {
   // Assemble mini-kernel matrix.
-  for (size_t i = 0; i < rank; ++i)
-    for (size_t j = 0; j < rank; ++j)
-      miniKernel(i, j) = kernel.Evaluate(selectedData->col(i),
-                                         selectedData->col(j));
+  PairwiseKernelMatrix(*selectedData, *selectedData, kernel, miniKernel);
 
   // Construct semi-kernel matrix with interactions between selected data and
-  // all points.
-  for (size_t i = 0; i < data.n_cols; ++i)
-    for (size_t j = 0; j < rank; ++j)
-      semiKernel(i, j) = kernel.Evaluate(data.col(i),
-                                         selectedData->col(j));
+  // all points, optionally caching it on disk.
+  if (cachePath.empty())
+    PairwiseKernelMatrix(data, *selectedData, kernel, semiKernel);
+  else
+    PairwiseKernelMatrix(data, *selectedData, kernel, semiKernel, cachePath);
+
   // Clean the memory.
   delete selectedData;
 }
@@ -57,22 +57,21 @@ void NystroemMethod<KernelType, PointSelectionPolicy>::GetKernelMatrix(
     arma::mat& miniKernel,
     arma::mat& semiKernel)
 {
+  // Gather the selected points into a contiguous matrix, so that both kernel
+  // matrices can be assembled with blocked matrix products.
+  arma::mat selectedData(data.n_rows, rank);
+  for (size_t j = 0; j < rank; ++j)
+    selectedData.col(j) = data.col(selectedPoints(j));
+
   // Assemble mini-kernel matrix.
-  for (size_t i = 0; i < rank; ++i)
-  {
-    for (size_t j = 0; j < rank; ++j)
-    {
-      miniKernel(i, j) = kernel.Evaluate(data.col(selectedPoints(i)),
-                                         data.col(selectedPoints(j)));
-    }
-  }
+  PairwiseKernelMatrix(selectedData, selectedData, kernel, miniKernel);
 
   // Construct semi-kernel matrix with interactions between selected points and
-  // all points.
-  for (size_t i = 0; i < data.n_cols; ++i)
-    for (size_t j = 0; j < rank; ++j)
-      semiKernel(i, j) = kernel.Evaluate(data.col(i),
-                                         data.col(selectedPoints(j)));
+  // all points, optionally caching it on disk.
+  if (cachePath.empty())
+    PairwiseKernelMatrix(data, selectedData, kernel, semiKernel);
+  else
+    PairwiseKernelMatrix(data, selectedData, kernel, semiKernel, cachePath);
 }
 
 template<typename KernelType, typename PointSelectionPolicy>
@@ -17,6 +17,7 @@
 #define MLPACK_METHODS_PCA_PCA_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/ccov.hpp>
 #include <mlpack/methods/pca/decomposition_policies/exact_svd_method.hpp>
 
 namespace mlpack {
@@ -105,6 +106,51 @@ class PCA
    */
   double Apply(arma::mat& data, const double varRetained);
 
+  /**
+   * Start an application of PCA over chunks of data.  The data can then be
+   * passed in chunks with ApplyChunk(), and the decomposition computed with
+   * FinishApplyChunks(); only one chunk and the running dimensionality x
+   * dimensionality covariance accumulator need to be held in memory at once,
+   * so a dataset far larger than RAM can be decomposed.  Note that the chunked
+   * path computes an eigendecomposition of the accumulated covariance matrix
+   * directly, regardless of the decomposition policy.
+   *
+   * @param dimensionality Dimensionality of the data to be passed to
+   *     ApplyChunk().
+   */
+  void StartApplyChunks(const size_t dimensionality);
+
+  /**
+   * Accumulate the given chunk of data into the running covariance.  This can
+   * only be called after StartApplyChunks(), and every chunk must have the
+   * dimensionality given there.
+   *
+   * @param dataChunk Chunk of data points to accumulate.
+   */
+  void ApplyChunk(const arma::mat& dataChunk);
+
+  /**
+   * Finish an application of PCA over chunks of data, computing the
+   * eigenvalues and eigenvectors (loadings) of the accumulated covariance.
+   * After calling this, individual chunks can be projected onto the principal
+   * components with TransformChunk().
+   *
+   * @param eigVal Vector to put eigenvalues into, in descending order.
+   * @param eigvec Matrix to put eigenvectors (loadings) into.
+   */
+  void FinishApplyChunks(arma::vec& eigVal, arma::mat& eigvec);
+
+  /**
+   * Project a chunk of data onto the principal components found by
+   * FinishApplyChunks(), centering (and, if specified, scaling) it with the
+   * statistics accumulated over all chunks.
+   *
+   * @param dataChunk Chunk of data points to transform.
+   * @param transformedData Matrix to put the transformed chunk into.
+   */
+  void TransformChunk(const arma::mat& dataChunk,
+                      arma::mat& transformedData) const;
+
   //! Get whether or not this PCA object will scale (by standard deviation)
   //! the data when PCA is performed.
   bool ScaleData() const { return scaleData; }
@@ -139,6 +185,19 @@ class PCA
 
   //! Decomposition method used to perform principal components analysis.
   DecompositionPolicy decomposition;
+
+  //! Running covariance accumulator for chunked application (not serialized;
+  //! this is scratch state used between StartApplyChunks() and
+  //! FinishApplyChunks()).
+  math::ColumnCovarianceAccumulator<double> chunkAcc;
+  //! Mean of the accumulated data, set by FinishApplyChunks().
+  arma::vec chunkMean;
+  //! Per-dimension scaling of the accumulated data, set by
+  //! FinishApplyChunks().
+  arma::vec chunkScale;
+  //! Eigenvectors of the accumulated covariance, set by FinishApplyChunks()
+  //! and used by TransformChunk().
+  arma::mat chunkEigvec;
 }; // class PCA
 
 } // namespace pca
@@ -171,6 +171,120 @@ double PCA<DecompositionPolicy>::Apply(arma::mat& data,
   return varSum;
 }
 
+/**
+ * Start an application of PCA over chunks of data, resetting the covariance
+ * accumulator.
+ */
+template<typename DecompositionPolicy>
+void PCA<DecompositionPolicy>::StartApplyChunks(const size_t dimensionality)
+{
+  chunkAcc.Reset(dimensionality);
+
+  chunkMean.reset();
+  chunkScale.reset();
+  chunkEigvec.reset();
+}
+
+/**
+ * Accumulate a chunk of data into the running covariance.
+ */
+template<typename DecompositionPolicy>
+void PCA<DecompositionPolicy>::ApplyChunk(const arma::mat& dataChunk)
+{
+  if (chunkAcc.Dimensionality() == 0)
+  {
+    Log::Fatal << "PCA::ApplyChunk(): StartApplyChunks() must be called "
+        << "before ApplyChunk()!" << std::endl;
+  }
+
+  if (dataChunk.n_rows != chunkAcc.Dimensionality())
+  {
+    Log::Fatal << "PCA::ApplyChunk(): chunk has dimensionality "
+        << dataChunk.n_rows << ", but StartApplyChunks() was given "
+        << "dimensionality " << chunkAcc.Dimensionality() << "!" << std::endl;
+  }
+
+  // Only the second moment and the sum are accumulated; the mean is removed
+  // once all chunks have been seen, in FinishApplyChunks().
+  chunkAcc.Accumulate(dataChunk);
+}
+
+/**
+ * Finish an application of PCA over chunks of data, computing the
+ * eigendecomposition of the accumulated covariance.
+ */
+template<typename DecompositionPolicy>
+void PCA<DecompositionPolicy>::FinishApplyChunks(arma::vec& eigVal,
+                                                 arma::mat& eigvec)
+{
+  if (chunkAcc.Dimensionality() == 0)
+  {
+    Log::Fatal << "PCA::FinishApplyChunks(): StartApplyChunks() must be "
+        << "called before FinishApplyChunks()!" << std::endl;
+  }
+
+  if (chunkAcc.Count() < 2)
+  {
+    Log::Fatal << "PCA::FinishApplyChunks(): at least two points must be "
+        << "accumulated with ApplyChunk()!" << std::endl;
+  }
+
+  Timer::Start("pca");
+
+  // Remove the contribution of the mean from the accumulated second moment;
+  // this yields the same covariance the batch path computes from the centered
+  // data.
+  chunkMean = chunkAcc.Mean();
+  arma::mat covariance = chunkAcc.Covariance(0);
+
+  if (scaleData)
+  {
+    chunkScale = arma::sqrt(covariance.diag());
+
+    // If there are any zeroes, make them very small.
+    for (size_t i = 0; i < chunkScale.n_elem; ++i)
+      if (chunkScale[i] == 0)
+        chunkScale[i] = 1e-50;
+
+    covariance /= chunkScale * chunkScale.t();
+  }
+
+  arma::eig_sym(eigVal, eigvec, covariance);
+
+  // eig_sym() returns the eigenvalues in ascending order.
+  eigVal = arma::reverse(eigVal);
+  eigvec = arma::fliplr(eigvec);
+
+  chunkEigvec = eigvec;
+
+  // Release the accumulator; the mean, scaling and eigenvectors are kept for
+  // TransformChunk().
+  chunkAcc.Reset(0);
+
+  Timer::Stop("pca");
+}
+
+/**
+ * Project a chunk of data onto the principal components found by
+ * FinishApplyChunks().
+ */
+template<typename DecompositionPolicy>
+void PCA<DecompositionPolicy>::TransformChunk(const arma::mat& dataChunk,
+                                              arma::mat& transformedData) const
+{
+  if (chunkEigvec.is_empty())
+  {
+    Log::Fatal << "PCA::TransformChunk(): FinishApplyChunks() must be called "
+        << "before TransformChunk()!" << std::endl;
+  }
+
+  arma::mat centeredData = dataChunk.each_col() - chunkMean;
+  if (scaleData)
+    centeredData.each_col() /= chunkScale;
+
+  transformedData = chunkEigvec.t() * centeredData;
+}
+
 } // namespace pca
 } // namespace mlpack
 
@@ -87,6 +87,11 @@ PARAM_STRING_IN("decomposition_method", "Method used for the principal "
     "components analysis: 'exact', 'randomized', 'randomized-block-krylov', "
     "'quic'.", "c", "exact");
 
+PARAM_INT_IN("block_size", "If positive, accumulate the covariance over "
+    "column blocks of this many points and transform the data block by "
+    "block, instead of materializing the centered data matrix and its "
+    "covariance at once.  This overrides --decomposition_method.", "b", 0);
+
 
 //! Run RunPCA on the specified dataset with the given decomposition method.
 template<typename DecompositionPolicy>
@@ -117,6 +122,70 @@ void RunPCA(arma::mat& dataset,
       dataset.n_rows << " dimensions)." << endl;
 }
 
+//! Run PCA over column blocks of the dataset, accumulating the covariance and
+//! transforming the data one block at a time.
+void RunBlockPCA(arma::mat& dataset,
+                 const size_t newDimension,
+                 const bool scale,
+                 const double varToRetain,
+                 const size_t blockSize)
+{
+  PCA<> p(scale);
+
+  Log::Info << "Performing PCA on dataset in blocks of " << blockSize
+      << " points..." << endl;
+
+  p.StartApplyChunks(dataset.n_rows);
+  for (size_t begin = 0; begin < dataset.n_cols; begin += blockSize)
+  {
+    const size_t end = std::min(begin + blockSize, (size_t) dataset.n_cols) - 1;
+    p.ApplyChunk(dataset.cols(begin, end));
+  }
+
+  arma::vec eigVal;
+  arma::mat eigvec;
+  p.FinishApplyChunks(eigVal, eigvec);
+
+  // Decide the output dimensionality, mirroring the in-core path: either as
+  // many dimensions as needed to retain the requested variance, or the
+  // requested dimensionality.
+  const arma::vec varFrac = eigVal / arma::sum(eigVal);
+  size_t outDimension = std::min(newDimension, (size_t) eigVal.n_elem);
+  double varRetained;
+  if (IO::HasParam("var_to_retain"))
+  {
+    if (IO::HasParam("new_dimensionality"))
+      Log::Warn << "New dimensionality (-d) ignored because --var_to_retain "
+          << "(-r) was specified." << endl;
+
+    outDimension = 0;
+    varRetained = 0.0;
+    while ((varRetained < varToRetain) && (outDimension < varFrac.n_elem))
+    {
+      varRetained += varFrac[outDimension];
+      ++outDimension;
+    }
+  }
+  else
+  {
+    varRetained = arma::sum(varFrac.subvec(0, outDimension - 1));
+  }
+
+  // Project the data onto the retained components, one block at a time.
+  arma::mat transformed(outDimension, dataset.n_cols);
+  arma::mat transformedBlock;
+  for (size_t begin = 0; begin < dataset.n_cols; begin += blockSize)
+  {
+    const size_t end = std::min(begin + blockSize, (size_t) dataset.n_cols) - 1;
+    p.TransformChunk(dataset.cols(begin, end), transformedBlock);
+    transformed.cols(begin, end) = transformedBlock.rows(0, outDimension - 1);
+  }
+  dataset = std::move(transformed);
+
+  Log::Info << (varRetained * 100) << "% of variance retained (" <<
+      dataset.n_rows << " dimensions)." << endl;
+}
+
 static void mlpackMain()
 {
   // Load input dataset.
@@ -152,8 +221,20 @@ static void mlpackMain()
   const string decompositionMethod = IO::GetParam<string>(
       "decomposition_method");
 
+  RequireParamValue<int>("block_size", [](int x) { return x >= 0; }, true,
+      "block size must be non-negative");
+
   // Perform PCA.
-  if (decompositionMethod == "exact")
+  if (IO::GetParam<int>("block_size") > 0)
+  {
+    if (IO::HasParam("decomposition_method"))
+      Log::Warn << "Decomposition method (-c) ignored because --block_size "
+          << "(-b) was specified." << endl;
+
+    RunBlockPCA(dataset, newDimension, scale, varToRetain,
+        (size_t) IO::GetParam<int>("block_size"));
+  }
+  else if (decompositionMethod == "exact")
   {
     RunPCA<ExactSVDPolicy>(dataset, newDimension, scale, varToRetain);
   }
@@ -108,13 +108,17 @@ class Perceptron
 
   /**
    * Classification function. After training, use the weights matrix to
-   * classify test, and put the predicted classes in predictedLabels.
+   * classify test, and put the predicted classes in predictedLabels.  This
+   * method is const and keeps all scratch state on the stack, so a single
+   * trained model can be shared by concurrent threads that each call
+   * Classify().
    *
    * @param test Testing data or data to classify.
    * @param predictedLabels Vector to store the predicted classes after
    *     classifying test.
    */
-  void Classify(const MatType& test, arma::Row<size_t>& predictedLabels);
+  void Classify(const MatType& test,
+                arma::Row<size_t>& predictedLabels) const;
 
   /**
    * Serialize the perceptron.
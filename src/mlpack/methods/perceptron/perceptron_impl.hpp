@@ -104,7 +104,7 @@ template<
 >
 void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Classify(
     const MatType& test,
-    arma::Row<size_t>& predictedLabels)
+    arma::Row<size_t>& predictedLabels) const
 {
   arma::vec tempLabelMat;
   arma::uword maxIndex = 0;
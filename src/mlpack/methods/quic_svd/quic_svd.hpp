@@ -66,13 +66,18 @@ class QUIC_SVD
    * @param sigma Diagonal matrix of singular values.
    * @param epsilon Error tolerance fraction for calculated subspace.
    * @param delta Cumulative probability for Monte Carlo error lower bound.
+   * @param maxBasisSize Maximum size of the subspace basis; 0 means no limit.
+   *     A budget bounds the cosine tree construction time---useful for
+   *     interactive use---at the cost of a possibly larger reconstruction
+   *     error when the tolerance 'epsilon' cannot be reached within it.
    */
   QUIC_SVD(const arma::mat& dataset,
            arma::mat& u,
            arma::mat& v,
            arma::mat& sigma,
            const double epsilon = 0.03,
-           const double delta = 0.1);
+           const double delta = 0.1,
+           const size_t maxBasisSize = 0);
 
   /**
    * This function uses the vector subspace created using a cosine tree to
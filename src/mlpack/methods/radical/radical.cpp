@@ -70,24 +70,36 @@ double Radical::DoRadical2D(const mat& matX)
 {
   CopyAndPerturb(perturbed, matX);
 
-  mat::fixed<2, 2> matJacobi;
-
-  vec values(angles);
-
+  // Evaluate every candidate rotation with a single matrix product: columns
+  // 2i and 2i + 1 of the rotation bank hold the Jacobi rotation for the i'th
+  // angle, so the corresponding columns of the product are the two rotated
+  // coordinates for that angle.  This replaces one small matrix product per
+  // angle with one large one, which the BLAS handles far better.
+  mat rotations(2, 2 * angles);
   for (size_t i = 0; i < angles; ++i)
   {
     const double theta = (i / (double) angles) * M_PI / 2.0;
     const double cosTheta = cos(theta);
     const double sinTheta = sin(theta);
 
-    matJacobi(0, 0) = cosTheta;
-    matJacobi(1, 0) = -sinTheta;
-    matJacobi(0, 1) = sinTheta;
-    matJacobi(1, 1) = cosTheta;
+    rotations(0, 2 * i) = cosTheta;
+    rotations(1, 2 * i) = -sinTheta;
+    rotations(0, 2 * i + 1) = sinTheta;
+    rotations(1, 2 * i + 1) = cosTheta;
+  }
 
-    candidate = perturbed * matJacobi;
-    vec candidateY1 = candidate.unsafe_col(0);
-    vec candidateY2 = candidate.unsafe_col(1);
+  candidate = perturbed * rotations;
+
+  // The entropy estimates of the candidate angles are independent, and the
+  // sorts inside Vasicek() dominate the cost, so the angles are spread
+  // across threads.  Vasicek() sorts its argument in place, but each angle
+  // only touches its own two columns of the candidate matrix.
+  vec values(angles);
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) angles; ++i)
+  {
+    vec candidateY1 = candidate.unsafe_col(2 * i);
+    vec candidateY2 = candidate.unsafe_col(2 * i + 1);
 
     values(i) = Vasicek(candidateY1) + Vasicek(candidateY2);
   }
@@ -134,7 +146,7 @@ void Radical::DoRadical(const mat& matXT, mat& matY, mat& matW)
 
   mat matYSubspace(nPoints, 2);
 
-  mat matJ = eye(nDims, nDims);
+  vec yI(nPoints);
 
   for (size_t sweepNum = 0; sweepNum < sweeps; sweepNum++)
   {
@@ -155,19 +167,13 @@ void Radical::DoRadical(const mat& matXT, mat& matY, mat& matW)
         const double cosThetaOpt = cos(thetaOpt);
         const double sinThetaOpt = sin(thetaOpt);
 
-        // Set elements of transformation matrix.
-        matJ(i, i) = cosThetaOpt;
-        matJ(j, i) = -sinThetaOpt;
-        matJ(i, j) = sinThetaOpt;
-        matJ(j, j) = cosThetaOpt;
-
-        matY *= matJ;
-
-        // Unset elements of transformation matrix, so matJ = eye() again.
-        matJ(i, i) = 1;
-        matJ(j, i) = 0;
-        matJ(i, j) = 0;
-        matJ(j, j) = 1;
+        // Apply the rotation.  The Jacobi rotation for this pair of
+        // dimensions differs from the identity only in columns i and j, so
+        // only those two columns of matY change; updating them directly
+        // avoids a full matrix product per pair.
+        yI = matY.col(i);
+        matY.col(i) = cosThetaOpt * yI - sinThetaOpt * matY.col(j);
+        matY.col(j) = sinThetaOpt * yI + cosThetaOpt * matY.col(j);
       }
     }
   }
@@ -13,6 +13,8 @@
 #ifndef MLPACK_METHODS_RANDOM_FOREST_BOOTSTRAP_HPP
 #define MLPACK_METHODS_RANDOM_FOREST_BOOTSTRAP_HPP
 
+#include <mlpack/core/math/random_stream.hpp>
+
 namespace mlpack {
 namespace tree {
 
@@ -47,6 +49,27 @@ void Bootstrap(const MatType& dataset,
   }
 }
 
+/**
+ * Draw a bootstrap sample of the given number of points, returning only the
+ * sampled column indices.  This is for consumers that can train directly from
+ * indices into a shared dataset, so that no bootstrapped copy of the dataset
+ * needs to be materialized.
+ *
+ * The sample is drawn entirely from the given stream, so concurrent callers
+ * do not contend on (or consume from) the global generator, and keying one
+ * stream per logical sample makes the result independent of the number of
+ * threads.
+ */
+inline void Bootstrap(const size_t numPoints,
+                      arma::Row<size_t>& samples,
+                      math::RandomStream& stream)
+{
+  // Random sampling with replacement.
+  samples.set_size(numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+    samples[i] = (size_t) std::floor((double) numPoints * stream.Random());
+}
+
 } // namespace tree
 } // namespace mlpack
 
@@ -0,0 +1,149 @@
+/**
+ * @file methods/random_forest/compact_random_forest.hpp
+ *
+ * Definition of the CompactRandomForest class, a compact inference-only
+ * export of a trained RandomForest.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOM_FOREST_COMPACT_RANDOM_FOREST_HPP
+#define MLPACK_METHODS_RANDOM_FOREST_COMPACT_RANDOM_FOREST_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/map_policies/datatype.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * A compact, inference-only export of a trained RandomForest.  The nodes of
+ * every tree are flattened breadth-first into parallel arrays with narrowed
+ * types---float split thresholds, 16-bit feature indices, 32-bit child links
+ * and leaf class distributions quantized to 16 bits---so a serialized forest
+ * is several times smaller than the full RandomForest, and classification
+ * walks index-linked arrays instead of heap-allocated tree objects.
+ *
+ * The export covers binary numeric splits only (the default
+ * BestBinaryNumericSplit); building from a forest with categorical splits
+ * throws std::invalid_argument.  The exported forest can only classify: it
+ * cannot be trained further or converted back, so the original RandomForest
+ * should be kept wherever re-training matters.  Predictions may differ from
+ * the original forest for points that lie within float rounding of a split
+ * threshold or when leaf votes tie within quantization error.
+ *
+ * An empty CompactRandomForest can be constructed and then loaded from a
+ * serialized buffer via data::Load(), after which Classify() works directly
+ * on the loaded arrays.
+ */
+class CompactRandomForest
+{
+ public:
+  /**
+   * Construct an empty forest.  Classify() will throw an exception until a
+   * serialized forest is loaded.
+   */
+  CompactRandomForest() : numClasses(0) { }
+
+  /**
+   * Export the given trained random forest.
+   *
+   * @param forest Trained forest to export; it must use binary numeric
+   *     splits, have fewer than 65535 input dimensions, and hold fewer than
+   *     2^32 nodes in total.
+   */
+  template<typename RandomForestType>
+  explicit CompactRandomForest(const RandomForestType& forest);
+
+  /**
+   * Predict the class of the given point.  If no forest has been exported or
+   * loaded, this will throw an exception.
+   *
+   * @param point Point to be classified.
+   */
+  template<typename VecType>
+  size_t Classify(const VecType& point) const;
+
+  /**
+   * Predict the class of the given point and return the predicted class
+   * probabilities, reconstructed from the quantized leaf distributions.  If
+   * no forest has been exported or loaded, this will throw an exception.
+   *
+   * @param point Point to be classified.
+   * @param prediction size_t to store predicted class in.
+   * @param probabilities Output vector of class probabilities.
+   */
+  template<typename VecType>
+  void Classify(const VecType& point,
+                size_t& prediction,
+                arma::vec& probabilities) const;
+
+  /**
+   * Predict the classes of each point in the given dataset.  If no forest has
+   * been exported or loaded, this will throw an exception.
+   *
+   * All scratch state is local to the call, so multiple threads may call
+   * Classify() concurrently on a shared forest.
+   *
+   * @param data Dataset to be classified.
+   * @param predictions Output predictions for each point in the dataset.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data, arma::Row<size_t>& predictions) const;
+
+  //! Get the number of trees in the forest.
+  size_t NumTrees() const { return roots.size(); }
+
+  //! Get the number of classes in the forest.
+  size_t NumClasses() const { return numClasses; }
+
+  //! Get the total number of nodes (across all trees) in the forest.
+  size_t NumNodes() const { return featureIndices.size(); }
+
+  /**
+   * Serialize the compact forest.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Feature index that marks a leaf node.
+  static const uint16_t leafMarker = 0xFFFF;
+
+  //! Append the given node (without its children) to the flattened arrays.
+  template<typename TreeType>
+  void AppendNode(const TreeType& node);
+
+  //! Walk every tree for the given point and accumulate the quantized leaf
+  //! distributions into the given vote buffer, which is zeroed first.
+  template<typename VecType>
+  void AccumulateVotes(const VecType& point,
+                       arma::Col<uint64_t>& votes) const;
+
+  //! The number of classes in the forest.
+  size_t numClasses;
+  //! The index of each tree's root node.
+  std::vector<uint32_t> roots;
+  //! The split dimension of each node, or leafMarker for a leaf.
+  std::vector<uint16_t> featureIndices;
+  //! The split threshold of each node; points with values less than or equal
+  //! to it go to the first child.  Unused (zero) for leaves.
+  std::vector<float> thresholds;
+  //! For a split node, the index of its first child (the second child is
+  //! adjacent); for a leaf, the index of its distribution in
+  //! leafDistributions.
+  std::vector<uint32_t> childOrLeaf;
+  //! The class distributions of all leaves, numClasses entries per leaf,
+  //! quantized so that probability 1.0 maps to 65535.
+  std::vector<uint16_t> leafDistributions;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "compact_random_forest_impl.hpp"
+
+#endif
@@ -0,0 +1,256 @@
+/**
+ * @file methods/random_forest/compact_random_forest_impl.hpp
+ *
+ * Implementation of the CompactRandomForest class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOM_FOREST_COMPACT_RANDOM_FOREST_IMPL_HPP
+#define MLPACK_METHODS_RANDOM_FOREST_COMPACT_RANDOM_FOREST_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "compact_random_forest.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename RandomForestType>
+CompactRandomForest::CompactRandomForest(const RandomForestType& forest) :
+    numClasses(0)
+{
+  typedef typename RandomForestType::DecisionTreeType TreeType;
+
+  if (forest.NumTrees() == 0)
+  {
+    throw std::invalid_argument("CompactRandomForest(): cannot export an "
+        "untrained forest!");
+  }
+
+  numClasses = forest.Tree(0).NumClasses();
+
+  // Count the nodes up front so that all arrays can be allocated in one go.
+  size_t numNodes = 0;
+  size_t numLeaves = 0;
+  std::queue<const TreeType*> toCount;
+  for (size_t t = 0; t < forest.NumTrees(); ++t)
+    toCount.push(&forest.Tree(t));
+  while (!toCount.empty())
+  {
+    const TreeType* node = toCount.front();
+    toCount.pop();
+
+    ++numNodes;
+    if (node->NumChildren() == 0)
+      ++numLeaves;
+    for (size_t c = 0; c < node->NumChildren(); ++c)
+      toCount.push(&node->Child(c));
+  }
+
+  if (numNodes > std::numeric_limits<uint32_t>::max())
+  {
+    throw std::invalid_argument("CompactRandomForest(): forest has too many "
+        "nodes for 32-bit child links!");
+  }
+
+  roots.reserve(forest.NumTrees());
+  featureIndices.reserve(numNodes);
+  thresholds.reserve(numNodes);
+  childOrLeaf.reserve(numNodes);
+  leafDistributions.reserve(numLeaves * numClasses);
+
+  // Lay out the nodes of each tree in breadth-first order.  The two children
+  // of a split are appended together, so only the index of the first child
+  // needs to be stored.  The source pointers are only needed during layout.
+  std::vector<const TreeType*> sources;
+  sources.reserve(numNodes);
+  for (size_t t = 0; t < forest.NumTrees(); ++t)
+  {
+    roots.push_back((uint32_t) featureIndices.size());
+    AppendNode(forest.Tree(t));
+    sources.push_back(&forest.Tree(t));
+
+    std::queue<size_t> pending;
+    pending.push(roots[t]);
+    while (!pending.empty())
+    {
+      const size_t index = pending.front();
+      pending.pop();
+
+      const TreeType* source = sources[index];
+      if (source->NumChildren() == 0)
+        continue;
+
+      childOrLeaf[index] = (uint32_t) featureIndices.size();
+      for (size_t c = 0; c < source->NumChildren(); ++c)
+      {
+        AppendNode(source->Child(c));
+        sources.push_back(&source->Child(c));
+        pending.push(sources.size() - 1);
+      }
+    }
+  }
+}
+
+template<typename TreeType>
+void CompactRandomForest::AppendNode(const TreeType& node)
+{
+  if (node.NumChildren() == 0)
+  {
+    featureIndices.push_back((uint16_t) leafMarker);
+    thresholds.push_back(0.0f);
+    childOrLeaf.push_back((uint32_t) leafDistributions.size());
+
+    // Quantize the class distribution so that probability 1.0 maps to 65535.
+    const arma::vec& probabilities = node.ClassProbabilities();
+    for (size_t c = 0; c < numClasses; ++c)
+    {
+      leafDistributions.push_back(
+          (uint16_t) std::floor(65535.0 * probabilities[c] + 0.5));
+    }
+    return;
+  }
+
+  // Only binary numeric splits fit the feature-and-threshold node format.
+  if (node.NumChildren() != 2 || (data::Datatype)
+      node.DimensionTypeOrMajorityClass() != data::Datatype::numeric)
+  {
+    throw std::invalid_argument("CompactRandomForest(): only forests with "
+        "binary numeric splits can be exported!");
+  }
+
+  if (node.SplitDimension() >= leafMarker)
+  {
+    throw std::invalid_argument("CompactRandomForest(): split dimension too "
+        "large for 16-bit feature indices!");
+  }
+
+  // Narrow the threshold to float, rounding upwards if needed so that points
+  // equal to the original double threshold still go to the first child.
+  const double threshold = node.ClassProbabilities()[0];
+  float narrowed = (float) threshold;
+  if ((double) narrowed < threshold)
+  {
+    narrowed = std::nextafter(narrowed,
+        std::numeric_limits<float>::infinity());
+  }
+
+  featureIndices.push_back((uint16_t) node.SplitDimension());
+  thresholds.push_back(narrowed);
+  childOrLeaf.push_back(0); // Patched once the children are laid out.
+}
+
+template<typename VecType>
+void CompactRandomForest::AccumulateVotes(const VecType& point,
+                                          arma::Col<uint64_t>& votes) const
+{
+  votes.zeros();
+
+  for (size_t t = 0; t < roots.size(); ++t)
+  {
+    size_t current = roots[t];
+    while (featureIndices[current] != leafMarker)
+    {
+      const size_t direction =
+          (point[featureIndices[current]] <= thresholds[current]) ? 0 : 1;
+      current = childOrLeaf[current] + direction;
+    }
+
+    const size_t offset = childOrLeaf[current];
+    for (size_t c = 0; c < numClasses; ++c)
+      votes[c] += leafDistributions[offset + c];
+  }
+}
+
+template<typename VecType>
+size_t CompactRandomForest::Classify(const VecType& point) const
+{
+  // Check edge case.
+  if (roots.size() == 0)
+  {
+    throw std::invalid_argument("CompactRandomForest::Classify(): no forest "
+        "exported or loaded!");
+  }
+
+  arma::Col<uint64_t> votes(numClasses);
+  AccumulateVotes(point, votes);
+
+  arma::uword maxIndex = 0;
+  votes.max(maxIndex);
+  return (size_t) maxIndex;
+}
+
+template<typename VecType>
+void CompactRandomForest::Classify(const VecType& point,
+                                   size_t& prediction,
+                                   arma::vec& probabilities) const
+{
+  // Check edge case.
+  if (roots.size() == 0)
+  {
+    throw std::invalid_argument("CompactRandomForest::Classify(): no forest "
+        "exported or loaded!");
+  }
+
+  arma::Col<uint64_t> votes(numClasses);
+  AccumulateVotes(point, votes);
+
+  // Renormalize the quantized votes into probabilities.
+  probabilities = arma::conv_to<arma::vec>::from(votes);
+  probabilities /= arma::accu(probabilities);
+
+  arma::uword maxIndex = 0;
+  votes.max(maxIndex);
+  prediction = (size_t) maxIndex;
+}
+
+template<typename MatType>
+void CompactRandomForest::Classify(const MatType& data,
+                                   arma::Row<size_t>& predictions) const
+{
+  // Check edge case.
+  if (roots.size() == 0)
+  {
+    predictions.clear();
+
+    throw std::invalid_argument("CompactRandomForest::Classify(): no forest "
+        "exported or loaded!");
+  }
+
+  predictions.set_size(data.n_cols);
+
+  // The flattened arrays are shared read-only by all threads, and each thread
+  // reuses one vote buffer for its whole share of the batch.
+  #pragma omp parallel
+  {
+    arma::Col<uint64_t> votes(numClasses);
+
+    #pragma omp for
+    for (omp_size_t i = 0; i < data.n_cols; ++i)
+    {
+      AccumulateVotes(data.col(i), votes);
+
+      arma::uword maxIndex = 0;
+      votes.max(maxIndex);
+      predictions[i] = (size_t) maxIndex;
+    }
+  }
+}
+
+template<typename Archive>
+void CompactRandomForest::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(numClasses));
+  ar(CEREAL_NVP(roots));
+  ar(CEREAL_NVP(featureIndices));
+  ar(CEREAL_NVP(thresholds));
+  ar(CEREAL_NVP(childOrLeaf));
+  ar(CEREAL_NVP(leafDistributions));
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -16,6 +16,8 @@
 #include <mlpack/methods/decision_tree/multiple_random_dimension_select.hpp>
 #include "bootstrap.hpp"
 
+#include <queue>
+
 namespace mlpack {
 namespace tree {
 
@@ -303,6 +305,9 @@ class RandomForest
    * Predict the classes of each point in the given dataset.  If the random
    * forest has not been trained, this will throw an exception.
    *
+   * All scratch state is local to the call, so multiple threads may call
+   * Classify() concurrently on a shared trained forest.
+   *
    * @param data Dataset to be classified.
    * @param predictions Output predictions for each point in the dataset.
    */
@@ -371,6 +376,72 @@ class RandomForest
                const size_t maximumDepth,
                DimensionSelectionType& dimensionSelector);
 
+  /**
+   * A flattened, read-only copy of every tree in the forest.  The nodes of
+   * all trees are laid out breadth-first in one contiguous array, with the
+   * children of each node adjacent to each other, and the class probabilities
+   * of every leaf are collected into one matrix.  Batch classification builds
+   * this once per call, so that the traversal of each query point walks
+   * index-linked nodes in a single allocation instead of chasing per-node
+   * heap pointers, and the votes of a leaf can be accumulated without copying
+   * a probability vector.
+   */
+  class FlatForest
+  {
+   public:
+    /**
+     * Flatten the given trees.  The trees must outlive this object, since the
+     * split types' auxiliary information is read from the original nodes.
+     *
+     * @param trees Trees of the forest; must contain at least one tree.
+     */
+    FlatForest(const std::vector<DecisionTreeType>& trees);
+
+    /**
+     * Accumulate the class votes of every tree for the given point.  The vote
+     * buffer must already have one element per class; it is zeroed and then
+     * filled with the sum of the leaf class probabilities over all trees.
+     *
+     * @param point Point to classify.
+     * @param votes Vote buffer of length equal to the number of classes.
+     */
+    template<typename VecType>
+    void AccumulateVotes(const VecType& point, arma::vec& votes) const;
+
+   private:
+    //! A single flattened tree node.
+    struct FlatNode
+    {
+      //! The dimension the node splits on (non-leaf nodes only).
+      size_t splitDimension;
+      //! The type of the split dimension (non-leaf nodes only).
+      size_t dimensionType;
+      //! Index of the node's first child; children are laid out adjacently.
+      size_t firstChild;
+      //! Number of children; 0 for a leaf.
+      size_t numChildren;
+      //! Column of leafProbabilities with the node's class probabilities
+      //! (leaf nodes only).
+      size_t probabilitiesColumn;
+      //! Split information used by the split type's CalculateDirection()
+      //! (non-leaf nodes only).
+      arma::vec splitInfo;
+      //! The original node, for the split types' auxiliary information.
+      const DecisionTreeType* source;
+    };
+
+    //! Create the flattened version of a single node, assigning the next leaf
+    //! probabilities column if the node is a leaf.
+    FlatNode MakeFlatNode(const DecisionTreeType& source, size_t& leafIndex);
+
+    //! The nodes of all trees, breadth-first per tree.
+    std::vector<FlatNode> nodes;
+    //! The index of each tree's root node in nodes.
+    std::vector<size_t> roots;
+    //! The class probabilities of every leaf, one column per leaf.
+    arma::mat leafProbabilities;
+  };
+
   //! The trees in the forest.
   std::vector<DecisionTreeType> trees;
 };
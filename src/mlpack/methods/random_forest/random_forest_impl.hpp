@@ -362,10 +362,24 @@ void RandomForest<
 
   predictions.set_size(data.n_cols);
 
-  #pragma omp parallel for
-  for (omp_size_t i = 0; i < data.n_cols; ++i)
+  // Flatten the forest once; the flat layout is shared read-only by all
+  // threads, and each thread reuses one vote buffer for its whole share of
+  // the batch.
+  const FlatForest flatForest(trees);
+
+  #pragma omp parallel
   {
-    predictions[i] = Classify(data.col(i));
+    arma::vec votes(trees[0].NumClasses());
+
+    #pragma omp for
+    for (omp_size_t i = 0; i < data.n_cols; ++i)
+    {
+      flatForest.AccumulateVotes(data.col(i), votes);
+
+      arma::uword maxIndex = 0;
+      votes.max(maxIndex);
+      predictions[i] = (size_t) maxIndex;
+    }
   }
 }
 
@@ -399,11 +413,27 @@ void RandomForest<
 
   probabilities.set_size(trees[0].NumClasses(), data.n_cols);
   predictions.set_size(data.n_cols);
-  #pragma omp parallel for
-  for (omp_size_t i = 0; i < data.n_cols; ++i)
+
+  // Flatten the forest once; see the overload above.
+  const FlatForest flatForest(trees);
+
+  #pragma omp parallel
   {
-    arma::vec probs = probabilities.unsafe_col(i);
-    Classify(data.col(i), predictions[i], probs);
+    arma::vec votes(trees[0].NumClasses());
+
+    #pragma omp for
+    for (omp_size_t i = 0; i < data.n_cols; ++i)
+    {
+      flatForest.AccumulateVotes(data.col(i), votes);
+
+      // Renormalize the votes into probabilities.
+      votes /= trees.size();
+      probabilities.col(i) = votes;
+
+      arma::uword maxIndex = 0;
+      votes.max(maxIndex);
+      predictions[i] = (size_t) maxIndex;
+    }
   }
 }
 
@@ -467,15 +497,31 @@ double RandomForest<
   trees.resize(numTrees); // This will fill the vector with untrained trees.
   double avgGain = 0.0;
 
+  // Sort each numeric dimension exactly once; every tree shares the resulting
+  // index, so numeric split selection recovers sorted orders from cached ranks
+  // instead of re-sorting the same columns in every node of every tree.
+  PresortedIndex presortedIndex;
+  if (UseDatasetInfo)
+    presortedIndex.Build(dataset, datasetInfo);
+  else
+    presortedIndex.Build(dataset);
+
+  // Each tree draws its bootstrap sample from its own counter-based stream,
+  // keyed by the tree index, so the trained forest does not depend on the
+  // number of threads; one draw of the global generator separates successive
+  // Train() calls.
+  const uint64_t bootstrapStreamBase = math::randGen();
+
+  // Each tree trains on a row of sampled column indices into the shared
+  // read-only dataset, so no per-tree bootstrapped copy of the data matrix is
+  // made and peak memory use no longer scales with the number of threads.
   #pragma omp parallel for reduction( + : avgGain)
   for (omp_size_t i = 0; i < numTrees; ++i)
   {
     Timer::Start("bootstrap");
-    MatType bootstrapDataset;
-    arma::Row<size_t> bootstrapLabels;
-    arma::rowvec bootstrapWeights;
-    Bootstrap<UseWeights>(dataset, labels, weights, bootstrapDataset,
-        bootstrapLabels, bootstrapWeights);
+    math::RandomStream bootstrapStream(bootstrapStreamBase + i);
+    arma::Row<size_t> bootstrapSamples;
+    Bootstrap(dataset.n_cols, bootstrapSamples, bootstrapStream);
     Timer::Stop("bootstrap");
 
     // Now build the decision tree.
@@ -484,29 +530,30 @@ double RandomForest<
     {
       if (UseDatasetInfo)
       {
-        avgGain += trees[i].Train(bootstrapDataset, datasetInfo,
-            bootstrapLabels, numClasses, bootstrapWeights, minimumLeafSize,
-            minimumGainSplit, maximumDepth, dimensionSelector);
+        avgGain += trees[i].Train(dataset, bootstrapSamples, datasetInfo,
+            labels, numClasses, weights, minimumLeafSize, minimumGainSplit,
+            maximumDepth, dimensionSelector, &presortedIndex);
       }
       else
       {
-        avgGain += trees[i].Train(bootstrapDataset, bootstrapLabels, numClasses,
-            bootstrapWeights, minimumLeafSize, minimumGainSplit, maximumDepth,
-            dimensionSelector);
+        avgGain += trees[i].Train(dataset, bootstrapSamples, labels,
+            numClasses, weights, minimumLeafSize, minimumGainSplit,
+            maximumDepth, dimensionSelector, &presortedIndex);
       }
     }
     else
     {
       if (UseDatasetInfo)
       {
-        avgGain += trees[i].Train(bootstrapDataset, datasetInfo,
-            bootstrapLabels, numClasses, minimumLeafSize, minimumGainSplit,
-            maximumDepth, dimensionSelector);
+        avgGain += trees[i].Train(dataset, bootstrapSamples, datasetInfo,
+            labels, numClasses, minimumLeafSize, minimumGainSplit,
+            maximumDepth, dimensionSelector, &presortedIndex);
       }
       else
       {
-        avgGain += trees[i].Train(bootstrapDataset, bootstrapLabels, numClasses,
-            minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector);
+        avgGain += trees[i].Train(dataset, bootstrapSamples, labels,
+            numClasses, minimumLeafSize, minimumGainSplit, maximumDepth,
+            dimensionSelector, &presortedIndex);
       }
     }
     Timer::Stop("train_tree");
@@ -514,6 +561,165 @@ double RandomForest<
   return avgGain / numTrees;
 }
 
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    typename ElemType
+>
+RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    ElemType
+>::FlatForest::FlatForest(const std::vector<DecisionTreeType>& trees)
+{
+  // Count the nodes and leaves so that all storage can be allocated up front;
+  // this keeps the node array in one contiguous allocation.
+  size_t numNodes = 0;
+  size_t numLeaves = 0;
+  std::queue<const DecisionTreeType*> toCount;
+  for (size_t t = 0; t < trees.size(); ++t)
+    toCount.push(&trees[t]);
+  while (!toCount.empty())
+  {
+    const DecisionTreeType* node = toCount.front();
+    toCount.pop();
+
+    ++numNodes;
+    if (node->NumChildren() == 0)
+      ++numLeaves;
+    for (size_t c = 0; c < node->NumChildren(); ++c)
+      toCount.push(&node->Child(c));
+  }
+
+  nodes.reserve(numNodes);
+  roots.resize(trees.size());
+  leafProbabilities.set_size(trees[0].NumClasses(), numLeaves);
+
+  // Lay out the nodes of each tree in breadth-first order.  The children of a
+  // node are created together, so only the index of the first child needs to
+  // be stored.
+  size_t leafIndex = 0;
+  for (size_t t = 0; t < trees.size(); ++t)
+  {
+    roots[t] = nodes.size();
+    nodes.push_back(MakeFlatNode(trees[t], leafIndex));
+
+    std::queue<size_t> pending;
+    pending.push(roots[t]);
+    while (!pending.empty())
+    {
+      const size_t index = pending.front();
+      pending.pop();
+
+      const DecisionTreeType* source = nodes[index].source;
+      if (source->NumChildren() == 0)
+        continue;
+
+      nodes[index].firstChild = nodes.size();
+      for (size_t c = 0; c < source->NumChildren(); ++c)
+      {
+        nodes.push_back(MakeFlatNode(source->Child(c), leafIndex));
+        pending.push(nodes.size() - 1);
+      }
+    }
+  }
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    typename ElemType
+>
+typename RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    ElemType
+>::FlatForest::FlatNode RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    ElemType
+>::FlatForest::MakeFlatNode(const DecisionTreeType& source, size_t& leafIndex)
+{
+  FlatNode node;
+  node.splitDimension = 0;
+  node.dimensionType = 0;
+  node.firstChild = 0;
+  node.numChildren = source.NumChildren();
+  node.probabilitiesColumn = 0;
+  node.source = &source;
+
+  if (node.numChildren == 0)
+  {
+    node.probabilitiesColumn = leafIndex;
+    leafProbabilities.col(leafIndex) = source.ClassProbabilities();
+    ++leafIndex;
+  }
+  else
+  {
+    node.splitDimension = source.SplitDimension();
+    node.dimensionType = source.DimensionTypeOrMajorityClass();
+    node.splitInfo = source.ClassProbabilities();
+  }
+
+  return node;
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    typename ElemType
+>
+template<typename VecType>
+void RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    ElemType
+>::FlatForest::AccumulateVotes(const VecType& point, arma::vec& votes) const
+{
+  votes.zeros();
+
+  for (size_t t = 0; t < roots.size(); ++t)
+  {
+    size_t current = roots[t];
+    while (nodes[current].numChildren != 0)
+    {
+      const FlatNode& node = nodes[current];
+
+      // Dispatch to the split type, exactly as
+      // DecisionTree::CalculateDirection() does.
+      size_t direction;
+      if ((data::Datatype) node.dimensionType == data::Datatype::categorical)
+      {
+        direction = DecisionTreeType::CategoricalSplit::CalculateDirection(
+            point[node.splitDimension], node.splitInfo, *node.source);
+      }
+      else
+      {
+        direction = DecisionTreeType::NumericSplit::CalculateDirection(
+            point[node.splitDimension], node.splitInfo, *node.source);
+      }
+
+      current = node.firstChild + direction;
+    }
+
+    votes += leafProbabilities.unsafe_col(nodes[current].probabilitiesColumn);
+  }
+}
+
 } // namespace tree
 } // namespace mlpack
 
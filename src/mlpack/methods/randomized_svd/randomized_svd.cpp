@@ -72,5 +72,109 @@ void RandomizedSVD::Apply(const arma::mat& data,
   Apply(data, u, s, v, rank, rowMean);
 }
 
+void RandomizedSVD::Apply(data::ChunkedReader& reader,
+                          arma::mat& u,
+                          arma::vec& s,
+                          arma::mat& v,
+                          const size_t rank)
+{
+  if (iteratedPower == 0)
+    iteratedPower = rank + 2;
+
+  const size_t dim = reader.Dimensionality();
+
+  // First pass: apply the data to a random matrix, one chunk at a time.
+  // Each chunk sees its own block of the random matrix, so the full
+  // points-by-iteratedPower random matrix is never formed.
+  arma::mat Q(dim, iteratedPower, arma::fill::zeros);
+  arma::mat chunk;
+  size_t points = 0;
+  reader.Reset();
+  while (reader.ReadChunk(chunk) > 0)
+  {
+    Q += chunk * arma::randn<arma::mat>(chunk.n_cols, iteratedPower);
+    points += chunk.n_cols;
+  }
+
+  if (points == 0)
+  {
+    u.reset();
+    s.reset();
+    v.reset();
+    return;
+  }
+
+  CholeskyQR(Q);
+
+  // Power iterations: both products of Q <- orth(A * (A^T * Q)) are
+  // accumulated in the same pass over the data.  Each chunk's slice of the
+  // intermediate A^T * Q is applied immediately, so the intermediate is never
+  // stored and each iteration reads the data exactly once.
+  for (size_t i = 0; i < maxIterations; ++i)
+  {
+    arma::mat z(dim, iteratedPower, arma::fill::zeros);
+    reader.Reset();
+    while (reader.ReadChunk(chunk) > 0)
+      z += chunk * (chunk.t() * Q);
+
+    Q = std::move(z);
+    CholeskyQR(Q);
+  }
+
+  // Final pass: project the data onto the basis, then compute the small SVD
+  // of the projection.
+  arma::mat projection(iteratedPower, points);
+  size_t offset = 0;
+  reader.Reset();
+  while (reader.ReadChunk(chunk) > 0)
+  {
+    projection.cols(offset, offset + chunk.n_cols - 1) = Q.t() * chunk;
+    offset += chunk.n_cols;
+  }
+
+  arma::mat uProjection;
+  arma::svd_econ(uProjection, s, v, projection);
+  u = Q * uProjection;
+}
+
+void RandomizedSVD::CholeskyQR(arma::mat& Y)
+{
+  // Accumulate the Gram matrix Y^T * Y over row blocks; the blocks are
+  // independent, so they can be computed in parallel and summed.
+  const size_t blockSize = 4096;
+  arma::mat gram(Y.n_cols, Y.n_cols, arma::fill::zeros);
+  const size_t blocks = (Y.n_rows + blockSize - 1) / blockSize;
+
+  #pragma omp parallel
+  {
+    arma::mat localGram(Y.n_cols, Y.n_cols, arma::fill::zeros);
+
+    #pragma omp for schedule(dynamic) nowait
+    for (omp_size_t b = 0; b < (omp_size_t) blocks; ++b)
+    {
+      const size_t begin = b * blockSize;
+      const size_t end = std::min(begin + blockSize, (size_t) Y.n_rows) - 1;
+      localGram += arma::trans(Y.rows(begin, end)) * Y.rows(begin, end);
+    }
+
+    #pragma omp critical
+    gram += localGram;
+  }
+
+  // If the columns are numerically rank deficient the Cholesky factorization
+  // fails; fall back to a pivoted QR decomposition in that case.
+  arma::mat r;
+  if (arma::chol(r, gram))
+  {
+    Y *= arma::inv(arma::trimatu(r));
+  }
+  else
+  {
+    arma::mat q;
+    arma::qr_econ(q, r, Y);
+    Y = std::move(q);
+  }
+}
+
 } // namespace svd
 } // namespace mlpack
@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_RANDOMIZED_SVD_RANDOMIZED_SVD_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/chunked_reader.hpp>
 
 namespace mlpack {
 namespace svd {
@@ -136,6 +137,34 @@ class RandomizedSVD
              arma::mat& v,
              const size_t rank);
 
+  /**
+   * Apply randomized SVD to a dataset too large to fit in memory, streaming
+   * it from the given ChunkedReader (one point per column, following mlpack's
+   * convention).  The dataset is read once to build the initial random
+   * projection, once per power iteration, and once for the final projection;
+   * within each power iteration the two products of
+   * \f$ Q \leftarrow orth(A (A^T Q)) \f$ are fused, so the
+   * points-by-iteratedPower intermediate \f$ A^T Q \f$ is never stored and
+   * each iteration costs exactly one read of the data.  Orthonormalization
+   * uses a Cholesky-based tall-skinny QR whose Gram matrix is accumulated in
+   * parallel.
+   *
+   * Unlike the in-memory overloads, the data are used as-is: no centering is
+   * performed, which is the usual setting for the large sparse matrices this
+   * overload is intended for.
+   *
+   * @param reader Chunked reader to stream the data matrix from.
+   * @param u First unitary matrix.
+   * @param s Diagonal "Sigma" matrix of singular values.
+   * @param v Second unitary matrix.
+   * @param rank Rank of the approximation.
+   */
+  void Apply(data::ChunkedReader& reader,
+             arma::mat& u,
+             arma::vec& s,
+             arma::mat& v,
+             const size_t rank);
+
   /**
    * Apply Principal Component Analysis to the provided matrix data set
    * using the randomized SVD.
@@ -247,6 +276,17 @@ class RandomizedSVD
   double& Epsilon() { return eps; }
 
  private:
+  /**
+   * Orthonormalize the columns of the given tall-skinny matrix in place,
+   * using the Cholesky factor of its Gram matrix (CholeskyQR).  The Gram
+   * matrix is accumulated over row blocks in parallel with OpenMP; if the
+   * Cholesky factorization fails (the columns are numerically rank
+   * deficient), a pivoted QR decomposition is used as a fallback.
+   *
+   * @param Y Matrix whose columns are orthonormalized in place.
+   */
+  void CholeskyQR(arma::mat& Y);
+
   //! Locally stored size of the normalized power iterations.
   size_t iteratedPower;
 
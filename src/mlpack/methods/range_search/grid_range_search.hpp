@@ -0,0 +1,156 @@
+/**
+ * @file methods/range_search/grid_range_search.hpp
+ *
+ * Definition of the GridRangeSearch class, a uniform-grid backend for range
+ * search on low-dimensional data.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANGE_SEARCH_GRID_RANGE_SEARCH_HPP
+#define MLPACK_METHODS_RANGE_SEARCH_GRID_RANGE_SEARCH_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/range.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+
+namespace mlpack {
+namespace range {
+
+/**
+ * The GridRangeSearch class performs range search with a uniform grid instead
+ * of a tree.  The reference points are bucketed into the cells of a regular
+ * grid over (up to) the first three dimensions, with the per-cell point lists
+ * held contiguously in CSR form; a query enumerates the cells overlapping its
+ * search ball and filters the candidate points by exact distance.  On
+ * low-dimensional data (d <= 3) with reasonably uniform density this is much
+ * faster than a tree traversal, since cell lookup is arithmetic and the
+ * candidate points of each cell are contiguous in memory.
+ *
+ * For data with more than three dimensions the grid is built over the first
+ * three dimensions only; the results remain exact because candidates are
+ * always filtered with the full-dimensional distance, but the grid prunes
+ * less, so trees will usually be the better choice there.
+ *
+ * The interface mirrors the parts of the RangeSearch interface that the
+ * RSModel visitors use, so the class can be selected through
+ * RSModel::TreeTypes::GRID.
+ */
+class GridRangeSearch
+{
+ public:
+  /**
+   * Construct the GridRangeSearch object.  The parameters mirror the
+   * RangeSearch constructor; naive and singleMode have no effect on the grid
+   * backend but are kept so the RSModel interface is uniform.
+   *
+   * @param naive Unused by the grid backend.
+   * @param singleMode Unused by the grid backend.
+   */
+  GridRangeSearch(const bool naive = false, const bool singleMode = false);
+
+  /**
+   * Bucket the given reference set into the grid.  The average number of
+   * points per cell is kept near one by choosing the grid resolution from the
+   * number of points.
+   *
+   * @param referenceSet Set of reference points.
+   */
+  void Train(arma::mat referenceSet);
+
+  /**
+   * Perform bichromatic range search with the given query set, returning, for
+   * each query point, the indices of the reference points in the given range
+   * and the distances to them.  The output format matches
+   * RangeSearch<>::Search().
+   *
+   * @param querySet Set of query points.
+   * @param range Range of distances to search for.
+   * @param neighbors Output: neighbors falling within the desired range.
+   * @param distances Output: distances of neighbors.
+   */
+  void Search(const arma::mat& querySet,
+              const math::Range& range,
+              std::vector<std::vector<size_t>>& neighbors,
+              std::vector<std::vector<double>>& distances) const;
+
+  /**
+   * Perform monochromatic range search with the reference set as the query
+   * set.  A point is not returned as its own neighbor.
+   *
+   * @param range Range of distances to search for.
+   * @param neighbors Output: neighbors falling within the desired range.
+   * @param distances Output: distances of neighbors.
+   */
+  void Search(const math::Range& range,
+              std::vector<std::vector<size_t>>& neighbors,
+              std::vector<std::vector<double>>& distances) const;
+
+  //! Get whether single-tree search is used (meaningless for the grid).
+  bool SingleMode() const { return singleMode; }
+  //! Modify whether single-tree search is used (meaningless for the grid).
+  bool& SingleMode() { return singleMode; }
+
+  //! Get whether naive search is used (meaningless for the grid).
+  bool Naive() const { return naive; }
+  //! Modify whether naive search is used (meaningless for the grid).
+  bool& Naive() { return naive; }
+
+  //! Get the reference set.
+  const arma::mat& ReferenceSet() const { return referenceSet; }
+
+  //! Get the number of cells per gridded dimension.
+  size_t CellsPerDimension() const { return cellsPerDim; }
+
+  //! Serialize the grid.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  /**
+   * Search for the neighbors of a single query point and emit them into the
+   * output lists.  If selfIndex is not size_t(-1), the reference point with
+   * that index is skipped (for monochromatic search).
+   */
+  template<typename VecType>
+  void SearchPoint(const VecType& point,
+                   const math::Range& range,
+                   const size_t selfIndex,
+                   std::vector<size_t>& neighbors,
+                   std::vector<double>& distances) const;
+
+  //! Compute the cell coordinate of a value in the given gridded dimension.
+  size_t CellCoordinate(const double value, const size_t d) const;
+
+  //! The reference set.
+  arma::mat referenceSet;
+
+  //! The number of gridded dimensions (at most 3).
+  size_t gridDims;
+  //! The number of cells in each gridded dimension.
+  size_t cellsPerDim;
+  //! The lower corner of the grid (length gridDims).
+  arma::vec minCorner;
+  //! The width of a cell in each gridded dimension (length gridDims).
+  arma::vec cellWidths;
+
+  //! Offset of each cell's point list (length #cells + 1; CSR layout).
+  arma::uvec cellOffsets;
+  //! Point indices bucketed by cell, contiguous per cell.
+  arma::uvec pointIndices;
+
+  //! Unused; kept for interface uniformity with RangeSearch.
+  bool naive;
+  //! Unused; kept for interface uniformity with RangeSearch.
+  bool singleMode;
+};
+
+} // namespace range
+} // namespace mlpack
+
+// Include implementation.
+#include "grid_range_search_impl.hpp"
+
+#endif
@@ -0,0 +1,222 @@
+/**
+ * @file methods/range_search/grid_range_search_impl.hpp
+ *
+ * Implementation of the GridRangeSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANGE_SEARCH_GRID_RANGE_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_RANGE_SEARCH_GRID_RANGE_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "grid_range_search.hpp"
+
+namespace mlpack {
+namespace range {
+
+inline GridRangeSearch::GridRangeSearch(const bool naive,
+                                        const bool singleMode) :
+    gridDims(0),
+    cellsPerDim(1),
+    naive(naive),
+    singleMode(singleMode)
+{
+  // Nothing to do.
+}
+
+inline void GridRangeSearch::Train(arma::mat referenceSet)
+{
+  this->referenceSet = std::move(referenceSet);
+
+  const size_t n = this->referenceSet.n_cols;
+  gridDims = std::min((size_t) this->referenceSet.n_rows, (size_t) 3);
+
+  // Aim for about one point per cell on average, but keep the total cell
+  // count bounded.
+  cellsPerDim = (n > 0 && gridDims > 0) ?
+      (size_t) std::ceil(std::pow((double) n, 1.0 / gridDims)) : 1;
+  cellsPerDim = std::min(cellsPerDim, (size_t) 1024);
+  cellsPerDim = std::max(cellsPerDim, (size_t) 1);
+
+  minCorner.set_size(gridDims);
+  cellWidths.set_size(gridDims);
+  size_t numCells = 1;
+  for (size_t d = 0; d < gridDims; ++d)
+  {
+    minCorner[d] = (n > 0) ? this->referenceSet.row(d).min() : 0.0;
+    const double maxValue = (n > 0) ? this->referenceSet.row(d).max() : 0.0;
+    cellWidths[d] = (maxValue - minCorner[d]) / cellsPerDim;
+    if (cellWidths[d] <= 0.0)
+      cellWidths[d] = 1.0;
+
+    numCells *= cellsPerDim;
+  }
+
+  // Bucket the points into the cells with a counting sort, so each cell's
+  // point list is a contiguous slice of pointIndices (CSR layout).
+  cellOffsets.zeros(numCells + 1);
+  pointIndices.set_size(n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    size_t cell = 0;
+    size_t stride = 1;
+    for (size_t d = 0; d < gridDims; ++d)
+    {
+      cell += CellCoordinate(this->referenceSet(d, i), d) * stride;
+      stride *= cellsPerDim;
+    }
+
+    cellOffsets[cell + 1]++;
+  }
+
+  for (size_t c = 1; c <= numCells; ++c)
+    cellOffsets[c] += cellOffsets[c - 1];
+
+  arma::uvec cursor = cellOffsets.head(numCells);
+  for (size_t i = 0; i < n; ++i)
+  {
+    size_t cell = 0;
+    size_t stride = 1;
+    for (size_t d = 0; d < gridDims; ++d)
+    {
+      cell += CellCoordinate(this->referenceSet(d, i), d) * stride;
+      stride *= cellsPerDim;
+    }
+
+    pointIndices[cursor[cell]++] = i;
+  }
+}
+
+inline size_t GridRangeSearch::CellCoordinate(const double value,
+                                              const size_t d) const
+{
+  const double c = (value - minCorner[d]) / cellWidths[d];
+  if (!(c > 0.0))
+    return 0;
+  if (c >= (double) cellsPerDim)
+    return cellsPerDim - 1;
+  return (size_t) c;
+}
+
+template<typename VecType>
+void GridRangeSearch::SearchPoint(const VecType& point,
+                                  const math::Range& range,
+                                  const size_t selfIndex,
+                                  std::vector<size_t>& neighbors,
+                                  std::vector<double>& distances) const
+{
+  // The cells overlapping the search ball form an axis-aligned box of cell
+  // coordinates.
+  size_t loCell[3];
+  size_t hiCell[3];
+  size_t coord[3];
+  for (size_t d = 0; d < gridDims; ++d)
+  {
+    loCell[d] = CellCoordinate((double) point[d] - range.Hi(), d);
+    hiCell[d] = CellCoordinate((double) point[d] + range.Hi(), d);
+    coord[d] = loCell[d];
+  }
+
+  while (true)
+  {
+    size_t cell = 0;
+    size_t stride = 1;
+    for (size_t d = 0; d < gridDims; ++d)
+    {
+      cell += coord[d] * stride;
+      stride *= cellsPerDim;
+    }
+
+    // Filter the candidates of this cell by exact distance.
+    for (size_t k = cellOffsets[cell]; k < cellOffsets[cell + 1]; ++k)
+    {
+      const size_t index = pointIndices[k];
+      if (index == selfIndex)
+        continue;
+
+      const double distance = metric::EuclideanDistance::Evaluate(point,
+          referenceSet.col(index));
+      if (range.Contains(distance))
+      {
+        neighbors.push_back(index);
+        distances.push_back(distance);
+      }
+    }
+
+    // Advance to the next cell of the box.
+    size_t d = 0;
+    while (d < gridDims)
+    {
+      if (coord[d] < hiCell[d])
+      {
+        coord[d]++;
+        break;
+      }
+
+      coord[d] = loCell[d];
+      ++d;
+    }
+    if (d == gridDims)
+      break;
+  }
+}
+
+inline void GridRangeSearch::Search(
+    const arma::mat& querySet,
+    const math::Range& range,
+    std::vector<std::vector<size_t>>& neighbors,
+    std::vector<std::vector<double>>& distances) const
+{
+  neighbors.clear();
+  neighbors.resize(querySet.n_cols);
+  distances.clear();
+  distances.resize(querySet.n_cols);
+
+  // Each query point is independent.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+  {
+    SearchPoint(querySet.col(i), range, size_t(-1), neighbors[i],
+        distances[i]);
+  }
+}
+
+inline void GridRangeSearch::Search(
+    const math::Range& range,
+    std::vector<std::vector<size_t>>& neighbors,
+    std::vector<std::vector<double>>& distances) const
+{
+  neighbors.clear();
+  neighbors.resize(referenceSet.n_cols);
+  distances.clear();
+  distances.resize(referenceSet.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) referenceSet.n_cols; ++i)
+  {
+    SearchPoint(referenceSet.col(i), range, (size_t) i, neighbors[i],
+        distances[i]);
+  }
+}
+
+template<typename Archive>
+void GridRangeSearch::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(referenceSet));
+  ar(CEREAL_NVP(gridDims));
+  ar(CEREAL_NVP(cellsPerDim));
+  ar(CEREAL_NVP(minCorner));
+  ar(CEREAL_NVP(cellWidths));
+  ar(CEREAL_NVP(cellOffsets));
+  ar(CEREAL_NVP(pointIndices));
+  ar(CEREAL_NVP(naive));
+  ar(CEREAL_NVP(singleMode));
+}
+
+} // namespace range
+} // namespace mlpack
+
+#endif
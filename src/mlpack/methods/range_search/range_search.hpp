@@ -16,6 +16,8 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/metrics/lmetric.hpp>
 #include <mlpack/core/tree/binary_space_tree.hpp>
+#include <mlpack/core/tree/traversal_statistics.hpp>
+#include "range_search_results.hpp"
 #include "range_search_stat.hpp"
 
 namespace mlpack {
@@ -259,6 +261,72 @@ class RangeSearch
               std::vector<std::vector<size_t>>& neighbors,
               std::vector<std::vector<double>>& distances);
 
+  /**
+   * Search for all reference points in the given range for each point in the
+   * query set, storing the results in the given arena-backed results object.
+   * This produces the same results as the vector-of-vectors overload, but
+   * stores them in flat arrays (compressed sparse row layout), so the number
+   * of heap allocations is independent of the number of query points.  For
+   * very large query sets with small result lists this is considerably
+   * faster; see the RangeSearchResults documentation for the layout and
+   * accessors.
+   *
+   * Any results already in the given object are cleared.  Within each query
+   * point's results, neighbors are not sorted in any particular order.
+   *
+   * @param querySet Set of query points to search with.
+   * @param range Range of distances in which to search.
+   * @param results Object which will hold the results of the search.
+   */
+  void Search(const MatType& querySet,
+              const math::Range& range,
+              RangeSearchResults& results);
+
+  /**
+   * Given a pre-built query tree, search for all reference points in the
+   * given range for each point in the query set, storing the results in the
+   * given arena-backed results object.  This produces the same results as the
+   * vector-of-vectors overload, but stores them in flat arrays (compressed
+   * sparse row layout); see the RangeSearchResults documentation.
+   *
+   * If either naive or singleMode are set to true, this will throw an
+   * invalid_argument exception; passing in a query tree implies dual-tree
+   * search.
+   *
+   * Any results already in the given object are cleared.  Within each query
+   * point's results, neighbors are not sorted in any particular order.
+   *
+   * @param queryTree Tree built on query points.
+   * @param range Range of distances in which to search.
+   * @param results Object which will hold the results of the search.
+   */
+  void Search(Tree* queryTree,
+              const math::Range& range,
+              RangeSearchResults& results);
+
+  /**
+   * Search for all points in the given range for each point in the reference
+   * set (which was passed to the constructor), storing the results in the
+   * given arena-backed results object.  This means that the query set and the
+   * reference set are the same.  This produces the same results as the
+   * vector-of-vectors overload, but stores them in flat arrays (compressed
+   * sparse row layout); see the RangeSearchResults documentation.
+   *
+   * In dual-tree mode, this overload uses a self-join traversal when the tree
+   * type allows it: each unordered pair of tree nodes is scored only once and
+   * each qualifying pair of points is found only once, roughly halving the
+   * work compared to the symmetric traversal; the mirrored results are then
+   * restored with one linear pass over the arena.
+   *
+   * Any results already in the given object are cleared.  Within each query
+   * point's results, neighbors are not sorted in any particular order.
+   *
+   * @param range Range of distances in which to search.
+   * @param results Object which will hold the results of the search.
+   */
+  void Search(const math::Range& range,
+              RangeSearchResults& results);
+
   //! Get whether single-tree search is being used.
   bool SingleMode() const { return singleMode; }
   //! Modify whether single-tree search is being used.
@@ -274,6 +342,17 @@ class RangeSearch
   //! Get the number of scores during the last search.
   size_t Scores() const { return scores; }
 
+  //! Get whether detailed traversal statistics are collected.
+  bool CollectStatistics() const { return collectStatistics; }
+  //! Modify whether detailed traversal statistics are collected.  When this
+  //! is set to true, every Search() call fills the object returned by
+  //! Stats(); collection adds a small overhead to the traversal.
+  bool& CollectStatistics() { return collectStatistics; }
+
+  //! Get the detailed statistics of the last search (only filled if
+  //! CollectStatistics() is set to true).
+  const tree::TraversalStatistics& Stats() const { return stats; }
+
   //! Serialize the model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t version);
@@ -285,6 +364,24 @@ class RangeSearch
   Tree* ReferenceTree() { return referenceTree; }
 
  private:
+  /**
+   * Recurse over unordered pairs of tree nodes for the self-join search.
+   * Each qualifying pair of points is found exactly once and inserted into
+   * the results once (the mirrored entry is added afterwards by
+   * RangeSearchResults::Symmetrize()); reflexive pairs are skipped.  This is
+   * only correct for tree types whose children partition
+   * the points of their parent (no self-children or duplicated points).
+   *
+   * @param firstNode First node of the pair.
+   * @param secondNode Second node of the pair (may be the same node).
+   * @param range Range of distances in which to search.
+   * @param results Object the results are inserted into.
+   */
+  void SelfJoinRecursion(Tree& firstNode,
+                         Tree& secondNode,
+                         const math::Range& range,
+                         RangeSearchResults& results);
+
   //! Mappings to old reference indices (used when this object builds trees).
   std::vector<size_t> oldFromNewReferences;
   //! Reference tree.
@@ -309,6 +406,11 @@ class RangeSearch
   //! The total number of scores during the last search.
   size_t scores;
 
+  //! If true, detailed traversal statistics are collected during searches.
+  bool collectStatistics;
+  //! Detailed statistics of the last search.
+  tree::TraversalStatistics stats;
+
   //! For access to mappings when building models.
   friend class TrainVisitor;
 };
@@ -61,7 +61,8 @@ RangeSearch<MetricType, MatType, TreeType>::RangeSearch(
     singleMode(!naive && singleMode),
     metric(metric),
     baseCases(0),
-    scores(0)
+    scores(0),
+    collectStatistics(false)
 {
   // Nothing to do.
 }
@@ -82,7 +83,8 @@ RangeSearch<MetricType, MatType, TreeType>::RangeSearch(
     singleMode(singleMode),
     metric(metric),
     baseCases(0),
-    scores(0)
+    scores(0),
+    collectStatistics(false)
 {
   // Nothing else to initialize.
 }
@@ -103,7 +105,8 @@ RangeSearch<MetricType, MatType, TreeType>::RangeSearch(
     singleMode(singleMode),
     metric(metric),
     baseCases(0),
-    scores(0)
+    scores(0),
+    collectStatistics(false)
 {
   // Build the tree on the empty dataset, if necessary.
   if (!naive)
@@ -131,7 +134,9 @@ RangeSearch<MetricType, MatType, TreeType>::RangeSearch(
     singleMode(other.singleMode),
     metric(other.metric),
     baseCases(other.baseCases),
-    scores(other.scores)
+    scores(other.scores),
+    collectStatistics(other.collectStatistics),
+    stats(other.stats)
 {
   // Nothing to do.
 }
@@ -150,7 +155,9 @@ RangeSearch<MetricType, MatType, TreeType>::RangeSearch(RangeSearch&& other) :
     singleMode(other.singleMode),
     metric(std::move(other.metric)),
     baseCases(other.baseCases),
-    scores(other.scores)
+    scores(other.scores),
+    collectStatistics(other.collectStatistics),
+    stats(std::move(other.stats))
 {
   // Clear other object.
   other.referenceTree =
@@ -187,6 +194,8 @@ RangeSearch<MetricType, MatType, TreeType>::operator=(RangeSearch other)
   metric = std::move(other.metric);
   baseCases = other.baseCases;
   scores = other.scores;
+  collectStatistics = other.collectStatistics;
+  stats = other.stats;
 
   return *this;
 }
@@ -321,17 +330,22 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
   distancePtr->clear();
   distancePtr->resize(querySet.n_cols);
 
+  // Wrap the output vectors so the rules can insert into them.
+  RangeSearchVectorResults results(*neighborPtr, *distancePtr);
+
   // Create the helper object for the traversal.
   typedef RangeSearchRules<MetricType, Tree> RuleType;
 
   // Reset counts.
   baseCases = 0;
   scores = 0;
+  if (collectStatistics)
+    stats.Reset(querySet.n_cols);
 
   if (naive)
   {
-    RuleType rules(*referenceSet, querySet, range, *neighborPtr, *distancePtr,
-        metric);
+    RuleType rules(*referenceSet, querySet, range, results, metric, false,
+        collectStatistics ? &stats : NULL);
 
     // The naive brute-force solution.
     for (size_t i = 0; i < querySet.n_cols; ++i)
@@ -343,8 +357,8 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
   else if (singleMode)
   {
     // Create the traverser.
-    RuleType rules(*referenceSet, querySet, range, *neighborPtr, *distancePtr,
-        metric);
+    RuleType rules(*referenceSet, querySet, range, results, metric, false,
+        collectStatistics ? &stats : NULL);
     typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
 
     // Now have it traverse for each point.
@@ -364,8 +378,8 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
     Timer::Start("range_search/computing_neighbors");
 
     // Create the traverser.
-    RuleType rules(*referenceSet, queryTree->Dataset(), range, *neighborPtr,
-        *distancePtr, metric);
+    RuleType rules(*referenceSet, queryTree->Dataset(), range, results, metric,
+        false, collectStatistics ? &stats : NULL);
     typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
 
     traverser.Traverse(*queryTree, *referenceTree);
@@ -483,10 +497,15 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
   distances.clear();
   distances.resize(querySet.n_cols);
 
+  // Wrap the output vectors so the rules can insert into them.
+  RangeSearchVectorResults results(*neighborPtr, distances);
+
   // Create the helper object for the traversal.
   typedef RangeSearchRules<MetricType, Tree> RuleType;
-  RuleType rules(*referenceSet, queryTree->Dataset(), range, *neighborPtr,
-      distances, metric);
+  if (collectStatistics)
+    stats.Reset(querySet.n_cols);
+  RuleType rules(*referenceSet, queryTree->Dataset(), range, results, metric,
+      false, collectStatistics ? &stats : NULL);
 
   // Create the traverser.
   typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
@@ -550,10 +569,16 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
   distancePtr->clear();
   distancePtr->resize(referenceSet->n_cols);
 
+  // Wrap the output vectors so the rules can insert into them.
+  RangeSearchVectorResults results(*neighborPtr, *distancePtr);
+
   // Create the helper object for the traversal.
   typedef RangeSearchRules<MetricType, Tree> RuleType;
-  RuleType rules(*referenceSet, *referenceSet, range, *neighborPtr,
-      *distancePtr, metric, true /* don't return the query in the results */);
+  if (collectStatistics)
+    stats.Reset(referenceSet->n_cols);
+  RuleType rules(*referenceSet, *referenceSet, range, results,
+      metric, true /* don't return the query in the results */,
+      collectStatistics ? &stats : NULL);
 
   if (naive)
   {
@@ -618,6 +643,383 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
   }
 }
 
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<MetricType, MatType, TreeType>::Search(
+    const MatType& querySet,
+    const math::Range& range,
+    RangeSearchResults& results)
+{
+  if (querySet.n_rows != referenceSet->n_rows)
+  {
+    std::ostringstream oss;
+    oss << "RangeSearch::Search(): dimensionalities of query set ("
+        << querySet.n_rows << ") and reference set (" << referenceSet->n_rows
+        << ") do not match!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  results.Clear();
+
+  // If there are no points, there is no search to be done.
+  if (referenceSet->n_cols == 0)
+  {
+    results.Finalize(querySet.n_cols);
+    return;
+  }
+
+  Timer::Start("range_search/computing_neighbors");
+
+  // This will hold mappings for query points, if necessary.
+  std::vector<size_t> oldFromNewQueries;
+
+  // Preallocate the arena.  Growth during the search is geometric, so this
+  // only needs to be a rough floor; one result per query point is a
+  // reasonable starting estimate.
+  results.Reserve(querySet.n_cols);
+
+  // Create the helper object for the traversal.  Unlike the vector-of-vectors
+  // overload, no unmapped temporary storage is needed: index mappings are
+  // applied to the flat arena in place after the search.
+  typedef RangeSearchRules<MetricType, Tree, RangeSearchResults> RuleType;
+
+  // Reset counts.
+  baseCases = 0;
+  scores = 0;
+  if (collectStatistics)
+    stats.Reset(querySet.n_cols);
+
+  if (naive)
+  {
+    RuleType rules(*referenceSet, querySet, range, results, metric, false,
+        collectStatistics ? &stats : NULL);
+
+    // The naive brute-force solution.
+    for (size_t i = 0; i < querySet.n_cols; ++i)
+      for (size_t j = 0; j < referenceSet->n_cols; ++j)
+        rules.BaseCase(i, j);
+
+    baseCases += (querySet.n_cols * referenceSet->n_cols);
+  }
+  else if (singleMode)
+  {
+    // Create the traverser.
+    RuleType rules(*referenceSet, querySet, range, results, metric, false,
+        collectStatistics ? &stats : NULL);
+    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+
+    // Now have it traverse for each point.
+    for (size_t i = 0; i < querySet.n_cols; ++i)
+      traverser.Traverse(i, *referenceTree);
+
+    baseCases += rules.BaseCases();
+    scores += rules.Scores();
+  }
+  else // Dual-tree recursion.
+  {
+    // Build the query tree.
+    Timer::Stop("range_search/computing_neighbors");
+    Timer::Start("range_search/tree_building");
+    Tree* queryTree = BuildTree<Tree>(querySet, oldFromNewQueries);
+    Timer::Stop("range_search/tree_building");
+    Timer::Start("range_search/computing_neighbors");
+
+    // Create the traverser.
+    RuleType rules(*referenceSet, queryTree->Dataset(), range, results, metric,
+        false, collectStatistics ? &stats : NULL);
+    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+
+    traverser.Traverse(*queryTree, *referenceTree);
+
+    baseCases += rules.BaseCases();
+    scores += rules.Scores();
+
+    // Clean up tree memory.
+    delete queryTree;
+  }
+
+  Timer::Stop("range_search/computing_neighbors");
+
+  // Map points back to original indices, if necessary.  Both mappings operate
+  // on the flat arrays, so no temporary copies are needed; the query mapping
+  // must be applied before Finalize() so the results are grouped by original
+  // query index.
+  if (tree::TreeTraits<Tree>::RearrangesDataset)
+  {
+    if (!singleMode && !naive)
+      results.MapQueries(oldFromNewQueries);
+    if (treeOwner)
+      results.MapIndices(oldFromNewReferences);
+  }
+
+  results.Finalize(querySet.n_cols);
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<MetricType, MatType, TreeType>::Search(
+    Tree* queryTree,
+    const math::Range& range,
+    RangeSearchResults& results)
+{
+  // Get a reference to the query set.
+  const MatType& querySet = queryTree->Dataset();
+
+  // Make sure we are in dual-tree mode.
+  if (singleMode || naive)
+    throw std::invalid_argument("cannot call RangeSearch::Search() with a "
+        "query tree when naive or singleMode are set to true");
+
+  results.Clear();
+
+  // If there are no points, there is no search to be done.
+  if (referenceSet->n_cols == 0)
+  {
+    results.Finalize(querySet.n_cols);
+    return;
+  }
+
+  Timer::Start("range_search/computing_neighbors");
+
+  // Preallocate the arena.
+  results.Reserve(querySet.n_cols);
+
+  // Create the helper object for the traversal.
+  typedef RangeSearchRules<MetricType, Tree, RangeSearchResults> RuleType;
+  if (collectStatistics)
+    stats.Reset(querySet.n_cols);
+  RuleType rules(*referenceSet, queryTree->Dataset(), range, results, metric,
+      false, collectStatistics ? &stats : NULL);
+
+  // Create the traverser.
+  typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+
+  traverser.Traverse(*queryTree, *referenceTree);
+
+  Timer::Stop("range_search/computing_neighbors");
+
+  baseCases = rules.BaseCases();
+  scores = rules.Scores();
+
+  // Map reference indices, if necessary; query indices don't need mapping,
+  // since the query tree was passed in by the user.
+  if (treeOwner && tree::TreeTraits<Tree>::RearrangesDataset)
+    results.MapIndices(oldFromNewReferences);
+
+  results.Finalize(querySet.n_cols);
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<MetricType, MatType, TreeType>::Search(
+    const math::Range& range,
+    RangeSearchResults& results)
+{
+  results.Clear();
+
+  // If there are no points, there is no search to be done.
+  if (referenceSet->n_cols == 0)
+  {
+    results.Finalize(0);
+    return;
+  }
+
+  Timer::Start("range_search/computing_neighbors");
+
+  // Preallocate the arena.
+  results.Reserve(referenceSet->n_cols);
+
+  // Create the helper object for the traversal.
+  typedef RangeSearchRules<MetricType, Tree, RangeSearchResults> RuleType;
+  if (collectStatistics)
+    stats.Reset(referenceSet->n_cols);
+  RuleType rules(*referenceSet, *referenceSet, range, results,
+      metric, true /* don't return the query in the results */,
+      collectStatistics ? &stats : NULL);
+
+  if (naive)
+  {
+    // The naive brute-force solution.
+    for (size_t i = 0; i < referenceSet->n_cols; ++i)
+      for (size_t j = 0; j < referenceSet->n_cols; ++j)
+        rules.BaseCase(i, j);
+
+    baseCases = (referenceSet->n_cols * referenceSet->n_cols);
+    scores = 0;
+  }
+  else if (singleMode)
+  {
+    // Create the traverser.
+    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+
+    // Now have it traverse for each point.
+    for (size_t i = 0; i < referenceSet->n_cols; ++i)
+      traverser.Traverse(i, *referenceTree);
+
+    baseCases = rules.BaseCases();
+    scores = rules.Scores();
+  }
+  else if (!tree::TreeTraits<Tree>::HasSelfChildren &&
+           !tree::TreeTraits<Tree>::HasDuplicatedPoints &&
+           !collectStatistics)
+  {
+    // Self-join recursion.  Since the query set is the reference set, the
+    // symmetric traversal above would score every pair of nodes twice; the
+    // self-join recursion enumerates each unordered node pair once and finds
+    // each qualifying pair of points once, and the mirrored results are
+    // restored with one linear pass over the arena.  This requires that the
+    // children of a node partition its points, so trees with self-children or
+    // duplicated points use the generic traverser instead; so does statistics
+    // collection, which assumes a per-query-point traversal.
+    baseCases = 0;
+    scores = 0;
+    SelfJoinRecursion(*referenceTree, *referenceTree, range, results);
+    results.Symmetrize();
+  }
+  else // Dual-tree recursion.
+  {
+    // Create the traverser.
+    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+
+    traverser.Traverse(*referenceTree, *referenceTree);
+
+    baseCases = rules.BaseCases();
+    scores = rules.Scores();
+  }
+
+  Timer::Stop("range_search/computing_neighbors");
+
+  // Do we need to map the indices?  Here the query set is the reference set,
+  // so both sides use the reference mapping; the query mapping must be
+  // applied before Finalize().
+  if (treeOwner && tree::TreeTraits<Tree>::RearrangesDataset)
+  {
+    results.MapQueries(oldFromNewReferences);
+    results.MapIndices(oldFromNewReferences);
+  }
+
+  results.Finalize(referenceSet->n_cols);
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<MetricType, MatType, TreeType>::SelfJoinRecursion(
+    Tree& firstNode,
+    Tree& secondNode,
+    const math::Range& range,
+    RangeSearchResults& results)
+{
+  const bool sameNode = (&firstNode == &secondNode);
+
+  if (sameNode)
+  {
+    // A node paired with itself contains pairs of arbitrarily small distance,
+    // so only the bottom of the range can prune: if even the two farthest
+    // points of the node are closer than range.Lo(), no pair inside can
+    // qualify.
+    ++scores;
+    if (range.Lo() > firstNode.MaxDistance(firstNode))
+      return;
+  }
+  else
+  {
+    // Score this unordered pair of nodes; its mirror image is never visited.
+    const math::Range distances = firstNode.RangeDistance(secondNode);
+    ++scores;
+    if (!distances.Contains(range))
+      return;
+
+    // If every cross pair of descendants is inside the range, there is no
+    // need to recurse; emit them all directly.
+    if ((distances.Lo() >= range.Lo()) && (distances.Hi() <= range.Hi()))
+    {
+      results.Reserve(0, firstNode.NumDescendants() *
+          secondNode.NumDescendants());
+      for (size_t i = 0; i < firstNode.NumDescendants(); ++i)
+      {
+        const size_t firstIndex = firstNode.Descendant(i);
+        for (size_t j = 0; j < secondNode.NumDescendants(); ++j)
+        {
+          const size_t secondIndex = secondNode.Descendant(j);
+          const double distance = metric.Evaluate(
+              referenceSet->unsafe_col(firstIndex),
+              referenceSet->unsafe_col(secondIndex));
+          ++baseCases;
+          results.Insert(firstIndex, secondIndex, distance);
+        }
+      }
+      return;
+    }
+  }
+
+  const bool firstIsLeaf = (firstNode.NumChildren() == 0);
+  const bool secondIsLeaf = (secondNode.NumChildren() == 0);
+
+  if (firstIsLeaf && secondIsLeaf)
+  {
+    // Base cases.  Within a single leaf, enumerate each unordered pair of
+    // points once, skipping the reflexive pairs; between two distinct leaves,
+    // every cross pair is already distinct.
+    for (size_t i = 0; i < firstNode.NumDescendants(); ++i)
+    {
+      const size_t firstIndex = firstNode.Descendant(i);
+      for (size_t j = (sameNode ? i + 1 : 0);
+           j < secondNode.NumDescendants(); ++j)
+      {
+        const size_t secondIndex = secondNode.Descendant(j);
+        const double distance = metric.Evaluate(
+            referenceSet->unsafe_col(firstIndex),
+            referenceSet->unsafe_col(secondIndex));
+        ++baseCases;
+        if (range.Contains(distance))
+          results.Insert(firstIndex, secondIndex, distance);
+      }
+    }
+  }
+  else if (sameNode)
+  {
+    // Recurse into each unordered pair of children, including each child
+    // paired with itself; since the children partition the points of this
+    // node, every unordered pair of descendants falls into exactly one such
+    // child pair.
+    for (size_t i = 0; i < firstNode.NumChildren(); ++i)
+      for (size_t j = i; j < firstNode.NumChildren(); ++j)
+        SelfJoinRecursion(firstNode.Child(i), firstNode.Child(j), range,
+            results);
+  }
+  else if (firstIsLeaf)
+  {
+    for (size_t j = 0; j < secondNode.NumChildren(); ++j)
+      SelfJoinRecursion(firstNode, secondNode.Child(j), range, results);
+  }
+  else if (secondIsLeaf)
+  {
+    for (size_t i = 0; i < firstNode.NumChildren(); ++i)
+      SelfJoinRecursion(firstNode.Child(i), secondNode, range, results);
+  }
+  else
+  {
+    // The two nodes are distinct, so every cross pair of their children is
+    // distinct too.
+    for (size_t i = 0; i < firstNode.NumChildren(); ++i)
+      for (size_t j = 0; j < secondNode.NumChildren(); ++j)
+        SelfJoinRecursion(firstNode.Child(i), secondNode.Child(j), range,
+            results);
+  }
+}
+
 template<typename MetricType,
          typename MatType,
          template<typename TreeMetricType,
@@ -101,7 +101,7 @@ PARAM_DOUBLE_IN("min", "Lower bound in range.", "L", 0.0);
 // building.
 PARAM_STRING_IN("tree_type", "Type of tree to use: 'kd', 'vp', 'rp', 'max-rp', "
     "'ub', 'cover', 'r', 'r-star', 'x', 'ball', 'hilbert-r', 'r-plus', "
-    "'r-plus-plus', 'oct'.", "t", "kd");
+    "'r-plus-plus', 'oct', 'grid'.", "t", "kd");
 PARAM_INT_IN("leaf_size", "Leaf size for tree building (used for kd-trees, "
     "vp trees, random projection trees, UB trees, R trees, R* trees, X trees, "
     "Hilbert R trees, R+ trees, R++ trees, and octrees).", "l", 20);
@@ -168,7 +168,7 @@ static void mlpackMain()
     const string treeType = IO::GetParam<string>("tree_type");
     RequireParamInSet<string>("tree_type", { "kd", "cover", "r", "r-star",
         "ball", "x", "hilbert-r", "r-plus", "r-plus-plus", "vp", "rp", "max-rp",
-        "ub", "oct" }, true, "unknown tree type");
+        "ub", "oct", "grid" }, true, "unknown tree type");
     const bool randomBasis = IO::HasParam("random_basis");
 
     rs = new RSModel();
@@ -202,6 +202,8 @@ static void mlpackMain()
       tree = RSModel::UB_TREE;
     else if (treeType == "oct")
       tree = RSModel::OCTREE;
+    else if (treeType == "grid")
+      tree = RSModel::GRID;
 
     rs->TreeType() = tree;
     rs->RandomBasis() = randomBasis;
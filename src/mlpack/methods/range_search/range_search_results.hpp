@@ -0,0 +1,298 @@
+/**
+ * @file methods/range_search/range_search_results.hpp
+ *
+ * Arena-backed storage for range search results.  The classical output format
+ * of RangeSearch::Search() is a std::vector of std::vectors, which costs at
+ * least one heap allocation per query point; for very large query sets with
+ * small result lists, allocation dominates the search time.  The
+ * RangeSearchResults class instead stores all results in two flat arrays plus
+ * an offset array (compressed sparse row layout), so the number of allocations
+ * is independent of the number of query points.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANGE_SEARCH_RANGE_SEARCH_RESULTS_HPP
+#define MLPACK_METHODS_RANGE_SEARCH_RANGE_SEARCH_RESULTS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace range {
+
+/**
+ * Flat (arena-backed) storage for the results of a range search.  During the
+ * search, results arrive in traversal order, which interleaves query points
+ * arbitrarily; they are appended to a single growing arena along with the
+ * query index they belong to.  After the search, Finalize() groups the arena
+ * by query point with a counting sort, producing a compressed sparse row
+ * layout: the neighbors of query point i are stored at positions
+ * [Offsets()[i], Offsets()[i + 1]) of the flat index and distance arrays.
+ *
+ * Use this class by passing it to the RangeSearch::Search() overloads that
+ * accept it; it is filled by RangeSearchRules during the traversal.  Within
+ * each query point's results, neighbors are not sorted in any particular
+ * order.
+ */
+class RangeSearchResults
+{
+ public:
+  /**
+   * Construct an empty result set.
+   */
+  RangeSearchResults() { }
+
+  /**
+   * Preallocate the arena for the given total number of results (across all
+   * query points).  This is optional---the arena grows geometrically as
+   * results are inserted---but a reasonable estimate avoids regrowth copies
+   * during the search.
+   *
+   * @param totalResults Estimated total number of results.
+   */
+  void Reserve(const size_t totalResults)
+  {
+    queries.reserve(totalResults);
+    indices.reserve(totalResults);
+    distances.reserve(totalResults);
+  }
+
+  /**
+   * Ensure the arena has room for the given number of additional results.
+   * This is called by RangeSearchRules before inserting a batch of results.
+   *
+   * @param * (queryIndex) Index of the query point (unused; the arena is
+   *      shared between all query points).
+   * @param extra Number of additional results to make room for.
+   */
+  void Reserve(const size_t /* queryIndex */, const size_t extra)
+  {
+    queries.reserve(queries.size() + extra);
+    indices.reserve(indices.size() + extra);
+    distances.reserve(distances.size() + extra);
+  }
+
+  /**
+   * Insert one result.  This is called by RangeSearchRules during the
+   * traversal; the result lands at the end of the arena and is moved to its
+   * final grouped position by Finalize().
+   *
+   * @param queryIndex Index of the query point the result belongs to.
+   * @param referenceIndex Index of the reference point that fell into the
+   *      search range.
+   * @param distance Distance between the query point and the reference point.
+   */
+  void Insert(const size_t queryIndex,
+              const size_t referenceIndex,
+              const double distance)
+  {
+    queries.push_back(queryIndex);
+    indices.push_back(referenceIndex);
+    distances.push_back(distance);
+  }
+
+  /**
+   * Map each stored reference index through the given mapping (this is used
+   * by RangeSearch to restore the original point ordering after tree building
+   * has rearranged the reference set).
+   *
+   * @param oldFromNew Mapping from new indices to old indices.
+   */
+  void MapIndices(const std::vector<size_t>& oldFromNew)
+  {
+    for (size_t i = 0; i < indices.size(); ++i)
+      indices[i] = oldFromNew[indices[i]];
+  }
+
+  /**
+   * Map each stored query index through the given mapping.  This must be
+   * called before Finalize(), so that the results are grouped by the original
+   * (mapped) query indices.
+   *
+   * @param oldFromNew Mapping from new indices to old indices.
+   */
+  void MapQueries(const std::vector<size_t>& oldFromNew)
+  {
+    for (size_t i = 0; i < queries.size(); ++i)
+      queries[i] = oldFromNew[queries[i]];
+  }
+
+  /**
+   * Append the mirror image (j, i, d) of every stored result (i, j, d).  This
+   * is used by the self-join search path, whose traversal finds each unordered
+   * pair of points only once; a single linear pass over the arena then
+   * restores the full symmetric per-query result lists.  This must be called
+   * before Finalize().
+   */
+  void Symmetrize()
+  {
+    const size_t numResults = queries.size();
+    Reserve(2 * numResults);
+    for (size_t i = 0; i < numResults; ++i)
+    {
+      queries.push_back(indices[i]);
+      indices.push_back(queries[i]);
+      distances.push_back(distances[i]);
+    }
+  }
+
+  /**
+   * Group the arena by query point, building the offset array.  This is a
+   * counting sort: one pass to count the results of each query point, and one
+   * pass to scatter them into place.  After this call the per-result query
+   * indices are released, and the accessors below become valid.
+   *
+   * @param numQueries Number of query points in the search.
+   */
+  void Finalize(const size_t numQueries)
+  {
+    // Count the results of each query point, then turn the counts into
+    // offsets with a prefix sum.
+    offsets.assign(numQueries + 1, 0);
+    for (size_t i = 0; i < queries.size(); ++i)
+      ++offsets[queries[i] + 1];
+    for (size_t i = 1; i <= numQueries; ++i)
+      offsets[i] += offsets[i - 1];
+
+    // Scatter each result into its final position.
+    std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+    std::vector<size_t> sortedIndices(indices.size());
+    std::vector<double> sortedDistances(distances.size());
+    for (size_t i = 0; i < queries.size(); ++i)
+    {
+      const size_t position = next[queries[i]]++;
+      sortedIndices[position] = indices[i];
+      sortedDistances[position] = distances[i];
+    }
+
+    indices.swap(sortedIndices);
+    distances.swap(sortedDistances);
+
+    // The per-result query indices are no longer needed; release the memory.
+    std::vector<size_t>().swap(queries);
+  }
+
+  /**
+   * Clear all stored results (but keep any reserved arena capacity, so a
+   * result object can be reused across searches without reallocating).
+   */
+  void Clear()
+  {
+    queries.clear();
+    indices.clear();
+    distances.clear();
+    offsets.clear();
+  }
+
+  //! Get the number of query points (only valid after Finalize()).
+  size_t NumQueries() const
+  {
+    return (offsets.empty()) ? 0 : (offsets.size() - 1);
+  }
+
+  //! Get the total number of results, across all query points.
+  size_t NumResults() const { return indices.size(); }
+
+  //! Get the number of results for the given query point (only valid after
+  //! Finalize()).
+  size_t Count(const size_t queryIndex) const
+  {
+    return offsets[queryIndex + 1] - offsets[queryIndex];
+  }
+
+  //! Get the index of the j'th neighbor of the given query point (only valid
+  //! after Finalize()).
+  size_t Neighbor(const size_t queryIndex, const size_t j) const
+  {
+    return indices[offsets[queryIndex] + j];
+  }
+
+  //! Get the distance to the j'th neighbor of the given query point (only
+  //! valid after Finalize()).
+  double Distance(const size_t queryIndex, const size_t j) const
+  {
+    return distances[offsets[queryIndex] + j];
+  }
+
+  //! Get the flat array of neighbor indices, grouped by query point.
+  const std::vector<size_t>& Indices() const { return indices; }
+
+  //! Get the flat array of distances, parallel to Indices().
+  const std::vector<double>& Distances() const { return distances; }
+
+  //! Get the offset array; the results of query point i are stored at
+  //! positions [Offsets()[i], Offsets()[i + 1]) of Indices() and Distances().
+  const std::vector<size_t>& Offsets() const { return offsets; }
+
+ private:
+  //! The query index of each result, in traversal order.  This is released by
+  //! Finalize(), once the results have been grouped.
+  std::vector<size_t> queries;
+
+  //! Flat array of neighbor indices (grouped by query point after
+  //! Finalize()).
+  std::vector<size_t> indices;
+
+  //! Flat array of distances, parallel to indices.
+  std::vector<double> distances;
+
+  //! Offset of each query point's results in the flat arrays (compressed
+  //! sparse row layout; filled by Finalize()).
+  std::vector<size_t> offsets;
+};
+
+/**
+ * Adapter that presents the classical vector-of-vectors range search output
+ * through the same interface as RangeSearchResults, so that a single set of
+ * traversal rules (RangeSearchRules) can fill either representation.  This is
+ * an internal helper used by RangeSearch::Search().
+ */
+class RangeSearchVectorResults
+{
+ public:
+  /**
+   * Construct the adapter around the given output objects.  Both must already
+   * be sized to the number of query points.
+   *
+   * @param neighbors Vector of result index vectors, one per query point.
+   * @param distances Vector of result distance vectors, one per query point.
+   */
+  RangeSearchVectorResults(std::vector<std::vector<size_t>>& neighbors,
+                           std::vector<std::vector<double>>& distances) :
+      neighbors(neighbors),
+      distances(distances)
+  {
+    // Nothing to do.
+  }
+
+  //! Make room for the given number of additional results for the given query
+  //! point.
+  void Reserve(const size_t queryIndex, const size_t extra)
+  {
+    neighbors[queryIndex].reserve(neighbors[queryIndex].size() + extra);
+    distances[queryIndex].reserve(distances[queryIndex].size() + extra);
+  }
+
+  //! Insert one result for the given query point.
+  void Insert(const size_t queryIndex,
+              const size_t referenceIndex,
+              const double distance)
+  {
+    neighbors[queryIndex].push_back(referenceIndex);
+    distances[queryIndex].push_back(distance);
+  }
+
+ private:
+  //! The vector the resultant neighbor indices are stored in.
+  std::vector<std::vector<size_t>>& neighbors;
+
+  //! The vector the resultant neighbor distances are stored in.
+  std::vector<std::vector<double>>& distances;
+};
+
+} // namespace range
+} // namespace mlpack
+
+#endif
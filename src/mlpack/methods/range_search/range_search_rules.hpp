@@ -13,6 +13,9 @@
 #define MLPACK_METHODS_RANGE_SEARCH_RANGE_SEARCH_RULES_HPP
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/core/tree/traversal_statistics.hpp>
+
+#include "range_search_results.hpp"
 
 namespace mlpack {
 namespace range {
@@ -23,8 +26,13 @@ namespace range {
  *
  * @tparam MetricType The metric to use for computation.
  * @tparam TreeType The tree type to use; must adhere to the TreeType API.
+ * @tparam ResultsType The object results are inserted into; either
+ *      RangeSearchVectorResults (the classical vector-of-vectors output) or
+ *      RangeSearchResults (flat arena output).
  */
-template<typename MetricType, typename TreeType>
+template<typename MetricType,
+         typename TreeType,
+         typename ResultsType = RangeSearchVectorResults>
 class RangeSearchRules
 {
  public:
@@ -35,19 +43,21 @@ class RangeSearchRules
    * @param referenceSet Set of reference data.
    * @param querySet Set of query data.
    * @param range Range to search for.
-   * @param neighbors Vector to store resulting neighbors in.
-   * @param distances Vector to store resulting distances in.
+   * @param results Object to store results in.
    * @param metric Instantiated metric.
    * @param sameSet If true, the query and reference set are taken to be the
    *      same, and a query point will not return itself in the results.
+   * @param stats If non-NULL, detailed traversal statistics (base cases,
+   *      scores, prunes, result insertions) are recorded into the given
+   *      object during the traversal.
    */
   RangeSearchRules(const arma::mat& referenceSet,
                    const arma::mat& querySet,
                    const math::Range& range,
-                   std::vector<std::vector<size_t> >& neighbors,
-                   std::vector<std::vector<double> >& distances,
+                   ResultsType& results,
                    MetricType& metric,
-                   const bool sameSet = false);
+                   const bool sameSet = false,
+                   tree::TraversalStatistics* stats = NULL);
 
   /**
    * Compute the base case between the given query point and reference point.
@@ -131,11 +141,8 @@ class RangeSearchRules
   //! The range of distances for which we are searching.
   const math::Range& range;
 
-  //! The vector the resultant neighbor indices should be stored in.
-  std::vector<std::vector<size_t> >& neighbors;
-
-  //! The vector the resultant neighbor distances should be stored in.
-  std::vector<std::vector<double> >& distances;
+  //! The object the results should be stored in.
+  ResultsType& results;
 
   //! The instantiated metric.
   MetricType& metric;
@@ -160,6 +167,9 @@ class RangeSearchRules
   size_t baseCases;
   //! THe number of scores.
   size_t scores;
+
+  //! If non-NULL, detailed traversal statistics are recorded here.
+  tree::TraversalStatistics* stats;
 };
 
 } // namespace range
@@ -18,35 +18,35 @@
 namespace mlpack {
 namespace range {
 
-template<typename MetricType, typename TreeType>
-RangeSearchRules<MetricType, TreeType>::RangeSearchRules(
+template<typename MetricType, typename TreeType, typename ResultsType>
+RangeSearchRules<MetricType, TreeType, ResultsType>::RangeSearchRules(
     const arma::mat& referenceSet,
     const arma::mat& querySet,
     const math::Range& range,
-    std::vector<std::vector<size_t> >& neighbors,
-    std::vector<std::vector<double> >& distances,
+    ResultsType& results,
     MetricType& metric,
-    const bool sameSet) :
+    const bool sameSet,
+    tree::TraversalStatistics* stats) :
     referenceSet(referenceSet),
     querySet(querySet),
     range(range),
-    neighbors(neighbors),
-    distances(distances),
+    results(results),
     metric(metric),
     sameSet(sameSet),
     lastQueryIndex(querySet.n_cols),
     lastReferenceIndex(referenceSet.n_cols),
     baseCases(0),
-    scores(0)
+    scores(0),
+    stats(stats)
 {
   // Nothing to do.
 }
 
 //! The base case.  Evaluate the distance between the two points and add to the
 //! results if necessary.
-template<typename MetricType, typename TreeType>
+template<typename MetricType, typename TreeType, typename ResultsType>
 inline force_inline
-double RangeSearchRules<MetricType, TreeType>::BaseCase(
+double RangeSearchRules<MetricType, TreeType, ResultsType>::BaseCase(
     const size_t queryIndex,
     const size_t referenceIndex)
 {
@@ -61,6 +61,8 @@ double RangeSearchRules<MetricType, TreeType>::BaseCase(
   const double distance = metric.Evaluate(querySet.unsafe_col(queryIndex),
       referenceSet.unsafe_col(referenceIndex));
   ++baseCases;
+  if (stats)
+    stats->RecordBaseCase(queryIndex);
 
   // Update last indices, so we don't accidentally perform a base case twice.
   lastQueryIndex = queryIndex;
@@ -68,17 +70,19 @@ double RangeSearchRules<MetricType, TreeType>::BaseCase(
 
   if (range.Contains(distance))
   {
-    neighbors[queryIndex].push_back(referenceIndex);
-    distances[queryIndex].push_back(distance);
+    results.Insert(queryIndex, referenceIndex, distance);
+    if (stats)
+      stats->RecordInsertion(queryIndex);
   }
 
   return distance;
 }
 
 //! Single-tree scoring function.
-template<typename MetricType, typename TreeType>
-double RangeSearchRules<MetricType, TreeType>::Score(const size_t queryIndex,
-                                                     TreeType& referenceNode)
+template<typename MetricType, typename TreeType, typename ResultsType>
+double RangeSearchRules<MetricType, TreeType, ResultsType>::Score(
+    const size_t queryIndex,
+    TreeType& referenceNode)
 {
   // We must get the minimum and maximum distances and store them in this
   // object.
@@ -118,15 +122,24 @@ double RangeSearchRules<MetricType, TreeType>::Score(const size_t queryIndex,
     ++scores;
   }
 
+  if (stats)
+    stats->RecordScore();
+
   // If the ranges do not overlap, prune this node.
   if (!distances.Contains(range))
+  {
+    if (stats)
+      stats->RecordPrune();
     return DBL_MAX;
+  }
 
   // In this case, all of the points in the reference node will be part of the
   // results.
   if ((distances.Lo() >= range.Lo()) && (distances.Hi() <= range.Hi()))
   {
     AddResult(queryIndex, referenceNode);
+    if (stats)
+      stats->RecordPrune();
     return DBL_MAX; // We don't need to go any deeper.
   }
 
@@ -136,8 +149,8 @@ double RangeSearchRules<MetricType, TreeType>::Score(const size_t queryIndex,
 }
 
 //! Single-tree rescoring function.
-template<typename MetricType, typename TreeType>
-double RangeSearchRules<MetricType, TreeType>::Rescore(
+template<typename MetricType, typename TreeType, typename ResultsType>
+double RangeSearchRules<MetricType, TreeType, ResultsType>::Rescore(
     const size_t /* queryIndex */,
     TreeType& /* referenceNode */,
     const double oldScore) const
@@ -147,9 +160,10 @@ double RangeSearchRules<MetricType, TreeType>::Rescore(
 }
 
 //! Dual-tree scoring function.
-template<typename MetricType, typename TreeType>
-double RangeSearchRules<MetricType, TreeType>::Score(TreeType& queryNode,
-                                                     TreeType& referenceNode)
+template<typename MetricType, typename TreeType, typename ResultsType>
+double RangeSearchRules<MetricType, TreeType, ResultsType>::Score(
+    TreeType& queryNode,
+    TreeType& referenceNode)
 {
   math::Range distances;
   if (tree::TreeTraits<TreeType>::FirstPointIsCentroid)
@@ -188,9 +202,16 @@ double RangeSearchRules<MetricType, TreeType>::Score(TreeType& queryNode,
     ++scores;
   }
 
+  if (stats)
+    stats->RecordScore();
+
   // If the ranges do not overlap, prune this node.
   if (!distances.Contains(range))
+  {
+    if (stats)
+      stats->RecordPrune();
     return DBL_MAX;
+  }
 
   // In this case, all of the points in the reference node will be part of all
   // the results for each point in the query node.
@@ -198,6 +219,8 @@ double RangeSearchRules<MetricType, TreeType>::Score(TreeType& queryNode,
   {
     for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
       AddResult(queryNode.Descendant(i), referenceNode);
+    if (stats)
+      stats->RecordPrune();
     return DBL_MAX; // We don't need to go any deeper.
   }
 
@@ -209,8 +232,8 @@ double RangeSearchRules<MetricType, TreeType>::Score(TreeType& queryNode,
 }
 
 //! Dual-tree rescoring function.
-template<typename MetricType, typename TreeType>
-double RangeSearchRules<MetricType, TreeType>::Rescore(
+template<typename MetricType, typename TreeType, typename ResultsType>
+double RangeSearchRules<MetricType, TreeType, ResultsType>::Rescore(
     TreeType& /* queryNode */,
     TreeType& /* referenceNode */,
     const double oldScore) const
@@ -221,9 +244,10 @@ double RangeSearchRules<MetricType, TreeType>::Rescore(
 
 //! Add all the points in the given node to the results for the given query
 //! point.
-template<typename MetricType, typename TreeType>
-void RangeSearchRules<MetricType, TreeType>::AddResult(const size_t queryIndex,
-                                                       TreeType& referenceNode)
+template<typename MetricType, typename TreeType, typename ResultsType>
+void RangeSearchRules<MetricType, TreeType, ResultsType>::AddResult(
+    const size_t queryIndex,
+    TreeType& referenceNode)
 {
   // Some types of trees calculate the base case evaluation before Score() is
   // called, so if the base case has already been calculated, then we must avoid
@@ -236,14 +260,10 @@ void RangeSearchRules<MetricType, TreeType>::AddResult(const size_t queryIndex,
     baseCaseMod = 1;
   }
 
-  // Resize distances and neighbors vectors appropriately.  We have to use
-  // reserve() and not resize(), because we don't know if we will encounter the
-  // case where the datasets and points are the same (and we skip in that case).
-  const size_t oldSize = neighbors[queryIndex].size();
-  neighbors[queryIndex].reserve(oldSize + referenceNode.NumDescendants() -
-      baseCaseMod);
-  distances[queryIndex].reserve(oldSize + referenceNode.NumDescendants() -
-      baseCaseMod);
+  // Make room in the results object.  We have to reserve and not resize,
+  // because we don't know if we will encounter the case where the datasets and
+  // points are the same (and we skip in that case).
+  results.Reserve(queryIndex, referenceNode.NumDescendants() - baseCaseMod);
 
   for (size_t i = baseCaseMod; i < referenceNode.NumDescendants(); ++i)
   {
@@ -254,8 +274,9 @@ void RangeSearchRules<MetricType, TreeType>::AddResult(const size_t queryIndex,
     const double distance = metric.Evaluate(querySet.unsafe_col(queryIndex),
         referenceNode.Dataset().unsafe_col(referenceNode.Descendant(i)));
 
-    neighbors[queryIndex].push_back(referenceNode.Descendant(i));
-    distances[queryIndex].push_back(distance);
+    results.Insert(queryIndex, referenceNode.Descendant(i), distance);
+    if (stats)
+      stats->RecordInsertion(queryIndex);
   }
 }
 
@@ -22,6 +22,7 @@
 #include <boost/variant.hpp>
 
 #include "range_search.hpp"
+#include "grid_range_search.hpp"
 
 namespace mlpack {
 namespace range {
@@ -109,6 +110,9 @@ class BiSearchVisitor : public boost::static_visitor<void>
   //! Bichromatic range search specialized for octrees.
   void operator()(RSTypeT<tree::Octree>* rs) const;
 
+  //! Bichromatic range search specialized for the uniform grid.
+  void operator()(GridRangeSearch* rs) const;
+
   //! Construct the BiSearchVisitor.
   BiSearchVisitor(const arma::mat& querySet,
                   const math::Range& range,
@@ -156,6 +160,9 @@ class TrainVisitor : public boost::static_visitor<void>
   //! Train specialized for octrees.
   void operator()(RSTypeT<tree::Octree>* rs) const;
 
+  //! Train specialized for the uniform grid.
+  void operator()(GridRangeSearch* rs) const;
+
   //! Construct the TrainVisitor object with the given reference set, leafSize
   TrainVisitor(arma::mat&& referenceSet,
                const size_t leafSize);
@@ -228,7 +235,8 @@ class RSModel
     RP_TREE,
     MAX_RP_TREE,
     UB_TREE,
-    OCTREE
+    OCTREE,
+    GRID
   };
 
  private:
@@ -258,7 +266,8 @@ class RSModel
                  RSType<tree::RPTree>*,
                  RSType<tree::MaxRPTree>*,
                  RSType<tree::UBTree>*,
-                 RSType<tree::Octree>*> rSearch;
+                 RSType<tree::Octree>*,
+                 GridRangeSearch*> rSearch;
 
  public:
   /**
@@ -161,6 +161,10 @@ inline void RSModel::BuildModel(arma::mat&& referenceSet,
     case OCTREE:
       rSearch = new RSType<tree::Octree>(naive, singleMode);
       break;
+
+    case GRID:
+      rSearch = new GridRangeSearch(naive, singleMode);
+      break;
   }
 
   TrainVisitor tn(std::move(referenceSet), leafSize);
@@ -249,6 +253,8 @@ inline std::string RSModel::TreeName() const
       return "UB tree";
     case OCTREE:
       return "octree";
+    case GRID:
+      return "uniform grid";
     default:
       return "unknown tree";
   }
@@ -318,6 +324,14 @@ inline void BiSearchVisitor::operator()(RSTypeT<tree::Octree>* rs) const
   throw std::runtime_error("no range search model initialized");
 }
 
+//! Bichromatic range search specialized for the uniform grid.
+inline void BiSearchVisitor::operator()(GridRangeSearch* rs) const
+{
+  if (rs)
+    return rs->Search(querySet, range, neighbors, distances);
+  throw std::runtime_error("no range search model initialized");
+}
+
 //! Bichromatic range search on the given RSType considering the leafSize.
 template<typename RSType>
 void BiSearchVisitor::SearchLeaf(RSType* rs) const
@@ -392,6 +406,14 @@ inline void TrainVisitor::operator()(RSTypeT<tree::Octree>* rs) const
   throw std::runtime_error("no range search model initialized");
 }
 
+//! Train specialized for the uniform grid.
+inline void TrainVisitor::operator()(GridRangeSearch* rs) const
+{
+  if (rs)
+    return rs->Train(std::move(referenceSet));
+  throw std::runtime_error("no range search model initialized");
+}
+
 //! Train on the given RSType considering the leafSize.
 template<typename RSType>
 void TrainVisitor::TrainLeaf(RSType* rs) const
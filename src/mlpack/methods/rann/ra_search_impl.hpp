@@ -293,7 +293,10 @@ Search(const MatType& querySet,
 
   if (naive)
   {
-    RuleType rules(*referenceSet, querySet, k, metric, tau, alpha, naive,
+    // Pass false for the naive parameter so the rules object does not run its
+    // own sampling pass per query point in the constructor; the shared-sample
+    // batch below performs all of the base cases.
+    RuleType rules(*referenceSet, querySet, k, metric, tau, alpha, false,
         sampleAtLeaves, firstLeafExact, singleSampleLimit, false);
 
     // Find how many samples from the reference set we need and sample uniformly
@@ -304,11 +307,23 @@ Search(const MatType& querySet,
     math::ObtainDistinctSamples(0, referenceSet->n_cols, numSamples,
         distinctSamples);
 
-    // Run the base case on each combination of query point and sampled
-    // reference point.
-    for (size_t i = 0; i < querySet.n_cols; ++i)
+    // Gather the shared sample subset once, so that every query runs its
+    // distance kernel against the same contiguous block of columns, then
+    // process the query points in parallel; each query point only touches its
+    // own candidate list.
+    const MatType sampledSet = referenceSet->cols(distinctSamples);
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+    {
+      arma::vec sampleDistances(distinctSamples.n_elem);
       for (size_t j = 0; j < distinctSamples.n_elem; ++j)
-        rules.BaseCase(i, (size_t) distinctSamples[j]);
+      {
+        sampleDistances[j] = metric.Evaluate(querySet.unsafe_col(i),
+            sampledSet.unsafe_col(j));
+      }
+
+      rules.BaseCaseBatch(i, distinctSamples, sampleDistances);
+    }
 
     rules.GetResults(*neighborPtr, *distancePtr);
   }
@@ -519,7 +534,10 @@ void RASearch<SortPolicy, MetricType, MatType, TreeType>::Search(
 
   // Create the helper object for the tree traversal.
   typedef RASearchRules<SortPolicy, MetricType, Tree> RuleType;
-  RuleType rules(*referenceSet, *referenceSet, k, metric, tau, alpha, naive,
+  // Pass false for the naive parameter so the rules object does not run its
+  // own sampling pass per query point in the constructor; in naive mode the
+  // shared-sample batch below performs all of the base cases.
+  RuleType rules(*referenceSet, *referenceSet, k, metric, tau, alpha, false,
       sampleAtLeaves, firstLeafExact, singleSampleLimit, true /* same sets */);
 
   if (naive)
@@ -532,10 +550,23 @@ void RASearch<SortPolicy, MetricType, MatType, TreeType>::Search(
     math::ObtainDistinctSamples(0, referenceSet->n_cols, numSamples,
         distinctSamples);
 
-    // The naive brute-force solution.
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
-      for (size_t j = 0; j < referenceSet->n_cols; ++j)
-        rules.BaseCase(i, j);
+    // Gather the shared sample subset once, so that every query runs its
+    // distance kernel against the same contiguous block of columns, then
+    // process the query points in parallel; each query point only touches its
+    // own candidate list.
+    const MatType sampledSet = referenceSet->cols(distinctSamples);
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) referenceSet->n_cols; ++i)
+    {
+      arma::vec sampleDistances(distinctSamples.n_elem);
+      for (size_t j = 0; j < distinctSamples.n_elem; ++j)
+      {
+        sampleDistances[j] = metric.Evaluate(referenceSet->unsafe_col(i),
+            sampledSet.unsafe_col(j));
+      }
+
+      rules.BaseCaseBatch(i, distinctSamples, sampleDistances);
+    }
   }
   else if (singleMode)
   {
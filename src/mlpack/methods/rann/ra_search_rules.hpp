@@ -84,6 +84,22 @@ class RASearchRules
    */
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
 
+  /**
+   * Process a block of precomputed base cases for one query point.  The
+   * distances must correspond elementwise to the given reference indices.
+   * This updates the candidate list and the sampling bookkeeping exactly like
+   * one BaseCase() call per reference point, but lets the caller compute the
+   * distances in a blocked kernel against a gathered sample subset; it is
+   * safe to call concurrently for different query points.
+   *
+   * @param queryIndex Index of query point.
+   * @param referenceIndices Indices of the sampled reference points.
+   * @param distances Precomputed distances to the sampled reference points.
+   */
+  void BaseCaseBatch(const size_t queryIndex,
+                     const arma::uvec& referenceIndices,
+                     const arma::vec& distances);
+
   /**
    * Get the score for recursion order.  A low score indicates priority for
    * recursion, while DBL_MAX indicates that the node should not be recursed
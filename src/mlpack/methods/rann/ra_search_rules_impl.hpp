@@ -140,6 +140,30 @@ double RASearchRules<SortPolicy, MetricType, TreeType>::BaseCase(
   return distance;
 }
 
+template<typename SortPolicy, typename MetricType, typename TreeType>
+inline void RASearchRules<SortPolicy, MetricType, TreeType>::BaseCaseBatch(
+    const size_t queryIndex,
+    const arma::uvec& referenceIndices,
+    const arma::vec& distances)
+{
+  for (size_t j = 0; j < referenceIndices.n_elem; ++j)
+  {
+    // If the datasets are the same, then this search is only using one
+    // dataset and we should not return identical points.
+    if (sameSet && (queryIndex == referenceIndices[j]))
+      continue;
+
+    InsertNeighbor(queryIndex, referenceIndices[j], distances[j]);
+
+    numSamplesMade[queryIndex]++;
+  }
+
+  // Only this counter is shared between query points, so it is the only
+  // update that needs synchronization under concurrent callers.
+  #pragma omp atomic
+  numDistComputations += referenceIndices.n_elem;
+}
+
 template<typename SortPolicy, typename MetricType, typename TreeType>
 inline double RASearchRules<SortPolicy, MetricType, TreeType>::Score(
     const size_t queryIndex,
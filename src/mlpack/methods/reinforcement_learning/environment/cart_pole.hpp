@@ -185,6 +185,59 @@ class CartPole
     return 1.0;
   }
 
+  /**
+   * Batched dynamics of Cart Pole. Get rewards, next states and termination
+   * flags for a whole batch of independent episodes at once, with each column
+   * of the state matrices holding one encoded state.  The dynamics are the
+   * same as in Sample(), but evaluated with matrix arithmetic instead of one
+   * episode at a time.
+   *
+   * Each column is treated as an independent episode, so the step counter of
+   * this instance is not used; enforcing a per-episode step limit is up to
+   * the caller.
+   *
+   * @param states The current states, one encoded state per column.
+   * @param actions The current actions, one per column of states.
+   * @param nextStates The matrix to store the next states in.
+   * @param rewards The vector to store the rewards in; they are always 1.0.
+   * @param isTerminal The vector to store the termination flags in.
+   */
+  void BatchSample(const arma::mat& states,
+                   const arma::Col<size_t>& actions,
+                   arma::mat& nextStates,
+                   arma::rowvec& rewards,
+                   arma::irowvec& isTerminal) const
+  {
+    // Calculate accelerations for the whole batch.
+    const arma::rowvec force = arma::conv_to<arma::rowvec>::from(actions.t())
+        * (2 * forceMag) - forceMag;
+    const arma::rowvec cosTheta = arma::cos(states.row(2));
+    const arma::rowvec sinTheta = arma::sin(states.row(2));
+    const arma::rowvec temp = (force + poleMassLength *
+        (states.row(3) % states.row(3)) % sinTheta) / totalMass;
+    const arma::rowvec thetaAcc = (gravity * sinTheta - cosTheta % temp) /
+        (length * (4.0 / 3.0 - massPole * (cosTheta % cosTheta) / totalMass));
+    const arma::rowvec xAcc = temp - poleMassLength * (thetaAcc % cosTheta) /
+        totalMass;
+
+    // Update states.
+    nextStates.set_size(arma::size(states));
+    nextStates.row(0) = states.row(0) + tau * states.row(1);
+    nextStates.row(1) = states.row(1) + tau * xAcc;
+    nextStates.row(2) = states.row(2) + tau * states.row(3);
+    nextStates.row(3) = states.row(3) + tau * thetaAcc;
+
+    // An episode terminates when the cart leaves the track or the pole falls
+    // over.
+    const arma::urowvec failed =
+        (arma::abs(nextStates.row(0)) > xThreshold) +
+        (arma::abs(nextStates.row(2)) > thetaThresholdRadians);
+    isTerminal = arma::conv_to<arma::irowvec>::from(failed > 0);
+
+    // The reward is 1.0 for every transition.
+    rewards.ones(states.n_cols);
+  }
+
   /**
    * Dynamics of Cart Pole. Get reward based on current state and current
    * action.
@@ -164,6 +164,59 @@ class MountainCar
     return -1;
   }
 
+  /**
+   * Batched dynamics of Mountain Car. Get rewards, next states and
+   * termination flags for a whole batch of independent episodes at once, with
+   * each column of the state matrices holding one encoded state.  The
+   * dynamics are the same as in Sample(), but evaluated with matrix
+   * arithmetic instead of one episode at a time.
+   *
+   * Each column is treated as an independent episode, so the step counter of
+   * this instance is not used; enforcing a per-episode step limit is up to
+   * the caller.
+   *
+   * @param states The current states, one encoded state per column.
+   * @param actions The current actions, one per column of states.
+   * @param nextStates The matrix to store the next states in.
+   * @param rewards The vector to store the rewards in.
+   * @param isTerminal The vector to store the termination flags in.
+   */
+  void BatchSample(const arma::mat& states,
+                   const arma::Col<size_t>& actions,
+                   arma::mat& nextStates,
+                   arma::rowvec& rewards,
+                   arma::irowvec& isTerminal) const
+  {
+    // Calculate accelerations for the whole batch.
+    const arma::rowvec direction =
+        arma::conv_to<arma::rowvec>::from(actions.t()) - 1;
+    arma::rowvec velocity = states.row(0) + 0.001 * direction -
+        0.0025 * arma::cos(3 * states.row(1));
+    velocity = arma::clamp(velocity, velocityMin, velocityMax);
+
+    // Update states.
+    arma::rowvec position = states.row(1) + velocity;
+    position = arma::clamp(position, positionMin, positionMax);
+
+    // The car stops when it hits the left wall.
+    velocity.elem(arma::find((position == positionMin) %
+        (velocity < 0))).zeros();
+
+    nextStates.set_size(arma::size(states));
+    nextStates.row(0) = velocity;
+    nextStates.row(1) = position;
+
+    // An episode terminates when the car reaches the goal position.
+    isTerminal = arma::conv_to<arma::irowvec>::from(
+        position >= positionGoal);
+
+    // The reward is -1.0 for every transition, and the done reward for
+    // transitions that reach the goal.
+    rewards.set_size(states.n_cols);
+    rewards.fill(-1.0);
+    rewards.elem(arma::find(isTerminal == 1)).fill(doneReward);
+  }
+
   /**
    * Dynamics of Mountain Car. Get reward based on current state and current
    * action.
@@ -110,6 +110,19 @@ class QLearning
    */
   double Episode();
 
+  /**
+   * Execute one episode in each of several copies of the environment, stepped
+   * in lockstep.  At every step the encoded states of all environments that
+   * have not yet terminated are stacked into one matrix, so that the action
+   * values are computed with a single batched network prediction instead of
+   * one prediction per environment.  Transitions are stored and training
+   * updates are performed exactly as in Episode().
+   *
+   * @param numEnvs Number of environment instances to step in lockstep.
+   * @return Average return over the episodes.
+   */
+  double VectorizedEpisode(const size_t numEnvs);
+
   //! Modify total steps from beginning.
   size_t& TotalSteps() { return totalSteps; }
   //! Get total steps from beginning.
@@ -181,6 +194,19 @@ class QLearning
 
   //! Locally-stored flag indicating training mode or test mode.
   bool deterministic;
+
+  //! Reused minibatch buffers for experience replay, so that a training step
+  //! does not reallocate them.
+  arma::mat sampledStates;
+  std::vector<ActionType> sampledActions;
+  arma::rowvec sampledRewards;
+  arma::mat sampledNextStates;
+  arma::irowvec isTerminal;
+
+  //! Reused buffers for the batched target computation.
+  arma::mat nextActionValues;
+  arma::mat target;
+  arma::mat gradients;
 };
 
 } // namespace rl
@@ -132,18 +132,13 @@ void QLearning<
 {
   // Start experience replay.
 
-  // Sample from previous experience.
-  arma::mat sampledStates;
-  std::vector<ActionType> sampledActions;
-  arma::rowvec sampledRewards;
-  arma::mat sampledNextStates;
-  arma::irowvec isTerminal;
-
+  // Sample from previous experience into the reused minibatch buffers.  The
+  // replay methods append to the action vector, so it must be cleared first.
+  sampledActions.clear();
   replayMethod.Sample(sampledStates, sampledActions, sampledRewards,
       sampledNextStates, isTerminal);
 
   // Compute action value for next state with target network.
-  arma::mat nextActionValues;
   targetNetwork.Predict(sampledNextStates, nextActionValues);
 
   arma::Col<size_t> bestActions;
@@ -160,7 +155,6 @@ void QLearning<
   }
 
   // Compute the update target.
-  arma::mat target;
   learningNetwork.Forward(sampledStates, target);
 
   double discount = std::pow(config.Discount(), replayMethod.NSteps());
@@ -177,7 +171,6 @@ void QLearning<
   }
 
   // Learn from experience.
-  arma::mat gradients;
   learningNetwork.Backward(sampledStates, target, gradients);
 
   replayMethod.Update(target, sampledActions, nextActionValues, gradients);
@@ -385,6 +378,104 @@ double QLearning<
   return totalReturn;
 }
 
+template <
+  typename EnvironmentType,
+  typename NetworkType,
+  typename UpdaterType,
+  typename BehaviorPolicyType,
+  typename ReplayType
+>
+double QLearning<
+  EnvironmentType,
+  NetworkType,
+  UpdaterType,
+  BehaviorPolicyType,
+  ReplayType
+>::VectorizedEpisode(const size_t numEnvs)
+{
+  // Each environment instance is a copy of the agent's environment and starts
+  // from its own initial state.
+  std::vector<EnvironmentType> environments(numEnvs, environment);
+  std::vector<StateType> states(numEnvs);
+  std::vector<bool> active(numEnvs, true);
+  arma::vec returns(numEnvs, arma::fill::zeros);
+
+  size_t numActive = 0;
+  for (size_t i = 0; i < numEnvs; ++i)
+  {
+    states[i] = environments[i].InitialSample();
+    active[i] = !environments[i].IsTerminal(states[i]);
+    if (active[i])
+      numActive++;
+  }
+
+  arma::mat actionValues;
+
+  // Run until every environment has reached a terminal state.
+  while (numActive > 0)
+  {
+    // Stack the encoded states of all active environments.
+    arma::uvec activeIndices(numActive);
+    arma::mat stackedStates(StateType::dimension, numActive);
+    size_t pos = 0;
+    for (size_t i = 0; i < numEnvs; ++i)
+    {
+      if (!active[i])
+        continue;
+      activeIndices(pos) = i;
+      stackedStates.col(pos++) = states[i].Encode();
+    }
+
+    // Get the action values of all active environments with one batched
+    // prediction.
+    learningNetwork.Predict(stackedStates, actionValues);
+
+    for (size_t i = 0; i < numActive; ++i)
+    {
+      const size_t env = activeIndices(i);
+
+      // Select an action according to the behavior policy.
+      const arma::colvec actionValue = actionValues.col(i);
+      action = policy.Sample(actionValue, deterministic,
+          config.NoisyQLearning());
+
+      // Interact with the environment to advance to next state.
+      StateType nextState;
+      const double reward = environments[env].Sample(states[env], action,
+          nextState);
+
+      returns(env) += reward;
+      totalSteps++;
+
+      // Store the transition for replay.
+      replayMethod.Store(states[env], action, reward, nextState,
+          environments[env].IsTerminal(nextState), config.Discount());
+      // Update current state.
+      states[env] = nextState;
+
+      if (environments[env].IsTerminal(nextState))
+        active[env] = false;
+
+      if (deterministic || totalSteps < config.ExplorationSteps())
+        continue;
+      if (config.IsCategorical())
+        TrainCategoricalAgent();
+      else
+        TrainAgent();
+    }
+
+    // Drop the environments that reached a terminal state this step.
+    numActive = 0;
+    for (size_t i = 0; i < numEnvs; ++i)
+    {
+      if (active[i])
+        numActive++;
+    }
+  }
+
+  return arma::accu(returns) / numEnvs;
+}
+
 } // namespace rl
 } // namespace mlpack
 
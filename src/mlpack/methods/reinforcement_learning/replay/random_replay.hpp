@@ -64,7 +64,8 @@ class RandomReplay
       capacity(0),
       position(0),
       full(false),
-      nSteps(0)
+      nSteps(0),
+      contiguousSampling(false)
   { /* Nothing to do here. */ }
 
   /**
@@ -74,16 +75,21 @@ class RandomReplay
    * @param capacity Total memory size in terms of number of examples.
    * @param nSteps Number of steps to look in the future.
    * @param dimension The dimension of an encoded state.
+   * @param contiguousSampling If true, each sample is one contiguous window
+   *        of the ring buffer instead of independently drawn transitions, so
+   *        the gather is a single block copy from the preallocated slabs.
    */
   RandomReplay(const size_t batchSize,
                const size_t capacity,
                const size_t nSteps = 1,
-               const size_t dimension = StateType::dimension) :
+               const size_t dimension = StateType::dimension,
+               const bool contiguousSampling = false) :
       batchSize(batchSize),
       capacity(capacity),
       position(0),
       full(false),
       nSteps(nSteps),
+      contiguousSampling(contiguousSampling),
       states(dimension, capacity),
       actions(capacity),
       rewards(capacity),
@@ -187,6 +193,27 @@ class RandomReplay
               arma::irowvec& isTerminal)
   {
     size_t upperBound = full ? capacity : position;
+
+    if (contiguousSampling && upperBound >= batchSize)
+    {
+      // Fused batched sampling: copy one contiguous window of the ring
+      // buffer, so the gather is a single block copy from each preallocated
+      // slab instead of batchSize scattered column copies.  The transitions
+      // within a batch are consecutive, which trades some decorrelation for
+      // a much cheaper per-step gather.
+      const size_t start = math::RandInt(0, upperBound - batchSize + 1);
+      const size_t end = start + batchSize - 1;
+
+      sampledStates = states.cols(start, end);
+      for (size_t t = start; t <= end; t++)
+        sampledActions.push_back(actions[t]);
+      sampledRewards = rewards.subvec(start, end);
+      sampledNextStates = nextStates.cols(start, end);
+      isTerminal = this->isTerminal.subvec(start, end);
+
+      return;
+    }
+
     arma::uvec sampledIndices = arma::randi<arma::uvec>(
         batchSize, arma::distr_param(0, upperBound - 1));
 
@@ -227,6 +254,11 @@ class RandomReplay
   //! Get the number of steps for n-step agent.
   const size_t& NSteps() const { return nSteps; }
 
+  //! Get whether contiguous window sampling is used.
+  bool ContiguousSampling() const { return contiguousSampling; }
+  //! Modify whether contiguous window sampling is used.
+  bool& ContiguousSampling() { return contiguousSampling; }
+
  private:
   //! Locally-stored number of examples of each sample.
   size_t batchSize;
@@ -243,6 +275,9 @@ class RandomReplay
   //! Locally-stored number of steps to look into the future.
   size_t nSteps;
 
+  //! If true, samples are contiguous windows of the ring buffer.
+  bool contiguousSampling;
+
   //! Locally-stored buffer containing n consecutive steps.
   std::deque<Transition> nStepBuffer;
 
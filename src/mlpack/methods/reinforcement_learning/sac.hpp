@@ -122,6 +122,19 @@ class SAC
    */
   double Episode();
 
+  /**
+   * Execute one episode in each of several copies of the environment, stepped
+   * in lockstep.  At every step the encoded states of all environments that
+   * have not yet terminated are stacked into one matrix, so that the actions
+   * are computed with a single batched prediction of the policy network
+   * instead of one prediction per environment.  Transitions are stored and
+   * network updates are performed exactly as in Episode().
+   *
+   * @param numEnvs Number of environment instances to step in lockstep.
+   * @return Average return over the episodes.
+   */
+  double VectorizedEpisode(const size_t numEnvs);
+
   //! Modify total steps from beginning.
   size_t& TotalSteps() { return totalSteps; }
   //! Get total steps from beginning.
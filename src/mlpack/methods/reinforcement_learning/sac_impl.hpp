@@ -358,6 +358,117 @@ double SAC<
   return totalReturn;
 }
 
+template <
+  typename EnvironmentType,
+  typename QNetworkType,
+  typename PolicyNetworkType,
+  typename UpdaterType,
+  typename ReplayType
+>
+double SAC<
+  EnvironmentType,
+  QNetworkType,
+  PolicyNetworkType,
+  UpdaterType,
+  ReplayType
+>::VectorizedEpisode(const size_t numEnvs)
+{
+  // Each environment instance is a copy of the agent's environment and starts
+  // from its own initial state.
+  std::vector<EnvironmentType> environments(numEnvs, environment);
+  std::vector<StateType> states(numEnvs);
+  std::vector<bool> active(numEnvs, true);
+  arma::vec returns(numEnvs, arma::fill::zeros);
+
+  size_t numActive = 0;
+  for (size_t i = 0; i < numEnvs; ++i)
+  {
+    states[i] = environments[i].InitialSample();
+    active[i] = !environments[i].IsTerminal(states[i]);
+    if (active[i])
+      numActive++;
+  }
+
+  // Track the lockstep steps taken; the step limit applies to every episode
+  // simultaneously, since the environments are stepped together.
+  size_t steps = 0;
+
+  // Run until every environment has reached a terminal state.
+  while (numActive > 0)
+  {
+    if (config.StepLimit() && steps >= config.StepLimit())
+      break;
+
+    // Stack the encoded states of all active environments.
+    arma::uvec activeIndices(numActive);
+    arma::mat stackedStates(StateType::dimension, numActive);
+    size_t pos = 0;
+    for (size_t i = 0; i < numEnvs; ++i)
+    {
+      if (!active[i])
+        continue;
+      activeIndices(pos) = i;
+      stackedStates.col(pos++) = states[i].Encode();
+    }
+
+    // Get the actions of all active environments with one batched prediction
+    // of the policy network.
+    arma::mat outputActions;
+    policyNetwork.Predict(stackedStates, outputActions);
+
+    if (!deterministic)
+    {
+      arma::mat noise = arma::randn<arma::mat>(arma::size(outputActions)) *
+          0.1;
+      noise = arma::clamp(noise, -0.25, 0.25);
+      outputActions += noise;
+    }
+
+    steps++;
+
+    for (size_t i = 0; i < numActive; ++i)
+    {
+      const size_t env = activeIndices(i);
+
+      action.action = arma::conv_to<std::vector<double>>::from(
+          outputActions.col(i));
+
+      // Interact with the environment to advance to next state.
+      StateType nextState;
+      const double reward = environments[env].Sample(states[env], action,
+          nextState);
+
+      returns(env) += reward;
+      totalSteps++;
+
+      // Store the transition for replay.
+      replayMethod.Store(states[env], action, reward, nextState,
+          environments[env].IsTerminal(nextState), config.Discount());
+
+      // Update current state.
+      states[env] = nextState;
+
+      if (environments[env].IsTerminal(nextState))
+        active[env] = false;
+
+      if (deterministic || totalSteps < config.ExplorationSteps())
+        continue;
+      for (size_t u = 0; u < config.UpdateInterval(); u++)
+        Update();
+    }
+
+    // Drop the environments that reached a terminal state this step.
+    numActive = 0;
+    for (size_t i = 0; i < numEnvs; ++i)
+    {
+      if (active[i])
+        numActive++;
+    }
+  }
+
+  return arma::accu(returns) / numEnvs;
+}
+
 } // namespace rl
 } // namespace mlpack
 #endif
@@ -122,6 +122,10 @@ class SoftmaxRegression
    * The function calculates the probabilities for every class, given a data
    * point. It then chooses the class which has the highest probability among
    * all.
+   *
+   * This method does not modify the model, so concurrent calls on a shared
+   * trained model are safe.
+   *
    * @param dataset Set of points to classify.
    * @param labels Predicted labels for each point.
    */
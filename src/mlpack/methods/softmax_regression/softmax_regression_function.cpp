@@ -153,8 +153,6 @@ void SoftmaxRegressionFunction::GetProbabilitiesMatrix(
     const size_t start,
     const size_t batchSize) const
 {
-  arma::mat hypothesis;
-
   if (fitIntercept)
   {
     // In order to add the intercept term, we should compute following matrix:
@@ -162,20 +160,29 @@ void SoftmaxRegressionFunction::GetProbabilitiesMatrix(
     //     hypothesis = arma::exp(parameters * [1; data]).
     //
     // Since the cost of join may be high due to the copy of original data,
-    // split the hypothesis computation to two components.
-    hypothesis = arma::exp(
-        arma::repmat(parameters.col(0), 1, batchSize) +
-        parameters.cols(1, parameters.n_cols - 1) *
-        data.cols(start, start + batchSize - 1));
+    // split the hypothesis computation to two components: the product below
+    // and the intercept shift fused into the normalization pass.
+    probabilities = parameters.cols(1, parameters.n_cols - 1) *
+        data.cols(start, start + batchSize - 1);
   }
   else
   {
-    hypothesis = arma::exp(parameters *
-        data.cols(start, start + batchSize - 1));
+    probabilities = parameters * data.cols(start, start + batchSize - 1);
   }
 
-  probabilities = hypothesis / arma::repmat(arma::sum(hypothesis, 0),
-                                            numClasses, 1);
+  // Fuse the intercept shift, the exponentiation and the normalization into
+  // a single pass over each column, instead of materializing the repmat()ed
+  // intercept and column sums.  The columns are independent, so the pass can
+  // run in parallel.
+  #pragma omp parallel for
+  for (omp_size_t j = 0; j < (omp_size_t) probabilities.n_cols; ++j)
+  {
+    arma::vec col(probabilities.colptr(j), numClasses, false, true);
+    if (fitIntercept)
+      col += parameters.col(0);
+    col = arma::exp(col);
+    col /= arma::accu(col);
+  }
 }
 
 /**
@@ -199,14 +206,21 @@ double SoftmaxRegressionFunction::Evaluate(const arma::mat& parameters) const
   // The sum is calculated over all the classes.
   // x_i is the input vector for a particular training example.
   // theta_j is the parameter vector associated with a particular class.
-  arma::mat probabilities;
-  GetProbabilitiesMatrix(parameters, probabilities, 0, data.n_cols);
+  GetProbabilitiesMatrix(parameters, probabilitiesWork, 0, data.n_cols);
 
-  // Calculate the log likelihood and regularization terms.
-  double logLikelihood, weightDecay, cost;
+  // Calculate the log likelihood and regularization terms.  The ground truth
+  // matrix has one nonzero entry per column, so only the probability it
+  // marks contributes; iterating the nonzeros avoids taking the logarithm of
+  // the whole probabilities matrix.
+  double logLikelihood = 0.0, weightDecay, cost;
 
-  logLikelihood = arma::accu(groundTruth % arma::log(probabilities)) /
-                  data.n_cols;
+  arma::sp_mat::const_iterator it = groundTruth.begin();
+  while (it != groundTruth.end())
+  {
+    logLikelihood += (*it) * std::log(probabilitiesWork(it.row(), it.col()));
+    ++it;
+  }
+  logLikelihood /= data.n_cols;
   weightDecay = 0.5 * lambda * arma::accu(parameters % parameters);
 
   // The cost is the sum of the negative log likelihood and the regularization
@@ -223,14 +237,21 @@ double SoftmaxRegressionFunction::Evaluate(const arma::mat& parameters,
                                            const size_t start,
                                            const size_t batchSize) const
 {
-  arma::mat probabilities;
-  GetProbabilitiesMatrix(parameters, probabilities, start, batchSize);
+  GetProbabilitiesMatrix(parameters, probabilitiesWork, start, batchSize);
 
-  // Calculate the log likelihood and regularization terms.
-  double logLikelihood, weightDecay;
+  // Calculate the log likelihood and regularization terms, visiting only the
+  // nonzero entries of the ground truth matrix as in the full-batch
+  // Evaluate().
+  double logLikelihood = 0.0, weightDecay;
 
-  logLikelihood = arma::accu(groundTruth.cols(start, start + batchSize - 1) %
-      arma::log(probabilities)) / batchSize;
+  arma::sp_mat::const_iterator it = groundTruth.begin_col(start);
+  while (it != groundTruth.end_col(start + batchSize - 1))
+  {
+    logLikelihood += (*it) *
+        std::log(probabilitiesWork(it.row(), it.col() - start));
+    ++it;
+  }
+  logLikelihood /= batchSize;
   weightDecay = 0.5 * lambda * arma::accu(parameters * parameters);
 
   return -logLikelihood + weightDecay;
@@ -248,27 +269,24 @@ void SoftmaxRegressionFunction::Gradient(const arma::mat& parameters,
   // The sum is calculated over all the classes.
   // x_i is the input vector for a particular training example.
   // theta_j is the parameter vector associated with a particular class.
-  arma::mat probabilities;
-  GetProbabilitiesMatrix(parameters, probabilities, 0, data.n_cols);
+  GetProbabilitiesMatrix(parameters, probabilitiesWork, 0, data.n_cols);
 
   // Calculate the parameter gradients.
   gradient.set_size(parameters.n_rows, parameters.n_cols);
+  innerWork = probabilitiesWork - groundTruth;
   if (fitIntercept)
   {
     // Treating the intercept term parameters.col(0) seperately to avoid
     // the cost of building matrix [1; data].
-    arma::mat inner = probabilities - groundTruth;
-    gradient.col(0) =
-      inner * arma::ones<arma::mat>(data.n_cols, 1) / data.n_cols +
+    gradient.col(0) = arma::sum(innerWork, 1) / data.n_cols +
       lambda * parameters.col(0);
     gradient.cols(1, parameters.n_cols - 1) =
-      inner * data.t() / data.n_cols +
+      innerWork * data.t() / data.n_cols +
       lambda * parameters.cols(1, parameters.n_cols - 1);
   }
   else
   {
-    gradient = (probabilities - groundTruth) * data.t() / data.n_cols +
-               lambda * parameters;
+    gradient = innerWork * data.t() / data.n_cols + lambda * parameters;
   }
 }
 
@@ -277,27 +295,24 @@ void SoftmaxRegressionFunction::Gradient(const arma::mat& parameters,
                                          arma::mat& gradient,
                                          const size_t batchSize) const
 {
-  arma::mat probabilities;
-  GetProbabilitiesMatrix(parameters, probabilities, start, batchSize);
+  GetProbabilitiesMatrix(parameters, probabilitiesWork, start, batchSize);
 
   // Calculate the parameter gradients.
   gradient.set_size(parameters.n_rows, parameters.n_cols);
+  innerWork = probabilitiesWork - groundTruth.cols(start, start +
+      batchSize - 1);
   if (fitIntercept)
   {
-    arma::mat inner = probabilities - groundTruth.cols(start, start +
-        batchSize - 1);
-    gradient.col(0) =
-        inner * arma::ones<arma::mat>(batchSize, 1) / batchSize +
+    gradient.col(0) = arma::sum(innerWork, 1) / batchSize +
         lambda * parameters.col(0);
     gradient.cols(1, parameters.n_cols - 1) =
-        inner * data.cols(start, start + batchSize - 1).t() / batchSize +
+        innerWork * data.cols(start, start + batchSize - 1).t() / batchSize +
         lambda * parameters.cols(1, parameters.n_cols - 1);
   }
   else
   {
-    gradient = (probabilities - groundTruth.cols(start, start + batchSize - 1))
-        * data.cols(start, start + batchSize - 1).t() / batchSize
-        + lambda * parameters;
+    gradient = innerWork * data.cols(start, start + batchSize - 1).t()
+        / batchSize + lambda * parameters;
   }
 }
 
@@ -307,28 +322,26 @@ void SoftmaxRegressionFunction::PartialGradient(const arma::mat& parameters,
 {
   gradient.zeros(arma::size(parameters));
 
-  arma::mat probabilities;
-  GetProbabilitiesMatrix(parameters, probabilities, 0, data.n_cols);
+  GetProbabilitiesMatrix(parameters, probabilitiesWork, 0, data.n_cols);
 
   // Calculate the required part of the gradient.
-  arma::mat inner = probabilities - groundTruth;
+  innerWork = probabilitiesWork - groundTruth;
   if (fitIntercept)
   {
     if (j == 0)
     {
-      gradient.col(j) =
-          inner * arma::ones<arma::mat>(data.n_cols, 1) / data.n_cols +
+      gradient.col(j) = arma::sum(innerWork, 1) / data.n_cols +
           lambda * parameters.col(0);
     }
     else
     {
-      gradient.col(j) = inner * data.row(j).t() / data.n_cols + lambda *
+      gradient.col(j) = innerWork * data.row(j).t() / data.n_cols + lambda *
           parameters.col(j);
     }
   }
   else
   {
-    gradient.col(j) = inner * data.row(j).t() / data.n_cols + lambda *
+    gradient.col(j) = innerWork * data.row(j).t() / data.n_cols + lambda *
         parameters.col(j);
   }
 }
@@ -200,6 +200,13 @@ class SoftmaxRegressionFunction
   double lambda;
   //! Intercept term flag.
   bool fitIntercept;
+  //! Workspace for the probabilities matrix. Keeping the buffer on the
+  //! function object lets every optimizer iteration reuse the allocation
+  //! instead of reallocating it on each Evaluate()/Gradient() call.
+  mutable arma::mat probabilitiesWork;
+  //! Workspace for the difference between the probabilities and the ground
+  //! truth, reused across optimizer calls just like probabilitiesWork.
+  mutable arma::mat innerWork;
 };
 
 } // namespace regression
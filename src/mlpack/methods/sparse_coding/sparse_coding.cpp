@@ -35,26 +35,36 @@ SparseCoding::SparseCoding(
 
 void SparseCoding::Encode(const arma::mat& data, arma::mat& codes)
 {
-  // When using the Cholesky version of LARS, this is correct even if
-  // lambda2 > 0.
+  // The Gram matrix of the dictionary is computed once and shared by every
+  // per-point LARS problem below, since the design matrix is the same for all
+  // of them.  When using the Cholesky version of LARS, this is correct even
+  // if lambda2 > 0.
   arma::mat matGram = trans(dictionary) * dictionary;
 
   codes.set_size(atoms, data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
-  {
-    // Report progress.
-    if ((i % 100) == 0)
-      Log::Debug << "Optimization at point " << i << "." << std::endl;
 
-    bool useCholesky = true;
+  // The per-point problems are independent, so they can be solved in
+  // parallel.  Each thread keeps a single LARS object for all of its points:
+  // LARS::Train() resets the solution state, so reusing the object avoids
+  // reconstructing it (and re-referencing the Gram matrix) for every point.
+  #pragma omp parallel
+  {
+    const bool useCholesky = true;
     regression::LARS lars(useCholesky, matGram, lambda1, lambda2);
+    // All of a thread's points share the dictionary as their design matrix,
+    // so Cholesky state can be carried from one point to the next.
+    lars.WarmStart() = true;
 
-    // Create an alias of the code (using the same memory), and then LARS will
-    // place the result directly into that; then we will not need to have an
-    // extra copy.
-    arma::vec code = codes.unsafe_col(i);
-    arma::rowvec responses = data.unsafe_col(i).t();
-    lars.Train(dictionary, responses, code, false);
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+    {
+      // Create an alias of the code (using the same memory), and then LARS
+      // will place the result directly into that; then we will not need to
+      // have an extra copy.
+      arma::vec code = codes.unsafe_col(i);
+      arma::rowvec responses = data.unsafe_col(i).t();
+      lars.Train(dictionary, responses, code, false);
+    }
   }
 }
 
@@ -259,17 +269,35 @@ double SparseCoding::Objective(const arma::mat& data, const arma::mat& codes)
     const
 {
   double l11NormZ = arma::sum(arma::sum(arma::abs(codes)));
-  double froNormResidual = arma::norm(data - (dictionary * codes), "fro");
+
+  // Accumulate the squared residual norm over blocks of columns instead of
+  // materializing the full reconstruction: for large datasets the residual
+  // matrix is as big as the data itself, and the blocks are independent so
+  // they can be computed in parallel.
+  const size_t blockSize = 4096;
+  const size_t numBlocks = (data.n_cols + blockSize - 1) / blockSize;
+  double sqNormResidual = 0.0;
+  #pragma omp parallel for schedule(dynamic) reduction( + : sqNormResidual)
+  for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+  {
+    const size_t blockBegin = block * blockSize;
+    const size_t blockEnd =
+        std::min(blockBegin + blockSize, (size_t) data.n_cols) - 1;
+
+    const arma::mat residual = data.cols(blockBegin, blockEnd) -
+        dictionary * codes.cols(blockBegin, blockEnd);
+    sqNormResidual += arma::accu(residual % residual);
+  }
 
   if (lambda2 > 0)
   {
     double froNormZ = arma::norm(codes, "fro");
-    return 0.5 * (std::pow(froNormResidual, 2.0) + (lambda2 *
+    return 0.5 * (sqNormResidual + (lambda2 *
         std::pow(froNormZ, 2.0))) + (lambda1 * l11NormZ);
   }
   else // It can be simpler.
   {
-    return 0.5 * std::pow(froNormResidual, 2.0) + lambda1 * l11NormZ;
+    return 0.5 * sqNormResidual + lambda1 * l11NormZ;
   }
 }
 
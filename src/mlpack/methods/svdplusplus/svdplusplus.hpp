@@ -132,6 +132,55 @@ class SVDPlusPlus
              arma::vec& q,
              arma::mat& y);
 
+  /**
+   * Trains the model with a sharded parallel SGD (distributed SGD, or DSGD).
+   * Users and items are partitioned into as many blocks as there are threads,
+   * and each epoch is run as a sequence of rotations in which every thread
+   * processes one user block paired with a distinct item block.  No two
+   * blocks of a rotation share a user or an item, so the explicit factor and
+   * bias updates need no locking; only the item implicit vectors, which are
+   * shared between users of different blocks, are updated atomically.  The
+   * ratings of each block pair are stored contiguously so each thread streams
+   * through its shard in order.
+   *
+   * @param data Rating data matrix.
+   * @param implicitData Implicit feedback.
+   * @param rank Rank parameter to be used for optimization.
+   * @param u Item matrix obtained on decomposition.
+   * @param v User matrix obtained on decomposition.
+   * @param p Item bias.
+   * @param q User bias.
+   * @param y Item matrix with respect to implicit feedback.
+   */
+  void ApplyParallel(const arma::mat& data,
+                     const arma::mat& implicitData,
+                     const size_t rank,
+                     arma::mat& u,
+                     arma::mat& v,
+                     arma::vec& p,
+                     arma::vec& q,
+                     arma::mat& y);
+
+  /**
+   * Trains the model with a sharded parallel SGD (see the overload above).
+   * Whether a user rates an item is used as implicit feedback.
+   *
+   * @param data Rating data matrix.
+   * @param rank Rank parameter to be used for optimization.
+   * @param u Item matrix obtained on decomposition.
+   * @param v User matrix obtained on decomposition.
+   * @param p Item bias.
+   * @param q User bias.
+   * @param y Item matrix with respect to implicit feedback.
+   */
+  void ApplyParallel(const arma::mat& data,
+                     const size_t rank,
+                     arma::mat& u,
+                     arma::mat& v,
+                     arma::vec& p,
+                     arma::vec& q,
+                     arma::mat& y);
+
   /**
    * Converts the User, Item matrix of implicit data to Item-User Table.
    */
@@ -82,6 +82,16 @@ double SVDPlusPlusFunction<MatType>::Evaluate(const arma::mat& parameters,
   arma::vec implicitVecsNormSquare(numItems);
   implicitVecsNormSquare.fill(-1);
 
+  // The implicit-feedback term of each user is also cached, so the sum over
+  // a user's rated items is computed at most once per call.  The parameters
+  // do not change within a call, so the cache is exact; without it, users
+  // with many ratings make the cost of a batch quadratic.  The cached
+  // regularization value doubles as the "not yet computed" flag, since it is
+  // never negative.
+  arma::mat userVecCache(rank, numUsers);
+  arma::vec userRegCache(numUsers);
+  userRegCache.fill(-1);
+
   for (size_t i = start; i < start + batchSize; ++i)
   {
     // Indices for accessing the the correct parameter columns.
@@ -95,30 +105,39 @@ double SVDPlusPlusFunction<MatType>::Evaluate(const arma::mat& parameters,
     const double itemBias = parameters(rank, item);
 
     // Iterate through each item which the user interacted with to calculate
-    // user vector.
-    arma::vec userVec(rank, arma::fill::zeros);
-    arma::sp_mat::const_iterator it = implicitData.begin_col(user);
-    arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
-    size_t implicitCount = 0;
-    double regularizationError = 0;
-    for (; it != it_end; ++it)
+    // user vector, unless the user's terms are already cached.
+    if (userRegCache(user) < 0)
     {
-      userVec += parameters.col(implicitStart + it.row()).subvec(0, rank - 1);
-      if (implicitVecsNormSquare(it.row()) < 0)
+      arma::vec implicitVec(rank, arma::fill::zeros);
+      arma::sp_mat::const_iterator it = implicitData.begin_col(user);
+      arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
+      size_t implicitCount = 0;
+      double regularizationError = 0;
+      for (; it != it_end; ++it)
       {
-        implicitVecsNormSquare(it.row()) = arma::dot(
-            parameters.col(implicitStart + it.row()).subvec(0, rank - 1),
-            parameters.col(implicitStart + it.row()).subvec(0, rank - 1));
+        implicitVec +=
+            parameters.col(implicitStart + it.row()).subvec(0, rank - 1);
+        if (implicitVecsNormSquare(it.row()) < 0)
+        {
+          implicitVecsNormSquare(it.row()) = arma::dot(
+              parameters.col(implicitStart + it.row()).subvec(0, rank - 1),
+              parameters.col(implicitStart + it.row()).subvec(0, rank - 1));
+        }
+        regularizationError += lambda * implicitVecsNormSquare(it.row());
+        implicitCount += 1;
       }
-      regularizationError += lambda * implicitVecsNormSquare(it.row());
-      implicitCount += 1;
-    }
-    if (implicitCount != 0)
-    {
-      userVec /= std::sqrt(implicitCount);
-      regularizationError /= implicitCount;
+      if (implicitCount != 0)
+      {
+        implicitVec /= std::sqrt(implicitCount);
+        regularizationError /= implicitCount;
+      }
+      userVecCache.col(user) = implicitVec;
+      userRegCache(user) = regularizationError;
     }
-    userVec += parameters.col(user).subvec(0, rank - 1);
+
+    const arma::vec userVec = userVecCache.col(user) +
+        parameters.col(user).subvec(0, rank - 1);
+    double regularizationError = userRegCache(user);
 
     double ratingError = rating - userBias - itemBias -
         arma::dot(userVec, parameters.col(item).subvec(0, rank - 1));
@@ -155,6 +174,14 @@ void SVDPlusPlusFunction<MatType>::Gradient(const arma::mat& parameters,
 
   gradient.zeros(rank + 1, numUsers + 2 * numItems);
 
+  // The implicit-feedback sum of each user is cached, so it is computed at
+  // most once per call instead of once per rating of the user.  The
+  // parameters do not change within a call, so the cache is exact; a count
+  // of -1 marks a user whose sum has not been computed yet.
+  arma::mat userVecCache(rank, numUsers);
+  arma::ivec userCountCache(numUsers);
+  userCountCache.fill(-1);
+
   for (size_t i = 0; i < data.n_cols; ++i)
   {
     // Indices for accessing the the correct parameter columns.
@@ -168,19 +195,28 @@ void SVDPlusPlusFunction<MatType>::Gradient(const arma::mat& parameters,
     const double itemBias = parameters(rank, item);
 
     // Iterate through each item which the user interacted with to calculate
-    // user vector.
-    arma::vec userVec(rank, arma::fill::zeros);
-    arma::sp_mat::const_iterator it = implicitData.begin_col(user);
-    arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
-    size_t implicitCount = 0;
-    for (; it != it_end; ++it)
+    // user vector, unless the user's sum is already cached.
+    if (userCountCache(user) < 0)
     {
-      userVec += parameters.col(implicitStart + it.row()).subvec(0, rank - 1);
-      implicitCount += 1;
+      arma::vec implicitVec(rank, arma::fill::zeros);
+      arma::sp_mat::const_iterator it = implicitData.begin_col(user);
+      arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
+      size_t implicitCount = 0;
+      for (; it != it_end; ++it)
+      {
+        implicitVec +=
+            parameters.col(implicitStart + it.row()).subvec(0, rank - 1);
+        implicitCount += 1;
+      }
+      if (implicitCount != 0)
+        implicitVec /= std::sqrt(implicitCount);
+      userVecCache.col(user) = implicitVec;
+      userCountCache(user) = implicitCount;
     }
-    if (implicitCount != 0)
-      userVec /= std::sqrt(implicitCount);
-    userVec += parameters.col(user).subvec(0, rank - 1);
+
+    const size_t implicitCount = (size_t) userCountCache(user);
+    const arma::vec userVec = userVecCache.col(user) +
+        parameters.col(user).subvec(0, rank - 1);
 
     double ratingError = rating - userBias - itemBias -
         arma::dot(userVec, parameters.col(item).subvec(0, rank - 1));
@@ -198,8 +234,8 @@ void SVDPlusPlusFunction<MatType>::Gradient(const arma::mat& parameters,
     gradient(rank, item) +=
         2 * (lambda * parameters(rank, item) - ratingError);
     // Calculate gradients for item implicit vector.
-    it = implicitData.begin_col(user);
-    it_end = implicitData.end_col(user);
+    arma::sp_mat::const_iterator it = implicitData.begin_col(user);
+    arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
     for (; it != it_end; ++it)
     {
       // Note that implicitCount != 0 if this loop is acutally executed.
@@ -221,6 +257,13 @@ void SVDPlusPlusFunction<MatType>::Gradient(const arma::mat& parameters,
 {
   gradient.zeros(rank + 1, numUsers + 2 * numItems);
 
+  // The implicit-feedback sum of each user is cached, so it is computed at
+  // most once per call instead of once per rating of the user (see the full
+  // Gradient() overload above).
+  arma::mat userVecCache(rank, numUsers);
+  arma::ivec userCountCache(numUsers);
+  userCountCache.fill(-1);
+
   // It's possible this could be SIMD-vectorized for additional speedup.
   for (size_t i = start; i < start + batchSize; ++i)
   {
@@ -235,19 +278,28 @@ void SVDPlusPlusFunction<MatType>::Gradient(const arma::mat& parameters,
     const double itemBias = parameters(rank, item);
 
     // Iterate through each item which the user interacted with to calculate
-    // user vector.
-    arma::vec userVec(rank, arma::fill::zeros);
-    arma::sp_mat::const_iterator it = implicitData.begin_col(user);
-    arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
-    size_t implicitCount = 0;
-    for (; it != it_end; ++it)
+    // user vector, unless the user's sum is already cached.
+    if (userCountCache(user) < 0)
     {
-      userVec += parameters.col(implicitStart + it.row()).subvec(0, rank - 1);
-      implicitCount += 1;
+      arma::vec implicitVec(rank, arma::fill::zeros);
+      arma::sp_mat::const_iterator it = implicitData.begin_col(user);
+      arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
+      size_t implicitCount = 0;
+      for (; it != it_end; ++it)
+      {
+        implicitVec +=
+            parameters.col(implicitStart + it.row()).subvec(0, rank - 1);
+        implicitCount += 1;
+      }
+      if (implicitCount != 0)
+        implicitVec /= std::sqrt(implicitCount);
+      userVecCache.col(user) = implicitVec;
+      userCountCache(user) = implicitCount;
     }
-    if (implicitCount != 0)
-      userVec /= std::sqrt(implicitCount);
-    userVec += parameters.col(user).subvec(0, rank - 1);
+
+    const size_t implicitCount = (size_t) userCountCache(user);
+    const arma::vec userVec = userVecCache.col(user) +
+        parameters.col(user).subvec(0, rank - 1);
 
     double ratingError = rating - userBias - itemBias -
         arma::dot(userVec, parameters.col(item).subvec(0, rank - 1));
@@ -268,8 +320,8 @@ void SVDPlusPlusFunction<MatType>::Gradient(const arma::mat& parameters,
     gradient(rank, item) +=
         2 * (lambda * parameters(rank, item) - ratingError);
     // Calculate gradients for item implicit vector.
-    it = implicitData.begin_col(user);
-    it_end = implicitData.end_col(user);
+    arma::sp_mat::const_iterator it = implicitData.begin_col(user);
+    arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
     for (; it != it_end; ++it)
     {
       // Note that implicitCount != 0 if this loop is acutally executed.
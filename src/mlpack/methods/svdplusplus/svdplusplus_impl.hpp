@@ -14,6 +14,8 @@
 #ifndef MLPACK_METHODS_SVDPLUSPLUS_SVDPLUSPLUS_IMPL_HPP
 #define MLPACK_METHODS_SVDPLUSPLUS_SVDPLUSPLUS_IMPL_HPP
 
+#include <mlpack/core/util/threads.hpp>
+
 namespace mlpack {
 namespace svd {
 
@@ -86,6 +88,162 @@ void SVDPlusPlus<OptimizerType>::Apply(const arma::mat& data,
   Apply(data, implicitData, rank, u, v, p, q, y);
 }
 
+template<typename OptimizerType>
+void SVDPlusPlus<OptimizerType>::ApplyParallel(const arma::mat& data,
+                                               const arma::mat& implicitData,
+                                               const size_t rank,
+                                               arma::mat& u,
+                                               arma::mat& v,
+                                               arma::vec& p,
+                                               arma::vec& q,
+                                               arma::mat& y)
+{
+  // Converts implicitData to the form of sparse matrix.
+  arma::sp_mat cleanedData;
+  CleanData(implicitData, cleanedData, data);
+
+  // The function object is only used for its parameter initialization and
+  // user/item bookkeeping; the DSGD loop below performs the updates itself.
+  SVDPlusPlusFunction<arma::mat> svdPPFunc(data, cleanedData, rank, lambda);
+
+  const size_t numUsers = svdPPFunc.NumUsers();
+  const size_t numItems = svdPPFunc.NumItems();
+  const size_t implicitStart = numUsers + numItems;
+
+  // One block of users and items per thread; with fewer users or items than
+  // threads there is nothing to shard.
+  size_t numBlocks = Threads();
+  numBlocks = std::min(numBlocks, std::min(numUsers, numItems));
+
+  // Group the ratings by (user block, item block) cell with a counting sort,
+  // so the ratings of each cell are one contiguous slice of ratingOrder and
+  // every thread streams through its shard in order.
+  const size_t numCells = numBlocks * numBlocks;
+  arma::uvec cellOffsets(numCells + 1, arma::fill::zeros);
+  arma::uvec ratingOrder(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    const size_t userBlock = (size_t) data(0, i) * numBlocks / numUsers;
+    const size_t itemBlock = (size_t) data(1, i) * numBlocks / numItems;
+    cellOffsets[userBlock * numBlocks + itemBlock + 1]++;
+  }
+  for (size_t c = 1; c <= numCells; ++c)
+    cellOffsets[c] += cellOffsets[c - 1];
+  arma::uvec cursor = cellOffsets.head(numCells);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    const size_t userBlock = (size_t) data(0, i) * numBlocks / numUsers;
+    const size_t itemBlock = (size_t) data(1, i) * numBlocks / numItems;
+    ratingOrder[cursor[userBlock * numBlocks + itemBlock]++] = i;
+  }
+
+  arma::mat parameters = svdPPFunc.GetInitialPoint();
+
+  for (size_t epoch = 0; epoch < iterations; ++epoch)
+  {
+    // Each rotation pairs every user block with a distinct item block
+    // (block-diagonal schedule), so no two threads of a rotation ever update
+    // the same explicit factor or bias column.  The item implicit vectors do
+    // not obey the sharding---a user's implicit item set may span any item
+    // block---so those updates are made atomically, as in the Hogwild-style
+    // ParallelSGD specialization.
+    for (size_t rotation = 0; rotation < numBlocks; ++rotation)
+    {
+      #pragma omp parallel for
+      for (omp_size_t t = 0; t < (omp_size_t) numBlocks; ++t)
+      {
+        const size_t cell = t * numBlocks + ((t + rotation) % numBlocks);
+        for (size_t k = cellOffsets[cell]; k < cellOffsets[cell + 1]; ++k)
+        {
+          const size_t index = ratingOrder[k];
+
+          // Indices for accessing the the correct parameter columns.
+          const size_t user = data(0, index);
+          const size_t item = data(1, index) + numUsers;
+
+          // Prediction error for the example.
+          const double rating = data(2, index);
+          const double userBias = parameters(rank, user);
+          const double itemBias = parameters(rank, item);
+
+          // Iterate through each item which the user interacted with to
+          // calculate user vector.
+          arma::vec userVec(rank, arma::fill::zeros);
+          arma::sp_mat::const_iterator it = cleanedData.begin_col(user);
+          arma::sp_mat::const_iterator it_end = cleanedData.end_col(user);
+          size_t implicitCount = 0;
+          for (; it != it_end; ++it)
+          {
+            userVec +=
+                parameters.col(implicitStart + it.row()).subvec(0, rank - 1);
+            implicitCount += 1;
+          }
+          if (implicitCount != 0)
+            userVec /= std::sqrt(implicitCount);
+          userVec += parameters.col(user).subvec(0, rank - 1);
+
+          double ratingError = rating - userBias - itemBias -
+              arma::dot(userVec, parameters.col(item).subvec(0, rank - 1));
+
+          // Gradient is non-zero only for the parameter columns corresponding
+          // to the example.  The item column belongs to this thread's block,
+          // so it can be updated in place like in the sequential
+          // specialization.
+          parameters.col(user).subvec(0, rank - 1) -= alpha * 2 * (
+              lambda * parameters.col(user).subvec(0, rank - 1) -
+              ratingError * parameters.col(item).subvec(0, rank - 1));
+          parameters.col(item).subvec(0, rank - 1) -= alpha * 2 * (
+              lambda * parameters.col(item).subvec(0, rank - 1) -
+              ratingError * userVec);
+          parameters(rank, user) -= alpha * 2 * (
+              lambda * parameters(rank, user) - ratingError);
+          parameters(rank, item) -= alpha * 2 * (
+              lambda * parameters(rank, item) - ratingError);
+          // Update item implicit vectors.
+          it = cleanedData.begin_col(user);
+          it_end = cleanedData.end_col(user);
+          for (; it != it_end; ++it)
+          {
+            // Note that implicitCount != 0 if this loop is acutally executed.
+            const arma::vec implicitUpdate = alpha * 2.0 * (
+                lambda / implicitCount *
+                parameters.col(implicitStart + it.row()).subvec(0, rank - 1) -
+                ratingError / std::sqrt(implicitCount) *
+                parameters.col(item).subvec(0, rank - 1));
+            for (size_t j = 0; j < rank; ++j)
+            {
+              #pragma omp atomic
+              parameters(j, implicitStart + it.row()) -= implicitUpdate[j];
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // Extract user and item matrices, user and item bias, item implicit matrix
+  // from the optimized parameters.
+  u = parameters.submat(0, numUsers, rank - 1, numUsers + numItems - 1).t();
+  v = parameters.submat(0, 0, rank - 1, numUsers - 1);
+  p = parameters.row(rank).subvec(numUsers, numUsers + numItems - 1).t();
+  q = parameters.row(rank).subvec(0, numUsers - 1).t();
+  y = parameters.submat(0, numUsers + numItems, rank - 1,
+      numUsers + 2 * numItems - 1);
+}
+
+template<typename OptimizerType>
+void SVDPlusPlus<OptimizerType>::ApplyParallel(const arma::mat& data,
+                                               const size_t rank,
+                                               arma::mat& u,
+                                               arma::mat& v,
+                                               arma::vec& p,
+                                               arma::vec& q,
+                                               arma::mat& y)
+{
+  arma::mat implicitData = data.submat(0, 0, 1, data.n_cols - 1);
+  ApplyParallel(data, implicitData, rank, u, v, p, q, y);
+}
+
 template<typename OptimizerType>
 void SVDPlusPlus<OptimizerType>::CleanData(const arma::mat& implicitData,
                                            arma::sp_mat& cleanedData,
@@ -13,6 +13,7 @@
 #include <mlpack/core.hpp>
 
 #include <mlpack/methods/ann/layer/layer.hpp>
+#include <mlpack/methods/ann/activation_functions/fast_math.hpp>
 #include <mlpack/methods/ann/activation_functions/logistic_function.hpp>
 #include <mlpack/methods/ann/activation_functions/identity_function.hpp>
 #include <mlpack/methods/ann/activation_functions/softsign_function.hpp>
@@ -1134,3 +1135,35 @@ TEST_CASE("SoftminFunctionTest", "[ActivationFunctionsTest]")
   CheckSoftminDerivativeCorrect(activationData,
                                 desiredDerivatives);
 }
+
+/**
+ * Test that the fast exp() and log() approximations stay within their
+ * documented error bounds and saturate instead of overflowing.
+ */
+TEST_CASE("FastMathApproximationTest", "[ActivationFunctionsTest]")
+{
+  // FastExp() over the range activations actually see.
+  for (double x = -30.0; x <= 30.0; x += 0.01)
+  {
+    const double expected = std::exp(x);
+    REQUIRE(FastExp(x) == Approx(expected).epsilon(1e-10));
+  }
+
+  // Extreme inputs must saturate to finite values instead of producing 0 or
+  // infinity.
+  REQUIRE(std::isfinite(FastExp(1000.0)));
+  REQUIRE(FastExp(1000.0) > 1e307);
+  REQUIRE(FastExp(-1000.0) > 0.0);
+  REQUIRE(FastExp(-1000.0) < 1e-300);
+
+  // FastLog() across many orders of magnitude.
+  for (double x = 1e-300; x < 1e300; x *= 1e3)
+  {
+    const double expected = std::log(x);
+    REQUIRE(FastLog(x) == Approx(expected).epsilon(1e-10));
+  }
+
+  // Domain edges delegate to std::log().
+  REQUIRE(FastLog(0.0) == -std::numeric_limits<double>::infinity());
+  REQUIRE(std::isnan(FastLog(-1.0)));
+}
@@ -891,3 +891,160 @@ TEST_CASE("ID3DecisionStumpSerializationTest", "[AdaBoostTest]")
             abBinary.WeakLearner(i).SplitDimension());
   }
 }
+
+/**
+ * Train AdaBoost on the UCI Iris dataset with weight-proportional
+ * subsampling enabled, and make sure the resulting ensemble is still an
+ * accurate classifier.
+ */
+TEST_CASE("SubsampledTrainingIris", "[AdaBoostTest]")
+{
+  arma::mat inputData;
+
+  if (!data::Load("iris.csv", inputData))
+    FAIL("Cannot load test dataset iris.csv!");
+
+  arma::Mat<size_t> labels;
+  if (!data::Load("iris_labels.txt", labels))
+    FAIL("Cannot load labels for iris iris_labels.txt");
+
+  const size_t numClasses = max(labels.row(0)) + 1;
+
+  Perceptron<> p(inputData, labels.row(0), numClasses, 400);
+
+  AdaBoost<> a(1e-10);
+  a.SampleFraction() = 0.5;
+  a.Train(inputData, labels.row(0), numClasses, p, 100, 1e-10);
+
+  arma::Row<size_t> predictedLabels;
+  a.Classify(inputData, predictedLabels);
+
+  // Each weak learner only saw half of the (sampled) data, so allow a looser
+  // error bound than the full-data tests.
+  size_t countError = arma::accu(labels != predictedLabels);
+  double error = (double) countError / labels.n_cols;
+  REQUIRE(error <= 0.3);
+
+  // An invalid sample fraction must be rejected.
+  a.SampleFraction() = 1.5;
+  REQUIRE_THROWS_AS(a.Train(inputData, labels.row(0), numClasses, p, 10,
+      1e-10), std::invalid_argument);
+}
+
+/**
+ * Classify() must be callable on a const model, and concurrent calls on a
+ * shared trained model must produce the same results as a serial call (there
+ * is no hidden scratch state in the model).
+ */
+TEST_CASE("ConstConcurrentClassifyTest", "[AdaBoostTest]")
+{
+  arma::mat inputData;
+
+  if (!data::Load("iris.csv", inputData))
+    FAIL("Cannot load test dataset iris.csv!");
+
+  arma::Mat<size_t> labels;
+  if (!data::Load("iris_labels.txt", labels))
+    FAIL("Cannot load labels for iris iris_labels.txt");
+
+  const size_t numClasses = max(labels.row(0)) + 1;
+
+  Perceptron<> p(inputData, labels.row(0), numClasses, 400);
+
+  AdaBoost<> a(inputData, labels.row(0), numClasses, p, 50, 1e-10);
+
+  // Classify through a const reference, as a shared loaded model would be.
+  const AdaBoost<>& constModel = a;
+
+  arma::Row<size_t> serialLabels;
+  constModel.Classify(inputData, serialLabels);
+
+  // Fan the same model out to several threads; each uses its own output
+  // buffers.
+  const size_t threads = 4;
+  std::vector<arma::Row<size_t>> threadLabels(threads);
+  std::vector<arma::mat> threadProbabilities(threads);
+
+  #pragma omp parallel for
+  for (omp_size_t t = 0; t < (omp_size_t) threads; ++t)
+    constModel.Classify(inputData, threadLabels[t], threadProbabilities[t]);
+
+  for (size_t t = 0; t < threads; ++t)
+  {
+    REQUIRE(threadLabels[t].n_elem == serialLabels.n_elem);
+    for (size_t i = 0; i < serialLabels.n_elem; ++i)
+      REQUIRE(threadLabels[t][i] == serialLabels[i]);
+  }
+}
+
+/**
+ * With the default confidence of 1, the early-exit cascade only retires a
+ * point when the remaining learners cannot flip the decision, so its
+ * predictions must match Classify() exactly.
+ */
+TEST_CASE("CascadeMatchesClassifyTest", "[AdaBoostTest]")
+{
+  arma::mat inputData;
+  if (!data::Load("iris_train.csv", inputData))
+    FAIL("Cannot load test dataset iris_train.csv!");
+
+  arma::Mat<size_t> labels;
+  if (!data::Load("iris_train_labels.csv", labels))
+    FAIL("Cannot load labels for iris_train_labels.csv");
+  const size_t numClasses = max(labels.row(0)) + 1;
+
+  Perceptron<> p(inputData, labels.row(0), numClasses, 800);
+  AdaBoost<> a(inputData, labels.row(0), numClasses, p, 50, 1e-10);
+
+  arma::mat testData;
+  if (!data::Load("iris_test.csv", testData))
+    FAIL("Cannot load test dataset iris_test.csv!");
+
+  arma::Row<size_t> fullLabels, cascadeLabels;
+  a.Classify(testData, fullLabels);
+  a.ClassifyCascade(testData, cascadeLabels);
+
+  REQUIRE(cascadeLabels.n_elem == fullLabels.n_elem);
+  for (size_t i = 0; i < fullLabels.n_elem; ++i)
+    REQUIRE(cascadeLabels[i] == fullLabels[i]);
+}
+
+/**
+ * With a lower confidence the cascade exits more aggressively; the
+ * predictions may differ from Classify(), but only rarely.
+ */
+TEST_CASE("CascadeLowConfidenceTest", "[AdaBoostTest]")
+{
+  arma::mat inputData;
+  if (!data::Load("iris_train.csv", inputData))
+    FAIL("Cannot load test dataset iris_train.csv!");
+
+  arma::Mat<size_t> labels;
+  if (!data::Load("iris_train_labels.csv", labels))
+    FAIL("Cannot load labels for iris_train_labels.csv");
+  const size_t numClasses = max(labels.row(0)) + 1;
+
+  Perceptron<> p(inputData, labels.row(0), numClasses, 800);
+  AdaBoost<> a(inputData, labels.row(0), numClasses, p, 50, 1e-10);
+
+  arma::mat testData;
+  if (!data::Load("iris_test.csv", testData))
+    FAIL("Cannot load test dataset iris_test.csv!");
+
+  arma::Row<size_t> fullLabels, cascadeLabels;
+  a.Classify(testData, fullLabels);
+  a.ClassifyCascade(testData, cascadeLabels, 0.5);
+
+  size_t agreement = 0;
+  for (size_t i = 0; i < fullLabels.n_elem; ++i)
+    if (cascadeLabels[i] == fullLabels[i])
+      ++agreement;
+
+  REQUIRE((double) agreement / fullLabels.n_elem >= 0.9);
+
+  // Invalid confidences must be rejected.
+  REQUIRE_THROWS_AS(a.ClassifyCascade(testData, cascadeLabels, 0.0),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(a.ClassifyCascade(testData, cascadeLabels, 1.5),
+      std::invalid_argument);
+}
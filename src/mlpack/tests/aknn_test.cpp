@@ -471,3 +471,54 @@ TEST_CASE("AKNNModelMonochromaticTest", "[AKNNTest]")
     }
   }
 }
+
+/**
+ * Test the anytime search mode: a dual-tree search with a score budget must
+ * return valid best-so-far results, and the per-query anytime bounds must
+ * account for everything the truncated traversal did not visit.
+ */
+TEST_CASE("AKNNAnytimeSearchTest", "[AKNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(8, 500);
+  arma::mat querySet = arma::randu<arma::mat>(8, 200);
+
+  // Exact results for comparison.
+  KNN exact(dataset);
+  arma::Mat<size_t> exactNeighbors;
+  arma::mat exactDistances;
+  exact.Search(querySet, 3, exactNeighbors, exactDistances);
+
+  // Anytime search with a very small budget, so that the traversal is
+  // certainly truncated.
+  KNN anytime(dataset);
+  anytime.ScoreBudget() = 25;
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  anytime.Search(querySet, 3, neighbors, distances);
+
+  REQUIRE(neighbors.n_cols == querySet.n_cols);
+  REQUIRE(anytime.AnytimeBounds().n_elem == querySet.n_cols);
+
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    // Best-so-far results can never beat the exact ones.
+    for (size_t j = 0; j < 3; ++j)
+      REQUIRE(distances(j, i) >= exactDistances(j, i) - 1e-10);
+
+    // The true k-th neighbor distance can be no better than the better of
+    // the reported bound and the returned k-th distance.
+    const double bound = std::min(anytime.AnytimeBounds()[i],
+        distances(2, i));
+    REQUIRE(exactDistances(2, i) >= bound - 1e-10);
+  }
+
+  // With a budget that cannot be exhausted, the results are exact and the
+  // bounds report that nothing was left unexplored.
+  KNN loose(dataset);
+  loose.ScoreBudget() = std::numeric_limits<size_t>::max();
+  loose.Search(querySet, 3, neighbors, distances);
+
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+    REQUIRE(loose.AnytimeBounds()[i] == DBL_MAX);
+  CheckMatrices(distances, exactDistances);
+}
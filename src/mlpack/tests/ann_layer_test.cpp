@@ -432,6 +432,43 @@ TEST_CASE("SimpleLinearLayerTest", "[ANNLayerTest]")
   REQUIRE(arma::accu(delta) == 0);
 }
 
+/**
+ * Test that a registered inference backend is used by the Linear forward
+ * pass above the dispatch threshold, bypassed below it, and produces the
+ * same output either way.
+ */
+TEST_CASE("LinearInferenceBackendTest", "[ANNLayerTest]")
+{
+  arma::mat input = arma::randu(10, 32);
+  Linear<> module(10, 8);
+  module.Parameters().randu();
+  module.Reset();
+
+  arma::mat expected;
+  module.Forward(input, expected);
+
+  // Register a counting backend and make every product large enough to
+  // dispatch.
+  size_t calls = 0;
+  InferenceBackend::Gemm() = [&calls](const arma::mat& a, const arma::mat& b,
+      arma::mat& c) { c = a * b; ++calls; return true; };
+  InferenceBackend::Threshold() = 0;
+
+  arma::mat output;
+  module.Forward(input, output);
+  REQUIRE(calls == 1);
+  CheckMatrices(output, expected);
+
+  // Below the threshold the plain path is kept and the backend is not
+  // invoked.
+  InferenceBackend::Threshold() = InferenceBackend::DefaultThreshold;
+  module.Forward(input, output);
+  REQUIRE(calls == 1);
+  CheckMatrices(output, expected);
+
+  InferenceBackend::Gemm() = InferenceBackend::GemmType();
+}
+
 /**
  * Jacobian linear module test.
  */
@@ -1962,6 +1999,60 @@ TEST_CASE("LookupLayerParametersTest", "[ANNLayerTest]")
   REQUIRE(layer.EmbeddingSize() == 8);
 }
 
+/**
+ * The sparse gradient path of the Lookup layer has to produce the same dense
+ * gradient as the default path.
+ */
+TEST_CASE("LookupLayerSparseGradientTest", "[ANNLayerTest]")
+{
+  const size_t vocabSize = 50;
+  const size_t embeddingSize = 4;
+  const size_t seqLength = 6;
+  const size_t batchSize = 3;
+
+  Lookup<> module(vocabSize, embeddingSize);
+  module.Parameters().randu();
+
+  arma::mat input(seqLength, batchSize);
+  for (size_t i = 0; i < input.n_elem; ++i)
+    input(i) = math::RandInt(1, vocabSize);
+
+  arma::mat error = 0.01 * arma::randu(embeddingSize * seqLength, batchSize);
+
+  arma::mat denseGradient;
+  module.Gradient(input, error, denseGradient);
+
+  // The sparse path only rewrites the columns touched by the current and the
+  // previous pass; starting from a zeroed gradient of the right size matches
+  // the contract of the FFN gradient machinery.
+  arma::mat sparseGradient(embeddingSize, vocabSize, arma::fill::zeros);
+  module.SparseGradient() = true;
+  module.Gradient(input, error, sparseGradient);
+
+  CheckMatrices(denseGradient, sparseGradient, 1e-10);
+
+  // The emitted (index, slice) pairs have to match the dense gradient.
+  REQUIRE(module.GradientIndices().n_elem <= seqLength * batchSize);
+  for (size_t i = 0; i < module.GradientIndices().n_elem; ++i)
+  {
+    CheckMatrices(arma::mat(module.GradientSlices().col(i)),
+        arma::mat(denseGradient.col(module.GradientIndices()[i])), 1e-10);
+  }
+
+  // A second sparse pass with different tokens has to clear the columns the
+  // first pass wrote.
+  arma::mat secondInput(seqLength, batchSize);
+  for (size_t i = 0; i < secondInput.n_elem; ++i)
+    secondInput(i) = math::RandInt(1, vocabSize);
+
+  Lookup<> reference(vocabSize, embeddingSize);
+  arma::mat secondDenseGradient;
+  reference.Gradient(secondInput, error, secondDenseGradient);
+
+  module.Gradient(secondInput, error, sparseGradient);
+  CheckMatrices(secondDenseGradient, sparseGradient, 1e-10);
+}
+
 /**
  * Simple LogSoftMax module test.
  */
@@ -193,3 +193,39 @@ TEST_CASE("EqualtoRidge", "[BayesianLinearRegressionTest]")
 
   REQUIRE(trial <= 3);
 }
+
+// Check that training on chunks with TrainIncremental() matches a batch
+// Train() on the concatenated data.
+TEST_CASE("IncrementalMatchesBatch", "[BayesianLinearRegressionTest]")
+{
+  arma::mat matX;
+  arma::rowvec y;
+  GenerateProblem(matX, y, 300, 10, 0.5);
+
+  BayesianLinearRegression batch(true, true), incremental(true, true);
+  batch.Train(matX, y);
+
+  // Feed the same data in three chunks.
+  incremental.TrainIncremental(matX.cols(0, 99), y.cols(0, 99));
+  incremental.TrainIncremental(matX.cols(100, 199), y.cols(100, 199));
+  incremental.TrainIncremental(matX.cols(200, 299), y.cols(200, 299));
+
+  REQUIRE(incremental.Alpha() == Approx(batch.Alpha()).epsilon(1e-3));
+  REQUIRE(incremental.Beta() == Approx(batch.Beta()).epsilon(1e-3));
+  for (size_t i = 0; i < matX.n_rows; ++i)
+    REQUIRE(incremental.Omega()[i] == Approx(batch.Omega()[i]).margin(1e-5));
+
+  // After Reset() the next chunk starts a new window.
+  incremental.Reset();
+  incremental.TrainIncremental(matX.cols(0, 99), y.cols(0, 99));
+  batch.Train(matX.cols(0, 99), y.cols(0, 99));
+  for (size_t i = 0; i < matX.n_rows; ++i)
+    REQUIRE(incremental.Omega()[i] == Approx(batch.Omega()[i]).margin(1e-5));
+
+  // A chunk of the wrong dimensionality must be refused.
+  arma::mat badX;
+  arma::rowvec badY;
+  GenerateProblem(badX, badY, 10, 5);
+  REQUIRE_THROWS_AS(incremental.TrainIncremental(badX, badY),
+      std::invalid_argument);
+}
@@ -375,3 +375,72 @@ TEST_CASE("BiasSVDFunctionParallelOptimize", "[BiasSVDTest]")
 }
 
 #endif
+
+// Test Bias SVD with the sharded (DSGD) parallel trainer.
+TEST_CASE("BiasSVDApplyParallelTest", "[BiasSVDTest]")
+{
+  // Define useful constants.
+  const size_t numUsers = 50;
+  const size_t numItems = 50;
+  const size_t numRatings = 100;
+  const size_t iterations = 30;
+  const size_t rank = 10;
+  const double alpha = 0.01;
+  const double lambda = 0.01;
+
+  // Initiate random parameters.
+  arma::mat parameters = arma::randu(rank + 1, numUsers + numItems);
+
+  // Make a random rating dataset.
+  arma::mat data = arma::randu(3, numRatings);
+  data.row(0) = floor(data.row(0) * numUsers);
+  data.row(1) = floor(data.row(1) * numItems);
+
+  // Manually set last row to maximum user and maximum item.
+  data(0, numRatings - 1) = numUsers - 1;
+  data(1, numRatings - 1) = numItems - 1;
+
+  // Make rating entries based on the parameters.
+  for (size_t i = 0; i < numRatings; ++i)
+  {
+    const size_t user = data(0, i);
+    const size_t item = data(1, i) + numUsers;
+    const double userBias = parameters(rank, user);
+    const double itemBias = parameters(rank, item);
+    data(2, i) = userBias + itemBias +
+        arma::dot(parameters.col(user).subvec(0, rank - 1),
+                  parameters.col(item).subvec(0, rank - 1));
+  }
+
+  // Train with the sharded parallel trainer.
+  BiasSVD<> biasSVD(iterations, alpha, lambda);
+  arma::mat itemLatent, userLatent;
+  arma::vec itemBiases, userBiases;
+  biasSVD.ApplyParallel(data, rank, itemLatent, userLatent, itemBiases,
+      userBiases);
+
+  // Check the size of outputs.
+  REQUIRE(itemLatent.n_rows == numItems);
+  REQUIRE(itemLatent.n_cols == rank);
+  REQUIRE(userLatent.n_rows == rank);
+  REQUIRE(userLatent.n_cols == numUsers);
+  REQUIRE(itemBiases.n_elem == numItems);
+  REQUIRE(userBiases.n_elem == numUsers);
+
+  // Get predicted ratings from the factorization.
+  arma::mat predictedData(1, numRatings);
+  for (size_t i = 0; i < numRatings; ++i)
+  {
+    const size_t user = data(0, i);
+    const size_t item = data(1, i);
+    predictedData(0, i) = userBiases(user) + itemBiases(item) +
+        arma::dot(itemLatent.row(item), userLatent.col(user));
+  }
+
+  // Calculate relative error.
+  const double relativeError = arma::norm(data.row(2) - predictedData, "frob") /
+                               arma::norm(data, "frob");
+
+  // Relative error should be small.
+  REQUIRE(relativeError == Approx(0.0).margin(1e-2));
+}
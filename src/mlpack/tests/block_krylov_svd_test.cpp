@@ -106,3 +106,32 @@ TEST_CASE("RandomizedBlockKrylovSVDNoisyLowRankTest", "[BlockKrylovSVDTest]")
   double error = arma::max(arma::abs(s1.subvec(0, rank) - s2.subvec(0, rank)));
   REQUIRE(error == Approx(0.0).margin(1e-4));
 }
+
+/**
+ * The method must also work on sparse matrices, with singular values close
+ * to those of the equivalent dense decomposition.
+ */
+TEST_CASE("RandomizedBlockKrylovSVDSparseTest", "[BlockKrylovSVDTest]")
+{
+  arma::sp_mat data;
+  data.sprandu(200, 500, 0.05);
+
+  arma::mat dense(data);
+
+  arma::mat U1, U2, V1, V2;
+  arma::vec s1, s2;
+
+  arma::svd_econ(U1, s1, V1, dense);
+
+  svd::RandomizedBlockKrylovSVD rSVD(10, 30);
+  rSVD.Apply(data, U2, s2, V2, 20);
+
+  // The leading singular values must match the dense decomposition.
+  for (size_t i = 0; i < 20; ++i)
+    REQUIRE(s2[i] == Approx(s1[i]).epsilon(1e-3).margin(1e-5));
+
+  // The basis returned must be orthonormal.
+  arma::mat gram = U2.t() * U2;
+  REQUIRE(arma::norm(gram - arma::eye(gram.n_rows, gram.n_cols), "fro") ==
+      Approx(0.0).margin(1e-8));
+}
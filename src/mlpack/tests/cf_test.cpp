@@ -17,6 +17,7 @@
 #include <mlpack/methods/cf/decomposition_policies/bias_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/randomized_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/regularized_svd_method.hpp>
+#include <mlpack/methods/cf/decomposition_policies/sgd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/svd_complete_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/svd_incomplete_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/svdplusplus_method.hpp>
@@ -117,6 +118,55 @@ void GetRecommendationsAllUsers()
   REQUIRE(recommendations.n_cols == numUsers);
 }
 
+/**
+ * Make sure that RecommendBatch() generates the correct number of valid,
+ * unrated recommendations for all users and for a queried subset of users.
+ */
+template<typename DecompositionPolicy>
+void RecommendBatchUsers()
+{
+  DecompositionPolicy decomposition;
+  // Dummy number of recommendations.
+  size_t numRecs = 3;
+  // GroupLensSmall.csv dataset has 200 users.
+  size_t numUsers = 200;
+
+  // Matrix to save recommendations into.
+  arma::Mat<size_t> recommendations;
+
+  // Load GroupLens data.
+  arma::mat dataset;
+  if (!data::Load("GroupLensSmall.csv", dataset))
+    FAIL("Cannot load test dataset GroupLensSmall.csv!");
+
+  CFType<DecompositionPolicy> c(dataset, decomposition, 5, 5, 30);
+
+  // Generate recommendations for all users.
+  c.RecommendBatch(numRecs, recommendations);
+
+  // Check if correct number of recommendations are generated.
+  REQUIRE(recommendations.n_rows == numRecs);
+  REQUIRE(recommendations.n_cols == numUsers);
+
+  // Check that every recommended item is valid and unrated by its user.
+  const arma::sp_mat& cleanedData = c.CleanedData();
+  for (size_t i = 0; i < recommendations.n_cols; ++i)
+  {
+    for (size_t j = 0; j < recommendations.n_rows; ++j)
+    {
+      REQUIRE(recommendations(j, i) < cleanedData.n_rows);
+      REQUIRE(cleanedData(recommendations(j, i), i) == 0.0);
+    }
+  }
+
+  // Generate recommendations for a queried subset of users.
+  arma::Col<size_t> users("2 12 22");
+  c.RecommendBatch(numRecs, recommendations, users);
+
+  REQUIRE(recommendations.n_rows == numRecs);
+  REQUIRE(recommendations.n_cols == users.n_elem);
+}
+
 /**
  * Make sure that the recommendations are generated for queried users only.
  */
@@ -578,6 +628,31 @@ TEST_CASE("CFGetRecommendationsAllUsersSVDPPTest", "[CFTest]")
   GetRecommendationsAllUsers<SVDPlusPlusPolicy>();
 }
 
+/**
+ * Make sure that correct number of recommendations are generated when query
+ * set for parallel SGD method.
+ */
+TEST_CASE("CFGetRecommendationsAllUsersSGDTest", "[CFTest]")
+{
+  GetRecommendationsAllUsers<SGDPolicy>();
+}
+
+/**
+ * Make sure RecommendBatch() generates valid recommendations for NMF.
+ */
+TEST_CASE("CFRecommendBatchNMFTest", "[CFTest]")
+{
+  RecommendBatchUsers<NMFPolicy>();
+}
+
+/**
+ * Make sure RecommendBatch() generates valid recommendations for batch SVD.
+ */
+TEST_CASE("CFRecommendBatchBatchSVDTest", "[CFTest]")
+{
+  RecommendBatchUsers<BatchSVDPolicy>();
+}
+
 /**
  * Make sure that the recommendations are generated for queried users only
  * for randomized SVD.
@@ -650,6 +725,15 @@ TEST_CASE("CFGetRecommendationsQueriedUserSVDPPTest", "[CFTest]")
   GetRecommendationsQueriedUser<SVDPlusPlusPolicy>();
 }
 
+/**
+ * Make sure that the recommendations are generated for queried users only
+ * for parallel SGD method.
+ */
+TEST_CASE("CFGetRecommendationsQueriedUserSGDTest", "[CFTest]")
+{
+  GetRecommendationsQueriedUser<SGDPolicy>();
+}
+
 /**
  * Make sure recommendations that are generated are reasonably accurate
  * for randomized SVD.
@@ -786,6 +870,15 @@ TEST_CASE("CFPredictSVDPPTest", "[CFTest]")
   CFPredict<SVDPlusPlusPolicy>();
 }
 
+/**
+ * Make sure that Predict() is returning reasonable results for parallel SGD
+ * method.
+ */
+TEST_CASE("CFPredictSGDTest", "[CFTest]")
+{
+  CFPredict<SGDPolicy>();
+}
+
 // Compare batch Predict() and individual Predict() for randomized SVD.
 TEST_CASE("CFBatchPredictRandSVDTest", "[CFTest]")
 {
@@ -838,6 +931,13 @@ TEST_CASE("CFBatchPredictSVDPPTest", "[CFTest]")
   BatchPredict<SVDPlusPlusPolicy>();
 }
 
+// Compare batch Predict() and individual Predict() for
+// parallel SGD method.
+TEST_CASE("CFBatchPredictSGDTest", "[CFTest]")
+{
+  BatchPredict<SGDPolicy>();
+}
+
 /**
  * Make sure we can train an already-trained model and it works okay for
  * randomized SVD.
@@ -918,6 +1018,16 @@ TEST_CASE("TrainSVDPPTest", "[CFTest]")
   TrainWithCoordinateList(decomposition);
 }
 
+/**
+ * Make sure we can train an already-trained model and it works okay for
+ * parallel SGD method.
+ */
+TEST_CASE("TrainSGDTest", "[CFTest]")
+{
+  SGDPolicy decomposition;
+  Train(decomposition);
+}
+
 /**
  * Make sure we can train a model after using the empty constructor when
  * using randomized SVD.
@@ -0,0 +1,120 @@
+/**
+ * @file tests/columnar_dataset_test.cpp
+ *
+ * Tests for the ColumnarDataset container.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/data/columnar_dataset.hpp>
+#include <mlpack/methods/decision_tree/decision_tree.hpp>
+
+#include "catch.hpp"
+#include "test_catch_tools.hpp"
+#include "serialization.hpp"
+
+using namespace mlpack;
+using namespace mlpack::data;
+
+/**
+ * A mixed dataset should round-trip exactly through the compressed
+ * representation, whichever encoding each dimension gets.
+ */
+TEST_CASE("ColumnarDatasetRoundTripTest", "[ColumnarDatasetTest]")
+{
+  arma::mat dataset(4, 500);
+  dataset.row(0) = arma::randu<arma::rowvec>(500); // High cardinality.
+  dataset.row(1) = arma::floor(5 * arma::randu<arma::rowvec>(500)); // Dict.
+  dataset.row(2).fill(3.0); // Constant; one run.
+  for (size_t i = 0; i < 500; ++i)
+    dataset(3, i) = (double) (i / 100); // Five long runs.
+
+  ColumnarDataset columnar(dataset);
+
+  REQUIRE(columnar.NumDimensions() == 4);
+  REQUIRE(columnar.NumPoints() == 500);
+  REQUIRE(columnar.Encoding(0) == ColumnarDataset::RAW);
+  REQUIRE(columnar.Encoding(1) == ColumnarDataset::DICTIONARY);
+  REQUIRE(columnar.Encoding(2) == ColumnarDataset::RLE);
+  REQUIRE(columnar.Encoding(3) == ColumnarDataset::RLE);
+
+  // The compressed representation should be smaller than the dense matrix.
+  REQUIRE(columnar.CompressedBytes() < 8 * dataset.n_elem);
+
+  // Element access must decode exactly.
+  for (size_t d = 0; d < 4; ++d)
+    for (size_t i = 0; i < 500; ++i)
+      REQUIRE(columnar(d, i) == dataset(d, i));
+
+  // The lazily materialized views must match too.
+  for (size_t d = 0; d < 4; ++d)
+  {
+    const arma::rowvec& view = columnar.DimensionView(d);
+    for (size_t i = 0; i < 500; ++i)
+      REQUIRE(view[i] == dataset(d, i));
+  }
+
+  CheckMatrices(columnar.DenseView(), dataset);
+
+  // Dropping the views must not affect the compressed data.
+  columnar.ClearViews();
+  CheckMatrices(columnar.DenseView(), dataset);
+}
+
+/**
+ * Test that a DecisionTree can be trained directly from the container using
+ * the dense view and the stored type information.
+ */
+TEST_CASE("ColumnarDatasetDecisionTreeTest", "[ColumnarDatasetTest]")
+{
+  // Two numeric dimensions and one categorical dimension; the label is
+  // determined by the categorical dimension.
+  arma::mat dataset(3, 400);
+  dataset.rows(0, 1) = arma::randu<arma::mat>(2, 400);
+  arma::Row<size_t> labels(400);
+  for (size_t i = 0; i < 400; ++i)
+  {
+    dataset(2, i) = (double) (i % 3);
+    labels[i] = i % 3;
+  }
+
+  DatasetInfo info(3);
+  info.Type(2) = Datatype::categorical;
+  for (size_t i = 0; i < 3; ++i)
+    info.MapString<double>(std::to_string(i), 2);
+
+  ColumnarDataset columnar(dataset, info);
+  REQUIRE(columnar.Info().Type(2) == Datatype::categorical);
+
+  tree::DecisionTree<> tree(columnar.DenseView(), columnar.Info(), labels, 3,
+      1);
+
+  arma::Row<size_t> predictions;
+  tree.Classify(columnar.DenseView(), predictions);
+
+  for (size_t i = 0; i < 400; ++i)
+    REQUIRE(predictions[i] == labels[i]);
+}
+
+/**
+ * Test serialization of the compressed container.
+ */
+TEST_CASE("ColumnarDatasetSerializationTest", "[ColumnarDatasetTest]")
+{
+  arma::mat dataset(3, 200);
+  dataset.row(0) = arma::randu<arma::rowvec>(200);
+  dataset.row(1) = arma::floor(4 * arma::randu<arma::rowvec>(200));
+  dataset.row(2).fill(1.0);
+
+  ColumnarDataset columnar(dataset);
+  ColumnarDataset xmlColumnar, jsonColumnar, binaryColumnar;
+
+  SerializeObjectAll(columnar, xmlColumnar, jsonColumnar, binaryColumnar);
+
+  CheckMatrices(columnar.DenseView(), xmlColumnar.DenseView());
+  CheckMatrices(columnar.DenseView(), jsonColumnar.DenseView());
+  CheckMatrices(columnar.DenseView(), binaryColumnar.DenseView());
+}
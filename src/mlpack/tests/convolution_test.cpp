@@ -16,6 +16,9 @@
 #include <mlpack/methods/ann/convolution_rules/naive_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/fft_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/svd_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/gemm_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/winograd_convolution.hpp>
+#include <mlpack/methods/ann/util/inference_backend.hpp>
 
 #include "serialization.hpp"
 #include "catch.hpp"
@@ -148,6 +151,14 @@ TEST_CASE("ValidConvolution2DTest", "[ConvolutionTest]")
   // speed up the computation.
   Convolution2DMethodTest<SVDConvolution<ValidConvolution> >(input, filter,
       output);
+
+  // Perform the convolution as an im2col matrix multiplication.
+  Convolution2DMethodTest<GemmConvolution<ValidConvolution> >(input, filter,
+      output);
+
+  // Perform the convolution with the Winograd minimal filtering algorithm.
+  Convolution2DMethodTest<WinogradConvolution<ValidConvolution> >(input,
+      filter, output);
 }
 
 /**
@@ -185,6 +196,14 @@ TEST_CASE("FullConvolution2DTest", "[ConvolutionTest]")
   // speed up the computation.
   Convolution2DMethodTest<SVDConvolution<FullConvolution> >(input, filter,
       output);
+
+  // Perform the convolution as an im2col matrix multiplication.
+  Convolution2DMethodTest<GemmConvolution<FullConvolution> >(input, filter,
+      output);
+
+  // Perform the convolution with the Winograd minimal filtering algorithm.
+  Convolution2DMethodTest<WinogradConvolution<FullConvolution> >(input,
+      filter, output);
 }
 
 /**
@@ -230,6 +249,14 @@ TEST_CASE("ValidConvolution3DTest", "[ConvolutionTest]")
   // speed up the computation.
   Convolution3DMethodTest<SVDConvolution<ValidConvolution> >(inputCube,
       filterCube, outputCube);
+
+  // Perform the convolution as an im2col matrix multiplication.
+  Convolution3DMethodTest<GemmConvolution<ValidConvolution> >(inputCube,
+      filterCube, outputCube);
+
+  // Perform the convolution with the Winograd minimal filtering algorithm.
+  Convolution3DMethodTest<WinogradConvolution<ValidConvolution> >(inputCube,
+      filterCube, outputCube);
 }
 
 /**
@@ -279,6 +306,14 @@ TEST_CASE("FullConvolution3DTest", "[ConvolutionTest]")
   // speed up the computation.
   Convolution3DMethodTest<SVDConvolution<FullConvolution> >(inputCube,
       filterCube, outputCube);
+
+  // Perform the convolution as an im2col matrix multiplication.
+  Convolution3DMethodTest<GemmConvolution<FullConvolution> >(inputCube,
+      filterCube, outputCube);
+
+  // Perform the convolution with the Winograd minimal filtering algorithm.
+  Convolution3DMethodTest<WinogradConvolution<FullConvolution> >(inputCube,
+      filterCube, outputCube);
 }
 
 /**
@@ -321,6 +356,14 @@ TEST_CASE("ValidConvolutionBatchTest", "[ConvolutionTest]")
   // speed up the computation.
   ConvolutionMethodBatchTest<SVDConvolution<ValidConvolution> >(input,
       filterCube, outputCube);
+
+  // Perform the convolution as an im2col matrix multiplication.
+  ConvolutionMethodBatchTest<GemmConvolution<ValidConvolution> >(input,
+      filterCube, outputCube);
+
+  // Perform the convolution with the Winograd minimal filtering algorithm.
+  ConvolutionMethodBatchTest<WinogradConvolution<ValidConvolution> >(input,
+      filterCube, outputCube);
 }
 
 /**
@@ -367,4 +410,80 @@ TEST_CASE("FullConvolutionBatchTest", "[ConvolutionTest]")
   // speed up the computation.
   ConvolutionMethodBatchTest<SVDConvolution<FullConvolution> >(input,
       filterCube, outputCube);
+
+  // Perform the convolution as an im2col matrix multiplication.
+  ConvolutionMethodBatchTest<GemmConvolution<FullConvolution> >(input,
+      filterCube, outputCube);
+
+  // Perform the convolution with the Winograd minimal filtering algorithm.
+  ConvolutionMethodBatchTest<WinogradConvolution<FullConvolution> >(input,
+      filterCube, outputCube);
+}
+
+/**
+ * Test the Winograd convolution against the naive method for shapes that do
+ * not tile evenly into 2x2 output blocks, and for configurations that fall
+ * back to the direct method.
+ */
+TEST_CASE("WinogradConvolutionShapeTest", "[ConvolutionTest]")
+{
+  arma::mat input = arma::randu<arma::mat>(7, 6);
+  arma::mat filter = arma::randu<arma::mat>(3, 3);
+
+  // The 5x4 valid output has an odd number of rows, so the last tile row is
+  // cropped.
+  arma::mat output;
+  NaiveConvolution<ValidConvolution>::Convolution(input, filter, output);
+  Convolution2DMethodTest<WinogradConvolution<ValidConvolution> >(input,
+      filter, output);
+
+  NaiveConvolution<FullConvolution>::Convolution(input, filter, output);
+  Convolution2DMethodTest<WinogradConvolution<FullConvolution> >(input,
+      filter, output);
+
+  // A 5x5 filter takes the fallback path.
+  filter = arma::randu<arma::mat>(5, 5);
+  NaiveConvolution<ValidConvolution>::Convolution(input, filter, output);
+  Convolution2DMethodTest<WinogradConvolution<ValidConvolution> >(input,
+      filter, output);
+}
+
+/**
+ * Test that the gemm-based convolution dispatches its product to a registered
+ * inference backend and produces the same output, and that the backend is
+ * bypassed below the dispatch threshold.
+ */
+TEST_CASE("GemmConvolutionBackendTest", "[ConvolutionTest]")
+{
+  arma::mat input = arma::randu<arma::mat>(12, 12);
+  arma::cube filter = arma::randu<arma::cube>(3, 3, 4);
+
+  arma::cube expected;
+  GemmConvolution<ValidConvolution>::Convolution(input, filter, expected);
+
+  // Register a counting backend and make every product large enough to
+  // dispatch.
+  size_t calls = 0;
+  InferenceBackend::Gemm() = [&calls](const arma::mat& a, const arma::mat& b,
+      arma::mat& c) { c = a * b; ++calls; return true; };
+  InferenceBackend::Threshold() = 0;
+
+  arma::cube output;
+  GemmConvolution<ValidConvolution>::Convolution(input, filter, output);
+  REQUIRE(calls == 1);
+
+  // Below the threshold the plain path is kept.
+  InferenceBackend::Threshold() = InferenceBackend::DefaultThreshold;
+  arma::cube outputBypassed;
+  GemmConvolution<ValidConvolution>::Convolution(input, filter,
+      outputBypassed);
+  REQUIRE(calls == 1);
+
+  InferenceBackend::Gemm() = InferenceBackend::GemmType();
+
+  for (size_t i = 0; i < expected.n_elem; ++i)
+  {
+    REQUIRE(output[i] == Approx(expected[i]).epsilon(1e-5));
+    REQUIRE(outputBypassed[i] == Approx(expected[i]).epsilon(1e-5));
+  }
 }
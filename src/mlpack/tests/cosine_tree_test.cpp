@@ -431,3 +431,35 @@ TEST_CASE("MoveConstructorAndOperatorCosineTreeTest", "[CosineTreeTest]")
     REQUIRE(v1.at(i) == v3.at(i));
   }
 }
+
+/**
+ * Constructs a cosine tree with a maximum basis size. The obtained basis
+ * should respect the budget and still be orthonormal.
+ */
+TEST_CASE("CosineTreeMaxBasisSize", "[CosineTreeTest]")
+{
+  // Initialize constants required for the test.
+  const size_t numRows = 10;
+  const size_t numCols = 500;
+  const double epsilon = 0.01;
+  const double delta = 0.1;
+  const size_t maxBasisSize = 5;
+
+  // Make a random dataset.
+  arma::mat data = arma::randu(numRows, numCols);
+
+  // Construct a cosine tree with a budget on the basis size.
+  CosineTree ctree(data, epsilon, delta, maxBasisSize);
+
+  // Get the basis obtained from the tree.
+  arma::mat basis;
+  ctree.GetFinalBasis(basis);
+
+  // The budget must be respected.
+  REQUIRE(basis.n_cols <= maxBasisSize);
+
+  // The budgeted basis should still be orthonormal.
+  arma::mat gram = basis.t() * basis;
+  REQUIRE(arma::norm(gram - arma::eye(gram.n_rows, gram.n_cols), "frob") ==
+      Approx(0.0).margin(1e-6));
+}
@@ -15,6 +15,7 @@
 #include <mlpack/core/cv/metrics/accuracy.hpp>
 #include <mlpack/core/cv/metrics/f1.hpp>
 #include <mlpack/core/cv/metrics/mse.hpp>
+#include <mlpack/core/cv/metrics/multi_metric.hpp>
 #include <mlpack/core/cv/metrics/precision.hpp>
 #include <mlpack/core/cv/metrics/recall.hpp>
 #include <mlpack/core/cv/metrics/r2_score.hpp>
@@ -779,3 +780,134 @@ TEST_CASE("SilhouetteScoreTest", "[CVTest]")
   double silhouetteScore = SilhouetteScore::Overall(X, labels, metric);
   REQUIRE(silhouetteScore == Approx(0.1121684822489150).epsilon(1e-7));
 }
+
+/**
+ * Test that MultiMetric computes the same values as evaluating each
+ * classification metric separately, with only one prediction pass.
+ */
+TEST_CASE("MultiMetricClassificationTest", "[CVTest]")
+{
+  // The same linearly separable setup as in BinaryClassificationMetricsTest.
+  arma::mat data = arma::linspace<arma::rowvec>(1.0, 10.0, 10);
+  arma::Row<size_t> labels("0 0 1 0 0  1 0 1 0 1");
+  arma::Row<size_t> predictedLabels("0 0 0 0 0  1 1 1 1 1");
+
+  LogisticRegression<> lr(data, predictedLabels);
+
+  arma::vec results =
+      MultiMetric<Accuracy, F1<Binary>, F1<Micro>>::Evaluate(lr, data, labels);
+
+  REQUIRE(results.n_elem == 3);
+  REQUIRE(results[0] == Approx(Accuracy::Evaluate(lr, data, labels)).
+      epsilon(1e-7));
+  REQUIRE(results[1] == Approx(F1<Binary>::Evaluate(lr, data, labels)).
+      epsilon(1e-7));
+  REQUIRE(results[2] == Approx(F1<Micro>::Evaluate(lr, data, labels)).
+      epsilon(1e-7));
+}
+
+/**
+ * Test that MultiMetric works for regression metrics too.
+ */
+TEST_CASE("MultiMetricRegressionTest", "[CVTest]")
+{
+  // Making two points that define the linear function f(x) = x - 1.
+  arma::mat trainingData("0 1");
+  arma::rowvec trainingResponses("-1 0");
+
+  LinearRegression lr(trainingData, trainingResponses);
+
+  // Making three responses that differ from the correct ones by 0, 1, and 2
+  // respectively.
+  arma::mat data("2 3 4");
+  arma::rowvec responses("1 3 5");
+
+  arma::vec results = MultiMetric<MSE>::Evaluate(lr, data, responses);
+
+  REQUIRE(results.n_elem == 1);
+  REQUIRE(results[0] == Approx(MSE::Evaluate(lr, data, responses)).
+      epsilon(1e-7));
+}
+
+/**
+ * Test bootstrap confidence intervals: the interval bounds must be ordered,
+ * bracket values achievable by resampling, and the point estimates must match
+ * a plain evaluation.
+ */
+TEST_CASE("MultiMetricBootstrapTest", "[CVTest]")
+{
+  arma::mat data = arma::linspace<arma::rowvec>(1.0, 10.0, 10);
+  arma::Row<size_t> labels("0 0 1 0 0  1 0 1 0 1");
+  arma::Row<size_t> predictedLabels("0 0 0 0 0  1 1 1 1 1");
+
+  LogisticRegression<> lr(data, predictedLabels);
+
+  arma::mat results = MultiMetric<Accuracy, F1<Binary>>::BootstrapEvaluate(
+      lr, data, labels, 200, 0.9);
+
+  REQUIRE(results.n_rows == 2);
+  REQUIRE(results.n_cols == 3);
+
+  arma::vec pointEstimates =
+      MultiMetric<Accuracy, F1<Binary>>::Evaluate(lr, data, labels);
+  for (size_t m = 0; m < 2; ++m)
+  {
+    REQUIRE(results(m, 0) == Approx(pointEstimates[m]).epsilon(1e-7));
+    REQUIRE(results(m, 1) <= results(m, 2));
+    REQUIRE(results(m, 1) >= 0.0);
+    REQUIRE(results(m, 2) <= 1.0);
+  }
+
+  // Invalid arguments should be rejected.
+  REQUIRE_THROWS_AS(MultiMetric<Accuracy>::BootstrapEvaluate(lr, data, labels,
+      0), std::invalid_argument);
+  REQUIRE_THROWS_AS(MultiMetric<Accuracy>::BootstrapEvaluate(lr, data, labels,
+      200, 1.5), std::invalid_argument);
+}
+
+/**
+ * Test that KFoldCV::EvaluateMetrics() agrees with separate single-metric
+ * k-fold runs over the same (unshuffled) folds.
+ */
+TEST_CASE("KFoldCVEvaluateMetricsTest", "[CVTest]")
+{
+  // The same setup as in KFoldCVAccuracyTest.
+  arma::mat data("0 1 2 3 100 101 102 103 104 5");
+  arma::Row<size_t> labels("0 0 0 0 1 1 1 1 1 1");
+  size_t numClasses = 2;
+
+  KFoldCV<NaiveBayesClassifier<>, Accuracy> cv(10, data, labels, numClasses,
+      false);
+
+  arma::vec results =
+      cv.template EvaluateMetrics<Accuracy, F1<Micro>>();
+
+  // Both metrics resolve to accuracy here; the expected value is the same as
+  // in KFoldCVAccuracyTest.
+  double expectedAccuracy = (9 * 1.0 + 0.0) / 10;
+
+  REQUIRE(results.n_elem == 2);
+  REQUIRE(results[0] == Approx(expectedAccuracy).epsilon(1e-7));
+  REQUIRE(results[1] == Approx(expectedAccuracy).epsilon(1e-7));
+
+  // Assert we can access a trained model without the exception of
+  // uninitialization.
+  REQUIRE_NOTHROW(cv.Model());
+}
+
+/**
+ * Test KFoldCV::EvaluateMetrics() for a regression task.
+ */
+TEST_CASE("KFoldCVEvaluateMetricsMSETest", "[CVTest]")
+{
+  // The same setup as in KFoldCVMSETest.
+  arma::mat data("0 1  0 1");
+  arma::rowvec responses("0 1  1 3");
+
+  KFoldCV<LinearRegression, MSE> cv(2, data, responses, false);
+
+  arma::vec results = cv.template EvaluateMetrics<MSE>();
+
+  REQUIRE(results.n_elem == 1);
+  REQUIRE(results[0] == Approx(cv.Evaluate()).epsilon(1e-7));
+}
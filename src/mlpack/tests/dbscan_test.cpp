@@ -306,3 +306,80 @@ TEST_CASE("RandomPointSelectionTest", "[DBSCANTest]")
   // The number of assignments returned should be the same as points.
   REQUIRE(assignments.n_elem == points.n_cols);
 }
+
+/**
+ * The lock-free union-find used by the batch union pass should produce the
+ * same components as the serial union-find, even when the unions are applied
+ * from multiple threads.
+ */
+TEST_CASE("ConcurrentUnionFindTest", "[DBSCANTest]")
+{
+  const size_t numPoints = 5000;
+  const size_t numEdges = 20000;
+
+  // Build a random edge list.
+  arma::Mat<size_t> edges(2, numEdges);
+  for (size_t i = 0; i < numEdges; ++i)
+  {
+    edges(0, i) = math::RandInt(0, numPoints);
+    edges(1, i) = math::RandInt(0, numPoints);
+  }
+
+  // Apply the edges serially to the reference structure.
+  emst::UnionFind uf(numPoints);
+  for (size_t i = 0; i < numEdges; ++i)
+    uf.Union(edges(0, i), edges(1, i));
+
+  // Apply the edges in parallel to the concurrent structure.
+  ConcurrentUnionFind cuf(numPoints);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) numEdges; ++i)
+    cuf.Union(edges(0, i), edges(1, i));
+
+  // The components must match: two points share a root in one structure if
+  // and only if they share a root in the other.  The concurrent structure
+  // roots each component at its smallest member, so map the reference roots
+  // through that convention.
+  std::map<size_t, size_t> rootMap;
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    const size_t refRoot = uf.Find(i);
+    if (rootMap.count(refRoot) == 0)
+      rootMap[refRoot] = cuf.Find(i);
+    REQUIRE(cuf.Find(i) == rootMap[refRoot]);
+  }
+}
+
+/**
+ * Batch mode and pointwise mode should agree on the clustering.
+ */
+TEST_CASE("BatchPointwiseEquivalenceTest", "[DBSCANTest]")
+{
+  arma::mat points(10, 1000, arma::fill::randu);
+
+  DBSCAN<> batch(0.3, 4, true);
+  DBSCAN<> pointwise(0.3, 4, false);
+
+  arma::Row<size_t> batchAssignments, pointwiseAssignments;
+  const size_t batchClusters = batch.Cluster(points, batchAssignments);
+  const size_t pointwiseClusters = pointwise.Cluster(points,
+      pointwiseAssignments);
+
+  REQUIRE(batchClusters == pointwiseClusters);
+
+  // The cluster numbering may differ between the two modes, so compare the
+  // assignments up to a relabeling; noise points must match exactly.
+  std::map<size_t, size_t> labelMap;
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    if (batchAssignments[i] == SIZE_MAX)
+    {
+      REQUIRE(pointwiseAssignments[i] == SIZE_MAX);
+      continue;
+    }
+
+    if (labelMap.count(batchAssignments[i]) == 0)
+      labelMap[batchAssignments[i]] = pointwiseAssignments[i];
+    REQUIRE(pointwiseAssignments[i] == labelMap[batchAssignments[i]]);
+  }
+}
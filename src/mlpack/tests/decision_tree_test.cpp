@@ -13,6 +13,7 @@
 #include <mlpack/methods/decision_tree/decision_tree.hpp>
 #include <mlpack/methods/decision_tree/information_gain.hpp>
 #include <mlpack/methods/decision_tree/gini_gain.hpp>
+#include <mlpack/methods/decision_tree/histogram_numeric_split.hpp>
 #include <mlpack/methods/decision_tree/random_dimension_select.hpp>
 #include <mlpack/methods/decision_tree/multiple_random_dimension_select.hpp>
 
@@ -412,6 +413,51 @@ TEST_CASE("AllCategoricalSplitSimpleSplitTest", "[DecisionTreeTest]")
   REQUIRE((size_t) classProbabilities[0] == 4);
 }
 
+/**
+ * Check that the histogram-based gain of AllCategoricalSplit matches the gain
+ * computed by evaluating the fitness function on the extracted labels of each
+ * child.
+ */
+TEST_CASE("AllCategoricalSplitHistogramGainTest", "[DecisionTreeTest]")
+{
+  const size_t numCategories = 5;
+  const size_t numClasses = 3;
+  arma::vec values = arma::floor(arma::randu<arma::vec>(500) * numCategories);
+  arma::Row<size_t> labels = arma::randi<arma::Row<size_t>>(500,
+      arma::distr_param(0, numClasses - 1));
+  arma::rowvec weights = arma::randu<arma::rowvec>(500) + 0.25;
+
+  arma::vec classProbabilities;
+  AllCategoricalSplit<GiniGain>::template AuxiliarySplitInfo<double> aux;
+
+  // Use a best gain poor enough that the split is always taken.
+  const double gain = AllCategoricalSplit<GiniGain>::SplitIfBetter<false>(
+      -0.75, values, numCategories, labels, numClasses, weights, 1, 1e-7,
+      classProbabilities, aux);
+  const double weightedGain =
+      AllCategoricalSplit<GiniGain>::SplitIfBetter<true>(-0.75, values,
+      numCategories, labels, numClasses, weights, 1, 1e-7, classProbabilities,
+      aux);
+
+  // Recompute both gains by materializing the children.
+  double refGain = 0.0, refWeightedGain = 0.0;
+  const double sumWeights = arma::accu(weights);
+  for (size_t c = 0; c < numCategories; ++c)
+  {
+    const arma::uvec members = arma::find(values == c);
+    const arma::Row<size_t> childLabels = labels.cols(members);
+    const arma::rowvec childWeights = weights.cols(members);
+
+    refGain += (double(members.n_elem) / double(values.n_elem)) *
+        GiniGain::Evaluate<false>(childLabels, numClasses, childWeights);
+    refWeightedGain += (arma::accu(childWeights) / sumWeights) *
+        GiniGain::Evaluate<true>(childLabels, numClasses, childWeights);
+  }
+
+  REQUIRE(gain == Approx(refGain).epsilon(1e-10));
+  REQUIRE(weightedGain == Approx(refWeightedGain).epsilon(1e-10));
+}
+
 /**
  * Make sure that AllCategoricalSplit respects the minimum number of samples
  * required to split.
@@ -1241,3 +1287,350 @@ TEST_CASE("DifferentMaximumDepthTest", "[DecisionTreeTest]")
   REQUIRE(d2.Child(0).NumChildren() == 2);
   REQUIRE(d2.Child(1).NumChildren() == 2);
 }
+
+/**
+ * Check that the HistogramNumericSplit will split on an obviously splittable
+ * dimension.
+ */
+TEST_CASE("HistogramNumericSplitSimpleSplitTest", "[DecisionTreeTest]")
+{
+  arma::vec values("0.0 0.1 0.2 0.3 0.4 0.5 0.6 0.7 0.8 0.9 1.0");
+  arma::Row<size_t> labels("0 0 0 0 0 1 1 1 1 1 1");
+  arma::rowvec weights(labels.n_elem);
+  weights.ones();
+
+  arma::vec classProbabilities;
+  HistogramNumericSplit<GiniGain>::template AuxiliarySplitInfo<double> aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain = HistogramNumericSplit<GiniGain>::SplitIfBetter<false>(
+      bestGain, values, labels, 2, weights, 3, 1e-7, classProbabilities,
+      aux);
+  const double weightedGain =
+      HistogramNumericSplit<GiniGain>::SplitIfBetter<true>(bestGain, values,
+      labels, 2, weights, 3, 1e-7, classProbabilities, aux);
+
+  // Make sure that a split was made.
+  REQUIRE(gain > bestGain);
+
+  // Make sure weight works and is not different than the unweighted one.
+  REQUIRE(gain == weightedGain);
+
+  // The split is perfect, so we should be able to accomplish a gain of 0.
+  REQUIRE(gain == Approx(0.0).margin(1e-7));
+
+  // The class probabilities, for this split, hold the splitting point, which
+  // should be a bucket boundary between 0.4 and 0.5.
+  REQUIRE(classProbabilities.n_elem == 1);
+  REQUIRE(classProbabilities[0] > 0.4);
+  REQUIRE(classProbabilities[0] <= 0.5);
+}
+
+/**
+ * Check that the HistogramNumericSplit won't split if not enough points are
+ * given.
+ */
+TEST_CASE("HistogramNumericSplitMinSamplesTest", "[DecisionTreeTest]")
+{
+  arma::vec values("0.0 0.1 0.2 0.3 0.4 0.5 0.6 0.7 0.8 0.9 1.0");
+  arma::Row<size_t> labels("0 0 0 0 0 1 1 1 1 1 1");
+  arma::rowvec weights(labels.n_elem);
+
+  arma::vec classProbabilities;
+  HistogramNumericSplit<GiniGain>::template AuxiliarySplitInfo<double> aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain = HistogramNumericSplit<GiniGain>::SplitIfBetter<false>(
+      bestGain, values, labels, 2, weights, 8, 1e-7, classProbabilities,
+      aux);
+
+  // Make sure that no split was made.
+  REQUIRE(gain == DBL_MAX);
+  REQUIRE(classProbabilities.n_elem == 0);
+}
+
+/**
+ * Check that a decision tree built with the histogram split generalizes
+ * about as well as one built with the exhaustive split.
+ */
+TEST_CASE("HistogramNumericSplitGeneralizationTest", "[DecisionTreeTest]")
+{
+  arma::mat inputData;
+  if (!data::Load("vc2.csv", inputData))
+    FAIL("Cannot load test dataset vc2.csv!");
+
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt");
+
+  // Build decision tree.
+  DecisionTree<GiniGain, HistogramNumericSplit> d(inputData, labels, 3, 10);
+
+  // Load testing data.
+  arma::mat testData;
+  if (!data::Load("vc2_test.csv", testData))
+    FAIL("Cannot load test dataset vc2_test.csv!");
+
+  arma::Mat<size_t> trueTestLabels;
+  if (!data::Load("vc2_test_labels.txt", trueTestLabels))
+    FAIL("Cannot load labels for vc2_test_labels.txt");
+
+  // Get the predicted test labels.
+  arma::Row<size_t> predictions;
+  d.Classify(testData, predictions);
+
+  REQUIRE(predictions.n_elem == testData.n_cols);
+
+  // Figure out the accuracy.
+  double correct = 0.0;
+  for (size_t i = 0; i < predictions.n_elem; ++i)
+    if (predictions[i] == trueTestLabels[i])
+      ++correct;
+  correct /= predictions.n_elem;
+
+  REQUIRE(correct > 0.75);
+}
+
+/**
+ * Test that training on a row of sample indices that covers every point
+ * exactly once gives the same tree as training on the data directly.
+ */
+TEST_CASE("SampleIndexedTrainTest", "[DecisionTreeTest]")
+{
+  arma::mat inputData;
+  if (!data::Load("vc2.csv", inputData))
+    FAIL("Cannot load test dataset vc2.csv!");
+
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt");
+
+  // Every point is sampled exactly once, in order, so the sample-indexed
+  // training must visit the same points as direct training.
+  arma::Row<size_t> samples(inputData.n_cols);
+  for (size_t i = 0; i < samples.n_elem; ++i)
+    samples[i] = i;
+
+  DecisionTree<> d(inputData, labels, 3, 10); // Leaf size of 10.
+  DecisionTree<> id;
+  id.Train(inputData, samples, labels, 3, 10); // Leaf size of 10.
+
+  // The trees should make identical predictions.
+  arma::Row<size_t> predictions, indexedPredictions;
+  d.Classify(inputData, predictions);
+  id.Classify(inputData, indexedPredictions);
+
+  REQUIRE(indexedPredictions.n_elem == predictions.n_elem);
+  for (size_t i = 0; i < predictions.n_elem; ++i)
+    REQUIRE(indexedPredictions[i] == predictions[i]);
+}
+
+/**
+ * Test that a tree trained on a bootstrap sample of indices (with repeats)
+ * still generalizes to a test set.
+ */
+TEST_CASE("SampleIndexedBootstrapTrainTest", "[DecisionTreeTest]")
+{
+  arma::mat inputData;
+  if (!data::Load("vc2.csv", inputData))
+    FAIL("Cannot load test dataset vc2.csv!");
+
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt");
+
+  // Sample with replacement, as a random forest's bootstrap does.
+  arma::Row<size_t> samples(inputData.n_cols);
+  for (size_t i = 0; i < samples.n_elem; ++i)
+    samples[i] = math::RandInt(0, inputData.n_cols);
+
+  DecisionTree<> d;
+  d.Train(inputData, samples, labels, 3, 10); // Leaf size of 10.
+
+  // Load testing data.
+  arma::mat testData;
+  if (!data::Load("vc2_test.csv", testData))
+    FAIL("Cannot load test dataset vc2_test.csv!");
+
+  arma::Mat<size_t> trueTestLabels;
+  if (!data::Load("vc2_test_labels.txt", trueTestLabels))
+    FAIL("Cannot load labels for vc2_test_labels.txt");
+
+  // Get the predicted test labels.
+  arma::Row<size_t> predictions;
+  d.Classify(testData, predictions);
+
+  REQUIRE(predictions.n_elem == testData.n_cols);
+
+  // Figure out the accuracy.
+  double correct = 0.0;
+  for (size_t i = 0; i < predictions.n_elem; ++i)
+    if (predictions[i] == trueTestLabels[i])
+      ++correct;
+  correct /= predictions.n_elem;
+
+  REQUIRE(correct > 0.70);
+}
+
+//! Count the nodes of the given tree, for the pruning test below.
+template<typename TreeType>
+size_t CountTreeNodes(const TreeType& node)
+{
+  size_t count = 1;
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+    count += CountTreeNodes(node.Child(i));
+  return count;
+}
+
+/**
+ * Cost-complexity pruning should shrink an overgrown tree without losing
+ * validation accuracy (the unpruned tree is one of the candidates).
+ */
+TEST_CASE("CostComplexityPruningTest", "[DecisionTreeTest]")
+{
+  arma::mat inputData;
+  if (!data::Load("vc2.csv", inputData))
+    FAIL("Cannot load test dataset vc2.csv!");
+
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt");
+
+  arma::mat validationData;
+  if (!data::Load("vc2_test.csv", validationData))
+    FAIL("Cannot load test dataset vc2_test.csv!");
+
+  arma::Row<size_t> validationLabels;
+  if (!data::Load("vc2_test_labels.txt", validationLabels))
+    FAIL("Cannot load labels for vc2_test_labels.txt");
+
+  // Grow an overfit tree: no minimum leaf size or depth limit to speak of.
+  DecisionTree<> d(inputData, labels, 3, 1 /* minimum leaf size */, 1e-9);
+  const size_t unprunedNodes = CountTreeNodes(d);
+
+  // Validation accuracy of the unpruned tree.
+  arma::Row<size_t> predictions;
+  d.Classify(validationData, predictions);
+  const double unprunedAccuracy =
+      (double) arma::accu(predictions == validationLabels) /
+      validationLabels.n_elem;
+
+  const double prunedAccuracy =
+      d.Prune(inputData, labels, validationData, validationLabels);
+
+  // Pruning may never lose validation accuracy, and the overgrown tree
+  // should actually shrink.
+  REQUIRE(prunedAccuracy >= unprunedAccuracy);
+  REQUIRE(CountTreeNodes(d) < unprunedNodes);
+
+  // The reported accuracy must match what the pruned tree actually does.
+  d.Classify(validationData, predictions);
+  const double repeatAccuracy =
+      (double) arma::accu(predictions == validationLabels) /
+      validationLabels.n_elem;
+  REQUIRE(prunedAccuracy == Approx(repeatAccuracy).epsilon(1e-10));
+
+  // Class probabilities of the pruned tree must still be valid.
+  arma::mat probabilities;
+  d.Classify(validationData, predictions, probabilities);
+  for (size_t i = 0; i < validationData.n_cols; ++i)
+  {
+    REQUIRE(arma::accu(probabilities.col(i)) ==
+        Approx(1.0).epsilon(1e-7));
+  }
+
+  // Pruning with an empty validation set must throw.
+  arma::mat emptyData;
+  arma::Row<size_t> emptyLabels;
+  REQUIRE_THROWS_AS(d.Prune(inputData, labels, emptyData, emptyLabels),
+      std::invalid_argument);
+}
+
+/**
+ * The PresortedIndex must reproduce the ascending order of any subset of the
+ * points, including repeated sample indices, from its cached ranks.
+ */
+TEST_CASE("PresortedIndexOrderTest", "[DecisionTreeTest]")
+{
+  arma::mat dataset(5, 100, arma::fill::randu);
+
+  PresortedIndex index;
+  index.Build(dataset);
+
+  REQUIRE(index.NumPoints() == dataset.n_cols);
+
+  // The rank array of every dimension must invert that dimension's sorted
+  // order.
+  for (size_t i = 0; i < dataset.n_rows; ++i)
+  {
+    REQUIRE(index.HasDimension(i));
+
+    const arma::uvec sortedOrder = arma::sort_index(dataset.row(i));
+    for (size_t j = 0; j < dataset.n_cols; ++j)
+      REQUIRE(index.Ranks(i)[sortedOrder[j]] == j);
+  }
+
+  // Order a bootstrap-style subset (with repeated indices) of every size from
+  // tiny to the full dataset, so both the counting-sort path and the
+  // comparison-sort fallback are exercised.
+  for (size_t count = 5; count <= dataset.n_cols; count += 31)
+  {
+    arma::Row<size_t> samples(count);
+    for (size_t j = 0; j < count; ++j)
+      samples[j] = math::RandInt(0, (int) dataset.n_cols);
+
+    for (size_t i = 0; i < dataset.n_rows; ++i)
+    {
+      arma::uvec order;
+      index.SortSamples(i, samples, 0, count, order);
+
+      REQUIRE(order.n_elem == count);
+      for (size_t j = 1; j < count; ++j)
+      {
+        REQUIRE(dataset(i, samples[order[j - 1]]) <=
+                dataset(i, samples[order[j]]));
+      }
+    }
+  }
+}
+
+/**
+ * Training on a bootstrap sample with a presorted index must produce exactly
+ * the same tree as training without one: the index only changes how the
+ * sorted order of each node's points is obtained.
+ */
+TEST_CASE("PresortedIndexEquivalentTrainingTest", "[DecisionTreeTest]")
+{
+  arma::mat inputData;
+  if (!data::Load("vc2.csv", inputData))
+    FAIL("Cannot load test dataset vc2.csv!");
+
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt");
+
+  // A bootstrap sample with repeated indices.
+  arma::Row<size_t> samples(inputData.n_cols);
+  for (size_t i = 0; i < inputData.n_cols; ++i)
+    samples[i] = math::RandInt(0, (int) inputData.n_cols);
+
+  PresortedIndex index;
+  index.Build(inputData);
+
+  DecisionTree<> plain;
+  plain.Train(inputData, samples, labels, 3, 10, 1e-7);
+  DecisionTree<> presorted;
+  presorted.Train(inputData, samples, labels, 3, 10, 1e-7, 0,
+      AllDimensionSelect(), &index);
+
+  // Both trees must make identical predictions.
+  arma::Row<size_t> plainPredictions, presortedPredictions;
+  plain.Classify(inputData, plainPredictions);
+  presorted.Classify(inputData, presortedPredictions);
+
+  REQUIRE(plainPredictions.n_elem == presortedPredictions.n_elem);
+  for (size_t i = 0; i < plainPredictions.n_elem; ++i)
+    REQUIRE(plainPredictions[i] == presortedPredictions[i]);
+}
@@ -351,6 +351,35 @@ TEST_CASE("TestComputeValue", "[DETTest]")
   REQUIRE(0.0 == Approx(testDTree.ComputeValue(q4)).epsilon(1e-12));
 }
 
+TEST_CASE("TestBatchComputeValue", "[DETTest]")
+{
+  // The batched ComputeValue() overload must return exactly the same
+  // densities as the per-point version, including zero densities for points
+  // outside the root's bounding box.
+  arma::mat trainData = arma::randu<arma::mat>(3, 500);
+
+  arma::Col<size_t> oTest(trainData.n_cols);
+  for (size_t i = 0; i < oTest.n_elem; ++i)
+    oTest[i] = i;
+
+  DTree<arma::mat> testDTree(trainData);
+  testDTree.Grow(trainData, oTest, false, 10, 5);
+
+  // Scale the queries a bit so some of them fall outside the bounding box.
+  arma::mat queries = 1.1 * arma::randu<arma::mat>(3, 300) - 0.05;
+
+  arma::rowvec batchDensities;
+  testDTree.ComputeValue(queries, batchDensities);
+
+  REQUIRE(batchDensities.n_elem == queries.n_cols);
+
+  for (size_t i = 0; i < queries.n_cols; ++i)
+  {
+    const double density = testDTree.ComputeValue(queries.unsafe_col(i));
+    REQUIRE(batchDensities[i] == Approx(density).epsilon(1e-12));
+  }
+}
+
 TEST_CASE("TestVariableImportance", "[DETTest]")
 {
   arma::mat testData(3, 5);
@@ -782,3 +811,120 @@ TEST_CASE("MoveOperatorTest", "[DETTest]")
   REQUIRE(testDTree2.Right()->SplitDim() == 1);
   REQUIRE(testDTree2.Right()->SplitValue() == Approx(0.5).epsilon(1e-7));
 }
+
+TEST_CASE("PresortedSplitsPartitionTest", "[DETTest]")
+{
+  // Build the presorted index on random data, then apply a split the way
+  // Grow() would and check that every dimension's runs are still sorted and
+  // hold exactly the points of each side.
+  arma::mat data(4, 150, arma::fill::randu);
+
+  arma::Col<size_t> oldFromNew(data.n_cols);
+  for (size_t i = 0; i < oldFromNew.n_elem; ++i)
+    oldFromNew[i] = i;
+
+  PresortedSplits<arma::mat> index;
+  index.Build(data, oldFromNew);
+  REQUIRE(index.Built());
+
+  // Split on the median of dimension 1, reordering the data and the mapping
+  // the same way SplitData() does.
+  const size_t splitDim = 1;
+  const double splitValue = arma::median(data.row(splitDim).t());
+
+  size_t left = 0;
+  size_t right = data.n_cols - 1;
+  for (;;)
+  {
+    while (data(splitDim, left) <= splitValue)
+      ++left;
+    while (data(splitDim, right) > splitValue)
+      --right;
+
+    if (left > right)
+      break;
+
+    data.swap_cols(left, right);
+    const size_t tmp = oldFromNew[left];
+    oldFromNew[left] = oldFromNew[right];
+    oldFromNew[right] = tmp;
+  }
+  const size_t splitIndex = left;
+
+  index.Partition(0, splitIndex, data.n_cols, oldFromNew);
+
+  for (size_t dim = 0; dim < data.n_rows; ++dim)
+  {
+    const double* vals = index.Values(dim);
+
+    // Both runs must be sorted, and every left-run value must belong to a
+    // point on the left side of the split (respectively for the right run).
+    arma::vec leftRun(splitIndex), rightRun(data.n_cols - splitIndex);
+    for (size_t i = 0; i < splitIndex; ++i)
+    {
+      if (i > 0)
+        REQUIRE(vals[i] >= vals[i - 1]);
+      leftRun[i] = vals[i];
+    }
+
+    for (size_t i = splitIndex; i < data.n_cols; ++i)
+    {
+      if (i > splitIndex)
+        REQUIRE(vals[i] >= vals[i - 1]);
+      rightRun[i - splitIndex] = vals[i];
+    }
+
+    // The runs must hold exactly the values of each side's columns.
+    arma::vec leftExpected =
+        arma::sort(data(dim, arma::span(0, splitIndex - 1)).t());
+    arma::vec rightExpected =
+        arma::sort(data(dim, arma::span(splitIndex, data.n_cols - 1)).t());
+
+    for (size_t i = 0; i < leftExpected.n_elem; ++i)
+      REQUIRE(arma::sort(leftRun)[i] == Approx(leftExpected[i]).epsilon(0));
+    for (size_t i = 0; i < rightExpected.n_elem; ++i)
+      REQUIRE(arma::sort(rightRun)[i] == Approx(rightExpected[i]).epsilon(0));
+  }
+}
+
+TEST_CASE("PresortedGrowEquivalenceTest", "[DETTest]")
+{
+  // A tree grown on a dense matrix uses the presorted index, while a sparse
+  // matrix with the same (all-nonzero) values takes the legacy per-node
+  // sorting path; both must produce the same tree.
+  arma::mat denseData(3, 300);
+  denseData.randu();
+  denseData += 1.0; // Make all values nonzero.
+
+  arma::sp_mat sparseData(denseData.n_rows, denseData.n_cols);
+  for (size_t j = 0; j < denseData.n_cols; ++j)
+    for (size_t d = 0; d < denseData.n_rows; ++d)
+      sparseData(d, j) = denseData(d, j);
+
+  arma::Col<size_t> denseMap(denseData.n_cols), sparseMap(denseData.n_cols);
+  for (size_t i = 0; i < denseMap.n_elem; ++i)
+    denseMap[i] = sparseMap[i] = i;
+
+  DTree<arma::mat> denseTree(denseData);
+  DTree<arma::sp_mat> sparseTree(sparseData);
+
+  const double denseAlpha =
+      denseTree.Grow(denseData, denseMap, false, 10, 5);
+  const double sparseAlpha =
+      sparseTree.Grow(sparseData, sparseMap, false, 10, 5);
+
+  REQUIRE(denseAlpha == Approx(sparseAlpha).epsilon(1e-10));
+
+  // The same points must have ended up in the same positions.
+  for (size_t i = 0; i < denseMap.n_elem; ++i)
+    REQUIRE(denseMap[i] == sparseMap[i]);
+
+  // The density estimates must agree everywhere.
+  for (size_t i = 0; i < denseData.n_cols; ++i)
+  {
+    const arma::vec query = denseData.col(i);
+    const arma::sp_vec sparseQuery(query);
+    REQUIRE(denseTree.ComputeValue(query) ==
+        Approx(sparseTree.ComputeValue(sparseQuery)).epsilon(1e-10));
+  }
+}
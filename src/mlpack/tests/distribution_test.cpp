@@ -88,6 +88,68 @@ TEST_CASE("DiscreteDistributionRandomTest", "[DistributionTest]")
   REQUIRE(actualProb(2) == Approx(0.1).epsilon(0.08));
 }
 
+/**
+ * Make sure batched sampling gives the correct distribution, and that the
+ * alias tables are rebuilt after the probabilities are modified.
+ */
+TEST_CASE("DiscreteDistributionBatchRandomTest", "[DistributionTest]")
+{
+  DiscreteDistribution d(arma::Col<size_t>("3"));
+
+  d.Probabilities() = "0.3 0.6 0.1";
+
+  arma::mat observations;
+  d.Random(50000, observations);
+
+  REQUIRE(observations.n_rows == 1);
+  REQUIRE(observations.n_cols == 50000);
+
+  arma::vec actualProb(3);
+  actualProb.zeros();
+  for (size_t i = 0; i < observations.n_cols; ++i)
+    actualProb((size_t) (observations(0, i) + 0.5))++;
+
+  // Normalize.
+  actualProb /= accu(actualProb);
+
+  // 8% tolerance, because this can be a noisy process.
+  REQUIRE(actualProb(0) == Approx(0.3).epsilon(0.08));
+  REQUIRE(actualProb(1) == Approx(0.6).epsilon(0.08));
+  REQUIRE(actualProb(2) == Approx(0.1).epsilon(0.08));
+
+  // Now change the probabilities to a point mass; the cached alias tables must
+  // be invalidated, so every new sample should be 2.
+  d.Probabilities() = "0.0 0.0 1.0";
+  d.Random(100, observations);
+  for (size_t i = 0; i < observations.n_cols; ++i)
+    REQUIRE((size_t) (observations(0, i) + 0.5) == 2);
+}
+
+/**
+ * Make sure the vectorized probability overloads match per-observation calls
+ * for a multidimensional distribution.
+ */
+TEST_CASE("DiscreteDistributionMatrixProbabilityTest", "[DistributionTest]")
+{
+  DiscreteDistribution d("4 3");
+
+  arma::mat obs("0 1 1 2 3 3 3 2;"
+                "0 0 1 1 2 2 2 1;");
+  d.Train(obs);
+
+  arma::vec prob, logProb;
+  d.Probability(obs, prob);
+  d.LogProbability(obs, logProb);
+
+  REQUIRE(prob.n_elem == obs.n_cols);
+  REQUIRE(logProb.n_elem == obs.n_cols);
+  for (size_t i = 0; i < obs.n_cols; ++i)
+  {
+    REQUIRE(prob(i) == Approx(d.Probability(obs.col(i))).epsilon(1e-7));
+    REQUIRE(logProb(i) == Approx(d.LogProbability(obs.col(i))).epsilon(1e-7));
+  }
+}
+
 /**
  * Make sure we can estimate from observations correctly.
  */
@@ -560,6 +622,47 @@ TEST_CASE("GaussianDistributionTrainWithProbabilitiesTest",
   REQUIRE(guDist.Covariance()[0] == Approx(cov[0]).epsilon(0.06));
 }
 
+/**
+ * Rank-1 (and rank-k) covariance updates must leave the cached Cholesky
+ * factor, inverse and log-determinant consistent with a factorization of the
+ * updated covariance from scratch.
+ */
+TEST_CASE("GaussianDistributionUpdateCovarianceTest", "[DistributionTest]")
+{
+  const size_t d = 8;
+
+  // Build a random positive definite covariance.
+  arma::mat x = arma::randu<arma::mat>(d, d);
+  arma::mat cov = x * x.t() + d * arma::eye<arma::mat>(d, d);
+  arma::vec mean = arma::randu<arma::vec>(d);
+
+  GaussianDistribution dist(mean, cov);
+
+  // Apply a rank-1 update, a weighted update and a downdate incrementally.
+  arma::mat updates = arma::randu<arma::mat>(d, 3);
+  arma::vec weights("1.0 0.5 -0.25");
+  dist.UpdateCovariance(updates, weights);
+
+  // Factorize the updated covariance from scratch for comparison.
+  arma::mat updatedCov = cov;
+  for (size_t i = 0; i < updates.n_cols; ++i)
+    updatedCov += weights(i) * (updates.col(i) * updates.col(i).t());
+  GaussianDistribution reference(mean, updatedCov);
+
+  CheckMatrices(dist.Covariance(), reference.Covariance());
+  CheckMatrices(dist.InvCov(), reference.InvCov());
+  REQUIRE(dist.LogDetCov() == Approx(reference.LogDetCov()).epsilon(1e-10));
+
+  // Log-probabilities (which exercise the updated factor through the batch
+  // triangular solve) must agree too.
+  arma::mat obs = arma::randu<arma::mat>(d, 20);
+  arma::vec logProb, refLogProb;
+  dist.LogProbability(obs, logProb);
+  reference.LogProbability(obs, refLogProb);
+  for (size_t i = 0; i < obs.n_cols; ++i)
+    REQUIRE(logProb(i) == Approx(refLogProb(i)).epsilon(1e-10));
+}
+
 /**
  * This test ensures that the same result is obtained when trained with
  * probabilities all set to 1 and with no probabilities at all.
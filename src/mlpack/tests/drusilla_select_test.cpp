@@ -92,6 +92,56 @@ TEST_CASE("DrusillaSelectRetrainTest", "[DrusillaSelectTest]")
   REQUIRE(distances.n_rows == 1);
 }
 
+// If a changed point becomes an extreme outlier, an incremental update should
+// rebuild the candidate set so that searches return it.
+TEST_CASE("DrusillaSelectUpdatePointsTest", "[DrusillaSelectTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 100);
+
+  DrusillaSelect<> ds(dataset, 5, 5);
+
+  // Turn one point into an extreme outlier and update incrementally.
+  dataset.col(42) += 100;
+  arma::Col<size_t> changed(1);
+  changed[0] = 42;
+  ds.UpdatePoints(dataset, changed);
+
+  // Now every other point should have point 42 as its furthest neighbor
+  // candidate.
+  arma::mat distances;
+  arma::Mat<size_t> neighbors;
+  ds.Search(dataset.cols(0, 41), 1, neighbors, distances);
+
+  for (size_t i = 0; i < 42; ++i)
+  {
+    REQUIRE(neighbors[i] == 42);
+  }
+}
+
+// If a changed point is already in the candidate set, an incremental update
+// should refresh the stored copy in-place.
+TEST_CASE("DrusillaSelectUpdateCandidateTest", "[DrusillaSelectTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 100);
+
+  DrusillaSelect<> ds(dataset, 3, 3);
+
+  // Shrink the first candidate point; since it is already a candidate, no
+  // retraining pass is needed, but the stored copy must be refreshed.
+  const size_t index = ds.CandidateIndices()[0];
+  dataset.col(index) *= 0.5;
+  arma::Col<size_t> changed(1);
+  changed[0] = index;
+  ds.UpdatePoints(dataset, changed);
+
+  REQUIRE(ds.CandidateIndices()[0] == index);
+  for (size_t d = 0; d < dataset.n_rows; ++d)
+  {
+    REQUIRE(ds.CandidateSet()(d, 0) ==
+        Approx(dataset(d, index)).epsilon(1e-10));
+  }
+}
+
 // Test serialization.
 TEST_CASE("DrusillaSelectSerializationTest", "[DrusillaSelectTest]")
 {
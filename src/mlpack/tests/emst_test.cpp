@@ -274,3 +274,37 @@ TEST_CASE("EMSTBallTreeTest", "[EMSTTest]")
     REQUIRE(bstResults(2, i) == Approx(ballResults(2, i)).epsilon(1e-7));
   }
 }
+
+/**
+ * Test that UnionFind agrees with a brute-force component labeling after a
+ * sequence of random unions.
+ */
+TEST_CASE("EMSTUnionFindTest", "[EMSTTest]")
+{
+  const size_t size = 200;
+  UnionFind uf(size);
+
+  // Brute-force component labels: initially each point is its own component.
+  arma::Col<size_t> labels =
+      arma::linspace<arma::Col<size_t> >(0, size - 1, size);
+
+  for (size_t i = 0; i < 150; ++i)
+  {
+    const size_t x = math::RandInt(0, size);
+    const size_t y = math::RandInt(0, size);
+
+    uf.Union(x, y);
+
+    // Relabel every point in y's component to x's label.
+    const size_t oldLabel = labels[y];
+    const size_t newLabel = labels[x];
+    for (size_t j = 0; j < size; ++j)
+      if (labels[j] == oldLabel)
+        labels[j] = newLabel;
+  }
+
+  // Two points are in the same component exactly when their labels agree.
+  for (size_t i = 0; i < size; ++i)
+    for (size_t j = 0; j < size; ++j)
+      REQUIRE((uf.Find(i) == uf.Find(j)) == (labels[i] == labels[j]));
+}
@@ -0,0 +1,101 @@
+/**
+ * @file tests/ensemble_test.cpp
+ *
+ * Tests for the EnsemblePredictor.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/ensemble/ensemble_predictor.hpp>
+#include <mlpack/methods/logistic_regression/logistic_regression.hpp>
+#include <mlpack/methods/decision_tree/decision_tree.hpp>
+
+#include "catch.hpp"
+
+using namespace mlpack;
+using namespace mlpack::ensemble;
+using namespace mlpack::regression;
+using namespace mlpack::tree;
+
+/**
+ * Tiled evaluation must give exactly the same per-model predictions as one
+ * full pass through each model, including when the number of points is not a
+ * multiple of the block size.
+ */
+TEST_CASE("EnsembleTiledPredictionsTest", "[EnsembleTest]")
+{
+  // Two well-separated Gaussians.
+  arma::mat data = arma::randn<arma::mat>(3, 1000);
+  arma::Row<size_t> labels(1000);
+  for (size_t i = 500; i < 1000; ++i)
+  {
+    data.col(i) += 5;
+    labels[i] = 1;
+  }
+
+  LogisticRegression<> lr(data, labels);
+  DecisionTree<> dt(data, labels, 2);
+
+  EnsemblePredictor ensemble(64); // Block size that does not divide 1000.
+  ensemble.Add(lr);
+  ensemble.Add(dt);
+
+  REQUIRE(ensemble.NumModels() == 2);
+
+  std::vector<arma::Row<size_t>> predictions;
+  ensemble.Classify(data, predictions);
+
+  arma::Row<size_t> lrPredictions, dtPredictions;
+  lr.Classify(data, lrPredictions);
+  dt.Classify(data, dtPredictions);
+
+  REQUIRE(predictions.size() == 2);
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    REQUIRE(predictions[0][i] == lrPredictions[i]);
+    REQUIRE(predictions[1][i] == dtPredictions[i]);
+  }
+}
+
+/**
+ * Check the majority vote with deterministic functor models.
+ */
+TEST_CASE("EnsembleMajorityVoteTest", "[EnsembleTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(2, 100);
+
+  // Two models vote for class 0, one votes for class 2.
+  EnsemblePredictor ensemble;
+  ensemble.Add([](const arma::mat& block, arma::Row<size_t>& predictions)
+      { predictions.zeros(block.n_cols); });
+  ensemble.Add([](const arma::mat& block, arma::Row<size_t>& predictions)
+      { predictions.zeros(block.n_cols); predictions += 2; });
+  ensemble.Add([](const arma::mat& block, arma::Row<size_t>& predictions)
+      { predictions.zeros(block.n_cols); });
+
+  arma::Row<size_t> predictions;
+  ensemble.Classify(data, 3, predictions);
+
+  REQUIRE(predictions.n_elem == 100);
+  for (size_t i = 0; i < 100; ++i)
+    REQUIRE(predictions[i] == 0);
+}
+
+/**
+ * Classifying with no registered models should throw.
+ */
+TEST_CASE("EnsembleEmptyTest", "[EnsembleTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(2, 10);
+  arma::Row<size_t> predictions;
+
+  EnsemblePredictor ensemble;
+  REQUIRE_THROWS_AS(ensemble.Classify(data, 2, predictions),
+      std::runtime_error);
+
+  // An invalid block size should also throw.
+  REQUIRE_THROWS_AS(EnsemblePredictor(0), std::invalid_argument);
+}
@@ -92,6 +92,41 @@ TEST_CASE("FastMKSDualTreeVsNaive", "[FastMKSTest]")
   }
 }
 
+/**
+ * Compare dual-tree and naive with the polynomial kernel; naive search uses
+ * the blocked matrix-product path for any dot-product-expressible kernel.
+ */
+TEST_CASE("FastMKSPolynomialDualTreeVsNaive", "[FastMKSTest]")
+{
+  // First create a random dataset.
+  arma::mat data;
+  data.randn(10, 2000);
+  PolynomialKernel pk(3.0, 1.5);
+
+  // Now run FastMKS naively.
+  FastMKS<PolynomialKernel> naive(data, pk, false, true);
+
+  arma::Mat<size_t> naiveIndices;
+  arma::mat naiveProducts;
+  naive.Search(10, naiveIndices, naiveProducts);
+
+  // Now run it in dual-tree mode.
+  FastMKS<PolynomialKernel> tree(data, pk);
+
+  arma::Mat<size_t> treeIndices;
+  arma::mat treeProducts;
+  tree.Search(10, treeIndices, treeProducts);
+
+  for (size_t q = 0; q < treeIndices.n_cols; ++q)
+  {
+    for (size_t r = 0; r < treeIndices.n_rows; ++r)
+    {
+      REQUIRE(treeIndices(r, q) == naiveIndices(r, q));
+      REQUIRE(treeProducts(r, q) == Approx(naiveProducts(r, q)).epsilon(1e-7));
+    }
+  }
+}
+
 /**
  * Compare dual-tree and single-tree on a larger dataset.
  */
@@ -15,6 +15,9 @@
 #include <mlpack/methods/ann/layer/layer.hpp>
 #include <mlpack/methods/ann/loss_functions/mean_squared_error.hpp>
 #include <mlpack/methods/ann/ffn.hpp>
+#include <mlpack/methods/ann/async_checkpoint.hpp>
+#include <mlpack/methods/ann/data_parallel_trainer.hpp>
+#include <mlpack/methods/ann/static_ffn.hpp>
 
 #include <ensmallen.hpp>
 
@@ -944,3 +947,346 @@ TEST_CASE("FFNCheckInputShapeTest", "[FeedForwardNetworkTest]")
 
   REQUIRE_THROWS_AS(model.Train(trainData, trainLabels, opt), std::logic_error);
 }
+
+/**
+ * Test that a compiled inference plan produces exactly the same predictions as
+ * the regular visitor-dispatched Predict() path.
+ */
+TEST_CASE("CompiledInferencePlanTest", "[FeedForwardNetworkTest]")
+{
+  // Load the dataset.
+  arma::mat trainData;
+  data::Load("thyroid_train.csv", trainData, true);
+
+  arma::mat trainLabels = trainData.row(trainData.n_rows - 1);
+  trainData.shed_row(trainData.n_rows - 1);
+
+  arma::mat testData;
+  data::Load("thyroid_test.csv", testData, true);
+  testData.shed_row(testData.n_rows - 1);
+
+  FFN<NegativeLogLikelihood<> > model;
+  model.Add<Linear<> >(trainData.n_rows, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 3);
+  model.Add<LogSoftMax<> >();
+
+  ens::RMSProp opt(0.01, 32, 0.88, 1e-8, 2 * trainData.n_cols, -1);
+  model.Train(trainData, trainLabels, opt);
+
+  // Predict with the regular path, then compile the plan and predict again.
+  arma::mat prediction, compiledPrediction;
+  model.Predict(testData, prediction);
+
+  model.CompileInference();
+  model.Predict(testData, compiledPrediction);
+
+  REQUIRE(compiledPrediction.n_rows == prediction.n_rows);
+  REQUIRE(compiledPrediction.n_cols == prediction.n_cols);
+  for (size_t i = 0; i < prediction.n_elem; ++i)
+    REQUIRE(compiledPrediction[i] == Approx(prediction[i]).margin(1e-12));
+
+  // Adding a layer must invalidate the plan; predictions still work through
+  // the regular path.
+  model.Add<LogSoftMax<> >();
+  model.Predict(testData, prediction);
+  REQUIRE(prediction.n_cols == testData.n_cols);
+}
+
+/**
+ * Test that the in-place steps of a compiled inference plan (elementwise
+ * activation layers overwriting their input buffer) produce exactly the
+ * same predictions as the regular Predict() path, including consecutive
+ * in-place layers and an in-place layer as the very first step.
+ */
+TEST_CASE("CompiledInferenceInPlaceTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat dataset;
+  dataset.randu(10, 64);
+
+  FFN<MeanSquaredError<> > model;
+  model.Add<TanHLayer<> >();
+  model.Add<Linear<> >(10, 8);
+  model.Add<ReLULayer<> >();
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 3);
+  model.Add<TanHLayer<> >();
+  model.ResetParameters();
+
+  arma::mat prediction, compiledPrediction;
+  model.Predict(dataset, prediction);
+
+  model.CompileInference();
+  model.Predict(dataset, compiledPrediction);
+
+  REQUIRE(compiledPrediction.n_rows == prediction.n_rows);
+  REQUIRE(compiledPrediction.n_cols == prediction.n_cols);
+  for (size_t i = 0; i < prediction.n_elem; ++i)
+    REQUIRE(compiledPrediction[i] == Approx(prediction[i]).margin(1e-12));
+}
+
+/**
+ * Test that folding BatchNorm layers into the preceding Linear layers leaves
+ * the predictions unchanged while removing the folded layers.
+ */
+TEST_CASE("FuseForInferenceTest", "[FeedForwardNetworkTest]")
+{
+  // Load the dataset.
+  arma::mat trainData;
+  data::Load("thyroid_train.csv", trainData, true);
+
+  arma::mat trainLabels = trainData.row(trainData.n_rows - 1);
+  trainData.shed_row(trainData.n_rows - 1);
+
+  arma::mat testData;
+  data::Load("thyroid_test.csv", testData, true);
+  testData.shed_row(testData.n_rows - 1);
+
+  FFN<NegativeLogLikelihood<> > model;
+  model.Add<Linear<> >(trainData.n_rows, 8);
+  model.Add<BatchNorm<> >(8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 3);
+  model.Add<LogSoftMax<> >();
+
+  // Train so that the BatchNorm layer accumulates running statistics.
+  ens::RMSProp opt(0.01, 32, 0.88, 1e-8, 2 * trainData.n_cols, -1);
+  model.Train(trainData, trainLabels, opt);
+
+  arma::mat prediction, fusedPrediction;
+  model.Predict(testData, prediction);
+
+  const size_t layers = model.Model().size();
+  const size_t weights = model.Parameters().n_elem;
+
+  model.FuseForInference();
+
+  // The BatchNorm layer and its parameters must be gone.
+  REQUIRE(model.Model().size() == layers - 1);
+  REQUIRE(model.Parameters().n_elem == weights - 16);
+
+  // The fused network must produce the same predictions.
+  model.Predict(testData, fusedPrediction);
+  REQUIRE(fusedPrediction.n_rows == prediction.n_rows);
+  REQUIRE(fusedPrediction.n_cols == prediction.n_cols);
+  for (size_t i = 0; i < prediction.n_elem; ++i)
+    REQUIRE(fusedPrediction[i] == Approx(prediction[i]).margin(1e-10));
+}
+
+/**
+ * Test that int8 quantization of the network parameters round-trips within
+ * the quantization step size and keeps the network usable.
+ */
+TEST_CASE("QuantizeParametersTest", "[FeedForwardNetworkTest]")
+{
+  // Load the dataset.
+  arma::mat trainData;
+  data::Load("thyroid_train.csv", trainData, true);
+
+  arma::mat trainLabels = trainData.row(trainData.n_rows - 1);
+  trainData.shed_row(trainData.n_rows - 1);
+
+  FFN<NegativeLogLikelihood<> > model;
+  model.Add<Linear<> >(trainData.n_rows, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 3);
+  model.Add<LogSoftMax<> >();
+
+  ens::RMSProp opt(0.01, 32, 0.88, 1e-8, 2 * trainData.n_cols, -1);
+  model.Train(trainData, trainLabels, opt);
+
+  const arma::mat original = model.Parameters();
+
+  arma::Col<arma::s8> quantized;
+  arma::vec scales;
+  model.QuantizeParameters(quantized, scales);
+
+  // One int8 value per parameter; one scale per weight row of the two
+  // Linear layers plus one per bias block.
+  REQUIRE(quantized.n_elem == original.n_elem);
+  REQUIRE(scales.n_elem == 8 + 1 + 3 + 1);
+
+  model.DequantizeParameters(quantized, scales);
+
+  // Every parameter must be reconstructed within its quantization step,
+  // which is bounded by the largest scale.
+  const double step = scales.max();
+  REQUIRE(arma::abs(model.Parameters() - original).max() <= step);
+
+  // The dequantized network must still predict the right shapes.
+  arma::mat prediction;
+  model.Predict(trainData, prediction);
+  REQUIRE(prediction.n_rows == 3);
+  REQUIRE(prediction.n_cols == trainData.n_cols);
+}
+
+/**
+ * Test that gradient accumulation over micro-batches produces the same
+ * objective and gradient as evaluating the whole minibatch at once.
+ */
+TEST_CASE("MicroBatchGradientAccumulationTest", "[FeedForwardNetworkTest]")
+{
+  // Load the dataset.
+  arma::mat trainData;
+  data::Load("thyroid_train.csv", trainData, true);
+
+  arma::mat trainLabels = trainData.row(trainData.n_rows - 1);
+  trainData.shed_row(trainData.n_rows - 1);
+
+  FFN<NegativeLogLikelihood<> > model;
+  model.Add<Linear<> >(trainData.n_rows, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 3);
+  model.Add<LogSoftMax<> >();
+
+  ens::RMSProp opt(0.01, 32, 0.88, 1e-8, trainData.n_cols, -1);
+  model.Train(trainData, trainLabels, opt);
+
+  arma::mat fullGradient;
+  const double fullObjective = model.EvaluateWithGradient(
+      model.Parameters(), 0, fullGradient, 64);
+
+  // The same evaluation split into micro-batches of 24, 24 and 16 points
+  // must accumulate to the same result.
+  model.MicroBatchSize() = 24;
+  arma::mat microGradient;
+  const double microObjective = model.EvaluateWithGradient(
+      model.Parameters(), 0, microGradient, 64);
+
+  REQUIRE(microObjective == Approx(fullObjective).margin(1e-8));
+  REQUIRE(microGradient.n_elem == fullGradient.n_elem);
+  for (size_t i = 0; i < fullGradient.n_elem; ++i)
+    REQUIRE(microGradient[i] == Approx(fullGradient[i]).margin(1e-8));
+}
+
+/**
+ * Test that the synchronous data-parallel trainer trains a usable model and
+ * writes the optimized parameters back into the wrapped model.
+ */
+TEST_CASE("DataParallelTrainerTest", "[FeedForwardNetworkTest]")
+{
+  // Load the dataset.
+  arma::mat trainData;
+  data::Load("thyroid_train.csv", trainData, true);
+
+  arma::mat trainLabels = trainData.row(trainData.n_rows - 1);
+  trainData.shed_row(trainData.n_rows - 1);
+
+  FFN<NegativeLogLikelihood<> > model;
+  model.Add<Linear<> >(trainData.n_rows, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 3);
+  model.Add<LogSoftMax<> >();
+
+  model.ResetParameters();
+  const arma::mat initialParameters = model.Parameters();
+
+  DataParallelTrainer<FFN<NegativeLogLikelihood<> > > trainer(model, 2);
+  REQUIRE(trainer.Threads() == 2);
+
+  ens::RMSProp opt(0.01, 32, 0.88, 1e-8, 4 * trainData.n_cols, -1);
+  const double objective = trainer.Train(trainData, trainLabels, opt);
+
+  // The optimized parameters must have been written into the wrapped model,
+  // which is usable directly.
+  REQUIRE(std::isfinite(objective));
+  REQUIRE(arma::any(arma::vectorise(
+      model.Parameters() != initialParameters)));
+
+  arma::mat predictionTemp;
+  model.Predict(trainData, predictionTemp);
+  arma::mat prediction = arma::zeros<arma::mat>(1, predictionTemp.n_cols);
+
+  for (size_t i = 0; i < predictionTemp.n_cols; ++i)
+  {
+    prediction(i) = arma::as_scalar(arma::find(
+        arma::max(predictionTemp.col(i)) == predictionTemp.col(i), 1)) + 1;
+  }
+
+  const size_t correct = arma::accu(prediction == trainLabels);
+  const double classificationError =
+      1 - double(correct) / trainData.n_cols;
+  REQUIRE(classificationError <= 0.35);
+}
+
+/**
+ * Test that StaticFFN produces the same predictions as an FFN built from the
+ * same layers once the trained parameters are moved over.
+ */
+TEST_CASE("StaticFFNPredictionEquivalenceTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat dataset;
+  dataset.randu(10, 50);
+
+  FFN<> model;
+  model.Add<Linear<> >(10, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 3);
+  model.Add<LogSoftMax<> >();
+  model.ResetParameters();
+
+  StaticFFN<NegativeLogLikelihood<>, RandomInitialization,
+      Linear<>, SigmoidLayer<>, Linear<>, LogSoftMax<> > staticModel(
+      Linear<>(10, 8), SigmoidLayer<>(), Linear<>(8, 3), LogSoftMax<>());
+  staticModel.ResetParameters();
+
+  // The parameter layout matches the dynamic FFN, so the trained parameters
+  // can be assigned directly.
+  REQUIRE(staticModel.Parameters().n_elem == model.Parameters().n_elem);
+  staticModel.Parameters() = model.Parameters();
+
+  arma::mat predictions, staticPredictions;
+  model.Predict(dataset, predictions);
+  staticModel.Predict(dataset, staticPredictions);
+
+  CheckMatrices(predictions, staticPredictions, 1e-10);
+
+  // The evaluated objective has to match as well.
+  arma::mat responses = arma::ones<arma::mat>(1, dataset.n_cols);
+  REQUIRE(model.Evaluate(dataset, responses) ==
+      Approx(staticModel.Evaluate(dataset, responses)).epsilon(1e-10));
+}
+
+/**
+ * Test that asynchronously written checkpoints can be loaded back and match
+ * the checkpointed model, and that later checkpoints replace earlier ones.
+ */
+TEST_CASE("AsyncCheckpointerTest", "[FeedForwardNetworkTest]")
+{
+  FFN<> model;
+  model.Add<Linear<> >(10, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 3);
+  model.Add<LogSoftMax<> >();
+  model.ResetParameters();
+
+  {
+    AsyncCheckpointer<FFN<> > checkpointer("async_checkpoint_test.bin");
+    checkpointer.Checkpoint(model);
+    checkpointer.Wait();
+    REQUIRE(checkpointer.CheckpointsWritten() == 1);
+
+    FFN<> restored;
+    REQUIRE(data::Load("async_checkpoint_test.bin", "model", restored));
+    CheckMatrices(model.Parameters(), restored.Parameters(), 1e-10);
+
+    // A second checkpoint with updated parameters and optimizer state has to
+    // replace the first one on disk.
+    model.Parameters() += 1.0;
+    arma::mat optimizerState = arma::randu<arma::mat>(model.Parameters().n_elem,
+        1);
+    checkpointer.Checkpoint(model, optimizerState);
+    checkpointer.Wait();
+    REQUIRE(checkpointer.CheckpointsWritten() == 2);
+
+    REQUIRE(data::Load("async_checkpoint_test.bin", "model", restored));
+    CheckMatrices(model.Parameters(), restored.Parameters(), 1e-10);
+
+    arma::mat restoredState;
+    REQUIRE(restoredState.load("async_checkpoint_test.bin.state"));
+    CheckMatrices(optimizerState, restoredState, 1e-10);
+  }
+
+  remove("async_checkpoint_test.bin");
+  remove("async_checkpoint_test.bin.state");
+}
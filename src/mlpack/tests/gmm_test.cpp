@@ -13,6 +13,7 @@
 #include <mlpack/core.hpp>
 
 #include <mlpack/methods/gmm/gmm.hpp>
+#include <mlpack/methods/gmm/component_pruning_index.hpp>
 #include <mlpack/methods/gmm/diagonal_gmm.hpp>
 
 #include <mlpack/methods/gmm/no_constraint.hpp>
@@ -1239,3 +1240,95 @@ TEST_CASE("DiagonalGMMLoadSaveTest", "[GMMTest]")
     }
   }
 }
+
+/**
+ * Make sure the vectorized matrix overload of GMM::LogProbability() agrees
+ * with the single-observation version.
+ */
+TEST_CASE("GMMMatrixLogProbabilityTest", "[GMMTest]")
+{
+  GMM gmm(3, 2);
+  gmm.Weights() = arma::vec("0.3 0.25 0.45");
+  gmm.Component(0) = distribution::GaussianDistribution("0.0 0.0",
+      "1.0 0.3; 0.3 1.0");
+  gmm.Component(1) = distribution::GaussianDistribution("3.0 2.0",
+      "1.5 0.0; 0.0 0.7");
+  gmm.Component(2) = distribution::GaussianDistribution("-2.0 1.0",
+      "0.5 0.1; 0.1 0.6");
+
+  arma::mat observations(2, 50, arma::fill::randn);
+
+  arma::vec logProbs;
+  gmm.LogProbability(observations, logProbs);
+
+  REQUIRE(logProbs.n_elem == observations.n_cols);
+  for (size_t i = 0; i < observations.n_cols; ++i)
+  {
+    REQUIRE(logProbs[i] ==
+        Approx(gmm.LogProbability(observations.unsafe_col(i))).epsilon(1e-10));
+  }
+}
+
+//! Build a random well-conditioned GMM for the pruning index tests.
+static GMM RandomIndexTestGMM(const size_t gaussians, const size_t dims)
+{
+  GMM gmm(gaussians, dims);
+  for (size_t i = 0; i < gaussians; ++i)
+  {
+    gmm.Component(i).Mean() = 20.0 * arma::randu<arma::vec>(dims);
+    const arma::mat a = arma::randu<arma::mat>(dims, dims);
+    arma::mat covariance = a * a.t() + 2.0 * arma::eye(dims, dims);
+    gmm.Component(i).Covariance(std::move(covariance));
+  }
+  gmm.Weights() = arma::randu<arma::vec>(gaussians);
+  gmm.Weights() /= arma::accu(gmm.Weights());
+  return gmm;
+}
+
+/**
+ * With a relative epsilon of 0 the component-pruning index never prunes, so
+ * it must reproduce GMM::LogProbability() exactly.
+ */
+TEST_CASE("ComponentPruningIndexExactTest", "[GMMTest]")
+{
+  const GMM gmm = RandomIndexTestGMM(16, 3);
+  ComponentPruningIndex index(gmm);
+
+  const arma::mat points = 25.0 * arma::randu<arma::mat>(3, 50) - 2.5;
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    REQUIRE(index.LogProbability(points.col(i), 0.0) ==
+        Approx(gmm.LogProbability(points.col(i))).epsilon(1e-10));
+  }
+}
+
+/**
+ * With a small positive epsilon the index may prune, but the density must
+ * stay within a tight relative error of the exact evaluation, and the batch
+ * overloads must agree with the single-point ones.
+ */
+TEST_CASE("ComponentPruningIndexApproximationTest", "[GMMTest]")
+{
+  const GMM gmm = RandomIndexTestGMM(32, 3);
+  ComponentPruningIndex index(gmm);
+
+  const arma::mat points = 25.0 * arma::randu<arma::mat>(3, 100) - 2.5;
+
+  arma::vec exact;
+  gmm.Probability(points, exact);
+
+  arma::vec approx;
+  index.Probability(points, approx, 1e-8);
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    REQUIRE(std::abs(approx[i] - exact[i]) <= 1e-4 * exact[i]);
+    REQUIRE(index.Probability(points.col(i), 1e-8) ==
+        Approx(approx[i]).epsilon(1e-12));
+  }
+
+  // Invalid epsilons must be rejected.
+  REQUIRE_THROWS_AS(index.LogProbability(points.col(0), -1.0),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(index.LogProbability(points.col(0), 1.0),
+      std::invalid_argument);
+}
@@ -10,6 +10,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/hmm/hmm.hpp>
+#include <mlpack/methods/hmm/hmm_regression.hpp>
 #include <mlpack/methods/gmm/gmm.hpp>
 #include <mlpack/methods/gmm/diagonal_gmm.hpp>
 
@@ -1857,3 +1858,314 @@ TEST_CASE("DiagonalGMMHMMLoadSaveTest", "[HMMTest]")
     }
   }
 }
+
+/**
+ * Make sure that Predict() with a caller-owned ViterbiWorkspace gives the
+ * same results as the allocating overload, including when the workspace is
+ * reused across sequences of different lengths.
+ */
+TEST_CASE("HMMPredictWorkspaceTest", "[HMMTest]")
+{
+  // Create a random Gaussian HMM with 4 hidden states.
+  arma::vec initial("0.4 0.2 0.3 0.1");
+  arma::mat transition("0.75 0.10 0.10 0.40;"
+                       "0.10 0.60 0.25 0.10;"
+                       "0.10 0.25 0.50 0.25;"
+                       "0.05 0.05 0.15 0.25");
+  std::vector<GaussianDistribution> emission(4);
+  emission[0] = GaussianDistribution("0.0 0.0", "1.0 0.2; 0.2 1.5");
+  emission[1] = GaussianDistribution("4.0 2.5", "0.8 0.0; 0.0 0.8");
+  emission[2] = GaussianDistribution("-3.0 1.0", "1.2 0.3; 0.3 1.0");
+  emission[3] = GaussianDistribution("1.5 -2.0", "0.5 0.1; 0.1 0.9");
+
+  HMM<GaussianDistribution> hmm(initial, transition, emission);
+
+  // Decode several sequences of varying lengths with one shared workspace,
+  // including a length larger than any earlier one so the buffers must grow.
+  ViterbiWorkspace workspace;
+  const size_t lengths[5] = { 50, 10, 75, 75, 3 };
+  for (size_t i = 0; i < 5; ++i)
+  {
+    arma::mat obs;
+    arma::Row<size_t> unusedStates;
+    hmm.Generate(lengths[i], obs, unusedStates);
+
+    arma::Row<size_t> states, statesWs;
+    const double logLik = hmm.Predict(obs, states);
+    const double logLikWs = hmm.Predict(obs, statesWs, workspace);
+
+    REQUIRE(logLikWs == Approx(logLik).epsilon(1e-10));
+    REQUIRE(states.n_elem == statesWs.n_elem);
+    for (size_t t = 0; t < states.n_elem; ++t)
+      REQUIRE(states[t] == statesWs[t]);
+  }
+}
+
+/**
+ * The simplest possible model should also be recoverable with minibatch EM.
+ */
+TEST_CASE("SimplestMinibatchBaumWelchDiscreteHMM", "[HMMTest]")
+{
+  // Don't yet require a useful distribution.  1 state, 1 emission.
+  HMM<DiscreteDistribution> hmm(1, DiscreteDistribution(1));
+
+  std::vector<arma::mat> observations;
+  // Different lengths for each observation sequence.
+  observations.push_back("0 0 0 0 0 0 0 0"); // 8 zeros.
+  observations.push_back("0 0 0 0 0 0 0"); // 7 zeros.
+  observations.push_back("0 0 0 0 0 0 0 0 0 0 0 0"); // 12 zeros.
+  observations.push_back("0 0 0 0 0 0 0 0 0 0"); // 10 zeros.
+
+  // Two sequences per minibatch.
+  hmm.Train(observations, 2);
+
+  REQUIRE(hmm.Initial()[0] == Approx(1.0).epsilon(1e-7));
+  REQUIRE(hmm.Emission()[0].Probability("0") == Approx(1.0).epsilon(1e-7));
+  REQUIRE(hmm.Transition()(0, 0) == Approx(1.0).epsilon(1e-7));
+}
+
+/**
+ * Minibatch EM should recover the same model as SimpleBaumWelchDiscreteHMM_2,
+ * where the state can be determined directly by the emission.
+ */
+TEST_CASE("MinibatchBaumWelchDiscreteHMM", "[HMMTest]")
+{
+  HMM<DiscreteDistribution> hmm(2, DiscreteDistribution(4));
+
+  // A little bit of obfuscation to the solution.
+  hmm.Transition() = arma::mat("0.1 0.4; 0.9 0.6");
+  hmm.Emission()[0].Probabilities() = "0.85 0.15 0.00 0.00";
+  hmm.Emission()[1].Probabilities() = "0.00 0.00 0.50 0.50";
+
+  // Generate observations from the same model as in
+  // SimpleBaumWelchDiscreteHMM_2: the state is uniform at each step, state 0
+  // emits 0 or 1, and state 1 emits 2 or 3.
+  std::vector<arma::mat> observations;
+  size_t obsNum = 250; // Number of observations.
+  size_t obsLen = 500; // Number of elements in each observation.
+  size_t stateZeroStarts = 0; // Number of times we start in state 0.
+  for (size_t i = 0; i < obsNum; ++i)
+  {
+    arma::mat observation(1, obsLen);
+
+    size_t state = 0;
+    size_t emissionVal = 0;
+
+    for (size_t obs = 0; obs < obsLen; obs++)
+    {
+      // See if state changed.
+      double r = math::Random();
+
+      if (r <= 0.5)
+      {
+        if (obs == 0)
+          ++stateZeroStarts;
+        state = 0;
+      }
+      else
+      {
+        state = 1;
+      }
+
+      // Now set the observation.
+      r = math::Random();
+
+      switch (state)
+      {
+        // case 0 is not possible.
+        case 0:
+          if (r <= 0.4)
+            emissionVal = 0;
+          else
+            emissionVal = 1;
+          break;
+        case 1:
+          if (r <= 0.2)
+            emissionVal = 2;
+          else
+            emissionVal = 3;
+          break;
+      }
+
+      observation(0, obs) = emissionVal;
+    }
+
+    observations.push_back(observation);
+  }
+
+  // Train with 25 sequences per minibatch.
+  hmm.Train(observations, 25);
+
+  // Calculate true probability of class 0 at the start.
+  double prob = double(stateZeroStarts) / observations.size();
+
+  // Only require 3% tolerance, because the minibatch updates are noisier
+  // than full-batch Baum-Welch.
+  REQUIRE(hmm.Initial()[0] == Approx(prob).epsilon(0.03));
+  REQUIRE(hmm.Initial()[1] == Approx(1.0 - prob).epsilon(0.03));
+
+  REQUIRE(hmm.Transition()(0, 0) == Approx(0.5).epsilon(0.03));
+  REQUIRE(hmm.Transition()(1, 0) == Approx(0.5).epsilon(0.03));
+  REQUIRE(hmm.Transition()(0, 1) == Approx(0.5).epsilon(0.03));
+  REQUIRE(hmm.Transition()(1, 1) == Approx(0.5).epsilon(0.03));
+
+  REQUIRE(hmm.Emission()[0].Probability("0") == Approx(0.4).epsilon(0.05));
+  REQUIRE(hmm.Emission()[0].Probability("1") == Approx(0.6).epsilon(0.05));
+  REQUIRE(hmm.Emission()[0].Probability("2") == Approx(0.0).margin(2.5));
+  REQUIRE(hmm.Emission()[0].Probability("3") == Approx(0.0).margin(2.5));
+  REQUIRE(hmm.Emission()[1].Probability("0") == Approx(0.0).margin(2.5));
+  REQUIRE(hmm.Emission()[1].Probability("1") == Approx(0.0).margin(2.5));
+  REQUIRE(hmm.Emission()[1].Probability("2") == Approx(0.2).epsilon(0.05));
+  REQUIRE(hmm.Emission()[1].Probability("3") == Approx(0.8).epsilon(0.05));
+}
+
+/**
+ * Beam-pruned decoding and filtering should agree with the exact algorithms
+ * on a model whose states are easily distinguished by their emissions.
+ */
+TEST_CASE("HMMBeamPrunedPredictFilterTest", "[HMMTest]")
+{
+  // Create a random Gaussian HMM with 4 hidden states whose emission
+  // distributions are well-separated, so the beam always contains the states
+  // that matter.
+  arma::vec initial("0.4 0.2 0.3 0.1");
+  arma::mat transition("0.75 0.10 0.10 0.40;"
+                       "0.10 0.60 0.25 0.10;"
+                       "0.10 0.25 0.50 0.25;"
+                       "0.05 0.05 0.15 0.25");
+  std::vector<GaussianDistribution> emission(4);
+  emission[0] = GaussianDistribution("0.0 0.0", "1.0 0.2; 0.2 1.5");
+  emission[1] = GaussianDistribution("8.0 5.0", "0.8 0.0; 0.0 0.8");
+  emission[2] = GaussianDistribution("-6.0 2.0", "1.2 0.3; 0.3 1.0");
+  emission[3] = GaussianDistribution("3.0 -4.0", "0.5 0.1; 0.1 0.9");
+
+  HMM<GaussianDistribution> hmm(initial, transition, emission);
+  HMM<GaussianDistribution> prunedHmm(initial, transition, emission);
+  prunedHmm.BeamWidth() = 2;
+
+  for (size_t i = 0; i < 5; ++i)
+  {
+    arma::mat obs;
+    arma::Row<size_t> unusedStates;
+    hmm.Generate(100, obs, unusedStates);
+
+    // The most likely path never passes through a state outside the top two,
+    // so the pruned decode must find the same path.
+    arma::Row<size_t> states, prunedStates;
+    const double logLik = hmm.Predict(obs, states);
+    const double prunedLogLik = prunedHmm.Predict(obs, prunedStates);
+
+    REQUIRE(prunedLogLik == Approx(logLik).epsilon(1e-10));
+    for (size_t t = 0; t < states.n_elem; ++t)
+      REQUIRE(states[t] == prunedStates[t]);
+
+    // The forward mass outside the top two states is negligible for these
+    // emissions, so the pruned filter estimates must be very close.
+    arma::mat filterSeq, prunedFilterSeq;
+    hmm.Filter(obs, filterSeq);
+    prunedHmm.Filter(obs, prunedFilterSeq);
+
+    REQUIRE(filterSeq.n_cols == prunedFilterSeq.n_cols);
+    for (size_t t = 0; t < filterSeq.n_cols; ++t)
+    {
+      for (size_t d = 0; d < filterSeq.n_rows; ++d)
+      {
+        REQUIRE(prunedFilterSeq(d, t) ==
+            Approx(filterSeq(d, t)).margin(1e-3));
+      }
+    }
+  }
+
+  // A beam at least as wide as the state count disables pruning entirely,
+  // so the results must be bitwise identical.
+  prunedHmm.BeamWidth() = 4;
+  arma::mat obs;
+  arma::Row<size_t> unusedStates;
+  hmm.Generate(50, obs, unusedStates);
+
+  arma::Row<size_t> states, prunedStates;
+  const double logLik = hmm.Predict(obs, states);
+  const double prunedLogLik = prunedHmm.Predict(obs, prunedStates);
+
+  REQUIRE(prunedLogLik == logLik);
+  for (size_t t = 0; t < states.n_elem; ++t)
+    REQUIRE(states[t] == prunedStates[t]);
+}
+
+/**
+ * Make sure that extending a sequence one observation at a time with
+ * ExtendForward() gives the same log-likelihood as running the full forward
+ * pass on every prefix of the sequence.
+ */
+TEST_CASE("HMMExtendForwardTest", "[HMMTest]")
+{
+  // A two-state model with discrete emissions.
+  arma::vec initial("0.6 0.4");
+  arma::mat transition("0.7 0.3; 0.3 0.7");
+  std::vector<DiscreteDistribution> emission(2);
+  emission[0] = DiscreteDistribution(std::vector<arma::vec>{"0.9 0.1"});
+  emission[1] = DiscreteDistribution(std::vector<arma::vec>{"0.2 0.8"});
+
+  HMM<DiscreteDistribution> hmm(initial, transition, emission);
+
+  // Generate a random observation sequence.
+  arma::mat observations(1, 50);
+  for (size_t t = 0; t < observations.n_cols; ++t)
+    observations(0, t) = (double) (math::RandInt(0, 2));
+
+  // Stream the sequence into a ForwardState, checking the incremental
+  // log-likelihood against the batch computation on each prefix.
+  ForwardState state;
+  for (size_t t = 0; t < observations.n_cols; ++t)
+  {
+    const double streamed = hmm.ExtendForward(state, observations.col(t));
+
+    const double batch = hmm.LogLikelihood(observations.cols(0, t));
+    REQUIRE(streamed == Approx(batch).epsilon(1e-10));
+  }
+
+  // The normalized forward probabilities must sum to one.
+  REQUIRE(arma::accu(arma::exp(state.logForwardProb)) ==
+      Approx(1.0).epsilon(1e-10));
+
+  // A reset state must start a fresh sequence.
+  state.Reset();
+  const double restarted = hmm.ExtendForward(state, observations.col(0));
+  REQUIRE(restarted ==
+      Approx(hmm.LogLikelihood(observations.cols(0, 0))).epsilon(1e-10));
+}
+
+/**
+ * Make sure that HMMRegression::ExtendForward() matches the batch
+ * log-likelihood when a stream of (predictor, response) pairs is scored
+ * incrementally.
+ */
+TEST_CASE("HMMRegressionExtendForwardTest", "[HMMTest]")
+{
+  // Create a two-state HMMR with random regression emissions.
+  arma::mat predictors(2, 100, arma::fill::randn);
+  arma::vec responses(100, arma::fill::randn);
+
+  arma::vec initial("0.5 0.5");
+  arma::mat transition("0.8 0.2; 0.2 0.8");
+  std::vector<RegressionDistribution> emissions;
+  emissions.push_back(RegressionDistribution(predictors.cols(0, 49),
+      responses.subvec(0, 49)));
+  emissions.push_back(RegressionDistribution(predictors.cols(50, 99),
+      responses.subvec(50, 99)));
+
+  HMMRegression hmmr(initial, transition, emissions);
+
+  // Stream a sequence and compare against the batch log-likelihood of each
+  // prefix.
+  ForwardState state;
+  for (size_t t = 0; t < 20; ++t)
+  {
+    const double streamed = hmmr.ExtendForward(state, predictors.col(t),
+        responses[t]);
+
+    const double batch = hmmr.LogLikelihood(predictors.cols(0, t),
+        responses.subvec(0, t));
+    REQUIRE(streamed == Approx(batch).epsilon(1e-10));
+  }
+}
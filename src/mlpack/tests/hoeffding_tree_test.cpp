@@ -16,6 +16,8 @@
 #include <mlpack/methods/hoeffding_trees/hoeffding_categorical_split.hpp>
 #include <mlpack/methods/hoeffding_trees/binary_numeric_split.hpp>
 #include <mlpack/methods/hoeffding_trees/hoeffding_tree_model.hpp>
+#include <mlpack/methods/hoeffding_trees/hoeffding_forest.hpp>
+#include <mlpack/methods/hoeffding_trees/hoeffding_quantile_numeric_split.hpp>
 
 #include "catch.hpp"
 #include "test_catch_tools.hpp"
@@ -1475,3 +1477,258 @@ TEST_CASE("HoeffdingTreeModelSerializationTest", "[HoeffdingTreeTest]")
     }
   }
 }
+
+/**
+ * Test that TrainBatch() can learn a simple separable problem.
+ */
+TEST_CASE("HoeffdingTreeTrainBatchTest", "[HoeffdingTreeTest]")
+{
+  // Two well-separated Gaussian classes in three dimensions.
+  arma::mat dataset(3, 6000);
+  arma::Row<size_t> labels(6000);
+  for (size_t i = 0; i < 6000; i += 2)
+  {
+    dataset.col(i) = arma::vec(3, arma::fill::randn) * 0.25 + 3.0;
+    labels[i] = 0;
+    dataset.col(i + 1) = arma::vec(3, arma::fill::randn) * 0.25 - 3.0;
+    labels[i + 1] = 1;
+  }
+
+  data::DatasetInfo info(3);
+  HoeffdingTree<> tree(info, 2);
+
+  // Feed the stream in mini-batches of 500 points.
+  for (size_t start = 0; start < dataset.n_cols; start += 500)
+  {
+    arma::mat batch = dataset.cols(start, start + 499);
+    arma::Row<size_t> batchLabels = labels.cols(start, start + 499);
+    tree.TrainBatch(batch, batchLabels);
+  }
+
+  // The tree should have split and should classify nearly everything right.
+  size_t correct = 0;
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    if (tree.Classify(dataset.col(i)) == labels[i])
+      ++correct;
+  }
+
+  REQUIRE(correct > 5700);
+}
+
+TEST_CASE("HoeffdingForestTest", "[HoeffdingTreeTest]")
+{
+  // Two well-separated Gaussian classes in eight dimensions.
+  arma::mat dataset(8, 4000);
+  arma::Row<size_t> labels(4000);
+  for (size_t i = 0; i < 4000; i += 2)
+  {
+    dataset.col(i) = arma::vec(8, arma::fill::randn) * 0.25 + 3.0;
+    labels[i] = 0;
+    dataset.col(i + 1) = arma::vec(8, arma::fill::randn) * 0.25 - 3.0;
+    labels[i + 1] = 1;
+  }
+
+  data::DatasetInfo info(8);
+  HoeffdingForest<> forest(info, 2, 10);
+
+  REQUIRE(forest.NumTrees() == 10);
+
+  // Every tree should observe a sorted subspace of ceil(sqrt(8)) = 3 valid
+  // distinct dimensions.
+  for (size_t t = 0; t < forest.NumTrees(); ++t)
+  {
+    arma::uvec subspace = forest.Subspace(t);
+    REQUIRE(subspace.n_elem == 3);
+    for (size_t j = 0; j < subspace.n_elem; ++j)
+    {
+      REQUIRE(subspace[j] < 8);
+      if (j > 0)
+        REQUIRE(subspace[j] > subspace[j - 1]);
+    }
+  }
+
+  // Feed the stream in chunks of 500 points.
+  for (size_t start = 0; start < dataset.n_cols; start += 500)
+  {
+    arma::mat chunk = dataset.cols(start, start + 499);
+    arma::Row<size_t> chunkLabels = labels.cols(start, start + 499);
+    forest.Train(chunk, chunkLabels);
+  }
+
+  // The majority vote should classify nearly everything right, and the
+  // probabilities must be valid vote fractions.
+  arma::Row<size_t> predictions;
+  arma::mat probabilities;
+  forest.Classify(dataset, predictions, probabilities);
+
+  size_t correct = 0;
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    if (predictions[i] == labels[i])
+      ++correct;
+
+    REQUIRE(arma::sum(probabilities.col(i)) == Approx(1.0).epsilon(1e-7));
+    REQUIRE(probabilities(predictions[i], i) >= 0.5);
+  }
+
+  REQUIRE(correct > 3800);
+
+  // The single-point overload must agree with the batch overload.
+  for (size_t i = 0; i < 50; ++i)
+  {
+    size_t prediction;
+    double probability;
+    forest.Classify(dataset.col(i), prediction, probability);
+
+    REQUIRE(prediction == predictions[i]);
+    REQUIRE(probability == Approx(probabilities(prediction, i)).epsilon(1e-7));
+  }
+}
+
+TEST_CASE("HoeffdingForestSerializationTest", "[HoeffdingTreeTest]")
+{
+  // Build a small forest on categorical data and make sure it survives a
+  // serialization round trip.
+  arma::mat dataset(4, 1000);
+  arma::Row<size_t> labels(1000);
+  data::DatasetInfo info(4);
+  info.MapString<size_t>("a", 2);
+  info.MapString<size_t>("b", 2);
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    dataset(0, i) = mlpack::math::Random();
+    dataset(1, i) = mlpack::math::Random();
+    dataset(2, i) = mlpack::math::RandInt(0, 2);
+    dataset(3, i) = mlpack::math::Random();
+    labels[i] = (size_t) dataset(2, i);
+  }
+
+  HoeffdingForest<> forest(info, 2, 5, 3);
+  forest.Train(dataset, labels);
+
+  HoeffdingForest<> xmlForest, jsonForest, binaryForest;
+  SerializeObjectAll(forest, xmlForest, jsonForest, binaryForest);
+
+  REQUIRE(xmlForest.NumTrees() == forest.NumTrees());
+  REQUIRE(jsonForest.NumTrees() == forest.NumTrees());
+  REQUIRE(binaryForest.NumTrees() == forest.NumTrees());
+
+  arma::Row<size_t> predictions, xmlPredictions, jsonPredictions,
+      binaryPredictions;
+  forest.Classify(dataset, predictions);
+  xmlForest.Classify(dataset, xmlPredictions);
+  jsonForest.Classify(dataset, jsonPredictions);
+  binaryForest.Classify(dataset, binaryPredictions);
+
+  CheckMatrices(predictions, xmlPredictions, jsonPredictions,
+      binaryPredictions);
+}
+
+/**
+ * Feed the quantile-sketch numeric split a uniform stream and make sure the
+ * bin boundaries it builds are close to the true quantiles, without any
+ * observation buffering.
+ */
+TEST_CASE("HoeffdingQuantileNumericSplitQuantileTest", "[HoeffdingTreeTest]")
+{
+  // 2 classes, 4 bins, 2000 samples before binning.
+  HoeffdingQuantileNumericSplit<GiniImpurity> split(2, 4, 2000);
+
+  for (size_t i = 0; i < 2000; ++i)
+    split.Train(mlpack::math::Random(), i % 2);
+
+  // The bins should now exist, with boundaries near the quartiles of
+  // Uniform(0, 1).
+  REQUIRE(split.SplitPoints().n_elem == 3);
+  REQUIRE(split.SplitPoints()[0] == Approx(0.25).margin(0.05));
+  REQUIRE(split.SplitPoints()[1] == Approx(0.50).margin(0.05));
+  REQUIRE(split.SplitPoints()[2] == Approx(0.75).margin(0.05));
+}
+
+/**
+ * Feed the quantile-sketch numeric split a bimodal dataset and make sure it
+ * separates the two classes, exactly as the buffering split does.
+ */
+TEST_CASE("HoeffdingQuantileNumericSplitBimodalTest", "[HoeffdingTreeTest]")
+{
+  // 2 classes, 2 bins, 200 samples before binning.
+  HoeffdingQuantileNumericSplit<GiniImpurity> split(2, 2, 200);
+
+  for (size_t i = 0; i < 200; ++i)
+  {
+    split.Train(mlpack::math::Random() + 0.3, 0);
+    split.Train(-mlpack::math::Random() - 0.3, 1);
+  }
+
+  REQUIRE(split.MajorityClass() == 0 || split.MajorityClass() == 1);
+
+  // The 200 points seen after binning are balanced and separable, so the
+  // impurity improvement should be near (0.5 * (1 - 0.5)) * 2 = 0.50.
+  double bestGain, secondBestGain;
+  split.EvaluateFitnessFunction(bestGain, secondBestGain);
+  REQUIRE(bestGain == Approx(0.50).epsilon(0.01));
+  REQUIRE(secondBestGain == Approx(0.0).margin(1e-10));
+
+  // The split boundary must separate the two modes.
+  NumericSplitInfo<> info;
+  arma::Col<size_t> childMajorities;
+  split.Split(childMajorities, info);
+  REQUIRE(childMajorities.n_elem == 2);
+  for (size_t i = 0; i < 10; ++i)
+  {
+    REQUIRE(info.CalculateDirection(mlpack::math::Random() + 0.3) !=
+            info.CalculateDirection(-mlpack::math::Random() - 0.3));
+  }
+}
+
+/**
+ * Create a HoeffdingTree that uses the quantile-sketch numeric split and make
+ * sure it can split meaningfully on the correct dimension.
+ */
+TEST_CASE("QuantileNumericHoeffdingTreeTest", "[HoeffdingTreeTest]")
+{
+  // Generate data.
+  arma::mat dataset(3, 9000);
+  arma::Row<size_t> labels(9000);
+  data::DatasetInfo info(3); // All features are numeric.
+  for (size_t i = 0; i < 9000; i += 3)
+  {
+    dataset(0, i) = mlpack::math::Random();
+    dataset(1, i) = mlpack::math::Random();
+    dataset(2, i) = mlpack::math::Random();
+    labels[i] = 0;
+
+    dataset(0, i + 1) = mlpack::math::Random();
+    dataset(1, i + 1) = mlpack::math::Random() - 1.0;
+    dataset(2, i + 1) = mlpack::math::Random() + 0.5;
+    labels[i + 1] = 2;
+
+    dataset(0, i + 2) = mlpack::math::Random();
+    dataset(1, i + 2) = mlpack::math::Random() + 1.0;
+    dataset(2, i + 2) = mlpack::math::Random() + 0.8;
+    labels[i + 2] = 1;
+  }
+
+  typedef HoeffdingTree<GiniImpurity, HoeffdingDoubleQuantileNumericSplit>
+      TreeType;
+  TreeType streamTree(info, 3);
+  for (size_t i = 0; i < 9000; ++i)
+    streamTree.Train(dataset.col(i), labels[i]);
+
+  // The tree should have split on the informative dimension.
+  REQUIRE(streamTree.NumChildren() > 0);
+  REQUIRE(streamTree.SplitDimension() == 1);
+
+  arma::Row<size_t> streamLabels(9000);
+  streamTree.Classify(dataset, streamLabels);
+
+  size_t streamCorrect = 0;
+  for (size_t i = 0; i < 9000; ++i)
+  {
+    if (labels[i] == streamLabels[i])
+      ++streamCorrect;
+  }
+
+  REQUIRE(streamCorrect > 7000);
+}
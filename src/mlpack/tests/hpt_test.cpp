@@ -15,7 +15,9 @@
 #include <mlpack/core/hpt/cv_function.hpp>
 #include <mlpack/core/hpt/fixed.hpp>
 #include <mlpack/core/hpt/hpt.hpp>
+#include <mlpack/core/hpt/successive_halving.hpp>
 #include <mlpack/methods/lars/lars.hpp>
+#include <mlpack/methods/linear_regression/linear_regression.hpp>
 #include <mlpack/methods/logistic_regression/logistic_regression.hpp>
 
 #include <ensmallen.hpp>
@@ -399,3 +401,40 @@ TEST_CASE("HPTGradientDescentTest", "[HPTTest]")
   REQUIRE(xOptimized == Approx(xMin).epsilon(1e-6));
   REQUIRE(zOptimized == Approx(zMin).epsilon(1e-6));
 }
+
+/**
+ * Test that successive halving eliminates clearly bad configurations and
+ * returns a model trained with a good one.
+ */
+TEST_CASE("SuccessiveHalvingTest", "[HPTTest]")
+{
+  // Noisy responses retrieved by a random linear transformation of data, so
+  // small ridge penalties should clearly beat huge ones.
+  arma::mat xs = arma::randn(5, 600);
+  arma::vec beta = arma::randn(5, 1);
+  arma::rowvec ys = beta.t() * xs + 0.1 * arma::randn(1, 600);
+
+  std::vector<std::tuple<double>> candidates;
+  for (double lambda : {0.0, 0.01, 0.1, 100.0, 1000.0, 10000.0})
+    candidates.push_back(std::make_tuple(lambda));
+
+  SuccessiveHalving<LinearRegression, MSE> sh(0.2, xs, ys);
+
+  // Start with 60 points and triple the budget at every rung.
+  double bestLambda;
+  std::tie(bestLambda) = sh.Optimize(candidates, 60);
+
+  // The huge penalties should have been eliminated.
+  REQUIRE(bestLambda <= 0.1);
+  REQUIRE(sh.BestIndex() < 3);
+  REQUIRE(sh.BestObjective() < 0.5);
+
+  // The model of the best configuration should show the same performance on
+  // a fresh validation set as the best objective order of magnitude suggests.
+  arma::mat validationXs = arma::randn(5, 100);
+  arma::rowvec validationYs =
+      beta.t() * validationXs + 0.1 * arma::randn(1, 100);
+  const double objective =
+      MSE::Evaluate(sh.BestModel(), validationXs, validationYs);
+  REQUIRE(objective < 0.5);
+}
@@ -11,6 +11,7 @@
  */
 
 #include <mlpack/core.hpp>
+#include <mlpack/core/data/image_batch_loader.hpp>
 #include "serialization.hpp"
 #include "test_catch_tools.hpp"
 #include "catch.hpp"
@@ -156,4 +157,38 @@ TEST_CASE("ImageInfoSerialization", "[ImageLoadTest]")
   REQUIRE(info.Quality() == binaryInfo.Quality());
 }
 
+/**
+ * Test that the prefetching batch loader delivers all images, in order and
+ * correctly normalized.
+ */
+TEST_CASE("ImageBatchLoaderTest", "[ImageLoadTest]")
+{
+  // Load the image once to get the expected normalized column.
+  arma::mat expected;
+  data::ImageInfo info;
+  REQUIRE(data::Load("test_image.png", expected, info, false) == true);
+  expected /= 255.0;
+
+  // Five copies of the image in batches of two: the last batch is smaller.
+  std::vector<std::string> files(5, "test_image.png");
+  data::ImageBatchLoader<> loader(files, info, 2);
+  REQUIRE(loader.NumBatches() == 3);
+
+  arma::mat batch;
+  size_t delivered = 0;
+  while (loader.Next(batch))
+  {
+    REQUIRE(batch.n_rows == info.Width() * info.Height() * info.Channels());
+    for (size_t c = 0; c < batch.n_cols; ++c)
+    {
+      for (size_t i = 0; i < batch.n_rows; ++i)
+        REQUIRE(batch(i, c) == Approx(expected[i]).margin(1e-7));
+    }
+    delivered += batch.n_cols;
+  }
+
+  REQUIRE(delivered == files.size());
+  REQUIRE(loader.HasNext() == false);
+}
+
 #endif // HAS_STB.
@@ -313,3 +313,106 @@ TEST_CASE("DatasetMapperPointerMapping", "[ImputationTest]")
   REQUIRE(dm.UnmapString(1, 0) == &b);
   REQUIRE(dm.UnmapString(2, 0) == &c);
 }
+
+/**
+ * Make sure the all-dimensions overloads give the same results as imputing
+ * each dimension separately.
+ */
+TEST_CASE("AllDimensionsImputationTest", "[ImputationTest]")
+{
+  arma::mat input = arma::randu<arma::mat>(8, 60);
+  // Scatter missing values over every dimension.
+  for (size_t d = 0; d < input.n_rows; ++d)
+    for (size_t i = d; i < input.n_cols; i += (d + 3))
+      input(d, i) = 99.0;
+
+  arma::Col<double> mappedValues(input.n_rows);
+  mappedValues.fill(99.0);
+
+  // Mean imputation.
+  {
+    arma::mat bulk(input), reference(input);
+    MeanImputation<double> imputer;
+    imputer.Impute(bulk, mappedValues, true);
+    for (size_t d = 0; d < reference.n_rows; ++d)
+      imputer.Impute(reference, 99.0, d, true);
+    CheckMatrices(bulk, reference);
+  }
+
+  // Median imputation.
+  {
+    arma::mat bulk(input), reference(input);
+    MedianImputation<double> imputer;
+    imputer.Impute(bulk, mappedValues, true);
+    for (size_t d = 0; d < reference.n_rows; ++d)
+      imputer.Impute(reference, 99.0, d, true);
+    CheckMatrices(bulk, reference);
+  }
+
+  // Custom imputation.
+  {
+    arma::mat bulk(input), reference(input);
+    CustomImputation<double> imputer(7.0);
+    imputer.Impute(bulk, mappedValues, true);
+    for (size_t d = 0; d < reference.n_rows; ++d)
+      imputer.Impute(reference, 99.0, d, true);
+    CheckMatrices(bulk, reference);
+  }
+
+  // Listwise deletion.
+  {
+    arma::mat bulk(input), reference(input);
+    ListwiseDeletion<double> imputer;
+    imputer.Impute(bulk, mappedValues, true);
+    for (size_t d = 0; d < reference.n_rows; ++d)
+      imputer.Impute(reference, 99.0, d, true);
+    CheckMatrices(bulk, reference);
+  }
+
+  // Row-major (transposed) mean imputation must match too.
+  {
+    arma::mat transposed = input.t();
+    arma::mat bulk(transposed), reference(transposed);
+    MeanImputation<double> imputer;
+    imputer.Impute(bulk, mappedValues, false);
+    for (size_t d = 0; d < reference.n_cols; ++d)
+      imputer.Impute(reference, 99.0, d, false);
+    CheckMatrices(bulk, reference);
+  }
+}
+
+/**
+ * Make sure approximate (sketch-based) median imputation fills missing
+ * values with a close estimate of the exact median.
+ */
+TEST_CASE("ApproximateMedianImputationTest", "[ImputationTest]")
+{
+  arma::mat input = arma::randu<arma::mat>(3, 5000);
+  // Punch missing values into the first dimension.
+  for (size_t i = 0; i < input.n_cols; i += 17)
+    input(0, i) = 99.0;
+
+  arma::mat exact(input), approx(input);
+
+  MedianImputation<double> exactImputer;
+  MedianImputation<double> approxImputer(true);
+  exactImputer.Impute(exact, 99.0, 0, true);
+  approxImputer.Impute(approx, 99.0, 0, true);
+
+  // Every missing entry must hold a value close to the exact median.
+  for (size_t i = 0; i < input.n_cols; i += 17)
+    REQUIRE(approx(0, i) == Approx(exact(0, i)).margin(0.02));
+
+  // Non-missing entries must be untouched.
+  for (size_t i = 1; i < input.n_cols; ++i)
+    if (i % 17 != 0)
+      REQUIRE(approx(0, i) == input(0, i));
+
+  // The bulk overload must honor the approximate mode, too.
+  arma::mat bulk(input);
+  arma::Col<double> mappedValues(input.n_rows);
+  mappedValues.fill(99.0);
+  approxImputer.Impute(bulk, mappedValues, true);
+  for (size_t i = 0; i < input.n_cols; i += 17)
+    REQUIRE(bulk(0, i) == Approx(exact(0, i)).margin(0.02));
+}
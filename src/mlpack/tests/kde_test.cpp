@@ -1297,3 +1297,144 @@ TEST_CASE("GaussianBreadthDualKDTreeMonteCarloKDE", "[KDETest]")
 
   REQUIRE(correctResults > 70);
 }
+
+/**
+ * Test that CollectQuerySubtrees partitions the query tree: the collected
+ * subtrees are disjoint and together cover every query point.
+ */
+TEST_CASE("KDECollectQuerySubtreesTest", "[KDETest]")
+{
+  arma::mat dataset = arma::randu(2, 300);
+  std::vector<size_t> oldFromNew;
+  KDTree<EuclideanDistance, kde::KDEStat, arma::mat> tree(dataset, oldFromNew);
+
+  std::vector<KDTree<EuclideanDistance, kde::KDEStat, arma::mat>*> subtrees;
+  kde::CollectQuerySubtrees(&tree, 8, subtrees);
+
+  REQUIRE(subtrees.size() >= 8);
+
+  // Each point must be a descendant of exactly one collected subtree.
+  arma::Col<size_t> counts(dataset.n_cols, arma::fill::zeros);
+  for (size_t i = 0; i < subtrees.size(); ++i)
+    for (size_t j = 0; j < subtrees[i]->NumDescendants(); ++j)
+      counts(subtrees[i]->Descendant(j))++;
+
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    REQUIRE(counts(i) == 1);
+}
+
+/**
+ * Test dual-tree implementation results against brute force results on a
+ * query set large enough for the evaluation to be split across threads.
+ */
+TEST_CASE("ParallelDualTreeResultsKDE", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 1000);
+  arma::mat query = arma::randu(2, 800);
+  arma::vec kdeEstimations, bfEstimations = arma::vec(query.n_cols,
+      arma::fill::zeros);
+  const double kernelBandwidth = 0.3;
+  const double relError = 0.05;
+
+  // Brute force KDE.
+  GaussianKernel kernel(kernelBandwidth);
+  BruteForceKDE<GaussianKernel>(reference, query, bfEstimations, kernel);
+
+  // Optimized KDE.
+  metric::EuclideanDistance metric;
+  KDE<GaussianKernel, metric::EuclideanDistance, arma::mat, KDTree>
+      kde(relError, 0.0, kernel, KDEMode::DUAL_TREE_MODE, metric);
+  kde.Train(reference);
+  kde.Evaluate(query, kdeEstimations);
+
+  // Check whether results are equal.
+  for (size_t i = 0; i < query.n_cols; ++i)
+    REQUIRE(kdeEstimations[i] == Approx(bfEstimations[i]).epsilon(relError));
+}
+
+/**
+ * Test that batched kernel evaluation matches the scalar evaluation for the
+ * kernels that support it.
+ */
+TEST_CASE("BatchKernelEvaluationKDE", "[KDETest]")
+{
+  arma::vec distances = 3.0 * arma::randu<arma::vec>(500);
+  arma::vec kernelValues;
+
+  GaussianKernel gaussian(0.7);
+  gaussian.BatchEvaluate(distances, kernelValues);
+  REQUIRE(kernelValues.n_elem == distances.n_elem);
+  for (size_t i = 0; i < distances.n_elem; ++i)
+  {
+    REQUIRE(kernelValues[i] ==
+        Approx(gaussian.Evaluate(distances[i])).epsilon(1e-10));
+  }
+
+  EpanechnikovKernel epanechnikov(0.7);
+  epanechnikov.BatchEvaluate(distances, kernelValues);
+  REQUIRE(kernelValues.n_elem == distances.n_elem);
+  for (size_t i = 0; i < distances.n_elem; ++i)
+  {
+    REQUIRE(kernelValues[i] ==
+        Approx(epanechnikov.Evaluate(distances[i])).margin(1e-10));
+  }
+}
+
+/**
+ * Test that Monte Carlo checkpointing produces correct results when the same
+ * query set is evaluated again with a tighter relative error tolerance.
+ */
+TEST_CASE("MonteCarloCheckpointKDE", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 3000);
+  arma::mat query = arma::randu(2, 100);
+  arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  arma::vec firstEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  arma::vec secondEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  const double kernelBandwidth = 0.35;
+
+  // Brute force KDE.
+  GaussianKernel kernel(kernelBandwidth);
+  BruteForceKDE<GaussianKernel>(reference,
+                                query,
+                                bfEstimations,
+                                kernel);
+
+  // Optimized KDE with checkpointing enabled.
+  metric::EuclideanDistance metric;
+  KDE<GaussianKernel,
+      metric::EuclideanDistance,
+      arma::mat,
+      tree::KDTree>
+    kde(0.08,
+        0.0,
+        kernel,
+        KDEMode::SINGLE_TREE_MODE,
+        metric,
+        true,
+        0.95,
+        100,
+        2,
+        0.7);
+  kde.MCCheckpointing() = true;
+  kde.Train(reference);
+
+  // First evaluation fills the checkpoint; the second one refines the samples
+  // with a tighter relative error tolerance.
+  kde.Evaluate(query, firstEstimations);
+  kde.RelativeError(0.05);
+  kde.Evaluate(query, secondEstimations);
+
+  // The Monte Carlo estimation has a random component so it can fail. Therefore
+  // we require a reasonable amount of results to be right.
+  size_t correctResults = 0;
+  for (size_t i = 0; i < query.n_cols; ++i)
+  {
+    const double resultRelativeError =
+      std::abs((bfEstimations[i] - secondEstimations[i]) / bfEstimations[i]);
+    if (resultRelativeError < 0.05)
+      ++correctResults;
+  }
+
+  REQUIRE(correctResults > 70);
+}
@@ -11,7 +11,9 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/core/kernels/gaussian_kernel.hpp>
+#include <mlpack/methods/kernel_pca/kernel_rules/krylov_method.hpp>
 #include <mlpack/methods/kernel_pca/kernel_rules/nystroem_method.hpp>
+#include <mlpack/methods/kernel_pca/kernel_rules/incomplete_cholesky_method.hpp>
 #include <mlpack/methods/kernel_pca/kernel_pca.hpp>
 
 #include "catch.hpp"
@@ -147,3 +149,164 @@ TEST_CASE("CircleTransformationTestNystroem", "[KernelPCATest]")
   REQUIRE(ranges[0].Contains(ranges[2]) == false);
   REQUIRE(ranges[1].Contains(ranges[2]) == false);
 }
+
+/**
+ * The incomplete Cholesky rule should also turn the circle dataset into a
+ * linearly separable dataset.
+ */
+TEST_CASE("CircleTransformationTestIncompleteCholesky", "[KernelPCATest]")
+{
+  // The dataset, which will have three concentric rings in three dimensions.
+  arma::mat dataset;
+
+  // Now, there are 750 points centered at the origin with unit variance.
+  dataset.randn(3, 750);
+  dataset *= 0.05;
+
+  // Take the second 250 points and spread them away from the origin.
+  for (size_t i = 250; i < 500; ++i)
+  {
+    // Push the point away from the origin by 2.
+    const double pointNorm = norm(dataset.col(i), 2);
+
+    dataset(0, i) += 2.0 * (dataset(0, i) / pointNorm);
+    dataset(1, i) += 2.0 * (dataset(1, i) / pointNorm);
+    dataset(2, i) += 2.0 * (dataset(2, i) / pointNorm);
+  }
+
+  // Take the third 500 points and spread them away from the origin.
+  for (size_t i = 500; i < 750; ++i)
+  {
+    // Push the point away from the origin by 5.
+    const double pointNorm = norm(dataset.col(i), 2);
+
+    dataset(0, i) += 5.0 * (dataset(0, i) / pointNorm);
+    dataset(1, i) += 5.0 * (dataset(1, i) / pointNorm);
+    dataset(2, i) += 5.0 * (dataset(2, i) / pointNorm);
+  }
+
+  // Reduce to 20 dimensions with the incomplete Cholesky rule (which also
+  // bounds the rank of the kernel approximation at 20), and check that the
+  // first component separates the rings.
+  KernelPCA<GaussianKernel, IncompleteCholeskyKernelRule<GaussianKernel> > p;
+  arma::mat transformed;
+  arma::vec eigval;
+  arma::mat eigvec;
+  p.Apply(dataset, transformed, eigval, eigvec, 20);
+
+  // Get the ranges of each "class".  These are all initialized as empty
+  // ranges containing no points.
+  Range ranges[3];
+  ranges[0] = Range();
+  ranges[1] = Range();
+  ranges[2] = Range();
+
+  // Expand the ranges to hold all of the points in the class.
+  for (size_t i = 0; i < 250; ++i)
+    ranges[0] |= transformed(0, i);
+  for (size_t i = 250; i < 500; ++i)
+    ranges[1] |= transformed(0, i);
+  for (size_t i = 500; i < 750; ++i)
+    ranges[2] |= transformed(0, i);
+
+  // None of these ranges should overlap -- the classes should be linearly
+  // separable.
+  REQUIRE(ranges[0].Contains(ranges[1]) == false);
+  REQUIRE(ranges[0].Contains(ranges[2]) == false);
+  REQUIRE(ranges[1].Contains(ranges[2]) == false);
+}
+
+/**
+ * The block Krylov rule should also turn the circle dataset into a linearly
+ * separable dataset.
+ */
+TEST_CASE("CircleTransformationTestKrylov", "[KernelPCATest]")
+{
+  // The dataset, which will have three concentric rings in three dimensions.
+  arma::mat dataset;
+
+  // Now, there are 750 points centered at the origin with unit variance.
+  dataset.randn(3, 750);
+  dataset *= 0.05;
+
+  // Take the second 250 points and spread them away from the origin.
+  for (size_t i = 250; i < 500; ++i)
+  {
+    // Push the point away from the origin by 2.
+    const double pointNorm = norm(dataset.col(i), 2);
+
+    dataset(0, i) += 2.0 * (dataset(0, i) / pointNorm);
+    dataset(1, i) += 2.0 * (dataset(1, i) / pointNorm);
+    dataset(2, i) += 2.0 * (dataset(2, i) / pointNorm);
+  }
+
+  // Take the third 500 points and spread them away from the origin.
+  for (size_t i = 500; i < 750; ++i)
+  {
+    // Push the point away from the origin by 5.
+    const double pointNorm = norm(dataset.col(i), 2);
+
+    dataset(0, i) += 5.0 * (dataset(0, i) / pointNorm);
+    dataset(1, i) += 5.0 * (dataset(1, i) / pointNorm);
+    dataset(2, i) += 5.0 * (dataset(2, i) / pointNorm);
+  }
+
+  // Now we have a dataset; we will use the GaussianKernel to perform KernelPCA
+  // using the block Krylov eigensolver to take it down to one dimension.
+  KernelPCA<GaussianKernel, KrylovKernelRule<GaussianKernel> > p;
+  p.Apply(dataset, 1);
+
+  // Get the ranges of each "class".  These are all initialized as empty ranges
+  // containing no points.
+  Range ranges[3];
+  ranges[0] = Range();
+  ranges[1] = Range();
+  ranges[2] = Range();
+
+  // Expand the ranges to hold all of the points in the class.
+  for (size_t i = 0; i < 250; ++i)
+    ranges[0] |= dataset(0, i);
+  for (size_t i = 250; i < 500; ++i)
+    ranges[1] |= dataset(0, i);
+  for (size_t i = 500; i < 750; ++i)
+    ranges[2] |= dataset(0, i);
+
+  // None of these ranges should overlap -- the classes should be linearly
+  // separable.
+  REQUIRE(ranges[0].Contains(ranges[1]) == false);
+  REQUIRE(ranges[0].Contains(ranges[2]) == false);
+  REQUIRE(ranges[1].Contains(ranges[2]) == false);
+}
+
+/**
+ * The top eigenvalues from the block Krylov rule should agree with the top
+ * eigenvalues from the naive rule.
+ */
+TEST_CASE("KrylovEigenvalueAgreementTest", "[KernelPCATest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 300);
+
+  arma::mat naiveTransformed, krylovTransformed;
+  arma::vec naiveEigval, krylovEigval;
+  arma::mat naiveEigvec, krylovEigvec;
+
+  NaiveKernelRule<GaussianKernel>::ApplyKernelMatrix(dataset,
+      naiveTransformed, naiveEigval, naiveEigvec, 0);
+  KrylovKernelRule<GaussianKernel>::ApplyKernelMatrix(dataset,
+      krylovTransformed, krylovEigval, krylovEigvec, 5);
+
+  REQUIRE(krylovEigval.n_elem == 5);
+  for (size_t i = 0; i < 5; ++i)
+    REQUIRE(krylovEigval[i] == Approx(naiveEigval[i]).epsilon(1e-5));
+
+  // The transformed rows should agree up to sign.
+  for (size_t i = 0; i < 5; ++i)
+  {
+    const double same = arma::norm(krylovTransformed.row(i) -
+        naiveTransformed.row(i));
+    const double flipped = arma::norm(krylovTransformed.row(i) +
+        naiveTransformed.row(i));
+    REQUIRE(std::min(same, flipped) ==
+        Approx(0.0).margin(1e-5 * arma::norm(naiveTransformed.row(i))));
+  }
+}
@@ -20,6 +20,8 @@
 #include <mlpack/core/kernels/spherical_kernel.hpp>
 #include <mlpack/core/kernels/pspectrum_string_kernel.hpp>
 #include <mlpack/core/kernels/cauchy_kernel.hpp>
+#include <mlpack/core/kernels/kernel_matrix.hpp>
+#include <mlpack/core/kernels/incomplete_cholesky.hpp>
 #include <mlpack/core/metrics/lmetric.hpp>
 #include <mlpack/core/metrics/mahalanobis_distance.hpp>
 
@@ -632,3 +634,120 @@ TEST_CASE("CauchyKernelTest", "[KernelTest]")
   REQUIRE(ck.Evaluate(a, b) == Approx(0.92592588).epsilon(1e-7));
   REQUIRE(ck.Evaluate(b, a) == Approx(0.92592588).epsilon(1e-7));
 }
+
+/**
+ * The blocked pairwise kernel matrix must match scalar evaluation for each of
+ * the three strategies: squared-distance kernels, dot-product kernels, and
+ * the pairwise fallback.
+ */
+TEST_CASE("PairwiseKernelMatrixTest", "[KernelTest]")
+{
+  arma::mat a = arma::randu<arma::mat>(5, 40);
+  arma::mat b = arma::randu<arma::mat>(5, 25);
+
+  GaussianKernel gk(0.5);
+  EpanechnikovKernel ek(2.0);
+  PolynomialKernel pk(3.0, 1.0);
+  LaplacianKernel lk(1.5);
+
+  // Use a block size smaller than the number of columns, so that the blocked
+  // paths actually process more than one block.
+  arma::mat kernelMatrix;
+  PairwiseKernelMatrix(a, b, gk, kernelMatrix, 8);
+  REQUIRE(kernelMatrix.n_rows == a.n_cols);
+  REQUIRE(kernelMatrix.n_cols == b.n_cols);
+  for (size_t j = 0; j < b.n_cols; ++j)
+    for (size_t i = 0; i < a.n_cols; ++i)
+      REQUIRE(kernelMatrix(i, j) ==
+          Approx(gk.Evaluate(a.col(i), b.col(j))).margin(1e-10));
+
+  PairwiseKernelMatrix(a, b, ek, kernelMatrix, 8);
+  for (size_t j = 0; j < b.n_cols; ++j)
+    for (size_t i = 0; i < a.n_cols; ++i)
+      REQUIRE(kernelMatrix(i, j) ==
+          Approx(ek.Evaluate(a.col(i), b.col(j))).margin(1e-10));
+
+  PairwiseKernelMatrix(a, b, pk, kernelMatrix, 8);
+  for (size_t j = 0; j < b.n_cols; ++j)
+    for (size_t i = 0; i < a.n_cols; ++i)
+      REQUIRE(kernelMatrix(i, j) ==
+          Approx(pk.Evaluate(a.col(i), b.col(j))).margin(1e-10));
+
+  PairwiseKernelMatrix(a, b, lk, kernelMatrix, 8);
+  for (size_t j = 0; j < b.n_cols; ++j)
+    for (size_t i = 0; i < a.n_cols; ++i)
+      REQUIRE(kernelMatrix(i, j) ==
+          Approx(lk.Evaluate(a.col(i), b.col(j))).margin(1e-10));
+}
+
+/**
+ * The cached pairwise kernel matrix must give the same result whether it is
+ * computed or loaded from disk, and changing a kernel parameter must change
+ * the cache file.
+ */
+TEST_CASE("PairwiseKernelMatrixCacheTest", "[KernelTest]")
+{
+  arma::mat a = arma::randu<arma::mat>(4, 30);
+  arma::mat b = arma::randu<arma::mat>(4, 10);
+  GaussianKernel gk(1.2);
+
+  const std::string prefix = "pairwise_kernel_cache_test";
+  const std::string cacheFile = KernelMatrixCacheFile(a, b, gk, prefix);
+
+  // The first call computes and saves; the second call loads from disk.
+  arma::mat direct, cached, reloaded;
+  PairwiseKernelMatrix(a, b, gk, direct);
+  PairwiseKernelMatrix(a, b, gk, cached, prefix);
+  PairwiseKernelMatrix(a, b, gk, reloaded, prefix);
+
+  REQUIRE(arma::norm(direct - cached, "fro") == Approx(0.0).margin(1e-15));
+  REQUIRE(arma::norm(direct - reloaded, "fro") == Approx(0.0).margin(1e-15));
+
+  // A different bandwidth must map to a different cache file, so a parameter
+  // sweep can never hit a stale entry.
+  GaussianKernel gk2(2.0);
+  REQUIRE(KernelMatrixCacheFile(a, b, gk2, prefix) != cacheFile);
+
+  remove(cacheFile.c_str());
+}
+
+/**
+ * The pivoted incomplete Cholesky factor must reproduce the kernel matrix
+ * when the rank budget is not binding, respect the budget when it is, and
+ * stop early on low-rank kernels.
+ */
+TEST_CASE("IncompleteCholeskyTest", "[KernelTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(4, 50);
+  GaussianKernel gk(0.5);
+
+  // With a full rank budget the factorization is exact.
+  arma::mat factor;
+  const size_t rank = IncompleteCholesky(data, gk, data.n_cols, factor);
+  REQUIRE(factor.n_rows == data.n_cols);
+  REQUIRE(factor.n_cols == rank);
+
+  const arma::mat approximation = factor * factor.t();
+  for (size_t j = 0; j < data.n_cols; ++j)
+    for (size_t i = 0; i < data.n_cols; ++i)
+      REQUIRE(approximation(i, j) ==
+          Approx(gk.Evaluate(data.col(i), data.col(j))).margin(1e-6));
+
+  // A smaller budget must be respected.
+  const size_t lowRank = IncompleteCholesky(data, gk, 10, factor);
+  REQUIRE(lowRank <= 10);
+  REQUIRE(factor.n_cols == lowRank);
+
+  // The linear kernel matrix of 4-dimensional data has rank at most 4, so
+  // the factorization must stop long before the budget is exhausted.
+  LinearKernel lk;
+  const size_t linearRank =
+      IncompleteCholesky(data, lk, data.n_cols, factor, 1e-8);
+  REQUIRE(linearRank <= 4);
+
+  const arma::mat linearApproximation = factor * factor.t();
+  for (size_t j = 0; j < data.n_cols; ++j)
+    for (size_t i = 0; i < data.n_cols; ++i)
+      REQUIRE(linearApproximation(i, j) ==
+          Approx(lk.Evaluate(data.col(i), data.col(j))).margin(1e-6));
+}
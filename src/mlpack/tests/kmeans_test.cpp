@@ -17,6 +17,7 @@
 #include <mlpack/methods/kmeans/pelleg_moore_kmeans.hpp>
 #include <mlpack/methods/kmeans/dual_tree_kmeans.hpp>
 #include <mlpack/methods/kmeans/sample_initialization.hpp>
+#include <mlpack/methods/kmeans/scalable_kmeans_initialization.hpp>
 #include <mlpack/methods/kmeans/random_partition.hpp>
 
 #include <mlpack/core/tree/cover_tree/cover_tree.hpp>
@@ -486,6 +487,73 @@ TEST_CASE("RefinedStartTest", "[KMeansTest]")
   REQUIRE(distortion < 14000.0);
 }
 
+/**
+ * Test that the k-means|| initialization produces a full set of sensible
+ * centroids.
+ */
+TEST_CASE("ScalableKMeansInitializationTest", "[KMeansTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(4, 1000);
+
+  ScalableKMeansInitialization init;
+  arma::mat centroids;
+  init.Cluster(data, 20, centroids);
+
+  REQUIRE(centroids.n_rows == 4);
+  REQUIRE(centroids.n_cols == 20);
+
+  // Every centroid must be finite and lie inside the bounding box of the
+  // data (centroids are weighted means of data points).
+  for (size_t j = 0; j < centroids.n_cols; ++j)
+  {
+    for (size_t d = 0; d < centroids.n_rows; ++d)
+    {
+      REQUIRE(std::isfinite(centroids(d, j)));
+      REQUIRE(centroids(d, j) >= arma::min(data.row(d)));
+      REQUIRE(centroids(d, j) <= arma::max(data.row(d)));
+    }
+  }
+}
+
+/**
+ * Test that k-means seeded with k-means|| gives clusterings at least as good
+ * as the refined start bound on the same five-Gaussian dataset.
+ */
+TEST_CASE("ScalableKMeansClusterTest", "[KMeansTest]")
+{
+  // The same dataset as in RefinedStartTest: five Gaussians of largely
+  // varying numbers of points.
+  arma::mat data(3, 3000);
+  data.randn();
+
+  arma::mat centroids(" 0  5 -2 -6  1;"
+                      " 0  0 -2  8  6;"
+                      " 0 -2 -2  8  1");
+
+  for (size_t i = 1000; i < 1200; ++i)
+    data.col(i) += centroids.col(1);
+  for (size_t i = 1200; i < 1700; ++i)
+    data.col(i) += centroids.col(2);
+  for (size_t i = 1700; i < 1800; ++i)
+    data.col(i) += centroids.col(3);
+  for (size_t i = 1800; i < 3000; ++i)
+    data.col(i) += centroids.col(4);
+
+  KMeans<metric::EuclideanDistance, ScalableKMeansInitialization> kmeans;
+  arma::Row<size_t> assignments;
+  arma::mat resultingCentroids;
+  kmeans.Cluster(data, 5, assignments, resultingCentroids);
+
+  // Calculate the sum of distances from the cluster centroids, as in
+  // RefinedStartTest; the same 14000 bound applies.
+  double distortion = 0;
+  for (size_t i = 0; i < 3000; ++i)
+    distortion += metric::EuclideanDistance::Evaluate(data.col(i),
+        resultingCentroids.col(assignments[i]));
+
+  REQUIRE(distortion < 14000.0);
+}
+
 #ifdef ARMA_HAS_SPMAT
 /**
  * Make sure sparse k-means works okay.
@@ -567,6 +635,52 @@ TEST_CASE("ElkanTest", "[KMeansTest]")
   }
 }
 
+/**
+ * Make sure Elkan's algorithm agrees with the naive method for a non-Euclidean
+ * metric too; this exercises the pairwise inter-center kernel instead of the
+ * Gram-based one.  Also sanity-check the reported prune rate.
+ */
+TEST_CASE("ElkanManhattanTest", "[KMeansTest]")
+{
+  arma::mat dataset(10, 1000);
+  dataset.randu();
+
+  const size_t k = 20;
+  arma::mat centroids(10, k);
+  centroids.randu();
+
+  arma::mat naiveCentroids(centroids);
+  KMeans<metric::ManhattanDistance> km;
+  arma::Row<size_t> assignments;
+  km.Cluster(dataset, k, assignments, naiveCentroids, false, true);
+
+  KMeans<metric::ManhattanDistance, RandomPartition, MaxVarianceNewCluster,
+      ElkanKMeans> elkan;
+  arma::Row<size_t> elkanAssignments;
+  arma::mat elkanCentroids(centroids);
+  elkan.Cluster(dataset, k, elkanAssignments, elkanCentroids, false, true);
+
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    REQUIRE(assignments[i] == elkanAssignments[i]);
+
+  for (size_t i = 0; i < centroids.n_elem; ++i)
+    REQUIRE(naiveCentroids[i] == Approx(elkanCentroids[i]).epsilon(1e-7));
+
+  // The prune rate is only exposed on the Lloyd step object itself.
+  metric::EuclideanDistance metric;
+  ElkanKMeans<metric::EuclideanDistance, arma::mat> lloyd(dataset, metric);
+  arma::mat iterCentroids(centroids);
+  arma::mat newCentroids;
+  arma::Col<size_t> counts;
+  lloyd.Iterate(iterCentroids, newCentroids, counts);
+  iterCentroids = newCentroids;
+  lloyd.Iterate(iterCentroids, newCentroids, counts);
+
+  REQUIRE(lloyd.PruneRate() >= 0.0);
+  REQUIRE(lloyd.PruneRate() <= 1.0);
+  REQUIRE(lloyd.DistanceCalculations() > 0);
+}
+
 TEST_CASE("HamerlyTest", "[KMeansTest]")
 {
   const size_t trials = 5;
@@ -733,3 +847,82 @@ TEST_CASE("SampleInitializationTest", "[KMeansTest]")
     REQUIRE(j < dataset.n_cols);
   }
 }
+
+/**
+ * Make sure the blocked GEMM-based Lloyd step gives the same update as the
+ * naive step.
+ */
+TEST_CASE("GemmKMeansIterateTest", "[KMeansTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(10, 1000);
+  arma::mat centroids = arma::randu<arma::mat>(10, 5);
+
+  metric::EuclideanDistance metric;
+
+  NaiveKMeans<metric::EuclideanDistance, arma::mat> naive(data, metric);
+  GemmKMeans<metric::EuclideanDistance, arma::mat> gemm(data, metric);
+
+  arma::mat naiveCentroids, gemmCentroids;
+  arma::Col<size_t> naiveCounts, gemmCounts;
+
+  const double naiveResidual = naive.Iterate(centroids, naiveCentroids,
+      naiveCounts);
+  const double gemmResidual = gemm.Iterate(centroids, gemmCentroids,
+      gemmCounts);
+
+  REQUIRE(naiveResidual == Approx(gemmResidual).epsilon(1e-7));
+  for (size_t i = 0; i < naiveCounts.n_elem; ++i)
+    REQUIRE(naiveCounts[i] == gemmCounts[i]);
+  for (size_t i = 0; i < naiveCentroids.n_elem; ++i)
+    REQUIRE(naiveCentroids[i] == Approx(gemmCentroids[i]).epsilon(1e-7));
+}
+
+/**
+ * Make sure that a warm-started run with a persistent Lloyd step object gives
+ * the same results as a cold run from the same starting centroids, including
+ * after some points of the dataset change.
+ */
+TEST_CASE("KMeansWarmStartTest", "[KMeansTest]")
+{
+  arma::mat dataset(10, 1000);
+  dataset.randu();
+
+  const size_t k = 10;
+
+  typedef KMeans<metric::EuclideanDistance, SampleInitialization,
+      MaxVarianceNewCluster, HamerlyKMeans> HamerlyKMeansType;
+  HamerlyKMeansType km;
+  HamerlyKMeans<metric::EuclideanDistance, arma::mat> lloydStep(dataset,
+      km.Metric());
+
+  // Initial run, persisting the bound state in lloydStep.
+  arma::Row<size_t> assignments;
+  arma::mat centroids(10, k);
+  centroids.randu();
+  km.Cluster(dataset, k, assignments, centroids, lloydStep);
+
+  // Change a small fraction of the dataset and invalidate those bounds.
+  for (size_t i = 0; i < 20; ++i)
+  {
+    const size_t index = math::RandInt(0, dataset.n_cols);
+    dataset.col(index).randu();
+    lloydStep.InvalidateBounds(index);
+  }
+
+  // Warm-started re-clustering from the previous centroids.
+  arma::Row<size_t> warmAssignments;
+  arma::mat warmCentroids(centroids);
+  km.Cluster(dataset, k, warmAssignments, warmCentroids, lloydStep);
+
+  // Cold run from the same starting centroids, with a fresh Lloyd step.
+  HamerlyKMeansType coldKm;
+  arma::Row<size_t> coldAssignments;
+  arma::mat coldCentroids(centroids);
+  coldKm.Cluster(dataset, k, coldAssignments, coldCentroids, false, true);
+
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    REQUIRE(warmAssignments[i] == coldAssignments[i]);
+
+  for (size_t i = 0; i < coldCentroids.n_elem; ++i)
+    REQUIRE(warmCentroids[i] == Approx(coldCentroids[i]).epsilon(1e-7));
+}
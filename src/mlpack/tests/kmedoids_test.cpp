@@ -0,0 +1,188 @@
+/**
+ * @file tests/kmedoids_test.cpp
+ *
+ * Tests for the KMedoids class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/kmedoids/kmedoids.hpp>
+
+#include "catch.hpp"
+#include "test_catch_tools.hpp"
+
+using namespace mlpack;
+using namespace mlpack::kmedoids;
+
+//! Generate three well-separated Gaussian clusters of the given size.
+static void SeparatedClusters(const size_t pointsPerCluster, arma::mat& data)
+{
+  data.set_size(2, 3 * pointsPerCluster);
+  for (size_t c = 0; c < 3; ++c)
+  {
+    data.cols(c * pointsPerCluster, (c + 1) * pointsPerCluster - 1) =
+        arma::randn(2, pointsPerCluster) * 0.5 + 10.0 * c;
+  }
+}
+
+/**
+ * On well-separated clusters, k-medoids must recover the separation: every
+ * point of a true cluster shares its assignment, the medoids are distinct
+ * dataset points, and the returned cost matches the assignment tables.
+ */
+TEST_CASE("KMedoidsSeparatedClustersTest", "[KMedoidsTest]")
+{
+  arma::mat data;
+  SeparatedClusters(100, data);
+
+  KMedoids<> km;
+  arma::Row<size_t> assignments;
+  arma::Col<size_t> medoids;
+  const double cost = km.Cluster(data, 3, assignments, medoids);
+
+  REQUIRE(assignments.n_elem == data.n_cols);
+  REQUIRE(medoids.n_elem == 3);
+  REQUIRE(medoids[0] != medoids[1]);
+  REQUIRE(medoids[0] != medoids[2]);
+  REQUIRE(medoids[1] != medoids[2]);
+
+  // Each true cluster must map to a single distinct label.
+  arma::Col<size_t> clusterLabels(3);
+  for (size_t c = 0; c < 3; ++c)
+  {
+    clusterLabels[c] = assignments[c * 100];
+    for (size_t i = 0; i < 100; ++i)
+      REQUIRE(assignments[c * 100 + i] == clusterLabels[c]);
+  }
+  REQUIRE(clusterLabels[0] != clusterLabels[1]);
+  REQUIRE(clusterLabels[0] != clusterLabels[2]);
+  REQUIRE(clusterLabels[1] != clusterLabels[2]);
+
+  // The returned cost must equal the sum of nearest-medoid distances, and
+  // every point must actually be assigned to its nearest medoid.
+  double expectedCost = 0.0;
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    double minDist = DBL_MAX;
+    for (size_t m = 0; m < 3; ++m)
+      minDist = std::min(minDist,
+          arma::norm(data.col(i) - data.col(medoids[m])));
+    expectedCost += minDist;
+    REQUIRE(arma::norm(data.col(i) - data.col(medoids[assignments[i]])) ==
+        Approx(minDist).epsilon(1e-7));
+  }
+  REQUIRE(cost == Approx(expectedCost).epsilon(1e-7));
+}
+
+/**
+ * With exact BUILD and SWAP, the result must be swap-optimal: no exchange of
+ * a medoid for a non-medoid point may lower the total deviation.  This
+ * checks the FastPAM swap decomposition against a brute-force evaluation.
+ */
+TEST_CASE("KMedoidsSwapOptimalTest", "[KMedoidsTest]")
+{
+  const arma::mat data = arma::randu(3, 60);
+
+  // Large sample sizes make both phases exact; no iteration cap.
+  KMedoids<> km(0, 60, 60);
+  arma::Row<size_t> assignments;
+  arma::Col<size_t> medoids;
+  const double cost = km.Cluster(data, 4, assignments, medoids);
+
+  std::vector<bool> isMedoid(data.n_cols, false);
+  for (size_t m = 0; m < medoids.n_elem; ++m)
+    isMedoid[medoids[m]] = true;
+
+  for (size_t c = 0; c < data.n_cols; ++c)
+  {
+    if (isMedoid[c])
+      continue;
+
+    for (size_t m = 0; m < medoids.n_elem; ++m)
+    {
+      // Evaluate the total deviation of swapping medoid m for point c.
+      arma::Col<size_t> swapped = medoids;
+      swapped[m] = c;
+
+      double swappedCost = 0.0;
+      for (size_t i = 0; i < data.n_cols; ++i)
+      {
+        double minDist = DBL_MAX;
+        for (size_t j = 0; j < swapped.n_elem; ++j)
+        {
+          minDist = std::min(minDist,
+              arma::norm(data.col(i) - data.col(swapped[j])));
+        }
+        swappedCost += minDist;
+      }
+
+      REQUIRE(swappedCost >= cost - 1e-6);
+    }
+  }
+}
+
+/**
+ * Sampled BUILD and SWAP must still produce a valid clustering on separated
+ * data, and non-Euclidean metrics must work through the generic distance
+ * path.
+ */
+TEST_CASE("KMedoidsSampledAndMetricTest", "[KMedoidsTest]")
+{
+  arma::mat data;
+  SeparatedClusters(50, data);
+
+  KMedoids<> sampled(100, 10, 20);
+  arma::Row<size_t> assignments;
+  arma::Col<size_t> medoids;
+  const double cost = sampled.Cluster(data, 3, assignments, medoids);
+  REQUIRE(cost > 0.0);
+  REQUIRE(assignments.n_elem == data.n_cols);
+  REQUIRE(assignments.max() <= 2);
+
+  KMedoids<metric::ManhattanDistance> manhattan;
+  const double manhattanCost = manhattan.Cluster(data, 3, assignments,
+      medoids);
+  REQUIRE(manhattanCost > 0.0);
+
+  // Manhattan separation is as clean as Euclidean on this data.
+  for (size_t c = 0; c < 3; ++c)
+  {
+    for (size_t i = 1; i < 50; ++i)
+      REQUIRE(assignments[c * 50 + i] == assignments[c * 50]);
+  }
+}
+
+/**
+ * Degenerate inputs: an invalid number of clusters must be rejected, and
+ * clustering with a single cluster must pick a central medoid.
+ */
+TEST_CASE("KMedoidsDegenerateTest", "[KMedoidsTest]")
+{
+  const arma::mat data = arma::randu(2, 10);
+
+  KMedoids<> km;
+  arma::Row<size_t> assignments;
+  arma::Col<size_t> medoids;
+
+  REQUIRE_THROWS_AS(km.Cluster(data, 0, assignments, medoids),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(km.Cluster(data, 11, assignments, medoids),
+      std::invalid_argument);
+
+  const double cost = km.Cluster(data, 1, assignments, medoids);
+  REQUIRE(medoids.n_elem == 1);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    REQUIRE(assignments[i] == 0);
+
+  // No other point may do better as the single medoid.
+  for (size_t c = 0; c < data.n_cols; ++c)
+  {
+    double candidateCost = 0.0;
+    for (size_t i = 0; i < data.n_cols; ++i)
+      candidateCost += arma::norm(data.col(i) - data.col(c));
+    REQUIRE(candidateCost >= cost - 1e-6);
+  }
+}
@@ -12,6 +12,9 @@
 #include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 #include <mlpack/methods/neighbor_search/unmap.hpp>
 #include <mlpack/methods/neighbor_search/ns_model.hpp>
+#include <mlpack/methods/neighbor_search/query_tuning.hpp>
+#include <mlpack/methods/neighbor_search/sharded_neighbor_search.hpp>
+#include <mlpack/core/data/quantize.hpp>
 #include <mlpack/core/tree/cover_tree.hpp>
 #include <mlpack/core/tree/example_tree.hpp>
 #include "test_catch_tools.hpp"
@@ -979,6 +982,52 @@ TEST_CASE("KNNDuplicatedSpillSearchTest", "[KNNTest]")
   }
 }
 
+/**
+ * Test bounded-backtracking defeatist search on spill trees: increasing the
+ * backtracking budget must not reduce accuracy, and a budget large enough to
+ * revisit every skipped branch must give the exact answer.
+ */
+TEST_CASE("KNNSpillBacktrackingTest", "[KNNTest]")
+{
+  arma::mat dataset;
+  dataset.randu(8, 500); // 8 dimensional, 500 points.
+
+  const size_t k = 5;
+
+  KNN naive(dataset, NAIVE_MODE);
+  arma::Mat<size_t> neighborsNaive;
+  arma::mat distancesNaive;
+  naive.Search(dataset, k, neighborsNaive, distancesNaive);
+
+  SpillKNN::Tree referenceTree(dataset, 0.05 /* tau parameter */);
+  SpillKNN spTreeSearch(std::move(referenceTree));
+  spTreeSearch.SearchMode() = SINGLE_TREE_MODE;
+
+  const size_t limits[3] = { 0, 4, dataset.n_cols };
+  size_t lastMatches = 0;
+  for (size_t t = 0; t < 3; ++t)
+  {
+    spTreeSearch.BacktrackLimit() = limits[t];
+
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    spTreeSearch.Search(dataset, k, neighbors, distances);
+
+    size_t matches = 0;
+    for (size_t i = 0; i < distances.n_elem; ++i)
+      if (distances[i] == Approx(distancesNaive[i]).epsilon(1e-7))
+        ++matches;
+
+    // A larger budget may only improve the results.
+    REQUIRE(matches >= lastMatches);
+    lastMatches = matches;
+  }
+
+  // With a budget that allows every skipped branch to be revisited, the search
+  // must be exact.
+  REQUIRE(lastMatches == distancesNaive.n_elem);
+}
+
 /**
  * Make sure sparse nearest neighbors works with kd trees.
  */
@@ -1020,6 +1069,49 @@ TEST_CASE("SparseKNNKDTreeTest", "[KNNTest]")
   }
 }
 
+/**
+ * Make sure sparse nearest neighbors works with mean-split kd trees, which
+ * exercise the sparse-aware mean split, and that the SparseKNN typedef gives
+ * the same results as a dense naive search.
+ */
+TEST_CASE("SparseKNNMeanSplitTest", "[KNNTest]")
+{
+  // As above, the dimensionality must be high enough that the probability of
+  // a completely empty point is very low.
+  arma::sp_mat queryDataset;
+  queryDataset.sprandu(70, 200, 0.2);
+  arma::sp_mat referenceDataset;
+  referenceDataset.sprandu(70, 500, 0.1);
+  arma::mat denseQuery(queryDataset);
+  arma::mat denseReference(referenceDataset);
+
+  typedef NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::sp_mat,
+      MeanSplitKDTree> SparseMeanSplitKNN;
+
+  SparseMeanSplitKNN a(referenceDataset);
+  SparseKNN b(referenceDataset);
+  KNN naive(denseReference, NAIVE_MODE);
+
+  arma::mat meanSplitDistances, sparseDistances, naiveDistances;
+  arma::Mat<size_t> meanSplitNeighbors, sparseNeighbors, naiveNeighbors;
+  a.Search(queryDataset, 10, meanSplitNeighbors, meanSplitDistances);
+  b.Search(queryDataset, 10, sparseNeighbors, sparseDistances);
+  naive.Search(denseQuery, 10, naiveNeighbors, naiveDistances);
+
+  for (size_t i = 0; i < naiveNeighbors.n_cols; ++i)
+  {
+    for (size_t j = 0; j < naiveNeighbors.n_rows; ++j)
+    {
+      REQUIRE(naiveNeighbors(j, i) == meanSplitNeighbors(j, i));
+      REQUIRE(naiveDistances(j, i) ==
+              Approx(meanSplitDistances(j, i)).epsilon(1e-7));
+      REQUIRE(naiveNeighbors(j, i) == sparseNeighbors(j, i));
+      REQUIRE(naiveDistances(j, i) ==
+              Approx(sparseDistances(j, i)).epsilon(1e-7));
+    }
+  }
+}
+
 /*
 TEST_CASE("SparseKNNCoverTreeTest", "[KNNTest]")
 {
@@ -1771,6 +1863,207 @@ TEST_CASE("KNNGreedyTreeSearch", "[KNNTest]")
   REQUIRE(arma::accu(distances < 0.0 || distances > std::sqrt(3.0)) == 0);
 }
 
+/**
+ * Test that the hybrid greedy + dual-tree mode returns exactly the same
+ * results as exact dual-tree search.
+ */
+TEST_CASE("KNNHybridSearchTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 500);
+
+  KNN exact(dataset);
+  KNN hybrid(dataset, HYBRID_DUAL_TREE_MODE);
+
+  arma::Mat<size_t> neighborsExact, neighborsHybrid;
+  arma::mat distancesExact, distancesHybrid;
+
+  // Monochromatic search.
+  exact.Search(5, neighborsExact, distancesExact);
+  hybrid.Search(5, neighborsHybrid, distancesHybrid);
+
+  CheckMatrices(neighborsExact, neighborsHybrid);
+  CheckMatrices(distancesExact, distancesHybrid);
+
+  // Bichromatic search.
+  arma::mat querySet = arma::randu<arma::mat>(5, 200);
+  exact.Search(querySet, 5, neighborsExact, distancesExact);
+  hybrid.Search(querySet, 5, neighborsHybrid, distancesHybrid);
+
+  CheckMatrices(neighborsExact, neighborsHybrid);
+  CheckMatrices(distancesExact, distancesHybrid);
+}
+
+/**
+ * Test that points added with AddPoints() are found by subsequent searches,
+ * both while they sit in the unindexed side buffer and after the buffer is
+ * merged into the tree.
+ */
+TEST_CASE("KNNAddPointsTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 300);
+  arma::mat addedPoints = arma::randu<arma::mat>(5, 20);
+
+  // 20 added points are below the rebuild threshold (a tenth of the indexed
+  // set), so they must stay in the side buffer.
+  KNN knn(dataset);
+  knn.AddPoints(addedPoints);
+  REQUIRE(knn.NumUnindexedPoints() == 20);
+
+  // A model trained on the full set must give identical results.
+  arma::mat fullSet = arma::join_rows(dataset, addedPoints);
+  KNN reference(fullSet);
+
+  arma::mat querySet = arma::randu<arma::mat>(5, 100);
+  arma::Mat<size_t> neighbors, neighborsRef;
+  arma::mat distances, distancesRef;
+
+  knn.Search(querySet, 3, neighbors, distances);
+  reference.Search(querySet, 3, neighborsRef, distancesRef);
+
+  CheckMatrices(neighbors, neighborsRef);
+  CheckMatrices(distances, distancesRef);
+
+  // Adding enough points to cross the rebuild threshold must merge the
+  // buffer into the tree without changing any results.
+  arma::mat morePoints = arma::randu<arma::mat>(5, 30);
+  knn.AddPoints(morePoints);
+  REQUIRE(knn.NumUnindexedPoints() == 0);
+
+  reference.Train(arma::join_rows(fullSet, morePoints));
+
+  knn.Search(querySet, 3, neighbors, distances);
+  reference.Search(querySet, 3, neighborsRef, distancesRef);
+
+  CheckMatrices(neighbors, neighborsRef);
+  CheckMatrices(distances, distancesRef);
+}
+
+/**
+ * Test that sharded search over several per-shard trees gives exactly the
+ * same results as a single tree over the whole reference set, in both the
+ * bichromatic and monochromatic cases.
+ */
+TEST_CASE("KNNShardedSearchTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 500);
+
+  KNN exact(dataset);
+  ShardedKNN sharded(dataset, 4);
+  REQUIRE(sharded.NumShards() == 4);
+
+  arma::Mat<size_t> neighbors, neighborsRef;
+  arma::mat distances, distancesRef;
+
+  // Bichromatic search.
+  arma::mat querySet = arma::randu<arma::mat>(5, 200);
+  exact.Search(querySet, 5, neighborsRef, distancesRef);
+  sharded.Search(querySet, 5, neighbors, distances);
+
+  CheckMatrices(neighbors, neighborsRef);
+  CheckMatrices(distances, distancesRef);
+
+  // Monochromatic search.
+  exact.Search(5, neighborsRef, distancesRef);
+  sharded.Search(5, neighbors, distances);
+
+  CheckMatrices(neighbors, neighborsRef);
+  CheckMatrices(distances, distancesRef);
+}
+
+/**
+ * Test that the bounding-box routed sharded search gives exactly the same
+ * results as a single tree, including when the query set spans several
+ * routing blocks and when single shards hold fewer than k points.
+ */
+TEST_CASE("KNNShardedRoutedSearchTest", "[KNNTest]")
+{
+  // Clustered data, so that the shard bounding boxes actually prune: the
+  // points sit in well-separated unit cubes along the diagonal, and the
+  // contiguous shards line up with the clusters.
+  arma::mat dataset = arma::randu<arma::mat>(5, 1200);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    dataset.col(i) += 10.0 * (i / 300);
+
+  arma::mat querySet = arma::randu<arma::mat>(5, 1100);
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+    querySet.col(i) += 10.0 * (i % 4);
+
+  KNN exact(dataset);
+  ShardedKNN sharded(dataset, 4);
+
+  arma::Mat<size_t> neighbors, neighborsRef;
+  arma::mat distances, distancesRef;
+
+  exact.Search(querySet, 5, neighborsRef, distancesRef);
+  sharded.Search(querySet, 5, neighbors, distances);
+
+  CheckMatrices(neighbors, neighborsRef);
+  CheckMatrices(distances, distancesRef);
+
+  // Now with only three points per shard and k = 10, so that the merge has
+  // to combine candidates from several shards to fill out k.
+  arma::mat tinySet = arma::randu<arma::mat>(3, 12);
+  arma::mat tinyQueries = arma::randu<arma::mat>(3, 25);
+
+  KNN tinyExact(tinySet);
+  ShardedKNN tinySharded(tinySet, 4);
+
+  tinyExact.Search(tinyQueries, 10, neighborsRef, distancesRef);
+  tinySharded.Search(tinyQueries, 10, neighbors, distances);
+
+  CheckMatrices(neighbors, neighborsRef);
+  CheckMatrices(distances, distancesRef);
+}
+
+/**
+ * Test k-nearest-neighbor search over an int8-quantized dataset.  The
+ * quantized distances only approximate the true L2 distances, so we check
+ * that the recall against an exact search is high rather than that the
+ * results are identical.
+ */
+TEST_CASE("KNNQuantizedSearchTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(8, 500);
+  arma::mat querySet = arma::randu<arma::mat>(8, 100);
+
+  // Quantize the reference set, then the query set with the same map.
+  arma::Mat<arma::s8> quantizedRefs, quantizedQueries;
+  arma::vec scale, offset;
+  mlpack::data::Quantize(dataset, quantizedRefs, scale, offset);
+  mlpack::data::Quantize(querySet, quantizedQueries, scale, offset);
+
+  KNN exact(dataset);
+  QuantizedKNN quantized(quantizedRefs, DUAL_TREE_MODE, 0.0,
+      metric::QuantizedEuclideanDistance(scale));
+
+  arma::Mat<size_t> neighbors, neighborsRef;
+  arma::mat distances, distancesRef;
+
+  exact.Search(querySet, 5, neighborsRef, distancesRef);
+  quantized.Search(quantizedQueries, 5, neighbors, distances);
+
+  // Count how many of the exact neighbors the quantized search recovered.
+  size_t hits = 0;
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    for (size_t j = 0; j < 5; ++j)
+    {
+      for (size_t l = 0; l < 5; ++l)
+      {
+        if (neighbors(j, i) == neighborsRef(l, i))
+        {
+          ++hits;
+          break;
+        }
+      }
+    }
+  }
+
+  // With 256 quantization levels per dimension the recall should be very
+  // high; 70% leaves plenty of headroom against an unlucky random set.
+  REQUIRE(hits >= (size_t) (0.7 * 5 * querySet.n_cols));
+}
+
 /**
  * Check that no garbage value is returned when greedy tree traversal
  * is performed over spill trees.
@@ -1814,3 +2107,521 @@ TEST_CASE("KNNSpillTreeSearchEnoughResults", "[KNNTest]")
   REQUIRE(arma::accu(distancesGreedy < 0.0 || distancesGreedy > std::sqrt(3.0))
       == 0);
 }
+
+/**
+ * Test that the parallel dual-tree traverser returns the same results as the
+ * sequential dual-tree traverser.
+ */
+TEST_CASE("KNNParallelDualTreeTraverserTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(8, 1000);
+
+  typedef KDTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+
+  KNN sequentialSearch(dataset);
+  NeighborSearch<NearestNeighborSort, metric::EuclideanDistance, arma::mat,
+      KDTree, TreeType::template ParallelDualTreeTraverser>
+      parallelSearch(dataset);
+
+  arma::Mat<size_t> neighborsSeq, neighborsPar;
+  arma::mat distancesSeq, distancesPar;
+
+  sequentialSearch.Search(10, neighborsSeq, distancesSeq);
+  parallelSearch.Search(10, neighborsPar, distancesPar);
+
+  REQUIRE(neighborsSeq.n_elem == neighborsPar.n_elem);
+  for (size_t i = 0; i < neighborsSeq.n_elem; ++i)
+  {
+    REQUIRE(neighborsSeq[i] == neighborsPar[i]);
+    REQUIRE(distancesSeq[i] == Approx(distancesPar[i]).epsilon(1e-10));
+  }
+}
+
+/**
+ * Test that NSModel::SearchBatch() gives the same results as Search() when
+ * queries arrive in several small batches.
+ */
+TEST_CASE("KNNModelBatchSearchTest", "[KNNTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(5, 500);
+  arma::mat queryData = arma::randu<arma::mat>(5, 100);
+
+  typedef NSModel<NearestNeighborSort> KNNModel;
+  KNNModel model(KNNModel::TreeTypes::KD_TREE, false);
+  arma::mat referenceCopy(referenceData);
+  model.BuildModel(std::move(referenceCopy), 20, DUAL_TREE_MODE, 0.0);
+
+  // Baseline: search the whole query set at once.
+  arma::Mat<size_t> baselineNeighbors;
+  arma::mat baselineDistances;
+  arma::mat queryCopy(queryData);
+  model.Search(std::move(queryCopy), 3, baselineNeighbors, baselineDistances);
+
+  // Streaming: search the same queries in batches of 10, reusing the result
+  // buffers across calls.
+  arma::Mat<size_t> batchNeighbors;
+  arma::mat batchDistances;
+  for (size_t start = 0; start < queryData.n_cols; start += 10)
+  {
+    arma::mat batch = queryData.cols(start, start + 9);
+    model.SearchBatch(batch, 3, batchNeighbors, batchDistances);
+
+    for (size_t i = 0; i < batch.n_cols; ++i)
+    {
+      for (size_t j = 0; j < 3; ++j)
+      {
+        REQUIRE(batchNeighbors(j, i) == baselineNeighbors(j, start + i));
+        REQUIRE(batchDistances(j, i) ==
+            Approx(baselineDistances(j, start + i)).epsilon(1e-10));
+      }
+    }
+  }
+}
+
+/**
+ * Test that the navigable small-world graph returns correctly ordered, valid
+ * results with reasonable recall against a brute-force search.
+ */
+TEST_CASE("KNNNSWGraphSearchTest", "[KNNTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(8, 1000);
+  arma::mat queryData = arma::randu<arma::mat>(8, 100);
+
+  // Exact results, for computing recall.
+  KNN naive(referenceData, NAIVE_MODE);
+  arma::Mat<size_t> exactNeighbors;
+  arma::mat exactDistances;
+  naive.Search(queryData, 5, exactNeighbors, exactDistances);
+
+  NSWGraph<NearestNeighborSort> graph;
+  arma::mat referenceCopy(referenceData);
+  graph.Train(std::move(referenceCopy));
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  graph.Search(queryData, 5, neighbors, distances);
+
+  REQUIRE(neighbors.n_rows == 5);
+  REQUIRE(neighbors.n_cols == queryData.n_cols);
+
+  size_t found = 0;
+  for (size_t i = 0; i < queryData.n_cols; ++i)
+  {
+    for (size_t j = 0; j < 5; ++j)
+    {
+      // Every returned index must be valid, and the reported distance must be
+      // the true distance to that reference point.
+      REQUIRE(neighbors(j, i) < referenceData.n_cols);
+      const double trueDistance = metric::EuclideanDistance::Evaluate(
+          queryData.col(i), referenceData.col(neighbors(j, i)));
+      REQUIRE(distances(j, i) == Approx(trueDistance).epsilon(1e-10));
+
+      // Results must be sorted by ascending distance.
+      if (j > 0)
+        REQUIRE(distances(j, i) >= distances(j - 1, i));
+
+      for (size_t l = 0; l < 5; ++l)
+        if (neighbors(j, i) == exactNeighbors(l, i))
+          ++found;
+    }
+  }
+
+  // The search is approximate, so we only require loose recall; with the
+  // default parameters the observed recall is far higher than this.
+  REQUIRE(found >= (size_t) (0.7 * 5 * queryData.n_cols));
+}
+
+/**
+ * Test that the monochromatic NSW graph search never returns the query point
+ * itself.
+ */
+TEST_CASE("KNNNSWGraphMonochromaticTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 500);
+
+  NSWGraph<NearestNeighborSort> graph;
+  arma::mat datasetCopy(dataset);
+  graph.Train(std::move(datasetCopy));
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  graph.Search(3, neighbors, distances);
+
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    for (size_t j = 0; j < 3; ++j)
+    {
+      REQUIRE(neighbors(j, i) != i);
+      REQUIRE(neighbors(j, i) < dataset.n_cols);
+    }
+  }
+}
+
+/**
+ * Test that NSModel can build and search a navigable small-world graph.
+ */
+TEST_CASE("KNNModelNSWGraphTest", "[KNNTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(6, 800);
+  arma::mat queryData = arma::randu<arma::mat>(6, 50);
+
+  typedef NSModel<NearestNeighborSort> KNNModel;
+  KNNModel model(KNNModel::TreeTypes::NSW_GRAPH, false);
+  model.EfSearch() = 128;
+  arma::mat referenceCopy(referenceData);
+  model.BuildModel(std::move(referenceCopy), 20, SINGLE_TREE_MODE, 0.0);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  arma::mat queryCopy(queryData);
+  model.Search(std::move(queryCopy), 3, neighbors, distances);
+
+  REQUIRE(neighbors.n_rows == 3);
+  REQUIRE(neighbors.n_cols == queryData.n_cols);
+  for (size_t i = 0; i < queryData.n_cols; ++i)
+  {
+    for (size_t j = 0; j < 3; ++j)
+    {
+      REQUIRE(neighbors(j, i) < referenceData.n_cols);
+      const double trueDistance = metric::EuclideanDistance::Evaluate(
+          queryData.col(i), referenceData.col(neighbors(j, i)));
+      REQUIRE(distances(j, i) == Approx(trueDistance).epsilon(1e-10));
+    }
+  }
+}
+
+/**
+ * Test that the product-quantization index returns correctly ordered, valid
+ * results with reasonable recall against a brute-force search.
+ */
+TEST_CASE("KNNPQIndexSearchTest", "[KNNTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(8, 1000);
+  arma::mat queryData = arma::randu<arma::mat>(8, 100);
+
+  // Exact results, for computing recall.
+  KNN naive(referenceData, NAIVE_MODE);
+  arma::Mat<size_t> exactNeighbors;
+  arma::mat exactDistances;
+  naive.Search(queryData, 5, exactNeighbors, exactDistances);
+
+  PQIndex<NearestNeighborSort> index;
+  index.NumProbes() = 16;
+  arma::mat referenceCopy(referenceData);
+  index.Train(std::move(referenceCopy));
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  index.Search(queryData, 5, neighbors, distances);
+
+  REQUIRE(neighbors.n_rows == 5);
+  REQUIRE(neighbors.n_cols == queryData.n_cols);
+
+  size_t found = 0;
+  for (size_t i = 0; i < queryData.n_cols; ++i)
+  {
+    for (size_t j = 0; j < 5; ++j)
+    {
+      // Every returned index must be valid, and the results must be sorted
+      // by ascending (approximate) distance.  The distances are computed
+      // from the codes, so they are not the exact distances.
+      REQUIRE(neighbors(j, i) < referenceData.n_cols);
+      if (j > 0)
+        REQUIRE(distances(j, i) >= distances(j - 1, i));
+
+      for (size_t l = 0; l < 5; ++l)
+        if (neighbors(j, i) == exactNeighbors(l, i))
+          ++found;
+    }
+  }
+
+  // The search is approximate, so we only require loose recall; with these
+  // parameters the observed recall is far higher than this.
+  REQUIRE(found >= (size_t) (0.5 * 5 * queryData.n_cols));
+}
+
+/**
+ * Test that the monochromatic product-quantization search never returns the
+ * query point itself, and that adding points to a built index gives them
+ * valid, searchable codes.
+ */
+TEST_CASE("KNNPQIndexMonochromaticAddTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(8, 500);
+
+  PQIndex<NearestNeighborSort> index;
+  arma::mat datasetCopy(dataset);
+  index.Train(std::move(datasetCopy));
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  index.Search(3, neighbors, distances);
+
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    for (size_t j = 0; j < 3; ++j)
+    {
+      REQUIRE(neighbors(j, i) != i);
+      REQUIRE(neighbors(j, i) < dataset.n_cols);
+    }
+  }
+
+  // Appended points must be encoded and become searchable; searching for a
+  // duplicate of an added point must return its index.
+  arma::mat addedPoints = arma::randu<arma::mat>(8, 20);
+  index.AddPoints(addedPoints);
+  REQUIRE(index.ReferenceSet().n_cols == 520);
+
+  arma::mat querySet = addedPoints.cols(0, 4);
+  index.Search(querySet, 1, neighbors, distances);
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+    REQUIRE(neighbors(0, i) == 500 + i);
+}
+
+/**
+ * Make sure that opt-in traversal statistics are collected during a search
+ * and that the per-query aggregates are consistent with the totals.
+ */
+TEST_CASE("KNNTraversalStatisticsTest", "[KNNTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(5, 500);
+  arma::mat queryData = arma::randu<arma::mat>(5, 100);
+
+  KNN knn(referenceData, DUAL_TREE_MODE);
+
+  // Nothing should be collected unless statistics collection is enabled.
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(queryData, 3, neighbors, distances);
+  REQUIRE(knn.Stats().BaseCases() == 0);
+  REQUIRE(knn.Stats().Scores() == 0);
+
+  knn.CollectStatistics() = true;
+  knn.Search(queryData, 3, neighbors, distances);
+
+  // The statistics should agree with the coarse counters, and every query
+  // point must have been involved in at least k base cases and insertions.
+  REQUIRE(knn.Stats().BaseCases() == knn.BaseCases());
+  REQUIRE(knn.Stats().Scores() == knn.Scores());
+  REQUIRE(knn.Stats().Prunes() > 0);
+  REQUIRE(knn.Stats().Insertions() >= 3 * queryData.n_cols);
+  REQUIRE(knn.Stats().PerQueryBaseCases().n_elem == queryData.n_cols);
+  REQUIRE(arma::accu(knn.Stats().PerQueryBaseCases()) ==
+      knn.Stats().BaseCases());
+  REQUIRE(arma::accu(knn.Stats().PerQueryInsertions()) ==
+      knn.Stats().Insertions());
+  for (size_t i = 0; i < queryData.n_cols; ++i)
+    REQUIRE(knn.Stats().PerQueryInsertions()[i] >= 3);
+
+  // Statistics must be reset between searches, not accumulated.
+  const size_t lastBaseCases = knn.Stats().BaseCases();
+  knn.Search(queryData, 3, neighbors, distances);
+  REQUIRE(knn.Stats().BaseCases() == lastBaseCases);
+}
+
+/**
+ * Ensure that NSModel can be instantiated for single-precision data and that
+ * the results agree with a double-precision search on the same data.
+ */
+TEST_CASE("KNNModelFloatTest", "[KNNTest]")
+{
+  typedef NSModel<NearestNeighborSort, arma::fmat> KNNFloatModel;
+
+  arma::mat referenceData = arma::randu<arma::mat>(10, 200);
+  arma::mat queryData = arma::randu<arma::mat>(10, 50);
+
+  // Get a double-precision baseline.
+  KNN knn(referenceData);
+  arma::Mat<size_t> baselineNeighbors;
+  arma::mat baselineDistances;
+  knn.Search(queryData, 3, baselineNeighbors, baselineDistances);
+
+  arma::fmat floatReference = arma::conv_to<arma::fmat>::from(referenceData);
+  arma::fmat floatQuery = arma::conv_to<arma::fmat>::from(queryData);
+
+  KNNFloatModel model(KNNFloatModel::TreeTypes::KD_TREE, false);
+  model.BuildModel(std::move(floatReference), 20, DUAL_TREE_MODE);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  model.Search(std::move(floatQuery), 3, neighbors, distances);
+
+  REQUIRE(neighbors.n_rows == baselineNeighbors.n_rows);
+  REQUIRE(neighbors.n_cols == baselineNeighbors.n_cols);
+  for (size_t i = 0; i < distances.n_elem; ++i)
+  {
+    // Use a loose tolerance, since the search was done in single precision.
+    REQUIRE(neighbors[i] == baselineNeighbors[i]);
+    REQUIRE(distances[i] == Approx(baselineDistances[i]).epsilon(1e-4));
+  }
+}
+
+/**
+ * Test that TuneLeafSize() picks a leaf size from the candidate list and that
+ * searching with the tuned leaf size gives correct results.
+ */
+TEST_CASE("KNNTuneLeafSizeTest", "[KNNTest]")
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(5, 800);
+  arma::mat historicalQueries = arma::randu<arma::mat>(5, 300);
+
+  std::vector<size_t> candidates;
+  candidates.push_back(1);
+  candidates.push_back(20);
+  candidates.push_back(100);
+
+  const size_t tuned = TuneLeafSize<KNN>(referenceSet, historicalQueries, 5,
+      candidates, 50);
+
+  // The result must be one of the candidates.
+  bool found = false;
+  for (size_t i = 0; i < candidates.size(); ++i)
+    if (candidates[i] == tuned)
+      found = true;
+  REQUIRE(found);
+
+  // A tree built with the tuned leaf size must give exact results.
+  KNN::Tree tree(referenceSet, tuned);
+  KNN tunedKnn(std::move(tree));
+  KNN naive(referenceSet, NAIVE_MODE);
+
+  arma::mat queries = arma::randu<arma::mat>(5, 100);
+  arma::Mat<size_t> neighbors, naiveNeighbors;
+  arma::mat distances, naiveDistances;
+  tunedKnn.Search(queries, 5, neighbors, distances);
+  naive.Search(queries, 5, naiveNeighbors, naiveDistances);
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(neighbors[i] == naiveNeighbors[i]);
+    REQUIRE(distances[i] == Approx(naiveDistances[i]).epsilon(1e-7));
+  }
+
+  // An empty candidate list must be rejected.
+  REQUIRE_THROWS_AS(TuneLeafSize<KNN>(referenceSet, historicalQueries, 5,
+      std::vector<size_t>(), 50), std::invalid_argument);
+}
+
+/**
+ * Test that the fused single-tree traversal gives exactly the same results as
+ * the per-query single-tree traversal, in both the bichromatic and
+ * monochromatic cases.
+ */
+TEST_CASE("KNNFusedSingleTreeTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(6, 700);
+  arma::mat querySet = arma::randu<arma::mat>(6, 32);
+
+  KNN knn(dataset, SINGLE_TREE_MODE);
+  KNN fused(dataset, SINGLE_TREE_MODE);
+  fused.FusedSingleTree() = true;
+
+  // Bichromatic case: a small block of queries.
+  arma::Mat<size_t> neighbors, fusedNeighbors;
+  arma::mat distances, fusedDistances;
+  knn.Search(querySet, 7, neighbors, distances);
+  fused.Search(querySet, 7, fusedNeighbors, fusedDistances);
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(neighbors[i] == fusedNeighbors[i]);
+    REQUIRE(distances[i] == Approx(fusedDistances[i]).epsilon(1e-10));
+  }
+
+  // Monochromatic case.
+  knn.Search(7, neighbors, distances);
+  fused.Search(7, fusedNeighbors, fusedDistances);
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(neighbors[i] == fusedNeighbors[i]);
+    REQUIRE(distances[i] == Approx(fusedDistances[i]).epsilon(1e-10));
+  }
+}
+
+/**
+ * Test that repeated monochromatic dual-tree searches give correct results.
+ * Bounds cached in the tree by one search are invalidated lazily (by epoch)
+ * instead of by a full-tree reset pass, so stale bounds from earlier searches
+ * must never leak into later ones.
+ */
+TEST_CASE("KNNRepeatedSearchEpochTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 400);
+
+  KNN knn(dataset, DUAL_TREE_MODE);
+  KNN naive(dataset, NAIVE_MODE);
+
+  arma::Mat<size_t> naiveNeighbors;
+  arma::mat naiveDistances;
+  naive.Search(4, naiveNeighbors, naiveDistances);
+
+  // Search several times in a row; every pass must match the naive results.
+  for (size_t trial = 0; trial < 3; ++trial)
+  {
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    knn.Search(4, neighbors, distances);
+
+    for (size_t i = 0; i < neighbors.n_elem; ++i)
+    {
+      REQUIRE(neighbors[i] == naiveNeighbors[i]);
+      REQUIRE(distances[i] == Approx(naiveDistances[i]).epsilon(1e-10));
+    }
+  }
+
+  // A bichromatic search in between must not disturb later monochromatic
+  // searches either.
+  arma::mat querySet = arma::randu<arma::mat>(5, 50);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(querySet, 4, neighbors, distances);
+
+  knn.Search(4, neighbors, distances);
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(neighbors[i] == naiveNeighbors[i]);
+    REQUIRE(distances[i] == Approx(naiveDistances[i]).epsilon(1e-10));
+  }
+}
+
+/**
+ * Test tree-based search against the naive method on high-dimensional data,
+ * where the early-abandoning base case rejects most candidates after a
+ * fraction of the dimensions.  Errors are produced if the results are not
+ * identical.
+ */
+TEST_CASE("KNNEarlyAbandonHighDimensionTest", "[KNNTest]")
+{
+  // In high dimensions the trees prune little, so almost every candidate
+  // goes through the early-abandoning base case.
+  arma::mat dataset = arma::randu<arma::mat>(100, 500);
+  arma::mat queries = arma::randu<arma::mat>(100, 200);
+
+  KNN knn(dataset);
+  KNN naive(dataset, NAIVE_MODE);
+
+  arma::Mat<size_t> neighborsTree, neighborsNaive;
+  arma::mat distancesTree, distancesNaive;
+  knn.Search(queries, 5, neighborsTree, distancesTree);
+  naive.Search(queries, 5, neighborsNaive, distancesNaive);
+
+  for (size_t i = 0; i < neighborsTree.n_elem; ++i)
+  {
+    REQUIRE(neighborsTree(i) == neighborsNaive(i));
+    REQUIRE(distancesTree(i) == Approx(distancesNaive(i)).epsilon(1e-7));
+  }
+
+  // The single-tree traverser drives the same base case; it must agree too.
+  KNN single(dataset, SINGLE_TREE_MODE);
+  arma::Mat<size_t> neighborsSingle;
+  arma::mat distancesSingle;
+  single.Search(queries, 5, neighborsSingle, distancesSingle);
+
+  for (size_t i = 0; i < neighborsSingle.n_elem; ++i)
+  {
+    REQUIRE(neighborsSingle(i) == neighborsNaive(i));
+    REQUIRE(distancesSingle(i) == Approx(distancesNaive(i)).epsilon(1e-7));
+  }
+}
@@ -459,3 +459,74 @@ TEST_CASE("LARSCopyConstructorTest", "[LARSTest]")
   // The output of both models should be the same.
   CheckMatrices(predictions, predictionsFromCopiedModel);
 }
+
+/**
+ * Warm-started training on a sequence of related responses must give the same
+ * solutions as training each problem from scratch: the cached Cholesky state
+ * only replaces factor updates that would have produced identical values.
+ */
+TEST_CASE("LARSWarmStartTest", "[LARSTest]")
+{
+  const size_t nDims = 25;
+  const size_t nPoints = 100;
+
+  arma::mat X;
+  arma::rowvec y;
+  GenerateProblem(X, y, nPoints, nDims);
+
+  LARS warm(true, 0.1);
+  warm.WarmStart() = true;
+
+  for (size_t trial = 0; trial < 10; ++trial)
+  {
+    // Perturb the response so that successive problems are related but not
+    // identical; related responses share activation order prefixes, which is
+    // what the warm start exploits.
+    y += 0.1 * arma::randn(1, nPoints);
+
+    arma::vec warmBeta, coldBeta;
+    warm.Train(X, y, warmBeta);
+
+    LARS cold(true, 0.1);
+    cold.Train(X, y, coldBeta);
+
+    REQUIRE(warmBeta.n_elem == coldBeta.n_elem);
+    for (size_t i = 0; i < coldBeta.n_elem; ++i)
+      REQUIRE(warmBeta[i] == Approx(coldBeta[i]).margin(1e-12));
+  }
+}
+
+/**
+ * Warm starting must also be exact for the elastic net with a precomputed
+ * Gram matrix, the pattern used by SparseCoding::Encode().
+ */
+TEST_CASE("LARSWarmStartGramTest", "[LARSTest]")
+{
+  const size_t nDims = 25;
+  const size_t nPoints = 100;
+
+  arma::mat X;
+  arma::rowvec y;
+  GenerateProblem(X, y, nPoints, nDims);
+
+  // Train() will transpose X, so the Gram matrix is X * X^T.
+  arma::mat matGram = X * trans(X);
+
+  LARS warm(true, matGram, 0.1, 0.2);
+  warm.WarmStart() = true;
+
+  for (size_t trial = 0; trial < 10; ++trial)
+  {
+    y += 0.1 * arma::randn(1, nPoints);
+
+    arma::vec warmBeta, coldBeta;
+    warm.Train(X, y, warmBeta);
+
+    LARS cold(true, matGram, 0.1, 0.2);
+    cold.Train(X, y, coldBeta);
+
+    REQUIRE(warmBeta.n_elem == coldBeta.n_elem);
+    for (size_t i = 0; i < coldBeta.n_elem; ++i)
+      REQUIRE(warmBeta[i] == Approx(coldBeta[i]).margin(1e-12));
+  }
+}
@@ -265,3 +265,50 @@ TEST_CASE("TestSymKronId", "[LinAlgTest]")
       REQUIRE(lhs(j) == Approx(rhs(j)).epsilon(1e-7));
   }
 }
+
+/**
+ * Test that the fused one-pass ColumnCovariance() matches the covariance
+ * computed from an explicitly centered copy of the matrix.
+ */
+TEST_CASE("ColumnCovarianceFusedTest", "[LinAlgTest]")
+{
+  const mat x = randu<mat>(10, 500);
+  const mat centered = x.each_col() - arma::mean(x, 1);
+
+  for (size_t normType = 0; normType <= 1; ++normType)
+  {
+    const mat reference = (centered * centered.t()) /
+        ((normType == 0) ? (x.n_cols - 1) : x.n_cols);
+    const mat fused = ColumnCovariance(x, normType);
+
+    REQUIRE(fused.n_rows == reference.n_rows);
+    REQUIRE(fused.n_cols == reference.n_cols);
+    REQUIRE(abs(fused - reference).max() == Approx(0.0).margin(1e-10));
+  }
+}
+
+/**
+ * Test that accumulating a matrix batch by batch gives the same mean and
+ * covariance as ColumnCovariance() over the whole matrix.
+ */
+TEST_CASE("ColumnCovarianceAccumulatorTest", "[LinAlgTest]")
+{
+  const mat x = randu<mat>(8, 700);
+
+  ColumnCovarianceAccumulator<double> accumulator(x.n_rows);
+  accumulator.Accumulate(x.cols(0, 99));
+  accumulator.Accumulate(x.cols(100, 399));
+  accumulator.Accumulate(x.cols(400, 699));
+
+  REQUIRE(accumulator.Count() == x.n_cols);
+
+  const vec meanDiff = abs(accumulator.Mean() - arma::mean(x, 1));
+  REQUIRE(meanDiff.max() == Approx(0.0).margin(1e-10));
+
+  const mat covDiff = abs(accumulator.Covariance() - ColumnCovariance(x));
+  REQUIRE(covDiff.max() == Approx(0.0).margin(1e-10));
+
+  // Resetting discards everything accumulated so far.
+  accumulator.Reset(x.n_rows);
+  REQUIRE(accumulator.Count() == 0);
+}
@@ -266,3 +266,53 @@ TEST_CASE("LinearRegressionTrainReturnObjective", "[LinearRegressionTest]")
 
   REQUIRE(std::isfinite(error) == true);
 }
+
+/**
+ * Test that streaming (chunked) training gives the same parameters as batch
+ * training on the concatenated dataset.
+ */
+TEST_CASE("LinearRegressionTrainChunkTest", "[LinearRegressionTest]")
+{
+  arma::mat predictors(5, 300, arma::fill::randu);
+  arma::rowvec responses(300, arma::fill::randu);
+
+  // Train the batch model on all of the data at once.
+  LinearRegression batch(predictors, responses, 0.1);
+
+  // Train the streaming model on three chunks of 100 points each.
+  LinearRegression streaming;
+  streaming.Lambda() = 0.1;
+  streaming.StartTrainChunks(5);
+  streaming.TrainChunk(predictors.cols(0, 99), responses.subvec(0, 99));
+  streaming.TrainChunk(predictors.cols(100, 199), responses.subvec(100, 199));
+  streaming.TrainChunk(predictors.cols(200, 299), responses.subvec(200, 299));
+  streaming.FinishTrainChunks();
+
+  REQUIRE(streaming.Parameters().n_elem == batch.Parameters().n_elem);
+  for (size_t i = 0; i < batch.Parameters().n_elem; ++i)
+    REQUIRE(streaming.Parameters()[i] ==
+        Approx(batch.Parameters()[i]).epsilon(1e-7));
+}
+
+/**
+ * Test that streaming training works without an intercept term.
+ */
+TEST_CASE("LinearRegressionTrainChunkNoInterceptTest",
+          "[LinearRegressionTest]")
+{
+  arma::mat predictors(4, 200, arma::fill::randu);
+  arma::rowvec responses(200, arma::fill::randu);
+
+  LinearRegression batch(predictors, responses, 0.0, false);
+
+  LinearRegression streaming;
+  streaming.StartTrainChunks(4, false);
+  streaming.TrainChunk(predictors.cols(0, 149), responses.subvec(0, 149));
+  streaming.TrainChunk(predictors.cols(150, 199), responses.subvec(150, 199));
+  streaming.FinishTrainChunks();
+
+  REQUIRE(streaming.Intercept() == false);
+  for (size_t i = 0; i < batch.Parameters().n_elem; ++i)
+    REQUIRE(streaming.Parameters()[i] ==
+        Approx(batch.Parameters()[i]).epsilon(1e-7));
+}
@@ -525,6 +525,88 @@ TEST_CASE("LinearSVMGradientDescentSimpleTest", "[LinearSVMTest]")
   REQUIRE(acc == Approx(1.0).epsilon(0.005));
 }
 
+/**
+ * Test training of linear svm on a simple dataset using the dual coordinate
+ * descent solver.
+ */
+TEST_CASE("LinearSVMDCDSimpleTest", "[LinearSVMTest]")
+{
+  const size_t numClasses = 2;
+  const double lambda = 0.0001;
+
+  // A very simple fake dataset.
+  arma::mat dataset = "2 0 0;"
+                      "0 0 0;"
+                      "0 2 1;"
+                      "1 0 2;"
+                      "0 1 0";
+
+  // Corresponding labels.
+  arma::Row<size_t> labels = "1 0 1";
+
+  // Create a linear svm object and train with dual coordinate descent.
+  LinearSVM<arma::mat> lsvm(dataset.n_rows, numClasses, lambda);
+  lsvm.Train(dataset, labels, numClasses, DualCoordinateDescent());
+
+  // Compare training accuracy to 1.
+  const double acc = lsvm.ComputeAccuracy(dataset, labels);
+  REQUIRE(acc == Approx(1.0).epsilon(0.005));
+}
+
+/**
+ * Test training of linear svm for two classes on a complex gaussian dataset
+ * using the dual coordinate descent solver, with an intercept.
+ */
+TEST_CASE("LinearSVMDCDTwoClasses", "[LinearSVMTest]")
+{
+  const size_t points = 1000;
+  const size_t inputSize = 3;
+  const size_t numClasses = 2;
+  const double lambda = 0.5;
+
+  // Generate two-Gaussian dataset.
+  GaussianDistribution g1(arma::vec("1.0 9.0 1.0"), arma::eye<arma::mat>(3, 3));
+  GaussianDistribution g2(arma::vec("4.0 3.0 4.0"), arma::eye<arma::mat>(3, 3));
+
+  arma::mat data(inputSize, points);
+  arma::Row<size_t> labels(points);
+
+  for (size_t i = 0; i < points / 2; ++i)
+  {
+    data.col(i) = g1.Random();
+    labels(i) = 0;
+  }
+  for (size_t i = points / 2; i < points; ++i)
+  {
+    data.col(i) = g2.Random();
+    labels(i) = 1;
+  }
+
+  // Train with dual coordinate descent, fitting an intercept.
+  LinearSVM<arma::mat> lsvm(inputSize, numClasses, lambda, 1.0, true);
+  lsvm.Train(data, labels, numClasses, DualCoordinateDescent());
+
+  // Compare training accuracy to 1.
+  const double acc = lsvm.ComputeAccuracy(data, labels);
+  REQUIRE(acc == Approx(1.0).epsilon(0.01));
+
+  // Create test dataset.
+  for (size_t i = 0; i < points / 2; ++i)
+  {
+    data.col(i) = g1.Random();
+    labels(i) = 0;
+  }
+  for (size_t i = points / 2; i < points; ++i)
+  {
+    data.col(i) = g2.Random();
+    labels(i) = 1;
+  }
+
+  // Compare test accuracy to 1.
+  const double testAcc = lsvm.ComputeAccuracy(data, labels);
+  REQUIRE(testAcc == Approx(1.0).epsilon(0.01));
+}
+
 /**
  * Test training of linear svm for two classes on a complex gaussian dataset
  * using L-BFGS optimizer.
@@ -14,6 +14,8 @@
 #include <mlpack/core.hpp>
 #include <mlpack/core/data/load_arff.hpp>
 #include <mlpack/core/data/map_policies/missing_policy.hpp>
+#include <mlpack/core/data/mmap_load.hpp>
+#include <mlpack/core/data/chunked_reader.hpp>
 #include "catch.hpp"
 #include "test_catch_tools.hpp"
 
@@ -1348,6 +1350,65 @@ TEST_CASE("LoadJsonTest", "[LoadSaveTest]")
   REQUIRE(y.inb.s == x.inb.s);
 }
 
+/**
+ * Make sure an asynchronous matrix save produces the same file contents as a
+ * synchronous one.
+ */
+TEST_CASE("SaveAsyncCSVTest", "[LoadSaveTest]")
+{
+  arma::mat test = "1 5;"
+                   "2 6;"
+                   "3 7;"
+                   "4 8;";
+
+  std::future<bool> result = data::SaveAsync("test_async_file.csv", test);
+
+  // The matrix was snapshotted, so it can be modified right away without
+  // affecting the write.
+  test.zeros();
+
+  REQUIRE(result.get() == true);
+
+  // Load it in and make sure it is the same.
+  arma::mat test2;
+  REQUIRE(data::Load("test_async_file.csv", test2) == true);
+
+  REQUIRE(test2.n_rows == 4);
+  REQUIRE(test2.n_cols == 2);
+
+  for (size_t i = 0; i < 8; ++i)
+    REQUIRE(test2[i] == Approx((double) (i + 1)).epsilon(1e-7));
+
+  // Remove the file.
+  remove("test_async_file.csv");
+}
+
+/**
+ * Make sure an asynchronous model save can be loaded back.
+ */
+TEST_CASE("SaveAsyncModelTest", "[LoadSaveTest]")
+{
+  Test x(10, 12);
+
+  std::future<bool> result = data::SaveAsync("test_async.bin", "x", x);
+  REQUIRE(result.get() == true);
+
+  // Now reload.
+  Test y(11, 14);
+
+  REQUIRE(data::Load("test_async.bin", "x", y, false) == true);
+
+  REQUIRE(y.x == x.x);
+  REQUIRE(y.y == x.y);
+  REQUIRE(y.ina.c == x.ina.c);
+  REQUIRE(y.ina.s == x.ina.s);
+  REQUIRE(y.inb.c == x.inb.c);
+  REQUIRE(y.inb.s == x.inb.s);
+
+  // Remove the file.
+  remove("test_async.bin");
+}
+
 /**
  * Test DatasetInfo by making a map for a dimension.
  */
@@ -2466,3 +2527,287 @@ TEST_CASE("DatasetMapperNonUniqueTest", "[LoadSaveTest]")
   REQUIRE(dm.UnmapString(nan, 0, 1) == "goodbye");
   REQUIRE(dm.UnmapString(nan, 0, 2) == "cheese");
 }
+
+/**
+ * Make sure a frozen DatasetMapper gives the same lookups as the mutable maps
+ * and invalidates itself when a new mapping is added.
+ */
+TEST_CASE("DatasetMapperFreezeTest", "[LoadSaveTest]")
+{
+  DatasetInfo di(3);
+
+  const size_t first = di.MapString<size_t>("hello", 0);
+  const size_t second = di.MapString<size_t>("goodbye", 0);
+  const size_t third = di.MapString<size_t>("cheese", 2);
+
+  REQUIRE(!di.Frozen());
+  di.Freeze();
+  REQUIRE(di.Frozen());
+
+  // Already-mapped strings must resolve to the same values through the frozen
+  // index.
+  REQUIRE(di.MapString<size_t>("hello", 0) == first);
+  REQUIRE(di.MapString<size_t>("goodbye", 0) == second);
+  REQUIRE(di.MapString<size_t>("cheese", 2) == third);
+  REQUIRE(di.UnmapValue("hello", 0) == first);
+  REQUIRE(di.UnmapValue("goodbye", 0) == second);
+  REQUIRE(di.UnmapValue("cheese", 2) == third);
+
+  // Unknown strings must still throw, and unmapping must still work.
+  REQUIRE_THROWS_AS(di.UnmapValue("unknown", 0), std::invalid_argument);
+  REQUIRE(di.UnmapString(first, 0) == "hello");
+
+  // Mapping a numeric token in a numeric dimension adds no mapping, so the
+  // index must stay active.
+  REQUIRE(di.MapString<size_t>("5", 1) == 5);
+  REQUIRE(di.Frozen());
+
+  // Mapping a new string invalidates the frozen index but must still succeed.
+  const size_t fourth = di.MapString<size_t>("new_mapping", 0);
+  REQUIRE(!di.Frozen());
+  REQUIRE(fourth == 2);
+  REQUIRE(di.NumMappings(0) == 3);
+}
+
+/**
+ * Freeze a DatasetMapper with enough categories to force probe collisions in
+ * the frozen hash tables, and check every mapping.
+ */
+TEST_CASE("DatasetMapperFreezeManyCategoriesTest", "[LoadSaveTest]")
+{
+  DatasetInfo di(2);
+
+  std::vector<string> categories(1000);
+  for (size_t i = 0; i < categories.size(); ++i)
+  {
+    std::ostringstream oss;
+    oss << "category_" << i;
+    categories[i] = oss.str();
+    REQUIRE(di.MapString<size_t>(categories[i], 1) == i);
+  }
+
+  di.Freeze();
+
+  for (size_t i = 0; i < categories.size(); ++i)
+  {
+    REQUIRE(di.MapString<size_t>(categories[i], 1) == i);
+    REQUIRE(di.UnmapValue(categories[i], 1) == i);
+  }
+  REQUIRE(di.Frozen());
+}
+
+/**
+ * Make sure a deserialized DatasetMapper comes back frozen and with the same
+ * mappings.
+ */
+TEST_CASE("DatasetMapperFrozenSerializationTest", "[LoadSaveTest]")
+{
+  DatasetInfo di(4);
+  di.MapString<size_t>("hello", 1);
+  di.MapString<size_t>("goodbye", 1);
+  di.MapString<size_t>("cheese", 3);
+
+  REQUIRE(data::Save("info.bin", "info", di, false) == true);
+
+  DatasetInfo loaded;
+  REQUIRE(data::Load("info.bin", "info", loaded, false) == true);
+
+  // The frozen index is rebuilt automatically at load time.
+  REQUIRE(loaded.Frozen());
+  REQUIRE(loaded.Dimensionality() == 4);
+  REQUIRE(loaded.NumMappings(1) == 2);
+  REQUIRE(loaded.NumMappings(3) == 1);
+  REQUIRE(loaded.UnmapValue("hello", 1) == di.UnmapValue("hello", 1));
+  REQUIRE(loaded.UnmapValue("goodbye", 1) == di.UnmapValue("goodbye", 1));
+  REQUIRE(loaded.UnmapValue("cheese", 3) == di.UnmapValue("cheese", 3));
+  REQUIRE(loaded.UnmapString(size_t(0), 1) == di.UnmapString(size_t(0), 1));
+  REQUIRE_THROWS_AS(loaded.UnmapValue("hello", 3), std::invalid_argument);
+
+  remove("info.bin");
+}
+
+/**
+ * Test that a matrix saved in the binary container format can be loaded back
+ * through the mmap-backed zero-copy path.
+ */
+TEST_CASE("MmapLoadRoundTripTest", "[LoadSaveTest]")
+{
+  arma::mat test = arma::randu<arma::mat>(10, 50);
+
+  REQUIRE(data::SaveBinary(test, "test_file.bin") == true);
+
+  data::MappedMatrix<double> mapped;
+  REQUIRE(mapped.Load("test_file.bin") == true);
+
+  REQUIRE(mapped.Matrix().n_rows == test.n_rows);
+  REQUIRE(mapped.Matrix().n_cols == test.n_cols);
+  for (size_t i = 0; i < test.n_elem; ++i)
+    REQUIRE(mapped.Matrix()[i] == Approx(test[i]).epsilon(1e-12));
+
+  // The mapping is copy-on-write, so modifying the matrix must not change the
+  // file.
+  mapped.Matrix()(0, 0) = -1.0;
+  data::MappedMatrix<double> remapped;
+  REQUIRE(remapped.Load("test_file.bin") == true);
+  REQUIRE(remapped.Matrix()(0, 0) == Approx(test(0, 0)).epsilon(1e-12));
+
+  remove("test_file.bin");
+}
+
+/**
+ * Test that loading a binary container with the wrong element type fails
+ * cleanly.
+ */
+TEST_CASE("MmapLoadTypeMismatchTest", "[LoadSaveTest]")
+{
+  arma::fmat test = arma::randu<arma::fmat>(5, 5);
+  REQUIRE(data::SaveBinary(test, "test_file.bin") == true);
+
+  data::MappedMatrix<double> mapped;
+  REQUIRE(mapped.Load("test_file.bin") == false);
+
+  remove("test_file.bin");
+}
+
+/**
+ * Test that the parallel numeric CSV fast path parses a file identically to
+ * the standard loader, and rejects files with non-numeric fields.
+ */
+TEST_CASE("ParallelCSVParseTest", "[LoadSaveTest]")
+{
+  std::ofstream f;
+  f.open("test_file.csv", std::fstream::out);
+  f << "1, 2, 3, 4" << std::endl;
+  f << "5, 6, 7, 8" << std::endl;
+  f << "9.5, 10.5, -11, 1e2" << std::endl;
+  f.close();
+
+  arma::mat fast;
+  REQUIRE(data::ParallelCSVParse("test_file.csv", fast, ',', true) == true);
+
+  arma::mat standard;
+  REQUIRE(data::Load("test_file.csv", standard) == true);
+
+  REQUIRE(fast.n_rows == standard.n_rows);
+  REQUIRE(fast.n_cols == standard.n_cols);
+  for (size_t i = 0; i < standard.n_elem; ++i)
+    REQUIRE(fast[i] == Approx(standard[i]).epsilon(1e-12));
+
+  // A file with a non-numeric field must be rejected so the caller can fall
+  // back to the DatasetMapper-aware loader.
+  f.open("test_file.csv", std::fstream::out);
+  f << "1, 2, hello" << std::endl;
+  f << "3, 4, goodbye" << std::endl;
+  f.close();
+
+  arma::mat rejected;
+  REQUIRE(data::ParallelCSVParse("test_file.csv", rejected, ',', true)
+      == false);
+  REQUIRE(rejected.n_elem == 0);
+
+  remove("test_file.csv");
+}
+
+/**
+ * Test that the ChunkedReader yields the whole CSV file in fixed-size chunks
+ * with consistent categorical mappings across the chunks.
+ */
+TEST_CASE("ChunkedReaderCSVTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test.csv", fstream::out);
+  f << "1, 2, hello" << endl;
+  f << "3, 4, goodbye" << endl;
+  f << "5, 6, coffee" << endl;
+  f << "7, 8, confusion" << endl;
+  f << "9, 10, hello" << endl;
+  f << "11, 12, confusion" << endl;
+  f << "13, 14, confusion" << endl;
+  f.close();
+
+  data::ChunkedReader reader("test.csv", 3);
+  REQUIRE(reader.Dimensionality() == 3);
+
+  // Assemble the chunks; they must arrive as 3, 3 and 1 points.
+  arma::mat dataset(3, 0), chunk;
+  REQUIRE(reader.ReadChunk(chunk) == 3);
+  dataset = arma::join_rows(dataset, chunk);
+  REQUIRE(reader.ReadChunk(chunk) == 3);
+  dataset = arma::join_rows(dataset, chunk);
+  REQUIRE(reader.ReadChunk(chunk) == 1);
+  dataset = arma::join_rows(dataset, chunk);
+  REQUIRE(reader.ReadChunk(chunk) == 0);
+
+  // The result must match a whole-matrix load, including the mappings.
+  arma::mat expected;
+  DatasetInfo info;
+  data::Load("test.csv", expected, info);
+
+  CheckMatrices(dataset, expected);
+  REQUIRE(reader.Info().Type(2) == Datatype::categorical);
+  REQUIRE(reader.Info().NumMappings(2) == info.NumMappings(2));
+  for (size_t i = 0; i < info.NumMappings(2); ++i)
+  {
+    REQUIRE(reader.Info().UnmapString(i, 2) == info.UnmapString(i, 2));
+  }
+
+  // A second pass after Reset() must reuse the existing mappings.
+  reader.Reset();
+  REQUIRE(reader.ReadChunk(chunk) == 3);
+  CheckMatrices(arma::mat(chunk), arma::mat(dataset.cols(0, 2)));
+  REQUIRE(reader.Info().NumMappings(2) == info.NumMappings(2));
+
+  remove("test.csv");
+}
+
+/**
+ * Test that the ChunkedReader parses an ARFF header and maps the declared
+ * nominal values in declaration order before any data is read.
+ */
+TEST_CASE("ChunkedReaderARFFTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test.arff", fstream::out);
+  f << "@relation test" << endl;
+  f << endl;
+  f << "@attribute one NUMERIC" << endl;
+  f << "@attribute two {moo, goodbye, hello}" << endl;
+  f << "% a comment line" << endl;
+  f << "@data" << endl;
+  f << "1, hello" << endl;
+  f << "2, goodbye" << endl;
+  f << "% another comment" << endl;
+  f << "3, moo" << endl;
+  f << "4, hello" << endl;
+  f << "5, moo" << endl;
+  f.close();
+
+  data::ChunkedReader reader("test.arff", 2);
+  REQUIRE(reader.Dimensionality() == 2);
+  REQUIRE(reader.Info().Type(0) == Datatype::numeric);
+  REQUIRE(reader.Info().Type(1) == Datatype::categorical);
+
+  // The nominal values are mapped in declaration order up front.
+  REQUIRE(reader.Info().NumMappings(1) == 3);
+  REQUIRE(reader.Info().UnmapString(0, 1) == "moo");
+  REQUIRE(reader.Info().UnmapString(1, 1) == "goodbye");
+  REQUIRE(reader.Info().UnmapString(2, 1) == "hello");
+
+  arma::mat chunk;
+  REQUIRE(reader.ReadChunk(chunk) == 2);
+  REQUIRE(chunk(0, 0) == Approx(1.0));
+  REQUIRE(chunk(1, 0) == Approx(2.0)); // "hello"
+  REQUIRE(chunk(1, 1) == Approx(1.0)); // "goodbye"
+
+  REQUIRE(reader.ReadChunk(chunk) == 2);
+  REQUIRE(chunk(1, 0) == Approx(0.0)); // "moo"
+  REQUIRE(chunk(1, 1) == Approx(2.0)); // "hello"
+
+  REQUIRE(reader.ReadChunk(chunk) == 1);
+  REQUIRE(chunk(0, 0) == Approx(5.0));
+  REQUIRE(chunk(1, 0) == Approx(0.0)); // "moo"
+
+  REQUIRE(reader.ReadChunk(chunk) == 0);
+
+  remove("test.arff");
+}
@@ -1081,3 +1081,94 @@ TEST_CASE("IncrementalTraining", "[LogisticRegressionTest]")
 
   REQUIRE(acc == Approx(100.0).epsilon(0.03)); // 3% error tolerance.
 }
+
+/**
+ * Test that streaming mini-batch training over chunks of a two-Gaussian
+ * dataset reaches a good fit.
+ */
+TEST_CASE("LogisticRegressionTrainChunkGaussianTest",
+          "[LogisticRegressionTest]")
+{
+  // Generate a two-Gaussian dataset with the classes interleaved, so that
+  // every chunk contains points of both classes.
+  GaussianDistribution g1(arma::vec("1.0 1.0 1.0"), arma::eye<arma::mat>(3, 3));
+  GaussianDistribution g2(arma::vec("9.0 9.0 9.0"), arma::eye<arma::mat>(3, 3));
+
+  arma::mat data(3, 1000);
+  arma::Row<size_t> responses(1000);
+  for (size_t i = 0; i < 1000; i += 2)
+  {
+    data.col(i) = g1.Random();
+    responses[i] = 0;
+    data.col(i + 1) = g2.Random();
+    responses[i + 1] = 1;
+  }
+
+  // Train on four chunks of 250 points each, making several passes over the
+  // chunks; each chunk is one epoch of mini-batch SGD warm-started from the
+  // current parameters.
+  LogisticRegression<> lr(data.n_rows, 0.5);
+  for (size_t pass = 0; pass < 20; ++pass)
+  {
+    for (size_t chunk = 0; chunk < 4; ++chunk)
+    {
+      lr.TrainChunk(data.cols(250 * chunk, 250 * chunk + 249),
+          responses.subvec(250 * chunk, 250 * chunk + 249));
+    }
+  }
+
+  // Ensure that the error is close to zero.
+  const double acc = lr.ComputeAccuracy(data, responses);
+
+  REQUIRE(acc == Approx(100.0).epsilon(0.003)); // 0.3% error tolerance.
+}
+
+/**
+ * Test that the sparse specializations of the batched objective and gradient
+ * computations give the same results as the dense implementations.
+ */
+TEST_CASE("LogisticRegressionSparseBatchGradientTest",
+          "[LogisticRegressionTest]")
+{
+  // Create a random sparse dataset and a dense copy of it.
+  arma::sp_mat dataset;
+  dataset.sprandu(25, 500, 0.1);
+  arma::mat denseDataset(dataset);
+  arma::Row<size_t> labels(500);
+  for (size_t i = 0; i < 500; ++i)
+    labels[i] = math::RandInt(0, 2);
+
+  LogisticRegressionFunction<> lrf(denseDataset, labels, 0.5);
+  LogisticRegressionFunction<arma::sp_mat> lrfSparse(dataset, labels, 0.5);
+
+  const arma::mat parameters = arma::randn<arma::mat>(1, 26);
+
+  // Compare several batches, including a batch of size one.
+  const size_t begins[] = { 0, 37, 250, 499 };
+  const size_t batchSizes[] = { 100, 32, 250, 1 };
+  for (size_t trial = 0; trial < 4; ++trial)
+  {
+    const size_t begin = begins[trial];
+    const size_t batchSize = batchSizes[trial];
+
+    REQUIRE(lrfSparse.Evaluate(parameters, begin, batchSize) ==
+        Approx(lrf.Evaluate(parameters, begin, batchSize)).epsilon(1e-10));
+
+    arma::mat gradient, sparseGradient;
+    lrf.Gradient(parameters, begin, gradient, batchSize);
+    lrfSparse.Gradient(parameters, begin, sparseGradient, batchSize);
+
+    REQUIRE(sparseGradient.n_elem == gradient.n_elem);
+    for (size_t i = 0; i < gradient.n_elem; ++i)
+      REQUIRE(sparseGradient[i] == Approx(gradient[i]).margin(1e-10));
+
+    const double objective = lrf.EvaluateWithGradient(parameters, begin,
+        gradient, batchSize);
+    const double sparseObjective = lrfSparse.EvaluateWithGradient(parameters,
+        begin, sparseGradient, batchSize);
+
+    REQUIRE(sparseObjective == Approx(objective).epsilon(1e-10));
+    for (size_t i = 0; i < gradient.n_elem; ++i)
+      REQUIRE(sparseGradient[i] == Approx(gradient[i]).margin(1e-10));
+  }
+}
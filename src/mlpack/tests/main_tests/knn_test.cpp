@@ -663,6 +663,65 @@ TEST_CASE_METHOD(KNNTestFixture, "KNNAllTreeTypesTest",
   }
 }
 
+/*
+ * Ensure that sharded search gives the same results as a single tree.
+ */
+TEST_CASE_METHOD(KNNTestFixture, "KNNShardsTest",
+                 "[KNNMainTest][BindingTests]")
+{
+  arma::mat referenceData;
+  referenceData.randu(3, 400); // 400 points in 3 dimensions.
+
+  arma::mat queryData;
+  queryData.randu(3, 150); // 150 points in 3 dimensions.
+
+  // Keep some k <= number of reference points same over both runs.
+  SetInputParam("k", (int) 10);
+  SetInputParam("reference", referenceData);
+  SetInputParam("query", queryData);
+
+  mlpackMain();
+
+  arma::Mat<size_t> neighborsCompare =
+      std::move(IO::GetParam<arma::Mat<size_t>>("neighbors"));
+  arma::mat distancesCompare = std::move(IO::GetParam<arma::mat>("distances"));
+
+  delete IO::GetParam<KNNModel*>("output_model");
+  IO::GetParam<KNNModel*>("output_model") = NULL;
+
+  // Now the same search over four shards.
+  SetInputParam("reference", referenceData);
+  SetInputParam("query", queryData);
+  SetInputParam("shards", (int) 4);
+
+  mlpackMain();
+
+  arma::Mat<size_t> neighbors =
+      std::move(IO::GetParam<arma::Mat<size_t>>("neighbors"));
+  arma::mat distances = std::move(IO::GetParam<arma::mat>("distances"));
+
+  CheckMatrices(neighborsCompare, neighbors);
+  CheckMatrices(distancesCompare, distances);
+}
+
+/*
+ * Check that we can't specify a negative number of shards.
+ */
+TEST_CASE_METHOD(KNNTestFixture, "KNNInvalidShardsTest",
+                 "[KNNMainTest][BindingTests]")
+{
+  arma::mat referenceData;
+  referenceData.randu(3, 100); // 100 points in 3 dimensions.
+
+  SetInputParam("reference", std::move(referenceData));
+  SetInputParam("k", (int) 10);
+  SetInputParam("shards", (int) -1); // Invalid.
+
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(mlpackMain(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
+
 /**
   * Ensure that different leaf sizes give different results.
  */
@@ -115,3 +115,57 @@ TEST_CASE_METHOD(PCATestFixture, "PCATooHighNewDimensionalityTest",
   REQUIRE_THROWS_AS(mlpackMain(), std::runtime_error);
   Log::Fatal.ignoreInput = false;
 }
+
+/**
+ * Check that the block-processing path gives an output of the right shape and
+ * retains the requested dimensionality.
+ */
+TEST_CASE_METHOD(PCATestFixture, "PCABlockSizeTest",
+                 "[PCAMainTest][BindingTests]")
+{
+  arma::mat x = arma::randu<arma::mat>(5, 103);
+
+  SetInputParam("input", std::move(x));
+  SetInputParam("new_dimensionality", (int) 3);
+  SetInputParam("block_size", (int) 25); // 103 is not a multiple of 25.
+
+  mlpackMain();
+
+  REQUIRE(IO::GetParam<arma::mat>("output").n_rows == 3);
+  REQUIRE(IO::GetParam<arma::mat>("output").n_cols == 103);
+}
+
+/**
+ * Check that the block-processing path honors --var_to_retain.
+ */
+TEST_CASE_METHOD(PCATestFixture, "PCABlockSizeVarRetainTest",
+                 "[PCAMainTest][BindingTests]")
+{
+  arma::mat x = arma::randu<arma::mat>(5, 50);
+
+  SetInputParam("input", std::move(x));
+  SetInputParam("var_to_retain", (double) 1.0);
+  SetInputParam("block_size", (int) 10);
+
+  mlpackMain();
+
+  // All variance retained: all dimensions are kept.
+  REQUIRE(IO::GetParam<arma::mat>("output").n_rows == 5);
+  REQUIRE(IO::GetParam<arma::mat>("output").n_cols == 50);
+}
+
+/**
+ * Check that a negative block size is rejected.
+ */
+TEST_CASE_METHOD(PCATestFixture, "PCABadBlockSizeTest",
+                 "[PCAMainTest][BindingTests]")
+{
+  arma::mat x = arma::randu<arma::mat>(5, 5);
+
+  SetInputParam("input", std::move(x));
+  SetInputParam("block_size", (int) -1); // Invalid.
+
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(mlpackMain(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
@@ -10,7 +10,12 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include <mlpack/core/math/clamp.hpp>
+#include <mlpack/core/math/compensated_accumulator.hpp>
+#include <mlpack/core/math/log_add.hpp>
+#include <mlpack/core/math/pairwise_distances.hpp>
+#include <mlpack/core/math/quantile_sketch.hpp>
 #include <mlpack/core/math/random.hpp>
+#include <mlpack/core/math/random_stream.hpp>
 #include <mlpack/core/math/range.hpp>
 #include "catch.hpp"
 #include "test_catch_tools.hpp"
@@ -1006,3 +1011,397 @@ TEST_CASE("InplaceSparseShuffleWeightsTest", "[MathTest]")
     REQUIRE(weightCounts[i] == 1);
   }
 }
+
+/**
+ * Make sure the shuffled batch view delivers every point exactly once per
+ * epoch with its label, without copying the whole dataset.
+ */
+TEST_CASE("ShuffledBatchViewTest", "[MathTest]")
+{
+  arma::mat data(3, 10, arma::fill::zeros);
+  arma::Row<size_t> labels(10);
+  for (size_t i = 0; i < 10; ++i)
+  {
+    data(0, i) = i;
+    labels[i] = i;
+  }
+
+  // Batches of 4: the last batch only holds 2 points.
+  ShuffledBatchView<arma::mat, arma::Row<size_t>> view(data, labels, 4);
+  REQUIRE(view.NumBatches() == 3);
+
+  arma::mat batchData;
+  arma::Row<size_t> batchLabels;
+  for (size_t epoch = 0; epoch < 2; ++epoch)
+  {
+    arma::Row<size_t> counts(10, arma::fill::zeros);
+    for (size_t b = 0; b < view.NumBatches(); ++b)
+    {
+      view.Batch(b, batchData, batchLabels);
+      REQUIRE(batchData.n_rows == data.n_rows);
+      REQUIRE(batchData.n_cols == ((b == 2) ? 2 : 4));
+      REQUIRE(batchLabels.n_elem == batchData.n_cols);
+
+      for (size_t i = 0; i < batchData.n_cols; ++i)
+      {
+        REQUIRE((size_t) batchData(0, i) == batchLabels[i]);
+        counts[batchLabels[i]]++;
+      }
+    }
+
+    for (size_t i = 0; i < 10; ++i)
+      REQUIRE(counts[i] == 1);
+
+    view.Shuffle();
+  }
+}
+
+/**
+ * Make sure the shuffled batch view works on sparse data without rebuilding
+ * the whole sparse matrix.
+ */
+TEST_CASE("SparseShuffledBatchViewTest", "[MathTest]")
+{
+  arma::sp_mat data(3, 10);
+  arma::Row<size_t> labels(10);
+  for (size_t i = 0; i < 10; ++i)
+  {
+    data(0, i) = i;
+    labels[i] = i;
+  }
+
+  ShuffledBatchView<arma::sp_mat, arma::Row<size_t>> view(data, labels, 3);
+  REQUIRE(view.NumBatches() == 4);
+
+  arma::sp_mat batchData;
+  arma::Row<size_t> batchLabels;
+  arma::Row<size_t> counts(10, arma::fill::zeros);
+  for (size_t b = 0; b < view.NumBatches(); ++b)
+  {
+    view.Batch(b, batchData, batchLabels);
+    REQUIRE(batchData.n_rows == data.n_rows);
+    REQUIRE(batchLabels.n_elem == batchData.n_cols);
+
+    for (size_t i = 0; i < batchData.n_cols; ++i)
+    {
+      REQUIRE((size_t) batchData(0, i) == batchLabels[i]);
+      REQUIRE((double) batchData(1, i) == Approx(0.0).margin(1e-5));
+      REQUIRE((double) batchData(2, i) == Approx(0.0).margin(1e-5));
+      counts[batchLabels[i]]++;
+    }
+  }
+
+  for (size_t i = 0; i < 10; ++i)
+    REQUIRE(counts[i] == 1);
+}
+
+/**
+ * Verify that the vectorized log-sum-exp over columns agrees with AccuLog() on
+ * each column.
+ */
+TEST_CASE("LogSumExpColsTest", "[MathTest]")
+{
+  arma::mat x(25, 40, arma::fill::randn);
+  x *= 10.0; // Make sure the max-shift matters.
+
+  arma::vec y;
+  math::LogSumExpCols(x, y);
+
+  REQUIRE(y.n_elem == x.n_cols);
+  for (size_t i = 0; i < x.n_cols; ++i)
+    REQUIRE(y[i] == Approx(math::AccuLog(x.col(i))).epsilon(1e-10));
+}
+
+/**
+ * Verify that log-sum-exp handles columns of all -infinity values.
+ */
+TEST_CASE("LogSumExpColsInfTest", "[MathTest]")
+{
+  arma::mat x(10, 3, arma::fill::randn);
+  x.col(1).fill(-std::numeric_limits<double>::infinity());
+
+  arma::vec y;
+  math::LogSumExpCols(x, y);
+
+  REQUIRE(std::isfinite(y[0]));
+  REQUIRE(y[1] == -std::numeric_limits<double>::infinity());
+  REQUIRE(std::isfinite(y[2]));
+}
+
+/**
+ * Verify that the blocked pairwise inner product kernel agrees with direct
+ * computation, including when the block size does not divide the number of
+ * columns evenly.
+ */
+TEST_CASE("PairwiseInnerProductsTest", "[MathTest]")
+{
+  arma::mat a(8, 25, arma::fill::randn);
+  arma::mat b(8, 37, arma::fill::randn);
+
+  arma::mat products;
+  math::PairwiseInnerProducts(a, b, products, 10);
+
+  REQUIRE(products.n_rows == a.n_cols);
+  REQUIRE(products.n_cols == b.n_cols);
+  for (size_t j = 0; j < b.n_cols; ++j)
+    for (size_t i = 0; i < a.n_cols; ++i)
+      REQUIRE(products(i, j) ==
+          Approx(arma::dot(a.col(i), b.col(j))).epsilon(1e-10));
+}
+
+/**
+ * Verify that the blocked pairwise squared distance kernel agrees with direct
+ * computation and never produces negative values for identical points.
+ */
+TEST_CASE("PairwiseSquaredDistancesTest", "[MathTest]")
+{
+  arma::mat a(8, 25, arma::fill::randn);
+  arma::mat b(8, 37, arma::fill::randn);
+  b.col(5) = a.col(3); // Identical pair: distance must be exactly zero.
+
+  arma::mat distances;
+  math::PairwiseSquaredDistances(a, b, distances, 10);
+
+  REQUIRE(distances.n_rows == a.n_cols);
+  REQUIRE(distances.n_cols == b.n_cols);
+  for (size_t j = 0; j < b.n_cols; ++j)
+  {
+    for (size_t i = 0; i < a.n_cols; ++i)
+    {
+      const double direct =
+          std::pow(arma::norm(a.col(i) - b.col(j)), 2.0);
+      REQUIRE(distances(i, j) == Approx(direct).margin(1e-10));
+      REQUIRE(distances(i, j) >= 0.0);
+    }
+  }
+}
+
+/**
+ * The P^2 quantile sketch must reproduce small streams exactly and estimate
+ * quantiles of long streams closely.
+ */
+TEST_CASE("QuantileSketchTest", "[MathTest]")
+{
+  // Fewer than five observations: exact order statistics.
+  QuantileSketch small(0.5);
+  small.Insert(3.0);
+  small.Insert(1.0);
+  small.Insert(2.0);
+  REQUIRE(small.Count() == 3);
+  REQUIRE(small.Estimate() == Approx(2.0).epsilon(1e-10));
+
+  // A long uniform stream: the median must be close to 0.5 and the 0.9
+  // quantile close to 0.9.
+  QuantileSketch median(0.5);
+  QuantileSketch upper(0.9);
+  arma::vec values = arma::randu<arma::vec>(100000);
+  for (size_t i = 0; i < values.n_elem; ++i)
+  {
+    median.Insert(values[i]);
+    upper.Insert(values[i]);
+  }
+
+  REQUIRE(median.Count() == values.n_elem);
+  REQUIRE(median.Estimate() == Approx(0.5).margin(0.02));
+  REQUIRE(upper.Estimate() == Approx(0.9).margin(0.02));
+
+  // Invalid quantiles are rejected, and empty sketches cannot estimate.
+  REQUIRE_THROWS_AS(QuantileSketch(0.0), std::invalid_argument);
+  REQUIRE_THROWS_AS(QuantileSketch(1.0), std::invalid_argument);
+  REQUIRE_THROWS_AS(QuantileSketch(0.5).Estimate(), std::runtime_error);
+}
+
+/**
+ * Neumaier compensation must recover terms that plain summation drops
+ * entirely, including the case where a huge term is added and cancelled
+ * (which plain Kahan summation gets wrong).
+ */
+TEST_CASE("CompensatedAccumulatorCancellationTest", "[MathTest]")
+{
+  CompensatedAccumulator<> acc;
+  acc.Add(1.0);
+  acc.Add(1e100);
+  acc.Add(1.0);
+  acc.Add(-1e100);
+
+  // Plain summation would return 0; the compensated result is exact.
+  REQUIRE(acc.Value() == 2.0);
+
+  acc.Reset();
+  REQUIRE(acc.Value() == 0.0);
+}
+
+/**
+ * A long float32 reduction: plain summation of 1.0f stalls at 2^24 because
+ * adding 1 no longer changes the sum, while the compensated sum stays exact.
+ */
+TEST_CASE("CompensatedAccumulatorFloatTest", "[MathTest]")
+{
+  const size_t terms = 20000000;
+  CompensatedAccumulator<float> acc;
+  float naive = 0.0f;
+  for (size_t i = 0; i < terms; ++i)
+  {
+    acc.Add(1.0f);
+    naive += 1.0f;
+  }
+
+  REQUIRE(naive == 16777216.0f);
+  REQUIRE(acc.Value() == Approx((float) terms).epsilon(1e-6));
+}
+
+/**
+ * Element-wise compensated summation over a vector: tiny terms scattered
+ * into a large running element survive, and the whole-object adds of the
+ * compensated and direct policies agree on benign data.
+ */
+TEST_CASE("CompensatedSumTest", "[MathTest]")
+{
+  arma::vec target(3, arma::fill::zeros);
+  arma::vec naive(3, arma::fill::zeros);
+  CompensatedSum<arma::vec> acc(target);
+
+  acc.Add(1, 1.0);
+  naive(1) += 1.0;
+  for (size_t i = 0; i < 100000; ++i)
+  {
+    acc.Add(1, 1e-17);
+    naive(1) += 1e-17;
+  }
+  acc.Flush();
+
+  // Each tiny term is below the precision of the running sum, so plain
+  // summation drops all of them; the compensated sum keeps their total.
+  REQUIRE(naive(1) == 1.0);
+  REQUIRE(target(1) - 1.0 == Approx(1e-12).epsilon(1e-3));
+
+  // Untouched elements must remain zero.
+  REQUIRE(target(0) == 0.0);
+  REQUIRE(target(2) == 0.0);
+
+  // Whole-object adds of both policies must agree on benign data.
+  arma::vec a(5, arma::fill::zeros);
+  arma::vec b(5, arma::fill::zeros);
+  CompensatedSum<arma::vec> compSum(a);
+  DirectSum<arma::vec> directSum(b);
+  for (size_t i = 0; i < 50; ++i)
+  {
+    const arma::vec v(5, arma::fill::randu);
+    compSum.Add(v);
+    directSum.Add(v);
+  }
+  compSum.Flush();
+  directSum.Flush();
+  for (size_t i = 0; i < 5; ++i)
+    REQUIRE(a(i) == Approx(b(i)).epsilon(1e-12));
+}
+
+/**
+ * A random stream must be fully determined by the global seed and the stream
+ * id: equal ids reproduce the same sequence, different ids (and different
+ * seeds) give different sequences, and Seek() jumps to any position.
+ */
+TEST_CASE("RandomStreamReproducibilityTest", "[MathTest]")
+{
+  math::RandomSeed(42);
+
+  RandomStream a(17);
+  RandomStream b(17);
+  arma::Col<uint64_t> values(100);
+  for (size_t i = 0; i < 100; ++i)
+  {
+    values[i] = a();
+    REQUIRE(b() == values[i]);
+  }
+  REQUIRE(a.Position() == 100);
+
+  // A different stream id must give a different sequence.
+  RandomStream c(18);
+  size_t differing = 0;
+  for (size_t i = 0; i < 100; ++i)
+    differing += (c() != values[i]);
+  REQUIRE(differing > 0);
+
+  // Seek() must land exactly on the corresponding draw.
+  a.Seek(49);
+  REQUIRE(a() == values[49]);
+  a.Seek(0);
+  REQUIRE(a() == values[0]);
+
+  // The streams must follow the global seed.
+  math::RandomSeed(43);
+  RandomStream d(17);
+  REQUIRE(d() != values[0]);
+}
+
+/**
+ * Sanity-check the distributions of the stream's uniform, integer and normal
+ * draws.
+ */
+TEST_CASE("RandomStreamDistributionTest", "[MathTest]")
+{
+  RandomStream stream(3);
+
+  double uniformSum = 0.0;
+  for (size_t i = 0; i < 100000; ++i)
+  {
+    const double value = stream.Random();
+    REQUIRE(value >= 0.0);
+    REQUIRE(value < 1.0);
+    uniformSum += value;
+  }
+  REQUIRE(uniformSum / 100000 == Approx(0.5).epsilon(0.02));
+
+  // Every value of a small integer range must be hit.
+  arma::Col<size_t> counts(10, arma::fill::zeros);
+  for (size_t i = 0; i < 10000; ++i)
+  {
+    const int value = stream.RandInt(5, 15);
+    REQUIRE(value >= 5);
+    REQUIRE(value < 15);
+    counts[value - 5]++;
+  }
+  REQUIRE(counts.min() > 0);
+
+  double normalSum = 0.0, normalSumSq = 0.0;
+  for (size_t i = 0; i < 100000; ++i)
+  {
+    const double value = stream.RandNormal();
+    normalSum += value;
+    normalSumSq += value * value;
+  }
+  const double mean = normalSum / 100000;
+  REQUIRE(mean == Approx(0.0).margin(0.02));
+  REQUIRE(normalSumSq / 100000 - mean * mean == Approx(1.0).epsilon(0.05));
+}
+
+/**
+ * ShuffledOrder() must produce a valid permutation that is reproducible from
+ * a stream (or from the global seed, for the global overload).
+ */
+TEST_CASE("ShuffledOrderTest", "[MathTest]")
+{
+  RandomStream stream(11);
+  const arma::uvec order = ShuffledOrder(100, stream);
+  REQUIRE(order.n_elem == 100);
+
+  // Sorting the permutation must recover the identity.
+  const arma::uvec sorted = arma::sort(order);
+  for (size_t i = 0; i < 100; ++i)
+    REQUIRE(sorted[i] == i);
+
+  RandomStream sameStream(11);
+  const arma::uvec sameOrder = ShuffledOrder(100, sameStream);
+  for (size_t i = 0; i < 100; ++i)
+    REQUIRE(sameOrder[i] == order[i]);
+
+  // The global overload must follow the global seed.
+  math::RandomSeed(19);
+  const arma::uvec globalOrder = ShuffledOrder(100);
+  math::RandomSeed(19);
+  const arma::uvec repeatedOrder = ShuffledOrder(100);
+  for (size_t i = 0; i < 100; ++i)
+    REQUIRE(repeatedOrder[i] == globalOrder[i]);
+
+  REQUIRE(ShuffledOrder(0).n_elem == 0);
+}
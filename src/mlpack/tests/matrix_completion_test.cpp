@@ -11,6 +11,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/matrix_completion/matrix_completion.hpp>
+#include <mlpack/methods/matrix_completion/als_matrix_completion.hpp>
 
 #include "catch.hpp"
 
@@ -58,3 +59,56 @@ TEST_CASE("UniformMatrixCompletionSDP", "[MatrixCompletionTest]")
        Approx(Xorig(indices(0, i), indices(1, i))).epsilon(1e-7));
   }
 }
+
+/**
+ * A matrix completion test for the alternating least squares solver.
+ *
+ * A rank 3 matrix X = F1 F2^T is generated with the entries of Fi iid from
+ * the uniform distribution on [0, 1], and most of its entries are sampled
+ * without replacement.  The ALS solver only touches the observed entries, so
+ * recovery is approximate; we check that the completed matrix is close to X
+ * and that the observed entries are fit tightly.
+ */
+TEST_CASE("UniformMatrixCompletionALS", "[MatrixCompletionTest]")
+{
+  const size_t m = 60;
+  const size_t n = 50;
+  const size_t r = 3;
+
+  arma::mat f1 = arma::randu<arma::mat>(m, r);
+  arma::mat f2 = arma::randu<arma::mat>(n, r);
+  arma::mat Xorig = f1 * f2.t();
+
+  // Sample 80% of the entries without replacement.
+  const size_t p = (size_t) (0.8 * m * n);
+  arma::uvec sampled = arma::shuffle(
+      arma::linspace<arma::uvec>(0, m * n - 1, m * n)).subvec(0, p - 1);
+
+  arma::umat indices(2, p);
+  arma::vec values(p);
+  for (size_t i = 0; i < p; ++i)
+  {
+    indices(0, i) = sampled[i] % m;
+    indices(1, i) = sampled[i] / m;
+    values(i) = Xorig(indices(0, i), indices(1, i));
+  }
+
+  arma::mat recovered;
+  ALSMatrixCompletion mc(m, n, indices, values, r);
+  mc.Recover(recovered);
+
+  const double err =
+    arma::norm(Xorig - recovered, "fro") /
+    arma::norm(Xorig, "fro");
+  REQUIRE(err == Approx(0.0).margin(0.05));
+
+  // The observed entries have to be fit tightly.
+  double observedError = 0.0;
+  for (size_t i = 0; i < p; ++i)
+  {
+    const double residual = values(i) -
+        recovered(indices(0, i), indices(1, i));
+    observedError += residual * residual;
+  }
+  REQUIRE(std::sqrt(observedError / p) == Approx(0.0).margin(1e-3));
+}
@@ -14,6 +14,8 @@
 #include <mlpack/core/metrics/iou_metric.hpp>
 #include <mlpack/core/metrics/non_maximal_supression.hpp>
 #include <mlpack/core/metrics/bleu.hpp>
+#include <mlpack/core/metrics/quantized_euclidean_distance.hpp>
+#include <mlpack/core/data/quantize.hpp>
 #include "test_catch_tools.hpp"
 
 using namespace std;
@@ -100,6 +102,41 @@ TEST_CASE("LINFMetricTest", "[MetricTest]")
 /**
  * Simple test for IoU metric.
  */
+/**
+ * Test that the unrolled small-dimension kernels agree with the generic
+ * formulas for every dimensionality they handle (and one above the cutoff).
+ */
+TEST_CASE("SmallDimensionLMetricTest", "[MetricTest]")
+{
+  ManhattanDistance l1;
+  EuclideanDistance l2;
+  SquaredEuclideanDistance sql2;
+  LMetric<3, true> l3;
+  LMetric<4, true> l4;
+
+  for (size_t d = 1; d <= 9; ++d)
+  {
+    arma::vec a(d);
+    a.randn();
+
+    arma::vec b(d);
+    b.randn();
+
+    REQUIRE(l1.Evaluate(a, b) ==
+        Approx((double) arma::accu(arma::abs(a - b))).epsilon(1e-7));
+    REQUIRE(l2.Evaluate(a, b) ==
+        Approx((double) arma::norm(a - b, 2)).epsilon(1e-7));
+    REQUIRE(sql2.Evaluate(a, b) ==
+        Approx((double) arma::accu(arma::square(a - b))).epsilon(1e-7));
+    REQUIRE(l3.Evaluate(a, b) == Approx(std::pow((double)
+        arma::accu(arma::pow(arma::abs(a - b), 3.0)), 1.0 / 3.0))
+        .epsilon(1e-7));
+    REQUIRE(l4.Evaluate(a, b) == Approx(std::pow((double)
+        arma::accu(arma::pow(arma::abs(a - b), 4.0)), 1.0 / 4.0))
+        .epsilon(1e-7));
+  }
+}
+
 TEST_CASE("IoUMetricTest", "[MetricTest]")
 {
   arma::vec bbox1(4), bbox2(4);
@@ -359,3 +396,50 @@ TEST_CASE("BLEUScoreTest", "[MetricTest]")
         Approx(expectedPrecision[i]).epsilon(1e-4));
   }
 }
+
+/**
+ * Simple test of dataset quantization and the quantized Euclidean distance:
+ * distances between quantized points must closely approximate the distances
+ * between the original points.
+ */
+TEST_CASE("QuantizedEuclideanDistanceTest", "[MetricTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(10, 50);
+  // Stretch the dimensions differently so the per-dimension scales matter.
+  for (size_t d = 0; d < dataset.n_rows; ++d)
+    dataset.row(d) *= (d + 1);
+
+  arma::Mat<arma::s8> quantized;
+  arma::vec scale, offset;
+  mlpack::data::Quantize(dataset, quantized, scale, offset);
+
+  // Every point must be reconstructed to within half a quantization step in
+  // every dimension.
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    for (size_t d = 0; d < dataset.n_rows; ++d)
+    {
+      const double reconstructed = scale[d] * quantized(d, i) + offset[d];
+      REQUIRE(std::abs(reconstructed - dataset(d, i)) <=
+          0.5 * scale[d] + 1e-10);
+    }
+  }
+
+  QuantizedEuclideanDistance quantizedMetric(scale);
+  EuclideanDistance euclidean;
+  for (size_t i = 0; i < 10; ++i)
+  {
+    for (size_t j = i + 1; j < 10; ++j)
+    {
+      const double trueDistance = euclidean.Evaluate(dataset.col(i),
+          dataset.col(j));
+      const double approxDistance = quantizedMetric.Evaluate(
+          quantized.col(i), quantized.col(j));
+
+      // The per-dimension error is at most half a step, so the distance
+      // error is at most half the norm of the scale vector.
+      REQUIRE(std::abs(approxDistance - trueDistance) <=
+          0.5 * arma::norm(scale) + 1e-10);
+    }
+  }
+}
@@ -378,3 +378,43 @@ TEST_CASE("NaiveBayesClassifierHighDimensionsTest", "[NBCTest]")
   for (size_t i = 0; i < calcVec.n_cols; ++i)
     REQUIRE(calcVec(i) == testLabels(i));
 }
+
+/**
+ * Make sure that the blocked incremental trainer (used for batches larger
+ * than one column block) gives the same model as training on every point
+ * individually.
+ */
+TEST_CASE("ChunkedIncrementalTrainTest", "[NBCTest]")
+{
+  const size_t classes = 3;
+
+  // Use enough points that the incremental trainer splits the batch into
+  // several blocks and merges their statistics.
+  arma::mat trainData = arma::randu<arma::mat>(4, 3000);
+  arma::Row<size_t> labels(trainData.n_cols);
+  for (size_t i = 0; i < trainData.n_cols; ++i)
+  {
+    labels[i] = i % classes;
+    trainData.col(i) += labels[i]; // Shift each class.
+  }
+
+  NaiveBayesClassifier<> nbc(trainData, labels, classes, true);
+  NaiveBayesClassifier<> nbcTrain(trainData.n_rows, classes);
+  for (size_t i = 0; i < trainData.n_cols; ++i)
+    nbcTrain.Train(trainData.col(i), labels[i]);
+
+  for (size_t i = 0; i < nbc.Means().n_elem; ++i)
+    REQUIRE(nbc.Means()[i] == Approx(nbcTrain.Means()[i]).epsilon(1e-7));
+
+  for (size_t i = 0; i < nbc.Variances().n_elem; ++i)
+  {
+    REQUIRE(nbc.Variances()[i] ==
+        Approx(nbcTrain.Variances()[i]).epsilon(1e-7));
+  }
+
+  for (size_t i = 0; i < nbc.Probabilities().n_elem; ++i)
+  {
+    REQUIRE(nbc.Probabilities()[i] ==
+        Approx(nbcTrain.Probabilities()[i]).epsilon(1e-7));
+  }
+}
@@ -246,6 +246,48 @@ TEST_CASE("SoftmaxSeparableGradient", "[NCATesT]")
   REQUIRE(gradient(1, 1) == Approx(-2.0 * -0.1435886).epsilon(0.0001));
 }
 
+/**
+ * The non-separable objective and gradient use blocked pairwise distance
+ * computations for the squared Euclidean metric; make sure they agree with
+ * the sums of the separable objective and gradient, which compute every
+ * distance one pair at a time.
+ */
+TEST_CASE("SoftmaxBlockedPrecalculationTest", "[NCATesT]")
+{
+  arma::mat data = arma::randu(5, 60);
+  arma::Row<size_t> labels(60);
+  for (size_t i = 0; i < 60; ++i)
+    labels[i] = i % 3;
+
+  SoftmaxErrorFunction<SquaredEuclideanDistance> sef(data, labels);
+
+  arma::mat coordinates = arma::eye<arma::mat>(5, 5) +
+      0.1 * arma::randu(5, 5);
+
+  // Sum of separable objectives, computed one point at a time.
+  double separableObjective = 0.0;
+  for (size_t i = 0; i < data.n_cols; ++i)
+    separableObjective += sef.Evaluate(coordinates, i, 1);
+
+  REQUIRE(sef.Evaluate(coordinates) ==
+      Approx(separableObjective).epsilon(1e-8));
+
+  // Sum of separable gradients, computed one point at a time.
+  arma::mat separableGradient(5, 5), pointGradient(5, 5);
+  separableGradient.zeros();
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    sef.Gradient(coordinates, i, pointGradient, 1);
+    separableGradient += pointGradient;
+  }
+
+  arma::mat gradient;
+  sef.Gradient(coordinates, gradient);
+
+  REQUIRE(arma::norm(gradient - separableGradient, "fro") ==
+      Approx(0.0).margin(1e-8));
+}
+
 //
 // Tests for the NCA algorithm.
 //
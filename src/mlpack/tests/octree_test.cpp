@@ -346,3 +346,81 @@ TEST_CASE("OctreeSerializationTest", "[OctreeTest]")
   delete binaryTree;
   delete jsonTree;
 }
+
+/**
+ * Recursively check that the children of a node partition its point range
+ * contiguously, that every point of every node lies inside the node's bound,
+ * and that leaves respect the maximum leaf size.
+ */
+void CheckMortonNode(const Octree<>& node, const size_t maxLeafSize)
+{
+  // Every point of the node must be inside its bound.
+  for (size_t i = 0; i < node.NumDescendants(); ++i)
+    REQUIRE(node.Bound().Contains(node.Dataset().col(node.Descendant(i))));
+
+  if (node.IsLeaf())
+  {
+    REQUIRE(node.NumPoints() <= maxLeafSize);
+    return;
+  }
+
+  // The children must cover [begin, begin + count) contiguously and in
+  // order.
+  size_t expectedBegin = node.Descendant(0);
+  size_t totalCount = 0;
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+  {
+    REQUIRE(node.Child(i).Descendant(0) == expectedBegin);
+    expectedBegin += node.Child(i).NumDescendants();
+    totalCount += node.Child(i).NumDescendants();
+
+    CheckMortonNode(node.Child(i), maxLeafSize);
+  }
+  REQUIRE(totalCount == node.NumDescendants());
+}
+
+/**
+ * Build a quadtree with the Morton-code-based algorithm on the four corners
+ * of the unit square, and check the resulting structure directly.
+ */
+TEST_CASE("MortonBuildQuadtreeTest", "[OctreeTest]")
+{
+  // Four corners of the unit square.
+  arma::mat dataset("0 0 1 1; 0 1 0 1");
+
+  Octree<> t(dataset, MortonBuild(), 1);
+
+  REQUIRE(t.NumChildren() == 4);
+  REQUIRE(t.Dataset().n_cols == 4);
+  REQUIRE(t.Dataset().n_rows == 2);
+  REQUIRE(t.NumDescendants() == 4);
+  REQUIRE(t.NumPoints() == 0);
+  for (size_t i = 0; i < 4; ++i)
+  {
+    REQUIRE(t.Child(i).NumDescendants() == 1);
+    REQUIRE(t.Child(i).NumPoints() == 1);
+  }
+}
+
+/**
+ * Build a Morton-code-based octree on random data and check that the tree is
+ * valid and that the point mappings are correct.
+ */
+TEST_CASE("MortonBuildStructureTest", "[OctreeTest]")
+{
+  arma::mat dataset(3, 500, arma::fill::randu);
+  arma::mat datacopy(dataset);
+  std::vector<size_t> oldFromNew;
+
+  Octree<> t(std::move(dataset), oldFromNew, MortonBuild(), 10);
+
+  REQUIRE(t.NumDescendants() == 500);
+  CheckMortonNode(t, 10);
+
+  // The mappings must point back at the original points.
+  for (size_t i = 0; i < oldFromNew.size(); ++i)
+  {
+    REQUIRE(arma::norm(datacopy.col(oldFromNew[i]) -
+        t.Dataset().col(i)) == Approx(0.0).margin(1e-3));
+  }
+}
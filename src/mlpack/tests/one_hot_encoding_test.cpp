@@ -229,3 +229,64 @@ TEST_CASE("OneHotEncodingDatasetinfoTest", "[OneHotEncodingTest]")
 
   remove("test.csv");
 }
+
+/**
+ * Test that the sparse output overload matches the dense encoding.
+ */
+TEST_CASE("OneHotEncodingSparseOutputTest", "[OneHotEncodingTest]")
+{
+  arma::mat input = arma::randu<arma::mat>(6, 50);
+  // Turn two dimensions categorical with a handful of category values.
+  input.row(1) = arma::floor(input.row(1) * 4);
+  input.row(4) = arma::floor(input.row(4) * 3);
+  arma::Col<size_t> indices("1 4");
+
+  arma::mat denseOutput;
+  arma::sp_mat sparseOutput;
+  data::OneHotEncoding(input, indices, denseOutput);
+  data::OneHotEncoding(input, indices, sparseOutput);
+
+  REQUIRE(sparseOutput.n_rows == denseOutput.n_rows);
+  REQUIRE(sparseOutput.n_cols == denseOutput.n_cols);
+  CheckMatrices(denseOutput, arma::mat(sparseOutput));
+}
+
+/**
+ * Test the feature-hashing mode of the sparse encoding overload.
+ */
+TEST_CASE("OneHotEncodingFeatureHashingTest", "[OneHotEncodingTest]")
+{
+  const size_t numBuckets = 16;
+  arma::mat input = arma::randu<arma::mat>(3, 100);
+  // Give the encoded dimension many more categories than buckets.
+  input.row(1) = arma::floor(input.row(1) * 200);
+  arma::Col<size_t> indices("1");
+
+  arma::sp_mat output;
+  data::OneHotEncoding(input, indices, output, numBuckets);
+
+  // The encoded dimension spans numBuckets rows regardless of how many
+  // distinct categories it holds.
+  REQUIRE(output.n_rows == 2 + numBuckets);
+  REQUIRE(output.n_cols == input.n_cols);
+
+  const arma::mat denseOutput(output);
+  for (size_t col = 0; col < input.n_cols; ++col)
+  {
+    // The passthrough dimensions keep their values.
+    REQUIRE(denseOutput(0, col) == Approx(input(0, col)));
+    REQUIRE(denseOutput(1 + numBuckets, col) == Approx(input(2, col)));
+
+    // Exactly one bucket is set per column, and equal categories must land
+    // in the same bucket.
+    const arma::vec buckets = denseOutput.col(col).rows(1, numBuckets);
+    REQUIRE(arma::accu(buckets) == Approx(1.0));
+    REQUIRE(buckets.max() == Approx(1.0));
+  }
+
+  // Two columns holding the same category hash identically.
+  input.col(1) = input.col(0);
+  data::OneHotEncoding(input, indices, output, numBuckets);
+  const arma::mat rehashed(output);
+  CheckMatrices(arma::mat(rehashed.col(0)), arma::mat(rehashed.col(1)));
+}
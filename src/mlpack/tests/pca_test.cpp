@@ -335,3 +335,71 @@ TEST_CASE("PCAScalingTest", "[PCATest]")
   // The eigenvalues should sum to three.
   REQUIRE(accu(eigval) == Approx(3.0).epsilon(0.001));
 }
+
+/**
+ * Test that chunked PCA (StartApplyChunks()/ApplyChunk()/FinishApplyChunks())
+ * gives the same eigenvalues and projections as the batch path.  The signs of
+ * individual principal components are arbitrary, so the projections are
+ * compared by absolute value.
+ */
+TEST_CASE("PCAApplyChunksTest", "[PCATest]")
+{
+  arma::mat data = arma::randu<arma::mat>(5, 600);
+
+  // Batch decomposition.
+  arma::mat score, coeff;
+  arma::vec eigVal;
+  PCA<> pca;
+  pca.Apply(data, score, eigVal, coeff);
+
+  // Chunked decomposition over three uneven chunks.
+  arma::mat chunkScore, chunkCoeff;
+  arma::vec chunkEigVal;
+  PCA<> chunkPCA;
+  chunkPCA.StartApplyChunks(data.n_rows);
+  chunkPCA.ApplyChunk(data.cols(0, 199));
+  chunkPCA.ApplyChunk(data.cols(200, 499));
+  chunkPCA.ApplyChunk(data.cols(500, 599));
+  chunkPCA.FinishApplyChunks(chunkEigVal, chunkCoeff);
+
+  REQUIRE(chunkEigVal.n_elem == data.n_rows);
+  for (size_t i = 0; i < eigVal.n_elem; ++i)
+    REQUIRE(chunkEigVal[i] == Approx(eigVal[i]).epsilon(1e-7));
+
+  chunkPCA.TransformChunk(data, chunkScore);
+  REQUIRE(chunkScore.n_rows == score.n_rows);
+  REQUIRE(chunkScore.n_cols == score.n_cols);
+  for (size_t i = 0; i < score.n_elem; ++i)
+    REQUIRE(std::abs(chunkScore[i]) ==
+        Approx(std::abs(score[i])).margin(1e-7));
+}
+
+/**
+ * Test that chunked PCA with scaling matches the batch path with scaling.
+ */
+TEST_CASE("PCAApplyChunksScalingTest", "[PCATest]")
+{
+  arma::mat data = arma::randn<arma::mat>(4, 500);
+  data.row(2) *= 20.0; // Give one dimension a much larger variance.
+
+  arma::mat score, coeff;
+  arma::vec eigVal;
+  PCA<> pca(true);
+  pca.Apply(data, score, eigVal, coeff);
+
+  arma::mat chunkScore, chunkCoeff;
+  arma::vec chunkEigVal;
+  PCA<> chunkPCA(true);
+  chunkPCA.StartApplyChunks(data.n_rows);
+  chunkPCA.ApplyChunk(data.cols(0, 249));
+  chunkPCA.ApplyChunk(data.cols(250, 499));
+  chunkPCA.FinishApplyChunks(chunkEigVal, chunkCoeff);
+
+  for (size_t i = 0; i < eigVal.n_elem; ++i)
+    REQUIRE(chunkEigVal[i] == Approx(eigVal[i]).epsilon(1e-7));
+
+  chunkPCA.TransformChunk(data, chunkScore);
+  for (size_t i = 0; i < score.n_elem; ++i)
+    REQUIRE(std::abs(chunkScore[i]) ==
+        Approx(std::abs(score[i])).margin(1e-7));
+}
@@ -591,3 +591,72 @@ TEST_CASE("SACForMultipleActions", "[QLearningTest]")
   // If the agent is able to reach till this point of the test, it is assured
   // that the agent can handle multiple actions in continuous space.
 }
+
+//! Test the vectorized lockstep episode runner of the DQN agent.
+TEST_CASE("CartPoleVectorizedEpisode", "[QLearningTest]")
+{
+  // Set up the network.
+  SimpleDQN<> network(4, 128, 128, 2);
+
+  // Set up the policy and replay method.
+  GreedyPolicy<CartPole> policy(1.0, 1000, 0.1, 0.99);
+  RandomReplay<CartPole> replayMethod(10, 10000);
+
+  TrainingConfig config;
+  config.StepSize() = 0.01;
+  config.Discount() = 0.9;
+  config.TargetNetworkSyncInterval() = 100;
+  config.ExplorationSteps() = 100;
+  config.DoubleQLearning() = false;
+  config.StepLimit() = 200;
+
+  // Set up DQN agent.
+  QLearning<CartPole, decltype(network), AdamUpdate, decltype(policy)>
+      agent(config, network, policy, replayMethod);
+
+  // Step eight environment instances in lockstep until all of them terminate.
+  // Every transition of every environment instance must be counted, and the
+  // averaged return must be finite.
+  const double averageReturn = agent.VectorizedEpisode(8);
+
+  REQUIRE(std::isfinite(averageReturn));
+  REQUIRE(agent.TotalSteps() >= 8);
+}
+
+//! Test the vectorized lockstep episode runner of the SAC agent.
+TEST_CASE("PendulumVectorizedEpisode", "[QLearningTest]")
+{
+  // Set up the replay method.
+  RandomReplay<Pendulum> replayMethod(32, 10000);
+
+  TrainingConfig config;
+  config.StepSize() = 0.001;
+  config.TargetNetworkSyncInterval() = 1;
+  config.UpdateInterval() = 3;
+  // The pendulum task never terminates on its own, so the episodes end at the
+  // step limit.
+  config.StepLimit() = 10;
+
+  FFN<EmptyLoss<>, GaussianInitialization>
+      policyNetwork(EmptyLoss<>(), GaussianInitialization(0, 0.1));
+  policyNetwork.Add(new Linear<>(3, 128));
+  policyNetwork.Add(new ReLULayer<>());
+  policyNetwork.Add(new Linear<>(128, 1));
+  policyNetwork.Add(new TanHLayer<>());
+
+  FFN<EmptyLoss<>, GaussianInitialization>
+      qNetwork(EmptyLoss<>(), GaussianInitialization(0, 0.1));
+  qNetwork.Add(new Linear<>(3 + 1, 128));
+  qNetwork.Add(new ReLULayer<>());
+  qNetwork.Add(new Linear<>(128, 1));
+
+  // Set up Soft actor-critic agent.
+  SAC<Pendulum, decltype(qNetwork), decltype(policyNetwork), AdamUpdate>
+      agent(config, qNetwork, policyNetwork, replayMethod);
+
+  const double averageReturn = agent.VectorizedEpisode(4);
+
+  REQUIRE(std::isfinite(averageReturn));
+  // Four environments were stepped to the step limit in lockstep.
+  REQUIRE(agent.TotalSteps() == 4 * config.StepLimit());
+}
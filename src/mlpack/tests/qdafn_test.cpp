@@ -141,6 +141,50 @@ TEST_CASE("QDAFNMultipleNeighbors", "[QDAFNTest]")
   }
 }
 
+/**
+ * Test the incremental update method: after a handful of points change, the
+ * model should still find near-optimal furthest neighbors of the updated set.
+ */
+TEST_CASE("QDAFNUpdatePointsTest", "[QDAFNTest]")
+{
+  arma::mat uniformSet = arma::randu<arma::mat>(25, 1000);
+
+  QDAFN<> qdafn(uniformSet, 10, 30);
+
+  // Scale up a handful of points, so that they are likely to become furthest
+  // neighbors, and update the model incrementally.
+  arma::Col<size_t> changed(10);
+  for (size_t i = 0; i < 10; ++i)
+  {
+    changed[i] = 37 * i;
+    uniformSet.col(37 * i) = 2.0 * arma::randu<arma::vec>(25);
+  }
+  qdafn.UpdatePoints(uniformSet, changed);
+
+  // Get the actual furthest neighbors of the updated set.
+  KFN kfn(uniformSet);
+  arma::Mat<size_t> trueNeighbors;
+  arma::mat trueDistances;
+
+  kfn.Search(1, trueNeighbors, trueDistances);
+
+  arma::Mat<size_t> qdafnNeighbors;
+  arma::mat qdafnDistances;
+
+  qdafn.Search(uniformSet, 1, qdafnNeighbors, qdafnDistances);
+
+  // Expect a distance within 10% of the true furthest neighbor distance at
+  // least 70% of the time.
+  size_t successes = 0;
+  for (size_t i = 0; i < 999; ++i)
+  {
+    if (0.9 * trueDistances(0, i) <= qdafnDistances(0, i))
+      ++successes;
+  }
+
+  REQUIRE(successes >= 695);
+}
+
 /**
  * Test re-training method.
  */
@@ -88,3 +88,26 @@ TEST_CASE("QUICSVDSameDimensionTest", "[QUICSVDTest]")
   arma::mat u, v, sigma;
   svd::QUIC_SVD quicsvd(dataset, u, v, sigma);
 }
+
+/**
+ * A basis size budget should cap the width of the factors while still
+ * producing a usable factorization.
+ */
+TEST_CASE("QUICSVDBasisSizeBudgetTest", "[QUICSVDTest]")
+{
+  arma::mat dataset = arma::randn<arma::mat>(10, 500);
+
+  // Obtain the SVD with a budget of five basis vectors.
+  arma::mat u, v, sigma;
+  svd::QUIC_SVD quicsvd(dataset, u, v, sigma, 0.03, 0.1, 5);
+
+  // The factor widths must respect the budget.
+  REQUIRE(u.n_cols <= 5);
+  REQUIRE(v.n_cols <= 5);
+
+  // The factorization should still capture part of the dataset.
+  arma::mat reconstruct = u * sigma * v.t();
+  double relativeError = arma::norm(dataset - reconstruct, "frob") /
+                         arma::norm(dataset, "frob");
+  REQUIRE(relativeError < 1.0);
+}
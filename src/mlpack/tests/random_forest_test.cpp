@@ -11,6 +11,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/random_forest/random_forest.hpp>
+#include <mlpack/methods/random_forest/compact_random_forest.hpp>
 #include <mlpack/methods/decision_tree/random_dimension_select.hpp>
 
 #include "serialization.hpp"
@@ -94,6 +95,33 @@ TEST_CASE("BootstrapWeightsTest", "[RandomForestTest]")
   }
 }
 
+/**
+ * Make sure index-only bootstrap sampling produces valid column indices, and
+ * that the sample is determined by the stream it is drawn from.
+ */
+TEST_CASE("BootstrapIndexTest", "[RandomForestTest]")
+{
+  for (size_t trial = 0; trial < 5; ++trial)
+  {
+    math::RandomStream stream(trial);
+    arma::Row<size_t> samples;
+    Bootstrap(1000, samples, stream);
+
+    REQUIRE(samples.n_elem == 1000);
+
+    // Check each sampled index.
+    for (size_t i = 0; i < samples.n_elem; ++i)
+      REQUIRE(samples[i] < 1000);
+
+    // The same stream must reproduce the same sample.
+    math::RandomStream sameStream(trial);
+    arma::Row<size_t> sameSamples;
+    Bootstrap(1000, sameSamples, sameStream);
+    for (size_t i = 0; i < samples.n_elem; ++i)
+      REQUIRE(sameSamples[i] == samples[i]);
+  }
+}
+
 /**
  * Make sure an empty forest cannot predict.
  */
@@ -484,3 +512,123 @@ TEST_CASE("DifferentTreesTest", "[RandomForestTest]")
 
   REQUIRE(success == true);
 }
+
+/**
+ * Test that the batch Classify() overloads, which use the flattened forest
+ * layout, give exactly the same results as classifying each point separately.
+ */
+TEST_CASE("BatchClassifyMatchesSinglePointTest", "[RandomForestTest]")
+{
+  // Load the vc2 dataset.
+  arma::mat dataset;
+  data::Load("vc2.csv", dataset);
+  arma::Row<size_t> labels;
+  data::Load("vc2_labels.txt", labels);
+
+  RandomForest<> rf(dataset, labels, 3, 10 /* 10 trees */, 1);
+
+  arma::Row<size_t> batchPredictions;
+  arma::mat batchProbabilities;
+  rf.Classify(dataset, batchPredictions, batchProbabilities);
+
+  arma::Row<size_t> predictionsOnly;
+  rf.Classify(dataset, predictionsOnly);
+
+  REQUIRE(batchPredictions.n_elem == dataset.n_cols);
+  REQUIRE(batchProbabilities.n_rows == 3);
+  REQUIRE(batchProbabilities.n_cols == dataset.n_cols);
+
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    size_t prediction;
+    arma::vec probabilities;
+    rf.Classify(dataset.col(i), prediction, probabilities);
+
+    REQUIRE(batchPredictions[i] == prediction);
+    REQUIRE(predictionsOnly[i] == prediction);
+    for (size_t j = 0; j < probabilities.n_elem; ++j)
+    {
+      REQUIRE(batchProbabilities(j, i) ==
+          Approx(probabilities[j]).epsilon(1e-10));
+    }
+  }
+}
+
+/**
+ * A compact exported forest should agree with the original forest on almost
+ * every point (the narrowed thresholds and quantized leaf distributions may
+ * flip near-ties), and a serialized compact forest should classify
+ * identically after loading.
+ */
+TEST_CASE("CompactRandomForestTest", "[RandomForestTest]")
+{
+  // Load the vc2 dataset.
+  arma::mat dataset;
+  data::Load("vc2.csv", dataset);
+  arma::Row<size_t> labels;
+  data::Load("vc2_labels.txt", labels);
+
+  RandomForest<> rf(dataset, labels, 3, 10 /* 10 trees */, 1);
+
+  // Export the forest to the compact format.
+  CompactRandomForest crf(rf);
+  REQUIRE(crf.NumTrees() == rf.NumTrees());
+  REQUIRE(crf.NumClasses() == 3);
+
+  arma::Row<size_t> rfPredictions, crfPredictions;
+  rf.Classify(dataset, rfPredictions);
+  crf.Classify(dataset, crfPredictions);
+
+  const size_t matches = arma::accu(rfPredictions == crfPredictions);
+  REQUIRE(matches >= size_t(0.95 * dataset.n_cols));
+
+  // Single-point classification should match the batch version, and the
+  // reconstructed probabilities should sum to one.
+  for (size_t i = 0; i < 10; ++i)
+  {
+    size_t prediction;
+    arma::vec probabilities;
+    crf.Classify(dataset.col(i), prediction, probabilities);
+
+    REQUIRE(prediction == crfPredictions[i]);
+    REQUIRE(arma::accu(probabilities) == Approx(1.0).epsilon(1e-10));
+  }
+
+  // A reloaded compact forest must classify identically.
+  CompactRandomForest xmlCrf, jsonCrf, binaryCrf;
+  SerializeObjectAll(crf, xmlCrf, jsonCrf, binaryCrf);
+
+  arma::Row<size_t> xmlPredictions, jsonPredictions, binaryPredictions;
+  xmlCrf.Classify(dataset, xmlPredictions);
+  jsonCrf.Classify(dataset, jsonPredictions);
+  binaryCrf.Classify(dataset, binaryPredictions);
+
+  CheckMatrices(crfPredictions, xmlPredictions, jsonPredictions,
+      binaryPredictions);
+}
+
+/**
+ * Exporting an untrained forest or a forest with categorical splits should
+ * throw, as should classifying with an empty compact forest.
+ */
+TEST_CASE("CompactRandomForestInvalidExportTest", "[RandomForestTest]")
+{
+  // An untrained forest cannot be exported.
+  RandomForest<> rf;
+  REQUIRE_THROWS_AS(CompactRandomForest(rf), std::invalid_argument);
+
+  // An empty compact forest cannot classify.
+  CompactRandomForest crf;
+  arma::vec point(4, arma::fill::randu);
+  REQUIRE_THROWS_AS(crf.Classify(point), std::invalid_argument);
+
+  // A forest with categorical splits does not fit the compact format.
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  data::DatasetInfo info;
+  MockCategoricalData(dataset, labels, info);
+
+  RandomForest<> categoricalRf(dataset, info, labels, 5, 10 /* 10 trees */);
+  REQUIRE_THROWS_AS(CompactRandomForest(categoricalRf),
+      std::invalid_argument);
+}
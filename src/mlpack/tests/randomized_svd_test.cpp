@@ -60,3 +60,44 @@ TEST_CASE("RandomizedSVDReconstructionError", "[RandomizedSVDTest]")
       arma::norm(centeredData, "frob");
   REQUIRE(error == Approx(0.0).margin(1e-5));
 }
+
+/**
+ * The out-of-core (chunked) overload should recover the factorization of a
+ * low-rank matrix streamed from disk.
+ */
+TEST_CASE("RandomizedSVDChunkedReaderTest", "[RandomizedSVDTest]")
+{
+  arma::mat U = arma::randn<arma::mat>(8, 3);
+  arma::mat V = arma::randn<arma::mat>(500, 3);
+  arma::mat s = arma::diagmat(arma::vec("1 0.1 0.01"));
+
+  // One point per column.
+  arma::mat data = U * s * V.t();
+
+  data::Save("rsvd_chunk_test.csv", data);
+
+  // Use a chunk size much smaller than the dataset, so many chunks are read.
+  data::ChunkedReader reader("rsvd_chunk_test.csv", 64);
+
+  arma::mat U1, U2, V1, V2;
+  arma::vec s1, s2;
+
+  svd::RandomizedSVD rSVD(0, 10);
+  rSVD.Apply(reader, U2, s2, V2, 3);
+
+  // The streaming overload does not center the data, so compare against the
+  // SVD of the data as-is.
+  arma::svd_econ(U1, s1, V1, data);
+
+  // The singular value error should be small.
+  arma::vec s3 = s1.subvec(0, s2.n_elem - 1);
+  double error = arma::norm(s2 - s3, "frob") / arma::norm(s2, "frob");
+  REQUIRE(error == Approx(0.0).margin(1e-3));
+
+  // The relative reconstruction error should be small.
+  arma::mat reconstruct = U2 * arma::diagmat(s2) * V2.t();
+  error = arma::norm(data - reconstruct, "frob") / arma::norm(data, "frob");
+  REQUIRE(error == Approx(0.0).margin(1e-3));
+
+  remove("rsvd_chunk_test.csv");
+}
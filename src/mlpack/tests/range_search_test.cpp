@@ -1714,3 +1714,314 @@ TEST_CASE("MoveOperatorNaiveTest", "[RangeSearchTest]")
     }
   }
 }
+
+// Get the arena-backed results for one query point into a sorted format, so
+// that they can be compared with the vector-of-vectors results.
+void SortArenaResults(const RangeSearchResults& results,
+                      const size_t queryIndex,
+                      vector<pair<double, size_t>>& output)
+{
+  output.resize(results.Count(queryIndex));
+  for (size_t j = 0; j < output.size(); ++j)
+  {
+    output[j] = make_pair(results.Distance(queryIndex, j),
+        results.Neighbor(queryIndex, j));
+  }
+
+  sort(output.begin(), output.end());
+}
+
+/**
+ * Test that the arena-backed (flat) results overload of Search() returns the
+ * same results as the vector-of-vectors overload, in dual-tree, single-tree,
+ * and naive mode.
+ */
+TEST_CASE("ArenaResultsTest", "[RangeSearchTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(5, 500);
+  arma::mat queryData = arma::randu<arma::mat>(5, 200);
+
+  for (size_t mode = 0; mode < 3; ++mode)
+  {
+    const bool naive = (mode == 0);
+    const bool single = (mode == 1);
+    RangeSearch<> rs(referenceData, naive, single);
+
+    vector<vector<size_t>> neighbors;
+    vector<vector<double>> distances;
+    rs.Search(queryData, Range(0.5, 0.8), neighbors, distances);
+    vector<vector<pair<double, size_t>>> sortedVector;
+    SortResults(neighbors, distances, sortedVector);
+
+    RangeSearchResults results;
+    rs.Search(queryData, Range(0.5, 0.8), results);
+
+    REQUIRE(results.NumQueries() == queryData.n_cols);
+
+    size_t totalResults = 0;
+    for (size_t i = 0; i < queryData.n_cols; ++i)
+    {
+      totalResults += sortedVector[i].size();
+      REQUIRE(results.Count(i) == sortedVector[i].size());
+
+      vector<pair<double, size_t>> sortedArena;
+      SortArenaResults(results, i, sortedArena);
+
+      for (size_t j = 0; j < sortedArena.size(); ++j)
+      {
+        REQUIRE(sortedArena[j].second == sortedVector[i][j].second);
+        REQUIRE(sortedArena[j].first ==
+            Approx(sortedVector[i][j].first).epsilon(1e-7));
+      }
+    }
+
+    REQUIRE(results.NumResults() == totalResults);
+  }
+}
+
+/**
+ * Test the arena-backed results overload of the monochromatic Search().
+ */
+TEST_CASE("ArenaResultsMonochromaticTest", "[RangeSearchTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 500);
+  RangeSearch<> rs(dataset);
+
+  vector<vector<size_t>> neighbors;
+  vector<vector<double>> distances;
+  rs.Search(Range(0.2, 0.5), neighbors, distances);
+  vector<vector<pair<double, size_t>>> sortedVector;
+  SortResults(neighbors, distances, sortedVector);
+
+  RangeSearchResults results;
+  rs.Search(Range(0.2, 0.5), results);
+
+  REQUIRE(results.NumQueries() == dataset.n_cols);
+
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    REQUIRE(results.Count(i) == sortedVector[i].size());
+
+    vector<pair<double, size_t>> sortedArena;
+    SortArenaResults(results, i, sortedArena);
+
+    for (size_t j = 0; j < sortedArena.size(); ++j)
+    {
+      REQUIRE(sortedArena[j].second == sortedVector[i][j].second);
+      REQUIRE(sortedArena[j].first ==
+          Approx(sortedVector[i][j].first).epsilon(1e-7));
+    }
+  }
+}
+
+/**
+ * Test the arena-backed results overload that takes a pre-built query tree.
+ */
+TEST_CASE("ArenaResultsQueryTreeTest", "[RangeSearchTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(5, 500);
+  arma::mat queryData = arma::randu<arma::mat>(5, 200);
+
+  RangeSearch<> rs(referenceData);
+
+  typedef RangeSearch<>::Tree TreeType;
+  std::vector<size_t> oldFromNewQueries;
+  TreeType queryTree(queryData, oldFromNewQueries);
+
+  vector<vector<size_t>> neighbors;
+  vector<vector<double>> distances;
+  rs.Search(&queryTree, Range(0.5, 0.8), neighbors, distances);
+  vector<vector<pair<double, size_t>>> sortedVector;
+  SortResults(neighbors, distances, sortedVector);
+
+  RangeSearchResults results;
+  rs.Search(&queryTree, Range(0.5, 0.8), results);
+
+  REQUIRE(results.NumQueries() == queryData.n_cols);
+
+  for (size_t i = 0; i < queryData.n_cols; ++i)
+  {
+    REQUIRE(results.Count(i) == sortedVector[i].size());
+
+    vector<pair<double, size_t>> sortedArena;
+    SortArenaResults(results, i, sortedArena);
+
+    for (size_t j = 0; j < sortedArena.size(); ++j)
+    {
+      REQUIRE(sortedArena[j].second == sortedVector[i][j].second);
+      REQUIRE(sortedArena[j].first ==
+          Approx(sortedVector[i][j].first).epsilon(1e-7));
+    }
+  }
+}
+
+/**
+ * The monochromatic arena-backed Search() uses a self-join traversal for tree
+ * types whose children partition the points, and falls back to the generic
+ * traverser otherwise.  Check both paths against the vector-of-vectors
+ * results: a ball tree (overlapping children, but partitioned points) takes
+ * the self-join path, and a cover tree (self-children) takes the fallback.
+ */
+TEST_CASE("SelfJoinSearchTest", "[RangeSearchTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 500);
+
+  // Ball tree: self-join path.
+  {
+    RangeSearch<EuclideanDistance, arma::mat, BallTree> rs(dataset);
+
+    vector<vector<size_t>> neighbors;
+    vector<vector<double>> distances;
+    rs.Search(Range(0.2, 0.5), neighbors, distances);
+    vector<vector<pair<double, size_t>>> sortedVector;
+    SortResults(neighbors, distances, sortedVector);
+
+    RangeSearchResults results;
+    rs.Search(Range(0.2, 0.5), results);
+
+    REQUIRE(results.NumQueries() == dataset.n_cols);
+    for (size_t i = 0; i < dataset.n_cols; ++i)
+    {
+      REQUIRE(results.Count(i) == sortedVector[i].size());
+
+      vector<pair<double, size_t>> sortedArena;
+      SortArenaResults(results, i, sortedArena);
+      for (size_t j = 0; j < sortedArena.size(); ++j)
+      {
+        REQUIRE(sortedArena[j].second == sortedVector[i][j].second);
+        REQUIRE(sortedArena[j].first ==
+            Approx(sortedVector[i][j].first).epsilon(1e-7));
+      }
+    }
+  }
+
+  // Cover tree: generic traverser fallback.
+  {
+    RangeSearch<EuclideanDistance, arma::mat, StandardCoverTree> rs(dataset);
+
+    vector<vector<size_t>> neighbors;
+    vector<vector<double>> distances;
+    rs.Search(Range(0.2, 0.5), neighbors, distances);
+    vector<vector<pair<double, size_t>>> sortedVector;
+    SortResults(neighbors, distances, sortedVector);
+
+    RangeSearchResults results;
+    rs.Search(Range(0.2, 0.5), results);
+
+    REQUIRE(results.NumQueries() == dataset.n_cols);
+    for (size_t i = 0; i < dataset.n_cols; ++i)
+    {
+      REQUIRE(results.Count(i) == sortedVector[i].size());
+
+      vector<pair<double, size_t>> sortedArena;
+      SortArenaResults(results, i, sortedArena);
+      for (size_t j = 0; j < sortedArena.size(); ++j)
+      {
+        REQUIRE(sortedArena[j].second == sortedVector[i][j].second);
+        REQUIRE(sortedArena[j].first ==
+            Approx(sortedVector[i][j].first).epsilon(1e-7));
+      }
+    }
+  }
+}
+
+/**
+ * Make sure the uniform-grid backend returns exactly the naive results, in
+ * both the bichromatic and the monochromatic case.
+ */
+TEST_CASE("GridSearchVsNaiveTest", "[RangeSearchTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(3, 1000);
+  arma::mat queryData = arma::randu<arma::mat>(3, 200);
+
+  GridRangeSearch grid;
+  arma::mat referenceCopy(referenceData);
+  grid.Train(std::move(referenceCopy));
+
+  RangeSearch<> naive(referenceData, true);
+
+  // Bichromatic search.
+  vector<vector<size_t>> gridNeighbors, naiveNeighbors;
+  vector<vector<double>> gridDistances, naiveDistances;
+  grid.Search(queryData, Range(0.1, 0.35), gridNeighbors, gridDistances);
+  naive.Search(queryData, Range(0.1, 0.35), naiveNeighbors, naiveDistances);
+
+  vector<vector<pair<double, size_t>>> sortedGrid, sortedNaive;
+  SortResults(gridNeighbors, gridDistances, sortedGrid);
+  SortResults(naiveNeighbors, naiveDistances, sortedNaive);
+
+  for (size_t i = 0; i < sortedGrid.size(); ++i)
+  {
+    REQUIRE(sortedGrid[i].size() == sortedNaive[i].size());
+    for (size_t j = 0; j < sortedGrid[i].size(); ++j)
+    {
+      REQUIRE(sortedGrid[i][j].second == sortedNaive[i][j].second);
+      REQUIRE(sortedGrid[i][j].first ==
+          Approx(sortedNaive[i][j].first).epsilon(1e-7));
+    }
+  }
+
+  // Monochromatic search.
+  grid.Search(Range(0.1, 0.35), gridNeighbors, gridDistances);
+  naive.Search(Range(0.1, 0.35), naiveNeighbors, naiveDistances);
+
+  SortResults(gridNeighbors, gridDistances, sortedGrid);
+  SortResults(naiveNeighbors, naiveDistances, sortedNaive);
+
+  for (size_t i = 0; i < sortedGrid.size(); ++i)
+  {
+    REQUIRE(sortedGrid[i].size() == sortedNaive[i].size());
+    for (size_t j = 0; j < sortedGrid[i].size(); ++j)
+    {
+      REQUIRE(sortedGrid[i][j].second == sortedNaive[i][j].second);
+      REQUIRE(sortedGrid[i][j].first ==
+          Approx(sortedNaive[i][j].first).epsilon(1e-7));
+    }
+  }
+}
+
+/**
+ * Make sure the uniform-grid backend works through RSModel, including on data
+ * with more than three dimensions (where only the first three are gridded).
+ */
+TEST_CASE("GridRSModelTest", "[RangeSearchTest]")
+{
+  arma::mat queryData = arma::randu<arma::mat>(10, 50);
+  arma::mat referenceData = arma::randu<arma::mat>(10, 200);
+
+  // Get a baseline.
+  RangeSearch<> rs(referenceData);
+  vector<vector<size_t>> baselineNeighbors;
+  vector<vector<double>> baselineDistances;
+  rs.Search(queryData, math::Range(0.25, 0.75), baselineNeighbors,
+      baselineDistances);
+
+  vector<vector<pair<double, size_t>>> baselineSorted;
+  SortResults(baselineNeighbors, baselineDistances, baselineSorted);
+
+  RSModel model(RSModel::TreeTypes::GRID, false);
+
+  arma::mat referenceCopy(referenceData);
+  arma::mat queryCopy(queryData);
+  model.BuildModel(std::move(referenceCopy), 5, false, false);
+
+  vector<vector<size_t>> neighbors;
+  vector<vector<double>> distances;
+  model.Search(std::move(queryCopy), math::Range(0.25, 0.75), neighbors,
+      distances);
+
+  REQUIRE(neighbors.size() == baselineNeighbors.size());
+
+  vector<vector<pair<double, size_t>>> sorted;
+  SortResults(neighbors, distances, sorted);
+  for (size_t i = 0; i < sorted.size(); ++i)
+  {
+    REQUIRE(sorted[i].size() == baselineSorted[i].size());
+    for (size_t j = 0; j < sorted[i].size(); ++j)
+    {
+      REQUIRE(sorted[i][j].second == baselineSorted[i][j].second);
+      REQUIRE(sorted[i][j].first ==
+          Approx(baselineSorted[i][j].first).epsilon(1e-7));
+    }
+  }
+}
@@ -1359,3 +1359,140 @@ TEST_CASE("RectangleTreeMoveDatasetTest", "[RectangleTreeTraitsTest]")
   REQUIRE(tree.Dataset().n_rows == 3);
   REQUIRE(tree.Dataset().n_cols == 1000);
 }
+
+// A test that repeatedly deletes and reinserts points, exercising the per-tree
+// node arena: CondenseTree() returns node storage to the arena and the
+// following SplitNode() calls reuse the recycled slots.
+TEST_CASE("RectangleTreeInsertDeleteCycleTest", "[RectangleTreeTraitsTest]")
+{
+  arma::mat dataset;
+  dataset.randu(8, 600); // 600 points in 8 dimensions.
+
+  typedef RTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+  TreeType tree(dataset, 20, 6, 5, 2, 0);
+
+  for (size_t round = 0; round < 5; ++round)
+  {
+    for (size_t i = 0; i < 100; ++i)
+      tree.DeletePoint(500 + i);
+    for (size_t i = 0; i < 100; ++i)
+      tree.InsertPoint(500 + i);
+  }
+
+  // The tree must still be valid after all of the node churn.
+  REQUIRE(tree.NumDescendants() == 600);
+  CheckContainment(tree);
+  CheckExactContainment(tree);
+  CheckNumDescendants(tree);
+}
+
+// Count the leaves of a tree; used to check the packing of bulk-loaded trees.
+template<typename TreeType>
+size_t NumLeaves(const TreeType& tree)
+{
+  if (tree.NumChildren() == 0)
+    return 1;
+
+  size_t numLeaves = 0;
+  for (size_t i = 0; i < tree.NumChildren(); ++i)
+    numLeaves += NumLeaves(tree.Child(i));
+
+  return numLeaves;
+}
+
+// A test of the Sort-Tile-Recursive bulk loader.  The bulk-loaded tree must be
+// valid, its leaves must be completely full (1000 points pack into exactly 50
+// leaves of 20 points), and its query results must match a naive search.
+TEST_CASE("RectangleTreeSTRBulkLoadTest", "[RectangleTreeTraitsTest]")
+{
+  arma::mat dataset;
+  dataset.randu(8, 1000); // 1000 points in 8 dimensions.
+
+  typedef RTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+  TreeType tree(dataset, true, 20, 6, 5, 2, 0);
+
+  REQUIRE(tree.NumDescendants() == 1000);
+  REQUIRE(NumLeaves(tree) == 50);
+  CheckContainment(tree);
+  CheckExactContainment(tree);
+  CheckNumDescendants(tree);
+
+  // Single-tree search with the bulk-loaded tree.
+  NeighborSearch<NearestNeighborSort, metric::LMetric<2, true>, arma::mat,
+      RTree> knn1(std::move(tree), SINGLE_TREE_MODE);
+
+  arma::Mat<size_t> neighbors1;
+  arma::mat distances1;
+  knn1.Search(5, neighbors1, distances1);
+
+  // Nearest neighbor search the naive way.
+  KNN knn2(dataset, NAIVE_MODE);
+
+  arma::Mat<size_t> neighbors2;
+  arma::mat distances2;
+  knn2.Search(5, neighbors2, distances2);
+
+  for (size_t i = 0; i < neighbors1.size(); ++i)
+  {
+    REQUIRE(distances1[i] == distances2[i]);
+    REQUIRE(neighbors1[i] == neighbors2[i]);
+  }
+}
+
+// A test of bulk deletion.  We remove the tail of the dataset in one
+// DeletePoints() call and check that the rebuilt tree is valid and that its
+// query results match a naive search over the surviving points.
+TEST_CASE("RectangleTreeDeletePointsTest", "[RectangleTreeTraitsTest]")
+{
+  arma::mat dataset;
+  dataset.randu(8, 1000); // 1000 points in 8 dimensions.
+
+  arma::mat querySet;
+  querySet.randu(8, 500);
+
+  const size_t numDeleted = 200;
+
+  typedef RTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+  TreeType tree(dataset, 20, 6, 5, 2, 0);
+
+  std::vector<size_t> pointsToDelete(numDeleted);
+  for (size_t i = 0; i < numDeleted; ++i)
+    pointsToDelete[i] = 1000 - numDeleted + i;
+
+  tree.DeletePoints(pointsToDelete);
+
+  REQUIRE(tree.NumDescendants() == 1000 - numDeleted);
+  // The rebuild packs the survivors into completely full leaves.
+  REQUIRE(NumLeaves(tree) == 40);
+  CheckContainment(tree);
+  CheckExactContainment(tree);
+  CheckNumDescendants(tree);
+
+  // Single-tree search.
+  NeighborSearch<NearestNeighborSort, metric::LMetric<2, true>, arma::mat,
+      RTree> knn1(std::move(tree), SINGLE_TREE_MODE);
+
+  arma::Mat<size_t> neighbors1;
+  arma::mat distances1;
+  knn1.Search(querySet, 5, neighbors1, distances1);
+
+  arma::mat newDataset;
+  newDataset = dataset;
+  newDataset.resize(8, 1000 - numDeleted);
+
+  // Nearest neighbor search the naive way.
+  KNN knn2(newDataset, NAIVE_MODE);
+
+  arma::Mat<size_t> neighbors2;
+  arma::mat distances2;
+  knn2.Search(querySet, 5, neighbors2, distances2);
+
+  for (size_t i = 0; i < neighbors1.size(); ++i)
+  {
+    REQUIRE(distances1[i] == distances2[i]);
+    REQUIRE(neighbors1[i] == neighbors2[i]);
+  }
+}
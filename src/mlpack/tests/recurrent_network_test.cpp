@@ -806,6 +806,48 @@ TEST_CASE("BRNNTrainReturnObjective", "[RecurrentNetworkTest]")
   REQUIRE(std::isfinite(objVal) == true);
 }
 
+/**
+ * Test that RNN::TrainBucketed() trains on variable-length sequences and
+ * returns a finite objective.
+ */
+TEST_CASE("RNNTrainBucketedTest", "[RecurrentNetworkTest]")
+{
+  const size_t rho = 6;
+  const size_t maxLength = 12;
+  const size_t sequences = 8;
+
+  // Variable-length random sequences, padded with zeros to maxLength; some
+  // sequences are longer than rho, so BPTT has to be truncated into
+  // windows.
+  arma::cube input = arma::zeros<arma::cube>(1, sequences, maxLength);
+  arma::cube labels = arma::ones<arma::cube>(1, sequences, maxLength);
+  arma::urowvec sequenceLengths(sequences);
+  for (size_t i = 0; i < sequences; ++i)
+  {
+    sequenceLengths(i) = 4 + math::RandInt(maxLength - 3);
+    for (size_t t = 0; t < sequenceLengths(i); ++t)
+    {
+      input(0, i, t) = math::Random();
+      labels(0, i, t) = math::RandInt(1, 3);
+    }
+  }
+
+  RNN<> model(rho);
+  model.Add<Linear<> >(1, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<LSTM<> >(8, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 2);
+  model.Add<LogSoftMax<> >();
+
+  StandardSGD opt(0.1, 2, 10 * sequences, -100);
+  const double objective = model.TrainBucketed(input, labels,
+      sequenceLengths, 4, opt);
+
+  REQUIRE(std::isfinite(objective) == true);
+  REQUIRE(model.Rho() == rho);
+}
+
 /**
  * Test that RNN::Train() does not give an error for large rho.
  */
@@ -931,3 +973,34 @@ TEST_CASE("RNNCheckInputShapeTest", "[RecurrentNetworkTest]")
 
   REQUIRE_THROWS_AS(model.Train(input, labels, opt), std::logic_error);
 }
+
+/**
+ * Test that incremental prediction with PredictStep() produces the same
+ * outputs as Predict() on the whole sequence.
+ */
+TEST_CASE("RNNPredictStepTest", "[RecurrentNetworkTest]")
+{
+  const size_t rho = 5;
+
+  arma::cube input = arma::randu(1, 4, rho);
+
+  RNN<> model(rho);
+  model.Add<Linear<> >(1, 10);
+  model.Add<SigmoidLayer<> >();
+  model.Add<LSTM<> >(10, 10);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(10, 2);
+  model.Add<LogSoftMax<> >();
+
+  arma::cube output;
+  model.Predict(input, output);
+
+  // Predicting the sequence one step at a time must carry the recurrent
+  // state across the calls and reproduce the full-sequence outputs.
+  arma::mat stepOutput;
+  for (size_t t = 0; t < rho; ++t)
+  {
+    model.PredictStep(input.slice(t), stepOutput, t == 0);
+    CheckMatrices(output.slice(t), stepOutput);
+  }
+}
@@ -170,6 +170,77 @@ TEST_CASE("SimpleCartPoleTest", "[RLComponentsTest]")
   REQUIRE(2 == static_cast<size_t>(CartPole::Action::size));
 }
 
+/**
+ * The batched Cart Pole dynamics must agree with the scalar dynamics for
+ * every transition of a randomly generated batch.
+ */
+TEST_CASE("CartPoleBatchSampleTest", "[RLComponentsTest]")
+{
+  CartPole task(0); // No step limit.
+
+  const size_t batchSize = 50;
+  arma::mat states = arma::randu(4, batchSize) - 0.5;
+  arma::Col<size_t> actions = arma::randi<arma::Col<size_t>>(batchSize,
+      arma::distr_param(0, (int) CartPole::Action::size - 1));
+
+  arma::mat nextStates;
+  arma::rowvec rewards;
+  arma::irowvec isTerminal;
+  task.BatchSample(states, actions, nextStates, rewards, isTerminal);
+
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    CartPole::State state(states.col(i));
+    CartPole::Action action;
+    action.action = CartPole::Action::actions(actions[i]);
+
+    CartPole::State nextState;
+    const double reward = task.Sample(state, action, nextState);
+
+    REQUIRE(arma::norm(nextStates.col(i) - nextState.Encode()) ==
+        Approx(0.0).margin(1e-12));
+    REQUIRE(rewards[i] == Approx(reward));
+    REQUIRE((isTerminal[i] == 1) == task.IsTerminal(nextState));
+  }
+}
+
+/**
+ * The batched Mountain Car dynamics must agree with the scalar dynamics for
+ * every transition of a randomly generated batch.
+ */
+TEST_CASE("MountainCarBatchSampleTest", "[RLComponentsTest]")
+{
+  MountainCar task(0); // No step limit.
+
+  const size_t batchSize = 50;
+  arma::mat states(2, batchSize);
+  states.row(0) = arma::randu<arma::rowvec>(batchSize) * 0.14 - 0.07;
+  states.row(1) = arma::randu<arma::rowvec>(batchSize) * 1.8 - 1.2;
+
+  arma::Col<size_t> actions = arma::randi<arma::Col<size_t>>(batchSize,
+      arma::distr_param(0, (int) MountainCar::Action::size - 1));
+
+  arma::mat nextStates;
+  arma::rowvec rewards;
+  arma::irowvec isTerminal;
+  task.BatchSample(states, actions, nextStates, rewards, isTerminal);
+
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    MountainCar::State state(states.col(i));
+    MountainCar::Action action;
+    action.action = MountainCar::Action::actions(actions[i]);
+
+    MountainCar::State nextState;
+    const double reward = task.Sample(state, action, nextState);
+
+    REQUIRE(arma::norm(nextStates.col(i) - nextState.Encode()) ==
+        Approx(0.0).margin(1e-12));
+    REQUIRE(rewards[i] == Approx(reward));
+    REQUIRE((isTerminal[i] == 1) == task.IsTerminal(nextState));
+  }
+}
+
 /**
  * Constructs a DoublePoleCart instance and check if the main routine works as
  * it should be.
@@ -271,6 +342,56 @@ TEST_CASE("RandomReplayTest", "[RLComponentsTest]")
   }
 }
 
+/**
+ * Test contiguous window sampling of the random replay: samples must be
+ * consecutive transitions from the ring buffer.
+ */
+TEST_CASE("RandomReplayContiguousSampleTest", "[RLComponentsTest]")
+{
+  RandomReplay<MountainCar> replay(3, 10, 1, MountainCar::State::dimension,
+      true);
+  MountainCar env;
+  MountainCar::State state = env.InitialSample();
+  MountainCar::Action action;
+  action.action = MountainCar::Action::actions::forward;
+  MountainCar::State nextState;
+
+  // Store transitions with distinguishable rewards.
+  for (size_t i = 0; i < 10; ++i)
+  {
+    env.Sample(state, action, nextState);
+    replay.Store(state, action, (double) i, nextState,
+        env.IsTerminal(nextState), 0.9);
+    state = nextState;
+  }
+
+  REQUIRE(10 == replay.Size());
+
+  arma::mat sampledStates;
+  std::vector<MountainCar::Action> sampledActions;
+  arma::rowvec sampledRewards;
+  arma::mat sampledNextStates;
+  arma::irowvec sampledTerminal;
+
+  for (size_t trial = 0; trial < 20; ++trial)
+  {
+    sampledActions.clear();
+    replay.Sample(sampledStates, sampledActions, sampledRewards,
+        sampledNextStates, sampledTerminal);
+
+    REQUIRE(sampledStates.n_cols == 3);
+    REQUIRE(sampledActions.size() == 3);
+    REQUIRE(sampledRewards.n_elem == 3);
+    REQUIRE(sampledNextStates.n_cols == 3);
+    REQUIRE(sampledTerminal.n_elem == 3);
+
+    // The stored rewards are the storage indices, so a contiguous window must
+    // sample consecutive rewards.
+    REQUIRE(sampledRewards(1) == Approx(sampledRewards(0) + 1).epsilon(1e-7));
+    REQUIRE(sampledRewards(2) == Approx(sampledRewards(1) + 1).epsilon(1e-7));
+  }
+}
+
 /**
  * Construct a greedy policy instance and check if it works as
  * it should be.
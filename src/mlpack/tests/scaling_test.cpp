@@ -15,6 +15,7 @@
 #include <mlpack/core/data/scaler_methods/max_abs_scaler.hpp>
 #include <mlpack/core/data/scaler_methods/standard_scaler.hpp>
 #include <mlpack/core/data/scaler_methods/mean_normalization.hpp>
+#include <mlpack/core/data/pipeline.hpp>
 
 #include "test_catch_tools.hpp"
 #include "catch.hpp"
@@ -73,6 +74,98 @@ TEST_CASE("StandardScalerTest", "[ScalingTest]")
   CheckMatrices(dataset, temp);
 }
 
+/**
+ * Test that PartialFit() over chunks and Merge() of per-shard scalers give
+ * exactly the statistics of a single Fit() over the whole dataset.
+ */
+TEST_CASE("StandardScalerPartialFitMergeTest", "[ScalingTest]")
+{
+  arma::mat input(5, 300, arma::fill::randu);
+
+  data::StandardScaler batch;
+  batch.Fit(input);
+
+  // Feed the dataset in three uneven chunks.
+  data::StandardScaler online;
+  arma::mat chunk1 = input.cols(0, 9);
+  arma::mat chunk2 = input.cols(10, 149);
+  arma::mat chunk3 = input.cols(150, 299);
+  online.PartialFit(chunk1);
+  online.PartialFit(chunk2);
+  online.PartialFit(chunk3);
+
+  REQUIRE(online.Count() == 300);
+  CheckMatrices(batch.ItemMean(), online.ItemMean());
+  CheckMatrices(batch.ItemStdDev(), online.ItemStdDev());
+
+  // Fit two disjoint shards independently and merge them.
+  data::StandardScaler left, right;
+  arma::mat leftShard = input.cols(0, 99);
+  arma::mat rightShard = input.cols(100, 299);
+  left.Fit(leftShard);
+  right.Fit(rightShard);
+  left.Merge(right);
+
+  REQUIRE(left.Count() == 300);
+  CheckMatrices(batch.ItemMean(), left.ItemMean());
+  CheckMatrices(batch.ItemStdDev(), left.ItemStdDev());
+}
+
+/**
+ * Test that the in-place Transform() overload matches the two-matrix
+ * overload.
+ */
+TEST_CASE("StandardScalerInPlaceTransformTest", "[ScalingTest]")
+{
+  arma::mat input(5, 100, arma::fill::randu);
+
+  data::StandardScaler scale;
+  scale.Fit(input);
+
+  arma::mat output;
+  scale.Transform(input, output);
+
+  arma::mat inPlace = input;
+  scale.Transform(inPlace);
+
+  CheckMatrices(output, inPlace);
+}
+
+/**
+ * Test that MeanNormalization supports the same online fitting and merging.
+ */
+TEST_CASE("MeanNormalizationPartialFitMergeTest", "[ScalingTest]")
+{
+  arma::mat input(5, 300, arma::fill::randu);
+
+  data::MeanNormalization batch;
+  batch.Fit(input);
+
+  data::MeanNormalization online;
+  arma::mat chunk1 = input.cols(0, 49);
+  arma::mat chunk2 = input.cols(50, 299);
+  online.PartialFit(chunk1);
+  online.PartialFit(chunk2);
+
+  data::MeanNormalization left, right;
+  arma::mat leftShard = input.cols(0, 149);
+  arma::mat rightShard = input.cols(150, 299);
+  left.Fit(leftShard);
+  right.Fit(rightShard);
+  left.Merge(right);
+
+  CheckMatrices(batch.ItemMean(), online.ItemMean());
+  CheckMatrices(batch.Scale(), online.Scale());
+  CheckMatrices(batch.ItemMean(), left.ItemMean());
+  CheckMatrices(batch.Scale(), left.Scale());
+
+  arma::mat output;
+  batch.Transform(input, output);
+  arma::mat inPlace = input;
+  batch.Transform(inPlace);
+  CheckMatrices(output, inPlace);
+}
+
 /**
  * Test For MeanNormalization Scaler Class.
  */
@@ -172,3 +265,37 @@ TEST_CASE("ZCAWhiteningTest", "[ScalingTest]")
   scale.InverseTransform(output, temp);
   CheckMatrices(dataset, temp);
 }
+
+/**
+ * Test for the Pipeline class: the fused blocked transform has to match
+ * applying the stages one after another, and the inverse has to recover the
+ * original dataset.
+ */
+TEST_CASE("PipelineTest", "[ScalingTest]")
+{
+  arma::mat input = arma::randu<arma::mat>(5, 50);
+
+  // Chain the stages by hand.
+  data::StandardScaler standard;
+  data::MinMaxScaler minmax;
+  arma::mat standardized, chained;
+  standard.Fit(input);
+  standard.Transform(input, standardized);
+  minmax.Fit(standardized);
+  minmax.Transform(standardized, chained);
+
+  // The pipeline has to produce the same result; use a small block size so
+  // that the blocked path is actually exercised.
+  data::Pipeline<data::StandardScaler, data::MinMaxScaler> pipeline;
+  pipeline.BlockSize() = 7;
+  pipeline.Fit(input);
+
+  arma::mat transformed;
+  pipeline.Transform(input, transformed);
+  CheckMatrices(chained, transformed);
+
+  // The inverse transform has to recover the original dataset.
+  arma::mat recovered;
+  pipeline.InverseTransform(transformed, recovered);
+  CheckMatrices(input, recovered);
+}
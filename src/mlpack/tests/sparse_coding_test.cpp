@@ -214,3 +214,66 @@ TEST_CASE("SparseCodingTrainReturnObjective", "[SparseCodingTest]")
 
   REQUIRE(std::isfinite(objVal) == true);
 }
+
+/**
+ * The blocked objective computation must agree with the direct formula.
+ */
+TEST_CASE("SparseCodingBlockedObjectiveTest", "[SparseCodingTest]")
+{
+  double lambda1 = 0.1;
+  double lambda2 = 0.2;
+  uword nAtoms = 25;
+
+  mat X;
+  X.load("mnist_first250_training_4s_and_9s.arm");
+  uword nPoints = X.n_cols;
+
+  // Normalize each point since these are images.
+  for (uword i = 0; i < nPoints; ++i)
+    X.col(i) /= norm(X.col(i), 2);
+
+  SparseCoding sc(nAtoms, lambda1, lambda2, 0);
+  DataDependentRandomInitializer::Initialize(X, nAtoms, sc.Dictionary());
+
+  mat Z;
+  sc.Encode(X, Z);
+
+  // Compute the objective directly from its definition.
+  const double residualNorm = norm(X - sc.Dictionary() * Z, "fro");
+  const double directObjective = 0.5 * (std::pow(residualNorm, 2.0) +
+      lambda2 * std::pow(norm(Z, "fro"), 2.0)) +
+      lambda1 * accu(abs(Z));
+
+  REQUIRE(sc.Objective(X, Z) ==
+      Approx(directObjective).epsilon(1e-10));
+}
+
+/**
+ * Encoding the same data twice must give identical codes: the per-point LARS
+ * problems are independent, so the parallel coding step is deterministic.
+ */
+TEST_CASE("SparseCodingDeterministicEncodeTest", "[SparseCodingTest]")
+{
+  double lambda1 = 0.1;
+  uword nAtoms = 25;
+
+  mat X;
+  X.load("mnist_first250_training_4s_and_9s.arm");
+  uword nPoints = X.n_cols;
+
+  // Normalize each point since these are images.
+  for (uword i = 0; i < nPoints; ++i)
+    X.col(i) /= norm(X.col(i), 2);
+
+  SparseCoding sc(nAtoms, lambda1, 0.0, 0);
+  DataDependentRandomInitializer::Initialize(X, nAtoms, sc.Dictionary());
+
+  mat Z1, Z2;
+  sc.Encode(X, Z1);
+  sc.Encode(X, Z2);
+
+  REQUIRE(Z1.n_rows == Z2.n_rows);
+  REQUIRE(Z1.n_cols == Z2.n_cols);
+  for (uword i = 0; i < Z1.n_elem; ++i)
+    REQUIRE(Z1[i] == Z2[i]);
+}
@@ -322,3 +322,105 @@ TEST_CASE("StratifiedSplitLargerDataResultTest", "[SplitDataTest]")
   mat concat = arma::join_rows(std::get<0>(value), std::get<1>(value));
   CheckMatEqual(input, concat);
 }
+
+/**
+ * Check that SplitIndices() produces a partition of the column indices with
+ * the right sizes, and that views built on those indices see exactly the same
+ * points as the materializing Split().
+ */
+TEST_CASE("SplitIndicesViewTest", "[SplitDataTest]")
+{
+  mat input(3, 100);
+  input.randu();
+
+  uvec trainIndices, testIndices;
+  SplitIndices(input.n_cols, trainIndices, testIndices, 0.3);
+
+  REQUIRE(trainIndices.n_elem == 70);
+  REQUIRE(testIndices.n_elem == 30);
+
+  // Together the index sets must cover every column exactly once.
+  uvec all = arma::sort(arma::join_cols(trainIndices, testIndices));
+  for (size_t i = 0; i < all.n_elem; ++i)
+    REQUIRE(all[i] == i);
+
+  // The views must gather the same points as an eager gather, with no copy of
+  // the dataset.
+  ColumnSubsetView<double> trainView(input, trainIndices);
+  ColumnSubsetView<double> testView(input, testIndices);
+
+  REQUIRE(trainView.n_rows == input.n_rows);
+  REQUIRE(trainView.n_cols == trainIndices.n_elem);
+
+  for (size_t i = 0; i < trainView.n_cols; ++i)
+  {
+    for (size_t j = 0; j < trainView.n_rows; ++j)
+      REQUIRE(trainView(j, i) == input(j, trainIndices[i]));
+  }
+
+  mat materialized = testView.Materialize();
+  REQUIRE(materialized.n_cols == testIndices.n_elem);
+  for (size_t i = 0; i < testIndices.n_elem; ++i)
+    CheckMatrices(mat(materialized.col(i)), mat(input.col(testIndices[i])));
+}
+
+/**
+ * Check that StratifiedSplitIndices() preserves class ratios, and that
+ * label gathering through the view matches the index sets.
+ */
+TEST_CASE("StratifiedSplitIndicesTest", "[SplitDataTest]")
+{
+  mat input(3, 480);
+  input.randu();
+
+  // 256 0s, 128 1s, 64 2s and 32 3s.
+  Row<size_t> labels(480);
+  labels.cols(0, 255).fill(0);
+  labels.cols(256, 383).fill(1);
+  labels.cols(384, 447).fill(2);
+  labels.cols(448, 479).fill(3);
+
+  uvec trainIndices, testIndices;
+  StratifiedSplitIndices(labels, trainIndices, testIndices, 0.3);
+
+  ColumnSubsetView<double> trainView(input, trainIndices);
+  ColumnSubsetView<double> testView(input, testIndices);
+  Row<size_t> trainLabels = trainView.GatherLabels(labels);
+  Row<size_t> testLabels = testView.GatherLabels(labels);
+
+  REQUIRE(static_cast<uvec>(find(trainLabels == 0)).n_rows == 180);
+  REQUIRE(static_cast<uvec>(find(trainLabels == 1)).n_rows == 90);
+  REQUIRE(static_cast<uvec>(find(trainLabels == 2)).n_rows == 45);
+  REQUIRE(static_cast<uvec>(find(trainLabels == 3)).n_rows == 23);
+
+  REQUIRE(static_cast<uvec>(find(testLabels == 0)).n_rows == 76);
+  REQUIRE(static_cast<uvec>(find(testLabels == 1)).n_rows == 38);
+  REQUIRE(static_cast<uvec>(find(testLabels == 2)).n_rows == 19);
+  REQUIRE(static_cast<uvec>(find(testLabels == 3)).n_rows == 9);
+
+  mat concat = arma::join_rows(trainView.Materialize(),
+      testView.Materialize());
+  CheckMatEqual(input, concat);
+}
+
+/**
+ * Check the SplitView() convenience overload, including the zero and total
+ * ratio edge cases.
+ */
+TEST_CASE("SplitViewTest", "[SplitDataTest]")
+{
+  mat input(2, 10);
+  input.randu();
+
+  auto views = SplitView(input, 0.2);
+  REQUIRE(std::get<0>(views).n_cols == 8);
+  REQUIRE(std::get<1>(views).n_cols == 2);
+
+  auto noTest = SplitView(input, 0.0);
+  REQUIRE(std::get<0>(noTest).n_cols == 10);
+  REQUIRE(std::get<1>(noTest).n_cols == 0);
+
+  auto allTest = SplitView(input, 1.0);
+  REQUIRE(std::get<0>(allTest).n_cols == 0);
+  REQUIRE(std::get<1>(allTest).n_cols == 10);
+}
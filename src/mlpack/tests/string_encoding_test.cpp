@@ -1434,3 +1434,40 @@ TEST_CASE("SplitByAnyOfTfIdfEncodingSerialization", "[StringEncodingTest]")
 
   CheckMatrices(output, xmlOutput, jsonOutput, binaryOutput);
 }
+
+/**
+ * Test the single-lookup ValueOrAddToken() method of all dictionary
+ * specializations: it must assign labels exactly like AddToken() and return
+ * the existing label for tokens that are already present.
+ */
+TEST_CASE("DictionaryValueOrAddTokenTest", "[StringEncodingTest]")
+{
+  // The generic std::string dictionary.
+  StringEncodingDictionary<string> strDictionary;
+  REQUIRE(strDictionary.ValueOrAddToken(string("one")) == 1);
+  REQUIRE(strDictionary.ValueOrAddToken(string("two")) == 2);
+  REQUIRE(strDictionary.ValueOrAddToken(string("one")) == 1);
+  REQUIRE(strDictionary.Size() == 2);
+  REQUIRE(strDictionary.Value("two") == 2);
+
+  // The interning boost::string_view specialization.  The views passed to
+  // ValueOrAddToken() refer to short-lived strings, so the returned labels
+  // must be backed by interned copies.
+  StringEncodingDictionary<boost::string_view> viewDictionary;
+  {
+    const string one("one"), two("two");
+    REQUIRE(viewDictionary.ValueOrAddToken(boost::string_view(one)) == 1);
+    REQUIRE(viewDictionary.ValueOrAddToken(boost::string_view(two)) == 2);
+    REQUIRE(viewDictionary.ValueOrAddToken(boost::string_view(one)) == 1);
+  }
+  REQUIRE(viewDictionary.Size() == 2);
+  REQUIRE(viewDictionary.Value(boost::string_view("two")) == 2);
+
+  // The int (single character) specialization.
+  StringEncodingDictionary<int> intDictionary;
+  REQUIRE(intDictionary.ValueOrAddToken('a') == 1);
+  REQUIRE(intDictionary.ValueOrAddToken('b') == 2);
+  REQUIRE(intDictionary.ValueOrAddToken('a') == 1);
+  REQUIRE(intDictionary.Size() == 2);
+  REQUIRE(intDictionary.Value('b') == 2);
+}
@@ -548,3 +548,113 @@ TEST_CASE("SVDPlusPlusFunctionParallelOptimize", "[SVDPlusPlusTest]")
 }
 
 #endif
+
+// Test SVD++ with the sharded (DSGD) parallel trainer.
+TEST_CASE("SVDPlusPlusApplyParallelTest", "[SVDPlusPlusTest]")
+{
+  // Define useful constants.
+  const size_t numUsers = 100;
+  const size_t numItems = 100;
+  const size_t numRatings = 1000;
+  const size_t iterations = 30;
+  const size_t rank = 5;
+  const double alpha = 0.01;
+  const double lambda = 0;
+
+  // Initiate random parameters.
+  arma::mat parameters = arma::randu(rank + 1, numUsers + 2 * numItems);
+
+  // Make a random rating dataset.
+  arma::mat data = arma::randu(3, numRatings);
+  data.row(0) = floor(data.row(0) * numUsers);
+  data.row(1) = floor(data.row(1) * numItems);
+
+  // Manually set last row to maximum user and maximum item.
+  data(0, numRatings - 1) = numUsers - 1;
+  data(1, numRatings - 1) = numItems - 1;
+
+  // ApplyParallel() uses whether a user rates an item as implicit feedback,
+  // so the ratings are generated with the same implicit dataset.
+  arma::mat implicitData = data.submat(0, 0, 1, data.n_cols - 1);
+  arma::sp_mat cleanedData;
+  SVDPlusPlus<>::CleanData(implicitData, cleanedData, data);
+
+  // Make rating entries based on the parameters.
+  for (size_t i = 0; i < numRatings; ++i)
+  {
+    const size_t user = data(0, i);
+    const size_t item = data(1, i) + numUsers;
+    const size_t implicitStart = numUsers + numItems;
+
+    const double userBias = parameters(rank, user);
+    const double itemBias = parameters(rank, item);
+
+    // Iterate through each item which the user interacted with to calculate
+    // user vector.
+    arma::vec userVec(rank, arma::fill::zeros);
+    arma::sp_mat::const_iterator it = cleanedData.begin_col(user);
+    arma::sp_mat::const_iterator it_end = cleanedData.end_col(user);
+    size_t implicitCount = 0;
+    for (; it != it_end; ++it)
+    {
+      userVec += parameters.col(implicitStart + it.row()).subvec(0, rank - 1);
+      implicitCount += 1;
+    }
+    if (implicitCount != 0)
+      userVec /= std::sqrt(implicitCount);
+    userVec += parameters.col(user).subvec(0, rank - 1);
+
+    data(2, i) = userBias + itemBias +
+        arma::dot(userVec, parameters.col(item).subvec(0, rank - 1));
+  }
+
+  // Train with the sharded parallel trainer.
+  SVDPlusPlus<> svdPP(iterations, alpha, lambda);
+  arma::mat itemLatent, userLatent, itemImplicit;
+  arma::vec itemBiases, userBiases;
+  svdPP.ApplyParallel(data, rank, itemLatent, userLatent, itemBiases,
+      userBiases, itemImplicit);
+
+  // Check the size of outputs.
+  REQUIRE(itemLatent.n_rows == numItems);
+  REQUIRE(itemLatent.n_cols == rank);
+  REQUIRE(userLatent.n_rows == rank);
+  REQUIRE(userLatent.n_cols == numUsers);
+  REQUIRE(itemBiases.n_elem == numItems);
+  REQUIRE(userBiases.n_elem == numUsers);
+  REQUIRE(itemImplicit.n_rows == rank);
+  REQUIRE(itemImplicit.n_cols == numItems);
+
+  // Get predicted ratings from the factorization.
+  arma::mat predictedData(1, numRatings);
+  for (size_t i = 0; i < numRatings; ++i)
+  {
+    const size_t user = data(0, i);
+    const size_t item = data(1, i);
+
+    // Iterate through each item which the user interacted with to calculate
+    // user vector.
+    arma::vec userVec(rank, arma::fill::zeros);
+    arma::sp_mat::const_iterator it = cleanedData.begin_col(user);
+    arma::sp_mat::const_iterator it_end = cleanedData.end_col(user);
+    size_t implicitCount = 0;
+    for (; it != it_end; ++it)
+    {
+      userVec += itemImplicit.col(it.row());
+      implicitCount += 1;
+    }
+    if (implicitCount != 0)
+      userVec /= std::sqrt(implicitCount);
+    userVec += userLatent.col(user);
+
+    predictedData(0, i) = userBiases(user) + itemBiases(item) +
+        arma::dot(userVec, itemLatent.row(item).t());
+  }
+
+  // Calculate relative error.
+  const double relativeError = arma::norm(data.row(2) - predictedData, "frob") /
+                               arma::norm(data, "frob");
+
+  // Relative error should be small.
+  REQUIRE(relativeError == Approx(0.0).margin(1e-2));
+}
@@ -0,0 +1,81 @@
+/**
+ * @file tests/telemetry_test.cpp
+ *
+ * Test for the structured telemetry sink.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+
+#include "catch.hpp"
+
+using namespace mlpack;
+
+/**
+ * A scoped operation must emit one JSON line with the counters it reported,
+ * and nothing must be emitted while telemetry is disabled.
+ */
+TEST_CASE("TelemetryOperationTest", "[TelemetryTest]")
+{
+  // Disabled by default: no output is collected.
+  REQUIRE(!Telemetry::Enabled());
+  {
+    Telemetry::Operation op("test::Quiet");
+    op.Rows(3);
+  }
+
+  std::ostringstream records;
+  Telemetry::Stream(&records);
+  REQUIRE(Telemetry::Enabled());
+
+  {
+    Telemetry::Operation op("test::Operation");
+    op.Rows(3).Cols(7).Bytes(168);
+  }
+
+  Telemetry::Stream(NULL);
+  REQUIRE(!Telemetry::Enabled());
+
+  const std::string line = records.str();
+  REQUIRE(line.find("\"operation\":\"test::Operation\"") !=
+      std::string::npos);
+  REQUIRE(line.find("\"duration\":") != std::string::npos);
+  REQUIRE(line.find("\"rows\":3") != std::string::npos);
+  REQUIRE(line.find("\"cols\":7") != std::string::npos);
+  REQUIRE(line.find("\"bytes\":168") != std::string::npos);
+  REQUIRE(line.find("\"threads\":") != std::string::npos);
+  REQUIRE(line.find("test::Quiet") == std::string::npos);
+  // Exactly one line was emitted.
+  REQUIRE(std::count(line.begin(), line.end(), '\n') == 1);
+}
+
+/**
+ * Instrumented entry points must emit records: data::Load reports the size
+ * and byte count of the loaded matrix.
+ */
+TEST_CASE("TelemetryLoadTest", "[TelemetryTest]")
+{
+  std::ofstream f;
+  f.open("test_telemetry_file.csv", std::fstream::out);
+  f << "1, 2, 3" << std::endl;
+  f << "4, 5, 6" << std::endl;
+  f.close();
+
+  std::ostringstream records;
+  Telemetry::Stream(&records);
+
+  arma::mat test;
+  REQUIRE(data::Load("test_telemetry_file.csv", test) == true);
+
+  Telemetry::Stream(NULL);
+
+  const std::string line = records.str();
+  REQUIRE(line.find("\"operation\":\"data::Load\"") != std::string::npos);
+  REQUIRE(line.find("\"rows\":3") != std::string::npos);
+  REQUIRE(line.find("\"cols\":2") != std::string::npos);
+
+  remove("test_telemetry_file.csv");
+}
@@ -0,0 +1,51 @@
+/**
+ * @file tests/threads_test.cpp
+ *
+ * Test for the library-level thread count control.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+
+#include "catch.hpp"
+
+using namespace mlpack;
+
+/**
+ * Setting the thread count must be reflected by the getter, and 0 must
+ * restore the use of all hardware threads.
+ */
+TEST_CASE("ThreadsControlTest", "[ThreadsTest]")
+{
+  const size_t original = Threads();
+
+  Threads(1);
+  REQUIRE(Threads() == 1);
+
+  Threads(0);
+  REQUIRE(Threads() >= 1);
+
+  Threads(original);
+  REQUIRE(Threads() == original);
+}
+
+#ifdef HAS_OPENMP
+/**
+ * Inside a parallel region the getter must report a single thread, so that
+ * nested parallel work does not oversubscribe the machine.
+ */
+TEST_CASE("ThreadsNestedTest", "[ThreadsTest]")
+{
+  size_t nestedThreads = 0;
+  #pragma omp parallel num_threads(2)
+  {
+    #pragma omp single
+    nestedThreads = Threads();
+  }
+
+  REQUIRE(nestedThreads == 1);
+}
+#endif
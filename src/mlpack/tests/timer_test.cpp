@@ -19,6 +19,9 @@
 #endif
 
 #include <mlpack/core.hpp>
+#include <mlpack/core/util/profiler.hpp>
+
+#include <sstream>
 
 #include "catch.hpp"
 
@@ -143,3 +146,39 @@ TEST_CASE("DisabledTimingTest", "[TimerTest]")
 
   REQUIRE(Timer::Get("test_timer") == std::chrono::microseconds(0));
 }
+
+/**
+ * Nested profiled scopes should show up in the merged report with the right
+ * call counts, and Reset() should clear them again.
+ */
+TEST_CASE("ProfilerScopeTest", "[TimerTest]")
+{
+  util::Profiler::Reset();
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    util::ScopedProfile outer("profiler_test_outer");
+    {
+      util::ScopedProfile inner("profiler_test_inner");
+
+      #ifdef _WIN32
+      Sleep(5);
+      #else
+      usleep(5000);
+      #endif
+    }
+  }
+
+  // The inner scope was recorded one level deeper than the outer scope.
+  std::ostringstream report;
+  util::Profiler::Print(report);
+  REQUIRE(report.str().find("profiler_test_outer: ") != std::string::npos);
+  REQUIRE(report.str().find("  profiler_test_inner: ") != std::string::npos);
+  REQUIRE(report.str().find("(3 calls)") != std::string::npos);
+
+  // After a reset the report should be empty again.
+  util::Profiler::Reset();
+  std::ostringstream emptyReport;
+  util::Profiler::Print(emptyReport);
+  REQUIRE(emptyReport.str().find("profiler_test_outer") == std::string::npos);
+}
@@ -1363,6 +1363,48 @@ TEST_CASE("KdTreeTest", "[TreeTest]")
   TreeType root(dataset);
 }
 
+/**
+ * Make sure a tree large enough to trigger the task-parallel build path still
+ * satisfies all of the ordering invariants, and that the build is
+ * deterministic.
+ */
+TEST_CASE("KdTreeParallelBuildTest", "[TreeTest]")
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  // Large enough that child tasks are spawned during construction.
+  arma::mat dataset(5, 40000, arma::fill::randu);
+
+  // Mappings for post-sort verification of data.
+  std::vector<size_t> newToOld;
+  std::vector<size_t> oldToNew;
+
+  TreeType root(dataset, newToOld, oldToNew);
+  const arma::mat& treeset = root.Dataset();
+
+  // Ensure the size of the tree is correct.
+  REQUIRE(root.Count() == dataset.n_cols);
+
+  // Check the forward and backward mappings for correctness.
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    REQUIRE(oldToNew[newToOld[i]] == i);
+    for (size_t j = 0; j < dataset.n_rows; ++j)
+      REQUIRE(treeset(j, i) == dataset(j, newToOld[i]));
+  }
+
+  // Now check that each point is contained inside of all bounds above it.
+  CheckPointBounds(root);
+
+  // The split policy is deterministic and the children of a node work on
+  // disjoint column ranges, so a second build must produce the identical
+  // permutation.
+  std::vector<size_t> newToOld2;
+  std::vector<size_t> oldToNew2;
+  TreeType root2(dataset, newToOld2, oldToNew2);
+  REQUIRE(newToOld == newToOld2);
+}
+
 TEST_CASE("MaxRPTreeTest", "[TreeTest]")
 {
   typedef MaxRPTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
@@ -2287,3 +2329,219 @@ TEST_CASE("CoverTreeDescendantTest", "[TreeTest]")
   // using the recursive function above.
   CheckDescendants(&tree);
 }
+
+//! Recursively check that two trees have identical structure and bounds.
+template<typename TreeType>
+void CheckSameStructure(const TreeType* a, const TreeType* b)
+{
+  if (a == NULL || b == NULL)
+  {
+    REQUIRE(a == (const TreeType*) NULL);
+    REQUIRE(b == (const TreeType*) NULL);
+    return;
+  }
+
+  REQUIRE(a->Begin() == b->Begin());
+  REQUIRE(a->Count() == b->Count());
+  REQUIRE(a->NumDescendants() == b->NumDescendants());
+  for (size_t i = 0; i < a->Bound().Dim(); ++i)
+  {
+    REQUIRE(a->Bound()[i].Lo() == Approx(b->Bound()[i].Lo()).epsilon(1e-10));
+    REQUIRE(a->Bound()[i].Hi() == Approx(b->Bound()[i].Hi()).epsilon(1e-10));
+  }
+
+  CheckSameStructure(a->Left(), b->Left());
+  CheckSameStructure(a->Right(), b->Right());
+}
+
+/**
+ * Test that relocating a BinarySpaceTree into a contiguous van Emde Boas
+ * arena preserves the tree exactly.
+ */
+TEST_CASE("BinarySpaceTreeArenaLayoutTest", "[TreeTest]")
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset = arma::randu<arma::mat>(4, 1000);
+  TreeType tree(dataset, 10);
+  TreeType copy(tree); // Keep a deep copy for comparison.
+
+  TreeNodeArena<TreeType> arena;
+  TreeType* packedRoot = arena.Layout(tree);
+
+  REQUIRE(packedRoot != (TreeType*) NULL);
+  REQUIRE(packedRoot->Parent() == (TreeType*) NULL);
+  REQUIRE(arena.NumNodes() > 1);
+
+  // The relocated tree must be structurally identical to the original.
+  CheckSameStructure(packedRoot, &copy);
+
+  // All nodes must live inside the arena's single contiguous block.
+  std::queue<TreeType*> queue;
+  queue.push(packedRoot);
+  while (!queue.empty())
+  {
+    TreeType* node = queue.front();
+    queue.pop();
+    REQUIRE(node >= packedRoot);
+    REQUIRE(node < packedRoot + arena.NumNodes());
+    if (node->Left())
+      queue.push(node->Left());
+    if (node->Right())
+      queue.push(node->Right());
+  }
+}
+
+/**
+ * Test that deserializing a tree through the arena produces a contiguous tree
+ * identical to the one that was saved.
+ */
+TEST_CASE("BinarySpaceTreeArenaLoadTest", "[TreeTest]")
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset = arma::randu<arma::mat>(4, 500);
+  TreeType tree(dataset, 10);
+
+  std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+  {
+    cereal::BinaryOutputArchive oar(stream);
+    oar(cereal::make_nvp("tree", tree));
+  }
+
+  cereal::BinaryInputArchive iar(stream);
+  TreeNodeArena<TreeType> arena;
+  TreeType* root = arena.Load(iar, "tree");
+
+  REQUIRE(root != (TreeType*) NULL);
+  REQUIRE(root->Parent() == (TreeType*) NULL);
+
+  // The loaded tree must be structurally identical to the saved one.
+  CheckSameStructure(root, &tree);
+
+  // All nodes must live inside the arena's single contiguous block.
+  std::queue<TreeType*> queue;
+  queue.push(root);
+  while (!queue.empty())
+  {
+    TreeType* node = queue.front();
+    queue.pop();
+    REQUIRE(node >= root);
+    REQUIRE(node < root + arena.NumNodes());
+    if (node->Left())
+      queue.push(node->Left());
+    if (node->Right())
+      queue.push(node->Right());
+  }
+}
+
+/**
+ * Test that the two-tier HybridKDTree builds wide contiguous leaf buckets and
+ * relocates the top of the tree into one contiguous arena.
+ */
+TEST_CASE("HybridKDTreeTest", "[TreeTest]")
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset = arma::randu<arma::mat>(4, 1000);
+  std::vector<size_t> oldFromNew;
+  HybridKDTree<EuclideanDistance, EmptyStatistic, arma::mat> tree(
+      dataset, oldFromNew, 32);
+
+  TreeType* root = tree.Root();
+  REQUIRE(root != (TreeType*) NULL);
+  REQUIRE(root->Parent() == (TreeType*) NULL);
+  REQUIRE(root->NumDescendants() == 1000);
+  REQUIRE(tree.BucketWidth() == 32);
+
+  // Every leaf must be a bucket of at most the requested width, owning a
+  // contiguous range of reordered columns, and every node must live inside
+  // the arena's single contiguous block.
+  std::queue<TreeType*> queue;
+  queue.push(root);
+  while (!queue.empty())
+  {
+    TreeType* node = queue.front();
+    queue.pop();
+    REQUIRE(node >= root);
+    REQUIRE(node < root + tree.NumNodes());
+    if (node->IsLeaf())
+    {
+      REQUIRE(node->NumPoints() <= 32);
+      for (size_t i = 0; i < node->NumPoints(); ++i)
+        REQUIRE(node->Point(i) == node->Point(0) + i);
+    }
+    if (node->Left())
+      queue.push(node->Left());
+    if (node->Right())
+      queue.push(node->Right());
+  }
+
+  // The mapping must relate the reordered dataset to the original one.
+  REQUIRE(oldFromNew.size() == 1000);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    for (size_t j = 0; j < dataset.n_rows; ++j)
+    {
+      REQUIRE(tree.Dataset()(j, i) ==
+          Approx(dataset(j, oldFromNew[i])).epsilon(1e-10));
+    }
+  }
+}
+
+/**
+ * Test that a BinarySpaceTree survives a round trip through the flat binary
+ * format: the structure, bounds, cached distances, and dataset must all be
+ * restored.
+ */
+TEST_CASE("BinarySpaceTreeFlatFormatTest", "[TreeTest]")
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset = arma::randu<arma::mat>(6, 750);
+  TreeType tree(dataset, 15);
+
+  // Round-trip the tree through the flat format in memory.
+  std::stringstream stream;
+  tree.SaveFlat(stream);
+  TreeType* loaded = TreeType::LoadFlat(stream);
+
+  REQUIRE(loaded != (TreeType*) NULL);
+  REQUIRE(loaded->Parent() == (TreeType*) NULL);
+
+  // The loaded tree must be structurally identical to the original.
+  CheckSameStructure(loaded, &tree);
+
+  // The cached distances and the dataset must also match.
+  std::queue<std::pair<TreeType*, const TreeType*>> queue;
+  queue.push(std::make_pair(loaded, (const TreeType*) &tree));
+  while (!queue.empty())
+  {
+    TreeType* a = queue.front().first;
+    const TreeType* b = queue.front().second;
+    queue.pop();
+
+    REQUIRE(a->ParentDistance() ==
+        Approx(b->ParentDistance()).margin(1e-10));
+    REQUIRE(a->FurthestDescendantDistance() ==
+        Approx(b->FurthestDescendantDistance()).margin(1e-10));
+
+    if (a->Left())
+      queue.push(std::make_pair(a->Left(), (const TreeType*) b->Left()));
+    if (a->Right())
+      queue.push(std::make_pair(a->Right(), (const TreeType*) b->Right()));
+  }
+
+  for (size_t i = 0; i < dataset.n_elem; ++i)
+    REQUIRE(loaded->Dataset()[i] == dataset[i]);
+
+  // Saving anything but the root should be refused.
+  REQUIRE_THROWS_AS(tree.Left()->SaveFlat(stream), std::invalid_argument);
+
+  // Loading from a stream that does not hold a flat tree should be refused.
+  std::stringstream badStream;
+  badStream << "this is not a flat tree";
+  REQUIRE_THROWS_AS(TreeType::LoadFlat(badStream), std::runtime_error);
+
+  delete loaded;
+}
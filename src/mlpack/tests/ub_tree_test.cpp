@@ -157,6 +157,70 @@ TEST_CASE("UBTreeBoundTest", "[UBTreeTest]")
   CheckBound(tree);
 }
 
+template<typename TreeType>
+void CheckBoundTightness(const TreeType& tree)
+{
+  typedef typename TreeType::ElemType ElemType;
+
+  const arma::Mat<ElemType>& loBound = tree.Bound().LoBound();
+  const arma::Mat<ElemType>& hiBound = tree.Bound().HiBound();
+
+  // Every subrectangle of the bound has to be shrunk to the points it
+  // contains: each of its faces must touch at least one descendant point.
+  for (size_t j = 0; j < tree.Bound().NumBounds(); ++j)
+  {
+    arma::Col<ElemType> lo(loBound.n_rows);
+    arma::Col<ElemType> hi(hiBound.n_rows);
+    lo.fill(std::numeric_limits<ElemType>::max());
+    hi.fill(std::numeric_limits<ElemType>::lowest());
+
+    bool nonEmpty = false;
+    for (size_t i = 0; i < tree.NumDescendants(); ++i)
+    {
+      arma::Col<ElemType> point = tree.Dataset().col(tree.Descendant(i));
+
+      size_t k = 0;
+      for (; k < loBound.n_rows; ++k)
+        if (point[k] < loBound(k, j) || point[k] > hiBound(k, j))
+          break;
+
+      if (k < loBound.n_rows)
+        continue; // The point is not contained in this subrectangle.
+
+      nonEmpty = true;
+      for (k = 0; k < loBound.n_rows; ++k)
+      {
+        lo[k] = std::min(lo[k], point[k]);
+        hi[k] = std::max(hi[k], point[k]);
+      }
+    }
+
+    REQUIRE(nonEmpty == true);
+    for (size_t k = 0; k < loBound.n_rows; ++k)
+    {
+      REQUIRE(loBound(k, j) == Approx(lo[k]).epsilon(1e-14));
+      REQUIRE(hiBound(k, j) == Approx(hi[k]).epsilon(1e-14));
+    }
+  }
+
+  if (!tree.IsLeaf())
+  {
+    CheckBoundTightness(*tree.Left());
+    CheckBoundTightness(*tree.Right());
+  }
+}
+
+TEST_CASE("UBTreeBoundTightnessTest", "[UBTreeTest]")
+{
+  typedef UBTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+  arma::mat dataset(8, 1000);
+
+  dataset.randu();
+
+  TreeType tree(dataset);
+  CheckBoundTightness(tree);
+}
+
 // Ensure that MinDistance() and MaxDistance() works correctly.
 template<typename TreeType, typename MetricType>
 void CheckDistance(TreeType& tree, TreeType* node = NULL)
@@ -228,6 +228,75 @@ TEST_CASE("VPTreeTest", "[VantagePointTreeTest]")
   }
 }
 
+TEST_CASE("OrderedVPTreeSplitTest", "[VantagePointTreeTest]")
+{
+  typedef OrderedVPTreeSplit<HollowBallBound<EuclideanDistance>, arma::mat>
+      SplitType;
+
+  arma::mat dataset(8, 500);
+  dataset.randu();
+  std::vector<size_t> oldFromNew(dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    oldFromNew[i] = i;
+
+  HollowBallBound<EuclideanDistance> bound(dataset.n_rows);
+  bound |= dataset;
+
+  SplitType::SplitInfo splitInfo;
+  REQUIRE(SplitType::SplitNode(bound, dataset, 0, dataset.n_cols, splitInfo));
+
+  const size_t splitCol = SplitType::PerformSplit(dataset, 0, dataset.n_cols,
+      splitInfo, oldFromNew);
+
+  // The split has to separate the points closer to the vantage point than the
+  // median from the others, and both sides have to be sorted by distance to
+  // the vantage point.
+  REQUIRE(splitCol > 0);
+  REQUIRE(splitCol < dataset.n_cols);
+
+  double previous = 0.0;
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    const double dist = splitInfo.metric->Evaluate(splitInfo.vantagePoint,
+        dataset.col(i));
+
+    if (i < splitCol)
+      REQUIRE(dist < splitInfo.mu);
+    else
+      REQUIRE(dist >= splitInfo.mu);
+
+    REQUIRE(dist >= previous);
+    previous = dist;
+  }
+}
+
+TEST_CASE("OrderedVPTreeSearchTest", "[VantagePointTreeTest]")
+{
+  arma::mat dataset;
+  dataset.randu(8, 1000); // 1000 points in 8 dimensions.
+  arma::Mat<size_t> neighbors1;
+  arma::mat distances1;
+  arma::Mat<size_t> neighbors2;
+  arma::mat distances2;
+
+  // Nearest neighbor search with the ordered VP tree.
+  NeighborSearch<NearestNeighborSort, metric::LMetric<2, true>, arma::mat,
+      OrderedVPTree> knn1(dataset, DUAL_TREE_MODE);
+
+  knn1.Search(5, neighbors1, distances1);
+
+  // Nearest neighbor search the naive way.
+  KNN knn2(dataset, NAIVE_MODE);
+
+  knn2.Search(5, neighbors2, distances2);
+
+  for (size_t i = 0; i < neighbors1.size(); ++i)
+  {
+    REQUIRE(neighbors1[i] == neighbors2[i]);
+    REQUIRE(distances1[i] == distances2[i]);
+  }
+}
+
 TEST_CASE("SingleVPTreeTraverserTest", "[VantagePointTreeTest]")
 {
   arma::mat dataset;